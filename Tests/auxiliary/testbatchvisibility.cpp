@@ -0,0 +1,121 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for batchvisibility.h
+*/
+
+#include "testbatchvisibility.h"
+
+#include "auxiliary/batchvisibility.h"
+#include "skyobjects/skypoint.h"
+
+#include <QtTest>
+
+namespace
+{
+KStarsDateTime utc(int year, int month, int day, int hour)
+{
+    return KStarsDateTime(QDateTime(QDate(year, month, day), QTime(hour, 0, 0), Qt::UTC));
+}
+}
+
+TestBatchVisibility::TestBatchVisibility(QObject *parent) : QObject(parent)
+{
+}
+
+void TestBatchVisibility::testAgainstHorizontal()
+{
+    const GeoLocation geo(dms(-0.1), dms(51.5));
+    const KStarsDateTime start = utc(2024, 3, 1, 18);
+    const KStarsDateTime stop  = utc(2024, 3, 2, 6);
+    const double minAlt = 20, maxAlt = 70;
+
+    // More objects than one block, at all declinations
+    QVector<double> ra, dec;
+    for (int i = 0; i < 1000; ++i)
+    {
+        ra.append(std::fmod(i * 37.3, 360.0));
+        dec.append(-89.0 + std::fmod(i * 13.7, 178.0));
+    }
+
+    BatchVisibility visibility(geo, start, stop, 0.5);
+    visibility.setAltitudeRange(minAlt, maxAlt);
+    QCOMPARE(visibility.sampleCount(), 24);
+    const QVector<BatchVisibility::Result> results = visibility.compute(ra, dec);
+    QCOMPARE(results.size(), ra.size());
+
+    for (int i = 0; i < ra.size(); ++i)
+    {
+        int visible = 0;
+        double highest = -90;
+        for (int k = 0; k < visibility.sampleCount(); ++k)
+        {
+            const KStarsDateTime t = start.addSecs(k * 1800);
+            const dms lst = geo.GSTtoLST(t.gst());
+            SkyPoint p(dms(ra[i]), dms(dec[i]));
+            p.EquatorialToHorizontal(&lst, geo.lat());
+            const double alt = p.alt().Degrees();
+            highest = std::max(highest, alt);
+
+            // Stay clear of the limits, where rounding may go either way
+            if (std::fabs(alt - minAlt) < 1e-6 || std::fabs(alt - maxAlt) < 1e-6)
+                continue;
+            if (alt >= minAlt && alt <= maxAlt)
+                visible++;
+        }
+
+        QCOMPARE(results[i].hoursVisible, visible * 0.5);
+        QCOMPARE(results[i].fractionVisible, visible / 24.0);
+        QVERIFY(results[i].maxAltitude >= highest - 1e-6);
+    }
+}
+
+void TestBatchVisibility::testTransit()
+{
+    const GeoLocation geo(dms(10.0), dms(45.0));
+    const KStarsDateTime start = utc(2024, 6, 1, 0);
+    const KStarsDateTime stop  = utc(2024, 6, 2, 0);
+
+    const QVector<double> ra { 0.0, 123.0, 250.0 };
+    const QVector<double> dec { 30.0, -20.0, 60.0 };
+
+    BatchVisibility visibility(geo, start, stop, 1.0);
+    const QVector<BatchVisibility::Result> results = visibility.compute(ra, dec);
+
+    for (int i = 0; i < ra.size(); ++i)
+    {
+        // The hour angle is zero at the transit
+        const KStarsDateTime transit(results[i].transitJD);
+        const dms lst = geo.GSTtoLST(transit.gst());
+        const double hourAngle = dms::reduce(lst.Degrees() - ra[i]);
+        QVERIFY(std::min(hourAngle, 360.0 - hourAngle) < 0.01);
+
+        QVERIFY(results[i].transitJD >= start.djd() && results[i].transitJD < stop.djd());
+        QVERIFY(std::fabs(results[i].maxAltitude - (90.0 - std::fabs(45.0 - dec[i]))) < 1e-6);
+
+        // Without limits the object is counted whenever it is above the ground
+        QVERIFY(results[i].hoursVisible > 0);
+        QVERIFY(results[i].hoursVisible <= 24.0);
+    }
+
+    // Circumpolar at this latitude
+    QCOMPARE(results[2].hoursVisible, 24.0);
+}
+
+void TestBatchVisibility::testEmptyGrid()
+{
+    const GeoLocation geo(dms(0.0), dms(0.0));
+    const KStarsDateTime start = utc(2024, 1, 1, 0);
+
+    BatchVisibility visibility(geo, start, start, 1.0);
+    QCOMPARE(visibility.sampleCount(), 0);
+
+    const QVector<BatchVisibility::Result> results = visibility.compute({ 10.0 }, { 10.0 });
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results[0].hoursVisible, 0.0);
+    QCOMPARE(results[0].fractionVisible, 0.0);
+}
+
+QTEST_GUILESS_MAIN(TestBatchVisibility)
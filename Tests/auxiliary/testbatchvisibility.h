@@ -0,0 +1,23 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for batchvisibility.h
+*/
+
+#pragma once
+
+#include <QObject>
+
+class TestBatchVisibility: public QObject
+{
+        Q_OBJECT
+    public:
+        explicit TestBatchVisibility(QObject * parent = nullptr);
+
+    private slots:
+        void testAgainstHorizontal();
+        void testTransit();
+        void testEmptyGrid();
+};
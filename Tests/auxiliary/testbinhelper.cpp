@@ -6,6 +6,77 @@
 
 #include "testbinhelper.h"
 
+#include "auxiliary/binfilehelper.h"
+#include "auxiliary/starcatalogformat.h"
+#include "skyobjects/deepstardata.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QFile>
+#include <QStandardPaths>
+
+#include <cstring>
+
+namespace
+{
+// Writes an aligned catalog of two trixels holding one and two stars
+QString writeAlignedCatalog(bool foreignByteOrder)
+{
+    using namespace StarCatalogFormat;
+
+    const QString directory = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    QDir().mkpath(directory);
+    QFile file(QDir(directory).filePath("aligned.dat"));
+    if (!file.open(QIODevice::WriteOnly))
+        return QString();
+
+    dataElement field;
+    strncpy(field.name, "RA", sizeof(field.name));
+    field.size  = 4;
+    field.type  = 5;
+    field.scale = 1000000;
+
+    StarCatalogHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.byteOrderMark = foreignByteOrder ? 0x04030201 : BYTE_ORDER_MARK;
+    header.version       = VERSION;
+    header.recordSize    = sizeof(DeepStarData);
+    header.fieldCount    = 1;
+    header.indexSize     = 2;
+    header.recordCount   = 3;
+    header.indexOffset   = sizeof(header) + sizeof(field);
+    header.dataOffset    = 2 * STAR_CATALOG_ALIGNMENT + STAR_CATALOG_ALIGNMENT - TRAILER_SIZE;
+
+    const quint64 firstRecord = header.dataOffset + TRAILER_SIZE;
+    const StarCatalogIndexEntry index[2] =
+    {
+        { firstRecord, 1, 0 },
+        { firstRecord + sizeof(DeepStarData), 2, 0 }
+    };
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(&field), sizeof(field));
+    file.write(reinterpret_cast<const char *>(index), sizeof(index));
+    file.write(QByteArray(header.dataOffset - file.pos(), 0));
+
+    const qint16 faintMag = 12000;
+    const quint8 htmLevel = 3;
+    const quint16 maxStars = 2;
+    file.write(reinterpret_cast<const char *>(&faintMag), 2);
+    file.write(reinterpret_cast<const char *>(&htmLevel), 1);
+    file.write(reinterpret_cast<const char *>(&maxStars), 2);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        DeepStarData star;
+        star.V = 10000 + i;
+        file.write(reinterpret_cast<const char *>(&star), sizeof(star));
+    }
+    return QFileInfo(file).fileName();
+}
+}
+
 TestBinHelper::TestBinHelper(QObject *parent) : QObject(parent)
 {
 }
@@ -20,10 +91,12 @@ void TestBinHelper::cleanupTestCase()
 
 void TestBinHelper::init()
 {
+    QStandardPaths::setTestModeEnabled(true);
 }
 
 void TestBinHelper::cleanup()
 {
+    QFile::remove(QDir(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("aligned.dat"));
 }
 
 void TestBinHelper::testLoadBinary_data()
@@ -35,4 +108,53 @@ void TestBinHelper::testLoadBinary()
     QSKIP("Not implemented yet.");
 }
 
+void TestBinHelper::testLoadAligned()
+{
+    const QString fileName = writeAlignedCatalog(false);
+    QVERIFY(!fileName.isEmpty());
+
+    BinFileHelper reader;
+    FILE *f = reader.openFile(fileName);
+    QVERIFY(f != nullptr);
+    QVERIFY2(reader.readHeader(), qPrintable(reader.getError()));
+
+    QVERIFY(reader.isAligned());
+    QVERIFY(!reader.getByteSwap());
+    QCOMPARE(reader.guessRecordSize(), 16);
+    QCOMPARE(reader.getFieldCount(), 1);
+    QVERIFY(reader.isField("RA"));
+    QCOMPARE(reader.getRecordCount(), 3ul);
+    QCOMPARE(reader.getRecordCount(0), 1u);
+    QCOMPARE(reader.getRecordCount(1), 2u);
+    QCOMPARE((reader.getDataOffset() + 5) % 64, 0l);
+    QCOMPARE(reader.getOffset(1), reader.getOffset(0) + 16);
+
+    // The star components read the trailer from where the header leaves the file
+    qint16 faintMag = 0;
+    quint8 htmLevel = 0;
+    QCOMPARE(fread(&faintMag, 2, 1, f), size_t(1));
+    QCOMPARE(fread(&htmLevel, 1, 1, f), size_t(1));
+    QCOMPARE(faintMag, qint16(12000));
+    QCOMPARE(htmLevel, quint8(3));
+
+    QVERIFY(reader.mapFile());
+    DeepStarData star;
+    memcpy(&star, reader.getMappedData() + reader.getOffset(1) + 16, sizeof(star));
+    QCOMPARE(star.V, qint16(10002));
+
+    reader.closeFile();
+}
+
+void TestBinHelper::testRejectForeignByteOrder()
+{
+    const QString fileName = writeAlignedCatalog(true);
+    QVERIFY(!fileName.isEmpty());
+
+    BinFileHelper reader;
+    QVERIFY(reader.openFile(fileName) != nullptr);
+    QVERIFY(!reader.readHeader());
+    QCOMPARE(reader.getErrorNumber(), int(BinFileHelper::ERR_FORMAT));
+    reader.closeFile();
+}
+
 QTEST_GUILESS_MAIN(TestBinHelper)
@@ -25,6 +25,8 @@ private slots:
 
     void testLoadBinary_data();
     void testLoadBinary();
+    void testLoadAligned();
+    void testRejectForeignByteOrder();
 };
 
 #endif // TESTBINHELPER_H
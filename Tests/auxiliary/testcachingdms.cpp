@@ -11,6 +11,7 @@
 #include <QTest>
 
 #include <ctime>
+#include <type_traits>
 #include <cstdlib>
 #include <cstdint>
 
@@ -294,4 +295,22 @@ void TestCachingDms::testFailsafeUseOfBaseClassPtr()
     }
 }
 
+void TestCachingDms::testNonVirtual()
+{
+    // No vtable, the setters are resolved at compile time
+    QVERIFY(!std::is_polymorphic<dms>::value);
+    QVERIFY(!std::is_polymorphic<CachingDms>::value);
+#ifndef COUNT_DMS_SINCOS_CALLS
+    QCOMPARE(sizeof(dms), sizeof(double));
+    QCOMPARE(sizeof(CachingDms), 3 * sizeof(double));
+#endif
+
+    // Through the CachingDms type the cache follows every setter
+    CachingDms angle(10.0);
+    angle.setRadians(1.0);
+    QVERIFY(fabs(angle.sin() - sin(1.0)) < 1e-15);
+    angle.setH(3.0);
+    QVERIFY(fabs(angle.cos() - cos(45.0 * dms::DegToRad)) < 1e-15);
+}
+
 QTEST_GUILESS_MAIN(TestCachingDms)
@@ -36,4 +36,5 @@ class TestCachingDms : public QObject
     void subtractionOperator();
     void unaryMinusOperator();
     void testFailsafeUseOfBaseClassPtr();
+    void testNonVirtual();
 };
@@ -0,0 +1,146 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for cityindex.h
+*/
+
+#include "testcityindex.h"
+
+#include "auxiliary/cityindex.h"
+#include "auxiliary/geolocation.h"
+
+#include <QRandomGenerator>
+#include <QtTest>
+
+#include <cmath>
+#include <memory>
+
+namespace
+{
+struct Cities
+{
+    Cities()
+    {
+        add(2.35, 48.85, "Paris", "France");
+        add(-0.13, 51.51, "London", "United Kingdom");
+        add(-75.7, 45.42, "Ottawa", "Canada");
+        add(-95.7, 37.7, "Paris", "USA", "Texas");
+        add(179.9, -16.5, "Labasa", "Fiji");
+        add(-179.8, -16.0, "Vaitupu", "Wallis and Futuna");
+        add(0, 89.9, "North", "Nowhere");
+        add(-3.7, 40.42, "Madrid", "Spain");
+        add(-58.38, -34.6, "Buenos Aires", "Argentina");
+    }
+
+    void add(double lng, double lat, const QString &name, const QString &country, const QString &province = QString())
+    {
+        owned.emplace_back(new GeoLocation(dms(lng), dms(lat), name, province, country));
+        list.append(owned.back().get());
+    }
+
+    std::vector<std::unique_ptr<GeoLocation>> owned;
+    QList<GeoLocation *> list;
+};
+
+double angle(const GeoLocation *location, double lng, double lat)
+{
+    const double lat1 = lat * dms::DegToRad, lat2 = location->lat()->radians();
+    const double sinLat = std::sin((lat2 - lat1) / 2);
+    const double sinLng = std::sin((location->lng()->radians() - lng * dms::DegToRad) / 2);
+    return sinLat * sinLat + std::cos(lat1) * std::cos(lat2) * sinLng * sinLng;
+}
+}
+
+TestCityIndex::TestCityIndex(QObject *parent) : QObject(parent)
+{
+}
+
+void TestCityIndex::testNames()
+{
+    Cities cities;
+    CityIndex index;
+    index.build(cities.list);
+    QCOMPARE(index.size(), cities.list.size());
+
+    QCOMPARE(index.startingWith("par").size(), 2);
+    QCOMPARE(index.startingWith("L").size(), 2);
+    QCOMPARE(index.startingWith("Buenos A").size(), 1);
+    QVERIFY(index.startingWith("Zz").isEmpty());
+    QCOMPARE(index.startingWith("").size(), cities.list.size());
+
+    QCOMPARE(index.named("Paris", QString(), "USA")->translatedProvince(), QString("Texas"));
+    QCOMPARE(index.named("Paris", QString(), "France")->translatedCountry(), QString("France"));
+    QVERIFY(index.named("Paris") != nullptr);
+    QVERIFY(index.named("paris") == nullptr);
+    QVERIFY(index.named("Madrid", QString(), "France") == nullptr);
+}
+
+void TestCityIndex::testNearest()
+{
+    Cities cities;
+    CityIndex index;
+    QVERIFY(index.nearest(0, 0) == nullptr);
+    index.build(cities.list);
+
+    QCOMPARE(index.nearest(2.0, 48.0)->translatedName(), QString("Paris"));
+    // Across the antimeridian
+    QCOMPARE(index.nearest(-179.95, -16.5)->translatedName(), QString("Labasa"));
+    // Near the pole longitudes are close together
+    QCOMPARE(index.nearest(170, 89.5)->translatedName(), QString("North"));
+
+    // The same answer as a full scan
+    QRandomGenerator random(42);
+    for (int i = 0; i < 500; i++)
+    {
+        const double lng = random.generateDouble() * 360 - 180;
+        const double lat = random.generateDouble() * 180 - 90;
+
+        const GeoLocation *expected = nullptr;
+        for (const GeoLocation *location : cities.list)
+        {
+            if (!expected || angle(location, lng, lat) < angle(expected, lng, lat))
+                expected = location;
+        }
+        QCOMPARE(index.nearest(lng, lat), expected);
+    }
+}
+
+void TestCityIndex::testWithin()
+{
+    Cities cities;
+    CityIndex index;
+    index.build(cities.list);
+
+    QCOMPARE(index.within(0, 50, 3).size(), 2);
+    QCOMPARE(index.within(-3, 41, 3).size(), 1);
+    QCOMPARE(index.within(180, -16, 1).size(), 2);
+    QVERIFY(index.within(100, 0, 3).isEmpty());
+}
+
+void TestCityIndex::testUpdates()
+{
+    Cities cities;
+    CityIndex index;
+    index.build(cities.list);
+
+    GeoLocation moved(dms(10), dms(10), "Nowhere", QString(), "Atlantis");
+    index.insert(&moved);
+    QCOMPARE(index.named("Nowhere"), &moved);
+    QCOMPARE(index.nearest(10.5, 9.5), &moved);
+
+    index.remove(&moved);
+    moved.setName("Elsewhere");
+    moved.setLong(dms(-30));
+    index.insert(&moved);
+    QVERIFY(index.named("Nowhere") == nullptr);
+    QCOMPARE(index.startingWith("else").size(), 1);
+    QCOMPARE(index.nearest(-30, 10), &moved);
+    QVERIFY(index.within(10, 10, 1).isEmpty());
+
+    index.remove(&moved);
+    QCOMPARE(index.size(), cities.list.size());
+}
+
+QTEST_GUILESS_MAIN(TestCityIndex)
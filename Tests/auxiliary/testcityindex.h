@@ -0,0 +1,24 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for cityindex.h
+*/
+
+#pragma once
+
+#include <QObject>
+
+class TestCityIndex: public QObject
+{
+        Q_OBJECT
+    public:
+        explicit TestCityIndex(QObject * parent = nullptr);
+
+    private slots:
+        void testNames();
+        void testNearest();
+        void testWithin();
+        void testUpdates();
+};
@@ -0,0 +1,158 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "testcolumnparser.h"
+
+#include "kscolumnparser.h"
+
+#include <QTemporaryFile>
+
+namespace
+{
+QString writeFile(QTemporaryFile &file, const QByteArray &content)
+{
+    if (!file.open())
+        return QString();
+    file.write(content);
+    file.close();
+    return file.fileName();
+}
+}
+
+void TestColumnParser::testCSV()
+{
+    // The cases of TestCSVParser: an empty line, quoted fields, quotes in quotes, a row
+    // running into the next one with an unmatched quote, empty fields, and a comment
+    QTemporaryFile file;
+    const QString name = writeFile(file, "\n"
+                                   ",isn't,it,\"amusing\",how,3,\"isn't, pi\",and,\"\",-3.141,isn't,either\n"
+                                   ",isn't,it,\"amusing\",how,3,\"isn't\"(, )\"pi\",and,\"\",-3.141,isn't,either\r\n"
+                                   ",isn't,it,\"amusing\",how,3,\"isn't, pi\",and,\"\","
+                                   ",isn't,it,\"amusing\",how,3,\"isn't, pi\",and,\",-3.141,isn't,either\n"
+                                   "#,a,b,c,d,1,e,f,g,1.0,h,i\n"
+                                   ",,,,,,,,,,,\n"
+                                   "\n");
+
+    KSColumnParser::Sequence sequence;
+    for (int i = 1; i <= 12; i++)
+        sequence.append(qMakePair(QString("field%1").arg(i),
+                                  i == 6 ? KSParser::D_INT : i == 10 ? KSParser::D_FLOAT : KSParser::D_QSTRING));
+
+    KSColumnParser parser(name, '#', sequence);
+    QVERIFY(parser.parse());
+    QCOMPARE(parser.rowCount(), 3);
+    QCOMPARE(parser.column("field7"), 6);
+    QCOMPARE(parser.column("missing"), -1);
+
+    KSColumnParser::Row row = parser.row(0);
+    QCOMPARE(row.toString(0), QString(""));
+    QCOMPARE(row.toString(1), QString("isn't"));
+    QCOMPARE(row.toString(3), QString("amusing"));
+    QCOMPARE(row.toInt(5), 3);
+    QCOMPARE(row.toString(6), QString("isn't, pi"));
+    QCOMPARE(row.toString(8), QString(""));
+    QVERIFY(qAbs(row.toFloat(9) + 3.141f) < 1e-6f);
+    QCOMPARE(row.toString(11), QString("either"));
+    QCOMPARE(row.toRawData(11), QByteArray("either"));
+
+    row = parser.row(1);
+    QCOMPARE(row.toString(6), QString("isn't\"(, )\"pi"));
+    QCOMPARE(row.toString(11), QString("either"));
+
+    row = parser.row(2);
+    for (int i = 0; i < 12; i++)
+    {
+        if (i == 5)
+            QCOMPARE(row.toInt(i), KSParser::EBROKEN_INT);
+        else if (i == 9)
+            QCOMPARE(row.toFloat(i), KSParser::EBROKEN_FLOAT);
+        else
+            QCOMPARE(row.toString(i), QString(""));
+    }
+
+    // A field of another type
+    QCOMPARE(row.toDouble(0), KSParser::EBROKEN_DOUBLE);
+}
+
+void TestColumnParser::testFixedWidth()
+{
+    QTemporaryFile file;
+    const QString name = writeFile(file, "this is an exam ple of 256 cases being tested -3.14       times\n"
+                                   "                                                               \n"
+                                   "this is an ex\n\n");
+
+    KSColumnParser::Sequence sequence;
+    for (int i = 1; i <= 12; i++)
+        sequence.append(qMakePair(QString("field%1").arg(i),
+                                  i == 6 ? KSParser::D_INT : i == 10 ? KSParser::D_FLOAT : KSParser::D_QSTRING));
+    const QList<int> widths { 5, 3, 3, 9, 3, 4, 6, 6, 7, 6, 6 };
+
+    KSColumnParser parser(name, '#', sequence, widths);
+    QVERIFY(parser.parse());
+    QCOMPARE(parser.rowCount(), 2);
+
+    const KSColumnParser::Row row = parser.row(0);
+    QCOMPARE(row.toString(0), QString("this"));
+    QCOMPARE(row.toString(3), QString("exam ple"));
+    QCOMPARE(row.toInt(5), 256);
+    QCOMPARE(row.toString(6), QString("cases"));
+    QVERIFY(qAbs(row.toFloat(9) + 3.14f) < 1e-6f);
+    QCOMPARE(row.toString(11), QString("times"));
+
+    QCOMPARE(parser.row(1).toString(0), QString(""));
+    QCOMPARE(parser.row(1).toInt(5), 0);
+
+    // The widths must match the sequence
+    KSColumnParser broken(name, '#', sequence, widths.mid(1));
+    QVERIFY(!broken.parse());
+}
+
+void TestColumnParser::testLargeFile()
+{
+    // Large enough for several chunks, compared with KSParser
+    QByteArray content;
+    for (int i = 0; i < 60000; i++)
+        content += QString("body %1,%2,%3,\"%4, %5\"\n").arg(i).arg(i * 7).arg(i * 0.125, 0, 'f', 3).arg(i % 13).arg(i % 17).toUtf8();
+
+    QTemporaryFile file;
+    const QString name = writeFile(file, content);
+
+    KSColumnParser::Sequence sequence;
+    sequence.append(qMakePair(QString("name"), KSParser::D_QSTRING));
+    sequence.append(qMakePair(QString("number"), KSParser::D_INT));
+    sequence.append(qMakePair(QString("value"), KSParser::D_DOUBLE));
+    sequence.append(qMakePair(QString("pair"), KSParser::D_QSTRING));
+
+    KSColumnParser parser(name, '#', sequence);
+    QVERIFY(parser.parse());
+    QCOMPARE(parser.rowCount(), 60000);
+    QCOMPARE(static_cast<int>(parser.doubles(2).size()), 60000);
+
+    KSParser reference(name, '#', sequence);
+    int i = 0;
+    while (reference.HasNextRow())
+    {
+        const QHash<QString, QVariant> expected = reference.ReadNextRow();
+        const KSColumnParser::Row row = parser.row(i++);
+        QCOMPARE(row.toString(0), expected["name"].toString());
+        QCOMPARE(row.toInt(1), expected["number"].toInt());
+        QCOMPARE(row.toDouble(2), expected["value"].toDouble());
+        QCOMPARE(row.toString(3), expected["pair"].toString());
+    }
+    QCOMPARE(i, 60000);
+}
+
+void TestColumnParser::testMissingFile()
+{
+    KSColumnParser::Sequence sequence;
+    sequence.append(qMakePair(QString("name"), KSParser::D_QSTRING));
+
+    KSColumnParser parser("/nonexistent/kstars/file.csv", '#', sequence);
+    QVERIFY(!parser.parse());
+    QCOMPARE(parser.rowCount(), 0);
+}
+
+QTEST_GUILESS_MAIN(TestColumnParser)
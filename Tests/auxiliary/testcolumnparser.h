@@ -0,0 +1,24 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QTest>
+
+/**
+ * @class TestColumnParser
+ * @short Tests KSColumnParser against the rows KSParser reads
+ */
+class TestColumnParser : public QObject
+{
+        Q_OBJECT
+
+    private slots:
+        void testCSV();
+        void testFixedWidth();
+        void testLargeFile();
+        void testMissingFile();
+};
@@ -0,0 +1,98 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for elementtable.h
+*/
+
+#include "testelementtable.h"
+
+#include "auxiliary/elementtable.h"
+
+#include <QTemporaryDir>
+#include <QtTest>
+
+namespace
+{
+struct Record
+{
+    double value;
+    quint32 name;
+    quint32 kind;
+};
+
+bool writeTable(const QString &path, quint32 version, quint32 tag = 0)
+{
+    ElementTable::StringPool strings;
+    QByteArray records(3 * sizeof(Record), '\0');
+    auto *r = reinterpret_cast<Record *>(records.data());
+    const char *names[] = { "Ceres", "Pallas", "" };
+    for (int i = 0; i < 3; ++i)
+    {
+        r[i].value = i * 1.5;
+        r[i].name  = strings.add(QString::fromUtf8(names[i]));
+        r[i].kind  = strings.add("MBA");
+    }
+    return ElementTable::write(path, version, sizeof(Record), 3, records, strings, tag);
+}
+}
+
+TestElementTable::TestElementTable(QObject *parent) : QObject(parent)
+{
+}
+
+void TestElementTable::testRoundTrip()
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath("table.bin");
+    QVERIFY(writeTable(path, 1));
+
+    ElementTable table;
+    QVERIFY(table.open(path, 1, sizeof(Record)));
+    QCOMPARE(table.count(), 3);
+
+    QCOMPARE(table.record<Record>(1).value, 1.5);
+    QCOMPARE(table.string(table.record<Record>(0).name), QString("Ceres"));
+    QCOMPARE(table.string(table.record<Record>(1).name), QString("Pallas"));
+    QVERIFY(table.string(table.record<Record>(2).name).isEmpty());
+
+    // Equal strings are stored once
+    QCOMPARE(table.record<Record>(0).kind, table.record<Record>(2).kind);
+    QCOMPARE(table.sharedString(table.record<Record>(0).kind), QString("MBA"));
+}
+
+void TestElementTable::testRefused()
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath("table.bin");
+
+    ElementTable table;
+    QVERIFY(!table.open(path, 1, sizeof(Record)));
+
+    QVERIFY(writeTable(path, 1));
+    QVERIFY(!table.open(path, 2, sizeof(Record)));
+    QVERIFY(!table.open(path, 1, sizeof(Record) + 8));
+
+    // Built from other data
+    QVERIFY(writeTable(path, 1, 0x1234));
+    QVERIFY(!table.open(path, 1, sizeof(Record), 0x4321));
+    QVERIFY(table.open(path, 1, sizeof(Record), 0x1234));
+    table.close();
+    QVERIFY(writeTable(path, 1));
+
+    // Truncated
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.resize(file.size() - 4));
+    file.close();
+    QVERIFY(!table.open(path, 1, sizeof(Record)));
+
+    // Not a table at all, like the former QDataStream binary
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write(QByteArray(256, 'x'));
+    file.close();
+    QVERIFY(!table.open(path, 1, sizeof(Record)));
+}
+
+QTEST_GUILESS_MAIN(TestElementTable)
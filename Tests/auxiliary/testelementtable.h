@@ -0,0 +1,22 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for elementtable.h
+*/
+
+#pragma once
+
+#include <QObject>
+
+class TestElementTable: public QObject
+{
+        Q_OBJECT
+    public:
+        explicit TestElementTable(QObject * parent = nullptr);
+
+    private slots:
+        void testRoundTrip();
+        void testRefused();
+};
@@ -0,0 +1,232 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for executors.h
+*/
+
+#include "testexecutors.h"
+
+#include "auxiliary/executors.h"
+
+#include <QDir>
+#include <QSemaphore>
+#include <QTemporaryDir>
+#include <QThreadPool>
+#include <QtTest>
+
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+#ifdef Q_OS_LINUX
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+int twice(int value)
+{
+    return 2 * value;
+}
+
+// Writes the files of a cpu directory of sysfs
+void writeCpu(const QDir &sysfs, int cpu, const QString &file, int value)
+{
+    const QString path = sysfs.filePath(QString("cpu%1/%2").arg(cpu).arg(file));
+    QVERIFY(QDir().mkpath(QFileInfo(path).path()));
+    QFile out(path);
+    QVERIFY(out.open(QIODevice::WriteOnly));
+    out.write(QByteArray::number(value) + '\n');
+}
+
+#ifdef Q_OS_LINUX
+int threadNice()
+{
+    return getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)));
+}
+#endif
+}
+
+TestExecutors::TestExecutors(QObject *parent) : QObject(parent)
+{
+}
+
+void TestExecutors::testPools()
+{
+    QCOMPARE(Executors::pool(Executors::Interactive), QThreadPool::globalInstance());
+    QVERIFY(Executors::pool(Executors::RealTime) != QThreadPool::globalInstance());
+    QVERIFY(Executors::pool(Executors::Background) != QThreadPool::globalInstance());
+    QVERIFY(Executors::pool(Executors::RealTime) != Executors::pool(Executors::Background));
+}
+
+void TestExecutors::testRun()
+{
+    for (int i = 0; i < Executors::PriorityCount; ++i)
+    {
+        const auto priority = static_cast<Executors::Priority>(i);
+
+        QCOMPARE(Executors::run(priority, &twice, 21).result(), 42);
+        QCOMPARE(Executors::run(priority, &TestExecutors::square, this, 7).result(), 49);
+        QCOMPARE(Executors::run(priority, [](const QString & a, const QString & b)
+        {
+            return a + b;
+        }, QString("Real"), QString("Time")).result(), QString("RealTime"));
+    }
+}
+
+void TestExecutors::testBlockingMap()
+{
+    std::vector<int> values(10000);
+    std::iota(values.begin(), values.end(), 0);
+    Executors::blockingMap(Executors::RealTime, values, [](int &value)
+    {
+        value *= 2;
+    });
+    for (int i = 0; i < static_cast<int>(values.size()); ++i)
+        QCOMPARE(values[i], 2 * i);
+
+    // A range of pointers
+    std::atomic<int> count { 0 };
+    Executors::blockingMap(Executors::Background, values.data() + 10, values.data() + 110, [&](int &)
+    {
+        ++count;
+    });
+    QCOMPARE(count.load(), 100);
+}
+
+void TestExecutors::testMap()
+{
+    QVector<int> values(1000, 1);
+    QFuture<void> future = Executors::map(Executors::Background, values, [](int &value)
+    {
+        value += 1;
+    });
+    future.waitForFinished();
+    QCOMPARE(std::accumulate(values.cbegin(), values.cend(), 0), 2000);
+}
+
+void TestExecutors::testMetrics()
+{
+    Executors::setThreadCount(Executors::Background, 1);
+    Executors::resetMetrics();
+
+    // The first task holds the only thread, the second waits for it
+    QSemaphore started, release;
+    QFuture<void> first = Executors::run(Executors::Background, [&]()
+    {
+        started.release();
+        release.acquire();
+    });
+    QFuture<void> second = Executors::run(Executors::Background, []() {});
+    started.acquire();
+
+    Executors::Metrics metrics = Executors::metrics(Executors::Background);
+    QCOMPARE(metrics.threads, 1);
+    QCOMPARE(metrics.active, 1);
+    QCOMPARE(metrics.queued, 1);
+
+    QTest::qWait(20);
+    release.release();
+    first.waitForFinished();
+    second.waitForFinished();
+    Executors::pool(Executors::Background)->waitForDone();
+
+    metrics = Executors::metrics(Executors::Background);
+    QCOMPARE(metrics.active, 0);
+    QCOMPARE(metrics.queued, 0);
+    QCOMPARE(metrics.completed, 2ULL);
+    QVERIFY(metrics.longestWait >= 10);
+    QVERIFY(metrics.averageRun >= 5);
+    QVERIFY(Executors::summary().contains(metrics.name));
+
+    Executors::resetMetrics();
+    QCOMPARE(Executors::metrics(Executors::Background).completed, 0ULL);
+    Executors::setThreadCount(Executors::Background, 0);
+}
+
+void TestExecutors::testBorrowedTaskPriority()
+{
+#ifdef Q_OS_LINUX
+    Executors::setThreadCount(Executors::Background, 1);
+
+    // The only background thread is held, so the interactive task runs the queued background task as it waits for it
+    QSemaphore started, release;
+    QFuture<void> holder = Executors::run(Executors::Background, [&]()
+    {
+        started.release();
+        release.acquire();
+    });
+    started.acquire();
+    QFuture<int> queued = Executors::run(Executors::Background, []()
+    {
+        return threadNice();
+    });
+
+    const auto nices = Executors::run(Executors::Interactive, [queued]()
+    {
+        const int before = threadNice();
+        const int borrowed = queued.result();
+        return qMakePair(before, qMakePair(borrowed, threadNice()));
+    }).result();
+    release.release();
+    holder.waitForFinished();
+
+    // The interactive thread keeps its nice value, which it could not get back without privileges
+    QCOMPARE(nices.second.first, nices.first);
+    QCOMPARE(nices.second.second, nices.first);
+
+    Executors::setThreadCount(Executors::Background, 0);
+#else
+    QSKIP("Nice values are only set on Linux");
+#endif
+}
+
+void TestExecutors::testThreadCount()
+{
+    Executors::setThreadCount(Executors::RealTime, 3);
+    QCOMPARE(Executors::pool(Executors::RealTime)->maxThreadCount(), 3);
+    Executors::setThreadCount(Executors::RealTime, 0);
+    QCOMPARE(Executors::pool(Executors::RealTime)->maxThreadCount(), Executors::defaultThreadCount(Executors::RealTime));
+
+    QVERIFY(Executors::defaultThreadCount(Executors::Background) >= 1);
+    QVERIFY(Executors::defaultThreadCount(Executors::Background) <= Executors::defaultThreadCount(Executors::Interactive));
+}
+
+void TestExecutors::testReadCores()
+{
+    QTemporaryDir sysfs;
+    QVERIFY(sysfs.isValid());
+    const QDir dir(sysfs.path());
+
+    // Four efficiency cores and two performance cores, as on a big.LITTLE board
+    for (int cpu = 0; cpu < 6; ++cpu)
+        writeCpu(dir, cpu, "cpu_capacity", cpu < 4 ? 414 : 1024);
+
+    Executors::Cores cores = Executors::readCores(sysfs.path());
+    QCOMPARE(cores.performance, QVector<int>({4, 5}));
+    QCOMPARE(cores.efficiency, QVector<int>({0, 1, 2, 3}));
+
+    // Identical cores have no split
+    QTemporaryDir same;
+    for (int cpu = 0; cpu < 4; ++cpu)
+        writeCpu(QDir(same.path()), cpu, "cpu_capacity", 1024);
+    cores = Executors::readCores(same.path());
+    QVERIFY(cores.performance.isEmpty());
+    QVERIFY(cores.efficiency.isEmpty());
+
+    // Without capacities, the maximum frequencies tell the cores apart
+    QTemporaryDir frequencies;
+    for (int cpu = 0; cpu < 4; ++cpu)
+        writeCpu(QDir(frequencies.path()), cpu, "cpufreq/cpuinfo_max_freq", cpu % 2 ? 2400000 : 1800000);
+    cores = Executors::readCores(frequencies.path());
+    QCOMPARE(cores.performance, QVector<int>({1, 3}));
+    QCOMPARE(cores.efficiency, QVector<int>({0, 2}));
+
+    QVERIFY(Executors::readCores(dir.filePath("missing")).performance.isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestExecutors)
@@ -0,0 +1,33 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for executors.h
+*/
+
+#pragma once
+
+#include <QObject>
+
+class TestExecutors: public QObject
+{
+        Q_OBJECT
+    public:
+        explicit TestExecutors(QObject * parent = nullptr);
+
+        int square(int value) const
+        {
+            return value * value;
+        }
+
+    private slots:
+        void testPools();
+        void testRun();
+        void testBlockingMap();
+        void testMap();
+        void testMetrics();
+        void testBorrowedTaskPriority();
+        void testThreadCount();
+        void testReadCores();
+};
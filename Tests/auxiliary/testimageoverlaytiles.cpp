@@ -0,0 +1,127 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for imageoverlaytiles.h
+*/
+
+#include "testimageoverlaytiles.h"
+
+#include "skycomponents/imageoverlaytiles.h"
+
+#include <QDir>
+#include <QTemporaryDir>
+#include <QtTest>
+
+namespace
+{
+// An image whose left half is red and right half is blue
+QString writeImage(const QTemporaryDir &dir, int width, int height)
+{
+    QImage image(width, height, QImage::Format_RGB32);
+    image.fill(Qt::red);
+    for (int y = 0; y < height; ++y)
+        for (int x = width / 2; x < width; ++x)
+            image.setPixel(x, y, qRgb(0, 0, 255));
+
+    const QString filename = dir.filePath("overlay.png");
+    image.save(filename);
+    return filename;
+}
+}
+
+TestImageOverlayTiles::TestImageOverlayTiles(QObject * parent): QObject(parent)
+{
+}
+
+void TestImageOverlayTiles::testLevels()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    auto tiles = ImageOverlayTiles::create(writeImage(dir, 1000, 600), dir.filePath("tiles"), 0, false);
+    QVERIFY(tiles);
+
+    QCOMPARE(tiles->width(), 1000);
+    QCOMPARE(tiles->height(), 600);
+    QCOMPARE(tiles->levels(), 4);
+    QCOMPARE(tiles->levelSize(1), QSize(500, 300));
+    QCOMPARE(tiles->levelSize(3), QSize(125, 75));
+    QCOMPARE(tiles->preview().size(), QSize(125, 75));
+    QCOMPARE(tiles->tileCount(0), QSize(4, 3));
+    QCOMPARE(tiles->tileCount(3), QSize(1, 1));
+
+    // Magnified and 1:1 draw level 0, a level is only used once it has a pixel per screen pixel
+    QCOMPARE(tiles->level(0.5), 0);
+    QCOMPARE(tiles->level(1.0), 0);
+    QCOMPARE(tiles->level(1.9), 0);
+    QCOMPARE(tiles->level(2.0), 1);
+    QCOMPARE(tiles->level(5.0), 2);
+    QCOMPARE(tiles->level(100.0), 3);
+
+    // Larger images are scaled to the maximum width
+    auto scaled = ImageOverlayTiles::create(writeImage(dir, 1000, 600), dir.filePath("scaled"), 400, false);
+    QVERIFY(scaled);
+    QCOMPARE(scaled->width(), 400);
+    QCOMPARE(scaled->height(), 240);
+
+    QVERIFY(!ImageOverlayTiles::create(dir.filePath("missing.png"), dir.filePath("missing"), 0, false));
+}
+
+void TestImageOverlayTiles::testTiles()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString filename = writeImage(dir, 1000, 600);
+
+    auto tiles = ImageOverlayTiles::create(filename, dir.filePath("tiles"), 0, false);
+    QVERIFY(tiles);
+
+    // Tiles at the edges are cut to the image
+    QCOMPARE(tiles->tile(0, 0, 0, true).size(), QSize(256, 256));
+    QCOMPARE(tiles->tile(0, 3, 2, true).size(), QSize(1000 - 3 * 256, 600 - 2 * 256));
+    QCOMPARE(tiles->tile(0, 0, 0, true).pixel(10, 10), qRgb(255, 0, 0));
+    QCOMPARE(tiles->tile(0, 3, 0, true).pixel(10, 10), qRgb(0, 0, 255));
+
+    // Read tiles stay in memory, the others are only read when asked for
+    QVERIFY(!tiles->tile(0, 0, 0, false).isNull());
+    QVERIFY(tiles->tile(0, 1, 1, false).isNull());
+    QVERIFY(!tiles->tile(0, 1, 1, true).isNull());
+
+    // The coarsest level is always there
+    QVERIFY(!tiles->tile(tiles->levels() - 1, 0, 0, false).isNull());
+
+    // Mirroring swaps the halves
+    auto mirrored = ImageOverlayTiles::create(filename, dir.filePath("mirrored"), 0, true);
+    QVERIFY(mirrored);
+    QCOMPARE(mirrored->tile(0, 0, 0, true).pixel(10, 10), qRgb(0, 0, 255));
+    QCOMPARE(mirrored->preview().pixel(mirrored->preview().width() - 1, 0), qRgb(255, 0, 0));
+}
+
+void TestImageOverlayTiles::testReuse()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString filename = writeImage(dir, 600, 400);
+    const QString tileDirectory = dir.filePath("tiles");
+
+    QVERIFY(ImageOverlayTiles::create(filename, tileDirectory, 0, false));
+    const QString tilePath = QDir(tileDirectory).filePath("0_0_0.png");
+    QVERIFY(QFile::exists(tilePath));
+    const QDateTime written = QFileInfo(tilePath).lastModified();
+
+    // The same file and processing reuse the pyramid
+    auto reused = ImageOverlayTiles::create(filename, tileDirectory, 0, false);
+    QVERIFY(reused);
+    QCOMPARE(reused->width(), 600);
+    QCOMPARE(reused->levels(), 4);
+    QCOMPARE(QFileInfo(tilePath).lastModified(), written);
+
+    // Other processing builds it again
+    auto rebuilt = ImageOverlayTiles::create(filename, tileDirectory, 300, false);
+    QVERIFY(rebuilt);
+    QCOMPARE(rebuilt->width(), 300);
+    QCOMPARE(rebuilt->tile(0, 0, 0, true).size(), QSize(256, 200));
+}
+
+QTEST_GUILESS_MAIN(TestImageOverlayTiles)
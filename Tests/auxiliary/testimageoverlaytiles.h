@@ -0,0 +1,23 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for imageoverlaytiles.h
+*/
+
+#pragma once
+
+#include <QObject>
+
+class TestImageOverlayTiles: public QObject
+{
+        Q_OBJECT
+    public:
+        explicit TestImageOverlayTiles(QObject * parent = nullptr);
+
+    private slots:
+        void testLevels();
+        void testTiles();
+        void testReuse();
+};
@@ -7,6 +7,7 @@
 #include "testksuserdb.h"
 #include "../testhelpers.h"
 #include "ksuserdb.h"
+#include "skycomponents/imageoverlaycomponent.h"
 
 TestKSUserDB::TestKSUserDB(QObject *parent) : QObject(parent)
 {
@@ -133,4 +134,178 @@ void TestKSUserDB::testCoordinates()
     QSKIP("Not implemented yet.");
 }
 
+void TestKSUserDB::testReplaceAllFlags()
+{
+    QScopedPointer<KSUserDB> testDB(new KSUserDB());
+    QVERIFY(QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).mkpath("."));
+    QVERIFY(testDB->Initialize());
+
+    QList<QStringList> flags;
+    flags << (QStringList() << "10.5" << "-20.25" << "2000.0" << "Default" << "first" << "#ff0000");
+    flags << (QStringList() << "200" << "45" << "Jnow" << "Default" << "second" << "#00ff00");
+    QVERIFY(testDB->ReplaceAllFlags(flags));
+
+    QList<QStringList> stored;
+    QVERIFY(testDB->GetAllFlags(stored));
+    QCOMPARE(stored, flags);
+
+    // Replacing the flags removes the previous ones
+    flags.removeFirst();
+    QVERIFY(testDB->ReplaceAllFlags(flags));
+    stored.clear();
+    QVERIFY(testDB->GetAllFlags(stored));
+    QCOMPARE(stored, flags);
+
+    QVERIFY(testDB->ReplaceAllFlags({}));
+    stored.clear();
+    QVERIFY(testDB->GetAllFlags(stored));
+    QVERIFY(stored.isEmpty());
+}
+
+void TestKSUserDB::testAddImageOverlays()
+{
+    QScopedPointer<KSUserDB> testDB(new KSUserDB());
+    QVERIFY(QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).mkpath("."));
+    QVERIFY(testDB->Initialize());
+
+    QList<ImageOverlay> overlays;
+    overlays << ImageOverlay("m31.jpg", true, "", ImageOverlay::UNPROCESSED);
+    overlays << ImageOverlay("m42.jpg", true, "", ImageOverlay::UNPROCESSED);
+    QVERIFY(testDB->ReplaceAllImageOverlays(overlays));
+
+    // Solved overlays update their rows, new ones are added
+    QList<ImageOverlay> solved;
+    solved << ImageOverlay("m42.jpg", true, "", ImageOverlay::AVAILABLE, 12.5, 83.8, -5.4, 1.5, false, 4000, 3000);
+    solved << ImageOverlay("m45.jpg", true, "", ImageOverlay::PLATE_SOLVE_FAILURE);
+    QVERIFY(testDB->AddImageOverlays(solved));
+
+    QList<ImageOverlay> stored;
+    QVERIFY(testDB->GetAllImageOverlays(&stored));
+    QCOMPARE(stored.size(), 3);
+    QMap<QString, ImageOverlay> byName;
+    for (const auto &overlay : stored)
+        byName[overlay.m_Filename] = overlay;
+    QCOMPARE(byName["m31.jpg"].m_Status, ImageOverlay::UNPROCESSED);
+    QCOMPARE(byName["m42.jpg"].m_Status, ImageOverlay::AVAILABLE);
+    QCOMPARE(byName["m42.jpg"].m_RA, 83.8);
+    QCOMPARE(byName["m42.jpg"].m_DEC, -5.4);
+    QCOMPARE(byName["m42.jpg"].m_Width, 4000);
+    QCOMPARE(byName["m42.jpg"].m_EastToTheRight, false);
+    QCOMPARE(byName["m45.jpg"].m_Status, ImageOverlay::PLATE_SOLVE_FAILURE);
+
+    QVERIFY(testDB->ReplaceAllImageOverlays({}));
+}
+
+void TestKSUserDB::testAddDarkFrames()
+{
+    QScopedPointer<KSUserDB> testDB(new KSUserDB());
+    QVERIFY(QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).mkpath("."));
+    QVERIFY(testDB->Initialize());
+
+    QList<QVariantMap> before;
+    QVERIFY(testDB->GetAllDarkFrames(before));
+
+    QList<QVariantMap> frames;
+    for (int i = 0; i < 3; i++)
+    {
+        QVariantMap frame;
+        frame["ccd"] = "CCD Simulator";
+        frame["chip"] = 0;
+        frame["binX"] = i + 1;
+        frame["binY"] = i + 1;
+        frame["duration"] = 10.0 * (i + 1);
+        frame["filename"] = QString("dark_%1.fits").arg(i);
+        frames << frame;
+    }
+    // A frame with other keys than the previous ones
+    frames.last()["temperature"] = -10.0;
+    QVERIFY(testDB->AddDarkFrames(frames));
+
+    QList<QVariantMap> after;
+    QVERIFY(testDB->GetAllDarkFrames(after));
+    QCOMPARE(after.size(), before.size() + frames.size());
+    for (int i = 0; i < frames.size(); i++)
+    {
+        const QVariantMap &stored = after.at(before.size() + i);
+        QCOMPARE(stored["filename"].toString(), frames[i]["filename"].toString());
+        QCOMPARE(stored["binX"].toInt(), frames[i]["binX"].toInt());
+        QCOMPARE(stored["duration"].toDouble(), frames[i]["duration"].toDouble());
+    }
+    QCOMPARE(after.last()["temperature"].toDouble(), -10.0);
+
+    // A frame without the mandatory filename fails the whole batch
+    QVariantMap bad;
+    bad["ccd"] = "CCD Simulator";
+    QVERIFY(!testDB->AddDarkFrames(QList<QVariantMap>() << frames.first() << bad));
+    QList<QVariantMap> unchanged;
+    QVERIFY(testDB->GetAllDarkFrames(unchanged));
+    QCOMPARE(unchanged.size(), after.size());
+}
+
+void TestKSUserDB::testFindDarkFrame()
+{
+    QScopedPointer<KSUserDB> testDB(new KSUserDB());
+    QVERIFY(QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).mkpath("."));
+    QVERIFY(testDB->Initialize());
+
+    auto frame = [](const QString & filename, int bin, int gain, double temperature, double duration)
+    {
+        QVariantMap map;
+        map["ccd"] = "Find Camera";
+        map["chip"] = 0;
+        map["binX"] = bin;
+        map["binY"] = bin;
+        map["gain"] = gain;
+        map["temperature"] = temperature;
+        map["duration"] = duration;
+        map["filename"] = filename;
+        return map;
+    };
+
+    QVERIFY(testDB->AddDarkFrames(QList<QVariantMap>()
+                                  << frame("bin2.fits", 2, 100, -10, 60)
+                                  << frame("short.fits", 1, 100, -10, 30)
+                                  << frame("long.fits", 1, 100, -10, 120)
+                                  << frame("warm.fits", 1, 100, 5, 60)
+                                  << frame("gain0.fits", 1, 0, -10, 60)));
+
+    KSUserDB::DarkFrameCriteria criteria;
+    criteria.ccd = "Find Camera";
+    criteria.gain = 100;
+    criteria.duration = 60;
+    criteria.temperature = -10;
+
+    // Without a temperature threshold the closest duration wins
+    QVariantMap found;
+    QVERIFY(testDB->FindDarkFrame(criteria, found));
+    QCOMPARE(found["filename"].toString(), QString("warm.fits"));
+
+    // The warm frame is rejected with a threshold
+    criteria.maxTemperatureDiff = 1;
+    QVERIFY(testDB->FindDarkFrame(criteria, found));
+    QCOMPARE(found["filename"].toString(), QString("short.fits"));
+
+    criteria.duration = 100;
+    QVERIFY(testDB->FindDarkFrame(criteria, found));
+    QCOMPARE(found["filename"].toString(), QString("long.fits"));
+
+    // Any gain
+    criteria.gain = -1;
+    criteria.duration = 60;
+    QVERIFY(testDB->FindDarkFrame(criteria, found));
+    QCOMPARE(found["filename"].toString(), QString("gain0.fits"));
+
+    criteria.binX = criteria.binY = 2;
+    QVERIFY(testDB->FindDarkFrame(criteria, found));
+    QCOMPARE(found["filename"].toString(), QString("bin2.fits"));
+
+    criteria.binX = criteria.binY = 3;
+    QVERIFY(!testDB->FindDarkFrame(criteria, found));
+
+    // None of the frames has a defect map
+    criteria.binX = criteria.binY = 1;
+    criteria.defectMapOnly = true;
+    QVERIFY(!testDB->FindDarkFrame(criteria, found));
+}
+
 QTEST_GUILESS_MAIN(TestKSUserDB)
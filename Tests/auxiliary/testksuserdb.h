@@ -37,6 +37,10 @@ private slots:
     void testCreateProfilees();
     void testCreateDatabase();
     void testCoordinates();
+    void testReplaceAllFlags();
+    void testAddImageOverlays();
+    void testAddDarkFrames();
+    void testFindDarkFrame();
 };
 
 #endif // TESTKSUSERDB_H
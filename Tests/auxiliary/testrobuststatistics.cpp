@@ -0,0 +1,95 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for robuststatistics.h
+*/
+
+#include "testrobuststatistics.h"
+#include "auxiliary/robuststatistics.h"
+
+#include <QRandomGenerator>
+#include <QTest>
+
+using namespace Mathematics::RobustStatistics;
+
+namespace
+{
+// Reference median, averaging the middle values for even sizes.
+double sortedMedian(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    const size_t n = values.size();
+    return (n % 2) ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2.0;
+}
+
+double sortedMAD(const std::vector<double> &values)
+{
+    const double median = sortedMedian(values);
+    std::vector<double> deviations;
+    for (auto v : values)
+        deviations.push_back(std::fabs(v - median));
+    return sortedMedian(deviations);
+}
+}
+
+TestRobustStatistics::TestRobustStatistics(QObject * parent): QObject(parent)
+{
+}
+
+void TestRobustStatistics::testHistogramStatistics_data()
+{
+    QTest::addColumn<int>("SIZE");
+    QTest::addColumn<int>("RANGE");
+    QTest::addColumn<int>("SAMPLEBY");
+
+    QTest::newRow("single") << 1 << 100 << 1;
+    QTest::newRow("odd") << 1001 << 4000 << 1;
+    QTest::newRow("even") << 1000 << 4000 << 1;
+    QTest::newRow("narrow") << 20000 << 10 << 1;
+    QTest::newRow("subsampled") << 100000 << 65535 << 7;
+}
+
+void TestRobustStatistics::testHistogramStatistics()
+{
+    QFETCH(int, SIZE);
+    QFETCH(int, RANGE);
+    QFETCH(int, SAMPLEBY);
+
+    QRandomGenerator generator(SIZE);
+    std::vector<uint16_t> data(SIZE);
+    std::vector<double> reference;
+    for (int i = 0; i < SIZE; i++)
+    {
+        data[i] = generator.bounded(RANGE);
+        if (i % SAMPLEBY == 0)
+            reference.push_back(data[i]);
+    }
+
+    // 16 bit samples are counted per value so results must be exact
+    const HistogramStatistics stats = ComputeHistogramStatistics(data.data(), data.size(), SAMPLEBY);
+    QCOMPARE(stats.binWidth, 1.0);
+    QCOMPARE(stats.median, sortedMedian(reference));
+    QCOMPARE(stats.mad, sortedMAD(reference));
+}
+
+void TestRobustStatistics::testHistogramStatisticsWideRange()
+{
+    QRandomGenerator generator(42);
+    std::vector<int32_t> data(50000);
+    std::vector<double> reference;
+    for (auto &value : data)
+    {
+        value = generator.bounded(10000000) - 2000000;
+        reference.push_back(value);
+    }
+
+    // Wider samples are binned, so results are only bounded by the bin width
+    const HistogramStatistics stats = ComputeHistogramStatistics(data.data(), data.size());
+    QVERIFY(stats.binWidth > 1);
+    QVERIFY(std::fabs(stats.median - sortedMedian(reference)) <= stats.binWidth);
+    QVERIFY(std::fabs(stats.mad - sortedMAD(reference)) <= stats.binWidth);
+}
+
+QTEST_GUILESS_MAIN(TestRobustStatistics)
@@ -0,0 +1,23 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for robuststatistics.h
+*/
+
+#pragma once
+
+#include <QObject>
+
+class TestRobustStatistics: public QObject
+{
+        Q_OBJECT
+    public:
+        explicit TestRobustStatistics(QObject * parent = nullptr);
+
+    private slots:
+        void testHistogramStatistics_data();
+        void testHistogramStatistics();
+        void testHistogramStatisticsWideRange();
+};
@@ -0,0 +1,177 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for tracer.h
+*/
+
+#include "testtracer.h"
+
+#include "auxiliary/tracer.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+#include <QThread>
+#include <QtConcurrent>
+#include <QtTest>
+
+namespace
+{
+// The complete events named @p name in the exported trace
+QList<QJsonObject> spans(const char *name)
+{
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson(Tracer::toChromeJSON(), &error);
+    if (error.error != QJsonParseError::NoError)
+        return QList<QJsonObject>();
+
+    QList<QJsonObject> result;
+    for (const QJsonValue &value : document.object()["traceEvents"].toArray())
+    {
+        const QJsonObject event = value.toObject();
+        if (event["ph"].toString() == "X" && event["name"].toString() == name)
+            result.append(event);
+    }
+    return result;
+}
+}
+
+TestTracer::TestTracer(QObject *parent) : QObject(parent)
+{
+}
+
+void TestTracer::init()
+{
+    Tracer::setEnabled(true);
+    Tracer::clear();
+}
+
+void TestTracer::cleanupTestCase()
+{
+    Tracer::setEnabled(false);
+}
+
+void TestTracer::testDisabled()
+{
+    Tracer::setEnabled(false);
+    {
+        KSTARS_TRACE_SPAN("test", "Disabled");
+    }
+    // A span opened while disabled is not recorded, even if tracing is enabled before it closes
+    {
+        KSTARS_TRACE_SPAN("test", "Enabled late");
+        Tracer::setEnabled(true);
+    }
+    QVERIFY(spans("Disabled").isEmpty());
+    QVERIFY(spans("Enabled late").isEmpty());
+}
+
+void TestTracer::testNestedSpans()
+{
+    {
+        KSTARS_TRACE_SPAN("test", "Outer");
+        QThread::msleep(2);
+        {
+            KSTARS_TRACE_SPAN("test", "Inner");
+            QThread::msleep(5);
+        }
+        QThread::msleep(2);
+    }
+
+    const QList<QJsonObject> outer = spans("Outer");
+    const QList<QJsonObject> inner = spans("Inner");
+    QCOMPARE(outer.size(), 1);
+    QCOMPARE(inner.size(), 1);
+    QCOMPARE(outer[0]["cat"].toString(), QString("test"));
+    QCOMPARE(outer[0]["tid"].toInt(), inner[0]["tid"].toInt());
+
+    // Microseconds, the inner span lies within the outer one
+    QVERIFY(inner[0]["dur"].toDouble() >= 5000);
+    QVERIFY(outer[0]["dur"].toDouble() >= 9000);
+    QVERIFY(inner[0]["ts"].toDouble() >= outer[0]["ts"].toDouble());
+    QVERIFY(inner[0]["ts"].toDouble() + inner[0]["dur"].toDouble() <=
+            outer[0]["ts"].toDouble() + outer[0]["dur"].toDouble());
+
+    // Spans that end in a callback are recorded from their start time
+    const qint64 start = Tracer::now();
+    QThread::msleep(3);
+    Tracer::record("test", "Callback", start);
+    const QList<QJsonObject> callback = spans("Callback");
+    QCOMPARE(callback.size(), 1);
+    QVERIFY(callback[0]["dur"].toDouble() >= 3000);
+}
+
+void TestTracer::testThreads()
+{
+    QVector<int> jobs(32);
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+    QtConcurrent::blockingMap(&pool, jobs, [](int &)
+    {
+        KSTARS_TRACE_SPAN("test", "Job");
+        QThread::msleep(1);
+    });
+
+    const QList<QJsonObject> job = spans("Job");
+    QCOMPARE(job.size(), 32);
+
+    QSet<int> threads;
+    for (const QJsonObject &event : job)
+        threads.insert(event["tid"].toInt());
+    QVERIFY(threads.size() >= 1 && threads.size() <= 4);
+
+    // Each thread is named in the metadata
+    const QJsonDocument document = QJsonDocument::fromJson(Tracer::toChromeJSON());
+    QSet<int> named;
+    for (const QJsonValue &value : document.object()["traceEvents"].toArray())
+    {
+        const QJsonObject event = value.toObject();
+        if (event["ph"].toString() == "M" && event["name"].toString() == "thread_name")
+            named.insert(event["tid"].toInt());
+    }
+    for (int thread : threads)
+        QVERIFY(named.contains(thread));
+}
+
+void TestTracer::testRingBuffer()
+{
+    for (int i = 0; i < 10000; ++i)
+    {
+        KSTARS_TRACE_SPAN("test", "Many");
+    }
+
+    // The oldest spans were overwritten, the buffer holds the last ones
+    const QList<QJsonObject> many = spans("Many");
+    QVERIFY(!many.isEmpty());
+    QVERIFY(many.size() < 10000);
+
+    {
+        KSTARS_TRACE_SPAN("test", "Last");
+    }
+    QCOMPARE(spans("Last").size(), 1);
+}
+
+void TestTracer::testClear()
+{
+    {
+        KSTARS_TRACE_SPAN("test", "Before");
+    }
+    Tracer::clear();
+    {
+        KSTARS_TRACE_SPAN("test", "After");
+    }
+    QVERIFY(spans("Before").isEmpty());
+    QCOMPARE(spans("After").size(), 1);
+
+    QTemporaryDir dir;
+    const QString filename = dir.filePath("trace.json");
+    QVERIFY(Tracer::exportTrace(filename));
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QVERIFY(QJsonDocument::fromJson(file.readAll()).object().contains("traceEvents"));
+}
+
+QTEST_GUILESS_MAIN(TestTracer)
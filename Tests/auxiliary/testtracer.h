@@ -0,0 +1,28 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+
+    Test for tracer.h
+*/
+
+#pragma once
+
+#include <QObject>
+
+class TestTracer: public QObject
+{
+        Q_OBJECT
+    public:
+        explicit TestTracer(QObject * parent = nullptr);
+
+    private slots:
+        void init();
+        void cleanupTestCase();
+
+        void testDisabled();
+        void testNestedSpans();
+        void testThreads();
+        void testRingBuffer();
+        void testClear();
+};
@@ -0,0 +1,140 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ekos/capture/flatexposurestore.h"
+
+#include <QTest>
+
+#include <QObject>
+
+using Ekos::FlatExposureStore;
+
+class TestFlatExposureStore : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestFlatExposureStore();
+
+        /** @short Destructor */
+        ~TestFlatExposureStore() override = default;
+
+    private slots:
+        void storeTest();
+        void panelPredictionTest();
+        void skyPredictionTest();
+};
+
+#include "test_flatexposurestore.moc"
+
+namespace
+{
+constexpr qint64 NIGHT = 1700000000;
+
+FlatExposureStore::Flat makeFlat(const QString &filter, bool skyFlat, double exposure, double adu, qint64 time,
+                                 const QPoint &binning = QPoint(1, 1))
+{
+    FlatExposureStore::Flat flat;
+    flat.camera = "CCD Simulator";
+    flat.filter = filter;
+    flat.binning = binning;
+    flat.skyFlat = skyFlat;
+    flat.exposure = exposure;
+    flat.adu = adu;
+    flat.time = time;
+    return flat;
+}
+}  // namespace
+
+TestFlatExposureStore::TestFlatExposureStore() : QObject()
+{
+}
+
+void TestFlatExposureStore::storeTest()
+{
+    FlatExposureStore store(QStringList{});
+    QVERIFY(store.isEmpty());
+    QCOMPARE(store.predict("CCD Simulator", "L", QPoint(1, 1), false, 20000, NIGHT), -1.0);
+
+    // Names with the separators survive
+    FlatExposureStore::Flat flat = makeFlat("Ha;7nm", false, 2.5, 20000, NIGHT);
+    flat.camera = "ZWO|CCD";
+    store.add(flat);
+    store.add(makeFlat("L", false, 0.1, 20000, NIGHT));
+    // Replaces the flat of the same filter, binning and source
+    store.add(makeFlat("L", false, 0.2, 21000, NIGHT + 10));
+    store.add(makeFlat("L", true, 1.0, 30000, NIGHT + 20));
+    store.add(makeFlat("L", false, 0.05, 20000, NIGHT + 30, QPoint(2, 2)));
+    // Invalid flats are not kept
+    store.add(makeFlat("R", false, 0, 20000, NIGHT));
+    QCOMPARE(store.entries().size(), 4);
+
+    // Unreadable entries are ignored
+    QStringList entries = store.entries();
+    entries.append("garbage");
+    FlatExposureStore restored(entries);
+    const auto flats = restored.flats("ZWO|CCD", QPoint(1, 1));
+    QCOMPARE(flats.size(), 1);
+    QCOMPARE(flats[0].filter, QString("Ha;7nm"));
+    QCOMPARE(flats[0].exposure, 2.5);
+    QCOMPARE(flats[0].adu, 20000.0);
+    QCOMPARE(flats[0].skyFlat, false);
+    QCOMPARE(flats[0].time, NIGHT);
+
+    const auto simulator = restored.flats("CCD Simulator", QPoint(1, 1));
+    QCOMPARE(simulator.size(), 2);
+    QCOMPARE(simulator[0].exposure, 0.2);
+    QCOMPARE(simulator[1].skyFlat, true);
+    QCOMPARE(restored.flats("CCD Simulator", QPoint(2, 2)).size(), 1);
+}
+
+// Panel flats are predicted from the flat of the same filter, whenever it was taken
+void TestFlatExposureStore::panelPredictionTest()
+{
+    FlatExposureStore store(QStringList{});
+    store.add(makeFlat("L", false, 0.5, 15000, NIGHT));
+
+    QCOMPARE(store.predict("CCD Simulator", "L", QPoint(1, 1), false, 30000, NIGHT + 86400 * 30), 1.0);
+    QCOMPARE(store.predict("CCD Simulator", "R", QPoint(1, 1), false, 30000, NIGHT), -1.0);
+    QCOMPARE(store.predict("CCD Simulator", "L", QPoint(2, 2), false, 30000, NIGHT), -1.0);
+    QCOMPARE(store.predict("Other", "L", QPoint(1, 1), false, 30000, NIGHT), -1.0);
+}
+
+// Sky flats are predicted from the sky flat just taken, scaled by the response of the filters
+void TestFlatExposureStore::skyPredictionTest()
+{
+    FlatExposureStore store(QStringList{});
+    // Through the panel, Ha is 20 times darker than L
+    store.add(makeFlat("L", false, 0.5, 20000, NIGHT));
+    store.add(makeFlat("Ha", false, 10.0, 20000, NIGHT));
+    // A sky flat of the previous night doesn't tell tonight's sky
+    store.add(makeFlat("L", true, 2.0, 20000, NIGHT));
+    QCOMPARE(store.predict("CCD Simulator", "Ha", QPoint(1, 1), true, 20000, NIGHT + 86400), -1.0);
+
+    // L just took 1 s, so Ha should take 20 s
+    const qint64 now = NIGHT + 86400;
+    store.add(makeFlat("L", true, 1.0, 20000, now - 60));
+    QCOMPARE(store.predict("CCD Simulator", "Ha", QPoint(1, 1), true, 20000, now), 20.0);
+    QCOMPARE(store.predict("CCD Simulator", "L", QPoint(1, 1), true, 30000, now), 1.5);
+    // Too late
+    QCOMPARE(store.predict("CCD Simulator", "Ha", QPoint(1, 1), true, 20000,
+                           now + FlatExposureStore::SKY_VALIDITY), -1.0);
+    // No response of the filter
+    QCOMPARE(store.predict("CCD Simulator", "OIII", QPoint(1, 1), true, 20000, now), -1.0);
+
+    // Without panel flats, sky flats taken shortly after each other tell the response
+    FlatExposureStore sky(QStringList{});
+    sky.add(makeFlat("L", true, 1.0, 20000, NIGHT));
+    sky.add(makeFlat("R", true, 3.0, 20000, NIGHT + 120));
+    sky.add(makeFlat("L", true, 2.0, 20000, now));
+    QCOMPARE(sky.predict("CCD Simulator", "R", QPoint(1, 1), true, 20000, now + 60), -1.0);
+    sky.add(makeFlat("R", true, 3.0, 20000, now + 60));
+    sky.add(makeFlat("L", true, 1.0, 20000, now + 120));
+    QCOMPARE(sky.predict("CCD Simulator", "R", QPoint(1, 1), true, 20000, now + 180), 3.0);
+}
+
+QTEST_GUILESS_MAIN(TestFlatExposureStore)
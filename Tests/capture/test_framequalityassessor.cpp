@@ -0,0 +1,82 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <QTest>
+
+#include <QObject>
+#include "ekos/capture/framequalityassessor.h"
+#include "fitsviewer/fitsdata.h"
+
+#include <vector>
+
+using Ekos::FrameQualityAssessor;
+
+class TestFrameQualityAssessor : public QObject
+{
+        Q_OBJECT
+
+    public:
+        TestFrameQualityAssessor() : QObject() {}
+        ~TestFrameQualityAssessor() override = default;
+
+    private slots:
+        void binFrameTest();
+        void smallFrameTest();
+};
+
+#include "test_framequalityassessor.moc"
+
+namespace
+{
+QSharedPointer<FITSData> makeData(const std::vector<uint16_t> &image, uint16_t width, uint16_t height, int channels)
+{
+    QSharedPointer<FITSData> data(new FITSData());
+    FITSImage::Statistic stats;
+    stats.dataType = TUSHORT;
+    stats.bytesPerPixel = sizeof(uint16_t);
+    stats.channels = channels;
+    stats.width = width;
+    stats.height = height;
+    stats.samples_per_channel = width * height;
+    stats.size = stats.samples_per_channel * channels * sizeof(uint16_t);
+    uint8_t *buffer = data->createImageBuffer(stats);
+    memcpy(buffer, image.data(), stats.size);
+    return data;
+}
+}
+
+// Two channels of 5x4 binned 2x2, the last column is dropped
+void TestFrameQualityAssessor::binFrameTest()
+{
+    const uint16_t width = 5, height = 4;
+    std::vector<uint16_t> image(width * height * 2);
+    for (int c = 0; c < 2; c++)
+        for (int y = 0; y < height; y++)
+            for (int x = 0; x < width; x++)
+                image[c * width * height + y * width + x] = c * 100 + y * 10 + x;
+
+    QSharedPointer<FITSData> binned = FrameQualityAssessor::binFrame(makeData(image, width, height, 2), 2);
+    QVERIFY(binned);
+    const FITSImage::Statistic &stats = binned->getStatistics();
+    QCOMPARE(stats.width, uint16_t(2));
+    QCOMPARE(stats.height, uint16_t(2));
+    QCOMPARE(stats.channels, uint8_t(1));
+    QCOMPARE(stats.dataType, uint32_t(TFLOAT));
+
+    // Mean of the block of both channels: 50 + 10 * (2 * row + 0.5) + 2 * column + 0.5
+    const float *samples = reinterpret_cast<const float *>(binned->getImageBuffer());
+    for (int y = 0; y < 2; y++)
+        for (int x = 0; x < 2; x++)
+            QCOMPARE(samples[y * 2 + x], 50.0f + 10 * (2 * y + 0.5f) + 2 * x + 0.5f);
+}
+
+void TestFrameQualityAssessor::smallFrameTest()
+{
+    std::vector<uint16_t> image(3, 1);
+    QVERIFY(FrameQualityAssessor::binFrame(makeData(image, 3, 1, 1), 2).isNull());
+}
+
+QTEST_GUILESS_MAIN(TestFrameQualityAssessor)
@@ -0,0 +1,169 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ekos/capture/exposurecalculator/fileutilitycameradata.h"
+#include "ekos/capture/exposurecalculator/optimalsubexposurecalculator.h"
+
+#include <QTest>
+
+#include <QFile>
+#include <QObject>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+
+#include <cmath>
+
+using OptimalExposure::OptimalSubExposureCalculator;
+
+class TestOptimalSubExposure : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestOptimalSubExposure();
+
+        /** @short Destructor */
+        ~TestOptimalSubExposure() override = default;
+
+    private slots:
+        void initTestCase();
+        void cameraDataTest();
+        void subExposureTest();
+        void envelopeTest();
+
+    private:
+        QTemporaryDir m_Dir;
+};
+
+#include "test_optimalsubexposure.moc"
+
+namespace
+{
+// A mono camera of one read mode, with a read noise of readNoise0 at gain 0 and readNoise100 at gain 100
+QString writeCameraData(const QString &fileName, double readNoise0, double readNoise100)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+        return QString();
+    file.write(QString("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                       "<ExposureCalculatorCameraData>\n"
+                       "    <CameraDataClassVersion>1</CameraDataClassVersion>\n"
+                       "    <CameraId>Test Camera</CameraId>\n"
+                       "    <SensorType>MONOCHROME</SensorType>\n"
+                       "    <GainSelectionType>NORMAL</GainSelectionType>\n"
+                       "    <CameraGainSelections>\n"
+                       "        <GainSelection>0</GainSelection>\n"
+                       "        <GainSelection>100</GainSelection>\n"
+                       "    </CameraGainSelections>\n"
+                       "    <CameraGainReadMode>\n"
+                       "        <GainReadModeNumber>0</GainReadModeNumber>\n"
+                       "        <GainReadModeName>Standard</GainReadModeName>\n"
+                       "        <CameraGainReadNoise>\n"
+                       "            <GainReadNoiseValue><Gain>0</Gain><ReadNoise>%1</ReadNoise></GainReadNoiseValue>\n"
+                       "            <GainReadNoiseValue><Gain>100</Gain><ReadNoise>%2</ReadNoise></GainReadNoiseValue>\n"
+                       "        </CameraGainReadNoise>\n"
+                       "    </CameraGainReadMode>\n"
+                       "</ExposureCalculatorCameraData>\n").arg(readNoise0).arg(readNoise100).toUtf8());
+    return fileName;
+}
+
+// Dr Glover's optimal sub-exposure of a mono camera
+double expectedSubExposure(double readNoise, double skyQuality, double focalRatio, double filterCompensation,
+                           double noiseTolerance)
+{
+    const double cFactor = 1 / (std::pow((100 + noiseTolerance) / 100, 2) - 1);
+    const double rate = 1.25286030612621E+27 * std::pow(skyQuality, -19.3234809465887) * std::pow(focalRatio, -2) *
+                        filterCompensation;
+    return cFactor * readNoise * readNoise / rate;
+}
+
+bool near(double value, double expected)
+{
+    return std::fabs(value - expected) <= 1e-9 * std::fabs(expected);
+}
+}  // namespace
+
+TestOptimalSubExposure::TestOptimalSubExposure() : QObject()
+{
+}
+
+void TestOptimalSubExposure::initTestCase()
+{
+    // Keep the camera data cache out of the user's cache
+    QStandardPaths::setTestModeEnabled(true);
+    QVERIFY(m_Dir.isValid());
+}
+
+void TestOptimalSubExposure::cameraDataTest()
+{
+    const QString fileName = writeCameraData(m_Dir.filePath("Test_Camera.xml"), 3.0, 1.0);
+    QVERIFY(!fileName.isEmpty());
+
+    OptimalExposure::ImagingCameraData data;
+    QCOMPARE(OptimalExposure::FileUtilityCameraData::readCameraDataFile(fileName, &data), 0);
+    QCOMPARE(data.getCameraId(), QString("Test Camera"));
+    QCOMPARE(data.getSensorType(), OptimalExposure::SENSORTYPE_MONOCHROME);
+    QCOMPARE(data.getGainMin(), 0);
+    QCOMPARE(data.getGainMax(), 100);
+    QCOMPARE(data.getCameraGainReadModeVector().size(), 1);
+    QCOMPARE(data.getCameraGainReadModeVector()[0].getCameraGainReadNoiseVector().size(), 2);
+
+    // Read again from the cache
+    OptimalExposure::ImagingCameraData cached;
+    QCOMPARE(OptimalExposure::FileUtilityCameraData::readCameraDataFile(fileName, &cached), 0);
+    QCOMPARE(cached.getCameraId(), data.getCameraId());
+    QCOMPARE(cached.getCameraGainReadModeVector()[0].getCameraGainReadNoiseVector()[1].getReadNoise(), 1.0);
+
+    // A changed file is parsed again
+    writeCameraData(fileName, 3.0, 1.25);
+    QCOMPARE(OptimalExposure::FileUtilityCameraData::readCameraDataFile(fileName, &cached), 0);
+    QCOMPARE(cached.getCameraGainReadModeVector()[0].getCameraGainReadNoiseVector()[1].getReadNoise(), 1.25);
+
+    OptimalExposure::ImagingCameraData missing;
+    QVERIFY(OptimalExposure::FileUtilityCameraData::readCameraDataFile(m_Dir.filePath("missing.xml"), &missing) != 0);
+}
+
+void TestOptimalSubExposure::subExposureTest()
+{
+    const QString fileName = writeCameraData(m_Dir.filePath("Sub_Camera.xml"), 3.0, 1.0);
+    QVERIFY(!fileName.isEmpty());
+
+    // At a gain of the table, between two and beyond
+    QVERIFY(near(OptimalSubExposureCalculator::optimalSubExposure(fileName, 100, 0, 20.0, 5.0, 1.0, 5.0),
+                 expectedSubExposure(1.0, 20.0, 5.0, 1.0, 5.0)));
+    QVERIFY(near(OptimalSubExposureCalculator::optimalSubExposure(fileName, 50, 0, 20.0, 5.0, 1.0, 5.0),
+                 expectedSubExposure(2.0, 20.0, 5.0, 1.0, 5.0)));
+    QVERIFY(near(OptimalSubExposureCalculator::optimalSubExposure(fileName, 200, 0, 21.0, 4.0, 0.5, 2.0),
+                 expectedSubExposure(1.0, 21.0, 4.0, 0.5, 2.0)));
+
+    // No such read mode or camera
+    QCOMPARE(OptimalSubExposureCalculator::optimalSubExposure(fileName, 100, 1, 20.0, 5.0, 1.0, 5.0), -1.0);
+    QCOMPARE(OptimalSubExposureCalculator::optimalSubExposure(m_Dir.filePath("missing.xml"), 100, 0, 20.0, 5.0, 1.0, 5.0),
+             -1.0);
+}
+
+void TestOptimalSubExposure::envelopeTest()
+{
+    const QString fileName = writeCameraData(m_Dir.filePath("Envelope_Camera.xml"), 3.0, 1.0);
+    OptimalExposure::ImagingCameraData data;
+    QCOMPARE(OptimalExposure::FileUtilityCameraData::readCameraDataFile(fileName, &data), 0);
+
+    OptimalSubExposureCalculator calculator(5.0, 20.0, 5.0, 1.0, data);
+    const auto envelope = calculator.calculateCameraExposureEnvelope();
+    QCOMPARE(envelope.getASubExposureVector().size(), 2);
+    QVERIFY(near(envelope.getExposureTimeMax(), expectedSubExposure(3.0, 20.0, 5.0, 1.0, 5.0)));
+    QVERIFY(near(envelope.getExposureTimeMin(), expectedSubExposure(1.0, 20.0, 5.0, 1.0, 5.0)));
+
+    // The gain doesn't change the envelope, the sky does
+    calculator.setASelectedGain(50);
+    QCOMPARE(calculator.calculateCameraExposureEnvelope().getExposureTimeMax(), envelope.getExposureTimeMax());
+    calculator.setASkyQuality(21.0);
+    QVERIFY(near(calculator.calculateCameraExposureEnvelope().getExposureTimeMax(),
+                 expectedSubExposure(3.0, 21.0, 5.0, 1.0, 5.0)));
+}
+
+QTEST_GUILESS_MAIN(TestOptimalSubExposure)
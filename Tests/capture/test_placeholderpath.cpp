@@ -745,6 +745,8 @@ void TestPlaceholderPath::testGetCompletedFileIds()
     auto placeholderPath = Ekos::PlaceholderPath(seqFilename);
     bool bm = true;
     placeholderPath.setGenerateFilenameSettings(job);
+    // As when a job starts
+    Ekos::PlaceholderPath::resetDirectoryIndex();
     int nextSequenceID;
     for (int id = 1; id < 4; id++)
     {
@@ -756,8 +758,24 @@ void TestPlaceholderPath::testGetCompletedFileIds()
         QDir path;
         path.mkpath(QFileInfo(filename).dir().path());
         QFile(filename).open(QIODevice::WriteOnly);
+        // As the camera does for the files it writes
+        Ekos::PlaceholderPath::addToDirectoryIndex(filename);
     }
 
+    // Files written by others are found once the directories are scanned again
+    QFile(placeholderPath.generateOutputFilename(true, bm, 10, ".fits", "")).open(QIODevice::WriteOnly);
+    QCOMPARE(placeholderPath.checkSeqBoundary(job), 4);
+    Ekos::PlaceholderPath::resetDirectoryIndex();
+    QCOMPARE(placeholderPath.checkSeqBoundary(job), 11);
+
+    // The scheduler counts the frames of a signature from the index too, here all the files of the directory
+    const QDir directory = QFileInfo(placeholderPath.generateOutputFilename(true, bm, 1, ".fits", "")).dir();
+    QCOMPARE(Ekos::PlaceholderPath::getCompletedFiles(directory.filePath(".*")), 4);
+    QFile(placeholderPath.generateOutputFilename(true, bm, 11, ".fits", "")).open(QIODevice::WriteOnly);
+    QCOMPARE(Ekos::PlaceholderPath::getCompletedFiles(directory.filePath(".*")), 4);
+    Ekos::PlaceholderPath::resetDirectoryIndex();
+    QCOMPARE(Ekos::PlaceholderPath::getCompletedFiles(directory.filePath(".*")), 5);
+
 #endif
 }
 
@@ -12,6 +12,9 @@
 #include "catalogsdb.h"
 #include "skymesh.h"
 
+#include <algorithm>
+#include <numeric>
+
 using namespace CatalogsDB;
 class TestCatalogsDB_DBManager : public QObject
 {
@@ -85,6 +88,45 @@ class TestCatalogsDB_DBManager : public QObject
         QVERIFY(num_obj > 0);
     }
 
+    void getting_objects_in_trixels()
+    {
+        const int num_trixels = SkyMesh::Create(m_manager.htmesh_level())->size();
+        std::vector<int> trixels(num_trixels);
+        std::iota(trixels.begin(), trixels.end(), 0);
+
+        TrixelObjectsMap objects, known_mag, unknown_mag;
+        QBENCHMARK
+        {
+            objects = m_manager.get_objects_in_trixels(trixels);
+        }
+        known_mag   = m_manager.get_objects_in_trixels_no_nulls(trixels);
+        unknown_mag = m_manager.get_objects_in_trixels_null_mag(trixels);
+
+        // objects of equal magnitude may come in any order
+        auto ids = [](const CatalogObjectVector &vector)
+        {
+            QList<QByteArray> list;
+            for (const auto &object : vector)
+                list << object.getObjectId();
+            std::sort(list.begin(), list.end());
+            return list;
+        };
+
+        QCOMPARE(objects.size(), trixels.size());
+        for (const int trixel : trixels)
+        {
+            const auto single = m_manager.get_objects_in_trixel(trixel);
+            QCOMPARE(ids(objects[trixel]), ids(single));
+            QCOMPARE(known_mag[trixel].size() + unknown_mag[trixel].size(), single.size());
+            QCOMPARE(ids(known_mag[trixel]),
+                     ids(m_manager.get_objects_in_trixel_no_nulls(trixel)));
+
+            const auto &known = known_mag[trixel];
+            QVERIFY(std::is_sorted(known.begin(), known.end(),
+                                   [](const auto &a, const auto &b) { return a.mag() < b.mag(); }));
+        }
+    }
+
     void find_by_name()
     {
         const auto &obj  = some_object();
@@ -93,6 +135,27 @@ class TestCatalogsDB_DBManager : public QObject
         QCOMPARE(obj.name(), objs.front().name());
     }
 
+    void find_by_prefix()
+    {
+        const auto &obj = some_object();
+        QBENCHMARK
+        {
+            m_manager.find_objects_by_prefix(obj.name().left(2), 10);
+        }
+
+        // the exact match ranks first
+        const auto &objs = m_manager.find_objects_by_prefix(obj.name(), 10);
+        QVERIFY(objs.size() > 0);
+        QCOMPARE(objs.front().name(), obj.name());
+
+        const auto &partial = m_manager.find_objects_by_prefix(obj.name().left(2), 10);
+        QVERIFY(partial.size() > 0);
+        QVERIFY(partial.size() <= 10);
+
+        QCOMPARE(m_manager.find_objects_by_prefix(obj.name(), 0).size(), 0);
+        QCOMPARE(m_manager.find_objects_by_prefix("  ", 10).size(), 0);
+    }
+
     void get_by_id()
     {
         const auto &obj     = some_object();
@@ -408,8 +471,15 @@ class TestCatalogsDB_DBManager : public QObject
                                       111,         0 };
             });
 
-        auto success_add = m_manager.add_objects(cat.id, objects);
+        std::size_t done = 0;
+        auto success_add = m_manager.add_objects(
+            cat.id, objects, [&](const std::size_t objects_done, const std::size_t total) {
+                QVERIFY(objects_done > done);
+                QCOMPARE(total, objects.size());
+                done = objects_done;
+            });
         QVERIFY2(success_add.first, "Inserting an object worked.");
+        QCOMPARE(done, objects.size());
         QCOMPARE(m_manager.get_catalog_statistics(cat.id).second.total_count, num_objs);
 
         for (const auto &obj : objects)
@@ -448,6 +518,30 @@ class TestCatalogsDB_DBManager : public QObject
         QVERIFY(f1.result() && f2.result());
     }
 
+    void thread_readers()
+    {
+        // a file of its own, the readers outlive the test
+        QTemporaryDir dir;
+        const QString db_file = dir.filePath("readers.sqlite");
+        QVERIFY(QFile::copy(db_file_og, db_file));
+
+        auto &reader = thread_reader(db_file);
+        QCOMPARE(&reader, &thread_reader(db_file));
+        QVERIFY(reader.get_objects(99, 1).size() > 0);
+
+        auto other = QtConcurrent::run([&] {
+            auto &other_reader = thread_reader(db_file);
+            return &other_reader != &reader && other_reader.get_objects(99, 1).size() > 0;
+        });
+        other.waitForFinished();
+        QVERIFY2(other.result(), "Other threads get a connection of their own.");
+
+        const auto &success =
+            reader.add_object(user_catalog_id, SkyObject::STAR, dms{ 1 }, dms{ 0 },
+                              "read only", -1, "", "", 10, 11, 111, 0);
+        QVERIFY2(!success.first, "Readers can't write.");
+    }
+
     void statistics()
     {
         auto success_add =
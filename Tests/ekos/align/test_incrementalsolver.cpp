@@ -0,0 +1,219 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ekos/align/incrementalsolver.h"
+
+#include <QTest>
+
+#include <QObject>
+
+#include <cmath>
+
+using Ekos::IncrementalSolver;
+
+class TestIncrementalSolver : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestIncrementalSolver();
+
+        /** @short Destructor */
+        ~TestIncrementalSolver() override = default;
+
+    private slots:
+        void init();
+        void shiftTest();
+        void flipTest();
+        void rotatorTest();
+        void mismatchTest();
+
+    private:
+        IncrementalSolver m_Solver;
+        QVector<QPointF> m_Stars;
+};
+
+#include "test_incrementalsolver.moc"
+
+namespace
+{
+const QSize SIZE(3000, 2000);
+constexpr double PIXSCALE = 2.0;
+constexpr double ROTATION = 30.0 * M_PI / 180.0;
+
+// Deterministic star positions within the frame
+QVector<QPointF> randomStars(int count, uint32_t seed)
+{
+    QVector<QPointF> stars;
+    for (int i = 0; i < count; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        const double x = (seed >> 8) % 29000 / 10.0 + 50;
+        seed = seed * 1664525u + 1013904223u;
+        const double y = (seed >> 8) % 19000 / 10.0 + 50;
+        stars.append(QPointF(x, y));
+    }
+    return stars;
+}
+
+// The frame of stars seen from another pointing, where a frame pixel p is at rotation(p) + translation in
+// the reference. Some stars are lost, others appear, and all move a little.
+QVector<QPointF> frame(const QVector<QPointF> &reference, bool flipped, const QPointF &translation)
+{
+    const QVector<QPointF> spurious = randomStars(20, 42);
+    QVector<QPointF> stars;
+    for (int i = 0; i < reference.size(); ++i)
+    {
+        if (i % 10 == 3)
+            stars.append(spurious[i / 10 % spurious.size()]);
+        if (i % 7 == 5)
+            continue;
+        QPointF p = reference[i] - translation;
+        if (flipped)
+            p = -p;
+        p += QPointF(((i * 37) % 7 - 3) * 0.1, ((i * 11) % 7 - 3) * 0.1);
+        if (p.x() >= 0 && p.y() >= 0 && p.x() < SIZE.width() && p.y() < SIZE.height())
+            stars.append(p);
+    }
+    return stars;
+}
+
+// The frame of stars after the camera turned by angle radians about the center, where a frame pixel p is at
+// rotation(p - center) + center in the reference
+QVector<QPointF> rotatedFrame(const QVector<QPointF> &reference, double angle)
+{
+    const QPointF center(SIZE.width() / 2.0, SIZE.height() / 2.0);
+    const double c = std::cos(-angle), s = std::sin(-angle);
+    QVector<QPointF> stars;
+    for (int i = 0; i < reference.size(); ++i)
+    {
+        if (i % 7 == 5)
+            continue;
+        const QPointF d = reference[i] - center;
+        const QPointF p = QPointF(c * d.x() - s * d.y(), s * d.x() + c * d.y()) + center +
+                          QPointF(((i * 37) % 7 - 3) * 0.1, ((i * 11) % 7 - 3) * 0.1);
+        if (p.x() >= 0 && p.y() >= 0 && p.x() < SIZE.width() && p.y() < SIZE.height())
+            stars.append(p);
+    }
+    return stars;
+}
+
+// Sky position of a reference pixel, in degrees
+void expectedSky(const QPointF &pixel, double *ra, double *dec)
+{
+    const QPointF d = pixel - QPointF(SIZE.width() / 2.0, SIZE.height() / 2.0);
+    const double toRadians = M_PI / (180.0 * 3600.0);
+    const double xi = PIXSCALE * (std::cos(ROTATION) * d.x() - std::sin(ROTATION) * d.y()) * toRadians;
+    const double eta = PIXSCALE * (std::sin(ROTATION) * d.x() + std::cos(ROTATION) * d.y()) * toRadians;
+    const double ra0 = 83.8 * M_PI / 180, dec0 = -5.4 * M_PI / 180;
+    *dec = std::asin((std::sin(dec0) + eta * std::cos(dec0)) / std::sqrt(1 + xi * xi + eta * eta)) * 180 / M_PI;
+    *ra = (ra0 + std::atan2(xi, std::cos(dec0) - eta * std::sin(dec0))) * 180 / M_PI;
+}
+}  // namespace
+
+TestIncrementalSolver::TestIncrementalSolver() : QObject()
+{
+}
+
+void TestIncrementalSolver::init()
+{
+    m_Stars = randomStars(150, 7);
+
+    const IncrementalSolver::Solution solution {83.8, -5.4, 30.0, PIXSCALE, true};
+    const double toStandard[4] = {PIXSCALE * std::cos(ROTATION), -PIXSCALE * std::sin(ROTATION),
+                                  PIXSCALE * std::sin(ROTATION), PIXSCALE * std::cos(ROTATION)
+                                 };
+    m_Solver.setReference(m_Stars, SIZE, solution, toStandard);
+    QVERIFY(m_Solver.isValid());
+}
+
+// A re-centering slew of a few arcminutes
+void TestIncrementalSolver::shiftTest()
+{
+    const QPointF translation(120, -80);
+    IncrementalSolver::Solution result;
+    IncrementalSolver::Transform transform;
+    QVERIFY(m_Solver.solve(frame(m_Stars, false, translation), SIZE, &result, &transform));
+
+    QVERIFY(transform.matches >= IncrementalSolver::MIN_MATCHES);
+    QVERIFY(std::fabs(transform.translation.x() - translation.x()) < 0.5);
+    QVERIFY(std::fabs(transform.translation.y() - translation.y()) < 0.5);
+
+    double ra, dec;
+    expectedSky(QPointF(SIZE.width() / 2.0, SIZE.height() / 2.0) + translation, &ra, &dec);
+    QVERIFY(std::fabs(result.ra - ra) * std::cos(dec * M_PI / 180) * 3600 < 1.0);
+    QVERIFY(std::fabs(result.dec - dec) * 3600 < 1.0);
+    // North turns by a few arcseconds over the shift
+    QVERIFY(std::fabs(result.orientation - 30.0) < 0.05);
+    QVERIFY(std::fabs(result.pixscale - PIXSCALE) < 0.001);
+    QCOMPARE(result.eastToTheRight, true);
+}
+
+// The frame turns by half a turn after a meridian flip
+void TestIncrementalSolver::flipTest()
+{
+    const QPointF translation(3050, 2040);
+    IncrementalSolver::Solution result;
+    QVERIFY(m_Solver.solve(frame(m_Stars, true, translation), SIZE, &result));
+
+    double ra, dec;
+    expectedSky(translation - QPointF(SIZE.width() / 2.0, SIZE.height() / 2.0), &ra, &dec);
+    QVERIFY(std::fabs(result.ra - ra) * std::cos(dec * M_PI / 180) * 3600 < 1.0);
+    QVERIFY(std::fabs(result.dec - dec) * 3600 < 1.0);
+    QVERIFY(std::fabs(result.orientation + 150.0) < 0.05);
+    QVERIFY(std::fabs(result.pixscale - PIXSCALE) < 0.001);
+}
+
+// The rotator turned the camera by 50 degrees
+void TestIncrementalSolver::rotatorTest()
+{
+    const double angle = 50.0 * M_PI / 180.0;
+    const QVector<QPointF> stars = rotatedFrame(m_Stars, angle);
+
+    double rotation = 0;
+    int votes = 0;
+    QVERIFY(m_Solver.estimateRotation(stars, &rotation, &votes));
+    QVERIFY(votes >= IncrementalSolver::MIN_ROTATION_VOTES);
+    QVERIFY(std::fabs(rotation - angle) < 0.1 * M_PI / 180.0);
+    QVERIFY(!m_Solver.estimateRotation(randomStars(150, 1234), &rotation));
+
+    IncrementalSolver::Solution result;
+    IncrementalSolver::Transform transform;
+    QVERIFY(m_Solver.solve(stars, SIZE, &result, &transform));
+    QVERIFY(std::fabs(transform.rotation - angle) < 0.01 * M_PI / 180.0);
+
+    double ra, dec;
+    expectedSky(QPointF(SIZE.width() / 2.0, SIZE.height() / 2.0), &ra, &dec);
+    QVERIFY(std::fabs(result.ra - ra) * std::cos(dec * M_PI / 180) * 3600 < 1.0);
+    QVERIFY(std::fabs(result.dec - dec) * 3600 < 1.0);
+    QVERIFY(std::fabs(result.orientation + 20.0) < 0.05);
+
+    // Only none and half a turn are tried without the estimate
+    IncrementalSolver fixed = m_Solver;
+    fixed.setEstimateRotation(false);
+    QVERIFY(!fixed.solve(stars, SIZE, &result));
+}
+
+// Other fields and scales are left to the solver
+void TestIncrementalSolver::mismatchTest()
+{
+    IncrementalSolver::Solution result;
+    QVERIFY(!m_Solver.solve(randomStars(150, 1234), SIZE, &result));
+
+    QVector<QPointF> binned;
+    for (const auto &star : m_Stars)
+        binned.append(star / 2);
+    QVERIFY(!m_Solver.solve(binned, SIZE, &result));
+
+    QVERIFY(!m_Solver.solve(m_Stars.mid(0, IncrementalSolver::MIN_MATCHES - 1), SIZE, &result));
+
+    IncrementalSolver empty;
+    QVERIFY(!empty.isValid());
+    QVERIFY(!empty.solve(m_Stars, SIZE, &result));
+}
+
+QTEST_GUILESS_MAIN(TestIncrementalSolver)
@@ -0,0 +1,136 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ekos/analyze/analyzelogindex.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <QObject>
+
+#include <cmath>
+
+using Ekos::AnalyzeLogIndex;
+
+class TestAnalyzeLogIndex : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestAnalyzeLogIndex() = default;
+
+        /** @short Destructor */
+        ~TestAnalyzeLogIndex() override = default;
+
+    private slots:
+        void summaryTest();
+        void windowTest();
+        void appendTest();
+};
+
+#include "test_analyzelogindex.moc"
+
+namespace
+{
+const QByteArray sessionLog =
+    "#KStars version 3.7.0. Analyze log version 1.0.\n"
+    "\n"
+    "AnalyzeStartTime,2026-03-01 20:00:00.000,CET\n"
+    "GuideStats,10.0,1.000,0.000,100,0,50.0,1000.0,12\n"
+    "GuideStats,12.0,0.000,2.000,0,200,50.0,1000.0,12\n"
+    "CaptureStarting,20.0,60.000,L\n"
+    "CaptureComplete,80.0,60.000,L,2.500,/tmp/a.fits,100,1000,0.3\n"
+    "AutofocusAborted,90.0,L,0|0\n"
+    "GuideStats,100.0,3.000,4.000,0,0,50.0,1000.0,12\n"
+    "CaptureComplete,160.0,60.000,L,3.500,/tmp/b.fits,100,1000,0.3\n";
+
+bool writeLog(const QString &filename, const QByteArray &data, QIODevice::OpenMode mode = QIODevice::WriteOnly)
+{
+    QFile file(filename);
+    return file.open(mode) && file.write(data) == data.size();
+}
+}  // namespace
+
+void TestAnalyzeLogIndex::summaryTest()
+{
+    QTemporaryDir dir;
+    const QString filename = dir.filePath("ekos-test.analyze");
+    QVERIFY(writeLog(filename, sessionLog));
+
+    AnalyzeLogIndex index;
+    QVERIFY(index.load(filename));
+    QVERIFY(QFile::exists(AnalyzeLogIndex::indexFilename(filename)));
+
+    const AnalyzeLogIndex::Summary &summary = index.summary();
+    QCOMPARE(summary.startTime, QDateTime(QDate(2026, 3, 1), QTime(20, 0)));
+    QCOMPARE(summary.duration, 160.0);
+    QCOMPARE(summary.captures, 2);
+    QCOMPARE(summary.exposureSeconds, 120.0);
+    QCOMPARE(summary.meanHFR(), 3.0);
+    QCOMPARE(summary.autofocusRuns, 1);
+    QCOMPARE(summary.autofocusFailures, 1);
+    QCOMPARE(summary.guiding.samples, 3);
+    QCOMPARE(summary.guiding.raRMS(), std::sqrt(10.0 / 3));
+    QCOMPARE(summary.guiding.totalRMS(), std::sqrt(30.0 / 3));
+
+    // The saved index gives the same summary.
+    AnalyzeLogIndex saved;
+    QVERIFY(saved.load(filename));
+    QCOMPARE(saved.summary().guiding.samples, 3);
+    QCOMPARE(saved.summary().captures, 2);
+    QCOMPARE(saved.lines("CaptureStarting", 0, 1000).size(), 1);
+}
+
+void TestAnalyzeLogIndex::windowTest()
+{
+    QTemporaryDir dir;
+    const QString filename = dir.filePath("ekos-test.analyze");
+    QVERIFY(writeLog(filename, sessionLog));
+
+    AnalyzeLogIndex index;
+    QVERIFY(index.load(filename));
+
+    const QVector<QByteArray> lines = index.lines("GuideStats", 11, 200);
+    QCOMPARE(lines.size(), 2);
+    QCOMPARE(lines[0], QByteArray("GuideStats,12.0,0.000,2.000,0,200,50.0,1000.0,12"));
+
+    const AnalyzeLogIndex::Summary window = index.summary(50, 150);
+    QCOMPARE(window.duration, 100.0);
+    QCOMPARE(window.captures, 1);
+    QCOMPARE(window.meanHFR(), 2.5);
+    QCOMPARE(window.guiding.samples, 1);
+    QCOMPARE(window.guiding.totalRMS(), 5.0);
+}
+
+void TestAnalyzeLogIndex::appendTest()
+{
+    QTemporaryDir dir;
+    const QString filename = dir.filePath("ekos-test.analyze");
+
+    // The incomplete last line is only indexed once complete.
+    QVERIFY(writeLog(filename, sessionLog + "GuideStats,200.0,3.0"));
+    AnalyzeLogIndex index;
+    QVERIFY(index.load(filename));
+    QCOMPARE(index.summary().guiding.samples, 3);
+
+    QVERIFY(writeLog(filename, "00,4.000,0,0,50.0,1000.0,12\n", QIODevice::Append));
+    AnalyzeLogIndex extended;
+    QVERIFY(extended.load(filename));
+    QCOMPARE(extended.summary().guiding.samples, 4);
+    QCOMPARE(extended.summary().duration, 200.0);
+    QCOMPARE(extended.lines("GuideStats", 150, 250).size(), 1);
+
+    // A log replaced by another is indexed again.
+    QVERIFY(writeLog(filename, QByteArray(sessionLog).replace("20:00:00", "21:00:00")));
+    AnalyzeLogIndex replaced;
+    QVERIFY(replaced.load(filename));
+    QCOMPARE(replaced.summary().guiding.samples, 3);
+    QCOMPARE(replaced.summary().startTime.time(), QTime(21, 0));
+}
+
+QTEST_GUILESS_MAIN(TestAnalyzeLogIndex)
@@ -0,0 +1,148 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ekos/analyze/timeseries.h"
+#include "qcustomplot.h"
+
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <QObject>
+
+#include <cmath>
+
+using Ekos::TimeSeries;
+
+class TestTimeSeries : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestTimeSeries() = default;
+
+        /** @short Destructor */
+        ~TestTimeSeries() override = default;
+
+    private slots:
+        void appendTest();
+        void decimationTest();
+        void binaryLogTest();
+};
+
+#include "test_timeseries.moc"
+
+namespace
+{
+// A slow sine with a spike and a gap.
+void fill(TimeSeries &series, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        double value = std::sin(i / 1000.0);
+        if (i == count / 3)
+            value = 100;
+        if (i == count / 2)
+            value = qQNaN();
+        series.append(i, value);
+    }
+}
+}  // namespace
+
+void TestTimeSeries::appendTest()
+{
+    TimeSeries series;
+    QCOMPARE(series.findBegin(1), -1);
+
+    series.append(1, 10);
+    series.append(3, 30);
+    series.append(2, 20);
+    QCOMPARE(series.size(), 3);
+    QCOMPARE(series.time(1), 2.0);
+    QCOMPARE(series.value(2), 30.0);
+
+    // Same as QCPDataContainer::findBegin()
+    QCOMPARE(series.findBegin(0), 0);
+    QCOMPARE(series.findBegin(2), 0);
+    QCOMPARE(series.findBegin(2.5), 1);
+    QCOMPARE(series.findBegin(10), 2);
+}
+
+void TestTimeSeries::decimationTest()
+{
+    QCustomPlot plot;
+    QCPGraph *graph = plot.addGraph();
+
+    TimeSeries series;
+    fill(series, 1000000);
+
+    // Small ranges are plotted with all their samples, their neighbours and the extremes.
+    series.plot(graph, 10, 20, 1000);
+    QCOMPARE(graph->data()->size(), 11 + 2 + 2);
+    QCOMPARE(graph->data()->findBegin(10)->mainKey(), 9.0);
+
+    // The whole series is bounded by the width, and keeps the spike and the gap.
+    series.plot(graph, 0, 1000000, 1000);
+    QVERIFY(graph->data()->size() <= 3 * 2 * 1000 + 2);
+    bool foundSpike = false, foundGap = false;
+    for (auto it = graph->data()->constBegin(); it != graph->data()->constEnd(); ++it)
+    {
+        foundSpike |= it->mainValue() == 100;
+        foundGap |= qIsNaN(it->mainValue());
+    }
+    QVERIFY(foundSpike);
+    QVERIFY(foundGap);
+
+    // The extremes are kept out of the range, for the y-axis rescaling.
+    series.plot(graph, 500000, 500100, 1000);
+    bool foundRange = false;
+    QCOMPARE(graph->getValueRange(foundRange).upper, 100.0);
+    QVERIFY(graph->getValueRange(foundRange).lower < -0.99);
+}
+
+void TestTimeSeries::binaryLogTest()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString textLog = dir.filePath("test.analyze");
+    const QString binaryLog = dir.filePath("test.analyzeb");
+
+    QFile text(textLog);
+    QVERIFY(text.open(QIODevice::WriteOnly));
+    text.write("GuideStats,1,...\n");
+    text.close();
+
+    TimeSeries ra, dec;
+    fill(ra, 10000);
+    dec.append(5, 1);
+    const QByteArray events = "CaptureStarting,1,30,L\n";
+    QVERIFY(Ekos::BinaryLog::write(binaryLog, QFileInfo(textLog), 9999, {{"ra", &ra}, {"dec", &dec}}, events));
+    QVERIFY(Ekos::BinaryLog::isBinaryLog(binaryLog));
+    QVERIFY(!Ekos::BinaryLog::isBinaryLog(textLog));
+
+    TimeSeries raRead, decRead, unknown;
+    double lastTime = 0;
+    QByteArray eventsRead;
+    QVERIFY(Ekos::BinaryLog::read(binaryLog, QFileInfo(textLog), &lastTime,
+    {{"ra", &raRead}, {"dec", &decRead}, {"unknown", &unknown}}, &eventsRead));
+    QCOMPARE(lastTime, 9999.0);
+    QCOMPARE(eventsRead, events);
+    QCOMPARE(raRead.times(), ra.times());
+    QCOMPARE(raRead.size(), 10000);
+    QCOMPARE(raRead.value(10000 / 3), 100.0);
+    QVERIFY(qIsNaN(raRead.value(10000 / 2)));
+    QCOMPARE(decRead.size(), 1);
+    QVERIFY(unknown.isEmpty());
+
+    // A binary log is ignored once its text log changes.
+    QVERIFY(text.open(QIODevice::Append));
+    text.write("GuideStats,2,...\n");
+    text.close();
+    QVERIFY(!Ekos::BinaryLog::read(binaryLog, QFileInfo(textLog), &lastTime, {{"ra", &raRead}}, &eventsRead));
+    QVERIFY(raRead.isEmpty());
+}
+
+QTEST_MAIN(TestTimeSeries)
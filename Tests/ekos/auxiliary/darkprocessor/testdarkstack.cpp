@@ -0,0 +1,118 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <QTest>
+
+#include <QObject>
+#include <QTemporaryDir>
+#include "ekos/auxiliary/darkstack.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using Ekos::DarkStack;
+
+class TestDarkStack : public QObject
+{
+        Q_OBJECT
+
+    public:
+        TestDarkStack();
+        ~TestDarkStack() override = default;
+
+    private slots:
+        void combineSamplesTest();
+        void stackTest_data();
+        void stackTest();
+        void mismatchTest();
+};
+
+#include "testdarkstack.moc"
+
+TestDarkStack::TestDarkStack() : QObject()
+{
+}
+
+void TestDarkStack::combineSamplesTest()
+{
+    // A hot pixel hit in one of seven frames
+    const std::vector<float> values { 100, 102, 98, 101, 99, 100, 4000 };
+    auto combine = [&values](DarkStack::Method method)
+    {
+        std::vector<float> samples = values, deviations(values.size());
+        return DarkStack::combineSamples(samples.data(), deviations.data(), samples.size(), method, 3.0);
+    };
+
+    QVERIFY(std::fabs(combine(DarkStack::STACK_MEAN) - 4600 / 7.0) < 1e-3);
+    QCOMPARE(combine(DarkStack::STACK_MEDIAN), 100.0);
+    QCOMPARE(combine(DarkStack::STACK_SIGMA_CLIP), 100.0);
+    // The hit is clamped to 100 + 3 * 1.4826
+    QVERIFY(std::fabs(combine(DarkStack::STACK_WINSORIZED) - (600 + 100 + 3 * 1.4826) / 7.0) < 1e-3);
+
+    // Identical samples
+    std::vector<float> same(5, 7), deviations(5);
+    QCOMPARE(DarkStack::combineSamples(same.data(), deviations.data(), 5, DarkStack::STACK_SIGMA_CLIP, 3.0), 7.0);
+    // Too few samples to clip
+    std::vector<float> two { 10, 20 };
+    QCOMPARE(DarkStack::combineSamples(two.data(), deviations.data(), 2, DarkStack::STACK_SIGMA_CLIP, 3.0), 15.0);
+}
+
+void TestDarkStack::stackTest_data()
+{
+    QTest::addColumn<bool>("spill");
+
+    QTest::newRow("memory") << false;
+    QTest::newRow("scratch file") << true;
+}
+
+// Frames of more than one tile, with a bias that grows along the frame and a cosmic ray in each frame
+void TestDarkStack::stackTest()
+{
+    QFETCH(bool, spill);
+
+    const uint32_t elements = DarkStack::TILE_ELEMENTS * 2 + 123;
+    const int count = 9;
+    QTemporaryDir scratch;
+    QVERIFY(scratch.isValid());
+
+    // Room for two frames in memory when spilling
+    DarkStack stack(DarkStack::STACK_SIGMA_CLIP, 3.0);
+    stack.reset(elements, sizeof(uint16_t), spill ? elements * sizeof(uint16_t) * 2 : UINT64_MAX, scratch.path());
+    std::vector<uint16_t> frame(elements);
+    for (int f = 0; f < count; f++)
+    {
+        for (uint32_t i = 0; i < elements; i++)
+            frame[i] = 1000 + i % 500 + (i + f) % 3;
+        frame[(f * 7919) % elements] = 65535;
+        QVERIFY(stack.add(frame.data()));
+    }
+    QCOMPARE(stack.frames(), count);
+    QCOMPARE(stack.spilled(), spill);
+
+    std::vector<uint16_t> master(elements);
+    QVERIFY(stack.combine(master.data()));
+    for (uint32_t i = 0; i < elements; i++)
+        QVERIFY2(master[i] == 1000 + i % 500 + 1, qPrintable(QString("sample %1 is %2").arg(i).arg(master[i])));
+}
+
+void TestDarkStack::mismatchTest()
+{
+    DarkStack stack;
+    std::vector<uint16_t> frame(10, 1);
+    std::vector<float> floatFrame(10, 1);
+    QVERIFY(!stack.add(frame.data()));
+    QVERIFY(!stack.combine(frame.data()));
+
+    stack.reset(10, sizeof(uint16_t), UINT64_MAX);
+    QVERIFY(!stack.add(floatFrame.data()));
+    QVERIFY(stack.add(frame.data()));
+    QVERIFY(!stack.combine(floatFrame.data()));
+    QVERIFY(stack.combine(frame.data()));
+    QCOMPARE(frame[0], uint16_t(1));
+}
+
+QTEST_GUILESS_MAIN(TestDarkStack)
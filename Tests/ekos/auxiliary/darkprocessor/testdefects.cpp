@@ -6,6 +6,8 @@
 
 
 #include <QTest>
+#include <algorithm>
+#include <cmath>
 #include <memory>
 
 #include <QObject>
@@ -28,6 +30,7 @@ class TestDefects : public QObject
 
     private slots:
         void basicTest();
+        void thresholdTest();
 };
 
 #include "testdefects.moc"
@@ -96,4 +99,64 @@ void TestDefects::basicTest()
     }
 }
 
+// The pixels beyond the threshold of each aggressiveness are those of a scan of the frame
+void TestDefects::thresholdTest()
+{
+    const uint16_t width = 200, height = 150;
+    const double median = 1000, deviation = 10;
+
+    FITSImage::Statistic stats;
+    stats.dataType = TUSHORT;
+    stats.bytesPerPixel = sizeof(uint16_t);
+    stats.channels = 1;
+    stats.width = width;
+    stats.height = height;
+    stats.samples_per_channel = width * height;
+    stats.size = stats.samples_per_channel * stats.bytesPerPixel;
+    stats.median[0] = median;
+    stats.stddev[0] = deviation;
+
+    QSharedPointer<FITSData> dark(new FITSData());
+    auto *buffer = reinterpret_cast<uint16_t *>(dark->createImageBuffer(stats));
+    for (uint32_t i = 0; i < stats.samples_per_channel; i++)
+        buffer[i] = median;
+    // Hot and cold pixels of all strengths, and some on the edges that are left out
+    for (int i = 0; i < 300; i++)
+    {
+        const int x = 4 + (i * 37) % (width - 8), y = 4 + (i * 53) % (height - 8);
+        buffer[x + y * width] = (i % 3 == 0) ? median - 5 * (i % 100) : median + 5 * i;
+    }
+    buffer[1 + width] = 60000;
+    buffer[width * height - 2] = 0;
+
+    DefectMap map;
+    map.setDarkData(dark);
+    QVERIFY(std::is_sorted(map.hotPixels().cbegin(), map.hotPixels().cend()));
+    QVERIFY(std::is_sorted(map.coldPixels().cbegin(), map.coldPixels().cend()));
+
+    for (int aggressiveness : { 100, 90, 75, 50, 25, 1 })
+    {
+        map.setProperty("HotPixelAggressiveness", aggressiveness);
+        map.setProperty("ColdPixelAggressiveness", aggressiveness);
+        map.filterPixels();
+
+        const double sigma = 18.61742934980 * exp(-0.00052422221 * (aggressiveness - 9.89915467884) *
+                             (aggressiveness - 9.89915467884));
+        uint32_t hot = 0, cold = 0;
+        for (uint32_t y = 4; y < height - 4u; y++)
+            for (uint32_t x = 4; x < width - 4u; x++)
+            {
+                const uint16_t value = buffer[x + y * width];
+                if (value >= median + deviation * sigma)
+                    hot++;
+                else if (value < median - deviation * sigma)
+                    cold++;
+            }
+        QCOMPARE(map.hotCount(), hot);
+        QCOMPARE(map.coldCount(), cold);
+        QCOMPARE(static_cast<uint32_t>(std::distance(map.hotThreshold(), map.hotPixels().cend())), hot);
+        QCOMPARE(static_cast<uint32_t>(std::distance(map.coldPixels().cbegin(), map.coldThreshold())), cold);
+    }
+}
+
 QTEST_GUILESS_MAIN(TestDefects)
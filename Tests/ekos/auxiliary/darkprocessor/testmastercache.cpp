@@ -0,0 +1,95 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <QTest>
+
+#include <QObject>
+#include "ekos/auxiliary/mastercache.h"
+
+using Ekos::MasterCache;
+
+class TestMasterCache : public QObject
+{
+        Q_OBJECT
+
+    public:
+        TestMasterCache();
+        ~TestMasterCache() override = default;
+
+    private slots:
+        void evictionTest();
+        void countersTest();
+        void budgetTest();
+};
+
+#include "testmastercache.moc"
+
+TestMasterCache::TestMasterCache() : QObject()
+{
+}
+
+// Three frames of 1 MiB in a budget of 3 MiB
+void TestMasterCache::evictionTest()
+{
+    MasterCache<int> cache(3 << 20);
+    QVERIFY(cache.insert("a", QSharedPointer<int>::create(1), 1 << 20));
+    QVERIFY(cache.insert("b", QSharedPointer<int>::create(2), 1 << 20));
+    QVERIFY(cache.insert("c", QSharedPointer<int>::create(3), 1 << 20));
+    QCOMPARE(cache.count(), 3);
+    QCOMPARE(cache.bytes(), uint64_t(3 << 20));
+
+    // a is used again, so b is the least recently used
+    QSharedPointer<int> a = cache.find("a");
+    QVERIFY(a);
+    QVERIFY(cache.insert("d", QSharedPointer<int>::create(4), 1 << 20));
+    QVERIFY(cache.contains("a"));
+    QVERIFY(!cache.contains("b"));
+    QVERIFY(cache.contains("c"));
+    QVERIFY(cache.contains("d"));
+
+    // Evicted entries stay valid for their users
+    QSharedPointer<int> c = cache.find("c");
+    cache.remove("c");
+    QVERIFY(!cache.contains("c"));
+    QCOMPARE(*c, 3);
+    cache.clear();
+    QCOMPARE(cache.count(), 0);
+    QCOMPARE(*a, 1);
+}
+
+void TestMasterCache::countersTest()
+{
+    MasterCache<int> cache(1 << 20);
+    QVERIFY(!cache.find("a"));
+    cache.insert("a", QSharedPointer<int>::create(1), 100);
+    QCOMPARE(*cache.find("a"), 1);
+    QCOMPARE(*cache.find("a"), 1);
+    QVERIFY(!cache.find("b"));
+    QCOMPARE(cache.hits(), uint32_t(2));
+    QCOMPARE(cache.misses(), uint32_t(2));
+    // Small entries count as a KiB
+    QCOMPARE(cache.bytes(), uint64_t(1024));
+}
+
+void TestMasterCache::budgetTest()
+{
+    MasterCache<int> cache(1 << 20);
+    // Larger than the budget
+    QVERIFY(!cache.insert("a", QSharedPointer<int>::create(1), 2 << 20));
+    QVERIFY(!cache.contains("a"));
+
+    QVERIFY(cache.insert("b", QSharedPointer<int>::create(2), 512 << 10));
+    QVERIFY(cache.insert("c", QSharedPointer<int>::create(3), 512 << 10));
+    cache.setBudget(600 << 10);
+    QCOMPARE(cache.count(), 1);
+    QVERIFY(cache.contains("c"));
+
+    // No budget keeps nothing
+    cache.setBudget(0);
+    QCOMPARE(cache.count(), 0);
+}
+
+QTEST_GUILESS_MAIN(TestMasterCache)
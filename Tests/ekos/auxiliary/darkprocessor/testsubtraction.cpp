@@ -5,7 +5,10 @@
 */
 
 #include <QTest>
+#include <cstring>
 #include <memory>
+#include <random>
+#include <vector>
 
 #include <QObject>
 #include "fitsviewer/fitsdata.h"
@@ -21,6 +24,11 @@ class TestSubtraction : public QObject
 
     private slots:
         void basicTest();
+        void saturationTest();
+
+    private:
+        template <typename T>
+        void checkSubtraction(bool bigFrame, int dataType);
 };
 
 #include "testsubtraction.moc"
@@ -29,6 +37,57 @@ TestSubtraction::TestSubtraction() : QObject()
 {
 }
 
+namespace
+{
+// Wraps an image in a FITSData
+template <typename T>
+QSharedPointer<FITSData> makeData(const std::vector<T> &image, uint16_t width, uint16_t height, int dataType)
+{
+    QSharedPointer<FITSData> data(new FITSData());
+    FITSImage::Statistic stats;
+    stats.dataType = dataType;
+    stats.bytesPerPixel = sizeof(T);
+    stats.width = width;
+    stats.height = height;
+    stats.samples_per_channel = width * height;
+    stats.size = width * height * sizeof(T);
+    data->restoreStatistics(stats);
+
+    uint8_t *buffer = new uint8_t[stats.size];
+    memcpy(buffer, image.data(), stats.size);
+    data->setImageBuffer(buffer);
+    return data;
+}
+}
+
+// Subtracts a dark from a subframed light, which is large enough to be subtracted in parallel when bigFrame is set
+template <typename T>
+void TestSubtraction::checkSubtraction(bool bigFrame, int dataType)
+{
+    const uint16_t darkWidth = bigFrame ? 1400 : 200, darkHeight = bigFrame ? 1000 : 100;
+    const uint16_t width = darkWidth - 100, height = darkHeight - 50, offsetX = 30, offsetY = 17;
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> value(0, 2000);
+    std::vector<T> dark(darkWidth * darkHeight), light(width * height);
+    for (auto &d : dark)
+        d = value(rng);
+    for (auto &l : light)
+        l = value(rng);
+
+    auto darkData = makeData(dark, darkWidth, darkHeight, dataType);
+    auto lightData = makeData(light, width, height, dataType);
+    QPointer<Ekos::DarkProcessor> processor = new Ekos::DarkProcessor();
+    processor->subtractDarkData(darkData, lightData, offsetX, offsetY);
+
+    const T *result = reinterpret_cast<const T *>(lightData->getImageBuffer());
+    for (uint32_t y = 0; y < height; y++)
+        for (uint32_t x = 0; x < width; x++)
+        {
+            const T l = light[x + y * width], d = dark[(x + offsetX) + (y + offsetY) * darkWidth];
+            QCOMPARE(result[x + y * width], static_cast<T>(l > d ? l - d : 0));
+        }
+}
+
 void TestSubtraction::basicTest()
 {
     const QString filename = "../Tests/ekos/auxiliary/darkprocessor/hotpixels.fits";
@@ -56,5 +115,13 @@ void TestSubtraction::basicTest()
         QCOMPARE(buffer[i], 0);
 }
 
+// Pixels darker than the dark are clamped to zero
+void TestSubtraction::saturationTest()
+{
+    checkSubtraction<uint16_t>(true, TUSHORT);
+    checkSubtraction<uint16_t>(false, TUSHORT);
+    checkSubtraction<float>(true, TFLOAT);
+    checkSubtraction<uint8_t>(false, TBYTE);
+}
 
 QTEST_GUILESS_MAIN(TestSubtraction)
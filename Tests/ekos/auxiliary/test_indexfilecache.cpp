@@ -0,0 +1,52 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ekos/auxiliary/indexfilecache.h"
+
+#include <QTest>
+
+#include <QObject>
+
+using Ekos::IndexFileCache;
+
+class TestIndexFileCache : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestIndexFileCache() = default;
+
+        /** @short Destructor */
+        ~TestIndexFileCache() override = default;
+
+    private slots:
+        void skymarkSizeTest();
+        void selectTest();
+};
+
+#include "test_indexfilecache.moc"
+
+void TestIndexFileCache::skymarkSizeTest()
+{
+    QCOMPARE(IndexFileCache::skymarkSize("index-4107.fits"), 22.0);
+    QCOMPARE(IndexFileCache::skymarkSize("/data/index-5203-05.fits"), 8.0);
+    QCOMPARE(IndexFileCache::skymarkSize("index-4219.fits"), 2000.0);
+    QCOMPARE(IndexFileCache::skymarkSize("index-4220.fits"), -1.0);
+    QCOMPARE(IndexFileCache::skymarkSize("m31.fits"), -1.0);
+}
+
+void TestIndexFileCache::selectTest()
+{
+    const QStringList files {"index-4103.fits", "index-4107.fits", "index-4108.fits", "index-4110.fits", "index-4112.fits"};
+
+    // Required quads of 24' to 54' first, then the recommended ones of 6' to 60'
+    QCOMPARE(IndexFileCache::selectIndexFiles(files, 60),
+             QStringList({"index-4108.fits", "index-4107.fits", "index-4110.fits"}));
+    QVERIFY(IndexFileCache::selectIndexFiles(files, 0).isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestIndexFileCache)
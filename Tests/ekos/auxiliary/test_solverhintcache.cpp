@@ -0,0 +1,139 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ekos/auxiliary/solverhintcache.h"
+
+#include <QTest>
+
+#include <QObject>
+
+using Ekos::SolverHintCache;
+
+class TestSolverHintCache : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestSolverHintCache();
+
+        /** @short Destructor */
+        ~TestSolverHintCache() override = default;
+
+    private slots:
+        void regionTest();
+        void storeTest();
+        void findTest();
+};
+
+#include "test_solverhintcache.moc"
+
+namespace
+{
+SolverHintCache::Hint makeHint(const QString &train, double ra, double dec, int index, int healpix)
+{
+    SolverHintCache::Hint hint;
+    hint.train = train;
+    hint.ra = ra;
+    hint.dec = dec;
+    hint.index = index;
+    hint.healpix = healpix;
+    hint.scale = 1.5;
+    hint.parity = 2;
+    hint.time = 1700000000;
+    return hint;
+}
+}  // namespace
+
+TestSolverHintCache::TestSolverHintCache() : QObject()
+{
+}
+
+void TestSolverHintCache::regionTest()
+{
+    QCOMPARE(SolverHintCache::region(10.1, 20.1), SolverHintCache::region(10.2, 20.2));
+    QVERIFY(SolverHintCache::region(10.1, 20.1) != SolverHintCache::region(14.1, 20.1));
+    QVERIFY(SolverHintCache::region(10.1, 20.1) != SolverHintCache::region(10.1, 24.1));
+    // Right ascensions wrap around
+    QCOMPARE(SolverHintCache::region(-0.1, 45), SolverHintCache::region(359.9, 45));
+    QCOMPARE(SolverHintCache::region(360.1, 45), SolverHintCache::region(0.1, 45));
+    // The poles belong to the last bands
+    QCOMPARE(SolverHintCache::region(0, 90), SolverHintCache::region(0, 89.5));
+    QCOMPARE(SolverHintCache::region(0, -90), SolverHintCache::region(0, -89.5));
+}
+
+void TestSolverHintCache::storeTest()
+{
+    SolverHintCache cache(QStringList{});
+    QVERIFY(cache.isEmpty());
+
+    // Names with the separators survive
+    cache.add(makeHint("Main|Scope;1", 83.8, -5.4, 4207, 10));
+    cache.add(makeHint("Guide", 83.8, -5.4, 4110, 2));
+    // Replaces the hint of the same train and region
+    cache.add(makeHint("Guide", 83.9, -5.3, 4111, 3));
+    // Invalid hints are not kept
+    cache.add(makeHint("Guide", 10, 10, -1, -1));
+    cache.add(makeHint("", 10, 10, 4207, 1));
+    QCOMPARE(cache.entries().size(), 2);
+
+    // Unreadable entries are ignored
+    QStringList entries = cache.entries();
+    entries.append("garbage");
+    entries.append("Guide|1;2;3");
+    SolverHintCache restored(entries);
+
+    SolverHintCache::Hint hint;
+    QVERIFY(restored.find("Main|Scope;1", 83.8, -5.4, &hint));
+    QCOMPARE(hint.train, QString("Main|Scope;1"));
+    QCOMPARE(hint.index, 4207);
+    QCOMPARE(hint.healpix, 10);
+    QCOMPARE(hint.scale, 1.5);
+    QCOMPARE(hint.parity, 2);
+    QCOMPARE(hint.time, 1700000000LL);
+
+    QVERIFY(restored.find("Guide", 83.8, -5.4, &hint));
+    QCOMPARE(hint.index, 4111);
+
+    // The oldest are dropped
+    SolverHintCache full(QStringList{});
+    for (int i = 0; i < SolverHintCache::MAX_ENTRIES + 10; ++i)
+        full.add(makeHint(QString("Train %1").arg(i), 100, 30, 4207, 1));
+    QCOMPARE(full.entries().size(), SolverHintCache::MAX_ENTRIES);
+    QVERIFY(!full.find("Train 0", 100, 30, &hint));
+    QVERIFY(full.find(QString("Train %1").arg(SolverHintCache::MAX_ENTRIES + 9), 100, 30, &hint));
+}
+
+void TestSolverHintCache::findTest()
+{
+    SolverHintCache cache(QStringList{});
+    cache.add(makeHint("Main", 10, 40, 4207, 1));
+    cache.add(makeHint("Main", 13, 40, 4207, 2));
+    cache.add(makeHint("Main", 359.5, 0, 4208, 3));
+
+    SolverHintCache::Hint hint;
+    // The closest hint around
+    QVERIFY(cache.find("Main", 11, 40, &hint));
+    QCOMPARE(hint.healpix, 1);
+    QVERIFY(cache.find("Main", 12.5, 40, &hint));
+    QCOMPARE(hint.healpix, 2);
+    // Across the origin of right ascensions
+    QVERIFY(cache.find("Main", 0.5, 0, &hint));
+    QCOMPARE(hint.healpix, 3);
+
+    // Too far, or of another train
+    QVERIFY(!cache.find("Main", 10, 45, &hint));
+    QVERIFY(!cache.find("Main", 200, 40, &hint));
+    QVERIFY(!cache.find("Guide", 10, 40, &hint));
+
+    // The hints around a failed solve are dropped
+    cache.remove("Main", 9.5, 40);
+    QVERIFY(!cache.find("Main", 10, 40, &hint));
+    QVERIFY(cache.find("Main", 13, 40, &hint));
+    QCOMPARE(hint.healpix, 2);
+}
+
+QTEST_GUILESS_MAIN(TestSolverHintCache)
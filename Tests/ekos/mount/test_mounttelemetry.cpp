@@ -0,0 +1,156 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ekos/mount/mounttelemetry.h"
+
+#include <QSignalSpy>
+#include <QTest>
+
+#include <QObject>
+
+using Ekos::MountTelemetry;
+
+class TestMountTelemetry : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestMountTelemetry() = default;
+
+        /** @short Destructor */
+        ~TestMountTelemetry() override = default;
+
+    private slots:
+        void computeTest();
+        void changeTest();
+        void rateTest();
+        void resetTest();
+};
+
+#include "test_mounttelemetry.moc"
+
+namespace
+{
+constexpr int UI_INTERVAL = 50;
+constexpr int ANALYZE_INTERVAL = 100;
+
+SkyPoint position(double ra, double dec)
+{
+    SkyPoint point;
+    point.setRA(ra);
+    point.setDec(dec);
+    point.setAlt(45);
+    point.setAz(180);
+    return point;
+}
+
+MountTelemetry::Snapshot snapshot(double haHours, double dec, ISD::Mount::PierSide pierSide = ISD::Mount::PIER_WEST)
+{
+    return MountTelemetry::compute(position(10, dec), pierSide, dms(haHours * 15));
+}
+
+MountTelemetry::Snapshot lastOf(const QSignalSpy &spy)
+{
+    return spy.last().first().value<MountTelemetry::Snapshot>();
+}
+}
+
+void TestMountTelemetry::computeTest()
+{
+    // West of the meridian
+    MountTelemetry::Snapshot west = snapshot(1, 20);
+    QCOMPARE(west.haHours, 1.0);
+    QVERIFY(west.haText.startsWith('+'));
+    QCOMPARE(west.pierSide, ISD::Mount::PIER_WEST);
+    QVERIFY(qAbs(west.altitude - 45) < 0.1);
+
+    // East of the meridian, shown with a sign
+    MountTelemetry::Snapshot east = snapshot(23, 20);
+    QCOMPARE(east.haHours, -1.0);
+    QVERIFY(east.haText.startsWith('-'));
+    QCOMPARE(east.haText.mid(1), west.haText.mid(1));
+}
+
+void TestMountTelemetry::changeTest()
+{
+    MountTelemetry::Snapshot previous = snapshot(1, 20);
+
+    // Nothing was delivered yet
+    QVERIFY(MountTelemetry::hasChanged(MountTelemetry::Snapshot(), previous));
+    previous.sequence = 1;
+
+    QVERIFY(!MountTelemetry::hasChanged(previous, snapshot(1 + 0.5 / 3600, 20 + 5.0 / 3600)));
+    QVERIFY(MountTelemetry::hasChanged(previous, snapshot(1 + 1.0 / 3600, 20)));
+    QVERIFY(MountTelemetry::hasChanged(previous, snapshot(1, 20 + 20.0 / 3600)));
+    QVERIFY(MountTelemetry::hasChanged(previous, snapshot(1, 20, ISD::Mount::PIER_EAST)));
+
+    // Across the meridian
+    MountTelemetry::Snapshot meridian = snapshot(24 - 0.2 / 3600, 20);
+    meridian.sequence = 1;
+    QVERIFY(!MountTelemetry::hasChanged(meridian, snapshot(0.2 / 3600, 20)));
+}
+
+void TestMountTelemetry::rateTest()
+{
+    MountTelemetry telemetry;
+    telemetry.setInterval(MountTelemetry::UI, UI_INTERVAL);
+    telemetry.setInterval(MountTelemetry::Analyze, ANALYZE_INTERVAL);
+
+    QSignalSpy all(&telemetry, &MountTelemetry::newSnapshot);
+    QSignalSpy changed(&telemetry, &MountTelemetry::snapshotChanged);
+    QSignalSpy ui(&telemetry, &MountTelemetry::uiSnapshot);
+    QSignalSpy analyze(&telemetry, &MountTelemetry::analyzeSnapshot);
+
+    // A fast driver reports ten positions, a tenth of a second of hour angle apart
+    for (int i = 0; i < 10; ++i)
+        telemetry.update(position(10, 20), ISD::Mount::PIER_WEST, dms((1 + i * 0.1 / 3600) * 15));
+
+    QCOMPARE(all.count(), 10);
+    QCOMPARE(lastOf(all).sequence, 10ull);
+    // The first one, then not before a full second of hour angle
+    QCOMPARE(changed.count(), 1);
+    // The first one right away, the last one once the interval ends
+    QCOMPARE(ui.count(), 1);
+    QCOMPARE(analyze.count(), 1);
+    QCOMPARE(lastOf(ui).sequence, 1ull);
+
+    QTRY_COMPARE_WITH_TIMEOUT(ui.count(), 2, 10 * UI_INTERVAL);
+    QTRY_COMPARE_WITH_TIMEOUT(analyze.count(), 2, 10 * ANALYZE_INTERVAL);
+    QCOMPARE(lastOf(ui).sequence, 10ull);
+    QCOMPARE(lastOf(analyze).sequence, 10ull);
+
+    // Nothing is repeated without new updates
+    QTest::qWait(2 * ANALYZE_INTERVAL);
+    QCOMPARE(ui.count(), 2);
+    QCOMPARE(analyze.count(), 2);
+
+    telemetry.update(position(10, 20), ISD::Mount::PIER_WEST, dms((1 + 1.5 / 3600) * 15));
+    QCOMPARE(changed.count(), 2);
+    QCOMPARE(ui.count(), 3);
+}
+
+void TestMountTelemetry::resetTest()
+{
+    MountTelemetry telemetry;
+    telemetry.setInterval(MountTelemetry::UI, UI_INTERVAL);
+    QSignalSpy changed(&telemetry, &MountTelemetry::snapshotChanged);
+    QSignalSpy ui(&telemetry, &MountTelemetry::uiSnapshot);
+
+    telemetry.update(position(10, 20), ISD::Mount::PIER_WEST, dms(15));
+    telemetry.update(position(10, 20), ISD::Mount::PIER_WEST, dms(15));
+    telemetry.reset();
+    QCOMPARE(telemetry.snapshot().sequence, 0ull);
+
+    // The pending update of the previous mount is dropped, the next mount starts afresh
+    QTest::qWait(2 * UI_INTERVAL);
+    QCOMPARE(ui.count(), 1);
+    telemetry.update(position(10, 20), ISD::Mount::PIER_WEST, dms(15));
+    QCOMPARE(changed.count(), 2);
+    QCOMPARE(ui.count(), 2);
+}
+
+QTEST_GUILESS_MAIN(TestMountTelemetry)
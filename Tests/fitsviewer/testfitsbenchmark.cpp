@@ -0,0 +1,458 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+/*
+ * This file contains benchmarks for the FITS pipeline: loading, statistics, histogram,
+ * debayering, stretching, star detection with each algorithm, HFR and dark subtraction.
+ * The frames are m47_sim_stars.fits tiled into 24, 62 and 100 megapixel images, the sizes
+ * of common APS-C, full frame and medium format sensors.
+ *
+ * The fastest iteration of every benchmark is written to fitsbenchmark.json, or to the
+ * file given in the FITS_BENCHMARK_JSON environment variable, next to the QTest output.
+ */
+
+#include "config-kstars.h"
+#include "fitsviewer/fitsdata.h"
+#include "fitsviewer/stretch.h"
+#include "Options.h"
+
+#ifdef HAVE_INDI
+#include "ekos/auxiliary/darkprocessor.h"
+#endif
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPointer>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <QObject>
+
+#include <algorithm>
+#include <limits>
+
+class TestFitsBenchmark : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestFitsBenchmark();
+
+        /** @short Destructor */
+        ~TestFitsBenchmark() override = default;
+
+    private slots:
+        void initTestCase();
+        void cleanupTestCase();
+
+        void loadFromFileBenchmark_data();
+        void loadFromFileBenchmark();
+        void calculateStatsBenchmark_data();
+        void calculateStatsBenchmark();
+        void constructHistogramBenchmark_data();
+        void constructHistogramBenchmark();
+        void debayerBenchmark_data();
+        void debayerBenchmark();
+        void stretchBenchmark_data();
+        void stretchBenchmark();
+        void findStarsBenchmark_data();
+        void findStarsBenchmark();
+        void bahtinovBenchmark();
+        void getHFRBenchmark_data();
+        void getHFRBenchmark();
+        void darkSubtractionBenchmark_data();
+        void darkSubtractionBenchmark();
+
+    private:
+        void addSizes();
+        /** @return the file of the tiled frame of the current row, written on first use */
+        QString frame(bool bayered = false);
+        QSharedPointer<FITSData> load(const QString &filename);
+        void record(qint64 nanoseconds);
+
+        QTemporaryDir m_Directory;
+        QMap<QString, QString> m_Frames;
+        QVector<float> m_Source;
+        int m_SourceWidth { 0 };
+        int m_SourceHeight { 0 };
+        QJsonArray m_Results;
+};
+
+#include "testfitsbenchmark.moc"
+
+namespace
+{
+const QString sourceFixture = "m47_sim_stars.fits";
+
+// Times the iterations of a QBENCHMARK, and keeps the fastest one.
+class IterationTimer
+{
+    public:
+        void start()
+        {
+            m_Timer.start();
+        }
+        void stop()
+        {
+            m_Fastest = std::min(m_Fastest, m_Timer.nsecsElapsed());
+        }
+        qint64 fastest() const
+        {
+            return m_Fastest;
+        }
+
+    private:
+        QElapsedTimer m_Timer;
+        qint64 m_Fastest { std::numeric_limits<qint64>::max() };
+};
+
+// Writes a 16-bit FITS file by hand, which is much faster than going through a FITSData.
+bool writeFITS(const QString &filename, int width, int height, const QVector<quint16> &pixels, bool bayered)
+{
+    QByteArray header;
+    auto card = [&header](const QString & keyword, const QString & value)
+    {
+        header.append(QString("%1= %2").arg(keyword, -8).arg(value, 20).leftJustified(80, ' ').toLatin1());
+    };
+    card("SIMPLE", "T");
+    card("BITPIX", "16");
+    card("NAXIS", "2");
+    card("NAXIS1", QString::number(width));
+    card("NAXIS2", QString::number(height));
+    card("BZERO", "32768");
+    card("BSCALE", "1");
+    if (bayered)
+        header.append(QString("BAYERPAT= 'RGGB    '").leftJustified(80, ' ').toLatin1());
+    header.append(QString("END").leftJustified(80, ' ').toLatin1());
+    header.append(QByteArray((2880 - header.size() % 2880) % 2880, ' '));
+
+    // Big-endian signed values, offset by BZERO
+    QByteArray data(pixels.size() * 2, Qt::Uninitialized);
+    for (int i = 0; i < pixels.size(); ++i)
+    {
+        const quint16 value = pixels[i] ^ 0x8000;
+        data[2 * i] = static_cast<char>(value >> 8);
+        data[2 * i + 1] = static_cast<char>(value & 0xFF);
+    }
+    data.append(QByteArray((2880 - data.size() % 2880) % 2880, '\0'));
+
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    return file.write(header) == header.size() && file.write(data) == data.size();
+}
+}  // namespace
+
+TestFitsBenchmark::TestFitsBenchmark() : QObject()
+{
+}
+
+void TestFitsBenchmark::initTestCase()
+{
+    Options::setStellarSolverPartition(true);
+    Options::setAutoDebayer(true);
+
+    if (!QFile::exists(sourceFixture))
+        QSKIP("Skipping benchmarks because of missing fixture");
+    QVERIFY(m_Directory.isValid());
+
+    // The pixels of the fixture are tiled into the larger frames
+    QSharedPointer<FITSData> source = load(sourceFixture);
+    QVERIFY(source);
+    m_Source = *source->getFloatBuffer();
+    m_SourceWidth = source->width();
+    m_SourceHeight = source->height();
+}
+
+void TestFitsBenchmark::cleanupTestCase()
+{
+    QString filename = qEnvironmentVariable("FITS_BENCHMARK_JSON");
+    if (filename.isEmpty())
+        filename = "fitsbenchmark.json";
+
+    QFile file(filename);
+    if (file.open(QIODevice::WriteOnly))
+        file.write(QJsonDocument(m_Results).toJson());
+}
+
+void TestFitsBenchmark::addSizes()
+{
+    QTest::addColumn<int>("WIDTH");
+    QTest::addColumn<int>("HEIGHT");
+
+    QTest::newRow("24MP") << 6000 << 4000;
+    QTest::newRow("62MP") << 9576 << 6388;
+    QTest::newRow("100MP") << 11664 << 8750;
+}
+
+QString TestFitsBenchmark::frame(bool bayered)
+{
+    QFETCH(int, WIDTH);
+    QFETCH(int, HEIGHT);
+
+    const QString name = QString("%1x%2%3.fits").arg(WIDTH).arg(HEIGHT).arg(bayered ? "-bayered" : "");
+    if (m_Frames.contains(name))
+        return m_Frames[name];
+
+    QVector<quint16> pixels(WIDTH * HEIGHT);
+    for (int y = 0; y < HEIGHT; ++y)
+    {
+        const float *row = m_Source.constData() + (y % m_SourceHeight) * m_SourceWidth;
+        for (int x = 0; x < WIDTH; ++x)
+            pixels[y * WIDTH + x] = static_cast<quint16>(std::clamp(row[x % m_SourceWidth], 0.0f, 65535.0f));
+    }
+
+    const QString filename = m_Directory.filePath(name);
+    if (!writeFITS(filename, WIDTH, HEIGHT, pixels, bayered))
+        return QString();
+    m_Frames[name] = filename;
+    return filename;
+}
+
+QSharedPointer<FITSData> TestFitsBenchmark::load(const QString &filename)
+{
+    QSharedPointer<FITSData> data(new FITSData());
+    QFuture<bool> worker = data->loadFromFile(filename);
+    worker.waitForFinished();
+    return worker.result() ? data : QSharedPointer<FITSData>();
+}
+
+void TestFitsBenchmark::record(qint64 nanoseconds)
+{
+    QJsonObject result;
+    result["benchmark"] = QString(QTest::currentTestFunction());
+    result["row"] = QString(QTest::currentDataTag());
+    result["milliseconds"] = nanoseconds / 1e6;
+    m_Results.append(result);
+}
+
+void TestFitsBenchmark::loadFromFileBenchmark_data()
+{
+    addSizes();
+}
+
+void TestFitsBenchmark::loadFromFileBenchmark()
+{
+    const QString filename = frame();
+    QVERIFY(!filename.isEmpty());
+
+    IterationTimer timer;
+    QBENCHMARK
+    {
+        timer.start();
+        QVERIFY(load(filename));
+        timer.stop();
+    }
+    record(timer.fastest());
+}
+
+void TestFitsBenchmark::calculateStatsBenchmark_data()
+{
+    addSizes();
+}
+
+void TestFitsBenchmark::calculateStatsBenchmark()
+{
+    QSharedPointer<FITSData> data = load(frame());
+    QVERIFY(data);
+
+    IterationTimer timer;
+    QBENCHMARK
+    {
+        timer.start();
+        data->calculateStats(true);
+        timer.stop();
+    }
+    record(timer.fastest());
+}
+
+void TestFitsBenchmark::constructHistogramBenchmark_data()
+{
+    addSizes();
+}
+
+void TestFitsBenchmark::constructHistogramBenchmark()
+{
+    QSharedPointer<FITSData> data = load(frame());
+    QVERIFY(data);
+
+    IterationTimer timer;
+    QBENCHMARK
+    {
+        timer.start();
+        data->resetHistogram();
+        data->constructHistogram();
+        timer.stop();
+    }
+    record(timer.fastest());
+}
+
+void TestFitsBenchmark::debayerBenchmark_data()
+{
+    addSizes();
+}
+
+void TestFitsBenchmark::debayerBenchmark()
+{
+    // The frame is debayered once as it is loaded, each iteration reads the bayered frame
+    // again from the file and debayers it.
+    QSharedPointer<FITSData> data = load(frame(true));
+    QVERIFY(data);
+    QVERIFY(data->hasDebayer());
+
+    IterationTimer timer;
+    QBENCHMARK
+    {
+        timer.start();
+        QVERIFY(data->debayer(true));
+        timer.stop();
+    }
+    record(timer.fastest());
+}
+
+void TestFitsBenchmark::stretchBenchmark_data()
+{
+    addSizes();
+}
+
+void TestFitsBenchmark::stretchBenchmark()
+{
+    QSharedPointer<FITSData> data = load(frame());
+    QVERIFY(data);
+
+    // As FITSView does with the auto stretch
+    QImage image(data->width(), data->height(), QImage::Format_Indexed8);
+    image.setColorCount(256);
+    for (int i = 0; i < 256; i++)
+        image.setColor(i, qRgb(i, i, i));
+
+    IterationTimer timer;
+    QBENCHMARK
+    {
+        timer.start();
+        Stretch stretch(data->width(), data->height(), data->channels(), data->dataType());
+        stretch.setParams(stretch.computeParams(data->getImageBuffer()));
+        stretch.run(data->getImageBuffer(), &image);
+        timer.stop();
+    }
+    record(timer.fastest());
+}
+
+void TestFitsBenchmark::findStarsBenchmark_data()
+{
+    QTest::addColumn<int>("WIDTH");
+    QTest::addColumn<int>("HEIGHT");
+    QTest::addColumn<int>("ALGORITHM");
+
+    const QList<QPair<QString, int>> algorithms =
+    {
+        {"centroid", ALGORITHM_CENTROID}, {"gradient", ALGORITHM_GRADIENT},
+        {"threshold", ALGORITHM_THRESHOLD}, {"SEP", ALGORITHM_SEP}
+    };
+    const QList<QPair<QString, QSize>> sizes =
+    {
+        {"24MP", QSize(6000, 4000)}, {"62MP", QSize(9576, 6388)}, {"100MP", QSize(11664, 8750)}
+    };
+    for (const auto &algorithm : algorithms)
+    {
+        for (const auto &size : sizes)
+            QTest::newRow(qPrintable(algorithm.first + "-" + size.first))
+                    << size.second.width() << size.second.height() << algorithm.second;
+    }
+}
+
+void TestFitsBenchmark::findStarsBenchmark()
+{
+    QFETCH(int, ALGORITHM);
+
+    QSharedPointer<FITSData> data = load(frame());
+    QVERIFY(data);
+
+    IterationTimer timer;
+    QBENCHMARK
+    {
+        timer.start();
+        data->findStars(static_cast<StarAlgorithm>(ALGORITHM)).waitForFinished();
+        timer.stop();
+    }
+    record(timer.fastest());
+}
+
+void TestFitsBenchmark::bahtinovBenchmark()
+{
+    // The Bahtinov detector only looks at the tracking box, so the size of the frame does not matter.
+    if (!QFile::exists("bahtinov-focus.fits"))
+        QSKIP("Skipping benchmark because of missing fixture");
+
+    QSharedPointer<FITSData> data = load("bahtinov-focus.fits");
+    QVERIFY(data);
+    const QRect trackingBox(204, 240, 128, 128);
+
+    IterationTimer timer;
+    QBENCHMARK
+    {
+        timer.start();
+        data->findStars(ALGORITHM_BAHTINOV, trackingBox).waitForFinished();
+        timer.stop();
+    }
+    record(timer.fastest());
+}
+
+void TestFitsBenchmark::getHFRBenchmark_data()
+{
+    addSizes();
+}
+
+void TestFitsBenchmark::getHFRBenchmark()
+{
+    QSharedPointer<FITSData> data = load(frame());
+    QVERIFY(data);
+    data->findStars(ALGORITHM_SEP).waitForFinished();
+    QVERIFY(data->getDetectedStars() > 0);
+
+    IterationTimer timer;
+    QBENCHMARK
+    {
+        timer.start();
+        data->getHFR(HFR_MEDIAN);
+        timer.stop();
+    }
+    record(timer.fastest());
+}
+
+void TestFitsBenchmark::darkSubtractionBenchmark_data()
+{
+    addSizes();
+}
+
+void TestFitsBenchmark::darkSubtractionBenchmark()
+{
+#ifdef HAVE_INDI
+    // The frame serves as its own dark, the light ends up black but the work is the same
+    QSharedPointer<FITSData> dark = load(frame());
+    QSharedPointer<FITSData> light = load(frame());
+    QVERIFY(dark && light);
+    QPointer<Ekos::DarkProcessor> processor = new Ekos::DarkProcessor();
+
+    IterationTimer timer;
+    QBENCHMARK
+    {
+        timer.start();
+        processor->subtractDarkData(dark, light, 0, 0);
+        timer.stop();
+    }
+    record(timer.fastest());
+    delete processor;
+#else
+    QSKIP("Dark subtraction needs INDI support");
+#endif
+}
+
+QTEST_GUILESS_MAIN(TestFitsBenchmark)
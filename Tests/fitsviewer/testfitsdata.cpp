@@ -5,6 +5,7 @@
 */
 
 #include <QTest>
+#include <cmath>
 #include <memory>
 #include "testfitsdata.h"
 #include "Options.h"
@@ -138,6 +139,216 @@ void TestFitsData::testBahtinovFocusHFR()
 #endif
 }
 
+void TestFitsData::testIncrementalDetection()
+{
+#if QT_VERSION < 0x050900
+    QSKIP("Skipping fixture-based test on old QT version.");
+#else
+    const QString filename = "m47_sim_stars.fits";
+    if (!QFile::exists(filename))
+        QSKIP("Skipping incremental detection test because of missing fixture");
+
+    std::unique_ptr<FITSData> d(new FITSData());
+    QFuture<bool> worker = d->loadFromFile(filename);
+    QTRY_VERIFY_WITH_TIMEOUT(worker.isFinished(), 10000);
+    QVERIFY(worker.result());
+
+    d->findStars(ALGORITHM_SEP).waitForFinished();
+    QList<Edge> seeds;
+    for (const Edge *star : d->getStarCenters())
+        seeds.append(*star);
+    QVERIFY(seeds.size() > 0);
+
+    // Seeded with slightly offset positions, as if the mount had drifted, the same stars must be found again.
+    QList<Edge> drifted = seeds;
+    for (auto &star : drifted)
+    {
+        star.x += 2;
+        star.y -= 1;
+    }
+    QVERIFY(d->findStars(drifted).result());
+    const auto centers = d->getStarCenters();
+    QVERIFY(centers.count() >= 0.75 * seeds.size());
+    for (const Edge *star : centers)
+    {
+        double closest = 1e10;
+        for (const auto &seed : seeds)
+            closest = std::min(closest, std::hypot(star->x - seed.x, star->y - seed.y));
+        QVERIFY(closest < 1.5);
+    }
+#endif
+}
+
+void TestFitsData::testFloatBuffer()
+{
+#if QT_VERSION < 0x050900
+    QSKIP("Skipping fixture-based test on old QT version.");
+#else
+    const QString filename = "m47_sim_stars.fits";
+    if (!QFile::exists(filename))
+        QSKIP("Skipping float buffer test because of missing fixture");
+
+    std::unique_ptr<FITSData> d(new FITSData());
+    QFuture<bool> worker = d->loadFromFile(filename);
+    QTRY_VERIFY_WITH_TIMEOUT(worker.isFinished(), 10000);
+    QVERIFY(worker.result());
+    QCOMPARE(d->dataType(), (uint32_t) TUSHORT);
+
+    const QRect roi(100, 50, 64, 32);
+    auto floats = d->getFloatBuffer(roi);
+    QVERIFY(floats);
+    QCOMPARE(floats->size(), roi.width() * roi.height());
+    auto const *pixels = reinterpret_cast<uint16_t const *>(d->getImageBuffer());
+    for (int y = 0; y < roi.height(); y++)
+        for (int x = 0; x < roi.width(); x++)
+            QCOMPARE(floats->at(y * roi.width() + x), static_cast<float>(pixels[(roi.y() + y) * d->width() + roi.x() + x]));
+
+    // Asking again for the same region does not convert again, until the image is written to.
+    QCOMPARE(d->getFloatBuffer(roi).data(), floats.data());
+    d->getWritableImageBuffer();
+    QVERIFY(d->getFloatBuffer(roi).data() != floats.data());
+
+    // The whole image, filled with the statistics, also serves the regions.
+    d->setFloatBufferWithStatistics(true);
+    d->calculateStats(true);
+    auto full = d->getFloatBuffer();
+    QVERIFY(full);
+    QCOMPARE(full->size(), static_cast<int>(d->samplesPerChannel() * d->channels()));
+    QCOMPARE(d->getFloatBuffer().data(), full.data());
+    QCOMPARE(*d->getFloatBuffer(roi), *floats);
+
+    // Binned blocks average the samples, read from the converted image or straight from the image buffer.
+    auto binned = d->getBinnedFloatBuffer(3, roi);
+    QVERIFY(binned);
+    QCOMPARE(binned->size(), (roi.width() / 3) * (roi.height() / 3));
+    for (int y = 0; y < roi.height() / 3; y++)
+        for (int x = 0; x < roi.width() / 3; x++)
+        {
+            double sum = 0;
+            for (int j = 0; j < 3; j++)
+                for (int i = 0; i < 3; i++)
+                    sum += pixels[(roi.y() + y * 3 + j) * d->width() + roi.x() + x * 3 + i];
+            QVERIFY(std::fabs(binned->at(y * (roi.width() / 3) + x) - sum / 9) <= 1e-3 * sum / 9 + 1e-3);
+        }
+    d->getWritableImageBuffer();
+    QCOMPARE(*d->getBinnedFloatBuffer(3, roi), *binned);
+    QVERIFY(!d->getBinnedFloatBuffer(0));
+    QVERIFY(!d->getBinnedFloatBuffer(2, QRect(-1, 0, 10, 10)));
+#endif
+}
+
+void TestFitsData::testStatisticsMedian_data()
+{
+    QTest::addColumn<bool>("FLOATS");
+    QTest::addColumn<int>("DATATYPE");
+
+    QTest::newRow("16-bit") << false << TUSHORT;
+    QTest::newRow("16-bit, float buffer") << true << TUSHORT;
+    QTest::newRow("float") << false << TFLOAT;
+    QTest::newRow("float, float buffer") << true << TFLOAT;
+}
+
+void TestFitsData::testStatisticsMedian()
+{
+    QFETCH(bool, FLOATS);
+    QFETCH(int, DATATYPE);
+
+    // A 4x4 frame of the values 1 to 16 in shuffled order, whose median is 8.5.
+    const int values[16] = { 16, 3, 9, 12, 1, 7, 14, 5, 10, 2, 15, 8, 4, 13, 6, 11 };
+
+    FITSImage::Statistic stats;
+    stats.dataType = DATATYPE;
+    stats.bytesPerPixel = DATATYPE == TUSHORT ? sizeof(uint16_t) : sizeof(float);
+    stats.width = 4;
+    stats.height = 4;
+    stats.samples_per_channel = 16;
+    stats.size = stats.samples_per_channel * stats.bytesPerPixel;
+
+    FITSData d(FITS_NORMAL);
+    d.setFloatBufferWithStatistics(FLOATS);
+    uint8_t *buffer = d.createImageBuffer(stats);
+    QVERIFY(buffer != nullptr);
+    for (int i = 0; i < 16; i++)
+    {
+        if (DATATYPE == TUSHORT)
+            reinterpret_cast<uint16_t *>(buffer)[i] = values[i];
+        else
+            reinterpret_cast<float *>(buffer)[i] = values[i];
+    }
+    d.calculateStats(true);
+
+    // 16-bit frames have the exact median from the value counts, float frames the one of the samples.
+    if (DATATYPE == TUSHORT)
+        QCOMPARE(d.getMedian(), 8.5);
+    else
+        QVERIFY(d.getMedian() >= 8 && d.getMedian() <= 9);
+    QCOMPARE(d.getMin(), 1.0);
+    QCOMPARE(d.getMax(), 16.0);
+
+    auto floats = d.getFloatBuffer();
+    QVERIFY(floats);
+    QCOMPARE(floats->size(), 16);
+    QCOMPARE(floats->at(0), 16.0f);
+}
+
+void TestFitsData::testBatchWCS()
+{
+#if QT_VERSION < 0x050900 || !defined(HAVE_WCSLIB)
+    QSKIP("Skipping WCS test on old QT version or without wcslib.");
+#else
+    const QString filename = "m47_sim_stars.fits";
+    if (!QFile::exists(filename))
+        QSKIP("Skipping batch WCS test because of missing fixture");
+
+    std::unique_ptr<FITSData> d(new FITSData());
+    QFuture<bool> worker = d->loadFromFile(filename);
+    QTRY_VERIFY_WITH_TIMEOUT(worker.isFinished(), 10000);
+    QVERIFY(worker.result());
+
+    // The TAN projection computed in place matches the wcslib conversions of single points
+    d->injectWCS(32.5, 116.2, 58.3, 1.7, true);
+    QVERIFY(d->loadWCS());
+
+    QVector<QPointF> pixels;
+    for (int y = -100; y <= d->height() + 100; y += 7)
+        for (int x = -100; x <= d->width() + 100; x += 7)
+            pixels.append(QPointF(x, y));
+    QVERIFY(pixels.size() > 4096);
+
+    QVector<QPointF> world;
+    QVector<bool> valid;
+    QVERIFY(d->pixelsToWCS(pixels, world, valid));
+    QCOMPARE(world.size(), pixels.size());
+    for (int i = 0; i < pixels.size(); i += 13)
+    {
+        SkyPoint coord;
+        QVERIFY(valid[i]);
+        QVERIFY(d->pixelToWCS(pixels[i], coord));
+        QVERIFY(std::fabs(world[i].x() - coord.ra0().Degrees()) < 1e-7);
+        QVERIFY(std::fabs(world[i].y() - coord.dec0().Degrees()) < 1e-7);
+    }
+
+    // Back to the same pixels, while the far side of the sky has none
+    world.append(QPointF(116.2 + 180, -58.3));
+    QVector<QPointF> back;
+    QVERIFY(d->wcsToPixels(world, back, valid));
+    QCOMPARE(back.size(), world.size());
+    for (int i = 0; i < pixels.size(); i++)
+    {
+        QVERIFY(valid[i]);
+        QVERIFY(std::fabs(back[i].x() - pixels[i].x()) < 1e-6);
+        QVERIFY(std::fabs(back[i].y() - pixels[i].y()) < 1e-6);
+    }
+    QVERIFY(!valid.last());
+    QPointF pixel, image;
+    QVERIFY(!d->wcsToPixel(SkyPoint(world.last().x() / 15.0, world.last().y()), pixel, image));
+
+    // No conversion without a WCS
+    std::unique_ptr<FITSData> empty(new FITSData());
+    QVERIFY(!empty->pixelsToWCS(pixels, world, valid));
+#endif
+}
+
 void TestFitsData::initGenericDataFixture()
 {
 #if QT_VERSION < 0x050900
@@ -288,6 +499,57 @@ void TestFitsData::testLoadFits()
 #endif
 }
 
+void TestFitsData::testMemoryMappedLoad_data()
+{
+#if QT_VERSION < 0x050900
+    QSKIP("Skipping fixture-based test on old QT version.");
+#else
+    QTest::addColumn<QString>("NAME");
+
+    // 16bit with BZERO 32768, which is read instead, and plain 8bit data
+    QTest::newRow("M47-16BIT") << "m47_sim_stars.fits";
+    QTest::newRow("BAHTINOV-8BIT") << "bahtinov-focus.fits";
+#endif
+}
+
+void TestFitsData::testMemoryMappedLoad()
+{
+#if QT_VERSION < 0x050900
+    QSKIP("Skipping fixture-based test on old QT version.");
+#else
+    QFETCH(QString, NAME);
+
+    if(!QFile::exists(NAME))
+        QSKIP("Skipping load test because of missing fixture");
+
+    const bool memoryMapped = Options::memoryMappedFITS();
+
+    Options::setMemoryMappedFITS(false);
+    std::unique_ptr<FITSData> copied(new FITSData(FITS_FOCUS));
+    QFuture<bool> worker = copied->loadFromFile(NAME);
+    QTRY_VERIFY_WITH_TIMEOUT(worker.isFinished(), 10000);
+    QVERIFY(worker.result());
+
+    Options::setMemoryMappedFITS(true);
+    std::unique_ptr<FITSData> mapped(new FITSData(FITS_FOCUS));
+    worker = mapped->loadFromFile(NAME);
+    QTRY_VERIFY_WITH_TIMEOUT(worker.isFinished(), 10000);
+    QVERIFY(worker.result());
+
+    Options::setMemoryMappedFITS(memoryMapped);
+
+    // Both load paths must produce the very same pixels and statistics
+    QCOMPARE(mapped->dataType(), copied->dataType());
+    QCOMPARE(mapped->samplesPerChannel(), copied->samplesPerChannel());
+    const int64_t bytes = copied->samplesPerChannel() * copied->channels() * copied->getBytesPerPixel();
+    QVERIFY(memcmp(mapped->getImageBuffer(), copied->getImageBuffer(), bytes) == 0);
+    QCOMPARE(mapped->getMin(), copied->getMin());
+    QCOMPARE(mapped->getMax(), copied->getMax());
+    QCOMPARE(mapped->getMean(), copied->getMean());
+    QCOMPARE(mapped->getMedian(), copied->getMedian());
+#endif
+}
+
 void TestFitsData::testCentroidAlgorithmBenchmark_data()
 {
 #if QT_VERSION < 0x050900
@@ -34,6 +34,9 @@ class TestFitsData : public QObject
         void testLoadFits_data();
         void testLoadFits();
 
+        void testMemoryMappedLoad_data();
+        void testMemoryMappedLoad();
+
         void testCentroidAlgorithmBenchmark_data();
         void testCentroidAlgorithmBenchmark();
 
@@ -52,6 +55,12 @@ class TestFitsData : public QObject
         void testBahtinovFocusHFR_data();
         void testBahtinovFocusHFR();
 
+        void testIncrementalDetection();
+        void testFloatBuffer();
+        void testStatisticsMedian_data();
+        void testStatisticsMedian();
+        void testBatchWCS();
+
         void testParallelSolvers();
     private:
         void startGuideDetect(const QString &filename);
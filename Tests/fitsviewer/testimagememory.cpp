@@ -0,0 +1,169 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "fitsviewer/fitsdata.h"
+#include "fitsviewer/imagememory.h"
+
+#include <QTest>
+
+#include <QObject>
+
+class TestImageMemory : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestImageMemory() = default;
+
+        /** @short Destructor */
+        ~TestImageMemory() override = default;
+
+    private slots:
+        void cleanup();
+        void trackTest();
+        void ownerTest();
+        void budgetTest();
+        void variantMapTest();
+};
+
+#include "testimagememory.moc"
+
+namespace
+{
+// A float frame of width x height, which takes 4 bytes per pixel
+void createImage(FITSData &image, int width, int height)
+{
+    FITSImage::Statistic stats;
+    stats.dataType = TFLOAT;
+    stats.bytesPerPixel = sizeof(float);
+    stats.width = width;
+    stats.height = height;
+    stats.samples_per_channel = width * height;
+    stats.size = stats.samples_per_channel * sizeof(float);
+    image.createImageBuffer(stats);
+}
+
+ImageMemory::Usage usageOf(ImageMemory::Owner owner)
+{
+    return ImageMemory::instance().usage()[owner];
+}
+}
+
+void TestImageMemory::cleanup()
+{
+    ImageMemory::instance().setBudget(0);
+}
+
+void TestImageMemory::trackTest()
+{
+    ImageMemory &memory = ImageMemory::instance();
+    const uint64_t total = memory.totalBytes();
+    {
+        FITSData image(FITS_NORMAL);
+        createImage(image, 100, 50);
+        QCOMPARE(memory.totalBytes(), total + 20000);
+
+        // A new image replaces the previous one
+        createImage(image, 10, 10);
+        QCOMPARE(memory.totalBytes(), total + 400);
+
+        image.clearImageBuffers();
+        QCOMPARE(memory.totalBytes(), total);
+
+        createImage(image, 100, 50);
+    }
+    QCOMPARE(memory.totalBytes(), total);
+}
+
+void TestImageMemory::ownerTest()
+{
+    const ImageMemory::Usage guide = usageOf(ImageMemory::Guide);
+    const ImageMemory::Usage viewer = usageOf(ImageMemory::Viewer);
+
+    // The owner follows the mode unless the holder sets it, even before loading
+    FITSData guideImage(FITS_GUIDE);
+    createImage(guideImage, 100, 50);
+    FITSData viewerImage(FITS_NORMAL);
+    ImageMemory::instance().setOwner(&viewerImage, ImageMemory::Viewer);
+    createImage(viewerImage, 10, 10);
+
+    QCOMPARE(usageOf(ImageMemory::Guide).images, guide.images + 1);
+    QCOMPARE(usageOf(ImageMemory::Guide).bytes, guide.bytes + 20000);
+    QCOMPARE(usageOf(ImageMemory::Viewer).images, viewer.images + 1);
+    QCOMPARE(usageOf(ImageMemory::Viewer).bytes, viewer.bytes + 400);
+    QCOMPARE(usageOf(ImageMemory::Viewer).evictable, viewer.evictable);
+
+    ImageMemory::instance().setEvictor(&viewerImage, []()
+    {
+        return true;
+    });
+    QCOMPARE(usageOf(ImageMemory::Viewer).evictable, viewer.evictable + 400);
+}
+
+void TestImageMemory::budgetTest()
+{
+    ImageMemory &memory = ImageMemory::instance();
+    const quint64 evictions = memory.evictions();
+
+    FITSData first(FITS_NORMAL), second(FITS_NORMAL), third(FITS_NORMAL), shown(FITS_NORMAL);
+    createImage(first, 100, 50);
+    createImage(second, 100, 50);
+    createImage(third, 100, 50);
+    createImage(shown, 100, 50);
+
+    QList<FITSData *> evicted;
+    for (FITSData *image : { &first, &second, &third })
+    {
+        memory.setEvictor(image, [image, &evicted]()
+        {
+            evicted.append(image);
+            image->clearImageBuffers();
+            return true;
+        });
+    }
+    // The image shown can not be released
+    memory.setEvictor(&shown, []()
+    {
+        return false;
+    });
+
+    // Used again, the first image is evicted last
+    memory.touch(&first);
+    QCOMPARE(memory.enforceBudget(), 0);
+
+    // The other images take 30000 bytes beyond the budget, so that two of them must go
+    memory.setBudget(memory.totalBytes() - 30000);
+    QCOMPARE(memory.enforceBudget(), 2);
+    QCOMPARE(evicted, QList<FITSData *>({ &second, &third }));
+    QCOMPARE(memory.evictions(), evictions + 2);
+    QVERIFY(memory.totalBytes() <= memory.budget());
+
+    // Only the shown image is left over a lower budget, which is kept
+    memory.setBudget(memory.totalBytes() - 30000);
+    QCOMPARE(memory.enforceBudget(), 1);
+    QCOMPARE(evicted.last(), &first);
+    QCOMPARE(memory.enforceBudget(), 0);
+    QVERIFY(shown.getImageBuffer() != nullptr);
+}
+
+void TestImageMemory::variantMapTest()
+{
+    FITSData image(FITS_NORMAL);
+    ImageMemory::instance().setOwner(&image, ImageMemory::DarkLibrary);
+    createImage(image, 100, 50);
+    ImageMemory::instance().setBudget(1 << 30);
+
+    const QVariantMap map = ImageMemory::instance().toVariantMap();
+    QCOMPARE(map["budget"].toULongLong(), 1ull << 30);
+    QCOMPARE(map["total"].toULongLong(), ImageMemory::instance().totalBytes());
+    const QVariantMap owners = map["owners"].toMap();
+    QCOMPARE(owners.size(), ImageMemory::OwnerCount);
+    QVERIFY(owners["darkLibrary"].toULongLong() >= 20000);
+    QVERIFY(!ImageMemory::instance().summary().isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestImageMemory)
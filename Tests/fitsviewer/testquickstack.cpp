@@ -0,0 +1,108 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "fitsviewer/fitsdata.h"
+#include "fitsviewer/fitsquickstack.h"
+
+#include <QTest>
+
+#include <QObject>
+
+#include <cmath>
+
+class TestQuickStack : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestQuickStack() = default;
+
+        /** @short Destructor */
+        ~TestQuickStack() override = default;
+
+    private slots:
+        void offsetTest();
+        void unmatchedTest();
+        void stackTest();
+};
+
+#include "testquickstack.moc"
+
+namespace
+{
+// A width x height float frame with pixels base + x + 10 y
+QSharedPointer<FITSData> createFrame(int width, int height, float base)
+{
+    FITSImage::Statistic stats;
+    stats.dataType = TFLOAT;
+    stats.bytesPerPixel = sizeof(float);
+    stats.width = width;
+    stats.height = height;
+    stats.samples_per_channel = width * height;
+    stats.size = stats.samples_per_channel * sizeof(float);
+
+    QSharedPointer<FITSData> frame(new FITSData(FITS_NORMAL));
+    float *pixels = reinterpret_cast<float *>(frame->createImageBuffer(stats));
+    for (int y = 0; y < height; y++)
+        for (int x = 0; x < width; x++)
+            pixels[y * width + x] = base + x + 10 * y;
+    frame->calculateStats(true);
+    return frame;
+}
+}
+
+void TestQuickStack::offsetTest()
+{
+    const QList<QPointF> reference = { {10, 10}, {200, 35}, {57, 180}, {120, 120}, {300, 260}, {15, 290}, {250, 90} };
+    const QPointF shift(12.25, -4.5);
+
+    // The frame misses a star of the reference and has two of its own.
+    QList<QPointF> stars;
+    for (int i = 1; i < reference.size(); i++)
+        stars.append(reference[i] - shift + QPointF(i % 2 ? 0.3 : -0.3, 0));
+    stars.append(QPointF(400, 400));
+    stars.append(QPointF(33, 222));
+
+    QPointF offset;
+    QVERIFY(FITSQuickStack::findOffset(reference, stars, offset));
+    QVERIFY(std::abs(offset.x() - shift.x()) < 0.1);
+    QVERIFY(std::abs(offset.y() - shift.y()) < 0.1);
+}
+
+void TestQuickStack::unmatchedTest()
+{
+    const QList<QPointF> reference = { {0, 0}, {100, 0}, {0, 100} };
+    const QList<QPointF> stars = { {0, 0}, {37, 0}, {0, 71} };
+
+    QPointF offset;
+    QVERIFY(!FITSQuickStack::findOffset(reference, stars, offset));
+}
+
+void TestQuickStack::stackTest()
+{
+    FITSQuickStack stack;
+    QVERIFY(stack.result().isNull());
+
+    QVERIFY(stack.add(createFrame(8, 4, 0), QPointF()));
+    QVERIFY(stack.add(createFrame(8, 4, 100), QPointF(2.2, 0.9)));
+    QVERIFY(!stack.add(createFrame(4, 4, 0), QPointF()));
+    QCOMPARE(stack.count(), 2);
+
+    const QSharedPointer<FITSData> result = stack.result();
+    QCOMPARE(result->width(), static_cast<uint16_t>(8));
+    QCOMPARE(result->height(), static_cast<uint16_t>(4));
+    const float *pixels = reinterpret_cast<const float *>(result->getImageBuffer());
+
+    // Only the first frame covers the top row and left columns.
+    QCOMPARE(pixels[0], 0.0f);
+    QCOMPARE(pixels[8 + 1], 11.0f);
+    // Elsewhere the second frame, shifted by (2, 1), is averaged in.
+    QCOMPARE(pixels[2 * 8 + 3], (23.0f + 111.0f) / 2);
+    QCOMPARE(pixels[3 * 8 + 7], (37.0f + 125.0f) / 2);
+}
+
+QTEST_GUILESS_MAIN(TestQuickStack)
@@ -0,0 +1,145 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "fitsviewer/starstatistics.h"
+
+#include <QTest>
+
+#include <QObject>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+class TestStarStatistics : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestStarStatistics();
+
+        /** @short Destructor */
+        ~TestStarStatistics() override = default;
+
+    private slots:
+        void fewValuesTest();
+        void quantileTest_data();
+        void quantileTest();
+        void saturationTest();
+        void tilesTest();
+};
+
+#include "teststarstatistics.moc"
+
+TestStarStatistics::TestStarStatistics() : QObject()
+{
+}
+
+// Up to five values the quantile is exact
+void TestStarStatistics::fewValuesTest()
+{
+    P2Quantile median;
+    QCOMPARE(median.value(), 0.0);
+    median.add(3);
+    QCOMPARE(median.value(), 3.0);
+    median.add(1);
+    QCOMPARE(median.value(), 2.0);
+    median.add(2);
+    QCOMPARE(median.value(), 2.0);
+    median.add(10);
+    median.add(0);
+    QCOMPARE(median.count(), 5);
+    QCOMPARE(median.value(), 2.0);
+}
+
+void TestStarStatistics::quantileTest_data()
+{
+    QTest::addColumn<double>("quantile");
+    QTest::addColumn<int>("count");
+
+    for (double quantile : { 0.25, 0.5, 0.9 })
+        for (int count : { 50, 1000, 20000 })
+            QTest::newRow(qPrintable(QString("q=%1 n=%2").arg(quantile).arg(count))) << quantile << count;
+}
+
+// The estimate is compared with the quantile of the sorted values, for a skewed distribution like that of HFRs
+void TestStarStatistics::quantileTest()
+{
+    QFETCH(double, quantile);
+    QFETCH(int, count);
+
+    std::mt19937 rng(count);
+    std::lognormal_distribution<double> hfr(1.0, 0.3);
+    P2Quantile estimate(quantile);
+    std::vector<double> values;
+    for (int i = 0; i < count; i++)
+    {
+        values.push_back(hfr(rng));
+        estimate.add(values.back());
+    }
+    std::sort(values.begin(), values.end());
+    const double exact = values[static_cast<int>(quantile * (count - 1))];
+    QVERIFY2(std::fabs(estimate.value() - exact) < 0.05 * exact,
+             qPrintable(QString("estimate %1 exact %2").arg(estimate.value()).arg(exact)));
+}
+
+void TestStarStatistics::saturationTest()
+{
+    StarStatistics statistics;
+    QCOMPARE(statistics.medianHFR(), -1.0);
+    QCOMPARE(statistics.eccentricity(), -1.0);
+
+    statistics.setSaturation(1000);
+    // 30 good stars and 10 large saturated ones, which are left out
+    for (int i = 0; i < 30; i++)
+        statistics.add(10, 10, 2.0, 0.0, 500);
+    for (int i = 0; i < 10; i++)
+        statistics.add(10, 10, 6.0, 0.0, 2000);
+    QCOMPARE(statistics.count(), 40);
+    QCOMPARE(statistics.saturated(), 10);
+    QCOMPARE(statistics.medianHFR(), 2.0);
+    QCOMPARE(statistics.maxHFR(), 6.0);
+    QCOMPARE(statistics.eccentricity(), 0.0);
+
+    // With few unsaturated stars all are used. The estimate of a two valued distribution is between the values.
+    StarStatistics few;
+    few.setSaturation(1000);
+    for (int i = 0; i < 5; i++)
+        few.add(10, 10, 2.0, 0.5, 500);
+    for (int i = 0; i < 10; i++)
+        few.add(10, 10, 6.0, 0.5, 2000);
+    QVERIFY(few.medianHFR() > 2.0 && few.medianHFR() <= 6.0);
+    QVERIFY(std::fabs(few.eccentricity() - std::sqrt(0.75)) < 1e-9);
+}
+
+void TestStarStatistics::tilesTest()
+{
+    StarStatistics statistics(3, 3);
+    statistics.reset(300, 300);
+    // The HFR grows to the right
+    for (int y = 5; y < 300; y += 10)
+        for (int x = 5; x < 300; x += 10)
+            statistics.add(x, y, 2.0 + x / 100, 0.1, 100);
+    // Off the frame, only in the totals
+    statistics.add(-1, 10, 2.0, 0.1, 100);
+
+    QCOMPARE(statistics.count(), 30 * 30 + 1);
+    for (int tile = 0; tile < 9; tile++)
+    {
+        QCOMPARE(statistics.tileCount(tile), 100);
+        QCOMPARE(statistics.tileMedianHFR(tile), 2.0 + tile % 3);
+    }
+    QCOMPARE(statistics.tileCount(9), 0);
+    QCOMPARE(statistics.tileMedianHFR(9), -1.0);
+
+    statistics.reset(300, 300);
+    QCOMPARE(statistics.count(), 0);
+    QCOMPARE(statistics.tileCount(0), 0);
+}
+
+QTEST_GUILESS_MAIN(TestStarStatistics)
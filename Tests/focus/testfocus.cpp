@@ -7,11 +7,12 @@
 #include "ekos/focus/focusalgorithms.h"
 
 #include <QTest>
+#include <cmath>
 #include <memory>
 
 #include <QObject>
 
-// At this point, only the methods in focusalgorithms.h are tested.
+// At this point, only the methods in focusalgorithms.h and the curve fits of curvefit.h are tested.
 
 class TestFocus : public QObject
 {
@@ -30,6 +31,8 @@ class TestFocus : public QObject
         void L1PHyperbolaTest();
         void L1PParabolaTest();
         void L1PQuadraticTest();
+        void curveFitRefitTest();
+        void predictedPositionTest();
 };
 
 #include "testfocus.moc"
@@ -867,4 +870,83 @@ void TestFocus::L1PQuadraticTest()
     QCOMPARE(focuser->doneReason(), "Solution found.");
 }
 
+// The refits of a growing V-curve start from the previous solution, they have to find the solution of a fit
+// that starts from the datapoints.
+void TestFocus::curveFitRefitTest()
+{
+    constexpr auto HYPERBOLA = Ekos::CurveFitting::FOCUS_HYPERBOLA;
+    constexpr auto MINIMISE = Ekos::CurveFitting::OPTIMISATION_MINIMISE;
+    auto hfr = [](int x)
+    {
+        return 1.5 * std::sqrt(1.0 + std::pow((x - 10000) / 60.0, 2.0)) + 0.5;
+    };
+
+    QVector<int> positions;
+    QVector<double> values, weights;
+    QVector<bool> outliers;
+    Ekos::CurveFitting refit;
+    double refitPosition = 0, refitValue = 0;
+    for (int x = 10300; x >= 9700; x -= 50)
+    {
+        positions.push_back(x);
+        values.push_back(hfr(x));
+        weights.push_back(1.0);
+        outliers.push_back(false);
+        if (positions.size() < 3)
+            continue;
+
+        refit.fitCurve(Ekos::CurveFitting::STANDARD, positions, values, weights, outliers, HYPERBOLA, false, MINIMISE);
+        // Before the minimum, the fits aren't well determined
+        if (positions.size() < 8)
+            continue;
+
+        Ekos::CurveFitting fresh;
+        fresh.fitCurve(Ekos::CurveFitting::STANDARD, positions, values, weights, outliers, HYPERBOLA, false, MINIMISE);
+        double freshPosition = 0, freshValue = 0;
+        QVERIFY(refit.findMinMax(10000, 9000, 11000, &refitPosition, &refitValue, HYPERBOLA, MINIMISE));
+        QVERIFY(fresh.findMinMax(10000, 9000, 11000, &freshPosition, &freshValue, HYPERBOLA, MINIMISE));
+        QVERIFY(std::fabs(refitPosition - freshPosition) < 1.0);
+        QVERIFY(std::fabs(refitValue - freshValue) < 0.01);
+    }
+    QVERIFY(std::fabs(refitPosition - 10000) < 1.0);
+    QVERIFY(std::fabs(refitValue - 2.0) < 0.01);
+}
+
+// The position predicted before a measurement, which the focuser moves to while the frame is analysed,
+// has to be the one newMeasurement() then requests.
+void TestFocus::predictedPositionTest()
+{
+    for (auto walk : { Ekos::Focus::FOCUS_WALK_FIXED_STEPS, Ekos::Focus::FOCUS_WALK_CFZ_SHUFFLE })
+    {
+        auto params = makeL1PHyperbolaParams();
+        params.focusWalk = walk;
+        std::unique_ptr<FocusAlgorithmInterface> focuser(MakeLinearFocuser(params));
+
+        int position = focuser->initialPosition();
+        int predictions = 0;
+        for (int i = 0; i < params.maxIterations && !focuser->isDone(); ++i)
+        {
+            const bool firstPass = focuser->isInFirstPass();
+            const int predicted = focuser->predictedPosition();
+            const double value = std::hypot(1.0, (position - 10000) / 40.0);
+            const int next = focuser->newMeasurement(position, value, 1);
+            if (predicted >= 0)
+            {
+                QVERIFY(firstPass);
+                QCOMPARE(next, predicted);
+                predictions++;
+            }
+            position = next;
+        }
+        QVERIFY(focuser->isDone());
+        // All steps of the first pass but the last one, which depends on the curve fit
+        QCOMPARE(predictions, params.numSteps - 1);
+    }
+
+    // The classic walk may end the first pass at any step
+    auto params = makeL1PHyperbolaParams();
+    std::unique_ptr<FocusAlgorithmInterface> focuser(MakeLinearFocuser(params));
+    QCOMPARE(focuser->predictedPosition(), -1);
+}
+
 QTEST_GUILESS_MAIN(TestFocus)
@@ -0,0 +1,189 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ekos/focus/focusmodelstore.h"
+
+#include <QTest>
+
+#include <QObject>
+
+#include <cmath>
+
+using Ekos::FocusModelStore;
+
+class TestFocusModelStore : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestFocusModelStore();
+
+        /** @short Destructor */
+        ~TestFocusModelStore() override = default;
+
+    private slots:
+        void storeTest();
+        void limitTest();
+        void fittedPredictionTest();
+        void filterPredictionTest();
+        void narrowStepsTest();
+};
+
+#include "testfocusmodelstore.moc"
+
+namespace
+{
+FocusModelStore::Run makeRun(const QString &train, const QString &filter, int position, double temperature,
+                             double altitude = FocusModelStore::UNKNOWN)
+{
+    FocusModelStore::Run run;
+    run.train = train;
+    run.filter = filter;
+    run.position = position;
+    run.temperature = temperature;
+    run.altitude = altitude;
+    run.stepSize = 50;
+    run.value = 2.5;
+    run.halfWidth = 120;
+    run.cfz = 30;
+    run.curveFit = 1;
+    run.coefficients = { 1.5, 10000.25, 2.0, -0.5 };
+    run.time = 1700000000;
+    return run;
+}
+}  // namespace
+
+TestFocusModelStore::TestFocusModelStore() : QObject()
+{
+}
+
+void TestFocusModelStore::storeTest()
+{
+    FocusModelStore store(QStringList{});
+    QVERIFY(store.isEmpty());
+    QVERIFY(!store.predict("Main", "L", 10, 50, 0, 0).valid);
+
+    // Names with the separators survive
+    store.add(makeRun("Main|Scope", "Ha;7nm", 10000, 12.5, 45));
+    store.add(makeRun("Main", "L", 20000, FocusModelStore::UNKNOWN));
+    QCOMPARE(store.entries().size(), 2);
+
+    // Unreadable entries are ignored
+    QStringList entries = store.entries();
+    entries.append("garbage");
+    FocusModelStore restored(entries);
+    const auto runs = restored.runs("Main|Scope", "Ha;7nm");
+    QCOMPARE(runs.size(), 1);
+    QCOMPARE(runs[0].position, 10000);
+    QCOMPARE(runs[0].temperature, 12.5);
+    QCOMPARE(runs[0].altitude, 45.0);
+    QCOMPARE(runs[0].stepSize, 50);
+    QCOMPARE(runs[0].halfWidth, 120.0);
+    QCOMPARE(runs[0].coefficients.size(), 4);
+    QCOMPARE(runs[0].coefficients[1], 10000.25);
+    QCOMPARE(runs[0].time, qint64(1700000000));
+    QVERIFY(restored.runs("Main", "Ha;7nm").isEmpty());
+
+    restored.remove("Main");
+    QCOMPARE(restored.runs("Main", "L").size(), 0);
+    QCOMPARE(restored.runs("Main|Scope", "Ha;7nm").size(), 1);
+}
+
+void TestFocusModelStore::limitTest()
+{
+    FocusModelStore store(QStringList{});
+    for (int i = 0; i < FocusModelStore::MAX_RUNS + 5; i++)
+        store.add(makeRun("Main", "L", 1000 + i, 10));
+    store.add(makeRun("Main", "R", 5000, 10));
+
+    const auto runs = store.runs("Main", "L");
+    QCOMPARE(runs.size(), FocusModelStore::MAX_RUNS);
+    // The oldest were dropped
+    QCOMPARE(runs.first().position, 1000 + 5);
+    QCOMPARE(runs.last().position, 1000 + FocusModelStore::MAX_RUNS + 4);
+    QCOMPARE(store.runs("Main", "R").size(), 1);
+}
+
+// Once the temperatures spread, the coefficient is fitted to the runs and the filter's is ignored
+void TestFocusModelStore::fittedPredictionTest()
+{
+    FocusModelStore store(QStringList{});
+    // -20 ticks per °C, with altitudes moved by 2 ticks per degree
+    store.add(makeRun("Main", "L", 10000, 15.0, 40));
+    store.add(makeRun("Main", "L", 10040 + 2 * 10, 13.0, 50));
+    store.add(makeRun("Main", "L", 10080 - 2 * 10, 11.0, 30));
+
+    const auto prediction = store.predict("Main", "L", 10.0, 40, 5.0, 2.0);
+    QVERIFY(prediction.valid);
+    QVERIFY(prediction.fittedTicksPerTemp);
+    QVERIFY(std::fabs(prediction.ticksPerTemp + 20) < 1e-6);
+    QCOMPARE(prediction.position, 10100);
+    QVERIFY(prediction.residual < 1e-6);
+    QCOMPARE(prediction.runs, 3);
+    QCOMPARE(prediction.halfWidth, 120.0);
+}
+
+// With too little temperature spread the filter's ticks per °C move the newest run
+void TestFocusModelStore::filterPredictionTest()
+{
+    FocusModelStore store(QStringList{});
+    store.add(makeRun("Main", "L", 10010, 10.2));
+    store.add(makeRun("Main", "L", 9990, 10.0));
+
+    auto prediction = store.predict("Main", "L", 9.0, FocusModelStore::UNKNOWN, -30, 0);
+    QVERIFY(prediction.valid);
+    QVERIFY(!prediction.fittedTicksPerTemp);
+    QCOMPARE(prediction.position, 10020);
+    // Too few runs to know how good the prediction is
+    QCOMPARE(prediction.residual, -1.0);
+
+    store.add(makeRun("Main", "L", 10000, 10.1));
+    prediction = store.predict("Main", "L", 10.1, FocusModelStore::UNKNOWN, -30, 0);
+    QCOMPARE(prediction.position, 10000);
+    // The other runs, moved to 10.1°C, are at 10013 and 9987
+    QVERIFY(std::fabs(prediction.residual - 13.0) < 1e-6);
+
+    // Without a temperature only the newest position is used
+    prediction = store.predict("Main", "L", FocusModelStore::UNKNOWN, FocusModelStore::UNKNOWN, -30, 0);
+    QCOMPARE(prediction.position, 10000);
+}
+
+void TestFocusModelStore::narrowStepsTest()
+{
+    FocusModelStore::Prediction prediction { true, 10000, -20, true, 10, 3, 120, 30, 50 };
+    double outSteps;
+    int numSteps;
+
+    // 120 + 2 * 10 ticks are covered by 3 steps of 50
+    QVERIFY(FocusModelStore::narrowSteps(prediction, 50, 5, 11, outSteps, numSteps));
+    QCOMPARE(outSteps, 3.0);
+    QCOMPARE(numSteps, 7);
+
+    // Never more than the user's steps
+    QVERIFY(!FocusModelStore::narrowSteps(prediction, 20, 5, 11, outSteps, numSteps));
+    QCOMPARE(outSteps, 5.0);
+    QCOMPARE(numSteps, 11);
+
+    // Not with a poor prediction, too few runs or no curve width
+    prediction.residual = 60;
+    QVERIFY(!FocusModelStore::narrowSteps(prediction, 50, 5, 11, outSteps, numSteps));
+    prediction.residual = 10;
+    prediction.runs = 2;
+    QVERIFY(!FocusModelStore::narrowSteps(prediction, 50, 5, 11, outSteps, numSteps));
+    prediction.runs = 3;
+    prediction.halfWidth = 0;
+    QVERIFY(!FocusModelStore::narrowSteps(prediction, 50, 5, 11, outSteps, numSteps));
+
+    // At least 2 steps out and 5 steps
+    prediction.halfWidth = 10;
+    prediction.residual = 1;
+    QVERIFY(FocusModelStore::narrowSteps(prediction, 50, 5, 11, outSteps, numSteps));
+    QCOMPARE(outSteps, 2.0);
+    QCOMPARE(numSteps, 5);
+}
+
+QTEST_GUILESS_MAIN(TestFocusModelStore)
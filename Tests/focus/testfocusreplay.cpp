@@ -0,0 +1,309 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+// Replays a recorded autofocus run: the focus algorithm requests positions, and is given the measurement
+// of the recorded frame closest to each position. The frames are measured with the detection of the
+// focus module and the curve of the solution is fitted again, and the time of each stage is reported.
+//
+// The frame set is a directory of FITS frames, given by KSTARS_FOCUS_REPLAY_DIR. The focuser position of
+// each frame is read from a "positions.txt" file in the directory, with one "<file name> <position>" line
+// per frame, or else from the FOCUSPOS keyword of the frame. KSTARS_FOCUS_REPLAY_START optionally sets the
+// start position, which defaults to the middle of the recorded positions.
+//
+// Without a frame set only the replay itself is tested, on measurements of a simulated focuser.
+
+#include "ekos/focus/focusalgorithms.h"
+#include "ekos/focus/curvefit.h"
+#include "ekos/auxiliary/stellarsolverprofile.h"
+#include "fitsviewer/fitsdata.h"
+#include "Options.h"
+
+#include <QTest>
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QObject>
+#include <QTextStream>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+class TestFocusReplay : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestFocusReplay();
+
+        /** @short Destructor */
+        ~TestFocusReplay() override = default;
+
+    private slots:
+        void initTestCase();
+        void simulatedReplayTest();
+        void recordedReplayTest();
+};
+
+#include "testfocusreplay.moc"
+
+using Ekos::FocusAlgorithmInterface;
+
+namespace
+{
+struct Frame
+{
+    QString filename;
+    int position { 0 };
+    bool measured { false };
+    double value { -1 };
+    double weight { 1 };
+    int stars { 0 };
+    // Milliseconds
+    qint64 loadTime { 0 };
+    qint64 detectTime { 0 };
+};
+
+struct ReplayResult
+{
+    bool done { false };
+    int solution { -1 };
+    double value { -1 };
+    QString reason;
+    int measurements { 0 };
+    double R2 { 0 };
+    // Milliseconds
+    qint64 loadTime { 0 };
+    qint64 detectTime { 0 };
+    qint64 algorithmTime { 0 };
+    qint64 curveFitTime { 0 };
+};
+
+// Returns the frames of the directory with their focuser positions, sorted by position
+QVector<Frame> readFrameSet(const QDir &dir)
+{
+    QVector<Frame> frames;
+    QFile positions(dir.filePath("positions.txt"));
+    if (positions.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        QTextStream stream(&positions);
+        while (!stream.atEnd())
+        {
+            const QStringList fields = stream.readLine().simplified().split(' ');
+            bool ok = false;
+            Frame frame;
+            if (fields.size() == 2)
+                frame.position = fields[1].toInt(&ok);
+            if (!ok || fields[0].startsWith('#'))
+                continue;
+            frame.filename = dir.filePath(fields[0]);
+            frames.append(frame);
+        }
+    }
+    else
+    {
+        for (const QString &name : dir.entryList({ "*.fits", "*.fit", "*.fts" }, QDir::Files))
+        {
+            FITSData data;
+            if (!data.loadFromFile(dir.filePath(name)).result())
+                continue;
+            QVariant position;
+            if (!data.getRecordValue("FOCUSPOS", position))
+                continue;
+            Frame frame;
+            frame.filename = dir.filePath(name);
+            frame.position = position.toInt();
+            frames.append(frame);
+        }
+    }
+    std::sort(frames.begin(), frames.end(), [](const Frame & a, const Frame & b)
+    {
+        return a.position < b.position;
+    });
+    return frames;
+}
+
+// Measures the HFR of the frame as the focus module does with SEP
+bool measureFrame(Frame &frame, const bool useWeights, const Mathematics::RobustStatistics::ScaleCalculation scale)
+{
+    QElapsedTimer timer;
+    timer.start();
+    FITSData data(FITS_FOCUS);
+    if (!data.loadFromFile(frame.filename).result())
+        return false;
+    frame.loadTime = timer.restart();
+
+    QVariantMap extractionSettings;
+    extractionSettings["optionsProfileIndex"] = Options::focusOptionsProfile();
+    extractionSettings["optionsProfileGroup"] = static_cast<int>(Ekos::FocusProfiles);
+    data.setSourceExtractorSettings(extractionSettings);
+    if (!data.findStars(ALGORITHM_SEP).result())
+        return false;
+
+    frame.stars = data.getDetectedStars();
+    frame.value = data.getHFR(HFR_AVERAGE);
+    std::vector<double> hfrs;
+    for (const Edge *edge : data.getStarCenters())
+        hfrs.push_back(edge->HFR);
+    frame.weight = (useWeights && !hfrs.empty()) ? Mathematics::RobustStatistics::ComputeWeight(scale, hfrs) : 1.0;
+    frame.detectTime = timer.elapsed();
+    frame.measured = true;
+    return true;
+}
+
+// Returns the index of the frame closest to position
+int nearestFrame(const QVector<Frame> &frames, int position)
+{
+    int nearest = 0;
+    for (int i = 1; i < frames.size(); i++)
+    {
+        if (std::abs(frames[i].position - position) < std::abs(frames[nearest].position - position))
+            nearest = i;
+    }
+    return nearest;
+}
+
+// Runs the algorithm over the frames, measuring frames that aren't measured yet
+ReplayResult replay(const FocusAlgorithmInterface::FocusParams &params, QVector<Frame> &frames)
+{
+    ReplayResult result;
+    if (frames.isEmpty())
+        return result;
+
+    std::unique_ptr<FocusAlgorithmInterface> focuser(MakeLinearFocuser(params));
+    QElapsedTimer timer;
+    int position = focuser->initialPosition();
+    for (int i = 0; i < params.maxIterations && position >= 0 && !focuser->isDone(); i++)
+    {
+        Frame &frame = frames[nearestFrame(frames, position)];
+        if (!frame.measured)
+        {
+            measureFrame(frame, params.useWeights, params.scaleCalculation);
+            result.loadTime += frame.loadTime;
+            result.detectTime += frame.detectTime;
+        }
+        result.measurements++;
+
+        // The algorithm is told the position it asked for, as the focuser would report it
+        timer.start();
+        position = focuser->newMeasurement(position, frame.value, frame.weight);
+        result.algorithmTime += timer.elapsed();
+    }
+
+    result.done = focuser->isDone();
+    result.solution = focuser->solution();
+    result.value = focuser->solutionValue();
+    result.reason = focuser->doneReason();
+
+    // Fit the measurements again, to time the fit and to know how good it is
+    QVector<int> positions;
+    QVector<double> values, weights;
+    QVector<bool> outliers;
+    focuser->getPass1Measurements(&positions, &values, &weights, &outliers);
+    if (positions.size() >= 3)
+    {
+        Ekos::CurveFitting curveFitting;
+        timer.start();
+        curveFitting.fitCurve(Ekos::CurveFitting::BEST, positions, values, weights, outliers, params.curveFit,
+                              params.useWeights, params.optimisationDirection);
+        result.curveFitTime = timer.elapsed();
+        result.R2 = curveFitting.calculateR2(params.curveFit);
+    }
+    return result;
+}
+
+FocusAlgorithmInterface::FocusParams makeReplayParams(int startPosition, int stepSize, double outSteps, int numSteps)
+{
+    const FocusAlgorithmInterface::FocusParams params(nullptr,
+            100000, stepSize, startPosition, 0, 1000000, 30, 0.05, "Replay", 20.0, outSteps, numSteps,
+            Ekos::Focus::FOCUS_LINEAR1PASS, 0, Ekos::CurveFitting::FOCUS_HYPERBOLA, true, Ekos::Focus::FOCUS_STAR_HFR,
+            Ekos::Focus::FOCUS_STAR_GAUSSIAN, false, Ekos::Focus::FOCUS_WALK_CLASSIC, false, 0.2,
+            Ekos::CurveFitting::OPTIMISATION_MINIMISE, Mathematics::RobustStatistics::SCALE_QESTIMATOR);
+    return params;
+}
+
+QString report(const ReplayResult &result)
+{
+    return QString("solution %1 value %2 R2 %3 after %4 measurements (%5); load %6 ms, detection %7 ms, "
+                   "algorithm %8 ms, curve fit %9 ms")
+           .arg(result.solution).arg(result.value, 0, 'f', 3).arg(result.R2, 0, 'f', 3).arg(result.measurements)
+           .arg(result.reason).arg(result.loadTime).arg(result.detectTime).arg(result.algorithmTime).arg(result.curveFitTime);
+}
+}  // namespace
+
+TestFocusReplay::TestFocusReplay() : QObject()
+{
+}
+
+void TestFocusReplay::initTestCase()
+{
+    Options::setStellarSolverPartition(true);
+}
+
+// Recorded frames of a simulated focuser with its best focus at 10000, every 50 ticks
+void TestFocusReplay::simulatedReplayTest()
+{
+    QVector<Frame> frames;
+    for (int position = 9000; position <= 11000; position += 50)
+    {
+        Frame frame;
+        frame.position = position;
+        frame.measured = true;
+        frame.value = 1.5 * std::sqrt(1.0 + std::pow((position - 10000) / 100.0, 2.0)) + 0.5;
+        frames.append(frame);
+    }
+
+    const ReplayResult result = replay(makeReplayParams(10100, 50, 5, 11), frames);
+    qInfo() << qPrintable(report(result));
+    QVERIFY2(result.done, qPrintable(result.reason));
+    // Within a frame of the best focus
+    QVERIFY(std::abs(result.solution - 10000) <= 50);
+    QVERIFY(result.R2 > 0.9);
+    QVERIFY(result.measurements > 5);
+}
+
+void TestFocusReplay::recordedReplayTest()
+{
+    const QString dirName = qEnvironmentVariable("KSTARS_FOCUS_REPLAY_DIR");
+    if (dirName.isEmpty())
+        QSKIP("Set KSTARS_FOCUS_REPLAY_DIR to the directory of recorded autofocus frames to replay them");
+
+    QVector<Frame> frames = readFrameSet(QDir(dirName));
+    if (frames.size() < 5)
+        QSKIP("Not enough frames with focuser positions to replay");
+
+    // Steps of the closest recorded positions, over the range of the recorded positions
+    int stepSize = frames.last().position - frames.first().position;
+    for (int i = 1; i < frames.size(); i++)
+    {
+        if (frames[i].position > frames[i - 1].position)
+            stepSize = std::min(stepSize, frames[i].position - frames[i - 1].position);
+    }
+    QVERIFY(stepSize > 0);
+    bool ok = false;
+    int start = qEnvironmentVariable("KSTARS_FOCUS_REPLAY_START").toInt(&ok);
+    if (!ok)
+        start = (frames.first().position + frames.last().position) / 2;
+    const double outSteps = std::floor((frames.last().position - start) / static_cast<double>(stepSize));
+    const int numSteps = std::max(5, std::min(11, static_cast<int>(frames.size())));
+
+    const ReplayResult result = replay(makeReplayParams(start, stepSize, outSteps, numSteps), frames);
+    for (const Frame &frame : frames)
+    {
+        if (frame.measured)
+            qInfo() << qPrintable(QString("%1 position %2: %3 stars HFR %4 weight %5, load %6 ms, detection %7 ms")
+                                  .arg(QFileInfo(frame.filename).fileName()).arg(frame.position).arg(frame.stars)
+                                  .arg(frame.value, 0, 'f', 3).arg(frame.weight, 0, 'f', 3).arg(frame.loadTime)
+                                  .arg(frame.detectTime));
+    }
+    qInfo() << qPrintable(report(result));
+    QVERIFY2(result.done && result.solution >= 0, qPrintable(result.reason));
+}
+
+QTEST_GUILESS_MAIN(TestFocusReplay)
@@ -0,0 +1,182 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ekos/focus/sensortilemap.h"
+#include "fitsviewer/fitsstardetector.h"
+
+#include <QTest>
+#include <cmath>
+#include <memory>
+
+#include <QObject>
+
+class TestSensorTileMap : public QObject
+{
+        Q_OBJECT
+
+    public:
+        TestSensorTileMap();
+        ~TestSensorTileMap() override = default;
+
+    private slots:
+        void binTest();
+        void statsTest();
+        void tiltTest();
+        void backfocusTest();
+};
+
+#include "testsensortilemap.moc"
+
+using Ekos::SensorTileMap;
+
+TestSensorTileMap::TestSensorTileMap() : QObject()
+{
+}
+
+#define CompareFloat(d1,d2) QVERIFY(fabs((d1) - (d2)) < .0001)
+
+namespace
+{
+// Stars on a regular grid over a 300x300 sensor, the HFR given by the position
+QList<Edge *> makeStars(std::vector<std::unique_ptr<Edge>> &edges, double (*hfr)(double x, double y))
+{
+    QList<Edge *> stars;
+    for (int y = 5; y < 300; y += 10)
+        for (int x = 5; x < 300; x += 10)
+        {
+            edges.emplace_back(new Edge());
+            edges.back()->x = x;
+            edges.back()->y = y;
+            edges.back()->HFR = hfr(x, y);
+            stars.append(edges.back().get());
+        }
+    return stars;
+}
+}
+
+void TestSensorTileMap::binTest()
+{
+    SensorTileMap map(3, 3);
+    QCOMPARE(map.tileAt(10, 10), -1);
+
+    map.setSensorSize(300, 300);
+    QCOMPARE(map.tileCount(), 9);
+    QCOMPARE(map.tileAt(10, 10), 0);
+    QCOMPARE(map.tileAt(150, 10), 1);
+    QCOMPARE(map.tileAt(299, 10), 2);
+    QCOMPARE(map.tileAt(150, 150), 4);
+    QCOMPARE(map.tileAt(10, 299), 6);
+    QCOMPARE(map.tileAt(300, 10), -1);
+    QCOMPARE(map.tileCentre(4), QPointF(0, 0));
+    QCOMPARE(map.tileCentre(0), QPointF(-100, 100));
+
+    std::vector<std::unique_ptr<Edge>> edges;
+    const auto stars = makeStars(edges, [](double, double)
+    {
+        return 2.0;
+    });
+    auto tileStars = map.binStars(stars);
+    for (int tile = 0; tile < 9; tile++)
+        QCOMPARE(tileStars[tile].size(), 100);
+
+    // Mosaic tiles don't cover the sensor, stars between them are dropped
+    QVector<QRect> tiles;
+    for (int row = 0; row < 3; row++)
+        for (int column = 0; column < 3; column++)
+            tiles.append(QRect(column * 120, row * 120, 60, 60));
+    map.setTiles(tiles, 300, 300);
+    QCOMPARE(map.tileAt(100, 10), -1);
+    QCOMPARE(map.tileAt(130, 250), 7);
+    tileStars = map.binStars(stars);
+    for (int tile = 0; tile < 9; tile++)
+        QCOMPARE(tileStars[tile].size(), 36);
+}
+
+void TestSensorTileMap::statsTest()
+{
+    SensorTileMap map(3, 3, 10);
+    map.setSensorSize(300, 300);
+    QCOMPARE(map.stats(0).count, 0);
+
+    for (int i = 0; i < 5; i++)
+        map.addMeasure(0, 3.0);
+    // An outlier is clipped
+    map.addMeasure(0, 30.0);
+    QCOMPARE(map.stats(0).count, 6);
+    CompareFloat(map.stats(0).location, 3.0);
+
+    // Only the latest measures are kept
+    for (int i = 0; i < 10; i++)
+        map.addMeasure(0, 2.0);
+    QCOMPARE(map.stats(0).count, 10);
+    CompareFloat(map.stats(0).location, 2.0);
+
+    // Resizing the sensor starts over
+    map.setSensorSize(400, 300);
+    QCOMPARE(map.stats(0).count, 0);
+}
+
+void TestSensorTileMap::tiltTest()
+{
+    // One focus position per tile, growing to the right
+    QVector<double> values = { 100, 110, 120, 100, 110, 120, 100, 110, 120 };
+    QVector<bool> valid(9, true);
+    SensorTileMap::Tilt tilt;
+    QVERIFY(SensorTileMap::calcTilt(3, 3, values, valid, 2.0, 1000, 1000, tilt));
+    CompareFloat(tilt.LR, 40.0);
+    CompareFloat(tilt.TB, 0.0);
+    CompareFloat(tilt.diagonal, 40.0);
+    CompareFloat(tilt.LRPercent, 4.0);
+    QCOMPARE(tilt.deltas.size(), 9);
+    CompareFloat(tilt.deltas[0], 20.0);
+
+    // A side without valid tiles fails
+    valid[0] = valid[3] = valid[6] = false;
+    QVERIFY(!SensorTileMap::calcTilt(3, 3, values, valid, 2.0, 1000, 1000, tilt));
+    valid.fill(true);
+    valid[4] = false;
+    QVERIFY(!SensorTileMap::calcTilt(3, 3, values, valid, 2.0, 1000, 1000, tilt));
+    // No centre tile
+    QVERIFY(!SensorTileMap::calcTilt(2, 2, QVector<double>(4, 1.0), QVector<bool>(4, true), 1.0, 1, 1, tilt));
+
+    // From star HFRs, larger at the bottom
+    SensorTileMap map(3, 3);
+    map.setSensorSize(300, 300);
+    std::vector<std::unique_ptr<Edge>> edges;
+    map.addStars(makeStars(edges, [](double, double y)
+    {
+        return 2.0 + y / 300.0;
+    }));
+    QVERIFY(map.calcTilt(1.0, 1.0, tilt));
+    CompareFloat(tilt.LR, 0.0);
+    CompareFloat(tilt.TB, 2.0 / 3.0);
+}
+
+void TestSensorTileMap::backfocusTest()
+{
+    // The corners focus 10 steps before the centre, the sides 4
+    QVector<double> values = { 90, 96, 90, 96, 100, 96, 90, 96, 90 };
+    QVector<bool> valid(9, true);
+    QVector<double> distances = { std::sqrt(2.0), 1, std::sqrt(2.0), 1, 0, 1, std::sqrt(2.0), 1, std::sqrt(2.0) };
+    double delta = 0;
+
+    QVERIFY(SensorTileMap::calcBackfocusDelta(3, 3, values, valid, distances, SensorTileMap::TILES_OUTER_CORNERS, 2.0,
+            delta));
+    CompareFloat(delta, 20.0);
+    QVERIFY(SensorTileMap::calcBackfocusDelta(3, 3, values, valid, distances, SensorTileMap::TILES_INNER_DIAMOND, 2.0,
+            delta));
+    CompareFloat(delta, 8.0);
+    QVERIFY(SensorTileMap::calcBackfocusDelta(3, 3, values, valid, distances, SensorTileMap::TILES_ALL, 1.0, delta));
+    const double expected = 100 - (4 * 90 * std::sqrt(2.0) + 4 * 96) / (4 * std::sqrt(2.0) + 4);
+    CompareFloat(delta, expected);
+
+    // Only the centre left
+    valid.fill(false);
+    valid[4] = true;
+    QVERIFY(!SensorTileMap::calcBackfocusDelta(3, 3, values, valid, distances, SensorTileMap::TILES_ALL, 1.0, delta));
+}
+
+QTEST_GUILESS_MAIN(TestSensorTileMap)
@@ -0,0 +1,319 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+/*
+ * This file contains benchmarks for the sky indexing: HTMesh intersections with circles
+ * and polygons at several levels and sizes, SkyMesh apertures, and the indexing of stars
+ * and star lines. Next to the timings, every row logs the trixels it finds and the
+ * allocations made by one call. Only the allocations through operator new are counted,
+ * Qt containers allocate with malloc.
+ *
+ * Run with "-iterations N" for a fixed run time, as ctest does.
+ */
+
+#include "htmesh/HTMesh.h"
+#include "htmesh/MeshIterator.h"
+#include "kstarsdata.h"
+#include "skycomponents/skymesh.h"
+#include "skyobjects/starobject.h"
+
+#include <QTest>
+
+#include <QObject>
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+namespace
+{
+std::atomic<qint64> allocationCount { 0 };
+}
+
+void *operator new(std::size_t size)
+{
+    ++allocationCount;
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+class TestHTMeshBenchmark : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestHTMeshBenchmark();
+
+        /** @short Destructor */
+        ~TestHTMeshBenchmark() override = default;
+
+    private slots:
+        void initTestCase();
+
+        void intersectCircleBenchmark_data();
+        void intersectCircleBenchmark();
+        void intersectPolygonBenchmark_data();
+        void intersectPolygonBenchmark();
+        void apertureBenchmark_data();
+        void apertureBenchmark();
+        void indexStarBenchmark_data();
+        void indexStarBenchmark();
+        void indexStarLineBenchmark_data();
+        void indexStarLineBenchmark();
+};
+
+#include "testhtmeshbenchmark.moc"
+
+namespace
+{
+// The levels of the meshes of KStars: the default sky mesh, the deep star catalogs, and a fine one
+const QList<int> levels = {3, 5, 7};
+
+// Runs the call once and logs its trixels and allocations
+template <typename Call>
+void logStatistics(Call call, int trixels)
+{
+    const qint64 before = allocationCount;
+    call();
+    qInfo().noquote() << QString("%1: %2 trixels, %3 allocations per call")
+                      .arg(QTest::currentDataTag()).arg(trixels).arg(allocationCount - before);
+}
+
+int bufferSize(HTMesh &mesh)
+{
+    MeshIterator region(&mesh);
+    int count = 0;
+    while (region.hasNext())
+    {
+        region.next();
+        ++count;
+    }
+    return count;
+}
+}  // namespace
+
+TestHTMeshBenchmark::TestHTMeshBenchmark() : QObject()
+{
+}
+
+void TestHTMeshBenchmark::initTestCase()
+{
+    // SkyMesh::aperture() reads the time of the data, the data files are not needed
+    if (KStarsData::Instance() == nullptr)
+        KStarsData::Create();
+}
+
+void TestHTMeshBenchmark::intersectCircleBenchmark_data()
+{
+    QTest::addColumn<int>("LEVEL");
+    QTest::addColumn<double>("RADIUS");
+
+    for (int level : levels)
+    {
+        for (double radius : {0.5, 5.0, 30.0, 90.0})
+            QTest::newRow(qPrintable(QString("level%1-radius%2").arg(level).arg(radius))) << level << radius;
+    }
+}
+
+void TestHTMeshBenchmark::intersectCircleBenchmark()
+{
+    QFETCH(int, LEVEL);
+    QFETCH(double, RADIUS);
+
+    HTMesh mesh(LEVEL, LEVEL);
+    int call = 0;
+    QBENCHMARK
+    {
+        mesh.intersect(std::fmod(call * 37.1, 360.0), std::fmod(call * 13.7, 160.0) - 80.0, RADIUS);
+        ++call;
+    }
+
+    mesh.intersect(10.0, 20.0, RADIUS);
+    const int trixels = bufferSize(mesh);
+    QVERIFY(trixels > 0);
+    logStatistics([&]()
+    {
+        mesh.intersect(10.0, 20.0, RADIUS);
+    }, trixels);
+}
+
+void TestHTMeshBenchmark::intersectPolygonBenchmark_data()
+{
+    QTest::addColumn<int>("LEVEL");
+    QTest::addColumn<int>("CORNERS");
+    QTest::addColumn<double>("SIZE");
+
+    for (int level : levels)
+    {
+        for (int corners : {3, 4})
+        {
+            for (double size : {1.0, 10.0, 40.0})
+                QTest::newRow(qPrintable(QString("level%1-corners%2-size%3").arg(level).arg(corners).arg(size)))
+                        << level << corners << size;
+        }
+    }
+}
+
+void TestHTMeshBenchmark::intersectPolygonBenchmark()
+{
+    QFETCH(int, LEVEL);
+    QFETCH(int, CORNERS);
+    QFETCH(double, SIZE);
+
+    HTMesh mesh(LEVEL, LEVEL);
+    auto intersect = [&](double ra, double dec)
+    {
+        if (CORNERS == 3)
+            mesh.intersect(ra, dec, ra + SIZE, dec, ra + SIZE / 2, dec + SIZE);
+        else
+            mesh.intersect(ra, dec, ra + SIZE, dec, ra + SIZE, dec + SIZE, ra, dec + SIZE);
+    };
+
+    int call = 0;
+    QBENCHMARK
+    {
+        intersect(std::fmod(call * 37.1, 300.0), std::fmod(call * 13.7, 80.0) - 60.0);
+        ++call;
+    }
+
+    intersect(10.0, 20.0);
+    const int trixels = bufferSize(mesh);
+    QVERIFY(trixels > 0);
+    logStatistics([&]()
+    {
+        intersect(10.0, 20.0);
+    }, trixels);
+}
+
+void TestHTMeshBenchmark::apertureBenchmark_data()
+{
+    QTest::addColumn<int>("LEVEL");
+    QTest::addColumn<double>("RADIUS");
+    QTest::addColumn<bool>("MOVING");
+
+    for (int level : levels)
+    {
+        for (double radius : {0.5, 5.0, 30.0, 90.0})
+        {
+            // A still view is answered from the aperture cache
+            for (bool moving : {true, false})
+                QTest::newRow(qPrintable(QString("level%1-radius%2-%3").arg(level).arg(radius).arg(moving ? "moving" : "still")))
+                        << level << radius << moving;
+        }
+    }
+}
+
+void TestHTMeshBenchmark::apertureBenchmark()
+{
+    QFETCH(int, LEVEL);
+    QFETCH(double, RADIUS);
+    QFETCH(bool, MOVING);
+
+    SkyMesh *mesh = SkyMesh::Create(LEVEL);
+    int call = 0;
+    QBENCHMARK
+    {
+        SkyPoint center(MOVING ? std::fmod(call * 2.47, 24.0) : 5.0, MOVING ? std::fmod(call * 13.7, 160.0) - 80.0 : 20.0);
+        mesh->aperture(&center, RADIUS);
+        ++call;
+    }
+
+    SkyPoint center(5.0, 20.0);
+    mesh->aperture(&center, RADIUS);
+    const int trixels = bufferSize(*mesh);
+    QVERIFY(trixels > 0);
+    logStatistics([&]()
+    {
+        SkyPoint other(MOVING ? 11.0 : 5.0, MOVING ? -30.0 : 20.0);
+        mesh->aperture(&other, RADIUS);
+    }, trixels);
+}
+
+void TestHTMeshBenchmark::indexStarBenchmark_data()
+{
+    QTest::addColumn<int>("LEVEL");
+
+    for (int level : levels)
+        QTest::newRow(qPrintable(QString("level%1").arg(level))) << level;
+}
+
+void TestHTMeshBenchmark::indexStarBenchmark()
+{
+    QFETCH(int, LEVEL);
+
+    // Stars spread over the sky, with proper motions
+    QVector<StarObject> stars;
+    for (int i = 0; i < 10000; ++i)
+    {
+        StarObject star(dms(std::fmod(i * 37.1, 360.0)), dms(std::fmod(i * 13.7, 178.0) - 89.0), 5.0);
+        star.setProperMotion((i % 7) * 100.0, (i % 5) * 100.0);
+        stars.append(star);
+    }
+
+    SkyMesh *mesh = SkyMesh::Create(LEVEL);
+    QBENCHMARK
+    {
+        for (StarObject &star : stars)
+            mesh->indexStar(&star);
+    }
+
+    logStatistics([&]()
+    {
+        mesh->indexStar(&stars[0]);
+    }, 1);
+}
+
+void TestHTMeshBenchmark::indexStarLineBenchmark_data()
+{
+    QTest::addColumn<int>("LEVEL");
+    QTest::addColumn<double>("LENGTH");
+
+    for (int level : levels)
+    {
+        for (double length : {5.0, 30.0, 120.0})
+            QTest::newRow(qPrintable(QString("level%1-length%2").arg(level).arg(length))) << level << length;
+    }
+}
+
+void TestHTMeshBenchmark::indexStarLineBenchmark()
+{
+    QFETCH(int, LEVEL);
+    QFETCH(double, LENGTH);
+
+    // A line of 20 stars, like the constellation lines
+    SkyList points;
+    for (int i = 0; i < 20; ++i)
+        points.append(std::make_shared<StarObject>(dms(40.0 + i * LENGTH / 20.0), dms(10.0 + 20.0 * std::sin(i / 3.0)), 3.0));
+
+    SkyMesh *mesh = SkyMesh::Create(LEVEL);
+    int trixels = 0;
+    QBENCHMARK
+    {
+        trixels = mesh->indexStarLine(&points).size();
+    }
+
+    QVERIFY(trixels > 0);
+    logStatistics([&]()
+    {
+        mesh->indexStarLine(&points);
+    }, trixels);
+}
+
+QTEST_GUILESS_MAIN(TestHTMeshBenchmark)
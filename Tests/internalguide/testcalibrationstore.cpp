@@ -0,0 +1,133 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ekos/guide/internalguide/calibrationstore.h"
+#include "ekos/guide/internalguide/calibration.h"
+
+#include <QTest>
+
+#include <QObject>
+
+class TestCalibrationStore : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestCalibrationStore();
+
+        /** @short Destructor */
+        ~TestCalibrationStore() override = default;
+
+    private slots:
+        void findTest();
+        void removeTest();
+        void limitTest();
+};
+
+#include "testcalibrationstore.moc"
+
+namespace
+{
+// A calibration whose RA axis points along (dx, dy), which tells the calibrations apart.
+Calibration makeCalibration(ISD::Mount::PierSide side, double dec, double dx, double dy)
+{
+    Calibration calibration;
+    calibration.setParameters(0.005, 0.005, 500, 1, 1, side, dms(0.0), dms(dec));
+    calibration.calculate1D(0, 0, dx, dy, 2000);
+    return calibration;
+}
+
+// The angle of a stored calibration, restored on the side it was calibrated on.
+double storedAngle(const QString &encoding, ISD::Mount::PierSide side)
+{
+    Calibration calibration;
+    if (!calibration.restore(encoding, side, false, 1, 1))
+        return -1;
+    return calibration.getAngle();
+}
+}  // namespace
+
+TestCalibrationStore::TestCalibrationStore() : QObject()
+{
+}
+
+void TestCalibrationStore::findTest()
+{
+    CalibrationStore store(QStringList{});
+    QVERIFY(store.isEmpty());
+
+    const Calibration east10 = makeCalibration(ISD::Mount::PIER_EAST, 10, 10, 0);
+    const Calibration west10 = makeCalibration(ISD::Mount::PIER_WEST, 10, 0, 10);
+    const Calibration east60 = makeCalibration(ISD::Mount::PIER_EAST, 60, -10, 0);
+    const Calibration otherTrain = makeCalibration(ISD::Mount::PIER_EAST, 10, 7, 7);
+    store.add("Guide Scope", east10);
+    store.add("Guide Scope", west10);
+    store.add("Guide Scope", east60);
+    store.add("OAG, main | scope", otherTrain);
+    QCOMPARE(store.entries().size(), 4);
+
+    // Same train, side and declination band, replaces east10
+    const Calibration east15 = makeCalibration(ISD::Mount::PIER_EAST, 15, 0, -10);
+    store.add("Guide Scope", east15);
+    QCOMPARE(store.entries().size(), 4);
+
+    // The nearest declination on the same side
+    const dms dec50(50.0), dec12(12.0);
+    QCOMPARE(storedAngle(store.find("Guide Scope", ISD::Mount::PIER_EAST, &dec50), ISD::Mount::PIER_EAST),
+             east60.getAngle());
+    QCOMPARE(storedAngle(store.find("Guide Scope", ISD::Mount::PIER_EAST, &dec12), ISD::Mount::PIER_EAST),
+             east15.getAngle());
+    QCOMPARE(storedAngle(store.find("Guide Scope", ISD::Mount::PIER_WEST, &dec12), ISD::Mount::PIER_WEST),
+             west10.getAngle());
+    // Without a declination, the newest of the same side
+    QCOMPARE(storedAngle(store.find("Guide Scope", ISD::Mount::PIER_EAST, nullptr), ISD::Mount::PIER_EAST),
+             east15.getAngle());
+    // Train names may have any character
+    QCOMPARE(storedAngle(store.find("OAG, main | scope", ISD::Mount::PIER_EAST, &dec12), ISD::Mount::PIER_EAST),
+             otherTrain.getAngle());
+    // The other side, when it is the only one
+    QCOMPARE(storedAngle(store.find("OAG, main | scope", ISD::Mount::PIER_WEST, &dec12), ISD::Mount::PIER_EAST),
+             otherTrain.getAngle());
+    QVERIFY(store.find("Unknown", ISD::Mount::PIER_EAST, &dec12).isEmpty());
+
+    // The entries are all there is to the store
+    CalibrationStore copy(store.entries());
+    QCOMPARE(copy.find("Guide Scope", ISD::Mount::PIER_WEST, &dec12),
+             store.find("Guide Scope", ISD::Mount::PIER_WEST, &dec12));
+}
+
+void TestCalibrationStore::removeTest()
+{
+    CalibrationStore store(QStringList{ "garbage", "train|Cal v1.0,broken" });
+    store.add("A", makeCalibration(ISD::Mount::PIER_EAST, 10, 10, 0));
+    store.add("B", makeCalibration(ISD::Mount::PIER_EAST, 10, 0, 10));
+    // Unreadable entries are dropped
+    QCOMPARE(store.entries().size(), 2);
+
+    store.remove("A");
+    QCOMPARE(store.entries().size(), 1);
+    QVERIFY(store.find("A", ISD::Mount::PIER_EAST, nullptr).isEmpty());
+    QVERIFY(!store.find("B", ISD::Mount::PIER_EAST, nullptr).isEmpty());
+
+    // Calibrations of an unknown pier side can't be restored, they are never found
+    store.add("C", makeCalibration(ISD::Mount::PIER_UNKNOWN, 10, 10, 0));
+    QVERIFY(store.find("C", ISD::Mount::PIER_EAST, nullptr).isEmpty());
+}
+
+void TestCalibrationStore::limitTest()
+{
+    CalibrationStore store(QStringList{});
+    for (int i = 0; i < CalibrationStore::MAX_ENTRIES + 6; ++i)
+        store.add(QString("Train %1").arg(i), makeCalibration(ISD::Mount::PIER_WEST, 30, 10, 0));
+
+    QCOMPARE(store.entries().size(), CalibrationStore::MAX_ENTRIES);
+    QVERIFY(store.find("Train 0", ISD::Mount::PIER_WEST, nullptr).isEmpty());
+    QVERIFY(!store.find(QString("Train %1").arg(CalibrationStore::MAX_ENTRIES + 5), ISD::Mount::PIER_WEST,
+                        nullptr).isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestCalibrationStore)
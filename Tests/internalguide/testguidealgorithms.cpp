@@ -0,0 +1,245 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ekos/guide/internalguide/guidealgorithms.h"
+#include "fitsviewer/fitsdata.h"
+
+#include <QTest>
+
+#include <QObject>
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Compares the centroid kernels of GuideAlgorithms with the square algorithms of
+// findLocalStarPosition() on synthetic stars, for accuracy and for speed.
+
+class TestGuideAlgorithms : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestGuideAlgorithms();
+
+        /** @short Destructor */
+        ~TestGuideAlgorithms() override = default;
+
+    private slots:
+        void referenceTest();
+        void accuracyTest();
+        void noStarTest();
+        void compareTest();
+        void benchmark_data();
+        void benchmark();
+};
+
+#include "testguidealgorithms.moc"
+
+namespace
+{
+// The algorithm indices of findLocalStarPosition()
+constexpr int SMART_THRESHOLD = 0;
+constexpr int AUTO_THRESHOLD = 3;
+constexpr int NO_THRESHOLD = 4;
+
+constexpr int WIDTH = 160;
+constexpr int HEIGHT = 120;
+constexpr double SIGMA = 2.0;
+
+// A Gaussian star on a flat background, with Gaussian noise.
+template <typename T>
+std::vector<T> makeStar(double cx, double cy, double background, double peak, double noise, std::mt19937 &rng)
+{
+    std::normal_distribution<double> gauss(0, 1);
+    std::vector<T> image(WIDTH * HEIGHT);
+    for (int y = 0; y < HEIGHT; ++y)
+        for (int x = 0; x < WIDTH; ++x)
+        {
+            const double d2 = ((x - cx) * (x - cx) + (y - cy) * (y - cy)) / (2 * SIGMA * SIGMA);
+            const double v = background + peak * std::exp(-d2) + noise * gauss(rng);
+            image[y * WIDTH + x] = static_cast<T>(std::max(0.0, v));
+        }
+    return image;
+}
+
+// Wraps a 16 bit image in a FITSData, for findLocalStarPosition().
+QSharedPointer<FITSData> makeData(const std::vector<uint16_t> &image)
+{
+    QSharedPointer<FITSData> data(new FITSData(FITS_GUIDE));
+    FITSImage::Statistic stats;
+    stats.dataType = TUSHORT;
+    stats.bytesPerPixel = sizeof(uint16_t);
+    stats.width = WIDTH;
+    stats.height = HEIGHT;
+    stats.samples_per_channel = WIDTH * HEIGHT;
+    stats.size = WIDTH * HEIGHT * sizeof(uint16_t);
+    data->restoreStatistics(stats);
+
+    uint8_t *buffer = new uint8_t[stats.size];
+    memcpy(buffer, image.data(), stats.size);
+    data->setImageBuffer(buffer);
+    return data;
+}
+
+template <typename T>
+void checkAccuracy(double background, double peak, double noise, double tolerance)
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> offset(-2, 2);
+    const QRect box(50, 30, 60, 60);
+
+    double weightedError = 0, fitError = 0;
+    constexpr int TRIALS = 20;
+    for (int i = 0; i < TRIALS; ++i)
+    {
+        const double cx = 80 + offset(rng), cy = 60 + offset(rng);
+        const std::vector<T> image = makeStar<T>(cx, cy, background, peak, noise, rng);
+
+        const auto weighted = GuideAlgorithms::weightedCentroid(image.data(), WIDTH, box, background + 3 * noise);
+        QVERIFY(weighted.isValid());
+        QVERIFY(weighted.snr > 10);
+        weightedError = std::max(weightedError, std::hypot(weighted.x - cx, weighted.y - cy));
+
+        const auto fit = GuideAlgorithms::gaussianFit(image.data(), WIDTH, box);
+        QVERIFY(fit.isValid());
+        QVERIFY(std::fabs(fit.sigma - SIGMA) < 0.2);
+        QVERIFY(fit.residual < 0.05);
+        fitError = std::max(fitError, std::hypot(fit.x - cx, fit.y - cy));
+    }
+    qInfo() << "Largest errors, weighted centroid:" << weightedError << "Gaussian fit:" << fitError;
+    QVERIFY(weightedError < tolerance);
+    QVERIFY(fitError < tolerance);
+}
+
+}  // namespace
+
+TestGuideAlgorithms::TestGuideAlgorithms() : QObject()
+{
+}
+
+// The kernel has to give the result of the plain loop, also for box widths that aren't
+// a multiple of the vector width.
+void TestGuideAlgorithms::referenceTest()
+{
+    std::mt19937 rng(1);
+    const std::vector<uint16_t> image = makeStar<uint16_t>(70.3, 50.8, 1000, 20000, 30, rng);
+
+    for (int width : { 31, 32, 45 })
+    {
+        const QRect box(55, 35, width, width);
+        const double threshold = 1100;
+
+        double sumX = 0, sumY = 0, mass = 0;
+        for (int y = box.y(); y < box.y() + width; ++y)
+            for (int x = box.x(); x < box.x() + width; ++x)
+            {
+                const double w = std::max(0.0, image[y * WIDTH + x] - threshold);
+                sumX += x * w;
+                sumY += y * w;
+                mass += w;
+            }
+
+        const auto centroid = GuideAlgorithms::weightedCentroid(image.data(), WIDTH, box, threshold);
+        QVERIFY(centroid.isValid());
+        QVERIFY(std::fabs(centroid.x - sumX / mass) < 1e-4);
+        QVERIFY(std::fabs(centroid.y - sumY / mass) < 1e-4);
+        QVERIFY(std::fabs(centroid.flux - mass) < 1e-5 * mass);
+    }
+}
+
+void TestGuideAlgorithms::accuracyTest()
+{
+    // 8 bits quantize the wings of the star
+    checkAccuracy<uint8_t>(20, 200, 2, 0.2);
+    checkAccuracy<uint16_t>(1000, 20000, 30, 0.1);
+    checkAccuracy<float>(0.01, 0.5, 0.002, 0.1);
+}
+
+void TestGuideAlgorithms::noStarTest()
+{
+    std::mt19937 rng(3);
+    const std::vector<float> image = makeStar<float>(0, 0, 100, 0, 0, rng);
+    const QRect box(50, 30, 40, 40);
+
+    QVERIFY(!GuideAlgorithms::weightedCentroid(image.data(), WIDTH, box, 100).isValid());
+    QVERIFY(!GuideAlgorithms::gaussianFit(image.data(), WIDTH, box).isValid());
+    QVERIFY(!GuideAlgorithms::gaussianFit<float>(nullptr, WIDTH, box).isValid());
+}
+
+// Logs the accuracy of the square algorithms, next to the kernels, on the same stars.
+void TestGuideAlgorithms::compareTest()
+{
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> offset(-2, 2);
+    const QRect box(50, 30, 60, 60);
+
+    double smartError = 0, autoError = 0, fitError = 0;
+    constexpr int TRIALS = 10;
+    for (int i = 0; i < TRIALS; ++i)
+    {
+        const double cx = 80 + offset(rng), cy = 60 + offset(rng);
+        const std::vector<uint16_t> image = makeStar<uint16_t>(cx, cy, 1000, 20000, 30, rng);
+        QSharedPointer<FITSData> data = makeData(image);
+
+        const auto smart = GuideAlgorithms::findLocalStarPosition(data, SMART_THRESHOLD, WIDTH, HEIGHT, box);
+        smartError = std::max(smartError, std::hypot(smart.x - cx, smart.y - cy));
+        const auto automatic = GuideAlgorithms::findLocalStarPosition(data, AUTO_THRESHOLD, WIDTH, HEIGHT, box);
+        autoError = std::max(autoError, std::hypot(automatic.x - cx, automatic.y - cy));
+        const auto fit = GuideAlgorithms::gaussianFit(image.data(), WIDTH, box);
+        fitError = std::max(fitError, std::hypot(fit.x - cx, fit.y - cy));
+    }
+    qInfo() << "Largest errors, smart threshold:" << smartError << "auto threshold:" << autoError
+            << "Gaussian fit:" << fitError;
+    QVERIFY(smartError < 1);
+    QVERIFY(fitError <= smartError + 0.05);
+}
+
+void TestGuideAlgorithms::benchmark_data()
+{
+    QTest::addColumn<int>("method");
+    QTest::addColumn<int>("boxSize");
+
+    for (int size : { 32, 96 })
+    {
+        QTest::newRow(qPrintable(QString("smart threshold %1").arg(size))) << 0 << size;
+        QTest::newRow(qPrintable(QString("no threshold %1").arg(size))) << 1 << size;
+        QTest::newRow(qPrintable(QString("weighted centroid %1").arg(size))) << 2 << size;
+        QTest::newRow(qPrintable(QString("gaussian fit %1").arg(size))) << 3 << size;
+    }
+}
+
+void TestGuideAlgorithms::benchmark()
+{
+    QFETCH(int, method);
+    QFETCH(int, boxSize);
+
+    std::mt19937 rng(5);
+    const std::vector<uint16_t> image = makeStar<uint16_t>(80.4, 60.6, 1000, 20000, 30, rng);
+    QSharedPointer<FITSData> data = makeData(image);
+    const QRect box(80 - boxSize / 2, 60 - boxSize / 2, boxSize, boxSize);
+    QVERIFY(box.bottom() < HEIGHT - 4);
+
+    switch (method)
+    {
+        case 0:
+            QBENCHMARK { GuideAlgorithms::findLocalStarPosition(data, SMART_THRESHOLD, WIDTH, HEIGHT, box); }
+            break;
+        case 1:
+            QBENCHMARK { GuideAlgorithms::findLocalStarPosition(data, NO_THRESHOLD, WIDTH, HEIGHT, box); }
+            break;
+        case 2:
+            QBENCHMARK { GuideAlgorithms::weightedCentroid(image.data(), WIDTH, box, 1100); }
+            break;
+        case 3:
+            QBENCHMARK { GuideAlgorithms::gaussianFit(image.data(), WIDTH, box); }
+            break;
+    }
+}
+
+QTEST_GUILESS_MAIN(TestGuideAlgorithms)
@@ -0,0 +1,149 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ekos/guide/internalguide/guidetelemetry.h"
+
+#include <QTemporaryDir>
+#include <QTest>
+#include <QObject>
+
+class TestGuideTelemetry : public QObject
+{
+        Q_OBJECT
+
+    public:
+        TestGuideTelemetry() : QObject() {}
+        ~TestGuideTelemetry() override = default;
+
+    private slots:
+        void writeReadTest();
+        void convertTest();
+        void badFileTest();
+
+    private:
+        void writeSession(const QString &filename);
+
+        GuideLog::GuideInfo m_Info;
+        QVector<GuideLog::GuideData> m_Data;
+        QDateTime m_Start, m_End;
+};
+
+#include "testguidetelemetry.moc"
+
+void TestGuideTelemetry::writeSession(const QString &filename)
+{
+    m_Info.pixelScale = 1.25;
+    m_Info.binning = 2;
+    m_Info.focalLength = 400;
+    m_Info.ra = 150;
+    m_Info.dec = 45.5;
+    m_Info.pierSide = ISD::Mount::PierSide::PIER_UNKNOWN;
+    m_Info.xangle = 90;
+
+    m_Data.clear();
+    for (int i = 0; i < 100; ++i)
+    {
+        GuideLog::GuideData data;
+        data.dx = 0.125 * i;
+        data.dy = -0.5;
+        data.raDuration = 10 * i;
+        data.raDirection = RA_INC_DIR;
+        data.decDirection = DEC_DEC_DIR;
+        data.snr = 25;
+        data.mass = 1000 + i;
+        data.starsDetected = 40;
+        data.starsUsed = 12;
+        if (i % 10 == 9)
+        {
+            data.type = GuideLog::GuideData::DROP;
+            data.code = GuideLog::GuideData::NO_STAR_FOUND;
+        }
+        m_Data.push_back(data);
+    }
+
+    // Whole seconds, as the text log shows.
+    m_Start = QDateTime::fromSecsSinceEpoch(QDateTime::currentSecsSinceEpoch());
+    m_End = m_Start.addSecs(60);
+
+    GuideTelemetry telemetry;
+    QVERIFY(telemetry.open(filename));
+    telemetry.startGuiding(m_Info, m_Start);
+    for (int i = 0; i < m_Data.size(); ++i)
+        telemetry.addGuideData(i + 1, m_Data[i]);
+    telemetry.endGuiding(m_End);
+    telemetry.close();
+    QCOMPARE(telemetry.droppedRecords(), 0);
+}
+
+void TestGuideTelemetry::writeReadTest()
+{
+    QTemporaryDir dir;
+    const QString filename = dir.filePath(QString("test") + GuideTelemetry::FILE_EXTENSION);
+    writeSession(filename);
+
+    QVector<GuideTelemetry::Record> records;
+    QVERIFY(GuideTelemetry::read(filename, &records));
+    QCOMPARE(records.size(), m_Data.size() + 2);
+
+    QCOMPARE(records.first().type, static_cast<quint8>(GuideTelemetry::GUIDING_START));
+    QCOMPARE(records.first().timestamp, m_Start.toMSecsSinceEpoch());
+    QCOMPARE(records.first().index, 2);
+    QCOMPARE(records.first().code, static_cast<qint8>(-1));
+    QCOMPARE(records.first().start.pixelScale, 1.25f);
+    QCOMPARE(records.last().type, static_cast<quint8>(GuideTelemetry::GUIDING_END));
+
+    for (int i = 0; i < m_Data.size(); ++i)
+    {
+        const auto &record = records[i + 1];
+        QCOMPARE(record.type, static_cast<quint8>(i % 10 == 9 ? GuideTelemetry::GUIDE_DROP : GuideTelemetry::GUIDE_FRAME));
+        QCOMPARE(record.index, i + 1);
+        QCOMPARE(record.frame.dx, static_cast<float>(m_Data[i].dx));
+        QCOMPARE(record.frame.raDuration, m_Data[i].raDuration);
+        QCOMPARE(record.raDirection, static_cast<quint8>(RA_INC_DIR));
+        QCOMPARE(record.frame.starsDetected, 40);
+        QCOMPARE(record.frame.starsUsed, 12);
+    }
+}
+
+void TestGuideTelemetry::convertTest()
+{
+    QTemporaryDir dir;
+    const QString filename = dir.filePath(QString("test") + GuideTelemetry::FILE_EXTENSION);
+    writeSession(filename);
+
+    QVector<GuideTelemetry::Record> records;
+    QVERIFY(GuideTelemetry::read(filename, &records));
+
+    const QString textFilename = dir.filePath("test.txt");
+    QVERIFY(GuideTelemetry::convertToText(filename, textFilename));
+    QFile file(textFilename);
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+    const QString text = QString::fromUtf8(file.readAll());
+
+    // The frame times depend on when they were recorded, so take them from the records.
+    QString expected = GuideLog::logStartText(m_Start) + GuideLog::guidingStartText(m_Info, m_Start);
+    for (int i = 0; i < m_Data.size(); ++i)
+        expected += GuideLog::guideDataText(i + 1, (records[i + 1].timestamp - m_Start.toMSecsSinceEpoch()) / 1000.0,
+                                            m_Data[i]);
+    expected += GuideLog::guidingEndText(m_End) + GuideLog::logEndText(m_End);
+    QCOMPARE(text, expected);
+}
+
+void TestGuideTelemetry::badFileTest()
+{
+    QTemporaryDir dir;
+    const QString filename = dir.filePath("bad.txt");
+    QFile file(filename);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("KStars version 3.7. PHD2 log version 2.5.\n");
+    file.close();
+
+    QVector<GuideTelemetry::Record> records;
+    QVERIFY(!GuideTelemetry::read(filename, &records));
+    QVERIFY(!GuideTelemetry::convertToText(filename, dir.filePath("out.txt")));
+}
+
+QTEST_GUILESS_MAIN(TestGuideTelemetry)
@@ -10,6 +10,9 @@
 
 #include <QObject>
 
+#include <algorithm>
+#include <cmath>
+
 
 class TestStarCorrespondence : public QObject
 {
@@ -230,12 +233,67 @@ void runNoCorrespondenceTest()
         QVERIFY(output[i] == -1);
 }
 
+// Checks a field with many references and unrelated stars in between.
+void runManyReferencesTest()
+{
+    constexpr double maxDistanceToStar = 5.0;
+    constexpr int guideStar = 7;
+
+    // 60 references and 100 other stars, at least 25 pixels apart.
+    QList<Edge> stars, others;
+    uint32_t seed = 12345;
+    while (stars.size() + others.size() < 160)
+    {
+        seed = seed * 1103515245 + 12345;
+        const float x = 10 + (seed >> 8) % 1260;
+        seed = seed * 1103515245 + 12345;
+        const float y = 10 + (seed >> 8) % 940;
+        const bool crowded = std::any_of(stars.cbegin(), stars.cend(), [&](const Edge & e)
+        {
+            return hypot(e.x - x, e.y - y) < 25;
+        }) || std::any_of(others.cbegin(), others.cend(), [&](const Edge & e)
+        {
+            return hypot(e.x - x, e.y - y) < 25;
+        });
+        if (crowded)
+            continue;
+        if (stars.size() < 60)
+            stars.append(makeEdge(x, y));
+        else
+            others.append(makeEdge(x, y));
+    }
+    StarCorrespondence c(stars, guideStar);
+    c.setImageSize(1280, 960);
+
+    // The field moved a little, the references are followed by the other stars.
+    QList<Edge> stars2;
+    for (const auto &star : stars)
+        stars2.append(makeEdge(star.x + 2.5, star.y - 1.5));
+    stars2.append(others);
+
+    QVector<int> output;
+    Edge gStar = c.find(stars2, maxDistanceToStar, &output, false);
+    QVERIFY(gStar.x == stars2[guideStar].x);
+    QVERIFY(gStar.y == stars2[guideStar].y);
+    QCOMPARE(c.getNumReferencesFound(), stars.size() - 1);
+    for (int i = 0; i < output.size(); ++i)
+        QCOMPARE(output[i], i < stars.size() ? i : -1);
+
+    // Without the guide star, its position is invented from the others.
+    stars2.removeAt(guideStar);
+    c.setAllowMissingGuideStar(true);
+    gStar = c.find(stars2, maxDistanceToStar, &output, false);
+    QVERIFY(fabs(gStar.x - (stars[guideStar].x + 2.5)) < .001);
+    QVERIFY(fabs(gStar.y - (stars[guideStar].y - 1.5)) < .001);
+}
+
 void TestStarCorrespondence::basicTest()
 {
     for (int i = 0; i < 6; ++i)
         runTest(i);
     runAdaptationTest();
     runNoCorrespondenceTest();
+    runManyReferencesTest();
 }
 
 QTEST_GUILESS_MAIN(TestStarCorrespondence)
@@ -130,6 +130,8 @@ void TestEkosSchedulerOps::init()
     Options::setSettingAltitudeCutoff(0);
     Options::setSchedulerAlgorithm(Ekos::ALGORITHM_GREEDY);
     Options::setGreedyScheduling(true);
+    // The mock modules run on simulated time, keep checking the running job every iteration
+    Options::setSchedulerWatchdogPeriod(1);
 }
 
 void TestEkosSchedulerOps::cleanup()
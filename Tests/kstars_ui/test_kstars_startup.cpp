@@ -16,6 +16,7 @@
 #include "kstars.h"
 #include "kspaths.h"
 #include "kswizard.h"
+#include "startupprofiler.h"
 #include <KTipDialog>
 
 #include "kstars_ui_tests.h"
@@ -163,3 +164,40 @@ void TestKStarsStartup::testInitialConditions()
              m_InitialConditions.dateTime.toSecsSinceEpoch());
 #endif
 }
+
+void TestKStarsStartup::startupBenchmarkTest()
+{
+    // The startup finishes once the data deferred after the first frame is loaded
+    const StartupProfiler &profiler = StartupProfiler::instance();
+    QTRY_VERIFY_WITH_TIMEOUT(profiler.isFinished(), 30000);
+    qInfo().noquote() << "Startup profile:\n" << profiler.toText();
+
+    // Budgets in milliseconds, which slower machines may scale with KSTARS_STARTUP_BUDGET_SCALE
+    const QList<QPair<QString, double>> budgets =
+    {
+        { "KStarsData::initialize", 15000 },
+        { "SkyMapComposite", 12000 },
+        { "KStars::buildGUI", 5000 },
+        { "KStarsData::loadDeferredData", 5000 },
+        { "Startup", 30000 },
+    };
+    bool scaleSet = false;
+    double scale = qEnvironmentVariable("KSTARS_STARTUP_BUDGET_SCALE").toDouble(&scaleSet);
+    if (!scaleSet || scale <= 0)
+        scale = 1;
+
+    for (const auto &budget : budgets)
+    {
+        const StartupProfiler::Entry *entry = profiler.entry(budget.first);
+        QVERIFY2(entry != nullptr, qPrintable(QString("Startup phase %1 was not recorded").arg(budget.first)));
+        QVERIFY2(entry->milliseconds <= budget.second * scale,
+                 qPrintable(QString("Startup phase %1 took %2 ms, over its budget of %3 ms")
+                            .arg(budget.first).arg(entry->milliseconds).arg(budget.second * scale)));
+    }
+
+    // Where the platform reports it, the resident memory after startup is bounded too
+    const StartupProfiler::Entry *startup = profiler.entry("Startup");
+    if (startup->memory > 0)
+        QVERIFY2(startup->memory <= 2048.0 * 1048576 * scale,
+                 qPrintable(QString("KStars is resident in %1 MiB after startup").arg(startup->memory / 1048576)));
+}
@@ -53,6 +53,7 @@ private slots:
 
     void createInstanceTest();
     void testInitialConditions();
+    void startupBenchmarkTest();
 };
 
 #endif // TEST_KSTARS_STARTUP_H
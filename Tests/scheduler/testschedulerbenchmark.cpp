@@ -0,0 +1,221 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+/*
+ * This file contains benchmarks for the scheduler planning: scheduling a queue,
+ * estimating the duration of its jobs, and simulating a full night.
+ * The queues are either synthetic, with mixed constraints, or the .esl test vectors.
+ *
+ * Run with "-o results.xml,xml" or "-csv" to get machine-readable results.
+ */
+
+#include "ekos/scheduler/schedulerutils.h"
+#include "ekos/scheduler/greedyscheduler.h"
+#include "ekos/scheduler/schedulerjob.h"
+#include "ekos/scheduler/schedulermodulestate.h"
+#include "geolocation.h"
+#include "Options.h"
+
+#include <QFileInfo>
+#include <QSignalSpy>
+#include <QTest>
+
+#include <QObject>
+
+class TestSchedulerBenchmark : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short Constructor */
+        TestSchedulerBenchmark();
+
+        /** @short Destructor */
+        ~TestSchedulerBenchmark() override = default;
+
+    private slots:
+        void scheduleJobsBenchmark_data();
+        void scheduleJobsBenchmark();
+        void estimateJobTimeBenchmark_data();
+        void estimateJobTimeBenchmark();
+        void nightSimulationBenchmark_data();
+        void nightSimulationBenchmark();
+
+    private:
+        void addQueues();
+};
+
+#include "testschedulerbenchmark.moc"
+
+// Same place and time as the scheduler unit tests, starting at 8pm.
+GeoLocation siliconValley(dms(-122, 10), dms(37, 26, 30), "Silicon Valley", "CA", "USA", -7);
+KStarsDateTime localTime8pm(QDateTime(QDate(2021, 4, 16), QTime(20, 0, 0), QTimeZone(-7 * 3600)));
+
+namespace
+{
+// The jobs of a queue, deleted with it.
+struct Queue
+{
+    QList<Ekos::SchedulerJob *> jobs;
+    ~Queue()
+    {
+        qDeleteAll(jobs);
+    }
+};
+
+const QStringList sequenceFiles = {"9filters.esq", "1x1s_RGBLumRGB.esq", "3x30s_Red.esq", "1x1s_Lum.esq"};
+
+// Jobs spread over the sky, cycling through the startup and completion conditions and the constraints.
+void createSyntheticQueue(Queue &queue, int count)
+{
+    const KStarsDateTime ut = siliconValley.LTtoUT(localTime8pm);
+
+    for (int i = 0; i < count; ++i)
+    {
+        auto job = new Ekos::SchedulerJob();
+
+        const bool startAt = i % 5 == 4;
+        Ekos::CompletionCondition completion = Ekos::FINISH_SEQUENCE;
+        QDateTime completionTime;
+        switch (i % 4)
+        {
+            case 1:
+                completion = Ekos::FINISH_REPEAT;
+                break;
+            case 2:
+                completion = Ekos::FINISH_AT;
+                completionTime = localTime8pm.addSecs(3600 * (4 + i % 6));
+                break;
+            case 3:
+                completion = Ekos::FINISH_LOOP;
+                break;
+        }
+
+        Ekos::SchedulerUtils::setupJob(*job, QString("Job%1").arg(i), QString("Group%1").arg(i % 7),
+                                       dms(std::fmod(i * 137.5, 360.0)), dms(-20 + (i * 11) % 90), ut.djd(), 0.0,
+                                       QUrl::fromLocalFile(sequenceFiles[i % sequenceFiles.size()]), QUrl(""),
+                                       startAt ? Ekos::START_AT : Ekos::START_ASAP,
+                                       startAt ? localTime8pm.addSecs(1800 * (i % 12)) : QDateTime(),
+                                       completion, completionTime, 1 + i % 3,
+                                       15.0 * (i % 4), (i % 3) * 20.0,
+                                       false, i % 2 == 0, i % 3 == 0,
+                                       true, i % 2 == 1, i % 3 == 1, true);
+        queue.jobs.append(job);
+    }
+}
+
+// The .esl test vectors refer to their sequences in /tmp/kstars_tests, use the copies next to the benchmark instead.
+bool loadFixtureQueue(Queue &queue, const QString &fixture)
+{
+    if (!Ekos::SchedulerUtils::loadJobs(fixture, queue.jobs, nullptr))
+        return false;
+
+    for (auto job : queue.jobs)
+        job->setSequenceFile(QUrl::fromLocalFile(QFileInfo(job->getSequenceFile().toLocalFile()).fileName()));
+    return !queue.jobs.isEmpty();
+}
+
+void loadQueue(Queue &queue)
+{
+    QFETCH(QString, FIXTURE);
+    QFETCH(int, COUNT);
+
+    if (FIXTURE.isEmpty())
+        createSyntheticQueue(queue, COUNT);
+    else
+        QVERIFY2(loadFixtureQueue(queue, FIXTURE), qPrintable(FIXTURE));
+}
+}  // namespace
+
+TestSchedulerBenchmark::TestSchedulerBenchmark() : QObject()
+{
+    // Same options as the scheduler unit tests, which don't instantiate KStarsData::Instance().
+    Options::setDitherEnabled(false);
+    Options::setSettingAltitudeCutoff(0);
+    Options::setUseRelativistic(false);
+
+    Ekos::SchedulerModuleState::setGeo(&siliconValley);
+    Ekos::SchedulerModuleState::setLocalTime(&localTime8pm);
+}
+
+void TestSchedulerBenchmark::addQueues()
+{
+    QTest::addColumn<QString>("FIXTURE");
+    QTest::addColumn<int>("COUNT");
+
+    for (const int count : {10, 100, 1000})
+        QTest::newRow(qPrintable(QString("synthetic-%1").arg(count))) << QString() << count;
+
+    for (const auto &fixture :
+            {
+                "simple_test.esl", "culmination_no_twilight.esl", "distant_jobs_no_twilight.esl",
+                "duplicated_scheduler_jobs_no_twilight.esl", "repeated_jobs_no_twilight.esl",
+                "start_at_finish_at_test.esl"
+            })
+        QTest::newRow(fixture) << QString(fixture) << 0;
+}
+
+void TestSchedulerBenchmark::scheduleJobsBenchmark_data()
+{
+    addQueues();
+}
+
+void TestSchedulerBenchmark::scheduleJobsBenchmark()
+{
+    Queue queue;
+    loadQueue(queue);
+    const QMap<QString, uint16_t> capturedFrames;
+
+    Ekos::GreedyScheduler scheduler;
+    scheduler.setParams(true, true, true, 3600, 3600);
+
+    QBENCHMARK_ONCE
+    {
+        scheduler.scheduleJobs(queue.jobs, localTime8pm, capturedFrames, nullptr);
+    }
+    QVERIFY(!scheduler.getSchedule().isEmpty());
+}
+
+void TestSchedulerBenchmark::estimateJobTimeBenchmark_data()
+{
+    addQueues();
+}
+
+void TestSchedulerBenchmark::estimateJobTimeBenchmark()
+{
+    Queue queue;
+    loadQueue(queue);
+    const QMap<QString, uint16_t> capturedFrames;
+
+    QBENCHMARK
+    {
+        for (auto job : queue.jobs)
+            Ekos::SchedulerUtils::estimateJobTime(job, capturedFrames, nullptr);
+    }
+}
+
+void TestSchedulerBenchmark::nightSimulationBenchmark_data()
+{
+    addQueues();
+}
+
+void TestSchedulerBenchmark::nightSimulationBenchmark()
+{
+    Queue queue;
+    loadQueue(queue);
+
+    Ekos::GreedyScheduler scheduler;
+    scheduler.setParams(true, true, true, 3600, 3600);
+    QSignalSpy planned(&scheduler, &Ekos::GreedyScheduler::nightsPlanned);
+
+    QBENCHMARK_ONCE
+    {
+        QVERIFY(scheduler.planNightsInBackground(queue.jobs, localTime8pm.date(), localTime8pm.date()));
+        QVERIFY(planned.wait(3600 * 1000));
+    }
+}
+
+QTEST_GUILESS_MAIN(TestSchedulerBenchmark)
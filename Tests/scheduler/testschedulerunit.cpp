@@ -18,8 +18,14 @@
 #include "ekos/capture/sequencejob.h"
 #include "ekos/capture/placeholderpath.h"
 #include "geolocation.h"
+#include "ksalmanac.h"
+#include "ksnumbers.h"
 #include "Options.h"
 
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSignalSpy>
+#include <QTemporaryDir>
 #include <QTest>
 #include <memory>
 
@@ -46,6 +52,10 @@ class TestSchedulerUnit : public QObject
         void loadSequenceQueueTest();
         void estimateJobTimeTest();
         void evaluateJobsTest();
+        void backgroundScheduleTest();
+        void parallelScheduleTest();
+        void planNightsTest();
+        void almanacTest();
 
     private:
         void runSetupJob(Ekos::SchedulerJob &job,
@@ -348,6 +358,35 @@ void TestSchedulerUnit::loadSequenceQueueTest()
     QVERIFY(Ekos::SchedulerUtils::loadSequenceQueue(seqFile9Filters, &schedJob, jobs, hasAutoFocus, nullptr));
     // Makes sure we have the basic details of the capture sequence were read properly.
     compareCaptureSequence(details9Filters, jobs);
+    qDeleteAll(jobs);
+    jobs.clear();
+
+    // A copy of the file is read from the cache, until it is modified.
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString copy = dir.filePath("copy.esq");
+    QVERIFY(QFile::copy(seqFile9Filters, copy));
+    QVERIFY(Ekos::SchedulerUtils::loadSequenceQueue(copy, &schedJob, jobs, hasAutoFocus, nullptr));
+    compareCaptureSequence(details9Filters, jobs);
+    qDeleteAll(jobs);
+    jobs.clear();
+
+    // Keep the first job only.
+    QFile file(copy);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QByteArray contents = file.readAll();
+    const int first = contents.indexOf("</Job>") + 6, last = contents.lastIndexOf("</Job>") + 6;
+    contents.remove(first, last - first);
+    QVERIFY(file.resize(0));
+    QVERIFY(file.write(contents) == contents.size());
+    file.close();
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.setFileTime(QDateTime::currentDateTime().addSecs(10), QFileDevice::FileModificationTime));
+    file.close();
+
+    QVERIFY(Ekos::SchedulerUtils::loadSequenceQueue(copy, &schedJob, jobs, hasAutoFocus, nullptr));
+    compareCaptureSequence(details9Filters.mid(0, 1), jobs);
+    qDeleteAll(jobs);
 }
 
 namespace
@@ -606,4 +645,188 @@ void TestSchedulerUnit::evaluateJobsTest()
     jobs.clear();
 }
 
+// Test GreedyScheduler::scheduleJobsInBackground(), which should find the schedule of Test 3 of evaluateJobsTest().
+void TestSchedulerUnit::backgroundScheduleTest()
+{
+    Ekos::GreedyScheduler scheduler;
+    Ekos::SchedulerModuleState state;
+    auto localTime8pm = midNight.addSecs(-4 * 3600);
+    state.setLocalTime(&localTime8pm);
+    const QMap<QString, uint16_t> capturedFrames;
+    QList<Ekos::SchedulerJob *> jobs;
+    scheduler.setParams(true, true, true, 3600, 3600);
+
+    Ekos::SchedulerJob job1(nullptr);
+    runSetupJob(job1, &siliconValley, &localTime8pm, "Job1",
+                midnightRA, testDEC, 0.0,
+                QUrl(QString("file:%1").arg(seqFile9Filters)), QUrl(""),
+                Ekos::START_ASAP, QDateTime(),
+                Ekos::FINISH_REPEAT, QDateTime(), 2,
+                80.0);
+    jobs.append(&job1);
+    Ekos::SchedulerJob job2(nullptr);
+    runSetupJob(job2, &siliconValley, &localTime8pm, "Job2",
+                midnightRA, testDEC, 0.0,
+                QUrl(QString("file:%1").arg(seqFile9Filters)), QUrl(""),
+                Ekos::START_ASAP, QDateTime(),
+                Ekos::FINISH_SEQUENCE, QDateTime(), 1,
+                30.0);
+    jobs.append(&job2);
+
+    // The jobs are left untouched until the schedule is applied.
+    QSignalSpy done(&scheduler, &Ekos::GreedyScheduler::backgroundScheduleDone);
+    const auto state1 = job1.getState(), state2 = job2.getState();
+    scheduler.scheduleJobsInBackground(jobs, localTime8pm, capturedFrames, nullptr);
+    QVERIFY(scheduler.isSchedulingInBackground());
+    QVERIFY(job1.getState() == state1);
+    QVERIFY(job2.getState() == state2);
+    QVERIFY(done.wait(60000));
+
+    QVERIFY(scheduler.applyBackgroundSchedule(jobs, nullptr));
+    QVERIFY(!scheduler.isSchedulingInBackground());
+    QVERIFY(scheduler.getScheduledJob() == &job2);
+    QVERIFY(job2.getState() == Ekos::SCHEDJOB_SCHEDULED);
+    QVERIFY(!scheduler.getSchedule().isEmpty());
+    for (const auto &entry : scheduler.getSchedule())
+        QVERIFY(jobs.contains(entry.job));
+    QVERIFY(compareTimes(job1.getStartupTime(), midNight.addSecs(-50 * 60), 300));
+    QVERIFY(compareTimes(job1.getCompletionTime(), midNight.addSecs(43 * 60), 300));
+    QVERIFY(compareTimes(job2.getStartupTime(), localTime8pm, 300));
+    QVERIFY(compareTimes(job2.getCompletionTime(), localTime8pm.addSecs(48 * 60), 300));
+
+    // A job that changed meanwhile drops the schedule.
+    scheduler.scheduleJobsInBackground(jobs, localTime8pm, capturedFrames, nullptr);
+    QVERIFY(done.wait(60000));
+    job1.setState(Ekos::SCHEDJOB_ABORTED);
+    QVERIFY(!scheduler.applyBackgroundSchedule(jobs, nullptr));
+    QVERIFY(job1.getState() == Ekos::SCHEDJOB_ABORTED);
+
+    // A cancelled schedule is never done.
+    done.clear();
+    scheduler.scheduleJobsInBackground(jobs, localTime8pm, capturedFrames, nullptr);
+    scheduler.cancelBackgroundSchedule();
+    QVERIFY(!scheduler.isSchedulingInBackground());
+    QVERIFY(!done.wait(1000));
+    QVERIFY(!scheduler.applyBackgroundSchedule(jobs, nullptr));
+}
+
+// Jobs evaluated in parallel should be scheduled as when evaluated one at a time.
+void TestSchedulerUnit::parallelScheduleTest()
+{
+    auto localTime8pm = midNight.addSecs(-4 * 3600);
+    Ekos::SchedulerModuleState state;
+    state.setLocalTime(&localTime8pm);
+    const QMap<QString, uint16_t> capturedFrames;
+
+    // Jobs rising one after the other, all wanting to start at 8pm.
+    std::vector<std::unique_ptr<Ekos::SchedulerJob>> jobs;
+    QList<Ekos::SchedulerJob *> jobList;
+    for (int i = 0; i < 6; ++i)
+    {
+        jobs.emplace_back(new Ekos::SchedulerJob(nullptr));
+        runSetupJob(*jobs.back(), &siliconValley, &localTime8pm, QString("Job%1").arg(i),
+                    dms(midnightRA.Degrees() - 15 * i), testDEC, 0.0,
+                    QUrl(QString("file:%1").arg(seqFile9Filters)), QUrl(""),
+                    Ekos::START_ASAP, QDateTime(),
+                    Ekos::FINISH_SEQUENCE, QDateTime(), 1,
+                    60.0);
+        jobList.append(jobs.back().get());
+    }
+
+    const auto threads = Options::schedulerThreads();
+    QList<QDateTime> startTimes;
+    QList<int> schedule;
+    for (const uint value : {1u, 4u})
+    {
+        Options::setSchedulerThreads(value);
+        Ekos::GreedyScheduler scheduler;
+        scheduler.setParams(true, true, true, 3600, 3600);
+        for (auto &job : jobs)
+            job->setState(Ekos::SCHEDJOB_IDLE);
+        scheduler.scheduleJobs(jobList, localTime8pm, capturedFrames, nullptr);
+
+        QList<QDateTime> times;
+        QList<int> order;
+        for (auto job : jobList)
+            times.append(job->getStartupTime());
+        for (const auto &entry : scheduler.getSchedule())
+            order.append(jobList.indexOf(entry.job));
+        QVERIFY(!order.isEmpty());
+        if (startTimes.isEmpty())
+        {
+            startTimes = times;
+            schedule = order;
+        }
+        else
+        {
+            QCOMPARE(times, startTimes);
+            QCOMPARE(order, schedule);
+        }
+    }
+    Options::setSchedulerThreads(threads);
+}
+
+// Each night is planned on its own, as if nothing had been captured.
+void TestSchedulerUnit::planNightsTest()
+{
+    Ekos::GreedyScheduler scheduler;
+    Ekos::SchedulerModuleState state;
+    auto localTime8pm = midNight.addSecs(-4 * 3600);
+    state.setLocalTime(&localTime8pm);
+    scheduler.setParams(true, true, true, 3600, 3600);
+
+    Ekos::SchedulerJob job(nullptr);
+    runSetupJob(job, &siliconValley, &localTime8pm, "Job1",
+                midnightRA, testDEC, 0.0,
+                QUrl(QString("file:%1").arg(seqFile9Filters)), QUrl(""),
+                Ekos::START_ASAP, QDateTime(),
+                Ekos::FINISH_SEQUENCE, QDateTime(), 1,
+                30.0);
+    const auto jobState = job.getState();
+
+    QSignalSpy planned(&scheduler, &Ekos::GreedyScheduler::nightsPlanned);
+    const QDate firstNight = localTime8pm.date();
+    QVERIFY(scheduler.planNightsInBackground({&job}, firstNight, firstNight.addDays(2)));
+    QVERIFY(scheduler.isPlanningNights());
+    QVERIFY(!scheduler.planNightsInBackground({&job}, firstNight, firstNight));
+    QVERIFY(planned.wait(120000));
+    QVERIFY(!scheduler.isPlanningNights());
+    QVERIFY(job.getState() == jobState);
+
+    const QJsonObject report = planned.first().first().toJsonObject();
+    const QJsonArray nights = report["nights"].toArray();
+    QCOMPARE(nights.size(), 3);
+    double total = 0;
+    for (int i = 0; i < nights.size(); ++i)
+    {
+        const QJsonObject night = nights[i].toObject();
+        QCOMPARE(night["date"].toString(), firstNight.addDays(i).toString(Qt::ISODate));
+        // The sequence takes 48 minutes.
+        const double hours = night["hours"].toObject()["Job1"].toDouble();
+        QVERIFY(std::abs(hours - 0.8) < 0.1);
+        total += hours;
+    }
+    QVERIFY(std::abs(report["totals"].toObject()["Job1"].toDouble() - total) < 1e-6);
+}
+
+// The almanac of a day is shared, and interpolates the Moon's position closely.
+void TestSchedulerUnit::almanacTest()
+{
+    const KStarsDateTime utMidnight(midNight.toUTC());
+    const auto almanac = KSAlmanac::forDay(utMidnight, &siliconValley);
+    QVERIFY(almanac == KSAlmanac::forDay(utMidnight, &siliconValley));
+    QVERIFY(almanac != KSAlmanac::forDay(KStarsDateTime(utMidnight.addDays(1)), &siliconValley));
+
+    for (int minutes : {-30, 197, 1433})
+    {
+        const KStarsDateTime ut(utMidnight.addSecs(minutes * 60));
+        KSMoon moon;
+        KSNumbers numbers(ut.djd());
+        CachingDms LST = siliconValley.GSTtoLST(ut.gst());
+        moon.updateCoords(&numbers, true, siliconValley.lat(), &LST, true);
+        const SkyPoint position = almanac->moonPosition(ut);
+        QVERIFY(position.angularDistanceTo(&moon).Degrees() < 0.01);
+    }
+}
+
 QTEST_GUILESS_MAIN(TestSchedulerUnit)
@@ -0,0 +1,109 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "test_chebyshevephemeris.h"
+
+#include "skyobjects/chebyshevephemeris.h"
+#include "skyobjects/keplersolver.h"
+
+#include <cmath>
+
+namespace
+{
+/// Heliocentric position on an inclined Keplerian orbit, a stand-in for the series
+ChebyshevEphemeris::Function orbit(double period, double e, double a)
+{
+    return [ = ](double days, double * xyz)
+    {
+        const double E = KeplerSolver::eccentricAnomaly(2 * M_PI * days / period, e);
+        const double x = a * (std::cos(E) - e);
+        const double y = a * std::sqrt(1 - e * e) * std::sin(E);
+        xyz[0]         = x;
+        xyz[1]         = y * std::cos(0.1);
+        xyz[2]         = y * std::sin(0.1);
+    };
+}
+}
+
+void TestChebyshevEphemeris::testAccuracy_data()
+{
+    QTest::addColumn<double>("period");
+    QTest::addColumn<double>("e");
+    QTest::addColumn<double>("a");
+    QTest::addColumn<double>("span");
+
+    QTest::newRow("Mercury") << 87.97 << 0.2056 << 0.387 << 16.0;
+    QTest::newRow("Mars") << 686.98 << 0.0934 << 1.524 << 32.0;
+    QTest::newRow("Neptune") << 60190.0 << 0.0086 << 30.07 << 128.0;
+    QTest::newRow("Moon") << 27.32 << 0.0549 << 0.00257 << 8.0;
+}
+
+void TestChebyshevEphemeris::testAccuracy()
+{
+    QFETCH(double, period);
+    QFETCH(double, e);
+    QFETCH(double, a);
+    QFETCH(double, span);
+
+    const ChebyshevEphemeris::Function exact = orbit(period, e, a);
+    ChebyshevEphemeris cache(exact, span, 13, 1e-9);
+
+    // Both sides of J2000, over several segments
+    for (double days = -3.3 * span; days < 3.3 * span; days += span / 7.3)
+    {
+        double cached[3], expected[3];
+        cache.evaluate(days, cached);
+        exact(days, expected);
+
+        QVERIFY(cache.errorBound(days) > 0);
+        for (int k = 0; k < 3; ++k)
+            QVERIFY2(std::fabs(cached[k] - expected[k]) < 1e-9, qPrintable(QString::number(days)));
+    }
+}
+
+void TestChebyshevEphemeris::testFallback()
+{
+    const ChebyshevEphemeris::Function exact = orbit(87.97, 0.2056, 0.387);
+
+    // A degree far too low for the span, the positions have to come from the function
+    ChebyshevEphemeris cache(exact, 64, 3, 1e-9);
+    double cached[3], expected[3];
+    cache.evaluate(10.5, cached);
+    exact(10.5, expected);
+
+    QCOMPARE(cache.errorBound(10.5), 0.0);
+    for (int k = 0; k < 3; ++k)
+        QCOMPARE(cached[k], expected[k]);
+}
+
+void TestChebyshevEphemeris::testSegments()
+{
+    int calls = 0;
+    const ChebyshevEphemeris::Function exact = orbit(686.98, 0.0934, 1.524);
+    ChebyshevEphemeris cache([&](double days, double * xyz)
+    {
+        ++calls;
+        exact(days, xyz);
+    }, 32, 13, 1e-9);
+
+    QCOMPARE(cache.segmentCount(), 0);
+
+    double xyz[3];
+    for (double days = 0; days < 32; days += 0.25)
+        cache.evaluate(days, xyz);
+
+    // One segment, sampled once at its nodes
+    QCOMPARE(cache.segmentCount(), 1);
+    QCOMPARE(calls, cache.degree() + 1);
+
+    cache.evaluate(-0.5, xyz);
+    QCOMPARE(cache.segmentCount(), 2);
+
+    cache.clear();
+    QCOMPARE(cache.segmentCount(), 0);
+}
+
+QTEST_GUILESS_MAIN(TestChebyshevEphemeris)
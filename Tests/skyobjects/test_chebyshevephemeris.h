@@ -0,0 +1,24 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QTest>
+
+/**
+ * @class TestChebyshevEphemeris
+ * @short Tests the Chebyshev cache of the planet and Moon ephemerides
+ */
+class TestChebyshevEphemeris : public QObject
+{
+        Q_OBJECT
+
+    private slots:
+        void testAccuracy_data();
+        void testAccuracy();
+        void testFallback();
+        void testSegments();
+};
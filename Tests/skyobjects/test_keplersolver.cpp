@@ -0,0 +1,58 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "test_keplersolver.h"
+
+#include "skyobjects/keplersolver.h"
+
+#include <QVector>
+
+void TestKeplerSolver::testEccentricAnomaly_data()
+{
+    QTest::addColumn<double>("M");
+    QTest::addColumn<double>("e");
+
+    QTest::newRow("circular") << 1.0 << 0.0;
+    QTest::newRow("below iteration limit") << 2.5 << 0.004;
+    QTest::newRow("Ceres") << 0.3 << 0.0785;
+    QTest::newRow("Halley") << 0.1 << 0.967;
+    QTest::newRow("near perihelion") << 0.001 << 0.99;
+    QTest::newRow("negative M") << -2.0 << 0.5;
+}
+
+void TestKeplerSolver::testEccentricAnomaly()
+{
+    QFETCH(double, M);
+    QFETCH(double, e);
+
+    const double E = KeplerSolver::eccentricAnomaly(M, e);
+
+    // The residual of a Newton step is much smaller than the step itself
+    const double tolerance = e > KeplerSolver::MIN_ITERATED_E ? KeplerSolver::TOLERANCE : 1e-6;
+    QVERIFY2(std::fabs(E - e * std::sin(E) - M) < tolerance, qPrintable(QString::number(E)));
+}
+
+void TestKeplerSolver::testBatch()
+{
+    QVector<double> M, e;
+    for (int i = 0; i < 100; ++i)
+    {
+        M.append(-3.0 + i * 0.06);
+        e.append(i * 0.0095);
+    }
+
+    QVector<double> E(M.size());
+    KeplerSolver::eccentricAnomalies(M.constData(), e.constData(), E.data(), M.size());
+
+    for (int i = 0; i < M.size(); ++i)
+        QCOMPARE(E[i], KeplerSolver::eccentricAnomaly(M[i], e[i]));
+
+    // In place
+    KeplerSolver::eccentricAnomalies(M.constData(), e.constData(), M.data(), M.size());
+    QCOMPARE(M, E);
+}
+
+QTEST_GUILESS_MAIN(TestKeplerSolver)
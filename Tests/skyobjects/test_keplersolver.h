@@ -0,0 +1,23 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QTest>
+
+/**
+ * @class TestKeplerSolver
+ * @short Tests the solution of Kepler's equation used by asteroids and comets
+ */
+class TestKeplerSolver : public QObject
+{
+        Q_OBJECT
+
+    private slots:
+        void testEccentricAnomaly_data();
+        void testEccentricAnomaly();
+        void testBatch();
+};
@@ -0,0 +1,99 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "test_ksnumbers.h"
+
+#include "ksnumbers.h"
+
+#include <vector>
+
+namespace
+{
+void compare(const KSNumbers &a, const KSNumbers &b)
+{
+    QCOMPARE(a.julianDay(), b.julianDay());
+    QVERIFY(qAbs(a.dEcLong() - b.dEcLong()) < 1e-12);
+    QVERIFY(qAbs(a.dObliq() - b.dObliq()) < 1e-12);
+    QCOMPARE(a.obliquity()->Degrees(), b.obliquity()->Degrees());
+    QCOMPARE(a.sunTrueLongitude().Degrees(), b.sunTrueLongitude().Degrees());
+    QCOMPARE(a.constAberr().Degrees(), b.constAberr().Degrees());
+    for (int i = 0; i < 3; i++)
+    {
+        QCOMPARE(a.vEarth(i), b.vEarth(i));
+        for (int j = 0; j < 3; j++)
+        {
+            QCOMPARE(a.p1(i, j), b.p1(i, j));
+            QCOMPARE(a.p1b(i, j), b.p1b(i, j));
+        }
+    }
+}
+}
+
+void TestKSNumbers::testCache()
+{
+    const long double jd = 2460000.25L;
+    const KSNumbers first(jd);
+    const KSNumbers second(jd);
+    compare(first, second);
+
+    // Updating to a cached date gives the values of a new instance
+    KSNumbers updated(jd + 10);
+    updated.updateValues(jd);
+    compare(updated, first);
+
+    // The nutation is about 17 arcseconds at most in longitude
+    QVERIFY(qAbs(first.dEcLong()) > 0 && qAbs(first.dEcLong()) < 20. / 3600);
+}
+
+void TestKSNumbers::testResolution()
+{
+    KSNumbers::setCacheResolution(1.0 / 1440);
+    const KSNumbers a(2460000.5L + 10. / 86400);
+    const KSNumbers b(2460000.5L - 10. / 86400);
+    KSNumbers::setCacheResolution(0);
+
+    // Both round to the same minute
+    QVERIFY(qAbs(a.julianDay() - 2460000.5L) < 1e-9);
+    compare(a, b);
+
+    const KSNumbers exact(2460000.5L + 10. / 86400);
+    QCOMPARE(exact.julianDay(), 2460000.5L + 10. / 86400);
+}
+
+void TestKSNumbers::testForJulianDays()
+{
+    // The batch computes dates a tenth of a second after the scalar ones, which the cache
+    // cannot match and over which the nutation changes by much less than the tolerance.
+    const long double offset = 1e-6L;
+    std::vector<long double> jds;
+    for (int i = 0; i < 50; i++)
+        jds.push_back(2300000.5L + i * 3001.37L + offset);
+
+    // Meeus, Astronomical Algorithms, example 22.a: -3.788" and +9.443"
+    jds.push_back(2446895.5L);
+
+    const std::vector<KSNumbers> numbers = KSNumbers::forJulianDays(jds);
+    QCOMPARE(numbers.size(), jds.size());
+    for (std::size_t i = 0; i + 1 < jds.size(); i++)
+    {
+        const KSNumbers scalar(jds[i] - offset);
+        QCOMPARE(numbers[i].julianDay(), jds[i]);
+        QVERIFY(qAbs(numbers[i].dEcLong() - scalar.dEcLong()) < 1e-10);
+        QVERIFY(qAbs(numbers[i].dObliq() - scalar.dObliq()) < 1e-10);
+        QVERIFY(qAbs(numbers[i].obliquity()->Degrees() - scalar.obliquity()->Degrees()) < 1e-10);
+    }
+
+    const KSNumbers &meeus = numbers.back();
+    QVERIFY(qAbs(meeus.dEcLong() * 3600 + 3.788) < 0.01);
+    QVERIFY(qAbs(meeus.dObliq() * 3600 - 9.443) < 0.01);
+
+    // Again, now from the cache
+    const std::vector<KSNumbers> cached = KSNumbers::forJulianDays(jds);
+    for (std::size_t i = 0; i < jds.size(); i++)
+        compare(cached[i], numbers[i]);
+}
+
+QTEST_GUILESS_MAIN(TestKSNumbers)
@@ -0,0 +1,23 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QTest>
+
+/**
+ * @class TestKSNumbers
+ * @short Tests the cache and the batch evaluation of KSNumbers
+ */
+class TestKSNumbers : public QObject
+{
+        Q_OBJECT
+
+    private slots:
+        void testCache();
+        void testResolution();
+        void testForJulianDays();
+};
@@ -0,0 +1,127 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "test_nametable.h"
+
+#include "skyobjects/nametable.h"
+#include "skyobjects/skyobject.h"
+#include "skycomponents/skyobjectnameindex.h"
+
+#include <QtConcurrent>
+
+#include <numeric>
+
+void TestNameTable::testIntern()
+{
+    NameTable &names = NameTable::instance();
+
+    QCOMPARE(names.intern(QString()), NameTable::NoName);
+    QCOMPARE(names.intern(""), NameTable::NoName);
+    QCOMPARE(names.find("test intern never interned"), NameTable::NoName);
+
+    const NameTable::Id ceres = names.intern("test intern Ceres");
+    const NameTable::Id pallas = names.intern("test intern Pallas");
+    QVERIFY(ceres != NameTable::NoName);
+    QVERIFY(pallas != NameTable::NoName);
+    QVERIFY(ceres != pallas);
+
+    const int size = names.size();
+    QCOMPARE(names.intern("test intern Ceres"), ceres);
+    QCOMPARE(names.size(), size);
+
+    QCOMPARE(names.find("test intern Pallas"), pallas);
+    QCOMPARE(names.name(ceres), QString("test intern Ceres"));
+    QCOMPARE(names.name(NameTable::NoName), QString());
+}
+
+void TestNameTable::testCaseInsensitive()
+{
+    NameTable &names = NameTable::instance();
+
+    const NameTable::Id id = names.intern("Test Case Alpha Centauri");
+    QCOMPARE(names.find("test case alpha centauri"), id);
+    QCOMPARE(names.find("TEST CASE ALPHA CENTAURI"), id);
+    QCOMPARE(names.intern("test case ALPHA centauri"), id);
+    // The first spelling is kept
+    QCOMPARE(names.name(id), QString("Test Case Alpha Centauri"));
+
+    QCOMPARE(names.find(QString::fromUtf8("Test Case Ωmega")), NameTable::NoName);
+    const NameTable::Id omega = names.intern(QString::fromUtf8("Test Case Ωmega"));
+    QCOMPARE(names.find(QString::fromUtf8("test case ωMEGA")), omega);
+}
+
+void TestNameTable::testShared()
+{
+    NameTable &names = NameTable::instance();
+
+    // Two separately built strings end up sharing the interned copy
+    QString first = QString("test shared ") + QString::number(1);
+    QString second = QString("test shared ") + QString::number(1);
+    QVERIFY(first.constData() != second.constData());
+
+    QString sharedFirst, sharedSecond;
+    const NameTable::Id id = names.intern(first, &sharedFirst);
+    QCOMPARE(names.intern(second, &sharedSecond), id);
+    QCOMPARE(sharedSecond, second);
+    QCOMPARE(sharedSecond.constData(), sharedFirst.constData());
+
+    // A different case keeps its own string
+    QString upper;
+    QCOMPARE(names.intern("TEST SHARED 1", &upper), id);
+    QCOMPARE(upper, QString("TEST SHARED 1"));
+}
+
+void TestNameTable::testThreads()
+{
+    NameTable &names = NameTable::instance();
+
+    QVector<int> numbers(1000);
+    std::iota(numbers.begin(), numbers.end(), 0);
+
+    // Intern the same names from several threads at once, each must get one id
+    const QVector<NameTable::Id> ids = QtConcurrent::blockingMapped<QVector<NameTable::Id>>(numbers, [&names](int number)
+    {
+        return names.intern(QString("test threads %1").arg(number % 100));
+    });
+
+    for (int i = 0; i < numbers.size(); ++i)
+        QCOMPARE(ids[i], names.find(QString("test threads %1").arg(i % 100)));
+}
+
+void TestNameTable::testNameIndex()
+{
+    SkyObjectNameIndex index;
+
+    SkyObject star(SkyObject::STAR, 0.0, 0.0, 1.0f, "Test Index Io");
+    SkyObject moon(SkyObject::MOON, 0.0, 0.0, 5.0f, "Test Index Io");
+    SkyObject galaxy(SkyObject::GALAXY, 0.0, 0.0, 8.0f, "Test Index Galaxy");
+
+    QVERIFY(index.find("Test Index Io") == nullptr);
+
+    // The solar system object wins over the star, whatever the order of registration
+    index.insert(star.name(), &star, star.type());
+    QCOMPARE(index.find("test index io"), &star);
+    index.insert(moon.name(), &moon, moon.type());
+    QCOMPARE(index.find("Test Index Io"), &moon);
+    index.insert(star.name(), &star, star.type());
+    QCOMPARE(index.find("Test Index Io"), &moon);
+
+    index.insert(galaxy.name(), &galaxy, galaxy.type());
+    QCOMPARE(index.find("TEST INDEX GALAXY"), &galaxy);
+    QCOMPARE(index.size(), 2);
+
+    // Only the indexed object is removed
+    index.remove(star.name(), &star);
+    QCOMPARE(index.find("Test Index Io"), &moon);
+    index.remove(moon.name(), &moon);
+    QVERIFY(index.find("Test Index Io") == nullptr);
+
+    index.removeType(SkyObject::GALAXY);
+    QVERIFY(index.find("Test Index Galaxy") == nullptr);
+    QCOMPARE(index.size(), 0);
+}
+
+QTEST_GUILESS_MAIN(TestNameTable)
@@ -0,0 +1,25 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QTest>
+
+/**
+ * @class TestNameTable
+ * @short Tests the interning of sky object names and the name index built on it
+ */
+class TestNameTable : public QObject
+{
+        Q_OBJECT
+
+    private slots:
+        void testIntern();
+        void testCaseInsensitive();
+        void testShared();
+        void testThreads();
+        void testNameIndex();
+};
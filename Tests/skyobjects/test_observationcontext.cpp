@@ -0,0 +1,119 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "test_observationcontext.h"
+
+#include "Options.h"
+#include "geolocation.h"
+#include "ksnumbers.h"
+#include "observationcontext.h"
+#include "skyobjects/skypoint.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+/// One arcsecond, the approximations of SkyPoint::nutate() and aberrate() differ by less
+constexpr double TOLERANCE = 1.0 / 3600.0;
+
+/** @return the points of a spiral over the whole sphere */
+std::vector<SkyPoint> spiral(int count)
+{
+    std::vector<SkyPoint> points;
+    for (int i = 0; i < count; ++i)
+    {
+        const double dec = std::asin(-1.0 + 2.0 * (i + 0.5) / count) / dms::DegToRad;
+        points.emplace_back(dms(std::fmod(i * 137.508, 360.0)), dms(dec));
+    }
+    return points;
+}
+
+double horizontalDistance(const SkyPoint &a, const SkyPoint &b)
+{
+    const SkyPoint pa(a.az(), a.alt()), pb(b.az(), b.alt());
+    return pa.angularDistanceTo(&pb).Degrees();
+}
+}
+
+void TestObservationContext::initTestCase()
+{
+    m_UseRelativistic = Options::useRelativistic();
+    Options::setUseRelativistic(false);
+}
+
+void TestObservationContext::cleanupTestCase()
+{
+    Options::setUseRelativistic(m_UseRelativistic);
+}
+
+void TestObservationContext::testAgainstSkyPoint_data()
+{
+    QTest::addColumn<double>("jd");
+    QTest::addColumn<double>("latitude");
+
+    QTest::newRow("2000, equator") << 2451545.0 << 0.0;
+    QTest::newRow("2024, north") << 2460400.3 << 52.5;
+    QTest::newRow("2050, south") << 2469807.7 << -33.9;
+}
+
+void TestObservationContext::testAgainstSkyPoint()
+{
+    QFETCH(double, jd);
+    QFETCH(double, latitude);
+
+    const GeoLocation geo(dms(13.4), dms(latitude));
+    const KStarsDateTime ut{ static_cast<long double>(jd) };
+    const CachingDms lst(geo.GSTtoLST(ut.gst()));
+    const CachingDms lat(latitude);
+    const KSNumbers num(jd);
+    const ObservationContext context(num, &geo, lst);
+
+    std::vector<SkyPoint> expected = spiral(500);
+    std::vector<SkyPoint> actual   = expected;
+    std::vector<SkyPoint *> raw;
+    for (auto &p : actual)
+        raw.push_back(&p);
+
+    context.update(raw.data(), static_cast<int>(raw.size()));
+
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        expected[i].updateCoordsNow(&num);
+        expected[i].EquatorialToHorizontal(&lst, &lat);
+
+        QVERIFY2(expected[i].angularDistanceTo(&actual[i]).Degrees() < TOLERANCE,
+                 qPrintable(QString("Point %1 at Dec %2").arg(i).arg(expected[i].dec().Degrees())));
+        QVERIFY(horizontalDistance(expected[i], actual[i]) < TOLERANCE);
+        QCOMPARE(actual[i].getLastPrecessJD(), jd);
+    }
+}
+
+void TestObservationContext::testHorizontalOnly()
+{
+    const GeoLocation geo(dms(-70.7), dms(-30.2));
+    const CachingDms lst(123.4), lat(-30.2);
+    const ObservationContext context(KSNumbers(2460000.5), &geo, lst);
+
+    // Without precession the coordinates of the date are kept, and only turned to the horizon
+    std::vector<SkyPoint> expected = spiral(200);
+    std::vector<SkyPoint> actual   = expected;
+    std::vector<SkyPoint *> raw;
+    for (auto &p : actual)
+        raw.push_back(&p);
+
+    context.update(raw.data(), static_cast<int>(raw.size()), false);
+
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        expected[i].EquatorialToHorizontal(&lst, &lat);
+        QCOMPARE(actual[i].ra().Degrees(), expected[i].ra().Degrees());
+        QCOMPARE(actual[i].dec().Degrees(), expected[i].dec().Degrees());
+        QVERIFY(horizontalDistance(expected[i], actual[i]) < 1e-8);
+    }
+}
+
+QTEST_GUILESS_MAIN(TestObservationContext)
@@ -0,0 +1,28 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QTest>
+
+/**
+ * @class TestObservationContext
+ * @short Tests the batch coordinate updates against the ones of SkyPoint
+ */
+class TestObservationContext : public QObject
+{
+        Q_OBJECT
+
+    private slots:
+        void initTestCase();
+        void cleanupTestCase();
+        void testAgainstSkyPoint_data();
+        void testAgainstSkyPoint();
+        void testHorizontalOnly();
+
+    private:
+        bool m_UseRelativistic { false };
+};
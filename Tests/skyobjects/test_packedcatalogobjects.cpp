@@ -0,0 +1,81 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "test_packedcatalogobjects.h"
+
+#include "skyobjects/packedcatalogobjects.h"
+#include "nan.h"
+
+#include <cmath>
+
+void TestPackedCatalogObjects::testRoundTrip()
+{
+    const QString path = "test.sqlite";
+    const std::vector<CatalogObject> objects
+    {
+        { {}, SkyObject::GALAXY, dms(10.684708), dms(41.26875), 3.44f, "M 31", "Andromeda Galaxy", "NGC 224", 1, 190.0f, 60.0f, 35.0, 0.0f, path },
+        { {}, SkyObject::GASEOUS_NEBULA, dms(83.8221), dms(-5.3911), NaN::f, "M 42", "", "NGC 1976", 2, 85.0f, 60.0f, 0.0, 1.5f, path },
+        { {}, SkyObject::OPEN_CLUSTER, dms(56.75), dms(24.1167), 1.6f, "", "Pleiades", "", 3, 0.0f, 0.0f, 0.0, 0.0f, path }
+    };
+
+    const PackedCatalogObjects packed(objects);
+    QCOMPARE(packed.size(), objects.size());
+
+    for (std::size_t i = 0; i < objects.size(); ++i)
+    {
+        const CatalogObject &original = objects[i];
+        const CatalogObject object    = packed.object(i, path);
+
+        QCOMPARE(object.getObjectId(), original.getObjectId());
+        QCOMPARE(object.type(), original.type());
+        QCOMPARE(object.ra0().Degrees(), original.ra0().Degrees());
+        QCOMPARE(object.dec0().Degrees(), original.dec0().Degrees());
+        QCOMPARE(std::isnan(object.mag()), std::isnan(original.mag()));
+        if (!std::isnan(original.mag()))
+            QCOMPARE(object.mag(), original.mag());
+        QCOMPARE(object.name(), original.name());
+        QCOMPARE(object.longname(), original.longname());
+        QCOMPARE(object.name2(), original.name2());
+        QCOMPARE(object.catalogIdentifier(), original.catalogIdentifier());
+        QCOMPARE(object.catalogId(), original.catalogId());
+        QCOMPARE(object.a(), original.a());
+        QCOMPARE(object.b(), original.b());
+        QCOMPARE(object.pa(), original.pa());
+        QCOMPARE(object.flux(), original.flux());
+
+        QCOMPARE(packed[i].mag, original.mag());
+        QCOMPARE(packed[i].a, original.a());
+    }
+}
+
+void TestPackedCatalogObjects::testDefaultLongName()
+{
+    // A long name equal to the name is not stored twice, but comes back
+    const std::vector<CatalogObject> objects
+    {
+        { {}, SkyObject::GALAXY, dms(1), dms(2), 12.0f, "NGC 1", "NGC 1", "", 1 }
+    };
+
+    const PackedCatalogObjects packed(objects);
+    QCOMPARE(packed[0].longNameSize, quint16(0));
+    QCOMPARE(packed.object(0, QString()).longname(), QString("NGC 1"));
+}
+
+void TestPackedCatalogObjects::testEmpty()
+{
+    PackedCatalogObjects packed;
+    QCOMPARE(packed.size(), std::size_t(0));
+
+    PackedCatalogObjects other(std::vector<CatalogObject>
+    {
+        { {}, SkyObject::GALAXY, dms(1), dms(2), 12.0f, "NGC 1" }
+    });
+    packed.swap(other);
+    QCOMPARE(packed.size(), std::size_t(1));
+    QCOMPARE(other.size(), std::size_t(0));
+}
+
+QTEST_GUILESS_MAIN(TestPackedCatalogObjects)
@@ -0,0 +1,23 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QTest>
+
+/**
+ * @class TestPackedCatalogObjects
+ * @short Tests that packed catalog objects come back as they were packed
+ */
+class TestPackedCatalogObjects : public QObject
+{
+        Q_OBJECT
+
+    private slots:
+        void testRoundTrip();
+        void testDefaultLongName();
+        void testEmpty();
+};
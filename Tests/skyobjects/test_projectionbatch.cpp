@@ -0,0 +1,158 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "test_projectionbatch.h"
+
+#include "projections/azimuthalequidistantprojector.h"
+#include "projections/equirectangularprojector.h"
+#include "projections/gnomonicprojector.h"
+#include "projections/lambertprojector.h"
+#include "projections/orthographicprojector.h"
+#include "projections/projectionbatch.h"
+#include "projections/stereographicprojector.h"
+#include "skyobjects/skypoint.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace
+{
+std::unique_ptr<Projector> createProjector(Projector::Projection projection, const ViewParams &p)
+{
+    switch (projection)
+    {
+        case Projector::Lambert:
+            return std::make_unique<LambertProjector>(p);
+        case Projector::AzimuthalEquidistant:
+            return std::make_unique<AzimuthalEquidistantProjector>(p);
+        case Projector::Orthographic:
+            return std::make_unique<OrthographicProjector>(p);
+        case Projector::Equirectangular:
+            return std::make_unique<EquirectangularProjector>(p);
+        case Projector::Stereographic:
+            return std::make_unique<StereographicProjector>(p);
+        case Projector::Gnomonic:
+            return std::make_unique<GnomonicProjector>(p);
+        default:
+            return nullptr;
+    }
+}
+
+/** A point with the same longitude and latitude in the equatorial and horizontal coordinates */
+SkyPoint gridPoint(double longitude, double latitude)
+{
+    SkyPoint point;
+    point.setRA(longitude / 15.0);
+    point.setDec(latitude);
+    point.setAz(longitude);
+    point.setAlt(latitude);
+    return point;
+}
+
+// Batch positions are single precision, and gnomonic ones grow large away from the focus
+bool closeEnough(float batch, float scalar)
+{
+    return std::fabs(batch - scalar) <= 0.01 + 1e-5 * std::fabs(scalar);
+}
+}
+
+void TestProjectionBatch::testBatch_data()
+{
+    QTest::addColumn<Projector::Projection>("PROJECTION");
+    QTest::addColumn<bool>("ALTAZ");
+    QTest::addColumn<bool>("REFRACTION");
+
+    const QList<QPair<Projector::Projection, const char *>> projections =
+    {
+        { Projector::Lambert, "Lambert" },
+        { Projector::AzimuthalEquidistant, "AzimuthalEquidistant" },
+        { Projector::Orthographic, "Orthographic" },
+        { Projector::Equirectangular, "Equirectangular" },
+        { Projector::Stereographic, "Stereographic" },
+        { Projector::Gnomonic, "Gnomonic" },
+    };
+
+    for (const auto &projection : projections)
+    {
+        QTest::addRow("%s equatorial", projection.second) << projection.first << false << false;
+        QTest::addRow("%s altaz", projection.second) << projection.first << true << false;
+        QTest::addRow("%s altaz refracted", projection.second) << projection.first << true << true;
+    }
+}
+
+void TestProjectionBatch::testBatch()
+{
+    QFETCH(Projector::Projection, PROJECTION);
+    QFETCH(bool, ALTAZ);
+    QFETCH(bool, REFRACTION);
+
+    // Off the grid, so that no point lies exactly on the edge of the visible hemisphere
+    SkyPoint focus = gridPoint(41.3, 23.7);
+
+    ViewParams p;
+    p.width = 1200;
+    p.height = 800;
+    p.zoomFactor = 400;
+    p.rotationAngle = dms(30);
+    p.useAltAz = ALTAZ;
+    p.useRefraction = REFRACTION;
+    p.focus = &focus;
+
+    // Mirrored too, with and without refraction of the single points
+    for (bool mirror : { false, true })
+    {
+        p.mirror = mirror;
+        std::unique_ptr<Projector> projector = createProjector(PROJECTION, p);
+        QVERIFY(projector);
+        QCOMPARE(projector->type(), PROJECTION);
+
+        for (bool refract : { true, false })
+        {
+            // A grid over the whole sphere, including points behind the focus and close to the horizon
+            std::vector<SkyPoint> points;
+            for (double latitude = -85; latitude <= 85; latitude += 5)
+                for (double longitude = 0; longitude < 360; longitude += 7.5)
+                    points.push_back(gridPoint(longitude, latitude));
+            points.push_back(gridPoint(0, 0.2));
+            points.push_back(gridPoint(40, -0.3));
+
+            ProjectionBatch batch;
+            for (const SkyPoint &point : points)
+                projector->appendToBatch(batch, &point, refract);
+            projector->toScreenBatch(batch);
+
+            QCOMPARE(batch.size(), static_cast<int>(points.size()));
+            QCOMPARE(static_cast<int>(batch.x.size()), batch.size());
+            QCOMPARE(static_cast<int>(batch.visible.size()), batch.size());
+
+            int visible = 0;
+            for (int i = 0; i < batch.size(); i++)
+            {
+                bool onVisibleHemisphere = false;
+                const Eigen::Vector2f scalar = projector->toScreenVec(&points[i], refract, &onVisibleHemisphere);
+
+                QVERIFY2(static_cast<bool>(batch.visible[i]) == onVisibleHemisphere,
+                         qPrintable(QString("point %1 visibility").arg(i)));
+                // Points on the back side are not drawn, where they land does not matter
+                if (!onVisibleHemisphere)
+                    continue;
+                visible++;
+                QVERIFY2(closeEnough(batch.x[i], scalar.x()) && closeEnough(batch.y[i], scalar.y()),
+                         qPrintable(QString("point %1 at (%2, %3) instead of (%4, %5)").arg(i).arg(batch.x[i])
+                                    .arg(batch.y[i]).arg(scalar.x()).arg(scalar.y())));
+            }
+            // Some points must have been compared
+            QVERIFY(visible > 0);
+
+            // Batches are reused
+            batch.clear();
+            QCOMPARE(batch.size(), 0);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(TestProjectionBatch)
@@ -0,0 +1,22 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QTest>
+
+/**
+ * @class TestProjectionBatch
+ * @short Tests the batch projection of each projector against its scalar toScreenVec()
+ */
+class TestProjectionBatch : public QObject
+{
+        Q_OBJECT
+
+    private slots:
+        void testBatch_data();
+        void testBatch();
+};
@@ -0,0 +1,107 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "test_satellitepasspredictor.h"
+
+#include "geolocation.h"
+#include "kstarsdatetime.h"
+#include "skyobjects/satellite.h"
+#include "skyobjects/satellitepasspredictor.h"
+
+#include <memory>
+
+namespace
+{
+// The ISS, a few hours before the start of the predictions
+const QString NAME  = "ISS (ZARYA)";
+const QString LINE1 = "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927";
+const QString LINE2 = "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537";
+
+GeoLocation london()
+{
+    return GeoLocation(dms(-0.13), dms(51.5), "London", "", "United Kingdom", 0);
+}
+
+double startJD()
+{
+    return KStarsDateTime(QDate(2008, 9, 20), QTime(18, 0, 0)).djd();
+}
+}
+
+void TestSatellitePassPredictor::testPasses()
+{
+    Satellite iss(NAME, LINE1, LINE2);
+    SatellitePassPredictor predictor(london());
+    predictor.compute({ &iss }, startJD(), startJD() + 1);
+
+    // The orbit is inclined enough to pass over London several times a day
+    QVERIFY(predictor.passes().size() >= 2);
+
+    for (const SatellitePassPredictor::Pass &pass : predictor.passes())
+    {
+        QCOMPARE(pass.name, NAME);
+        QVERIFY(pass.riseJD <= pass.culminationJD);
+        QVERIFY(pass.culminationJD <= pass.setJD);
+        QVERIFY(pass.setJD - pass.riseJD < 0.02);
+        QVERIFY(pass.maxAltitude >= 0 && pass.maxAltitude <= 90);
+
+        for (const SatellitePassPredictor::Window &window : pass.sunlit)
+        {
+            QVERIFY(window.startJD >= pass.riseJD && window.stopJD <= pass.setJD);
+            QVERIFY(window.startJD <= window.stopJD);
+        }
+    }
+
+    // The satellite is up at culmination and down a little before rise
+    const SatellitePassPredictor::Pass &pass = predictor.passes().last();
+    std::unique_ptr<Satellite> copy(iss.clone());
+    const GeoLocation geo = london();
+
+    QCOMPARE(copy->updatePos(Satellite::environment(pass.culminationJD, &geo)), 0);
+    QVERIFY(copy->alt().Degrees() > 0);
+    QVERIFY(qAbs(copy->alt().Degrees() - pass.maxAltitude) < 0.1);
+
+    copy->updatePos(Satellite::environment(pass.riseJD - 10.0 / 86400, &geo));
+    QVERIFY(copy->alt().Degrees() < 0);
+
+    QVERIFY(predictor.passesBetween(pass.culminationJD, pass.culminationJD).contains(predictor.passes().size() - 1));
+    QVERIFY(predictor.passesBetween(startJD() - 2, startJD() - 1).isEmpty());
+}
+
+void TestSatellitePassPredictor::testCrossings()
+{
+    Satellite iss(NAME, LINE1, LINE2);
+    SatellitePassPredictor predictor(london());
+    predictor.compute({ &iss }, startJD(), startJD() + 1);
+    QVERIFY(!predictor.passes().isEmpty());
+
+    // A field on the track of the satellite, a minute after its culmination
+    const int index = predictor.passes().size() - 1;
+    const SatellitePassPredictor::Pass &pass = predictor.passes()[index];
+    const double jd = std::min(pass.culminationJD + 60.0 / 86400, pass.setJD);
+
+    std::unique_ptr<Satellite> copy(iss.clone());
+    const GeoLocation geo = london();
+    QCOMPARE(copy->updatePos(Satellite::environment(jd, &geo)), 0);
+    const SkyPoint center(copy->ra(), copy->dec());
+
+    const QVector<SatellitePassPredictor::Crossing> crossings =
+        predictor.crossings(center, 0.5, pass.riseJD, pass.setJD);
+    QCOMPARE(crossings.size(), 1);
+    QCOMPARE(crossings[0].pass, index);
+    QVERIFY(crossings[0].entryJD <= jd && crossings[0].exitJD >= jd);
+    QVERIFY(crossings[0].exitJD - crossings[0].entryJD < 60.0 / 86400);
+    QVERIFY(crossings[0].minSeparation < 0.05);
+
+    // Not in a capture window before the pass
+    QVERIFY(predictor.crossings(center, 0.5, pass.riseJD - 0.01, pass.riseJD - 0.005).isEmpty());
+
+    // Not on the opposite side of the sky
+    const SkyPoint opposite(dms(center.ra().Degrees() + 180).reduce(), dms(-center.dec().Degrees()));
+    QVERIFY(predictor.crossings(opposite, 0.5, pass.riseJD, pass.setJD).isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestSatellitePassPredictor)
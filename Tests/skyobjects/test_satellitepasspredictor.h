@@ -0,0 +1,22 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QTest>
+
+/**
+ * @class TestSatellitePassPredictor
+ * @short Tests the pass prediction and field of view queries of satellites
+ */
+class TestSatellitePassPredictor : public QObject
+{
+        Q_OBJECT
+
+    private slots:
+        void testPasses();
+        void testCrossings();
+};
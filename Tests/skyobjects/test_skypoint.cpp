@@ -361,6 +361,13 @@ void TestSkyPoint::testApparentCatalogue()
 
     compare("J2000 to aparrent", RaOut, DecOut, sp.ra().Hours(), sp.dec().Degrees());
 
+    // Using the KSNumbers of the final epoch gives the same result
+    KSNumbers num(jd);
+    SkyPoint spNum(Ra, Dec);
+    spNum.apparentCoord(&num);
+    compare("J2000 to apparent with KSNumbers", sp.ra().Hours(), sp.dec().Degrees(), spNum.ra().Hours(),
+            spNum.dec().Degrees());
+
     SkyPoint spn = SkyPoint(sp.ra(), sp.dec());
     qDebug() << "spn ra0 " << spn.ra0().Degrees() << ", dec0 " << spn.dec0().Degrees() <<
              " ra " << spn.ra().Degrees() << ", dec " << spn.dec().Degrees();
@@ -0,0 +1,103 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "test_skyvectors.h"
+
+#include "skyvectors.h"
+#include "skyobjects/skypoint.h"
+
+#include <Eigen/Geometry>
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+constexpr int COUNT = 1000;
+
+/** Longitudes and latitudes, in radians, of a spiral over the whole sphere */
+void spiral(std::vector<double> &longitude, std::vector<double> &latitude)
+{
+    longitude.resize(COUNT);
+    latitude.resize(COUNT);
+    for (int i = 0; i < COUNT; ++i)
+    {
+        latitude[i]  = std::asin(-1.0 + 2.0 * (i + 0.5) / COUNT);
+        longitude[i] = std::fmod(i * 137.508, 360.0) * dms::DegToRad;
+    }
+}
+}
+
+void TestSkyVectors::testAngles()
+{
+    std::vector<double> longitude, latitude;
+    spiral(longitude, latitude);
+    const SkyVectors vectors = SkyVectors::fromAngles(longitude.data(), latitude.data(), COUNT);
+    QCOMPARE(vectors.size(), COUNT);
+
+    std::vector<double> lon(COUNT), lat(COUNT);
+    vectors.toAngles(lon.data(), lat.data());
+    for (int i = 0; i < COUNT; ++i)
+    {
+        QVERIFY(std::abs(lon[i] - longitude[i]) < 1e-12);
+        QVERIFY(std::abs(lat[i] - latitude[i]) < 1e-12);
+        QVERIFY(std::abs(vectors.at(i).norm() - 1) < 1e-12);
+    }
+
+    SkyVectors single(1);
+    single.set(0, longitude[7], latitude[7]);
+    QVERIFY((single.at(0) - vectors.at(7)).norm() < 1e-15);
+}
+
+void TestSkyVectors::testRotate()
+{
+    std::vector<double> longitude, latitude;
+    spiral(longitude, latitude);
+    SkyVectors vectors = SkyVectors::fromAngles(longitude.data(), latitude.data(), COUNT);
+    const SkyVectors original = vectors;
+
+    const Eigen::Matrix3d rotation = (Eigen::AngleAxisd(0.3, Eigen::Vector3d::UnitZ()) *
+                                      Eigen::AngleAxisd(-1.1, Eigen::Vector3d::UnitX())).toRotationMatrix();
+    vectors.rotate(rotation);
+    for (int i = 0; i < COUNT; ++i)
+        QVERIFY((vectors.at(i) - rotation * original.at(i)).norm() < 1e-14);
+
+    // A small offset keeps unit vectors
+    const Eigen::Vector3d offset(1e-4, -2e-4, 5e-5);
+    vectors.addAndNormalize(offset);
+    for (int i = 0; i < COUNT; ++i)
+        QVERIFY((vectors.at(i) - (rotation * original.at(i) + offset).normalized()).norm() < 1e-14);
+}
+
+void TestSkyVectors::testRefract()
+{
+    Eigen::ArrayXd altitudes = Eigen::ArrayXd::LinSpaced(721, -90, 90);
+    const Eigen::ArrayXd expected = altitudes;
+    SkyVectors::refract(altitudes);
+    for (int i = 0; i < expected.size(); ++i)
+        QVERIFY(std::abs(altitudes[i] - SkyPoint::refract(expected[i])) < 1e-12);
+}
+
+void TestSkyVectors::testAboveAltitude()
+{
+    std::vector<double> longitude, latitude;
+    spiral(longitude, latitude);
+    const SkyVectors vectors = SkyVectors::fromAngles(longitude.data(), latitude.data(), COUNT);
+
+    const std::vector<char> above = vectors.aboveAltitude(10);
+    const std::vector<char> refracted = vectors.aboveAltitude(0, true);
+    for (int i = 0; i < COUNT; ++i)
+    {
+        const double altitude = latitude[i] / dms::DegToRad;
+        // Positions on the limit may go either way
+        if (std::abs(altitude - 10) > 1e-9)
+            QCOMPARE(above[i] != 0, altitude >= 10);
+        if (std::abs(SkyPoint::refract(altitude)) > 1e-3)
+            QCOMPARE(refracted[i] != 0, SkyPoint::refract(altitude) >= 0);
+    }
+}
+
+QTEST_GUILESS_MAIN(TestSkyVectors)
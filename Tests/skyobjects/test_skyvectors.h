@@ -0,0 +1,24 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QTest>
+
+/**
+ * @class TestSkyVectors
+ * @short Tests the batch unit vector kernels against the scalar ones
+ */
+class TestSkyVectors : public QObject
+{
+        Q_OBJECT
+
+    private slots:
+        void testAngles();
+        void testRotate();
+        void testRefract();
+        void testAboveAltitude();
+};
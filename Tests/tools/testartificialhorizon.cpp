@@ -30,6 +30,7 @@ class TestArtificialHorizon : public QObject
     private slots:
         void artificialHorizonTest();
         void artificialCeilingTest();
+        void artificialHorizonBatchTest();
 
     private:
 };
@@ -251,4 +252,46 @@ void TestArtificialHorizon::artificialCeilingTest()
     QVERIFY(checkHorizon(horizon, 351, 3, false, polygons));
 }
 
+void TestArtificialHorizon::artificialHorizonBatchTest()
+{
+    ArtificialHorizon horizon;
+    horizon.setTesting();
+
+    // A horizon with a ceiling, and a second horizon line above part of it.
+    auto list1 = setupHorizonEntities({259.0, 260.0, 330.0, 0.0, 60.0, 61.0, 180.0, 259.99},
+                                      { 90.0,  26.0,  26.0, 26.0, 26.0, 90.0,  90.0,  90.0});
+    horizon.addRegion("horizon", true, list1, false);
+    auto list2 = setupHorizonEntities({260.0, 330.0, 0.0, 60.0}, {66.0, 66.0, 66.0, 66.0});
+    horizon.addRegion("ceiling", true, list2, true);
+    auto list3 = setupHorizonEntities({300.0, 320.0}, {40.0, 40.0});
+    horizon.addRegion("tree", true, list3, false);
+
+    // The points are at the centers of the cells of the bitmap, away from the lines.
+    QVector<double> az, alt;
+    for (double a = 0.5; a < 360; a += 1)
+    {
+        for (double h = -89.5; h < 90; h += 1)
+        {
+            az.append(a);
+            alt.append(h);
+        }
+    }
+
+    std::vector<char> visible = horizon.areVisible(az.constData(), alt.constData(), az.size());
+    QCOMPARE(static_cast<int>(visible.size()), az.size());
+    for (int i = 0; i < az.size(); ++i)
+    {
+        QCOMPARE(static_cast<bool>(visible[i]), horizon.isVisible(az[i], alt[i]));
+        QCOMPARE(horizon.isAltitudeOK(az[i], alt[i], nullptr), horizon.isVisible(az[i], alt[i]));
+    }
+
+    // The azimuths wrap around, and the bitmap follows the edits.
+    const double wrappedAz[] = { 310.5 - 360.0, 310.5 + 360.0 }, wrappedAlt[] = { 35.5, 35.5 };
+    visible = horizon.areVisible(wrappedAz, wrappedAlt, 2);
+    QVERIFY(!visible[0] && !visible[1]);
+    horizon.removeRegion("tree");
+    visible = horizon.areVisible(wrappedAz, wrappedAlt, 2);
+    QVERIFY(visible[0] && visible[1]);
+}
+
 QTEST_GUILESS_MAIN(TestArtificialHorizon)
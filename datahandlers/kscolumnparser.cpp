@@ -0,0 +1,336 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "kscolumnparser.h"
+
+#include <QDebug>
+#include <QLocale>
+#include <QStringView>
+#include <QThread>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+// Chunks are at least this large, so that small files are parsed in one go
+constexpr qint64 MIN_CHUNK_SIZE = 1 << 20;
+
+// Longer numbers are converted through a QString
+constexpr int MAX_NUMBER_LENGTH = 64;
+
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * QLocale::c() converts a QStringView as QString::toDouble() converts a QString, without
+ * allocating. The field is trimmed and widened into @p buffer, which is returned as the view.
+ */
+QStringView widen(const char *begin, const char *end, QChar *buffer, QString &fallback)
+{
+    while (begin < end && isSpace(*begin))
+        ++begin;
+    while (end > begin && isSpace(end[-1]))
+        --end;
+
+    const int length = static_cast<int>(end - begin);
+    if (length > MAX_NUMBER_LENGTH)
+    {
+        fallback = QString::fromLatin1(begin, length);
+        return QStringView(fallback);
+    }
+
+    for (int i = 0; i < length; ++i)
+        buffer[i] = QLatin1Char(begin[i]);
+    return QStringView(buffer, length);
+}
+}
+
+KSColumnParser::KSColumnParser(const QString &filename, const char comment_char, const Sequence &sequence,
+                               const char delimiter)
+    : filename_(filename), comment_char_(comment_char), name_type_sequence_(sequence), delimiter_(delimiter)
+{
+}
+
+KSColumnParser::KSColumnParser(const QString &filename, const char comment_char, const Sequence &sequence,
+                               const QList<int> &widths)
+    : filename_(filename), comment_char_(comment_char), name_type_sequence_(sequence), width_sequence_(widths)
+{
+}
+
+bool KSColumnParser::parse()
+{
+    if (delimiter_ == 0 && name_type_sequence_.length() != (width_sequence_.length() + 1))
+    {
+        qWarning() << "Unequal fields and widths in" << filename_;
+        return false;
+    }
+
+    file_.setFileName(filename_);
+    if (!file_.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "Unable to open file: " << filename_;
+        return false;
+    }
+
+    size_ = file_.size();
+    data_ = size_ > 0 ? reinterpret_cast<const char *>(file_.map(0, size_)) : nullptr;
+    if (data_ == nullptr)
+    {
+        // Files in resources or on some file systems can not be mapped
+        buffer_ = file_.readAll();
+        data_   = buffer_.constData();
+        size_   = buffer_.size();
+    }
+
+    // Split the file into chunks of whole lines
+    const qint64 chunkSize = std::max(MIN_CHUNK_SIZE, size_ / (std::max(1, QThread::idealThreadCount()) * 4));
+    QVector<Chunk> chunks;
+    for (qint64 begin = 0; begin < size_;)
+    {
+        qint64 end = std::min(begin + chunkSize, size_);
+        if (end < size_)
+        {
+            const void *newline = std::memchr(data_ + end, '\n', size_ - end);
+            end = newline ? static_cast<const char *>(newline) - data_ + 1 : size_;
+        }
+        chunks.append({ begin, end, 0, QVector<Column>(name_type_sequence_.size()) });
+        begin = end;
+    }
+
+    QtConcurrent::blockingMap(chunks, [this](Chunk & chunk)
+    {
+        parseChunk(chunk);
+    });
+
+    // Join the columns of the chunks, in the order of the file
+    row_count_ = 0;
+    for (const Chunk &chunk : chunks)
+        row_count_ += chunk.rows;
+
+    columns_ = QVector<Column>(name_type_sequence_.size());
+    for (int c = 0; c < columns_.size(); ++c)
+    {
+        Column &column = columns_[c];
+        switch (name_type_sequence_[c].second)
+        {
+            case KSParser::D_DOUBLE:
+                column.doubles.reserve(row_count_);
+                break;
+            case KSParser::D_FLOAT:
+                column.floats.reserve(row_count_);
+                break;
+            case KSParser::D_INT:
+                column.ints.reserve(row_count_);
+                break;
+            case KSParser::D_QSTRING:
+                column.strings.reserve(row_count_);
+                break;
+            case KSParser::D_SKIP:
+                break;
+        }
+
+        for (const Chunk &chunk : chunks)
+        {
+            const Column &part = chunk.columns[c];
+            column.doubles.insert(column.doubles.end(), part.doubles.begin(), part.doubles.end());
+            column.floats.insert(column.floats.end(), part.floats.begin(), part.floats.end());
+            column.ints.insert(column.ints.end(), part.ints.begin(), part.ints.end());
+            column.strings.insert(column.strings.end(), part.strings.begin(), part.strings.end());
+        }
+    }
+
+    return true;
+}
+
+void KSColumnParser::parseChunk(Chunk &chunk) const
+{
+    QVector<Field> fields;
+    fields.reserve(name_type_sequence_.size());
+
+    const char *line = data_ + chunk.begin;
+    const char *chunkEnd = data_ + chunk.end;
+    while (line < chunkEnd)
+    {
+        const char *newline = static_cast<const char *>(std::memchr(line, '\n', chunkEnd - line));
+        const char *next = newline ? newline + 1 : chunkEnd;
+        const char *end = newline ? newline : chunkEnd;
+        if (end > line && end[-1] == '\r')
+            --end;
+
+        if (end > line && *line != comment_char_ &&
+                (delimiter_ ? splitCSV(line, end, fields) : splitFixedWidth(line, end, fields)))
+        {
+            for (int c = 0; c < fields.size(); ++c)
+                append(chunk.columns[c], name_type_sequence_[c].second, fields[c]);
+            chunk.rows++;
+        }
+        line = next;
+    }
+}
+
+bool KSColumnParser::splitCSV(const char *begin, const char *end, QVector<Field> &fields) const
+{
+    fields.clear();
+    bool delimited = false;
+    const char *p = begin;
+    while (true)
+    {
+        const char *fieldBegin = p;
+        const char *fieldEnd   = nullptr;
+        if (p < end && *p == '"')
+        {
+            // A quoted field runs to the next quote at the end of a field, delimiters included
+            for (const char *q = p + 1; q < end; ++q)
+            {
+                if (*q == '"' && (q + 1 == end || q[1] == delimiter_))
+                {
+                    fieldEnd = q;
+                    break;
+                }
+            }
+            if (fieldEnd == nullptr)
+                return false;
+
+            fieldBegin = p + 1;
+            p = fieldEnd + 1;
+        }
+        else
+        {
+            p = fieldEnd = std::find(p, end, delimiter_);
+        }
+
+        fields.append({ fieldBegin - data_, static_cast<int>(fieldEnd - fieldBegin) });
+        if (p == end)
+            break;
+
+        // Skip the delimiter
+        ++p;
+        delimited = true;
+    }
+
+    return delimited && fields.size() == name_type_sequence_.size();
+}
+
+bool KSColumnParser::splitFixedWidth(const char *begin, const char *end, QVector<Field> &fields) const
+{
+    int total_min_length = 0;
+    for (int width : width_sequence_)
+        total_min_length += width;
+    if (end - begin < total_min_length)
+        return false;
+
+    fields.clear();
+    const char *p = begin;
+    for (int width : width_sequence_)
+    {
+        fields.append({ p - data_, width });
+        p += width;
+    }
+    // The last field runs to the end of the line
+    fields.append({ p - data_, static_cast<int>(end - p) });
+
+    // Fixed width fields are trimmed
+    for (Field &field : fields)
+    {
+        const char *fieldBegin = data_ + field.offset;
+        const char *fieldEnd   = fieldBegin + field.length;
+        while (fieldBegin < fieldEnd && isSpace(*fieldBegin))
+            ++fieldBegin;
+        while (fieldEnd > fieldBegin && isSpace(fieldEnd[-1]))
+            --fieldEnd;
+        field = { fieldBegin - data_, static_cast<int>(fieldEnd - fieldBegin) };
+    }
+    return true;
+}
+
+void KSColumnParser::append(Column &column, KSParser::DataTypes type, const Field &field) const
+{
+    const char *begin = data_ + field.offset;
+    const char *end   = begin + field.length;
+    static const QLocale locale = QLocale::c();
+    QChar buffer[MAX_NUMBER_LENGTH];
+    QString fallback;
+    bool ok = true;
+
+    switch (type)
+    {
+        case KSParser::D_DOUBLE:
+        {
+            const double value = locale.toDouble(widen(begin, end, buffer, fallback), &ok);
+            column.doubles.push_back(ok ? value : KSParser::EBROKEN_DOUBLE);
+            break;
+        }
+        case KSParser::D_FLOAT:
+        {
+            const float value = locale.toFloat(widen(begin, end, buffer, fallback), &ok);
+            column.floats.push_back(ok ? value : KSParser::EBROKEN_FLOAT);
+            break;
+        }
+        case KSParser::D_INT:
+        {
+            const int value = locale.toInt(widen(begin, end, buffer, fallback), &ok);
+            column.ints.push_back(ok ? value : KSParser::EBROKEN_INT);
+            break;
+        }
+        case KSParser::D_QSTRING:
+            column.strings.push_back(field);
+            break;
+        case KSParser::D_SKIP:
+            break;
+    }
+}
+
+int KSColumnParser::column(const QString &name) const
+{
+    for (int i = 0; i < name_type_sequence_.size(); ++i)
+    {
+        if (name_type_sequence_[i].first == name)
+            return i;
+    }
+    return -1;
+}
+
+double KSColumnParser::Row::toDouble(int column) const
+{
+    const auto &values = parser_->columns_[column].doubles;
+    return index_ < static_cast<int>(values.size()) ? values[index_] : KSParser::EBROKEN_DOUBLE;
+}
+
+float KSColumnParser::Row::toFloat(int column) const
+{
+    const auto &values = parser_->columns_[column].floats;
+    return index_ < static_cast<int>(values.size()) ? values[index_] : KSParser::EBROKEN_FLOAT;
+}
+
+int KSColumnParser::Row::toInt(int column) const
+{
+    const auto &values = parser_->columns_[column].ints;
+    return index_ < static_cast<int>(values.size()) ? values[index_] : KSParser::EBROKEN_INT;
+}
+
+QByteArray KSColumnParser::Row::toRawData(int column) const
+{
+    const auto &values = parser_->columns_[column].strings;
+    if (index_ >= static_cast<int>(values.size()))
+        return QByteArray();
+
+    const Field &field = values[index_];
+    return QByteArray::fromRawData(parser_->data_ + field.offset, field.length);
+}
+
+QString KSColumnParser::Row::toString(int column) const
+{
+    const auto &values = parser_->columns_[column].strings;
+    if (index_ >= static_cast<int>(values.size()))
+        return KSParser::EBROKEN_QSTRING;
+
+    const Field &field = values[index_];
+    return QString::fromUtf8(parser_->data_ + field.offset, field.length);
+}
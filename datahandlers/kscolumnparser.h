@@ -0,0 +1,157 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "ksparser.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+#include <vector>
+
+/**
+ * @brief Parser of large CSV and fixed width text files into typed columns.
+ *
+ * KSParser reads a file line by line through a QTextStream and returns every
+ * row as a QHash of QVariants, which allocates for every field. This parser
+ * takes the same sequence of fields, maps the file into memory, splits it on
+ * line boundaries into chunks and parses the chunks in parallel. Numbers are
+ * converted into one array per column, strings are kept as ranges of the
+ * mapped file and only decoded when asked for.
+ *
+ * Usage:
+ * 1) initialize KSColumnParser with the file and the sequence of fields
+ * 2) call parse()
+ * 3) for (int i = 0; i < parser.rowCount(); ++i) {
+ *        KSColumnParser::Row row = parser.row(i);
+ *        double value = row.toDouble(column);
+ *        ...
+ *    }
+ *
+ * The rows that KSParser skips are skipped too: comment lines, CSV lines
+ * without a delimiter or with the wrong number of fields, and fixed width
+ * lines shorter than the widths. Quoted CSV fields follow KSParser, the
+ * delimiters inside them are kept and the surrounding quotes are removed.
+ * Numbers that do not convert are KSParser::EBROKEN_DOUBLE and so on. The
+ * fixed widths are in bytes, which are characters for ASCII catalogs.
+ *
+ * The strings of a D_SKIP field are not kept.
+ **/
+class KSColumnParser
+{
+  public:
+    using Sequence = QList<QPair<QString, KSParser::DataTypes>>;
+
+    /**
+     * @brief A row of the parsed file, valid as long as the parser is.
+     * The accessors take the index of the field in the sequence.
+     **/
+    class Row
+    {
+      public:
+        double toDouble(int column) const;
+        float toFloat(int column) const;
+        int toInt(int column) const;
+        /** @return the string of a D_QSTRING field, decoded from UTF-8 */
+        QString toString(int column) const;
+        /** @return the raw bytes of a D_QSTRING field, without copying them */
+        QByteArray toRawData(int column) const;
+
+      private:
+        friend class KSColumnParser;
+        Row(const KSColumnParser *parser, int index) : parser_(parser), index_(index) {}
+
+        const KSColumnParser *parser_;
+        int index_;
+    };
+
+    /**
+     * @brief Parser of a CSV file, as KSParser(filename, comment_char, sequence, delimiter)
+     **/
+    KSColumnParser(const QString &filename, const char comment_char, const Sequence &sequence,
+                   const char delimiter = ',');
+
+    /**
+     * @brief Parser of a fixed width file, as KSParser(filename, comment_char, sequence, widths)
+     **/
+    KSColumnParser(const QString &filename, const char comment_char, const Sequence &sequence,
+                   const QList<int> &widths);
+
+    /**
+     * @brief Parse the whole file.
+     * @return false if the file can not be opened, or the widths do not match the sequence
+     **/
+    bool parse();
+
+    int rowCount() const { return row_count_; }
+
+    /** @return the index of the field @p name in the sequence, or -1 */
+    int column(const QString &name) const;
+
+    Row row(int index) const { return Row(this, index); }
+
+    /** @return all the values of a D_DOUBLE field */
+    const std::vector<double> &doubles(int column) const { return columns_[column].doubles; }
+
+    /** @return all the values of a D_FLOAT field */
+    const std::vector<float> &floats(int column) const { return columns_[column].floats; }
+
+    /** @return all the values of a D_INT field */
+    const std::vector<int> &ints(int column) const { return columns_[column].ints; }
+
+  private:
+    /** A string field, as a range of the file */
+    struct Field
+    {
+        qint64 offset;
+        int length;
+    };
+
+    struct Column
+    {
+        std::vector<double> doubles;
+        std::vector<float> floats;
+        std::vector<int> ints;
+        std::vector<Field> strings;
+    };
+
+    /** A range of whole lines and the columns parsed from it */
+    struct Chunk
+    {
+        qint64 begin;
+        qint64 end;
+        int rows;
+        QVector<Column> columns;
+    };
+
+    void parseChunk(Chunk &chunk) const;
+
+    /** @short Split the line from @p begin to @p end into @p fields, false if the row is skipped */
+    bool splitCSV(const char *begin, const char *end, QVector<Field> &fields) const;
+    bool splitFixedWidth(const char *begin, const char *end, QVector<Field> &fields) const;
+
+    /** @short Convert @p field and append it to @p column */
+    void append(Column &column, KSParser::DataTypes type, const Field &field) const;
+
+    QFile file_;
+    QByteArray buffer_;
+    const char *data_ { nullptr };
+    qint64 size_ { 0 };
+
+    QString filename_;
+    char comment_char_;
+    Sequence name_type_sequence_;
+    QList<int> width_sequence_;
+    char delimiter_ { 0 };
+
+    int row_count_ { 0 };
+    QVector<Column> columns_;
+};
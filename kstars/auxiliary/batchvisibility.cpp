@@ -0,0 +1,226 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "batchvisibility.h"
+
+#include "ksnumbers.h"
+#include "observationcontext.h"
+#include "Options.h"
+#include "skyvectors.h"
+#include "skycomponents/artificialhorizoncomponent.h"
+#include "skyobjects/skyobject.h"
+#include "auxiliary/executors.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+/// Objects per block of the inner loop
+constexpr int BLOCK_SIZE = 256;
+/// Sidereal days per solar day
+constexpr double SIDEREAL_RATE = 1.00273790935;
+constexpr double DEG = M_PI / 180.0;
+}
+
+BatchVisibility::BatchVisibility(const GeoLocation &geo, const KStarsDateTime &startUT, const KStarsDateTime &stopUT,
+                                 double stepHours)
+    : m_Geo(geo), m_StartJD(startUT.djd()), m_StepHours(stepHours > 0 ? stepHours : 1)
+{
+    const double hours = (stopUT.djd() - startUT.djd()) * 24.0;
+    m_Samples          = hours > 0 ? static_cast<int>(std::ceil(hours / m_StepHours - 1e-9)) : 0;
+    m_StartLST         = m_Geo.GSTtoLST(startUT.gst()).radians();
+}
+
+void BatchVisibility::setAltitudeRange(double minAltitude, double maxAltitude)
+{
+    m_MinAltitude = minAltitude;
+    m_MaxAltitude = maxAltitude;
+}
+
+void BatchVisibility::setHorizon(const ArtificialHorizon *horizon)
+{
+    m_Horizon = horizon;
+}
+
+QVector<BatchVisibility::Result> BatchVisibility::compute(const QVector<double> &ra, const QVector<double> &dec) const
+{
+    const int count = std::min(ra.size(), dec.size());
+    QVector<Result> results(count);
+
+    // The horizon fills a cache on first use, which must not happen in several threads at once
+    if (m_Horizon != nullptr)
+    {
+        const double az = 0, alt = 90;
+        m_Horizon->areVisible(&az, &alt, 1);
+    }
+
+    std::vector<int> blocks;
+    for (int first = 0; first < count; first += BLOCK_SIZE)
+        blocks.push_back(first);
+
+    Result *out = results.data();
+    Executors::blockingMap(Executors::Interactive, blocks, [&](int first)
+    {
+        computeBlock(ra.constData() + first, dec.constData() + first, out + first, std::min(BLOCK_SIZE, count - first));
+    });
+
+    return results;
+}
+
+void BatchVisibility::computeBlock(const double *ra, const double *dec, Result *results, int count) const
+{
+    double sinLat, cosLat;
+    m_Geo.lat()->SinCos(sinLat, cosLat);
+
+    const double step    = m_StepHours * SIDEREAL_RATE * 15.0 * DEG;
+    const double cosStep = std::cos(step), sinStep = std::sin(step);
+    const double sinMin  = std::sin(std::max(-90.0, m_MinAltitude) * DEG);
+    const double sinMax  = std::sin(std::min(90.0, m_MaxAltitude) * DEG);
+
+    // Structure of arrays, sin(alt) = a + b cos(H)
+    double a[BLOCK_SIZE], b[BLOCK_SIZE], cosH[BLOCK_SIZE], sinH[BLOCK_SIZE], maxSin[BLOCK_SIZE];
+    int visible[BLOCK_SIZE];
+    // The horizontal coordinates in degrees of the positions to check against the horizon
+    double azimuth[BLOCK_SIZE], altitude[BLOCK_SIZE];
+    int index[BLOCK_SIZE];
+
+    for (int i = 0; i < count; ++i)
+    {
+        const double d = dec[i] * DEG;
+        const double h = m_StartLST - ra[i] * DEG;
+        a[i]           = std::sin(d) * sinLat;
+        b[i]           = std::cos(d) * cosLat;
+        cosH[i]        = std::cos(h);
+        sinH[i]        = std::sin(h);
+        maxSin[i]      = -1;
+        visible[i]     = 0;
+    }
+
+    for (int k = 0; k < m_Samples; ++k)
+    {
+        if (m_Horizon == nullptr)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                const double s = a[i] + b[i] * cosH[i];
+                maxSin[i]      = std::max(maxSin[i], s);
+                visible[i] += (s >= sinMin && s <= sinMax) ? 1 : 0;
+            }
+        }
+        else
+        {
+            // The positions in the altitude range are checked against the horizon in one batch
+            int candidates = 0;
+            for (int i = 0; i < count; ++i)
+            {
+                const double s = a[i] + b[i] * cosH[i];
+                maxSin[i]      = std::max(maxSin[i], s);
+                if (s < sinMin || s > sinMax)
+                    continue;
+
+                // The azimuth is only needed for the horizon, measured from the north through the east
+                const double d       = dec[i] * DEG;
+                const double az      = std::atan2(-std::cos(d) * sinH[i], std::sin(d) * cosLat - std::cos(d) * cosH[i] * sinLat);
+                index[candidates]    = i;
+                azimuth[candidates]  = az < 0 ? az / DEG + 360.0 : az / DEG;
+                altitude[candidates] = std::asin(std::max(-1.0, std::min(1.0, s))) / DEG;
+                ++candidates;
+            }
+
+            const std::vector<char> unblocked = m_Horizon->areVisible(azimuth, altitude, candidates);
+            for (int j = 0; j < candidates; ++j)
+                visible[index[j]] += unblocked[j] ? 1 : 0;
+        }
+
+        // Advance all hour angles by one step
+        for (int i = 0; i < count; ++i)
+        {
+            const double c = cosH[i] * cosStep - sinH[i] * sinStep;
+            sinH[i]        = sinH[i] * cosStep + cosH[i] * sinStep;
+            cosH[i]        = c;
+        }
+    }
+
+    const double middleJD = m_StartJD + m_Samples * m_StepHours / 48.0;
+    const double stopJD   = m_StartJD + m_Samples * m_StepHours / 24.0;
+    for (int i = 0; i < count; ++i)
+    {
+        Result &r = results[i];
+
+        // The hour angle is zero at the transit, it grows by 2 pi per sidereal day
+        const double h0 = std::remainder(m_StartLST - ra[i] * DEG, 2 * M_PI);
+        const double transit = m_StartJD - h0 / (2 * M_PI * SIDEREAL_RATE);
+        const double period  = 1.0 / SIDEREAL_RATE;
+        r.transitJD          = transit + std::round((middleJD - transit) / period) * period;
+
+        // The samples may miss the culmination
+        double s = maxSin[i];
+        if (m_Samples > 0 && r.transitJD >= m_StartJD && r.transitJD <= stopJD)
+            s = a[i] + b[i];
+
+        r.maxAltitude     = std::asin(std::max(-1.0, std::min(1.0, s))) / DEG;
+        r.hoursVisible    = visible[i] * m_StepHours;
+        r.fractionVisible = m_Samples > 0 ? double(visible[i]) / m_Samples : 0.0;
+    }
+}
+
+void BatchVisibility::coordinatesOfDate(const QList<SkyObject *> &objects, const KStarsDateTime &ut,
+                                        const GeoLocation *geo, QVector<double> &ra, QVector<double> &dec)
+{
+    ra.resize(objects.size());
+    dec.resize(objects.size());
+
+    std::vector<int> others;
+    for (int i = 0; i < objects.size(); ++i)
+    {
+        if (objects[i]->isSolarSystem())
+        {
+            const SkyPoint p = objects[i]->recomputeCoords(ut, geo);
+            ra[i]            = p.ra().Degrees();
+            dec[i]           = p.dec().Degrees();
+        }
+        else
+            others.push_back(i);
+    }
+
+    if (others.empty())
+        return;
+
+    // Precession, nutation and aberration are the same rotation and offset for all of them
+    const KSNumbers num(ut.djd());
+    const ObservationContext context(num, geo, geo->GSTtoLST(ut.gst()));
+    SkyVectors vectors(static_cast<int>(others.size()));
+    for (size_t k = 0; k < others.size(); ++k)
+        vectors.set(static_cast<int>(k), ObservationContext::unitVector(objects[others[k]]->ra0(), objects[others[k]]->dec0()));
+    context.toApparent(vectors);
+
+    std::vector<double> longitude(others.size()), latitude(others.size());
+    vectors.toAngles(longitude.data(), latitude.data());
+    for (size_t k = 0; k < others.size(); ++k)
+    {
+        ra[others[k]]  = longitude[k] / DEG;
+        dec[others[k]] = latitude[k] / DEG;
+    }
+
+    // The bending of light near the Sun is no rotation, these are updated one by one
+    if (!Options::useRelativistic())
+        return;
+    for (int i : others)
+    {
+        SkyPoint p(objects[i]->ra0(), objects[i]->dec0());
+        p.setRA(ra[i] / 15.0);
+        p.setDec(dec[i]);
+        if (!p.checkBendLight())
+            continue;
+        p.setRA(objects[i]->ra0());
+        p.setDec(objects[i]->dec0());
+        p.apparentCoord(&num);
+        ra[i]  = p.ra().Degrees();
+        dec[i] = p.dec().Degrees();
+    }
+}
@@ -0,0 +1,92 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "geolocation.h"
+#include "kstarsdatetime.h"
+
+#include <QList>
+#include <QVector>
+
+class ArtificialHorizon;
+class SkyObject;
+
+/**
+ * @class BatchVisibility
+ * @short Computes the visibility of many objects over a grid of times at once.
+ *
+ * The observing list wizard, What's Interesting and the scheduler ask whether thousands of
+ * objects are up during some part of the night. Instead of one horizontal conversion with
+ * its own sidereal time per object and time, this class computes the sidereal time once
+ * per grid, and advances the hour angles of all objects by rotation, which needs no
+ * trigonometric function per sample. Objects are processed in blocks, in parallel, with
+ * the inner loop over the objects of a block, so that the compiler can vectorize it.
+ *
+ * The coordinates are those of the date, in degrees. Refraction is ignored.
+ */
+class BatchVisibility
+{
+    public:
+        struct Result
+        {
+            /// Highest altitude during the grid, in degrees
+            double maxAltitude { -90 };
+            /// UT Julian day of the upper transit nearest to the middle of the grid
+            double transitJD { 0 };
+            /// Hours during which the object is in the altitude range and above the horizon
+            double hoursVisible { 0 };
+            /// The same as a fraction of the samples, 0 if there are none
+            double fractionVisible { 0 };
+        };
+
+        /**
+         * The times are startUT + k * stepHours, for all k for which they are before stopUT.
+         * @param geo location of the observer, which is copied
+         */
+        BatchVisibility(const GeoLocation &geo, const KStarsDateTime &startUT, const KStarsDateTime &stopUT,
+                        double stepHours);
+
+        /** @short Count only altitudes between @p minAltitude and @p maxAltitude, in degrees */
+        void setAltitudeRange(double minAltitude, double maxAltitude);
+
+        /**
+         * @short Count only positions that @p horizon does not hide, or all if nullptr.
+         * The horizon has to stay alive and unchanged while compute() runs.
+         */
+        void setHorizon(const ArtificialHorizon *horizon);
+
+        /** @return the number of times of the grid */
+        int sampleCount() const
+        {
+            return m_Samples;
+        }
+
+        /** @return the results for the given coordinates of the date, in degrees */
+        QVector<Result> compute(const QVector<double> &ra, const QVector<double> &dec) const;
+
+        /**
+         * @short Find the coordinates of @p objects at @p ut, in degrees.
+         *
+         * Solar system objects are recomputed one at a time. The others are precessed,
+         * nutated and aberrated from their catalog coordinates with one KSNumbers, in parallel.
+         */
+        static void coordinatesOfDate(const QList<SkyObject *> &objects, const KStarsDateTime &ut,
+                                      const GeoLocation *geo, QVector<double> &ra, QVector<double> &dec);
+
+    private:
+        void computeBlock(const double *ra, const double *dec, Result *results, int count) const;
+
+        GeoLocation m_Geo;
+        double m_StartJD { 0 };
+        double m_StepHours { 1 };
+        int m_Samples { 0 };
+        /// Local sidereal time of the first sample, in radians
+        double m_StartLST { 0 };
+        double m_MinAltitude { -90 };
+        double m_MaxAltitude { 90 };
+        const ArtificialHorizon *m_Horizon { nullptr };
+};
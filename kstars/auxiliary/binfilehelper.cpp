@@ -8,9 +8,13 @@
 
 #include "byteorder.h"
 #include "auxiliary/kspaths.h"
+#include "auxiliary/starcatalogformat.h"
 
+#include <QFile>
 #include <QStandardPaths>
 
+#include <cstring>
+
 class BinFileHelper;
 
 BinFileHelper::BinFileHelper()
@@ -28,6 +32,7 @@ BinFileHelper::~BinFileHelper()
 
 void BinFileHelper::init()
 {
+    unmapFile();
     if (fileHandle)
         fclose(fileHandle);
 
@@ -37,6 +42,7 @@ void BinFileHelper::init()
     RSUpdated       = false;
     preambleUpdated = false;
     byteswap        = false;
+    aligned         = false;
     errnum          = ERR_NULL;
     recordCount     = 0;
     recordSize      = 0;
@@ -98,6 +104,11 @@ enum BinFileHelper::Errors BinFileHelper::__readHeader()
 
     rewind(fileHandle);
 
+    char magic[sizeof(StarCatalogFormat::MAGIC)];
+    if (fread(magic, sizeof(magic), 1, fileHandle) == 1 && memcmp(magic, StarCatalogFormat::MAGIC, sizeof(magic)) == 0)
+        return __readAlignedHeader();
+    rewind(fileHandle);
+
     // Read the first 124 bytes of the binary file which contains a general text about the binary data.
     // e.g. "KStars Star Data v1.0. To be read using the 32-bit StarData structure only"
     ret = fread(ASCII_text, 124, 1, fileHandle); // cppcheck-suppress redundantAssignment
@@ -247,6 +258,119 @@ enum BinFileHelper::Errors BinFileHelper::__readHeader()
     return ERR_NULL;
 }
 
+enum BinFileHelper::Errors BinFileHelper::__readAlignedHeader()
+{
+    using namespace StarCatalogFormat;
+
+    StarCatalogHeader header;
+    rewind(fileHandle);
+    if (!fread(&header, sizeof(header), 1, fileHandle))
+    {
+        errorMessage = QStringLiteral("Header truncated");
+        return ERR_FD_TRUNC;
+    }
+
+    // The format is native endian, files are compiled for the machine that reads them.
+    if (header.byteOrderMark != BYTE_ORDER_MARK)
+    {
+        errorMessage = QStringLiteral("File written for the other byte order");
+        return ERR_FORMAT;
+    }
+    if (header.version != VERSION || (header.flags & FLAG_COMPRESSED))
+    {
+        errorMessage = QString::asprintf("Unsupported version %u or flags %X", header.version, header.flags);
+        return ERR_FORMAT;
+    }
+
+    aligned         = true;
+    byteswap        = false;
+    versionNumber   = header.version;
+    headerText      = QStringLiteral("KStars aligned star catalog");
+    preambleUpdated = true;
+
+    nfields = header.fieldCount;
+    qDeleteAll(fields);
+    fields.clear();
+    for (int i = 0; i < nfields; ++i)
+    {
+        dataElement *de = new dataElement;
+        if (!fread(de, sizeof(dataElement), 1, fileHandle))
+        {
+            delete de;
+            qDeleteAll(fields);
+            fields.clear();
+            return ERR_FD_TRUNC;
+        }
+        fields.append(de);
+    }
+
+    if (!RSUpdated)
+    {
+        recordSize = header.recordSize;
+        RSUpdated  = true;
+    }
+    FDUpdated = true;
+
+    indexSize    = header.indexSize;
+    itableOffset = header.indexOffset;
+    dataOffset   = header.dataOffset;
+    recordCount  = 0;
+    indexCount.clear();
+    indexOffset.clear();
+
+    if (indexSize == 0)
+    {
+        errorMessage = QStringLiteral("Zero index size!");
+        return ERR_INDEX_TRUNC;
+    }
+
+    if (fseek(fileHandle, itableOffset, SEEK_SET))
+        return ERR_BADSEEK;
+
+    // Records of consecutive trixels are contiguous, starting right after the trailer.
+    quint64 expectedOffset = header.dataOffset + TRAILER_SIZE;
+    indexOffset.reserve(indexSize);
+    indexCount.reserve(indexSize);
+    for (quint32 j = 0; j < indexSize; ++j)
+    {
+        StarCatalogIndexEntry entry;
+        if (!fread(&entry, sizeof(entry), 1, fileHandle))
+        {
+            errorMessage = QString::asprintf("Table truncated before expected! Read i = %u index entries so far", j);
+            return ERR_INDEX_TRUNC;
+        }
+
+        if (entry.offset != expectedOffset)
+        {
+            errorMessage = QString::asprintf("Expected offset %llu but found %llu in index entry %u",
+                                             static_cast<unsigned long long>(expectedOffset),
+                                             static_cast<unsigned long long>(entry.offset), j);
+            return ERR_INDEX_BADOFFSET;
+        }
+
+        indexOffset.append(entry.offset);
+        indexCount.append(entry.count);
+
+        recordCount += entry.count;
+        expectedOffset += quint64(entry.count) * recordSize;
+    }
+
+    if (recordCount != header.recordCount)
+    {
+        errorMessage = QString::asprintf("Index table holds %lu records instead of %llu", recordCount,
+                                         static_cast<unsigned long long>(header.recordCount));
+        return ERR_INDEX_BADOFFSET;
+    }
+
+    // Leave the file where the original format leaves it, at the trailer.
+    if (fseek(fileHandle, dataOffset, SEEK_SET))
+        return ERR_BADSEEK;
+
+    indexUpdated = true;
+
+    return ERR_NULL;
+}
+
 bool BinFileHelper::readHeader()
 {
     switch ((errnum = __readHeader()))
@@ -265,6 +389,7 @@ bool BinFileHelper::readHeader()
         case ERR_INDEX_IDMISMATCH:
         case ERR_BADSEEK:
         case ERR_INDEX_BADOFFSET:
+        case ERR_FORMAT:
         {
             indexOffset.clear();
             indexCount.clear();
@@ -273,8 +398,37 @@ bool BinFileHelper::readHeader()
     return false;
 }
 
+bool BinFileHelper::mapFile()
+{
+    if (mappedData)
+        return true;
+    if (!fileHandle)
+        return false;
+
+    // QFile does not close a handle it did not open
+    mappedFile.reset(new QFile());
+    if (mappedFile->open(fileHandle, QIODevice::ReadOnly))
+    {
+        mappedSize = mappedFile->size();
+        mappedData = mappedSize > 0 ? mappedFile->map(0, mappedSize) : nullptr;
+    }
+
+    if (!mappedData)
+        unmapFile();
+    return mappedData != nullptr;
+}
+
+void BinFileHelper::unmapFile()
+{
+    // Closing the QFile removes the mapping
+    mappedFile.reset();
+    mappedData = nullptr;
+    mappedSize = 0;
+}
+
 void BinFileHelper::closeFile()
 {
+    unmapFile();
     fclose(fileHandle);
     fileHandle = nullptr;
 }
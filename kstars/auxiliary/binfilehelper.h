@@ -10,7 +10,9 @@
 #include <QVector>
 
 #include <cstdio>
+#include <memory>
 
+class QFile;
 class QString;
 
 /**
@@ -58,8 +60,17 @@ class BinFileHelper
 
     FILE *openFile(const QString &fileName);
 
+    /**
+     * @short Map the whole open file in memory, so that records can be read without any I/O call.
+     * The file handle stays valid. The mapping is released by closeFile().
+     * @return true if the file is mapped
+     */
+    bool mapFile();
+
     /**
      * @short  Read the header and index table from the file and fill up the QVector s with the entries
+     *
+     * Both the original format and the aligned format of StarCatalogFormat are read.
      * @return True if successful, false if an error occurred, sets the error.
      */
     bool readHeader();
@@ -108,6 +119,18 @@ class BinFileHelper
      */
     inline FILE *getFileHandle() const { return fileHandle; }
 
+    /**
+     * @short  Get the memory mapped contents of the currently open file
+     * @return Pointer to the first byte of the file if mapFile() succeeded, nullptr otherwise
+     */
+    inline const uchar *getMappedData() const { return mappedData; }
+
+    /**
+     * @short  Get the size of the memory mapped file
+     * @return Size of the file in bytes if it is mapped, zero otherwise
+     */
+    inline qint64 getMappedSize() const { return mappedSize; }
+
     /**
      * @short  Returns the offset in the file corresponding to the given index ID
      * @param  id  ID of the index entry whose offset is required
@@ -135,6 +158,12 @@ class BinFileHelper
      */
     inline bool getByteSwap() const { return byteswap; }
 
+    /**
+     * @short  Is the file in the aligned format of StarCatalogFormat?
+     * @note   To be called only after the header has been parsed
+     */
+    inline bool isAligned() const { return aligned; }
+
     /**
      * @short  Return a guessed record size
      * @note   The record size returned is guessed from the field descriptor table and may
@@ -207,7 +236,8 @@ class BinFileHelper
         ERR_INDEX_BADID,      /*!< Index table has an invalid ID entry */
         ERR_INDEX_IDMISMATCH, /*!< Index table has a mismatched ID entry [ID found in the wrong place] */
         ERR_INDEX_BADOFFSET,  /*!< Offset / Record count specified in the Index table is bad */
-        ERR_BADSEEK           /*!< Premature end of file / bad seek while reading index table */
+        ERR_BADSEEK,          /*!< Premature end of file / bad seek while reading index table */
+        ERR_FORMAT            /*!< Aligned file of another version, byte order or with unsupported features */
     };
 
   private:
@@ -217,6 +247,12 @@ class BinFileHelper
      */
     enum Errors __readHeader();
 
+    /**
+     * @short  Backend of __readHeader for the aligned format, called after the magic was read
+     * @return Return the appropriate error code, or ERR_NULL if successful
+     */
+    enum Errors __readAlignedHeader();
+
     /**
      * @short  Helper function that clears all field entries in the QVector fields
      */
@@ -227,8 +263,17 @@ class BinFileHelper
      */
     void init();
 
+    /**
+     * @short  Helper function that releases the memory mapping of the file, if any
+     */
+    void unmapFile();
+
     /// Handle to the file.
     FILE *fileHandle { nullptr};
+    /// Memory mapping of the file, see mapFile()
+    std::unique_ptr<QFile> mappedFile;
+    const uchar *mappedData { nullptr };
+    qint64 mappedSize { 0 };
     /// Stores offsets corresponding to each index table entry
     QVector<unsigned long> indexOffset;
     /// Stores number of records under each index table entry
@@ -245,6 +290,8 @@ class BinFileHelper
     enum Errors errnum { ERR_NULL };
     /// True if byteswapping should be done
     bool byteswap { false };
+    /// True if the file is in the aligned format
+    bool aligned { false };
     /// Stores the size of a record in bytes for quick retrieval
     int recordSize { 0 };
     /// Maintains a list of fields in the file, along with relevant details
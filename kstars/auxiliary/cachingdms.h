@@ -12,10 +12,13 @@
  * @class CachingDms
  * @short a dms subclass that caches its sine and cosine values every time the angle is changed.
  * @note This is to be used for those angles where sin/cos is repeatedly computed.
+ * @note The setters hide those of dms instead of overriding them, so that neither class
+ * has a vtable and calls are resolved at compile time. The cache is only kept up to date
+ * when the angle is set through a CachingDms, not through a dms reference or pointer.
  * @author Akarsh Simha <akarsh@kde.org>
  */
 
-class CachingDms : public dms
+class CachingDms final : public dms
 {
   public:
     /**
@@ -56,7 +59,7 @@ class CachingDms : public dms
      * @short Sets the angle in degrees supplied as a double
      * @note Re-implements dms::setD() with sine/cosine caching
      */
-    inline void setD(const double &x) override
+    inline void setD(const double &x)
     {
         dms::setD(x);
         dms::SinCos(m_sin, m_cos);
@@ -71,7 +74,7 @@ class CachingDms : public dms
     /**
      * @short Overrides dms::setD()
      */
-    inline void setD(const int &d, const int &m, const int &s, const int &ms = 0) override
+    inline void setD(const int &d, const int &m, const int &s, const int &ms = 0)
     {
         dms::setD(d, m, s, ms);
         dms::SinCos(m_sin, m_cos);
@@ -86,9 +89,8 @@ class CachingDms : public dms
     /**
      * @short Sets the angle in hours, supplied as a double
      * @note Re-implements dms::setH() with sine/cosine caching
-     * @note While this and other methods internally call setD, we want to avoid unnecessary vtable lookups. We'd rather have inline than virtual when speed matters in general.
      */
-    inline void setH(const double &x) override
+    inline void setH(const double &x)
     {
         dms::setH(x);
         dms::SinCos(m_sin, m_cos);
@@ -104,7 +106,7 @@ class CachingDms : public dms
      * @short Sets the angle in HMS form
      * @note Re-implements dms::setH() with sine/cosine caching
      */
-    inline void setH(const int &h, const int &m, const int &s, const int &ms = 0) override
+    inline void setH(const int &h, const int &m, const int &s, const int &ms = 0)
     {
         dms::setH(h, m, s, ms);
         dms::SinCos(m_sin, m_cos);
@@ -117,7 +119,7 @@ class CachingDms : public dms
      * @short Sets the angle from string
      * @note Re-implements dms::setFromString()
      */
-    inline bool setFromString(const QString &s, bool isDeg = true) override
+    inline bool setFromString(const QString &s, bool isDeg = true)
     {
         bool retval = dms::setFromString(s, isDeg);
         dms::SinCos(m_sin, m_cos);
@@ -133,7 +135,7 @@ class CachingDms : public dms
     /**
      * @short Sets the angle in radians
      */
-    inline void setRadians(const double &a) override
+    inline void setRadians(const double &a)
     {
         dms::setRadians(a);
         dms::SinCos(m_sin, m_cos);
@@ -0,0 +1,207 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "cityindex.h"
+
+#include "geolocation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+// The haversine of the great circle angle between two positions in radians, which grows with the angle
+double haversine(double lng1, double lat1, double lng2, double lat2)
+{
+    const double sinLat = std::sin((lat2 - lat1) / 2);
+    const double sinLng = std::sin((lng2 - lng1) / 2);
+    return sinLat * sinLat + std::cos(lat1) * std::cos(lat2) * sinLng * sinLng;
+}
+
+// The longitude difference in degrees, wrapped to [0, 180]
+double longitudeDifference(double lng1, double lng2)
+{
+    const double difference = std::fmod(std::abs(lng2 - lng1), 360.0);
+    return difference > 180 ? 360 - difference : difference;
+}
+}
+
+QString CityIndex::key(const QString &name)
+{
+    return name.toCaseFolded();
+}
+
+int CityIndex::band(double latitude)
+{
+    return qBound(0, static_cast<int>(std::floor(latitude)) + 90, 179);
+}
+
+int CityIndex::column(double longitude)
+{
+    const int column = static_cast<int>(std::floor(longitude)) % 360;
+    return column < 0 ? column + 360 : column;
+}
+
+int CityIndex::cell(int band, int column)
+{
+    return band * 360 + column;
+}
+
+void CityIndex::build(const QList<GeoLocation *> &locations)
+{
+    m_Names.clear();
+    m_Cells.clear();
+    m_Names.reserve(locations.size());
+
+    for (GeoLocation *location : locations)
+    {
+        m_Names.append({ key(location->translatedName()), location });
+        m_Cells[cell(band(location->lat()->Degrees()), column(location->lng()->Degrees()))].append(location);
+    }
+
+    std::stable_sort(m_Names.begin(), m_Names.end(), [](const Name & a, const Name & b)
+    {
+        return a.key < b.key;
+    });
+}
+
+void CityIndex::insert(GeoLocation *location)
+{
+    Name name { key(location->translatedName()), location };
+    auto position = std::upper_bound(m_Names.begin(), m_Names.end(), name, [](const Name & a, const Name & b)
+    {
+        return a.key < b.key;
+    });
+    m_Names.insert(position, name);
+    m_Cells[cell(band(location->lat()->Degrees()), column(location->lng()->Degrees()))].append(location);
+}
+
+void CityIndex::remove(GeoLocation *location)
+{
+    auto name = std::find_if(m_Names.begin(), m_Names.end(), [location](const Name & n)
+    {
+        return n.location == location;
+    });
+    if (name != m_Names.end())
+        m_Names.erase(name);
+
+    auto entry = m_Cells.find(cell(band(location->lat()->Degrees()), column(location->lng()->Degrees())));
+    if (entry != m_Cells.end())
+    {
+        entry->removeOne(location);
+        if (entry->isEmpty())
+            m_Cells.erase(entry);
+    }
+}
+
+QVector<CityIndex::Name>::const_iterator CityIndex::lowerBound(const QString &key) const
+{
+    return std::lower_bound(m_Names.constBegin(), m_Names.constEnd(), key, [](const Name & name, const QString & k)
+    {
+        return name.key < k;
+    });
+}
+
+QList<GeoLocation *> CityIndex::startingWith(const QString &prefix) const
+{
+    const QString folded = key(prefix);
+    QList<GeoLocation *> locations;
+    for (auto name = lowerBound(folded); name != m_Names.constEnd() && name->key.startsWith(folded); ++name)
+        locations.append(name->location);
+    return locations;
+}
+
+GeoLocation *CityIndex::named(const QString &city, const QString &province, const QString &country) const
+{
+    const QString folded = key(city);
+    for (auto name = lowerBound(folded); name != m_Names.constEnd() && name->key == folded; ++name)
+    {
+        GeoLocation *location = name->location;
+        if (location->translatedName() == city && (province.isEmpty() || location->translatedProvince() == province) &&
+                (country.isEmpty() || location->translatedCountry() == country))
+            return location;
+    }
+    return nullptr;
+}
+
+GeoLocation *CityIndex::nearest(double longitude, double latitude) const
+{
+    const double lng0 = longitude * dms::DegToRad;
+    const double lat0 = latitude * dms::DegToRad;
+    const int band0 = band(latitude);
+    const int column0 = column(longitude);
+
+    GeoLocation *nearest = nullptr;
+    double best = std::numeric_limits<double>::max();
+
+    for (int ring = 0; ring <= 180 && !m_Cells.isEmpty(); ring++)
+    {
+        for (int b = band0 - ring; b <= band0 + ring; b++)
+        {
+            if (b < 0 || b >= 180)
+                continue;
+
+            // Inner rows of the ring only have its two side cells
+            const bool edge = b == band0 - ring || b == band0 + ring;
+            for (int c = -ring; c <= ring; c += edge ? 1 : 2 * ring)
+            {
+                auto entry = m_Cells.constFind(cell(b, column(column0 + c)));
+                if (entry == m_Cells.constEnd())
+                    continue;
+
+                for (GeoLocation *location : *entry)
+                {
+                    const double distance = haversine(lng0, lat0, location->lng()->radians(), location->lat()->radians());
+                    if (distance < best)
+                    {
+                        best = distance;
+                        nearest = location;
+                    }
+                }
+            }
+        }
+
+        if (nearest == nullptr)
+            continue;
+
+        // A city outside of the searched rings is more than ring degrees away in latitude, or in
+        // longitude at a latitude less than ring + 1 degrees away.
+        const double sinLat = std::sin(ring * dms::DegToRad / 2);
+        const double sinLng = std::sin(std::min(ring, 180) * dms::DegToRad / 2);
+        const double farthestLatitude = std::min(90.0, std::abs(latitude) + ring + 1) * dms::DegToRad;
+        const double bound = std::min(sinLat * sinLat, std::cos(lat0) * std::cos(farthestLatitude) * sinLng * sinLng);
+        if (best <= bound)
+            break;
+    }
+
+    return nearest;
+}
+
+QList<GeoLocation *> CityIndex::within(double longitude, double latitude, double degrees) const
+{
+    QList<GeoLocation *> locations;
+    const int firstColumn = static_cast<int>(std::floor(longitude - degrees));
+    const int lastColumn = std::min(static_cast<int>(std::floor(longitude + degrees)), firstColumn + 359);
+
+    for (int b = band(latitude - degrees); b <= band(latitude + degrees); b++)
+    {
+        for (int c = firstColumn; c <= lastColumn; c++)
+        {
+            auto entry = m_Cells.constFind(cell(b, column(c)));
+            if (entry == m_Cells.constEnd())
+                continue;
+
+            for (GeoLocation *location : *entry)
+            {
+                if (std::abs(location->lat()->Degrees() - latitude) < degrees &&
+                        longitudeDifference(location->lng()->Degrees(), longitude) < degrees)
+                    locations.append(location);
+            }
+        }
+    }
+    return locations;
+}
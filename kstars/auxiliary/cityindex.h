@@ -0,0 +1,75 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QVector>
+
+class GeoLocation;
+
+/**
+ * @class CityIndex
+ * @short Name and position lookups on the city list of KStarsData.
+ *
+ * The names are kept sorted, case folded, so that a lookup by name or by name prefix is a binary
+ * search. The positions are kept in a grid of one degree cells, the nearest city is searched in
+ * rings of cells around the given position until no farther cell can hold a closer one.
+ *
+ * The index does not own the locations, they stay in the list they were built from.
+ */
+class CityIndex
+{
+    public:
+        /** @short Index @p locations, replacing the previous content. */
+        void build(const QList<GeoLocation *> &locations);
+
+        /** @short Add @p location, after it is added to the city list. */
+        void insert(GeoLocation *location);
+
+        /** @short Remove @p location, before it is deleted or its name or position changes. */
+        void remove(GeoLocation *location);
+
+        int size() const
+        {
+            return m_Names.size();
+        }
+
+        /** @return the cities whose translated name starts with @p prefix, ignoring case. */
+        QList<GeoLocation *> startingWith(const QString &prefix) const;
+
+        /**
+         * @return the city with the translated name @p city, in the translated @p province and
+         * @p country unless they are empty, or nullptr.
+         */
+        GeoLocation *named(const QString &city, const QString &province = QString(),
+                           const QString &country = QString()) const;
+
+        /** @return the city with the smallest great circle distance to @p longitude, @p latitude in degrees. */
+        GeoLocation *nearest(double longitude, double latitude) const;
+
+        /** @return the cities less than @p degrees away from @p longitude and @p latitude on each axis. */
+        QList<GeoLocation *> within(double longitude, double latitude, double degrees) const;
+
+    private:
+        struct Name
+        {
+            QString key;
+            GeoLocation *location;
+        };
+
+        static QString key(const QString &name);
+        static int cell(int band, int column);
+        static int band(double latitude);
+        static int column(double longitude);
+
+        QVector<Name>::const_iterator lowerBound(const QString &key) const;
+
+        QVector<Name> m_Names;
+        QHash<int, QVector<GeoLocation *>> m_Cells;
+};
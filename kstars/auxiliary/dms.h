@@ -50,9 +50,6 @@ class dms
 #endif
     }
 
-    /** Empty virtual destructor */
-    virtual ~dms() = default;
-
     /** @short Set the floating-point value of the angle according to the four integer arguments.
          * @param d degree portion of angle (int).  Defaults to zero.
          * @param m arcminute portion of angle (int).  Defaults to zero.
@@ -176,7 +173,7 @@ class dms
     /** Sets floating-point value of angle, in degrees.
          * @param x new angle (double)
          */
-    inline virtual void setD(const double &x)
+    inline void setD(const double &x)
     {
 #ifdef COUNT_DMS_SINCOS_CALLS
         m_sinDirty = m_cosDirty = true;
@@ -198,7 +195,7 @@ class dms
          * @param s integer arcseconds portion of angle
          * @param ms integer arcseconds portion of angle
          */
-    virtual void setD(const int &d, const int &m, const int &s, const int &ms = 0);
+    void setD(const int &d, const int &m, const int &s, const int &ms = 0);
 
     /** @short Sets floating-point value of angle, in hours.
          *
@@ -207,7 +204,7 @@ class dms
          * @param x new angle, in hours (double)
          * @sa setD()
          */
-    inline virtual void setH(const double &x)
+    inline void setH(const double &x)
     {
         dms::setD(x * 15.0);
 #ifdef COUNT_DMS_SINCOS_CALLS
@@ -227,7 +224,7 @@ class dms
          * @param ms integer milliseconds portion of angle
          * @sa setD()
          */
-    virtual void setH(const int &h, const int &m, const int &s, const int &ms = 0);
+    void setH(const int &h, const int &m, const int &s, const int &ms = 0);
 
     /** @short Attempt to parse the string argument as a dms value, and set the dms object
          * accordingly.
@@ -237,7 +234,7 @@ class dms
          * @return true if sting was parsed successfully.  Otherwise, set the dms value
          * to 0.0 and return false.
          */
-    virtual bool setFromString(const QString &s, bool isDeg = true);
+    bool setFromString(const QString &s, bool isDeg = true);
 
     /** @short Compute Sine and Cosine of the angle simultaneously.
          * On machines using glibc >= 2.1, calling SinCos() is somewhat faster
@@ -330,7 +327,7 @@ class dms
          * with setD().
          * @param Rad an angle in radians
          */
-    inline virtual void setRadians(const double &Rad)
+    inline void setRadians(const double &Rad)
     {
         dms::setD(Rad / DegToRad);
 #ifdef COUNT_DMS_SINCOS_CALLS
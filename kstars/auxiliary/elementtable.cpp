@@ -0,0 +1,172 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "elementtable.h"
+
+#include "kstars_debug.h"
+
+#include <QSaveFile>
+
+#include <cstring>
+
+namespace
+{
+constexpr char MAGIC[8] = { 'K', 'S', 'E', 'L', 'E', 'M', 'T', 'B' };
+constexpr quint32 BYTE_ORDER = 0x01020304;
+
+struct Header
+{
+    char magic[8];
+    quint32 byteOrder;
+    quint32 version;
+    quint32 recordSize;
+    quint32 count;
+    quint32 stringsSize;
+    quint32 tag;
+};
+static_assert(sizeof(Header) % 8 == 0, "The records that follow the header must stay aligned");
+}
+
+ElementTable::StringPool::StringPool()
+{
+    m_Data.append('\0');
+    m_Offsets.insert(QString(), 0);
+}
+
+quint32 ElementTable::StringPool::add(const QString &string)
+{
+    if (string.isEmpty())
+        return 0;
+
+    auto it = m_Offsets.constFind(string);
+    if (it != m_Offsets.constEnd())
+        return it.value();
+
+    const quint32 offset = m_Data.size();
+    m_Data.append(string.toUtf8());
+    m_Data.append('\0');
+    m_Offsets.insert(string, offset);
+    return offset;
+}
+
+ElementTable::~ElementTable()
+{
+    close();
+}
+
+bool ElementTable::open(const QString &path, quint32 version, quint32 recordSize, quint32 tag)
+{
+    close();
+
+    m_File.setFileName(path);
+    if (!m_File.open(QIODevice::ReadOnly))
+        return false;
+
+    const qint64 size = m_File.size();
+    if (size < static_cast<qint64>(sizeof(Header)))
+    {
+        close();
+        return false;
+    }
+
+    m_Map = m_File.map(0, size);
+    if (m_Map == nullptr)
+    {
+        qCWarning(KSTARS) << "Failed mapping" << path;
+        close();
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, m_Map, sizeof(Header));
+    const qint64 expected = sizeof(Header) + qint64(header.count) * header.recordSize + header.stringsSize;
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.byteOrder != BYTE_ORDER ||
+            header.version != version || header.recordSize != recordSize || header.tag != tag || header.stringsSize == 0 ||
+            size != expected)
+    {
+        close();
+        return false;
+    }
+
+    m_Records     = m_Map + sizeof(Header);
+    m_Strings     = reinterpret_cast<const char *>(m_Records + qint64(header.count) * header.recordSize);
+    m_StringsSize = header.stringsSize;
+    m_Count       = header.count;
+
+    // Every string must end within the pool
+    if (m_Strings[m_StringsSize - 1] != '\0')
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void ElementTable::close()
+{
+    if (m_Map != nullptr)
+        m_File.unmap(m_Map);
+    m_File.close();
+
+    m_Map         = nullptr;
+    m_Records     = nullptr;
+    m_Strings     = nullptr;
+    m_StringsSize = 0;
+    m_Count       = 0;
+    m_Cache.clear();
+}
+
+QString ElementTable::string(quint32 offset) const
+{
+    if (offset == 0 || offset >= m_StringsSize)
+        return QString();
+
+    return QString::fromUtf8(m_Strings + offset);
+}
+
+QString ElementTable::sharedString(quint32 offset) const
+{
+    if (offset == 0 || offset >= m_StringsSize)
+        return QString();
+
+    auto it = m_Cache.constFind(offset);
+    if (it != m_Cache.constEnd())
+        return it.value();
+
+    const QString s = QString::fromUtf8(m_Strings + offset);
+    m_Cache.insert(offset, s);
+    return s;
+}
+
+bool ElementTable::write(const QString &path, quint32 version, quint32 recordSize, quint32 count,
+                         const QByteArray &records, const StringPool &strings, quint32 tag)
+{
+    if (records.size() != qint64(count) * recordSize)
+        return false;
+
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.byteOrder   = BYTE_ORDER;
+    header.version     = version;
+    header.recordSize  = recordSize;
+    header.count       = count;
+    header.stringsSize = strings.data().size();
+    header.tag         = tag;
+
+    // Readers of the previous table must never see a partial one
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qCWarning(KSTARS) << "Failed writing" << path;
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+    file.write(records);
+    file.write(strings.data());
+    return file.commit();
+}
@@ -0,0 +1,102 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QString>
+
+/**
+ * @class ElementTable
+ * @short A memory mapped file of fixed size records, like the orbital elements of minor bodies.
+ *
+ * The file starts with a header that holds a magic number, a byte order mark, the version and
+ * size of the records, their count and a tag, such as a checksum of the data the table was built from. The records follow as they are in memory, then a pool
+ * of UTF-8 strings that the records refer to by offset. A table that was written by another
+ * version, from other data, on another architecture or that is truncated is refused by open(),
+ * and the caller rebuilds it.
+ *
+ * The records are read in place, nothing is copied but the strings that are asked for.
+ */
+class ElementTable
+{
+    public:
+        /**
+         * @class StringPool
+         * @short Collects the strings of the records while a table is written.
+         *
+         * Equal strings are stored once, the empty string is at offset 0.
+         */
+        class StringPool
+        {
+            public:
+                StringPool();
+
+                /** @return the offset of @p string in the pool */
+                quint32 add(const QString &string);
+
+                const QByteArray &data() const
+                {
+                    return m_Data;
+                }
+
+            private:
+                QByteArray m_Data;
+                QHash<QString, quint32> m_Offsets;
+        };
+
+        ElementTable() = default;
+        ~ElementTable();
+
+        ElementTable(const ElementTable &) = delete;
+        ElementTable &operator=(const ElementTable &) = delete;
+
+        /**
+         * @short Map the table at @p path.
+         * @return false if the file is missing or was not written with @p version, @p recordSize and @p tag
+         */
+        bool open(const QString &path, quint32 version, quint32 recordSize, quint32 tag = 0);
+
+        /** @short Unmap the table */
+        void close();
+
+        int count() const
+        {
+            return m_Count;
+        }
+
+        /** @return the record at @p index, valid until close() */
+        template <typename Record>
+        const Record &record(int index) const
+        {
+            return reinterpret_cast<const Record *>(m_Records)[index];
+        }
+
+        /** @return the string at @p offset */
+        QString string(quint32 offset) const;
+
+        /** @return the string at @p offset, the same shared one for the same offset, for repeated strings */
+        QString sharedString(quint32 offset) const;
+
+        /**
+         * @short Write a table of @p count records to @p path, replacing it.
+         * @return false if the file could not be written
+         */
+        static bool write(const QString &path, quint32 version, quint32 recordSize, quint32 count,
+                          const QByteArray &records, const StringPool &strings, quint32 tag = 0);
+
+    private:
+        QFile m_File;
+        uchar *m_Map { nullptr };
+        const uchar *m_Records { nullptr };
+        const char *m_Strings { nullptr };
+        quint32 m_StringsSize { 0 };
+        int m_Count { 0 };
+        /// Strings returned by sharedString()
+        mutable QHash<quint32, QString> m_Cache;
+};
@@ -0,0 +1,356 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "executors.h"
+
+#include "Options.h"
+
+#include <KLocalizedString>
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMap>
+#include <QRegularExpression>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <atomic>
+
+#ifdef Q_OS_LINUX
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+// QThreadPool names its threads so
+const QString POOLED_THREAD = QStringLiteral("Thread (pooled)");
+
+// The names of the pool threads, as shown in the traces
+const char *const THREAD_NAMES[Executors::PriorityCount] = { "Real-time pool", "Interactive pool", "Background pool" };
+
+#ifdef Q_OS_LINUX
+// The nice value of the background threads
+constexpr int BACKGROUND_NICE = 10;
+#endif
+
+struct Counters
+{
+    std::atomic<quint64> submitted { 0 };
+    std::atomic<quint64> started { 0 };
+    std::atomic<quint64> finished { 0 };
+
+    // Reset by resetMetrics()
+    std::atomic<quint64> completed { 0 };
+    std::atomic<qint64> totalWait { 0 };
+    std::atomic<qint64> longestWait { 0 };
+    std::atomic<qint64> totalRun { 0 };
+};
+
+Counters counters[Executors::PriorityCount];
+
+std::atomic<int> threadCounts[Executors::PriorityCount] { {0}, {0}, {0} };
+std::atomic<bool> affinity { false };
+
+// Bumped when the affinity changes, the pool threads are set up again with their next task
+std::atomic<int> generation { 0 };
+
+Q_GLOBAL_STATIC(QThreadPool, realTimePool)
+Q_GLOBAL_STATIC(QThreadPool, backgroundPool)
+
+qint64 now()
+{
+    static const QElapsedTimer timer = []()
+    {
+        QElapsedTimer timer;
+        timer.start();
+        return timer;
+    }();
+    return timer.nsecsElapsed();
+}
+
+// Reads an integer from a file of sysfs, -1 if there is none
+qint64 readValue(const QString &filename)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly))
+        return -1;
+    bool ok = false;
+    const qint64 value = file.readAll().trimmed().toLongLong(&ok);
+    return ok ? value : -1;
+}
+
+#ifdef Q_OS_LINUX
+void pinThread(const QVector<int> &cpus)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (cpus.isEmpty())
+    {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            CPU_SET(cpu, &set);
+    }
+    else
+    {
+        for (int cpu : cpus)
+            CPU_SET(cpu, &set);
+    }
+    // 0 is the calling thread
+    sched_setaffinity(0, sizeof(set), &set);
+}
+#endif
+}
+
+QThreadPool *Executors::pool(Priority priority)
+{
+    switch (priority)
+    {
+        case RealTime:
+            return realTimePool();
+        case Background:
+            return backgroundPool();
+        case Interactive:
+        default:
+            return QThreadPool::globalInstance();
+    }
+}
+
+QString Executors::name(Priority priority)
+{
+    switch (priority)
+    {
+        case RealTime:
+            return i18n("Real-time");
+        case Background:
+            return i18n("Background");
+        case Interactive:
+        default:
+            return i18n("Interactive");
+    }
+}
+
+void Executors::configure()
+{
+    // The pools share the stack size of the global pool, set at startup
+    const uint stackSize = QThreadPool::globalInstance()->stackSize();
+    realTimePool()->setStackSize(stackSize);
+    backgroundPool()->setStackSize(stackSize);
+
+    setAffinity(Options::threadAffinity());
+    setThreadCount(RealTime, static_cast<int>(Options::realTimeThreads()));
+    setThreadCount(Interactive, static_cast<int>(Options::interactiveThreads()));
+    setThreadCount(Background, static_cast<int>(Options::backgroundThreads()));
+}
+
+void Executors::setThreadCount(Priority priority, int threads)
+{
+    threadCounts[priority] = std::max(0, threads);
+    pool(priority)->setMaxThreadCount(threads > 0 ? threads : defaultThreadCount(priority));
+}
+
+int Executors::defaultThreadCount(Priority priority)
+{
+    const int ideal = std::max(1, QThread::idealThreadCount());
+    const bool pinned = affinity && !cores().performance.isEmpty();
+    switch (priority)
+    {
+        case RealTime:
+            return pinned ? cores().performance.size() : ideal;
+        case Background:
+            return pinned ? cores().efficiency.size() : std::max(1, ideal / 2);
+        case Interactive:
+        default:
+            return ideal;
+    }
+}
+
+void Executors::setAffinity(bool enabled)
+{
+    if (affinity.exchange(enabled) == enabled)
+        return;
+    ++generation;
+
+    // The default thread counts follow the cores of the pools
+    for (int i = 0; i < PriorityCount; ++i)
+    {
+        if (threadCounts[i] == 0)
+            setThreadCount(static_cast<Priority>(i), 0);
+    }
+}
+
+const Executors::Cores &Executors::cores()
+{
+    static const Cores cores = readCores(QStringLiteral("/sys/devices/system/cpu"));
+    return cores;
+}
+
+Executors::Cores Executors::readCores(const QString &sysfs)
+{
+    const QRegularExpression cpuName(QStringLiteral("^cpu(\\d+)$"));
+    const QDir directory(sysfs);
+
+    // The capacity is the performance of a core relative to the fastest one, the maximum frequency is
+    // the next best guess on kernels without it
+    QMap<int, qint64> capacities;
+    for (const QString &cpu : directory.entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+    {
+        const QRegularExpressionMatch match = cpuName.match(cpu);
+        if (!match.hasMatch())
+            continue;
+
+        qint64 capacity = readValue(directory.filePath(cpu + "/cpu_capacity"));
+        if (capacity < 0)
+            capacity = readValue(directory.filePath(cpu + "/cpufreq/cpuinfo_max_freq"));
+        if (capacity < 0)
+            return Cores();
+        capacities[match.captured(1).toInt()] = capacity;
+    }
+
+    Cores cores;
+    if (capacities.isEmpty())
+        return cores;
+
+    const qint64 fastest = *std::max_element(capacities.cbegin(), capacities.cend());
+    for (auto it = capacities.cbegin(); it != capacities.cend(); ++it)
+    {
+        if (it.value() == fastest)
+            cores.performance.append(it.key());
+        else
+            cores.efficiency.append(it.key());
+    }
+
+    if (cores.efficiency.isEmpty())
+        cores.performance.clear();
+    return cores;
+}
+
+Executors::Metrics Executors::metrics(Priority priority)
+{
+    const Counters &counter = counters[priority];
+    const quint64 submitted = counter.submitted;
+    const quint64 started = counter.started;
+    const quint64 finished = counter.finished;
+    const quint64 completed = counter.completed;
+
+    Metrics metrics;
+    metrics.name = name(priority);
+    metrics.threads = pool(priority)->maxThreadCount();
+    metrics.active = static_cast<int>(started > finished ? started - finished : 0);
+    metrics.queued = static_cast<int>(submitted > started ? submitted - started : 0);
+    metrics.completed = completed;
+    if (completed > 0)
+    {
+        metrics.averageWait = counter.totalWait / 1e6 / completed;
+        metrics.averageRun = counter.totalRun / 1e6 / completed;
+    }
+    metrics.longestWait = counter.longestWait / 1e6;
+    return metrics;
+}
+
+QString Executors::summary()
+{
+    QStringList lines;
+    for (int i = 0; i < PriorityCount; ++i)
+    {
+        const Metrics pool = metrics(static_cast<Priority>(i));
+        lines << i18n("%1: %2 threads, %3 active, %4 queued, %5 completed, %6 ms average wait, %7 ms longest wait, "
+                      "%8 ms average run", pool.name, pool.threads, pool.active, pool.queued, pool.completed,
+                      QString::number(pool.averageWait, 'f', 1), QString::number(pool.longestWait, 'f', 1),
+                      QString::number(pool.averageRun, 'f', 1));
+    }
+    return lines.join('\n');
+}
+
+void Executors::resetMetrics()
+{
+    for (Counters &counter : counters)
+    {
+        counter.completed = 0;
+        counter.totalWait = 0;
+        counter.longestWait = 0;
+        counter.totalRun = 0;
+    }
+}
+
+qint64 Executors::taskSubmitted(Priority priority)
+{
+    ++counters[priority].submitted;
+    return now();
+}
+
+Executors::Task::Task(Priority priority, qint64 submitted) : m_Priority(priority), m_Started(now())
+{
+    Counters &counter = counters[priority];
+    ++counter.started;
+
+    const qint64 wait = m_Started - submitted;
+    counter.totalWait += wait;
+    qint64 longest = counter.longestWait;
+    while (wait > longest && !counter.longestWait.compare_exchange_weak(longest, wait))
+        ;
+}
+
+Executors::Task::~Task()
+{
+    Counters &counter = counters[m_Priority];
+    counter.totalRun += now() - m_Started;
+    ++counter.completed;
+    ++counter.finished;
+}
+
+void Executors::prepareThread(Priority priority)
+{
+    // -1 while the thread was never set up, -2 if it is not a pool thread
+    thread_local int preparedGeneration = -1;
+    // The pool of the thread
+    thread_local Priority owner = Interactive;
+
+    const int current = generation;
+    if (preparedGeneration == -2 || preparedGeneration == current)
+        return;
+
+    QThread *thread = QThread::currentThread();
+    if (preparedGeneration == -1)
+    {
+        if (thread->objectName() != POOLED_THREAD)
+        {
+            preparedGeneration = -2;
+            return;
+        }
+        // A task runs out of its pool only in a thread that waits for it, which already runs a task of its own pool
+        owner = priority;
+    }
+    preparedGeneration = current;
+
+    thread->setObjectName(THREAD_NAMES[owner]);
+
+#ifdef Q_OS_LINUX
+    // The thread priorities of Qt have no effect on the default scheduler of Linux, the nice value of the thread
+    // is used instead. Raising it back fails without privileges, so it is only set for the threads of the background
+    // pool, whatever the tasks they borrow from other pools.
+    if (owner == Background)
+        setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), BACKGROUND_NICE);
+
+    const Cores &processor = cores();
+    if (affinity && !processor.performance.isEmpty())
+    {
+        if (owner == RealTime)
+            pinThread(processor.performance);
+        else if (owner == Background)
+            pinThread(processor.efficiency);
+        else
+            pinThread(QVector<int>());
+    }
+    else
+        pinThread(QVector<int>());
+#else
+    thread->setPriority(owner == RealTime ? QThread::HighPriority :
+                        owner == Background ? QThread::LowPriority : QThread::NormalPriority);
+#endif
+}
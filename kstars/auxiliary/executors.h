@@ -0,0 +1,225 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QFuture>
+#include <QString>
+#include <QThread>
+#include <QVector>
+#include <QtConcurrent>
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+class QThreadPool;
+
+/**
+ * @class Executors
+ * The thread pools that run the background work of KStars, one per priority.
+ *
+ * Work submitted to one pool never waits behind the work of another, so the statistics of an image in the
+ * FITS viewer or a scheduler evaluation can not delay the star detection of the next guide frame.
+ *
+ * @li RealTime runs the work of the guide and focus frames, with the highest thread priority and on the
+ * performance cores of a big.LITTLE processor when the affinity is enabled.
+ * @li Interactive runs the work the user waits on, such as loading and stretching an image or drawing the
+ * sky map. It is the global thread pool, so plain QtConcurrent calls run there too.
+ * @li Background runs batch work such as loading catalogs, writing files or evaluating the scheduler queue,
+ * with fewer threads and a lower thread priority, on the efficiency cores when the affinity is enabled.
+ *
+ * The thread counts and the affinity are read from the options by configure(). Each pool keeps counters of
+ * its queue, returned by metrics().
+ */
+class Executors
+{
+    public:
+        enum Priority
+        {
+            RealTime,
+            Interactive,
+            Background
+        };
+
+        static constexpr int PriorityCount = Background + 1;
+
+        struct Metrics
+        {
+            QString name;
+            int threads { 0 };
+            /// Tasks running now
+            int active { 0 };
+            /// Tasks waiting for a thread
+            int queued { 0 };
+            quint64 completed { 0 };
+            /// Average and longest time in milliseconds a completed task waited for a thread
+            double averageWait { 0 };
+            double longestWait { 0 };
+            /// Average time in milliseconds a completed task ran
+            double averageRun { 0 };
+        };
+
+        /**
+         * @struct Cores
+         * The logical CPUs of the performance and efficiency cores. Both are empty when all the cores are alike.
+         */
+        struct Cores
+        {
+            QVector<int> performance;
+            QVector<int> efficiency;
+        };
+
+        /** @return the pool of @p priority */
+        static QThreadPool *pool(Priority priority);
+
+        /** @return the translated name of @p priority */
+        static QString name(Priority priority);
+
+        /**
+         * @short Run @p function with @p args in the pool of @p priority, as QtConcurrent::run does.
+         * Member functions take the object as their first argument, as in std::invoke.
+         */
+        template <typename Function, typename... Args>
+        static auto run(Priority priority, Function &&function, Args &&... args)
+        -> QFuture<std::invoke_result_t<std::decay_t<Function>, std::decay_t<Args>...>>
+        {
+            const qint64 submitted = taskSubmitted(priority);
+            return QtConcurrent::run(pool(priority), [priority, submitted, function = std::forward<Function>(function),
+                                                      args = std::make_tuple(std::forward<Args>(args)...)]()
+            {
+                prepareThread(priority);
+                Task task(priority, submitted);
+                return std::apply(function, args);
+            });
+        }
+
+        /** @short Call @p function on each item from @p begin to @p end in the pool of @p priority, and wait for all of them. */
+        template <typename Iterator, typename Function>
+        static void blockingMap(Priority priority, Iterator begin, Iterator end, Function function)
+        {
+            // The whole map is counted as one task of the pool
+            Task task(priority, taskSubmitted(priority));
+            MapKernel<Iterator, Function> kernel(priority, begin, end, std::move(function));
+            kernel.startBlocking();
+        }
+
+        /** @short Call @p function on each item of @p sequence in the pool of @p priority, and wait for all of them. */
+        template <typename Sequence, typename Function>
+        static void blockingMap(Priority priority, Sequence &sequence, Function function)
+        {
+            blockingMap(priority, sequence.begin(), sequence.end(), std::move(function));
+        }
+
+        /** @short Call @p function on each item from @p begin to @p end in the pool of @p priority, without waiting. */
+        template <typename Iterator, typename Function>
+        static QFuture<void> map(Priority priority, Iterator begin, Iterator end, Function function)
+        {
+            // The kernel deletes itself when it is done
+            return (new MapKernel<Iterator, Function>(priority, begin, end, std::move(function)))->startAsynchronously();
+        }
+
+        /** @short Call @p function on each item of @p sequence, which must outlive the future, in the pool of @p priority. */
+        template <typename Sequence, typename Function>
+        static QFuture<void> map(Priority priority, Sequence &sequence, Function function)
+        {
+            return map(priority, sequence.begin(), sequence.end(), std::move(function));
+        }
+
+        /**
+         * @short Apply the thread counts and the affinity of the options. Pool threads that are already running
+         * move to their cores with their next task.
+         */
+        static void configure();
+
+        /** @short Set the thread count of the pool of @p priority, 0 for the default. */
+        static void setThreadCount(Priority priority, int threads);
+
+        /** @return the thread count of the pool of @p priority when it is set to 0 */
+        static int defaultThreadCount(Priority priority);
+
+        /** @short Keep the real-time threads on the performance cores and the background threads on the efficiency cores. */
+        static void setAffinity(bool enabled);
+
+        /** @return the performance and efficiency cores of this processor */
+        static const Cores &cores();
+
+        /**
+         * @return the cores read from the cpu_capacity files of @p sysfs, such as /sys/devices/system/cpu, or from
+         * the maximum frequencies of the cores when there are none
+         */
+        static Cores readCores(const QString &sysfs);
+
+        static Metrics metrics(Priority priority);
+
+        /** @return the metrics of all the pools, one line each */
+        static QString summary();
+
+        /** @short Clear the counters of completed tasks. */
+        static void resetMetrics();
+
+    private:
+        /** @short Counts a task of a pool from the time it starts running to its end. */
+        class Task
+        {
+            public:
+                Task(Priority priority, qint64 submitted);
+                ~Task();
+
+            private:
+                Q_DISABLE_COPY(Task)
+
+                Priority m_Priority;
+                qint64 m_Started;
+        };
+
+        /** A map kernel of QtConcurrent that runs in one of the pools instead of the global pool. */
+        template <typename Iterator, typename Function>
+        class MapKernel : public QtConcurrent::MapKernel<Iterator, Function>
+        {
+            public:
+                MapKernel(Priority priority, Iterator begin, Iterator end, Function function)
+                    : QtConcurrent::MapKernel<Iterator, Function>(begin, end, std::move(function)), m_Priority(priority),
+                      m_Caller(QThread::currentThread())
+                {
+                    this->threadPool = pool(priority);
+                }
+
+                bool runIteration(Iterator it, int index, void *result) override
+                {
+                    prepare();
+                    return QtConcurrent::MapKernel<Iterator, Function>::runIteration(it, index, result);
+                }
+
+                bool runIterations(Iterator sequenceBeginIterator, int beginIndex, int endIndex, void *result) override
+                {
+                    prepare();
+                    return QtConcurrent::MapKernel<Iterator, Function>::runIterations(sequenceBeginIterator, beginIndex,
+                            endIndex, result);
+                }
+
+            private:
+                // A blocking map also runs in the thread that waits for it, which is left as it is
+                void prepare()
+                {
+                    if (QThread::currentThread() != m_Caller)
+                        prepareThread(m_Priority);
+                }
+
+                Priority m_Priority;
+                QThread *m_Caller;
+        };
+
+        /** @return the time of the submission */
+        static qint64 taskSubmitted(Priority priority);
+
+        /**
+         * @short Set the thread priority and the affinity of the current thread for its pool, once per configuration.
+         * The pool is that of @p priority, the first task the thread runs. Later tasks of other pools, run by the thread
+         * while it waits for them, leave it as it is. Threads that are not pool threads are left as they are.
+         */
+        static void prepareThread(Priority priority);
+};
@@ -19,6 +19,64 @@
 #include <QFile>
 #include <QProgressDialog>
 
+#include <zlib.h>
+
+#include <cstdio>
+
+namespace
+{
+/** The ETag and Last-Modified of the response a file was downloaded from */
+struct Validators
+{
+    QByteArray etag;
+    QByteArray lastModified;
+
+    bool isEmpty() const
+    {
+        return etag.isEmpty() && lastModified.isEmpty();
+    }
+};
+
+QString validatorsFileName(const QString &fileName)
+{
+    return fileName + QLatin1String(".etag");
+}
+
+Validators readValidators(const QString &fileName)
+{
+    Validators validators;
+    QFile file(validatorsFileName(fileName));
+    if (file.open(QIODevice::ReadOnly))
+    {
+        validators.etag         = file.readLine().trimmed();
+        validators.lastModified = file.readLine().trimmed();
+    }
+    return validators;
+}
+
+void writeValidators(const QString &fileName, const Validators &validators)
+{
+    QFile file(validatorsFileName(fileName));
+    if (validators.isEmpty())
+    {
+        file.remove();
+        return;
+    }
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        file.write(validators.etag + '\n' + validators.lastModified + '\n');
+}
+
+bool replaceFile(const QString &source, const QString &destination)
+{
+    // rename() replaces the destination in one step on POSIX systems, elsewhere it fails if it exists
+    if (std::rename(QFile::encodeName(source).constData(), QFile::encodeName(destination).constData()) == 0)
+        return true;
+
+    QFile::remove(destination);
+    return QFile::rename(source, destination);
+}
+}
+
 FileDownloader::FileDownloader(QObject *parent) : QObject(parent)
 {
     connect(&m_WebCtrl, SIGNAL(finished(QNetworkReply*)), this, SLOT(dataFinished(QNetworkReply*)));
@@ -27,35 +85,99 @@ FileDownloader::FileDownloader(QObject *parent) : QObject(parent)
     registerFileVerification([](const QString &) { return true;});
 }
 
+FileDownloader::~FileDownloader()
+{
+    if (m_Inflate)
+        inflateEnd(m_Inflate.get());
+}
+
 void FileDownloader::get(const QUrl &fileUrl)
 {
     QNetworkRequest request(fileUrl);
     m_DownloadedData.clear();
-    isCancelled = false;
-    m_Reply     = m_WebCtrl.get(request);
+    isCancelled   = false;
+    m_Resuming    = false;
+    m_NotModified = false;
+
+    if (m_PartFile.isOpen())
+    {
+        const QString fileName = m_DownloadedFileURL.toLocalFile();
 
+        // Only download the file if it changed
+        const Validators current = readValidators(fileName);
+        if (QFile::exists(fileName))
+        {
+            if (!current.etag.isEmpty())
+                request.setRawHeader("If-None-Match", current.etag);
+            if (!current.lastModified.isEmpty())
+                request.setRawHeader("If-Modified-Since", current.lastModified);
+        }
+
+        // Continue an interrupted download, if the server still has the same version.
+        // The state of the decompression is not kept, so decompressed downloads restart.
+        const Validators partial = readValidators(partFileName());
+        if (!m_Decompress && m_PartFile.size() > 0 && !partial.isEmpty())
+        {
+            request.setRawHeader("Range", "bytes=" + QByteArray::number(m_PartFile.size()) + '-');
+            request.setRawHeader("If-Range", partial.etag.isEmpty() ? partial.lastModified : partial.etag);
+            m_Resuming = true;
+        }
+        else
+            m_PartFile.resize(0);
+    }
+
+    m_Reply = m_WebCtrl.get(request);
+    connectReply();
+}
+
+void FileDownloader::connectReply()
+{
     connect(m_Reply, SIGNAL(error(QNetworkReply::NetworkError)), this, SLOT(slotError()));
     connect(m_Reply, SIGNAL(downloadProgress(qint64,qint64)), this, SIGNAL(downloadProgress(qint64,qint64)));
     connect(m_Reply, SIGNAL(downloadProgress(qint64,qint64)), this, SLOT(setDownloadProgress(qint64,qint64)));
+    connect(m_Reply, SIGNAL(metaDataChanged()), this, SLOT(metaDataReady()));
     connect(m_Reply, SIGNAL(readyRead()), this, SLOT(dataReady()));
 
     setDownloadProgress(0, 0);
 }
 
+void FileDownloader::metaDataReady()
+{
+    const int status = m_Reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status == 304)
+    {
+        m_NotModified = true;
+        return;
+    }
+
+    if (!m_PartFile.isOpen())
+        return;
+
+    if (status == 206 && m_Resuming)
+        m_PartFile.seek(m_PartFile.size());
+    else
+    {
+        // The server sends the whole file
+        m_Resuming = false;
+        m_PartFile.resize(0);
+        m_PartFile.seek(0);
+    }
+
+    writeValidators(partFileName(), { m_Reply->rawHeader("ETag"), m_Reply->rawHeader("Last-Modified") });
+}
+
 void FileDownloader::post(const QUrl &fileUrl, QByteArray &data)
 {
     QNetworkRequest request(fileUrl);
     request.setHeader(QNetworkRequest::ContentTypeHeader, QVariant("application/x-www-form-urlencoded"));
     m_DownloadedData.clear();
-    isCancelled = false;
-    m_Reply     = m_WebCtrl.post(request, data);
-
-    connect(m_Reply, SIGNAL(error(QNetworkReply::NetworkError)), this, SLOT(slotError()));
-    connect(m_Reply, SIGNAL(downloadProgress(qint64,qint64)), this, SIGNAL(downloadProgress(qint64,qint64)));
-    connect(m_Reply, SIGNAL(downloadProgress(qint64,qint64)), this, SLOT(setDownloadProgress(qint64,qint64)));
-    connect(m_Reply, SIGNAL(readyRead()), this, SLOT(dataReady()));
-
-    setDownloadProgress(0, 0);
+    isCancelled   = false;
+    m_Resuming    = false;
+    m_NotModified = false;
+    if (m_PartFile.isOpen())
+        m_PartFile.resize(0);
+    m_Reply       = m_WebCtrl.post(request, data);
+    connectReply();
 }
 
 void FileDownloader::post(const QUrl &fileUrl, QHttpMultiPart *parts)
@@ -63,25 +185,113 @@ void FileDownloader::post(const QUrl &fileUrl, QHttpMultiPart *parts)
     QNetworkRequest request(fileUrl);
     request.setHeader(QNetworkRequest::ContentTypeHeader, QVariant("application/x-www-form-urlencoded"));
     m_DownloadedData.clear();
-    isCancelled = false;
-    m_Reply     = m_WebCtrl.post(request, parts);
-
-    connect(m_Reply, SIGNAL(error(QNetworkReply::NetworkError)), this, SLOT(slotError()));
-    connect(m_Reply, SIGNAL(downloadProgress(qint64,qint64)), this, SIGNAL(downloadProgress(qint64,qint64)));
-    connect(m_Reply, SIGNAL(downloadProgress(qint64,qint64)), this, SLOT(setDownloadProgress(qint64,qint64)));
-    connect(m_Reply, SIGNAL(readyRead()), this, SLOT(dataReady()));
-
-    setDownloadProgress(0, 0);
+    isCancelled   = false;
+    m_Resuming    = false;
+    m_NotModified = false;
+    if (m_PartFile.isOpen())
+        m_PartFile.resize(0);
+    m_Reply       = m_WebCtrl.post(request, parts);
+    connectReply();
 }
 
 void FileDownloader::dataReady()
 {
-    if (m_downloadTemporaryFile.isOpen())
-        m_downloadTemporaryFile.write(m_Reply->readAll());
+    if (m_NotModified)
+        m_Reply->readAll();
+    else if (m_PartFile.isOpen())
+    {
+        if (!writePart(m_Reply->readAll()))
+            m_Reply->abort();
+    }
     else
         m_DownloadedData += m_Reply->readAll();
 }
 
+bool FileDownloader::writePart(const QByteArray &data)
+{
+    if (!m_Decompress)
+        return m_PartFile.write(data) == data.size();
+
+    if (!m_Inflate)
+    {
+        m_Inflate.reset(new z_stream());
+        // 16 + MAX_WBITS: expect a gzip header
+        if (inflateInit2(m_Inflate.get(), 16 + MAX_WBITS) != Z_OK)
+        {
+            m_Inflate.reset();
+            return false;
+        }
+    }
+
+    if (m_InflateDone)
+        return true;
+
+    m_Inflate->next_in  = reinterpret_cast<Bytef *>(const_cast<char *>(data.constData()));
+    m_Inflate->avail_in = static_cast<uInt>(data.size());
+
+    char buffer[65536];
+    while (m_Inflate->avail_in > 0)
+    {
+        m_Inflate->next_out  = reinterpret_cast<Bytef *>(buffer);
+        m_Inflate->avail_out = sizeof(buffer);
+
+        const int rc = inflate(m_Inflate.get(), Z_NO_FLUSH);
+        if (rc != Z_OK && rc != Z_STREAM_END)
+        {
+            qCWarning(KSTARS) << "Failed to decompress" << m_Reply->url() << ":" << rc;
+            return false;
+        }
+
+        const qint64 size = sizeof(buffer) - m_Inflate->avail_out;
+        if (m_PartFile.write(buffer, size) != size)
+            return false;
+
+        if (rc == Z_STREAM_END)
+        {
+            m_InflateDone = true;
+            break;
+        }
+    }
+    return true;
+}
+
+void FileDownloader::closePart(bool remove)
+{
+    if (m_Inflate)
+    {
+        inflateEnd(m_Inflate.get());
+        m_Inflate.reset();
+    }
+    m_InflateDone = false;
+
+    m_PartFile.close();
+    if (remove)
+    {
+        m_PartFile.remove();
+        writeValidators(partFileName(), {});
+    }
+}
+
+bool FileDownloader::commitPart()
+{
+    const QString fileName = m_DownloadedFileURL.toLocalFile();
+    const Validators validators = readValidators(partFileName());
+    if (!replaceFile(partFileName(), fileName))
+    {
+        qCWarning(KSTARS) << "Failed to replace" << fileName;
+        return false;
+    }
+
+    writeValidators(partFileName(), {});
+    writeValidators(fileName, validators);
+    return true;
+}
+
+QString FileDownloader::partFileName() const
+{
+    return m_DownloadedFileURL.toLocalFile() + QLatin1String(".part");
+}
+
 void FileDownloader::dataFinished(QNetworkReply *pReply)
 {
     if (pReply->error() != QNetworkReply::NoError)
@@ -89,27 +299,51 @@ void FileDownloader::dataFinished(QNetworkReply *pReply)
 
     dataReady();
 
+    if (m_NotModified)
+    {
+        qCDebug(KSTARS) << m_DownloadedFileURL.toLocalFile() << "is up to date";
+#ifndef KSTARS_LITE
+        if (progressDialog != nullptr)
+            progressDialog->hide();
+#endif
+        closePart(true);
+        emit unchanged();
+        pReply->deleteLater();
+        return;
+    }
+
     if (m_verifyData(m_DownloadedData) == false)
     {
         emit error(i18n("Data verification failed"));
         pReply->deleteLater();
         return;
     }
-    else if (m_downloadTemporaryFile.isOpen())
+    else if (m_PartFile.isOpen())
     {
-        m_downloadTemporaryFile.flush();
-        m_downloadTemporaryFile.close();
+        const bool complete = !m_Decompress || m_InflateDone;
+        m_PartFile.flush();
+        closePart(false);
+
+        if (!complete)
+        {
+            closePart(true);
+            emit error(i18n("Incomplete compressed data"));
+            pReply->deleteLater();
+            return;
+        }
 
-        if (m_verifyFile(m_downloadTemporaryFile.fileName()) == false)
+        if (m_verifyFile(partFileName()) == false)
         {
+            closePart(true);
             emit error(i18n("File verification failed"));
             pReply->deleteLater();
             return;
         }
-        else
+        else if (commitPart() == false)
         {
-            QFile::remove(m_DownloadedFileURL.toLocalFile());
-            m_downloadTemporaryFile.copy(m_DownloadedFileURL.toLocalFile());
+            emit error(i18n("Failed to write %1", m_DownloadedFileURL.toLocalFile()));
+            pReply->deleteLater();
+            return;
         }
     }
 
@@ -130,16 +364,21 @@ void FileDownloader::slotError()
 
     if (isCancelled)
     {
-        // Remove partially downloaded file, should we download to %tmp first?
-        if (m_downloadTemporaryFile.isOpen())
-        {
-            m_downloadTemporaryFile.close();
-            m_downloadTemporaryFile.remove();
-        }
+        // Remove partially downloaded file
+        if (m_PartFile.isOpen())
+            closePart(true);
         emit canceled();
     }
     else
     {
+        // Keep the partial file, the next download continues it. Unless it can not be
+        // continued, or the range is not satisfiable because the file changed.
+        if (m_PartFile.isOpen())
+        {
+            m_PartFile.flush();
+            if (m_Decompress || m_Reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 416)
+                closePart(true);
+        }
         emit error(m_Reply->errorString());
     }
 }
@@ -171,12 +410,15 @@ bool FileDownloader::setDownloadedFileURL(const QUrl &DownloadedFile)
 
     if (m_DownloadedFileURL.isEmpty() == false)
     {
-        bool rc= m_downloadTemporaryFile.open();
+        // The part file is kept between downloads, so that an interrupted one can be continued
+        m_PartFile.close();
+        m_PartFile.setFileName(partFileName());
+        bool rc = m_PartFile.open(QIODevice::ReadWrite);
 
         if (rc == false)
-            qCWarning(KSTARS) << m_downloadTemporaryFile.errorString();
+            qCWarning(KSTARS) << m_PartFile.errorString();
         else
-            qCDebug(KSTARS) << "Opened" << m_downloadTemporaryFile.fileName() << "to download data into" << DownloadedFile.toLocalFile();
+            qCDebug(KSTARS) << "Opened" << m_PartFile.fileName() << "to download data into" << DownloadedFile.toLocalFile();
 
         return rc;
     }
@@ -14,18 +14,30 @@
 #include <QNetworkRequest>
 #include <QNetworkReply>
 #include <QObject>
-#include <QTemporaryFile>
 
 #include <functional>
+#include <memory>
 
 class QProgressDialog;
-
+struct z_stream_s;
+
+/**
+ * Downloads into memory, or streams into a file when setDownloadedFileURL() is called.
+ *
+ * A file download is written to the destination name with a ".part" suffix and renamed over
+ * the destination once it is complete and verified, so that readers never see a partial file.
+ * The ETag and Last-Modified of the responses are kept next to the files. A GET of a file
+ * that exists is conditional, and a 304 reply emits unchanged() without touching the file.
+ * A partial file left by an interrupted GET is resumed with a range request, when the
+ * server still has the same version of it. With setDecompress(), gzip data is inflated as
+ * it arrives and only the decompressed data is written.
+ */
 class FileDownloader : public QObject
 {
     Q_OBJECT
   public:
     explicit FileDownloader(QObject *parent = nullptr);
-    ~FileDownloader() override = default;
+    ~FileDownloader() override;
 
     void get(const QUrl &fileUrl);
     void post(const QUrl &fileUrl, QByteArray &data);
@@ -36,6 +48,9 @@ class FileDownloader : public QObject
     QUrl getDownloadedFileURL() const;
     bool setDownloadedFileURL(const QUrl &DownloadedFile);
 
+    /** Inflate gzip data while it is written to the downloaded file. Downloads are not resumed then. */
+    void setDecompress(bool decompress) { m_Decompress = decompress; }
+
     void setProgressDialogEnabled(bool ShowProgressDialog, const QString &textTitle = QString(),
                                   const QString &textLabel = QString());
 
@@ -45,6 +60,8 @@ class FileDownloader : public QObject
 
   signals:
     void downloaded();
+    /** The downloaded file is up to date on the server, it was left as it is */
+    void unchanged();
     void canceled();
     void error(const QString &errorString);
     void downloadProgress(qint64 bytesReceived, qint64 bytesTotal);
@@ -52,18 +69,35 @@ class FileDownloader : public QObject
   private slots:
     void dataFinished(QNetworkReply *pReply);
     void dataReady();
+    void metaDataReady();
     void slotError();
     void setDownloadProgress(qint64 bytesReceived, qint64 bytesTotal);
 
   private:
+    void connectReply();
+    /** Write downloaded @p data to the part file, inflated if needed */
+    bool writePart(const QByteArray &data);
+    void closePart(bool remove);
+    /** Replace the destination with the complete part file */
+    bool commitPart();
+
+    QString partFileName() const;
+
     QNetworkAccessManager m_WebCtrl;
     QByteArray m_DownloadedData;
 
     // Downloaded file
     QUrl m_DownloadedFileURL;
 
-    // Temporary file used until download is successful
-    QTemporaryFile m_downloadTemporaryFile;
+    // Partial file used until download is successful
+    QFile m_PartFile;
+    bool m_Resuming { false };
+    bool m_NotModified { false };
+
+    // Streaming gzip decompression
+    bool m_Decompress { false };
+    std::unique_ptr<z_stream_s> m_Inflate;
+    bool m_InflateDone { false };
 
     // Network reply
     QNetworkReply *m_Reply { nullptr };
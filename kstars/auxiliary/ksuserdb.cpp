@@ -32,6 +32,15 @@
 
 KSUserDB::~KSUserDB()
 {
+    // Move the pending changes from the write-ahead log into the database file before backing it up
+    auto db = QSqlDatabase::database(m_ConnectionName, false);
+    if (db.isOpen())
+    {
+        QSqlQuery query(db);
+        if (!query.exec("PRAGMA wal_checkpoint(TRUNCATE)"))
+            qCWarning(KSTARS) << query.lastError();
+    }
+
     // Backup
     QString current_dbfile = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("userdb.sqlite");
     QString backup_dbfile = QDir(KSPaths::writableLocation(
@@ -94,6 +103,9 @@ bool KSUserDB::Initialize()
 
             qCWarning(KSTARS) << "Detected corrupted database. Attempting to recover from backup...";
             QFile::remove(dbfile.filePath());
+            // A write-ahead log left by the corrupted database must not be applied to the backup
+            QFile::remove(dbfile.filePath() + "-wal");
+            QFile::remove(dbfile.filePath() + "-shm");
             QFile::copy(backup_file.filePath(), dbfile.filePath());
             QFile::remove(backup_file.filePath());
             return Initialize();
@@ -105,6 +117,14 @@ bool KSUserDB::Initialize()
         }
     }
 
+    // With a write-ahead log, committing a transaction appends to the log instead of rewriting and
+    // syncing the database file, and readers are not blocked while the GUI saves.
+    {
+        QSqlQuery query(db);
+        if (!query.exec("PRAGMA journal_mode = WAL") || !query.exec("PRAGMA synchronous = NORMAL"))
+            qCWarning(KSTARS) << query.lastError();
+    }
+
     qCDebug(KSTARS) << "Opened the User DB. Ready.";
 
     // Update table if previous version exists
@@ -346,6 +366,14 @@ bool KSUserDB::Initialize()
                         "Thickness INTEGER DEFAULT 1)"))
             qCWarning(KSTARS) << query.lastError();
     }
+
+    // Dark frames are looked up by camera and settings on every capture, see FindDarkFrame()
+    {
+        QSqlQuery query(db);
+        if (!query.exec("CREATE INDEX IF NOT EXISTS darkframe_match ON darkframe "
+                        "(ccd, chip, binX, binY, gain, temperature)"))
+            qCWarning(KSTARS) << query.lastError();
+    }
     return true;
 }
 
@@ -768,6 +796,67 @@ bool KSUserDB::AddDarkFrame(const QVariantMap &oneFrame)
     return true;
 }
 
+/**
+ * @brief KSUserDB::AddDarkFrames Saves several dark frames in one transaction
+ * @param frames Maps with the same keys as for AddDarkFrame.
+ */
+bool KSUserDB::AddDarkFrames(const QList<QVariantMap> &frames)
+{
+    auto db = QSqlDatabase::database(m_ConnectionName);
+    if (!db.isValid())
+    {
+        qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
+        return false;
+    }
+
+    if (!db.transaction())
+    {
+        qCWarning(KSTARS) << db.lastError();
+        return false;
+    }
+
+    // Frames usually all have the same keys, so the insert statement is only prepared again when they change
+    QSqlQuery query(db);
+    QStringList columns;
+    for (const auto &oneFrame : frames)
+    {
+        if (oneFrame.keys() != columns)
+        {
+            columns = oneFrame.keys();
+            QStringList placeholders;
+            for (int i = 0; i < columns.size(); ++i)
+                placeholders << "?";
+
+            if (!query.prepare(QString("INSERT INTO darkframe (%1) VALUES (%2)")
+                               .arg(columns.join(", "), placeholders.join(", "))))
+            {
+                qCWarning(KSTARS) << query.lastError();
+                db.rollback();
+                return false;
+            }
+        }
+
+        for (const auto &value : oneFrame)
+            query.addBindValue(value);
+
+        if (!query.exec())
+        {
+            qCWarning(KSTARS) << query.lastError();
+            db.rollback();
+            return false;
+        }
+    }
+
+    if (!db.commit())
+    {
+        qCWarning(KSTARS) << db.lastError();
+        db.rollback();
+        return false;
+    }
+
+    return true;
+}
+
 /**
  * @brief KSUserDB::UpdateDarkFrame Updates an existing dark frame record in the data, replace all values matching the supplied ID
  * @param oneFrame dark frame to update. The ID should already exist in the database.
@@ -852,6 +941,83 @@ bool KSUserDB::GetAllDarkFrames(QList<QVariantMap> &darkFrames)
     return true;
 }
 
+/**
+ * @brief KSUserDB::FindDarkFrame Finds the dark frame that best matches the capture settings
+ * @param criteria capture settings to match
+ * @param darkFrame filled with the columns of the best dark frame, as in GetAllDarkFrames
+ * @return true if a matching frame was found
+ */
+bool KSUserDB::FindDarkFrame(const DarkFrameCriteria &criteria, QVariantMap &darkFrame)
+{
+    auto db = QSqlDatabase::database(m_ConnectionName);
+    if (!db.isValid())
+    {
+        qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
+        return false;
+    }
+
+    // The conditions are only added when they apply, so that the darkframe_match index covers them
+    QStringList conditions;
+    conditions << "ccd = :ccd" << "chip = :chip" << "binX = :binX" << "binY = :binY";
+    if (criteria.gain >= 0)
+        conditions << "gain = :gain";
+    if (!criteria.iso.isNull())
+        conditions << "IFNULL(iso, '') = :iso";
+    if (criteria.maxTemperatureDiff >= 0)
+        conditions << "(temperature = :invalid OR temperature BETWEEN :minTemperature AND :maxTemperature)";
+    if (criteria.defectMapOnly)
+        conditions << "defectmap IS NOT NULL AND defectmap != ''";
+
+    // Closest duration first, then closest temperature, then the most recent frame
+    QStringList order;
+    order << "ABS(duration - :duration)";
+    if (criteria.rankTemperature)
+        order << "ABS(IFNULL(temperature, 0) - :temperature)";
+    order << "timestamp DESC";
+
+    QSqlQuery query(db);
+    if (!query.prepare(QString("SELECT * FROM darkframe WHERE %1 ORDER BY %2 LIMIT 1")
+                       .arg(conditions.join(" AND "), order.join(", "))))
+    {
+        qCWarning(KSTARS) << query.lastError();
+        return false;
+    }
+
+    query.bindValue(":ccd", criteria.ccd);
+    query.bindValue(":chip", criteria.chip);
+    query.bindValue(":binX", criteria.binX);
+    query.bindValue(":binY", criteria.binY);
+    query.bindValue(":duration", criteria.duration);
+    if (criteria.gain >= 0)
+        query.bindValue(":gain", criteria.gain);
+    if (!criteria.iso.isNull())
+        query.bindValue(":iso", criteria.iso);
+    if (criteria.maxTemperatureDiff >= 0)
+    {
+        query.bindValue(":invalid", criteria.invalidTemperature);
+        query.bindValue(":minTemperature", criteria.temperature - criteria.maxTemperatureDiff);
+        query.bindValue(":maxTemperature", criteria.temperature + criteria.maxTemperatureDiff);
+    }
+    if (criteria.rankTemperature)
+        query.bindValue(":temperature", criteria.temperature);
+
+    if (!query.exec())
+    {
+        qCWarning(KSTARS) << query.lastError();
+        return false;
+    }
+
+    if (!query.next())
+        return false;
+
+    darkFrame.clear();
+    const QSqlRecord record = query.record();
+    for (int i = 0; i < record.count(); i++)
+        darkFrame[record.fieldName(i)] = record.value(i);
+
+    return true;
+}
+
 /* Effective FOV Section */
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1401,6 +1567,52 @@ bool KSUserDB::AddFlag(const QString &ra, const QString &dec, const QString &epo
     return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+///
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool KSUserDB::ReplaceAllFlags(const QList<QStringList> &flagList)
+{
+    auto db = QSqlDatabase::database(m_ConnectionName);
+    if (!db.isValid())
+    {
+        qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
+        return false;
+    }
+
+    if (!db.transaction())
+    {
+        qCWarning(KSTARS) << db.lastError();
+        return false;
+    }
+
+    QSqlQuery query(db);
+    bool success = query.exec("DELETE FROM flags") &&
+                   query.prepare("INSERT INTO flags (RA, Dec, Epoch, Icon, Label, Color) VALUES (?, ?, ?, ?, ?, ?)");
+
+    for (int i = 0; success && i < flagList.size(); ++i)
+    {
+        const QStringList &flagEntry = flagList.at(i);
+        if (flagEntry.size() < 6)
+        {
+            qCWarning(KSTARS) << "Skipping incomplete flag" << flagEntry;
+            continue;
+        }
+
+        for (int j = 0; j < 6; ++j)
+            query.addBindValue(flagEntry.at(j));
+        success = query.exec();
+    }
+
+    if (!success || !db.commit())
+    {
+        qCWarning(KSTARS) << "Failed to save the flags:" << query.lastError() << db.lastError();
+        db.rollback();
+        return false;
+    }
+
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 ///
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -2358,6 +2570,85 @@ bool KSUserDB::AddHorizon(ArtificialHorizonEntity *horizon)
     return true;
 }
 
+bool KSUserDB::ReplaceAllHorizons(const QList<ArtificialHorizonEntity *> &horizonList)
+{
+    auto db = QSqlDatabase::database(m_ConnectionName);
+    if (!db.isValid())
+    {
+        qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
+        return false;
+    }
+
+    if (!db.transaction())
+    {
+        qCWarning(KSTARS) << db.lastError();
+        return false;
+    }
+
+    QSqlQuery query(db);
+    bool success = query.exec("SELECT name FROM horizons");
+
+    QStringList oldTables;
+    while (success && query.next())
+        oldTables << query.value(0).toString();
+
+    for (const auto &tableName : oldTables)
+    {
+        // Old databases may miss some of the point tables, as DeleteAllHorizons() does not fail on them
+        if (!query.exec(QString("DROP TABLE IF EXISTS %1").arg(tableName)))
+        {
+            success = false;
+            break;
+        }
+    }
+
+    success = success && query.exec("DELETE FROM horizons");
+
+    QSqlQuery region(db);
+    success = success && region.prepare("INSERT INTO horizons (name, label, enabled) VALUES (?, ?, ?)");
+
+    for (int i = 0; success && i < horizonList.size(); ++i)
+    {
+        ArtificialHorizonEntity *horizon = horizonList.at(i);
+        const QString tableName = QString("horizon_%1").arg(i + 1);
+
+        int flags = 0;
+        if (horizon->enabled()) flags |= 0x1;
+        if (horizon->ceiling()) flags |= 0x2;
+
+        region.addBindValue(tableName);
+        region.addBindValue(horizon->region());
+        region.addBindValue(flags);
+        success = region.exec() &&
+                  query.exec(QString("CREATE TABLE %1 (Az REAL NOT NULL, Alt REAL NOT NULL)").arg(tableName)) &&
+                  query.prepare(QString("INSERT INTO %1 (Az, Alt) VALUES (?, ?)").arg(tableName));
+
+        if (!success)
+            break;
+
+        for (const auto &item : *horizon->list()->points())
+        {
+            query.addBindValue(item->az().Degrees());
+            query.addBindValue(item->alt().Degrees());
+            if (!query.exec())
+            {
+                success = false;
+                break;
+            }
+        }
+    }
+
+    if (!success || !db.commit())
+    {
+        qCWarning(KSTARS) << "Failed to save the artificial horizons:" << region.lastError() << query.lastError()
+                          << db.lastError();
+        db.rollback();
+        return false;
+    }
+
+    return true;
+}
+
 void KSUserDB::CreateImageOverlayTableIfNecessary()
 {
     auto db = QSqlDatabase::database(m_ConnectionName);
@@ -2460,6 +2751,108 @@ bool KSUserDB::AddImageOverlay(const ImageOverlay &overlay)
     return true;
 }
 
+bool KSUserDB::AddImageOverlays(const QList<ImageOverlay> &overlayList)
+{
+    CreateImageOverlayTableIfNecessary();
+    auto db = QSqlDatabase::database(m_ConnectionName);
+    if (!db.isValid())
+    {
+        qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
+        return false;
+    }
+
+    if (!db.transaction())
+    {
+        qCWarning(KSTARS) << db.lastError();
+        return false;
+    }
+
+    QSqlQuery update(db), insert(db);
+    bool success = update.prepare("UPDATE imageOverlays SET enabled = ?, nickname = ?, status = ?, orientation = ?, "
+                                  "ra = ?, dec = ?, pixelsPerArcsec = ?, eastToTheRight = ?, width = ?, height = ? "
+                                  "WHERE filename = ?") &&
+                   insert.prepare("INSERT INTO imageOverlays (enabled, nickname, status, orientation, ra, dec, "
+                                  "pixelsPerArcsec, eastToTheRight, width, height, filename) "
+                                  "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+
+    for (int i = 0; success && i < overlayList.size(); ++i)
+    {
+        const ImageOverlay &overlay = overlayList.at(i);
+        // Both statements take the same values, in the same order.
+        const QVariantList values =
+        {
+            static_cast<int>(overlay.m_Enabled), overlay.m_Nickname, static_cast<int>(overlay.m_Status),
+            overlay.m_Orientation, overlay.m_RA, overlay.m_DEC, overlay.m_ArcsecPerPixel,
+            static_cast<int>(overlay.m_EastToTheRight), overlay.m_Width, overlay.m_Height, overlay.m_Filename
+        };
+        for (int v = 0; v < values.size(); ++v)
+        {
+            update.bindValue(v, values[v]);
+            insert.bindValue(v, values[v]);
+        }
+        success = update.exec() && (update.numRowsAffected() > 0 || insert.exec());
+    }
+
+    if (!success || !db.commit())
+    {
+        qCWarning(KSTARS) << "Failed to save the image overlays:" << update.lastError() << insert.lastError()
+                          << db.lastError();
+        db.rollback();
+        return false;
+    }
+
+    return true;
+}
+
+bool KSUserDB::ReplaceAllImageOverlays(const QList<ImageOverlay> &overlayList)
+{
+    CreateImageOverlayTableIfNecessary();
+    auto db = QSqlDatabase::database(m_ConnectionName);
+    if (!db.isValid())
+    {
+        qCCritical(KSTARS) << "Failed to open database:" << db.lastError();
+        return false;
+    }
+
+    if (!db.transaction())
+    {
+        qCWarning(KSTARS) << db.lastError();
+        return false;
+    }
+
+    QSqlQuery query(db);
+    bool success = query.exec("DELETE FROM imageOverlays") &&
+                   query.prepare("INSERT INTO imageOverlays (filename, enabled, nickname, status, orientation, ra, dec, "
+                                 "pixelsPerArcsec, eastToTheRight, width, height) "
+                                 "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+
+    for (int i = 0; success && i < overlayList.size(); ++i)
+    {
+        const ImageOverlay &overlay = overlayList.at(i);
+        query.addBindValue(overlay.m_Filename);
+        query.addBindValue(static_cast<int>(overlay.m_Enabled));
+        query.addBindValue(overlay.m_Nickname);
+        query.addBindValue(static_cast<int>(overlay.m_Status));
+        query.addBindValue(overlay.m_Orientation);
+        query.addBindValue(overlay.m_RA);
+        query.addBindValue(overlay.m_DEC);
+        query.addBindValue(overlay.m_ArcsecPerPixel);
+        query.addBindValue(static_cast<int>(overlay.m_EastToTheRight));
+        query.addBindValue(overlay.m_Width);
+        query.addBindValue(overlay.m_Height);
+        success = query.exec();
+    }
+
+    if (!success || !db.commit())
+    {
+        qCWarning(KSTARS) << "Failed to save the image overlays:" << query.lastError() << db.lastError();
+        db.rollback();
+        return false;
+    }
+
+    return true;
+}
+
 bool KSUserDB::GetAllImageOverlays(QList<ImageOverlay> *imageOverlayList)
 {
     CreateImageOverlayTableIfNecessary();
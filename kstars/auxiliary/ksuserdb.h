@@ -76,10 +76,48 @@ class KSUserDB
          ************************************************************************/
 
         bool AddDarkFrame(const QVariantMap &oneFrame);
+        /**
+         * @brief Saves several dark frames in one transaction
+         * @param frames maps as for AddDarkFrame()
+         * @return true if all the frames were saved, false if none was
+         */
+        bool AddDarkFrames(const QList<QVariantMap> &frames);
         bool UpdateDarkFrame(const QVariantMap &oneFrame);
         bool DeleteDarkFrame(const QString &filename);
         bool GetAllDarkFrames(QList<QVariantMap> &darkFrames);
 
+        /** @brief Capture settings a dark frame is matched against, see FindDarkFrame() */
+        struct DarkFrameCriteria
+        {
+            QString ccd;
+            int chip { 0 };
+            int binX { 1 };
+            int binY { 1 };
+            /// Negative to accept any gain
+            int gain { -1 };
+            /// Null to accept any ISO
+            QString iso;
+            double duration { 0 };
+            /// Current sensor temperature
+            double temperature { 0 };
+            /// Frames further than this from the sensor temperature are rejected, negative to accept all
+            double maxTemperatureDiff { -1 };
+            /// Frames stored with this temperature are never rejected by maxTemperatureDiff
+            double invalidTemperature { -1e6 };
+            /// Prefer frames closer to the sensor temperature
+            bool rankTemperature { false };
+            /// Only consider frames with a defect map
+            bool defectMapOnly { false };
+        };
+
+        /**
+         * @brief Returns the dark frame best matching @p criteria with an indexed query.
+         * Frames with the closest duration win, then the ones with the closest temperature
+         * and then the most recent ones.
+         * @return true if a frame matched, false otherwise
+         */
+        bool FindDarkFrame(const DarkFrameCriteria &criteria, QVariantMap &darkFrame);
+
         /************************************************************************
          ******************************* Effective FOVs *************************
          ************************************************************************/
@@ -153,6 +191,12 @@ class KSUserDB
         /** @brief Adds a new artificial horizon row into the database **/
         bool AddHorizon(ArtificialHorizonEntity *horizon);
 
+        /**
+         * @brief Replaces all the artificial horizons in the database with @p horizonList
+         * in one transaction. If it fails, the previous horizons are kept.
+         **/
+        bool ReplaceAllHorizons(const QList<ArtificialHorizonEntity *> &horizonList);
+
         /** @brief Gets all the artificial horizon rows from the database **/
         bool GetAllHorizons(QList<ArtificialHorizonEntity *> &horizonList);
 
@@ -166,6 +210,18 @@ class KSUserDB
         /** @brief Adds a new image overlay row into the database **/
         bool AddImageOverlay(const ImageOverlay &overlay);
 
+        /**
+         * @brief Adds or updates the rows of @p overlayList, matched by filename, in one
+         * transaction. If it fails, none of them are changed.
+         **/
+        bool AddImageOverlays(const QList<ImageOverlay> &overlayList);
+
+        /**
+         * @brief Replaces all the image overlay rows in the database with @p overlayList
+         * in one transaction. If it fails, the previous rows are kept.
+         **/
+        bool ReplaceAllImageOverlays(const QList<ImageOverlay> &overlayList);
+
         /** @brief Gets all the image overlay rows from the database **/
         bool GetAllImageOverlays(QList<ImageOverlay> *imageOverlayList);
 
@@ -206,6 +262,15 @@ class KSUserDB
          **/
         bool AddFlag(const QString &ra, const QString &dec, const QString &epoch, const QString &image_name,
                      const QString &label, const QString &labelColor);
+
+        /**
+         * @brief Replaces all the flags in the database with @p flagList in one transaction.
+         * If it fails, the previous flags are kept.
+         *
+         * @param flagList flags in the same order as returned by GetAllFlags()
+         * @return True if database transaction is successful, false otherwise
+         **/
+        bool ReplaceAllFlags(const QList<QStringList> &flagList);
         /**
          * @brief Returns a QList populated with all stored flags
          * Order: const QString &ra, const QString &dec, const QString &epoch,
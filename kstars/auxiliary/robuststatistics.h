@@ -39,9 +39,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 #include <cmath>
+#include <type_traits>
 #include <QObject>
 #include <QVector>
 
@@ -387,5 +389,119 @@ constexpr double ConvertScaleToWeight(const ScaleCalculation scaleMethod, double
     return -1;
 }
 
+/**
+ * @short Median and median absolute deviation estimated from a histogram of the samples.
+ */
+struct HistogramStatistics
+{
+    double median { 0 };
+    /** Unscaled MAD, i.e. the median of abs(sample - median). Multiply by 1.4826 to estimate a Gaussian sigma. */
+    double mad { 0 };
+    /** Width of the histogram bins. The error of median and MAD is bounded by this value, 1 means exact. */
+    double binWidth { 1 };
+};
+
+/**
+ * @short Estimates median and MAD of integer samples in O(n) using a histogram instead of copying and sorting.
+ *
+ * 8 and 16 bit samples are counted per value, so the results match the sort based estimators exactly.
+ * Wider types are binned into at most maxBins bins spanning the sample range, which bounds the error
+ * of both estimates by the bin width returned in the result.
+ *
+ * @param data The samples.
+ * @param size The number of samples.
+ * @param sampleBy Only consider every sampleBy'th sample.
+ * @param maxBins The maximum number of histogram bins used for samples larger than 16 bit.
+ */
+template<typename Base>
+HistogramStatistics ComputeHistogramStatistics(const Base data[], const size_t size, const size_t sampleBy = 1,
+        const size_t maxBins = 65536)
+{
+    static_assert(std::is_integral<Base>::value, "Histogram statistics are only available for integer samples");
+
+    HistogramStatistics result;
+    if (size == 0 || sampleBy == 0)
+        return result;
+
+    // Range of the histogram. Small types simply use one bin per possible value.
+    double low = std::numeric_limits<Base>::lowest();
+    size_t numBins = size_t(1) << (8 * std::min(sizeof(Base), size_t(2)));
+    if (sizeof(Base) > 2)
+    {
+        Base minValue = data[0], maxValue = data[0];
+        for (size_t i = 0; i < size; i += sampleBy)
+        {
+            minValue = std::min(minValue, data[i]);
+            maxValue = std::max(maxValue, data[i]);
+        }
+        low = minValue;
+        const double range = static_cast<double>(maxValue) - minValue + 1;
+        result.binWidth = std::max(1.0, std::ceil(range / maxBins));
+        numBins = static_cast<size_t>(std::ceil(range / result.binWidth));
+    }
+
+    std::vector<uint32_t> counts(numBins, 0);
+    uint64_t numSamples = 0;
+    for (size_t i = 0; i < size; i += sampleBy, numSamples++)
+        counts[std::min(numBins - 1, static_cast<size_t>((data[i] - low) / result.binWidth))]++;
+
+    // Samples are represented by the center of their bin, which for one value wide bins is the value itself.
+    const double binOffset = low + (result.binWidth - 1) / 2.0;
+    auto const binValue = [&](size_t bin)
+    {
+        return bin * result.binWidth + binOffset;
+    };
+
+    // For an even number of samples the two middle values are averaged, like the sort based median does.
+    const uint64_t lowerRank = (numSamples - 1) / 2, upperRank = numSamples / 2;
+
+    size_t medianBin = 0;
+    double lowerValue = 0;
+    uint64_t accumulator = 0;
+    for (size_t bin = 0; bin < numBins; bin++)
+    {
+        if (accumulator <= lowerRank && lowerRank < accumulator + counts[bin])
+            lowerValue = binValue(bin);
+        accumulator += counts[bin];
+        if (accumulator > upperRank)
+        {
+            result.median = (lowerValue + binValue(bin)) / 2.0;
+            medianBin = bin;
+            break;
+        }
+    }
+
+    // The absolute deviations grow in both directions away from the median, so merge the bins below and
+    // above it in order of increasing deviation until we reach the middle ranks.
+    int64_t below = static_cast<int64_t>(medianBin), above = static_cast<int64_t>(medianBin) + 1;
+    if (binValue(medianBin) > result.median)
+    {
+        below--;
+        above--;
+    }
+    double lowerDeviation = 0;
+    accumulator = 0;
+    while (below >= 0 || above < static_cast<int64_t>(numBins))
+    {
+        const double belowDeviation = below >= 0 ? result.median - binValue(below) : std::numeric_limits<double>::max();
+        const double aboveDeviation = above < static_cast<int64_t>(numBins) ? binValue(above) - result.median :
+                                      std::numeric_limits<double>::max();
+        const bool takeBelow = belowDeviation <= aboveDeviation;
+        const uint32_t count = takeBelow ? counts[below] : counts[above];
+        const double deviation = takeBelow ? belowDeviation : aboveDeviation;
+        takeBelow ? below-- : above++;
+
+        if (accumulator <= lowerRank && lowerRank < accumulator + count)
+            lowerDeviation = deviation;
+        accumulator += count;
+        if (accumulator > upperRank)
+        {
+            result.mad = (lowerDeviation + deviation) / 2.0;
+            break;
+        }
+    }
+
+    return result;
+}
 
 } // namespace Mathematics
@@ -8,6 +8,8 @@
 
 #include "skyobject.h"
 
+#include <algorithm>
+
 SkyObjectListModel::SkyObjectListModel(QObject *parent) : QAbstractListModel(parent)
 {
 }
@@ -23,29 +25,40 @@ QHash<int, QByteArray> SkyObjectListModel::roleNames() const
 
 int SkyObjectListModel::indexOf(const QString &objectName) const
 {
-    for (int i = 0; i < skyObjects.size(); ++i)
+    for (int list = 0; list < skyObjects.size(); ++list)
     {
-        if (skyObjects[i].first == objectName)
+        const SkyObjectList &objects = skyObjects[list];
+        for (int i = 0; i < objects.size(); ++i)
         {
-            return i;
+            if (objects[i].first == objectName)
+            {
+                return m_Offsets[list] + i;
+            }
         }
     }
     return -1;
 }
 
+const QPair<QString, const SkyObject *> &SkyObjectListModel::entry(int row) const
+{
+    // The last list starting at or before row
+    const int list = std::upper_bound(m_Offsets.begin(), m_Offsets.end(), row) - m_Offsets.begin() - 1;
+    return skyObjects[list][row - m_Offsets[list]];
+}
+
 QVariant SkyObjectListModel::data(const QModelIndex &index, int role) const
 {
-    if (!index.isValid())
+    if (!index.isValid() || index.row() >= m_Size)
     {
         return QVariant();
     }
     if (role == Qt::DisplayRole)
     {
-        return QVariant(skyObjects[index.row()].first);
+        return QVariant(entry(index.row()).first);
     }
     else if (role == SkyObjectRole)
     {
-        return QVariant::fromValue((void *)skyObjects[index.row()].second);
+        return QVariant::fromValue((void *)entry(index.row()).second);
     }
     return QVariant();
 }
@@ -54,31 +67,77 @@ QStringList SkyObjectListModel::filter(const QRegExp &regEx)
 {
     QStringList filteredList;
 
-    for (auto &item : skyObjects)
+    for (auto &objects : skyObjects)
+    {
+        for (auto &item : objects)
+        {
+            if (regEx.exactMatch(item.first))
+            {
+                filteredList.append(item.first);
+            }
+        }
+    }
+    return filteredList;
+}
+
+QStringList SkyObjectListModel::startingWith(const QString &prefix) const
+{
+    QStringList filteredList;
+
+    for (auto &objects : skyObjects)
     {
-        if (regEx.exactMatch(item.first))
+        for (auto &item : objects)
         {
-            filteredList.append(item.first);
+            if (item.first.startsWith(prefix, Qt::CaseInsensitive))
+            {
+                filteredList.append(item.first);
+            }
         }
     }
     return filteredList;
 }
 
 void SkyObjectListModel::setSkyObjectsList(QVector<QPair<QString, const SkyObject *>> sObjects)
+{
+    setSkyObjectsLists({ sObjects });
+}
+
+void SkyObjectListModel::setSkyObjectsLists(const QVector<SkyObjectList> &lists)
 {
     beginResetModel();
-    skyObjects = sObjects;
+    skyObjects = lists;
+    updateOffsets();
     endResetModel();
 }
 
+void SkyObjectListModel::updateOffsets()
+{
+    m_Offsets.resize(skyObjects.size());
+    m_Size = 0;
+    for (int list = 0; list < skyObjects.size(); ++list)
+    {
+        m_Offsets[list] = m_Size;
+        m_Size += skyObjects[list].size();
+    }
+}
+
 void SkyObjectListModel::removeSkyObject(SkyObject *object)
 {
-    for (int i = 0; i < skyObjects.size(); ++i)
+    for (int list = 0; list < skyObjects.size(); ++list)
     {
-        if (skyObjects[i].second == object)
+        // Look through a const reference, so that the shared lists are only copied on removal
+        const SkyObjectList &objects = skyObjects.at(list);
+        for (int i = 0; i < objects.size(); ++i)
         {
-            skyObjects.remove(i);
-            return;
+            if (objects[i].second == object)
+            {
+                const int row = m_Offsets[list] + i;
+                beginRemoveRows(QModelIndex(), row, row);
+                skyObjects[list].remove(i);
+                updateOffsets();
+                endRemoveRows();
+                return;
+            }
         }
     }
 }
@@ -31,7 +31,9 @@ class SkyObjectListModel : public QAbstractListModel
 
     explicit SkyObjectListModel(QObject *parent = nullptr);
 
-    int rowCount(const QModelIndex &) const override { return skyObjects.size(); }
+    using SkyObjectList = QVector<QPair<QString, const SkyObject *>>;
+
+    int rowCount(const QModelIndex &) const override { return m_Size; }
     QVariant data(const QModelIndex &index, int role) const override;
 
     QHash<int, QByteArray> roleNames() const override;
@@ -49,11 +51,32 @@ class SkyObjectListModel : public QAbstractListModel
      */
     QStringList filter(const QRegExp &regEx);
 
+    /**
+     * @return the names in the model that start with @p prefix, ignoring case. Cheaper than
+     * filter() for the common case of completing a name.
+     */
+    QStringList startingWith(const QString &prefix) const;
+
     void setSkyObjectsList(QVector<QPair<QString, const SkyObject *>> sObjects);
 
+    /**
+     * @short Show the objects of several lists, one after the other.
+     *
+     * The lists are not concatenated, the model shares them with the components that own them
+     * until one of its objects is removed.
+     */
+    void setSkyObjectsLists(const QVector<SkyObjectList> &lists);
+
   public slots:
     void removeSkyObject(SkyObject *object);
 
   private:
-    QVector<QPair<QString, const SkyObject *>> skyObjects;
+    /** @return the entry at @p row of the concatenated lists */
+    const QPair<QString, const SkyObject *> &entry(int row) const;
+    void updateOffsets();
+
+    QVector<SkyObjectList> skyObjects;
+    /// Row of the first entry of each list
+    QVector<int> m_Offsets;
+    int m_Size { 0 };
 };
@@ -0,0 +1,74 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @short Layout of the aligned star catalog files.
+ *
+ * The aligned format holds the same StarData or DeepStarData records as the original KStars
+ * binary files, but in the byte order of the machine that reads them and at aligned offsets,
+ * so that they can be used straight from a memory mapping. Files are written by the
+ * kstars-starcatalog-compiler tool and read by BinFileHelper. The layout is:
+ *
+ * - the 64 byte StarCatalogHeader
+ * - fieldCount field descriptors (struct dataElement, 16 bytes each)
+ * - indexSize StarCatalogIndexEntry, one per trixel, in trixel order
+ * - padding, then the 5 byte trailer of the original format: faint magnitude (int16_t, in
+ *   hundredths, or thousandths for 16 byte records), HTM level (uint8_t) and maximum stars per
+ *   trixel (uint16_t)
+ * - the records of all the trixels, contiguous and sorted by magnitude in each trixel. They
+ *   start at a multiple of STAR_CATALOG_ALIGNMENT, so every record is aligned to its size.
+ *
+ * The trailer sits right before the records, so the readers of the original format, which read
+ * it at the data offset and then read the records sequentially, work with both formats.
+ *
+ * This header does not depend on Qt, so that the tools in kstars/data/tools can use it.
+ */
+namespace StarCatalogFormat
+{
+/// First bytes of an aligned star catalog file.
+static constexpr char MAGIC[8] = { 'K', 'S', 'S', 'T', 'A', 'R', 'S', 'A' };
+/// Written in native byte order, reads differently on a machine of the other byte order.
+static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+static constexpr uint32_t VERSION         = 1;
+/// Alignment of the header, index table and records, one cache line.
+static constexpr uint32_t STAR_CATALOG_ALIGNMENT = 64;
+static constexpr uint32_t TRAILER_SIZE           = 5;
+
+/// Reserved for compressed blocks of records, not supported by this version.
+static constexpr uint32_t FLAG_COMPRESSED = 0x1;
+
+struct StarCatalogHeader
+{
+    char magic[8];
+    uint32_t byteOrderMark;
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t fieldCount;
+    uint32_t indexSize;
+    uint32_t flags;
+    uint64_t recordCount;
+    /// Offset of the first index table entry
+    uint64_t indexOffset;
+    /// Offset of the trailer, the records start TRAILER_SIZE bytes later
+    uint64_t dataOffset;
+    char reserved[8];
+};
+
+struct StarCatalogIndexEntry
+{
+    /// Offset of the first record of the trixel in the file
+    uint64_t offset;
+    uint32_t count;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(StarCatalogHeader) == STAR_CATALOG_ALIGNMENT, "The header must fill one cache line");
+static_assert(sizeof(StarCatalogIndexEntry) == 16, "Index entries must not be padded");
+}
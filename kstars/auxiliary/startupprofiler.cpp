@@ -0,0 +1,207 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "startupprofiler.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+#include <QTextStream>
+
+#if defined(Q_OS_LINUX)
+#include <unistd.h>
+#elif defined(Q_OS_OSX)
+#include <mach/mach.h>
+#elif defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#endif
+
+#include <kstars_debug.h>
+
+namespace
+{
+QString textLine(const StartupProfiler::Entry &entry)
+{
+    return QString("%1%2: %3 ms, %4 MiB added, %5 MiB resident")
+           .arg(QString(2 * entry.depth, ' '), entry.name)
+           .arg(entry.milliseconds, 0, 'f', 1)
+           .arg(entry.memoryDelta / 1048576.0, 0, 'f', 1)
+           .arg(entry.memory / 1048576.0, 0, 'f', 1);
+}
+}
+
+StartupProfiler::Phase::Phase(const char *name)
+{
+    StartupProfiler::instance().begin(name);
+}
+
+StartupProfiler::Phase::~Phase()
+{
+    StartupProfiler::instance().end();
+}
+
+StartupProfiler &StartupProfiler::instance()
+{
+    static StartupProfiler profiler;
+    return profiler;
+}
+
+StartupProfiler::StartupProfiler()
+{
+    m_Timer.start();
+}
+
+void StartupProfiler::begin(const char *name)
+{
+    if (m_Finished)
+        return;
+
+    Entry entry;
+    entry.name = QString::fromLatin1(name);
+    entry.depth = m_Open.size();
+    entry.start = m_Timer.nsecsElapsed() / 1e6;
+    entry.memory = residentMemory();
+
+    m_Open.append({ m_Entries.size(), entry.start, entry.memory });
+    m_Entries.append(entry);
+}
+
+void StartupProfiler::end()
+{
+    if (m_Open.isEmpty())
+        return;
+
+    const OpenPhase phase = m_Open.takeLast();
+    Entry &entry = m_Entries[phase.index];
+    const qint64 startMemory = entry.memory;
+    entry.milliseconds = m_Timer.nsecsElapsed() / 1e6 - entry.start;
+    entry.memory = residentMemory();
+    entry.memoryDelta = entry.memory - startMemory;
+
+    // The next mark of the enclosing phase starts after this one
+    if (!m_Open.isEmpty())
+    {
+        m_Open.last().lastMark = entry.start + entry.milliseconds;
+        m_Open.last().lastMemory = entry.memory;
+    }
+}
+
+void StartupProfiler::mark(const char *name)
+{
+    if (m_Open.isEmpty())
+        return;
+
+    OpenPhase &phase = m_Open.last();
+    Entry entry;
+    entry.name = QString::fromLatin1(name);
+    entry.depth = m_Open.size();
+    entry.start = phase.lastMark;
+    entry.milliseconds = m_Timer.nsecsElapsed() / 1e6 - phase.lastMark;
+    entry.memory = residentMemory();
+    entry.memoryDelta = entry.memory - phase.lastMemory;
+    m_Entries.append(entry);
+
+    phase.lastMark = entry.start + entry.milliseconds;
+    phase.lastMemory = entry.memory;
+}
+
+void StartupProfiler::finish()
+{
+    if (m_Finished)
+        return;
+
+    Entry total;
+    total.name = QStringLiteral("Startup");
+    total.milliseconds = m_Timer.nsecsElapsed() / 1e6;
+    total.memory = residentMemory();
+    m_Entries.append(total);
+    m_Finished = true;
+
+    if (m_Logging)
+    {
+        qCInfo(KSTARS) << "Startup profile:";
+        for (const Entry &entry : m_Entries)
+            qCInfo(KSTARS) << qPrintable(textLine(entry));
+    }
+}
+
+const StartupProfiler::Entry *StartupProfiler::entry(const QString &name) const
+{
+    for (const Entry &entry : m_Entries)
+    {
+        if (entry.name == name)
+            return &entry;
+    }
+    return nullptr;
+}
+
+QString StartupProfiler::toText() const
+{
+    QStringList lines;
+    for (const Entry &entry : m_Entries)
+        lines.append(textLine(entry));
+    return lines.join('\n');
+}
+
+QString StartupProfiler::toCSV() const
+{
+    QString csv;
+    QTextStream stream(&csv);
+    stream << "phase,depth,start_ms,phase_ms,memory_bytes,memory_delta_bytes\n";
+    for (const Entry &entry : m_Entries)
+        stream << entry.name << ',' << entry.depth << ',' << entry.start << ',' << entry.milliseconds << ','
+               << entry.memory << ',' << entry.memoryDelta << '\n';
+    stream.flush();
+    return csv;
+}
+
+QString StartupProfiler::toJSON() const
+{
+    QJsonArray entries;
+    for (const Entry &entry : m_Entries)
+    {
+        entries.append(QJsonObject
+        {
+            { "name", entry.name },
+            { "depth", entry.depth },
+            { "start", entry.start },
+            { "milliseconds", entry.milliseconds },
+            { "memory", entry.memory },
+            { "memoryDelta", entry.memoryDelta }
+        });
+    }
+    return QString::fromUtf8(QJsonDocument(entries).toJson(QJsonDocument::Compact));
+}
+
+qint64 StartupProfiler::residentMemory()
+{
+#if defined(Q_OS_LINUX)
+    // The second field of statm is the resident set size in pages
+    QFile statm("/proc/self/statm");
+    if (!statm.open(QIODevice::ReadOnly))
+        return 0;
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2)
+        return 0;
+    return fields[1].toLongLong() * sysconf(_SC_PAGESIZE);
+#elif defined(Q_OS_OSX)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+        return 0;
+    return info.resident_size;
+#elif defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return counters.WorkingSetSize;
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,115 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QString>
+
+/**
+ * @class StartupProfiler
+ * Measures the wall time and memory of each phase of the KStars startup.
+ *
+ * A Phase records the time from its construction to its destruction, phases opened while another
+ * one is open are nested in it. A mark inside a phase records the time since the start of the phase
+ * or the previous mark, which suits long sequences such as the components of SkyMapComposite.
+ * Memory is the resident size of the process, where the platform reports it.
+ *
+ * Startup runs in the GUI thread, the profiler is only used from there.
+ */
+class StartupProfiler
+{
+    public:
+        struct Entry
+        {
+            QString name;
+            /// Nesting level, 0 for top level phases
+            int depth { 0 };
+            /// Start of the entry, in milliseconds since the profiler was created
+            double start { 0 };
+            double milliseconds { 0 };
+            /// Resident memory at the end of the entry, in bytes
+            qint64 memory { 0 };
+            /// Resident memory gained during the entry, in bytes
+            qint64 memoryDelta { 0 };
+        };
+
+        /**
+         * @class Phase
+         * Times the scope it lives in as a phase of the startup.
+         */
+        class Phase
+        {
+            public:
+                explicit Phase(const char *name);
+                ~Phase();
+
+            private:
+                Q_DISABLE_COPY(Phase)
+        };
+
+        static StartupProfiler &instance();
+
+        /** @short Record the time since the start of the innermost phase, or its previous mark, as @p name. */
+        void mark(const char *name);
+
+        /**
+         * @short Mark the startup as complete, once the sky map is shown and the deferred data loaded.
+         * The report is logged if enabled with setLogging().
+         */
+        void finish();
+
+        bool isFinished() const
+        {
+            return m_Finished;
+        }
+
+        /** @short Log the report when the startup finishes, set by the --startup-profile option. */
+        void setLogging(bool enabled)
+        {
+            m_Logging = enabled;
+        }
+
+        const QList<Entry> &entries() const
+        {
+            return m_Entries;
+        }
+
+        /** @return the entry named @p name, or nullptr if it was not recorded */
+        const Entry *entry(const QString &name) const;
+
+        /** @return the report as indented text, one line per entry. */
+        QString toText() const;
+
+        /** @return the report as comma separated values, one line per entry. */
+        QString toCSV() const;
+
+        /** @return the report as a JSON array of entries. */
+        QString toJSON() const;
+
+        /** @return the resident memory of the process in bytes, 0 where it is not known. */
+        static qint64 residentMemory();
+
+    private:
+        StartupProfiler();
+
+        void begin(const char *name);
+        void end();
+
+        struct OpenPhase
+        {
+            int index;
+            double lastMark;
+            qint64 lastMemory;
+        };
+
+        QElapsedTimer m_Timer;
+        QList<Entry> m_Entries;
+        QList<OpenPhase> m_Open;
+        bool m_Logging { false };
+        bool m_Finished { false };
+};
@@ -0,0 +1,229 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "tracer.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QThread>
+#include <QVector>
+
+#include <algorithm>
+#include <memory>
+
+std::atomic<bool> Tracer::s_Enabled { false };
+
+namespace
+{
+struct Event
+{
+    const char *category;
+    const char *name;
+    qint64 start;
+    qint64 duration;
+};
+
+// Spans kept per thread, a power of two
+constexpr quint64 BUFFER_SIZE = 4096;
+
+// Pool threads come and go, the buffers of this many finished threads are kept for the export
+constexpr int MAX_FINISHED_BUFFERS = 32;
+
+struct ThreadBuffer
+{
+    int id { 0 };
+    QString name;
+    std::atomic<bool> finished { false };
+    // Only the thread of the buffer writes events and the count. The export copies the events
+    // and drops those that may have been overwritten meanwhile.
+    std::atomic<quint64> written { 0 };
+    Event events[BUFFER_SIZE];
+};
+
+struct Registry
+{
+    QMutex mutex;
+    QList<std::shared_ptr<ThreadBuffer>> buffers;
+    int nextId { 1 };
+};
+
+Registry &registry()
+{
+    static Registry registry;
+    return registry;
+}
+
+const QElapsedTimer &traceClock()
+{
+    static const QElapsedTimer timer = []()
+    {
+        QElapsedTimer timer;
+        timer.start();
+        return timer;
+    }();
+    return timer;
+}
+
+// Spans that started before the last clear are not exported
+std::atomic<qint64> clearTime { 0 };
+
+// Holds the buffer of a thread, and marks it finished when the thread ends
+struct LocalBuffer
+{
+    std::shared_ptr<ThreadBuffer> buffer;
+
+    ~LocalBuffer()
+    {
+        if (buffer)
+            buffer->finished = true;
+    }
+};
+
+ThreadBuffer &threadBuffer()
+{
+    thread_local LocalBuffer local;
+    if (local.buffer)
+        return *local.buffer;
+
+    auto buffer = std::make_shared<ThreadBuffer>();
+    QThread *thread = QThread::currentThread();
+    buffer->name = thread->objectName();
+
+    Registry &reg = registry();
+    QMutexLocker lock(&reg.mutex);
+    buffer->id = reg.nextId++;
+    if (buffer->name.isEmpty())
+    {
+        const bool isMain = QCoreApplication::instance() && thread == QCoreApplication::instance()->thread();
+        buffer->name = isMain ? QString("Main") : QString("Thread %1").arg(buffer->id);
+    }
+
+    int finished = std::count_if(reg.buffers.cbegin(), reg.buffers.cend(), [](const std::shared_ptr<ThreadBuffer> &b)
+    {
+        return b->finished.load();
+    });
+    for (auto it = reg.buffers.begin(); it != reg.buffers.end() && finished > MAX_FINISHED_BUFFERS;)
+    {
+        if ((*it)->finished)
+        {
+            it = reg.buffers.erase(it);
+            --finished;
+        }
+        else
+            ++it;
+    }
+
+    reg.buffers.append(buffer);
+    local.buffer = buffer;
+    return *buffer;
+}
+}
+
+void Tracer::setEnabled(bool enabled)
+{
+    s_Enabled = enabled;
+}
+
+qint64 Tracer::now()
+{
+    return traceClock().nsecsElapsed();
+}
+
+void Tracer::record(const char *category, const char *name, qint64 start)
+{
+    if (!isEnabled())
+        return;
+
+    const qint64 end = now();
+    ThreadBuffer &buffer = threadBuffer();
+    const quint64 count = buffer.written.load(std::memory_order_relaxed);
+    buffer.events[count & (BUFFER_SIZE - 1)] = { category, name, start, end - start };
+    buffer.written.store(count + 1, std::memory_order_release);
+}
+
+void Tracer::clear()
+{
+    clearTime = now();
+}
+
+QByteArray Tracer::toChromeJSON()
+{
+    QList<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        Registry &reg = registry();
+        QMutexLocker lock(&reg.mutex);
+        buffers = reg.buffers;
+    }
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    const qint64 cleared = clearTime;
+
+    QJsonArray events;
+    events.append(QJsonObject
+    {
+        { "name", "process_name" },
+        { "ph", "M" },
+        { "pid", pid },
+        { "args", QJsonObject{ { "name", QCoreApplication::applicationName() } } }
+    });
+
+    for (const auto &buffer : buffers)
+    {
+        events.append(QJsonObject
+        {
+            { "name", "thread_name" },
+            { "ph", "M" },
+            { "pid", pid },
+            { "tid", buffer->id },
+            { "args", QJsonObject{ { "name", buffer->name } } }
+        });
+
+        const quint64 end = buffer->written.load(std::memory_order_acquire);
+        const quint64 begin = end > BUFFER_SIZE ? end - BUFFER_SIZE : 0;
+        QVector<Event> copy;
+        copy.reserve(end - begin);
+        for (quint64 i = begin; i < end; ++i)
+            copy.append(buffer->events[i & (BUFFER_SIZE - 1)]);
+
+        // The spans written during the copy overwrote the oldest ones
+        const quint64 after = buffer->written.load(std::memory_order_acquire);
+        const quint64 valid = after > BUFFER_SIZE ? after - BUFFER_SIZE : 0;
+
+        for (quint64 i = std::max(begin, valid); i < end; ++i)
+        {
+            const Event &event = copy[i - begin];
+            if (event.start < cleared)
+                continue;
+
+            events.append(QJsonObject
+            {
+                { "name", event.name },
+                { "cat", event.category },
+                { "ph", "X" },
+                { "ts", event.start / 1000.0 },
+                { "dur", event.duration / 1000.0 },
+                { "pid", pid },
+                { "tid", buffer->id }
+            });
+        }
+    }
+
+    return QJsonDocument(QJsonObject{ { "traceEvents", events }, { "displayTimeUnit", "ms" } }).toJson(QJsonDocument::Compact);
+}
+
+bool Tracer::exportTrace(const QString &filename)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    return file.write(toChromeJSON()) >= 0;
+}
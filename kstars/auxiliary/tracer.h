@@ -0,0 +1,91 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+
+#include <atomic>
+
+/**
+ * @class Tracer
+ * Records timed spans of the Ekos pipelines, for a timeline of every frame across the modules and threads.
+ *
+ * A span is the time of a scope, opened with KSTARS_TRACE_SPAN, or recorded afterwards from a start time
+ * taken with now() for work that ends in a callback, such as a solve. Each thread writes its spans into
+ * a ring buffer of its own without locking, so the oldest spans are overwritten once it is full. Tracing
+ * is off by default, and a span then costs a single atomic load.
+ *
+ * The spans of all the threads are exported in the Chrome trace event format, which is read by Perfetto
+ * and chrome://tracing.
+ *
+ * Names and categories are not copied, they must be string literals.
+ */
+class Tracer
+{
+    public:
+        /**
+         * @class Span
+         * Records the scope it lives in as a span, if tracing is enabled when it is opened.
+         */
+        class Span
+        {
+            public:
+                Span(const char *category, const char *name)
+                    : m_Category(category), m_Name(name), m_Start(isEnabled() ? now() : -1)
+                {
+                }
+                ~Span()
+                {
+                    if (m_Start >= 0)
+                        record(m_Category, m_Name, m_Start);
+                }
+
+            private:
+                Q_DISABLE_COPY(Span)
+
+                const char *m_Category;
+                const char *m_Name;
+                qint64 m_Start;
+        };
+
+        static bool isEnabled()
+        {
+            return s_Enabled.load(std::memory_order_relaxed);
+        }
+
+        /** @short Start or stop recording spans, set from the Logs options. */
+        static void setEnabled(bool enabled);
+
+        /** @return the time in nanoseconds on the clock of the spans */
+        static qint64 now();
+
+        /**
+         * @short Record a span of the current thread that started at @p start, as returned by now(), and ends now.
+         * Nothing is recorded if tracing is disabled.
+         */
+        static void record(const char *category, const char *name, qint64 start);
+
+        /** @short Drop the spans of all the threads. */
+        static void clear();
+
+        /** @return the spans of all the threads as a Chrome trace event JSON document */
+        static QByteArray toChromeJSON();
+
+        /** @short Write the spans to @p filename, false if it can not be written. */
+        static bool exportTrace(const QString &filename);
+
+    private:
+        static std::atomic<bool> s_Enabled;
+};
+
+#define KSTARS_TRACE_CONCAT_(a, b) a##b
+#define KSTARS_TRACE_CONCAT(a, b) KSTARS_TRACE_CONCAT_(a, b)
+
+/** @short Record the enclosing scope as a span named @p name in @p category. */
+#define KSTARS_TRACE_SPAN(category, name) Tracer::Span KSTARS_TRACE_CONCAT(traceSpan, __LINE__)(category, name)
@@ -10,8 +10,6 @@
 #include "dialogs/timedialog.h"
 #include "ksnotification.h"
 
-#include <QtConcurrent>
-
 #ifndef KSTARS_LITE
 #include "kstars.h"
 #endif
@@ -33,10 +31,36 @@
 #include "skymap.h"
 #include "kspaths.h"
 #include "fov.h"
+#include "auxiliary/executors.h"
 
 #include <QUuid>
-#include <sys/stat.h>
 #include <QInputDialog>
+#include <QCache>
+#include <QThread>
+
+#include <algorithm>
+
+namespace
+{
+// The memory for rendered frames of all the viewers, in KB
+constexpr int FrameCacheSize = 256 * 1024;
+
+/**
+ * Frames are keyed by the xplanet arguments without the output file, which hold the object,
+ * the origin, the time, the field of view and all the options.
+ */
+QCache<QString, QImage> &frameCache()
+{
+    static QCache<QString, QImage> cache(FrameCacheSize);
+    return cache;
+}
+
+// The most xplanet processes that run at once for a viewer
+int maxRenders()
+{
+    return qBound(1, QThread::idealThreadCount() - 1, 4);
+}
+}
 
 typedef enum
 {
@@ -498,14 +522,6 @@ XPlanetImageViewer::XPlanetImageViewer(const QString &obj, QWidget *parent): QDi
     m_Caption->setPalette(p);
     m_View->setPalette(p);
 
-#ifndef Q_OS_WIN
-    if(Options::xplanetUseFIFO())
-    {
-        connect(&watcherTimeout, SIGNAL(timeout()), &fifoImageLoadWatcher, SLOT(cancel()));
-        connect(&fifoImageLoadWatcher, SIGNAL(finished()), this, SLOT(showImage()));
-    }
-#endif
-
 
 #ifdef Q_OS_OSX
     QList<QPushButton *> qButtons = findChildren<QPushButton *>();
@@ -518,18 +534,13 @@ XPlanetImageViewer::XPlanetImageViewer(const QString &obj, QWidget *parent): QDi
 
 XPlanetImageViewer::~XPlanetImageViewer()
 {
+    for (const QString &key : m_Renders.keys())
+        cancelRender(key);
     QApplication::restoreOverrideCursor();
 }
 
-void XPlanetImageViewer::startXplanet()
+QString XPlanetImageViewer::xplanetProgram() const
 {
-    if(m_XPlanetRunning)
-        return;
-
-    //This means something failed in the file output
-    if(!setupOutputFile())
-        return;
-
     QString xPlanetLocation = Options::xplanetPath();
 #ifdef Q_OS_OSX
     if (Options::xplanetIsInternal())
@@ -540,7 +551,7 @@ void XPlanetImageViewer::startXplanet()
     if (xPlanetLocation.isEmpty())
     {
         KSNotification::error(i18n("Xplanet binary path is empty in config panel."));
-        return;
+        return QString();
     }
 
     // If Options::xplanetPath() does not exist, return
@@ -548,19 +559,23 @@ void XPlanetImageViewer::startXplanet()
     if (!xPlanetLocationInfo.exists() || !xPlanetLocationInfo.isExecutable())
     {
         KSNotification::error(i18n("The configured Xplanet binary does not exist or is not executable."));
-        return;
+        return QString();
     }
+    return xPlanetLocation;
+}
 
-    // Create xplanet process
-    QProcess *xplanetProc = new QProcess(this);
+QStringList XPlanetImageViewer::xplanetArguments(const QString &program, const QString &date) const
+{
+#ifndef Q_OS_WIN
+    Q_UNUSED(program)
+#endif
 
-    // Add some options
     QStringList args;
 
     //This specifies the object to be viewed
     args << "-body" << m_ObjectName.toLower();
     //This is the date and time requested
-    args << "-date" << m_Date;
+    args << "-date" << date;
     //This is the glare from the sun
     args << "-glare" << Options::xplanetGlare();
     args << "-base_magnitude" << Options::xplanetMagnitude();
@@ -583,8 +598,6 @@ void XPlanetImageViewer::startXplanet()
         args << "-starmap" << Options::xplanetStarmapPath();
     if (Options::xplanetArcFile())
         args << "-arc_file" << Options::xplanetArcFilePath();
-    if (!m_File.fileName().isEmpty())
-        args << "-output" << m_File.fileName() << "-quality" << Options::xplanetQuality();
 
     // Labels
     if (Options::xplanetLabel())
@@ -714,92 +727,188 @@ void XPlanetImageViewer::startXplanet()
 #endif
 
 #ifdef Q_OS_WIN
-    QString searchDir = xPlanetLocationInfo.dir().absolutePath() + QDir::separator() + "xplanet";
+    QString searchDir = QFileInfo(program).dir().absolutePath() + QDir::separator() + "xplanet";
     args << "-searchdir" << searchDir;
 #endif
 
     //This prevents it from running forever.
     args << "-num_times" << "1";
 
-    m_XPlanetRunning = true;
-    m_ImageLoadSucceeded = false; //This will be set to true if it works.
-    uint32_t timeout = Options::xplanetTimeout();
+    return args;
+}
+
+void XPlanetImageViewer::startXplanet()
+{
+    const QString program = xplanetProgram();
+    if (program.isEmpty())
+        return;
 
-    //FIFO files don't work on windows
-#ifndef Q_OS_WIN
-    if(Options::xplanetUseFIFO())
-    {
-        fifoImageLoadWatcher.setFuture(QtConcurrent::run(this, &XPlanetImageViewer::loadImage));
-        watcherTimeout.setSingleShot(true);
-        watcherTimeout.start(timeout);
-    }
-#endif
+    const QStringList args = xplanetArguments(program, m_Date);
+    const QString key = args.join(' ');
 
-    xplanetProc->start(xPlanetLocation, args);
+    // A random position is drawn again on every render
+    if (m_CurrentObjectIndex == m_CurrentOriginIndex && Options::xplanetRandom())
+        frameCache().remove(key);
 
-    //Uncomment to print the XPlanet commands to the console
-    // qDebug() << Q_FUNC_INFO << "Run:" << xplanetProc->program() << args.join(" ");
+    if(m_FOV == 0)
+        m_WantedCaption = i18n("XPlanet View: %1 from %2 on %3", m_ObjectName, m_OriginName, m_DateText);
+    else
+        m_WantedCaption = i18n("XPlanet View: %1 from %2 on %3 at FOV: %4 deg", m_ObjectName, m_OriginName, m_DateText, m_FOV);
+
+    // The next time steps are rendered ahead, as many as run at once while animating, and the
+    // steps on both sides otherwise, for scrubbing the time.
+    QList<Render> renders { { key, program, args } };
+    const int timeShift = m_TimeEdit->value();
+    const bool animating = m_XPlanetTimer->isActive();
+    QList<int> steps;
+    for (int step = 1; step <= (animating ? maxRenders() : 1); ++step)
+        steps << timeShift + step;
+    if (!animating)
+        steps << timeShift - 1;
+    for (int step : steps)
+    {
+        const QStringList stepArgs = xplanetArguments(program, xplanetDate(shiftedXPlanetTime(step)));
+        renders.append({ stepArgs.join(' '), program, stepArgs });
+    }
 
-    bool XPlanetSucceeded = xplanetProc->waitForFinished(timeout);
-    m_XPlanetRunning = false;
-    xplanetProc->kill(); //In case it timed out
-    xplanetProc->deleteLater();
-    if(XPlanetSucceeded)
+    // Renders of frames that are no longer wanted are stopped
+    QSet<QString> wanted;
+    for (const Render &render : renders)
+        wanted.insert(render.key);
+    for (const QString &running : m_Renders.keys())
     {
-        if(m_FOV == 0)
-            m_Caption->setText(i18n("XPlanet View: %1 from %2 on %3", m_ObjectName, m_OriginName, m_DateText));
-        else
-            m_Caption->setText(i18n("XPlanet View: %1 from %2 on %3 at FOV: %4 deg", m_ObjectName, m_OriginName, m_DateText, m_FOV));
-#ifdef Q_OS_WIN
-        loadImage(); //This will also set imageLoadSucceeded based on whether it worked.
-#else
-        if(Options::xplanetUseFIFO())
-            return;  //The loading of the image is handled with the watcher
-        else
-            loadImage(); //This will also set imageLoadSucceeded based on whether it worked.
-#endif
+        if (!wanted.contains(running))
+            cancelRender(running);
+    }
 
-        if(m_ImageLoadSucceeded)
-            showImage();
-        else
-        {
-            KSNotification::error(i18n("Loading of the image of object %1 failed.", m_ObjectName));
-        }
+    m_RenderQueue.clear();
+    for (const Render &render : renders)
+    {
+        if (!frameCache().contains(render.key) && !m_Renders.contains(render.key) && !m_Loading.contains(render.key))
+            m_RenderQueue.append(render);
     }
+
+    if (const QImage *frame = frameCache().object(key))
+        showFrame(*frame);
     else
     {
-        KStars::Instance()->statusBar()->showMessage(i18n("XPlanet failed to generate the image for object %1 before the timeout expired.", m_ObjectName));
-#ifndef Q_OS_WIN
-        if(Options::xplanetUseFIFO())
-            fifoImageLoadWatcher.cancel();
-#endif
+        m_WantedKey = key;
+        m_XPlanetRunning = true;
+        m_ImageLoadSucceeded = false; //This will be set to true if it works.
     }
+
+    startRenders();
 }
 
-bool XPlanetImageViewer::setupOutputFile()
+void XPlanetImageViewer::startRenders()
 {
-#ifndef Q_OS_WIN
-    if(Options::xplanetUseFIFO())
+    while (m_Renders.size() < maxRenders() && !m_RenderQueue.isEmpty())
     {
-        if(m_File.fileName().contains("xplanetfifo") && m_File.exists())
-            return true;
+        const Render render = m_RenderQueue.takeFirst();
+
+        // Every render writes a file of its own, that is removed once it is loaded
         QDir kstarsTempDir(KSPaths::writableLocation(QStandardPaths::TempLocation) + QDir::separator() + qAppName());
         kstarsTempDir.mkpath(".");
-        m_File.setFileName(kstarsTempDir.filePath(QString("xplanetfifo%1.png").arg(QUuid::createUuid().toString().mid(1, 8)).toLatin1()));
-        if (mkfifo(m_File.fileName().toLatin1(), S_IRUSR | S_IWUSR) < 0)
+        const QString fileName = kstarsTempDir.filePath(QString("xplanet%1.png").arg(QUuid::createUuid().toString().mid(1, 8)));
+
+        QProcess *xplanetProc = new QProcess(this);
+        m_Renders.insert(render.key, { xplanetProc, fileName });
+
+        connect(xplanetProc, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), xplanetProc, &QObject::deleteLater);
+        connect(xplanetProc, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this,
+                [this, key = render.key](int exitCode, QProcess::ExitStatus exitStatus)
+        {
+            finishRender(key, exitStatus == QProcess::NormalExit && exitCode == 0);
+        });
+        connect(xplanetProc, &QProcess::errorOccurred, this, [this, xplanetProc, key = render.key](QProcess::ProcessError error)
         {
-            KSNotification::error(i18n("Error making FIFO file %1: %2.", m_File.fileName(), strerror(errno)));
-            return false;
+            if (error == QProcess::FailedToStart)
+            {
+                xplanetProc->deleteLater();
+                finishRender(key, false);
+            }
+        });
+
+        //This prevents it from running forever.
+        QTimer::singleShot(Options::xplanetTimeout(), xplanetProc, [xplanetProc]()
+        {
+            xplanetProc->kill();
+        });
+
+        xplanetProc->start(render.program, QStringList(render.args) << "-output" << fileName << "-quality" << Options::xplanetQuality());
+
+        //Uncomment to print the XPlanet commands to the console
+        // qDebug() << Q_FUNC_INFO << "Run:" << xplanetProc->program() << xplanetProc->arguments().join(" ");
+    }
+}
+
+void XPlanetImageViewer::finishRender(const QString &key, bool succeeded)
+{
+    if (!m_Renders.contains(key))
+        return;
+
+    const QString fileName = m_Renders.take(key).fileName;
+    if (succeeded)
+    {
+        // The frame is decoded away from the GUI thread, it is shown if it is still wanted
+        m_Loading.insert(key);
+        QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>(this);
+        connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, key]()
+        {
+            const QImage frame = watcher->result();
+            watcher->deleteLater();
+            m_Loading.remove(key);
+            if (!frame.isNull())
+                frameCache().insert(key, new QImage(frame), std::max<int>(1, frame.sizeInBytes() / 1024));
+
+            if (key != m_WantedKey)
+                return;
+            if (frame.isNull())
+            {
+                m_WantedKey.clear();
+                m_XPlanetRunning = false;
+                KSNotification::error(i18n("Loading of the image of object %1 failed.", m_ObjectName));
+            }
+            else
+                showFrame(frame);
+        });
+        watcher->setFuture(Executors::run(Executors::Interactive, [fileName]()
+        {
+            const QImage frame(fileName);
+            QFile::remove(fileName);
+            return frame;
+        }));
+    }
+    else
+    {
+        QFile::remove(fileName);
+        if (key == m_WantedKey)
+        {
+            m_WantedKey.clear();
+            m_XPlanetRunning = false;
+            KStars::Instance()->statusBar()->showMessage(i18n("XPlanet failed to generate the image for object %1 before the timeout expired.", m_ObjectName));
         }
-        return true;
     }
-#endif
 
-    //If the user is using windows or has not selected to use FIFO, it uses files in the KStars data directory.
-    QDir xPlanetDirPath(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + QDir::separator() + "xplanet");
-    xPlanetDirPath.mkpath(".");
-    m_File.setFileName(xPlanetDirPath.filePath(m_ObjectName + ".png"));
-    return true;
+    startRenders();
+}
+
+void XPlanetImageViewer::cancelRender(const QString &key)
+{
+    const RunningRender render = m_Renders.take(key);
+    disconnect(render.process, nullptr, this, nullptr);
+    render.process->kill();
+    QFile::remove(render.fileName);
+}
+
+void XPlanetImageViewer::showFrame(const QImage &frame)
+{
+    m_WantedKey.clear();
+    m_XPlanetRunning = false;
+    m_ImageLoadSucceeded = true;
+    m_Caption->setText(m_WantedCaption);
+    m_Image = frame;
+    showImage();
 }
 
 void XPlanetImageViewer::zoomInXPlanetFOV()
@@ -842,9 +951,8 @@ void XPlanetImageViewer::updatePositionDisplay()
     m_PositionDisplay->setText(i18n("%1, %2, %3", QString::number(m_lat), QString::number(m_lon), QString::number(m_Radius)));
 }
 
-void XPlanetImageViewer::updateXPlanetTime(int timeShift)
+KStarsDateTime XPlanetImageViewer::shiftedXPlanetTime(int timeShift) const
 {
-
     KStarsDateTime shiftedXPlanetTime;
     switch(m_CurrentTimeUnitIndex)
     {
@@ -873,6 +981,12 @@ void XPlanetImageViewer::updateXPlanetTime(int timeShift)
             break;
     }
 
+    return shiftedXPlanetTime;
+}
+
+void XPlanetImageViewer::updateXPlanetTime(int timeShift)
+{
+    const KStarsDateTime shiftedXPlanetTime = this->shiftedXPlanetTime(timeShift);
     setXPlanetDate(shiftedXPlanetTime);
     m_DateText = i18n("%1, %2", shiftedXPlanetTime.date().toString(), shiftedXPlanetTime.time().toString());
     if(m_TimeEdit->value() != timeShift)
@@ -977,14 +1091,19 @@ void XPlanetImageViewer::updateStates()
 }
 
 void XPlanetImageViewer::setXPlanetDate(KStarsDateTime time)
+{
+    m_Date = xplanetDate(time);
+}
+
+QString XPlanetImageViewer::xplanetDate(const KStarsDateTime &time) const
 {
     //Note Xplanet uses UT time for everything but we want the labels to all be LT
     KStarsDateTime utTime = KStarsData::Instance()->geo()->LTtoUT(time);
-    m_Date = utTime.toString(Qt::ISODate)
-             .replace("-", QString(""))
-             .replace("T", ".")
-             .replace(":", QString(""))
-             .replace("Z", QString(""));
+    return utTime.toString(Qt::ISODate)
+           .replace("-", QString(""))
+           .replace("T", ".")
+           .replace(":", QString(""))
+           .replace("Z", QString(""));
 }
 
 void XPlanetImageViewer::updateXPlanetTimeUnits(int units)
@@ -1072,10 +1191,6 @@ void XPlanetImageViewer::toggleXPlanetRun()
     if(m_XPlanetTimer->isActive())
     {
         m_XPlanetTimer->stop();
-#ifndef Q_OS_WIN
-        if(Options::xplanetUseFIFO())
-            fifoImageLoadWatcher.cancel();
-#endif
     }
     else
     {
@@ -1143,23 +1258,6 @@ void XPlanetImageViewer::invertXPlanetRotation()
     m_RotateEdit->setValue(180);
 }
 
-bool XPlanetImageViewer::loadImage()
-{
-#ifndef KSTARS_LITE
-
-    if (!m_Image.load(m_File.fileName()))
-    {
-        m_ImageLoadSucceeded = false;
-        return false;
-    }
-    m_ImageLoadSucceeded = true;
-    return true;
-#else
-    imageLoadSucceeded = false;
-    return false;
-#endif
-}
-
 bool XPlanetImageViewer::showImage()
 {
 #ifndef KSTARS_LITE
@@ -14,7 +14,6 @@
 #include <QSpinBox>
 #include "nonlineardoublespinbox.h"
 #include <QComboBox>
-#include <QFile>
 #include <QFrame>
 #include <QImage>
 #include <QPixmap>
@@ -22,10 +21,8 @@
 #include <QEvent>
 #include <QGestureEvent>
 #include <QPinchGesture>
-
-#ifndef Q_OS_WIN
-#include<QFutureWatcher>
-#endif
+#include <QProcess>
+#include <QSet>
 
 
 class QLabel;
@@ -106,26 +103,43 @@ class XPlanetImageViewer : public QDialog
     ~XPlanetImageViewer() override;
 
     /**
-     * @brief loadImage Load image and display it
-     * @return True if opened and displayed, false otherwise
+     * @brief startXplanet Show the frame of the current settings, from the cache or once
+     * xplanet has rendered it, and render the frames of the next time steps ahead.
      */
-    bool loadImage();
-
     void startXplanet();
 
   private:
-
-
-    /** prepares the output file**/
-    bool setupOutputFile();
+    /** A frame to render, keyed by its arguments without the output file */
+    struct Render
+    {
+        QString key;
+        QString program;
+        QStringList args;
+    };
+
+    struct RunningRender
+    {
+        QProcess *process { nullptr };
+        QString fileName;
+    };
+
+    /** @return the xplanet binary, or an empty string after telling the user what is wrong */
+    QString xplanetProgram() const;
+
+    /** @return the xplanet arguments of the current settings at @p date, without the output file */
+    QStringList xplanetArguments(const QString &program, const QString &date) const;
+
+    /** Start the queued renders, as long as fewer than the limit are running */
+    void startRenders();
+    void finishRender(const QString &key, bool succeeded);
+    void cancelRender(const QString &key);
+    void showFrame(const QImage &frame);
 
     QImage m_Image;
 
     /** Save the downloaded image to a local file. */
     void saveFile(const QString & fileName);
 
-    QFile m_File;
-
     XPlanetImageLabel *m_View { nullptr };
     QLabel *m_Caption { nullptr };
 
@@ -137,6 +151,8 @@ class XPlanetImageViewer : public QDialog
     typedef enum { YEARS, MONTHS, DAYS, HOURS, MINS, SECS } timeUnits;
 
     void setXPlanetDate(KStarsDateTime time);
+    QString xplanetDate(const KStarsDateTime &time) const;
+    KStarsDateTime shiftedXPlanetTime(int timeShift) const;
 
     //XPlanet strings
     QString m_ObjectName;
@@ -155,10 +171,12 @@ class XPlanetImageViewer : public QDialog
     double m_lon { 0 };
     QPoint center;
 
-#ifndef Q_OS_WIN
-    QFutureWatcher<bool> fifoImageLoadWatcher;
-    QTimer watcherTimeout;
-#endif
+    // Rendering
+    QString m_WantedKey;
+    QString m_WantedCaption;
+    QList<Render> m_RenderQueue;
+    QHash<QString, RunningRender> m_Renders;
+    QSet<QString> m_Loading;
 
     // Time
     KStarsDateTime m_XPlanetTime {};
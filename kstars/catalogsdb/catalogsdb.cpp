@@ -6,10 +6,13 @@
 
 #include <limits>
 #include <cmath>
+#include <numeric>
 #include <QSqlDriver>
 #include <QSqlRecord>
 #include <QMutexLocker>
+#include <QCoreApplication>
 #include <QTemporaryDir>
+#include <QRegularExpression>
 #include <qsqldatabase.h>
 #include "cachingdms.h"
 #include "catalogsdb.h"
@@ -17,7 +20,9 @@
 #include "skymesh.h"
 #include "Options.h"
 #include "final_action.h"
+#include "qtskipemptyparts.h"
 #include "sqlstatements.cpp"
+#include "auxiliary/executors.h"
 
 using namespace CatalogsDB;
 
@@ -77,10 +82,13 @@ std::pair<bool, QString> migrate_db(const int version, QSqlDatabase &db,
     return { true, "" };
 }
 
-DBManager::DBManager(const QString &filename) : m_db_file(filename)
+DBManager::DBManager(const QString &filename, const bool read_only)
+    : m_db_file(filename), m_read_only(read_only)
 {
     m_db = QSqlDatabase::addDatabase("QSQLITE", QUuid::createUuid().toString());
     m_db.setDatabaseName(m_db_file);
+    if (m_read_only)
+        m_db.setConnectOptions("QSQLITE_OPEN_READONLY");
 
     // we are throwing here, because errors at this stage should be fatal
     if (!m_db.open())
@@ -89,10 +97,25 @@ DBManager::DBManager(const QString &filename) : m_db_file(filename)
                             DatabaseError::ErrorType::OPEN, m_db.lastError());
     }
 
+    if (!m_read_only)
+    {
+        // may fail for databases in memory, where it does not matter
+        QSqlQuery wal{ m_db };
+        wal.exec(SqlStatements::enable_wal);
+    }
+
     bool init                                    = false;
     std::tie(m_db_version, m_htmesh_level, init) = get_db_meta();
 
-    if (!init && m_db_version > 0 && m_db_version < SqlStatements::current_db_version)
+    const bool needs_migration =
+        !init && m_db_version > 0 && m_db_version < SqlStatements::current_db_version;
+    if (m_read_only && (init || needs_migration))
+        throw DatabaseError(QString("The database '%1' has to be initialized or upgraded "
+                                    "and can't be opened read only.")
+                            .arg(m_db_file),
+                            DatabaseError::ErrorType::VERSION, QSqlError{});
+
+    if (needs_migration)
     {
         const auto &backup_path = QString("%1.%2").arg(m_db_file).arg(
                                       QDateTime::currentDateTime().toString("dd_MMMM_yy_hh_mm_sss_zzz"));
@@ -133,6 +156,12 @@ DBManager::DBManager(const QString &filename) : m_db_file(filename)
     const bool master_does_exist = master_exists.next();
     master_exists.finish();
 
+    if (m_read_only && !master_does_exist)
+        throw DatabaseError(QString("The database '%1' has no master catalog and can't "
+                                    "be opened read only.")
+                            .arg(m_db_file),
+                            DatabaseError::ErrorType::INIT, QSqlError{});
+
     if (init || !master_does_exist)
     {
         if (!initialize_db())
@@ -168,6 +197,19 @@ DBManager::DBManager(const QString &filename) : m_db_file(filename)
         }
     }
 
+    QSqlQuery name_index_exists{ m_db };
+    name_index_exists.exec(SqlStatements::exists_master_name_fts);
+    m_has_name_index = name_index_exists.next();
+    name_index_exists.finish();
+
+    // databases compiled by older versions lack the index
+    if (!m_has_name_index && master_does_exist && !init && !m_read_only)
+    {
+        m_db.transaction();
+        compile_name_index();
+        m_db.commit();
+    }
+
     m_q_cat_by_id         = make_query(m_db, SqlStatements::get_catalog_by_id, true);
     m_q_obj_by_trixel     = make_query(m_db, SqlStatements::dso_by_trixel, false);
     m_q_obj_by_trixel_no_nulls = make_query(m_db, SqlStatements::dso_by_trixel_no_nulls, false);
@@ -181,7 +223,22 @@ DBManager::DBManager(const QString &filename) : m_db_file(filename)
     m_q_obj_by_oid = make_query(m_db, SqlStatements::dso_by_oid, true);
 };
 
-DBManager::DBManager(const DBManager &other) : DBManager::DBManager{ other.m_db_file } {};
+DBManager::DBManager(const DBManager &other)
+    : DBManager::DBManager{ other.m_db_file, other.m_read_only } {};
+
+QSqlQuery *DBManager::cached_query(const QString &statement)
+{
+    auto found = m_query_cache.find(statement);
+    if (found != m_query_cache.end())
+        return &found->second;
+
+    QSqlQuery query{ m_db };
+    query.setForwardOnly(true);
+    if (!query.prepare(statement))
+        return nullptr;
+
+    return &m_query_cache.emplace(statement, std::move(query)).first->second;
+}
 
 bool DBManager::initialize_db()
 {
@@ -358,9 +415,24 @@ bool DBManager::compile_master_catalog()
     success &= query.exec(SqlStatements::create_master_mag_index);
     success &= query.exec(SqlStatements::create_master_type_index);
     success &= query.exec(SqlStatements::create_master_name_index);
+
+    if (success)
+        compile_name_index();
+
     return success;
 };
 
+void DBManager::compile_name_index()
+{
+    QSqlQuery query{ m_db };
+    m_has_name_index = query.exec(SqlStatements::drop_master_name_index) &&
+                       query.exec(SqlStatements::create_master_name_fts) &&
+                       query.exec(SqlStatements::fill_master_name_fts);
+
+    if (!m_has_name_index)
+        query.exec(SqlStatements::drop_master_name_index);
+}
+
 const Catalog read_catalog(const QSqlQuery &query)
 {
     return { query.value("id").toInt(),
@@ -478,6 +550,76 @@ CatalogObjectVector DBManager::_get_objects_in_trixel_generic(QSqlQuery &query,
     return objects;
 }
 
+namespace
+{
+/** @return the \p trixels as a comma separated list for an `IN` clause */
+QString trixel_list(const std::vector<int> &trixels)
+{
+    QStringList ids;
+    ids.reserve(trixels.size());
+    for (const int trixel : trixels)
+        ids << QString::number(trixel);
+
+    return ids.join(',');
+}
+} // namespace
+
+TrixelObjectsMap DBManager::get_objects_in_trixels(const std::vector<int> &trixels)
+{
+    return _get_objects_in_trixels_generic(
+        SqlStatements::dso_by_trixels(trixel_list(trixels)), trixels);
+}
+
+TrixelObjectsMap DBManager::get_objects_in_trixels_no_nulls(const std::vector<int> &trixels)
+{
+    return _get_objects_in_trixels_generic(
+        SqlStatements::dso_by_trixels_no_nulls(trixel_list(trixels)), trixels);
+}
+
+TrixelObjectsMap DBManager::get_objects_in_trixels_null_mag(const std::vector<int> &trixels)
+{
+    return _get_objects_in_trixels_generic(
+        SqlStatements::dso_by_trixels_null_mag(trixel_list(trixels)), trixels);
+}
+
+TrixelObjectsMap DBManager::_get_objects_in_trixels_generic(const QString &statement,
+                                                            const std::vector<int> &trixels)
+{
+    TrixelObjectsMap objects;
+    if (trixels.empty())
+        return objects;
+
+    objects.reserve(trixels.size());
+    for (const int trixel : trixels)
+        objects[trixel];
+
+    QMutexLocker _{ &m_mutex };
+    auto query = make_query(m_db, statement, false);
+    auto finish = gsl::finally([&]() { query.finish(); });
+
+    if (!query.exec()) // we throw because this is not recoverable
+        throw DatabaseError(
+            QString("The by-trixel query for objects in %1 trixels failed.")
+            .arg(trixels.size()),
+            DatabaseError::ErrorType::UNKNOWN, query.lastError());
+
+    // Count the rows of each trixel first, which also moves the query
+    // head to the end
+    const int trixel_column = SqlStatements::dso_query_fields.size();
+    std::unordered_map<int, size_t> counts;
+    while (query.next())
+        counts[query.value(trixel_column).toInt()]++;
+
+    for (const auto &count : counts)
+        objects[count.first].reserve(count.second);
+
+    // Backwards, in the same order as `_get_objects_in_trixel_generic`
+    while (query.previous())
+        objects[query.value(trixel_column).toInt()].push_back(read_catalogobject(query));
+
+    return objects;
+}
+
 CatalogObjectList DBManager::fetch_objects(QSqlQuery &query) const
 {
     CatalogObjectList objects;
@@ -523,6 +665,51 @@ CatalogObjectList DBManager::find_objects_by_name(const QString &name, const int
 
 }
 
+namespace
+{
+/**
+ * Turns the words of \p prefix into an FTS5 query that matches names
+ * in which each word starts a word, e.g. `"ngc" "70"*`.
+ */
+QString prefix_match(const QString &prefix)
+{
+    static const QRegularExpression separators{ "[^\\w]+",
+                                                QRegularExpression::UseUnicodePropertiesOption };
+    const auto words = prefix.split(separators, Qt::SkipEmptyParts);
+
+    QStringList terms;
+    for (const auto &word : words)
+        terms << '"' + word + '"';
+
+    if (!terms.isEmpty())
+        terms.last() += '*';
+
+    return terms.join(' ');
+}
+} // namespace
+
+CatalogObjectList DBManager::find_objects_by_prefix(const QString &prefix, const int limit)
+{
+    QMutexLocker _{ &m_mutex };
+
+    const QString match = prefix_match(prefix);
+    if (limit == 0 || match.isEmpty())
+        return {};
+
+    QSqlQuery *query = cached_query(m_has_name_index ? SqlStatements::dso_by_prefix
+                                                     : SqlStatements::dso_by_prefix_no_fts);
+    if (!query)
+        return {};
+
+    query->bindValue(":name", prefix);
+    query->bindValue(":prefix", prefix + '%');
+    query->bindValue(":limit", limit);
+    if (m_has_name_index)
+        query->bindValue(":match", match);
+
+    return fetch_objects(*query);
+}
+
 CatalogObjectList DBManager::find_objects_by_name(const int catalog_id,
         const QString &name, const int limit)
 {
@@ -655,35 +842,35 @@ inline void bind_catalogobject(QSqlQuery &query, const int catalog_id,
                                const QString &lname, const QString &catalog_identifier,
                                const float a, const float b, const double pa,
                                const float flux, Trixel trixel,
-                               const CatalogObject::oid &new_id)
+                               const CatalogObject::oid &new_id,
+                               const QString &suffix = "")
 {
-    query.prepare(SqlStatements::insert_dso(catalog_id));
-
-    query.bindValue(":hash", new_id); // no dedupe, maybe in the future
-    query.bindValue(":oid", new_id);
-    query.bindValue(":type", static_cast<int>(t));
-    query.bindValue(":ra", r.Degrees());
-    query.bindValue(":dec", d.Degrees());
-    query.bindValue(":magnitude", (m < 99 && !std::isnan(m)) ? m : QVariant{});
-    query.bindValue(":name", n);
-    query.bindValue(":long_name", lname.length() > 0 ? lname : QVariant{});
-    query.bindValue(":catalog_identifier",
+    query.bindValue(":hash" + suffix, new_id); // no dedupe, maybe in the future
+    query.bindValue(":oid" + suffix, new_id);
+    query.bindValue(":type" + suffix, static_cast<int>(t));
+    query.bindValue(":ra" + suffix, r.Degrees());
+    query.bindValue(":dec" + suffix, d.Degrees());
+    query.bindValue(":magnitude" + suffix, (m < 99 && !std::isnan(m)) ? m : QVariant{});
+    query.bindValue(":name" + suffix, n);
+    query.bindValue(":long_name" + suffix, lname.length() > 0 ? lname : QVariant{});
+    query.bindValue(":catalog_identifier" + suffix,
                     catalog_identifier.length() > 0 ? catalog_identifier : QVariant{});
-    query.bindValue(":major_axis", a > 0 ? a : QVariant{});
-    query.bindValue(":minor_axis", b > 0 ? b : QVariant{});
-    query.bindValue(":position_angle", pa > 0 ? pa : QVariant{});
-    query.bindValue(":flux", flux > 0 ? flux : QVariant{});
-    query.bindValue(":trixel", trixel);
-    query.bindValue(":catalog", catalog_id);
+    query.bindValue(":major_axis" + suffix, a > 0 ? a : QVariant{});
+    query.bindValue(":minor_axis" + suffix, b > 0 ? b : QVariant{});
+    query.bindValue(":position_angle" + suffix, pa > 0 ? pa : QVariant{});
+    query.bindValue(":flux" + suffix, flux > 0 ? flux : QVariant{});
+    query.bindValue(":trixel" + suffix, trixel);
+    query.bindValue(":catalog" + suffix, catalog_id);
 }
 
 inline void bind_catalogobject(QSqlQuery &query, const int catalog_id,
-                               const CatalogObject &obj, Trixel trixel)
+                               const CatalogObject &obj, Trixel trixel,
+                               const QString &suffix = "")
 {
     bind_catalogobject(query, catalog_id, static_cast<SkyObject::TYPE>(obj.type()),
                        obj.ra0(), obj.dec0(), obj.name(), obj.mag(), obj.longname(),
                        obj.catalogIdentifier(), obj.a(), obj.b(), obj.pa(), obj.flux(),
-                       trixel, obj.getObjectId());
+                       trixel, obj.getObjectId(), suffix);
 };
 
 std::pair<bool, QString> DBManager::add_object(const int catalog_id,
@@ -715,6 +902,7 @@ DBManager::add_object(const int catalog_id, const SkyObject::TYPE t, const Cachi
 
     const auto new_id =
         CatalogObject::getId(t, r.Degrees(), d.Degrees(), n, catalog_identifier);
+    query.prepare(SqlStatements::insert_dso(catalog_id));
     bind_catalogobject(query, catalog_id, t, r, d, n, m, lname, catalog_identifier, a, b,
                        pa, flux, trixel, new_id);
 
@@ -985,6 +1173,86 @@ QString CatalogsDB::dso_db_path()
            .filePath(Options::dSOCatalogFilename());
 }
 
+namespace
+{
+using ReaderMap = std::unordered_map<QString, std::unique_ptr<DBManager>>;
+
+QMutex readers_mutex;
+std::unordered_map<QThread *, ReaderMap> readers;
+QThread *main_thread = nullptr;
+
+/** Closes the readers of \p thread, must run in that thread. */
+void release_readers(QThread *thread)
+{
+    ReaderMap released;
+    {
+        QMutexLocker _{ &readers_mutex };
+        const auto found = readers.find(thread);
+        if (found == readers.end())
+            return;
+
+        released = std::move(found->second);
+        readers.erase(found);
+    }
+}
+
+std::unique_ptr<DBManager> open_reader(const QString &filename)
+{
+    try
+    {
+        return std::make_unique<DBManager>(filename, true);
+    }
+    catch (const DatabaseError &)
+    {
+        // creates, upgrades or initializes the database
+        DBManager writer{ filename };
+    }
+
+    return std::make_unique<DBManager>(filename, true);
+}
+} // namespace
+
+DBManager &CatalogsDB::thread_reader(const QString &filename)
+{
+    QThread *const thread = QThread::currentThread();
+    ReaderMap *managers   = nullptr;
+    {
+        QMutexLocker _{ &readers_mutex };
+        auto found = readers.find(thread);
+        if (found == readers.end())
+        {
+            found = readers.emplace(thread, ReaderMap{}).first;
+
+            auto *app = QCoreApplication::instance();
+            if (app && thread == app->thread())
+            {
+                main_thread = thread;
+                qAddPostRoutine([] { release_readers(main_thread); });
+            }
+            else if (app)
+            {
+                // finished is emitted in the thread itself
+                QObject::connect(thread, &QThread::finished, [thread]
+                {
+                    release_readers(thread);
+                });
+            }
+        }
+
+        // only this thread changes its map, and references to the
+        // elements survive insertions for other threads
+        managers = &found->second;
+    }
+
+    auto manager = managers->find(filename);
+    if (manager == managers->end())
+    {
+        manager = managers->emplace(filename, open_reader(filename)).first;
+    }
+
+    return *manager->second;
+}
+
 std::pair<bool, Catalog> CatalogsDB::read_catalog_meta_from_file(const QString &path)
 {
     QSqlDatabase db{ QSqlDatabase::addDatabase(
@@ -1054,7 +1322,8 @@ DBManager::get_catalog_statistics(const int catalog_id)
 
 std::pair<bool, QString>
 CatalogsDB::DBManager::add_objects(const int catalog_id,
-                                   const CatalogObjectVector &objects)
+                                   const CatalogObjectVector &objects,
+                                   const ProgressCallback &progress)
 {
     {
         const auto &success = get_catalog(catalog_id);
@@ -1065,23 +1334,54 @@ CatalogsDB::DBManager::add_objects(const int catalog_id,
             return { false, i18n("Catalog is immutable!") };
     }
 
+    // The mesh is created here, SkyMesh::Create isn't thread safe
+    // but indexing is.
+    SkyMesh *mesh = SkyMesh::Create(m_htmesh_level);
+    std::vector<Trixel> trixels(objects.size());
+    std::vector<std::size_t> indices(objects.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    Executors::blockingMap(Executors::Interactive, indices, [&](const std::size_t i)
+    {
+        SkyPoint tmp{ objects[i].ra(), objects[i].dec() };
+        trixels[i] = mesh->index(&tmp);
+    });
+
+    const std::size_t batch = SqlStatements::insert_dsos_max_rows;
+    QStringList suffixes;
+    for (std::size_t row = 0; row < batch; ++row)
+        suffixes << QString("_%1").arg(row);
+
+    QSqlQuery batch_query{ m_db };
+    QSqlQuery rest_query{ m_db };
+    if (!batch_query.prepare(SqlStatements::insert_dsos(catalog_id, batch)))
+        return { false, i18n("Could not insert object! %1",
+                             batch_query.lastError().text()) };
+
     m_db.transaction();
-    QSqlQuery query{ m_db };
-    for (const auto &object : objects)
+    for (std::size_t start = 0; start < objects.size(); start += batch)
     {
-        SkyPoint tmp{ object.ra(), object.dec() };
-        const auto trixel = SkyMesh::Create(m_htmesh_level)->index(&tmp);
+        const std::size_t rows = std::min(batch, objects.size() - start);
+        auto &query = rows == batch ? batch_query : rest_query;
+        if (rows < batch)
+            query.prepare(SqlStatements::insert_dsos(catalog_id, rows));
 
-        bind_catalogobject(query, catalog_id, object, trixel);
+        for (std::size_t row = 0; row < rows; ++row)
+            bind_catalogobject(query, catalog_id, objects[start + row],
+                               trixels[start + row], suffixes[row]);
 
         if (!query.exec())
         {
+            m_db.rollback();
+
             auto err = query.lastError().text();
             if (err.startsWith("UNIQUE"))
                 err = i18n("The object is already in the catalog!");
 
             return { false, i18n("Could not insert object! %1", err) };
         }
+
+        if (progress)
+            progress(start + rows, objects.size());
     }
 
     return { m_db.commit() &&update_catalog_views() &&compile_master_catalog(),
@@ -1093,15 +1393,14 @@ CatalogObjectList CatalogsDB::DBManager::find_objects_by_wildcard(const QString
 {
     QMutexLocker _{ &m_mutex };
 
-    QSqlQuery query{ m_db };
-    if (!query.prepare(SqlStatements::dso_by_wildcard()))
-    {
+    QSqlQuery *query = cached_query(SqlStatements::dso_by_wildcard());
+    if (!query)
         return {};
-    }
-    query.bindValue(":wildcard", wildcard);
-    query.bindValue(":limit", limit);
 
-    return fetch_objects(query);
+    query->bindValue(":wildcard", wildcard);
+    query->bindValue(":limit", limit);
+
+    return fetch_objects(*query);
 };
 
 std::tuple<bool, const QString, CatalogObjectList>
@@ -9,6 +9,7 @@
 #include <QSqlDatabase>
 #include <QSqlError>
 #include <exception>
+#include <functional>
 #include <list>
 #include <QString>
 #include <QList>
@@ -132,6 +133,7 @@ using CatalogColorMap           = std::map<QString, QColor>;
 using ColorMap                  = std::map<int, CatalogColorMap>;
 using CatalogObjectList         = std::list<CatalogObject>;
 using CatalogObjectVector       = std::vector<CatalogObject>;
+using TrixelObjectsMap          = std::unordered_map<int, CatalogObjectVector>;
 
 /**
  * \returns A hash table of the form `color scheme: color` by
@@ -190,8 +192,17 @@ class DBManager
      * (throws if that does not work), checks the database version
      * (throws if that does not match), initializes the database,
      * registers the user catalog and updates the all_catalog_view.
+     *
+     * Writable connections switch the database to write-ahead
+     * logging, so that readers in other connections don't block
+     * writers and vice versa.
+     *
+     * If \p read_only is `true` the database is opened read only. It
+     * is neither initialized nor migrated then, the constructor throws
+     * if it would have to. Prefer `thread_reader` over constructing
+     * read only managers.
      */
-    DBManager(const QString &filename);
+    DBManager(const QString &filename, const bool read_only = false);
     DBManager(const DBManager &other);
 
     DBManager &operator=(DBManager other)
@@ -211,6 +222,9 @@ class DBManager
         swap(m_q_obj_by_maglim, other.m_q_obj_by_maglim);
         swap(m_q_obj_by_maglim_and_type, other.m_q_obj_by_maglim_and_type);
         swap(m_q_obj_by_oid, other.m_q_obj_by_oid);
+        swap(m_has_name_index, other.m_has_name_index);
+        swap(m_read_only, other.m_read_only);
+        swap(m_query_cache, other.m_query_cache);
 
         return *this;
     };
@@ -268,6 +282,25 @@ class DBManager
         return _get_objects_in_trixel_generic(m_q_obj_by_trixel_null_mag, trixel);
     }
 
+    /**
+     * @return the objects in each of the \p trixels, fetched in a
+     * single query. Every trixel has an entry, holding the same objects
+     * in the same order as `get_objects_in_trixel`.
+     */
+    TrixelObjectsMap get_objects_in_trixels(const std::vector<int> &trixels);
+
+    /**
+     * @return the objects of known mag in each of the \p trixels, see
+     * `get_objects_in_trixels`.
+     */
+    TrixelObjectsMap get_objects_in_trixels_no_nulls(const std::vector<int> &trixels);
+
+    /**
+     * @return the objects of unknown mag in each of the \p trixels, see
+     * `get_objects_in_trixels`.
+     */
+    TrixelObjectsMap get_objects_in_trixels_null_mag(const std::vector<int> &trixels);
+
     /**
      * \brief Find an objects by name.
      *
@@ -292,6 +325,25 @@ class DBManager
     CatalogObjectList find_objects_by_name(const int catalog_id, const QString &name,
                                            const int limit = -1);
 
+    /**
+     * \brief Find the objects whose name or long name starts with \p
+     * `prefix`, best matches first.
+     *
+     * Every word of \p prefix has to start a word of the name or the
+     * long name. Exact matches of the name come first, then names
+     * and long names that start with \p prefix, then the remaining
+     * matches by relevance and brightness.
+     *
+     * The names are looked up in a full text index built along with
+     * the master catalog. If sqlite lacks FTS5, only names and long
+     * names starting with \p prefix are found.
+     *
+     * \param limit Upper limit to the quanitity of results. `-1` means "no
+     * limit"
+     * \return a list of matching objects
+     */
+    CatalogObjectList find_objects_by_prefix(const QString &prefix, const int limit = -1);
+
     /**
      * \brief Find an objects by searching the name four wildcard. See
      * the LIKE sqlite statement.
@@ -399,15 +451,28 @@ class DBManager
      */
     std::pair<bool, QString> add_object(const int catalog_id, const CatalogObject &obj);
 
+    /**
+     * Called by `add_objects` with the number of objects inserted so
+     * far and the total number of objects.
+     */
+    using ProgressCallback = std::function<void(std::size_t done, std::size_t total)>;
+
     /**
      * Add the \p `objects` to a table with \p `catalog_id`. For the
      * rest of the arguments see `CatalogObject::CatalogObject`.
      *
+     * All objects are inserted in one transaction, many rows per
+     * statement, after their trixels have been computed in parallel.
+     * The master catalog is compiled once at the end. If an insert
+     * fails, none of the objects are added.
+     *
+     * \param progress if set, called after each batch of rows
      * \returns wether the operation was successful and if not, an
      * error message
      */
     std::pair<bool, QString> add_objects(const int catalog_id,
-                                         const CatalogObjectVector &objects);
+                                         const CatalogObjectVector &objects,
+                                         const ProgressCallback &progress = {});
 
     /**
      * Remove the catalog object with the \p `oid` from the catalog with the
@@ -514,6 +579,13 @@ class DBManager
      */
     bool compile_master_catalog();
 
+    /**
+     * (Re)builds the full text index of the names in the master
+     * catalog and sets `m_has_name_index`. A missing FTS5 module is
+     * not an error, prefix searches fall back to `LIKE` then.
+     */
+    void compile_name_index();
+
     /**
      * Updates the all_catalog_view so that it includes all known
      * catalogs.
@@ -597,6 +669,29 @@ class DBManager
      */
     int m_db_version = -1;
 
+    /**
+     * Whether the full text index of the names in the master catalog
+     * exists. It needs sqlite with FTS5.
+     */
+    bool m_has_name_index = false;
+
+    /** Whether the database was opened read only. */
+    bool m_read_only = false;
+
+    /**
+     * Queries that are not worth a member of their own, prepared on
+     * first use. `m_mutex` should be locked when using them.
+     *
+     * \sa cached_query
+     */
+    std::unordered_map<QString, QSqlQuery> m_query_cache;
+
+    /**
+     * \returns the query for \p statement from `m_query_cache`,
+     * prepared on first use, or `nullptr` if it can't be prepared.
+     */
+    QSqlQuery *cached_query(const QString &statement);
+
     /**
      * A simple mutex to be locked when using prepared statements,
      * that are stored in the class.
@@ -669,6 +764,13 @@ class DBManager
      */
     CatalogObjectVector _get_objects_in_trixel_generic(QSqlQuery &query, const int trixel);
 
+    /**
+     * Run the by-trixels \p statement, which selects the trixel after
+     * the object fields, and sort the rows into \p trixels.
+     */
+    TrixelObjectsMap _get_objects_in_trixels_generic(const QString &statement,
+                                                     const std::vector<int> &trixels);
+
     //@}
 };
 
@@ -722,6 +824,22 @@ std::pair<bool, Catalog> read_catalog_meta_from_file(const QString &path);
 
 
 
+/**
+ * \returns a read only manager of the database \p filename for the
+ * calling thread.
+ *
+ * The managers are opened once per thread and file and closed when
+ * the thread finishes, or at exit for the main thread. This saves
+ * opening the database and preparing its queries for every lookup, and
+ * concurrent lookups in different threads don't share a connection.
+ * The manager must only be used in the calling thread, sqlite
+ * connections are not shared between threads.
+ *
+ * If the database can't be opened read only because it does not
+ * exist yet or has to be migrated, a writable manager does that first.
+ */
+DBManager &thread_reader(const QString &filename = dso_db_path());
+
 /**
  * A concurrent wrapper around \sa CatalogsDB::DBManager
  *
@@ -35,6 +35,9 @@ const QString master_catalog       = "master";
 const QString all_catalog_view     = "all_catalogs";
 const QString colors_table         = "catalog_colors";
 
+// Persists in the database file
+const QString enable_wal = "PRAGMA journal_mode = WAL";
+
 /* metadata */
 const QString create_meta_table =
     "CREATE TABLE IF NOT EXISTS meta (version INTEGER NOT "
@@ -299,6 +302,17 @@ const QString create_master_name_index =
     "COLLATE NOCASE ASC, long_name COLLATE NOCASE ASC, "
     "magnitude ASC)";
 
+// The name index refers to the rows of master by rowid, so it has to
+// be rebuilt whenever master is.
+const QString drop_master_name_index = "DROP TABLE IF EXISTS master_fts";
+const QString create_master_name_fts =
+    "CREATE VIRTUAL TABLE master_fts USING fts5(name, long_name, content='master', "
+    "content_rowid='rowid', prefix='1 2 3')";
+const QString fill_master_name_fts =
+    "INSERT INTO master_fts(master_fts) VALUES('rebuild')";
+const QString exists_master_name_fts =
+    "SELECT name FROM sqlite_master WHERE type='table' AND name='master_fts';";
+
 const QString get_first_catalog = "SELECT id, name, precedence, author, source, "
                                   "description, mut, enabled, version, color, license, "
                                   "maintainer, timestamp FROM catalogs LIMIT 1";
@@ -335,6 +349,26 @@ const QString _dso_by_trixel_no_nulls = "SELECT %1 FROM master WHERE trixel = "
                                         " BY magnitude DESC";
 const QString dso_by_trixel_no_nulls = QString(_dso_by_trixel_no_nulls).arg(object_fields);
 
+// The trixel comes after the object fields, so that the rows can be
+// read like those of the queries above.
+const QString _dso_by_trixels = "SELECT %1, trixel FROM master WHERE trixel IN (%2)%3";
+
+inline const QString dso_by_trixels(const QString &trixels)
+{
+    return _dso_by_trixels.arg(object_fields, trixels, " ORDER BY " + mag_desc);
+}
+
+inline const QString dso_by_trixels_null_mag(const QString &trixels)
+{
+    return _dso_by_trixels.arg(object_fields, trixels, " AND magnitude IS NULL");
+}
+
+inline const QString dso_by_trixels_no_nulls(const QString &trixels)
+{
+    return _dso_by_trixels.arg(object_fields, trixels,
+                               " AND magnitude IS NOT NULL ORDER BY magnitude DESC");
+}
+
 const QString _dso_by_oid = "SELECT %1 FROM master WHERE oid = :id LIMIT 1";
 
 const QString dso_by_oid = QString(_dso_by_oid).arg(object_fields);
@@ -368,14 +402,33 @@ inline const QString dso_by_name_and_catalog(const int id)
            .arg(mag_asc);
 }
 
-const QString _dso_by_wildcard = "SELECT %1 FROM master WHERE name LIKE :wildcard LIMIT "
-                                 ":limit ORDER BY CAST(name AS INTEGER)";
+const QString _dso_by_wildcard = "SELECT %1 FROM master WHERE name LIKE :wildcard ORDER "
+                                 "BY CAST(name AS INTEGER) LIMIT :limit";
 
 inline const QString dso_by_wildcard()
 {
     return QString(_dso_by_wildcard).arg(object_fields);
 }
 
+// Exact matches first, then names and long names that start with the
+// search text, then the full text rank and the brightest objects.
+const QString _dso_by_prefix_order =
+    "ORDER BY name = :name COLLATE NOCASE DESC, name LIKE :prefix DESC, long_name "
+    "LIKE :prefix DESC, %1, magnitude IS NULL, magnitude ASC, name LIMIT :limit";
+
+const QString dso_by_prefix =
+    QString("SELECT %1 FROM master JOIN (SELECT rowid AS match_id, rank AS match_rank "
+            "FROM master_fts WHERE master_fts MATCH :match) ON master.rowid = match_id ")
+        .arg(object_fields) +
+    _dso_by_prefix_order.arg("match_rank");
+
+// Used if sqlite was built without FTS5, the prefix can still be
+// looked up in master_name.
+const QString dso_by_prefix_no_fts =
+    QString("SELECT %1 FROM master WHERE name LIKE :prefix OR long_name LIKE :prefix ")
+        .arg(object_fields) +
+    _dso_by_prefix_order.arg("name");
+
 inline const QString dso_general_query(const QString &where, const QString &order_by = "")
 {
     auto query = QString("SELECT %1 FROM master WHERE %2").arg(object_fields).arg(where);
@@ -433,6 +486,30 @@ inline const QString insert_dso(int catalog_id)
     return _insert_dso.arg(catalog_id);
 }
 
+// Stays below the 999 variables sqlite allowed before 3.32
+constexpr int insert_dsos_max_rows = 999 / catalog_collumns.size();
+
+/**
+ * An insert of \p rows objects, the placeholders of row `i` are
+ * named like those of `insert_dso`, followed by `_i`.
+ */
+inline const QString insert_dsos(int catalog_id, int rows)
+{
+    QStringList values;
+    for (int row = 0; row < rows; ++row)
+    {
+        QStringList placeholders;
+        for (const auto &column : catalog_collumns)
+            placeholders << QString(":%1_%2").arg(column).arg(row);
+
+        values << '(' + placeholders.join(", ") + ')';
+    }
+
+    return QString("INSERT OR REPLACE INTO cat_%1 (%2) VALUES %3")
+        .arg(catalog_id)
+        .arg(catalog_fields, values.join(", "));
+}
+
 const QString _remove_dso{ "DELETE FROM cat_%1 WHERE oid = :oid" };
 inline const QString remove_dso(const int id)
 {
@@ -0,0 +1,521 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+/*
+ * Compiles star catalogs to the aligned format described in kstars/auxiliary/starcatalogformat.h,
+ * which KStars reads in place of the original binary files.
+ *
+ * Usage:
+ *
+ *   starcatalogcompiler [-i <Henry-Draper.idx>] <input.dat> <output.dat>
+ *
+ *     Converts a KStars binary star file (namedstars.dat, unnamedstars.dat, deepstars.dat,
+ *     USNO-NOMAD-1e8.dat...) of either byte order. With -i, the Henry Draper index of the
+ *     output file is written too, which is needed when converting deepstars.dat.
+ *
+ *   starcatalogcompiler -t [-l <HTM level>] <input.txt> <output.dat>
+ *
+ *     Builds a deep star file of 16 byte records from a text catalog (a Gaia subset for
+ *     instance), with one star per line: RA and Dec in degrees, proper motions in RA and Dec
+ *     in mas/yr, V magnitude and optionally B magnitude, separated by spaces, tabs or commas.
+ *     Lines starting with # are skipped. The default HTM level is 6, as in USNO-NOMAD-1e8.dat.
+ *
+ * The output must be compiled on a machine with the byte order of the machines that read it.
+ */
+
+#include "byteorder.h"
+#include "starcatalogformat.h"
+#include "HTMesh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace StarCatalogFormat;
+
+namespace
+{
+// Field descriptor and data types of the original format, as in binfile.h
+struct dataElement
+{
+    char name[10];
+    int8_t size;
+    uint8_t type;
+    int32_t scale;
+};
+
+enum dataType
+{
+    DT_CHAR,
+    DT_INT8,
+    DT_UINT8,
+    DT_INT16,
+    DT_UINT16,
+    DT_INT32,
+    DT_UINT32,
+    DT_CHARV,
+    DT_STR
+};
+
+struct Catalog
+{
+    std::vector<dataElement> fields;
+    uint32_t recordSize { 0 };
+    int16_t faintMag { 0 };
+    uint8_t htmLevel { 0 };
+    uint16_t maxStarsPerTrixel { 0 };
+    /// Number of records of each trixel
+    std::vector<uint32_t> counts;
+};
+
+// Same layout as DeepStarData in kstars/skyobjects/deepstardata.h
+struct DeepStar
+{
+    int32_t RA;
+    int32_t Dec;
+    int16_t dRA;
+    int16_t dDec;
+    int16_t B;
+    int16_t V;
+};
+
+struct TextStar
+{
+    uint32_t trixel;
+    DeepStar data;
+};
+
+uint64_t align(uint64_t offset)
+{
+    return (offset + STAR_CATALOG_ALIGNMENT - 1) / STAR_CATALOG_ALIGNMENT * STAR_CATALOG_ALIGNMENT;
+}
+
+// Offset of the first record, the trailer of the original format is right before it.
+uint64_t recordsOffset(const Catalog &catalog)
+{
+    const uint64_t indexEnd = sizeof(StarCatalogHeader) + catalog.fields.size() * sizeof(dataElement) +
+                              catalog.counts.size() * sizeof(StarCatalogIndexEntry);
+    return align(indexEnd + TRAILER_SIZE);
+}
+
+void swapRecord(char *record, const std::vector<dataElement> &fields)
+{
+    for (const dataElement &field : fields)
+    {
+        if (field.size == 2 && (field.type == DT_INT16 || field.type == DT_UINT16))
+        {
+            uint16_t value;
+            memcpy(&value, record, 2);
+            value = static_cast<uint16_t>(bswap_16(value));
+            memcpy(record, &value, 2);
+        }
+        else if (field.size == 4 && (field.type == DT_INT32 || field.type == DT_UINT32))
+        {
+            uint32_t value;
+            memcpy(&value, record, 4);
+            value = bswap_32(value);
+            memcpy(record, &value, 4);
+        }
+        record += field.size;
+    }
+}
+
+bool writePadding(FILE *f, uint64_t offset)
+{
+    static const char zeros[STAR_CATALOG_ALIGNMENT] = {};
+    long position = ftell(f);
+    while (position >= 0 && static_cast<uint64_t>(position) < offset)
+    {
+        const size_t n = std::min<uint64_t>(sizeof(zeros), offset - position);
+        if (fwrite(zeros, n, 1, f) != 1)
+            return false;
+        position += n;
+    }
+    return position >= 0 && static_cast<uint64_t>(position) == offset;
+}
+
+/*
+ * Writes everything up to the first record. The records of all the trixels must be written
+ * right after, in trixel order.
+ */
+bool writeHeader(FILE *f, const Catalog &catalog)
+{
+    const uint64_t indexOffset = sizeof(StarCatalogHeader) + catalog.fields.size() * sizeof(dataElement);
+    const uint64_t firstRecord = recordsOffset(catalog);
+
+    StarCatalogHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.byteOrderMark = BYTE_ORDER_MARK;
+    header.version       = VERSION;
+    header.recordSize    = catalog.recordSize;
+    header.fieldCount    = catalog.fields.size();
+    header.indexSize     = catalog.counts.size();
+    header.indexOffset   = indexOffset;
+    header.dataOffset    = firstRecord - TRAILER_SIZE;
+    for (uint32_t count : catalog.counts)
+        header.recordCount += count;
+
+    if (fwrite(&header, sizeof(header), 1, f) != 1)
+        return false;
+    for (const dataElement &field : catalog.fields)
+        if (fwrite(&field, sizeof(dataElement), 1, f) != 1)
+            return false;
+
+    uint64_t offset = firstRecord;
+    for (uint32_t count : catalog.counts)
+    {
+        StarCatalogIndexEntry entry;
+        entry.offset   = offset;
+        entry.count    = count;
+        entry.reserved = 0;
+        if (fwrite(&entry, sizeof(entry), 1, f) != 1)
+            return false;
+        offset += static_cast<uint64_t>(count) * catalog.recordSize;
+    }
+
+    return writePadding(f, header.dataOffset) && fwrite(&catalog.faintMag, 2, 1, f) == 1 &&
+           fwrite(&catalog.htmLevel, 1, 1, f) == 1 && fwrite(&catalog.maxStarsPerTrixel, 2, 1, f) == 1;
+}
+
+/*
+ * Converts a file in the original format, see BinFileHelper::readHeader().
+ */
+int compileBinary(const char *input, const char *output, const char *hdIndex)
+{
+    FILE *in = fopen(input, "rb");
+    if (!in)
+    {
+        fprintf(stderr, "Cannot open %s\n", input);
+        return 1;
+    }
+
+    char text[124];
+    int16_t endian;
+    uint8_t version;
+    int16_t nfields;
+    if (fread(text, sizeof(text), 1, in) != 1 || fread(&endian, 2, 1, in) != 1 || fread(&version, 1, 1, in) != 1 ||
+            fread(&nfields, 2, 1, in) != 1)
+    {
+        fprintf(stderr, "%s: truncated header\n", input);
+        return 1;
+    }
+    if (memcmp(text, MAGIC, sizeof(MAGIC)) == 0)
+    {
+        fprintf(stderr, "%s is already compiled\n", input);
+        return 1;
+    }
+
+    const bool swap = (endian != 0x4B53);
+    if (swap)
+        nfields = static_cast<int16_t>(bswap_16(nfields));
+
+    Catalog catalog;
+    for (int i = 0; i < nfields; ++i)
+    {
+        dataElement field;
+        if (fread(&field, sizeof(field), 1, in) != 1)
+        {
+            fprintf(stderr, "%s: truncated field descriptor\n", input);
+            return 1;
+        }
+        if (swap)
+            field.scale = bswap_32(field.scale);
+        catalog.recordSize += field.size;
+        catalog.fields.push_back(field);
+    }
+
+    uint32_t indexSize;
+    if (fread(&indexSize, 4, 1, in) != 1)
+    {
+        fprintf(stderr, "%s: truncated index table\n", input);
+        return 1;
+    }
+    if (swap)
+        indexSize = bswap_32(indexSize);
+
+    std::vector<uint32_t> offsets(indexSize);
+    catalog.counts.resize(indexSize);
+    for (uint32_t j = 0; j < indexSize; ++j)
+    {
+        uint32_t entry[3];
+        if (fread(entry, sizeof(entry), 1, in) != 1)
+        {
+            fprintf(stderr, "%s: truncated index table\n", input);
+            return 1;
+        }
+        if (swap)
+            for (uint32_t &value : entry)
+                value = bswap_32(value);
+        if (entry[0] != j)
+        {
+            fprintf(stderr, "%s: found trixel %u where trixel %u was expected\n", input, entry[0], j);
+            return 1;
+        }
+        offsets[j]        = entry[1];
+        catalog.counts[j] = entry[2];
+    }
+
+    if (fread(&catalog.faintMag, 2, 1, in) != 1 || fread(&catalog.htmLevel, 1, 1, in) != 1 ||
+            fread(&catalog.maxStarsPerTrixel, 2, 1, in) != 1)
+    {
+        fprintf(stderr, "%s: truncated trailer\n", input);
+        return 1;
+    }
+    if (swap)
+    {
+        catalog.faintMag          = static_cast<int16_t>(bswap_16(catalog.faintMag));
+        catalog.maxStarsPerTrixel = static_cast<uint16_t>(bswap_16(catalog.maxStarsPerTrixel));
+    }
+
+    // The Henry Draper index points to the records of the HD field
+    int hdOffset = -1;
+    if (hdIndex)
+    {
+        int offset = 0;
+        for (const dataElement &field : catalog.fields)
+        {
+            if (strncmp(field.name, "HD", sizeof(field.name)) == 0)
+                hdOffset = offset;
+            offset += field.size;
+        }
+        if (hdOffset < 0)
+        {
+            fprintf(stderr, "%s has no HD field\n", input);
+            return 1;
+        }
+    }
+    std::vector<uint32_t> hdOffsets;
+
+    FILE *out = fopen(output, "wb");
+    if (!out || !writeHeader(out, catalog))
+    {
+        fprintf(stderr, "Cannot write %s\n", output);
+        return 1;
+    }
+
+    std::vector<char> records;
+    uint64_t outputOffset = recordsOffset(catalog);
+    for (uint32_t j = 0; j < indexSize; ++j)
+    {
+        records.resize(static_cast<size_t>(catalog.counts[j]) * catalog.recordSize);
+        if (records.empty())
+            continue;
+        if (fseeko(in, offsets[j], SEEK_SET) != 0 || fread(records.data(), records.size(), 1, in) != 1)
+        {
+            fprintf(stderr, "%s: cannot read the records of trixel %u\n", input, j);
+            return 1;
+        }
+        for (uint32_t k = 0; k < catalog.counts[j]; ++k)
+        {
+            char *record = records.data() + static_cast<size_t>(k) * catalog.recordSize;
+            if (swap)
+                swapRecord(record, catalog.fields);
+            if (hdOffset >= 0)
+            {
+                int32_t hd;
+                memcpy(&hd, record + hdOffset, 4);
+                if (hd > 0)
+                {
+                    if (hdOffsets.size() < static_cast<size_t>(hd))
+                        hdOffsets.resize(hd, 0);
+                    hdOffsets[hd - 1] = outputOffset + static_cast<uint64_t>(k) * catalog.recordSize;
+                }
+            }
+        }
+        if (fwrite(records.data(), records.size(), 1, out) != 1)
+        {
+            fprintf(stderr, "Cannot write %s\n", output);
+            return 1;
+        }
+        outputOffset += records.size();
+    }
+    fclose(in);
+    fclose(out);
+
+    if (hdIndex)
+    {
+        if (outputOffset > UINT32_MAX)
+        {
+            fprintf(stderr, "%s is too large for a Henry Draper index\n", output);
+            return 1;
+        }
+        FILE *idx = fopen(hdIndex, "wb");
+        if (!idx || (!hdOffsets.empty() && fwrite(hdOffsets.data(), hdOffsets.size() * 4, 1, idx) != 1))
+        {
+            fprintf(stderr, "Cannot write %s\n", hdIndex);
+            return 1;
+        }
+        fclose(idx);
+    }
+
+    return 0;
+}
+
+int16_t clampToInt16(double value)
+{
+    return static_cast<int16_t>(std::max(-32768.0, std::min(32767.0, std::round(value))));
+}
+
+/*
+ * Builds a deep star file from a text catalog.
+ */
+int compileText(const char *input, const char *output, int level)
+{
+    FILE *in = fopen(input, "r");
+    if (!in)
+    {
+        fprintf(stderr, "Cannot open %s\n", input);
+        return 1;
+    }
+
+    HTMesh mesh(level, level);
+    std::vector<TextStar> stars;
+    char line[1024];
+    unsigned long lineNumber = 0;
+    while (fgets(line, sizeof(line), in))
+    {
+        ++lineNumber;
+        for (char *c = line; *c; ++c)
+            if (*c == ',')
+                *c = ' ';
+
+        double values[6];
+        char *c = line;
+        int n = 0;
+        while (n < 6)
+        {
+            char *end;
+            values[n] = strtod(c, &end);
+            if (end == c)
+                break;
+            c = end;
+            ++n;
+        }
+        if (n == 0 && (line[strspn(line, " \t\r\n")] == '#' || line[strspn(line, " \t\r\n")] == '\0'))
+            continue;
+        if (n < 5)
+        {
+            fprintf(stderr, "%s:%lu: expected RA, Dec, pmRA, pmDec and V\n", input, lineNumber);
+            return 1;
+        }
+
+        TextStar star;
+        star.trixel   = mesh.index(values[0], values[1]);
+        star.data.RA  = static_cast<int32_t>(std::lround(values[0] / 15.0 * 1000000.0));
+        star.data.Dec = static_cast<int32_t>(std::lround(values[1] * 100000.0));
+        // Proper motions beyond the 16 bit range are clamped, such stars belong to the named star catalog
+        star.data.dRA  = clampToInt16(values[2] * 100.0);
+        star.data.dDec = clampToInt16(values[3] * 100.0);
+        star.data.V    = clampToInt16(values[4] * 1000.0);
+        star.data.B    = (n == 6) ? clampToInt16(values[5] * 1000.0) : 30000;
+        stars.push_back(star);
+    }
+    fclose(in);
+
+    // Each trixel sorted by magnitude, as StarBlockList expects
+    std::stable_sort(stars.begin(), stars.end(), [](const TextStar & a, const TextStar & b)
+    {
+        return a.trixel != b.trixel ? a.trixel < b.trixel : a.data.V < b.data.V;
+    });
+
+    Catalog catalog;
+    catalog.recordSize = sizeof(DeepStar);
+    catalog.htmLevel   = level;
+    catalog.counts.resize(mesh.size(), 0);
+    const struct
+    {
+        const char *name;
+        int8_t size;
+        uint8_t type;
+        int32_t scale;
+    } fields[] = { { "RA", 4, DT_INT32, 1000000 }, { "Dec", 4, DT_INT32, 100000 }, { "dRA", 2, DT_INT16, 100 },
+        { "dDec", 2, DT_INT16, 100 }, { "B", 2, DT_INT16, 1000 }, { "V", 2, DT_INT16, 1000 }
+    };
+    for (const auto &f : fields)
+    {
+        dataElement field;
+        memset(&field, 0, sizeof(field));
+        strncpy(field.name, f.name, sizeof(field.name));
+        field.size  = f.size;
+        field.type  = f.type;
+        field.scale = f.scale;
+        catalog.fields.push_back(field);
+    }
+    for (const TextStar &star : stars)
+    {
+        uint32_t &count = catalog.counts[star.trixel];
+        ++count;
+        catalog.maxStarsPerTrixel = std::max<uint32_t>(catalog.maxStarsPerTrixel, std::min<uint32_t>(count, UINT16_MAX));
+        catalog.faintMag          = std::max(catalog.faintMag, star.data.V);
+    }
+
+    FILE *out = fopen(output, "wb");
+    if (!out || !writeHeader(out, catalog))
+    {
+        fprintf(stderr, "Cannot write %s\n", output);
+        return 1;
+    }
+    for (const TextStar &star : stars)
+    {
+        if (fwrite(&star.data, sizeof(DeepStar), 1, out) != 1)
+        {
+            fprintf(stderr, "Cannot write %s\n", output);
+            return 1;
+        }
+    }
+    fclose(out);
+
+    fprintf(stdout, "Wrote %zu stars in %d trixels to %s\n", stars.size(), mesh.size(), output);
+    return 0;
+}
+
+void usage(const char *program)
+{
+    fprintf(stderr, "Usage: %s [-i <Henry-Draper.idx>] <input.dat> <output.dat>\n", program);
+    fprintf(stderr, "       %s -t [-l <HTM level>] <input.txt> <output.dat>\n", program);
+}
+}
+
+int main(int argc, char **argv)
+{
+    const char *hdIndex = nullptr;
+    bool text           = false;
+    int level           = 6;
+
+    int option;
+    while ((option = getopt(argc, argv, "i:tl:")) != -1)
+    {
+        switch (option)
+        {
+            case 'i':
+                hdIndex = optarg;
+                break;
+            case 't':
+                text = true;
+                break;
+            case 'l':
+                level = atoi(optarg);
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (argc - optind != 2 || level < 0 || level > 10 || (text && hdIndex))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    return text ? compileText(argv[optind], argv[optind + 1], level) : compileBinary(argv[optind], argv[optind + 1], hdIndex);
+}
@@ -14,7 +14,7 @@
 CatalogColorEditor::CatalogColorEditor(const int id, QWidget *parent)
     : QDialog(parent), ui(new Ui::CatalogColorEditor), m_id{ id }
 {
-    CatalogsDB::DBManager manager{ CatalogsDB::dso_db_path() };
+    auto &manager = CatalogsDB::thread_reader();
     const auto &cat = manager.get_catalog(m_id);
     if (!cat.first)
     {
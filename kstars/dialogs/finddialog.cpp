@@ -230,35 +230,20 @@ void FindDialog::filterByType()
 
     switch (ui->FilterType->currentIndex())
     {
+        // The model shares the lists of the components, nothing is copied here
         case 0: // All object types
-        {
-            QVector<QPair<QString, const SkyObject *>> allObjects;
-            foreach (int type, data->skyComposite()->objectLists().keys())
-            {
-                allObjects.append(data->skyComposite()->objectLists(SkyObject::TYPE(type)));
-            }
-            fModel->setSkyObjectsList(allObjects);
+            fModel->setSkyObjectsLists(data->skyComposite()->objectLists().values().toVector());
             break;
-        }
         case 1: //Stars
-        {
-            QVector<QPair<QString, const SkyObject *>> starObjects;
-            starObjects.append(data->skyComposite()->objectLists(SkyObject::STAR));
-            starObjects.append(data->skyComposite()->objectLists(SkyObject::CATALOG_STAR));
-            fModel->setSkyObjectsList(starObjects);
+            fModel->setSkyObjectsLists({ data->skyComposite()->objectLists(SkyObject::STAR),
+                                         data->skyComposite()->objectLists(SkyObject::CATALOG_STAR) });
             break;
-        }
         case 2: //Solar system
-        {
-            QVector<QPair<QString, const SkyObject *>> ssObjects;
-            ssObjects.append(data->skyComposite()->objectLists(SkyObject::PLANET));
-            ssObjects.append(data->skyComposite()->objectLists(SkyObject::COMET));
-            ssObjects.append(data->skyComposite()->objectLists(SkyObject::ASTEROID));
-            ssObjects.append(data->skyComposite()->objectLists(SkyObject::MOON));
-
-            fModel->setSkyObjectsList(ssObjects);
+            fModel->setSkyObjectsLists({ data->skyComposite()->objectLists(SkyObject::PLANET),
+                                         data->skyComposite()->objectLists(SkyObject::COMET),
+                                         data->skyComposite()->objectLists(SkyObject::ASTEROID),
+                                         data->skyComposite()->objectLists(SkyObject::MOON) });
             break;
-        }
         case 3: //Open Clusters
             fModel->setSkyObjectsList(data->skyComposite()->objectLists(SkyObject::OPEN_CLUSTER));
             break;
@@ -310,9 +295,11 @@ void FindDialog::filterList()
     //        return; // Ignore this search since the search text has changed
     //    }
 
-    auto objs = m_dbManager.find_objects_by_name(SearchText, 10);
+    // Ranked, so the best match comes first
+    auto objs = m_dbManager.find_objects_by_prefix(SearchText, 10);
 
-    bool exactMatchExists = objs.size() > 0 ? QString::compare(objs.front().name(), SearchText, Qt::CaseInsensitive) : false;
+    bool exactMatchExists = objs.size() > 0 ? QString::compare(objs.front().name(), SearchText, Qt::CaseInsensitive) == 0 : false;
+    const QString bestMatch = objs.size() > 0 ? objs.front().name() : QString();
 
     for (const auto &obj : objs)
     {
@@ -330,13 +317,14 @@ void FindDialog::filterList()
     //Select the first item in the list that begins with the filter string
     if (!SearchText.isEmpty())
     {
-        QStringList mItems =
-            fModel->filter(QRegExp('^' + SearchText, Qt::CaseInsensitive));
+        QStringList mItems = fModel->startingWith(SearchText);
         mItems.sort();
 
-        if (mItems.size())
+        // Prefer the best match of the database, it may also match by long name
+        const int bestIndex = bestMatch.isEmpty() ? -1 : fModel->indexOf(bestMatch);
+        if (bestIndex >= 0 || mItems.size())
         {
-            QModelIndex qmi        = fModel->index(fModel->indexOf(mItems[0]));
+            QModelIndex qmi        = fModel->index(bestIndex >= 0 ? bestIndex : fModel->indexOf(mItems[0]));
             QModelIndex selectItem = sortModel->mapFromSource(qmi);
 
             if (selectItem.isValid())
@@ -396,7 +384,8 @@ void FindDialog::enqueueSearch()
             this->filterList();
         });
     }
-    timer->start(500);
+    // Prefix searches are cheap, only wait for a pause in typing
+    timer->start(150);
 }
 
 // Process the search box text to replace equivalent names like "m93" with "m 93"
@@ -185,16 +185,17 @@ void LocationDialog::filterCity()
     ld->AddCityButton->setEnabled(false);
     ld->UpdateButton->setEnabled(false);
 
-    foreach (GeoLocation *loc, data->getGeoList())
+    // The city filter narrows the search to a range of the name index
+    const QList<GeoLocation *> candidates = ld->CityFilter->text().isEmpty() ?
+                                            data->getGeoList() : data->cityIndex().startingWith(ld->CityFilter->text());
+    for (GeoLocation *loc : candidates)
     {
-        QString sc(loc->translatedName());
         QString ss(loc->translatedCountry());
         QString sp = "";
         if (!loc->province().isEmpty())
             sp = loc->translatedProvince();
 
-        if (sc.startsWith(ld->CityFilter->text(), Qt::CaseInsensitive) &&
-                sp.startsWith(ld->ProvinceFilter->text(), Qt::CaseInsensitive) &&
+        if (sp.startsWith(ld->ProvinceFilter->text(), Qt::CaseInsensitive) &&
                 ss.startsWith(ld->CountryFilter->text(), Qt::CaseInsensitive))
         {
             ld->GeoBox->addItem(loc->fullName());
@@ -406,6 +407,7 @@ bool LocationDialog::updateCity(CityOperation operation)
             //Add city to geoList...don't need to insert it alphabetically, since we always sort GeoList
             g = new GeoLocation(lng, lat, name, province, country, TZ, &KStarsData::Instance()->Rulebook[TZrule], Elevation);
             KStarsData::Instance()->getGeoList().append(g);
+            KStarsData::Instance()->cityIndex().insert(g);
         }
         break;
 
@@ -434,6 +436,7 @@ bool LocationDialog::updateCity(CityOperation operation)
                 return false;
             }
 
+            KStarsData::Instance()->cityIndex().remove(g);
             g->setName(name);
             g->setProvince(province);
             g->setCountry(country);
@@ -442,6 +445,7 @@ bool LocationDialog::updateCity(CityOperation operation)
             g->setTZ0(TZ);
             g->setTZRule(&KStarsData::Instance()->Rulebook[TZrule]);
             g->setElevation(height);
+            KStarsData::Instance()->cityIndex().insert(g);
 
         }
         break;
@@ -462,6 +466,7 @@ bool LocationDialog::updateCity(CityOperation operation)
 
             filteredCityList.removeOne(g);
             KStarsData::Instance()->getGeoList().removeOne(g);
+            KStarsData::Instance()->cityIndex().remove(g);
             delete g;
             g = nullptr;
         }
@@ -500,13 +505,10 @@ void LocationDialog::findCitiesNear(int lng, int lat)
     while (!filteredCityList.isEmpty())
         filteredCityList.takeFirst();
 
-    foreach (GeoLocation *loc, data->getGeoList())
+    for (GeoLocation *loc : data->cityIndex().within(lng, lat, 3))
     {
-        if ((abs(lng - int(loc->lng()->Degrees())) < 3) && (abs(lat - int(loc->lat()->Degrees())) < 3))
-        {
-            ld->GeoBox->addItem(loc->fullName());
-            filteredCityList.append(loc);
-        }
+        ld->GeoBox->addItem(loc->fullName());
+        filteredCityList.append(loc);
     }
 
     ld->GeoBox->sortItems();
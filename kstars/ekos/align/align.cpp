@@ -24,13 +24,16 @@
 #include "polaralignmentassistant.h"
 #include "remoteastrometryparser.h"
 #include "manualrotator.h"
+#include "incrementalsolver.h"
 
 // FITS
 #include "fitsviewer/fitsdata.h"
+#include "fitsviewer/imagememory.h"
 
 // Auxiliary
 #include "auxiliary/QProgressIndicator.h"
 #include "auxiliary/ksmessagebox.h"
+#include "auxiliary/tracer.h"
 #include "ekos/auxiliary/darkprocessor.h"
 #include "ekos/auxiliary/filtermanager.h"
 #include "ekos/auxiliary/stellarsolverprofileeditor.h"
@@ -45,6 +48,8 @@
 #include "kstarsdata.h"
 #include "skymapcomposite.h"
 #include "ekos/auxiliary/solverutils.h"
+#include "ekos/auxiliary/solverhintcache.h"
+#include "ekos/auxiliary/indexfilecache.h"
 #include "ekos/auxiliary/rotatorutils.h"
 
 // INDI
@@ -60,6 +65,7 @@
 #include <KActionCollection>
 #include <basedevice.h>
 #include <indicom.h>
+#include <algorithm>
 #include <memory>
 
 // Qt version calming
@@ -238,6 +244,8 @@ Align::Align(const QSharedPointer<ProfileInfo> &activeProfile) : m_ActiveProfile
         m_StellarSolverProfiles = getDefaultAlignOptionsProfiles();
 
     m_StellarSolver.reset(new StellarSolver());
+    m_IncrementalSolver.reset(new IncrementalSolver());
+    connect(&m_IncrementalWatcher, &QFutureWatcher<bool>::finished, this, &Align::incrementalStarsDetected);
     connect(m_StellarSolver.get(), &StellarSolver::logOutput, this, &Align::appendLogText);
 
     setupPolarAlignmentAssistant();
@@ -1146,6 +1154,9 @@ void Align::calculateFOV()
     if (m_PolarAlignmentAssistant != nullptr)
         m_PolarAlignmentAssistant->setEnabled(fovOK);
 
+    // Have the index files of the new field read before the next solve needs them
+    IndexFileCache::Instance()->warmUp(Options::astrometryIndexFolderList(), std::max(m_FOVWidth, m_FOVHeight));
+
     if (opsAstrometry->kcfg_AstrometryUseImageScale->isChecked())
     {
         int unitType = opsAstrometry->kcfg_AstrometryImageScaleUnits->currentIndex();
@@ -1589,6 +1600,7 @@ bool Align::captureAndSolve(bool initialCall)
             dynamic_cast<RemoteAstrometryParser *>(remoteParser.get())->setEnabled(true);
             dynamic_cast<RemoteAstrometryParser *>(remoteParser.get())->sendArgs(generateRemoteArgs(QSharedPointer<FITSData>()));
             solverTimer.start();
+            m_SolveTraceStart = Tracer::now();
         }
     }
 
@@ -1821,6 +1833,14 @@ void Align::startSolving()
     m_ScaleUsed = 0;
     m_RAUsed = 0;
     m_DECUsed = 0;
+    m_SolverHintUsed = false;
+    stopRacingSolvers();
+
+    if (solveIncrementally())
+        return;
+
+    const bool skipSolverHint = m_SkipSolverHint;
+    m_SkipSolverHint = false;
 
     if (solverModeButtonGroup->checkedId() == SOLVER_LOCAL)
     {
@@ -1977,6 +1997,34 @@ void Align::startSolving()
             }
             else
                 m_StellarSolver->setProperty("UsePosition", false);
+
+            // Only load the index file and healpix that solved this region last, instead of searching all of them
+            SolverHintCache::Hint hint;
+            if (Options::astrometryUseSolverHints() && m_UsedPosition && !skipSolverHint && m_Camera &&
+                    type == SSolver::SOLVER_STELLARSOLVER &&
+                    SolverHintCache().find(opticalTrain(), m_RAUsed, m_DECUsed, &hint))
+            {
+                const QStringList indexFiles = StellarSolver::getIndexFiles(Options::astrometryIndexFolderList(),
+                                               hint.index, hint.healpix);
+                if (!indexFiles.isEmpty())
+                {
+                    m_SolverHintUsed = true;
+                    m_StellarSolver->setIndexFilePaths(indexFiles);
+                    params.search_parity = static_cast<FITSImage::Parity>(hint.parity);
+                    m_StellarSolver->setParameters(params);
+
+                    if (m_UsedScale)
+                    {
+                        int binx = 1, biny = 1;
+                        m_Camera->getChip(useGuideHead ? ISD::CameraChip::GUIDE_CCD :
+                                          ISD::CameraChip::PRIMARY_CCD)->getBinning(&binx, &biny);
+                        m_StellarSolver->setSearchScale(hint.scale * binx * 0.95, hint.scale * binx * 1.05,
+                                                        SSolver::ARCSEC_PER_PIX);
+                    }
+                    qCDebug(KSTARS_EKOS_ALIGN) << "Solving with the stored hint of index" << hint.index
+                                               << "healpix" << hint.healpix;
+                }
+            }
         }
 
         if(Options::alignmentLogging())
@@ -2002,6 +2050,9 @@ void Align::startSolving()
 
         // Start solving process
         m_StellarSolver->start();
+
+        if (Options::astrometryRaceSolvers() && !m_SolveFromFile && type == SSolver::SOLVER_STELLARSOLVER)
+            startRacingSolvers(params, m_UsedScale, m_UsedPosition);
     }
     else
     {
@@ -2026,6 +2077,7 @@ void Align::startSolving()
 
     // Kick off timer
     solverTimer.start();
+    m_SolveTraceStart = Tracer::now();
 
     setState(ALIGN_PROGRESS);
     emit newStatus(state);
@@ -2036,6 +2088,26 @@ void Align::solverComplete()
     disconnect(m_StellarSolver.get(), &StellarSolver::ready, this, &Align::solverComplete);
     if(!m_StellarSolver->solvingDone() || m_StellarSolver->failed())
     {
+        // Let the racing solvers finish, one of them may still solve the image
+        if (!m_RacingSolvers.isEmpty() && state != ALIGN_ABORTED)
+        {
+            qCDebug(KSTARS_EKOS_ALIGN) << "Solver failed, waiting for" << m_RacingSolvers.size() << "racing solvers.";
+            m_RaceLost = true;
+            return;
+        }
+
+        // The region may need another index file or healpix than the stored one, so try them all on the same image
+        if (m_SolverHintUsed && state != ALIGN_ABORTED)
+        {
+            SolverHintCache cache;
+            cache.remove(opticalTrain(), m_RAUsed, m_DECUsed);
+            cache.save();
+            appendLogText(i18n("Solver failed with the index file that solved this region before. Retrying with all index files."));
+            m_SkipSolverHint = true;
+            startSolving();
+            return;
+        }
+
         if (matchPAHStage(PAA::PAH_FIRST_CAPTURE) ||
                 matchPAHStage(PAA::PAH_SECOND_CAPTURE) ||
                 matchPAHStage(PAA::PAH_THIRD_CAPTURE) ||
@@ -2053,14 +2125,204 @@ void Align::solverComplete()
     }
     else
     {
+        stopRacingSolvers();
         FITSImage::Solution solution = m_StellarSolver->getSolution();
         const bool eastToTheRight = solution.parity == FITSImage::POSITIVE ? false : true;
+        storeSolverHint(solution);
         solverFinished(solution.orientation, solution.ra, solution.dec, solution.pixscale, eastToTheRight);
     }
 }
 
+void Align::storeSolverHint(const FITSImage::Solution &solution)
+{
+    const int index = m_StellarSolver->getSolutionIndexNumber();
+    if (!Options::astrometryUseSolverHints() || m_SolveFromFile || !m_Camera || index < 0 || solution.pixscale <= 0)
+        return;
+
+    int binx = 1, biny = 1;
+    m_Camera->getChip(useGuideHead ? ISD::CameraChip::GUIDE_CCD : ISD::CameraChip::PRIMARY_CCD)->getBinning(&binx, &biny);
+
+    SolverHintCache::Hint hint;
+    hint.train = opticalTrain();
+    hint.ra = solution.ra;
+    hint.dec = solution.dec;
+    hint.index = index;
+    hint.healpix = m_StellarSolver->getSolutionHealpix();
+    hint.scale = solution.pixscale / std::max(binx, 1);
+    hint.parity = solution.parity;
+    hint.time = QDateTime::currentSecsSinceEpoch();
+
+    SolverHintCache cache;
+    cache.add(hint);
+    cache.save();
+}
+
+bool Align::solveIncrementally()
+{
+    m_SolvedIncrementally = false;
+    if (m_FullSolvePending)
+    {
+        m_FullSolvePending = false;
+        return false;
+    }
+    if (!Options::astrometryIncrementalSolve() || m_SolveFromFile || !matchPAHStage(PAA::PAH_IDLE) ||
+            !m_IncrementalSolver->isValid() || m_IncrementalTrain != opticalTrain() || m_IncrementalWatcher.isRunning())
+        return false;
+
+    if (!m_ImageData)
+        m_ImageData = m_AlignView->imageData();
+    if (!m_ImageData)
+        return false;
+
+    solverTimer.start();
+    m_SolveTraceStart = Tracer::now();
+    m_IncrementalStage = INCREMENTAL_SOLVE;
+    m_IncrementalData = m_ImageData;
+    m_IncrementalWatcher.setFuture(m_IncrementalData->findStars(ALGORITHM_SEP));
+    return true;
+}
+
+void Align::incrementalStarsDetected()
+{
+    const auto stage = m_IncrementalStage;
+    const QSharedPointer<FITSData> data = m_IncrementalData;
+    m_IncrementalStage = INCREMENTAL_IDLE;
+    m_IncrementalData.reset();
+
+    if (stage == INCREMENTAL_REFERENCE)
+    {
+        if (m_IncrementalWatcher.result() && m_IncrementalSolver->setReference(data, m_IncrementalReference))
+            m_IncrementalTrain = m_IncrementalReferenceTrain;
+        return;
+    }
+    // Stopped while detecting
+    if (stage != INCREMENTAL_SOLVE)
+        return;
+
+    IncrementalSolver::Solution solution;
+    IncrementalSolver::Transform transform;
+    m_IncrementalSolver->setEstimateRotation(Options::astrometryIncrementalRotation());
+    if (!m_IncrementalWatcher.result() || !m_IncrementalSolver->solve(data, &solution, &transform))
+    {
+        qCDebug(KSTARS_EKOS_ALIGN) << "Frame does not match the last solved frame, solving it.";
+        m_FullSolvePending = true;
+        startSolving();
+        return;
+    }
+
+    appendLogText(i18n("Solved from %1 stars of the last solved frame.", transform.matches));
+    m_SolvedIncrementally = true;
+    // Turns of the rotator measured this way are confirmed by the solver once the target is reached
+    if (Options::astrometryUseRotator() && !std::isnan(m_TargetPositionAngle) &&
+            solverModeButtonGroup->checkedId() == SOLVER_LOCAL)
+        m_VerifyRotation = true;
+    setState(ALIGN_PROGRESS);
+    emit newStatus(state);
+    solverFinished(solution.orientation, solution.ra, solution.dec, solution.pixscale, solution.eastToTheRight);
+}
+
+void Align::startRacingSolvers(const SSolver::Parameters &parameters, bool useScale, bool usePosition)
+{
+    if (!m_ImageData)
+        return;
+
+    typedef struct
+    {
+        SSolver::Parameters parameters;
+        bool useScale;
+        bool usePosition;
+    } Racer;
+
+    // The retries of solverFailed(), then the next profile with the same constraints
+    QVector<Racer> racers;
+    if (useScale)
+        racers.append({parameters, false, usePosition});
+    if (usePosition)
+        racers.append({parameters, useScale, false});
+    if (m_StellarSolverProfiles.size() > 1)
+        racers.append({m_StellarSolverProfiles.at((Options::solveOptionsProfile() + 1) % m_StellarSolverProfiles.size()),
+                       useScale, usePosition});
+
+    const int count = std::min<int>(racers.size(), std::clamp(Options::astrometryRacingSolvers(), 1, 2));
+    for (int i = 0; i < count; ++i)
+    {
+        QSharedPointer<SolverUtils> solver(new SolverUtils(racers[i].parameters, Options::astrometryTimeout()),
+                                           &QObject::deleteLater);
+        // m_FOVPixelScale is the scale of the binned pixels of the image
+        solver->useScale(racers[i].useScale && m_FOVPixelScale > 0, m_FOVPixelScale, m_FOVPixelScale);
+        solver->usePosition(racers[i].usePosition, m_RAUsed, m_DECUsed);
+
+        SolverUtils *racer = solver.data();
+        connect(racer, &SolverUtils::done, this, [this, racer](bool timedOut, bool success,
+                const FITSImage::Solution & solution, double elapsedSeconds)
+        {
+            racingSolverDone(racer, timedOut, success, solution, elapsedSeconds);
+        });
+        m_RacingSolvers.append(solver);
+        solver->runSolver(m_ImageData);
+
+        qCDebug(KSTARS_EKOS_ALIGN) << "Racing solver" << i + 1 << "with profile" << racers[i].parameters.listName
+                                   << "scale" << racers[i].useScale << "position" << racers[i].usePosition;
+    }
+}
+
+void Align::stopRacingSolvers()
+{
+    for (auto &solver : m_RacingSolvers)
+    {
+        disconnect(solver.data(), &SolverUtils::done, this, nullptr);
+        solver->abort();
+    }
+    m_RacingSolvers.clear();
+    m_RaceLost = false;
+}
+
+void Align::racingSolverDone(SolverUtils *solver, bool timedOut, bool success, const FITSImage::Solution &solution,
+                             double elapsedSeconds)
+{
+    auto racer = std::find_if(m_RacingSolvers.begin(), m_RacingSolvers.end(),
+                              [solver](const QSharedPointer<SolverUtils> &s)
+    {
+        return s.data() == solver;
+    });
+    if (racer == m_RacingSolvers.end())
+        return;
+    // Only deleted later, once out of its signal
+    m_RacingSolvers.erase(racer);
+
+    if (state != ALIGN_PROGRESS)
+    {
+        stopRacingSolvers();
+        return;
+    }
+
+    if (success)
+    {
+        disconnect(m_StellarSolver.get(), &StellarSolver::ready, this, &Align::solverComplete);
+        if (m_StellarSolver->isRunning())
+            m_StellarSolver->abort();
+        stopRacingSolvers();
+
+        appendLogText(i18n("Solved by a racing solver in %1 seconds.", QString::number(elapsedSeconds, 'f', 2)));
+        const bool eastToTheRight = solution.parity == FITSImage::POSITIVE ? false : true;
+        solverFinished(solution.orientation, solution.ra, solution.dec, solution.pixscale, eastToTheRight);
+        return;
+    }
+
+    qCDebug(KSTARS_EKOS_ALIGN) << "Racing solver" << (timedOut ? "timed out" : "failed") << "after" << elapsedSeconds
+                               << "seconds," << m_RacingSolvers.size() << "still running.";
+
+    // The StellarSolver failed before, and now all of them did
+    if (m_RacingSolvers.isEmpty() && m_RaceLost)
+    {
+        m_RaceLost = false;
+        solverComplete();
+    }
+}
+
 void Align::solverFinished(double orientation, double ra, double dec, double pixscale, bool eastToTheRight)
 {
+    Tracer::record("align", "Solve", m_SolveTraceStart);
     pi->stopAnimation();
     stopB->setEnabled(false);
     solveB->setEnabled(true);
@@ -2073,6 +2335,22 @@ void Align::solverFinished(double orientation, double ra, double dec, double pix
     if (elapsed > 0)
         appendLogText(i18n("Solver completed after %1 seconds.", QString::number(elapsed, 'f', 2)));
 
+    // The next frames of the field can be solved from the stars of this one
+    if (!m_SolvedIncrementally)
+    {
+        m_IncrementalSolver->clear();
+        m_IncrementalTrain.clear();
+        if (Options::astrometryIncrementalSolve() && !m_SolveFromFile && matchPAHStage(PAA::PAH_IDLE) && m_ImageData)
+        {
+            m_IncrementalStage = INCREMENTAL_REFERENCE;
+            m_IncrementalData = m_ImageData;
+            m_IncrementalReference = {ra, dec, orientation, pixscale, eastToTheRight};
+            m_IncrementalReferenceTrain = opticalTrain();
+            m_IncrementalWatcher.setFuture(m_IncrementalData->findStars(ALGORITHM_SEP));
+        }
+    }
+    m_SolvedIncrementally = false;
+
     m_AlignTimer.stop();
     if (solverModeButtonGroup->checkedId() == SOLVER_REMOTE && m_RemoteParserDevice && remoteParser.get())
     {
@@ -2341,6 +2619,7 @@ void Align::solverFinished(double orientation, double ra, double dec, double pix
 
 void Align::solverFailed()
 {
+    Tracer::record("align", "Solve", m_SolveTraceStart);
 
     // If failed-align logging is enabled, let's save the frame.
     if (Options::saveFailedAlignImages())
@@ -2457,6 +2736,8 @@ bool Align::checkIfRotationRequired()
                         emit newStatus(state); // Evoke 'updateProperty()' (where the same check is executed again)
                         return true;
                     }
+                    else if (verifyRotation())
+                        return true;
                     else
                     {
                         appendLogText(i18n("Camera position angle is within acceptable range."));
@@ -2499,9 +2780,34 @@ bool Align::checkIfRotationRequired()
     return false;
 }
 
+bool Align::verifyRotation()
+{
+    if (!m_VerifyRotation)
+        return false;
+    m_VerifyRotation = false;
+
+    if (!m_ImageData)
+        return false;
+
+    appendLogText(i18n("Verifying camera position angle with the solver..."));
+    m_FullSolvePending = true;
+    stopB->setEnabled(true);
+    pi->startAnimation();
+    setState(ALIGN_PROGRESS);
+    emit newStatus(state);
+    startSolving();
+    return true;
+}
+
 void Align::stop(Ekos::AlignState mode)
 {
     m_CaptureTimer.stop();
+    stopRacingSolvers();
+    m_VerifyRotation = false;
+    m_FullSolvePending = false;
+    // The frame being detected is left unsolved, while the reference is still set
+    if (m_IncrementalStage == INCREMENTAL_SOLVE)
+        m_IncrementalStage = INCREMENTAL_IDLE;
     if (solverModeButtonGroup->checkedId() == SOLVER_LOCAL)
         m_StellarSolver->abort();
     else if (solverModeButtonGroup->checkedId() == SOLVER_REMOTE && remoteParser)
@@ -2675,7 +2981,9 @@ void Align::updateProperty(INDI::Property prop)
                     {
                         m_wasSlewStarted = false;
                         //qCDebug(KSTARS_EKOS_ALIGN) << "## ALIGN_SYNCING --> setting slewStarted to FALSE";
-                        if (m_CurrentGotoMode == GOTO_SLEW)
+                        // A point of the mount model is done once it is synced, the model does not need it on target
+                        if (m_CurrentGotoMode == GOTO_SLEW &&
+                                !(m_MountModel && m_MountModel->isRunning() && Options::mountModelSyncOnce()))
                         {
                             Slew();
                             return;
@@ -3085,6 +3393,7 @@ bool Align::loadAndSlew(const QByteArray &image, const QString &extension)
     m_ImageData.clear();
     QSharedPointer<FITSData> data;
     data.reset(new FITSData(), &QObject::deleteLater);
+    ImageMemory::instance().setOwner(data.get(), ImageMemory::Align);
     data->loadFromBuffer(image, extension);
     m_AlignView->loadData(data);
     startSolving();
@@ -15,10 +15,12 @@
 #include "indi/indistd.h"
 #include "indi/indimount.h"
 #include "skypoint.h"
+#include "incrementalsolver.h"
 
 #include <QTime>
 #include <QTimer>
 #include <QElapsedTimer>
+#include <QFutureWatcher>
 #include <KConfigDialog>
 
 #if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
@@ -37,6 +39,7 @@ class FOV;
 class StarObject;
 class ProfileInfo;
 class RotatorSettings;
+class SolverUtils;
 
 namespace Ekos
 {
@@ -518,6 +521,13 @@ class Align : public QWidget, public Ui::Align
          */
         bool checkIfRotationRequired();
 
+        /**
+         * @brief verifyRotation Solves the last frame again with the solver once the rotator reached the position
+         * angle, if the incremental solver measured the turns of the rotator.
+         * @return true if the solver was started.
+         */
+        bool verifyRotation();
+
         // Settings
         QVariantMap getAllSettings() const;
         void setAllSettings(const QVariantMap &settings);
@@ -614,6 +624,34 @@ class Align : public QWidget, public Ui::Align
         void setupOpticalTrainManager();
         void refreshOpticalTrain();
 
+        /**
+         * @brief Store the index file, healpix, scale and parity of a solve of the mount position, to start the next
+         * solves of the same region of the sky with them.
+         */
+        void storeSolverHint(const FITSImage::Solution &solution);
+
+        /**
+         * @brief Start detecting the stars of the captured frame to match them with those of the last solved frame, if
+         * it is of the same field and train. The frame is solved by incrementalStarsDetected().
+         * @return true if the detection was started.
+         */
+        bool solveIncrementally();
+
+        /**
+         * @brief Solve the frame or set the reference of the incremental solver once its stars are detected. Frames that
+         * don't match are solved by the solver.
+         */
+        void incrementalStarsDetected();
+
+        /**
+         * @brief Start solvers racing the StellarSolver on the image being solved, with the constraints solverFailed()
+         * would drop next or another profile. The first solver to succeed wins and the others are aborted.
+         */
+        void startRacingSolvers(const SSolver::Parameters &parameters, bool useScale, bool usePosition);
+        void stopRacingSolvers();
+        void racingSolverDone(SolverUtils *solver, bool timedOut, bool success, const FITSImage::Solution &solution,
+                              double elapsedSeconds);
+
         ////////////////////////////////////////////////////////////////////
         /// Settings
         ////////////////////////////////////////////////////////////////////
@@ -757,6 +795,10 @@ class Align : public QWidget, public Ui::Align
         BlindState useBlindScale {BLIND_IDLE};
         /// Was solving with position off used?
         BlindState useBlindPosition {BLIND_IDLE};
+        /// Was the solve started with the index file and healpix of a stored solver hint?
+        bool m_SolverHintUsed {false};
+        /// Retry the image with all index files after a hinted solve failed
+        bool m_SkipSolverHint {false};
 
         // FOV
         double m_CameraPixelWidth { -1 };
@@ -798,11 +840,39 @@ class Align : public QWidget, public Ui::Align
 
         /// Keep track of how long the solver is running
         QElapsedTimer solverTimer;
+        /// Start of the solve on the clock of the Tracer
+        qint64 m_SolveTraceStart { 0 };
 
         // The StellarSolver
         std::unique_ptr<StellarSolver> m_StellarSolver;
         // StellarSolver Profiles
         QList<SSolver::Parameters> m_StellarSolverProfiles;
+        // Solves the frames of the field solved last without the solver
+        std::unique_ptr<IncrementalSolver> m_IncrementalSolver;
+        // Train of the last solved frame
+        QString m_IncrementalTrain;
+        // Detects the stars of m_IncrementalData off the GUI thread
+        QFutureWatcher<bool> m_IncrementalWatcher;
+        QSharedPointer<FITSData> m_IncrementalData;
+        // What the detected stars are for, and the solution and train of the reference
+        enum
+        {
+            INCREMENTAL_IDLE,
+            INCREMENTAL_SOLVE,
+            INCREMENTAL_REFERENCE
+        } m_IncrementalStage { INCREMENTAL_IDLE };
+        IncrementalSolver::Solution m_IncrementalReference {0, 0, 0, 0, false};
+        QString m_IncrementalReferenceTrain;
+        // Was the solution in process found by the incremental solver?
+        bool m_SolvedIncrementally { false };
+        // Was the rotator turned from a position angle found by the incremental solver?
+        bool m_VerifyRotation { false };
+        // Must the next solve be done by the solver, to confirm the position angle reached?
+        bool m_FullSolvePending { false };
+        // Solvers racing m_StellarSolver with other constraints or profiles
+        QList<QSharedPointer<SolverUtils>> m_RacingSolvers;
+        // Did m_StellarSolver fail while racing solvers were still running?
+        bool m_RaceLost { false };
 
         /// Have we slewed?
         bool m_wasSlewStarted { false };
@@ -13,9 +13,9 @@
 #include <math.h>
 #include "Options.h"
 #include "fitsviewer/fitsdata.h"
+#include "auxiliary/executors.h"
 
 #include <QPainter>
-#include <QtConcurrent>
 
 AlignView::AlignView(QWidget *parent, FITSMode mode, FITSScale filter) : FITSView(parent, mode, filter)
 {
@@ -43,7 +43,7 @@ bool AlignView::injectWCS(double orientation, double ra, double dec, double pixs
         if (wcsWatcher.isRunning() == false && m_ImageData->getWCSState() == FITSData::Idle)
         {
             // Load WCS async
-            QFuture<bool> future = QtConcurrent::run(m_ImageData.data(), &FITSData::loadWCS);
+            QFuture<bool> future = Executors::run(Executors::Interactive, &FITSData::loadWCS, m_ImageData.data());
             wcsWatcher.setFuture(future);
         }
         return true;
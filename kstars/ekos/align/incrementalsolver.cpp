@@ -0,0 +1,451 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "incrementalsolver.h"
+
+#include "fitsviewer/fitsdata.h"
+#include "fitsviewer/fitsstardetector.h"
+#include "skypoint.h"
+#include <ekos_align_debug.h>
+
+#include <QHash>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Ekos
+{
+
+namespace
+{
+// Stars used to fit the transform, the brightest of each frame
+constexpr int FIT_STARS = IncrementalSolver::MATCH_STARS * 5;
+// Ratio of scales beyond which frames were not taken with the same scale
+constexpr double MAX_SCALE_CHANGE = 0.02;
+// Pixels from the center at which the directions of the axes are sampled
+constexpr double SAMPLE_DISTANCE = 100.0;
+// Bins of the histogram of the rotations voted for by star pairs, over half a turn
+constexpr int ROTATION_BINS = 180;
+// Pixels below which the angle of a pair of stars is too uncertain to vote
+constexpr double MIN_PAIR_LENGTH = 10 * IncrementalSolver::MATCH_TOLERANCE;
+// Radians within which an estimated rotation is the same as one tried anyway
+constexpr double SAME_ROTATION = 2.0 * M_PI / 180.0;
+
+constexpr double ARCSEC_TO_RADIANS = M_PI / (180.0 * 3600.0);
+
+double toRadians(double degrees)
+{
+    return degrees * M_PI / 180.0;
+}
+
+double toDegrees(double radians)
+{
+    return radians * 180.0 / M_PI;
+}
+
+QPointF apply(const IncrementalSolver::Transform &t, const QPointF &p)
+{
+    const double c = t.scale * std::cos(t.rotation), s = t.scale * std::sin(t.rotation);
+    return QPointF(c * p.x() - s * p.y(), s * p.x() + c * p.y()) + t.translation;
+}
+
+// Least-squares shift, rotation and scale from the points of from to those of to
+IncrementalSolver::Transform fit(const QVector<QPointF> &from, const QVector<QPointF> &to)
+{
+    QPointF fromCenter, toCenter;
+    for (int i = 0; i < from.size(); ++i)
+    {
+        fromCenter += from[i];
+        toCenter += to[i];
+    }
+    fromCenter /= from.size();
+    toCenter /= to.size();
+
+    double a = 0, b = 0, norm = 0;
+    for (int i = 0; i < from.size(); ++i)
+    {
+        const QPointF p = from[i] - fromCenter, q = to[i] - toCenter;
+        a += p.x() * q.x() + p.y() * q.y();
+        b += p.x() * q.y() - p.y() * q.x();
+        norm += p.x() * p.x() + p.y() * p.y();
+    }
+
+    IncrementalSolver::Transform t;
+    t.scale = norm > 0 ? std::hypot(a, b) / norm : 1.0;
+    t.rotation = std::atan2(b, a);
+    t.translation = toCenter - apply(t, fromCenter);
+    t.matches = from.size();
+    t.rms = 0;
+    return t;
+}
+
+// Pairs each star with the closest reference star within the tolerance, once transformed, and fits them
+IncrementalSolver::Transform refine(const IncrementalSolver::Transform &initial, const QVector<QPointF> &stars,
+                                    const QVector<QPointF> &reference)
+{
+    QVector<QPointF> from, to;
+    for (const auto &star : stars)
+    {
+        const QPointF p = apply(initial, star);
+        double closest = IncrementalSolver::MATCH_TOLERANCE * IncrementalSolver::MATCH_TOLERANCE;
+        int match = -1;
+        for (int j = 0; j < reference.size(); ++j)
+        {
+            const QPointF d = reference[j] - p;
+            const double distance = d.x() * d.x() + d.y() * d.y();
+            if (distance <= closest)
+            {
+                closest = distance;
+                match = j;
+            }
+        }
+        if (match >= 0)
+        {
+            from.append(star);
+            to.append(reference[match]);
+        }
+    }
+
+    if (from.size() < IncrementalSolver::MIN_MATCHES)
+    {
+        IncrementalSolver::Transform none = initial;
+        none.matches = from.size();
+        return none;
+    }
+
+    IncrementalSolver::Transform t = fit(from, to);
+    double squares = 0;
+    for (int i = 0; i < from.size(); ++i)
+    {
+        const QPointF d = apply(t, from[i]) - to[i];
+        squares += d.x() * d.x() + d.y() * d.y();
+    }
+    t.rms = std::sqrt(squares / from.size());
+    return t;
+}
+
+// Gnomonic projection of ra and dec in radians about the tangent point ra0 and dec0, in radians
+bool project(double ra, double dec, double ra0, double dec0, double *xi, double *eta)
+{
+    const double cosc = std::sin(dec0) * std::sin(dec) + std::cos(dec0) * std::cos(dec) * std::cos(ra - ra0);
+    if (cosc <= 0)
+        return false;
+    *xi = std::cos(dec) * std::sin(ra - ra0) / cosc;
+    *eta = (std::cos(dec0) * std::sin(dec) - std::sin(dec0) * std::cos(dec) * std::cos(ra - ra0)) / cosc;
+    return true;
+}
+
+void deproject(double xi, double eta, double ra0, double dec0, double *ra, double *dec)
+{
+    *dec = std::asin((std::sin(dec0) + eta * std::cos(dec0)) / std::sqrt(1 + xi * xi + eta * eta));
+    *ra = ra0 + std::atan2(xi, std::cos(dec0) - eta * std::sin(dec0));
+}
+
+// Position angle of the second point from the first, in radians E of N
+double positionAngle(double ra1, double dec1, double ra2, double dec2)
+{
+    return std::atan2(std::sin(ra2 - ra1) * std::cos(dec2),
+                      std::cos(dec1) * std::sin(dec2) - std::sin(dec1) * std::cos(dec2) * std::cos(ra2 - ra1));
+}
+
+typedef struct
+{
+    double length;
+    // Radians, in [0, PI)
+    double angle;
+} StarPair;
+
+// The pairs of stars long enough to vote, shortest first
+QVector<StarPair> starPairs(const QVector<QPointF> &stars)
+{
+    QVector<StarPair> pairs;
+    for (int i = 0; i < stars.size(); ++i)
+    {
+        for (int j = i + 1; j < stars.size(); ++j)
+        {
+            const QPointF d = stars[j] - stars[i];
+            const double length = std::hypot(d.x(), d.y());
+            if (length < MIN_PAIR_LENGTH)
+                continue;
+            double angle = std::atan2(d.y(), d.x());
+            if (angle < 0)
+                angle += M_PI;
+            if (angle >= M_PI)
+                angle -= M_PI;
+            pairs.append({length, angle});
+        }
+    }
+    std::sort(pairs.begin(), pairs.end(), [](const StarPair & a, const StarPair & b)
+    {
+        return a.length < b.length;
+    });
+    return pairs;
+}
+
+double normalizeDegrees(double degrees)
+{
+    degrees = std::fmod(degrees, 360.0);
+    if (degrees > 180)
+        degrees -= 360;
+    else if (degrees <= -180)
+        degrees += 360;
+    return degrees;
+}
+}
+
+void IncrementalSolver::clear()
+{
+    m_Stars.clear();
+}
+
+QVector<QPointF> IncrementalSolver::stars(const QSharedPointer<FITSData> &data)
+{
+    QList<Edge *> edges = data->getStarCenters();
+    std::sort(edges.begin(), edges.end(), [](const Edge * a, const Edge * b)
+    {
+        return a->sum > b->sum;
+    });
+
+    QVector<QPointF> stars;
+    stars.reserve(edges.size());
+    for (const auto &edge : edges)
+        stars.append(QPointF(edge->x, edge->y));
+    return stars;
+}
+
+bool IncrementalSolver::setReference(const QSharedPointer<FITSData> &data, const Solution &solution)
+{
+    clear();
+    if (data.isNull())
+        return false;
+
+    // The frame may carry the approximate WCS of the camera driver, so always place it with the solution
+    data->injectWCS(solution.orientation, solution.ra, solution.dec, solution.pixscale, solution.eastToTheRight);
+    if (!data->loadWCS())
+        return false;
+
+    const QPointF center(data->width() / 2.0, data->height() / 2.0);
+    SkyPoint c, x, y;
+    if (!data->pixelToWCS(center, c) || !data->pixelToWCS(center + QPointF(SAMPLE_DISTANCE, 0), x) ||
+            !data->pixelToWCS(center + QPointF(0, SAMPLE_DISTANCE), y))
+        return false;
+
+    const double ra0 = c.ra0().radians(), dec0 = c.dec0().radians();
+    double xiX, etaX, xiY, etaY;
+    if (!project(x.ra0().radians(), x.dec0().radians(), ra0, dec0, &xiX, &etaX) ||
+            !project(y.ra0().radians(), y.dec0().radians(), ra0, dec0, &xiY, &etaY))
+        return false;
+
+    const QVector<QPointF> detected = stars(data);
+    if (detected.size() < MIN_MATCHES)
+        return false;
+
+    constexpr double scale = 1.0 / (SAMPLE_DISTANCE * ARCSEC_TO_RADIANS);
+    const double toStandard[4] = {xiX * scale, xiY * scale, etaX * scale, etaY * scale};
+    Solution reference = solution;
+    reference.ra = c.ra0().Degrees();
+    reference.dec = c.dec0().Degrees();
+    setReference(detected, QSize(data->width(), data->height()), reference, toStandard);
+    return true;
+}
+
+void IncrementalSolver::setReference(const QVector<QPointF> &stars, const QSize &size, const Solution &solution,
+                                     const double toStandard[4])
+{
+    m_Stars = stars;
+    m_Size = size;
+    m_Solution = solution;
+    std::copy(toStandard, toStandard + 4, m_ToStandard);
+}
+
+bool IncrementalSolver::match(const QVector<QPointF> &stars, Transform *result) const
+{
+    if (m_Stars.size() < MIN_MATCHES || stars.size() < MIN_MATCHES)
+        return false;
+
+    const QVector<QPointF> reference = m_Stars.mid(0, MATCH_STARS), candidates = stars.mid(0, MATCH_STARS);
+
+    // Vote for the shift of every pair of bright stars, as is and turned by half a turn after a meridian flip, and
+    // turned as the pairs of stars of the frame were after a move of the rotator, either way
+    QVector<double> rotations {0.0, M_PI};
+    double estimate = 0;
+    if (m_EstimateRotation && estimateRotation(stars, &estimate) && estimate > SAME_ROTATION &&
+            estimate < M_PI - SAME_ROTATION)
+        rotations << estimate << estimate + M_PI;
+
+    Transform best {1, 0, QPointF(), 0, 0};
+    for (const double rotation : rotations)
+    {
+        Transform t {1, rotation, QPointF(), 0, 0};
+        QHash<QPair<int, int>, QVector<QPointF>> votes;
+        for (const auto &r : reference)
+        {
+            for (const auto &c : candidates)
+            {
+                const QPointF shift = r - apply(t, c);
+                votes[qMakePair(static_cast<int>(std::floor(shift.x() / MATCH_TOLERANCE)),
+                                static_cast<int>(std::floor(shift.y() / MATCH_TOLERANCE)))].append(shift);
+            }
+        }
+
+        for (auto vote = votes.cbegin(); vote != votes.cend(); ++vote)
+        {
+            if (vote.value().size() < 2)
+                continue;
+            // Shifts close to a cell border fall in its neighbours
+            QPointF sum;
+            int count = 0;
+            for (int dx = -1; dx <= 1; ++dx)
+            {
+                for (int dy = -1; dy <= 1; ++dy)
+                {
+                    const auto neighbour = votes.constFind(qMakePair(vote.key().first + dx, vote.key().second + dy));
+                    if (neighbour == votes.cend())
+                        continue;
+                    for (const auto &shift : neighbour.value())
+                    {
+                        sum += shift;
+                        count++;
+                    }
+                }
+            }
+            if (count > best.matches)
+            {
+                best = t;
+                best.translation = sum / count;
+                best.matches = count;
+            }
+        }
+    }
+
+    if (best.matches < MIN_MATCHES / 2)
+        return false;
+
+    const QVector<QPointF> fitReference = m_Stars.mid(0, FIT_STARS), fitStars = stars.mid(0, FIT_STARS);
+    Transform t = best;
+    for (int i = 0; i < 3 && t.matches >= MIN_MATCHES / 2; ++i)
+        t = refine(t, fitStars, fitReference);
+
+    qCDebug(KSTARS_EKOS_ALIGN) << "Incremental solver matched" << t.matches << "stars, rms" << t.rms << "px, scale" << t.scale
+                               << "rotation" << toDegrees(t.rotation);
+
+    if (t.matches < MIN_MATCHES || t.rms > MAX_RMS || std::fabs(t.scale - 1) > MAX_SCALE_CHANGE)
+        return false;
+
+    *result = t;
+    return true;
+}
+
+bool IncrementalSolver::estimateRotation(const QVector<QPointF> &stars, double *rotation, int *votes) const
+{
+    if (m_Stars.size() < MIN_MATCHES || stars.size() < MIN_MATCHES)
+        return false;
+
+    const QVector<StarPair> reference = starPairs(m_Stars.mid(0, ROTATION_STARS));
+    const QVector<StarPair> candidates = starPairs(stars.mid(0, ROTATION_STARS));
+
+    // Angles are voted for twice over, so that the mean of a bin wraps around half a turn
+    QVector<int> counts(ROTATION_BINS, 0);
+    QVector<double> sines(ROTATION_BINS, 0), cosines(ROTATION_BINS, 0);
+    for (const auto &c : candidates)
+    {
+        auto r = std::lower_bound(reference.cbegin(), reference.cend(), c.length - MATCH_TOLERANCE,
+                                  [](const StarPair & pair, double length)
+        {
+            return pair.length < length;
+        });
+        for (; r != reference.cend() && r->length <= c.length + MATCH_TOLERANCE; ++r)
+        {
+            double difference = r->angle - c.angle;
+            if (difference < 0)
+                difference += M_PI;
+            const int bin = static_cast<int>(difference / M_PI * ROTATION_BINS) % ROTATION_BINS;
+            counts[bin]++;
+            // Longer pairs have the more accurate angles
+            sines[bin] += c.length * std::sin(2 * difference);
+            cosines[bin] += c.length * std::cos(2 * difference);
+        }
+    }
+
+    // Differences close to a bin border fall in its neighbours
+    int best = -1, bestVotes = 0;
+    for (int bin = 0; bin < ROTATION_BINS; ++bin)
+    {
+        int sum = 0;
+        for (int d = -1; d <= 1; ++d)
+            sum += counts[(bin + d + ROTATION_BINS) % ROTATION_BINS];
+        if (sum > bestVotes)
+        {
+            best = bin;
+            bestVotes = sum;
+        }
+    }
+
+    if (votes)
+        *votes = bestVotes;
+    if (best < 0 || bestVotes < MIN_ROTATION_VOTES)
+        return false;
+
+    double sine = 0, cosine = 0;
+    for (int d = -1; d <= 1; ++d)
+    {
+        sine += sines[(best + d + ROTATION_BINS) % ROTATION_BINS];
+        cosine += cosines[(best + d + ROTATION_BINS) % ROTATION_BINS];
+    }
+    double angle = std::atan2(sine, cosine) / 2;
+    if (angle < 0)
+        angle += M_PI;
+    *rotation = angle;
+
+    qCDebug(KSTARS_EKOS_ALIGN) << "Star pairs turned by" << toDegrees(angle) << "degrees with" << bestVotes << "votes";
+    return true;
+}
+
+bool IncrementalSolver::solve(const QSharedPointer<FITSData> &data, Solution *result, Transform *transform) const
+{
+    if (!isValid() || data.isNull())
+        return false;
+    return solve(stars(data), QSize(data->width(), data->height()), result, transform);
+}
+
+bool IncrementalSolver::solve(const QVector<QPointF> &stars, const QSize &size, Solution *result,
+                              Transform *transform) const
+{
+    Transform t;
+    if (!isValid() || !match(stars, &t))
+        return false;
+
+    // Places points of the frame on the sky through the reference
+    const QPointF referenceCenter(m_Size.width() / 2.0, m_Size.height() / 2.0);
+    const double ra0 = toRadians(m_Solution.ra), dec0 = toRadians(m_Solution.dec);
+    auto toSky = [&](const QPointF & point, double * ra, double * dec)
+    {
+        const QPointF d = point - referenceCenter;
+        const double xi = (m_ToStandard[0] * d.x() + m_ToStandard[1] * d.y()) * ARCSEC_TO_RADIANS;
+        const double eta = (m_ToStandard[2] * d.x() + m_ToStandard[3] * d.y()) * ARCSEC_TO_RADIANS;
+        deproject(xi, eta, ra0, dec0, ra, dec);
+    };
+
+    const QPointF center(size.width() / 2.0, size.height() / 2.0);
+    double ra, dec, upRA, upDec, referenceUpRA, referenceUpDec;
+    toSky(apply(t, center), &ra, &dec);
+    toSky(apply(t, center + QPointF(0, SAMPLE_DISTANCE)), &upRA, &upDec);
+    toSky(referenceCenter + QPointF(0, SAMPLE_DISTANCE), &referenceUpRA, &referenceUpDec);
+
+    // The orientation turns as the position angle of the same axis of the frame
+    const double turn = positionAngle(ra, dec, upRA, upDec) - positionAngle(ra0, dec0, referenceUpRA, referenceUpDec);
+
+    result->ra = std::fmod(toDegrees(ra) + 360.0, 360.0);
+    result->dec = toDegrees(dec);
+    result->orientation = normalizeDegrees(m_Solution.orientation + toDegrees(turn));
+    result->pixscale = m_Solution.pixscale * t.scale;
+    result->eastToTheRight = m_Solution.eastToTheRight;
+    if (transform)
+        *transform = t;
+    return true;
+}
+
+}
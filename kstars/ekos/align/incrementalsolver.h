@@ -0,0 +1,137 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QPointF>
+#include <QSharedPointer>
+#include <QSize>
+#include <QVector>
+
+class FITSData;
+
+namespace Ekos
+{
+
+/**
+ * @class IncrementalSolver
+ * @short Solves frames of a field that was just plate solved, by matching their stars with those of the solved frame.
+ *
+ * The stars of the solved frame, the reference, are placed on the sky with its WCS. The stars of a new frame are
+ * matched with them, as shifted and possibly rotated by half a turn after a meridian flip or by the angle the pairs of
+ * stars of both frames turned after a move of the rotator, and the shift and rotation are refined by a least-squares fit
+ * of all matched stars. The center, orientation and scale of the new frame follow
+ * from the fit and the reference WCS, in milliseconds instead of the seconds of a blind solve.
+ *
+ * Frames of other fields, scales or cameras don't match, and must be solved by the solver.
+ */
+class IncrementalSolver
+{
+    public:
+        typedef struct
+        {
+            // J2000 center, in degrees
+            double ra;
+            double dec;
+            // Degrees E of N of the image up
+            double orientation;
+            // Arcseconds per pixel
+            double pixscale;
+            bool eastToTheRight;
+        } Solution;
+
+        // Shift and rotation from the pixels of a frame to those of the reference, and how well it fits
+        typedef struct
+        {
+            double scale;
+            // Radians
+            double rotation;
+            QPointF translation;
+            int matches;
+            // Pixels
+            double rms;
+        } Transform;
+
+        // Stars used to find the transform, the brightest of each frame.
+        static constexpr int MATCH_STARS = 40;
+        // Stars that must match for a frame to be solved.
+        static constexpr int MIN_MATCHES = 8;
+        // Pixels from its reference star within which a star matches.
+        static constexpr double MATCH_TOLERANCE = 3.0;
+        // Pixels of residual beyond which the fit is rejected.
+        static constexpr double MAX_RMS = 1.5;
+        // Stars whose pairs vote for the rotation of a frame, the brightest of each frame.
+        static constexpr int ROTATION_STARS = 25;
+        // Votes for the rotation of a frame for it to be trusted.
+        static constexpr int MIN_ROTATION_VOTES = MIN_MATCHES * (MIN_MATCHES - 1) / 4;
+
+        /**
+         * @brief setReference Places the stars of a solved frame on the sky with its WCS, which is injected from the
+         * solution if the frame has none. The stars must have been detected with FITSData::findStars().
+         * @return false if there are too few stars or no WCS.
+         */
+        bool setReference(const QSharedPointer<FITSData> &data, const Solution &solution);
+
+        /**
+         * @brief setReference Sets the stars of a solved frame, brightest first, in pixels.
+         * @param toStandard Arcseconds East and North on the plane tangent to the sky at the center per pixel of x
+         * and y from the center, as {dXi/dx, dXi/dy, dEta/dx, dEta/dy}.
+         */
+        void setReference(const QVector<QPointF> &stars, const QSize &size, const Solution &solution,
+                          const double toStandard[4]);
+
+        void clear();
+        bool isValid() const
+        {
+            return !m_Stars.isEmpty();
+        }
+
+        /**
+         * @brief solve Solves a frame of the reference field from its stars, which must have been detected with
+         * FITSData::findStars().
+         * @return false if the stars don't match those of the reference.
+         */
+        bool solve(const QSharedPointer<FITSData> &data, Solution *result, Transform *transform = nullptr) const;
+
+        /**
+         * @brief solve Solves a frame of the given size from its stars, brightest first, in pixels.
+         */
+        bool solve(const QVector<QPointF> &stars, const QSize &size, Solution *result, Transform *transform = nullptr) const;
+
+        /**
+         * @brief stars The stars detected in a frame, brightest first, in pixels.
+         */
+        static QVector<QPointF> stars(const QSharedPointer<FITSData> &data);
+
+        /**
+         * @brief match Finds the transform from the pixels of stars to those of the reference stars.
+         */
+        bool match(const QVector<QPointF> &stars, Transform *result) const;
+
+        /**
+         * @brief estimateRotation Finds how far a frame turned from the reference, as after a move of the rotator, from
+         * the position angles of the pairs of its brightest stars. Every pair of the frame votes for the difference of
+         * its angle with those of the pairs of the reference of the same length, and the difference most voted for wins.
+         * @param rotation Radians, from the frame to the reference, in [0, PI) as pairs have no direction.
+         * @return false if no difference got enough votes.
+         */
+        bool estimateRotation(const QVector<QPointF> &stars, double *rotation, int *votes = nullptr) const;
+
+        // Whether match() tries the rotation estimated from star pairs, besides none and half a turn
+        void setEstimateRotation(bool enabled)
+        {
+            m_EstimateRotation = enabled;
+        }
+
+    private:
+        QVector<QPointF> m_Stars;
+        QSize m_Size;
+        Solution m_Solution {0, 0, 0, 0, false};
+        double m_ToStandard[4] {0, 0, 0, 0};
+        bool m_EstimateRotation { true };
+};
+
+}
@@ -8,6 +8,7 @@
 
 #include "align.h"
 #include "kstars.h"
+#include "Options.h"
 #include "kstarsdata.h"
 #include "flagcomponent.h"
 #include "ksnotification.h"
@@ -22,6 +23,8 @@
 
 #include <ekos_align_debug.h>
 
+#include <algorithm>
+
 #define AL_FORMAT_VERSION 1.0
 
 // Qt version calming
@@ -519,6 +522,62 @@ int MountModel::findNextAlignmentPointAfter(int currentSpot)
         return -1;
 }
 
+// Of the pending points, those that fill the sky left between the points done at least half as well as the best of
+// them are worth about as much to the model, so the nearest of them to the telescope is the quickest to add.
+int MountModel::findMostInformativeAlignmentPoint(int firstPending)
+{
+    auto pointAt = [this](int row, SkyPoint * point)
+    {
+        QTableWidgetItem *raCell = alignTable->item(row, 0);
+        QTableWidgetItem *deCell = alignTable->item(row, 1);
+        if (!raCell || !deCell)
+            return false;
+        *point = SkyPoint(dms::fromString(raCell->text(), false), dms::fromString(deCell->text(), true));
+        return true;
+    };
+
+    QVector<SkyPoint> done;
+    for (int i = 0; i < firstPending; i++)
+    {
+        SkyPoint point;
+        if (pointAt(i, &point))
+            done.append(point);
+    }
+    if (done.isEmpty())
+        return -1;
+
+    QVector<int> rows;
+    QVector<double> gaps, slews;
+    for (int i = firstPending; i < alignTable->rowCount(); i++)
+    {
+        SkyPoint point;
+        if (!pointAt(i, &point))
+            continue;
+
+        double gap = 180;
+        for (auto &donePoint : done)
+            gap = std::min(gap, donePoint.angularDistanceTo(&point).Degrees());
+        rows.append(i);
+        gaps.append(gap);
+        slews.append(telescopeCoord.angularDistanceTo(&point).Degrees());
+    }
+    if (rows.isEmpty())
+        return -1;
+
+    const double largestGap = *std::max_element(gaps.constBegin(), gaps.constEnd());
+    int index = -1;
+    double bestSlew = 360;
+    for (int i = 0; i < rows.size(); i++)
+    {
+        if (gaps[i] >= largestGap / 2 && slews[i] < bestSlew)
+        {
+            index = rows[i];
+            bestSlew = slews[i];
+        }
+    }
+    return index;
+}
+
 void MountModel::slotWizardAlignmentPoints()
 {
     int points = alignPtNum->value();
@@ -1087,6 +1146,16 @@ void MountModel::finishAlignmentPoint(bool solverSucceeded)
 
         if (currentAlignmentPoint < alignTable->rowCount())
         {
+            if (Options::mountModelAdaptiveOrder())
+            {
+                const int next = findMostInformativeAlignmentPoint(currentAlignmentPoint);
+                if (next > currentAlignmentPoint)
+                {
+                    swapAlignPoints(next, currentAlignmentPoint);
+                    if (previewShowing)
+                        updatePreviewAlignPoints();
+                }
+            }
             startAlignmentPoint();
         }
         else
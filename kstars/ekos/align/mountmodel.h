@@ -87,6 +87,7 @@ class MountModel : public QDialog, public Ui::mountModel
         void updatePreviewAlignPoints();
         int findNextAlignmentPointAfter(int currentSpot);
         int findClosestAlignmentPointToTelescope();
+        int findMostInformativeAlignmentPoint(int firstPending);
         void swapAlignPoints(int firstPt, int secondPt);
 
         /**
@@ -2,6 +2,7 @@
 #include "opsastrometryindexfiles.h"
 
 #include "align.h"
+#include "ekos/auxiliary/indexfilecache.h"
 #include "kstars.h"
 #include "ksutils.h"
 #include "Options.h"
@@ -181,6 +182,9 @@ void OpsAstrometryIndexFiles::slotUpdate()
 
     QStringList astrometryDataDirs = Options::astrometryIndexFolderList();
 
+    // Index files may have been downloaded or removed
+    IndexFileCache::Instance()->warmUp(astrometryDataDirs, fov_check);
+
     bool allDirsSelected = (indexLocations->currentIndex() == 0 && astrometryDataDirs.count() > 1);
     bool folderIsWriteable;
 
@@ -345,12 +345,26 @@ bool PolarAlignmentAssistant::detectStarsPAHRefresh(QList<Edge> *stars, int num,
     QVariantMap settings;
     settings["optionsProfileIndex"] = Options::solveOptionsProfile();
     settings["optionsProfileGroup"] = static_cast<int>(Ekos::AlignProfiles);
+    settings["SEARCH_RADIUS"] = Options::pAHRefreshTrackRadius();
     m_ImageData->setSourceExtractorSettings(settings);
 
+    // Track the stars of the previous frame, and detect those of the whole frame now and then to anchor them
+    const bool track = Options::pAHRefreshTrackStars() && !m_RefreshSeeds.isEmpty() &&
+                       m_FramesSinceFullDetection < Options::pAHRefreshFullDetectionInterval();
     QElapsedTimer timer;
-    m_ImageData->findStars(ALGORITHM_SEP).waitForFinished();
+    timer.start();
+    if (track)
+    {
+        m_ImageData->findStars(m_RefreshSeeds).waitForFinished();
+        m_FramesSinceFullDetection++;
+    }
+    else
+    {
+        m_ImageData->findStars(ALGORITHM_SEP).waitForFinished();
+        m_FramesSinceFullDetection = 0;
+    }
 
-    QString debugString = QString("PAA Refresh: Detected %1 stars (%2s)")
+    QString debugString = QString("PAA Refresh: %1 %2 stars (%3s)").arg(track ? "Tracked" : "Detected")
                           .arg(m_ImageData->getStarCenters().size()).arg(timer.elapsed() / 1000.0, 5, 'f', 3);
     qCDebug(KSTARS_EKOS_ALIGN) << debugString;
 
@@ -391,6 +405,7 @@ bool PolarAlignmentAssistant::detectStarsPAHRefresh(QList<Edge> *stars, int num,
     qCDebug(KSTARS_EKOS_ALIGN) << debugString;
 
     detectedStars.clear();
+    m_RefreshSeeds = *stars;
 
     return stars->count();
 }
@@ -543,6 +558,8 @@ void PolarAlignmentAssistant::processPAHRefresh()
                     debugString = QString("PAA Refresh(%1): Didn't find the user's star").arg(refreshIteration);
                     qCDebug(KSTARS_EKOS_ALIGN) << debugString;
                 }
+                // The tracked stars may have drifted off, detect them all in the next frame
+                m_RefreshSeeds.clear();
             }
         }
         else
@@ -550,6 +567,7 @@ void PolarAlignmentAssistant::processPAHRefresh()
             debugString = QString("PAA Refresh(%1): Too few stars detected (%2)").arg(refreshIteration).arg(stars.size());
             qCDebug(KSTARS_EKOS_ALIGN) << debugString;
             emit updatedErrorsChanged(-1, -1, -1);
+            m_RefreshSeeds.clear();
         }
     }
     // Finally start the next capture
@@ -1026,6 +1044,8 @@ void PolarAlignmentAssistant::startPAHRefreshProcess()
     refreshIteration = 0;
     imageNumber = 0;
     m_NumHealpixFailures = 0;
+    m_RefreshSeeds.clear();
+    m_FramesSinceFullDetection = 0;
 
     setPAHStage(PAH_REFRESH);
     polarAlignWidget->updatePAHStage(m_PAHStage);
@@ -243,6 +243,10 @@ class PolarAlignmentAssistant : public QWidget, public Ui::PolarAlignmentAssista
         int refreshIteration { 0 };
         // Incremented on every image received.
         int imageNumber { 0 };
+        // Stars of the previous refresh frame, found again around their positions in the next one.
+        QList<Edge> m_RefreshSeeds;
+        // Refresh frames since the stars of a whole frame were detected.
+        int m_FramesSinceFullDetection { 0 };
         StarCorrespondence starCorrespondencePAH;
 
         // Class used to estimate alignment error.
@@ -63,7 +63,7 @@ constexpr int MAX_SCROLL_VALUE = 10000;
 constexpr double halfTimelineHeight = 0.35;
 
 // These are initialized in initStatsPlot when the graphs are added.
-// They index the graphs in statsPlot, e.g. statsPlot->graph(HFR_GRAPH)->addData(...)
+// They index the graphs in statsPlot, e.g. statsSeries[HFR_GRAPH].append(...)
 int HFR_GRAPH = -1;
 int TEMPERATURE_GRAPH = -1;
 int FOCUS_POSITION_GRAPH = -1;
@@ -72,6 +72,7 @@ int MEDIAN_GRAPH = -1;
 int ECCENTRICITY_GRAPH = -1;
 int NUMSTARS_GRAPH = -1;
 int SKYBG_GRAPH = -1;
+int LATENCY_GRAPH = -1;
 int SNR_GRAPH = -1;
 int RA_GRAPH = -1;
 int DEC_GRAPH = -1;
@@ -110,6 +111,10 @@ const QBrush progress4Brush(Qt::darkGreen, Qt::SolidPattern);
 const QBrush stoppedBrush(Qt::yellow, Qt::SolidPattern);
 const QBrush stopped2Brush(Qt::darkYellow, Qt::SolidPattern);
 
+// The lines of the periodic samples, whose series are stored as columns in the binary logs.
+// The other lines are events, kept as text in the binary logs.
+const QStringList sampleCommands = {"GuideStats", "GuideLatency", "TargetDistance", "MountCoords"};
+
 // Utility to checks if a file exists and is not a directory.
 bool fileExists(const QString &path)
 {
@@ -514,6 +519,7 @@ void Analyze::initInputSelection()
     inputCombo->addItem(i18n("Current Session"));
     inputCombo->addItem(i18n("Read from File"));
     inputCombo->addItem(i18n("Set alternative image-file base directory"));
+    inputCombo->addItem(i18n("Browse Sessions"));
     inputValue->setText("");
     connect(inputCombo, static_cast<void (QComboBox::*)(int)>(&QComboBox::activated), this, [&](int index)
     {
@@ -538,22 +544,11 @@ void Analyze::initInputSelection()
             // translates "analyze" to "analyse" for the English UK locale, but we need to keep it ".analyze"
             // because that's what how the files are named.
             QUrl inputURL = QFileDialog::getOpenFileUrl(this, i18nc("@title:window", "Select input file"), dirPath,
-                            QString("Analyze %1 (*.analyze);;%2").arg(i18n("Log")).arg(i18n("All Files (*)")));
+                            QString("Analyze %1 (*.analyze *.analyzeb);;%2").arg(i18n("Log")).arg(i18n("All Files (*)")));
             if (inputURL.isEmpty())
                 return;
             dirPath = QUrl(inputURL.url(QUrl::RemoveFilename));
-
-            reset();
-            inputValue->setText(inputURL.fileName());
-
-            // If we do this after the readData call below, it would animate the sequence.
-            runtimeDisplay = false;
-
-            maxXValue = readDataFromFile(inputURL.toLocalFile());
-            checkForMissingSchedulerJobEnd(maxXValue);
-            plotStart = 0;
-            plotWidth = maxXValue + 5;
-            replot();
+            displayFile(inputURL);
         }
         else if (index == 2)
         {
@@ -572,9 +567,46 @@ void Analyze::initInputSelection()
             else
                 inputCombo->setCurrentIndex(1);
         }
+        else if (index == 3)
+        {
+            if (sessionBrowser.isNull())
+            {
+                sessionBrowser = new SessionBrowser(this);
+                connect(sessionBrowser, &SessionBrowser::openLog, this, [this](const QString & filename)
+                {
+                    inputCombo->setCurrentIndex(1);
+                    displayFile(QUrl::fromLocalFile(filename));
+                });
+            }
+            sessionBrowser->setDirectory(dirPath.toLocalFile());
+            sessionBrowser->show();
+            sessionBrowser->raise();
+
+            // This is not a destiation either.
+            if (runtimeDisplay)
+                inputCombo->setCurrentIndex(0);
+            else
+                inputCombo->setCurrentIndex(1);
+        }
     });
 }
 
+// Display an .analyze log, or its binary variant, instead of the current session.
+void Analyze::displayFile(const QUrl &inputURL)
+{
+    reset();
+    inputValue->setText(inputURL.fileName());
+
+    // If we do this after the readData call below, it would animate the sequence.
+    runtimeDisplay = false;
+
+    maxXValue = readDataFromFile(inputURL.toLocalFile());
+    checkForMissingSchedulerJobEnd(maxXValue);
+    plotStart = 0;
+    plotWidth = maxXValue + 5;
+    replot();
+}
+
 void Analyze::setupKeyboardShortcuts(QWidget *plot)
 {
     // Shortcuts defined: https://doc.qt.io/archives/qt-4.8/qkeysequence.html#standard-shortcuts
@@ -721,12 +753,12 @@ void Analyze::addGuideStats(double raDrift, double decDrift, int raPulse, int de
                 (time - lastCaptureRmsTime > MAX_GUIDE_STATS_GAP))
         {
             // this is the first sample in a series with a gap behind us.
-            statsPlot->graph(CAPTURE_RMS_GRAPH)->addData(lastCaptureRmsTime + .0001, qQNaN());
-            statsPlot->graph(CAPTURE_RMS_GRAPH)->addData(time - .0001, qQNaN());
+            statsSeries[CAPTURE_RMS_GRAPH].append(lastCaptureRmsTime + .0001, qQNaN());
+            statsSeries[CAPTURE_RMS_GRAPH].append(time - .0001, qQNaN());
             captureRms->resetFilter();
         }
         const double rmsC = captureRms->newSample(raDrift, decDrift);
-        statsPlot->graph(CAPTURE_RMS_GRAPH)->addData(time, rmsC);
+        statsSeries[CAPTURE_RMS_GRAPH].append(time, rmsC);
         lastCaptureRmsTime = time;
     }
 
@@ -738,12 +770,12 @@ void Analyze::addGuideStatsInternal(double raDrift, double decDrift, double raPu
                                     double numStars, double skyBackground,
                                     double drift, double rms, double time)
 {
-    statsPlot->graph(RA_GRAPH)->addData(time, raDrift);
-    statsPlot->graph(DEC_GRAPH)->addData(time, decDrift);
-    statsPlot->graph(RA_PULSE_GRAPH)->addData(time, raPulse);
-    statsPlot->graph(DEC_PULSE_GRAPH)->addData(time, decPulse);
-    statsPlot->graph(DRIFT_GRAPH)->addData(time, drift);
-    statsPlot->graph(RMS_GRAPH)->addData(time, rms);
+    statsSeries[RA_GRAPH].append(time, raDrift);
+    statsSeries[DEC_GRAPH].append(time, decDrift);
+    statsSeries[RA_PULSE_GRAPH].append(time, raPulse);
+    statsSeries[DEC_PULSE_GRAPH].append(time, decPulse);
+    statsSeries[DRIFT_GRAPH].append(time, drift);
+    statsSeries[RMS_GRAPH].append(time, rms);
 
     // Set the SNR axis' maximum to 95% of the way up from the middle to the top.
     if (!qIsNaN(snr))
@@ -753,9 +785,9 @@ void Analyze::addGuideStatsInternal(double raDrift, double decDrift, double raPu
     if (!qIsNaN(numStars))
         numStarsMax = std::max(numStars, static_cast<double>(numStarsMax));
 
-    statsPlot->graph(SNR_GRAPH)->addData(time, snr);
-    statsPlot->graph(NUMSTARS_GRAPH)->addData(time, numStars);
-    statsPlot->graph(SKYBG_GRAPH)->addData(time, skyBackground);
+    statsSeries[SNR_GRAPH].append(time, snr);
+    statsSeries[NUMSTARS_GRAPH].append(time, numStars);
+    statsSeries[SKYBG_GRAPH].append(time, skyBackground);
 }
 
 void Analyze::addTemperature(double temperature, double time)
@@ -763,12 +795,12 @@ void Analyze::addTemperature(double temperature, double time)
     // The HFR corresponds to the last capture
     // If there is no temperature sensor, focus sends a large negative value.
     if (temperature > -200)
-        statsPlot->graph(TEMPERATURE_GRAPH)->addData(time, temperature);
+        statsSeries[TEMPERATURE_GRAPH].append(time, temperature);
 }
 
 void Analyze::addFocusPosition(double focusPosition, double time)
 {
-    statsPlot->graph(FOCUS_POSITION_GRAPH)->addData(time, focusPosition);
+    statsSeries[FOCUS_POSITION_GRAPH].append(time, focusPosition);
 }
 
 void Analyze::addTargetDistance(double targetDistance, double time)
@@ -778,10 +810,10 @@ void Analyze::addTargetDistance(double targetDistance, double time)
             previousCaptureStartedTime < previousCaptureCompletedTime &&
             previousCaptureCompletedTime <= time)
     {
-        statsPlot->graph(TARGET_DISTANCE_GRAPH)->addData(previousCaptureStartedTime - .0001, qQNaN());
-        statsPlot->graph(TARGET_DISTANCE_GRAPH)->addData(previousCaptureStartedTime, targetDistance);
-        statsPlot->graph(TARGET_DISTANCE_GRAPH)->addData(previousCaptureCompletedTime, targetDistance);
-        statsPlot->graph(TARGET_DISTANCE_GRAPH)->addData(previousCaptureCompletedTime + .0001, qQNaN());
+        statsSeries[TARGET_DISTANCE_GRAPH].append(previousCaptureStartedTime - .0001, qQNaN());
+        statsSeries[TARGET_DISTANCE_GRAPH].append(previousCaptureStartedTime, targetDistance);
+        statsSeries[TARGET_DISTANCE_GRAPH].append(previousCaptureCompletedTime, targetDistance);
+        statsSeries[TARGET_DISTANCE_GRAPH].append(previousCaptureCompletedTime + .0001, qQNaN());
     }
 }
 
@@ -790,25 +822,25 @@ void Analyze::addHFR(double hfr, int numCaptureStars, int median, double eccentr
                      double time, double startTime)
 {
     // The HFR corresponds to the last capture
-    statsPlot->graph(HFR_GRAPH)->addData(startTime - .0001, qQNaN());
-    statsPlot->graph(HFR_GRAPH)->addData(startTime, hfr);
-    statsPlot->graph(HFR_GRAPH)->addData(time, hfr);
-    statsPlot->graph(HFR_GRAPH)->addData(time + .0001, qQNaN());
-
-    statsPlot->graph(NUM_CAPTURE_STARS_GRAPH)->addData(startTime - .0001, qQNaN());
-    statsPlot->graph(NUM_CAPTURE_STARS_GRAPH)->addData(startTime, numCaptureStars);
-    statsPlot->graph(NUM_CAPTURE_STARS_GRAPH)->addData(time, numCaptureStars);
-    statsPlot->graph(NUM_CAPTURE_STARS_GRAPH)->addData(time + .0001, qQNaN());
-
-    statsPlot->graph(MEDIAN_GRAPH)->addData(startTime - .0001, qQNaN());
-    statsPlot->graph(MEDIAN_GRAPH)->addData(startTime, median);
-    statsPlot->graph(MEDIAN_GRAPH)->addData(time, median);
-    statsPlot->graph(MEDIAN_GRAPH)->addData(time + .0001, qQNaN());
-
-    statsPlot->graph(ECCENTRICITY_GRAPH)->addData(startTime - .0001, qQNaN());
-    statsPlot->graph(ECCENTRICITY_GRAPH)->addData(startTime, eccentricity);
-    statsPlot->graph(ECCENTRICITY_GRAPH)->addData(time, eccentricity);
-    statsPlot->graph(ECCENTRICITY_GRAPH)->addData(time + .0001, qQNaN());
+    statsSeries[HFR_GRAPH].append(startTime - .0001, qQNaN());
+    statsSeries[HFR_GRAPH].append(startTime, hfr);
+    statsSeries[HFR_GRAPH].append(time, hfr);
+    statsSeries[HFR_GRAPH].append(time + .0001, qQNaN());
+
+    statsSeries[NUM_CAPTURE_STARS_GRAPH].append(startTime - .0001, qQNaN());
+    statsSeries[NUM_CAPTURE_STARS_GRAPH].append(startTime, numCaptureStars);
+    statsSeries[NUM_CAPTURE_STARS_GRAPH].append(time, numCaptureStars);
+    statsSeries[NUM_CAPTURE_STARS_GRAPH].append(time + .0001, qQNaN());
+
+    statsSeries[MEDIAN_GRAPH].append(startTime - .0001, qQNaN());
+    statsSeries[MEDIAN_GRAPH].append(startTime, median);
+    statsSeries[MEDIAN_GRAPH].append(time, median);
+    statsSeries[MEDIAN_GRAPH].append(time + .0001, qQNaN());
+
+    statsSeries[ECCENTRICITY_GRAPH].append(startTime - .0001, qQNaN());
+    statsSeries[ECCENTRICITY_GRAPH].append(startTime, eccentricity);
+    statsSeries[ECCENTRICITY_GRAPH].append(time, eccentricity);
+    statsSeries[ECCENTRICITY_GRAPH].append(time + .0001, qQNaN());
 
     medianMax = std::max(median, medianMax);
     numCaptureStarsMax = std::max(numCaptureStars, numCaptureStarsMax);
@@ -819,18 +851,53 @@ void Analyze::addHFR(double hfr, int numCaptureStars, int median, double eccentr
 void Analyze::addMountCoords(double ra, double dec, double az,
                              double alt, int pierSide, double ha, double time)
 {
-    statsPlot->graph(MOUNT_RA_GRAPH)->addData(time, ra);
-    statsPlot->graph(MOUNT_DEC_GRAPH)->addData(time, dec);
-    statsPlot->graph(MOUNT_HA_GRAPH)->addData(time, ha);
-    statsPlot->graph(AZ_GRAPH)->addData(time, az);
-    statsPlot->graph(ALT_GRAPH)->addData(time, alt);
-    statsPlot->graph(PIER_SIDE_GRAPH)->addData(time, double(pierSide));
+    statsSeries[MOUNT_RA_GRAPH].append(time, ra);
+    statsSeries[MOUNT_DEC_GRAPH].append(time, dec);
+    statsSeries[MOUNT_HA_GRAPH].append(time, ha);
+    statsSeries[AZ_GRAPH].append(time, az);
+    statsSeries[ALT_GRAPH].append(time, alt);
+    statsSeries[PIER_SIDE_GRAPH].append(time, double(pierSide));
 }
 
 // Read a .analyze file, and setup all the graphics.
+// The periodic samples of a log are stored in the binary variant of the log, which is written
+// next to it the first time it is read, and loaded instead of parsing the samples the next times.
+// The other lines of the log are still processed, in order, from the binary variant.
 double Analyze::readDataFromFile(const QString &filename)
 {
     double lastTime = 10;
+    QByteArray events;
+    const QHash<QString, TimeSeries *> series = binaryLogSeries();
+
+    auto processEvents = [&]()
+    {
+        for (const auto &line : events.split('\n'))
+        {
+            const double time = processInputLine(QString::fromUtf8(line));
+            if (time > lastTime)
+                lastTime = time;
+        }
+    };
+
+    if (BinaryLog::isBinaryLog(filename))
+    {
+        if (BinaryLog::read(filename, QFileInfo(), &lastTime, series, &events))
+            processEvents();
+        else
+            qCWarning(KSTARS_EKOS_ANALYZE) << "Could not read binary log" << filename;
+        return lastTime;
+    }
+
+    // The log of the current session is still being written.
+    const QFileInfo source(filename);
+    const bool useBinaryLog = filename != logFilename;
+    const QString binaryFilename = source.dir().filePath(source.completeBaseName() + "." + BinaryLog::Suffix);
+    if (useBinaryLog && BinaryLog::read(binaryFilename, source, &lastTime, series, &events))
+    {
+        processEvents();
+        return lastTime;
+    }
+
     QFile inputFile(filename);
     if (inputFile.open(QIODevice::ReadOnly))
     {
@@ -841,12 +908,48 @@ double Analyze::readDataFromFile(const QString &filename)
             double time = processInputLine(line);
             if (time > lastTime)
                 lastTime = time;
+            if (useBinaryLog && !sampleCommands.contains(line.section(QLatin1Char(','), 0, 0)))
+                events.append(line.toUtf8()).append('\n');
         }
         inputFile.close();
+
+        if (useBinaryLog)
+        {
+            QHash<QString, const TimeSeries *> samples;
+            for (auto it = series.cbegin(); it != series.cend(); ++it)
+                samples.insert(it.key(), it.value());
+            BinaryLog::write(binaryFilename, source, lastTime, samples, events);
+        }
     }
     return lastTime;
 }
 
+QHash<QString, TimeSeries *> Analyze::binaryLogSeries()
+{
+    // These are only added by the sampleCommands lines.
+    return
+    {
+        {"guideRA", &statsSeries[RA_GRAPH]},
+        {"guideDEC", &statsSeries[DEC_GRAPH]},
+        {"guideRAPulse", &statsSeries[RA_PULSE_GRAPH]},
+        {"guideDECPulse", &statsSeries[DEC_PULSE_GRAPH]},
+        {"guideDrift", &statsSeries[DRIFT_GRAPH]},
+        {"guideRMS", &statsSeries[RMS_GRAPH]},
+        {"guideSNR", &statsSeries[SNR_GRAPH]},
+        {"guideNumStars", &statsSeries[NUMSTARS_GRAPH]},
+        {"guideSkyBg", &statsSeries[SKYBG_GRAPH]},
+        {"captureRMS", &statsSeries[CAPTURE_RMS_GRAPH]},
+        {"guideLatency", &statsSeries[LATENCY_GRAPH]},
+        {"targetDistance", &statsSeries[TARGET_DISTANCE_GRAPH]},
+        {"mountRA", &statsSeries[MOUNT_RA_GRAPH]},
+        {"mountDEC", &statsSeries[MOUNT_DEC_GRAPH]},
+        {"mountHA", &statsSeries[MOUNT_HA_GRAPH]},
+        {"mountAz", &statsSeries[AZ_GRAPH]},
+        {"mountAlt", &statsSeries[ALT_GRAPH]},
+        {"mountPierSide", &statsSeries[PIER_SIDE_GRAPH]}
+    };
+}
+
 // Process an input line read from a .analyze file.
 double Analyze::processInputLine(const QString &line)
 {
@@ -1061,6 +1164,19 @@ double Analyze::processInputLine(const QString &line)
             return 0;
         processGuideStats(time, ra, dec, raPulse, decPulse, snr, skyBg, numStars, true);
     }
+    else if ((list[0] == "GuideLatency") && list.size() == 5)
+    {
+        const double starFound = QString(list[2]).toDouble(&ok);
+        if (!ok)
+            return 0;
+        const double pulseSent = QString(list[3]).toDouble(&ok);
+        if (!ok)
+            return 0;
+        const double pulseAcknowledged = QString(list[4]).toDouble(&ok);
+        if (!ok)
+            return 0;
+        processGuideLatency(time, starFound, pulseSent, pulseAcknowledged, true);
+    }
     else if ((list[0] == "Temperature") && list.size() == 3)
     {
         const double temperature = QString(list[2]).toDouble(&ok);
@@ -1496,20 +1612,18 @@ void Analyze::displayGuideGraphics(double start, double end, double *raRMS,
                                    double *decRMS, double *totalRMS, int *numSamples)
 {
     resetGraphicsPlot();
-    auto ra = statsPlot->graph(RA_GRAPH)->data()->findBegin(start);
-    auto dec = statsPlot->graph(DEC_GRAPH)->data()->findBegin(start);
-    auto raEnd = statsPlot->graph(RA_GRAPH)->data()->findEnd(end);
-    auto decEnd = statsPlot->graph(DEC_GRAPH)->data()->findEnd(end);
+    const TimeSeries &raSeries = statsSeries[RA_GRAPH];
+    const TimeSeries &decSeries = statsSeries[DEC_GRAPH];
+    int ra = raSeries.findBegin(start);
+    int dec = decSeries.findBegin(start);
     int num = 0;
     double raSquareErrorSum = 0, decSquareErrorSum = 0;
-    while (ra != raEnd && dec != decEnd &&
-            ra->mainKey() < end && dec->mainKey() < end &&
-            ra != statsPlot->graph(RA_GRAPH)->data()->constEnd() &&
-            dec != statsPlot->graph(DEC_GRAPH)->data()->constEnd() &&
-            ra->mainKey() < end && dec->mainKey() < end)
-    {
-        const double raVal = ra->mainValue();
-        const double decVal = dec->mainValue();
+    while (ra >= 0 && dec >= 0 &&
+            ra < raSeries.size() && dec < decSeries.size() &&
+            raSeries.time(ra) < end && decSeries.time(dec) < end)
+    {
+        const double raVal = raSeries.value(ra);
+        const double decVal = decSeries.value(dec);
         graphicsPlot->graph(GUIDER_GRAPHICS)->addData(raVal, decVal);
         if (!qIsNaN(raVal) && !qIsNaN(decVal))
         {
@@ -1940,6 +2054,7 @@ void Analyze::replot(bool adjustSlider)
     timelinePlot->yAxis->setRange(0, LAST_Y);
 
     statsPlot->xAxis->setRange(plotStart, plotStart + plotWidth);
+    plotStatsSeries();
 
     // Rescale any automatic y-axes.
     if (statsPlot->isVisible())
@@ -1979,6 +2094,13 @@ void Analyze::replot(bool adjustSlider)
     updateStatsValues();
 }
 
+void Analyze::plotStatsSeries()
+{
+    const int pixels = statsPlot->axisRect()->width();
+    for (int i = 0; i < statsSeries.size(); ++i)
+        statsSeries[i].plot(statsPlot->graph(i), plotStart, plotStart + plotWidth, pixels);
+}
+
 void Analyze::statsYZoom(double zoomAmount)
 {
     auto axis = activeYAxis;
@@ -2006,23 +2128,23 @@ namespace
 // Pass in a function that converts the double graph value to a string
 // for the value box.
 template<typename Func>
-void updateStat(double time, QLineEdit *valueBox, QCPGraph *graph, Func func, bool useLastRealVal = false)
+void updateStat(double time, QLineEdit *valueBox, const TimeSeries &series, Func func, bool useLastRealVal = false)
 {
-    auto begin = graph->data()->findBegin(time);
+    const int begin = series.findBegin(time);
     double timeDiffThreshold = 10000000.0;
-    if ((begin != graph->data()->constEnd()) &&
-            (fabs(begin->mainKey() - time) < timeDiffThreshold))
+    if ((begin >= 0) &&
+            (fabs(series.time(begin) - time) < timeDiffThreshold))
     {
-        double foundVal = begin->mainValue();
+        double foundVal = series.value(begin);
         valueBox->setDisabled(false);
         if (qIsNaN(foundVal))
         {
-            int index = graph->findBegin(time);
+            int index = begin;
             const double MAX_TIME_DIFF = 600;
             while (useLastRealVal && index >= 0)
             {
-                const double val = graph->data()->at(index)->mainValue();
-                const double t = graph->data()->at(index)->mainKey();
+                const double val = series.value(index);
+                const double t = series.time(index);
                 if (time - t > MAX_TIME_DIFF)
                     break;
                 if (!qIsNaN(val))
@@ -2051,21 +2173,22 @@ void Analyze::updateStatsValues()
     auto d1Fcn = [](double d) -> QString { return QString::number(d, 'f', 1); };
     // HFR, numCaptureStars, median & eccentricity are the only ones to use the last real value,
     // that is, it keeps those values from the last exposure.
-    updateStat(time, hfrOut, statsPlot->graph(HFR_GRAPH), d2Fcn, true);
-    updateStat(time, eccentricityOut, statsPlot->graph(ECCENTRICITY_GRAPH), d2Fcn, true);
-    updateStat(time, skyBgOut, statsPlot->graph(SKYBG_GRAPH), d1Fcn);
-    updateStat(time, snrOut, statsPlot->graph(SNR_GRAPH), d1Fcn);
-    updateStat(time, raOut, statsPlot->graph(RA_GRAPH), d2Fcn);
-    updateStat(time, decOut, statsPlot->graph(DEC_GRAPH), d2Fcn);
-    updateStat(time, driftOut, statsPlot->graph(DRIFT_GRAPH), d2Fcn);
-    updateStat(time, rmsOut, statsPlot->graph(RMS_GRAPH), d2Fcn);
-    updateStat(time, rmsCOut, statsPlot->graph(CAPTURE_RMS_GRAPH), d2Fcn);
-    updateStat(time, azOut, statsPlot->graph(AZ_GRAPH), d1Fcn);
-    updateStat(time, altOut, statsPlot->graph(ALT_GRAPH), d2Fcn);
-    updateStat(time, temperatureOut, statsPlot->graph(TEMPERATURE_GRAPH), d2Fcn);
+    updateStat(time, hfrOut, statsSeries[HFR_GRAPH], d2Fcn, true);
+    updateStat(time, eccentricityOut, statsSeries[ECCENTRICITY_GRAPH], d2Fcn, true);
+    updateStat(time, skyBgOut, statsSeries[SKYBG_GRAPH], d1Fcn);
+    updateStat(time, snrOut, statsSeries[SNR_GRAPH], d1Fcn);
+    updateStat(time, latencyOut, statsSeries[LATENCY_GRAPH], d1Fcn);
+    updateStat(time, raOut, statsSeries[RA_GRAPH], d2Fcn);
+    updateStat(time, decOut, statsSeries[DEC_GRAPH], d2Fcn);
+    updateStat(time, driftOut, statsSeries[DRIFT_GRAPH], d2Fcn);
+    updateStat(time, rmsOut, statsSeries[RMS_GRAPH], d2Fcn);
+    updateStat(time, rmsCOut, statsSeries[CAPTURE_RMS_GRAPH], d2Fcn);
+    updateStat(time, azOut, statsSeries[AZ_GRAPH], d1Fcn);
+    updateStat(time, altOut, statsSeries[ALT_GRAPH], d2Fcn);
+    updateStat(time, temperatureOut, statsSeries[TEMPERATURE_GRAPH], d2Fcn);
 
     auto asFcn = [](double d) -> QString { return QString("%1\"").arg(d, 0, 'f', 0); };
-    updateStat(time, targetDistanceOut, statsPlot->graph(TARGET_DISTANCE_GRAPH), asFcn, true);
+    updateStat(time, targetDistanceOut, statsSeries[TARGET_DISTANCE_GRAPH], asFcn, true);
 
     auto hmsFcn = [](double d) -> QString
     {
@@ -2074,9 +2197,9 @@ void Analyze::updateStatsValues()
         return QString("%1:%2:%3").arg(ra.hour()).arg(ra.minute()).arg(ra.second());
         //return ra.toHMSString();
     };
-    updateStat(time, mountRaOut, statsPlot->graph(MOUNT_RA_GRAPH), hmsFcn);
+    updateStat(time, mountRaOut, statsSeries[MOUNT_RA_GRAPH], hmsFcn);
     auto dmsFcn = [](double d) -> QString { dms dec; dec.setD(d); return dec.toDMSString(); };
-    updateStat(time, mountDecOut, statsPlot->graph(MOUNT_DEC_GRAPH), dmsFcn);
+    updateStat(time, mountDecOut, statsSeries[MOUNT_DEC_GRAPH], dmsFcn);
     auto haFcn = [](double d) -> QString
     {
         dms ha;
@@ -2091,21 +2214,21 @@ void Analyze::updateStatsValues()
         return QString("%1%2:%3").arg(sgn).arg(ha.hour(), 2, 10, z)
         .arg(ha.minute(), 2, 10, z);
     };
-    updateStat(time, mountHaOut, statsPlot->graph(MOUNT_HA_GRAPH), haFcn);
+    updateStat(time, mountHaOut, statsSeries[MOUNT_HA_GRAPH], haFcn);
 
     auto intFcn = [](double d) -> QString { return QString::number(d, 'f', 0); };
-    updateStat(time, numStarsOut, statsPlot->graph(NUMSTARS_GRAPH), intFcn);
-    updateStat(time, raPulseOut, statsPlot->graph(RA_PULSE_GRAPH), intFcn);
-    updateStat(time, decPulseOut, statsPlot->graph(DEC_PULSE_GRAPH), intFcn);
-    updateStat(time, numCaptureStarsOut, statsPlot->graph(NUM_CAPTURE_STARS_GRAPH), intFcn, true);
-    updateStat(time, medianOut, statsPlot->graph(MEDIAN_GRAPH), intFcn, true);
-    updateStat(time, focusPositionOut, statsPlot->graph(FOCUS_POSITION_GRAPH), intFcn);
+    updateStat(time, numStarsOut, statsSeries[NUMSTARS_GRAPH], intFcn);
+    updateStat(time, raPulseOut, statsSeries[RA_PULSE_GRAPH], intFcn);
+    updateStat(time, decPulseOut, statsSeries[DEC_PULSE_GRAPH], intFcn);
+    updateStat(time, numCaptureStarsOut, statsSeries[NUM_CAPTURE_STARS_GRAPH], intFcn, true);
+    updateStat(time, medianOut, statsSeries[MEDIAN_GRAPH], intFcn, true);
+    updateStat(time, focusPositionOut, statsSeries[FOCUS_POSITION_GRAPH], intFcn);
 
     auto pierFcn = [](double d) -> QString
     {
         return d == 0.0 ? "W->E" : d == 1.0 ? "E->W" : "?";
     };
-    updateStat(time, pierSideOut, statsPlot->graph(PIER_SIDE_GRAPH), pierFcn);
+    updateStat(time, pierSideOut, statsSeries[PIER_SIDE_GRAPH], pierFcn);
 }
 
 void Analyze::initStatsCheckboxes()
@@ -2116,6 +2239,7 @@ void Analyze::initStatsCheckboxes()
     eccentricityCB->setChecked(Options::analyzeEccentricity());
     numStarsCB->setChecked(Options::analyzeNumStars());
     skyBgCB->setChecked(Options::analyzeSkyBg());
+    latencyCB->setChecked(Options::analyzeGuideLatency());
     snrCB->setChecked(Options::analyzeSNR());
     temperatureCB->setChecked(Options::analyzeTemperature());
     focusPositionCB->setChecked(Options::focusPosition());
@@ -2501,6 +2625,10 @@ void Analyze::initStatsPlot()
     QCPAxis *skyBgAxis = newStatsYAxis(shortName);
     SKYBG_GRAPH = initGraphAndCB(statsPlot, skyBgAxis, QCPGraph::lsStepRight, Qt::darkYellow, "Sky Background Brightness",
                                  shortName, skyBgCB, Options::setAnalyzeSkyBg, skyBgOut);
+    shortName = "Latency";
+    QCPAxis *latencyAxis = newStatsYAxis(shortName, 0, 500);
+    LATENCY_GRAPH = initGraphAndCB(statsPlot, latencyAxis, QCPGraph::lsStepRight, QColor(135, 206, 235), // sky blue
+                                   "Guide Latency (ms)", shortName, latencyCB, Options::setAnalyzeGuideLatency, latencyOut);
 
     shortName = "temp";
     QCPAxis *temperatureAxis = newStatsYAxis(shortName, -40, 40);
@@ -2576,6 +2704,8 @@ void Analyze::initStatsPlot()
     PIER_SIDE_GRAPH = initGraphAndCB(statsPlot, pierSideAxis, QCPGraph::lsLine, Qt::darkRed, "Mount Pier Side", shortName,
                                      pierSideCB, Options::setAnalyzePierSide, pierSideOut);
 
+    statsSeries.resize(statsPlot->graphCount());
+
     // This makes mouseMove only get called when a button is pressed.
     statsPlot->setMouseTracking(false);
 
@@ -2604,6 +2734,8 @@ void Analyze::reset()
 
     for (int i = 0; i < statsPlot->graphCount(); ++i)
         statsPlot->graph(i)->data()->clear();
+    for (auto &oneSeries : statsSeries)
+        oneSeries.clear();
     statsPlot->clearItems();
 
     for (int i = 0; i < timelinePlot->graphCount(); ++i)
@@ -2630,6 +2762,7 @@ void Analyze::reset()
 
     numStarsOut->setText("");
     skyBgOut->setText("");
+    latencyOut->setText("");
     snrOut->setText("");
     temperatureOut->setText("");
     focusPositionOut->setText("");
@@ -3529,6 +3662,28 @@ void Analyze::processGuideStats(double time, double raError, double decError,
         replot();
 }
 
+void Analyze::guideLatency(double starFound, double pulseSent, double pulseAcknowledged)
+{
+    saveMessage("GuideLatency", QString("%1,%2,%3")
+                .arg(QString::number(starFound, 'f', 1), QString::number(pulseSent, 'f', 1),
+                     QString::number(pulseAcknowledged, 'f', 1)));
+
+    if (runtimeDisplay)
+        processGuideLatency(logTime(), starFound, pulseSent, pulseAcknowledged);
+}
+
+// Only the total is plotted, the steps are in the log file.
+void Analyze::processGuideLatency(double time, double starFound, double pulseSent, double pulseAcknowledged,
+                                  bool batchMode)
+{
+    Q_UNUSED(starFound);
+    Q_UNUSED(pulseSent);
+    statsSeries[LATENCY_GRAPH].append(time, pulseAcknowledged);
+    updateMaxX(time);
+    if (!batchMode)
+        replot();
+}
+
 void Analyze::resetGuideStats()
 {
     lastGuideStatsTime = -1;
@@ -3747,6 +3902,11 @@ void Analyze::mountCoords(const SkyPoint &position, ISD::Mount::PierSide pierSid
     }
 }
 
+void Analyze::mountSnapshot(const Ekos::MountTelemetry::Snapshot &snapshot)
+{
+    mountCoords(snapshot.position, snapshot.pierSide, snapshot.ha);
+}
+
 void Analyze::processMountCoords(double time, double ra, double dec, double az,
                                  double alt, int pierSide, double ha, bool batchMode)
 {
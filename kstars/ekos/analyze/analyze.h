@@ -8,10 +8,13 @@
 #define ANALYZE_H
 
 #include <memory>
+#include <QPointer>
 #include "ekos/ekos.h"
 #include "ekos/mount/mount.h"
 #include "indi/indimount.h"
 #include "yaxistool.h"
+#include "timeseries.h"
+#include "sessionbrowser.h"
 #include "ui_analyze.h"
 #include "ekos/manager/meridianflipstate.h"
 #include "ekos/focus/focusutils.h"
@@ -204,6 +207,7 @@ class Analyze : public QWidget, public Ui::Analyze
         void guideState(Ekos::GuideState status);
         void guideStats(double raError, double decError, int raPulse, int decPulse,
                         double snr, double skyBg, int numStars);
+        void guideLatency(double starFound, double pulseSent, double pulseAcknowledged);
 
         // From Focus
         void autofocusStarting(double temperature, const QString &filter, const AutofocusReason reason, const QString &reasonInfo);
@@ -222,6 +226,7 @@ class Analyze : public QWidget, public Ui::Analyze
         // From Mount
         void mountState(ISD::Mount::Status status);
         void mountCoords(const SkyPoint &position, ISD::Mount::PierSide pierSide, const dms &haValue);
+        void mountSnapshot(const Ekos::MountTelemetry::Snapshot &snapshot);
         void mountFlipStatus(Ekos::MeridianFlipState::MeridianFlipMountState status);
 
         void schedulerJobStarted(const QString &jobName);
@@ -266,6 +271,8 @@ class Analyze : public QWidget, public Ui::Analyze
         void processGuideState(double time, const QString &state, bool batchMode = false);
         void processGuideStats(double time, double raError, double decError, int raPulse,
                                int decPulse, double snr, double skyBg, int numStars, bool batchMode = false);
+        void processGuideLatency(double time, double starFound, double pulseSent, double pulseAcknowledged,
+                                 bool batchMode = false);
         void processMountCoords(double time, double ra, double dec, double az, double alt,
                                 int pierSide, double ha, bool batchMode = false);
 
@@ -391,6 +398,9 @@ class Analyze : public QWidget, public Ui::Analyze
                            const QColor &color, const QString &name, const QString &shortName,
                            QCheckBox *cb, Func setCb, QLineEdit *out = nullptr);
 
+        // Fills the stats graphs with the samples of the displayed range, decimated to the plot width.
+        void plotStatsSeries();
+
         // Make graphs visible/invisible & add/delete them from the legend.
         void toggleGraph(int graph_id, bool show);
 
@@ -433,9 +443,12 @@ class Analyze : public QWidget, public Ui::Analyze
         void resetSchedulerJob();
         void resetTemperature();
 
-        // Read and display an input .analyze file.
+        // Read and display an input .analyze file, or its binary variant.
         double readDataFromFile(const QString &filename);
+        void displayFile(const QUrl &inputURL);
         double processInputLine(const QString &line);
+        // The series stored as columns in the binary logs, by name.
+        QHash<QString, TimeSeries *> binaryLogSeries();
 
         // Opens a FITS file for viewing.
         void displayFITS(const QString &filename);
@@ -501,6 +514,10 @@ class Analyze : public QWidget, public Ui::Analyze
         // When displaying the current session it should equal analyzeStartTime.
         QDateTime displayStartTime;
 
+        // The samples of the stats graphs, indexed like the graphs. The graphs only hold
+        // the samples being displayed, see plotStatsSeries().
+        QVector<TimeSeries> statsSeries;
+
         // AddGuideStats uses RmsFilter to compute RMS values of the squared
         // RA and DEC errors, thus calculating the RMS error.
         std::unique_ptr<RmsFilter> guiderRms;
@@ -518,6 +535,8 @@ class Analyze : public QWidget, public Ui::Analyze
 
         // FITS Viewer to display FITS images.
         QSharedPointer<FITSViewer> fitsViewer;
+        // Browser of the sessions of the logs, created when first used.
+        QPointer<SessionBrowser> sessionBrowser;
         // When trying to load a FITS file, if the original file path doesn't
         // work, Analyze tries to find the file under the alternate folder.
         QString alternateFolder;
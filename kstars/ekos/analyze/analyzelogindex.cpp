@@ -0,0 +1,319 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "analyzelogindex.h"
+
+#include <ekos_analyze_debug.h>
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <cmath>
+#include <cstring>
+
+namespace Ekos
+{
+
+namespace
+{
+// Same as the .analyze logs.
+const QString timeFormat = "yyyy-MM-dd hh:mm:ss.zzz";
+
+constexpr quint32 IndexMagic = 0x414e4958;
+constexpr quint32 IndexVersion = 1;
+// Bytes of the start of the log kept in the index
+constexpr int HeadSize = 256;
+
+// Accumulate the statistics of a line in a summary.
+void addToSummary(AnalyzeLogIndex::Summary &summary, const QByteArray &command, const QByteArray &line)
+{
+    if (command == "GuideStats")
+    {
+        const QList<QByteArray> fields = line.split(',');
+        bool raOk = false, decOk = false;
+        const double ra = fields.size() > 3 ? fields[2].toDouble(&raOk) : 0;
+        const double dec = fields.size() > 3 ? fields[3].toDouble(&decOk) : 0;
+        if (raOk && decOk)
+            summary.guiding.add(ra, dec);
+    }
+    else if (command == "CaptureComplete")
+    {
+        const QList<QByteArray> fields = line.split(',');
+        summary.captures++;
+        if (fields.size() > 4)
+        {
+            summary.exposureSeconds += fields[2].toDouble();
+            bool ok = false;
+            const double hfr = fields[4].toDouble(&ok);
+            if (ok && hfr > 0)
+            {
+                summary.hfrCount++;
+                summary.hfrSum += hfr;
+            }
+        }
+    }
+    else if (command == "AutofocusComplete")
+        summary.autofocusRuns++;
+    else if (command == "AutofocusAborted")
+    {
+        summary.autofocusRuns++;
+        summary.autofocusFailures++;
+    }
+}
+
+QDataStream &operator<<(QDataStream &out, const AnalyzeLogIndex::Summary &summary)
+{
+    return out << summary.startTime << summary.duration << summary.captures << summary.exposureSeconds
+           << summary.hfrCount << summary.hfrSum << summary.autofocusRuns << summary.autofocusFailures
+           << summary.guiding.samples << summary.guiding.raSumSquares << summary.guiding.decSumSquares;
+}
+
+QDataStream &operator>>(QDataStream &in, AnalyzeLogIndex::Summary &summary)
+{
+    return in >> summary.startTime >> summary.duration >> summary.captures >> summary.exposureSeconds
+           >> summary.hfrCount >> summary.hfrSum >> summary.autofocusRuns >> summary.autofocusFailures
+           >> summary.guiding.samples >> summary.guiding.raSumSquares >> summary.guiding.decSumSquares;
+}
+}
+
+void AnalyzeLogIndex::GuideStats::add(double ra, double dec)
+{
+    samples++;
+    raSumSquares += ra * ra;
+    decSumSquares += dec * dec;
+}
+
+void AnalyzeLogIndex::GuideStats::add(const GuideStats &other)
+{
+    samples += other.samples;
+    raSumSquares += other.raSumSquares;
+    decSumSquares += other.decSumSquares;
+}
+
+double AnalyzeLogIndex::GuideStats::raRMS() const
+{
+    return samples > 0 ? std::sqrt(raSumSquares / samples) : 0;
+}
+
+double AnalyzeLogIndex::GuideStats::decRMS() const
+{
+    return samples > 0 ? std::sqrt(decSumSquares / samples) : 0;
+}
+
+double AnalyzeLogIndex::GuideStats::totalRMS() const
+{
+    return samples > 0 ? std::sqrt((raSumSquares + decSumSquares) / samples) : 0;
+}
+
+void AnalyzeLogIndex::Summary::add(const Summary &other)
+{
+    if (!startTime.isValid() || (other.startTime.isValid() && other.startTime < startTime))
+        startTime = other.startTime;
+    duration += other.duration;
+    captures += other.captures;
+    exposureSeconds += other.exposureSeconds;
+    hfrCount += other.hfrCount;
+    hfrSum += other.hfrSum;
+    autofocusRuns += other.autofocusRuns;
+    autofocusFailures += other.autofocusFailures;
+    guiding.add(other.guiding);
+}
+
+double AnalyzeLogIndex::Summary::meanHFR() const
+{
+    return hfrCount > 0 ? hfrSum / hfrCount : 0;
+}
+
+QString AnalyzeLogIndex::indexFilename(const QString &filename)
+{
+    const QFileInfo info(filename);
+    return info.dir().filePath(info.completeBaseName() + ".analyzeidx");
+}
+
+bool AnalyzeLogIndex::load(const QString &filename)
+{
+    m_Filename = filename;
+
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    const qint64 size = file.size();
+    const qint64 modified = QFileInfo(filename).lastModified().toMSecsSinceEpoch();
+    const QByteArray head = file.read(HeadSize);
+
+    if (!readIndex(size, modified, head))
+    {
+        m_IndexedSize = 0;
+        m_Summary = Summary();
+        m_Events.clear();
+    }
+    m_Summary.filename = filename;
+    m_Head = head;
+    if (m_IndexedSize == size && m_SourceModified == modified)
+        return true;
+
+    if (size > 0)
+    {
+        uchar *data = file.map(0, size);
+        if (data == nullptr)
+        {
+            qCWarning(KSTARS_EKOS_ANALYZE) << "Could not map" << filename << file.errorString();
+            return false;
+        }
+
+        // Logs are only appended to, the lines after the indexed ones are added.
+        // An incomplete last line is indexed once it is complete.
+        qint64 offset = m_IndexedSize;
+        while (offset < size)
+        {
+            const char *line = reinterpret_cast<const char *>(data + offset);
+            const char *end = static_cast<const char *>(memchr(line, '\n', size - offset));
+            if (end == nullptr)
+                break;
+            indexLine(QByteArray::fromRawData(line, end - line), offset);
+            offset += end - line + 1;
+        }
+        file.unmap(data);
+        m_IndexedSize = offset;
+    }
+    m_SourceModified = modified;
+
+    writeIndex();
+    return true;
+}
+
+void AnalyzeLogIndex::indexLine(const QByteArray &line, qint64 offset)
+{
+    // Same checks as Analyze::processInputLine(), the fields of the other lines are left to it.
+    if (line.isEmpty() || line.at(0) == '#')
+        return;
+    const int comma = line.indexOf(',');
+    if (comma <= 0)
+        return;
+    const int nextComma = line.indexOf(',', comma + 1);
+    const QByteArray command = line.left(comma);
+    const QByteArray second = line.mid(comma + 1, nextComma < 0 ? -1 : nextComma - comma - 1);
+
+    if (command == "AnalyzeStartTime")
+    {
+        m_Summary.startTime = QDateTime::fromString(QString::fromLatin1(second), timeFormat);
+        return;
+    }
+
+    bool ok = false;
+    const double time = second.toDouble(&ok);
+    if (!ok || time < 0 || time > 3600 * 24 * 10)
+        return;
+
+    Events &events = m_Events[QString::fromLatin1(command)];
+    events.times.append(time);
+    events.offsets.append(offset);
+    m_Summary.duration = std::max(m_Summary.duration, time);
+
+    addToSummary(m_Summary, command, line);
+}
+
+QVector<QByteArray> AnalyzeLogIndex::lines(const QString &command, double start, double end) const
+{
+    QVector<QByteArray> result;
+    auto events = m_Events.constFind(command);
+    if (events == m_Events.constEnd() || m_IndexedSize == 0)
+        return result;
+
+    QFile file(m_Filename);
+    if (!file.open(QIODevice::ReadOnly) || file.size() < m_IndexedSize)
+        return result;
+    uchar *data = file.map(0, m_IndexedSize);
+    if (data == nullptr)
+        return result;
+
+    for (int i = 0; i < events->times.size(); ++i)
+    {
+        const double time = events->times[i];
+        if (time < start || time > end)
+            continue;
+        const char *line = reinterpret_cast<const char *>(data + events->offsets[i]);
+        const char *lineEnd = static_cast<const char *>(memchr(line, '\n', m_IndexedSize - events->offsets[i]));
+        if (lineEnd != nullptr)
+            result.append(QByteArray(line, lineEnd - line));
+    }
+
+    file.unmap(data);
+    return result;
+}
+
+AnalyzeLogIndex::Summary AnalyzeLogIndex::summary(double start, double end) const
+{
+    Summary result;
+    result.filename = m_Filename;
+    result.startTime = m_Summary.startTime;
+    result.duration = std::max(0.0, std::min(end, m_Summary.duration) - std::max(start, 0.0));
+    for (const QByteArray command : {"GuideStats", "CaptureComplete", "AutofocusComplete", "AutofocusAborted"})
+    {
+        for (const auto &line : lines(QString::fromLatin1(command), start, end))
+            addToSummary(result, command, line);
+    }
+    return result;
+}
+
+bool AnalyzeLogIndex::readIndex(qint64 sourceSize, qint64 sourceModified, const QByteArray &head)
+{
+    QFile file(indexFilename(m_Filename));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_12);
+    quint32 magic = 0, version = 0;
+    in >> magic >> version;
+    if (magic != IndexMagic || version != IndexVersion)
+        return false;
+
+    QByteArray indexedHead;
+    in >> m_IndexedSize >> m_SourceModified >> indexedHead;
+    // The index is still valid for a log that was appended to.
+    if (in.status() != QDataStream::Ok || m_IndexedSize > sourceSize ||
+            (m_IndexedSize == sourceSize && m_SourceModified != sourceModified) ||
+            !head.startsWith(indexedHead))
+        return false;
+
+    in >> m_Summary;
+    quint32 commands = 0;
+    in >> commands;
+    m_Events.clear();
+    for (quint32 i = 0; i < commands && in.status() == QDataStream::Ok; ++i)
+    {
+        QString command;
+        Events events;
+        in >> command >> events.times >> events.offsets;
+        m_Events.insert(command, events);
+    }
+    return in.status() == QDataStream::Ok;
+}
+
+void AnalyzeLogIndex::writeIndex() const
+{
+    QSaveFile file(indexFilename(m_Filename));
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_12);
+    out << IndexMagic << IndexVersion;
+    out << m_IndexedSize << m_SourceModified << m_Head;
+    out << m_Summary;
+    out << static_cast<quint32>(m_Events.size());
+    for (auto it = m_Events.cbegin(); it != m_Events.cend(); ++it)
+        out << it.key() << it.value().times << it.value().offsets;
+
+    if (!file.commit())
+        qCWarning(KSTARS_EKOS_ANALYZE) << "Could not write the index of" << m_Filename << file.errorString();
+}
+
+}
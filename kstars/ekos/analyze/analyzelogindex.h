@@ -0,0 +1,108 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+namespace Ekos
+{
+
+/**
+ * @class AnalyzeLogIndex
+ * @short Index of the events of a .analyze log, with a summary of the session.
+ *
+ * The index holds the time and the byte offset of every line of the log, by command, and a
+ * summary of the session: captures, autofocus runs and guiding errors. It is built once and
+ * saved next to the log, then extended when the log grows, so that browsing many logs doesn't
+ * parse them again. The lines of a command within a time window are read from the offsets,
+ * without parsing the rest of the log.
+ */
+class AnalyzeLogIndex
+{
+    public:
+        /// Guiding errors, which can be accumulated across windows and sessions.
+        struct GuideStats
+        {
+            int samples { 0 };
+            double raSumSquares { 0 };
+            double decSumSquares { 0 };
+
+            void add(double ra, double dec);
+            void add(const GuideStats &other);
+            double raRMS() const;
+            double decRMS() const;
+            double totalRMS() const;
+        };
+
+        /// Summary of a session, which can be accumulated across sessions.
+        struct Summary
+        {
+            QString filename;
+            QDateTime startTime;
+            // Seconds since the start of the session
+            double duration { 0 };
+            int captures { 0 };
+            double exposureSeconds { 0 };
+            int hfrCount { 0 };
+            double hfrSum { 0 };
+            int autofocusRuns { 0 };
+            int autofocusFailures { 0 };
+            GuideStats guiding;
+
+            void add(const Summary &other);
+            double meanHFR() const;
+        };
+
+        /**
+         * @brief load Load the index of a log, building or extending it as needed.
+         * @return false if the log cannot be read.
+         */
+        bool load(const QString &filename);
+
+        const Summary &summary() const
+        {
+            return m_Summary;
+        }
+
+        /** @return the lines of @p command whose time is between @p start and @p end, in order */
+        QVector<QByteArray> lines(const QString &command, double start, double end) const;
+
+        /**
+         * @return the summary of the session between @p start and @p end, in seconds since its start,
+         * from the indexed lines of the window only.
+         */
+        Summary summary(double start, double end) const;
+
+        /** @return the file of the index of the log @p filename */
+        static QString indexFilename(const QString &filename);
+
+    private:
+        struct Events
+        {
+            QVector<double> times;
+            QVector<qint64> offsets;
+        };
+
+        void indexLine(const QByteArray &line, qint64 offset);
+        bool readIndex(qint64 sourceSize, qint64 sourceModified, const QByteArray &head);
+        void writeIndex() const;
+
+        QString m_Filename;
+        // Bytes of the log covered by the index, up to its last complete line
+        qint64 m_IndexedSize { 0 };
+        qint64 m_SourceModified { 0 };
+        // Start of the log, to detect a log replaced by another
+        QByteArray m_Head;
+        Summary m_Summary;
+        QHash<QString, Events> m_Events;
+};
+
+}
@@ -0,0 +1,309 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "sessionbrowser.h"
+#include "auxiliary/executors.h"
+
+#include <KLocalizedString>
+
+#include <QCheckBox>
+#include <QDateEdit>
+#include <QDialogButtonBox>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLineEdit>
+#include <QMap>
+#include <QPushButton>
+#include <QSet>
+#include <QTimeEdit>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+namespace Ekos
+{
+
+namespace
+{
+enum Columns
+{
+    SESSION_COLUMN,
+    FOLDER_COLUMN,
+    HOURS_COLUMN,
+    CAPTURES_COLUMN,
+    EXPOSURE_COLUMN,
+    HFR_COLUMN,
+    RMS_COLUMN,
+    RA_RMS_COLUMN,
+    DEC_RMS_COLUMN,
+    AUTOFOCUS_COLUMN
+};
+
+// A night runs from noon to noon, sessions started after midnight belong to the night before.
+QDate nightOf(const QDateTime &startTime)
+{
+    return startTime.addSecs(-12 * 3600).date();
+}
+
+QDateTime nightTime(const QDate &night, const QTime &time)
+{
+    const QDateTime dateTime(night, time);
+    return time < QTime(12, 0) ? dateTime.addDays(1) : dateTime;
+}
+
+void setSummary(QTreeWidgetItem *item, const AnalyzeLogIndex::Summary &summary)
+{
+    item->setText(HOURS_COLUMN, QString::number(summary.duration / 3600, 'f', 1));
+    item->setText(CAPTURES_COLUMN, QString::number(summary.captures));
+    item->setText(EXPOSURE_COLUMN, QString::number(summary.exposureSeconds / 3600, 'f', 1));
+    if (summary.hfrCount > 0)
+        item->setText(HFR_COLUMN, QString::number(summary.meanHFR(), 'f', 2));
+    if (summary.guiding.samples > 0)
+    {
+        item->setText(RMS_COLUMN, QString::number(summary.guiding.totalRMS(), 'f', 2));
+        item->setText(RA_RMS_COLUMN, QString::number(summary.guiding.raRMS(), 'f', 2));
+        item->setText(DEC_RMS_COLUMN, QString::number(summary.guiding.decRMS(), 'f', 2));
+    }
+    item->setText(AUTOFOCUS_COLUMN, QString("%1 (%2)").arg(summary.autofocusRuns).arg(summary.autofocusFailures));
+    for (int column = HOURS_COLUMN; column <= AUTOFOCUS_COLUMN; ++column)
+        item->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+}
+}
+
+SessionBrowser::SessionBrowser(QWidget *parent) : QDialog(parent)
+{
+    setWindowTitle(i18nc("@title:window", "Analyze Sessions"));
+
+    m_DirectoryEdit = new QLineEdit(this);
+    m_DirectoryEdit->setReadOnly(true);
+    QPushButton *directoryB = new QPushButton(QIcon::fromTheme("document-open-folder"), QString(), this);
+    directoryB->setToolTip(i18n("Folder of the logs, including its subfolders"));
+    connect(directoryB, &QPushButton::clicked, this, [this]()
+    {
+        const QString directory = QFileDialog::getExistingDirectory(this, i18nc("@title:window", "Select Log Folder"),
+                                  m_Directory);
+        if (!directory.isEmpty())
+            setDirectory(directory);
+    });
+
+    m_From = new QDateEdit(QDate::currentDate().addMonths(-3), this);
+    m_To = new QDateEdit(QDate::currentDate(), this);
+    m_From->setCalendarPopup(true);
+    m_To->setCalendarPopup(true);
+    m_WindowCB = new QCheckBox(i18n("Only between"), this);
+    m_WindowCB->setToolTip(i18n("Restrict the statistics to a window of each night"));
+    m_WindowStart = new QTimeEdit(QTime(22, 0), this);
+    m_WindowEnd = new QTimeEdit(QTime(2, 0), this);
+    m_WindowStart->setEnabled(false);
+    m_WindowEnd->setEnabled(false);
+
+    connect(m_From, &QDateEdit::dateChanged, this, &SessionBrowser::refresh);
+    connect(m_To, &QDateEdit::dateChanged, this, &SessionBrowser::refresh);
+    connect(m_WindowStart, &QTimeEdit::timeChanged, this, &SessionBrowser::refresh);
+    connect(m_WindowEnd, &QTimeEdit::timeChanged, this, &SessionBrowser::refresh);
+    connect(m_WindowCB, &QCheckBox::toggled, this, [this](bool checked)
+    {
+        m_WindowStart->setEnabled(checked);
+        m_WindowEnd->setEnabled(checked);
+        refresh();
+    });
+
+    QHBoxLayout *directoryLayout = new QHBoxLayout();
+    directoryLayout->addWidget(new QLabel(i18n("Folder:"), this));
+    directoryLayout->addWidget(m_DirectoryEdit, 1);
+    directoryLayout->addWidget(directoryB);
+
+    QHBoxLayout *filterLayout = new QHBoxLayout();
+    filterLayout->addWidget(new QLabel(i18n("Nights from"), this));
+    filterLayout->addWidget(m_From);
+    filterLayout->addWidget(new QLabel(i18n("to"), this));
+    filterLayout->addWidget(m_To);
+    filterLayout->addSpacing(20);
+    filterLayout->addWidget(m_WindowCB);
+    filterLayout->addWidget(m_WindowStart);
+    filterLayout->addWidget(new QLabel(i18n("and"), this));
+    filterLayout->addWidget(m_WindowEnd);
+    filterLayout->addStretch();
+
+    m_Tree = new QTreeWidget(this);
+    m_Tree->setHeaderLabels(QStringList()
+                            << i18n("Session")
+                            << i18n("Folder")
+                            << i18n("Hours")
+                            << i18n("Captures")
+                            << i18n("Exposure (h)")
+                            << i18n("Mean HFR")
+                            << i18n("Guide RMS (\")")
+                            << i18n("RA RMS (\")")
+                            << i18n("DEC RMS (\")")
+                            << i18n("Autofocus (failed)"));
+    m_Tree->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    m_Tree->setToolTip(i18n("Double click a session to display it"));
+    connect(m_Tree, &QTreeWidget::itemDoubleClicked, this, [this](QTreeWidgetItem * item)
+    {
+        const QString filename = item->data(SESSION_COLUMN, Qt::UserRole).toString();
+        if (!filename.isEmpty())
+            emit openLog(filename);
+    });
+
+    m_Status = new QLabel(this);
+
+    QDialogButtonBox *buttonBox = new QDialogButtonBox(QDialogButtonBox::Close, this);
+    QPushButton *refreshB = buttonBox->addButton(i18n("Refresh"), QDialogButtonBox::ActionRole);
+    connect(refreshB, &QPushButton::clicked, this, &SessionBrowser::refresh);
+    connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::close);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addLayout(directoryLayout);
+    layout->addLayout(filterLayout);
+    layout->addWidget(m_Tree);
+    layout->addWidget(m_Status);
+    layout->addWidget(buttonBox);
+
+    resize(1000, 600);
+
+    connect(&m_Loader, &QFutureWatcher<QVector<AnalyzeLogIndex::Summary>>::finished, this, [this]()
+    {
+        if (m_RefreshPending)
+        {
+            m_RefreshPending = false;
+            refresh();
+        }
+        else
+            display();
+    });
+}
+
+void SessionBrowser::setDirectory(const QString &directory)
+{
+    if (directory == m_Directory)
+        return;
+    m_Directory = directory;
+    m_DirectoryEdit->setText(QDir::toNativeSeparators(directory));
+    refresh();
+}
+
+void SessionBrowser::refresh()
+{
+    if (m_Loader.isRunning())
+    {
+        m_RefreshPending = true;
+        return;
+    }
+
+    // Logs last written before the first night cannot be in the range.
+    const QDateTime oldest(m_From->date(), QTime(12, 0));
+    QStringList files;
+    QDirIterator it(m_Directory, QStringList("*.analyze"), QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext())
+    {
+        it.next();
+        if (it.fileInfo().lastModified() >= oldest)
+            files.append(it.filePath());
+    }
+
+    Window window;
+    window.enabled = m_WindowCB->isChecked();
+    window.start = m_WindowStart->time();
+    window.end = m_WindowEnd->time();
+
+    m_Status->setText(i18np("Reading 1 log...", "Reading %1 logs...", files.size()));
+    m_Loader.setFuture(Executors::run(Executors::Background, &SessionBrowser::loadSessions, files, window));
+}
+
+QVector<AnalyzeLogIndex::Summary> SessionBrowser::loadSessions(const QStringList &files, const Window &window)
+{
+    QVector<AnalyzeLogIndex::Summary> sessions;
+    for (const auto &file : files)
+    {
+        AnalyzeLogIndex index;
+        if (!index.load(file) || !index.summary().startTime.isValid())
+            continue;
+
+        if (window.enabled)
+        {
+            // The window of the night of the session, in seconds since its start.
+            const QDateTime &startTime = index.summary().startTime;
+            const QDate night = nightOf(startTime);
+            const QDateTime windowStart = nightTime(night, window.start);
+            QDateTime windowEnd = nightTime(night, window.end);
+            if (windowEnd < windowStart)
+                windowEnd = windowEnd.addDays(1);
+            sessions.append(index.summary(startTime.msecsTo(windowStart) / 1000.0, startTime.msecsTo(windowEnd) / 1000.0));
+        }
+        else
+            sessions.append(index.summary());
+    }
+    return sessions;
+}
+
+void SessionBrowser::display()
+{
+    const QVector<AnalyzeLogIndex::Summary> sessions = m_Loader.result();
+
+    // Sorted by month, folder, and start time.
+    const QDir directory(m_Directory);
+    QMap<QString, QMap<QString, QMap<QDateTime, AnalyzeLogIndex::Summary>>> months;
+    QSet<QString> folders;
+    for (const auto &session : sessions)
+    {
+        const QDate night = nightOf(session.startTime);
+        if (night < m_From->date() || night > m_To->date())
+            continue;
+        QString folder = directory.relativeFilePath(QFileInfo(session.filename).absolutePath());
+        if (folder == ".")
+            folder.clear();
+        folders.insert(folder);
+        months[night.toString("yyyy-MM")][folder].insert(session.startTime, session);
+    }
+
+    m_Tree->clear();
+    AnalyzeLogIndex::Summary total;
+    int count = 0;
+    for (auto month = months.cbegin(); month != months.cend(); ++month)
+    {
+        const QDate monthDate = QDate::fromString(month.key(), "yyyy-MM");
+        QTreeWidgetItem *monthItem = new QTreeWidgetItem(m_Tree, QStringList(QLocale().toString(monthDate, "MMMM yyyy")));
+        AnalyzeLogIndex::Summary monthTotal;
+        for (auto folder = month->cbegin(); folder != month->cend(); ++folder)
+        {
+            // Each folder of a fleet gets its own monthly statistics.
+            QTreeWidgetItem *folderItem = monthItem;
+            if (folders.size() > 1)
+            {
+                folderItem = new QTreeWidgetItem(monthItem, QStringList(folder.key().isEmpty() ? i18n("(top folder)") : folder.key()));
+                folderItem->setText(FOLDER_COLUMN, folder.key());
+            }
+
+            AnalyzeLogIndex::Summary folderTotal;
+            for (const auto &session : *folder)
+            {
+                QTreeWidgetItem *item = new QTreeWidgetItem(folderItem,
+                        QStringList(QLocale().toString(session.startTime, QLocale::ShortFormat)));
+                item->setText(FOLDER_COLUMN, folder.key());
+                item->setData(SESSION_COLUMN, Qt::UserRole, session.filename);
+                item->setToolTip(SESSION_COLUMN, QDir::toNativeSeparators(session.filename));
+                setSummary(item, session);
+                folderTotal.add(session);
+                count++;
+            }
+            if (folderItem != monthItem)
+                setSummary(folderItem, folderTotal);
+            monthTotal.add(folderTotal);
+        }
+        setSummary(monthItem, monthTotal);
+        total.add(monthTotal);
+    }
+
+    if (months.size() > 1)
+        setSummary(new QTreeWidgetItem(m_Tree, QStringList(i18n("All nights"))), total);
+    m_Status->setText(i18np("1 session", "%1 sessions", count));
+}
+
+}
@@ -0,0 +1,75 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "analyzelogindex.h"
+
+#include <QDialog>
+#include <QFutureWatcher>
+
+class QCheckBox;
+class QDateEdit;
+class QLabel;
+class QLineEdit;
+class QTimeEdit;
+class QTreeWidget;
+
+namespace Ekos
+{
+
+/**
+ * @class SessionBrowser
+ * @short Browses the sessions of the .analyze logs of a folder and its subfolders.
+ *
+ * Sessions are grouped by month, and by subfolder when there are several, e.g. one per
+ * observatory, with the statistics accumulated over each group: captures, exposure time,
+ * HFR, autofocus runs and guiding RMS. Sessions are summarized from their AnalyzeLogIndex,
+ * which is only built the first time a log is browsed. The statistics may be restricted to
+ * a window of the night, in which case only the indexed lines of the window are read.
+ */
+class SessionBrowser : public QDialog
+{
+        Q_OBJECT
+
+    public:
+        explicit SessionBrowser(QWidget *parent = nullptr);
+
+        void setDirectory(const QString &directory);
+
+    signals:
+        /** @short A session was double clicked, to be displayed by Analyze */
+        void openLog(const QString &filename);
+
+    private:
+        struct Window
+        {
+            bool enabled { false };
+            QTime start;
+            QTime end;
+        };
+
+        void refresh();
+        void display();
+
+        static QVector<AnalyzeLogIndex::Summary> loadSessions(const QStringList &files, const Window &window);
+
+        QString m_Directory;
+        QLineEdit *m_DirectoryEdit { nullptr };
+        QDateEdit *m_From { nullptr };
+        QDateEdit *m_To { nullptr };
+        QCheckBox *m_WindowCB { nullptr };
+        QTimeEdit *m_WindowStart { nullptr };
+        QTimeEdit *m_WindowEnd { nullptr };
+        QTreeWidget *m_Tree { nullptr };
+        QLabel *m_Status { nullptr };
+
+        QFutureWatcher<QVector<AnalyzeLogIndex::Summary>> m_Loader;
+        // Set when the parameters changed while loading
+        bool m_RefreshPending { false };
+};
+
+}
@@ -0,0 +1,357 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "timeseries.h"
+
+#include "qcustomplot.h"
+
+#include <ekos_analyze_debug.h>
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Ekos
+{
+
+void TimeSeries::append(double time, double value)
+{
+    if (!m_Times.isEmpty() && time < m_Times.last())
+    {
+        // Rare, the levels are simply rebuilt.
+        const int index = std::upper_bound(m_Times.cbegin(), m_Times.cend(), time) - m_Times.cbegin();
+        m_Times.insert(index, time);
+        m_Values.insert(index, value);
+        rebuildLevels();
+        return;
+    }
+
+    m_Times.append(time);
+    m_Values.append(value);
+    addToLevels(m_Times.size() - 1);
+}
+
+void TimeSeries::assign(const double *times, const double *values, int count)
+{
+    m_Times.resize(count);
+    m_Values.resize(count);
+    std::copy(times, times + count, m_Times.begin());
+    std::copy(values, values + count, m_Values.begin());
+    rebuildLevels();
+}
+
+void TimeSeries::clear()
+{
+    m_Times.clear();
+    m_Values.clear();
+    m_Levels.clear();
+    m_All = Bucket();
+}
+
+int TimeSeries::findBegin(double time) const
+{
+    if (m_Times.isEmpty())
+        return -1;
+    const int index = std::lower_bound(m_Times.cbegin(), m_Times.cend(), time) - m_Times.cbegin();
+    return std::max(0, index - 1);
+}
+
+void TimeSeries::addToBucket(Bucket &bucket, int index) const
+{
+    const double value = m_Values[index];
+    if (qIsNaN(value))
+    {
+        if (bucket.gapIndex < 0)
+            bucket.gapIndex = index;
+        return;
+    }
+    if (bucket.minIndex < 0 || value < m_Values[bucket.minIndex])
+        bucket.minIndex = index;
+    if (bucket.maxIndex < 0 || value > m_Values[bucket.maxIndex])
+        bucket.maxIndex = index;
+}
+
+void TimeSeries::addToLevels(int index)
+{
+    addToBucket(m_All, index);
+
+    int bucketSize = FANOUT;
+    for (auto &level : m_Levels)
+    {
+        const int bucket = index / bucketSize;
+        if (bucket == level.size())
+            level.append(Bucket());
+        addToBucket(level[bucket], index);
+        bucketSize *= FANOUT;
+    }
+
+    // A coarser level is started once the samples don't fit in one of its buckets.
+    if (m_Times.size() > bucketSize)
+        addLevel();
+}
+
+void TimeSeries::addLevel()
+{
+    int bucketSize = FANOUT;
+    for (int i = 0; i < m_Levels.size(); ++i)
+        bucketSize *= FANOUT;
+
+    QVector<Bucket> level((m_Times.size() + bucketSize - 1) / bucketSize);
+    for (int i = 0; i < m_Times.size(); ++i)
+        addToBucket(level[i / bucketSize], i);
+    m_Levels.append(level);
+}
+
+void TimeSeries::rebuildLevels()
+{
+    m_Levels.clear();
+    m_All = Bucket();
+    for (int i = 0; i < m_Times.size(); ++i)
+        addToBucket(m_All, i);
+
+    int bucketSize = FANOUT;
+    while (m_Times.size() > bucketSize)
+    {
+        addLevel();
+        bucketSize *= FANOUT;
+    }
+}
+
+void TimeSeries::plot(QCPGraph *graph, double start, double end, int pixels) const
+{
+    if (m_Times.isEmpty())
+    {
+        graph->data()->clear();
+        return;
+    }
+
+    // The samples in the range, and their neighbours.
+    const int first = findBegin(start);
+    const int last = std::min<int>(m_Times.size() - 1,
+                                   std::upper_bound(m_Times.cbegin(), m_Times.cend(), end) - m_Times.cbegin());
+
+    // The coarsest level with at most two buckets per pixel, or the raw samples.
+    const int maxBuckets = 2 * std::max(1, pixels);
+    int level = 0;
+    int bucketSize = 1;
+    while (level < m_Levels.size() && (last - first + 1) / bucketSize > maxBuckets)
+    {
+        level++;
+        bucketSize *= FANOUT;
+    }
+
+    QVector<int> indexes;
+    if (level == 0)
+    {
+        indexes.reserve(last - first + 3);
+        for (int i = first; i <= last; ++i)
+            indexes.append(i);
+    }
+    else
+    {
+        const auto &buckets = m_Levels[level - 1];
+        indexes.reserve(3 * (last / bucketSize - first / bucketSize + 1) + 2);
+        for (int b = first / bucketSize; b <= last / bucketSize; ++b)
+        {
+            for (const int index : {buckets[b].minIndex, buckets[b].maxIndex, buckets[b].gapIndex})
+                if (index >= 0)
+                    indexes.append(index);
+        }
+    }
+    for (const int index : {m_All.minIndex, m_All.maxIndex})
+        if (index >= 0)
+            indexes.append(index);
+
+    std::sort(indexes.begin(), indexes.end());
+    indexes.erase(std::unique(indexes.begin(), indexes.end()), indexes.end());
+
+    QVector<QCPGraphData> points;
+    points.reserve(indexes.size());
+    for (const int index : indexes)
+        points.append(QCPGraphData(m_Times[index], m_Values[index]));
+    graph->data()->set(points, true);
+}
+
+namespace BinaryLog
+{
+
+const QString Suffix = "analyzeb";
+
+namespace
+{
+constexpr char Signature[8] = {'K', 'S', 'A', 'N', 'L', 'Z', 'B', '\0'};
+constexpr quint32 Version = 1;
+// Binary logs are written in the byte order of the host, and are ignored on other hosts.
+constexpr quint32 ByteOrderMark = 0x01020304;
+constexpr int MaxNameSize = 48;
+
+struct Header
+{
+    char signature[8];
+    quint32 version;
+    quint32 byteOrder;
+    qint64 sourceSize;
+    qint64 sourceModified;
+    double lastTime;
+    quint32 seriesCount;
+    quint32 reserved;
+    qint64 eventsOffset;
+    qint64 eventsSize;
+};
+
+// Followed by the times, then the values of the series, as doubles.
+struct SeriesEntry
+{
+    char name[MaxNameSize];
+    qint64 offset;
+    qint64 count;
+};
+
+qint64 modificationTime(const QFileInfo &source)
+{
+    return source.lastModified().toMSecsSinceEpoch();
+}
+}
+
+bool isBinaryLog(const QString &filename)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    char signature[sizeof(Signature)];
+    return file.read(signature, sizeof(signature)) == sizeof(signature) &&
+           memcmp(signature, Signature, sizeof(signature)) == 0;
+}
+
+bool write(const QString &filename, const QFileInfo &source, double lastTime,
+           const QHash<QString, const TimeSeries *> &series, const QByteArray &events)
+{
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.signature, Signature, sizeof(Signature));
+    header.version = Version;
+    header.byteOrder = ByteOrderMark;
+    header.sourceSize = source.exists() ? source.size() : -1;
+    header.sourceModified = source.exists() ? modificationTime(source) : -1;
+    header.lastTime = lastTime;
+    header.seriesCount = series.size();
+
+    QVector<SeriesEntry> entries;
+    qint64 offset = sizeof(Header) + series.size() * sizeof(SeriesEntry);
+    for (auto it = series.cbegin(); it != series.cend(); ++it)
+    {
+        const QByteArray name = it.key().toUtf8();
+        if (name.size() >= MaxNameSize)
+            return false;
+
+        SeriesEntry entry;
+        memset(&entry, 0, sizeof(entry));
+        memcpy(entry.name, name.constData(), name.size());
+        entry.offset = offset;
+        entry.count = it.value()->size();
+        entries.append(entry);
+        offset += 2 * entry.count * sizeof(double);
+    }
+    header.eventsOffset = offset;
+    header.eventsSize = events.size();
+
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qCWarning(KSTARS_EKOS_ANALYZE) << "Could not write" << filename << file.errorString();
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(entries.constData()), entries.size() * sizeof(SeriesEntry));
+    for (const auto &oneSeries : series)
+    {
+        file.write(reinterpret_cast<const char *>(oneSeries->times().constData()), oneSeries->size() * sizeof(double));
+        file.write(reinterpret_cast<const char *>(oneSeries->values().constData()), oneSeries->size() * sizeof(double));
+    }
+    file.write(events);
+
+    if (!file.commit())
+    {
+        qCWarning(KSTARS_EKOS_ANALYZE) << "Could not write" << filename << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool read(const QString &filename, const QFileInfo &source, double *lastTime,
+          const QHash<QString, TimeSeries *> &series, QByteArray *events)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    const qint64 size = file.size();
+    if (size < static_cast<qint64>(sizeof(Header)))
+        return false;
+
+    uchar *map = file.map(0, size);
+    if (map == nullptr)
+    {
+        qCWarning(KSTARS_EKOS_ANALYZE) << "Could not map" << filename << file.errorString();
+        return false;
+    }
+
+    Header header;
+    memcpy(&header, map, sizeof(header));
+    const qint64 tableEnd = sizeof(Header) + static_cast<qint64>(header.seriesCount) * sizeof(SeriesEntry);
+    bool valid = memcmp(header.signature, Signature, sizeof(Signature)) == 0 &&
+                 header.version == Version && header.byteOrder == ByteOrderMark &&
+                 tableEnd <= size &&
+                 header.eventsOffset >= tableEnd && header.eventsSize >= 0 &&
+                 header.eventsOffset + header.eventsSize <= size;
+
+    if (valid && source.exists())
+        valid = header.sourceSize == source.size() && header.sourceModified == modificationTime(source);
+
+    for (quint32 i = 0; valid && i < header.seriesCount; ++i)
+    {
+        SeriesEntry entry;
+        memcpy(&entry, map + sizeof(Header) + i * sizeof(SeriesEntry), sizeof(entry));
+        entry.name[MaxNameSize - 1] = '\0';
+        if (entry.count < 0 || entry.offset < tableEnd || entry.offset % sizeof(double) != 0 ||
+                entry.offset + 2 * entry.count * static_cast<qint64>(sizeof(double)) > size)
+        {
+            valid = false;
+            break;
+        }
+
+        TimeSeries *oneSeries = series.value(QString::fromUtf8(entry.name), nullptr);
+        if (oneSeries == nullptr)
+            continue;
+
+        // The mapping is page aligned, so are the columns of doubles.
+        const double *times = reinterpret_cast<const double *>(map + entry.offset);
+        oneSeries->assign(times, times + entry.count, entry.count);
+    }
+
+    if (valid)
+    {
+        *lastTime = header.lastTime;
+        *events = QByteArray(reinterpret_cast<const char *>(map + header.eventsOffset), header.eventsSize);
+    }
+    else
+    {
+        for (auto &oneSeries : series)
+            oneSeries->clear();
+    }
+
+    file.unmap(map);
+    return valid;
+}
+
+}
+
+}
@@ -0,0 +1,150 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+class QCPGraph;
+class QFileInfo;
+
+namespace Ekos
+{
+
+/**
+ * @class TimeSeries
+ * @short Columnar storage of the samples of one Analyze stats graph.
+ *
+ * Samples are stored as two columns, times and values, sorted by time. NaN values are gaps,
+ * which are not drawn. Above the raw samples, the series maintains a pyramid of levels of
+ * detail: level L divides the samples in buckets of FANOUT^L consecutive samples, and keeps
+ * for each bucket the indexes of its minimum, its maximum and its first gap. Appending a sample
+ * updates the last bucket of each level, and the levels are built as the series grows.
+ *
+ * When a time range is plotted, the coarsest level that still has about two buckets per pixel
+ * is used, and only the minimum, the maximum and the gap of each bucket are drawn. This keeps
+ * the spikes of the data visible at any zoom, with a number of points bounded by the width of
+ * the plot instead of the length of the session.
+ */
+class TimeSeries
+{
+    public:
+        /** @short Append a sample. Samples are expected in time order, older samples are inserted in place. */
+        void append(double time, double value);
+
+        /** @short Replace the samples with @p count samples from the columns @p times and @p values */
+        void assign(const double *times, const double *values, int count);
+
+        void clear();
+
+        int size() const
+        {
+            return m_Times.size();
+        }
+        bool isEmpty() const
+        {
+            return m_Times.isEmpty();
+        }
+        double time(int index) const
+        {
+            return m_Times[index];
+        }
+        double value(int index) const
+        {
+            return m_Values[index];
+        }
+        const QVector<double> &times() const
+        {
+            return m_Times;
+        }
+        const QVector<double> &values() const
+        {
+            return m_Values;
+        }
+
+        /**
+         * @brief findBegin Same as QCPDataContainer::findBegin() with an expanded range.
+         * @return the index of the last sample before @p time, or of the first sample if there are none,
+         * or -1 if the series is empty.
+         */
+        int findBegin(double time) const;
+
+        /**
+         * @brief plot Replace the data of @p graph with the samples between @p start and @p end, decimated for @p pixels.
+         * The neighbours of the range are included, so that lines enter and leave the plot as before,
+         * and so are the extremes of the whole series, so that rescaling the y-axis does not depend
+         * on the zoom.
+         */
+        void plot(QCPGraph *graph, double start, double end, int pixels) const;
+
+    private:
+        struct Bucket
+        {
+            int minIndex { -1 };
+            int maxIndex { -1 };
+            int gapIndex { -1 };
+        };
+
+        void addToBucket(Bucket &bucket, int index) const;
+        void addToLevels(int index);
+        void addLevel();
+        void rebuildLevels();
+
+        /// Number of buckets of level L-1 in a bucket of level L
+        static constexpr int FANOUT = 4;
+
+        QVector<double> m_Times;
+        QVector<double> m_Values;
+        // m_Levels[L - 1] holds the buckets of FANOUT^L samples
+        QVector<QVector<Bucket>> m_Levels;
+        // Extremes of the whole series
+        Bucket m_All;
+};
+
+/**
+ * @short Binary variant of the .analyze logs.
+ *
+ * The series of the periodic samples (guiding, mount coordinates, temperature...) are stored as
+ * columns of doubles, loaded by mapping the file in memory, and the other events are kept as the
+ * text lines of the .analyze log, which are few. A binary log written for a text log records the
+ * size and modification time of the text log, and is only used while they match.
+ */
+namespace BinaryLog
+{
+/// The suffix of the binary logs, which are stored next to their text log
+extern const QString Suffix;
+
+/// @return true if @p filename starts with the signature of a binary log
+bool isBinaryLog(const QString &filename);
+
+/**
+ * @brief write Save a binary log.
+ * @param filename the binary log, overwritten.
+ * @param source the text log it was read from, or an invalid QFileInfo.
+ * @param lastTime the last time of the log, in seconds since its start.
+ * @param series the series to store, by name.
+ * @param events the text lines of the events that are not stored as series.
+ */
+bool write(const QString &filename, const QFileInfo &source, double lastTime,
+           const QHash<QString, const TimeSeries *> &series, const QByteArray &events);
+
+/**
+ * @brief read Load a binary log.
+ * @param filename the binary log.
+ * @param source the text log it should match, or an invalid QFileInfo to load it unconditionally.
+ * @param lastTime receives the last time of the log.
+ * @param series the series to load, by name. Series missing from the file are left empty.
+ * @param events receives the text lines of the other events.
+ * @return false if the file is not a valid binary log, or doesn't match @p source.
+ */
+bool read(const QString &filename, const QFileInfo &source, double *lastTime,
+          const QHash<QString, TimeSeries *> &series, QByteArray *events);
+}
+
+}
@@ -18,7 +18,10 @@
 #include "kstarsdata.h"
 #include "fitsviewer/fitsdata.h"
 #include "fitsviewer/fitsview.h"
+#include "fitsviewer/imagememory.h"
+#include "auxiliary/executors.h"
 
+#include <QCoreApplication>
 #include <QDesktopServices>
 #include <QSqlRecord>
 #include <QSqlTableModel>
@@ -55,6 +58,9 @@ DarkLibrary::DarkLibrary(QWidget *parent) : QDialog(parent)
     writableDir.mkpath("darks");
     writableDir.mkpath("defectmaps");
 
+    m_CachedDarkFrames.setBudget(static_cast<uint64_t>(Options::darkLibraryCacheSize()) * 1000000);
+    m_CachedDefectMaps.setBudget(static_cast<uint64_t>(Options::darkLibraryCacheSize()) * 1000000);
+
     // Setup Debounce timer to limit over-activation of settings changes
     m_DebounceTimer.setInterval(500);
     m_DebounceTimer.setSingleShot(true);
@@ -211,118 +217,68 @@ void DarkLibrary::refreshFromDB()
 ///////////////////////////////////////////////////////////////////////////////////////
 ///
 ///////////////////////////////////////////////////////////////////////////////////////
-bool DarkLibrary::findDarkFrame(ISD::CameraChip *m_TargetChip, double duration, QSharedPointer<FITSData> &darkData)
+bool DarkLibrary::findDarkFrameFile(ISD::CameraChip *m_TargetChip, double duration, int binX, int binY, QString &filename)
 {
-    QVariantMap bestCandidate;
-    for (auto &map : m_DarkFramesDatabaseList)
-    {
-        // First check CCD name matches and check if we are on the correct chip
-        if (map["ccd"].toString() == m_TargetChip->getCCD()->getDeviceName() &&
-                map["chip"].toInt() == static_cast<int>(m_TargetChip->getType()))
-        {
-            // Match Gain
-            int gain = getGain();
-            if (gain >= 0 && map["gain"].toInt() != gain)
-                continue;
-
-            // Match ISO
-            QString isoValue;
-            if (m_TargetChip->getISOValue(isoValue) && map["iso"].toString() != isoValue)
-                continue;
-
-            // Match binning
-            int binX = 1, binY = 1;
-            m_TargetChip->getBinning(&binX, &binY);
-
-            // Then check if binning is the same
-            if (map["binX"].toInt() != binX || map["binY"].toInt() != binY)
-                continue;
-
-            // If camera has an active cooler, then we check temperature against the absolute threshold.
-            if (m_TargetChip->getCCD()->hasCoolerControl())
-            {
-                double temperature = 0;
-                m_TargetChip->getCCD()->getTemperature(&temperature);
-                double darkTemperature = map["temperature"].toDouble();
-                // If different is above threshold, it is completely rejected.
-                if (darkTemperature != INVALID_VALUE && fabs(darkTemperature - temperature) > maxDarkTemperatureDiff->value())
-                    continue;
-            }
-
-            if (bestCandidate.isEmpty())
-            {
-                bestCandidate = map;
-                continue;
-            }
-
-            // We try to find the best frame
-            // Frame closest in exposure duration wins
-            // Frame with temperature closest to stored temperature wins (if temperature is reported)
-            uint32_t thisMapScore = 0;
-            uint32_t bestCandidateScore = 0;
-
-            // Else we check for the closest passive temperature
-            if (m_TargetChip->getCCD()->hasCooler())
-            {
-                double temperature = 0;
-                m_TargetChip->getCCD()->getTemperature(&temperature);
-                double diffMap = std::fabs(temperature - map["temperature"].toDouble());
-                double diffBest = std::fabs(temperature - bestCandidate["temperature"].toDouble());
-                // Prefer temperatures closest to target
-                if (diffMap < diffBest)
-                    thisMapScore++;
-                else if (diffBest < diffMap)
-                    bestCandidateScore++;
-            }
-
-            // Duration has a higher score priority over temperature
-            {
-                double diffMap = std::fabs(map["duration"].toDouble() - duration);
-                double diffBest = std::fabs(bestCandidate["duration"].toDouble() - duration);
-                if (diffMap < diffBest)
-                    thisMapScore += 5;
-                else if (diffBest < diffMap)
-                    bestCandidateScore += 5;
-            }
-
-            // More recent has a higher score than older.
-            {
-                const QDateTime now = QDateTime::currentDateTime();
-                int64_t diffMap  = map["timestamp"].toDateTime().secsTo(now);
-                int64_t diffBest = bestCandidate["timestamp"].toDateTime().secsTo(now);
-                if (diffMap < diffBest)
-                    thisMapScore++;
-                else if (diffBest < diffMap)
-                    bestCandidateScore++;
-            }
+    KSUserDB::DarkFrameCriteria criteria;
+    criteria.ccd = m_TargetChip->getCCD()->getDeviceName();
+    criteria.chip = static_cast<int>(m_TargetChip->getType());
+    criteria.gain = getGain();
+    criteria.duration = duration;
+    criteria.invalidTemperature = INVALID_VALUE;
+    criteria.binX = binX;
+    criteria.binY = binY;
+
+    QString isoValue;
+    if (m_TargetChip->getISOValue(isoValue))
+        criteria.iso = isoValue.isNull() ? QString("") : isoValue;
+
+    // If camera has an active cooler, then we check temperature against the absolute threshold.
+    // Else we prefer the closest passive temperature.
+    criteria.rankTemperature = m_TargetChip->getCCD()->hasCooler();
+    if (m_TargetChip->getCCD()->hasCoolerControl())
+        criteria.maxTemperatureDiff = maxDarkTemperatureDiff->value();
+    if (criteria.rankTemperature || criteria.maxTemperatureDiff >= 0)
+        m_TargetChip->getCCD()->getTemperature(&criteria.temperature);
 
-            // Find candidate with closest time in case we have multiple defect maps
-            if (thisMapScore > bestCandidateScore)
-                bestCandidate = map;
-        }
-    }
+    QVariantMap bestCandidate;
+    KStarsData::Instance()->userdb()->FindDarkFrame(criteria, bestCandidate);
 
     if (bestCandidate.isEmpty())
         return false;
 
     if (fabs(bestCandidate["duration"].toDouble() - duration) > 3)
-        emit i18n("Using available dark frame with %1 seconds exposure. Please take a dark frame with %1 seconds exposure for more accurate results.",
+        emit newLog(i18n("Using available dark frame with %1 seconds exposure. Please take a dark frame with %2 seconds exposure for more accurate results.",
                   QString::number(bestCandidate["duration"].toDouble(), 'f', 1),
-                  QString::number(duration, 'f', 1));
+                  QString::number(duration, 'f', 1)));
 
-    QString filename = bestCandidate["filename"].toString();
+    filename = bestCandidate["filename"].toString();
 
     // Finally check if the duration is acceptable
     QDateTime frameTime = bestCandidate["timestamp"].toDateTime();
     if (frameTime.daysTo(QDateTime::currentDateTime()) > Options::darkLibraryDuration())
     {
-        emit i18n("Dark frame %s is expired. Please create new master dark.", filename);
+        emit newLog(i18n("Dark frame %1 is expired. Please create new master dark.", filename));
         return false;
     }
 
-    if (m_CachedDarkFrames.contains(filename))
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////
+bool DarkLibrary::findDarkFrame(ISD::CameraChip *m_TargetChip, double duration, QSharedPointer<FITSData> &darkData)
+{
+    int binX = 1, binY = 1;
+    m_TargetChip->getBinning(&binX, &binY);
+    QString filename;
+    if (!findDarkFrameFile(m_TargetChip, duration, binX, binY, filename))
+        return false;
+
+    darkData = m_CachedDarkFrames.find(filename);
+    if (darkData)
     {
-        darkData = m_CachedDarkFrames[filename];
+        ImageMemory::instance().touch(darkData.get());
         return true;
     }
 
@@ -332,9 +288,11 @@ bool DarkLibrary::findDarkFrame(ISD::CameraChip *m_TargetChip, double duration,
         m_CachedDarkFrames.clear();
 
     // Finally we made it, let's put it in the hash
-    if (cacheDarkFrameFromFile(filename))
+    if (cacheDarkFrameFromFile(filename, &darkData))
     {
-        darkData = m_CachedDarkFrames[filename];
+        qCDebug(KSTARS_EKOS) << "Loaded dark frame" << filename << "- dark cache hits" << m_CachedDarkFrames.hits()
+                             << "misses" << m_CachedDarkFrames.misses() << "frames" << m_CachedDarkFrames.count()
+                             << "MB" << m_CachedDarkFrames.bytes() / 1e6;
         return true;
     }
 
@@ -352,63 +310,21 @@ bool DarkLibrary::findDarkFrame(ISD::CameraChip *m_TargetChip, double duration,
 ///////////////////////////////////////////////////////////////////////////////////////
 bool DarkLibrary::findDefectMap(ISD::CameraChip *m_TargetChip, double duration, QSharedPointer<DefectMap> &defectMap)
 {
-    QVariantMap bestCandidate;
-    for (auto &map : m_DarkFramesDatabaseList)
-    {
-        if (map["defectmap"].toString().isEmpty())
-            continue;
+    KSUserDB::DarkFrameCriteria criteria;
+    criteria.ccd = m_TargetChip->getCCD()->getDeviceName();
+    criteria.chip = static_cast<int>(m_TargetChip->getType());
+    criteria.duration = duration;
+    criteria.defectMapOnly = true;
+    m_TargetChip->getBinning(&criteria.binX, &criteria.binY);
 
-        // First check CCD name matches and check if we are on the correct chip
-        if (map["ccd"].toString() == m_TargetChip->getCCD()->getDeviceName() &&
-                map["chip"].toInt() == static_cast<int>(m_TargetChip->getType()))
-        {
-            int binX, binY;
-            m_TargetChip->getBinning(&binX, &binY);
-
-            // Then check if binning is the same
-            if (map["binX"].toInt() == binX && map["binY"].toInt() == binY)
-            {
-                if (bestCandidate.isEmpty())
-                {
-                    bestCandidate = map;
-                    continue;
-                }
-
-                // We try to find the best frame
-                // Frame closest in exposure duration wins
-                // Frame with temperature closest to stored temperature wins (if temperature is reported)
-                uint32_t thisMapScore = 0;
-                uint32_t bestCandidateScore = 0;
-
-                // Else we check for the closest passive temperature
-                if (m_TargetChip->getCCD()->hasCooler())
-                {
-                    double temperature = 0;
-                    m_TargetChip->getCCD()->getTemperature(&temperature);
-                    double diffMap = std::fabs(temperature - map["temperature"].toDouble());
-                    double diffBest = std::fabs(temperature - bestCandidate["temperature"].toDouble());
-                    // Prefer temperatures closest to target
-                    if (diffMap < diffBest)
-                        thisMapScore++;
-                    else if (diffBest < diffMap)
-                        bestCandidateScore++;
-                }
-
-                // Duration has a higher score priority over temperature
-                double diffMap = std::fabs(map["duration"].toDouble() - duration);
-                double diffBest = std::fabs(bestCandidate["duration"].toDouble() - duration);
-                if (diffMap < diffBest)
-                    thisMapScore += 2;
-                else if (diffBest < diffMap)
-                    bestCandidateScore += 2;
-
-                // Find candidate with closest time in case we have multiple defect maps
-                if (thisMapScore > bestCandidateScore)
-                    bestCandidate = map;
-            }
-        }
+    if (m_TargetChip->getCCD()->hasCooler())
+    {
+        m_TargetChip->getCCD()->getTemperature(&criteria.temperature);
+        criteria.rankTemperature = true;
     }
 
+    QVariantMap bestCandidate;
+    KStarsData::Instance()->userdb()->FindDarkFrame(criteria, bestCandidate);
 
     if (bestCandidate.isEmpty())
         return false;
@@ -420,18 +336,13 @@ bool DarkLibrary::findDefectMap(ISD::CameraChip *m_TargetChip, double duration,
     if (darkFilename.isEmpty() || defectFilename.isEmpty())
         return false;
 
-    if (m_CachedDefectMaps.contains(darkFilename))
-    {
-        defectMap = m_CachedDefectMaps[darkFilename];
+    defectMap = m_CachedDefectMaps.find(darkFilename);
+    if (defectMap)
         return true;
-    }
 
     // Finally we made it, let's put it in the hash
-    if (cacheDefectMapFromFile(darkFilename, defectFilename))
-    {
-        defectMap = m_CachedDefectMaps[darkFilename];
+    if (cacheDefectMapFromFile(darkFilename, defectFilename, &defectMap))
         return true;
-    }
     else
     {
         // Remove bad dark frame
@@ -443,7 +354,40 @@ bool DarkLibrary::findDefectMap(ISD::CameraChip *m_TargetChip, double duration,
 ///////////////////////////////////////////////////////////////////////////////////////
 ///
 ///////////////////////////////////////////////////////////////////////////////////////
-bool DarkLibrary::cacheDefectMapFromFile(const QString &key, const QString &filename)
+void DarkLibrary::preloadDarkFrames(ISD::CameraChip *targetChip, const QList<QPair<double, QPoint>> &exposures)
+{
+    if (targetChip == nullptr)
+        return;
+
+    // The database is only used from this thread, the frames are loaded in the background
+    QStringList filenames;
+    for (const auto &oneExposure : exposures)
+    {
+        QString filename;
+        if (findDarkFrameFile(targetChip, oneExposure.first, oneExposure.second.x(), oneExposure.second.y(), filename)
+                && !filenames.contains(filename) && !m_CachedDarkFrames.contains(filename))
+            filenames << filename;
+    }
+
+    if (filenames.isEmpty())
+        return;
+
+    qCDebug(KSTARS_EKOS) << "Preloading dark frames" << filenames;
+    Executors::run(Executors::Background, [this, filenames]()
+    {
+        for (const auto &oneFile : filenames)
+        {
+            if (KSUtils::getAvailableRAM() / 1e6 < CACHE_MEMORY_LIMIT)
+                break;
+            cacheDarkFrameFromFile(oneFile);
+        }
+    });
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////
+bool DarkLibrary::cacheDefectMapFromFile(const QString &key, const QString &filename, QSharedPointer<DefectMap> *defectMap)
 {
     QSharedPointer<DefectMap> oneMap;
     oneMap.reset(new DefectMap());
@@ -451,7 +395,12 @@ bool DarkLibrary::cacheDefectMapFromFile(const QString &key, const QString &file
     if (oneMap->load(filename))
     {
         oneMap->filterPixels();
-        m_CachedDefectMaps[key] = oneMap;
+        if (oneMap->thread() != QCoreApplication::instance()->thread())
+            oneMap->moveToThread(QCoreApplication::instance()->thread());
+        const uint64_t bytes = (oneMap->hotPixels().capacity() + oneMap->coldPixels().capacity()) * sizeof(BadPixel);
+        m_CachedDefectMaps.insert(key, oneMap, bytes);
+        if (defectMap)
+            *defectMap = oneMap;
         return true;
     }
 
@@ -462,7 +411,7 @@ bool DarkLibrary::cacheDefectMapFromFile(const QString &key, const QString &file
 ///////////////////////////////////////////////////////////////////////////////////////
 ///
 ///////////////////////////////////////////////////////////////////////////////////////
-bool DarkLibrary::cacheDarkFrameFromFile(const QString &filename)
+bool DarkLibrary::cacheDarkFrameFromFile(const QString &filename, QSharedPointer<FITSData> *loaded)
 {
     QSharedPointer<FITSData> data;
     data.reset(new FITSData(FITS_CALIBRATE), &QObject::deleteLater);
@@ -471,7 +420,22 @@ bool DarkLibrary::cacheDarkFrameFromFile(const QString &filename)
     rc.waitForFinished();
     if (rc.result())
     {
-        m_CachedDarkFrames[filename] = data;
+        // Frames loaded by the processing threads are deleted later in the main thread
+        if (data->thread() != QCoreApplication::instance()->thread())
+            data->moveToThread(QCoreApplication::instance()->thread());
+        const uint64_t bytes = static_cast<uint64_t>(data->samplesPerChannel()) * data->channels() * data->getBytesPerPixel();
+        m_CachedDarkFrames.insert(filename, data, bytes);
+        // Over the image memory budget, the frame is dropped from the cache and loaded again when needed
+        QPointer<DarkLibrary> library(this);
+        ImageMemory::instance().setEvictor(data.get(), [library, filename]()
+        {
+            if (library.isNull())
+                return false;
+            library->m_CachedDarkFrames.remove(filename);
+            return true;
+        });
+        if (loaded)
+            *loaded = data;
     }
     else
     {
@@ -546,8 +510,13 @@ void DarkLibrary::updateProperty(INDI::Property prop)
     }
 
     uint32_t totalElements = m_CurrentDarkFrame->channels() * m_CurrentDarkFrame->samplesPerChannel();
-    if (totalElements != m_DarkMasterBuffer.size())
-        m_DarkMasterBuffer.assign(totalElements, 0);
+    if (totalElements != m_DarkStack.elements() || m_DarkStack.frames() == 0)
+    {
+        // Keep the frames in memory while at most half the available memory is used, then in a scratch file
+        m_DarkStack.setMethod(static_cast<DarkStack::Method>(Options::darkLibraryStackMethod()), Options::darkLibraryStackSigma());
+        m_DarkStack.reset(totalElements, m_CurrentDarkFrame->getBytesPerPixel(), KSUtils::getAvailableRAM() / 2,
+                          QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("darks"));
+    }
 
     aggregate(m_CurrentDarkFrame);
     darkProgress->setValue(darkProgress->value() + 1);
@@ -845,11 +814,12 @@ void DarkLibrary::loadCurrentMasterDark(const QString &camera, int masterIndex)
 void DarkLibrary::loadCurrentMasterDefectMap()
 {
     // Find if we have an existing map
-    if (m_CachedDefectMaps.contains(m_MasterDarkFrameFilename))
+    QSharedPointer<DefectMap> cachedMap = m_CachedDefectMaps.find(m_MasterDarkFrameFilename);
+    if (cachedMap)
     {
-        if (m_CurrentDefectMap != m_CachedDefectMaps.value(m_MasterDarkFrameFilename))
+        if (m_CurrentDefectMap != cachedMap)
         {
-            m_CurrentDefectMap = m_CachedDefectMaps.value(m_MasterDarkFrameFilename);
+            m_CurrentDefectMap = cachedMap;
             m_DarkView->setDefectMap(m_CurrentDefectMap);
             m_CurrentDefectMap->setDarkData(m_CurrentDarkFrame);
         }
@@ -1290,8 +1260,8 @@ template <typename T>
 void DarkLibrary::aggregateInternal(const QSharedPointer<FITSData> &data)
 {
     T const *darkBuffer  = reinterpret_cast<T const*>(data->getImageBuffer());
-    for (uint32_t i = 0; i < m_DarkMasterBuffer.size(); i++)
-        m_DarkMasterBuffer[i] += darkBuffer[i];
+    if (!m_DarkStack.add(darkBuffer))
+        m_FileLabel->setText(i18n("Failed to keep dark frame for the master frame."));
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -1338,8 +1308,8 @@ void DarkLibrary::generateMasterFrame(const QSharedPointer<FITSData> &data, cons
     }
 
     emit newImage(data);
-    // Reset Master Buffer
-    m_DarkMasterBuffer.assign(m_DarkMasterBuffer.size(), 0);
+    // Reset Master Stack
+    m_DarkStack.reset(0, 0, 0);
 
 }
 
@@ -1350,10 +1320,12 @@ template <typename T>  void DarkLibrary::generateMasterFrameInternal(const QShar
         const QJsonObject &metadata)
 {
     T *writableBuffer = reinterpret_cast<T *>(data->getWritableImageBuffer());
-    const uint32_t count = metadata["count"].toInt();
-    // Average the values
-    for (uint32_t i = 0; i < m_DarkMasterBuffer.size(); i++)
-        writableBuffer[i] = m_DarkMasterBuffer[i] / count;
+    // Combine the values
+    if (!m_DarkStack.combine(writableBuffer))
+    {
+        m_FileLabel->setText(i18n("Failed to combine dark frames."));
+        return;
+    }
 
     QString ts = QDateTime::currentDateTime().toString("yyyy-MM-ddThh-mm-ss");
     QString path = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("darks/darkframe_" + ts +
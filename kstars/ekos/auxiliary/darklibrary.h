@@ -10,6 +10,8 @@
 #include "indi/indidustcap.h"
 #include "darkview.h"
 #include "defectmap.h"
+#include "darkstack.h"
+#include "mastercache.h"
 #include "ekos/ekos.h"
 
 #include <QDialog>
@@ -33,7 +35,7 @@ class SequenceJob;
  *
  * Dark Frames:
  *
- * The user can generate dark frames from an average combination of the camera dark frames. By default, 5 dark frames
+ * The user can generate dark frames from a sigma clipped combination of the camera dark frames. By default, 5 dark frames
  * are captured to merged into a single master frame. Frame duration, binning, and temperature are all configurable.
  * If the user select "Dark" in any of the Ekos module, Dark Library can be queried if a suitable dark frame exists given
  * the current camera settings (binning, temperature..etc). If a suitable frame exists, it is loaded up and send to /class DarkProcessor
@@ -74,6 +76,14 @@ class DarkLibrary : public QDialog, public Ui::DarkLibrary
          */
         bool findDefectMap(ISD::CameraChip *targetChip, double duration, QSharedPointer<DefectMap> &defectMap);        
 
+        /**
+         * @brief preloadDarkFrames Loads the dark frames matching the exposures in the background, so they are
+         * in the cache once the frames arrive.
+         * @param targetChip Camera chip pointer to lookup for relevant information.
+         * @param exposures Durations in seconds with their binning.
+         */
+        void preloadDarkFrames(ISD::CameraChip *targetChip, const QList<QPair<double, QPoint>> &exposures);
+
         void refreshFromDB();
         bool setCamera(ISD::Camera *device);
         void removeDevice(const QSharedPointer<ISD::GenericDevice> &device);
@@ -194,12 +204,19 @@ class DarkLibrary : public QDialog, public Ui::DarkLibrary
          */
         template <typename T> void aggregateInternal(const QSharedPointer<FITSData> &data);
 
+        /**
+         * @brief findDarkFrameFile Search the database for the file of the dark frame that matches the passed parameters.
+         * @return True if a suitable frame was found, false otherwise.
+         */
+        bool findDarkFrameFile(ISD::CameraChip *targetChip, double duration, int binX, int binY, QString &filename);
+
         /**
          * @brief cacheDarkFrameFromFile Load dark frame from disk and saves it in the local dark frames cache
          * @param filename path of dark frame to load
+         * @param data If not null, set to the loaded frame, which may be too large for the cache.
          * @return True if file is successfully loaded, false otherwise.
          */
-        bool cacheDarkFrameFromFile(const QString &filename);
+        bool cacheDarkFrameFromFile(const QString &filename, QSharedPointer<FITSData> *data = nullptr);
 
 
         ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -232,9 +249,10 @@ class DarkLibrary : public QDialog, public Ui::DarkLibrary
          * @brief cacheDefectMapFromFile Load defect map from disk and saves it in the local defect maps cache
          * @param key dark file name that is used as the key in the defect map cache
          * @param filename path of dark frame to load
+         * @param defectMap If not null, set to the loaded map, which may be too large for the cache.
          * @return True if file is successfully loaded, false otherwise.
          */
-        bool cacheDefectMapFromFile(const QString &key, const QString &filename);
+        bool cacheDefectMapFromFile(const QString &key, const QString &filename, QSharedPointer<DefectMap> *defectMap = nullptr);
 
         ////////////////////////////////////////////////////////////////////
         /// Settings
@@ -279,8 +297,9 @@ class DarkLibrary : public QDialog, public Ui::DarkLibrary
         ////////////////////////////////////////////////////////////////////////////////////////////////
 
         QList<QVariantMap> m_DarkFramesDatabaseList;
-        QMap<QString, QSharedPointer<FITSData>> m_CachedDarkFrames;
-        QMap<QString, QSharedPointer<DefectMap>> m_CachedDefectMaps;
+        // Least recently used master frames and maps, within the DarkLibraryCacheSize budget
+        MasterCache<FITSData> m_CachedDarkFrames {0};
+        MasterCache<DefectMap> m_CachedDefectMaps {0};
 
         ISD::Camera *m_Camera {nullptr};
         ISD::CameraChip *m_TargetChip {nullptr};
@@ -291,7 +310,7 @@ class DarkLibrary : public QDialog, public Ui::DarkLibrary
         QSqlTableModel *darkFramesModel = nullptr;
         QSortFilterProxyModel *sortFilter = nullptr;
 
-        std::vector<uint32_t> m_DarkMasterBuffer;
+        DarkStack m_DarkStack;
         uint32_t m_DarkImagesCounter {0};
         bool m_RememberFITSViewer {true};
         bool m_RememberSummaryView {true};
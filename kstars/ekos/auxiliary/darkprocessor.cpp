@@ -8,9 +8,11 @@
 #include "darklibrary.h"
 #include "ekos/auxiliary/opticaltrainsettings.h"
 
+#include <algorithm>
 #include <array>
 
 #include "ekos_debug.h"
+#include "auxiliary/executors.h"
 
 namespace Ekos
 {
@@ -84,33 +86,29 @@ void DarkProcessor::normalizeDefectsInternal(const QSharedPointer<DefectMap> &de
     // e.g. if we send a subframed light frame 100x100 pixels wide
     // but the source defect map covers 1000x1000 pixels array, then we need to only compensate
     // for the 100x100 region.
-    for (BadPixelSet::const_iterator onePixel = defectMap->hotThreshold();
-            onePixel != defectMap->hotPixels().cend(); ++onePixel)
+    const QVector<uint32_t> indexes = defectMap->defectIndexes(width, lightData->height(), offsetX, offsetY);
+    const ptrdiff_t stride = width;
+    const std::array<ptrdiff_t, 8> neighbours {{ -stride - 1, -stride, -stride + 1, -1, 1, stride - 1, stride, stride + 1 }};
+
+    // The medians are taken from the uncorrected frame before any pixel is replaced, so blocks of pixels can be
+    // filtered in parallel
+    QVector<T> medians(indexes.size());
+    auto filter = [&](uint32_t first)
     {
-        const uint16_t x = (*onePixel).x;
-        const uint16_t y = (*onePixel).y;
-
-        if (x <= offsetX || y <= offsetY)
-            continue;
-
-        uint32_t offset = (x - offsetX) + (y - offsetY) * width;
-
-        lightBuffer[offset] = median3x3Filter(x - offsetX, y - offsetY, width, lightBuffer);
-    }
-
-    for (BadPixelSet::const_iterator onePixel = defectMap->coldPixels().cbegin();
-            onePixel != defectMap->coldThreshold(); ++onePixel)
-    {
-        const uint16_t x = (*onePixel).x;
-        const uint16_t y = (*onePixel).y;
-
-        if (x <= offsetX || y <= offsetY)
-            continue;
-
-        uint32_t offset = (x - offsetX) + (y - offsetY) * width;
-
-        lightBuffer[offset] = median3x3Filter(x - offsetX, y - offsetY, width, lightBuffer);
-    }
+        const uint32_t last = std::min<uint32_t>(first + DEFECTS_PER_BLOCK, indexes.size());
+        for (uint32_t i = first; i < last; i++)
+            medians[i] = median3x3Filter(lightBuffer + indexes[i], neighbours);
+    };
+    QVector<uint32_t> blocks;
+    for (uint32_t first = 0; first < static_cast<uint32_t>(indexes.size()); first += DEFECTS_PER_BLOCK)
+        blocks.append(first);
+    if (blocks.size() > 1)
+        Executors::blockingMap(lightData->executorPriority(), blocks, filter);
+    else if (!blocks.isEmpty())
+        filter(0);
+
+    for (int i = 0; i < indexes.size(); i++)
+        lightBuffer[indexes[i]] = medians[i];
 
     lightData->calculateStats(true);
 
@@ -120,29 +118,16 @@ void DarkProcessor::normalizeDefectsInternal(const QSharedPointer<DefectMap> &de
 ///
 ///////////////////////////////////////////////////////////////////////////////////////
 template <typename T>
-T DarkProcessor::median3x3Filter(uint16_t x, uint16_t y, uint32_t width, T *buffer)
+T DarkProcessor::median3x3Filter(const T *pixel, const std::array<ptrdiff_t, 8> &neighbours)
 {
-    T *top = buffer + (y - 1) * width + (x - 1);
-    T *mid = buffer + (y - 0) * width + (x - 1);
-    T *bot = buffer + (y + 1) * width + (x - 1);
-
+    // The pixel itself is the defective value, so only its 8 neighbours are used
     std::array<T, 8> elements;
+    for (size_t i = 0; i < elements.size(); i++)
+        elements[i] = pixel[neighbours[i]];
 
-    // Top
-    elements[0] = *(top + 0);
-    elements[1] = *(top + 1);
-    elements[2] = *(top + 2);
-    // Mid
-    elements[3] = *(mid + 0);
-    // Mid+1 is the defective value, so we skip and go for + 2
-    elements[4] = *(mid + 2);
-    // Bottom
-    elements[5] = *(bot + 0);
-    elements[6] = *(bot + 1);
-    elements[7] = *(bot + 2);
-
-    std::sort(elements.begin(), elements.end());
-    auto median = (elements[3] + elements[4]) / 2;
+    std::nth_element(elements.begin(), elements.begin() + 4, elements.end());
+    auto lower = *std::max_element(elements.begin(), elements.begin() + 4);
+    auto median = (lower + elements[4]) / 2;
     return median;
 }
 
@@ -206,14 +191,27 @@ void DarkProcessor::subtractInternal(const QSharedPointer<FITSData> &darkData, c
     const uint32_t darkoffset = offsetX + offsetY * darkStride;
     T const *darkBuffer  = reinterpret_cast<T const*>(darkData->getImageBuffer()) + darkoffset;
 
-    for (uint32_t y = 0; y < height; y++)
+    // Rows are subtracted in blocks in parallel. max(light, dark) - dark saturates at zero without a branch,
+    // which the compiler vectorizes, e.g. to a saturating subtraction for 16 bit samples.
+    auto subtract = [&](uint32_t firstRow)
     {
-        for (uint32_t x = 0; x < width; x++)
-            lightBuffer[x] = (lightBuffer[x] > darkBuffer[x]) ? (lightBuffer[x] - darkBuffer[x]) : 0;
+        const uint32_t lastRow = std::min(firstRow + ROWS_PER_BLOCK, height);
+        for (uint32_t y = firstRow; y < lastRow; y++)
+        {
+            T *light = lightBuffer + static_cast<size_t>(y) * width;
+            T const *dark = darkBuffer + static_cast<size_t>(y) * darkStride;
+            for (uint32_t x = 0; x < width; x++)
+                light[x] = static_cast<T>(std::max(light[x], dark[x]) - dark[x]);
+        }
+    };
 
-        lightBuffer += width;
-        darkBuffer += darkStride;
-    }
+    QVector<uint32_t> blocks;
+    for (uint32_t firstRow = 0; firstRow < height; firstRow += ROWS_PER_BLOCK)
+        blocks.append(firstRow);
+    if (static_cast<uint64_t>(width) * height >= PARALLEL_SUBTRACT_PIXELS)
+        Executors::blockingMap(lightData->executorPriority(), blocks, subtract);
+    else
+        std::for_each(blocks.cbegin(), blocks.cend(), subtract);
 
     lightData->calculateStats(true);
 }
@@ -233,7 +231,8 @@ void DarkProcessor::denoise(int trainID, ISD::CameraChip *m_TargetChip, const QS
     if (settings.isValid())
         useDefect = settings.toMap().contains("preferDefectsRadio");
 
-    QFuture<bool> result = QtConcurrent::run(this, &DarkProcessor::denoiseInternal, useDefect);
+    // The darks of the guide and focus frames are subtracted in the real-time pool
+    QFuture<bool> result = Executors::run(targetData->executorPriority(), &DarkProcessor::denoiseInternal, this, useDefect);
     m_Watcher.setFuture(result);
 }
 
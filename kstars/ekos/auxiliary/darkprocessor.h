@@ -14,8 +14,11 @@
 
 #include <QFutureWatcher>
 
+#include <array>
+
 class TestDefects;
 class TestSubtraction;
+class TestFitsBenchmark;
 
 namespace Ekos
 {
@@ -95,7 +98,14 @@ class DarkProcessor : public QObject
                                       uint16_t offsetX, uint16_t offsetY);
 
         template <typename T>
-        T median3x3Filter(uint16_t x, uint16_t y, uint32_t width, T *buffer);
+        static T median3x3Filter(const T *pixel, const std::array<ptrdiff_t, 8> &neighbours);
+
+        // Rows of a block of the subtraction done by a thread
+        static constexpr uint32_t ROWS_PER_BLOCK = 64;
+        // Smaller frames are subtracted in the calling thread
+        static constexpr uint64_t PARALLEL_SUBTRACT_PIXELS = 1 << 20;
+        // Bad pixels of a block of the defect filter done by a thread
+        static constexpr uint32_t DEFECTS_PER_BLOCK = 4096;
 
     signals:
         void darkFrameCompleted(bool);
@@ -117,6 +127,7 @@ class DarkProcessor : public QObject
         // Testing
         friend class ::TestDefects;
         friend class ::TestSubtraction;
+        friend class ::TestFitsBenchmark;
 
 };
 
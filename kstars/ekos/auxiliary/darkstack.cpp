@@ -0,0 +1,241 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "darkstack.h"
+
+#include "ekos_debug.h"
+#include "auxiliary/executors.h"
+
+#include <QDir>
+#include <QTemporaryFile>
+#include <QVector>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+
+namespace Ekos
+{
+
+namespace
+{
+// Scale of the median absolute deviation to the standard deviation of a normal distribution
+constexpr double MAD_TO_SIGMA = 1.4826;
+
+double median(float *values, int n)
+{
+    const int middle = n / 2;
+    std::nth_element(values, values + middle, values + n);
+    double result = values[middle];
+    if (n % 2 == 0)
+        result = (result + *std::max_element(values, values + middle)) / 2.0;
+    return result;
+}
+
+template <typename T>
+T toSample(double value)
+{
+    if (std::is_integral<T>::value)
+    {
+        value = std::round(value);
+        value = std::max(value, static_cast<double>(std::numeric_limits<T>::lowest()));
+        value = std::min(value, static_cast<double>(std::numeric_limits<T>::max()));
+    }
+    return static_cast<T>(value);
+}
+}
+
+DarkStack::DarkStack(Method method, double sigma) : m_Method(method), m_Sigma(sigma)
+{
+}
+
+DarkStack::~DarkStack() = default;
+
+void DarkStack::setMethod(Method method, double sigma)
+{
+    m_Method = method;
+    m_Sigma = sigma;
+}
+
+void DarkStack::reset(uint32_t elements, int elementSize, uint64_t memoryLimit, const QString &scratchDir)
+{
+    m_Elements = elements;
+    m_ElementSize = elementSize;
+    m_MemoryLimit = memoryLimit;
+    m_ScratchDir = scratchDir;
+    m_Frames = 0;
+    std::vector<uint8_t>().swap(m_Memory);
+    m_Scratch.reset();
+}
+
+bool DarkStack::spill()
+{
+    const QString dir = m_ScratchDir.isEmpty() ? QDir::tempPath() : m_ScratchDir;
+    m_Scratch.reset(new QTemporaryFile(QDir(dir).filePath("darkstack_XXXXXX")));
+    if (!m_Scratch->open() || m_Scratch->write(reinterpret_cast<const char *>(m_Memory.data()), m_Memory.size())
+            != static_cast<qint64>(m_Memory.size()))
+    {
+        qCWarning(KSTARS_EKOS) << "Failed to write dark stack scratch file" << m_Scratch->fileName();
+        m_Scratch.reset();
+        return false;
+    }
+
+    qCDebug(KSTARS_EKOS) << "Dark stack of" << m_Frames << "frames moved to scratch file" << m_Scratch->fileName();
+    std::vector<uint8_t>().swap(m_Memory);
+    return true;
+}
+
+template <typename T>
+bool DarkStack::add(const T *buffer)
+{
+    if (buffer == nullptr || m_Elements == 0 || sizeof(T) != static_cast<size_t>(m_ElementSize))
+        return false;
+
+    const uint64_t frameBytes = static_cast<uint64_t>(m_Elements) * m_ElementSize;
+    if (!m_Scratch && (m_Frames + 1) * frameBytes > m_MemoryLimit && !spill())
+        return false;
+
+    const auto *bytes = reinterpret_cast<const uint8_t *>(buffer);
+    if (m_Scratch)
+    {
+        if (m_Scratch->write(reinterpret_cast<const char *>(bytes), frameBytes) != static_cast<qint64>(frameBytes))
+        {
+            qCWarning(KSTARS_EKOS) << "Failed to write dark frame to scratch file" << m_Scratch->fileName();
+            return false;
+        }
+    }
+    else
+        m_Memory.insert(m_Memory.end(), bytes, bytes + frameBytes);
+
+    m_Frames++;
+    return true;
+}
+
+const uint8_t *DarkStack::frame(int index, const uint8_t *mapped) const
+{
+    const uint64_t offset = static_cast<uint64_t>(index) * m_Elements * m_ElementSize;
+    return (mapped ? mapped : m_Memory.data()) + offset;
+}
+
+template <typename T>
+bool DarkStack::combine(T *output)
+{
+    if (output == nullptr || m_Frames == 0 || sizeof(T) != static_cast<size_t>(m_ElementSize))
+        return false;
+
+    uchar *mapped = nullptr;
+    if (m_Scratch)
+    {
+        m_Scratch->flush();
+        mapped = m_Scratch->map(0, static_cast<qint64>(m_Frames) * m_Elements * m_ElementSize);
+        if (mapped == nullptr)
+        {
+            qCWarning(KSTARS_EKOS) << "Failed to map dark stack scratch file" << m_Scratch->fileName();
+            return false;
+        }
+    }
+
+    const int count = m_Frames;
+    const Method method = m_Method;
+    const double sigma = m_Sigma;
+    QVector<uint32_t> tiles((m_Elements + TILE_ELEMENTS - 1) / TILE_ELEMENTS);
+    std::iota(tiles.begin(), tiles.end(), 0);
+    Executors::blockingMap(Executors::Background, tiles, [&](uint32_t tile)
+    {
+        const uint32_t first = tile * TILE_ELEMENTS;
+        const uint32_t length = std::min(TILE_ELEMENTS, m_Elements - first);
+
+        if (method == STACK_MEAN)
+        {
+            std::vector<double> sums(length, 0.0);
+            for (int f = 0; f < count; f++)
+            {
+                const T *source = reinterpret_cast<const T *>(frame(f, mapped)) + first;
+                for (uint32_t j = 0; j < length; j++)
+                    sums[j] += source[j];
+            }
+            for (uint32_t j = 0; j < length; j++)
+                output[first + j] = toSample<T>(sums[j] / count);
+            return;
+        }
+
+        // The tile of every frame, one frame after the other
+        std::vector<float> stack(static_cast<size_t>(length) * count);
+        for (int f = 0; f < count; f++)
+        {
+            const T *source = reinterpret_cast<const T *>(frame(f, mapped)) + first;
+            float *destination = stack.data() + static_cast<size_t>(f) * length;
+            for (uint32_t j = 0; j < length; j++)
+                destination[j] = static_cast<float>(source[j]);
+        }
+
+        std::vector<float> samples(count), deviations(count);
+        for (uint32_t j = 0; j < length; j++)
+        {
+            for (int f = 0; f < count; f++)
+                samples[f] = stack[static_cast<size_t>(f) * length + j];
+            output[first + j] = toSample<T>(combineSamples(samples.data(), deviations.data(), count, method, sigma));
+        }
+    });
+
+    if (mapped)
+        m_Scratch->unmap(mapped);
+    return true;
+}
+
+double DarkStack::combineSamples(float *samples, float *deviations, int n, Method method, double sigma)
+{
+    if (n <= 0)
+        return 0;
+    if (method == STACK_MEAN || n < 3)
+        return std::accumulate(samples, samples + n, 0.0) / n;
+
+    const double location = median(samples, n);
+    if (method == STACK_MEDIAN)
+        return location;
+
+    for (int i = 0; i < n; i++)
+        deviations[i] = std::fabs(samples[i] - location);
+    const double scale = MAD_TO_SIGMA * median(deviations, n);
+    // Most samples are the same, which is what the master should be
+    if (scale <= 0)
+        return location;
+
+    const double low = location - sigma * scale;
+    const double high = location + sigma * scale;
+    double sum = 0;
+    int kept = 0;
+    for (int i = 0; i < n; i++)
+    {
+        if (method == STACK_WINSORIZED)
+            sum += std::min(high, std::max(low, static_cast<double>(samples[i])));
+        else if (samples[i] >= low && samples[i] <= high)
+        {
+            sum += samples[i];
+            kept++;
+        }
+    }
+    if (method == STACK_WINSORIZED)
+        return sum / n;
+    return kept > 0 ? sum / kept : location;
+}
+
+#define DARKSTACK_INSTANTIATE(T) \
+    template bool DarkStack::add<T>(const T *buffer); \
+    template bool DarkStack::combine<T>(T *output);
+
+DARKSTACK_INSTANTIATE(uint8_t)
+DARKSTACK_INSTANTIATE(int16_t)
+DARKSTACK_INSTANTIATE(uint16_t)
+DARKSTACK_INSTANTIATE(int32_t)
+DARKSTACK_INSTANTIATE(uint32_t)
+DARKSTACK_INSTANTIATE(float)
+DARKSTACK_INSTANTIATE(int64_t)
+DARKSTACK_INSTANTIATE(double)
+
+}
@@ -0,0 +1,105 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QString>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class QTemporaryFile;
+
+namespace Ekos
+{
+
+/**
+ * @class DarkStack
+ * @short Keeps the frames of a master dark or bias and combines them pixel by pixel.
+ *
+ * Frames are kept in their own data type, in memory until the memory limit is reached and in a scratch file after
+ * that. The scratch file is memory mapped when the frames are combined, so only the tiles being combined need to be
+ * in memory. The image is combined in tiles of TILE_ELEMENTS samples, on all threads.
+ *
+ * Median based sigma clipping and winsorizing keep hot pixel hits and cosmic rays of single frames out of the master.
+ *
+ * @version 1.0
+ */
+class DarkStack
+{
+    public:
+        typedef enum
+        {
+            STACK_MEAN,
+            STACK_MEDIAN,
+            // Mean of the samples within sigma deviations of the median
+            STACK_SIGMA_CLIP,
+            // Mean of the samples clamped to sigma deviations of the median
+            STACK_WINSORIZED
+        } Method;
+
+        // Samples combined at a time by a thread
+        static constexpr uint32_t TILE_ELEMENTS = 1 << 14;
+
+        explicit DarkStack(Method method = STACK_SIGMA_CLIP, double sigma = 3.0);
+        ~DarkStack();
+
+        /**
+         * @brief reset Removes all frames and prepares for frames of elements samples.
+         * @param elements Samples of a frame, over all channels.
+         * @param elementSize Bytes per sample.
+         * @param memoryLimit Bytes of frames kept in memory, further frames go to the scratch file.
+         * @param scratchDir Directory of the scratch file, the temporary directory if empty.
+         */
+        void reset(uint32_t elements, int elementSize, uint64_t memoryLimit, const QString &scratchDir = QString());
+
+        /**
+         * @brief add Adds a frame of elements samples.
+         * @return False if the frame can't be kept.
+         */
+        template <typename T> bool add(const T *buffer);
+
+        /**
+         * @brief combine Combines the frames into output, of elements samples.
+         * @return False if there are no frames or the scratch file can't be mapped.
+         */
+        template <typename T> bool combine(T *output);
+
+        void setMethod(Method method, double sigma);
+
+        int frames() const
+        {
+            return m_Frames;
+        }
+        uint32_t elements() const
+        {
+            return m_Elements;
+        }
+        bool spilled() const
+        {
+            return m_Scratch != nullptr;
+        }
+
+        /** @brief combineSamples Combines n samples with method, reordering them. Deviations holds n values. */
+        static double combineSamples(float *samples, float *deviations, int n, Method method, double sigma);
+
+    private:
+        bool spill();
+        const uint8_t *frame(int index, const uint8_t *mapped) const;
+
+        Method m_Method;
+        double m_Sigma;
+        uint32_t m_Elements {0};
+        int m_ElementSize {0};
+        uint64_t m_MemoryLimit {0};
+        QString m_ScratchDir;
+        int m_Frames {0};
+        std::vector<uint8_t> m_Memory;
+        std::unique_ptr<QTemporaryFile> m_Scratch;
+};
+
+}
@@ -5,8 +5,11 @@
 */
 
 #include "defectmap.h"
+#include "auxiliary/executors.h"
 #include <QJsonDocument>
 
+#include <algorithm>
+
 //////////////////////////////////////////////////////////////////////////////
 ///
 //////////////////////////////////////////////////////////////////////////////
@@ -58,22 +61,27 @@ bool DefectMap::load(const QString &filename)
 
     m_HotPixels.clear();
     m_ColdPixels.clear();
+    m_HotPixels.reserve(hot.size());
+    m_ColdPixels.reserve(cold.size());
 
     for (const auto &onePixel : qAsConst(hot))
     {
         QJsonObject oneObject = onePixel.toObject();
-        m_HotPixels.insert(BadPixel(oneObject["x"].toInt(), oneObject["y"].toInt(), oneObject["value"].toDouble()));
+        m_HotPixels.push_back(BadPixel(oneObject["x"].toInt(), oneObject["y"].toInt(), oneObject["value"].toDouble()));
     }
 
-    m_HotPixelsCount = m_HotPixels.size();
-
     for (const auto &onePixel : qAsConst(cold))
     {
         QJsonObject oneObject = onePixel.toObject();
-        m_ColdPixels.insert(BadPixel(oneObject["x"].toInt(), oneObject["y"].toInt(), oneObject["value"].toDouble()));
+        m_ColdPixels.push_back(BadPixel(oneObject["x"].toInt(), oneObject["y"].toInt(), oneObject["value"].toDouble()));
     }
 
+    sortPixels();
+    m_HotPixelsThreshold = m_HotPixels.cbegin();
+    m_ColdPixelsThreshold = m_ColdPixels.cend();
+    m_HotPixelsCount = m_HotPixels.size();
     m_ColdPixelsCount = m_ColdPixels.size();
+    invalidateIndexes();
     return true;
 }
 
@@ -227,22 +235,64 @@ void DefectMap::initBadPixelsInternal(double hotPixelThreshold,
         samples /= downsample;
     }
 
-    // Need templated function
-    for (uint32_t y = 4; y < height - 4; y += downsample)
+    // The candidates of bands of rows are collected on all threads, then sorted once. Filtering by the
+    // aggressiveness afterwards only searches the sorted pixels.
+    struct Candidates
     {
-        for (uint32_t x = 4; x < width - 4; x += downsample)
+        uint32_t firstRow;
+        BadPixelSet hot, cold;
+    };
+    const uint32_t rows = (width > 8 && height > 8) ? (height - 8 + downsample - 1) / downsample : 0;
+    const uint32_t bandRows = 64;
+    QVector<Candidates> bands((rows + bandRows - 1) / bandRows);
+    for (int i = 0; i < bands.size(); i++)
+        bands[i].firstRow = i * bandRows;
+
+    Executors::blockingMap(Executors::Interactive, bands, [&](Candidates & band)
+    {
+        const uint32_t lastRow = std::min(rows, band.firstRow + bandRows);
+        for (uint32_t row = band.firstRow; row < lastRow; row++)
         {
-            uint32_t offset = x + y * width;
-            if (buffer[offset] > hotPixelThreshold)
-                m_HotPixels.insert(BadPixel(x, y, buffer[offset]));
-            else if (buffer[offset] < coldPixelThreshold)
-                m_ColdPixels.insert(BadPixel(x, y, buffer[offset]));
+            const uint32_t y = 4 + row * downsample;
+            for (uint32_t x = 4; x < width - 4; x += downsample)
+            {
+                uint32_t offset = x + y * width;
+                if (buffer[offset] > hotPixelThreshold)
+                    band.hot.push_back(BadPixel(x, y, buffer[offset]));
+                else if (buffer[offset] < coldPixelThreshold)
+                    band.cold.push_back(BadPixel(x, y, buffer[offset]));
+            }
         }
+    });
+
+    size_t hotCount = 0, coldCount = 0;
+    for (const auto &band : bands)
+    {
+        hotCount += band.hot.size();
+        coldCount += band.cold.size();
+    }
+    m_HotPixels.reserve(hotCount);
+    m_ColdPixels.reserve(coldCount);
+    for (const auto &band : bands)
+    {
+        m_HotPixels.insert(m_HotPixels.end(), band.hot.begin(), band.hot.end());
+        m_ColdPixels.insert(m_ColdPixels.end(), band.cold.begin(), band.cold.end());
     }
 
+    sortPixels();
     filterPixels();
 }
 
+//////////////////////////////////////////////////////////////////////////////
+///
+//////////////////////////////////////////////////////////////////////////////
+void DefectMap::sortPixels()
+{
+    // Stable, so that pixels of the same value stay in frame order as they did in the multiset
+    std::stable_sort(m_HotPixels.begin(), m_HotPixels.end());
+    std::stable_sort(m_ColdPixels.begin(), m_ColdPixels.end());
+}
+
 //////////////////////////////////////////////////////////////////////////////
 ///
 //////////////////////////////////////////////////////////////////////////////
@@ -251,19 +301,13 @@ void DefectMap::filterPixels()
     double hotPixelThreshold =  getHotThreshold(m_HotPixelsAggressiveness);
     double coldPixelThreshold = getColdThreshold(m_ColdPixelsAggressiveness);
 
-    m_HotPixelsThreshold = m_HotPixels.lower_bound(BadPixel(0, 0, hotPixelThreshold));
-    m_ColdPixelsThreshold = m_ColdPixels.lower_bound(BadPixel(0, 0, coldPixelThreshold));
-
-    if (m_HotPixelsThreshold == m_HotPixels.cend())
-        m_HotPixelsCount = 0;
-    else
-        m_HotPixelsCount = std::distance(m_HotPixelsThreshold, m_HotPixels.cend());
+    m_HotPixelsThreshold = std::lower_bound(m_HotPixels.cbegin(), m_HotPixels.cend(), BadPixel(0, 0, hotPixelThreshold));
+    m_ColdPixelsThreshold = std::lower_bound(m_ColdPixels.cbegin(), m_ColdPixels.cend(), BadPixel(0, 0, coldPixelThreshold));
 
-    if (m_ColdPixelsThreshold == m_ColdPixels.cbegin())
-        m_ColdPixelsCount = 0;
-    else
-        m_ColdPixelsCount = std::distance(m_ColdPixels.cbegin(), m_ColdPixelsThreshold);
+    m_HotPixelsCount = std::distance(m_HotPixelsThreshold, m_HotPixels.cend());
+    m_ColdPixelsCount = std::distance(m_ColdPixels.cbegin(), m_ColdPixelsThreshold);
 
+    invalidateIndexes();
     emit pixelsUpdated(m_HotPixelsCount, m_ColdPixelsCount);
 }
 
@@ -273,6 +317,7 @@ void DefectMap::filterPixels()
 void DefectMap::setHotEnabled(bool enabled)
 {
     m_HotEnabled = enabled;
+    invalidateIndexes();
     emit pixelsUpdated(m_HotEnabled ? m_HotPixelsCount : 0, m_ColdPixelsCount);
 }
 
@@ -282,5 +327,49 @@ void DefectMap::setHotEnabled(bool enabled)
 void DefectMap::setColdEnabled(bool enabled)
 {
     m_ColdEnabled = enabled;
+    invalidateIndexes();
     emit pixelsUpdated(m_HotPixelsCount, m_ColdEnabled ? m_ColdPixelsCount : 0);
 }
+
+//////////////////////////////////////////////////////////////////////////////
+///
+//////////////////////////////////////////////////////////////////////////////
+void DefectMap::invalidateIndexes()
+{
+    QMutexLocker locker(&m_IndexesMutex);
+    m_IndexesFrame = QRect();
+    m_Indexes.clear();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+///
+//////////////////////////////////////////////////////////////////////////////
+QVector<uint32_t> DefectMap::defectIndexes(uint32_t width, uint32_t height, uint16_t offsetX, uint16_t offsetY) const
+{
+    const QRect frame(offsetX, offsetY, width, height);
+    QMutexLocker locker(&m_IndexesMutex);
+    if (frame == m_IndexesFrame)
+        return m_Indexes;
+
+    QVector<uint32_t> indexes;
+    indexes.reserve((m_HotEnabled ? m_HotPixelsCount : 0) + (m_ColdEnabled ? m_ColdPixelsCount : 0));
+    auto append = [&](const BadPixel & onePixel)
+    {
+        if (onePixel.x <= offsetX || onePixel.y <= offsetY)
+            return;
+        const uint32_t x = onePixel.x - offsetX;
+        const uint32_t y = onePixel.y - offsetY;
+        if (x + 1 < width && y + 1 < height)
+            indexes.append(x + y * width);
+    };
+    std::for_each(hotThreshold(), m_HotPixels.cend(), append);
+    std::for_each(m_ColdPixels.cbegin(), coldThreshold(), append);
+
+    // In memory order, and once each
+    std::sort(indexes.begin(), indexes.end());
+    indexes.erase(std::unique(indexes.begin(), indexes.end()), indexes.end());
+
+    m_Indexes = indexes;
+    m_IndexesFrame = frame;
+    return indexes;
+}
@@ -6,9 +6,12 @@
 
 #pragma once
 
-#include <set>
+#include <vector>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QMutex>
+#include <QRect>
+#include <QVector>
 
 #include "fitsviewer/fitsdata.h"
 
@@ -26,7 +29,8 @@ class BadPixel
         double value {0};
 };
 
-typedef std::multiset<BadPixel> BadPixelSet;
+// Bad pixels sorted by value, so that the pixels beyond a threshold are found by binary search
+typedef std::vector<BadPixel> BadPixelSet;
 
 class DefectMap : public QObject
 {
@@ -91,6 +95,14 @@ class DefectMap : public QObject
         }
 
         void filterPixels();
+
+        /**
+         * @brief defectIndexes Sorted buffer indexes of the enabled hot and cold pixels in a frame of width x height
+         * whose top left pixel is at offsetX, offsetY of the sensor. Pixels on the edges of the frame have no 3x3
+         * neighbourhood and are left out. The indexes are kept until the pixels or their thresholds change.
+         */
+        QVector<uint32_t> defectIndexes(uint32_t width, uint32_t height, uint16_t offsetX, uint16_t offsetY) const;
+
     signals:
         //        void hotPixelsUpdated(const BadPixelSet::const_iterator &start, const BadPixelSet::const_iterator &end);
         //        void coldPixelsUpdated(const BadPixelSet::const_iterator &start, const BadPixelSet::const_iterator &end);
@@ -100,8 +112,10 @@ class DefectMap : public QObject
         double getHotThreshold(uint8_t aggressiveness);
         double getColdThreshold(uint8_t aggressiveness);
         double calculateSigma(uint8_t aggressiveness);
+        void invalidateIndexes();
         template <typename T>
         void initBadPixelsInternal(double hotPixelThreshold, double coldPixelThreshold);
+        void sortPixels();
 
         BadPixelSet m_ColdPixels, m_HotPixels;
         BadPixelSet::const_iterator m_ColdPixelsThreshold, m_HotPixelsThreshold;
@@ -114,5 +128,10 @@ class DefectMap : public QObject
 
         QSharedPointer<FITSData> m_DarkData;
 
+        // Indexes of the last frame geometry asked for, which may be asked from several threads
+        mutable QMutex m_IndexesMutex;
+        mutable QVector<uint32_t> m_Indexes;
+        mutable QRect m_IndexesFrame;
+
 };
 
@@ -0,0 +1,218 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "indexfilecache.h"
+
+#include "Options.h"
+#include "auxiliary/executors.h"
+#include <ekos_align_debug.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+
+namespace Ekos
+{
+
+namespace
+{
+// Arcminutes of the quads of the index files of each scale number, as in OpsAstrometryIndexFiles
+constexpr double SKYMARK_SIZES[] = {2.8, 4.0, 5.6, 8, 11, 16, 22, 30, 42, 60, 85, 120, 170, 240, 340, 480, 680, 1000,
+                                    1400, 2000
+                                   };
+
+// Bytes between the reads that bring the pages of a mapped file in
+constexpr qint64 READ_STRIDE = 4096;
+}
+
+IndexFileCache *IndexFileCache::m_Instance = nullptr;
+
+IndexFileCache *IndexFileCache::Instance()
+{
+    if (m_Instance == nullptr)
+        m_Instance = new IndexFileCache();
+    return m_Instance;
+}
+
+void IndexFileCache::release()
+{
+    delete m_Instance;
+    m_Instance = nullptr;
+}
+
+IndexFileCache::~IndexFileCache()
+{
+    {
+        QMutexLocker locker(&m_Mutex);
+        m_Pending = false;
+    }
+    m_Future.waitForFinished();
+}
+
+double IndexFileCache::skymarkSize(const QString &fileName)
+{
+    static const QRegularExpression indexName("^index[-_]\\d{2}(\\d{2})([-_]\\d+)?\\.fits$",
+            QRegularExpression::CaseInsensitiveOption);
+    const auto match = indexName.match(QFileInfo(fileName).fileName());
+    if (!match.hasMatch())
+        return -1;
+
+    const int scale = match.captured(1).toInt();
+    if (scale < 0 || scale >= static_cast<int>(sizeof(SKYMARK_SIZES) / sizeof(SKYMARK_SIZES[0])))
+        return -1;
+    return SKYMARK_SIZES[scale];
+}
+
+QStringList IndexFileCache::selectIndexFiles(const QStringList &files, double fovArcmin)
+{
+    QStringList required, recommended;
+    if (fovArcmin <= 0)
+        return required;
+
+    for (const auto &file : files)
+    {
+        const double size = skymarkSize(file);
+        if (size >= 0.4 * fovArcmin && size <= 0.9 * fovArcmin)
+            required.append(file);
+        else if (size >= 0.1 * fovArcmin && size <= fovArcmin)
+            recommended.append(file);
+    }
+    return required + recommended;
+}
+
+void IndexFileCache::warmUp(const QStringList &folders, double fovArcmin)
+{
+    if (!Options::astrometryIndexCache())
+    {
+        clear();
+        return;
+    }
+    if (fovArcmin <= 0)
+        return;
+
+    QStringList files;
+    for (const auto &folder : folders)
+    {
+        QDir dir(folder);
+        for (const auto &name : dir.entryList(QStringList() << "*.fits", QDir::Files, QDir::Name))
+            files.append(dir.absoluteFilePath(name));
+    }
+    files = selectIndexFiles(files, fovArcmin);
+    const qint64 budget = static_cast<qint64>(Options::astrometryIndexCacheSize()) * 1024 * 1024;
+
+    QMutexLocker locker(&m_Mutex);
+    if (m_Running)
+    {
+        m_PendingFiles = files;
+        m_PendingBudget = budget;
+        m_Pending = true;
+        return;
+    }
+
+    m_Running = true;
+    m_Future = Executors::run(Executors::Background, [this, files, budget]()
+    {
+        QStringList nextFiles = files;
+        qint64 nextBudget = budget;
+        while (true)
+        {
+            load(nextFiles, nextBudget);
+
+            QMutexLocker locker(&m_Mutex);
+            if (!m_Pending)
+            {
+                m_Running = false;
+                return;
+            }
+            nextFiles = m_PendingFiles;
+            nextBudget = m_PendingBudget;
+            m_Pending = false;
+        }
+    });
+}
+
+void IndexFileCache::load(const QStringList &files, qint64 budget)
+{
+    QStringList wanted;
+    qint64 total = 0;
+    for (const auto &file : files)
+    {
+        const qint64 size = QFileInfo(file).size();
+        if (size <= 0 || total + size > budget)
+            continue;
+        wanted.append(file);
+        total += size;
+    }
+
+    {
+        QMutexLocker locker(&m_Mutex);
+        for (auto it = m_Files.begin(); it != m_Files.end();)
+        {
+            if (wanted.contains(it.key()))
+            {
+                ++it;
+                continue;
+            }
+            m_Bytes -= it.value()->size();
+            it = m_Files.erase(it);
+        }
+    }
+
+    for (const auto &fileName : wanted)
+    {
+        {
+            QMutexLocker locker(&m_Mutex);
+            if (m_Files.contains(fileName))
+                continue;
+        }
+
+        QSharedPointer<QFile> file(new QFile(fileName));
+        if (!file->open(QIODevice::ReadOnly))
+            continue;
+        const qint64 size = file->size();
+        const uchar *data = file->map(0, size);
+        if (data == nullptr)
+        {
+            qCDebug(KSTARS_EKOS_ALIGN) << "Failed to map index file" << fileName << file->errorString();
+            continue;
+        }
+
+        // Read a byte of each page so that the system reads them all now, rather than during a solve
+        uchar sum = 0;
+        for (qint64 offset = 0; offset < size; offset += READ_STRIDE)
+            sum ^= *static_cast<const volatile uchar *>(data + offset);
+        Q_UNUSED(sum);
+
+        QMutexLocker locker(&m_Mutex);
+        m_Files.insert(fileName, file);
+        m_Bytes += size;
+    }
+
+    QMutexLocker locker(&m_Mutex);
+    qCDebug(KSTARS_EKOS_ALIGN) << "Index file cache holds" << m_Files.size() << "files," << m_Bytes / (1024 * 1024) << "MB";
+}
+
+void IndexFileCache::clear()
+{
+    QMutexLocker locker(&m_Mutex);
+    m_Files.clear();
+    m_Bytes = 0;
+}
+
+qint64 IndexFileCache::cachedBytes() const
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_Bytes;
+}
+
+QStringList IndexFileCache::cachedFiles() const
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_Files.keys();
+}
+
+}
@@ -0,0 +1,82 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QFuture>
+#include <QMap>
+#include <QMutex>
+#include <QObject>
+#include <QSharedPointer>
+#include <QStringList>
+
+class QFile;
+
+namespace Ekos
+{
+
+/**
+ * @class IndexFileCache
+ * @short Keeps the astrometry.net index files an optical train solves with memory mapped, so solves don't read them.
+ *
+ * StellarSolver loads the index files it needs on each solve. The cache maps the files whose quads suit the field of
+ * view of the train, up to a memory budget, and reads them through once in the background. Their pages then stay in
+ * the page cache, shared with the mappings of the solvers, and the first solve after a slew has no disk I/O to wait for.
+ */
+class IndexFileCache : public QObject
+{
+        Q_OBJECT
+
+    public:
+        static IndexFileCache *Instance();
+        static void release();
+
+        /**
+         * @brief warmUp Maps, in the background, the index files of folders worth solving a field of view of
+         * fovArcmin with. Files beyond the AstrometryIndexCacheSize budget are left out, and the files of previous
+         * warm ups that are no longer worth it are unmapped.
+         */
+        void warmUp(const QStringList &folders, double fovArcmin);
+
+        // Unmaps all of the files.
+        void clear();
+
+        qint64 cachedBytes() const;
+        QStringList cachedFiles() const;
+
+        /**
+         * @brief skymarkSize Size of the quads of an index file, in arcminutes, from a name such as index-4107.fits or
+         * index-5203-05.fits.
+         * @return -1 if the name is not the one of an index file.
+         */
+        static double skymarkSize(const QString &fileName);
+
+        /**
+         * @brief selectIndexFiles The index files worth solving a field of view of fovArcmin with, the required ones,
+         * with quads of 40% to 90% of the field, first and then the recommended ones, with quads of 10% to 100%.
+         */
+        static QStringList selectIndexFiles(const QStringList &files, double fovArcmin);
+
+    private:
+        IndexFileCache() = default;
+        ~IndexFileCache() override;
+        static IndexFileCache *m_Instance;
+
+        // Maps the files, in order, up to budget bytes, and unmaps the others.
+        void load(const QStringList &files, qint64 budget);
+
+        mutable QMutex m_Mutex;
+        QMap<QString, QSharedPointer<QFile>> m_Files;
+        qint64 m_Bytes { 0 };
+        QFuture<void> m_Future;
+        bool m_Running { false };
+        // Warm up asked for while another was running
+        QStringList m_PendingFiles;
+        qint64 m_PendingBudget { 0 };
+        bool m_Pending { false };
+};
+
+}
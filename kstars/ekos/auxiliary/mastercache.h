@@ -0,0 +1,114 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QCache>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Ekos
+{
+
+/**
+ * @class MasterCache
+ * @short Least recently used cache of master dark frames or defect maps, keyed by file name, within a budget of bytes.
+ *
+ * Entries are evicted, least recently used first, once their bytes exceed the budget. An evicted entry stays valid
+ * for those still holding it. The cache may be used from the modules' processing threads.
+ */
+template <typename T>
+class MasterCache
+{
+    public:
+        explicit MasterCache(uint64_t budget) : m_Cache(toCost(budget)) {}
+
+        void setBudget(uint64_t budget)
+        {
+            QMutexLocker locker(&m_Mutex);
+            m_Cache.setMaxCost(toCost(budget));
+        }
+
+        /** @brief find Returns the entry of key, or null, and counts the hit or miss. */
+        QSharedPointer<T> find(const QString &key)
+        {
+            QMutexLocker locker(&m_Mutex);
+            QSharedPointer<T> *entry = m_Cache.object(key);
+            if (entry == nullptr)
+            {
+                m_Misses++;
+                return QSharedPointer<T>();
+            }
+            m_Hits++;
+            return *entry;
+        }
+
+        bool contains(const QString &key) const
+        {
+            QMutexLocker locker(&m_Mutex);
+            return m_Cache.contains(key);
+        }
+
+        /** @brief insert Adds the entry of key, which uses bytes of memory. Entries larger than the budget are not kept. */
+        bool insert(const QString &key, const QSharedPointer<T> &value, uint64_t bytes)
+        {
+            QMutexLocker locker(&m_Mutex);
+            return m_Cache.insert(key, new QSharedPointer<T>(value), toCost(bytes));
+        }
+
+        void remove(const QString &key)
+        {
+            QMutexLocker locker(&m_Mutex);
+            m_Cache.remove(key);
+        }
+
+        void clear()
+        {
+            QMutexLocker locker(&m_Mutex);
+            m_Cache.clear();
+        }
+
+        int count() const
+        {
+            QMutexLocker locker(&m_Mutex);
+            return m_Cache.count();
+        }
+        /** @brief bytes Memory used by the entries, rounded up to KiB per entry. */
+        uint64_t bytes() const
+        {
+            QMutexLocker locker(&m_Mutex);
+            return static_cast<uint64_t>(m_Cache.totalCost()) * 1024;
+        }
+        uint32_t hits() const
+        {
+            QMutexLocker locker(&m_Mutex);
+            return m_Hits;
+        }
+        uint32_t misses() const
+        {
+            QMutexLocker locker(&m_Mutex);
+            return m_Misses;
+        }
+
+    private:
+        // QCache costs are ints, so they are counted in KiB, at least one per entry
+        static int toCost(uint64_t bytes)
+        {
+            const uint64_t cost = (bytes + 1023) / 1024;
+            return static_cast<int>(std::min<uint64_t>(std::max<uint64_t>(cost, 1), INT32_MAX));
+        }
+
+        mutable QMutex m_Mutex;
+        QCache<QString, QSharedPointer<T>> m_Cache;
+        uint32_t m_Hits {0};
+        uint32_t m_Misses {0};
+};
+
+}
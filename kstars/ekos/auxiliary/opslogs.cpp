@@ -9,12 +9,16 @@
 #include "kstars.h"
 #include "Options.h"
 #include "auxiliary/kspaths.h"
+#include "auxiliary/tracer.h"
+#include "fitsviewer/imagememory.h"
 #include "indi/indilistener.h"
 
 #include <KConfigDialog>
 #include <KFormat>
 #include <KMessageBox>
 
+#include <QDateTime>
+#include <QFileDialog>
 #include <QFrame>
 #include <QUrl>
 #include <QDesktopServices>
@@ -39,6 +43,12 @@ OpsLogs::OpsLogs() : QFrame(KStars::Instance())
 
     connect(kcfg_LogToFile, SIGNAL(toggled(bool)), this, SLOT(slotToggleOutputOptions()));
 
+    connect(exportTraceB, &QPushButton::clicked, this, &OpsLogs::slotExportTrace);
+
+    // The memory of the images, while the page is shown
+    m_ImageMemoryTimer.setInterval(1000);
+    connect(&m_ImageMemoryTimer, &QTimer::timeout, this, &OpsLogs::slotUpdateImageMemory);
+
     connect(showLogsB, &QPushButton::clicked, []()
     {
         QDesktopServices::openUrl(QUrl::fromLocalFile(QDir(KSPaths::writableLocation(
@@ -119,6 +129,9 @@ void OpsLogs::refreshInterface()
 
     Options::setINDILogging((m_INDIDebugInterface > 0));
 
+    Tracer::setEnabled(Options::enableTracing());
+    ImageMemory::instance().setBudget(static_cast<uint64_t>(Options::imageMemoryBudget()) * 1024 * 1024);
+
     m_SettingsChanged = (previousInterface != m_INDIDebugInterface);
 }
 
@@ -145,6 +158,38 @@ qint64 OpsLogs::getDirSize(const QString &dirPath)
     return size;
 }
 
+void OpsLogs::slotExportTrace()
+{
+    const QString logsDirectory = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("logs");
+    const QString defaultName = QDir(logsDirectory).filePath(QString("trace_%1.json").arg(
+                                    QDateTime::currentDateTime().toString("yyyy-MM-ddThh-mm-ss")));
+    const QString filename = QFileDialog::getSaveFileName(this, i18nc("@title:window", "Export Trace"), defaultName,
+                             i18n("Chrome Trace (*.json)"));
+    if (filename.isEmpty())
+        return;
+
+    if (!Tracer::exportTrace(filename))
+        KMessageBox::error(nullptr, i18n("Failed to write trace to %1", filename));
+}
+
+void OpsLogs::slotUpdateImageMemory()
+{
+    imageMemoryLabel->setText(ImageMemory::instance().summary());
+}
+
+void OpsLogs::showEvent(QShowEvent *event)
+{
+    QFrame::showEvent(event);
+    slotUpdateImageMemory();
+    m_ImageMemoryTimer.start();
+}
+
+void OpsLogs::hideEvent(QHideEvent *event)
+{
+    QFrame::hideEvent(event);
+    m_ImageMemoryTimer.stop();
+}
+
 void OpsLogs::slotClearLogs()
 {
     if (KMessageBox::questionYesNo(nullptr, i18n("Are you sure you want to delete all logs?")) == KMessageBox::Yes)
@@ -8,6 +8,8 @@
 
 #include "ui_opslogs.h"
 
+#include <QTimer>
+
 class KConfigDialog;
 
 namespace Ekos
@@ -34,12 +36,19 @@ class OpsLogs : public QFrame, public Ui::OpsLogs
     void slotToggleVerbosityOptions();
     void slotToggleOutputOptions();
     void slotClearLogs();
+    void slotExportTrace();
+    void slotUpdateImageMemory();
+
+  protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
 
   private:
     qint64 getDirSize(const QString &dirPath);
 
     uint16_t m_INDIDebugInterface = { 0 };
     bool m_SettingsChanged = { false };
+    QTimer m_ImageMemoryTimer;
 };
 
 }
@@ -0,0 +1,60 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "replotscheduler.h"
+
+#include "qcustomplot.h"
+#include "Options.h"
+
+namespace Ekos
+{
+
+ReplotScheduler::ReplotScheduler(QCustomPlot *plot) : QObject(plot), m_Plot(plot)
+{
+    m_Timer.setSingleShot(true);
+    connect(&m_Timer, &QTimer::timeout, this, &ReplotScheduler::replot);
+    m_Plot->installEventFilter(this);
+
+#ifdef QCUSTOMPLOT_USE_OPENGL
+    if (Options::plotOpenGL())
+        m_Plot->setOpenGl(true);
+#endif
+}
+
+void ReplotScheduler::schedule()
+{
+    if (!m_Plot->isVisible())
+    {
+        m_Pending = true;
+        return;
+    }
+    if (m_Timer.isActive())
+        return;
+
+    const int interval = 1000 / std::max(1, static_cast<int>(Options::plotRefreshRate()));
+    const qint64 elapsed = m_LastReplot.isValid() ? m_LastReplot.elapsed() : interval;
+    if (elapsed >= interval)
+        replot();
+    else
+        m_Timer.start(interval - elapsed);
+}
+
+void ReplotScheduler::replot()
+{
+    m_Pending = false;
+    m_LastReplot.start();
+    // Merged with the other replots requested before the event loop runs again.
+    m_Plot->replot(QCustomPlot::rpQueuedReplot);
+}
+
+bool ReplotScheduler::eventFilter(QObject *object, QEvent *event)
+{
+    if (object == m_Plot && event->type() == QEvent::Show && m_Pending)
+        schedule();
+    return QObject::eventFilter(object, event);
+}
+
+}
@@ -0,0 +1,63 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+
+class QCustomPlot;
+
+namespace Ekos
+{
+
+/**
+ * @class ReplotScheduler
+ * @short Coalesces the replots of a QCustomPlot which is updated continuously.
+ *
+ * Replots are limited to Options::plotRefreshRate() per second, the requests in between are
+ * merged into a single queued replot. A plot which is hidden, e.g. in another tab, is only
+ * replotted once shown again. The plot is rendered with OpenGL when QCustomPlot was built with
+ * it and Options::plotOpenGL() is set.
+ */
+class ReplotScheduler : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** @short The scheduler is owned by @p plot */
+        explicit ReplotScheduler(QCustomPlot *plot);
+
+        /** @short Request a replot of the plot, which is done at the latest after one refresh interval */
+        void schedule();
+
+        /**
+         * @brief limitPoints Drop the oldest points of a QCP data container, keyed by time, beyond @p maxPoints.
+         * The container only moves its start on removals at the front, so it behaves as a ring buffer.
+         */
+        template <class DataContainer>
+        static void limitPoints(DataContainer &data, int maxPoints)
+        {
+            const int excess = data.size() - maxPoints;
+            if (maxPoints > 0 && excess > 0)
+                data.removeBefore((data.constBegin() + excess)->sortKey());
+        }
+
+    protected:
+        bool eventFilter(QObject *object, QEvent *event) override;
+
+    private:
+        void replot();
+
+        QCustomPlot *m_Plot { nullptr };
+        QTimer m_Timer;
+        QElapsedTimer m_LastReplot;
+        // A replot was requested while the plot was hidden
+        bool m_Pending { false };
+};
+
+}
@@ -0,0 +1,164 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "solverhintcache.h"
+
+#include "Options.h"
+#include <ekos_align_debug.h>
+
+#include <QUrl>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Ekos
+{
+
+namespace
+{
+// Number of fields of a hint after the train name
+constexpr int HINT_FIELDS = 8;
+
+double toRadians(double degrees)
+{
+    return degrees * M_PI / 180.0;
+}
+
+// Angle between two positions, in degrees
+double distance(double ra1, double dec1, double ra2, double dec2)
+{
+    const double sinDec = std::sin(toRadians(dec2 - dec1) / 2);
+    const double sinRA = std::sin(toRadians(ra2 - ra1) / 2);
+    const double a = sinDec * sinDec + std::cos(toRadians(dec1)) * std::cos(toRadians(dec2)) * sinRA * sinRA;
+    return 2 * std::asin(std::min(1.0, std::sqrt(a))) * 180.0 / M_PI;
+}
+}
+
+SolverHintCache::SolverHintCache() : m_Entries(Options::solverHintCache())
+{
+}
+
+SolverHintCache::SolverHintCache(const QStringList &entries) : m_Entries(entries)
+{
+}
+
+void SolverHintCache::save() const
+{
+    Options::setSolverHintCache(m_Entries);
+}
+
+int SolverHintCache::region(double ra, double dec)
+{
+    const int bands = static_cast<int>(std::ceil(180.0 / REGION_SIZE));
+    const int band = std::clamp(static_cast<int>(std::floor((dec + 90.0) / REGION_SIZE)), 0, bands - 1);
+    const double center = -90.0 + (band + 0.5) * REGION_SIZE;
+    const int cells = std::max(1, static_cast<int>(std::ceil(360.0 * std::cos(toRadians(center)) / REGION_SIZE)));
+
+    double normalized = std::fmod(ra, 360.0);
+    if (normalized < 0)
+        normalized += 360.0;
+    const int cell = static_cast<int>(std::floor(normalized / 360.0 * cells)) % cells;
+
+    return band * 1000 + cell;
+}
+
+QString SolverHintCache::encode(const Hint &hint)
+{
+    QStringList fields;
+    fields << QString::number(hint.ra, 'f', 6)
+           << QString::number(hint.dec, 'f', 6)
+           << QString::number(hint.index)
+           << QString::number(hint.healpix)
+           << QString::number(hint.scale, 'g', 10)
+           << QString::number(hint.parity)
+           << QString::number(hint.time)
+           // Reserved
+           << QString();
+
+    return QString::fromUtf8(QUrl::toPercentEncoding(hint.train)) + '|' + fields.join(';');
+}
+
+bool SolverHintCache::parse(const QString &entry, Hint *result)
+{
+    const QStringList parts = entry.split('|');
+    if (parts.size() != 2)
+        return false;
+    const QStringList fields = parts[1].split(';');
+    if (fields.size() != HINT_FIELDS)
+        return false;
+
+    bool ok[7];
+    Hint hint;
+    hint.train = QUrl::fromPercentEncoding(parts[0].toUtf8());
+    hint.ra = fields[0].toDouble(&ok[0]);
+    hint.dec = fields[1].toDouble(&ok[1]);
+    hint.index = fields[2].toInt(&ok[2]);
+    hint.healpix = fields[3].toInt(&ok[3]);
+    hint.scale = fields[4].toDouble(&ok[4]);
+    hint.parity = fields[5].toInt(&ok[5]);
+    hint.time = fields[6].toLongLong(&ok[6]);
+    if (std::find(std::begin(ok), std::end(ok), false) != std::end(ok) || hint.index < 0 || hint.scale <= 0 ||
+            std::fabs(hint.dec) > 90)
+        return false;
+
+    *result = hint;
+    return true;
+}
+
+void SolverHintCache::add(const Hint &hint)
+{
+    if (hint.train.isEmpty() || hint.index < 0 || hint.scale <= 0 || std::fabs(hint.dec) > 90)
+        return;
+
+    // Drop unreadable entries, and the previous hint of the train and region
+    const int hintRegion = region(hint.ra, hint.dec);
+    for (int i = m_Entries.size() - 1; i >= 0; --i)
+    {
+        Hint h;
+        if (!parse(m_Entries[i], &h) || (h.train == hint.train && region(h.ra, h.dec) == hintRegion))
+            m_Entries.removeAt(i);
+    }
+
+    m_Entries.append(encode(hint));
+    while (m_Entries.size() > MAX_ENTRIES)
+        m_Entries.removeFirst();
+
+    qCDebug(KSTARS_EKOS_ALIGN) << QString("Stored solver hint of train %1 at RA %2 DE %3: index %4 healpix %5, %6 hints stored")
+                               .arg(hint.train).arg(hint.ra, 0, 'f', 3).arg(hint.dec, 0, 'f', 3)
+                               .arg(hint.index).arg(hint.healpix).arg(m_Entries.size());
+}
+
+bool SolverHintCache::find(const QString &train, double ra, double dec, Hint *result) const
+{
+    double closest = REGION_SIZE;
+    bool found = false;
+    for (const auto &entry : m_Entries)
+    {
+        Hint hint;
+        if (!parse(entry, &hint) || hint.train != train)
+            continue;
+        const double d = distance(ra, dec, hint.ra, hint.dec);
+        if (d <= closest)
+        {
+            closest = d;
+            *result = hint;
+            found = true;
+        }
+    }
+    return found;
+}
+
+void SolverHintCache::remove(const QString &train, double ra, double dec)
+{
+    for (int i = m_Entries.size() - 1; i >= 0; --i)
+    {
+        Hint hint;
+        if (parse(m_Entries[i], &hint) && hint.train == train && distance(ra, dec, hint.ra, hint.dec) <= REGION_SIZE)
+            m_Entries.removeAt(i);
+    }
+}
+
+}
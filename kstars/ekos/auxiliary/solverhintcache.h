@@ -0,0 +1,86 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+namespace Ekos
+{
+
+// Keeps, for each optical train and region of the sky, the index file and healpix that solved an image there last,
+// along with the pixel scale and parity of the solution. Priming the StellarSolver with them lets it load a single
+// index file instead of searching all of them, so solves after slews to places solved before are much faster.
+//
+// The sky is split in regions of REGION_SIZE degrees in declination, and about as many degrees along the right
+// ascension circles, so regions are of similar size everywhere. A hint is only given for positions within
+// REGION_SIZE degrees of the solution that stored it, since an index healpix may not cover further.
+//
+// The hints are stored in the SolverHintCache option, one entry per region: the percent-encoded train name,
+// a '|', and the fields of the hint separated by ';'.
+class SolverHintCache
+{
+    public:
+        // Regions kept in all, the oldest are dropped beyond this.
+        static constexpr int MAX_ENTRIES = 500;
+        // Degrees of the regions.
+        static constexpr double REGION_SIZE = 2.0;
+
+        typedef struct
+        {
+            QString train;
+            // Center of the solution, in degrees
+            double ra;
+            double dec;
+            int index;
+            int healpix;
+            // Arcseconds per unbinned pixel
+            double scale;
+            // FITSImage::Parity of the solution
+            int parity;
+            // Seconds since the epoch
+            qint64 time;
+        } Hint;
+
+        // Reads the cache from the options.
+        SolverHintCache();
+        // Uses the given entries, for tests.
+        explicit SolverHintCache(const QStringList &entries);
+
+        // Writes the cache to the options.
+        void save() const;
+
+        // Adds the hint of a solve, replacing the one of the same train and region.
+        void add(const Hint &hint);
+
+        // Looks for the hint of train closest to ra and dec, in degrees. Returns false if none is close enough.
+        bool find(const QString &train, double ra, double dec, Hint *result) const;
+
+        // Removes the hints of train close to ra and dec, e.g. after they failed to solve.
+        void remove(const QString &train, double ra, double dec);
+
+        // Region of the sky of ra and dec, in degrees.
+        static int region(double ra, double dec);
+
+        bool isEmpty() const
+        {
+            return m_Entries.isEmpty();
+        }
+
+        const QStringList &entries() const
+        {
+            return m_Entries;
+        }
+
+    private:
+        static QString encode(const Hint &hint);
+        static bool parse(const QString &entry, Hint *result);
+
+        QStringList m_Entries;
+};
+
+}
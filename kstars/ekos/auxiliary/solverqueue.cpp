@@ -0,0 +1,76 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "solverqueue.h"
+
+#include "solverutils.h"
+#include "Options.h"
+#include <ekos_align_debug.h>
+
+#include <algorithm>
+
+SolverQueue *SolverQueue::m_Instance = nullptr;
+
+SolverQueue *SolverQueue::Instance()
+{
+    if (m_Instance == nullptr)
+        m_Instance = new SolverQueue();
+    return m_Instance;
+}
+
+void SolverQueue::submit(SolverUtils *solver)
+{
+    cancel(solver);
+    m_Waiting.append(solver);
+    startNext();
+
+    if (m_Waiting.contains(solver))
+        qCDebug(KSTARS_EKOS_ALIGN) << "Solve of priority" << solver->priority() << "waits for its turn," << m_Running.size()
+                                   << "solves running," << m_Waiting.size() << "waiting";
+}
+
+bool SolverQueue::cancel(SolverUtils *solver)
+{
+    const bool waiting = m_Waiting.removeAll(solver) > 0;
+    if (m_Running.removeAll(solver) > 0)
+        startNext();
+    return waiting;
+}
+
+void SolverQueue::finished(SolverUtils *solver)
+{
+    if (m_Running.removeAll(solver) > 0)
+        startNext();
+}
+
+void SolverQueue::startNext()
+{
+    while (!m_Waiting.isEmpty())
+    {
+        // The first of the highest priority
+        auto next = std::min_element(m_Waiting.begin(), m_Waiting.end(), [](const SolverUtils * a, const SolverUtils * b)
+        {
+            return a->priority() < b->priority();
+        });
+        SolverUtils *solver = *next;
+
+        if (solver->priority() != SolverUtils::ALIGN_PRIORITY)
+        {
+            if (m_Running.size() >= std::max(1, Options::solverQueueParallelism()))
+                return;
+            const bool aligning = std::any_of(m_Running.cbegin(), m_Running.cend(), [](const SolverUtils * s)
+            {
+                return s->priority() == SolverUtils::ALIGN_PRIORITY;
+            });
+            if (solver->priority() == SolverUtils::BATCH_PRIORITY && aligning)
+                return;
+        }
+
+        m_Waiting.erase(next);
+        m_Running.append(solver);
+        solver->start();
+    }
+}
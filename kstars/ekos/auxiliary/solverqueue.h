@@ -0,0 +1,62 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QList>
+#include <QObject>
+
+class SolverUtils;
+
+/**
+ * @class SolverQueue
+ * @short Shares the CPU among the SolverUtils solves of the modules, by their priority.
+ *
+ * Align solves start at once. The solves of the FITS viewer and of batches, such as those of the image overlays, wait
+ * until fewer than SolverQueueParallelism solves are running, the viewer's first, and batch solves also wait for the
+ * Align solves to be done. Solves of the same priority start in the order they were submitted.
+ */
+class SolverQueue : public QObject
+{
+        Q_OBJECT
+
+    public:
+        static SolverQueue *Instance();
+
+        // Starts the solver now or once its turn comes.
+        void submit(SolverUtils *solver);
+
+        /**
+         * @brief cancel Removes a solver from the queue, wherever it is, so that it no longer holds a turn.
+         * @return true if the solver was waiting for its turn.
+         */
+        bool cancel(SolverUtils *solver);
+
+        // Frees the turn of a solver that finished.
+        void finished(SolverUtils *solver);
+
+        bool isWaiting(const SolverUtils *solver) const
+        {
+            return m_Waiting.contains(const_cast<SolverUtils *>(solver));
+        }
+        int waitingCount() const
+        {
+            return m_Waiting.size();
+        }
+        int runningCount() const
+        {
+            return m_Running.size();
+        }
+
+    private:
+        SolverQueue() = default;
+        static SolverQueue *m_Instance;
+
+        void startNext();
+
+        QList<SolverUtils *> m_Waiting;
+        QList<SolverUtils *> m_Running;
+};
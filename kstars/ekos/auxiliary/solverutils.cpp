@@ -6,11 +6,23 @@
 
 #include "solverutils.h"
 
+#include "solverqueue.h"
+#include "auxiliary/tracer.h"
 #include "fitsviewer/fitsdata.h"
+#include "fitsviewer/imagememory.h"
 #include "Options.h"
 #include <QRegularExpression>
 #include <QUuid>
 
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Smallest binned width or height worth solving
+constexpr int MIN_PREPARED_SIZE = 64;
+}
+
 SolverUtils::SolverUtils(const SSolver::Parameters &parameters, double timeoutSeconds,
                          SSolver::ProcessType type) :
     m_Parameters(parameters), m_TimeoutMilliseconds(timeoutSeconds * 1000.0), m_Type(type)
@@ -24,6 +36,7 @@ SolverUtils::SolverUtils(const SSolver::Parameters &parameters, double timeoutSe
 
 SolverUtils::~SolverUtils()
 {
+    SolverQueue::Instance()->cancel(this);
     disconnect(&m_Watcher, &QFutureWatcher<bool>::finished, this, &SolverUtils::executeSolver);
     disconnect(&m_SolverTimer, &QTimer::timeout, this, &SolverUtils::solverTimeout);
     if (m_StellarSolver.get())
@@ -41,6 +54,7 @@ void SolverUtils::executeSolver()
 void SolverUtils::runSolver(const QString &filename)
 {
     m_ImageData.reset(new FITSData(), &QObject::deleteLater);
+    ImageMemory::instance().setOwner(m_ImageData.get(), ImageMemory::Align);
     QFuture<bool> response = m_ImageData->loadFromFile(filename);
     m_Watcher.setFuture(response);
 }
@@ -53,15 +67,32 @@ void SolverUtils::setHealpix(int indexToUse, int healpixToUse)
 
 void SolverUtils::abort()
 {
+    // A solve waiting for its turn ends as a running one would once aborted
+    if (SolverQueue::Instance()->cancel(this))
+    {
+        m_SolverBuffer.clear();
+        QTimer::singleShot(0, this, [this]()
+        {
+            emit done(false, false, FITSImage::Solution(), 0);
+        });
+        return;
+    }
     if (m_StellarSolver.get()) m_StellarSolver->abort();
 }
 
 bool SolverUtils::isRunning() const
 {
+    if (SolverQueue::Instance()->isWaiting(this)) return true;
     if (!m_StellarSolver.get()) return false;
     return m_StellarSolver->isRunning();
 }
 
+SolverUtils &SolverUtils::setPriority(Priority priority)
+{
+    m_Priority = priority;
+    return *this;
+}
+
 void SolverUtils::getSolutionHealpix(int *indexUsed, int *healpixUsed) const
 {
     *indexUsed = m_StellarSolver->getSolutionIndexNumber();
@@ -74,7 +105,29 @@ void SolverUtils::prepareSolver()
     if (m_StellarSolver->isRunning())
         m_StellarSolver->abort();
     m_StellarSolver->setProperty("ProcessType", m_Type);
-    m_StellarSolver->loadNewImageBuffer(m_ImageData->getStatistics(), m_ImageData->getImageBuffer());
+
+    // Bin and crop the image here, in one pass, rather than copying the full image into the solver to downsample it
+    auto params = m_Parameters;
+    m_SolverBuffer.clear();
+    m_Downsample = 1;
+    m_CropFraction = 1;
+    if (m_Type == SSolver::SOLVE && Options::solverType() == SSolver::SOLVER_STELLARSOLVER &&
+            Options::stellarSolverPreprocess())
+    {
+        const uint8_t downsample = solverDownsample(params, m_ImageData->width(), m_ImageData->height());
+        const double cropFraction = std::clamp(Options::stellarSolverCropFraction(), 0.25, 1.0);
+        if (prepareImage(m_ImageData, downsample, cropFraction, &m_SolverStatistics, &m_SolverBuffer))
+        {
+            m_Downsample = downsample;
+            m_CropFraction = cropFraction;
+            params.downsample = 1;
+            params.autoDownsample = false;
+        }
+    }
+    if (m_SolverBuffer)
+        m_StellarSolver->loadNewImageBuffer(m_SolverStatistics, reinterpret_cast<const uint8_t *>(m_SolverBuffer->constData()));
+    else
+        m_StellarSolver->loadNewImageBuffer(m_ImageData->getStatistics(), m_ImageData->getImageBuffer());
     m_StellarSolver->setProperty("ExtractorType", Options::solveSextractorType());
     m_StellarSolver->setProperty("SolverType", Options::solverType());
     connect(m_StellarSolver.get(), &StellarSolver::finished, this, &SolverUtils::solverDone, Qt::UniqueConnection);
@@ -101,7 +154,6 @@ void SolverUtils::prepareSolver()
     //No need for a conf file this way.
     m_StellarSolver->setProperty("AutoGenerateAstroConfig", true);
 
-    auto params = m_Parameters;
     params.partition = Options::stellarSolverPartition();
     m_StellarSolver->setParameters(params);
 
@@ -128,8 +180,8 @@ void SolverUtils::prepareSolver()
     if (m_UseScale)
     {
         // Extend search scale from 80% to 120%
-        m_StellarSolver->setSearchScale(m_ScaleLowArcsecPerPixel * 0.8,
-                                        m_ScaleHighArcsecPerPixel * 1.2,
+        m_StellarSolver->setSearchScale(m_ScaleLowArcsecPerPixel * m_Downsample * 0.8,
+                                        m_ScaleHighArcsecPerPixel * m_Downsample * 1.2,
                                         ARCSEC_PER_PIX);
     }
     else
@@ -149,15 +201,21 @@ void SolverUtils::prepareSolver()
 
 void SolverUtils::runSolver(const QSharedPointer<FITSData> &data)
 {
-    // Limit the time the solver can run.
+    m_ImageData = data;
+    SolverQueue::Instance()->submit(this);
+}
+
+void SolverUtils::start()
+{
+    // Limit the time the solver can run, from its turn on.
     m_SolverTimer.setSingleShot(true);
     m_SolverTimer.setInterval(m_TimeoutMilliseconds);
     m_SolverTimer.start();
     // Somehow m_SolverTimer's elapsed time can be greater than the interval,
     // so using this to get more exact times.
     m_StartTime = QDateTime::currentMSecsSinceEpoch();
+    m_TraceStart = Tracer::now();
 
-    m_ImageData = data;
     prepareSolver();
     m_StellarSolver->start();
 }
@@ -182,13 +240,19 @@ void SolverUtils::solverDone()
 {
     const double elapsed = (QDateTime::currentMSecsSinceEpoch() - m_StartTime) / 1000.0;
     m_SolverTimer.stop();
+    SolverQueue::Instance()->finished(this);
+    Tracer::record("solver", m_Type == SSolver::SOLVE ? "Solve" : "Extraction", m_TraceStart);
 
     if (m_Type == SSolver::SOLVE)
     {
         FITSImage::Solution solution;
         const bool success = m_StellarSolver->solvingDone() && !m_StellarSolver->failed();
         if (success)
+        {
             solution = m_StellarSolver->getSolution();
+            restoreSolution(solution, m_Downsample, m_CropFraction);
+        }
+        m_SolverBuffer.clear();
         emit done(false, success, solution, elapsed);
     }
     else
@@ -204,6 +268,7 @@ void SolverUtils::solverDone()
 void SolverUtils::solverTimeout()
 {
     m_SolverTimer.stop();
+    SolverQueue::Instance()->finished(this);
 
     disconnect(m_StellarSolver.get(), &StellarSolver::finished, this, &SolverUtils::solverDone);
     abort();
@@ -226,3 +291,51 @@ void SolverUtils::patchMultiAlgorithm(StellarSolver *solver)
         solver->setParameters(currentParameters);
     }
 }
+
+uint8_t SolverUtils::solverDownsample(const SSolver::Parameters &parameters, int width, int height)
+{
+    if (!parameters.autoDownsample)
+        return static_cast<uint8_t>(std::clamp(parameters.downsample, 1, 255));
+    // As StellarSolver does it
+    return static_cast<uint8_t>(std::clamp(static_cast<int>(std::ceil(std::max(width, height) / 2048.0)), 1, 255));
+}
+
+bool SolverUtils::prepareImage(const QSharedPointer<FITSData> &data, uint8_t downsample, double cropFraction,
+                               FITSImage::Statistic *statistics, QSharedPointer<const QVector<float>> *buffer)
+{
+    if (data.isNull() || downsample == 0 || (downsample == 1 && cropFraction >= 1))
+        return false;
+
+    const FITSImage::Statistic &stats = data->getStatistics();
+    // Keep whole blocks only, as many on each side of the center
+    const int width = static_cast<int>(stats.width * std::min(cropFraction, 1.0)) / (2 * downsample) * 2 * downsample;
+    const int height = static_cast<int>(stats.height * std::min(cropFraction, 1.0)) / (2 * downsample) * 2 * downsample;
+    if (width / downsample < MIN_PREPARED_SIZE || height / downsample < MIN_PREPARED_SIZE)
+        return false;
+
+    const QRect roi((stats.width - width) / 2, (stats.height - height) / 2, width, height);
+    QSharedPointer<const QVector<float>> samples = data->getBinnedFloatBuffer(downsample, roi);
+    if (samples.isNull())
+        return false;
+
+    *statistics = stats;
+    statistics->dataType = TFLOAT;
+    statistics->bytesPerPixel = sizeof(float);
+    statistics->channels = 1;
+    statistics->width = width / downsample;
+    statistics->height = height / downsample;
+    statistics->samples_per_channel = statistics->width * statistics->height;
+    statistics->size = statistics->samples_per_channel * sizeof(float);
+    *buffer = samples;
+    return true;
+}
+
+void SolverUtils::restoreSolution(FITSImage::Solution &solution, uint8_t downsample, double cropFraction)
+{
+    solution.pixscale /= std::max<uint8_t>(downsample, 1);
+    if (cropFraction > 0 && cropFraction < 1)
+    {
+        solution.fieldWidth /= cropFraction;
+        solution.fieldHeight /= cropFraction;
+    }
+}
@@ -15,6 +15,7 @@
 #include <mutex>
 #include <memory>
 #include <QSharedPointer>
+#include <QVector>
 
 #ifdef _WIN32
 #undef Unused
@@ -30,6 +31,14 @@ class SolverUtils : public QObject
         Q_OBJECT
 
     public:
+        // Order in which SolverQueue gives solves their turn, see SolverQueue
+        typedef enum
+        {
+            ALIGN_PRIORITY,
+            INTERACTIVE_PRIORITY,
+            BATCH_PRIORITY
+        } Priority;
+
         SolverUtils(const SSolver::Parameters &parameters, double timeoutSeconds = 15,
                     SSolver::ProcessType type = SSolver::SOLVE);
         ~SolverUtils();
@@ -38,6 +47,13 @@ class SolverUtils : public QObject
         void runSolver(const QString &filename);
         SolverUtils &useScale(bool useIt, double scaleLowArcsecPerPixel, double scaleHighArcsecPerPixel);
         SolverUtils &usePosition(bool useIt, double raDegrees, double decDegrees);
+        // Align solves, the default, start at once, others may wait in SolverQueue for their turn
+        SolverUtils &setPriority(Priority priority);
+        Priority priority() const
+        {
+            return m_Priority;
+        }
+        // Also true while waiting for its turn
         bool isRunning() const;
         void abort();
 
@@ -66,11 +82,26 @@ class SolverUtils : public QObject
         // with multiAlgorithm==MULTI_AUTO && use_scale && !use_position. This disables that.
         static void patchMultiAlgorithm(StellarSolver *solver);
 
+        // The downsample StellarSolver applies to a width x height image with parameters.
+        static uint8_t solverDownsample(const SSolver::Parameters &parameters, int width, int height);
+
+        // Bins the image by downsample, averaging its channels, and crops it to cropFraction of its width and height
+        // about its center, in one pass over the image. The center of the result is that of the image.
+        // Returns false if the image should be solved as it is.
+        static bool prepareImage(const QSharedPointer<FITSData> &data, uint8_t downsample, double cropFraction,
+                                 FITSImage::Statistic *statistics, QSharedPointer<const QVector<float>> *buffer);
+
+        // Scales the solution of an image prepared with downsample and cropFraction back to the whole image.
+        static void restoreSolution(FITSImage::Solution &solution, uint8_t downsample, double cropFraction);
+
     signals:
         void done(bool timedOut, bool success, const FITSImage::Solution &solution, double elapsedSeconds);
         void newLog(const QString &logText);
 
     private:
+        friend class SolverQueue;
+        // Solves m_ImageData, once its turn came
+        void start();
         void solverDone();
         void solverTimeout();
         void executeSolver();
@@ -79,6 +110,8 @@ class SolverUtils : public QObject
         std::unique_ptr<StellarSolver> m_StellarSolver;
 
         qint64 m_StartTime;
+        // Start of the solve on the clock of the Tracer
+        qint64 m_TraceStart { 0 };
         QTimer m_SolverTimer;
         // Copy of parameters
         SSolver::Parameters m_Parameters;
@@ -90,6 +123,11 @@ class SolverUtils : public QObject
         double m_ScaleLowArcsecPerPixel {0}, m_ScaleHighArcsecPerPixel {0};
 
         QSharedPointer<FITSData> m_ImageData;
+        // Binned and cropped image given to the solver instead of m_ImageData, see prepareImage()
+        QSharedPointer<const QVector<float>> m_SolverBuffer;
+        FITSImage::Statistic m_SolverStatistics;
+        uint8_t m_Downsample { 1 };
+        double m_CropFraction { 1 };
 
         int m_IndexToUse { -1 };
         int m_HealpixToUse { -1 };
@@ -100,6 +138,7 @@ class SolverUtils : public QObject
         double m_decDegrees { 0.0 };
 
         SSolver::ProcessType m_Type = SSolver::SOLVE;
+        Priority m_Priority { ALIGN_PRIORITY };
         std::mutex deleteSolverMutex;
 };
 
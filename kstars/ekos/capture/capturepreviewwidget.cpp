@@ -15,6 +15,7 @@
 #include "capture.h"
 #include "sequencejob.h"
 #include "fitsviewer/fitsdata.h"
+#include "fitsviewer/fitspreviewcache.h"
 #include "fitsviewer/summaryfitsview.h"
 #include "ekos/scheduler/schedulerjob.h"
 #include "ekos/scheduler/schedulermodulestate.h"
@@ -31,6 +32,14 @@ CapturePreviewWidget::CapturePreviewWidget(QWidget *parent) : QWidget(parent)
     connect(m_overlay->historyForwardButton, &QPushButton::clicked, this, &CapturePreviewWidget::showNextFrame);
     // deleting of captured frames
     connect(m_overlay->deleteCurrentFrameButton, &QPushButton::clicked, this, &CapturePreviewWidget::deleteCurrentFrame);
+
+    m_fullFrameTimer.setSingleShot(true);
+    m_fullFrameTimer.setInterval(1000);
+    connect(&m_fullFrameTimer, &QTimer::timeout, this, [this]()
+    {
+        if (m_overlay->hasFrames())
+            m_fitsPreview->loadFile(m_overlay->currentFrame().filename);
+    });
 }
 
 void CapturePreviewWidget::shareCaptureModule(Ekos::Capture *module)
@@ -102,15 +111,20 @@ void CapturePreviewWidget::updateJobProgress(Ekos::SequenceJob *job, const QShar
     m_overlay->setVisible(true);
 
     // load frame
+    m_fullFrameTimer.stop();
     if (m_fitsPreview != nullptr && Options::useSummaryPreview())
         m_fitsPreview->loadData(data);
+
+    // previews for browsing the history later on, generated while the frame is still in memory
+    if (!data->filename().isEmpty() && !FITSPreviewCache::contains(data->filename()))
+        FITSPreviewCache::generate(data);
 }
 
 void CapturePreviewWidget::showNextFrame()
 {
     m_overlay->setEnabled(false);
     if (m_overlay->showNextFrame())
-        m_fitsPreview->loadFile(m_overlay->currentFrame().filename);
+        showFrame(m_overlay->currentFrame().filename);
     // Hint: since the FITSView loads in the background, we have to wait for FITSView::load() to enable the layer
     else
         m_overlay->setEnabled(true);
@@ -120,7 +134,7 @@ void CapturePreviewWidget::showPreviousFrame()
 {
     m_overlay->setEnabled(false);
     if (m_overlay->showPreviousFrame())
-        m_fitsPreview->loadFile(m_overlay->currentFrame().filename);
+        showFrame(m_overlay->currentFrame().filename);
     // Hint: since the FITSView loads in the background, we have to wait for FITSView::load() to enable the layer
     else
         m_overlay->setEnabled(true);
@@ -166,11 +180,13 @@ void CapturePreviewWidget::deleteCurrentFrame()
             // delete it from the history and update the FITS view
             if (m_overlay->deleteFrame(pos) && m_overlay->hasFrames())
             {
-                m_fitsPreview->loadFile(m_overlay->currentFrame().filename);
+                showFrame(m_overlay->currentFrame().filename);
                 // Hint: since the FITSView loads in the background, we have to wait for FITSView::load() to enable the layer
             }
             else
             {
+                m_fullFrameTimer.stop();
+                m_fitsPreview->hidePreview();
                 m_fitsPreview->clearData();
                 m_overlay->setEnabled(true);
             }
@@ -203,6 +219,22 @@ void CapturePreviewWidget::deleteCurrentFrame()
 
 }
 
+void CapturePreviewWidget::showFrame(const QString &filename)
+{
+    const QImage preview = FITSPreviewCache::load(filename, FITSPreviewCache::PREVIEW);
+    if (preview.isNull())
+    {
+        m_fullFrameTimer.stop();
+        m_fitsPreview->loadFile(filename);
+        return;
+    }
+
+    // Browsing through the history only shows the previews, the frame itself is loaded once it stays displayed.
+    m_fitsPreview->showPreview(preview);
+    m_overlay->setEnabled(true);
+    m_fullFrameTimer.start();
+}
+
 void CapturePreviewWidget::setSummaryFITSView(SummaryFITSView *view)
 {
     m_fitsPreview = view;
@@ -221,6 +253,10 @@ void CapturePreviewWidget::setSummaryFITSView(SummaryFITSView *view)
     // react upon signals
     connect(view, &FITSView::loaded, [&]()
     {
+        // a frame loaded late must not replace the preview of the frame browsed to since
+        if (m_overlay->hasFrames() && m_fitsPreview->imageData() != nullptr
+                && m_fitsPreview->imageData()->filename() == m_overlay->currentFrame().filename)
+            m_fitsPreview->hidePreview();
         m_overlay->setEnabled(true);
     });
     connect(view, &FITSView::failed, [&]()
@@ -11,6 +11,7 @@
 #include "captureprocessoverlay.h"
 
 #include <QObject>
+#include <QTimer>
 #include <QWidget>
 
 class FITSData;
@@ -95,6 +96,11 @@ public slots:
     void updateCaptureCountDown(int delta);
 
 private:
+    /**
+     * @brief Show a frame of the capture history, from its cached preview if there is one
+     */
+    void showFrame(const QString &filename);
+
     QSharedPointer<Ekos::SchedulerModuleState> m_schedulerModuleState = nullptr;
     Ekos::Capture *m_captureModule = nullptr;
     Ekos::Mount *m_mountModule = nullptr;
@@ -113,4 +119,7 @@ private:
 
     // move to trash or delete finally
     bool m_permanentlyDelete {false};
+
+    // loads the history frame shown from its preview once it stays displayed
+    QTimer m_fullFrameTimer;
 };
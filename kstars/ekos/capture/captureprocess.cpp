@@ -5,6 +5,9 @@
 */
 #include "captureprocess.h"
 #include "capturedeviceadaptor.h"
+#include "flatexposurestore.h"
+#include "framequalityassessor.h"
+#include "placeholderpath.h"
 #include "refocusstate.h"
 #include "sequencejob.h"
 #include "sequencequeue.h"
@@ -23,6 +26,11 @@
 #include "ksnotification.h"
 #include <ekos_capture_debug.h>
 
+#include <QDateTime>
+#include <QFutureWatcher>
+
+#include <algorithm>
+
 #ifdef HAVE_STELLARSOLVER
 #include "ekos/auxiliary/stellarsolverprofileeditor.h"
 #endif
@@ -44,6 +52,10 @@ CaptureProcess::CaptureProcess(QSharedPointer<CaptureModuleState> newModuleState
     state()->downloadProgressTimer().setInterval(100);
     connect(&state()->downloadProgressTimer(), &QTimer::timeout, this, &CaptureProcess::setDownloadProgress);
 
+    // background measurement of the captured light frames
+    m_QualityAssessor = new FrameQualityAssessor(this);
+    connect(m_QualityAssessor, &FrameQualityAssessor::frameAssessed, this, &CaptureProcess::captureComplete);
+
     // configure dark processor
     m_DarkProcessor = new DarkProcessor(this);
     connect(m_DarkProcessor, &DarkProcessor::newLog, this, &CaptureProcess::newLog);
@@ -225,6 +237,8 @@ void CaptureProcess::toggleSequence()
     }
     else if (capturestate == CAPTURE_IDLE || capturestate == CAPTURE_ABORTED || capturestate == CAPTURE_COMPLETE)
     {
+        if (Options::darkLibraryPreload() && Options::autoDark())
+            preloadDarkFrames();
         startNextPendingJob();
     }
     else
@@ -233,6 +247,27 @@ void CaptureProcess::toggleSequence()
     }
 }
 
+void CaptureProcess::preloadDarkFrames()
+{
+    if (devices()->getActiveChip() == nullptr)
+        return;
+
+    // The exposures of the light frames still to be captured
+    QList<QPair<double, QPoint>> exposures;
+    for (const auto &job : state()->allJobs())
+    {
+        if ((job->getStatus() != JOB_IDLE && job->getStatus() != JOB_ABORTED) || job->getFrameType() != FRAME_LIGHT)
+            continue;
+        const QPair<double, QPoint> exposure(job->getCoreProperty(SequenceJob::SJ_Exposure).toDouble(),
+                                             job->getCoreProperty(SequenceJob::SJ_Binning).toPoint());
+        if (!exposures.contains(exposure))
+            exposures << exposure;
+    }
+
+    if (!exposures.isEmpty())
+        DarkLibrary::Instance()->preloadDarkFrames(devices()->getActiveChip(), exposures);
+}
+
 void CaptureProcess::startNextPendingJob()
 {
     if (state()->allJobs().count() > 0)
@@ -461,6 +496,9 @@ void CaptureProcess::prepareJob(SequenceJob * job)
         if (activeCamera()->getUploadMode() != ISD::Camera::UPLOAD_LOCAL)
             state()->setNextSequenceID(1);
 
+        // Scan the capture directories once for this job, the files written are added as they are captured
+        PlaceholderPath::resetDirectoryIndex();
+
         // We check if the job is already fully or partially complete by checking how many files of its type exist on the file system
         // The signature is the unique identification path in the system for a particular job. Format is "<storage path>/<target>/<frame type>/<filter name>".
         // If the Scheduler is requesting the Capture tab to process a sequence job, a target name will be inserted after the sequence file storage field (e.g. /path/to/storage/target/Light/...)
@@ -1370,6 +1408,11 @@ void CaptureProcess::captureImage()
             }
 
             activeJob()->setCalibrationStage(SequenceJobState::CAL_CALIBRATION);
+            // The first calibration exposure is a full frame, it tells the scale of the subframes
+            activeJob()->setCalibrationFrame(QRect());
+            m_FlatSubframeScale = 0;
+            if (Options::flatExposurePredict())
+                predictFlatExposure();
         }
     }
 
@@ -1646,14 +1689,23 @@ void CaptureProcess::updateCompletedCaptureCountersAction()
 
 IPState CaptureProcess::updateImageMetadataAction(QSharedPointer<FITSData> imageData)
 {
-    double hfr = -1, eccentricity = -1;
-    int numStars = -1, median = -1;
-    QString filename;
+    // The job may change before the stars are found, so its part of the metadata is taken now
+    QVariantMap metadata;
+    if (activeJob())
+    {
+        metadata["type"] = activeJob()->getFrameType();
+        metadata["exposure"] = activeJob()->getCoreProperty(SequenceJob::SJ_Exposure).toDouble();
+        metadata["filter"] = activeJob()->getCoreProperty(SequenceJob::SJ_Filter).toString();
+        metadata["width"] = activeJob()->getCoreProperty(SequenceJob::SJ_ROI).toRect().width();
+        metadata["height"] = activeJob()->getCoreProperty(SequenceJob::SJ_ROI).toRect().height();
+    }
+
+    QFuture<bool> starSearch;
     if (imageData)
     {
         QVariant frameType;
-        if (Options::autoHFR() && imageData && !imageData->areStarsSearched() && imageData->getRecordValue("FRAME", frameType)
-                && frameType.toString() == "Light")
+        const bool isLight = imageData->getRecordValue("FRAME", frameType) && frameType.toString() == "Light";
+        if (Options::autoHFR() && !imageData->areStarsSearched() && isLight)
         {
 #ifdef HAVE_STELLARSOLVER
             // Don't use the StellarSolver defaults (which allow very small stars).
@@ -1661,48 +1713,175 @@ IPState CaptureProcess::updateImageMetadataAction(QSharedPointer<FITSData> image
             QVariantMap extractionSettings;
             extractionSettings["optionsProfileIndex"] = Options::hFROptionsProfile();
             extractionSettings["optionsProfileGroup"] = static_cast<int>(Ekos::HFRProfiles);
+            // Only the aggregates are reported, so don't keep a list of the stars. The tiles are those of the tilt map.
+            extractionSettings["statisticsOnly"] = true;
+            extractionSettings["statisticsColumns"] = m_TileMap.columns();
+            extractionSettings["statisticsRows"] = m_TileMap.rows();
+            imageData->setSourceExtractorSettings(extractionSettings);
+#endif
+            starSearch = imageData->findStars(ALGORITHM_SEP);
+#ifdef HAVE_STELLARSOLVER
+            // The detector has taken its settings. Later searches of this image, e.g. to mark
+            // the stars in the viewer, need the star list
+            extractionSettings.remove("statisticsOnly");
             imageData->setSourceExtractorSettings(extractionSettings);
 #endif
-            QFuture<bool> result = imageData->findStars(ALGORITHM_SEP);
-            result.waitForFinished();
         }
-        hfr = imageData->getHFR(HFR_AVERAGE);
-        numStars = imageData->getSkyBackground().starsDetected;
-        median = imageData->getMedian();
-        eccentricity = imageData->getEccentricity();
-        filename = imageData->filename();
+        metadata["filename"] = imageData->filename();
 
         // avoid logging that we captured a temporary file
         if (state()->isLooping() == false && activeJob()->jobType() != SequenceJob::JOBTYPE_PREVIEW)
-            emit newLog(i18n("Captured %1", filename));
+            emit newLog(i18n("Captured %1", imageData->filename()));
 
-        auto remainingPlaceholders = PlaceholderPath::remainingPlaceholders(filename);
+        auto remainingPlaceholders = PlaceholderPath::remainingPlaceholders(imageData->filename());
         if (remainingPlaceholders.size() > 0)
         {
             emit newLog(
                 i18n("WARNING: remaining and potentially unknown placeholders %1 in %2",
-                     remainingPlaceholders.join(", "), filename));
+                     remainingPlaceholders.join(", "), imageData->filename()));
         }
     }
 
-    if (activeJob())
+    // In the pipelined mode the next exposure doesn't wait for the stars of batch frames,
+    // only for the oldest frame once too many are searched for
+    if (Options::captureAnalysisPipelined() && starSearch.isRunning() && activeJob()
+            && activeJob()->jobType() == SequenceJob::JOBTYPE_BATCH && state()->isLooping() == false)
     {
-        QVariantMap metadata;
-        metadata["filename"] = filename;
-        metadata["type"] = activeJob()->getFrameType();
-        metadata["exposure"] = activeJob()->getCoreProperty(SequenceJob::SJ_Exposure).toDouble();
-        metadata["filter"] = activeJob()->getCoreProperty(SequenceJob::SJ_Filter).toString();
-        metadata["width"] = activeJob()->getCoreProperty(SequenceJob::SJ_ROI).toRect().width();
-        metadata["height"] = activeJob()->getCoreProperty(SequenceJob::SJ_ROI).toRect().height();
-        metadata["hfr"] = hfr;
-        metadata["starCount"] = numStars;
-        metadata["median"] = median;
-        metadata["eccentricity"] = eccentricity;
-        emit captureComplete(metadata);
+        while (m_PendingAnalyses.size() >= static_cast<int>(std::max(1u, Options::captureAnalysisQueueSize())))
+        {
+            qCDebug(KSTARS_EKOS_CAPTURE) << "Waiting for the analysis of" << m_PendingAnalyses.head().imageData->filename();
+            processPendingAnalyses(true);
+        }
+
+        PendingAnalysis pending;
+        pending.imageData = imageData;
+        pending.metadata = metadata;
+        pending.starSearch = starSearch;
+        m_PendingAnalyses.enqueue(pending);
+
+        auto watcher = new QFutureWatcher<bool>(this);
+        connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher]()
+        {
+            watcher->deleteLater();
+            processPendingAnalyses(false);
+        });
+        watcher->setFuture(starSearch);
+        return IPS_BUSY;
     }
+
+    // Light frames that aren't measured here are measured in the background, binned. Headless
+    // captures have no image data, so the HFR is always measured from their files.
+    const bool measureFile = Options::captureHeadless() && Options::autoHFR() && imageData.isNull();
+    if ((Options::captureQualityAssessment() || measureFile) && activeJob()
+            && activeJob()->jobType() == SequenceJob::JOBTYPE_BATCH && activeJob()->getFrameType() == FRAME_LIGHT
+            && state()->isLooping() == false && (imageData.isNull() || !imageData->areStarsSearched()))
+    {
+        QString filename;
+        QFuture<void> fileWrite;
+        if (imageData.isNull() && activeCamera())
+        {
+            filename = activeCamera()->getFileWriteFilename();
+            fileWrite = activeCamera()->getFileWrite();
+            metadata["filename"] = filename;
+        }
+        if ((imageData || !filename.isEmpty()) && m_QualityAssessor->assess(metadata, imageData, filename, fileWrite))
+            return IPS_BUSY;
+    }
+
+    // Frames still analyzed are reported first
+    while (!m_PendingAnalyses.isEmpty())
+        processPendingAnalyses(true);
+
+    starSearch.waitForFinished();
+    completeImageMetadata(imageData, metadata);
     return IPS_OK;
 }
 
+void CaptureProcess::processPendingAnalyses(bool wait)
+{
+    // Frames are reported in the order they were captured
+    while (!m_PendingAnalyses.isEmpty())
+    {
+        PendingAnalysis &pending = m_PendingAnalyses.head();
+        if (!pending.starSearch.isFinished())
+        {
+            if (wait == false)
+                return;
+            pending.starSearch.waitForFinished();
+        }
+
+        const PendingAnalysis finished = m_PendingAnalyses.dequeue();
+        completeImageMetadata(finished.imageData, finished.metadata);
+        // When waiting, only the oldest frame is needed
+        if (wait)
+            return;
+    }
+}
+
+void CaptureProcess::completeImageMetadata(const QSharedPointer<FITSData> &imageData, QVariantMap metadata)
+{
+    double hfr = -1, eccentricity = -1;
+    double hfrTiltLR = 0, hfrTiltTB = 0;
+    bool hfrTiltOK = false;
+    int numStars = -1, median = -1;
+    if (imageData)
+    {
+        QVariant frameType;
+        const bool isLight = imageData->getRecordValue("FRAME", frameType) && frameType.toString() == "Light";
+        hfr = imageData->getHFR(HFR_AVERAGE);
+        numStars = imageData->getSkyBackground().starsDetected;
+
+        // The tilt is the difference of the HFRs of the right and left, bottom and top tiles, in pixels
+        if (isLight && imageData->areStarsSearched())
+        {
+            m_TileMap.setSensorSize(imageData->width(), imageData->height());
+            int minMeasures = 5;
+            const StarStatistics &statistics = imageData->getStarStatistics();
+            if (imageData->hasStarStatisticsOnly() && statistics.columns() == m_TileMap.columns()
+                    && statistics.rows() == m_TileMap.rows())
+            {
+                // One measure per frame, the median HFR of the tiles with enough stars
+                for (int tile = 0; tile < m_TileMap.tileCount(); tile++)
+                {
+                    if (statistics.tileCount(tile) >= 5)
+                        m_TileMap.addMeasure(tile, statistics.tileMedianHFR(tile));
+                }
+                minMeasures = 1;
+            }
+            else
+                m_TileMap.addStars(imageData->getStarCenters());
+            SensorTileMap::Tilt tilt;
+            hfrTiltOK = m_TileMap.calcTilt(1.0, 1.0, tilt, minMeasures);
+            if (hfrTiltOK)
+            {
+                hfrTiltLR = tilt.LR;
+                hfrTiltTB = tilt.TB;
+                qCDebug(KSTARS_EKOS_CAPTURE) << QString("HFR tilt left-right %1 top-bottom %2")
+                                             .arg(hfrTiltLR, 0, 'f', 3).arg(hfrTiltTB, 0, 'f', 3);
+            }
+        }
+        median = imageData->getMedian();
+        eccentricity = imageData->getEccentricity();
+    }
+
+    // Without a job there is nothing to report
+    if (!metadata.contains("type"))
+        return;
+
+    if (!metadata.contains("filename"))
+        metadata["filename"] = QString();
+    metadata["hfr"] = hfr;
+    metadata["starCount"] = numStars;
+    metadata["median"] = median;
+    metadata["eccentricity"] = eccentricity;
+    if (hfrTiltOK)
+    {
+        metadata["hfrTiltLR"] = hfrTiltLR;
+        metadata["hfrTiltTB"] = hfrTiltTB;
+    }
+    emit captureComplete(metadata);
+}
+
 IPState CaptureProcess::runCaptureScript(ScriptTypes scriptType, bool precond)
 {
     if (activeJob())
@@ -2031,6 +2210,9 @@ bool CaptureProcess::checkFlatCalibration(QSharedPointer<FITSData> imageData, do
         return true;
 
     double currentADU = imageData->getADU();
+    // Subframes are brighter than the full frame by the vignetting of the flat
+    if (activeJob()->isCalibrationSubframed() && m_FlatSubframeScale > 0)
+        currentADU *= m_FlatSubframeScale;
     bool outOfRange = false, saturated = false;
 
     switch (imageData->bpp())
@@ -2102,6 +2284,7 @@ bool CaptureProcess::checkFlatCalibration(QSharedPointer<FITSData> imageData, do
             placeholderPath.processJobInfo(activeJob());
             // Mark calibration as complete
             activeJob()->setCalibrationStage(SequenceJobState::CAL_CALIBRATION_COMPLETE);
+            storeFlatExposure(currentADU);
 
             // Must update sequence prefix as this step is only done in prepareJob
             // but since the duration has now been updated, we must take care to update signature
@@ -2136,6 +2319,9 @@ bool CaptureProcess::checkFlatCalibration(QSharedPointer<FITSData> imageData, do
     // Limit to minimum and maximum values
     nextExposure = qBound(exp_min, nextExposure, exp_max);
 
+    if (Options::flatCalibrationSubframe() && activeJob()->isCalibrationSubframed() == false)
+        updateFlatCalibrationFrame(imageData);
+
     emit newLog(i18n("Current ADU is %1 Next exposure is %2 seconds.", QString::number(currentADU, 'f', 0),
                      QString("%L1").arg(nextExposure, 0, 'f', 6)));
 
@@ -2269,6 +2455,67 @@ void CaptureProcess::clearFlatCache()
     ExpRaw.clear();
 }
 
+void CaptureProcess::updateFlatCalibrationFrame(const QSharedPointer<FITSData> &imageData)
+{
+    auto chip = devices()->getActiveChip();
+    int x = 0, y = 0, w = 0, h = 0, binX = 1, binY = 1;
+    if (chip == nullptr || chip->canSubframe() == false || chip->getFrame(&x, &y, &w, &h) == false)
+        return;
+    chip->getBinning(&binX, &binY);
+
+    // Central quarter of the image, and of the frame in unbinned pixels
+    const int width = imageData->width(), height = imageData->height();
+    const QRect center(width / 4, height / 4, width / 2, height / 2);
+    const double centerADU = imageData->getADU(center);
+    if (centerADU <= 0 || width < 64 || height < 64)
+        return;
+
+    m_FlatSubframeScale = imageData->getADU() / centerADU;
+    const QRect frame(x + center.x() * binX, y + center.y() * binY, center.width() * binX, center.height() * binY);
+    activeJob()->setCalibrationFrame(frame);
+    qCDebug(KSTARS_EKOS_CAPTURE) << "Flat calibration continues on frame" << frame << "with ADU scale" << m_FlatSubframeScale;
+}
+
+void CaptureProcess::predictFlatExposure()
+{
+    if (activeCamera() == nullptr)
+        return;
+
+    const FlatExposureStore store;
+    const double targetADU = activeJob()->getCoreProperty(SequenceJob::SJ_TargetADU).toDouble();
+    const bool skyFlat = activeJob()->getCoreProperty(SequenceJob::SJ_SkyFlat).toBool();
+    double exposure = store.predict(activeCamera()->getDeviceName(),
+                                    activeJob()->getCoreProperty(SequenceJob::SJ_Filter).toString(),
+                                    activeJob()->getCoreProperty(SequenceJob::SJ_Binning).toPoint(), skyFlat, targetADU,
+                                    QDateTime::currentSecsSinceEpoch());
+    if (exposure <= 0 || std::isnan(exposure))
+        return;
+
+    exposure = qBound(state()->exposureRange().min, exposure, state()->exposureRange().max);
+    emit newLog(i18n("Flat calibration starts at the predicted exposure of %1 seconds.",
+                     QString("%L1").arg(exposure, 0, 'f', 6)));
+    activeJob()->setCoreProperty(SequenceJob::SJ_Exposure, exposure);
+}
+
+void CaptureProcess::storeFlatExposure(double currentADU)
+{
+    if (activeCamera() == nullptr)
+        return;
+
+    FlatExposureStore::Flat flat;
+    flat.camera = activeCamera()->getDeviceName();
+    flat.filter = activeJob()->getCoreProperty(SequenceJob::SJ_Filter).toString();
+    flat.binning = activeJob()->getCoreProperty(SequenceJob::SJ_Binning).toPoint();
+    flat.skyFlat = activeJob()->getCoreProperty(SequenceJob::SJ_SkyFlat).toBool();
+    flat.exposure = activeJob()->getCoreProperty(SequenceJob::SJ_Exposure).toDouble();
+    flat.adu = currentADU;
+    flat.time = QDateTime::currentSecsSinceEpoch();
+
+    FlatExposureStore store;
+    store.add(flat);
+    store.save();
+}
+
 void CaptureProcess::updateTelescopeInfo()
 {
     if (devices()->mount() && activeCamera() && devices()->mount()->isConnected())
@@ -8,15 +8,19 @@
 
 #include "capturemodulestate.h"
 #include "sequencejob.h"
+#include "ekos/focus/sensortilemap.h"
 
 #include "indiapi.h"
 
+#include <QFuture>
 #include <QObject>
+#include <QQueue>
 
 namespace Ekos
 {
 
 class CaptureDeviceAdaptor;
+class FrameQualityAssessor;
 class DarkProcessor;
 
 /**
@@ -58,7 +62,8 @@ class DarkProcessor;
  *    - listen to the event {@see ISD::Camera::newImage} and start processing the FITS image
  *      as soon as it has been recieved
  * 6. Process received image
- *    - update the FITS image meta data {@see #updateImageMetadataAction()}
+ *    - update the FITS image meta data {@see #updateImageMetadataAction()}, in the background
+ *      for batch images with Options::captureAnalysisPipelined()
  *    - update time calculation and counters and execute post capture script ({@see imageCapturingCompleted()})
  * 7. Check how to continue the sequence execution ({@see resumeSequence()})
  *    - if the current sequence job isn't completed,
@@ -215,6 +220,11 @@ public:
      */
     void startNextPendingJob();
 
+    /**
+     * @brief preloadDarkFrames Load the master darks of the pending light frame jobs in the background
+     */
+    void preloadDarkFrames();
+
     /**
      * @brief Counterpart to the event {@see#createJob(SequenceJob::SequenceJobType)}
      * where the event receiver reports whether one has been added successfully
@@ -493,9 +503,22 @@ public:
 
     /**
      * @brief updateImageMetadataAction Update meta data of a captured image
+     * @return IPS_BUSY if the stars of the image are searched for in the background
+     * (see Options::captureAnalysisPipelined() and Options::captureQualityAssessment()), IPS_OK otherwise
      */
     IPState updateImageMetadataAction(QSharedPointer<FITSData> imageData);
 
+    /**
+     * @brief processPendingAnalyses Report the metadata of the images whose star search has finished
+     * @param wait wait for the oldest image and report it only
+     */
+    void processPendingAnalyses(bool wait);
+
+    /**
+     * @brief completeImageMetadata Add the star measures of the image to its metadata and report it
+     */
+    void completeImageMetadata(const QSharedPointer<FITSData> &imageData, QVariantMap metadata);
+
     /**
      * @brief runCaptureScript Run the pre-/post capture/job script
      * @param scriptType script type (pre-/post capture/job)
@@ -570,6 +593,22 @@ public:
      */
     void clearFlatCache();
 
+    /**
+     * @brief updateFlatCalibrationFrame Continue the flat calibration of the active job on the central quarter of its
+     * frame, with the ADU scaled by how much brighter the center is in the full frame imageData
+     */
+    void updateFlatCalibrationFrame(const QSharedPointer<FITSData> &imageData);
+
+    /**
+     * @brief predictFlatExposure Start the flat calibration of the active job at the exposure predicted from the stored flats
+     */
+    void predictFlatExposure();
+
+    /**
+     * @brief storeFlatExposure Store the calibrated exposure of the active job for the next calibrations
+     */
+    void storeFlatExposure(double currentADU);
+
     /**
      * @brief updateTelescopeInfo Update the scope information in the camera's
      * INDI driver.
@@ -726,13 +765,26 @@ private:
     QSharedPointer<CaptureModuleState> m_State;
     QSharedPointer<CaptureDeviceAdaptor> m_DeviceAdaptor;
     QPointer<DarkProcessor> m_DarkProcessor;
+    QPointer<FrameQualityAssessor> m_QualityAssessor;
 
     // Pre-/post capture script process
     QProcess m_CaptureScript;
     QString m_Scope;
     // Flat field automation
     QVector<double> ExpRaw, ADURaw;
+    // ADU of the full frame relative to the flat calibration subframe, 0 when not calibrating on subframes
+    double m_FlatSubframeScale { 0 };
     ADUAlgorithm targetADUAlgorithm { ADU_LEAST_SQUARES };
+    // HFRs of the stars of the light frames across the sensor, to monitor tilt
+    SensorTileMap m_TileMap;
+    // Images whose stars are searched for while the next exposures are taken, oldest first
+    typedef struct
+    {
+        QSharedPointer<FITSData> imageData;
+        QVariantMap metadata;
+        QFuture<bool> starSearch;
+    } PendingAnalysis;
+    QQueue<PendingAnalysis> m_PendingAnalyses;
 
 
     /**
@@ -33,7 +33,7 @@ class CameraGainReadMode
         void setCameraGainReadNoiseVector(const QVector<OptimalExposure::CameraGainReadNoise> &newCameraGainReadNoiseVector);
 
     private:
-        int CameraGainReadModeNumber;
+        int CameraGainReadModeNumber = 0;
         QString CameraGainReadModeName;
         QVector<OptimalExposure::CameraGainReadNoise> CameraGainReadNoiseVector;
 };
@@ -20,6 +20,11 @@
 #include <QDirIterator>
 #include <QXmlStreamWriter>
 #include <QXmlStreamReader>
+#include <QDataStream>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QSaveFile>
 #include "fileutilitycameradata.h"
 #include "imagingcameradata.h"
 #include "cameragainreadnoise.h"
@@ -302,14 +307,190 @@ void OptimalExposure::FileUtilityCameraData::downloadCameraDataFile(
 }
 
 
+namespace
+{
+// Identifies the binary cache of the parsed camera data files, the version changes with its layout
+constexpr quint32 CAMERA_DATA_CACHE_MAGIC = 0x4b534344;
+constexpr quint32 CAMERA_DATA_CACHE_VERSION = 1;
+
+struct CachedCameraData
+{
+    // Of the camera data file when it was parsed
+    qint64 modified { 0 };
+    qint64 size { 0 };
+    OptimalExposure::ImagingCameraData data;
+};
+
+QMutex cameraDataCacheMutex;
+QHash<QString, CachedCameraData> cameraDataCache;
+bool cameraDataCacheLoaded = false;
+
+QString cameraDataCacheFile()
+{
+    return QDir(KSPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("cameradata.cache");
+}
+
+void writeCameraData(QDataStream &out, OptimalExposure::ImagingCameraData &data)
+{
+    out << data.getCameraId() << qint32(data.getDataClassVersion()) << qint32(data.getSensorType())
+        << qint32(data.getGainSelectionType()) << data.getGainSelectionRange();
+
+    const QVector<OptimalExposure::CameraGainReadMode> readModes = data.getCameraGainReadModeVector();
+    out << qint32(readModes.size());
+    for (const auto &readMode : readModes)
+    {
+        out << qint32(readMode.getCameraGainReadModeNumber()) << readMode.getCameraGainReadModeName();
+        out << qint32(readMode.getCameraGainReadNoiseVector().size());
+        for (const auto &readNoise : readMode.getCameraGainReadNoiseVector())
+            out << qint32(readNoise.getGain()) << readNoise.getReadNoise();
+    }
+}
+
+bool readCameraData(QDataStream &in, OptimalExposure::ImagingCameraData &data)
+{
+    QString cameraId;
+    qint32 dataClassVersion = 0, sensorType = 0, gainSelectionType = 0, readModeCount = 0;
+    QVector<int> gainSelectionRange;
+    in >> cameraId >> dataClassVersion >> sensorType >> gainSelectionType >> gainSelectionRange >> readModeCount;
+    if (in.status() != QDataStream::Ok || readModeCount < 0)
+        return false;
+
+    QVector<OptimalExposure::CameraGainReadMode> readModes;
+    for (qint32 i = 0; i < readModeCount; i++)
+    {
+        qint32 number = 0, readNoiseCount = 0;
+        QString name;
+        in >> number >> name >> readNoiseCount;
+        if (in.status() != QDataStream::Ok || readNoiseCount < 0)
+            return false;
+
+        QVector<OptimalExposure::CameraGainReadNoise> readNoises;
+        readNoises.reserve(readNoiseCount);
+        for (qint32 j = 0; j < readNoiseCount; j++)
+        {
+            qint32 gain = 0;
+            double readNoise = 0;
+            in >> gain >> readNoise;
+            readNoises.append(OptimalExposure::CameraGainReadNoise(gain, readNoise));
+        }
+        readModes.append(OptimalExposure::CameraGainReadMode(number, name, readNoises));
+    }
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    data.setCameraId(cameraId);
+    data.setDataClassVersion(dataClassVersion);
+    data.setSensorType(static_cast<OptimalExposure::SensorType>(sensorType));
+    data.setGainSelectionType(static_cast<OptimalExposure::GainSelectionType>(gainSelectionType));
+    data.setGainSelectionRange(gainSelectionRange);
+    data.setCameraGainReadModeVector(readModes);
+    return true;
+}
+
+// Called with the cache mutex held
+void loadCameraDataCache()
+{
+    cameraDataCacheLoaded = true;
+    QFile file(cameraDataCacheFile());
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_12);
+    quint32 magic = 0, version = 0;
+    qint32 count = 0;
+    in >> magic >> version >> count;
+    if (magic != CAMERA_DATA_CACHE_MAGIC || version != CAMERA_DATA_CACHE_VERSION || count < 0)
+        return;
+
+    for (qint32 i = 0; i < count; i++)
+    {
+        QString fileName;
+        CachedCameraData entry;
+        in >> fileName >> entry.modified >> entry.size;
+        if (in.status() != QDataStream::Ok || !readCameraData(in, entry.data))
+        {
+            qCWarning(KSTARS_EKOS_CAPTURE) << "Discarding unreadable camera data cache" << file.fileName();
+            cameraDataCache.clear();
+            return;
+        }
+        cameraDataCache.insert(fileName, entry);
+    }
+}
+
+// Called with the cache mutex held
+void saveCameraDataCache()
+{
+    const QString fileName = cameraDataCacheFile();
+    QDir().mkpath(QFileInfo(fileName).absolutePath());
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_12);
+    out << CAMERA_DATA_CACHE_MAGIC << CAMERA_DATA_CACHE_VERSION << qint32(cameraDataCache.size());
+    for (auto entry = cameraDataCache.begin(); entry != cameraDataCache.end(); ++entry)
+    {
+        out << entry.key() << entry->modified << entry->size;
+        writeCameraData(out, entry->data);
+    }
+    if (!file.commit())
+        qCWarning(KSTARS_EKOS_CAPTURE) << "Cannot write camera data cache" << fileName;
+}
+}
+
 int OptimalExposure::FileUtilityCameraData::readCameraDataFile(QString aCameraDataFile,
         OptimalExposure::ImagingCameraData *anImagingCameraData)
+{
+    // The parsed files are kept in memory and in a binary cache, until the file changes
+    const QFileInfo info(aCameraDataFile);
+    const QString fileName = info.absoluteFilePath();
+    const qint64 modified = info.lastModified().toMSecsSinceEpoch();
+
+    QMutexLocker locker(&cameraDataCacheMutex);
+    if (!cameraDataCacheLoaded)
+        loadCameraDataCache();
+
+    auto cached = cameraDataCache.constFind(fileName);
+    if (cached != cameraDataCache.constEnd() && cached->modified == modified && cached->size == info.size())
+    {
+        *anImagingCameraData = cached->data;
+        return 0;
+    }
+
+    OptimalExposure::ImagingCameraData data;
+    if (parseCameraDataFile(aCameraDataFile, &data) != 0)
+    {
+        cameraDataCache.remove(fileName);
+        return -1;
+    }
+
+    cameraDataCache.insert(fileName, CachedCameraData { modified, info.size(), data });
+    saveCameraDataCache();
+    *anImagingCameraData = data;
+    return 0;
+}
+
+QString OptimalExposure::FileUtilityCameraData::findCameraDataFile(const QString &cameraId)
+{
+    for (const QString &cameraDataFile : getAvailableCameraFilesList())
+    {
+        if (cameraDataFileNameToCameraId(cameraDataFile).compare(cameraId, Qt::CaseInsensitive) == 0)
+            return cameraDataFile;
+    }
+    return QString();
+}
+
+int OptimalExposure::FileUtilityCameraData::parseCameraDataFile(const QString &aCameraDataFile,
+        OptimalExposure::ImagingCameraData *anImagingCameraData)
 {
     //    QString aCameraDataFile = OptimalExposure::FileUtilityCameraData::cameraApplicationDataRepository +
     //                              cameraIdToCameraDataFileName(cameraId);
 
     // qCInfo(KSTARS_EKOS_CAPTURE) << "Opening... " + aCameraDataFile;
 
+    int result = 0;
     QFile file(aCameraDataFile);
     if(file.open(QIODevice::ReadOnly | QIODevice::Text))
     {
@@ -477,21 +658,24 @@ int OptimalExposure::FileUtilityCameraData::readCameraDataFile(QString aCameraDa
             {
                 qCCritical(KSTARS_EKOS_CAPTURE) << "Read Failed";
                 xmlReader.raiseError(QObject::tr("Incorrect file"));
+                result = -1;
             }
         }
         else
         {
             qCCritical(KSTARS_EKOS_CAPTURE) << "Read Initial Element Failed,";
+            result = -1;
         }
     }
     else
     {
         qCCritical(KSTARS_EKOS_CAPTURE)
                 << "Cannot open file for reading " << file.errorString();
+        result = -1;
     }
 
     file.close();
-    return 0;
+    return result;
 }
 
 int OptimalExposure::FileUtilityCameraData::writeCameraDataFile(OptimalExposure::ImagingCameraData *anImagingCameraData)
@@ -34,7 +34,10 @@ class FileUtilityCameraData
 
         void static downloadRepositoryCameraDataFileList(QDialog *aDialog);
         void static downloadCameraDataFile(QString cameraId, QDialog *aDialog);
+        // Reads the camera data file, parsing it only if it changed since it was last read. Returns 0 on success.
         int static readCameraDataFile(QString cameraId, ImagingCameraData *anImagingCameraData);
+        // Returns the available camera data file of cameraId, or an empty string.
+        QString static findCameraDataFile(const QString &cameraId);
         int static writeCameraDataFile(ImagingCameraData *anImagingCameraData);
         void static buildCameraDataFile();
         void static initializeCameraDataPaths();
@@ -47,6 +50,9 @@ class FileUtilityCameraData
 
         QString static const cameraDataRemoteRepositoryList;
         QString static const cameraDataRemoteRepository;
+
+    private:
+        int static parseCameraDataFile(const QString &aCameraDataFile, ImagingCameraData *anImagingCameraData);
 };
 }
 
@@ -74,7 +74,7 @@ void ImagingCameraData::setGainSelectionRange(QVector<int> newGainSelectionRange
 
 
 
-QVector<int> ImagingCameraData::getGainSelectionRange()
+const QVector<int> &ImagingCameraData::getGainSelectionRange() const
 {
     return gainSelectionRange;
 }
@@ -85,7 +85,7 @@ void OptimalExposure::ImagingCameraData::setCameraGainReadModeVector(QVector<Cam
     CameraGainReadModeVector = newCameraGainReadModeVector;
 }
 
-QVector<OptimalExposure::CameraGainReadMode> OptimalExposure::ImagingCameraData::getCameraGainReadModeVector()
+const QVector<OptimalExposure::CameraGainReadMode> &OptimalExposure::ImagingCameraData::getCameraGainReadModeVector() const
 {
     return CameraGainReadModeVector;
 }
@@ -47,20 +47,20 @@ class ImagingCameraData
         int getGainMin();
         int getGainMax();
 
-        QVector<CameraGainReadMode> getCameraGainReadModeVector();
+        const QVector<CameraGainReadMode> &getCameraGainReadModeVector() const;
         void setCameraGainReadModeVector(QVector<CameraGainReadMode> newCameraGainReadModeVector);
 
-        QVector<int> getGainSelectionRange();
+        const QVector<int> &getGainSelectionRange() const;
         void setGainSelectionRange(QVector<int> newGainSelectionRange);
 
 
 
     private:
         QString cameraId;
-        int dataClassVersion;
+        int dataClassVersion = 0;
 
-        OptimalExposure::SensorType sensorType;
-        OptimalExposure::GainSelectionType gainSelectionType;
+        OptimalExposure::SensorType sensorType = SENSORTYPE_MONOCHROME;
+        OptimalExposure::GainSelectionType gainSelectionType = GAIN_SELECTION_TYPE_NORMAL;
 
         // For GAIN_SELECTION_TYPE_NORMAL gainSelection holds only the min and max gains.
         // For GAIN_SELECTION_TYPE_ISO_DISCRETE, gainSelection hold the discrete values.
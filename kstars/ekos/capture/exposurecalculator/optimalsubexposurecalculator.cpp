@@ -11,6 +11,7 @@
 #include "calculatedgainsubexposuretime.h"
 #include "cameraexposureenvelope.h"
 #include "optimalexposuredetail.h"
+#include "fileutilitycameradata.h"
 #include <ekos_capture_debug.h>
 
 namespace OptimalExposure
@@ -125,6 +126,7 @@ ImagingCameraData &OptimalSubExposureCalculator::getImagingCameraData()
 void OptimalSubExposureCalculator::setImagingCameraData(ImagingCameraData &newanImagingCameraData)
 {
     anImagingCameraData = newanImagingCameraData;
+    envelopeValid = false;
 }
 
 int OptimalSubExposureCalculator::getASelectedGain()
@@ -155,15 +157,16 @@ QVector<CalculatedGainSubExposureTime> OptimalSubExposureCalculator::calculateGa
     // qCInfo(KSTARS_EKOS_CAPTURE) << "Calculating gain sub-exposure vector: ";
     QVector<CalculatedGainSubExposureTime> aCalculatedGainSubExposureTimeVector;
 
-    OptimalExposure::CameraGainReadMode aSelectedReadMode =
+    const OptimalExposure::CameraGainReadMode &aSelectedReadMode =
         anImagingCameraData.getCameraGainReadModeVector()[aSelectedCameraReadMode];
     // qCInfo(KSTARS_EKOS_CAPTURE) << "\t with camera read mode: "
     //  << aSelectedReadMode.getCameraGainReadModeName();
 
-    QVector<OptimalExposure::CameraGainReadNoise> aCameraGainReadNoiseVector
+    const QVector<OptimalExposure::CameraGainReadNoise> &aCameraGainReadNoiseVector
         = aSelectedReadMode.getCameraGainReadNoiseVector();
+    aCalculatedGainSubExposureTimeVector.reserve(aCameraGainReadNoiseVector.size());
 
-    for(QVector<OptimalExposure::CameraGainReadNoise>::iterator rn = aCameraGainReadNoiseVector.begin();
+    for(QVector<OptimalExposure::CameraGainReadNoise>::const_iterator rn = aCameraGainReadNoiseVector.begin();
             rn != aCameraGainReadNoiseVector.end(); ++rn)
     {
         int aGain = rn->getGain();
@@ -188,9 +191,7 @@ QVector<CalculatedGainSubExposureTime> OptimalSubExposureCalculator::calculateGa
 
         // qCInfo(KSTARS_EKOS_CAPTURE) << "anOptimalSubExposure is: " << anOptimalSubExposure;
 
-        CalculatedGainSubExposureTime *aSubExposureTime = new CalculatedGainSubExposureTime(aGain, anOptimalSubExposure);
-
-        aCalculatedGainSubExposureTimeVector.append(*aSubExposureTime);
+        aCalculatedGainSubExposureTimeVector.append(CalculatedGainSubExposureTime(aGain, anOptimalSubExposure));
 
     }
 
@@ -223,7 +224,7 @@ double OptimalSubExposureCalculator::calculateCFactor(double aNoiseTolerance)
 double OptimalSubExposureCalculator::calculateLightPollutionElectronBaseRate(double skyQuality)
 {
     // Conversion curve fitted from Dr Glover data
-    double base = std::stod("1.25286030612621E+27");
+    double base = 1.25286030612621E+27;
     double power = (double) -19.3234809465887;
 
     // New version of Dr Glover's function calculates the Electron rate at thet pixel level
@@ -244,8 +245,15 @@ OptimalExposure::CameraExposureEnvelope OptimalSubExposureCalculator::calculateC
         This method calculates the exposures for each gain setting found in the camera gain readnoise table.
         It is used to refresh the ui presentation, in prparation for a calculation of sub-exposure data with a
         specific (probably interpolated) read-noise value.
+        The envelope does not depend on the selected gain, so it is recalculated only when its inputs change.
     */
 
+    const EnvelopeInputs inputs { aNoiseTolerance, aSkyQuality, aFocalRatio, aFilterCompensation, aSelectedCameraReadMode };
+    if (envelopeValid && inputs.noiseTolerance == envelopeInputs.noiseTolerance
+            && inputs.skyQuality == envelopeInputs.skyQuality && inputs.focalRatio == envelopeInputs.focalRatio
+            && inputs.filterCompensation == envelopeInputs.filterCompensation && inputs.readMode == envelopeInputs.readMode)
+        return envelope;
+
     double lightPollutionElectronBaseRate = OptimalSubExposureCalculator::calculateLightPollutionElectronBaseRate(aSkyQuality);
     /*
     qCInfo(KSTARS_EKOS_CAPTURE) << "Calculating CameraExposureEnvelope..."
@@ -261,7 +269,7 @@ OptimalExposure::CameraExposureEnvelope OptimalSubExposureCalculator::calculateC
             << lightPollutionForOpticFocalRatio;
     */
     // qCDebug(KSTARS_EKOS_CAPTURE) << "Using a camera Id: " << anImagingCameraData.getCameraId();
-    OptimalExposure::CameraGainReadMode aSelectedReadMode =
+    const OptimalExposure::CameraGainReadMode &aSelectedReadMode =
         anImagingCameraData.getCameraGainReadModeVector()[aSelectedCameraReadMode];
     /*
     qCInfo(KSTARS_EKOS_CAPTURE) << "\t with camera read mode: "
@@ -295,9 +303,56 @@ OptimalExposure::CameraExposureEnvelope OptimalSubExposureCalculator::calculateC
                 exposureTimeMin,
                 exposureTimeMax);
 
+    envelope = aCameraExposureEnvelope;
+    envelopeInputs = inputs;
+    envelopeValid = true;
     return(aCameraExposureEnvelope);
 }
 
+double OptimalSubExposureCalculator::interpolateReadNoise(const QVector<CameraGainReadNoise> &aCameraGainReadNoiseVector,
+        int aGain)
+{
+    // Look for a matching gain from the camera gain read-noise table, or identify a bracket for interpolation.
+    // Interpolation may result in slight errors when the read-noise data is curve. (there's probably a better way to code this)
+    int lowerReadNoiseIndex = 0;
+    for(int readNoiseIndex = 0; readNoiseIndex < aCameraGainReadNoiseVector.size(); readNoiseIndex++)
+    {
+        const CameraGainReadNoise &aCameraGainReadNoise = aCameraGainReadNoiseVector[readNoiseIndex];
+        if(aCameraGainReadNoise.getGain() == aGain)
+            return aCameraGainReadNoise.getReadNoise();
+        if(aCameraGainReadNoise.getGain() < aGain)
+            lowerReadNoiseIndex = readNoiseIndex;
+    }
+
+    if (lowerReadNoiseIndex < aCameraGainReadNoiseVector.size() - 1)
+    {
+        // interpolate a read-noise value
+        const CameraGainReadNoise &aLowerIndexCameraReadNoise = aCameraGainReadNoiseVector[lowerReadNoiseIndex];
+        const CameraGainReadNoise &anUpperIndexCameraReadNoise = aCameraGainReadNoiseVector[lowerReadNoiseIndex + 1];
+        double m = (anUpperIndexCameraReadNoise.getReadNoise() - aLowerIndexCameraReadNoise.getReadNoise()) /
+                   (anUpperIndexCameraReadNoise.getGain() - aLowerIndexCameraReadNoise.getGain());
+        return aLowerIndexCameraReadNoise.getReadNoise() + (m * (aGain - aLowerIndexCameraReadNoise.getGain()));
+    }
+
+    // using max camera gain, defaulted high just to make an error obvious without data
+    return aCameraGainReadNoiseVector.isEmpty() ? 100.0 : aCameraGainReadNoiseVector.last().getReadNoise();
+}
+
+double OptimalSubExposureCalculator::optimalSubExposure(const QString &cameraDataFile, int gain, int readMode,
+        double skyQuality, double focalRatio, double filterCompensation, double noiseTolerance)
+{
+    ImagingCameraData aCameraData;
+    if (FileUtilityCameraData::readCameraDataFile(cameraDataFile, &aCameraData) != 0 || readMode < 0
+            || readMode >= aCameraData.getCameraGainReadModeVector().size()
+            || aCameraData.getCameraGainReadModeVector()[readMode].getCameraGainReadNoiseVector().isEmpty())
+        return -1;
+
+    OptimalSubExposureCalculator aCalculator(noiseTolerance, skyQuality, focalRatio, filterCompensation, aCameraData);
+    aCalculator.setASelectedCameraReadMode(readMode);
+    aCalculator.setASelectedGain(gain);
+    return aCalculator.calculateSubExposureDetail().getSubExposureTime();
+}
+
 // OptimalExposure::OptimalExposureDetail OptimalSubExposureCalculator::calculateSubExposureDetail(int aSelectedGainValue)
 OptimalExposure::OptimalExposureDetail OptimalSubExposureCalculator::calculateSubExposureDetail()
 {
@@ -311,72 +366,9 @@ OptimalExposure::OptimalExposureDetail OptimalSubExposureCalculator::calculateSu
 
     int aSelectedGain = getASelectedGain();
 
-    // Look for a matching gain from the camera gain read-noise table, or identify a bracket for interpolation.
-    // Interpolation may result in slight errors when the read-noise data is curve. (there's probably a better way to code this)
-    double aReadNoise = 100.0;  // defaulted high just to make an error in the interpolation obvious
-    bool matched = false;
-    int lowerReadNoiseIndex = 0;
-
-    OptimalExposure::CameraGainReadMode aSelectedReadMode =
+    const OptimalExposure::CameraGainReadMode &aSelectedReadMode =
         anImagingCameraData.getCameraGainReadModeVector()[aSelectedCameraReadMode];
-
-    QVector<OptimalExposure::CameraGainReadNoise> aCameraGainReadNoiseVector =
-        aSelectedReadMode.getCameraGainReadNoiseVector();
-
-
-
-    for(int readNoiseIndex = 0; readNoiseIndex < aSelectedReadMode.getCameraGainReadNoiseVector().size(); readNoiseIndex++)
-    {
-        if(!matched)
-        {
-            CameraGainReadNoise aCameraGainReadNoise = aSelectedReadMode.getCameraGainReadNoiseVector()[readNoiseIndex];
-            if(aCameraGainReadNoise.getGain() == aSelectedGain)
-            {
-                matched = true;
-                // qCInfo(KSTARS_EKOS_CAPTURE) << " matched a camera gain ";
-                aReadNoise = aCameraGainReadNoise.getReadNoise();
-                break;
-            }
-            if(aCameraGainReadNoise.getGain() < aSelectedGain)
-            {
-                lowerReadNoiseIndex = readNoiseIndex;
-            }
-        }
-    }
-
-    if(!matched)
-    {
-        int upperReadNoiseIndex = lowerReadNoiseIndex + 1;
-        // qCInfo(KSTARS_EKOS_CAPTURE)
-        //  << "Interpolating read noise gain bracket: " << lowerReadNoiseIndex
-        //  << " and " << upperReadNoiseIndex;
-
-        if (lowerReadNoiseIndex < aSelectedReadMode.getCameraGainReadNoiseVector().size() - 1)
-        {
-
-            CameraGainReadNoise aLowerIndexCameraReadNoise = aSelectedReadMode.getCameraGainReadNoiseVector()[lowerReadNoiseIndex];
-            CameraGainReadNoise anUpperIndexCameraReadNoise = aSelectedReadMode.getCameraGainReadNoiseVector()[upperReadNoiseIndex];
-
-            // interpolate a read-noise value
-            double m = (anUpperIndexCameraReadNoise.getReadNoise() - aLowerIndexCameraReadNoise.getReadNoise()) /
-                       (anUpperIndexCameraReadNoise.getGain() - aLowerIndexCameraReadNoise.getGain());
-            aReadNoise = aLowerIndexCameraReadNoise.getReadNoise() + (m * (aSelectedGain - aLowerIndexCameraReadNoise.getGain()));
-            // qCInfo(KSTARS_EKOS_CAPTURE)
-            //        << "The camera read-noise for the selected gain value is interpolated to: " << aReadNoise;
-        }
-        else
-        {
-            // qCInfo(KSTARS_EKOS_CAPTURE) << " using max camera gain ";
-            int maxIndex = aSelectedReadMode.getCameraGainReadNoiseVector().size() - 1;
-            CameraGainReadNoise aMaxIndexCameraReadNoise = aSelectedReadMode.getCameraGainReadNoiseVector()[maxIndex];
-            aReadNoise = aMaxIndexCameraReadNoise.getReadNoise();
-        }
-    }
-    else
-    {
-        // qCInfo(KSTARS_EKOS_CAPTURE)
-        // << "The camera read-noise for the selected gain value was matched: " << aReadNoise;
-    }
+    double aReadNoise = interpolateReadNoise(aSelectedReadMode.getCameraGainReadNoiseVector(), aSelectedGain);
 
     double anOptimalSubExposure = 0.0;
 
@@ -424,8 +416,7 @@ OptimalExposure::OptimalExposureDetail OptimalSubExposureCalculator::calculateSu
         double aStackTotalNoise = sqrt( (double)anExposureCount * pow(aReadNoise, 2)
                                         + lightPollutionForOpticFocalRatio * (anExposureCount * anOptimalSubExposure));
 
-        OptimalExposureStack *anOptimalExposureStack
-            = new OptimalExposureStack(sessionHours, anExposureCount, aStackTime, aStackTotalNoise);
+        OptimalExposureStack anOptimalExposureStack(sessionHours, anExposureCount, aStackTime, aStackTotalNoise);
 
         /*
                 qCInfo(KSTARS_EKOS_CAPTURE) << sessionHours << "\t" << anExposureCount
@@ -434,7 +425,7 @@ OptimalExposure::OptimalExposureDetail OptimalSubExposureCalculator::calculateSu
 
                 //  << aSelectedGainValue << " is " << anOptimalSubExposure << " seconds";
         */
-        aStackSummary.push_back(*anOptimalExposureStack);
+        aStackSummary.push_back(anOptimalExposureStack);
 
 
     }
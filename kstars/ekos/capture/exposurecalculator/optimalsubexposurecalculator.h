@@ -53,6 +53,13 @@ class OptimalSubExposureCalculator
         int getASelectedCameraReadMode() const;
         void setASelectedCameraReadMode(int aNewSelectedCameraReadMode);
 
+        /*
+         *  Optimal sub-exposure in seconds of the camera of a camera data file at a gain and read mode, for callers
+         *  without the dialog such as the scheduler or the sequence editor. Returns -1 without data for the read mode.
+         */
+        static double optimalSubExposure(const QString &cameraDataFile, int gain, int readMode, double skyQuality,
+                                         double focalRatio, double filterCompensation, double noiseTolerance);
+
     protected:
         double aNoiseTolerance;
         double aSkyQuality;
@@ -70,6 +77,20 @@ class OptimalSubExposureCalculator
                 double AFilterCompensation);
         QVector<CalculatedGainSubExposureTime> calculateGainSubExposureVector(double cFactor,
                 double lightPollutionForOpticFocalRatio);
+        static double interpolateReadNoise(const QVector<CameraGainReadNoise> &aCameraGainReadNoiseVector, int aGain);
+
+        // The envelope only changes with these inputs, so it is kept until one of them changes
+        typedef struct
+        {
+            double noiseTolerance;
+            double skyQuality;
+            double focalRatio;
+            double filterCompensation;
+            int readMode;
+        } EnvelopeInputs;
+        bool envelopeValid = false;
+        EnvelopeInputs envelopeInputs {};
+        CameraExposureEnvelope envelope;
 
 
 };
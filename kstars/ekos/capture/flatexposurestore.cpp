@@ -0,0 +1,176 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "flatexposurestore.h"
+
+#include "Options.h"
+#include <ekos_capture_debug.h>
+
+#include <QUrl>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Ekos
+{
+
+namespace
+{
+// Number of fields of a flat after the names
+constexpr int FLAT_FIELDS = 7;
+
+// ADU per second of exposure
+double rate(const FlatExposureStore::Flat &flat)
+{
+    return flat.adu / flat.exposure;
+}
+
+// Returns the newest flat of filter and source in flats, or nullptr
+const FlatExposureStore::Flat *newest(const QVector<FlatExposureStore::Flat> &flats, const QString &filter,
+                                      bool skyFlat)
+{
+    const FlatExposureStore::Flat *result = nullptr;
+    for (const auto &flat : flats)
+    {
+        if (flat.filter == filter && flat.skyFlat == skyFlat && (result == nullptr || flat.time >= result->time))
+            result = &flat;
+    }
+    return result;
+}
+}
+
+FlatExposureStore::FlatExposureStore() : m_Entries(Options::flatExposureStore())
+{
+}
+
+FlatExposureStore::FlatExposureStore(const QStringList &entries) : m_Entries(entries)
+{
+}
+
+void FlatExposureStore::save() const
+{
+    Options::setFlatExposureStore(m_Entries);
+}
+
+QString FlatExposureStore::encode(const Flat &flat)
+{
+    QStringList fields;
+    fields << QString::number(flat.binning.x())
+           << QString::number(flat.binning.y())
+           << QString::number(flat.skyFlat ? 1 : 0)
+           << QString::number(flat.exposure, 'g', 10)
+           << QString::number(flat.adu, 'g', 10)
+           << QString::number(flat.time)
+           // Reserved
+           << QString();
+
+    return QString::fromUtf8(QUrl::toPercentEncoding(flat.camera)) + '|' +
+           QString::fromUtf8(QUrl::toPercentEncoding(flat.filter)) + '|' + fields.join(';');
+}
+
+bool FlatExposureStore::parse(const QString &entry, Flat *result)
+{
+    const QStringList parts = entry.split('|');
+    if (parts.size() != 3)
+        return false;
+    const QStringList fields = parts[2].split(';');
+    if (fields.size() != FLAT_FIELDS)
+        return false;
+
+    bool ok[6];
+    Flat flat;
+    flat.camera = QUrl::fromPercentEncoding(parts[0].toUtf8());
+    flat.filter = QUrl::fromPercentEncoding(parts[1].toUtf8());
+    flat.binning.setX(fields[0].toInt(&ok[0]));
+    flat.binning.setY(fields[1].toInt(&ok[1]));
+    flat.skyFlat = fields[2].toInt(&ok[2]) != 0;
+    flat.exposure = fields[3].toDouble(&ok[3]);
+    flat.adu = fields[4].toDouble(&ok[4]);
+    flat.time = fields[5].toLongLong(&ok[5]);
+    if (std::find(std::begin(ok), std::end(ok), false) != std::end(ok) || flat.exposure <= 0 || flat.adu <= 0)
+        return false;
+
+    *result = flat;
+    return true;
+}
+
+void FlatExposureStore::add(const Flat &flat)
+{
+    if (flat.exposure <= 0 || flat.adu <= 0)
+        return;
+
+    // Drop unreadable entries, and the previous flat of the camera, filter, binning and source
+    for (int i = m_Entries.size() - 1; i >= 0; --i)
+    {
+        Flat f;
+        if (!parse(m_Entries[i], &f) || (f.camera == flat.camera && f.filter == flat.filter &&
+                                         f.binning == flat.binning && f.skyFlat == flat.skyFlat))
+            m_Entries.removeAt(i);
+    }
+
+    m_Entries.append(encode(flat));
+    while (m_Entries.size() > MAX_ENTRIES)
+        m_Entries.removeFirst();
+
+    qCDebug(KSTARS_EKOS_CAPTURE) << QString("Stored %1 flat of camera %2 filter %3: %4 ADU in %5 s, %6 flats stored")
+                                 .arg(flat.skyFlat ? "sky" : "panel", flat.camera, flat.filter)
+                                 .arg(flat.adu, 0, 'f', 0).arg(flat.exposure).arg(m_Entries.size());
+}
+
+QVector<FlatExposureStore::Flat> FlatExposureStore::flats(const QString &camera, const QPoint &binning) const
+{
+    QVector<Flat> result;
+    for (const auto &entry : m_Entries)
+    {
+        Flat flat;
+        if (parse(entry, &flat) && flat.camera == camera && flat.binning == binning)
+            result.append(flat);
+    }
+    return result;
+}
+
+double FlatExposureStore::predict(const QString &camera, const QString &filter, const QPoint &binning, bool skyFlat,
+                                  double targetADU, qint64 now) const
+{
+    if (targetADU <= 0)
+        return -1;
+
+    const QVector<Flat> stored = flats(camera, binning);
+    if (!skyFlat)
+    {
+        const Flat *flat = newest(stored, filter, false);
+        return flat ? targetADU / rate(*flat) : -1;
+    }
+
+    // The newest sky flat that is still valid, of any filter
+    const Flat *reference = nullptr;
+    for (const auto &flat : stored)
+    {
+        if (flat.skyFlat && now - flat.time <= SKY_VALIDITY && flat.time <= now &&
+                (reference == nullptr || flat.time >= reference->time))
+            reference = &flat;
+    }
+    if (reference == nullptr)
+        return -1;
+    if (reference->filter == filter)
+        return targetADU / rate(*reference);
+
+    // How much brighter the filter is than the one of the reference, preferably from panel flats since the panel is
+    // steady. Sky flats only tell it if they were taken shortly after each other.
+    double response = -1;
+    const Flat *panel = newest(stored, filter, false), *referencePanel = newest(stored, reference->filter, false);
+    const Flat *sky = newest(stored, filter, true), *referenceSky = newest(stored, reference->filter, true);
+    if (panel && referencePanel)
+        response = rate(*panel) / rate(*referencePanel);
+    else if (sky && referenceSky && std::abs(sky->time - referenceSky->time) <= SKY_VALIDITY)
+        response = rate(*sky) / rate(*referenceSky);
+    if (response <= 0 || std::isnan(response) || std::isinf(response))
+        return -1;
+
+    return targetADU / (rate(*reference) * response);
+}
+
+}
@@ -0,0 +1,83 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QPoint>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace Ekos
+{
+
+// Keeps the exposures of the last calibrated ADU flats of each camera, filter, binning and flat source, so that
+// the next calibration can start close to its result instead of at the exposure of the job.
+//
+// A panel is assumed to be as bright as when its flats were last calibrated, so its exposure is predicted from the
+// stored flat of the same filter. The sky changes within minutes, so a sky flat is predicted from the sky flat of
+// another filter calibrated shortly before, scaled by how much brighter the filter was than the other one in stored
+// flats of the same source.
+//
+// The flats are stored in the FlatExposureStore option, one entry per flat: the percent-encoded camera and filter
+// names separated by '|', a '|', and the fields of the flat separated by ';'.
+class FlatExposureStore
+{
+    public:
+        // Flats kept in all, the oldest are dropped beyond this.
+        static constexpr int MAX_ENTRIES = 200;
+        // Seconds during which a sky flat predicts the sky flats of other filters.
+        static constexpr qint64 SKY_VALIDITY = 20 * 60;
+
+        typedef struct
+        {
+            QString camera;
+            QString filter;
+            QPoint binning;
+            bool skyFlat;
+            double exposure;
+            double adu;
+            // Seconds since the epoch
+            qint64 time;
+        } Flat;
+
+        // Reads the store from the options.
+        FlatExposureStore();
+        // Uses the given entries, for tests.
+        explicit FlatExposureStore(const QStringList &entries);
+
+        // Writes the store to the options.
+        void save() const;
+
+        // Adds a calibrated flat, replacing the one of the same camera, filter, binning and source.
+        void add(const Flat &flat);
+
+        // Returns the flats of camera and binning, oldest first.
+        QVector<Flat> flats(const QString &camera, const QPoint &binning) const;
+
+        // Predicts the exposure of a flat of targetADU of camera, filter, binning and source at time now,
+        // or returns -1 if the stored flats don't allow it.
+        double predict(const QString &camera, const QString &filter, const QPoint &binning, bool skyFlat,
+                       double targetADU, qint64 now) const;
+
+        bool isEmpty() const
+        {
+            return m_Entries.isEmpty();
+        }
+
+        const QStringList &entries() const
+        {
+            return m_Entries;
+        }
+
+    private:
+        static QString encode(const Flat &flat);
+        static bool parse(const QString &entry, Flat *result);
+
+        QStringList m_Entries;
+};
+
+}
@@ -0,0 +1,125 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "framequalityassessor.h"
+
+#include "fitsviewer/fitsdata.h"
+#include "fitsviewer/imagememory.h"
+#include "ekos/auxiliary/stellarsolverprofile.h"
+#include "Options.h"
+
+#include <ekos_capture_debug.h>
+
+#include <QtConcurrent>
+
+#include <algorithm>
+
+namespace Ekos
+{
+
+FrameQualityAssessor::FrameQualityAssessor(QObject *parent) : QObject(parent)
+{
+    m_Pool.setMaxThreadCount(std::max(1u, Options::captureQualityThreads()));
+}
+
+FrameQualityAssessor::~FrameQualityAssessor()
+{
+    m_Pool.waitForDone();
+}
+
+bool FrameQualityAssessor::assess(const QVariantMap &metadata, const QSharedPointer<FITSData> &imageData,
+                                  const QString &filename, const QFuture<void> &fileWrite)
+{
+    if (m_Pending.loadAcquire() >= static_cast<int>(std::max(1u, Options::captureQualityQueueSize())))
+    {
+        qCDebug(KSTARS_EKOS_CAPTURE) << "Frame quality queue is full, not assessing" << metadata["filename"].toString();
+        return false;
+    }
+
+    m_Pending.ref();
+    const int bin = std::max(1u, Options::captureQualityBinning());
+    QtConcurrent::run(&m_Pool, [this, metadata, imageData, filename, fileWrite, bin]()
+    {
+        QVariantMap assessed = metadata;
+        QSharedPointer<FITSData> data = imageData;
+        if (data.isNull() && !filename.isEmpty())
+        {
+            // The camera may still be writing the file
+            QFuture<void> write = fileWrite;
+            write.waitForFinished();
+            data.reset(new FITSData(FITS_NORMAL));
+            ImageMemory::instance().setOwner(data.get(), ImageMemory::Capture);
+            if (!data->loadFromFile(filename).result())
+            {
+                qCWarning(KSTARS_EKOS_CAPTURE) << "Failed to load" << filename << "to assess its quality";
+                data.clear();
+            }
+        }
+        if (data)
+            measure(data, bin, assessed);
+
+        m_Pending.deref();
+        emit frameAssessed(assessed);
+    });
+    return true;
+}
+
+void FrameQualityAssessor::waitForDone()
+{
+    m_Pool.waitForDone();
+}
+
+QSharedPointer<FITSData> FrameQualityAssessor::binFrame(const QSharedPointer<FITSData> &imageData, int bin)
+{
+    const FITSImage::Statistic &stats = imageData->getStatistics();
+    if (bin <= 0 || bin > UINT8_MAX)
+        return QSharedPointer<FITSData>();
+    const QSharedPointer<const QVector<float>> samples = imageData->getBinnedFloatBuffer(static_cast<uint8_t>(bin));
+    if (samples.isNull())
+        return QSharedPointer<FITSData>();
+
+    FITSImage::Statistic binned;
+    binned.dataType = TFLOAT;
+    binned.bytesPerPixel = sizeof(float);
+    binned.channels = 1;
+    binned.width = stats.width / bin;
+    binned.height = stats.height / bin;
+    binned.samples_per_channel = binned.width * binned.height;
+    binned.size = binned.samples_per_channel * sizeof(float);
+
+    QSharedPointer<FITSData> result(new FITSData(FITS_NORMAL));
+    float *destination = reinterpret_cast<float *>(result->createImageBuffer(binned));
+    std::copy(samples->cbegin(), samples->cend(), destination);
+    return result;
+}
+
+bool FrameQualityAssessor::measure(const QSharedPointer<FITSData> &imageData, int bin, QVariantMap &metadata)
+{
+    QSharedPointer<FITSData> binned = bin > 1 ? binFrame(imageData, bin) : QSharedPointer<FITSData>();
+    FITSData *searched = binned ? binned.data() : imageData.data();
+    const double scale = binned ? bin : 1.0;
+
+    QVariantMap extractionSettings;
+#ifdef HAVE_STELLARSOLVER
+    extractionSettings["optionsProfileIndex"] = Options::hFROptionsProfile();
+    extractionSettings["optionsProfileGroup"] = static_cast<int>(Ekos::HFRProfiles);
+#endif
+    extractionSettings["statisticsOnly"] = true;
+    // A frame that is searched as it is may be shown, so its settings are kept
+    const QVariantMap previousSettings = searched->getSourceExtractorSettings();
+    searched->setSourceExtractorSettings(extractionSettings);
+    const bool found = searched->findStars(ALGORITHM_SEP).result();
+    if (!binned)
+        searched->setSourceExtractorSettings(previousSettings);
+
+    metadata["hfr"] = found ? searched->getHFR(HFR_AVERAGE) * scale : -1;
+    metadata["starCount"] = found ? searched->getSkyBackground().starsDetected : 0;
+    metadata["eccentricity"] = found ? searched->getEccentricity() : -1;
+    metadata["median"] = imageData->getMedian();
+    return found;
+}
+
+}
@@ -0,0 +1,73 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QAtomicInt>
+#include <QFuture>
+#include <QObject>
+#include <QSharedPointer>
+#include <QThreadPool>
+#include <QVariantMap>
+
+class FITSData;
+
+namespace Ekos
+{
+
+/**
+ * @class FrameQualityAssessor
+ * @short Measures the stars of captured light frames on a few background threads.
+ *
+ * Frames are binned before their stars are searched for, which is enough for the HFR, star count and
+ * eccentricity reported to Analyze and the scheduler. Frames are dropped rather than queued once too
+ * many are waiting, so the sequence is never held up.
+ */
+class FrameQualityAssessor : public QObject
+{
+        Q_OBJECT
+
+    public:
+        explicit FrameQualityAssessor(QObject *parent = nullptr);
+        ~FrameQualityAssessor() override;
+
+        /**
+         * @brief assess Measure the stars of a frame in the background, and report them with frameAssessed().
+         * @param metadata Metadata of the frame, completed with the measures.
+         * @param imageData The frame, or null to load it from filename once fileWrite has finished.
+         * @param filename File of the frame if it has no data.
+         * @param fileWrite Write of the file, if in progress.
+         * @return False if the frame was dropped.
+         */
+        bool assess(const QVariantMap &metadata, const QSharedPointer<FITSData> &imageData,
+                    const QString &filename = QString(), const QFuture<void> &fileWrite = QFuture<void>());
+
+        /** @brief waitForDone Wait until all queued frames are reported. */
+        void waitForDone();
+
+        int pending() const
+        {
+            return m_Pending.loadAcquire();
+        }
+
+        /**
+         * @brief binFrame Average the samples of all channels of the frame over bin x bin blocks.
+         * @return A single channel float frame, or null if the frame is smaller than a block.
+         */
+        static QSharedPointer<FITSData> binFrame(const QSharedPointer<FITSData> &imageData, int bin);
+
+        /** @brief measure Search the stars of the frame binned bin x bin, and add the measures to metadata. */
+        static bool measure(const QSharedPointer<FITSData> &imageData, int bin, QVariantMap &metadata);
+
+    signals:
+        void frameAssessed(const QVariantMap &metadata);
+
+    private:
+        QThreadPool m_Pool;
+        QAtomicInt m_Pending {0};
+};
+
+}
@@ -9,8 +9,15 @@
 #include "sequencejob.h"
 #include "kspaths.h"
 
+#include <QCoreApplication>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QMutex>
+#include <QSet>
 #include <QString>
 #include <QStringList>
+#include <QTimer>
+#include <QVector>
 
 #include <cmath>
 #include <algorithm>
@@ -19,6 +26,125 @@
 namespace Ekos
 {
 
+namespace
+{
+// A part of a filename format: either literal text or a placeholder with its level and separator
+struct FormatToken
+{
+    bool placeholder { false };
+    QString text;
+    QString name;
+    QString level;
+    QString sep;
+};
+
+// Formats split at their placeholders, since the same format is used for each frame of a job
+QMutex formatsMutex;
+QHash<QString, QVector<FormatToken>> parsedFormats;
+constexpr int MAX_PARSED_FORMATS = 64;
+
+QVector<FormatToken> parseFormat(const QString &format)
+{
+    QMutexLocker locker(&formatsMutex);
+    auto parsed = parsedFormats.constFind(format);
+    if (parsed != parsedFormats.constEnd())
+        return parsed.value();
+
+    static const QRegularExpression
+#if defined(Q_OS_WIN)
+    re("(?<replace>\\%(?<name>(filename|f|Datetime|D|Type|T|exposure|e|exp|E|Filter|F|target|t|temperature|C|bin|B|gain|G|offset|O|iso|I|pierside|P|sequence|s))(?<level>\\d+)?)(?<sep>[_\\\\])?");
+#else
+    re("(?<replace>\\%(?<name>(filename|f|Datetime|D|Type|T|exposure|e|exp|E|Filter|F|target|t|temperature|C|bin|B|gain|G|offset|O|iso|I|pierside|P|sequence|s))(?<level>\\d+)?)(?<sep>[_/])?");
+#endif
+
+    QVector<FormatToken> tokens;
+    int last = 0;
+    auto matches = re.globalMatch(format);
+    while (matches.hasNext())
+    {
+        const QRegularExpressionMatch match = matches.next();
+        if (match.capturedStart() > last)
+        {
+            FormatToken literal;
+            literal.text = format.mid(last, match.capturedStart() - last);
+            tokens.append(literal);
+        }
+        FormatToken placeholder;
+        placeholder.placeholder = true;
+        placeholder.text = match.captured("replace");
+        placeholder.name = match.captured("name");
+        placeholder.level = match.captured("level");
+        placeholder.sep = match.captured("sep");
+        tokens.append(placeholder);
+        last = match.capturedEnd();
+    }
+    if (last < format.length())
+    {
+        FormatToken literal;
+        literal.text = format.mid(last);
+        tokens.append(literal);
+    }
+
+    if (parsedFormats.size() >= MAX_PARSED_FORMATS)
+        parsedFormats.clear();
+    parsedFormats.insert(format, tokens);
+    return tokens;
+}
+
+// Names of the files of the capture directories, scanned once per job and updated as frames are written
+QMutex directoryIndexMutex;
+QHash<QString, QSet<QString>> directoryIndex;
+
+QString directoryKey(const QDir &dir)
+{
+    return QDir::cleanPath(dir.absolutePath());
+}
+
+// Indexed directories changed by others, forgotten together so that each one is scanned at most once per delay
+constexpr int RECONCILE_DELAY_MS = 30000;
+QSet<QString> changedDirectories;
+
+void reconcileChangedDirectories()
+{
+    QMutexLocker locker(&directoryIndexMutex);
+    for (const auto &key : changedDirectories)
+        directoryIndex.remove(key);
+    changedDirectories.clear();
+}
+
+// Watches an indexed directory, so that files added or removed outside of Ekos are found again
+void watchDirectory(const QString &key)
+{
+    QCoreApplication *app = QCoreApplication::instance();
+    if (app == nullptr || !QFileInfo::exists(key))
+        return;
+
+    // Directories are indexed from any thread, the watcher lives in the main one
+    QMetaObject::invokeMethod(app, [key, app]()
+    {
+        static QFileSystemWatcher *watcher = nullptr;
+        static QTimer *reconcileTimer = nullptr;
+        if (watcher == nullptr)
+        {
+            watcher = new QFileSystemWatcher(app);
+            reconcileTimer = new QTimer(app);
+            reconcileTimer->setSingleShot(true);
+            reconcileTimer->setInterval(RECONCILE_DELAY_MS);
+            QObject::connect(reconcileTimer, &QTimer::timeout, app, reconcileChangedDirectories);
+            QObject::connect(watcher, &QFileSystemWatcher::directoryChanged, app, [](const QString & path)
+            {
+                QMutexLocker locker(&directoryIndexMutex);
+                changedDirectories.insert(path);
+                if (!reconcileTimer->isActive())
+                    reconcileTimer->start();
+            });
+        }
+        if (!watcher->directories().contains(key))
+            watcher->addPath(key);
+    }, Qt::QueuedConnection);
+}
+}
+
 QMap<CCDFrameType, QString> PlaceholderPath::m_frameTypes =
 {
     {FRAME_LIGHT, "Light"},
@@ -284,7 +410,6 @@ QString PlaceholderPath::generateFilenameInternal(const QMap<PathProperty, QVari
         const bool gettingSignature) const
 {
     QString targetNameSanitized = KSUtils::sanitize(pathPropertyMap[PP_TARGETNAME].toString());
-    int i = 0;
 
     const QString format = pathPropertyMap[PP_FORMAT].toString();
     const bool isDarkFlat = pathPropertyMap[PP_DARKFLAT].isValid() && pathPropertyMap[PP_DARKFLAT].toBool();
@@ -310,20 +435,19 @@ QString PlaceholderPath::generateFilenameInternal(const QMap<PathProperty, QVari
 #if defined(Q_OS_WIN)
     tempFormat.replace("\\", "/");
 #endif
-    QRegularExpressionMatch match;
-    QRegularExpression
-#if defined(Q_OS_WIN)
-    re("(?<replace>\\%(?<name>(filename|f|Datetime|D|Type|T|exposure|e|exp|E|Filter|F|target|t|temperature|C|bin|B|gain|G|offset|O|iso|I|pierside|P|sequence|s))(?<level>\\d+)?)(?<sep>[_\\\\])?");
-#else
-    re("(?<replace>\\%(?<name>(filename|f|Datetime|D|Type|T|exposure|e|exp|E|Filter|F|target|t|temperature|C|bin|B|gain|G|offset|O|iso|I|pierside|P|sequence|s))(?<level>\\d+)?)(?<sep>[_/])?");
-#endif
-
-    while ((i = tempFormat.indexOf(re, i, &match)) != -1)
+    QString result;
+    for (const FormatToken &token : parseFormat(tempFormat))
     {
+        if (!token.placeholder)
+        {
+            result += token.text;
+            continue;
+        }
+
         QString replacement = "";
-        if ((match.captured("name") == "filename") || (match.captured("name") == "f"))
+        if ((token.name == "filename") || (token.name == "f"))
             replacement = m_seqFilename.baseName();
-        else if ((match.captured("name") == "Datetime") || (match.captured("name") == "D"))
+        else if ((token.name == "Datetime") || (token.name == "D"))
         {
             if (glob || gettingSignature)
             {
@@ -336,15 +460,15 @@ QString PlaceholderPath::generateFilenameInternal(const QMap<PathProperty, QVari
             else
                 replacement = QDateTime::currentDateTime().toString("yyyy-MM-ddThh-mm-ss");
         }
-        else if ((match.captured("name") == "Type") || (match.captured("name") == "T"))
+        else if ((token.name == "Type") || (token.name == "T"))
         {
             if (isDarkFlat)
                 replacement = "DarkFlat";
             else
                 replacement = getFrameType(frameType);
         }
-        else if ((match.captured("name") == "exposure") || (match.captured("name") == "e") ||
-                 (match.captured("name") == "exp") || (match.captured("name") == "E"))
+        else if ((token.name == "exposure") || (token.name == "e") ||
+                 (token.name == "exp") || (token.name == "E"))
         {
             double fractpart, intpart;
             double exposure = pathPropertyMap[PP_EXPOSURE].toDouble();
@@ -356,10 +480,10 @@ QString PlaceholderPath::generateFilenameInternal(const QMap<PathProperty, QVari
             else
                 replacement = QString::number(exposure, 'f', 6);
             // append _secs for placeholders "exposure" and "e"
-            if ((match.captured("name") == "exposure") || (match.captured("name") == "e"))
+            if ((token.name == "exposure") || (token.name == "e"))
                 replacement += QString("_secs");
         }
-        else if ((match.captured("name") == "Filter") || (match.captured("name") == "F"))
+        else if ((token.name == "Filter") || (token.name == "F"))
         {
             QString filter = pathPropertyMap[PP_FILTER].toString();
             if (filter.isEmpty() == false
@@ -371,64 +495,64 @@ QString PlaceholderPath::generateFilenameInternal(const QMap<PathProperty, QVari
                 replacement = filter;
             }
         }
-        else if ((match.captured("name") == "target") || (match.captured("name") == "t"))
+        else if ((token.name == "target") || (token.name == "t"))
         {
             replacement = targetNameSanitized;
         }
-        else if (((match.captured("name") == "temperature") || (match.captured("name") == "C")))
+        else if (((token.name == "temperature") || (token.name == "C")))
         {
             replacement = generateReplacement(pathPropertyMap, PP_TEMPERATURE,
                                               (glob || gettingSignature) && pathPropertyMap[PP_TEMPERATURE].isValid() == false);
         }
-        else if (((match.captured("name") == "bin") || (match.captured("name") == "B")))
+        else if (((token.name == "bin") || (token.name == "B")))
         {
             replacement = generateReplacement(pathPropertyMap, PP_BIN,
                                               (glob || gettingSignature) && pathPropertyMap[PP_BIN].isValid() == false);
         }
-        else if (((match.captured("name") == "gain") || (match.captured("name") == "G")))
+        else if (((token.name == "gain") || (token.name == "G")))
         {
             replacement = generateReplacement(pathPropertyMap, PP_GAIN,
                                               (glob || gettingSignature) && pathPropertyMap[PP_GAIN].isValid() == false);
         }
-        else if (((match.captured("name") == "offset") || (match.captured("name") == "O")))
+        else if (((token.name == "offset") || (token.name == "O")))
         {
             replacement = generateReplacement(pathPropertyMap, PP_OFFSET,
                                               (glob || gettingSignature) && pathPropertyMap[PP_OFFSET].isValid() == false);
         }
-        else if (((match.captured("name") == "iso") || (match.captured("name") == "I"))
+        else if (((token.name == "iso") || (token.name == "I"))
                  && pathPropertyMap[PP_ISO].isValid())
         {
             replacement = generateReplacement(pathPropertyMap, PP_ISO,
                                               (glob || gettingSignature) && pathPropertyMap[PP_ISO].isValid() == false);
         }
-        else if (((match.captured("name") == "pierside") || (match.captured("name") == "P")))
+        else if (((token.name == "pierside") || (token.name == "P")))
         {
             replacement = generateReplacement(pathPropertyMap, PP_PIERSIDE, glob || gettingSignature);
         }
         // Disable for now %d & %p tags to simplfy
-        //        else if ((match.captured("name") == "directory") || (match.captured("name") == "d") ||
-        //                 (match.captured("name") == "path") || (match.captured("name") == "p"))
+        //        else if ((token.name == "directory") || (token.name == "d") ||
+        //                 (token.name == "path") || (token.name == "p"))
         //        {
         //            int level = 0;
-        //            if (!match.captured("level").isEmpty())
-        //                level = match.captured("level").toInt() - 1;
+        //            if (!token.level.isEmpty())
+        //                level = token.level.toInt() - 1;
         //            QFileInfo dir = m_seqFilename;
         //            for (int j = 0; j < level; ++j)
         //                dir = QFileInfo(dir.dir().path());
-        //            if (match.captured("name") == "directory" || match.captured("name") == "d")
+        //            if (token.name == "directory" || token.name == "d")
         //                replacement = dir.dir().dirName();
-        //            else if (match.captured("name") == "path" || match.captured("name") == "p")
+        //            else if (token.name == "path" || token.name == "p")
         //                replacement = dir.path();
         //        }
-        else if ((match.captured("name") == "sequence") || (match.captured("name") == "s"))
+        else if ((token.name == "sequence") || (token.name == "s"))
         {
             if (glob)
                 replacement = "(?<id>\\d+)";
             else if (local)
             {
                 int level = 0;
-                if (!match.captured("level").isEmpty())
-                    level = match.captured("level").toInt();
+                if (!token.level.isEmpty())
+                    level = token.level.toInt();
                 replacement = QString("%1").arg(nextSequenceID, level, 10, QChar('0'));
             }
             else
@@ -438,14 +562,13 @@ QString PlaceholderPath::generateFilenameInternal(const QMap<PathProperty, QVari
             }
         }
         else
-            qWarning() << "Unknown replacement string: " << match.captured("replace");
+            qWarning() << "Unknown replacement string: " << token.text;
 
-        if (replacement.isEmpty())
-            tempFormat = tempFormat.replace(match.capturedStart(), match.capturedLength(), replacement);
-        else
-            tempFormat = tempFormat.replace(match.capturedStart("replace"), match.capturedLength("replace"), replacement);
-        i += replacement.length();
+        // Empty placeholders are removed with their separator
+        if (replacement.isEmpty() == false)
+            result += replacement + token.sep;
     }
+    tempFormat = result;
 
     if (!gettingSignature)
         tempFilename = tempFormat + extension;
@@ -535,7 +658,7 @@ QList<int> PlaceholderPath::getCompletedFileIds(const SequenceJob &job)
     filename.replace("{IDRE}", idRE);
     filename.replace("{DATETIMERE}", datetimeRE);
 
-    QStringList matchingFiles = dir.entryList(QDir::Files);
+    const QSet<QString> matchingFiles = directoryEntries(dir);
     QRegularExpressionMatch match;
     QRegularExpression re("^" + filename + "$");
     QList<int> ids = {};
@@ -549,6 +672,45 @@ QList<int> PlaceholderPath::getCompletedFileIds(const SequenceJob &job)
     return ids;
 }
 
+QSet<QString> PlaceholderPath::directoryEntries(const QDir &dir)
+{
+    const QString key = directoryKey(dir);
+    QMutexLocker locker(&directoryIndexMutex);
+    auto entries = directoryIndex.constFind(key);
+    if (entries != directoryIndex.constEnd())
+        return entries.value();
+
+    QSet<QString> scanned;
+    for (const auto &name : dir.entryList(QDir::Files))
+        scanned.insert(name);
+    // Directories that don't exist yet are created with the first frame, which is then added
+    directoryIndex.insert(key, scanned);
+    watchDirectory(key);
+    return scanned;
+}
+
+void PlaceholderPath::resetDirectoryIndex()
+{
+    QMutexLocker locker(&directoryIndexMutex);
+    directoryIndex.clear();
+    changedDirectories.clear();
+}
+
+void PlaceholderPath::addToDirectoryIndex(const QString &filename)
+{
+    const QFileInfo info(filename);
+    const QString key = directoryKey(info.dir());
+    QMutexLocker locker(&directoryIndexMutex);
+    auto entries = directoryIndex.find(key);
+    if (entries != directoryIndex.end())
+    {
+        // The directory has just been created with this file
+        if (entries->isEmpty())
+            watchDirectory(key);
+        entries->insert(info.fileName());
+    }
+}
+
 int PlaceholderPath::getCompletedFiles(const SequenceJob &job)
 {
     return getCompletedFileIds(job).length();
@@ -592,12 +754,10 @@ int PlaceholderPath::getCompletedFiles(const QString &path)
 #endif
     QRegularExpression re(sig_file);
 
-    QDirIterator it(sig_dir, QDir::Files);
-
     /* FIXME: this counts all files with prefix in the storage location, not just captures. DSS analysis files are counted in, for instance. */
-    while (it.hasNext())
+    for (const auto &name : directoryEntries(QDir(sig_dir)))
     {
-        QString const fileName = QFileInfo(it.next()).completeBaseName();
+        QString const fileName = QFileInfo(name).completeBaseName();
 
         QRegularExpressionMatch match = re.match(fileName);
         if (match.hasMatch())
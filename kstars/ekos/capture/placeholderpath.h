@@ -10,6 +10,7 @@
 #include "indi/indistd.h"
 #include <QDebug>
 #include <QFileInfo>
+#include <QSet>
 
 class QString;
 class SchedulerJob;
@@ -132,6 +133,18 @@ class PlaceholderPath
          */
         QList<int> getCompletedFileIds(const SequenceJob &job);
 
+        /**
+         * @brief resetDirectoryIndex forgets the files known in the capture directories. Each directory
+         * is scanned again the next time its fileIDs are needed, typically once when a job starts.
+         */
+        static void resetDirectoryIndex();
+
+        /**
+         * @brief addToDirectoryIndex adds a file that is being written to the index of its directory
+         * @param filename full path of the file
+         */
+        static void addToDirectoryIndex(const QString &filename);
+
         /**
          * @brief getCompletedFiles provides the number of existing fileIDs
          * @param sequence job to be processed
@@ -141,6 +154,8 @@ class PlaceholderPath
 
         /**
          * @brief getCompletedFiles determines the number of files matching the given path pattern
+         * @note The files are taken from the directory index, the directory is scanned only if it is not indexed yet.
+         * Indexed directories are watched, and scanned again at most every 30 seconds once changed outside of Ekos.
          */
         static int getCompletedFiles(const QString &path);
 
@@ -209,6 +224,11 @@ private:
          */
         QString generateReplacement(const QMap<PathProperty, QVariant> &pathPropertyMap, PathProperty property, bool usePattern = false) const;
 
+        /**
+         * @brief directoryEntries provides the names of the files in dir, from the index if it is indexed
+         */
+        static QSet<QString> directoryEntries(const QDir &dir);
+
         static QString getFrameType(CCDFrameType frameType)
         {
             if (m_frameTypes.contains(frameType))
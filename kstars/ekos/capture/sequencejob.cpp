@@ -343,10 +343,19 @@ void SequenceJob::capture(FITSMode mode)
         logentry.append(QString(", Cannot bin"));
 
 
-    const auto roi = getCoreProperty(SJ_ROI).toRect();
+    auto roi = getCoreProperty(SJ_ROI).toRect();
+    // ADU flat calibration exposures may be measured on a part of the frame only
+    const bool calibrationSubframe = mode == FITS_CALIBRATE && m_CalibrationFrame.isValid();
+    if (calibrationSubframe)
+        roi = m_CalibrationFrame;
 
     if (devices.data()->getActiveChip()->canSubframe())
     {
+        // Back to the full frame after calibration exposures of a job without ROI
+        if (m_CalibrationSubframed && calibrationSubframe == false && (roi.width() <= 0 || roi.height() <= 0))
+            devices.data()->getActiveChip()->resetFrame();
+        m_CalibrationSubframed = calibrationSubframe;
+
         if ((roi.width() > 0 && roi.height() > 0) && devices.data()->getActiveChip()->setFrame(roi.x(),
                 roi.y(),
                 roi.width(),
@@ -464,6 +473,21 @@ FlatFieldDuration SequenceJob::getFlatFieldDuration() const
     return m_FlatFieldDuration;
 }
 
+void SequenceJob::setCalibrationFrame(const QRect &frame)
+{
+    m_CalibrationFrame = frame;
+}
+
+const QRect &SequenceJob::getCalibrationFrame() const
+{
+    return m_CalibrationFrame;
+}
+
+bool SequenceJob::isCalibrationSubframed() const
+{
+    return m_CalibrationSubframed;
+}
+
 void SequenceJob::setJobProgressIgnored(bool value)
 {
     m_JobProgressIgnored = value;
@@ -263,6 +263,13 @@ class SequenceJob : public QObject
         // Getter: Get flat field duration
         FlatFieldDuration getFlatFieldDuration() const;
 
+        // Setter: Set the frame of ADU flat calibration exposures, empty for the frame of the job
+        void setCalibrationFrame(const QRect &frame);
+        // Getter: Get the frame of ADU flat calibration exposures
+        const QRect &getCalibrationFrame() const;
+        // Getter: Whether the last exposure was taken on the calibration frame
+        bool isCalibrationSubframed() const;
+
         // Setter: Set job progress ignored flag
         void setJobProgressIgnored(bool value);
         bool getJobProgressIgnored() const;
@@ -440,6 +447,9 @@ private:
         //////////////////////////////////////////////////////////////
         QMap<QString, QMap<QString, QVariant>> m_CustomProperties;
         FlatFieldDuration m_FlatFieldDuration { DURATION_MANUAL };
+        // Frame of ADU flat calibration exposures, and whether the chip is set to it
+        QRect m_CalibrationFrame;
+        bool m_CalibrationSubframed { false };
         // Capture Scripts
         QMap<ScriptTypes, QString> m_Scripts;
         // Upload Mode
@@ -9,8 +9,10 @@
 #include "cloud.h"
 #include "commands.h"
 #include "fitsviewer/fitsdata.h"
+#include "fitsviewer/imagememory.h"
 
 #include "ekos_debug.h"
+#include "kspaths.h"
 #include "version.h"
 #include "../fitsviewer/fpack.h"
 #include "Options.h"
@@ -32,12 +34,16 @@ Cloud::Cloud(Ekos::Manager * manager, QVector<QSharedPointer<NodeManager>> &node
 
         connect(nodeManager->cloud(), &Node::connected, this, &Cloud::onConnected);
         connect(nodeManager->cloud(), &Node::disconnected, this, &Cloud::onDisconnected);
-        connect(nodeManager->cloud(), &Node::onTextReceived, this, &Cloud::onTextReceived);
+        connect(nodeManager->cloud(), &Node::onJsonReceived, this, &Cloud::onJsonReceived);
+        connect(nodeManager->cloud(), &Node::bytesWritten, this, &Cloud::onBytesWritten);
     }
 
-    connect(&watcher, &QFutureWatcher<bool>::finished, this, &Cloud::sendImage, Qt::UniqueConnection);
-    connect(this, &Cloud::newImage, this, &Cloud::uploadImage);
     connect(Options::self(), &Options::EkosLiveCloudChanged, this, &Cloud::updateOptions);
+
+    // Images of a whole night may wait for a slow link, they are queued on disk rather than in memory.
+    m_SpoolDirectory = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("ekoslivecloud");
+    QDir().mkpath(m_SpoolDirectory);
+    m_CompressionPool.setMaxThreadCount(std::max(1u, Options::ekosLiveCloudUploads()));
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -59,6 +65,11 @@ void Cloud::onConnected()
 
     qCInfo(KSTARS_EKOS) << "Connected to Cloud Websocket server at" << node->url().toDisplayString();
 
+    m_BytesSent[node] = 0;
+    m_BytesWritten[node] = 0;
+    resumeSpool();
+    sendNext();
+
     emit connected();
 }
 
@@ -67,6 +78,20 @@ void Cloud::onDisconnected()
     qCInfo(KSTARS_EKOS) << "Disconnected from Cloud Websocket server.";
     m_sendBlobs = true;
 
+    // Images not completely written are sent again from the spool once connected.
+    auto node = qobject_cast<Node*>(sender());
+    if (node)
+    {
+        const QQueue<InFlight> inFlight = m_InFlight.take(node);
+        for (auto it = inFlight.crbegin(); it != inFlight.crend(); ++it)
+        {
+            if (m_InFlightNodes.remove(it->uuid) > 0 && m_Queue.contains(it->uuid) == false)
+                m_Queue.prepend(it->uuid);
+        }
+        m_BytesSent.remove(node);
+        m_BytesWritten.remove(node);
+    }
+
     for (auto &oneFile : temporaryFiles)
         QFile::remove(oneFile);
     temporaryFiles.clear();
@@ -74,18 +99,8 @@ void Cloud::onDisconnected()
     emit disconnected();
 }
 
-void Cloud::onTextReceived(const QString &message)
+void Cloud::onJsonReceived(const QJsonObject &msgObj)
 {
-    qCInfo(KSTARS_EKOS) << "Cloud Text Websocket Message" << message;
-    QJsonParseError error;
-    auto serverMessage = QJsonDocument::fromJson(message.toLatin1(), &error);
-    if (error.error != QJsonParseError::NoError)
-    {
-        qCWarning(KSTARS_EKOS) << "Ekos Live Parsing Error" << error.errorString();
-        return;
-    }
-
-    const QJsonObject msgObj = serverMessage.object();
     const QString command = msgObj["type"].toString();
     if (command == commands[SET_BLOBS])
         m_sendBlobs = msgObj["payload"].toBool();
@@ -96,7 +111,7 @@ void Cloud::onTextReceived(const QString &message)
             if (nodeManager->cloud() == nullptr)
                 continue;
 
-            nodeManager->cloud()->disconnectServer();
+            QMetaObject::invokeMethod(nodeManager->cloud(), &Node::disconnectServer, Qt::QueuedConnection);
         }
     }
 }
@@ -106,9 +121,7 @@ void Cloud::upload(const QSharedPointer<FITSData> &data, const QString &uuid)
     if (Options::ekosLiveCloud() == false  || m_sendBlobs == false)
         return;
 
-    m_UUID = uuid;
-    m_ImageData = data;
-    sendImage();
+    compress(data, QString(), uuid);
 }
 
 void Cloud::upload(const QString &filename, const QString &uuid)
@@ -116,25 +129,47 @@ void Cloud::upload(const QString &filename, const QString &uuid)
     if (Options::ekosLiveCloud() == false  || m_sendBlobs == false)
         return;
 
-    watcher.waitForFinished();
-    m_UUID = uuid;
-    m_ImageData.reset(new FITSData(), &QObject::deleteLater);
-    QFuture<bool> result = m_ImageData->loadFromFile(filename);
-    watcher.setFuture(result);
+    compress(QSharedPointer<FITSData>(), filename, uuid);
 }
 
-void Cloud::sendImage()
+void Cloud::compress(const QSharedPointer<FITSData> &data, const QString &filename, const QString &uuid)
 {
-    QtConcurrent::run(this, &Cloud::asyncUpload);
+    auto spooled = new QFutureWatcher<QString>(this);
+    connect(spooled, &QFutureWatcher<QString>::finished, this, [this, spooled]()
+    {
+        const QString uuid = spooled->result();
+        spooled->deleteLater();
+        if (uuid.isEmpty())
+            return;
+
+        m_Queue.enqueue(uuid);
+        sendNext();
+    });
+
+    m_CompressionPool.setMaxThreadCount(std::max(1u, Options::ekosLiveCloudUploads()));
+    spooled->setFuture(QtConcurrent::run(&m_CompressionPool, &Cloud::spoolImage, data, filename, uuid, m_SpoolDirectory));
 }
 
-void Cloud::asyncUpload()
+QString Cloud::spoolImage(const QSharedPointer<FITSData> &data, const QString &filename, const QString &uuid,
+                          const QString &directory)
 {
+    QSharedPointer<FITSData> imageData = data;
+    if (imageData.isNull())
+    {
+        imageData.reset(new FITSData());
+        ImageMemory::instance().setOwner(imageData.get(), ImageMemory::EkosLive);
+        if (imageData->loadFromFile(filename).result() == false)
+        {
+            qCWarning(KSTARS_EKOS) << "Failed to load" << filename << "for cloud upload";
+            return QString();
+        }
+    }
+
     // Send complete metadata
     // Add file name and size
     QJsonObject metadata;
     // Skip empty or useless metadata
-    for (const auto &oneRecord : m_ImageData->getRecords())
+    for (const auto &oneRecord : imageData->getRecords())
     {
         if (oneRecord.key.isEmpty() || oneRecord.value.toString().isEmpty())
             continue;
@@ -142,50 +177,128 @@ void Cloud::asyncUpload()
     }
 
     // Filename only without path
-    QString filepath = m_ImageData->filename();
+    QString filepath = imageData->filename();
     QString filenameOnly = QFileInfo(filepath).fileName();
 
     // Add filename and size as wells
-    metadata.insert("uuid", m_UUID);
+    metadata.insert("uuid", uuid);
     metadata.insert("filename", filenameOnly);
-    metadata.insert("filesize", static_cast<int>(m_ImageData->size()));
+    metadata.insert("filesize", static_cast<int>(imageData->size()));
     // Must set Content-Disposition so
     metadata.insert("Content-Disposition", QString("attachment;filename=%1.fz").arg(filenameOnly));
 
-    QByteArray image;
-    QByteArray meta = QJsonDocument(metadata).toJson(QJsonDocument::Compact);
-    meta = meta.leftJustified(METADATA_PACKET, 0);
-    image += meta;
-
-    QString compressedFile = QDir::tempPath() + QString("/ekoslivecloud%1").arg(m_UUID);
-    m_ImageData->saveImage(compressedFile + QStringLiteral("[compress R]"));
-    // Upload the compressed image
-    QFile compressedImage(compressedFile);
-    if (compressedImage.open(QIODevice::ReadOnly))
+    // The image is compressed once, and sent again from the spool if the connection is lost.
+    const QString compressedFile = QDir(directory).filePath(uuid + ".fz");
+    if (imageData->saveImage(compressedFile + QStringLiteral("[compress R]")) == false)
     {
-        image += compressedImage.readAll();
-        emit newImage(image);
-        qCInfo(KSTARS_EKOS) << "Uploaded" << compressedFile << " to the cloud";
+        qCWarning(KSTARS_EKOS) << "Failed to compress" << filepath << "for cloud upload";
+        QFile::remove(compressedFile);
+        return QString();
     }
 
-    // Remove from disk if temporary
-    if (compressedFile != filepath && compressedFile.startsWith(QDir::tempPath()))
+    QFile metadataFile(QDir(directory).filePath(uuid + ".json"));
+    if (metadataFile.open(QIODevice::WriteOnly) == false ||
+            metadataFile.write(QJsonDocument(metadata).toJson(QJsonDocument::Compact)) < 0)
+    {
         QFile::remove(compressedFile);
+        return QString();
+    }
 
-    m_ImageData.reset();
+    return uuid;
 }
 
-void Cloud::uploadImage(const QByteArray &image)
+void Cloud::resumeSpool()
 {
-    for (auto &nodeManager : m_NodeManagers)
+    if (m_SpoolResumed)
+        return;
+    m_SpoolResumed = true;
+
+    // Only images with their metadata are complete, in the order they were captured.
+    const QFileInfoList spooled = QDir(m_SpoolDirectory).entryInfoList(QStringList("*.json"), QDir::Files, QDir::Time | QDir::Reversed);
+    for (const auto &oneFile : spooled)
     {
-        if (nodeManager->cloud() == nullptr)
+        const QString uuid = oneFile.completeBaseName();
+        if (m_Queue.contains(uuid) == false && m_InFlightNodes.contains(uuid) == false)
+            m_Queue.enqueue(uuid);
+    }
+
+    if (m_Queue.isEmpty() == false)
+        qCInfo(KSTARS_EKOS) << "Resuming upload of" << m_Queue.size() << "images to the cloud";
+}
+
+void Cloud::sendNext()
+{
+    const int maxInFlight = std::max(1u, Options::ekosLiveCloudUploads());
+    while (m_Queue.isEmpty() == false && m_InFlightNodes.size() < maxInFlight)
+    {
+        const QString uuid = m_Queue.head();
+        QFile metadataFile(QDir(m_SpoolDirectory).filePath(uuid + ".json"));
+        QFile compressedImage(QDir(m_SpoolDirectory).filePath(uuid + ".fz"));
+        if (metadataFile.open(QIODevice::ReadOnly) == false || compressedImage.open(QIODevice::ReadOnly) == false)
+        {
+            qCWarning(KSTARS_EKOS) << "Discarding incomplete cloud upload" << uuid;
+            m_Queue.dequeue();
+            removeFromSpool(uuid);
             continue;
+        }
+
+        // First METADATA_PACKET bytes of the binary data is always allocated to the metadata
+        QByteArray image = metadataFile.readAll().leftJustified(METADATA_PACKET, 0);
+        image += compressedImage.readAll();
+
+        int nodes = 0;
+        for (auto &nodeManager : m_NodeManagers)
+        {
+            Node *node = nodeManager->cloud();
+            if (node == nullptr || node->isConnected() == false)
+                continue;
+
+            node->sendBinaryMessage(image);
+            m_BytesSent[node] += image.size();
+            m_InFlight[node].enqueue({uuid, m_BytesSent[node]});
+            nodes++;
+        }
+
+        // Wait for a connection
+        if (nodes == 0)
+            break;
 
-        nodeManager->cloud()->sendBinaryMessage(image);
+        m_Queue.dequeue();
+        m_InFlightNodes[uuid] = nodes;
     }
 }
 
+void Cloud::onBytesWritten(qint64 bytes)
+{
+    auto node = qobject_cast<Node*>(sender());
+    if (!node || m_InFlight.contains(node) == false)
+        return;
+
+    m_BytesWritten[node] += bytes;
+
+    QQueue<InFlight> &inFlight = m_InFlight[node];
+    while (inFlight.isEmpty() == false && inFlight.head().end <= m_BytesWritten[node])
+    {
+        const QString uuid = inFlight.dequeue().uuid;
+        // Images sent again after a disconnection are no longer counted here.
+        auto nodes = m_InFlightNodes.find(uuid);
+        if (nodes == m_InFlightNodes.end() || --nodes.value() > 0)
+            continue;
+
+        m_InFlightNodes.erase(nodes);
+        removeFromSpool(uuid);
+        qCInfo(KSTARS_EKOS) << "Uploaded" << uuid << "to the cloud," << m_Queue.size() << "images left";
+    }
+
+    sendNext();
+}
+
+void Cloud::removeFromSpool(const QString &uuid)
+{
+    QFile::remove(QDir(m_SpoolDirectory).filePath(uuid + ".json"));
+    QFile::remove(QDir(m_SpoolDirectory).filePath(uuid + ".fz"));
+}
+
 void Cloud::updateOptions()
 {
     // In case cloud storage is toggled, inform cloud
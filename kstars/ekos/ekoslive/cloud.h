@@ -9,6 +9,8 @@
 #pragma once
 
 #include <QtWebSockets/QWebSocket>
+#include <QQueue>
+#include <QThreadPool>
 #include <memory>
 
 #include "ekos/manager.h"
@@ -36,7 +38,6 @@ class Cloud : public QObject
     signals:
         void connected();
         void disconnected();
-        void newImage(const QByteArray &image);
 
     public slots:
         void updateOptions();
@@ -47,22 +48,44 @@ class Cloud : public QObject
         void onDisconnected();        
 
         // Communication
-        void onTextReceived(const QString &message);
-
-        // Send image
-        void sendImage();
-
-        void uploadImage(const QByteArray &image);
+        void onJsonReceived(const QJsonObject &msgObj);
+        void onBytesWritten(qint64 bytes);
 
     private:
-        void asyncUpload();
+        /**
+         * @brief spoolImage Compress an image to the spool directory with its metadata. The metadata is
+         * written last, so that only complete images are found by resumeSpool().
+         * @return the UUID of the image, or an empty string if it could not be compressed.
+         */
+        static QString spoolImage(const QSharedPointer<FITSData> &data, const QString &filename, const QString &uuid,
+                                  const QString &directory);
+        void compress(const QSharedPointer<FITSData> &data, const QString &filename, const QString &uuid);
+        // Queue the images left in the spool by a previous connection or session
+        void resumeSpool();
+        // Send queued images while less than the configured number are being written to the connections
+        void sendNext();
+        void removeFromSpool(const QString &uuid);
 
         Ekos::Manager * m_Manager { nullptr };
         QVector<QSharedPointer<NodeManager>> m_NodeManagers;
-        QString m_UUID;
 
-        QSharedPointer<FITSData> m_ImageData;
-        QFutureWatcher<bool> watcher;
+        // Compressed images waiting to be uploaded, kept on disk until they are sent
+        QString m_SpoolDirectory;
+        QThreadPool m_CompressionPool;
+        QQueue<QString> m_Queue;
+        bool m_SpoolResumed { false };
+
+        // Images being written to each connection, with the number of bytes sent when they are completely written
+        struct InFlight
+        {
+            QString uuid;
+            qint64 end;
+        };
+        QHash<Node *, QQueue<InFlight>> m_InFlight;
+        QHash<Node *, qint64> m_BytesSent;
+        QHash<Node *, qint64> m_BytesWritten;
+        // Number of connections still writing each image
+        QHash<QString, int> m_InFlightNodes;
 
         QString extension;
         QStringList temporaryFiles;
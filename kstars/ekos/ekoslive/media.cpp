@@ -11,6 +11,7 @@
 #include "skymapcomposite.h"
 #include "fitsviewer/fitsview.h"
 #include "fitsviewer/fitsdata.h"
+#include "fitsviewer/fitspreviewcache.h"
 #include "indi/indilistener.h"
 #include "hips/hipsfinder.h"
 #include "kstarsdata.h"
@@ -23,9 +24,10 @@
 #include "ekos_debug.h"
 #include "kstars.h"
 #include "version.h"
+#include "auxiliary/executors.h"
 
-#include <QtConcurrent>
 #include <KFormat>
+#include <QFileInfo>
 
 namespace EkosLive
 {
@@ -40,7 +42,7 @@ Media::Media(Ekos::Manager * manager, QVector<QSharedPointer<NodeManager>> &node
     {
         connect(nodeManager->media(), &Node::connected, this, &Media::onConnected);
         connect(nodeManager->media(), &Node::disconnected, this, &Media::onDisconnected);
-        connect(nodeManager->media(), &Node::onTextReceived, this, &Media::onTextReceived);
+        connect(nodeManager->media(), &Node::onJsonReceived, this, &Media::onJsonReceived);
         connect(nodeManager->media(), &Node::onBinaryReceived, this, &Media::onBinaryReceived);
     }
 
@@ -50,6 +52,13 @@ Media::Media(Ekos::Manager * manager, QVector<QSharedPointer<NodeManager>> &node
         uploadImage(image);
         m_TemporaryView.clear();
     });
+    connect(&m_FrameEncoder, &QFutureWatcher<QByteArray>::finished, this, [this]()
+    {
+        const QByteArray image = m_FrameEncoder.result();
+        m_EncodedSize = image.size();
+        emit newImage(image);
+        encodeNextFrame();
+    });
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -103,18 +112,8 @@ void Media::onDisconnected()
 ///////////////////////////////////////////////////////////////////////////////////////////
 ///
 ///////////////////////////////////////////////////////////////////////////////////////////
-void Media::onTextReceived(const QString &message)
+void Media::onJsonReceived(const QJsonObject &msgObj)
 {
-    qCInfo(KSTARS_EKOS) << "Media Text Websocket Message" << message;
-    QJsonParseError error;
-    auto serverMessage = QJsonDocument::fromJson(message.toLatin1(), &error);
-    if (error.error != QJsonParseError::NoError)
-    {
-        qCWarning(KSTARS_EKOS) << "Ekos Live Parsing Error" << error.errorString();
-        return;
-    }
-
-    const QJsonObject msgObj = serverMessage.object();
     const QString command = msgObj["type"].toString();
     const QJsonObject payload = msgObj["payload"].toObject();
 
@@ -288,7 +287,7 @@ void Media::sendData(const QSharedPointer<FITSData> &data, const QString &uuid)
 
     m_TemporaryView.reset(new FITSView());
     m_TemporaryView->loadData(data);
-    QtConcurrent::run(this, &Media::upload, m_TemporaryView);
+    upload(m_TemporaryView);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -301,10 +300,34 @@ void Media::sendFile(const QString &filename, const QString &uuid)
 
     m_UUID = uuid;
 
+    // Captured images have a stretched preview cached, which spares loading and stretching them again.
+    const QImage preview = FITSPreviewCache::load(filename, FITSPreviewCache::PREVIEW);
+    if (!preview.isNull())
+    {
+        const QJsonObject metadata =
+        {
+            {"size", KFormat().formatByteSize(QFileInfo(filename).size())},
+            {"uuid", m_UUID},
+            {"ext", "jpg"}
+        };
+
+        Frame frame;
+        frame.uuid = m_UUID;
+        frame.metadata = QJsonDocument(metadata).toJson(QJsonDocument::Compact);
+        frame.image = preview;
+        const auto fastImage = (!Options::ekosLiveHighBandwidth() || m_UUID[0] == "+");
+        const auto scaleWidth = fastImage ? HB_IMAGE_WIDTH / 2 : HB_IMAGE_WIDTH;
+        if (frame.image.width() > scaleWidth)
+            frame.scaleWidth = scaleWidth;
+        frame.transformation = fastImage ? Qt::FastTransformation : Qt::SmoothTransformation;
+        queueFrame(frame);
+        return;
+    }
+
     QSharedPointer<FITSView> previewImage(new FITSView());
     connect(previewImage.get(), &FITSView::loaded, this, [this, previewImage]()
     {
-        QtConcurrent::run(this, &Media::upload, previewImage);
+        upload(previewImage);
     });
     previewImage->loadFile(filename);
 }
@@ -328,9 +351,6 @@ void Media::sendView(const QSharedPointer<FITSView> &view, const QString &uuid)
 void Media::upload(const QSharedPointer<FITSView> &view)
 {
     const QString ext = "jpg";
-    QByteArray jpegData;
-    QBuffer buffer(&jpegData);
-    buffer.open(QIODevice::WriteOnly);
 
     const QSharedPointer<FITSData> imageData = view->imageData();
     QString resolution = QString("%1x%2").arg(imageData->width()).arg(imageData->height());
@@ -378,23 +398,22 @@ void Media::upload(const QSharedPointer<FITSView> &view)
     // First METADATA_PACKET bytes of the binary data is always allocated
     // to the metadata
     // the rest to the image data.
-    QByteArray meta = QJsonDocument(metadata).toJson(QJsonDocument::Compact);
-    meta = meta.leftJustified(METADATA_PACKET, 0);
-    buffer.write(meta);
+    Frame frame;
+    frame.uuid = m_UUID;
+    frame.metadata = QJsonDocument(metadata).toJson(QJsonDocument::Compact);
 
     auto fastImage = (!Options::ekosLiveHighBandwidth() || m_UUID[0] == "+");
     auto scaleWidth = fastImage ? HB_IMAGE_WIDTH / 2 : HB_IMAGE_WIDTH;
 
     // For low bandwidth images
     // Except for dark frames +D
-    QPixmap scaledImage = view->getDisplayPixmap().width() > scaleWidth ?
-                          view->getDisplayPixmap().scaledToWidth(scaleWidth, fastImage ? Qt::FastTransformation : Qt::SmoothTransformation) :
-                          view->getDisplayPixmap();
-    scaledImage.save(&buffer, ext.toLatin1().constData(), HB_IMAGE_QUALITY);
+    // The stretched image is shared with the view, it is scaled and encoded by the encoder thread.
+    frame.image = view->getDisplayImage();
+    if (frame.image.width() > scaleWidth)
+        frame.scaleWidth = scaleWidth;
+    frame.transformation = fastImage ? Qt::FastTransformation : Qt::SmoothTransformation;
 
-    buffer.close();
-
-    emit newImage(jpegData);
+    queueFrame(frame);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -403,9 +422,6 @@ void Media::upload(const QSharedPointer<FITSView> &view)
 void Media::sendUpdatedFrame(const QSharedPointer<FITSView> &view)
 {
     QString ext = "jpg";
-    QByteArray jpegData;
-    QBuffer buffer(&jpegData);
-    buffer.open(QIODevice::WriteOnly);
 
     const QSharedPointer<FITSData> imageData = view->imageData();
 
@@ -450,23 +466,25 @@ void Media::sendUpdatedFrame(const QSharedPointer<FITSView> &view)
     // First METADATA_PACKET bytes of the binary data is always allocated
     // to the metadata
     // the rest to the image data.
-    QByteArray meta = QJsonDocument(metadata).toJson(QJsonDocument::Compact);
-    meta = meta.leftJustified(METADATA_PACKET, 0);
-    buffer.write(meta);
+    Frame frame;
+    frame.uuid = "+A";
+    frame.metadata = QJsonDocument(metadata).toJson(QJsonDocument::Compact);
 
     // For low bandwidth images
-    QPixmap scaledImage;
     // Align images
     if (correctionVector.isNull() == false)
     {
-        scaledImage = view->getDisplayPixmap();
+        frame.image = view->getDisplayPixmap().toImage();
+        QSize scaledSize = frame.image.size();
         const double currentZoom = view->getCurrentZoom();
         const double normalizedZoom = currentZoom / 100;
         // If zoom level is not 100%, then scale.
-        if (fabs(normalizedZoom - 1) > 0.001)
-            scaledImage = view->getDisplayPixmap().scaledToWidth(view->zoomedWidth());
-        else
-            scaledImage = view->getDisplayPixmap();
+        if (fabs(normalizedZoom - 1) > 0.001 && frame.image.width() > 0)
+        {
+            frame.scaleWidth = view->zoomedWidth();
+            frame.transformation = Qt::SmoothTransformation;
+            scaledSize = QSize(frame.scaleWidth, qRound(frame.image.height() * frame.scaleWidth / double(frame.image.width())));
+        }
         // as we factor in the zoom level, we adjust center and length accordingly
         QPointF center = 0.5 * correctionVector.p1() * normalizedZoom + 0.5 * correctionVector.p2() * normalizedZoom;
         uint32_t length = qMax(correctionVector.length() / normalizedZoom, 100 / normalizedZoom);
@@ -475,23 +493,93 @@ void Media::sendUpdatedFrame(const QSharedPointer<FITSView> &view)
         boundingRectable.setSize(QSize(length * 2, length * 2));
         QPoint topLeft = (center - QPointF(length, length)).toPoint();
         boundingRectable.moveTo(topLeft);
-        boundingRectable = boundingRectable.intersected(scaledImage.rect());
+        boundingRectable = boundingRectable.intersected(QRect(QPoint(0, 0), scaledSize));
 
-        emit newBoundingRect(boundingRectable, scaledImage.size(), currentZoom);
+        emit newBoundingRect(boundingRectable, scaledSize, currentZoom);
 
-        scaledImage = scaledImage.copy(boundingRectable);
+        frame.crop = boundingRectable;
     }
     else
     {
-        scaledImage = view->getDisplayPixmap().width() > HB_IMAGE_WIDTH / 2 ?
-                      view->getDisplayPixmap().scaledToWidth(HB_IMAGE_WIDTH / 2, Qt::FastTransformation) :
-                      view->getDisplayPixmap();
+        frame.image = view->getDisplayImage();
+        if (frame.image.width() > HB_IMAGE_WIDTH / 2)
+            frame.scaleWidth = HB_IMAGE_WIDTH / 2;
         emit newBoundingRect(QRect(), QSize(), 100);
     }
 
-    scaledImage.save(&buffer, ext.toLatin1().constData(), HB_IMAGE_QUALITY);
+    queueFrame(frame);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Media::queueFrame(Frame frame)
+{
+    // Encoding and sending module frames nobody can receive in time only delays the next ones.
+    if (frame.uuid.startsWith("+"))
+    {
+        const bool busy = std::any_of(m_NodeManagers.begin(), m_NodeManagers.end(), [](auto & nodeManager)
+        {
+            return nodeManager->media()->isBusy();
+        });
+        if (busy)
+        {
+            qCDebug(KSTARS_EKOS) << "Media connection is busy, dropping frame" << frame.uuid;
+            return;
+        }
+
+        for (auto &onePendingFrame : m_PendingFrames)
+        {
+            if (onePendingFrame.uuid == frame.uuid)
+            {
+                onePendingFrame = std::move(frame);
+                return;
+            }
+        }
+    }
+
+    m_PendingFrames.append(std::move(frame));
+    if (m_FrameEncoder.isRunning() == false)
+        encodeNextFrame();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Media::encodeNextFrame()
+{
+    if (m_PendingFrames.isEmpty())
+        return;
+
+    m_FrameEncoder.setFuture(Executors::run(Executors::Interactive, &Media::encodeFrame, m_PendingFrames.takeFirst(), m_EncodedSize));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+QByteArray Media::encodeFrame(const Frame &frame, int sizeHint)
+{
+    QByteArray jpegData;
+    // Frames of a view have similar sizes, allocate for a slightly larger one than the last.
+    jpegData.reserve(METADATA_PACKET + sizeHint + sizeHint / 4);
+    QBuffer buffer(&jpegData);
+    buffer.open(QIODevice::WriteOnly);
+
+    // First METADATA_PACKET bytes of the binary data is always allocated
+    // to the metadata
+    // the rest to the image data.
+    buffer.write(frame.metadata.leftJustified(METADATA_PACKET, 0));
+
+    QImage image = frame.scaleWidth > 0 ? frame.image.scaledToWidth(frame.scaleWidth, frame.transformation) : frame.image;
+    if (frame.crop.isNull() == false)
+        image = image.copy(frame.crop);
+
+    QImageWriter writer(&buffer, "jpg");
+    writer.setQuality(HB_IMAGE_QUALITY);
+    writer.write(image);
+
     buffer.close();
-    emit newImage(jpegData);
+    return jpegData;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
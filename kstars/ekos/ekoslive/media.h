@@ -9,6 +9,8 @@
 #pragma once
 
 #include <QtWebSockets/QWebSocket>
+#include <QFutureWatcher>
+#include <QImage>
 #include <memory>
 
 #include "ekos/manager.h"
@@ -71,7 +73,7 @@ class Media : public QObject
         void onDisconnected();        
 
         // Communication
-        void onTextReceived(const QString &message);
+        void onJsonReceived(const QJsonObject &msgObj);
         void onBinaryReceived(const QByteArray &message);
 
         // Metadata and Image upload
@@ -79,7 +81,28 @@ class Media : public QObject
         void uploadImage(const QByteArray &image);
 
     private:
+        // A frame to encode and send, with its metadata
+        struct Frame
+        {
+            QString uuid;
+            QByteArray metadata;
+            QImage image;
+            // Width to scale the image to before cropping, or 0 to keep its size
+            int scaleWidth { 0 };
+            Qt::TransformationMode transformation { Qt::FastTransformation };
+            // Rectangle of the scaled image to send, or null to send it all
+            QRect crop;
+        };
+
         void upload(const QSharedPointer<FITSView> &view);
+        /**
+         * @brief queueFrame Queue a frame to be encoded and sent by the encoder thread. Frames of the
+         * module views, which are only interesting until the next one, replace the pending frame of the same
+         * view, and are dropped while the connection is still busy sending the previous ones.
+         */
+        void queueFrame(Frame frame);
+        void encodeNextFrame();
+        static QByteArray encodeFrame(const Frame &frame, int sizeHint);
 
         Ekos::Manager * m_Manager { nullptr };
         QVector<QSharedPointer<NodeManager>> m_NodeManagers;
@@ -89,6 +112,12 @@ class Media : public QObject
         QLineF correctionVector;
         QSharedPointer<FITSView> m_TemporaryView;
 
+        // Frames waiting for the encoder, which encodes one frame at a time in order
+        QList<Frame> m_PendingFrames;
+        QFutureWatcher<QByteArray> m_FrameEncoder;
+        // Size of the last encoded frame, to allocate the next one at once
+        int m_EncodedSize { 0 };
+
         bool m_sendBlobs { true};
 
         // Image width for high-bandwidth setting
@@ -45,18 +45,19 @@ Message::Message(Ekos::Manager *manager, QVector<QSharedPointer<NodeManager>> &n
     {
         connect(nodeManager->message(), &Node::connected, this, &Message::onConnected);
         connect(nodeManager->message(), &Node::disconnected, this, &Message::onDisconnected);
-        connect(nodeManager->message(), &Node::onTextReceived, this, &Message::onTextReceived);
+        connect(nodeManager->message(), &Node::onJsonReceived, this, &Message::onJsonReceived);
     }
 
     connect(manager, &Ekos::Manager::newModule, this, &Message::sendModuleState);
 
-    m_ThrottleTS = QDateTime::currentDateTime();
-
     m_PendingPropertiesTimer.setInterval(500);
     connect(&m_PendingPropertiesTimer, &QTimer::timeout, this, &Message::sendPendingProperties);
 
     m_DebouncedSend.setInterval(500);
     connect(&m_DebouncedSend, &QTimer::timeout, this, &Message::dispatchDebounceQueue);
+
+    m_StatusTimer.setSingleShot(true);
+    connect(&m_StatusTimer, &QTimer::timeout, this, &Message::dispatchStatuses);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -70,6 +71,9 @@ void Message::onConnected()
 
     qCInfo(KSTARS_EKOS) << "Connected to Message Websocket server at" << node->url().toDisplayString();
 
+    // The new client knows nothing yet, send all status fields again.
+    m_SentStatuses.clear();
+
     m_PendingPropertiesTimer.start();
     sendConnection();
     sendProfiles();
@@ -90,6 +94,9 @@ void Message::onDisconnected()
     if (isConnected() == false)
     {
         m_PendingPropertiesTimer.stop();
+        m_StatusTimer.stop();
+        m_PendingStatuses.clear();
+        m_ThrottledStatuses.clear();
         emit disconnected();
     }
 }
@@ -97,22 +104,12 @@ void Message::onDisconnected()
 ///////////////////////////////////////////////////////////////////////////////////////////
 ///
 ///////////////////////////////////////////////////////////////////////////////////////////
-void Message::onTextReceived(const QString &message)
+void Message::onJsonReceived(const QJsonObject &msgObj)
 {
     auto node = qobject_cast<Node*>(sender());
-    if (!node || message.isEmpty())
-        return;
-
-    qCInfo(KSTARS_EKOS) << "Websocket Message" << message;
-    QJsonParseError error;
-    auto serverMessage = QJsonDocument::fromJson(message.toUtf8(), &error);
-    if (error.error != QJsonParseError::NoError)
-    {
-        qCWarning(KSTARS_EKOS) << "Ekos Live Parsing Error" << error.errorString();
+    if (!node)
         return;
-    }
 
-    const QJsonObject msgObj = serverMessage.object();
     const QString command = msgObj["type"].toString();
     const QJsonObject payload = msgObj["payload"].toObject();
 
@@ -1657,20 +1654,20 @@ void Message::processAstronomyCommands(const QString &command, const QJsonObject
         // Local Midnight
         const KStarsDateTime midnight  = KStarsDateTime(localTime.date(), QTime(0, 0), Qt::LocalTime);
 
-        KSAlmanac almanac(midnight, KStarsData::Instance()->geo());
+        const auto almanac = KSAlmanac::forDay(midnight, KStarsData::Instance()->geo());
 
         QJsonObject response =
         {
-            {"SunRise", almanac.getSunRise()},
-            {"SunSet", almanac.getSunSet()},
-            {"SunMaxAlt", almanac.getSunMaxAlt()},
-            {"SunMinAlt", almanac.getSunMinAlt()},
-            {"MoonRise", almanac.getMoonRise()},
-            {"MoonSet", almanac.getMoonSet()},
-            {"MoonPhase", almanac.getMoonPhase()},
-            {"MoonIllum", almanac.getMoonIllum()},
-            {"Dawn", almanac.getDawnAstronomicalTwilight()},
-            {"Dusk", almanac.getDuskAstronomicalTwilight()},
+            {"SunRise", almanac->getSunRise()},
+            {"SunSet", almanac->getSunSet()},
+            {"SunMaxAlt", almanac->getSunMaxAlt()},
+            {"SunMinAlt", almanac->getSunMinAlt()},
+            {"MoonRise", almanac->getMoonRise()},
+            {"MoonSet", almanac->getMoonSet()},
+            {"MoonPhase", almanac->getMoonPhase()},
+            {"MoonIllum", almanac->getMoonIllum()},
+            {"Dawn", almanac->getDawnAstronomicalTwilight()},
+            {"Dusk", almanac->getDuskAstronomicalTwilight()},
 
         };
 
@@ -2142,9 +2139,9 @@ KStarsDateTime Message::getNextDawn()
     // Local Midnight
     const KStarsDateTime midnight  = KStarsDateTime(localTime.date(), QTime(0, 0), Qt::LocalTime);
     // Almanac
-    KSAlmanac almanac(midnight, KStarsData::Instance()->geo());
+    const auto almanac = KSAlmanac::forDay(midnight, KStarsData::Instance()->geo());
     // Next Dawn
-    KStarsDateTime nextDawn = midnight.addSecs(almanac.getDawnAstronomicalTwilight() * 24.0 * 3600.0);
+    KStarsDateTime nextDawn = midnight.addSecs(almanac->getDawnAstronomicalTwilight() * 24.0 * 3600.0);
     // If dawn is earliar than now, add a day
     if (nextDawn < localTime)
         nextDawn.addDays(1);
@@ -2237,17 +2234,7 @@ void Message::autofocusAborted()
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Message::updateMountStatus(const QJsonObject &status, bool throttle)
 {
-    if (throttle)
-    {
-        QDateTime now = QDateTime::currentDateTime();
-        if (m_ThrottleTS.msecsTo(now) >= THROTTLE_INTERVAL)
-        {
-            m_ThrottleTS = now;
-            sendResponse(commands[NEW_MOUNT_STATE], status);
-        }
-    }
-    else
-        sendResponse(commands[NEW_MOUNT_STATE], status);
+    sendStatus(commands[NEW_MOUNT_STATE], status, throttle);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -2255,7 +2242,7 @@ void Message::updateMountStatus(const QJsonObject &status, bool throttle)
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Message::updateCaptureStatus(const QJsonObject &status)
 {
-    sendResponse(commands[NEW_CAPTURE_STATE], status);
+    sendStatus(commands[NEW_CAPTURE_STATE], status);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -2263,7 +2250,7 @@ void Message::updateCaptureStatus(const QJsonObject &status)
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Message::updateFocusStatus(const QJsonObject &status)
 {
-    sendResponse(commands[NEW_FOCUS_STATE], status);
+    sendStatus(commands[NEW_FOCUS_STATE], status);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -2271,7 +2258,7 @@ void Message::updateFocusStatus(const QJsonObject &status)
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Message::updateGuideStatus(const QJsonObject &status)
 {
-    sendResponse(commands[NEW_GUIDE_STATE], status);
+    sendStatus(commands[NEW_GUIDE_STATE], status);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -2279,7 +2266,7 @@ void Message::updateGuideStatus(const QJsonObject &status)
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Message::updateDomeStatus(const QJsonObject &status)
 {
-    sendResponse(commands[NEW_DOME_STATE], status);
+    sendStatus(commands[NEW_DOME_STATE], status);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -2287,7 +2274,100 @@ void Message::updateDomeStatus(const QJsonObject &status)
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Message::updateCapStatus(const QJsonObject &status)
 {
-    sendResponse(commands[NEW_CAP_STATE], status);
+    sendStatus(commands[NEW_CAP_STATE], status);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Message::sendStatus(const QString &command, const QJsonObject &status, bool throttle)
+{
+    // States are events, and samples are plotted one by one by the clients. Neither may be merged or skipped.
+    static const QStringList eventKeys = {"status", "drift_ra", "drift_de", "hfr"};
+    const bool event = std::any_of(eventKeys.cbegin(), eventKeys.cend(), [&status](const QString & key)
+    {
+        return status.contains(key);
+    });
+
+    if (event)
+    {
+        // Keep the order of the updates, what is pending was received before.
+        if (m_PendingStatuses.contains(command))
+        {
+            sendStatusNow(command, m_PendingStatuses.take(command));
+            m_ThrottledStatuses.remove(command);
+        }
+        sendStatusNow(command, status);
+        return;
+    }
+
+    const QJsonObject &sent = m_SentStatuses[command];
+    const bool wasPending = m_PendingStatuses.contains(command);
+    QJsonObject &pending = m_PendingStatuses[command];
+    for (auto it = status.constBegin(); it != status.constEnd(); ++it)
+    {
+        // A field changed back to the value sent before must still replace the pending one.
+        if (pending.contains(it.key()) || sent.contains(it.key()) == false || sent[it.key()] != it.value())
+            pending.insert(it.key(), it.value());
+    }
+
+    if (pending.isEmpty())
+    {
+        m_PendingStatuses.remove(command);
+        return;
+    }
+
+    if (throttle == false)
+        m_ThrottledStatuses.remove(command);
+    else if (wasPending == false)
+        m_ThrottledStatuses.insert(command);
+
+    if (m_StatusTimer.isActive() == false)
+        m_StatusTimer.start(std::max(STATUS_MIN_INTERVAL, Options::ekosLiveStatusInterval()));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Message::sendStatusNow(const QString &command, const QJsonObject &status)
+{
+    QJsonObject &sent = m_SentStatuses[command];
+    for (auto it = status.constBegin(); it != status.constEnd(); ++it)
+        sent.insert(it.key(), it.value());
+    m_StatusTS[command] = QDateTime::currentDateTime();
+
+    if (Options::ekosLiveBinaryStatus())
+    {
+        for (auto &nodeManager : m_NodeManagers)
+            nodeManager->message()->sendCborResponse(command, status);
+    }
+    else
+        sendResponse(command, status);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Message::dispatchStatuses()
+{
+    const QDateTime now = QDateTime::currentDateTime();
+    for (auto it = m_PendingStatuses.begin(); it != m_PendingStatuses.end();)
+    {
+        // Throttled fields are sent at most once per throttle interval.
+        if (m_ThrottledStatuses.contains(it.key()) && m_StatusTS.value(it.key()).isValid()
+                && m_StatusTS[it.key()].msecsTo(now) < THROTTLE_INTERVAL)
+        {
+            ++it;
+            continue;
+        }
+
+        sendStatusNow(it.key(), it.value());
+        m_ThrottledStatuses.remove(it.key());
+        it = m_PendingStatuses.erase(it);
+    }
+
+    if (m_PendingStatuses.isEmpty() == false)
+        m_StatusTimer.start(std::max(STATUS_MIN_INTERVAL, Options::ekosLiveStatusInterval()));
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
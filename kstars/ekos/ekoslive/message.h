@@ -140,7 +140,7 @@ class Message : public QObject
         void onDisconnected();        
 
         // Communication
-        void onTextReceived(const QString &);
+        void onJsonReceived(const QJsonObject &msgObj);
 
     private:
         // Profiles
@@ -208,6 +208,16 @@ class Message : public QObject
 
         void sendPendingProperties();
 
+        /**
+         * @brief sendStatus Send a module status update on the status channel @p command.
+         * Updates with a new state or a sample for the graphs are sent at once, as they are.
+         * Other fields are only sent when they changed since they were last sent, and are
+         * coalesced until the next status tick, or the next throttle interval if @p throttle is set.
+         */
+        void sendStatus(const QString &command, const QJsonObject &status, bool throttle = false);
+        void sendStatusNow(const QString &command, const QJsonObject &status);
+        void dispatchStatuses();
+
         typedef struct
         {
             int number_integer;
@@ -238,7 +248,14 @@ class Message : public QObject
         QTimer m_DebouncedSend;
         QMap<QString, QVariantMap> m_DebouncedMap;
 
-        QDateTime m_ThrottleTS;
+        // Fields last sent on each status channel
+        QHash<QString, QJsonObject> m_SentStatuses;
+        // Changed fields waiting for the next status tick
+        QMap<QString, QJsonObject> m_PendingStatuses;
+        // Channels with only throttled fields pending, and when they were last sent
+        QSet<QString> m_ThrottledStatuses;
+        QHash<QString, QDateTime> m_StatusTS;
+        QTimer m_StatusTimer;
         CatalogsDB::DBManager m_DSOManager;        
 
         typedef enum
@@ -252,6 +269,8 @@ class Message : public QObject
 
         // Throttle interval
         static const uint16_t THROTTLE_INTERVAL = 1000;
+        // Shortest status tick
+        static const uint32_t STATUS_MIN_INTERVAL = 100;
 };
 
 }
\ No newline at end of file
@@ -15,6 +15,9 @@
 #include <QWebSocket>
 #include <QUrlQuery>
 #include <QTimer>
+#include <QCborMap>
+#include <QElapsedTimer>
+#include <QJsonArray>
 #include <QJsonDocument>
 
 #include <KActionCollection>
@@ -23,10 +26,11 @@
 
 namespace EkosLive
 {
-Node::Node(const QString &name) : m_Name(name)
+Node::Node(const QString &name) : m_WebSocket(QString(), QWebSocketProtocol::VersionLatest, this), m_Name(name)
 {
     connect(&m_WebSocket, &QWebSocket::connected, this, &Node::onConnected);
     connect(&m_WebSocket, &QWebSocket::disconnected, this, &Node::onDisconnected);
+    connect(&m_WebSocket, &QWebSocket::bytesWritten, this, &Node::onBytesWritten);
     connect(&m_WebSocket, static_cast<void(QWebSocket::*)(QAbstractSocket::SocketError)>(&QWebSocket::error), this,
             &Node::onError);
 
@@ -70,8 +74,8 @@ void Node::onConnected()
     m_isConnected = true;
     m_ReconnectTries = 0;
 
-    connect(&m_WebSocket, &QWebSocket::textMessageReceived,  this, &Node::onTextReceived, Qt::UniqueConnection);
-    connect(&m_WebSocket, &QWebSocket::binaryMessageReceived,  this, &Node::onBinaryReceived, Qt::UniqueConnection);
+    connect(&m_WebSocket, &QWebSocket::textMessageReceived,  this, &Node::onTextMessageReceived, Qt::UniqueConnection);
+    connect(&m_WebSocket, &QWebSocket::binaryMessageReceived,  this, &Node::onBinaryMessageReceived, Qt::UniqueConnection);
 
     emit connected();
 }
@@ -80,9 +84,11 @@ void Node::onDisconnected()
 {
     qCInfo(KSTARS_EKOS) << "Disconnected from" << m_Name << "Websocket server at" << m_URL.toDisplayString();
     m_isConnected = false;
+    m_SocketBytes = 0;
+    logStatistics();
 
-    disconnect(&m_WebSocket, &QWebSocket::textMessageReceived,  this, &Node::onTextReceived);
-    disconnect(&m_WebSocket, &QWebSocket::binaryMessageReceived,  this, &Node::onBinaryReceived);
+    disconnect(&m_WebSocket, &QWebSocket::textMessageReceived,  this, &Node::onTextMessageReceived);
+    disconnect(&m_WebSocket, &QWebSocket::binaryMessageReceived,  this, &Node::onBinaryMessageReceived);
 
     emit disconnected();
 }
@@ -105,10 +111,7 @@ void Node::onError(QAbstractSocket::SocketError error)
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Node::sendResponse(const QString &command, const QJsonObject &payload)
 {
-    if (m_isConnected == false)
-        return;
-
-    m_WebSocket.sendTextMessage(QJsonDocument({{"type", command}, {"payload", payload}}).toJson(QJsonDocument::Compact));
+    queueResponse(command, payload);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -116,32 +119,87 @@ void Node::sendResponse(const QString &command, const QJsonObject &payload)
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Node::sendResponse(const QString &command, const QJsonArray &payload)
 {
-    if (m_isConnected == false)
-        return;
-
-    m_WebSocket.sendTextMessage(QJsonDocument({{"type", command}, {"payload", payload}}).toJson(QJsonDocument::Compact));
+    queueResponse(command, payload);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
 ///
 ///////////////////////////////////////////////////////////////////////////////////////////
 void Node::sendResponse(const QString &command, const QString &payload)
+{
+    queueResponse(command, payload);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Node::sendResponse(const QString &command, bool payload)
+{
+    queueResponse(command, payload);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Node::queueResponse(const QString &command, const QJsonValue &payload)
 {
     if (m_isConnected == false)
         return;
 
-    m_WebSocket.sendTextMessage(QJsonDocument({{"type", command}, {"payload", payload}}).toJson(QJsonDocument::Compact));
+    // Payloads are implicitly shared, serializing large ones (scheduler jobs, property dumps...)
+    // is left to the network thread.
+    QMetaObject::invokeMethod(this, [this, command, payload]()
+    {
+        if (m_isConnected == false)
+            return;
+
+        QElapsedTimer timer;
+        timer.start();
+        const QString message = QString::fromUtf8(QJsonDocument(QJsonObject({{"type", command}, {"payload", payload}})).toJson(
+                                    QJsonDocument::Compact));
+        const qint64 elapsed = timer.nsecsElapsed();
+
+        m_WebSocket.sendTextMessage(message);
+        m_SocketBytes = m_WebSocket.bytesToWrite();
+
+        QMutexLocker locker(&m_StatisticsMutex);
+        m_Statistics.sent++;
+        m_Statistics.bytesSent += message.size();
+        m_Statistics.serializeNsecs += elapsed;
+        m_Statistics.serializeMaxNsecs = std::max(m_Statistics.serializeMaxNsecs, elapsed);
+    }, Qt::QueuedConnection);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
 ///
 ///////////////////////////////////////////////////////////////////////////////////////////
-void Node::sendResponse(const QString &command, bool payload)
+void Node::sendCborResponse(const QString &command, const QJsonObject &payload)
 {
     if (m_isConnected == false)
         return;
 
-    m_WebSocket.sendTextMessage(QJsonDocument({{"type", command}, {"payload", payload}}).toJson(QJsonDocument::Compact));
+    QMetaObject::invokeMethod(this, [this, command, payload]()
+    {
+        if (m_isConnected == false)
+            return;
+
+        QElapsedTimer timer;
+        timer.start();
+        QCborMap response;
+        response.insert(QLatin1String("type"), command);
+        response.insert(QLatin1String("payload"), QCborMap::fromJsonObject(payload));
+        const QByteArray message = response.toCborValue().toCbor();
+        const qint64 elapsed = timer.nsecsElapsed();
+
+        m_WebSocket.sendBinaryMessage(message);
+        m_SocketBytes = m_WebSocket.bytesToWrite();
+
+        QMutexLocker locker(&m_StatisticsMutex);
+        m_Statistics.sent++;
+        m_Statistics.bytesSent += message.size();
+        m_Statistics.serializeNsecs += elapsed;
+        m_Statistics.serializeMaxNsecs = std::max(m_Statistics.serializeMaxNsecs, elapsed);
+    }, Qt::QueuedConnection);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -151,7 +209,19 @@ void Node::sendTextMessage(const QString &message)
 {
     if (m_isConnected == false)
         return;
-    m_WebSocket.sendTextMessage(message);
+
+    QMetaObject::invokeMethod(this, [this, message]()
+    {
+        if (m_isConnected == false)
+            return;
+
+        m_WebSocket.sendTextMessage(message);
+        m_SocketBytes = m_WebSocket.bytesToWrite();
+
+        QMutexLocker locker(&m_StatisticsMutex);
+        m_Statistics.sent++;
+        m_Statistics.bytesSent += message.size();
+    }, Qt::QueuedConnection);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -161,7 +231,99 @@ void Node::sendBinaryMessage(const QByteArray &message)
 {
     if (m_isConnected == false)
         return;
-    m_WebSocket.sendBinaryMessage(message);
+
+    // Images are counted as soon as they are queued, so that isBusy() holds back the next ones.
+    m_QueuedBytes += message.size();
+    QMetaObject::invokeMethod(this, [this, message]()
+    {
+        m_QueuedBytes -= message.size();
+        if (m_isConnected == false)
+            return;
+
+        m_WebSocket.sendBinaryMessage(message);
+        m_SocketBytes = m_WebSocket.bytesToWrite();
+
+        QMutexLocker locker(&m_StatisticsMutex);
+        m_Statistics.sent++;
+        m_Statistics.bytesSent += message.size();
+    }, Qt::QueuedConnection);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Node::onTextMessageReceived(const QString &message)
+{
+    if (message.isEmpty())
+        return;
+
+    qCInfo(KSTARS_EKOS) << m_Name << "Websocket Message" << message;
+
+    QElapsedTimer timer;
+    timer.start();
+    QJsonParseError error;
+    auto serverMessage = QJsonDocument::fromJson(message.toUtf8(), &error);
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    {
+        QMutexLocker locker(&m_StatisticsMutex);
+        m_Statistics.received++;
+        m_Statistics.bytesReceived += message.size();
+        m_Statistics.parseNsecs += elapsed;
+        m_Statistics.parseMaxNsecs = std::max(m_Statistics.parseMaxNsecs, elapsed);
+    }
+
+    if (error.error != QJsonParseError::NoError)
+    {
+        qCWarning(KSTARS_EKOS) << "Ekos Live Parsing Error" << error.errorString();
+        return;
+    }
+
+    emit onJsonReceived(serverMessage.object());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Node::onBinaryMessageReceived(const QByteArray &message)
+{
+    {
+        QMutexLocker locker(&m_StatisticsMutex);
+        m_Statistics.received++;
+        m_Statistics.bytesReceived += message.size();
+    }
+
+    emit onBinaryReceived(message);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Node::onBytesWritten(qint64 bytes)
+{
+    m_SocketBytes = m_WebSocket.bytesToWrite();
+    emit bytesWritten(bytes);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+Node::Statistics Node::statistics() const
+{
+    QMutexLocker locker(&m_StatisticsMutex);
+    return m_Statistics;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+void Node::logStatistics()
+{
+    const Statistics stats = statistics();
+    qCInfo(KSTARS_EKOS) << m_Name << "channel:" << stats.sent << "messages sent," << stats.bytesSent << "bytes,"
+                        << "serialization" << stats.serializeNsecs / 1e6 << "ms," << "max" << stats.serializeMaxNsecs / 1e6 << "ms;"
+                        << stats.received << "messages received," << stats.bytesReceived << "bytes,"
+                        << "parsing" << stats.parseNsecs / 1e6 << "ms," << "max" << stats.parseMaxNsecs / 1e6 << "ms";
 }
 
 }
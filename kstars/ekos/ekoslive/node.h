@@ -10,10 +10,20 @@
 
 #include <QtWebSockets/QWebSocket>
 #include <QJsonObject>
+#include <QMutex>
+#include <atomic>
 #include <memory>
 
 namespace EkosLive
 {
+/**
+ * @class Node
+ * @short A websocket channel to an EkosLive server.
+ *
+ * Nodes live in the network thread of their NodeManager. The send functions may be called from any thread:
+ * messages are queued to the network thread, where they are serialized and written in order. Received text
+ * messages are parsed in the network thread too, and handed to the modules already parsed.
+ */
 class Node : public QObject
 {
     Q_PROPERTY(QString name MEMBER m_Name)
@@ -21,6 +31,19 @@ class Node : public QObject
     Q_OBJECT
 
     public:
+        struct Statistics
+        {
+            quint64 sent { 0 };
+            quint64 received { 0 };
+            quint64 bytesSent { 0 };
+            quint64 bytesReceived { 0 };
+            // Time spent serializing sent messages and parsing received ones
+            qint64 serializeNsecs { 0 };
+            qint64 serializeMaxNsecs { 0 };
+            qint64 parseNsecs { 0 };
+            qint64 parseMaxNsecs { 0 };
+        };
+
         explicit Node(const QString &name);
         virtual ~Node() = default;
 
@@ -29,10 +52,19 @@ class Node : public QObject
         void sendResponse(const QString &command, const QJsonArray &payload);
         void sendResponse(const QString &command, const QString &payload);
         void sendResponse(const QString &command, bool payload);
+        /** @short Send a response as a binary CBOR message, for clients that enabled them */
+        void sendCborResponse(const QString &command, const QJsonObject &payload);
 
         void sendTextMessage(const QString &message);
         void sendBinaryMessage(const QByteArray &message);
         bool isConnected() const {return m_isConnected;}        
+        /** @return true while the messages already sent are still waiting for the network */
+        bool isBusy() const
+        {
+            return m_isConnected && m_QueuedBytes + m_SocketBytes > MAX_PENDING_BYTES;
+        }
+
+        Statistics statistics() const;
 
         void setAuthResponse(const QJsonObject &response)
         {
@@ -42,8 +74,9 @@ class Node : public QObject
     signals:
         void connected();
         void disconnected();
-        void onTextReceived(const QString &message);
+        void onJsonReceived(const QJsonObject &message);
         void onBinaryReceived(const QByteArray &message);
+        void bytesWritten(qint64 bytes);
 
     public slots:
         void connectServer();
@@ -55,7 +88,16 @@ class Node : public QObject
         void onDisconnected();
         void onError(QAbstractSocket::SocketError error);
 
+        // Communication, in the network thread
+        void onTextMessageReceived(const QString &message);
+        void onBinaryMessageReceived(const QByteArray &message);
+        void onBytesWritten(qint64 bytes);
+
    private:
+        void queueResponse(const QString &command, const QJsonValue &payload);
+        void logStatistics();
+
+        // Child of the node, so that it moves to the network thread with it
         QWebSocket m_WebSocket;
         QJsonObject m_AuthResponse;
         uint16_t m_ReconnectTries {0};
@@ -63,9 +105,16 @@ class Node : public QObject
         QString m_Name;
         QString m_Path;
 
-        bool m_isConnected { false };
+        std::atomic<bool> m_isConnected { false };
         bool m_sendBlobs { true};
 
+        // Binary messages queued to the network thread, and bytes the socket has yet to write
+        std::atomic<qint64> m_QueuedBytes { 0 };
+        std::atomic<qint64> m_SocketBytes { 0 };
+
+        mutable QMutex m_StatisticsMutex;
+        Statistics m_Statistics;
+
         QMap<int, bool> m_Options;        
 
         // Retry every 5 seconds in case remote server is down
@@ -74,5 +123,7 @@ class Node : public QObject
         static const uint16_t RECONNECT_MAX_TRIES = 720;
         // Throttle interval
         static const uint16_t THROTTLE_INTERVAL = 1000;
+        // Connection is busy beyond this many bytes waiting to be written
+        static const qint64 MAX_PENDING_BYTES = 1024 * 1024;
 };
 }
@@ -39,11 +39,26 @@ NodeManager::NodeManager(uint32_t mask)
     if (mask & Cloud)
         m_Nodes[Cloud] = new Node("cloud");
 
+    // Websocket I/O and the (de)serialization of messages are done in the network thread,
+    // so that large payloads do not stall the user interface.
+    m_NetworkThread.setObjectName("EkosLive Network");
     for (auto &node : m_Nodes)
     {
         connect(node, &Node::connected, this, &NodeManager::setConnected);
         connect(node, &Node::disconnected, this, &NodeManager::setDisconnected);
+        node->moveToThread(&m_NetworkThread);
+        connect(&m_NetworkThread, &QThread::finished, node, &QObject::deleteLater);
     }
+    m_NetworkThread.start();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+///
+///////////////////////////////////////////////////////////////////////////////////////////
+NodeManager::~NodeManager()
+{
+    m_NetworkThread.quit();
+    m_NetworkThread.wait();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -107,7 +122,7 @@ void NodeManager::setDisconnected()
 void NodeManager::disconnectNodes()
 {
     for (auto &node : m_Nodes)
-        node->disconnectServer();
+        QMetaObject::invokeMethod(node, &Node::disconnectServer, Qt::QueuedConnection);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -187,7 +202,7 @@ void NodeManager::onResult(QNetworkReply *reply)
     for (auto &node : m_Nodes)
     {
         node->setAuthResponse(m_AuthResponse);
-        node->connectServer();
+        QMetaObject::invokeMethod(node, &Node::connectServer, Qt::QueuedConnection);
     }
 
     reply->deleteLater();
@@ -13,6 +13,7 @@
 #include <QNetworkAccessManager>
 #include <QPointer>
 #include <QNetworkReply>
+#include <QThread>
 #include <memory>
 
 #include "node.h"
@@ -27,7 +28,7 @@ class NodeManager : public QObject
 
     public:
         explicit NodeManager(uint32_t mask);
-        virtual ~NodeManager() = default;
+        virtual ~NodeManager();
 
         bool isConnected() const;
 
@@ -72,6 +73,8 @@ class NodeManager : public QObject
 
         QPointer<QNetworkAccessManager> m_NetworkManager;
         QMap<Channels, Node*> m_Nodes;
+        // Thread of the nodes
+        QThread m_NetworkThread;
 
         // Retry every 5 seconds in case remote server is down
         static const uint16_t RECONNECT_INTERVAL = 5000;
@@ -601,164 +601,49 @@ void AberrationInspector::analyseResults()
 // and for which the user hasn't elected to exclude
 bool AberrationInspector::calcBackfocusDelta(TileSelection tileSelection, double &backfocusDelta)
 {
-    backfocusDelta = 0.0;
-
-    // Firstly check that we have a valid central tile - we can't do anything without that
-    if (!m_fit[TILE_CM] || m_excludeTile[TILE_CM])
-        return false;
-
-    double dist = 0.0, sum = 0.0, counter = 0.0;
-
-    switch(tileSelection)
+    QVector<double> minimums(NUM_TILES), distances(NUM_TILES);
+    QVector<bool> valid(NUM_TILES);
+    for (int tile = 0; tile < NUM_TILES; tile++)
     {
-        case TileSelection::TILES_ALL:
-            // Use all useable tiles weighted by their distance from the centre
-            for (int i = 0; i < NUM_TILES; i++)
-            {
-                if (i == TILE_CM)
-                    continue;
-
-                if (m_fit[i] && !m_excludeTile[i])
-                {
-                    dist = getXYTileCentre(static_cast<tileID>(i)).length();
-                    sum += m_minimum[i] * dist;
-                    counter += dist;
-                }
-            }
-            if (counter == 0)
-                // No valid tiles so can't complete the calc
-                return false;
-            break;
-
-        case TileSelection::TILES_OUTER_CORNERS:
-            // All tiles are diagonal from centre... so no need to weight the calc
-            // Use tiles 0, 2, 6, 8
-            if (m_fit[0] && !m_excludeTile[0])
-            {
-                sum += m_minimum[0];
-                counter++;
-            }
-            if (m_fit[2] && !m_excludeTile[2])
-            {
-                sum += m_minimum[2];
-                counter++;
-            }
-            if (m_fit[6] && !m_excludeTile[6])
-            {
-                sum += m_minimum[6];
-                counter++;
-            }
-            if (m_fit[8] && !m_excludeTile[8])
-            {
-                sum += m_minimum[8];
-                counter++;
-            }
-
-            if (counter == 0)
-                // No valid tiles so can't complete the calc
-                return false;
-            break;
-
-        case TileSelection::TILES_INNER_DIAMOND:
-            // Tiles are different distances from centre... so need to weight the calc
-            // Use tiles 1, 3, 5, 7
-            if (m_fit[TILE_TM] && !m_excludeTile[TILE_TM])
-            {
-                dist = getXYTileCentre(TILE_TM).length();
-                sum += m_minimum[TILE_TM] * dist;
-                counter += dist;
-            }
-            if (m_fit[TILE_CL] && !m_excludeTile[TILE_CL])
-            {
-                dist = getXYTileCentre(TILE_CL).length();
-                sum += m_minimum[TILE_CL] * dist;
-                counter += dist;
-            }
-            if (m_fit[TILE_CR] && !m_excludeTile[TILE_CR])
-            {
-                dist = getXYTileCentre(TILE_CR).length();
-                sum += m_minimum[TILE_CR] * dist;
-                counter += dist;
-            }
-            if (m_fit[TILE_BM] && !m_excludeTile[TILE_BM])
-            {
-                dist = getXYTileCentre(TILE_BM).length();
-                sum += m_minimum[TILE_BM] * dist;
-                counter += dist;
-            }
-
-            if (counter == 0)
-                // No valid tiles so can't complete the calc
-                return false;
-            break;
-
-        default:
-            qCDebug(KSTARS_EKOS_FOCUS) << QString("%1 called with invalid tile selection %2").arg(__FUNCTION__).arg(tileSelection);
-            return false;
-            break;
+        minimums[tile] = m_minimum[tile];
+        valid[tile] = m_fit[tile] && !m_excludeTile[tile];
+        distances[tile] = getXYTileCentre(static_cast<tileID>(tile)).length();
     }
-    backfocusDelta = (m_minimum[TILE_CM] - (sum / counter)) * m_data.focuserStepMicrons;
-    return true;
+
+    return SensorTileMap::calcBackfocusDelta(MOSAIC_COLUMNS, MOSAIC_ROWS, minimums, valid, distances,
+            static_cast<SensorTileMap::TileSelection>(tileSelection), m_data.focuserStepMicrons, backfocusDelta);
 }
 
+// Calculate the tilt in microns from the deltas of the tiles to the centre tile. Only tiles for
+// which curve fitting worked, that are used by the tile selection and not excluded by the user count.
 bool AberrationInspector::calcTilt()
 {
-    // Firstly check that we have a valid central tile - we can't do anything without that
-    if (!m_fit[TILE_CM] || m_excludeTile[TILE_CM])
-        return false;
-
-    // Calculate the deltas relative to the centre tile in microns
-    m_deltas.clear();
+    QVector<double> minimums(NUM_TILES);
+    QVector<bool> valid(NUM_TILES);
     for (int tile = 0; tile < NUM_TILES; tile++)
-        m_deltas.append((m_minimum[TILE_CM] - m_minimum[tile]) * m_data.focuserStepMicrons);
-
-    // Calculate the average tile position for left, right, top and bottom. If any of these cannot be
-    // calculated then fail the whole calculation.
-    double avLeft, avRight, avTop, avBottom;
-    int tilesL[3] = { 0, 3, 6 };
-    if (!avTiles(tilesL, avLeft))
-        return false;
-    int tilesR[3] = { 2, 5, 8 };
-    if (!avTiles(tilesR, avRight))
-        return false;
-    int tilesT[3] = { 0, 1, 2 };
-    if (!avTiles(tilesT, avTop))
-        return false;
-    int tilesB[3] = { 6, 7, 8 };
-    if(!avTiles(tilesB, avBottom))
-        return false;
-
-    m_LRMicrons = avLeft - avRight;
-    m_TBMicrons = avTop - avBottom;
-    m_diagonalMicrons = std::hypot(m_LRMicrons, m_TBMicrons);
+    {
+        minimums[tile] = m_minimum[tile];
+        valid[tile] = m_useTile[tile] && m_fit[tile] && !m_excludeTile[tile];
+    }
 
     // Calculate the sensor spans in microns
     const double LRSpan = (m_data.sensorWidth - m_data.tileWidth) * m_data.pixelSize;
     const double TBSpan = (m_data.sensorHeight - m_data.tileWidth) * m_data.pixelSize;
 
-    // Calculate the tilt as a % slope
-    m_LRTilt = m_LRMicrons / LRSpan * 100.0;
-    m_TBTilt = m_TBMicrons / TBSpan * 100.0;
-    m_diagonalTilt = std::hypot(m_LRTilt, m_TBTilt);
-    return true;
-}
+    SensorTileMap::Tilt tilt;
+    const bool tiltOK = SensorTileMap::calcTilt(MOSAIC_COLUMNS, MOSAIC_ROWS, minimums, valid, m_data.focuserStepMicrons,
+                        LRSpan, TBSpan, tilt);
+    m_deltas = tilt.deltas;
+    if (!tiltOK)
+        return false;
 
-// Averages upto 3 passed in tile values.
-bool AberrationInspector::avTiles(int tiles[3], double &average)
-{
-    double sum = 0.0;
-    int counter = 0;
-    for (int i = 0; i < 3; i++)
-    {
-        if (m_useTile[tiles[i]] && m_fit[tiles[i]] && !m_excludeTile[tiles[i]])
-        {
-            sum += m_deltas[tiles[i]];
-            counter++;
-        }
-    }
-    if (counter > 0)
-        average = sum / counter;
-    return (counter > 0);
+    m_LRMicrons = tilt.LR;
+    m_TBMicrons = tilt.TB;
+    m_diagonalMicrons = tilt.diagonal;
+    m_LRTilt = tilt.LRPercent;
+    m_TBTilt = tilt.TBPercent;
+    m_diagonalTilt = tilt.diagonalPercent;
+    return true;
 }
 
 // Initialise the 3D graphic
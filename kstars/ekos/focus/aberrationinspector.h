@@ -12,6 +12,7 @@
 #include "curvefit.h"
 #include "ui_aberrationinspector.h"
 #include "aberrationinspectorutils.h"
+#include "sensortilemap.h"
 
 // The AberrationInspector class manages the Aberration Inspector dialog.
 // Settings are managed in a global way, rather than per Optical Train which would be overkill. The approach is the same as Focus
@@ -254,14 +255,6 @@ class AberrationInspector : public QDialog, public Ui::aberrationInspectorDialog
          */
         bool calcTilt();
 
-        /**
-         * @brief calculates average of 3 tile values
-         * @param tiles to average
-         * @param retured tile average
-         * @return success = true
-         */
-        bool avTiles(int tiles[3], double &average);
-
         /**
          * @brief set exclude tiles vector
          * @param row
@@ -29,6 +29,10 @@ typedef enum
     NUM_TILES
 } tileID;
 
+// The tiles form a 3x3 grid
+constexpr int MOSAIC_COLUMNS { 3 };
+constexpr int MOSAIC_ROWS { 3 };
+
 // Tile names and colours
 static const QString TILE_NAME[NUM_TILES] = {"TL", "T", "TR", "L", "C", "R", "BL", "B", "BR"};
 static const QString TILE_LONGNAME[NUM_TILES] = {"Top Left", "Top", "Top Right", "Left", "Centre", "Right", "Bottom Left", "Bottom", "Bottom Right"};
@@ -5,6 +5,7 @@
 */
 
 #include "adaptivefocus.h"
+#include "focusmodelstore.h"
 #include <kstars_debug.h>
 #include "kstars.h"
 #include "Options.h"
@@ -440,4 +441,120 @@ int AdaptiveFocus::adaptStartPosition(int currentPosition, QString &AFfilter)
     }
 }
 
+int AdaptiveFocus::modelStartPosition(int position, const QString &AFfilter)
+{
+    m_focus->m_ModelOutSteps = -1;
+    m_focus->m_ModelNumSteps = -1;
+
+    if (!Options::focusModelStart() || m_focus->m_FocusAlgorithm != Focus::FOCUS_LINEAR1PASS || !m_focus->canAbsMove)
+        return position;
+
+    const QString train = m_focus->opticalTrainCombo->currentText();
+    const double temperature = m_focus->currentTemperatureSourceElement ? m_focus->currentTemperatureSourceElement->value :
+                               INVALID_VALUE;
+    double ticksPerTemp = 0.0, ticksPerAlt = 0.0;
+    if (m_focus->m_FilterManager)
+    {
+        ticksPerTemp = m_focus->m_FilterManager->getFilterTicksPerTemp(AFfilter);
+        ticksPerAlt = m_focus->m_FilterManager->getFilterTicksPerAlt(AFfilter);
+    }
+
+    const FocusModelStore store;
+    const FocusModelStore::Prediction prediction = store.predict(train, AFfilter, temperature, m_focus->mountAlt,
+            ticksPerTemp, ticksPerAlt);
+    if (!prediction.valid)
+        return position;
+
+    // The same checks as for the adapted start position
+    const int currentPosition = m_focus->currentPosition;
+    const int minTravelLimit = qMax(0.0, currentPosition - m_focus->m_OpsFocusMechanics->focusMaxTravel->value());
+    const int maxTravelLimit = qMin(m_focus->absMotionMax, currentPosition + m_focus->m_OpsFocusMechanics->focusMaxTravel->value());
+    if (prediction.position < minTravelLimit || prediction.position > maxTravelLimit ||
+            abs(prediction.position - currentPosition) > m_focus->m_OpsFocusSettings->focusAdaptiveMaxMove->value())
+    {
+        m_focus->appendLogText(i18n("Focus model start point %1 is too far from %2, ignoring", prediction.position,
+                                    currentPosition));
+        return position;
+    }
+
+    const int stepSize = m_focus->m_OpsFocusMechanics->focusTicks->value();
+    double outSteps;
+    int numSteps;
+    if (FocusModelStore::narrowSteps(prediction, stepSize, m_focus->m_OpsFocusMechanics->focusOutSteps->value(),
+                                     m_focus->m_OpsFocusMechanics->focusNumSteps->value(), outSteps, numSteps))
+    {
+        m_focus->m_ModelOutSteps = outSteps;
+        m_focus->m_ModelNumSteps = numSteps;
+    }
+
+    m_focus->appendLogText(i18n("Focus model start point [%1] %2 from %3 runs", AFfilter, prediction.position,
+                                prediction.runs));
+    qCDebug(KSTARS_EKOS_FOCUS) << "Focus model start point: " << train << AFfilter
+                               << " start position: " << position
+                               << " predicted: " << prediction.position
+                               << " runs: " << prediction.runs
+                               << " ticks/°C: " << prediction.ticksPerTemp << (prediction.fittedTicksPerTemp ? "fitted" : "filter")
+                               << " residual: " << prediction.residual
+                               << " half width: " << prediction.halfWidth
+                               << " out steps: " << m_focus->m_ModelOutSteps
+                               << " steps: " << m_focus->m_ModelNumSteps;
+    return prediction.position;
+}
+
+void AdaptiveFocus::storeFocusModel(const int position)
+{
+    if (m_focus->m_FocusAlgorithm != Focus::FOCUS_LINEAR1PASS || !m_focus->canAbsMove || !m_focus->linearFocuser
+            || !m_focus->curveFitting)
+        return;
+
+    // Only keep runs with a good curve
+    const CurveFitting::CurveFit curveFit = m_focus->m_CurveFit;
+    if (curveFit != CurveFitting::FOCUS_QUADRATIC && m_focus->R2 < m_focus->m_OpsFocusProcess->focusR2Limit->value())
+        return;
+
+    const double solution = m_focus->linearFocuser->solution();
+    const double value = m_focus->linearFocuser->solutionValue();
+    if (solution <= 0 || value <= 0)
+        return;
+
+    FocusModelStore::Run run;
+    run.train = m_focus->opticalTrainCombo->currentText();
+    run.filter = m_focus->m_AFfilter;
+    run.position = position;
+    run.temperature = m_focus->m_LastSourceAutofocusTemperature;
+    run.altitude = m_focus->m_LastSourceAutofocusAlt;
+    run.stepSize = m_focus->linearFocuser->getParams().initialStepSize;
+    run.value = value;
+    run.cfz = m_focus->m_cfzSteps;
+    run.curveFit = static_cast<int>(curveFit);
+    m_focus->curveFitting->getCurveParams(curveFit, run.coefficients);
+    run.time = QDateTime::currentSecsSinceEpoch();
+
+    // How far either side of the solution the curve gets 1.5 times as bad
+    const bool minimise = m_focus->m_OptDir == CurveFitting::OPTIMISATION_MINIMISE;
+    const double limit = minimise ? value * 1.5 : value / 1.5;
+    const double increment = std::max(1.0, run.stepSize / 4.0);
+    const double maxDistance = 2.0 * m_focus->linearFocuser->getParams().numSteps * run.stepSize;
+    double widths = 0.0;
+    int sides = 0;
+    for (const int side : { -1, 1 })
+    {
+        for (double distance = increment; distance <= maxDistance; distance += increment)
+        {
+            const double curveValue = m_focus->curveFitting->f(solution + side * distance);
+            if (minimise ? curveValue >= limit : curveValue <= limit)
+            {
+                widths += distance;
+                sides++;
+                break;
+            }
+        }
+    }
+    run.halfWidth = (sides > 0) ? widths / sides : 0.0;
+
+    FocusModelStore store;
+    store.add(run);
+    store.save();
+}
+
 }
@@ -130,6 +130,20 @@ class AdaptiveFocus
          */
         int adaptStartPosition(int position, QString &AFfilter);
 
+        /**
+         * @brief start position and steps of an autofocus run predicted from the stored runs of the train and filter
+         * @param position is the start position so far, e.g. from adaptStartPosition
+         * @param AFfilter is the filter to run autofocus on
+         * @return predicted start position, or position if there is no usable prediction
+         */
+        int modelStartPosition(int position, const QString &AFfilter);
+
+        /**
+         * @brief store the result of a successful Linear 1 Pass run for later predictions
+         * @param position is the focuser position at the end of the run
+         */
+        void storeFocusModel(const int position);
+
     private:
 
         /**
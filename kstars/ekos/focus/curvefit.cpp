@@ -2,6 +2,8 @@
 #include "ekos/ekos.h"
 #include <ekos_focus_debug.h>
 
+#include <QMutex>
+
 // Constants used to identify the number of parameters used for different curve types
 constexpr int NUM_HYPERBOLA_PARAMS = 4;
 constexpr int NUM_PARABOLA_PARAMS = 3;
@@ -20,6 +22,39 @@ constexpr int MAX_ITERATIONS_PLANE = 5000;
 constexpr double INEPSXTOL = 1e-5;
 const double INEPSGTOL = pow(GSL_DBL_EPSILON, 1.0 / 3.0);
 constexpr double INEPSFTOL = 1e-5;
+// Number of solver workspaces kept, enough for the box sizes of the stars of a frame
+constexpr int MAX_WORKSPACES = 16;
+
+namespace
+{
+// The GSL error handler aborts the program on error, it is turned off while solving. The handler is global,
+// so when stars are fitted in several threads, the first solver turns it off and the last one restores it.
+class GSLErrorHandlerOff
+{
+    public:
+        GSLErrorHandlerOff()
+        {
+            QMutexLocker lock(&s_Mutex);
+            if (s_Count++ == 0)
+                s_OldHandler = gsl_set_error_handler_off();
+        }
+        ~GSLErrorHandlerOff()
+        {
+            QMutexLocker lock(&s_Mutex);
+            if (--s_Count == 0)
+                gsl_set_error_handler(s_OldHandler);
+        }
+
+    private:
+        static QMutex s_Mutex;
+        static int s_Count;
+        static gsl_error_handler_t *s_OldHandler;
+};
+
+QMutex GSLErrorHandlerOff::s_Mutex;
+int GSLErrorHandlerOff::s_Count = 0;
+gsl_error_handler_t *GSLErrorHandlerOff::s_OldHandler = nullptr;
+}
 
 // The functions here fit a number of different curves to the incoming data points using the Lehvensberg-Marquart
 // solver with geodesic acceleration as provided the Gnu Science Library (GSL). The following sources of information are useful:
@@ -766,6 +801,70 @@ CurveFitting::CurveFitting(const QString &serialized)
     recreateFromQString(serialized);
 }
 
+CurveFitting::~CurveFitting()
+{
+    freeWorkspaces();
+}
+
+void CurveFitting::freeWorkspaces()
+{
+    for (auto w : m_NlinearWorkspaces)
+        gsl_multifit_nlinear_free(w);
+    m_NlinearWorkspaces.clear();
+    for (auto w : m_LinearWorkspaces)
+        gsl_multifit_linear_free(w);
+    m_LinearWorkspaces.clear();
+}
+
+gsl_multifit_nlinear_workspace *CurveFitting::nlinearWorkspace(size_t n, size_t p)
+{
+    const auto key = qMakePair(n, p);
+    auto w = m_NlinearWorkspaces.value(key, nullptr);
+    if (w != nullptr)
+        return w;
+
+    if (m_NlinearWorkspaces.size() >= MAX_WORKSPACES)
+    {
+        for (auto old : m_NlinearWorkspaces)
+            gsl_multifit_nlinear_free(old);
+        m_NlinearWorkspaces.clear();
+    }
+
+    // The workspace keeps the solver parameters it is allocated with
+    gsl_multifit_nlinear_parameters params = gsl_multifit_nlinear_default_parameters();
+    w = gsl_multifit_nlinear_alloc(gsl_multifit_nlinear_trust, &params, n, p);
+    if (w != nullptr)
+        m_NlinearWorkspaces.insert(key, w);
+    else
+        qCDebug(KSTARS_EKOS_FOCUS) << QString("CurveFitting: Could not allocate a workspace for %1 datapoints").arg(n);
+    return w;
+}
+
+gsl_multifit_linear_workspace *CurveFitting::linearWorkspace(size_t n, size_t p)
+{
+    const auto key = qMakePair(n, p);
+    auto w = m_LinearWorkspaces.value(key, nullptr);
+    if (w != nullptr)
+        return w;
+
+    if (m_LinearWorkspaces.size() >= MAX_WORKSPACES)
+    {
+        for (auto old : m_LinearWorkspaces)
+            gsl_multifit_linear_free(old);
+        m_LinearWorkspaces.clear();
+    }
+
+    w = gsl_multifit_linear_alloc(n, p);
+    if (w != nullptr)
+        m_LinearWorkspaces.insert(key, w);
+    return w;
+}
+
+bool CurveFitting::canWarmStart(CurveFit curveFit, int numParams) const
+{
+    return !m_FirstSolverRun && !m_WarmStartFailed && m_LastCurveType == curveFit && m_LastCoefficients.size() == numParams;
+}
+
 void CurveFitting::fitCurve(const FittingGoal goal, const QVector<int> &x_, const QVector<double> &y_,
                             const QVector<double> &weight_, const QVector<bool> &outliers_,
                             const CurveFit curveFit, const bool useWeights, const OptimisationDirection optDir)
@@ -788,6 +887,7 @@ void CurveFitting::fitCurve(const FittingGoal goal, const QVector<int> &x_, cons
 
     m_useWeights = useWeights;
     m_CurveType = curveFit;
+    m_WarmStartFailed = false;
 
     switch (m_CurveType)
     {
@@ -806,9 +906,13 @@ void CurveFitting::fitCurve(const FittingGoal goal, const QVector<int> &x_, cons
             m_FirstSolverRun = true;
             return;
     }
-    m_LastCoefficients = m_coefficients;
-    m_LastCurveType    = m_CurveType;
-    m_FirstSolverRun   = false;
+    // A failed fit keeps the solution of the last good fit for the next guess
+    if (!m_coefficients.empty())
+    {
+        m_LastCoefficients = m_coefficients;
+        m_LastCurveType    = m_CurveType;
+        m_FirstSolverRun   = false;
+    }
 }
 
 void CurveFitting::fitCurve3D(const DataPoint3DT data, const CurveFit curveFit)
@@ -910,15 +1014,14 @@ QVector<double> CurveFitting::polynomial_fit(const double *const data_x, const d
     // Must turn off error handler or it aborts on error
     gsl_set_error_handler_off();
 
-    gsl_multifit_linear_workspace *work = gsl_multifit_linear_alloc(n, order + 1);
-    status                              = gsl_multifit_linear(X, y, c, cov, &chisq, work);
+    // The workspace is kept for the next fit
+    gsl_multifit_linear_workspace *work = linearWorkspace(n, order + 1);
+    status                              = work ? gsl_multifit_linear(X, y, c, cov, &chisq, work) : GSL_ENOMEM;
 
     if (status != GSL_SUCCESS)
         qDebug() << Q_FUNC_INFO << "GSL multifit error:" << gsl_strerror(status);
     else
     {
-        gsl_multifit_linear_free(work);
-
         for (int i = 0; i < order + 1; i++)
         {
             vc.push_back(gsl_vector_get(c, i));
@@ -946,14 +1049,15 @@ QVector<double> CurveFitting::hyperbola_fit(FittingGoal goal, const QVector<doub
         if (!outliers[i])
             dataPoints.push_back(data_x[i], data_y[i], data_weights[i]);
 
-    auto weights = gsl_vector_alloc(dataPoints.dps.size());
     // Set the gsl error handler off as it aborts the program on error.
-    auto const oldErrorHandler = gsl_set_error_handler_off();
+    GSLErrorHandlerOff errorHandlerOff;
 
     // Setup variables to be used by the solver
     gsl_multifit_nlinear_parameters params = gsl_multifit_nlinear_default_parameters();
-    gsl_multifit_nlinear_workspace *w = gsl_multifit_nlinear_alloc(gsl_multifit_nlinear_trust, &params, dataPoints.dps.size(),
-                                        NUM_HYPERBOLA_PARAMS);
+    gsl_multifit_nlinear_workspace *w = nlinearWorkspace(dataPoints.dps.size(), NUM_HYPERBOLA_PARAMS);
+    if (w == nullptr)
+        return vc;
+    auto weights = gsl_vector_alloc(dataPoints.dps.size());
     gsl_multifit_nlinear_fdf fdf;
     gsl_vector *guess = gsl_vector_alloc(NUM_HYPERBOLA_PARAMS);
     int numIters;
@@ -1004,6 +1108,7 @@ QVector<double> CurveFitting::hyperbola_fit(FittingGoal goal, const QVector<doub
     // a situation where the solver gets "stuck" failing on first step repeatedly.
     for (int attempt = 0; attempt < 5; attempt++)
     {
+        const bool warmStart = canWarmStart(FOCUS_HYPERBOLA, NUM_HYPERBOLA_PARAMS);
         // Make initial guesses
         hypMakeGuess(attempt, dataPoints, guess);
 
@@ -1043,6 +1148,13 @@ QVector<double> CurveFitting::hyperbola_fit(FittingGoal goal, const QVector<doub
                 // So, perturb the initial conditions and have another go.
                 retry = true;
 
+            if (!retry && warmStart)
+            {
+                // The solution of the previous fit didn't lead to one, so have another go from the datapoints
+                m_WarmStartFailed = true;
+                retry = true;
+            }
+
             qCDebug(KSTARS_EKOS_FOCUS) <<
                                        QString("LM solver (Hyperbola): Failed after %1ms iters=%2 [attempt=%3] with status=%4 [%5] and info=%6 [%7], retry=%8")
                                        .arg(timer.elapsed()).arg(gsl_multifit_nlinear_niter(w)).arg(attempt + 1).arg(status).arg(gsl_strerror(status))
@@ -1065,14 +1177,10 @@ QVector<double> CurveFitting::hyperbola_fit(FittingGoal goal, const QVector<doub
         }
     }
 
-    // Free GSL memory
-    gsl_multifit_nlinear_free(w);
+    // Free GSL memory, the workspace is kept for the next fit
     gsl_vector_free(guess);
     gsl_vector_free(weights);
 
-    // Restore old GSL error handler
-    gsl_set_error_handler(oldErrorHandler);
-
     return vc;
 }
 
@@ -1159,7 +1267,7 @@ void CurveFitting::hypMakeGuess(const int attempt, const DataPointT &dataPoints,
     // will be nudged to find a solution this time
     double perturbation = 1.0 + pow(-1, attempt) * (attempt * 0.1);
 
-    if (!m_FirstSolverRun && (m_LastCurveType == FOCUS_HYPERBOLA) && (m_LastCoefficients.size() == NUM_HYPERBOLA_PARAMS))
+    if (canWarmStart(FOCUS_HYPERBOLA, NUM_HYPERBOLA_PARAMS))
     {
         // Last run of the solver was a Hyperbola and the solution was good, so use that solution
         gsl_vector_set(guess, A_IDX, m_LastCoefficients[A_IDX] * perturbation);
@@ -1262,14 +1370,15 @@ QVector<double> CurveFitting::parabola_fit(FittingGoal goal, const QVector<doubl
         if (!outliers[i])
             dataPoints.push_back(data_x[i], data_y[i], data_weights[i]);
 
-    auto weights = gsl_vector_alloc(dataPoints.dps.size());
     // Set the gsl error handler off as it aborts the program on error.
-    auto const oldErrorHandler = gsl_set_error_handler_off();
+    GSLErrorHandlerOff errorHandlerOff;
 
     // Setup variables to be used by the solver
     gsl_multifit_nlinear_parameters params = gsl_multifit_nlinear_default_parameters();
-    gsl_multifit_nlinear_workspace* w = gsl_multifit_nlinear_alloc (gsl_multifit_nlinear_trust, &params, dataPoints.dps.size(),
-                                        NUM_PARABOLA_PARAMS);
+    gsl_multifit_nlinear_workspace* w = nlinearWorkspace(dataPoints.dps.size(), NUM_PARABOLA_PARAMS);
+    if (w == nullptr)
+        return vc;
+    auto weights = gsl_vector_alloc(dataPoints.dps.size());
     gsl_multifit_nlinear_fdf fdf;
     gsl_vector * guess = gsl_vector_alloc(NUM_PARABOLA_PARAMS);
     int numIters;
@@ -1318,6 +1427,7 @@ QVector<double> CurveFitting::parabola_fit(FittingGoal goal, const QVector<doubl
     // a situation where the solver gets "stuck" failing on first step repeatedly.
     for (int attempt = 0; attempt < 5; attempt++)
     {
+        const bool warmStart = canWarmStart(FOCUS_PARABOLA, NUM_PARABOLA_PARAMS);
         // Make initial guesses - here we just set all parameters to 1.0
         parMakeGuess(attempt, dataPoints, guess);
 
@@ -1357,6 +1467,13 @@ QVector<double> CurveFitting::parabola_fit(FittingGoal goal, const QVector<doubl
                 // So, perturb the initial conditions and have another go.
                 retry = true;
 
+            if (!retry && warmStart)
+            {
+                // The solution of the previous fit didn't lead to one, so have another go from the datapoints
+                m_WarmStartFailed = true;
+                retry = true;
+            }
+
             qCDebug(KSTARS_EKOS_FOCUS) <<
                                        QString("LM solver (Parabola): Failed after %1ms iters=%2 [attempt=%3] with status=%4 [%5] and info=%6 [%7], retry=%8")
                                        .arg(timer.elapsed()).arg(gsl_multifit_nlinear_niter(w)).arg(attempt + 1).arg(status).arg(gsl_strerror(status))
@@ -1378,14 +1495,10 @@ QVector<double> CurveFitting::parabola_fit(FittingGoal goal, const QVector<doubl
         }
     }
 
-    // Free GSL memory
-    gsl_multifit_nlinear_free(w);
+    // Free GSL memory, the workspace is kept for the next fit
     gsl_vector_free(guess);
     gsl_vector_free(weights);
 
-    // Restore old GSL error handler
-    gsl_set_error_handler(oldErrorHandler);
-
     return vc;
 }
 
@@ -1458,7 +1571,7 @@ void CurveFitting::parMakeGuess(const int attempt, const DataPointT &dataPoints,
     // will be nudged to find a solution this time
     double perturbation = 1.0 + pow(-1, attempt) * (attempt * 0.1);
 
-    if (!m_FirstSolverRun && (m_LastCurveType == FOCUS_PARABOLA) && (m_LastCoefficients.size() == NUM_PARABOLA_PARAMS))
+    if (canWarmStart(FOCUS_PARABOLA, NUM_PARABOLA_PARAMS))
     {
         // Last run of the solver was a Parabola and that solution was good, so use that solution
         gsl_vector_set(guess, A_IDX, m_LastCoefficients[A_IDX] * perturbation);
@@ -1515,17 +1628,18 @@ void CurveFitting::parMakeGuess(const int attempt, const DataPointT &dataPoints,
     }
 }
 
-QVector<double> CurveFitting::gaussian_fit(DataPoint3DT data, const StarParams &starParams)
+QVector<double> CurveFitting::gaussian_fit(const DataPoint3DT &data, const StarParams &starParams)
 {
     QVector<double> vc;
 
     // Set the gsl error handler off as it aborts the program on error.
-    auto const oldErrorHandler = gsl_set_error_handler_off();
+    GSLErrorHandlerOff errorHandlerOff;
 
     // Setup variables to be used by the solver
     gsl_multifit_nlinear_parameters params = gsl_multifit_nlinear_default_parameters();
-    gsl_multifit_nlinear_workspace* w = gsl_multifit_nlinear_alloc (gsl_multifit_nlinear_trust, &params, data.dps.size(),
-                                        NUM_GAUSSIAN_PARAMS);
+    gsl_multifit_nlinear_workspace* w = nlinearWorkspace(data.dps.size(), NUM_GAUSSIAN_PARAMS);
+    if (w == nullptr)
+        return vc;
     gsl_multifit_nlinear_fdf fdf;
     int numIters;
     double xtol, gtol, ftol;
@@ -1536,12 +1650,12 @@ QVector<double> CurveFitting::gaussian_fit(DataPoint3DT data, const StarParams &
     fdf.fvv = gauFxyxy;
     fdf.n = data.dps.size();
     fdf.p = NUM_GAUSSIAN_PARAMS;
-    fdf.params = &data;
+    fdf.params = const_cast<DataPoint3DT *>(&data);
 
     // Allocate the guess vector
     gsl_vector * guess = gsl_vector_alloc(NUM_GAUSSIAN_PARAMS);
     // Allocate weights vector
-    auto weights = gsl_vector_alloc(data.dps.size());
+    auto weights = data.useWeights ? gsl_vector_alloc(data.dps.size()) : nullptr;
 
     // Setup a timer to see how long the solve takes
     QElapsedTimer timer;
@@ -1634,13 +1748,10 @@ QVector<double> CurveFitting::gaussian_fit(DataPoint3DT data, const StarParams &
         }
     }
 
-    // Free GSL memory
-    gsl_multifit_nlinear_free(w);
+    // Free GSL memory, the workspace is kept for the next star
     gsl_vector_free(guess);
-    gsl_vector_free(weights);
-
-    // Restore old GSL error handler
-    gsl_set_error_handler(oldErrorHandler);
+    if (weights != nullptr)
+        gsl_vector_free(weights);
 
     return vc;
 }
@@ -1725,12 +1836,13 @@ QVector<double> CurveFitting::plane_fit(const DataPoint3DT data)
     QVector<double> vc;
 
     // Set the gsl error handler off as it aborts the program on error.
-    auto const oldErrorHandler = gsl_set_error_handler_off();
+    GSLErrorHandlerOff errorHandlerOff;
 
     // Setup variables to be used by the solver
     gsl_multifit_nlinear_parameters params = gsl_multifit_nlinear_default_parameters();
-    gsl_multifit_nlinear_workspace* w = gsl_multifit_nlinear_alloc (gsl_multifit_nlinear_trust, &params, data.dps.size(),
-                                        NUM_PLANE_PARAMS);
+    gsl_multifit_nlinear_workspace* w = nlinearWorkspace(data.dps.size(), NUM_PLANE_PARAMS);
+    if (w == nullptr)
+        return vc;
     gsl_multifit_nlinear_fdf fdf;
     int numIters;
     double xtol, gtol, ftol;
@@ -1832,14 +1944,10 @@ QVector<double> CurveFitting::plane_fit(const DataPoint3DT data)
         }
     }
 
-    // Free GSL memory
-    gsl_multifit_nlinear_free(w);
+    // Free GSL memory, the workspace is kept for the next fit
     gsl_vector_free(guess);
     gsl_vector_free(weights);
 
-    // Restore old GSL error handler
-    gsl_set_error_handler(oldErrorHandler);
-
     return vc;
 }
 
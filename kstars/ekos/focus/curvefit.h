@@ -2,8 +2,10 @@
 
 #include "../../auxiliary/robuststatistics.h"
 
+#include <QHash>
 #include <QVector>
 #include <qcustomplot.h>
+#include <algorithm>
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_min.h>
 #include <gsl/gsl_matrix.h>
@@ -104,6 +106,11 @@ class CurveFitting
         // Does not implement getting the original data points.
         CurveFitting(const QString &serialized);
 
+        // Frees the GSL workspaces. Objects keep their workspaces between fits so they can't be copied.
+        ~CurveFitting();
+        CurveFitting(const CurveFitting &) = delete;
+        CurveFitting &operator=(const CurveFitting &) = delete;
+
         // fitCurve takes in the vectors with the position, hfr and weight (e.g. variance in HFR) values
         // along with the type of curve to use and whether or not to use weights in the calculation
         // It fits the curve and solves for the coefficients.
@@ -115,6 +122,7 @@ class CurveFitting
         // Data is passed in in imageBuffer - a 2D array of width x height
         // Approx star information is passed in to seed the LM solver initial parameters.
         // Start and end define the x,y coordinates of a box around the star, start is top left corner, end is bottom right
+        // Different objects may fit stars in different threads at the same time.
         template <typename T>
         void fitCurve3D(const T *imageBuffer, const int imageWidth, const QPair<int, int> start, const QPair<int, int> end,
                         const StarParams &starParams, const CurveFit curveFit, const bool useWeights)
@@ -140,18 +148,23 @@ class CurveFitting
                 return;
             }
 
-            m_dataPoints.dps.clear();
             m_dataPoints.useWeights = useWeights;
 
             // Load up the data structures for the solver.
             // The pixel reference x, y refers to the top left corner of the pizel so add 0.5 to x and y to reference the
             // centre of the pixel.
-            int width = end.first - start.first;
-            int height = end.second - start.second;
+            // The vector keeps its capacity, so stars of a similar size are loaded without allocating.
+            const int width = std::max(end.first - start.first, 0);
+            const int height = std::max(end.second - start.second, 0);
+            m_dataPoints.dps.resize(width * height);
 
+            DataPT3D *dp = m_dataPoints.dps.data();
             for (int j = 0; j < height; j++)
+            {
+                const T *row = imageBuffer + start.first + ((start.second + j) * imageWidth);
                 for (int i = 0; i < width; i++)
-                    m_dataPoints.push_back(i + 0.5, j + 0.5, imageBuffer[start.first + i + ((start.second + j) * imageWidth)], 1.0);
+                    *dp++ = { i + 0.5, j + 0.5, static_cast<double>(row[i]), 1.0 };
+            }
 
             m_CurveType = curveFit;
             switch (m_CurveType)
@@ -227,7 +240,14 @@ class CurveFitting
         QVector<double> parabola_fit(FittingGoal goal, const QVector<double> data_x, const QVector<double> data_y,
                                      const QVector<double> data_weights,
                                      const QVector<bool> outliers, bool useWeights, const OptimisationDirection optDir);
-        QVector<double> gaussian_fit(DataPoint3DT data, const StarParams &starParams);
+        QVector<double> gaussian_fit(const DataPoint3DT &data, const StarParams &starParams);
+
+        // Return a solver workspace for n datapoints and p parameters, which is kept for the next fits.
+        gsl_multifit_nlinear_workspace *nlinearWorkspace(size_t n, size_t p);
+        gsl_multifit_linear_workspace *linearWorkspace(size_t n, size_t p);
+        void freeWorkspaces();
+        // Returns true if the guess can start from the solution of the previous fit
+        bool canWarmStart(CurveFit curveFit, int numParams) const;
         QVector<double> plane_fit(const DataPoint3DT data);
 
         bool minimumQuadratic(double expected, double minPosition, double maxPosition, double *position, double *value);
@@ -267,14 +287,21 @@ class CurveFitting
         // Use weights or not
         bool m_useWeights;
         DataPoint3DT m_dataPoints;
+        // The solver workspaces by number of datapoints and parameters. Refits of the same datapoints, and stars of
+        // the same box size, share one.
+        QHash<QPair<size_t, size_t>, gsl_multifit_nlinear_workspace *> m_NlinearWorkspaces;
+        QHash<QPair<size_t, size_t>, gsl_multifit_linear_workspace *> m_LinearWorkspaces;
         // The solved parameters.
         QVector<double> m_coefficients;
         // State variables used by the LM solver. These variables provide a way of optimising the starting
         // point for the solver by using the solution found by the previous run providing the relevant
         // solver parameters are consistent between runs.
+        // m_LastCoefficients are those of the last fit that found a solution. A failed fit doesn't lose them.
         bool m_FirstSolverRun;
         CurveFit m_LastCurveType;
         QVector<double> m_LastCoefficients;
+        // Set when the solver failed from the previous solution, the next attempts start from the datapoints.
+        bool m_WarmStartFailed { false };
 };
 
 } //namespace
@@ -10,6 +10,7 @@
 #include "focusfwhm.h"
 #include "aberrationinspector.h"
 #include "aberrationinspectorutils.h"
+#include "sensortilemap.h"
 #include "kstars.h"
 #include "kstarsdata.h"
 #include "Options.h"
@@ -335,6 +336,7 @@ void Focus::resetFrame()
             starSelected = false;
             starCenter   = QVector3D();
             subFramed    = false;
+            m_AutoROI    = false;
 
             m_FocusView->setTrackingBox(QRect());
             checkMosaicMaskLimits();
@@ -1272,6 +1274,7 @@ void Focus::runAutoFocus(AutofocusReason autofocusReason, const QString &reasonI
     {
         m_AFfilter = filter();
         int position = adaptFocus->adaptStartPosition(currentPosition, m_AFfilter);
+        position = adaptFocus->modelStartPosition(position, m_AFfilter);
 
         curveFitting.reset(new CurveFitting());
 
@@ -1299,11 +1302,15 @@ void Focus::runAutoFocus(AutofocusReason autofocusReason, const QString &reasonI
 
 void Focus::setupLinearFocuser(int initialPosition)
 {
+    // The focus model may allow fewer steps than the user's
+    const double outSteps = (m_ModelOutSteps > 0) ? m_ModelOutSteps : m_OpsFocusMechanics->focusOutSteps->value();
+    const int numSteps = (m_ModelNumSteps > 0) ? m_ModelNumSteps : m_OpsFocusMechanics->focusNumSteps->value();
+
     FocusAlgorithmInterface::FocusParams params(curveFitting.get(),
             m_OpsFocusMechanics->focusMaxTravel->value(), m_OpsFocusMechanics->focusTicks->value(), initialPosition, absMotionMin,
             absMotionMax, MAXIMUM_ABS_ITERATIONS, m_OpsFocusProcess->focusTolerance->value() / 100.0, m_AFfilter,
             currentTemperatureSourceElement ? currentTemperatureSourceElement->value : INVALID_VALUE,
-            m_OpsFocusMechanics->focusOutSteps->value(), m_OpsFocusMechanics->focusNumSteps->value(),
+            outSteps, numSteps,
             m_FocusAlgorithm, m_OpsFocusMechanics->focusBacklash->value(), m_CurveFit, m_OpsFocusProcess->focusUseWeights->isChecked(),
             m_StarMeasure, m_StarPSF, m_OpsFocusProcess->focusRefineCurveFit->isChecked(), m_FocusWalk,
             m_OpsFocusProcess->focusDonut->isChecked(), m_OpsFocusProcess->focusOutlierRejection->value(), m_OptDir, m_ScaleCalc);
@@ -1442,6 +1449,8 @@ void Focus::stop(Ekos::FocusState completionState)
     m_FocusMotionTimer.stop();
     m_FocusMotionTimerCounter = 0;
     m_FocuserReconnectCounter = 0;
+    m_PipelineState = PIPELINE_IDLE;
+    resetAutoROI();
 
     opticalTrainCombo->setEnabled(true);
     resetDonutProcessing();
@@ -2226,9 +2235,12 @@ void Focus::settle(const FocusState completionState, const bool autoFocusUsed, c
                                   KSNotification::Focus);
             // Pass consistent Autofocus temperature to analyze
             if (m_FocusAlgorithm == FOCUS_LINEAR1PASS && curveFitting != nullptr)
+            {
+                adaptFocus->storeFocusModel(currentPosition);
                 emit autofocusComplete(m_LastSourceAutofocusTemperature, filter(), getAnalyzeData(),
                                        m_OpsFocusProcess->focusUseWeights->isChecked(),
                                        curveFitting->serialize(), linearFocuser->getTextStatus(R2));
+            }
             else
                 emit autofocusComplete(m_LastSourceAutofocusTemperature, filter(), getAnalyzeData(),
                                        m_OpsFocusProcess->focusUseWeights->isChecked());
@@ -2433,7 +2445,7 @@ void Focus::setCurrentMeasure()
     // Let signal the current HFR now depending on whether the focuser is absolute or relative
     // Outside of Focus we continue to rely on HFR and independent of which measure the user selected we always calculate HFR
     if (canAbsMove)
-        emit newHFR(currentHFR, currentPosition, inAutoFocus);
+        emit newHFR(currentHFR, measuredPosition(), inAutoFocus);
     else
         emit newHFR(currentHFR, -1, inAutoFocus);
 
@@ -2549,23 +2561,9 @@ void Focus::calculateAbInsData()
 {
     ImageMosaicMask *mosaicmask = dynamic_cast<ImageMosaicMask *>(m_FocusView->imageMask().get());
     const QVector<QRect> tiles = mosaicmask->tiles();
-    auto stars = m_ImageData->getStarCenters();
-    QVector<QList<Edge *>> tileStars(NUM_TILES);
-
-    for (int star = 0; star < stars.count(); star++)
-    {
-        const int x = stars[star]->x;
-        const int y = stars[star]->y;
-        for (int tile = 0; tile < NUM_TILES; tile++)
-        {
-            QRect thisTile = tiles[tile];
-            if (thisTile.contains(x, y))
-            {
-                tileStars[tile].append(stars[star]);
-                break;
-            }
-        }
-    }
+    SensorTileMap tileMap(MOSAIC_COLUMNS, MOSAIC_ROWS);
+    tileMap.setTiles(tiles, m_ImageData->width(), m_ImageData->height());
+    const QVector<QList<Edge *>> tileStars = tileMap.binStars(m_ImageData->getStarCenters());
 
     // Get the measure for each tile
     for (int tile = 0; tile < tileStars.count(); tile++)
@@ -2624,7 +2622,7 @@ void Focus::calculateAbInsData()
             m_abInsTileCenterOffset.append(QPoint(xAv, yAv));
         }
     }
-    m_abInsPosition.append(currentPosition);
+    m_abInsPosition.append(measuredPosition());
 }
 
 void Focus::setCaptureComplete()
@@ -2662,11 +2660,110 @@ void Focus::setCaptureComplete()
     // THEN let's find stars in the image and get current HFR
     if (inFocusLoop == false || (inFocusLoop && (m_FocusView->isTrackingBoxEnabled()
                                  || m_OpsFocusSettings->focusUseFullField->isChecked())))
+    {
+        startPipelinedMove();
         analyzeSources();
+    }
     else
         setHFRComplete();
 }
 
+// With the automatic ROI, full field autofocus only downloads and analyses the part of the sensor around the
+// brightest stars of the first frame. The frame is subframed to the box bounding these stars plus a margin,
+// and the first frame is captured again. Masks are relative to the full frame, so it's only done without one.
+bool Focus::setupAutoROI()
+{
+    if (m_AutoROI || subFramed || !Options::focusAutoROI() || !m_OpsFocusSettings->focusUseFullField->isChecked()
+            || !m_OpsFocusSettings->focusNoMaskRB->isChecked() || !isFocusSubFrameEnabled() || m_abInsOn || !m_ImageData)
+        return false;
+
+    ISD::CameraChip *targetChip = m_Camera->getChip(ISD::CameraChip::PRIMARY_CCD);
+    if (targetChip == nullptr || !targetChip->canSubframe())
+        return false;
+
+    QList<Edge *> stars = m_ImageData->getStarCenters();
+    const int numStars = std::min(static_cast<int>(Options::focusAutoROIStars()), stars.size());
+    if (numStars < 3)
+        return false;
+
+    std::partial_sort(stars.begin(), stars.begin() + numStars, stars.end(), [](const Edge * a, const Edge * b)
+    {
+        return a->sum > b->sum;
+    });
+
+    double minX = stars[0]->x, maxX = stars[0]->x, minY = stars[0]->y, maxY = stars[0]->y;
+    for (int i = 1; i < numStars; i++)
+    {
+        minX = std::min(minX, static_cast<double>(stars[i]->x));
+        maxX = std::max(maxX, static_cast<double>(stars[i]->x));
+        minY = std::min(minY, static_cast<double>(stars[i]->y));
+        maxY = std::max(maxY, static_cast<double>(stars[i]->y));
+    }
+
+    int subBinX = 1, subBinY = 1;
+    targetChip->getBinning(&subBinX, &subBinY);
+    const int margin = (static_cast<double>(m_OpsFocusSettings->focusBoxSize->value()) / subBinX) * 1.5;
+    const QRect frame(0, 0, m_ImageData->width(), m_ImageData->height());
+    const QPoint topLeft(static_cast<int>(std::floor(minX)) - margin, static_cast<int>(std::floor(minY)) - margin);
+    const QPoint bottomRight(static_cast<int>(std::ceil(maxX)) + margin, static_cast<int>(std::ceil(maxY)) + margin);
+    const QRect roi = QRect(topLeft, bottomRight).intersected(frame);
+
+    // Not worth it if the stars spread over most of the frame
+    if (roi.isEmpty() || roi.width() * roi.height() > frame.width() * frame.height() / 2)
+        return false;
+
+    QVariantMap settings = frameSettings[targetChip];
+    int subX = settings["x"].toInt() + roi.x() * subBinX;
+    int subY = settings["y"].toInt() + roi.y() * subBinY;
+    int subW = roi.width() * subBinX;
+    int subH = roi.height() * subBinY;
+
+    int frameMinX, frameMaxX, frameMinY, frameMaxY, frameMinW, frameMaxW, frameMinH, frameMaxH;
+    targetChip->getFrameMinMax(&frameMinX, &frameMaxX, &frameMinY, &frameMaxY, &frameMinW, &frameMaxW, &frameMinH,
+                               &frameMaxH);
+    subX = std::max(subX, frameMinX);
+    subY = std::max(subY, frameMinY);
+    subW = std::min(subW, frameMaxW - subX);
+    subH = std::min(subH, frameMaxH - subY);
+
+    m_AutoROIFrame = settings;
+    settings["x"] = subX;
+    settings["y"] = subY;
+    settings["w"] = subW;
+    settings["h"] = subH;
+    settings["binx"] = subBinX;
+    settings["biny"] = subBinY;
+    frameSettings[targetChip] = settings;
+
+    m_AutoROIOffset = QPoint((subX - m_AutoROIFrame["x"].toInt()) / subBinX, (subY - m_AutoROIFrame["y"].toInt()) / subBinY);
+    m_AutoROI = true;
+
+    qCDebug(KSTARS_EKOS_FOCUS) << "Frame is cropped to the brightest" << numStars << "stars. X:" << subX << "Y:" << subY
+                               << "W:" << subW << "H:" << subH << "binX:" << subBinX << "binY:" << subBinY;
+    appendLogText(i18n("Subframing around the %1 brightest stars...", numStars));
+
+    starsHFR.clear();
+    m_FocusView->setFirstLoad(true);
+    capture();
+    return true;
+}
+
+// Returns to the frame in use before the automatic ROI
+void Focus::resetAutoROI()
+{
+    if (!m_AutoROI)
+        return;
+
+    m_AutoROI = false;
+    if (m_Camera)
+    {
+        ISD::CameraChip *targetChip = m_Camera->getChip(ISD::CameraChip::PRIMARY_CCD);
+        if (targetChip)
+            frameSettings[targetChip] = m_AutoROIFrame;
+    }
+    m_FocusView->setFirstLoad(true);
+}
+
 void Focus::setHFRComplete()
 {
     // If we are just framing, let's capture again
@@ -2876,6 +2973,10 @@ void Focus::setHFRComplete()
         return;
     }
 
+    // The first full field autofocus frame may select a ROI for the next frames
+    if (inAutoFocus && setupAutoROI())
+        return;
+
     // If we are not in autofocus process, we're done.
     if (inAutoFocus == false)
     {
@@ -2985,7 +3086,11 @@ bool Focus::autoFocusChecks()
         {
             noStarCount++;
             appendLogText(i18n("No stars detected, capturing again..."));
-            capture();
+            // The focuser may already be moving on, then recapture once it is back
+            if (m_PipelineState != PIPELINE_IDLE)
+                completePipelinedMove(linearRequestedPosition);
+            else
+                capture();
             return false;
         }
         else if (m_FocusAlgorithm == FOCUS_LINEAR)
@@ -3125,7 +3230,8 @@ CurveFitting::FittingGoal Focus::getGoal(int numSteps)
         return CurveFitting::FittingGoal::STANDARD;
 
     // Fixed step walks will use C, except for the last step which should be BEST
-    return (numSteps >= m_OpsFocusMechanics->focusNumSteps->value()) ? CurveFitting::FittingGoal::BEST :
+    const int runSteps = linearFocuser ? linearFocuser->getParams().numSteps : m_OpsFocusMechanics->focusNumSteps->value();
+    return (numSteps >= runSteps) ? CurveFitting::FittingGoal::BEST :
            CurveFitting::FittingGoal::STANDARD;
 }
 
@@ -3307,7 +3413,24 @@ void Focus::autoFocusLinear()
                             && m_OpsFocusProcess->focusFramesCount->value() == 1;
     auto focusStars = useFocusStarsHFR || (m_FocusAlgorithm == FOCUS_LINEAR1PASS) ? &(m_ImageData->getStarCenters()) : nullptr;
 
-    linearRequestedPosition = linearFocuser->newMeasurement(currentPosition, currentMeasure, currentWeight, focusStars);
+    // Stars of a ROI are compared in sensor coordinates
+    QList<Edge> sensorStars;
+    QList<Edge *> sensorStarPointers;
+    if (focusStars && m_AutoROI)
+    {
+        for (const Edge *star : *focusStars)
+        {
+            Edge sensorStar = *star;
+            sensorStar.x += m_AutoROIOffset.x();
+            sensorStar.y += m_AutoROIOffset.y();
+            sensorStars.append(sensorStar);
+        }
+        for (Edge &star : sensorStars)
+            sensorStarPointers.append(&star);
+        focusStars = &sensorStarPointers;
+    }
+
+    linearRequestedPosition = linearFocuser->newMeasurement(measuredPosition(), currentMeasure, currentWeight, focusStars);
     if (m_FocusAlgorithm == FOCUS_LINEAR1PASS && linearFocuser->isDone() && linearFocuser->solution() != -1)
     {
         // Linear 1 Pass is done, graph is drawn, so just move to the focus position, and update the graph.
@@ -3363,6 +3486,12 @@ void Focus::autoFocusLinear()
         }
         return;
     }
+    else if (m_PipelineState != PIPELINE_IDLE)
+    {
+        // The focuser has been moving while the frame was analysed
+        completePipelinedMove(linearRequestedPosition);
+        return;
+    }
     else
     {
         const int delta = linearRequestedPosition - currentPosition;
@@ -3374,6 +3503,61 @@ void Focus::autoFocusLinear()
     }
 }
 
+// Starts moving the focuser to the next Linear 1 Pass position before the frame that was just
+// captured is analysed, when the algorithm can tell that position without the measurement.
+// This takes the move and the focuser settling off the critical path of each step.
+void Focus::startPipelinedMove()
+{
+    m_PipelineState = PIPELINE_IDLE;
+    if (!Options::focusPipelinedMoves() || !inAutoFocus || inScanStartPos || m_FocusAlgorithm != FOCUS_LINEAR1PASS
+            || !linearFocuser || !canAbsMove || !m_OpsFocusSettings->focusUseFullField->isChecked())
+        return;
+
+    // More frames are to be captured at this position
+    if (starMeasureFrames.count() + 1 < m_OpsFocusProcess->focusFramesCount->value())
+        return;
+
+    const int position = linearFocuser->predictedPosition();
+    if (position < 0 || abs(position - currentPosition) <= 1)
+        return;
+
+    qCDebug(KSTARS_EKOS_FOCUS) << QString("Pipelined autofocus: moving to %1 while the frame at %2 is analysed")
+                               .arg(position).arg(currentPosition);
+    m_PipelineFramePosition = currentPosition;
+    m_PipelinePosition = position;
+    m_PipelineState = PIPELINE_MOVING;
+    if (!changeFocus(position - currentPosition))
+        m_PipelineState = PIPELINE_IDLE;
+}
+
+// Called once the analysed frame has given the position to capture at next. If it is the predicted one
+// capture there as soon as the focuser has arrived, otherwise move on to it.
+void Focus::completePipelinedMove(int position)
+{
+    const PipelineState pipelineState = m_PipelineState;
+    m_PipelineState = PIPELINE_IDLE;
+
+    if (position != m_PipelinePosition)
+        qCDebug(KSTARS_EKOS_FOCUS) << QString("Pipelined autofocus: position %1 requested instead of %2, correcting")
+                                   .arg(position).arg(m_PipelinePosition);
+
+    if (pipelineState == PIPELINE_MOVING)
+    {
+        // Carry on when the focuser arrives, see autoFocusProcessPositionChange
+        if (position != m_PipelinePosition)
+            m_PipelineState = PIPELINE_CORRECTING;
+    }
+    else if (position == m_PipelinePosition)
+        autoFocusProcessPositionChange(IPS_OK);
+    else if (!changeFocus(position - currentPosition))
+        completeFocusProcedure(Ekos::FOCUS_ABORTED, Ekos::FOCUS_FAIL_FOCUSER_NO_MOVE, "", false);
+}
+
+int Focus::measuredPosition() const
+{
+    return (m_PipelineState == PIPELINE_IDLE) ? currentPosition : m_PipelineFramePosition;
+}
+
 void Focus::autoFocusAbs()
 {
     // Q_ASSERT_X(canAbsMove || canRelMove, __FUNCTION__, "Prerequisite: only absolute and relative focusers");
@@ -3893,6 +4077,19 @@ void Focus::autoFocusProcessPositionChange(IPState state)
                 }
             });
         }
+        else if (inAutoFocus && m_PipelineState == PIPELINE_MOVING)
+        {
+            // Still analysing the frame taken before this move, completePipelinedMove will capture
+            qCDebug(KSTARS_EKOS_FOCUS) << QString("Pipelined autofocus: reached %1 before the frame analysis completed")
+                                       .arg(currentPosition);
+            m_PipelineState = PIPELINE_MOVED;
+        }
+        else if (inAutoFocus && m_PipelineState == PIPELINE_CORRECTING)
+        {
+            m_PipelineState = PIPELINE_IDLE;
+            if (!changeFocus(linearRequestedPosition - currentPosition))
+                completeFocusProcedure(Ekos::FOCUS_ABORTED, Ekos::FOCUS_FAIL_FOCUSER_NO_MOVE);
+        }
         else if (inAutoFocus)
         {
             // Add a check that the current position matches the requested position (within a tolerance)
@@ -3928,11 +4125,12 @@ void Focus::donutTimeDilation()
         return;
 
     // Get the max distance from focus to outer points
-    const double centre = (m_OpsFocusMechanics->focusNumSteps->value() + 1.0) / 2.0;
+    const int runSteps = linearFocuser->getParams().numSteps;
+    const double centre = (runSteps + 1.0) / 2.0;
     // Get the current step - treat the final
     const int currentStep = linearFocuser->currentStep() + 1;
     double distance;
-    if (currentStep <= m_OpsFocusMechanics->focusNumSteps->value())
+    if (currentStep <= runSteps)
         distance = std::abs(centre - currentStep);
     else
         // Last step is always back to focus
@@ -736,6 +736,9 @@ class Focus : public QWidget, public Ui::Focus
 
         // HFR / FWHM
         void setHFRComplete();
+        // Crops full field autofocus frames to the brightest stars, returns true if a frame was requested
+        bool setupAutoROI();
+        void resetAutoROI();
 
         // Sets the star algorithm and enables/disables various UI inputs.
         void setFocusDetection(StarAlgorithm starAlgorithm);
@@ -780,6 +783,14 @@ class Focus : public QWidget, public Ui::Focus
         // Start up capture, or occasionally move focuser again, after current focus-move accomplished.
         void autoFocusProcessPositionChange(IPState state);
 
+        // Pipelined autofocus. When Linear 1 Pass already knows its next position, the focuser moves
+        // there while the last frame is analysed. startPipelinedMove() starts the move if possible,
+        // completePipelinedMove() continues once the algorithm has asked for its actual next position.
+        void startPipelinedMove();
+        void completePipelinedMove(int position);
+        // The position the frame being analysed was captured at
+        int measuredPosition() const;
+
         // For the Linear algorithm, which always scans in (from higher position to lower position)
         // if we notice the new position is higher than the current position (that is, it is the start
         // of a new scan), we adjust the new position to be several steps further out than requested
@@ -1022,6 +1033,12 @@ class Focus : public QWidget, public Ui::Focus
         //bool frameModified;
         /// Was the modified frame subFramed?
         bool subFramed { false };
+        /// Is full field autofocus cropped to the ROI around the brightest stars, see setupAutoROI()?
+        bool m_AutoROI { false };
+        /// Offset of the ROI in the full frame in binned pixels, to map star positions back to the sensor
+        QPoint m_AutoROIOffset;
+        /// The frame settings before the ROI, restored when autofocus stops
+        QVariantMap m_AutoROIFrame;
         /// If the autofocus process fails, let's not ruin the capture session probably taking place in the next tab. Instead, we should restart it and try again, but we keep count until we hit MAXIMUM_RESET_ITERATIONS
         /// and then we truly give up.
         int resetFocusIteration { 0 };
@@ -1187,6 +1204,21 @@ class Focus : public QWidget, public Ui::Focus
         bool focuserAdditionalMovementUpdateDir { true };
         int linearRequestedPosition { 0 };
 
+        // Pipelined autofocus moves, see startPipelinedMove()
+        typedef enum
+        {
+            PIPELINE_IDLE,
+            // Moving to the predicted position while the frame is analysed
+            PIPELINE_MOVING,
+            // Reached the predicted position, the frame is still being analysed
+            PIPELINE_MOVED,
+            // The prediction was wrong, move to linearRequestedPosition once the move completes
+            PIPELINE_CORRECTING
+        } PipelineState;
+        PipelineState m_PipelineState { PIPELINE_IDLE };
+        int m_PipelinePosition { 0 };
+        int m_PipelineFramePosition { 0 };
+
         bool hasDeviation { false };
 
         //double observatoryTemperature { INVALID_VALUE };
@@ -1303,5 +1335,8 @@ class Focus : public QWidget, public Ui::Focus
         QVector<int> m_scanPosition;
         QVector<double> m_scanMeasure;
         QString m_AFfilter = NULL_FILTER;
+        // Outward steps and steps of the run from the focus model, -1 to use the user's
+        double m_ModelOutSteps { -1 };
+        int m_ModelNumSteps { -1 };
 };
 }
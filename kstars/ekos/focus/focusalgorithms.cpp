@@ -86,6 +86,8 @@ class LinearFocusAlgorithm : public FocusAlgorithmInterface
             return numSteps;
         }
 
+        int predictedPosition() const override;
+
     private:
 
         // Called in newMeasurement. Sets up the next iteration.
@@ -107,7 +109,8 @@ class LinearFocusAlgorithm : public FocusAlgorithmInterface
         void removeDonuts();
 
         // Calc the next step size for Linear1Pass for FOCUS_WALK_FIXED_STEPS and FOCUS_WALK_CFZ_SHUFFLE
-        int getNextStepSize();
+        // after the given number of steps
+        int getNextStepSize(int steps) const;
 
         // Called when we've found a solution, e.g. the HFR value is within tolerance of the desired value.
         // It it returns true, then it's decided tht we should try one more sample for a possible improvement.
@@ -812,7 +815,7 @@ int LinearFocusAlgorithm::linearWalk(int position, double value, const double st
         }
     }
 
-    int nextStepSize = getNextStepSize();
+    int nextStepSize = getNextStepSize(numSteps);
     return completeIteration(nextStepSize, foundFit, minPos, minVal);
 }
 
@@ -909,7 +912,7 @@ void LinearFocusAlgorithm::removeDonuts()
 }
 
 // Function to calculate the next step size for LINEAR1PASS for walks: FOCUS_WALK_FIXED_STEPS and FOCUS_WALK_CFZ_SHUFFLE
-int LinearFocusAlgorithm::getNextStepSize()
+int LinearFocusAlgorithm::getNextStepSize(int steps) const
 {
     int nextStepSize, lower, upper;
 
@@ -935,9 +938,9 @@ int LinearFocusAlgorithm::getNextStepSize()
                 upper = (params.numSteps - lower);
             }
 
-            if (numSteps <= lower)
+            if (steps <= lower)
                 nextStepSize = stepSize;
-            else if (numSteps >= upper)
+            else if (steps >= upper)
                 nextStepSize = stepSize;
             else
                 nextStepSize = stepSize / 2;
@@ -950,6 +953,26 @@ int LinearFocusAlgorithm::getNextStepSize()
     return nextStepSize;
 }
 
+// In the first pass of the Linear 1 Pass walks the next position only depends on the number of steps,
+// until the last step of the pass, as long as the measurement is taken at the requested position.
+// This repeats what linearWalk() and completeIteration() will do with the next measurement.
+int LinearFocusAlgorithm::predictedPosition() const
+{
+    if (done || params.focusAlgorithm != Focus::FOCUS_LINEAR1PASS || !inFirstPass)
+        return -1;
+    if (params.focusWalk != Focus::FOCUS_WALK_FIXED_STEPS && params.focusWalk != Focus::FOCUS_WALK_CFZ_SHUFFLE)
+        return -1;
+
+    const int steps = numSteps + 1;
+    if (steps >= params.numSteps || steps > params.maxIterations)
+        return -1;
+
+    const int position = requestedPosition - getNextStepSize(steps);
+    if (position < minPositionLimit)
+        return -1;
+    return position;
+}
+
 int LinearFocusAlgorithm::setupSolution(int position, double value, double weight)
 {
     focusSolution = position;
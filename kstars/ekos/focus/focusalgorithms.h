@@ -180,6 +180,14 @@ class FocusAlgorithmInterface
         // For Linear and L1P returns the focuser step
         virtual int currentStep() const = 0;
 
+        // Returns the position the next newMeasurement() call will request, when that doesn't depend
+        // on the measurement, so the focuser can be moved there while the frame is analysed.
+        // Returns -1 if the next position can't be known before the measurement.
+        virtual int predictedPosition() const
+        {
+            return -1;
+        }
+
         // For testing.
         virtual FocusAlgorithmInterface *Copy() = 0;
 
@@ -7,13 +7,19 @@
 #pragma once
 
 #include <QList>
+#include <QThread>
 #include "../fitsviewer/fitsstardetector.h"
 #include "fitsviewer/fitsview.h"
 #include "fitsviewer/fitsdata.h"
 #include "curvefit.h"
 #include "../ekos.h"
+#include "auxiliary/executors.h"
 #include <ekos_focus_debug.h>
 
+#include <memory>
+#include <numeric>
+#include <vector>
+
 
 namespace Ekos
 {
@@ -32,7 +38,6 @@ class FocusFWHM
                          std::unique_ptr<CurveFitting> &starFitting,
                          double *FWHM, double *weight)
         {
-            CurveFitting::StarParams starParams, starParams2;
             std::vector<double> FWHMs, R2s;
 
             auto skyBackground = imageData->getSkyBackground();
@@ -92,43 +97,45 @@ class FocusFWHM
                 }
             }
 
-            // We have the list of stars to process now so iterate through the list fitting a curve, etc
+            // We have the list of stars to process now so fit a curve to each of them. The stars are fitted in parallel,
+            // each thread by its own CurveFitting which keeps its solver workspaces from star to star and from frame
+            // to frame. Stars are dealt out in turn so that big and small boxes spread evenly over the threads.
+            if (!starFitting)
+                starFitting.reset(new CurveFitting());
+            const int threads = std::max(1, std::min(QThread::idealThreadCount(), static_cast<int>(stars.size())));
+            while (static_cast<int>(m_StarFitting.size()) < threads - 1)
+                m_StarFitting.emplace_back(new CurveFitting());
+
+            QVector<StarFit> fits(stars.size());
+            std::vector<int> slices(threads);
+            std::iota(slices.begin(), slices.end(), 0);
+            Executors::blockingMap(Executors::RealTime, slices, [&](int slice)
+            {
+                CurveFitting *fitting = (slice == 0) ? starFitting.get() : m_StarFitting[slice - 1].get();
+                for (int s = slice; s < stars.size(); s += threads)
+                {
+                    if (stars[s].isValid)
+                        fitStar(imageBuffer, stats.width, focusStars[stars[s].star], stars[s], skyBackground.mean, fitting, &fits[s]);
+                }
+            });
+
             for (int s = 0; s < stars.size(); s++)
             {
-                if (!stars[s].isValid)
+                // Filter stars - 0.25 works OK on Sim
+                if (!fits[s].solved || fits[s].R2 < 0.25)
                     continue;
 
-                starParams.background = skyBackground.mean;
-                starParams.peak = focusStars[stars[s].star]->val;
-                starParams.centroid_x = focusStars[stars[s].star]->x - stars[s].start.first;
-                starParams.centroid_y = focusStars[stars[s].star]->y - stars[s].start.second;
-                starParams.HFR = focusStars[stars[s].star]->HFR;
-                starParams.theta = 0.0;
-                starParams.FWHMx = -1;
-                starParams.FWHMy = -1;
-                starParams.FWHM = -1;
-
-                starFitting->fitCurve3D(imageBuffer, stats.width, stars[s].start, stars[s].end, starParams, CurveFitting::FOCUS_GAUSSIAN,
-                                        false);
-                if (starFitting->getStarParams(CurveFitting::FOCUS_GAUSSIAN, &starParams2))
-                {
-                    starParams2.centroid_x += stars[s].start.first;
-                    starParams2.centroid_y += stars[s].start.second;
-                    double R2 = starFitting->calculateR2(CurveFitting::FOCUS_GAUSSIAN);
-                    if (R2 >= 0.25)
-                    {
-                        // Filter stars - 0.25 works OK on Sim
-                        FWHMs.push_back(starParams2.FWHM);
-                        R2s.push_back(R2);
-
-                        qCDebug(KSTARS_EKOS_FOCUS) << "Star" << s << " R2=" << R2
-                                                   << " x=" << focusStars[s]->x << " vs " << starParams2.centroid_x
-                                                   << " y=" << focusStars[s]->y << " vs " << starParams2.centroid_y
-                                                   << " HFR=" << focusStars[s]->HFR << " FWHM=" << starParams2.FWHM
-                                                   << " Background=" << skyBackground.mean << " vs " << starParams2.background
-                                                   << " Peak=" << focusStars[s]->val << "vs" << starParams2.peak;
-                    }
-                }
+                const Edge *focusStar = focusStars[stars[s].star];
+                const CurveFitting::StarParams &starParams2 = fits[s].params;
+                FWHMs.push_back(starParams2.FWHM);
+                R2s.push_back(fits[s].R2);
+
+                qCDebug(KSTARS_EKOS_FOCUS) << "Star" << s << " R2=" << fits[s].R2
+                                           << " x=" << focusStar->x << " vs " << starParams2.centroid_x
+                                           << " y=" << focusStar->y << " vs " << starParams2.centroid_y
+                                           << " HFR=" << focusStar->HFR << " FWHM=" << starParams2.FWHM
+                                           << " Background=" << skyBackground.mean << " vs " << starParams2.background
+                                           << " Peak=" << focusStar->val << "vs" << starParams2.peak;
             }
 
             if (FWHMs.size() == 0)
@@ -176,6 +183,43 @@ class FocusFWHM
             QPair<int, int> end; // bottom right of box. x = first element, y = second element
         };
 
+        // Result of the fit of one star
+        struct StarFit
+        {
+            bool solved { false };
+            double R2 { 0 };
+            CurveFitting::StarParams params;
+        };
+
+        // Fits a Gaussian to the star in box, called in parallel with a different fitting object per thread
+        template <typename T>
+        static void fitStar(const T &imageBuffer, int imageWidth, const Edge *focusStar, const StarBox &box, double background,
+                            CurveFitting *fitting, StarFit *fit)
+        {
+            CurveFitting::StarParams starParams;
+            starParams.background = background;
+            starParams.peak = focusStar->val;
+            starParams.centroid_x = focusStar->x - box.start.first;
+            starParams.centroid_y = focusStar->y - box.start.second;
+            starParams.HFR = focusStar->HFR;
+            starParams.theta = 0.0;
+            starParams.FWHMx = -1;
+            starParams.FWHMy = -1;
+            starParams.FWHM = -1;
+
+            fitting->fitCurve3D(imageBuffer, imageWidth, box.start, box.end, starParams, CurveFitting::FOCUS_GAUSSIAN, false);
+            if (fitting->getStarParams(CurveFitting::FOCUS_GAUSSIAN, &fit->params))
+            {
+                fit->params.centroid_x += box.start.first;
+                fit->params.centroid_y += box.start.second;
+                fit->R2 = fitting->calculateR2(CurveFitting::FOCUS_GAUSSIAN);
+                fit->solved = true;
+            }
+        }
+
+        // The fitting objects of the threads other than the first, which uses the one of the caller
+        std::vector<std::unique_ptr<CurveFitting>> m_StarFitting;
+
         Mathematics::RobustStatistics::ScaleCalculation m_ScaleCalc;
 };
 }
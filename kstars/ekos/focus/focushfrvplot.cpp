@@ -15,6 +15,8 @@
 
 FocusHFRVPlot::FocusHFRVPlot(QWidget *parent) : QCustomPlot (parent)
 {
+    m_Replot = new Ekos::ReplotScheduler(this);
+
     setBackground(QBrush(Qt::black));
 
     xAxis->setBasePen(QPen(Qt::white, 1));
@@ -176,7 +178,7 @@ void FocusHFRVPlot::init(QString yAxisLabel, double starUnits, bool minimum, boo
     minValue = -1;
     maxValue = -1;
     FocusHFRVPlot::clearItems();
-    replot();
+    m_Replot->schedule();
 }
 
 void FocusHFRVPlot::drawHFRPlot(double currentValue, int pulseDuration)
@@ -223,7 +225,7 @@ void FocusHFRVPlot::drawHFRPlot(double currentValue, int pulseDuration)
         m_Minimum ? upper = 1.5 * maxValue : upper = 1.2 * maxValue;
         yAxis->setRange(minVal - (0.25 * (upper - minVal)), upper);
     }
-    replot();
+    m_Replot->schedule();
 }
 
 void FocusHFRVPlot::addPosition(double pos, double newValue, double sigma, bool outlier, int pulseDuration, bool plot)
@@ -250,7 +252,7 @@ void FocusHFRVPlot::setTitle(const QString &title, bool plot)
     plotTitle->setVisible(true);
 
     plotTitle->setText(title);
-    if (plot) replot();
+    if (plot) m_Replot->schedule();
 }
 
 void FocusHFRVPlot::finalUpdates(const QString &title, bool plot)
@@ -259,7 +261,7 @@ void FocusHFRVPlot::finalUpdates(const QString &title, bool plot)
     if (plotTitle != nullptr)
     {
         plotTitle->setText(title);
-        if (plot) replot();
+        if (plot) m_Replot->schedule();
     }
 }
 void FocusHFRVPlot::setSolutionVShape(bool isVShape)
@@ -317,7 +319,7 @@ void FocusHFRVPlot::drawMinimum(double solutionPosition, double solutionValue, b
         textLabel->position->setCoords(solutionPosition, (maxValue + 2 * displayValue) / 3);
     else
         textLabel->position->setCoords(solutionPosition, (2 * displayValue + minValue) / 3);
-    if (plot) replot();
+    if (plot) m_Replot->schedule();
 }
 
 void FocusHFRVPlot::drawCFZ(double solutionPosition, double solutionValue, int cfzSteps, bool plot)
@@ -353,7 +355,7 @@ void FocusHFRVPlot::drawCFZ(double solutionPosition, double solutionValue, int c
         CFZ->setPen(QPen(QColor(Qt::yellow)));
         CFZ->setVisible(true);
     }
-    replot();
+    m_Replot->schedule();
 }
 
 void FocusHFRVPlot::drawPolynomial(Ekos::PolynomialFit *polyFit, bool isVShape, bool makeVisible, bool plot)
@@ -379,7 +381,7 @@ void FocusHFRVPlot::drawPolynomial(Ekos::PolynomialFit *polyFit, bool isVShape,
             double y = getDisplayValue(polyFit->f(x));
             polynomialGraph->addData(x, y);
         }
-        if (plot) replot();
+        if (plot) m_Replot->schedule();
     }
 }
 
@@ -406,7 +408,7 @@ void FocusHFRVPlot::drawCurve(Ekos::CurveFitting *curveFit, bool isVShape, bool
             double y = getDisplayValue(curveFit->f(x));
             polynomialGraph->addData(x, y);
         }
-        if (plot) replot();
+        if (plot) m_Replot->schedule();
     }
 }
 
@@ -13,6 +13,7 @@
 #include "ekos/ekos.h"
 #include "ekos/focus/polynomialfit.h"
 #include "ekos/focus/curvefit.h"
+#include "ekos/auxiliary/replotscheduler.h"
 
 class FocusHFRVPlot : public QCustomPlot
 {
@@ -175,4 +176,6 @@ class FocusHFRVPlot : public QCustomPlot
         double m_starUnits = 1.0;
 
         bool m_polynomialGraphIsVisible = false;
+
+        Ekos::ReplotScheduler *m_Replot { nullptr };
 };
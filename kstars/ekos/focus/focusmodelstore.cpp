@@ -0,0 +1,266 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "focusmodelstore.h"
+
+#include "Options.h"
+#include <ekos_focus_debug.h>
+
+#include <QUrl>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Ekos
+{
+
+namespace
+{
+// Number of fields of a run after the names
+constexpr int RUN_FIELDS = 11;
+
+bool isKnown(double value)
+{
+    return value != FocusModelStore::UNKNOWN && !std::isnan(value);
+}
+}
+
+FocusModelStore::FocusModelStore() : m_Entries(Options::focusModelStore())
+{
+}
+
+FocusModelStore::FocusModelStore(const QStringList &entries) : m_Entries(entries)
+{
+}
+
+void FocusModelStore::save() const
+{
+    Options::setFocusModelStore(m_Entries);
+}
+
+QString FocusModelStore::encode(const Run &run)
+{
+    QStringList coefficients;
+    for (const double coefficient : run.coefficients)
+        coefficients.append(QString::number(coefficient, 'g', 17));
+
+    QStringList fields;
+    fields << QString::number(run.position)
+           << QString::number(run.temperature, 'g', 10)
+           << QString::number(run.altitude, 'g', 10)
+           << QString::number(run.stepSize)
+           << QString::number(run.value, 'g', 10)
+           << QString::number(run.halfWidth, 'f', 1)
+           << QString::number(run.cfz, 'f', 1)
+           << QString::number(run.curveFit)
+           << coefficients.join(',')
+           << QString::number(run.time)
+           // Reserved
+           << QString();
+
+    return QString::fromUtf8(QUrl::toPercentEncoding(run.train)) + '|' +
+           QString::fromUtf8(QUrl::toPercentEncoding(run.filter)) + '|' + fields.join(';');
+}
+
+bool FocusModelStore::parse(const QString &entry, Run *result)
+{
+    const QStringList parts = entry.split('|');
+    if (parts.size() != 3)
+        return false;
+    const QStringList fields = parts[2].split(';');
+    if (fields.size() != RUN_FIELDS)
+        return false;
+
+    bool ok[8];
+    Run run;
+    run.train = QUrl::fromPercentEncoding(parts[0].toUtf8());
+    run.filter = QUrl::fromPercentEncoding(parts[1].toUtf8());
+    run.position = fields[0].toInt(&ok[0]);
+    run.temperature = fields[1].toDouble(&ok[1]);
+    run.altitude = fields[2].toDouble(&ok[2]);
+    run.stepSize = fields[3].toInt(&ok[3]);
+    run.value = fields[4].toDouble(&ok[4]);
+    run.halfWidth = fields[5].toDouble(&ok[5]);
+    run.cfz = fields[6].toDouble(&ok[6]);
+    run.curveFit = fields[7].toInt(&ok[7]);
+    if (std::find(std::begin(ok), std::end(ok), false) != std::end(ok))
+        return false;
+
+    if (!fields[8].isEmpty())
+    {
+        for (const QString &coefficient : fields[8].split(','))
+        {
+            bool valid;
+            run.coefficients.append(coefficient.toDouble(&valid));
+            if (!valid)
+                return false;
+        }
+    }
+    bool timeOK;
+    run.time = fields[9].toLongLong(&timeOK);
+    if (!timeOK)
+        return false;
+
+    *result = run;
+    return true;
+}
+
+void FocusModelStore::add(const Run &run)
+{
+    // Drop unreadable entries, and the oldest runs of the train and filter beyond MAX_RUNS
+    int kept = 0;
+    for (int i = m_Entries.size() - 1; i >= 0; --i)
+    {
+        Run r;
+        if (!parse(m_Entries[i], &r))
+            m_Entries.removeAt(i);
+        else if (r.train == run.train && r.filter == run.filter && ++kept >= MAX_RUNS)
+            m_Entries.removeAt(i);
+    }
+
+    m_Entries.append(encode(run));
+    while (m_Entries.size() > MAX_ENTRIES)
+        m_Entries.removeFirst();
+
+    qCDebug(KSTARS_EKOS_FOCUS) << QString("Stored focus run of train %1 filter %2 at %3, %4 runs stored")
+                               .arg(run.train, run.filter).arg(run.position).arg(m_Entries.size());
+}
+
+QVector<FocusModelStore::Run> FocusModelStore::runs(const QString &train, const QString &filter) const
+{
+    QVector<Run> result;
+    for (const auto &entry : m_Entries)
+    {
+        Run run;
+        if (parse(entry, &run) && run.train == train && run.filter == filter)
+            result.append(run);
+    }
+    return result;
+}
+
+FocusModelStore::Prediction FocusModelStore::predict(const QString &train, const QString &filter, double temperature,
+        double altitude, double ticksPerTemp, double ticksPerAlt) const
+{
+    Prediction prediction { false, 0, 0.0, false, -1.0, 0, 0.0, 0.0, 0 };
+    const QVector<Run> stored = runs(train, filter);
+    if (stored.isEmpty())
+        return prediction;
+
+    // Move every run to the current altitude
+    QVector<double> positions;
+    for (const Run &run : stored)
+    {
+        double position = run.position;
+        if (isKnown(altitude) && isKnown(run.altitude))
+            position += ticksPerAlt * (altitude - run.altitude);
+        positions.append(position);
+    }
+
+    const Run &newest = stored.last();
+    prediction.runs = stored.size();
+    prediction.halfWidth = newest.halfWidth;
+    prediction.cfz = newest.cfz;
+    prediction.stepSize = newest.stepSize;
+    prediction.ticksPerTemp = isKnown(temperature) ? ticksPerTemp : 0.0;
+
+    // Least squares fit of position against temperature, if the temperatures spread enough
+    double minTemp = 1e9, maxTemp = -1e9, sumT = 0, sumP = 0;
+    int n = 0;
+    for (int i = 0; i < stored.size(); i++)
+    {
+        if (!isKnown(stored[i].temperature))
+            continue;
+        minTemp = std::min(minTemp, stored[i].temperature);
+        maxTemp = std::max(maxTemp, stored[i].temperature);
+        sumT += stored[i].temperature;
+        sumP += positions[i];
+        n++;
+    }
+    if (isKnown(temperature) && n >= MIN_RUNS && maxTemp - minTemp >= MIN_TEMPERATURE_SPREAD)
+    {
+        const double meanT = sumT / n, meanP = sumP / n;
+        double stt = 0, stp = 0;
+        for (int i = 0; i < stored.size(); i++)
+        {
+            if (!isKnown(stored[i].temperature))
+                continue;
+            stt += (stored[i].temperature - meanT) * (stored[i].temperature - meanT);
+            stp += (stored[i].temperature - meanT) * (positions[i] - meanP);
+        }
+        const double slope = stp / stt;
+        double sse = 0;
+        for (int i = 0; i < stored.size(); i++)
+        {
+            if (!isKnown(stored[i].temperature))
+                continue;
+            const double residual = positions[i] - (meanP + slope * (stored[i].temperature - meanT));
+            sse += residual * residual;
+        }
+        prediction.valid = true;
+        prediction.position = static_cast<int>(std::round(meanP + slope * (temperature - meanT)));
+        prediction.ticksPerTemp = slope;
+        prediction.fittedTicksPerTemp = true;
+        prediction.residual = std::sqrt(sse / (n - 2));
+        return prediction;
+    }
+
+    // Otherwise move every run to the current temperature with the ticks per °C, and start from the newest
+    QVector<double> predicted;
+    for (int i = 0; i < stored.size(); i++)
+    {
+        double position = positions[i];
+        if (isKnown(temperature) && isKnown(stored[i].temperature))
+            position += ticksPerTemp * (temperature - stored[i].temperature);
+        predicted.append(position);
+    }
+    prediction.valid = true;
+    prediction.position = static_cast<int>(std::round(predicted.last()));
+    if (predicted.size() >= MIN_RUNS)
+    {
+        double sse = 0;
+        for (int i = 0; i < predicted.size() - 1; i++)
+            sse += (predicted[i] - predicted.last()) * (predicted[i] - predicted.last());
+        prediction.residual = std::sqrt(sse / (predicted.size() - 1));
+    }
+    return prediction;
+}
+
+bool FocusModelStore::narrowSteps(const Prediction &prediction, int stepSize, double userOutSteps, int userNumSteps,
+                                  double &outSteps, int &numSteps)
+{
+    outSteps = userOutSteps;
+    numSteps = userNumSteps;
+    if (!prediction.valid || prediction.runs < MIN_RUNS || prediction.residual < 0 || prediction.halfWidth <= 0
+            || stepSize <= 0)
+        return false;
+
+    // A prediction that is out by more than a step is no better than the user's steps
+    if (prediction.residual > stepSize)
+        return false;
+
+    const double extent = prediction.halfWidth + 2 * prediction.residual;
+    const int out = std::max(2, static_cast<int>(std::ceil(extent / stepSize)));
+    const double newOutSteps = std::min(userOutSteps, static_cast<double>(out));
+    const int newNumSteps = std::max(5, std::min(userNumSteps, 2 * out + 1));
+    if (newOutSteps >= userOutSteps && newNumSteps >= userNumSteps)
+        return false;
+
+    outSteps = newOutSteps;
+    numSteps = newNumSteps;
+    return true;
+}
+
+void FocusModelStore::remove(const QString &train)
+{
+    for (int i = m_Entries.size() - 1; i >= 0; --i)
+    {
+        Run run;
+        if (!parse(m_Entries[i], &run) || run.train == train)
+            m_Entries.removeAt(i);
+    }
+}
+
+}
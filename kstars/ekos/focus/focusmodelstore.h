@@ -0,0 +1,121 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace Ekos
+{
+
+// Keeps the results of the last successful autofocus runs of each optical train and filter, so that the
+// next run can start at the position predicted for the current temperature and altitude, with fewer
+// steps when the prediction has been good.
+//
+// A run keeps the solution, its temperature and altitude, the step size, the fitted curve and the
+// width of the curve around the minimum. The temperature coefficient is fitted to the runs once their
+// temperatures spread enough, until then the ticks per degree of the filter are used.
+//
+// The runs are stored in the FocusModelStore option, one entry per run: the percent-encoded train and
+// filter names separated by '|', a '|', and the fields of the run separated by ';'.
+class FocusModelStore
+{
+    public:
+        // Runs kept per train and filter, the oldest are dropped beyond this.
+        static constexpr int MAX_RUNS = 10;
+        // Runs kept in all.
+        static constexpr int MAX_ENTRIES = 200;
+        // Runs needed to trust a prediction enough to use fewer steps.
+        static constexpr int MIN_RUNS = 3;
+        // Spread of the temperatures of the runs, in °C, needed to fit the temperature coefficient.
+        static constexpr double MIN_TEMPERATURE_SPREAD = 1.0;
+        // Unknown temperatures and altitudes, as INVALID_VALUE of Ekos.
+        static constexpr double UNKNOWN = -1e6;
+
+        typedef struct
+        {
+            QString train;
+            QString filter;
+            int position;
+            double temperature;
+            double altitude;
+            int stepSize;
+            // Value of the curve at the solution, e.g. HFR
+            double value;
+            // Distance from the solution, in ticks, at which the curve is 1.5 times as bad as at the solution, 0 if unknown
+            double halfWidth;
+            // Critical focus zone in ticks
+            double cfz;
+            int curveFit;
+            QVector<double> coefficients;
+            // Seconds since the epoch
+            qint64 time;
+        } Run;
+
+        typedef struct
+        {
+            bool valid;
+            int position;
+            // Ticks per °C used, and whether it was fitted to the runs rather than taken from the filter
+            double ticksPerTemp;
+            bool fittedTicksPerTemp;
+            // RMS of the position residuals of the runs to the model in ticks, -1 if there are too few runs
+            double residual;
+            int runs;
+            // Of the newest run
+            double halfWidth;
+            double cfz;
+            int stepSize;
+        } Prediction;
+
+        // Reads the store from the options.
+        FocusModelStore();
+        // Uses the given entries, for tests.
+        explicit FocusModelStore(const QStringList &entries);
+
+        // Writes the store to the options.
+        void save() const;
+
+        // Adds a successful run.
+        void add(const Run &run);
+
+        // Returns the runs of train and filter, oldest first.
+        QVector<Run> runs(const QString &train, const QString &filter) const;
+
+        // Predicts the solution of a run of train and filter at the given temperature and altitude. The ticks per
+        // °C are used if the runs can't be fitted, the ticks per degree of altitude are always used.
+        Prediction predict(const QString &train, const QString &filter, double temperature, double altitude,
+                           double ticksPerTemp, double ticksPerAlt) const;
+
+        // Returns whether the prediction allows a run with fewer steps than the user's, and the number of outward
+        // steps and of steps to use with the given step size. The steps have to cover the width of the curve and
+        // twice the residual on both sides of the start position.
+        static bool narrowSteps(const Prediction &prediction, int stepSize, double userOutSteps, int userNumSteps,
+                                double &outSteps, int &numSteps);
+
+        // Removes all runs of train.
+        void remove(const QString &train);
+
+        bool isEmpty() const
+        {
+            return m_Entries.isEmpty();
+        }
+
+        const QStringList &entries() const
+        {
+            return m_Entries;
+        }
+
+    private:
+        static QString encode(const Run &run);
+        static bool parse(const QString &entry, Run *result);
+
+        QStringList m_Entries;
+};
+
+}
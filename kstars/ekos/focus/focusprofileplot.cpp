@@ -10,6 +10,7 @@
 FocusProfilePlot::FocusProfilePlot(QWidget *parent) : QCustomPlot (parent)
 {
     Q_UNUSED(parent);
+    m_Replot = new Ekos::ReplotScheduler(this);
 
     setBackground(QBrush(Qt::black));
     xAxis->setBasePen(QPen(Qt::white, 1));
@@ -85,7 +86,7 @@ void FocusProfilePlot::drawProfilePlot(double currentHFR)
     }
 
     rescaleAxes();
-    replot();
+    m_Replot->schedule();
 
     lastGausIndexes     = currentIndexes;
     lastGausFrequencies = currentFrequencies;
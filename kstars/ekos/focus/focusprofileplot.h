@@ -10,6 +10,7 @@
 #include <QObject>
 #include <QWidget>
 #include "qcustomplot.h"
+#include "ekos/auxiliary/replotscheduler.h"
 
 class FocusProfilePlot : public QCustomPlot
 {
@@ -32,4 +33,6 @@ private:
     QVector<double> lastGausIndexes;
     QVector<double> lastGausFrequencies;
 
+    Ekos::ReplotScheduler *m_Replot { nullptr };
+
 };
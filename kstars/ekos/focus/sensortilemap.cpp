@@ -0,0 +1,339 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "sensortilemap.h"
+
+#include "../../auxiliary/robuststatistics.h"
+#include "fitsviewer/fitsstardetector.h"
+
+#include <ekos_focus_debug.h>
+
+#include <cmath>
+#include <vector>
+
+namespace Ekos
+{
+
+SensorTileMap::SensorTileMap(int columns, int rows, int history)
+    : m_Columns(std::max(1, columns)), m_Rows(std::max(1, rows)), m_History(std::max(1, history))
+{
+    resetStats();
+}
+
+void SensorTileMap::setSensorSize(int width, int height)
+{
+    if (m_Grid && width == m_Width && height == m_Height && !m_Tiles.isEmpty())
+        return;
+
+    m_Width = width;
+    m_Height = height;
+    m_Grid = true;
+    m_Tiles.clear();
+    for (int row = 0; row < m_Rows; row++)
+    {
+        const int y0 = row * height / m_Rows;
+        const int y1 = (row + 1) * height / m_Rows;
+        for (int column = 0; column < m_Columns; column++)
+        {
+            const int x0 = column * width / m_Columns;
+            const int x1 = (column + 1) * width / m_Columns;
+            m_Tiles.append(QRect(x0, y0, x1 - x0, y1 - y0));
+        }
+    }
+    resetStats();
+}
+
+void SensorTileMap::setTiles(const QVector<QRect> &tiles, int width, int height)
+{
+    if (tiles.size() != tileCount())
+    {
+        qCWarning(KSTARS_EKOS_FOCUS) << QString("SensorTileMap: %1 tiles passed for a %2x%3 map").arg(tiles.size())
+                                     .arg(m_Columns).arg(m_Rows);
+        return;
+    }
+    if (!m_Grid && tiles == m_Tiles && width == m_Width && height == m_Height)
+        return;
+
+    m_Width = width;
+    m_Height = height;
+    m_Grid = false;
+    m_Tiles = tiles;
+    resetStats();
+}
+
+int SensorTileMap::tileAt(double x, double y) const
+{
+    if (m_Tiles.isEmpty())
+        return -1;
+
+    if (m_Grid)
+    {
+        if (x < 0 || y < 0 || x >= m_Width || y >= m_Height)
+            return -1;
+        const int column = std::min(m_Columns - 1, static_cast<int>(x * m_Columns / m_Width));
+        const int row = std::min(m_Rows - 1, static_cast<int>(y * m_Rows / m_Height));
+        return row * m_Columns + column;
+    }
+
+    const QPoint point(static_cast<int>(x), static_cast<int>(y));
+    for (int tile = 0; tile < m_Tiles.size(); tile++)
+    {
+        if (m_Tiles[tile].contains(point))
+            return tile;
+    }
+    return -1;
+}
+
+QVector<QList<Edge *>> SensorTileMap::binStars(const QList<Edge *> &stars) const
+{
+    QVector<QList<Edge *>> tileStars(tileCount());
+    for (Edge *star : stars)
+    {
+        const int tile = tileAt(star->x, star->y);
+        if (tile >= 0)
+            tileStars[tile].append(star);
+    }
+    return tileStars;
+}
+
+void SensorTileMap::addStars(const QList<Edge *> &stars)
+{
+    for (const Edge *star : stars)
+    {
+        if (star->HFR > 0)
+            addMeasure(tileAt(star->x, star->y), star->HFR);
+    }
+}
+
+void SensorTileMap::addMeasure(int tile, double measure)
+{
+    if (tile < 0 || tile >= tileCount())
+        return;
+
+    QVector<double> &measures = m_Measures[tile];
+    if (measures.size() < m_History)
+        measures.append(measure);
+    else
+    {
+        measures[m_Next[tile]] = measure;
+        m_Next[tile] = (m_Next[tile] + 1) % m_History;
+    }
+    m_Dirty[tile] = true;
+}
+
+void SensorTileMap::reset()
+{
+    resetStats();
+}
+
+void SensorTileMap::resetStats()
+{
+    const int count = tileCount();
+    m_Measures.fill(QVector<double>(), count);
+    m_Next.fill(0, count);
+    m_Stats.fill(TileStats { 0.0, 0.0, 0 }, count);
+    m_Dirty.fill(false, count);
+}
+
+SensorTileMap::TileStats SensorTileMap::stats(int tile) const
+{
+    if (tile < 0 || tile >= tileCount())
+        return TileStats { 0.0, 0.0, 0 };
+
+    if (m_Dirty[tile])
+    {
+        const QVector<double> &measures = m_Measures[tile];
+        std::vector<double> data(measures.constBegin(), measures.constEnd());
+        TileStats &stats = m_Stats[tile];
+        stats.count = static_cast<int>(data.size());
+        stats.location = Mathematics::RobustStatistics::ComputeLocation(
+                             Mathematics::RobustStatistics::LOCATION_SIGMACLIPPING, data, 2);
+        stats.scale = Mathematics::RobustStatistics::ComputeScale(Mathematics::RobustStatistics::SCALE_MAD, data);
+        m_Dirty[tile] = false;
+    }
+    return m_Stats[tile];
+}
+
+QPointF SensorTileMap::tileCentre(int tile) const
+{
+    if (tile < 0 || tile >= m_Tiles.size())
+        return QPointF();
+
+    const QRect &rect = m_Tiles[tile];
+    return QPointF(rect.x() + rect.width() / 2.0 - m_Width / 2.0, m_Height / 2.0 - (rect.y() + rect.height() / 2.0));
+}
+
+void SensorTileMap::collect(int minStars, QVector<double> &values, QVector<bool> &valid, QVector<double> *distances) const
+{
+    const int count = tileCount();
+    values.resize(count);
+    valid.resize(count);
+    if (distances)
+        distances->resize(count);
+
+    for (int tile = 0; tile < count; tile++)
+    {
+        const TileStats tileStats = stats(tile);
+        values[tile] = tileStats.location;
+        valid[tile] = tileStats.count > 0 && tileStats.count >= minStars;
+        if (distances)
+        {
+            const QPointF centre = tileCentre(tile);
+            (*distances)[tile] = std::hypot(centre.x(), centre.y());
+        }
+    }
+}
+
+bool SensorTileMap::calcTilt(double scale, double pixelSize, Tilt &tilt, int minStars) const
+{
+    if (m_Tiles.isEmpty())
+        return false;
+
+    QVector<double> values;
+    QVector<bool> valid;
+    collect(minStars, values, valid, nullptr);
+
+    const double LRSpan = (tileCentre(m_Columns - 1).x() - tileCentre(0).x()) * pixelSize;
+    const double TBSpan = (tileCentre(0).y() - tileCentre((m_Rows - 1) * m_Columns).y()) * pixelSize;
+    return calcTilt(m_Columns, m_Rows, values, valid, scale, LRSpan, TBSpan, tilt);
+}
+
+bool SensorTileMap::calcBackfocusDelta(TileSelection tileSelection, double scale, double &backfocusDelta,
+                                       int minStars) const
+{
+    backfocusDelta = 0.0;
+    if (m_Tiles.isEmpty())
+        return false;
+
+    QVector<double> values, distances;
+    QVector<bool> valid;
+    collect(minStars, values, valid, &distances);
+    return calcBackfocusDelta(m_Columns, m_Rows, values, valid, distances, tileSelection, scale, backfocusDelta);
+}
+
+bool SensorTileMap::calcTilt(int columns, int rows, const QVector<double> &values, const QVector<bool> &valid,
+                             double scale, double LRSpan, double TBSpan, Tilt &tilt)
+{
+    tilt.deltas.clear();
+    tilt.LR = tilt.TB = tilt.diagonal = 0.0;
+    tilt.LRPercent = tilt.TBPercent = tilt.diagonalPercent = 0.0;
+
+    // There has to be a centre tile, and a tile each side of it
+    if (columns < 3 || rows < 3 || columns % 2 == 0 || rows % 2 == 0)
+        return false;
+    const int count = columns * rows;
+    if (values.size() != count || valid.size() != count)
+        return false;
+
+    // Firstly check that we have a valid central tile - we can't do anything without that
+    const int centre = (rows / 2) * columns + columns / 2;
+    if (!valid[centre])
+        return false;
+
+    // Calculate the deltas relative to the centre tile
+    for (int tile = 0; tile < count; tile++)
+        tilt.deltas.append((values[centre] - values[tile]) * scale);
+
+    // Average the valid deltas of a column or a row. If any of the sides can't be averaged the whole calculation fails.
+    auto average = [&](int first, int step, double & result)
+    {
+        double sum = 0.0;
+        int counter = 0;
+        const int length = (step == 1) ? columns : rows;
+        for (int i = 0, tile = first; i < length; i++, tile += step)
+        {
+            if (valid[tile])
+            {
+                sum += tilt.deltas[tile];
+                counter++;
+            }
+        }
+        if (counter > 0)
+            result = sum / counter;
+        return counter > 0;
+    };
+
+    double avLeft, avRight, avTop, avBottom;
+    if (!average(0, columns, avLeft) || !average(columns - 1, columns, avRight) ||
+            !average(0, 1, avTop) || !average((rows - 1) * columns, 1, avBottom))
+        return false;
+
+    tilt.LR = avLeft - avRight;
+    tilt.TB = avTop - avBottom;
+    tilt.diagonal = std::hypot(tilt.LR, tilt.TB);
+
+    // Calculate the tilt as a % slope
+    tilt.LRPercent = (LRSpan > 0.0) ? tilt.LR / LRSpan * 100.0 : 0.0;
+    tilt.TBPercent = (TBSpan > 0.0) ? tilt.TB / TBSpan * 100.0 : 0.0;
+    tilt.diagonalPercent = std::hypot(tilt.LRPercent, tilt.TBPercent);
+    return true;
+}
+
+bool SensorTileMap::calcBackfocusDelta(int columns, int rows, const QVector<double> &values, const QVector<bool> &valid,
+                                       const QVector<double> &distances, TileSelection tileSelection, double scale,
+                                       double &backfocusDelta)
+{
+    backfocusDelta = 0.0;
+
+    if (columns < 3 || rows < 3 || columns % 2 == 0 || rows % 2 == 0)
+        return false;
+    const int count = columns * rows;
+    if (values.size() != count || valid.size() != count || distances.size() != count)
+        return false;
+
+    // Firstly check that we have a valid central tile - we can't do anything without that
+    const int centre = (rows / 2) * columns + columns / 2;
+    if (!valid[centre])
+        return false;
+
+    double sum = 0.0, counter = 0.0;
+    auto addTile = [&](int tile, bool weighted)
+    {
+        if (tile == centre || !valid[tile])
+            return;
+        const double weight = weighted ? distances[tile] : 1.0;
+        sum += values[tile] * weight;
+        counter += weight;
+    };
+
+    switch(tileSelection)
+    {
+        case TILES_ALL:
+            // Use all useable tiles weighted by their distance from the centre
+            for (int tile = 0; tile < count; tile++)
+                addTile(tile, true);
+            break;
+
+        case TILES_OUTER_CORNERS:
+            // All tiles are diagonal from centre... so no need to weight the calc
+            addTile(0, false);
+            addTile(columns - 1, false);
+            addTile((rows - 1) * columns, false);
+            addTile(count - 1, false);
+            break;
+
+        case TILES_INNER_DIAMOND:
+            // The middle tiles of each side are different distances from centre... so need to weight the calc
+            addTile(columns / 2, true);
+            addTile(centre - columns / 2, true);
+            addTile(centre + columns / 2, true);
+            addTile(count - 1 - columns / 2, true);
+            break;
+
+        default:
+            qCDebug(KSTARS_EKOS_FOCUS) << QString("%1 called with invalid tile selection %2").arg(__FUNCTION__).arg(tileSelection);
+            return false;
+    }
+
+    if (counter == 0)
+        // No valid tiles so can't complete the calc
+        return false;
+
+    backfocusDelta = (values[centre] - (sum / counter)) * scale;
+    return true;
+}
+
+}
@@ -0,0 +1,182 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QList>
+#include <QPointF>
+#include <QRect>
+#include <QVector>
+
+class Edge;
+
+namespace Ekos
+{
+
+// SensorTileMap bins the stars of a frame into a grid of tiles over the sensor and keeps running, robust
+// statistics of a star measure (e.g. HFR) for each tile. The stars are those of the detection already run on
+// the frame, so the map costs a pass over the star list and can be fed every frame, e.g. every light frame,
+// to monitor tilt continuously.
+//
+// The tilt and backfocus computations of Aberration Inspector also live here. They work on one value per tile:
+// Aberration Inspector passes the best focus position of the tiles, the running map its star measure.
+//
+// Tiles are numbered row major from the top left, so a 3x3 map uses the order of tileID.
+class SensorTileMap
+{
+    public:
+        typedef enum { TILES_ALL, TILES_OUTER_CORNERS, TILES_INNER_DIAMOND } TileSelection;
+
+        typedef struct
+        {
+            // Robust location and scale of the measures in the tile
+            double location;
+            double scale;
+            int count;
+        } TileStats;
+
+        typedef struct
+        {
+            // The value of the centre tile minus the value of each tile, times the scale
+            QVector<double> deltas;
+            // Left minus right, top minus bottom and their combination, in the unit of the deltas
+            double LR;
+            double TB;
+            double diagonal;
+            // The same as percent slopes over the spans between the outer tiles
+            double LRPercent;
+            double TBPercent;
+            double diagonalPercent;
+        } Tilt;
+
+        /**
+         * @brief create a map of columns x rows tiles
+         * @param history number of measures kept per tile for the running statistics
+         */
+        SensorTileMap(int columns = 3, int rows = 3, int history = 500);
+
+        int columns() const
+        {
+            return m_Columns;
+        }
+        int rows() const
+        {
+            return m_Rows;
+        }
+        int tileCount() const
+        {
+            return m_Columns * m_Rows;
+        }
+
+        /**
+         * @brief split a sensor of the given size into the tiles. The statistics are reset if that changes the tiles.
+         */
+        void setSensorSize(int width, int height);
+
+        /**
+         * @brief use the given tiles, e.g. those of a mosaic mask, instead of the full sensor grid
+         * @param tiles columns x rows rectangles in image coordinates, row major
+         * @param width of the sensor
+         * @param height of the sensor
+         */
+        void setTiles(const QVector<QRect> &tiles, int width, int height);
+
+        const QVector<QRect> &tiles() const
+        {
+            return m_Tiles;
+        }
+
+        /**
+         * @brief the tile containing the given pixel, or -1
+         */
+        int tileAt(double x, double y) const;
+
+        /**
+         * @brief sort stars into the tiles, without changing the statistics
+         */
+        QVector<QList<Edge *>> binStars(const QList<Edge *> &stars) const;
+
+        /**
+         * @brief add the HFRs of the stars of one frame to the statistics
+         */
+        void addStars(const QList<Edge *> &stars);
+
+        /**
+         * @brief add a measure to the statistics of a tile
+         */
+        void addMeasure(int tile, double measure);
+
+        /**
+         * @brief forget all measures
+         */
+        void reset();
+
+        /**
+         * @brief robust statistics of the measures of a tile, count is 0 if there are none
+         */
+        TileStats stats(int tile) const;
+
+        /**
+         * @brief the centre of a tile relative to the sensor centre, in pixels, y pointing up
+         */
+        QPointF tileCentre(int tile) const;
+
+        /**
+         * @brief tilt from the running statistics, tiles need at least minStars measures
+         * @param scale multiplies the measure differences
+         * @param pixelSize of the sensor, for the percent slopes
+         */
+        bool calcTilt(double scale, double pixelSize, Tilt &tilt, int minStars = 5) const;
+
+        /**
+         * @brief backfocus delta from the running statistics, see the static version
+         */
+        bool calcBackfocusDelta(TileSelection tileSelection, double scale, double &backfocusDelta, int minStars = 5) const;
+
+        /**
+         * @brief tilt from one value per tile. Needs an odd grid so there is a centre tile.
+         * @param values one per tile
+         * @param valid whether to use the value of each tile, the centre tile has to be valid
+         * @param scale multiplies the value differences, e.g. the microns per focuser step
+         * @param LRSpan horizontal distance between the centres of the outer tiles, in the unit of the scaled values
+         * @param TBSpan vertical distance between the centres of the outer tiles
+         */
+        static bool calcTilt(int columns, int rows, const QVector<double> &values, const QVector<bool> &valid,
+                             double scale, double LRSpan, double TBSpan, Tilt &tilt);
+
+        /**
+         * @brief difference between the value of the centre tile and the average of the selected outer tiles, times
+         * the scale. Tiles at different distances from the centre are weighted by the distance.
+         * @param distances of the tile centres from the sensor centre
+         */
+        static bool calcBackfocusDelta(int columns, int rows, const QVector<double> &values, const QVector<bool> &valid,
+                                       const QVector<double> &distances, TileSelection tileSelection, double scale,
+                                       double &backfocusDelta);
+
+    private:
+        void resetStats();
+        // The values, validity and distances of the tiles from the running statistics
+        void collect(int minStars, QVector<double> &values, QVector<bool> &valid, QVector<double> *distances) const;
+
+        int m_Columns { 3 };
+        int m_Rows { 3 };
+        int m_History { 500 };
+        int m_Width { 0 };
+        int m_Height { 0 };
+        QVector<QRect> m_Tiles;
+        // Whether the tiles split the sensor evenly, then tileAt() needn't search
+        bool m_Grid { true };
+
+        // Ring buffer of the latest measures of each tile
+        QVector<QVector<double>> m_Measures;
+        QVector<int> m_Next;
+
+        // Statistics are recomputed when asked for after new measures
+        mutable QVector<TileStats> m_Stats;
+        mutable QVector<bool> m_Dirty;
+};
+
+}
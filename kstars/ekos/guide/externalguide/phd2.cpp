@@ -15,6 +15,7 @@
 #include "ekos/guide/guide.h"
 #include "fitsviewer/fitsview.h"
 
+#include <array>
 #include <cassert>
 #include <fitsio.h>
 #include <KMessageBox>
@@ -27,6 +28,44 @@
 
 #define MAX_SET_CONNECTED_RETRIES   3
 
+namespace
+{
+// Decodes the base64 text into exactly size bytes of destination, returns false if the text doesn't hold them.
+bool decodeBase64(const QString &text, uint8_t *destination, int64_t size)
+{
+    static const auto values = []
+    {
+        std::array<int8_t, 128> table;
+        table.fill(-1);
+        const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (int i = 0; i < 64; ++i)
+            table[static_cast<uint8_t>(alphabet[i])] = i;
+        return table;
+    }();
+
+    uint32_t bits = 0;
+    int count = 0;
+    int64_t written = 0;
+    for (const QChar c : text)
+    {
+        const ushort u = c.unicode();
+        if (u == '=')
+            break;
+        if (u >= values.size() || values[u] < 0 || written == size)
+            return false;
+
+        bits = (bits << 6) | values[u];
+        count += 6;
+        if (count >= 8)
+        {
+            count -= 8;
+            destination[written++] = static_cast<uint8_t>(bits >> count);
+        }
+    }
+    return written == size;
+}
+}
+
 namespace Ekos
 {
 PHD2::PHD2()
@@ -326,15 +365,16 @@ void PHD2::processPHD2Event(const QJsonObject &jsonEvent, const QByteArray &line
     if (Options::verboseLogging())
         qCDebug(KSTARS_EKOS_GUIDE) << "PHD2: event:" << line;
 
-    QString eventName = jsonEvent["Event"].toString();
+    const QString eventName = jsonEvent["Event"].toString();
 
-    if (!events.contains(eventName))
+    const auto known = events.constFind(eventName);
+    if (known == events.constEnd())
     {
         emit newLog(i18n("Unknown PHD2 event: %1", eventName));
         return;
     }
 
-    event = events.value(eventName);
+    event = known.value();
 
     switch (event)
     {
@@ -1019,79 +1059,33 @@ void PHD2::setGuideView(const QSharedPointer<FITSView> &guideView)
 void PHD2::processStarImage(const QJsonObject &jsonStarFrame)
 {
     //The width and height of the received PHD2 Star Image
-    int width =  jsonStarFrame["width"].toInt();
-    int height = jsonStarFrame["height"].toInt();
-
-    //This section sets up the FITS File
-    fitsfile *fptr = nullptr;
-    int status = 0;
-    long fpixel = 1, naxis = 2, nelements, exposure;
-    long naxes[2] = { width, height };
-    char error_status[512] = {0};
-
-    void* fits_buffer = nullptr;
-    size_t fits_buffer_size = 0;
-    if (fits_create_memfile(&fptr, &fits_buffer, &fits_buffer_size, 4096, realloc, &status))
-    {
-        qCWarning(KSTARS_EKOS_GUIDE) << "fits_create_file failed:" << error_status;
-        return;
-    }
-
-    if (fits_create_img(fptr, USHORT_IMG, naxis, naxes, &status))
-    {
-        qCWarning(KSTARS_EKOS_GUIDE) << "fits_create_img failed:" << error_status;
-        status = 0;
-        fits_close_file(fptr, &status);
-        free(fits_buffer);
-        return;
-    }
-
-    //Note, this is made up.  If you want the actual exposure time, you have to request it from PHD2
-    exposure = 1;
-    fits_update_key(fptr, TLONG, "EXPOSURE", &exposure, "Total Exposure Time", &status);
-
-    //This section takes the Pixels from the JSON Document
-    //Then it converts from base64 to a QByteArray
-    //Then it creates a datastream from the QByteArray to the pixel array for the FITS File
-    QByteArray converted = QByteArray::fromBase64(jsonStarFrame["pixels"].toString().toLocal8Bit());
-
-    //This finishes up and closes the FITS file
-    nelements = naxes[0] * naxes[1];
-    if (fits_write_img(fptr, TUSHORT, fpixel, nelements, converted.data(), &status))
-    {
-        fits_get_errstatus(status, error_status);
-        qCWarning(KSTARS_EKOS_GUIDE) << "fits_write_img failed:" << error_status;
-        status = 0;
-        fits_close_file(fptr, &status);
-        free(fits_buffer);
+    const int width =  jsonStarFrame["width"].toInt();
+    const int height = jsonStarFrame["height"].toInt();
+    if (width <= 0 || height <= 0 || m_GuideFrame.isNull())
         return;
-    }
 
-    if (fits_flush_file(fptr, &status))
-    {
-        fits_get_errstatus(status, error_status);
-        qCWarning(KSTARS_EKOS_GUIDE) << "fits_flush_file failed:" << error_status;
-        status = 0;
-        fits_close_file(fptr, &status);
-        free(fits_buffer);
-        return;
-    }
+    //The pixels are 16 bit, base64 encoded. They are decoded straight into the image buffer of a guide frame,
+    //which comes from the frame pool, without going through a FITS file.
+    FITSImage::Statistic stats;
+    stats.width = width;
+    stats.height = height;
+    stats.dataType = TUSHORT;
+    stats.bytesPerPixel = sizeof(uint16_t);
+    stats.samples_per_channel = width * height;
+    stats.size = stats.samples_per_channel * stats.bytesPerPixel;
 
-    if (fits_close_file(fptr, &status))
+    QSharedPointer<FITSData> fdata;
+    fdata.reset(new FITSData(FITS_GUIDE), &QObject::deleteLater);
+    uint8_t *buffer = fdata->createImageBuffer(stats);
+    if (!decodeBase64(jsonStarFrame["pixels"].toString(), buffer, stats.size))
     {
-        fits_get_errstatus(status, error_status);
-        qCWarning(KSTARS_EKOS_GUIDE) << "fits_close_file failed:" << error_status;
-        free(fits_buffer);
+        qCWarning(KSTARS_EKOS_GUIDE) << "PHD2: invalid star image of" << width << "x" << height << "pixels";
         return;
     }
+    fdata->calculateStats(true);
 
-    //This loads the FITS file in the Guide FITSView
+    //This loads the star image in the Guide FITSView
     //Then it updates the Summary Screen
-    QSharedPointer<FITSData> fdata;
-    QByteArray buffer = QByteArray::fromRawData(reinterpret_cast<char *>(fits_buffer), fits_buffer_size);
-    fdata.reset(new FITSData(), &QObject::deleteLater);
-    fdata->loadFromBuffer(buffer, "fits");
-    free(fits_buffer);
     m_GuideFrame->loadData(fdata);
 
     m_GuideFrame->updateFrame();
@@ -1281,6 +1275,12 @@ void PHD2::requestStarImage(int size)
         return;
     }
 
+    // The star image is only displayed, it doesn't have to follow every guide step
+    const double interval = Options::pHD2StarImageInterval();
+    if (interval > 0 && m_StarImageTimer.isValid() && m_StarImageTimer.elapsed() < interval * 1000)
+        return;
+    m_StarImageTimer.start();
+
     QJsonArray args2;
     args2 << size; // This is both the width and height.
     sendPHD2Request("get_star_image", args2);
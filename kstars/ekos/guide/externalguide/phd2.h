@@ -9,6 +9,7 @@
 #include "../guideinterface.h"
 
 #include <QAbstractSocket>
+#include <QElapsedTimer>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QPointer>
@@ -251,6 +252,7 @@ class PHD2 : public GuideInterface
         int pendingRpcId;                         // ID of outstanding RPC call
         PHD2ResultType pendingRpcResultType { NO_RESULT };      // result type of outstanding RPC call
         bool starImageRequested { false };        // true when there is an outstanding star image request
+        QElapsedTimer m_StarImageTimer;           // time since the last star image request
 
         struct RpcCall
         {
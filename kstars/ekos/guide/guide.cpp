@@ -704,6 +704,11 @@ bool Guide::setGuider(ISD::Guider * device)
         {
             guideB->setEnabled(false);
         });
+        connect(m_Guider, &ISD::Guider::pulsesAcknowledged, this, [this]()
+        {
+            if (internalGuider)
+                internalGuider->pulsesAcknowledged();
+        });
     }
 
     guideB->setEnabled(m_Guider && m_Guider->isConnected());
@@ -894,7 +899,7 @@ void Guide::setBusy(bool enable)
         if (calibrationComplete ||
                 ((guiderType == GUIDE_INTERNAL) &&
                  Options::reuseGuideCalibration() &&
-                 !Options::serializedCalibration().isEmpty()))
+                 (!Options::serializedCalibration().isEmpty() || !Options::guideCalibrationStore().isEmpty())))
             clearCalibrationB->setEnabled(true);
         guideB->setEnabled(true);
         stopB->setEnabled(false);
@@ -1012,9 +1017,18 @@ void Guide::processData(const QSharedPointer<FITSData> &data)
         return;
     }
 
+    // While guiding, the frame goes to the guider first and is displayed once the pulses are
+    // out, rendering the view would only add to the latency of the correction.
+    const bool pulsesFirst = data && guiderType == GUIDE_INTERNAL && m_State == GUIDE_GUIDING &&
+                             operationStack.isEmpty();
+
+    m_PendingViewData.reset();
     if (data)
     {
-        m_GuideView->loadData(data);
+        if (pulsesFirst)
+            m_PendingViewData = data;
+        else
+            m_GuideView->loadData(data);
         m_ImageData = data;
     }
     else
@@ -1134,6 +1148,12 @@ void Guide::setCaptureComplete()
             break;
     }
 
+    if (m_PendingViewData)
+    {
+        m_GuideView->loadData(m_PendingViewData);
+        m_PendingViewData.reset();
+    }
+
     emit newImage(m_GuideView);
     emit newStarPixmap(m_GuideView->getTrackingBoxPixmap(10));
 }
@@ -1844,6 +1864,7 @@ bool Guide::setGuiderType(int type)
             connect(internalGuider, &InternalGuider::newSinglePulse, this, &Guide::sendSinglePulse);
             connect(internalGuider, &InternalGuider::DESwapChanged, this, &Guide::setDECSwap);
             connect(internalGuider, &InternalGuider::newStarPixmap, this, &Guide::newStarPixmap);
+            connect(internalGuider, &InternalGuider::newGuideLatency, this, &Guide::setGuideLatency);
 
             m_GuiderInstance = internalGuider;
 
@@ -2173,6 +2194,18 @@ QList<double> Guide::axisSigma()
     return sigma;
 }
 
+QList<double> Guide::guideLatency()
+{
+    return m_GuideLatency;
+}
+
+void Guide::setGuideLatency(double starFound, double pulseSent, double pulseAcknowledged)
+{
+    m_GuideLatency = { starFound, pulseSent, pulseAcknowledged };
+
+    emit newGuideLatency(starFound, pulseSent, pulseAcknowledged);
+}
+
 void Guide::setAxisPulse(double ra, double de)
 {
     l_PulseRA->setText(QString::number(static_cast<int>(ra)));
@@ -3157,6 +3190,7 @@ void Guide::refreshOpticalTrain()
         auto name = OpticalTrainManager::Instance()->name(id);
 
         opticalTrainCombo->setCurrentText(name);
+        internalGuider->setOpticalTrain(name);
 
         auto scope = OpticalTrainManager::Instance()->getScope(name);
         m_FocalLength = scope["focal_length"].toDouble(-1);
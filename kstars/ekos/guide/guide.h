@@ -59,6 +59,7 @@ class Guide : public QWidget, public Ui::Guide
         Q_PROPERTY(double exposure READ exposure WRITE setExposure)
         Q_PROPERTY(QList<double> axisDelta READ axisDelta NOTIFY newAxisDelta)
         Q_PROPERTY(QList<double> axisSigma READ axisSigma NOTIFY newAxisSigma)
+        Q_PROPERTY(QList<double> guideLatency READ guideLatency NOTIFY newGuideLatency)
 
     public:
         Guide();
@@ -297,6 +298,14 @@ class Guide : public QWidget, public Ui::Guide
          */
         Q_SCRIPTABLE QList<double> axisSigma();
 
+        /** DBUS interface function.
+         * @brief guideLatency returns the latency of the last corrected guide frame of the internal guider, in milliseconds
+         * after the frame reached the guider.
+         * @return List of doubles: the times at which the star was found, the pulses were sent and the driver acknowledged them.
+         * Empty if there was no correction yet.
+         */
+        Q_SCRIPTABLE QList<double> guideLatency();
+
         /**
               * @brief checkCamera Check all CCD parameters and ensure all variables are updated to reflect the selected CCD
               * @param ccdNum CCD index number in the CCD selection combo box
@@ -417,6 +426,7 @@ class Guide : public QWidget, public Ui::Guide
         void setAxisDelta(double ra, double de);
         void setAxisSigma(double ra, double de);
         void setAxisPulse(double ra, double de);
+        void setGuideLatency(double starFound, double pulseSent, double pulseAcknowledged);
         void setSNR(double snr);
         void calibrationUpdate(GuideInterface::CalibrationUpdateType type, const QString &message = QString(""), double dx = 0,
                                double dy = 0);
@@ -447,6 +457,8 @@ class Guide : public QWidget, public Ui::Guide
         void newAxisDelta(double ra, double de);
         // Sigma deviations in arcsecs RMS
         void newAxisSigma(double ra, double de);
+        // Latency of the internal guider in milliseconds, see guideLatency()
+        void newGuideLatency(double starFound, double pulseSent, double pulseAcknowledged);
 
         void guideStats(double raError, double decError, int raPulse, int decPulse,
                         double snr, double skyBg, int numStars);
@@ -648,6 +660,9 @@ class Guide : public QWidget, public Ui::Guide
         QPointer<LinGuider> linGuider;
         QSharedPointer<FITSViewer> fv;
         QSharedPointer<FITSData> m_ImageData;
+        /// Frame received while guiding, displayed once its pulses are out, see processData()
+        QSharedPointer<FITSData> m_PendingViewData;
+        QList<double> m_GuideLatency;
 
         // Dark Processor
         QPointer<DarkProcessor> m_DarkProcessor;
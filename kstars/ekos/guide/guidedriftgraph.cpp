@@ -18,6 +18,8 @@
 GuideDriftGraph::GuideDriftGraph(QWidget *parent)
 {
     Q_UNUSED(parent);
+    m_Replot = new Ekos::ReplotScheduler(this);
+
     // Drift Graph Color Settings
     setBackground(QBrush(Qt::black));
     xAxis->setBasePen(QPen(Qt::white, 1));
@@ -202,7 +204,7 @@ void GuideDriftGraph::guideHistory(int sliderValue, bool graphOnLatestPt)
             xAxis->setRange(t - xAxis->range().size(), t);
         }
     }
-    replot();
+    m_Replot->schedule();
     double snr = 0;
     if (graph(GuideGraph::G_SNR)->data()->size() > 0)
         snr = graph(GuideGraph::G_SNR)->dataMainValue(sliderValue);
@@ -318,7 +320,7 @@ void GuideDriftGraph::autoScaleGraphs()
     // This is only called when the autoScale button is pressed.
     graph(GuideGraph::G_RA)->rescaleValueAxis(false, true);
     graph(GuideGraph::G_DEC)->rescaleValueAxis(true, true);
-    replot();
+    m_Replot->schedule();
 }
 
 void GuideDriftGraph::zoomX(int zoomLevel)
@@ -338,20 +340,20 @@ void GuideDriftGraph::zoomX(int zoomLevel)
 void GuideDriftGraph::zoomInX()
 {
     zoomX(driftGraphZoomLevel - 1);
-    replot();
+    m_Replot->schedule();
 }
 
 void GuideDriftGraph::zoomOutX()
 {
     zoomX(driftGraphZoomLevel + 1);
-    replot();
+    m_Replot->schedule();
 }
 
 void GuideDriftGraph::setCorrectionGraphScale(int value)
 {
     yAxis2->setRange(yAxis->range().lower * value,
                      yAxis->range().upper * value);
-    replot();
+    m_Replot->schedule();
 }
 
 void GuideDriftGraph::clear()
@@ -368,7 +370,7 @@ void GuideDriftGraph::clear()
     graph(GuideGraph::G_RMS)->data()->clear(); //RMS
     clearItems();  //Clears dither text items from the graph
     setupNSEWLabels();
-    replot();
+    m_Replot->schedule();
 }
 
 void GuideDriftGraph::toggleShowPlot(GuideGraph::DRIFT_GRAPH_INDICES plot, bool isChecked)
@@ -380,14 +382,14 @@ void GuideDriftGraph::toggleShowPlot(GuideGraph::DRIFT_GRAPH_INDICES plot, bool
             graph(GuideGraph::G_RA)->setVisible(isChecked);
             graph(GuideGraph::G_RA_HIGHLIGHT)->setVisible(isChecked);
             setRMSVisibility();
-            replot();
+            m_Replot->schedule();
             break;
         case GuideGraph::G_DEC:
             Options::setDEDisplayedOnGuideGraph(isChecked);
             graph(GuideGraph::G_DEC)->setVisible(isChecked);
             graph(GuideGraph::G_DEC_HIGHLIGHT)->setVisible(isChecked);
             setRMSVisibility();
-            replot();
+            m_Replot->schedule();
             break;
         case GuideGraph::G_RA_PULSE:
             Options::setRACorrDisplayedOnGuideGraph(isChecked);
@@ -402,12 +404,12 @@ void GuideDriftGraph::toggleShowPlot(GuideGraph::DRIFT_GRAPH_INDICES plot, bool
         case GuideGraph::G_SNR:
             Options::setSNRDisplayedOnGuideGraph(isChecked);
             graph(GuideGraph::G_SNR)->setVisible(isChecked);
-            replot();
+            m_Replot->schedule();
             break;
         case GuideGraph::G_RMS:
             Options::setRMSDisplayedOnGuideGraph(isChecked);
             setRMSVisibility();
-            replot();
+            m_Replot->schedule();
             break;
         default:
             break;
@@ -536,6 +538,8 @@ void GuideDriftGraph::setAxisDelta(double ra, double de)
 
     graph(GuideGraph::G_RA)->addData(key, ra);
     graph(GuideGraph::G_DEC)->addData(key, de);
+    Ekos::ReplotScheduler::limitPoints(*graph(GuideGraph::G_RA)->data(), Options::guideGraphMaxPoints());
+    Ekos::ReplotScheduler::limitPoints(*graph(GuideGraph::G_DEC)->data(), Options::guideGraphMaxPoints());
 
     if(graphOnLatestPt)
     {
@@ -545,7 +549,7 @@ void GuideDriftGraph::setAxisDelta(double ra, double de)
         graph(GuideGraph::G_RA_HIGHLIGHT)->addData(key, ra); //Set highlighted RA point to latest point
         graph(GuideGraph::G_DEC_HIGHLIGHT)->addData(key, de); //Set highlighted DEC point to latest point
     }
-    replot();
+    m_Replot->schedule();
 }
 
 void GuideDriftGraph::setAxisSigma(double ra, double de)
@@ -555,6 +559,9 @@ void GuideDriftGraph::setAxisSigma(double ra, double de)
     graph(GuideGraph::G_RA_RMS)->addData(key, ra);
     graph(GuideGraph::G_DEC_RMS)->addData(key, de);
     graph(GuideGraph::G_RMS)->addData(key, total);
+    Ekos::ReplotScheduler::limitPoints(*graph(GuideGraph::G_RA_RMS)->data(), Options::guideGraphMaxPoints());
+    Ekos::ReplotScheduler::limitPoints(*graph(GuideGraph::G_DEC_RMS)->data(), Options::guideGraphMaxPoints());
+    Ekos::ReplotScheduler::limitPoints(*graph(GuideGraph::G_RMS)->data(), Options::guideGraphMaxPoints());
 }
 
 void GuideDriftGraph::setAxisPulse(double ra, double de)
@@ -562,12 +569,15 @@ void GuideDriftGraph::setAxisPulse(double ra, double de)
     double key = guideElapsedTimer.elapsed() / 1000.0;
     graph(GuideGraph::G_RA_PULSE)->addData(key, ra);
     graph(GuideGraph::G_DEC_PULSE)->addData(key, de);
+    Ekos::ReplotScheduler::limitPoints(*graph(GuideGraph::G_RA_PULSE)->data(), Options::guideGraphMaxPoints());
+    Ekos::ReplotScheduler::limitPoints(*graph(GuideGraph::G_DEC_PULSE)->data(), Options::guideGraphMaxPoints());
 }
 
 void GuideDriftGraph::setSNR(double snr)
 {
     double key = guideElapsedTimer.elapsed() / 1000.0;
     graph(GuideGraph::G_SNR)->addData(key, snr);
+    Ekos::ReplotScheduler::limitPoints(*graph(GuideGraph::G_SNR)->data(), Options::guideGraphMaxPoints());
 
     // Sets the SNR axis to have the maximum be 95% of the way up from the middle to the top.
     QCPGraphData snrMax = *std::min_element(graph(GuideGraph::G_SNR)->data()->begin(),
@@ -583,7 +593,7 @@ void GuideDriftGraph::updateCorrectionsScaleVisibility()
 {
     bool isVisible = (Options::rACorrDisplayedOnGuideGraph() || Options::dECorrDisplayedOnGuideGraph());
     yAxis2->setVisible(isVisible);
-    replot();
+    m_Replot->schedule();
 }
 
 void GuideDriftGraph::mouseOverLine(QMouseEvent *event)
@@ -660,7 +670,7 @@ void GuideDriftGraph::mouseOverLine(QMouseEvent *event)
         else
             QToolTip::hideText();
 
-        replot();
+        m_Replot->schedule();
     }
 
     if (xAxis->range().contains(key))
@@ -735,7 +745,7 @@ void GuideDriftGraph::mouseOverLine(QMouseEvent *event)
         else
             QToolTip::hideText();
 
-        replot();
+        m_Replot->schedule();
     }
 }
 
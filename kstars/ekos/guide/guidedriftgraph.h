@@ -13,6 +13,7 @@
 
 #include "qcustomplot.h"
 #include "guidegraph.h"
+#include "ekos/auxiliary/replotscheduler.h"
 
 namespace Ekos
 {
@@ -77,4 +78,6 @@ private:
     QElapsedTimer guideElapsedTimer;
 
     QUrl guideURLPath;
+
+    Ekos::ReplotScheduler *m_Replot { nullptr };
 };
@@ -16,6 +16,8 @@
 GuideTargetPlot::GuideTargetPlot(QWidget *parent) : QCustomPlot (parent)
 {
     Q_UNUSED(parent);
+    m_Replot = new Ekos::ReplotScheduler(this);
+
     //drift plot
     double accuracyRadius = Options::guiderAccuracyThreshold();
 
@@ -73,14 +75,14 @@ GuideTargetPlot::GuideTargetPlot(QWidget *parent) : QCustomPlot (parent)
     setupNSEWLabels();
 
     // resize(190, 190);
-    replot();
+    m_Replot->schedule();
 }
 
 void GuideTargetPlot::showPoint(double ra, double de)
 {
     graph(GuideGraph::G_DEC)->data()->clear(); //Clear Guide highlighted point
     graph(GuideGraph::G_DEC)->addData(ra, de); //Set guide highlighted point
-    replot();
+    m_Replot->schedule();
 }
 
 void GuideTargetPlot::connectGuider(Ekos::GuideInterface *guider)
@@ -91,13 +93,13 @@ void GuideTargetPlot::connectGuider(Ekos::GuideInterface *guider)
 void GuideTargetPlot::handleHorizontalPlotSizeChange()
 {
     resize(size().width(), size().height());
-    replot();
+    m_Replot->schedule();
 }
 
 void GuideTargetPlot::handleVerticalPlotSizeChange()
 {
     resize(size().width(), size().height());
-    replot();
+    m_Replot->schedule();
 }
 
 void GuideTargetPlot::resize(int w, int h)
@@ -115,7 +117,7 @@ void GuideTargetPlot::resize(int w, int h)
         xAxis->setRange(-accuracyRadius * 3, accuracyRadius * 3);
         yAxis->setScaleRatio(xAxis, 1.0);
     }
-    replot();
+    m_Replot->schedule();
 }
 
 void GuideTargetPlot::buildTarget(double accuracyRadius)
@@ -233,21 +235,25 @@ void GuideTargetPlot::autoScaleGraphs(double accuracyRadius)
     yAxis->setRange(-accuracyRadius * 3, accuracyRadius * 3);
     yAxis->setScaleRatio(xAxis, 1.0);
     xAxis->setScaleRatio(yAxis, 1.0);
-    replot();
+    m_Replot->schedule();
 }
 
 void GuideTargetPlot::clear()
 {
     graph(GuideGraph::G_RA)->data()->clear(); //Guide data
     graph(GuideGraph::G_DEC)->data()->clear(); //Guide highlighted point
+    m_PointKeys.clear();
     setupNSEWLabels();
-    replot();
+    m_Replot->schedule();
 }
 
 void GuideTargetPlot::setAxisDelta(double ra, double de)
 {
     //Add to Drift Plot
     graph(GuideGraph::G_RA)->addData(ra, de);
+    m_PointKeys.enqueue(ra);
+    while (m_PointKeys.size() > static_cast<int>(Options::guideGraphMaxPoints()))
+        graph(GuideGraph::G_RA)->data()->remove(m_PointKeys.dequeue());
     if(graphOnLatestPt)
     {
         graph(GuideGraph::G_DEC)->data()->clear(); //Clear highlighted point
@@ -260,9 +266,9 @@ void GuideTargetPlot::setAxisDelta(double ra, double de)
         QTimer::singleShot(300, this, [ = ]()
         {
             setBackground(QBrush(Qt::black));
-            replot();
+            m_Replot->schedule();
         });
     }
 
-    replot();
+    m_Replot->schedule();
 }
@@ -12,6 +12,9 @@
 
 #include "qcustomplot.h"
 #include "guideinterface.h"
+#include "ekos/auxiliary/replotscheduler.h"
+
+#include <QQueue>
 
 class GuideTargetPlot: public QCustomPlot
 {
@@ -48,4 +51,8 @@ private:
 
     bool graphOnLatestPt = true;
 
+    // RA of the guide points in the order they were added, the graph is sorted by RA.
+    QQueue<double> m_PointKeys;
+
+    Ekos::ReplotScheduler *m_Replot { nullptr };
 };
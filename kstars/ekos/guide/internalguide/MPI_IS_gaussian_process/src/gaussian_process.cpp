@@ -107,8 +107,8 @@ GP::GP(const GP &that) :
     chol_feature_matrix_(that.chol_feature_matrix_),
     beta_(that.beta_)
 {
-    covFunc_ = that.covFunc_->clone();
-    covFuncProj_ = that.covFuncProj_->clone();
+    covFunc_ = that.covFunc_ != nullptr ? that.covFunc_->clone() : nullptr;
+    covFuncProj_ = that.covFuncProj_ != nullptr ? that.covFuncProj_->clone() : nullptr;
 }
 
 bool GP::setCovarianceFunction(const covariance_functions::CovFunc &covFunc)
@@ -139,9 +139,15 @@ GP &GP::operator=(const GP &that)
     if (this != &that)
     {
         covariance_functions::CovFunc* temp = covFunc_;  // store old pointer...
-        covFunc_ = that.covFunc_->clone();  // ... first clone ...
+        covFunc_ = that.covFunc_ != nullptr ? that.covFunc_->clone() : nullptr;  // ... first clone ...
         delete temp;  // ... and then delete.
 
+        // HY: the projection and the explicit trend are needed to swap in models that were
+        // updated on a worker thread, see GaussianProcessGuider.
+        temp = covFuncProj_;
+        covFuncProj_ = that.covFuncProj_ != nullptr ? that.covFuncProj_->clone() : nullptr;
+        delete temp;
+
         // copy the rest
         data_loc_ = that.data_loc_;
         data_out_ = that.data_out_;
@@ -150,6 +156,11 @@ GP &GP::operator=(const GP &that)
         alpha_ = that.alpha_;
         chol_gram_matrix_ = that.chol_gram_matrix_;
         log_noise_sd_ = that.log_noise_sd_;
+        use_explicit_trend_ = that.use_explicit_trend_;
+        feature_vectors_ = that.feature_vectors_;
+        feature_matrix_ = that.feature_matrix_;
+        chol_feature_matrix_ = that.chol_feature_matrix_;
+        beta_ = that.beta_;
     }
     return *this;
 }
@@ -137,13 +137,79 @@ double GaussianProcessGuider::CalculateVariance(double SNR)
     return standard_deviation * standard_deviation;
 }
 
+std::vector<GaussianProcessGuider::data_point> GaussianProcessGuider::GetDataPoints() const
+{
+    std::vector<data_point> data;
+    data.reserve(circular_buffer_data_.size());
+    for (int i = 0; i < circular_buffer_data_.size(); ++i)
+        data.push_back(circular_buffer_data_[i]);
+    return data;
+}
+
 void GaussianProcessGuider::UpdateGP(double prediction_point /*= std::numeric_limits<double>::quiet_NaN()*/)
+{
+    UpdateModel(gp_, GetDataPoints(), parameters, learning_rate_, prediction_point);
+    model_valid_ = true;
+}
+
+void GaussianProcessGuider::RefreshModel(double prediction_point)
+{
+    if (!async_updates_ || !model_valid_)
+    {
+        UpdateGP(prediction_point);
+        return;
+    }
+
+    // Swap in the update started at a previous step, if it is done.
+    if (pending_update_.valid() &&
+            pending_update_.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+        std::unique_ptr<model_update> update = pending_update_.get();
+        if (update->generation == model_generation_)
+            gp_ = update->gp;
+    }
+
+    // Only one update at a time, the worker works on copies.
+    if (!pending_update_.valid())
+    {
+        auto update = std::make_unique<model_update>(model_update{ gp_, model_generation_ });
+        const std::vector<data_point> data = GetDataPoints();
+        const guide_parameters parameters_copy = parameters;
+        const double learning_rate = learning_rate_;
+        pending_update_ = std::async(std::launch::async,
+                                     [update = std::move(update), data, parameters_copy, learning_rate, prediction_point]() mutable
+        {
+            UpdateModel(update->gp, data, parameters_copy, learning_rate, prediction_point);
+            return std::move(update);
+        });
+    }
+}
+
+void GaussianProcessGuider::InvalidateModel()
+{
+    // A running update finishes on its own, and is dropped when collected.
+    ++model_generation_;
+    model_valid_ = false;
+}
+
+void GaussianProcessGuider::SetParallelUpdates(bool active)
+{
+    async_updates_ = active;
+}
+
+bool GaussianProcessGuider::GetParallelUpdates() const
+{
+    return async_updates_;
+}
+
+void GaussianProcessGuider::UpdateModel(GP &gp, const std::vector<data_point> &data, const guide_parameters &parameters,
+                                        double learning_rate, double prediction_point)
 {
 #if PRINT_TIMINGS_
     clock_t begin = std::clock(); // this is for timing the method in a simple way
 #endif
 
-    size_t N = get_number_of_measurements();
+    size_t N = data.size();
 
     // initialize the different vectors needed for the GP
     Eigen::VectorXd timestamps(N - 1);
@@ -156,10 +222,10 @@ void GaussianProcessGuider::UpdateGP(double prediction_point /*= std::numeric_li
     // transfer the data from the circular buffer to the Eigen::Vectors
     for (size_t i = 0; i < N - 1; i++)
     {
-        sum_control += circular_buffer_data_[i].control; // sum over the control signals
-        timestamps(i) = circular_buffer_data_[i].timestamp;
-        measurements(i) = circular_buffer_data_[i].measurement;
-        variances(i) = circular_buffer_data_[i].variance;
+        sum_control += data[i].control; // sum over the control signals
+        timestamps(i) = data[i].timestamp;
+        measurements(i) = data[i].measurement;
+        variances(i) = data[i].variance;
         sum_controls(i) = sum_control; // store current accumulated control signal
     }
 
@@ -212,12 +278,12 @@ void GaussianProcessGuider::UpdateGP(double prediction_point /*= std::numeric_li
 #endif
 
     // calculate period length if we have enough points already
-    double period_length = GetGPHyperparameters()[PKPeriodLength];
-    if (GetBoolComputePeriod() && get_last_point().timestamp > parameters.min_periods_for_period_estimation_ * period_length)
+    double period_length = GetHyperparameters(gp)[PKPeriodLength];
+    if (parameters.compute_period_ && data.back().timestamp > parameters.min_periods_for_period_estimation_ * period_length)
     {
         // find periodicity parameter with FFT
         period_length = EstimatePeriodLength(timestamps, gear_error_detrend);
-        UpdatePeriodLength(period_length);
+        UpdatePeriodLength(gp, period_length, learning_rate);
 
 #if PRINT_TIMINGS_
         end = std::clock();
@@ -230,7 +296,7 @@ void GaussianProcessGuider::UpdateGP(double prediction_point /*= std::numeric_li
 #endif
 
     // inference of the GP with the new points, maximum accuracy should be reached around current time
-    gp_.inferSD(timestamps, gear_error, parameters.points_for_approximation_, variances, prediction_point);
+    gp.inferSD(timestamps, gear_error, parameters.points_for_approximation_, variances, prediction_point);
 
 #if PRINT_TIMINGS_
     end = std::clock();
@@ -335,7 +401,7 @@ double GaussianProcessGuider::result(double input, double SNR, double time_step,
             prediction_point = std::chrono::duration<double>(std::chrono::system_clock::now() - start_time_).count();
         }
         // the point of highest precision shoud be between now and the next step
-        UpdateGP(prediction_point + 0.5 * time_step);
+        RefreshModel(prediction_point + 0.5 * time_step);
 
         // the prediction should end after one time step
         prediction_ = PredictGearError(prediction_point + time_step);
@@ -398,7 +464,7 @@ double GaussianProcessGuider::deduceResult(double time_step, double prediction_p
             prediction_point = std::chrono::duration<double>(std::chrono::system_clock::now() - start_time_).count();
         }
         // the point of highest precision should be between now and the next step
-        UpdateGP(prediction_point + 0.5 * time_step);
+        RefreshModel(prediction_point + 0.5 * time_step);
 
         // the prediction should end after one time step
         prediction_ = PredictGearError(prediction_point + time_step);
@@ -425,6 +491,7 @@ void GaussianProcessGuider::reset()
     qCDebug(KSTARS_EKOS_GUIDE) << QString("GPG::reset()");
     circular_buffer_data_.clear();
     gp_.clearData();
+    InvalidateModel();
 
     // We need to add a first data point because the measurements are always relative to the control.
     // For the first measurement, we therefore need to add a point with zero control.
@@ -495,9 +562,21 @@ bool GaussianProcessGuider::SetBoolComputePeriod(bool active)
 }
 
 std::vector<double> GaussianProcessGuider::GetGPHyperparameters() const
+{
+    return GetHyperparameters(gp_);
+}
+
+bool GaussianProcessGuider::SetGPHyperparameters(std::vector<double> const &hyperparameters)
+{
+    SetHyperparameters(gp_, hyperparameters);
+    InvalidateModel();
+    return false;
+}
+
+std::vector<double> GaussianProcessGuider::GetHyperparameters(const GP &gp)
 {
     // since the GP class works in log space, we have to exp() the parameters first.
-    Eigen::VectorXd hyperparameters_full = gp_.getHyperParameters().array().exp();
+    Eigen::VectorXd hyperparameters_full = gp.getHyperParameters().array().exp();
     // remove first parameter, which is unused here
     Eigen::VectorXd hyperparameters = hyperparameters_full.tail(NumParameters);
 
@@ -509,7 +588,7 @@ std::vector<double> GaussianProcessGuider::GetGPHyperparameters() const
                                hyperparameters.data() + NumParameters);
 }
 
-bool GaussianProcessGuider::SetGPHyperparameters(std::vector<double> const &hyperparameters)
+void GaussianProcessGuider::SetHyperparameters(GP &gp, std::vector<double> const &hyperparameters)
 {
     Eigen::VectorXd hyperparameters_eig = Eigen::VectorXd::Map(&hyperparameters[0], hyperparameters.size());
 
@@ -530,8 +609,7 @@ bool GaussianProcessGuider::SetGPHyperparameters(std::vector<double> const &hype
     hyperparameters_full << 1.0, hyperparameters_eig;
 
     // the GP works in log space, therefore we need to convert
-    gp_.setHyperParameters(hyperparameters_full.array().log());
-    return false;
+    gp.setHyperParameters(hyperparameters_full.array().log());
 }
 
 double GaussianProcessGuider::GetMinMove() const
@@ -689,7 +767,12 @@ double GaussianProcessGuider::EstimatePeriodLength(const Eigen::VectorXd &time,
 
 void GaussianProcessGuider::UpdatePeriodLength(double period_length)
 {
-    std::vector<double> hypers = GetGPHyperparameters();
+    UpdatePeriodLength(gp_, period_length, learning_rate_);
+}
+
+void GaussianProcessGuider::UpdatePeriodLength(GP &gp, double period_length, double learning_rate)
+{
+    std::vector<double> hypers = GetHyperparameters(gp);
 
     // assert for the developers...
     assert(!math_tools::isNaN(period_length));
@@ -701,15 +784,17 @@ void GaussianProcessGuider::UpdatePeriodLength(double period_length)
     }
 
     // we just apply a simple learning rate to slow down parameter jumps
-    hypers[PKPeriodLength] = (1 - learning_rate_) * hypers[PKPeriodLength] + learning_rate_ * period_length;
+    hypers[PKPeriodLength] = (1 - learning_rate) * hypers[PKPeriodLength] + learning_rate * period_length;
 
-    SetGPHyperparameters(hypers); // the setter function is needed to convert parameters
+    SetHyperparameters(gp, hypers); // the setter function is needed to convert parameters
 }
 
 Eigen::MatrixXd GaussianProcessGuider::regularize_dataset(const Eigen::VectorXd &timestamps,
         const Eigen::VectorXd &gear_error, const Eigen::VectorXd &variances)
 {
-    size_t N = get_number_of_measurements();
+    // HY: one more than the number of timestamps, as in UpdateModel(), so that this does not
+    // depend on the state of the guider.
+    size_t N = timestamps.size() + 1;
     double grid_interval = GRID_INTERVAL;
     double last_cell_end = -grid_interval;
     double last_timestamp = -grid_interval;
@@ -24,6 +24,9 @@
 #include "math_tools.h"
 #include "ekos_guide_debug.h"
 #include <chrono>
+#include <future>
+#include <memory>
+#include <vector>
 
 enum Hyperparameters
 {
@@ -177,6 +180,22 @@ class GaussianProcessGuider
          */
         double learning_rate_;
 
+        // HY: The model updates (regularization, period estimation and GP inference) grow
+        // with the history and can run on a worker thread instead of right before the pulse.
+        // Predictions then use the last completed model, and a finished update is swapped
+        // in before the next prediction. Updates started before a reset or a change of the
+        // hyperparameters are dropped.
+        struct model_update
+        {
+            GP gp;
+            int generation;
+        };
+        bool async_updates_ { false };
+        // False until the model was updated since the last reset or hyperparameter change.
+        bool model_valid_ { false };
+        int model_generation_ { 0 };
+        std::future<std::unique_ptr<model_update>> pending_update_;
+
         /**
          * Guiding parameters of this instance.
          */
@@ -211,7 +230,33 @@ class GaussianProcessGuider
         /**
          * Estimates the main period length for a given dataset.
          */
-        double EstimatePeriodLength(const Eigen::VectorXd &time, const Eigen::VectorXd &data);
+        static double EstimatePeriodLength(const Eigen::VectorXd &time, const Eigen::VectorXd &data);
+
+        /**
+         * Returns a copy of the data points, oldest first.
+         */
+        std::vector<data_point> GetDataPoints() const;
+
+        /**
+         * Does the work of UpdateGP() on the given model and data, for any thread.
+         */
+        static void UpdateModel(GP &gp, const std::vector<data_point> &data, const guide_parameters &parameters,
+                                double learning_rate, double prediction_point);
+
+        /**
+         * Updates the model inline, or swaps in a finished update and starts the next one
+         * on a worker thread if parallel updates are enabled.
+         */
+        void RefreshModel(double prediction_point);
+
+        /**
+         * Drops the updates being computed and forces the next one to run inline.
+         */
+        void InvalidateModel();
+
+        static std::vector<double> GetHyperparameters(const GP &gp);
+        static void SetHyperparameters(GP &gp, const std::vector<double> &hyperparameters);
+        static void UpdatePeriodLength(GP &gp, double period_length, double learning_rate);
 
         /**
          * Calculates the difference in gear error for the time between the last
@@ -247,6 +292,12 @@ class GaussianProcessGuider
         double GetPredictionGain() const;
         bool SetPredictionGain(double);
 
+        /**
+         * Enables model updates on a worker thread, see RefreshModel().
+         */
+        void SetParallelUpdates(bool active);
+        bool GetParallelUpdates() const;
+
         /**
          * Returns the weight of the prediction on the output control value
          */
@@ -357,8 +408,8 @@ class GaussianProcessGuider
         /**
          * Takes timestamps, measurements and SNRs and returns them regularized in a matrix.
          */
-        Eigen::MatrixXd regularize_dataset(const Eigen::VectorXd &timestamps, const Eigen::VectorXd &gear_error,
-                                           const Eigen::VectorXd &variances);
+        static Eigen::MatrixXd regularize_dataset(const Eigen::VectorXd &timestamps, const Eigen::VectorXd &gear_error,
+                const Eigen::VectorXd &variances);
 
         /**
          * Saves the GP data to a csv file for external analysis. Expensive!
@@ -203,5 +203,6 @@ class Calibration
 
         bool initialized { false };
         friend class TestGuideStars;
+        friend class CalibrationStore;
 };
 
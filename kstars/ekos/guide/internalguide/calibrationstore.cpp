@@ -0,0 +1,116 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "calibrationstore.h"
+
+#include "calibration.h"
+#include "Options.h"
+#include "ekos_guide_debug.h"
+
+#include <QUrl>
+
+#include <cmath>
+#include <limits>
+
+CalibrationStore::CalibrationStore() : m_Entries(Options::guideCalibrationStore())
+{
+}
+
+CalibrationStore::CalibrationStore(const QStringList &entries) : m_Entries(entries)
+{
+}
+
+void CalibrationStore::save() const
+{
+    Options::setGuideCalibrationStore(m_Entries);
+}
+
+bool CalibrationStore::parse(const QString &entry, Entry *result)
+{
+    const int separator = entry.indexOf('|');
+    if (separator < 0)
+        return false;
+
+    Calibration calibration;
+    const QString encoding = entry.mid(separator + 1);
+    if (!calibration.restore(encoding))
+        return false;
+
+    result->train = QUrl::fromPercentEncoding(entry.left(separator).toUtf8());
+    result->encoding = encoding;
+    result->pierSide = calibration.calibrationPierSide;
+    result->declination = calibration.calibrationDEC.Degrees();
+    return true;
+}
+
+int CalibrationStore::band(double declination)
+{
+    if (std::isnan(declination))
+        return -1;
+    return static_cast<int>(std::floor((declination + 90.0) / DEC_BAND));
+}
+
+void CalibrationStore::add(const QString &train, const Calibration &calibration)
+{
+    const QString entry = QString::fromUtf8(QUrl::toPercentEncoding(train)) + '|' + calibration.serialize();
+    Entry added;
+    if (!parse(entry, &added))
+        return;
+
+    // Replace the calibration of the same train, pier side and declination band
+    for (int i = m_Entries.size() - 1; i >= 0; --i)
+    {
+        Entry e;
+        if (!parse(m_Entries[i], &e))
+            m_Entries.removeAt(i);
+        else if (e.train == train && e.pierSide == added.pierSide && band(e.declination) == band(added.declination))
+            m_Entries.removeAt(i);
+    }
+
+    m_Entries.append(entry);
+    while (m_Entries.size() > MAX_ENTRIES)
+        m_Entries.removeFirst();
+
+    qCDebug(KSTARS_EKOS_GUIDE) << QString("Stored calibration of train %1, %2 calibrations stored")
+                               .arg(train).arg(m_Entries.size());
+}
+
+QString CalibrationStore::find(const QString &train, ISD::Mount::PierSide pierSide, const dms *declination) const
+{
+    const double dec = declination != nullptr ? declination->Degrees() : std::numeric_limits<double>::quiet_NaN();
+
+    QString best;
+    bool bestSameSide = false;
+    double bestDistance = std::numeric_limits<double>::max();
+    for (const auto &entry : m_Entries)
+    {
+        Entry e;
+        if (!parse(entry, &e) || e.train != train || e.pierSide == ISD::Mount::PIER_UNKNOWN)
+            continue;
+
+        const bool sameSide = e.pierSide == pierSide;
+        // Unknown declinations rank after all known ones
+        const double distance = (std::isnan(dec) || std::isnan(e.declination)) ? 1000.0 : std::fabs(dec - e.declination);
+        // Later entries are newer, and win ties
+        if ((sameSide && !bestSameSide) || (sameSide == bestSameSide && distance <= bestDistance))
+        {
+            best = e.encoding;
+            bestSameSide = sameSide;
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
+
+void CalibrationStore::remove(const QString &train)
+{
+    for (int i = m_Entries.size() - 1; i >= 0; --i)
+    {
+        Entry e;
+        if (!parse(m_Entries[i], &e) || e.train == train)
+            m_Entries.removeAt(i);
+    }
+}
@@ -0,0 +1,74 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "indi/indimount.h"
+
+#include <QString>
+#include <QStringList>
+
+class Calibration;
+class dms;
+
+// Keeps the guide calibrations of all optical trains, so that a rig can start guiding without
+// calibrating, as long as it was calibrated once. There is at most one calibration per train,
+// pier side and band of declination, the newest replaces the older one. A calibration of the
+// other pier side, or of another declination, is adapted by Calibration::restore().
+//
+// The calibrations are stored in the GuideCalibrationStore option, one entry per calibration:
+// the percent-encoded train name, a '|', and the serialized calibration.
+class CalibrationStore
+{
+    public:
+        // Width of the declination bands, in degrees.
+        static constexpr double DEC_BAND = 20.0;
+        // The oldest entries are dropped beyond this.
+        static constexpr int MAX_ENTRIES = 64;
+
+        // Reads the store from the options.
+        CalibrationStore();
+        // Uses the given entries, for tests.
+        explicit CalibrationStore(const QStringList &entries);
+
+        // Writes the store to the options.
+        void save() const;
+
+        // Adds the calibration of train, which has to be initialized.
+        void add(const QString &train, const Calibration &calibration);
+
+        // Returns the encoding of the stored calibration of train that suits pierSide and
+        // declination best, or an empty string if there is none. Calibrations of the same pier side
+        // come first, then the nearest declination. Declination may be nullptr.
+        QString find(const QString &train, ISD::Mount::PierSide pierSide, const dms *declination) const;
+
+        // Removes all calibrations of train.
+        void remove(const QString &train);
+
+        bool isEmpty() const
+        {
+            return m_Entries.isEmpty();
+        }
+
+        const QStringList &entries() const
+        {
+            return m_Entries;
+        }
+
+    private:
+        struct Entry
+        {
+            QString train;
+            QString encoding;
+            ISD::Mount::PierSide pierSide { ISD::Mount::PIER_UNKNOWN };
+            // NaN if unknown
+            double declination { 0 };
+        };
+        static bool parse(const QString &entry, Entry *result);
+        static int band(double declination);
+
+        QStringList m_Entries;
+};
@@ -594,6 +594,11 @@ void cgmath::performProcessing(Ekos::GuideState state, QSharedPointer<FITSData>
         data.code = GuideLog::GuideData::NO_ERRORS;
         data.snr = guideStars.getGuideStarSNR();
         data.mass = guideStars.getGuideStarMass();
+        if (usingSEPMultiStar())
+        {
+            data.starsDetected = guideStars.getNumStarsDetected();
+            data.starsUsed = guideStars.getNumStarsUsed();
+        }
         // Add SNR and MASS from SEP stars.
         logger->addGuideData(data);
     }
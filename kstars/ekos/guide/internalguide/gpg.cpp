@@ -117,6 +117,7 @@ void GPG::updateParameters()
     hyperparameters[SE1KSignalVariance] = parameters.SE1KSignalVariance_;
     hyperparameters[PKPeriodLength]     = parameters.PKPeriodLength_;
     gpg->SetGPHyperparameters(hyperparameters);
+    gpg->SetParallelUpdates(Options::gPGParallelUpdates());
 }
 
 
@@ -125,6 +126,7 @@ GPG::GPG()
     GaussianProcessGuider::guide_parameters parameters;
     getGPGParameters(&parameters);
     gpg.reset(new GaussianProcessGuider(parameters));
+    gpg->SetParallelUpdates(Options::gPGParallelUpdates());
     reset();
 }
 
@@ -9,7 +9,11 @@
 
 #include "guidealgorithms.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <set>
+#include <vector>
 #include <QObject>
 
 #include "ekos_guide_debug.h"
@@ -482,6 +486,274 @@ repeat:
 }
 
 
+namespace
+{
+
+// The kernels below accumulate in LANES independent sums, which compilers map onto SIMD
+// registers (SSE, AVX, NEON) without reordering floating point additions.
+constexpr int LANES = 8;
+
+// Converts a row of pixels to float, so that the inner loops are the same for all pixel types.
+template <typename T>
+inline void loadRow(const T *src, float *dst, int count)
+{
+    for (int i = 0; i < count; ++i)
+        dst[i] = static_cast<float>(src[i]);
+}
+
+inline float laneSum(const float *lanes)
+{
+    float sum = 0;
+    for (int k = 0; k < LANES; ++k)
+        sum += lanes[k];
+    return sum;
+}
+
+inline float laneMax(const float *lanes)
+{
+    return *std::max_element(lanes, lanes + LANES);
+}
+
+// Mean and standard deviation of the outermost pixels of a box.
+template <typename T>
+void borderStatistics(const T *origin, int stride, int width, int height, double *mean, double *stddev)
+{
+    double sum = 0, sumSq = 0;
+    int count = 0;
+    auto add = [&](const T * p, int n, int step)
+    {
+        for (int k = 0; k < n; ++k)
+        {
+            const double v = p[k * step];
+            sum += v;
+            sumSq += v * v;
+        }
+        count += n;
+    };
+
+    add(origin, width, 1);
+    if (height > 1)
+        add(origin + (height - 1) * stride, width, 1);
+    if (height > 2)
+    {
+        add(origin + stride, height - 2, stride);
+        if (width > 1)
+            add(origin + stride + width - 1, height - 2, stride);
+    }
+
+    *mean = sum / count;
+    *stddev = std::sqrt(std::max(0.0, sumSq / count - *mean * *mean));
+}
+
+double peakSNR(double peak, double background, double noise)
+{
+    if (peak <= background)
+        return 0;
+    return noise > 0 ? (peak - background) / noise : std::numeric_limits<double>::max();
+}
+
+struct Gaussian1D
+{
+    double center { 0 };
+    double sigma { 0 };
+    double amplitude { 0 };
+};
+
+// Fits a Gaussian to a background subtracted profile: a parabola is fitted to the log of the
+// samples above 10% of the peak, weighted by their squares (Caruana's method with Guo's weights).
+bool fitGaussian1D(const std::vector<double> &profile, Gaussian1D *fit)
+{
+    const int peak = std::max_element(profile.begin(), profile.end()) - profile.begin();
+    if (profile[peak] <= 0)
+        return false;
+
+    const double cutoff = 0.1 * profile[peak];
+    // s[k] is the sum of w x^k, t[k] the sum of w x^k ln(y), with x relative to the peak
+    double s[5] = { 0 }, t[3] = { 0 };
+    int used = 0;
+    for (int i = 0; i < static_cast<int>(profile.size()); ++i)
+    {
+        const double y = profile[i];
+        if (y <= cutoff)
+            continue;
+        const double x = i - peak, l = std::log(y);
+        double term = y * y;
+        for (int k = 0; k < 5; ++k)
+        {
+            s[k] += term;
+            if (k < 3)
+                t[k] += term * l;
+            term *= x;
+        }
+        ++used;
+    }
+    if (used < 3)
+        return false;
+
+    // Normal equations of ln(y) = a + b x + c x^2, solved with Cramer's rule
+    const double det = s[0] * (s[2] * s[4] - s[3] * s[3]) - s[1] * (s[1] * s[4] - s[2] * s[3]) +
+                       s[2] * (s[1] * s[3] - s[2] * s[2]);
+    if (std::fabs(det) < std::numeric_limits<double>::min())
+        return false;
+    const double a = (t[0] * (s[2] * s[4] - s[3] * s[3]) - s[1] * (t[1] * s[4] - s[3] * t[2]) +
+                      s[2] * (t[1] * s[3] - s[2] * t[2])) / det;
+    const double b = (s[0] * (t[1] * s[4] - s[3] * t[2]) - t[0] * (s[1] * s[4] - s[2] * s[3]) +
+                      s[2] * (s[1] * t[2] - t[1] * s[2])) / det;
+    const double c = (s[0] * (s[2] * t[2] - t[1] * s[3]) - s[1] * (s[1] * t[2] - t[1] * s[2]) +
+                      t[0] * (s[1] * s[3] - s[2] * s[2])) / det;
+    if (c >= 0)
+        return false;
+
+    fit->center = peak - b / (2 * c);
+    fit->sigma = std::sqrt(-1 / (2 * c));
+    fit->amplitude = std::exp(a - b * b / (4 * c));
+    return true;
+}
+
+// The rms difference between a profile and a Gaussian, relative to the amplitude of the Gaussian.
+double relativeResidual(const std::vector<double> &profile, const Gaussian1D &fit)
+{
+    double sumSq = 0;
+    for (int i = 0; i < static_cast<int>(profile.size()); ++i)
+    {
+        const double d = (i - fit.center) / fit.sigma;
+        const double r = profile[i] - fit.amplitude * std::exp(-0.5 * d * d);
+        sumSq += r * r;
+    }
+    return std::sqrt(sumSq / profile.size()) / fit.amplitude;
+}
+
+}  // namespace
+
+template <typename T>
+GuideAlgorithms::Centroid GuideAlgorithms::weightedCentroid(const T *image, int stride, const QRect &box,
+        double threshold)
+{
+    Centroid result;
+    const int width = box.width(), height = box.height();
+    if (image == nullptr || width <= 0 || height <= 0)
+        return result;
+
+    const T *origin = image + box.y() * stride + box.x();
+    std::vector<float> row(width), index(width);
+    for (int i = 0; i < width; ++i)
+        index[i] = i;
+
+    const float t = threshold;
+    double sumX = 0, sumY = 0, mass = 0;
+    float peak = std::numeric_limits<float>::lowest();
+    for (int j = 0; j < height; ++j)
+    {
+        loadRow(origin + j * stride, row.data(), width);
+
+        float m[LANES] = { 0 }, sx[LANES] = { 0 }, pk[LANES];
+        std::fill(pk, pk + LANES, peak);
+        int i = 0;
+        for (; i + LANES <= width; i += LANES)
+        {
+            for (int k = 0; k < LANES; ++k)
+            {
+                const float v = row[i + k];
+                const float w = v > t ? v - t : 0.0f;
+                m[k] += w;
+                sx[k] += index[i + k] * w;
+                pk[k] = std::max(pk[k], v);
+            }
+        }
+        for (; i < width; ++i)
+        {
+            const float v = row[i];
+            const float w = v > t ? v - t : 0.0f;
+            m[0] += w;
+            sx[0] += index[i] * w;
+            pk[0] = std::max(pk[0], v);
+        }
+
+        const double rowMass = laneSum(m);
+        mass += rowMass;
+        sumX += laneSum(sx);
+        sumY += j * rowMass;
+        peak = laneMax(pk);
+    }
+
+    if (mass <= 0)
+        return result;
+
+    double background, noise;
+    borderStatistics(origin, stride, width, height, &background, &noise);
+
+    result.x = box.x() + sumX / mass;
+    result.y = box.y() + sumY / mass;
+    result.flux = mass;
+    result.snr = peakSNR(peak, background, noise);
+    return result;
+}
+
+template <typename T>
+GuideAlgorithms::Centroid GuideAlgorithms::gaussianFit(const T *image, int stride, const QRect &box)
+{
+    Centroid result;
+    const int width = box.width(), height = box.height();
+    if (image == nullptr || width < 3 || height < 3)
+        return result;
+
+    const T *origin = image + box.y() * stride + box.x();
+    double background, noise;
+    borderStatistics(origin, stride, width, height, &background, &noise);
+
+    // The profiles are the sums of the columns and rows of the box, less the background.
+    std::vector<float> row(width), columns(width, 0.0f);
+    std::vector<double> xProfile(width), yProfile(height);
+    float peak = std::numeric_limits<float>::lowest();
+    for (int j = 0; j < height; ++j)
+    {
+        loadRow(origin + j * stride, row.data(), width);
+
+        float sum[LANES] = { 0 }, pk[LANES];
+        std::fill(pk, pk + LANES, peak);
+        int i = 0;
+        for (; i + LANES <= width; i += LANES)
+        {
+            for (int k = 0; k < LANES; ++k)
+            {
+                const float v = row[i + k];
+                columns[i + k] += v;
+                sum[k] += v;
+                pk[k] = std::max(pk[k], v);
+            }
+        }
+        for (; i < width; ++i)
+        {
+            columns[i] += row[i];
+            sum[0] += row[i];
+            pk[0] = std::max(pk[0], row[i]);
+        }
+
+        yProfile[j] = laneSum(sum) - width * background;
+        peak = laneMax(pk);
+    }
+    double flux = 0;
+    for (int i = 0; i < width; ++i)
+    {
+        xProfile[i] = columns[i] - height * background;
+        flux += xProfile[i];
+    }
+
+    Gaussian1D xFit, yFit;
+    if (!fitGaussian1D(xProfile, &xFit) || !fitGaussian1D(yProfile, &yFit))
+        return result;
+    if (xFit.center < 0 || xFit.center > width - 1 || yFit.center < 0 || yFit.center > height - 1)
+        return result;
+
+    result.x = box.x() + xFit.center;
+    result.y = box.y() + yFit.center;
+    result.flux = flux;
+    result.snr = peakSNR(peak, background, noise);
+    result.sigma = (xFit.sigma + yFit.sigma) / 2;
+    result.residual = (relativeResidual(xProfile, xFit) + relativeResidual(yProfile, yFit)) / 2;
+    return result;
+}
+
 template <typename T>
 GuiderUtils::Vector GuideAlgorithms::findLocalStarPosition(QSharedPointer<FITSData> &imageData,
         const int algorithmIndex,
@@ -494,9 +766,8 @@ GuiderUtils::Vector GuideAlgorithms::findLocalStarPosition(QSharedPointer<FITSDa
 
     GuiderUtils::Vector ret(-1, -1, -1);
     int i, j;
-    double resx, resy, mass, threshold, pval;
+    double threshold;
     T const *psrc    = nullptr;
-    T const *porigin = nullptr;
     T const *pptr;
 
     if (trackingBox.isValid() == false)
@@ -534,10 +805,9 @@ GuiderUtils::Vector GuideAlgorithms::findLocalStarPosition(QSharedPointer<FITSDa
 
     double square_square = trackingBox.width() * trackingBox.width();
 
-    psrc = porigin = pdata + trackingBox.y() * videoWidth + trackingBox.x();
+    psrc = pdata + trackingBox.y() * videoWidth + trackingBox.x();
 
-    resx = resy = 0;
-    threshold = mass = 0;
+    threshold = 0;
 
     // several threshold adaptive smart algorithms
     switch (algorithmIndex)
@@ -815,32 +1085,15 @@ GuiderUtils::Vector GuideAlgorithms::findLocalStarPosition(QSharedPointer<FITSDa
         }
     }
 
-    psrc = porigin;
-    for (j = 0; j < trackingBox.width(); ++j)
-    {
-        for (i = 0; i < trackingBox.width(); ++i)
-        {
-            pptr = psrc + i;
-            pval = *pptr - threshold;
-            pval = pval < 0 ? 0 : pval;
+    // The tracking box is square
+    const Centroid centroid = weightedCentroid(pdata, videoWidth,
+                              QRect(trackingBox.x(), trackingBox.y(), trackingBox.width(), trackingBox.width()), threshold);
 
-            resx += (double)i * pval;
-            resy += (double)j * pval;
+    // Without any pixel above the threshold, this returns the corner of the box
+    if (!centroid.isValid())
+        return GuiderUtils::Vector(trackingBox.x(), trackingBox.y(), 0);
 
-            mass += pval;
-        }
-        psrc += videoWidth;
-    }
-
-    if (mass == 0)
-        mass = 1;
-
-    resx /= mass;
-    resy /= mass;
-
-    ret = GuiderUtils::Vector(trackingBox.x(), trackingBox.y(), 0) + GuiderUtils::Vector(resx, resy, 0);
-
-    return ret;
+    return GuiderUtils::Vector(centroid.x, centroid.y, 0);
 }
 
 GuiderUtils::Vector GuideAlgorithms::findLocalStarPosition(QSharedPointer<FITSData> &imageData,
@@ -881,3 +1134,10 @@ GuiderUtils::Vector GuideAlgorithms::findLocalStarPosition(QSharedPointer<FITSDa
 
     return GuiderUtils::Vector(-1, -1, -1);
 }
+
+template GuideAlgorithms::Centroid GuideAlgorithms::weightedCentroid<uint8_t>(const uint8_t *, int, const QRect &, double);
+template GuideAlgorithms::Centroid GuideAlgorithms::weightedCentroid<uint16_t>(const uint16_t *, int, const QRect &, double);
+template GuideAlgorithms::Centroid GuideAlgorithms::weightedCentroid<float>(const float *, int, const QRect &, double);
+template GuideAlgorithms::Centroid GuideAlgorithms::gaussianFit<uint8_t>(const uint8_t *, int, const QRect &);
+template GuideAlgorithms::Centroid GuideAlgorithms::gaussianFit<uint16_t>(const uint16_t *, int, const QRect &);
+template GuideAlgorithms::Centroid GuideAlgorithms::gaussianFit<float>(const float *, int, const QRect &);
@@ -11,6 +11,7 @@
 
 #include "vect.h"
 #include <QPointer>
+#include <QRect>
 #include <cstdint>
 
 class FITSData;
@@ -28,6 +29,39 @@ class GuideAlgorithms : public QObject
                 const int videoWidth,
                 const int videoHeight,
                 const QRect &trackingBox);
+
+        // The result of the centroid kernels below. Positions are in image pixels, -1 if no star was found.
+        struct Centroid
+        {
+            double x { -1 };
+            double y { -1 };
+            // Sum of the pixel values above the threshold, or above the background for fits.
+            double flux { 0 };
+            // Quality: the peak above the background of the box border, in units of its noise.
+            double snr { 0 };
+            // Gaussian fits only: the sigma of the star, and the rms residual of the fit relative to its peak.
+            double sigma { 0 };
+            double residual { 0 };
+
+            bool isValid() const
+            {
+                return x >= 0 && y >= 0;
+            }
+        };
+
+        // Intensity weighted centroid of the pixels of box above threshold.
+        // image is the first pixel of an image that is stride pixels wide, box has to be inside it.
+        // Instantiated for uint8_t, uint16_t and float.
+        template <typename T>
+        static Centroid weightedCentroid(const T *image, int stride, const QRect &box, double threshold);
+
+        // Fits a circular Gaussian on a flat background to the star in box. The background is the
+        // mean of the box border. As a circular Gaussian is separable, its x and y profiles are
+        // Gaussians with the same center and sigma, and those are fitted, which needs a single pass
+        // over the pixels. Instantiated for uint8_t, uint16_t and float.
+        template <typename T>
+        static Centroid gaussianFit(const T *image, int stride, const QRect &box);
+
     private:
         template <typename T>
         static GuiderUtils::Vector findLocalStarPosition(QSharedPointer<FITSData> &imageData,
@@ -5,6 +5,7 @@
 */
 
 #include "guidelog.h"
+#include "guidetelemetry.h"
 
 #include <math.h>
 #include <cstdint>
@@ -14,6 +15,7 @@
 #include <QTextStream>
 
 #include "auxiliary/kspaths.h"
+#include "Options.h"
 #include <version.h>
 
 // This class writes a guide log that is compatible with the phdlogview program.
@@ -90,6 +92,18 @@ GuideLog::~GuideLog()
     endLog();
 }
 
+QString GuideLog::logStartText(const QDateTime &time)
+{
+    return QString("KStars version %1. PHD2 log version 2.5. Log enabled at %2\n\n")
+           .arg(KSTARS_VERSION)
+           .arg(time.toString("yyyy-MM-dd hh:mm:ss"));
+}
+
+QString GuideLog::logEndText(const QDateTime &time)
+{
+    return QString("Log closed at %1\n").arg(time.toString("yyyy-MM-dd hh:mm:ss"));
+}
+
 void GuideLog::appendToLog(const QString &lines)
 {
     if (!enabled)
@@ -107,13 +121,19 @@ void GuideLog::startLog()
     QDir dir = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("guidelogs");
     dir.mkpath(".");
 
-    logFileName = dir.filePath("guide_log-" + QDateTime::currentDateTime().toString("yyyy-MM-ddThh-mm-ss") + ".txt");
+    const QString baseName = "guide_log-" + QDateTime::currentDateTime().toString("yyyy-MM-ddThh-mm-ss");
+    logFileName = dir.filePath(baseName + ".txt");
     logFile.setFileName(logFileName);
     logFile.open(QIODevice::WriteOnly | QIODevice::Text);
 
-    appendToLog(QString("KStars version %1. PHD2 log version 2.5. Log enabled at %2\n\n")
-                .arg(KSTARS_VERSION)
-                .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss")));
+    appendToLog(logStartText(QDateTime::currentDateTime()));
+
+    if (Options::saveGuideTelemetry())
+    {
+        telemetry.reset(new GuideTelemetry());
+        if (!telemetry->open(dir.filePath(baseName + GuideTelemetry::FILE_EXTENSION)))
+            telemetry.reset();
+    }
 
     initialized = true;
 }
@@ -128,9 +148,36 @@ void GuideLog::endLog()
     if (isGuiding && initialized)
         endGuiding();
 
-    appendToLog(QString("Log closed at %1\n")
-                .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss")));
+    appendToLog(logEndText(QDateTime::currentDateTime()));
     logFile.close();
+    telemetry.reset();
+}
+
+QString GuideLog::guidingStartText(const GuideInfo &info, const QDateTime &time)
+{
+    // Currently phdlogview just reads the Pixel scale value on the 2nd line, and
+    // just reads the Dec value on the 3rd line.
+    // Note the log wants hrs for RA, the input to this method is in degrees.
+    return QString("Guiding Begins at %1\n"
+                   "Pixel scale = %2 arc-sec/px, Binning = %3, Focal length = %4 mm\n"
+                   "RA = %5 hr, Dec = %6 deg, Hour angle = N/A hr, Pier side = %7, "
+                   "Rotator pos = N/A, Alt = %8 deg, Az = %9 deg\n"
+                   "Mount = mount, xAngle = %10, xRate = %11, yAngle = %12, yRate = %13\n"
+                   "Frame,Time,mount,dx,dy,RARawDistance,DECRawDistance,RAGuideDistance,DECGuideDistance,"
+                   "RADuration,RADirection,DECDuration,DECDirection,XStep,YStep,StarMass,SNR,ErrorCode\n")
+           .arg(time.toString("yyyy-MM-dd hh:mm:ss"))
+           .arg(QString::number(info.pixelScale, 'f', 2))
+           .arg(info.binning)
+           .arg(info.focalLength)
+           .arg(QString::number(degreesToHours(info.ra), 'f', 2))
+           .arg(QString::number(info.dec, 'f', 1))
+           .arg(pierSideString(info.pierSide))
+           .arg(QString::number(info.altitude, 'f', 1))
+           .arg(QString::number(info.azimuth, 'f', 1))
+           .arg(QString::number(info.xangle, 'f', 1))
+           .arg(QString::number(info.xrate, 'f', 3))
+           .arg(QString::number(info.yangle, 'f', 1))
+           .arg(QString::number(info.yrate, 'f', 3));
 }
 
 // Output at the start of Guiding.
@@ -143,30 +190,10 @@ void GuideLog::startGuiding(const GuideInfo &info)
     if (!initialized)
         startLog();
 
-    // Currently phdlogview just reads the Pixel scale value on the 2nd line, and
-    // just reads the Dec value on the 3rd line.
-    // Note the log wants hrs for RA, the input to this method is in degrees.
-    appendToLog(QString("Guiding Begins at %1\n"
-                        "Pixel scale = %2 arc-sec/px, Binning = %3, Focal length = %4 mm\n"
-                        "RA = %5 hr, Dec = %6 deg, Hour angle = N/A hr, Pier side = %7, "
-                        "Rotator pos = N/A, Alt = %8 deg, Az = %9 deg\n"
-                        "Mount = mount, xAngle = %10, xRate = %11, yAngle = %12, yRate = %13\n"
-                        "Frame,Time,mount,dx,dy,RARawDistance,DECRawDistance,RAGuideDistance,DECGuideDistance,"
-                        "RADuration,RADirection,DECDuration,DECDirection,XStep,YStep,StarMass,SNR,ErrorCode\n")
-                .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss"))
-                .arg(QString::number(info.pixelScale, 'f', 2))
-                .arg(info.binning)
-                .arg(info.focalLength)
-                .arg(QString::number(degreesToHours(info.ra), 'f', 2))
-                .arg(QString::number(info.dec, 'f', 1))
-                .arg(pierSideString(info.pierSide))
-                .arg(QString::number(info.altitude, 'f', 1))
-                .arg(QString::number(info.azimuth, 'f', 1))
-                .arg(QString::number(info.xangle, 'f', 1))
-                .arg(QString::number(info.xrate, 'f', 3))
-                .arg(QString::number(info.yangle, 'f', 1))
-                .arg(QString::number(info.yrate, 'f', 3)));
-
+    const QDateTime now = QDateTime::currentDateTime();
+    appendToLog(guidingStartText(info, now));
+    if (enabled && telemetry)
+        telemetry->startGuiding(info, now);
 
     guideIndex = 1;
     isGuiding = true;
@@ -176,39 +203,53 @@ void GuideLog::startGuiding(const GuideInfo &info)
 // Prints a line that looks something like this:
 //   55,467.914,"Mount",-1.347,-2.160,2.319,-1.451,1.404,-0.987,303,W,218,N,,,2173,26.91,0
 // See the log analysis section in https://openphdguiding.org/PHD2_User_Guide.pdf for definitions of the fields.
-void GuideLog::addGuideData(const GuideData &data)
+QString GuideLog::guideDataText(int index, double seconds, const GuideData &data)
 {
     QString mountString = data.type == GuideData::MOUNT ? "\"Mount\"" : "\"DROP\"";
     QString xStepString = "";
     QString yStepString = "";
-    appendToLog(QString("%1,%2,%3,%4,%5,%6,%7,%8,%9,%10,%11,%12,%13,%14,%15,%16,%17,%18\n")
-                .arg(guideIndex)
-                .arg(QString::number(timer.elapsed() / 1000.0, 'f', 3))
-                .arg(mountString)
-                .arg(QString::number(data.dx, 'f', 3))
-                .arg(QString::number(data.dy, 'f', 3))
-                .arg(QString::number(data.raDistance, 'f', 3))
-                .arg(QString::number(data.decDistance, 'f', 3))
-                .arg(QString::number(data.raGuideDistance, 'f', 3))
-                .arg(QString::number(data.decGuideDistance, 'f', 3))
-                .arg(data.raDuration)
-                .arg(directionString(data.raDirection))
-                .arg(data.decDuration)
-                .arg(directionString(data.decDirection))
-                .arg(xStepString)
-                .arg(yStepString)
-                .arg(QString::number(data.mass, 'f', 0))
-                .arg(QString::number(data.snr, 'f', 2))
-                .arg(static_cast<int>(data.code)));
+    return QString("%1,%2,%3,%4,%5,%6,%7,%8,%9,%10,%11,%12,%13,%14,%15,%16,%17,%18\n")
+           .arg(index)
+           .arg(QString::number(seconds, 'f', 3))
+           .arg(mountString)
+           .arg(QString::number(data.dx, 'f', 3))
+           .arg(QString::number(data.dy, 'f', 3))
+           .arg(QString::number(data.raDistance, 'f', 3))
+           .arg(QString::number(data.decDistance, 'f', 3))
+           .arg(QString::number(data.raGuideDistance, 'f', 3))
+           .arg(QString::number(data.decGuideDistance, 'f', 3))
+           .arg(data.raDuration)
+           .arg(directionString(data.raDirection))
+           .arg(data.decDuration)
+           .arg(directionString(data.decDirection))
+           .arg(xStepString)
+           .arg(yStepString)
+           .arg(QString::number(data.mass, 'f', 0))
+           .arg(QString::number(data.snr, 'f', 2))
+           .arg(static_cast<int>(data.code));
+}
+
+void GuideLog::addGuideData(const GuideData &data)
+{
+    appendToLog(guideDataText(guideIndex, timer.elapsed() / 1000.0, data));
+    if (enabled && telemetry)
+        telemetry->addGuideData(guideIndex, data);
     ++guideIndex;
 }
 
 // Prints a line that looks like:
 //   Guiding Ends at 2019-11-21 01:57:45
+QString GuideLog::guidingEndText(const QDateTime &time)
+{
+    return QString("Guiding Ends at %1\n\n").arg(time.toString("yyyy-MM-dd hh:mm:ss"));
+}
+
 void GuideLog::endGuiding()
 {
-    appendToLog(QString("Guiding Ends at %1\n\n")
-                .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss")));
+    const QDateTime now = QDateTime::currentDateTime();
+    appendToLog(guidingEndText(now));
+    if (enabled && telemetry)
+        telemetry->endGuiding(now);
     isGuiding = false;
 }
 
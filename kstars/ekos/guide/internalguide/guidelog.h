@@ -6,12 +6,17 @@
 
 #pragma once
 
+#include <QDateTime>
 #include <QElapsedTimer>
 #include <QFile>
 
+#include <memory>
+
 #include "indi/indicommon.h"
 #include "indi/indimount.h"
 
+class GuideTelemetry;
+
 // This class will help write guide log files, using the PHD2 guide log format.
 
 class GuideLog
@@ -39,9 +44,11 @@ class GuideLog
                 double raDistance = 0, decDistance = 0;           // Should be in units of arcseconds.
                 double raGuideDistance = 0, decGuideDistance = 0; // Should be in units of arcseconds.
                 int raDuration = 0, decDuration = 0;              // Should be in units of milliseconds.
-                GuideDirection raDirection, decDirection = NO_DIR;
+                GuideDirection raDirection = NO_DIR, decDirection = NO_DIR;
                 double mass = 0;
                 double snr = 0;
+                // SEP MultiStar detections, and stars whose drift was used. Not in the text log.
+                int starsDetected = 0, starsUsed = 0;
                 // From https://openphdguiding.org/PHD2_User_Guide.pdf and logs
                 enum ErrorCode
                 {
@@ -88,6 +95,13 @@ class GuideLog
         void settleStartedInfo();
         void settleCompletedInfo();
 
+        // The text of the log, also used to convert telemetry files, see GuideTelemetry.
+        static QString logStartText(const QDateTime &time);
+        static QString logEndText(const QDateTime &time);
+        static QString guidingStartText(const GuideInfo &info, const QDateTime &time);
+        static QString guideDataText(int index, double seconds, const GuideData &data);
+        static QString guidingEndText(const QDateTime &time);
+
         // Deal with suspend, resume, dither, ...
     private:
         // Write the file header and footer.
@@ -115,4 +129,7 @@ class GuideLog
 
         // True means the filename was created and the log's header has been written.
         bool initialized = false;
+
+        // Binary copy of the guiding sessions, if Options::saveGuideTelemetry() is set.
+        std::unique_ptr<GuideTelemetry> telemetry;
 };
@@ -33,6 +33,13 @@
 // margin below (e.g. if a guide star was selected that was near the max guide-star hfr, the later
 // the hfr increased a little, we still want to be able to find it.
 constexpr double HFR_MARGIN = 2.0;
+
+// When the time budget of a frame is tight, keep at least this many of the best stars
+// for star correspondence, and at least twice the number of references.
+constexpr int MIN_BUDGET_STARS = 20;
+
+// Once the time budget is used up, getDrift() stops after this many stars.
+constexpr int MIN_BUDGET_DRIFT_STARS = 3;
 /*
  Start with a set of reference (x,y) positions from stars, where one is designated a guide star.
  Given these and a set of new input stars, determine a mapping of new stars to the references.
@@ -126,6 +133,7 @@ QVector3D GuideStars::selectGuideStar(const QSharedPointer<FITSData> &imageData)
     if (imageData == nullptr)
         return QVector3D(-1, -1, -1);
 
+    m_TrackedStars.clear();
     QList<double> sepScores;
     QList<double> minDistances;
     const double maxHFR = Options::guideMaxHFR();
@@ -296,6 +304,9 @@ GuiderUtils::Vector GuideStars::findGuideStar(const QSharedPointer<FITSData> &im
     if (firstFrame)
         unreliableDectionCounter = 0;
 
+    m_FrameTimer.start();
+    m_NumStarsUsed = 0;
+
     // Don't accept reference stars whose position is more than this many pixels from expected.
     constexpr double maxStarAssociationDistance = 10;
 
@@ -319,7 +330,21 @@ GuiderUtils::Vector GuideStars::findGuideStar(const QSharedPointer<FITSData> &im
     if (starCorrespondence.size() > 0)
     {
 
-        findTopStars(imageData, STARS_TO_SEARCH, &detectedStars, maxHFR);
+        // Consecutive guide frames show the same field, so search around the stars of the previous frame first.
+        findTopStars(imageData, STARS_TO_SEARCH, &detectedStars, maxHFR, nullptr, nullptr, nullptr,
+                     Options::guideIncrementalDetection() ? &m_TrackedStars : nullptr);
+
+        // Detection took more than half of the time budget, so only correlate the best stars.
+        // findTopStars() returns them by decreasing score.
+        const int deadline = static_cast<int>(Options::guideMultiStarDeadline());
+        const int budgetStars = std::max(MIN_BUDGET_STARS, 2 * starCorrespondence.size());
+        if (deadline > 0 && m_FrameTimer.elapsed() > deadline / 2 && detectedStars.size() > budgetStars)
+        {
+            qCDebug(KSTARS_EKOS_GUIDE) << "Multistar: detection took" << m_FrameTimer.elapsed() << "ms, keeping"
+                                       << budgetStars << "of" << detectedStars.size() << "stars";
+            detectedStars.erase(detectedStars.begin() + budgetStars, detectedStars.end());
+        }
+        m_TrackedStars = detectedStars;
         if (detectedStars.empty())
             return GuiderUtils::Vector(-1, -1, -1);
 
@@ -445,7 +470,8 @@ SSolver::Parameters GuideStars::getStarExtractionParameters(int num)
 }
 
 // This is the interface to star detection.
-int GuideStars::findAllSEPStars(const QSharedPointer<FITSData> &imageData, QList<Edge *> *sepStars, int num)
+int GuideStars::findAllSEPStars(const QSharedPointer<FITSData> &imageData, QList<Edge *> *sepStars, int num,
+                                const QList<Edge> *seeds)
 {
     if (imageData == nullptr)
         return 0;
@@ -454,7 +480,10 @@ int GuideStars::findAllSEPStars(const QSharedPointer<FITSData> &imageData, QList
     settings["optionsProfileIndex"] = Options::guideOptionsProfile();
     settings["optionsProfileGroup"] = static_cast<int>(Ekos::GuideProfiles);
     imageData->setSourceExtractorSettings(settings);
-    imageData->findStars(ALGORITHM_SEP).waitForFinished();
+    if (seeds != nullptr && !seeds->isEmpty())
+        imageData->findStars(*seeds).waitForFinished();
+    else
+        imageData->findStars(ALGORITHM_SEP).waitForFinished();
     skyBackground = imageData->getSkyBackground();
 
     QList<Edge *> edges = imageData->getStarCenters();
@@ -495,7 +524,8 @@ double GuideStars::findMinDistance(int index, const QList<Edge*> &stars)
 // If the region-of-interest rectange is not null, it only returns scores in that area.
 void GuideStars::findTopStars(const QSharedPointer<FITSData> &imageData, int num, QList<Edge> *stars,
                               const double maxHFR, const QRect *roi,
-                              QList<double> *outputScores, QList<double> *minDistances)
+                              QList<double> *outputScores, QList<double> *minDistances,
+                              const QList<Edge> *seeds)
 {
     if (roi == nullptr)
         DLOG(KSTARS_EKOS_GUIDE) << "Multistar: findTopStars" << num;
@@ -510,7 +540,7 @@ void GuideStars::findTopStars(const QSharedPointer<FITSData> &imageData, int num
     QElapsedTimer timer;
     timer.restart();
     QList<Edge*> sepStars;
-    int count = findAllSEPStars(imageData, &sepStars, num * 2);
+    int count = findAllSEPStars(imageData, &sepStars, num * 2, seeds);
     if (count == 0)
         return;
 
@@ -642,6 +672,12 @@ void GuideStars::computeStarDrift(const Edge &star, const Edge &reference, doubl
 // originally selected the guide star, e.g. due to dithering, etc. We compute an offset from the
 // original guide-star position and the reticle position and offset all the reference star
 // positions by that.
+bool GuideStars::deadlinePassed() const
+{
+    const qint64 deadline = Options::guideMultiStarDeadline();
+    return deadline > 0 && m_FrameTimer.isValid() && m_FrameTimer.elapsed() > deadline;
+}
+
 bool GuideStars::getDrift(double oneStarDrift, double reticle_x, double reticle_y,
                           double *RADrift, double *DECDrift)
 {
@@ -680,10 +716,28 @@ bool GuideStars::getDrift(double oneStarDrift, double reticle_x, double reticle_
     double guideStarRADrift = 0, guideStarDECDrift = 0;
     QVector<double> raDrifts, decDrifts;
 
+    // Process the stars by decreasing score, which is their detection order, but the guide
+    // star first, as the other drifts are checked against it.
+    QVector<int> order;
+    order.reserve(detectedStars.size());
+    for (int i = 0; i < detectedStars.size(); ++i)
+    {
+        if (getStarMap(i) == starCorrespondence.guideStar())
+            order.prepend(i);
+        else
+            order.push_back(i);
+    }
+
     DLOG(KSTARS_EKOS_GUIDE)
             << QString("%1 %2  dRA   dDEC").arg(logHeader("")).arg(logHeader("    Ref:"));
-    for (int i = 0; i < detectedStars.size(); ++i)
+    for (const int i : order)
     {
+        if (numStarsProcessed >= MIN_BUDGET_DRIFT_STARS && deadlinePassed())
+        {
+            qCDebug(KSTARS_EKOS_GUIDE) << "Multistar: time budget used up after" << numStarsProcessed << "stars";
+            break;
+        }
+
         const auto &star = detectedStars[i];
         auto bg = skybackground();
         double snr = bg.SNR(detectedStars[i].sum, detectedStars[i].numPixels);
@@ -734,6 +788,7 @@ bool GuideStars::getDrift(double oneStarDrift, double reticle_x, double reticle_
         return false;  // Shouldn't happen.
 
     numStarsProcessed = raDriftsKeep.size();
+    m_NumStarsUsed = numStarsProcessed;
 
     // Generate the drift either from the median or the average of the usable reference drifts.
     bool useMedian = true;
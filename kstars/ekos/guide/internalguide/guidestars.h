@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <QElapsedTimer>
 #include <QObject>
 #include <QList>
 #include <QVector3D>
@@ -99,9 +100,16 @@ class GuideStars
             return starCorrespondence.size();
         }
 
+        // Returns the number of stars whose drift was used by the last getDrift().
+        int getNumStarsUsed() const
+        {
+            return m_NumStarsUsed;
+        }
+
         void reset()
         {
             starCorrespondence.reset();
+            m_TrackedStars.clear();
         }
 
     private:
@@ -121,9 +129,12 @@ class GuideStars
                           const double maxHFR,
                           const QRect *roi = nullptr,
                           QList<double> *outputScores = nullptr,
-                          QList<double> *minDistances = nullptr);
+                          QList<double> *minDistances = nullptr,
+                          const QList<Edge> *seeds = nullptr);
         // The interface to the SEP star detection algoritms.
-        int findAllSEPStars(const QSharedPointer<FITSData> &imageData, QList<Edge*> *sepStars, int num);
+        // If seeds are given, only searches around them, see FITSData::findStars(const QList<Edge> &).
+        int findAllSEPStars(const QSharedPointer<FITSData> &imageData, QList<Edge*> *sepStars, int num,
+                            const QList<Edge> *seeds = nullptr);
 
         // Convert from input image coordinates to output RA and DEC coordinates.
         GuiderUtils::Vector point2arcsec(const GuiderUtils::Vector &p) const;
@@ -138,6 +149,9 @@ class GuideStars
                                   int maxX, int maxY,
                                   const QList<double> &minDistances);
 
+        // True if the time budget of the current frame, Options::guideMultiStarDeadline(), is used up.
+        bool deadlinePassed() const;
+
         // Computes the distance from stars[i] to its closest neighbor.
         double findMinDistance(int index, const QList<Edge*> &stars);
 
@@ -175,6 +189,8 @@ class GuideStars
         QVector<int> starMap;
         // This maps between the newly detected stars and the reference stars.
         QList<Edge> detectedStars;
+        // The stars detected in the previous guide frame, used to seed the detection in the next one.
+        QList<Edge> m_TrackedStars;
 
         Calibration calibration;
         bool calibrationInitialized {false};
@@ -185,6 +201,10 @@ class GuideStars
         int unreliableDectionCounter { 0 };
 
         int m_NumStarsDetected { 0 };
+        int m_NumStarsUsed { 0 };
+
+        // Started by findGuideStar(), measures the time spent on the current frame.
+        QElapsedTimer m_FrameTimer;
 
         friend class TestGuideStars;
 };
@@ -0,0 +1,298 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "guidetelemetry.h"
+
+#include "ekos_guide_debug.h"
+
+#include <QTextStream>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+
+struct Header
+{
+    char magic[8];
+    quint32 byteOrder;
+    quint32 version;
+    quint32 recordSize;
+    quint32 reserved;
+};
+
+constexpr char MAGIC[8] = { 'K', 'S', 'G', 'U', 'I', 'D', 'E', 'T' };
+constexpr quint32 BYTE_ORDER_MARK = 0x01020304;
+
+// How long the writer sleeps when the guide thread doesn't wake it.
+constexpr int WRITER_TIMEOUT = 1000; // milliseconds
+
+static_assert(sizeof(Header) == 24, "The telemetry header must have a fixed size");
+static_assert(sizeof(GuideTelemetry::Record) == 64, "Telemetry records must have a fixed size");
+
+} // namespace
+
+GuideTelemetry::GuideTelemetry()
+{
+}
+
+GuideTelemetry::~GuideTelemetry()
+{
+    close();
+}
+
+bool GuideTelemetry::open(const QString &filename)
+{
+    close();
+
+    m_File.setFileName(filename);
+    if (!m_File.open(QIODevice::WriteOnly))
+    {
+        qCWarning(KSTARS_EKOS_GUIDE) << "Cannot create guide telemetry file" << filename << m_File.errorString();
+        return false;
+    }
+
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.version = VERSION;
+    header.recordSize = sizeof(Record);
+    header.reserved = 0;
+    if (m_File.write(reinterpret_cast<const char *>(&header), sizeof(header)) != sizeof(header))
+    {
+        qCWarning(KSTARS_EKOS_GUIDE) << "Cannot write guide telemetry file" << filename << m_File.errorString();
+        m_File.close();
+        return false;
+    }
+
+    m_Queue.resize(QUEUE_SIZE);
+    m_Head = 0;
+    m_Tail = 0;
+    m_Dropped = 0;
+    m_Running = true;
+    m_Writer = std::thread(&GuideTelemetry::writerLoop, this);
+    return true;
+}
+
+void GuideTelemetry::close()
+{
+    if (!m_Running)
+        return;
+
+    m_Running = false;
+    m_Pending.release();
+    m_Writer.join();
+    m_File.close();
+
+    if (m_Dropped > 0)
+        qCWarning(KSTARS_EKOS_GUIDE) << "Guide telemetry dropped" << m_Dropped << "records";
+}
+
+void GuideTelemetry::startGuiding(const GuideLog::GuideInfo &info, const QDateTime &time)
+{
+    Record record = {};
+    record.timestamp = time.toMSecsSinceEpoch();
+    record.type = GUIDING_START;
+    record.code = static_cast<qint8>(info.pierSide);
+    record.index = info.binning;
+    record.start.pixelScale = info.pixelScale;
+    record.start.focalLength = info.focalLength;
+    record.start.ra = info.ra;
+    record.start.dec = info.dec;
+    record.start.azimuth = info.azimuth;
+    record.start.altitude = info.altitude;
+    record.start.xangle = info.xangle;
+    record.start.xrate = info.xrate;
+    record.start.yangle = info.yangle;
+    record.start.yrate = info.yrate;
+    push(record);
+}
+
+void GuideTelemetry::addGuideData(int index, const GuideLog::GuideData &data)
+{
+    Record record = {};
+    record.timestamp = QDateTime::currentMSecsSinceEpoch();
+    record.type = data.type == GuideLog::GuideData::MOUNT ? GUIDE_FRAME : GUIDE_DROP;
+    record.raDirection = static_cast<quint8>(data.raDirection);
+    record.decDirection = static_cast<quint8>(data.decDirection);
+    record.code = static_cast<qint8>(data.code);
+    record.index = index;
+    record.frame.dx = data.dx;
+    record.frame.dy = data.dy;
+    record.frame.raDistance = data.raDistance;
+    record.frame.decDistance = data.decDistance;
+    record.frame.raGuideDistance = data.raGuideDistance;
+    record.frame.decGuideDistance = data.decGuideDistance;
+    record.frame.raDuration = data.raDuration;
+    record.frame.decDuration = data.decDuration;
+    record.frame.mass = data.mass;
+    record.frame.snr = data.snr;
+    record.frame.starsDetected = data.starsDetected;
+    record.frame.starsUsed = data.starsUsed;
+    push(record);
+}
+
+void GuideTelemetry::endGuiding(const QDateTime &time)
+{
+    Record record = {};
+    record.timestamp = time.toMSecsSinceEpoch();
+    record.type = GUIDING_END;
+    push(record);
+}
+
+void GuideTelemetry::push(const Record &record)
+{
+    if (!m_Running)
+        return;
+
+    const quint32 head = m_Head.load(std::memory_order_relaxed);
+    if (head - m_Tail.load(std::memory_order_acquire) >= static_cast<quint32>(QUEUE_SIZE))
+    {
+        m_Dropped++;
+        return;
+    }
+
+    m_Queue[head & (QUEUE_SIZE - 1)] = record;
+    m_Head.store(head + 1, std::memory_order_release);
+    m_Pending.release();
+}
+
+void GuideTelemetry::writerLoop()
+{
+    while (m_Running)
+    {
+        m_Pending.tryAcquire(1, WRITER_TIMEOUT);
+        // One wake up is enough for all the records queued meanwhile.
+        m_Pending.tryAcquire(m_Pending.available());
+        drain();
+    }
+    drain();
+}
+
+bool GuideTelemetry::drain()
+{
+    quint32 tail = m_Tail.load(std::memory_order_relaxed);
+    const quint32 head = m_Head.load(std::memory_order_acquire);
+    if (tail == head)
+        return false;
+
+    while (tail != head)
+    {
+        // The records up to the end of the ring in one write.
+        const quint32 first = tail & (QUEUE_SIZE - 1);
+        const quint32 count = std::min(head - tail, static_cast<quint32>(QUEUE_SIZE) - first);
+        m_File.write(reinterpret_cast<const char *>(&m_Queue[first]), count * sizeof(Record));
+        tail += count;
+        m_Tail.store(tail, std::memory_order_release);
+    }
+    m_File.flush();
+    return true;
+}
+
+bool GuideTelemetry::read(const QString &filename, QVector<Record> *records)
+{
+    records->clear();
+
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    Header header;
+    if (file.read(reinterpret_cast<char *>(&header), sizeof(header)) != sizeof(header) ||
+            std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+            header.byteOrder != BYTE_ORDER_MARK || header.version != VERSION ||
+            header.recordSize != sizeof(Record))
+    {
+        qCWarning(KSTARS_EKOS_GUIDE) << filename << "is not a guide telemetry file of this version";
+        return false;
+    }
+
+    // A partial record at the end, e.g. after a crash, is ignored.
+    const QByteArray data = file.readAll();
+    records->resize(data.size() / sizeof(Record));
+    std::memcpy(records->data(), data.constData(), records->size() * sizeof(Record));
+    return true;
+}
+
+bool GuideTelemetry::convertToText(const QString &binaryFilename, const QString &textFilename)
+{
+    QVector<Record> records;
+    if (!read(binaryFilename, &records))
+        return false;
+
+    QFile file(textFilename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        return false;
+    QTextStream out(&file);
+
+    const auto time = [](qint64 timestamp)
+    {
+        return QDateTime::fromMSecsSinceEpoch(timestamp);
+    };
+
+    if (!records.isEmpty())
+        out << GuideLog::logStartText(time(records.first().timestamp));
+
+    qint64 guidingStart = 0;
+    for (const Record &record : records)
+    {
+        switch (record.type)
+        {
+            case GUIDING_START:
+            {
+                GuideLog::GuideInfo info;
+                info.pixelScale = record.start.pixelScale;
+                info.binning = record.index;
+                info.focalLength = record.start.focalLength;
+                info.ra = record.start.ra;
+                info.dec = record.start.dec;
+                info.azimuth = record.start.azimuth;
+                info.altitude = record.start.altitude;
+                info.pierSide = static_cast<ISD::Mount::PierSide>(record.code);
+                info.xangle = record.start.xangle;
+                info.xrate = record.start.xrate;
+                info.yangle = record.start.yangle;
+                info.yrate = record.start.yrate;
+                out << GuideLog::guidingStartText(info, time(record.timestamp));
+                guidingStart = record.timestamp;
+                break;
+            }
+            case GUIDE_FRAME:
+            case GUIDE_DROP:
+            {
+                GuideLog::GuideData data;
+                data.type = record.type == GUIDE_FRAME ? GuideLog::GuideData::MOUNT : GuideLog::GuideData::DROP;
+                data.dx = record.frame.dx;
+                data.dy = record.frame.dy;
+                data.raDistance = record.frame.raDistance;
+                data.decDistance = record.frame.decDistance;
+                data.raGuideDistance = record.frame.raGuideDistance;
+                data.decGuideDistance = record.frame.decGuideDistance;
+                data.raDuration = record.frame.raDuration;
+                data.raDirection = static_cast<GuideDirection>(record.raDirection);
+                data.decDuration = record.frame.decDuration;
+                data.decDirection = static_cast<GuideDirection>(record.decDirection);
+                data.mass = record.frame.mass;
+                data.snr = record.frame.snr;
+                data.code = static_cast<GuideLog::GuideData::ErrorCode>(record.code);
+                out << GuideLog::guideDataText(record.index, (record.timestamp - guidingStart) / 1000.0, data);
+                break;
+            }
+            case GUIDING_END:
+                out << GuideLog::guidingEndText(time(record.timestamp));
+                break;
+            default:
+                qCDebug(KSTARS_EKOS_GUIDE) << "Skipping guide telemetry record of unknown type" << record.type;
+                break;
+        }
+    }
+
+    if (!records.isEmpty())
+        out << GuideLog::logEndText(time(records.last().timestamp));
+    out.flush();
+    return true;
+}
@@ -0,0 +1,121 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "guidelog.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QSemaphore>
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// This class writes the guiding sessions of GuideLog to a compact binary file of fixed size
+// records. The guide thread only copies a record into a lock-free single producer, single
+// consumer queue, and a writer thread appends the queued records to the file.
+//
+// A file starts with a 24 byte header: the magic "KSGUIDET", a byte order mark, the version
+// and the size of a record, and a reserved word. Records follow. Everything is in host byte
+// order, which is checked when reading. convertToText() writes the text GuideLog writes.
+
+class GuideTelemetry
+{
+    public:
+        static constexpr const char *FILE_EXTENSION = ".kgtl";
+        static constexpr quint32 VERSION = 1;
+
+        enum RecordType : quint8
+        {
+            GUIDING_START = 1,
+            // A frame that was guided, GuideData::MOUNT
+            GUIDE_FRAME,
+            // A frame without a star, GuideData::DROP
+            GUIDE_DROP,
+            GUIDING_END
+        };
+
+        struct Record
+        {
+            // Milliseconds since the epoch, UTC
+            qint64 timestamp;
+            quint8 type;
+            quint8 raDirection, decDirection;
+            // The GuideData error code for frames, the pier side for starts
+            qint8 code;
+            // The frame number, or the binning for starts
+            qint32 index;
+            union
+            {
+                struct
+                {
+                    float dx, dy;
+                    float raDistance, decDistance;
+                    float raGuideDistance, decGuideDistance;
+                    qint32 raDuration, decDuration;
+                    float mass, snr;
+                    qint32 starsDetected, starsUsed;
+                } frame;
+                // Guiding starts, the binning is in index
+                struct
+                {
+                    float pixelScale, focalLength;
+                    float ra, dec, azimuth, altitude;
+                    float xangle, xrate, yangle, yrate;
+                } start;
+            };
+        };
+
+        GuideTelemetry();
+        ~GuideTelemetry();
+
+        // Creates the file and starts the writer thread.
+        bool open(const QString &filename);
+        // Writes the queued records and closes the file.
+        void close();
+
+        void startGuiding(const GuideLog::GuideInfo &info, const QDateTime &time);
+        void addGuideData(int index, const GuideLog::GuideData &data);
+        void endGuiding(const QDateTime &time);
+
+        // Returns the number of records that were dropped because the queue was full.
+        int droppedRecords() const
+        {
+            return m_Dropped;
+        }
+
+        // Reads all records of a telemetry file, returns false if it isn't one.
+        static bool read(const QString &filename, QVector<Record> *records);
+
+        // Writes the records of a telemetry file as a PHD2 guide log, the format of GuideLog.
+        static bool convertToText(const QString &binaryFilename, const QString &textFilename);
+
+    private:
+        // Called on the guide thread, drops the record if the queue is full.
+        void push(const Record &record);
+        void writerLoop();
+        // Writes the records in the queue, returns false if there were none.
+        bool drain();
+
+        // Power of two, 256 kB of records.
+        static constexpr int QUEUE_SIZE = 4096;
+
+        QFile m_File;
+        std::thread m_Writer;
+        std::atomic<bool> m_Running { false };
+        QSemaphore m_Pending;
+
+        // The queue. Only the guide thread advances m_Head, only the writer advances m_Tail.
+        std::vector<Record> m_Queue;
+        std::atomic<quint32> m_Head { 0 };
+        std::atomic<quint32> m_Tail { 0 };
+        std::atomic<int> m_Dropped { 0 };
+};
@@ -14,6 +14,7 @@
 #include "auxiliary/kspaths.h"
 #include "fitsviewer/fitsdata.h"
 #include "fitsviewer/fitsview.h"
+#include "calibrationstore.h"
 #include "guidealgorithms.h"
 #include "ksnotification.h"
 #include "ekos/auxiliary/stellarsolverprofileeditor.h"
@@ -777,6 +778,12 @@ void InternalGuider::iterateCalibration()
                               i18n("Guiding calibration completed successfully"), KSNotification::Guide);
         emit DESwapChanged(pmath->getCalibration().declinationSwapEnabled());
         pmath->setTargetPosition(calibrationStartX, calibrationStartY);
+        if (!m_OpticalTrain.isEmpty())
+        {
+            CalibrationStore store;
+            store.add(m_OpticalTrain, pmath->getCalibration());
+            store.save();
+        }
         reset();
     }
 }
@@ -789,6 +796,9 @@ void InternalGuider::setGuideView(const QSharedPointer<GuideView> &guideView)
 void InternalGuider::setImageData(const QSharedPointer<FITSData> &data)
 {
     m_ImageData = data;
+    m_LatencyTimer.start();
+    m_StarFoundTime = m_PulseSentTime = -1;
+    m_AwaitingAcknowledge = false;
     if (Options::saveGuideImages())
     {
         QDateTime now(QDateTime::currentDateTime());
@@ -819,16 +829,29 @@ void InternalGuider::reset()
 bool InternalGuider::clearCalibration()
 {
     Options::setSerializedCalibration("");
+    CalibrationStore store;
+    store.remove(m_OpticalTrain);
+    store.save();
     pmath->getMutableCalibration()->reset();
     return true;
 }
 
 bool InternalGuider::restoreCalibration()
 {
-    bool success = Options::reuseGuideCalibration() &&
-                   pmath->getMutableCalibration()->restore(
-                       pierSide, Options::reverseDecOnPierSideChange(),
-                       subBinX, subBinY, &mountDEC);
+    if (!Options::reuseGuideCalibration())
+        return false;
+
+    // Prefer the stored calibration of this train. The last calibration, whatever its train,
+    // is only used until the store has its first calibration.
+    const CalibrationStore store;
+    const QString encoding = store.find(m_OpticalTrain, pierSide, &mountDEC);
+    bool success = false;
+    if (!encoding.isEmpty())
+        success = pmath->getMutableCalibration()->restore(
+                      encoding, pierSide, Options::reverseDecOnPierSideChange(), subBinX, subBinY, &mountDEC);
+    else if (store.isEmpty())
+        success = pmath->getMutableCalibration()->restore(
+                      pierSide, Options::reverseDecOnPierSideChange(), subBinX, subBinY, &mountDEC);
     if (success)
         emit DESwapChanged(pmath->getCalibration().declinationSwapEnabled());
     return success;
@@ -862,6 +885,18 @@ void InternalGuider::setDECSwap(bool enable)
     pmath->getMutableCalibration()->setDeclinationSwapEnabled(enable);
 }
 
+void InternalGuider::pulsesAcknowledged()
+{
+    if (!m_AwaitingAcknowledge)
+        return;
+    m_AwaitingAcknowledge = false;
+
+    const double acknowledged = m_LatencyTimer.nsecsElapsed() / 1e6;
+    qCDebug(KSTARS_EKOS_GUIDE) << QString("Guide latency: star found %1ms, pulses sent %2ms, acknowledged %3ms")
+                               .arg(m_StarFoundTime, 0, 'f', 1).arg(m_PulseSentTime, 0, 'f', 1).arg(acknowledged, 0, 'f', 1);
+    emit newGuideLatency(m_StarFoundTime, m_PulseSentTime, acknowledged);
+}
+
 void InternalGuider::setSquareAlgorithm(int index)
 {
     if (index == SEP_MULTISTAR && !pmath->usingSEPMultiStar())
@@ -952,14 +987,16 @@ bool InternalGuider::processGuiding()
     {
         auto const timeStep = calculateGPGTimeStep();
         pmath->performProcessing(state, m_ImageData, m_GuideFrame, timeStep, &guideLog);
+        m_StarFoundTime = m_LatencyTimer.nsecsElapsed() / 1e6;
         if (pmath->usingSEPMultiStar())
         {
             QString info = "";
             auto gs = pmath->getGuideStars();
-            info = QString("%1 stars, %2/%3 refs")
+            info = QString("%1 stars, %2/%3 refs, %4 used")
                    .arg(gs.getNumStarsDetected())
                    .arg(gs.getNumReferencesFound())
-                   .arg(gs.getNumReferences());
+                   .arg(gs.getNumReferences())
+                   .arg(gs.getNumStarsUsed());
 
             emit guideInfo(info);
         }
@@ -997,6 +1034,9 @@ bool InternalGuider::processGuiding()
     {
         emit newMultiPulse(out->pulse_dir[GUIDE_RA], out->pulse_length[GUIDE_RA],
                            out->pulse_dir[GUIDE_DEC], out->pulse_length[GUIDE_DEC], StartCaptureAfterPulses);
+        // Guide is connected directly, the pulses are out when the signal returns
+        m_PulseSentTime = m_LatencyTimer.nsecsElapsed() / 1e6;
+        m_AwaitingAcknowledge = m_StarFoundTime >= 0;
     }
     else
         emit frameCaptureRequested();
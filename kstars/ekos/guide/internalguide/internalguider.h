@@ -63,6 +63,11 @@ class InternalGuider : public GuideInterface
 
         bool clearCalibration() override;
         bool restoreCalibration();
+        // Calibrations are stored and restored per optical train
+        void setOpticalTrain(const QString &name)
+        {
+            m_OpticalTrain = name;
+        }
 
         bool reacquire() override;
 
@@ -121,6 +126,8 @@ class InternalGuider : public GuideInterface
 
     public slots:
         void setDECSwap(bool enable);
+        // The driver answered the pulses of the last guide frame
+        void pulsesAcknowledged();
 
 
     protected slots:
@@ -134,6 +141,9 @@ class InternalGuider : public GuideInterface
         void newSinglePulse(GuideDirection dir, int msecs, CaptureAfterPulses followWithCapture);
         //void newStarPosition(QVector3D, bool);
         void DESwapChanged(bool enable);
+        // The times, in milliseconds after the guide frame reached the guider, at which the star was
+        // found, the pulses were sent and the driver acknowledged them.
+        void newGuideLatency(double starFound, double pulseSent, double pulseAcknowledged);
     private:
         // Guiding
         bool processGuiding();
@@ -152,6 +162,7 @@ class InternalGuider : public GuideInterface
         bool m_isStarted { false };
         bool m_isSubFramed { false };
         bool m_isFirstFrame { false };
+        QString m_OpticalTrain;
         int m_starLostCounter { 0 };
 
         QFile logFile;
@@ -163,6 +174,12 @@ class InternalGuider : public GuideInterface
         QElapsedTimer reacquireTimer;
         int m_highRMSCounter {0};
 
+        // Latency of the guide loop, measured from the arrival of the frame
+        QElapsedTimer m_LatencyTimer;
+        double m_StarFoundTime { -1 };
+        double m_PulseSentTime { -1 };
+        bool m_AwaitingAcknowledge { false };
+
         GuiderUtils::Matrix ROT_Z;
         Ekos::GuideState rememberState { GUIDE_IDLE };
 
@@ -7,58 +7,108 @@
 #include "starcorrespondence.h"
 
 #include <math.h>
+#include <algorithm>
+#include <cmath>
 #include "ekos_guide_debug.h"
 
-// Finds the star in sortedStars that's closest to x,y and within maxDistance pixels.
-// Returns the index of the closest star in  sortedStars, or -1 if none satisfies the criteria.
-// sortedStars must be sorted by x, from lower x to higher x.
-// Fills distance to the pixel distance to the closest star.
-int StarCorrespondence::findClosestStar(double x, double y, const QList<Edge> sortedStars,
-                                        double maxDistance, double *distance) const
+namespace
 {
-    if (x < -maxDistance || y < -maxDistance ||
-            x > imageWidth + maxDistance || y > imageWidth + maxDistance)
-        return -1;
+// Bounds the number of grid cells relative to the number of stars, for small search distances.
+constexpr int MAX_CELLS_PER_STAR = 4;
+}
+
+StarCorrespondence::StarGrid::StarGrid(const QList<Edge> &stars, double cellSize) : m_Stars(stars)
+{
+    if (stars.isEmpty())
+        return;
+
+    double maxX = stars[0].x, maxY = stars[0].y;
+    m_MinX = stars[0].x;
+    m_MinY = stars[0].y;
+    for (const auto &star : stars)
+    {
+        m_MinX = std::min<double>(m_MinX, star.x);
+        m_MinY = std::min<double>(m_MinY, star.y);
+        maxX = std::max<double>(maxX, star.x);
+        maxY = std::max<double>(maxY, star.y);
+    }
 
-    const int size = sortedStars.size();
-    int startPoint = 0;
+    // Grow the cells if the grid would have many more cells than stars.
+    m_CellSize = std::max(cellSize, 1.0);
+    const double area = std::max(maxX - m_MinX, 1.0) * std::max(maxY - m_MinY, 1.0);
+    m_CellSize = std::max(m_CellSize, sqrt(area / (MAX_CELLS_PER_STAR * stars.size())));
+    m_Columns = static_cast<int>((maxX - m_MinX) / m_CellSize) + 1;
+    m_Rows = static_cast<int>((maxY - m_MinY) / m_CellSize) + 1;
 
-    // Efficiency improvement to quickly find the start point.
-    // Increments by size/10 to find a better start point.
-    const int coarseIncrement = size / 10;
-    if (coarseIncrement > 1)
+    // Counting sort of the star indexes by cell, which keeps them increasing within a cell.
+    QVector<int> cells(stars.size());
+    m_CellStart = QVector<int>(m_Columns * m_Rows + 1, 0);
+    for (int i = 0; i < stars.size(); ++i)
     {
-        for (int i = 0; i < size; i += coarseIncrement)
-        {
-            if (sortedStars[i].x < x - maxDistance)
-                startPoint = i;
-            else
-                break;
-        }
+        const int column = static_cast<int>((stars[i].x - m_MinX) / m_CellSize);
+        const int row = static_cast<int>((stars[i].y - m_MinY) / m_CellSize);
+        cells[i] = row * m_Columns + column;
+        m_CellStart[cells[i] + 1]++;
     }
+    for (int c = 0; c < m_Columns * m_Rows; ++c)
+        m_CellStart[c + 1] += m_CellStart[c];
 
-    // Iterate through the stars starting with the star with lowest x where x >= x - maxDistance
-    // through the star with greatest x where x <= x + maxDistance.  Find the closest star to x,y.
+    m_Indexes.resize(stars.size());
+    QVector<int> next = m_CellStart;
+    for (int i = 0; i < stars.size(); ++i)
+        m_Indexes[next[cells[i]]++] = i;
+}
+
+// Returns the index of the closest star within maxDistance pixels, or -1 if there is none.
+// Of stars at the same distance, the one with the highest index is chosen.
+int StarCorrespondence::StarGrid::closest(double x, double y, double maxDistance, double *distance) const
+{
     int bestIndex = -1;
     double bestSquaredDistance = maxDistance * maxDistance;
-    for (int i = startPoint; i < size; ++i)
+
+    // The cells are at least maxDistance wide, so the neighbors of the cell of x,y are enough.
+    const int column = static_cast<int>(std::floor((x - m_MinX) / m_CellSize));
+    const int row = static_cast<int>(std::floor((y - m_MinY) / m_CellSize));
+    const int firstColumn = std::max(column - 1, 0), lastColumn = std::min(column + 1, m_Columns - 1);
+    const int firstRow = std::max(row - 1, 0), lastRow = std::min(row + 1, m_Rows - 1);
+
+    for (int r = firstRow; r <= lastRow; ++r)
     {
-        auto &star = sortedStars[i];
-        if (star.x < x - maxDistance) continue;
-        if (star.x > x + maxDistance) break;
-        const double xDiff = star.x - x;
-        const double yDiff = star.y - y;
-        const double squaredDistance = xDiff * xDiff + yDiff * yDiff;
-        if (squaredDistance <= bestSquaredDistance)
+        for (int c = firstColumn; c <= lastColumn; ++c)
         {
-            bestIndex = i;
-            bestSquaredDistance = squaredDistance;
+            const int cell = r * m_Columns + c;
+            for (int k = m_CellStart[cell]; k < m_CellStart[cell + 1]; ++k)
+            {
+                const int i = m_Indexes[k];
+                const double xDiff = m_Stars[i].x - x;
+                const double yDiff = m_Stars[i].y - y;
+                const double squaredDistance = xDiff * xDiff + yDiff * yDiff;
+                if (squaredDistance < bestSquaredDistance ||
+                        (squaredDistance == bestSquaredDistance && i > bestIndex))
+                {
+                    bestIndex = i;
+                    bestSquaredDistance = squaredDistance;
+                }
+            }
         }
     }
     if (distance != nullptr) *distance = sqrt(bestSquaredDistance);
     return bestIndex;
 }
 
+// Finds the star indexed by grid that's closest to x,y and within maxDistance pixels.
+// Returns the index of the closest star, or -1 if none satisfies the criteria.
+// Fills distance to the pixel distance to the closest star.
+int StarCorrespondence::findClosestStar(double x, double y, const StarGrid &grid,
+                                        double maxDistance, double *distance) const
+{
+    if (x < -maxDistance || y < -maxDistance ||
+            x > imageWidth + maxDistance || y > imageHeight + maxDistance)
+        return -1;
+
+    return grid.closest(x, y, maxDistance, distance);
+}
+
 namespace
 {
 // Sorts stars by their x values, places the sorted stars into sortedStars.
@@ -133,7 +183,7 @@ void StarCorrespondence::reset()
     initialized = false;
 }
 
-int StarCorrespondence::findInternal(const QList<Edge> &stars, double maxDistance, QVector<int> *starMap,
+int StarCorrespondence::findInternal(const QList<Edge> &stars, const StarGrid &grid, double maxDistance, QVector<int> *starMap,
                                      int guideStarIndex, const QVector<Offsets> &offsets,
                                      int *numFound, int *numNotFound, double minFraction) const
 {
@@ -182,7 +232,7 @@ int StarCorrespondence::findInternal(const QList<Edge> &stars, double maxDistanc
             const auto &offset = offsets[offsetIndex];
             double distance;
             const int closestIndex = findClosestStar(starX + offset.x, starY + offset.y,
-                                     stars, maxDistance, &distance);
+                                     grid, maxDistance, &distance);
             if (closestIndex < 0)
             {
                 // This reference star position had no corresponding input star.
@@ -326,14 +376,15 @@ Edge StarCorrespondence::find(const QList<Edge> &stars, double maxDistance,
     if (!initialized)  return foundStar;
     int numFound, numNotFound;
 
-    // findClosestStar needs an input with stars sorted by their x.
-    // Do this outside of the loops.
+    // The stars are sorted by their x, which keeps the order in which candidates are tried,
+    // and indexed once for all the searches below.
     QList<Edge> sortedStars;
     QVector<int> sortedToOriginal;
     sortByX(stars, &sortedStars, &sortedToOriginal);
+    const StarGrid grid(sortedStars, maxDistance);
 
     QVector<int> sortedStarMap;
-    int bestStarIndex = findInternal(sortedStars, maxDistance, &sortedStarMap, guideStarIndex,
+    int bestStarIndex = findInternal(sortedStars, grid, maxDistance, &sortedStarMap, guideStarIndex,
                                      guideStarOffsets, &numFound, &numNotFound, minFraction);
 
     if (bestStarIndex > -1)
@@ -367,7 +418,7 @@ Edge StarCorrespondence::find(const QList<Edge> &stars, double maxDistance,
             QVector<Offsets> gStarOffsets;
             makeOffsets(guideStarOffsets, &gStarOffsets, gStarIndex);
             QVector<int> newStarMap;
-            int detectedStarIndex = findInternal(sortedStars, maxDistance, &newStarMap,
+            int detectedStarIndex = findInternal(sortedStars, grid, maxDistance, &newStarMap,
                                                  gStarIndex, gStarOffsets,
                                                  &numFound, &numNotFound, minFraction);
             if (detectedStarIndex >= 0 && numFound > bestNumFound)
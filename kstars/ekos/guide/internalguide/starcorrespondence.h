@@ -105,13 +105,36 @@ class StarCorrespondence
             Offsets() : x(0), y(0) {}  // RPi compiler required this constructor.
         };
 
+        // A uniform grid over the positions of the input stars, built once per find(),
+        // so that the closest star to a position is found by looking at the cells around it
+        // instead of scanning the star list. Cells are at least as large as the search distance.
+        class StarGrid
+        {
+            public:
+                StarGrid(const QList<Edge> &stars, double cellSize);
+
+                // Returns the index in stars of the star closest to x,y and within maxDistance,
+                // which must not exceed the cell size, or -1. Fills distance like findClosestStar().
+                int closest(double x, double y, double maxDistance, double *distance) const;
+
+            private:
+                const QList<Edge> &m_Stars;
+                double m_MinX { 0 }, m_MinY { 0 };
+                double m_CellSize { 1 };
+                int m_Columns { 0 }, m_Rows { 0 };
+                // The stars of cell c are m_Indexes[m_CellStart[c]] to m_Indexes[m_CellStart[c + 1] - 1].
+                QVector<int> m_CellStart;
+                QVector<int> m_Indexes;
+        };
+
         // Update the reference-star offsets given the new star positions.
         // The adaption is similar to a 25-sample moving average.
         void initializeAdaptation();
         void adaptOffsets(const QList<Edge> &stars, const QVector<int> &starMap);
 
         // Utility used by find. Useful for iterating when the guide star is missing.
-        int findInternal(const QList<Edge> &stars, double maxDistance, QVector<int> *starMap,
+        // The grid indexes stars.
+        int findInternal(const QList<Edge> &stars, const StarGrid &grid, double maxDistance, QVector<int> *starMap,
                          int guideStarIndex, const QVector<Offsets> &offsets,
                          int *numFound, int *numNotFound, double minFraction) const;
 
@@ -127,9 +150,8 @@ class StarCorrespondence
         Edge inventStarPosition(const QList<Edge> &stars, const QVector<int> &starMap,
                                 QVector<Offsets> offsets, Offsets offset) const;
 
-        // Finds the star closest to x,y. Returns the index in sortedStars.
-        // sortedStars should be sorted in x, which allows for a speedup in search.
-        int findClosestStar(double x, double y, const QList<Edge> sortedStars,
+        // Finds the star closest to x,y. Returns the index in the stars indexed by grid.
+        int findClosestStar(double x, double y, const StarGrid &grid,
                             double maxDistance, double *distance) const;
 
         // The offsets of the reference stars relative to the guide star.
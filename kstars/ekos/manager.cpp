@@ -33,6 +33,7 @@
 #include "capture/captureprocess.h"
 #include "fitsviewer/fitsview.h"
 #include "fitsviewer/fitsdata.h"
+#include "fitsviewer/imagememory.h"
 #include "indi/clientmanager.h"
 #include "indi/driverinfo.h"
 #include "indi/drivermanager.h"
@@ -46,6 +47,7 @@
 #include "indi/indirotator.h"
 #include "mount/meridianflipstatuswidget.h"
 #include "ekos/auxiliary/rotatorutils.h"
+#include "ekos/auxiliary/indexfilecache.h"
 
 #include "ekoslive/ekosliveclient.h"
 #include "ekoslive/message.h"
@@ -85,6 +87,7 @@ void Manager::release()
     OpticalTrainManager::release();
     OpticalTrainSettings::release();
     RotatorUtils::release();
+    IndexFileCache::release();
     delete _Manager;
 }
 
@@ -550,6 +553,7 @@ void Manager::reset()
     OpticalTrainManager::release();
     OpticalTrainSettings::release();
     RotatorUtils::release();
+    IndexFileCache::release();
 
     m_DriverDevicesCount = 0;
 
@@ -2135,7 +2139,7 @@ void Manager::initMount()
 
     toolsWidget->tabBar()->setTabToolTip(index, i18n("Mount"));
     connect(mountModule(), &Ekos::Mount::newLog, this, &Ekos::Manager::updateLog);
-    connect(mountModule(), &Ekos::Mount::newCoords, this, &Ekos::Manager::updateMountCoords);
+    connect(mountModule()->getTelemetry().get(), &Ekos::MountTelemetry::uiSnapshot, this, &Ekos::Manager::updateMountCoords);
     connect(mountModule(), &Ekos::Mount::newStatus, this, &Ekos::Manager::updateMountStatus);
     connect(mountModule(), &Ekos::Mount::newTargetName, this, [this](const QString & name)
     {
@@ -2534,9 +2538,9 @@ void Manager::updateMountStatus(ISD::Mount::Status status)
     ekosLiveClient.get()->message()->updateMountStatus(cStatus);
 }
 
-void Manager::updateMountCoords(const SkyPoint position, ISD::Mount::PierSide pierSide, const dms &ha)
+void Manager::updateMountCoords(const MountTelemetry::Snapshot &snapshot)
 {
-    Q_UNUSED(pierSide)
+    const SkyPoint &position = snapshot.position;
     raOUT->setText(position.ra().toHMSString());
     decOUT->setText(position.dec().toDMSString());
     azOUT->setText(position.az().toDMSString());
@@ -2544,13 +2548,13 @@ void Manager::updateMountCoords(const SkyPoint position, ISD::Mount::PierSide pi
 
     QJsonObject cStatus =
     {
-        {"ra", dms::fromString(raOUT->text(), false).Degrees()},
-        {"de", dms::fromString(decOUT->text(), true).Degrees()},
+        {"ra", position.ra().Degrees()},
+        {"de", position.dec().Degrees()},
         {"ra0", position.ra0().Degrees()},
         {"de0", position.dec0().Degrees()},
-        {"az", dms::fromString(azOUT->text(), true).Degrees()},
-        {"at", dms::fromString(altOUT->text(), true).Degrees()},
-        {"ha", ha.Degrees()},
+        {"az", position.az().Degrees()},
+        {"at", position.alt().Degrees()},
+        {"ha", snapshot.ha.Degrees()},
     };
 
     ekosLiveClient.get()->message()->updateMountStatus(cStatus, true);
@@ -3139,6 +3143,9 @@ void Manager::connectModules()
 
             connect(guideModule(), &Ekos::Guide::guideStats,
                     analyzeProcess.get(), &Ekos::Analyze::guideStats, Qt::UniqueConnection);
+
+            connect(guideModule(), &Ekos::Guide::newGuideLatency,
+                    analyzeProcess.get(), &Ekos::Analyze::guideLatency, Qt::UniqueConnection);
         }
     }
 
@@ -3171,8 +3178,8 @@ void Manager::connectModules()
     {
         connect(mountModule(), &Ekos::Mount::newStatus,
                 analyzeProcess.get(), &Ekos::Analyze::mountState, Qt::UniqueConnection);
-        connect(mountModule(), &Ekos::Mount::newCoords,
-                analyzeProcess.get(), &Ekos::Analyze::mountCoords, Qt::UniqueConnection);
+        connect(mountModule()->getTelemetry().get(), &Ekos::MountTelemetry::analyzeSnapshot,
+                analyzeProcess.get(), &Ekos::Analyze::mountSnapshot, Qt::UniqueConnection);
         connect(mountModule()->getMeridianFlipState().get(), &Ekos::MeridianFlipState::newMountMFStatus,
                 analyzeProcess.get(), &Ekos::Analyze::mountFlipStatus, Qt::UniqueConnection);
     }
@@ -3306,6 +3313,11 @@ void Manager::setEkosLoggingEnabled(const QString &name, bool enabled)
     }
 }
 
+QVariantMap Manager::getImageMemory()
+{
+    return ImageMemory::instance().toVariantMap();
+}
+
 void Manager::acceptPortSelection()
 {
     if (m_PortSelector)
@@ -21,6 +21,7 @@
 #include "ksnotification.h"
 #include "auxiliary/opslogs.h"
 #include "ekos/capture/rotatorsettings.h"
+#include "ekos/mount/mounttelemetry.h"
 
 #include <QDialog>
 #include <QHash>
@@ -293,6 +294,13 @@ class Manager : public QDialog, public Ui::Manager
          */
         Q_SCRIPTABLE Q_NOREPLY void setEkosLoggingEnabled(const QString &name, bool enabled);
 
+        /**
+         * DBUS interface function.
+         * @return the memory of the images in bytes: the "budget", the "total", the images released over the budget as
+         * "evictions", and the bytes of each holder of images in "owners", such as "capture", "viewer" or "darkLibrary".
+         */
+        Q_SCRIPTABLE QVariantMap getImageMemory();
+
         /**
          * DBUS interface function.
          * If connection mode is local, the function first establishes an INDI server with all the specified drivers in Ekos options or as set by the user. For remote connection,
@@ -444,7 +452,7 @@ class Manager : public QDialog, public Ui::Manager
         void wizardProfile();
 
         // Mount Summary
-        void updateMountCoords(const SkyPoint position, ISD::Mount::PierSide pierSide, const dms &ha);
+        void updateMountCoords(const MountTelemetry::Snapshot &snapshot);
         void updateMountStatus(ISD::Mount::Status status);
         void setTarget(const QString &name);
 
@@ -53,7 +53,9 @@ void MeridianFlipState::setEnabled(bool value)
 
 void MeridianFlipState::connectMount(Mount *mount)
 {
-    connect(mount, &Mount::newCoords, this, &MeridianFlipState::updateTelescopeCoord, Qt::UniqueConnection);
+    // The flip only depends on noticeable changes of the position, not on every report of the mount
+    connect(mount->getTelemetry().get(), &MountTelemetry::snapshotChanged, this, &MeridianFlipState::updateTelemetry,
+            Qt::UniqueConnection);
     connect(mount, &Mount::newStatus, this, &MeridianFlipState::setMountStatus, Qt::UniqueConnection);
 }
 
@@ -507,6 +509,11 @@ void MeridianFlipState::updatePosition(MountPosition &pos, const SkyPoint &posit
     pos.valid    = isValid;
 }
 
+void MeridianFlipState::updateTelemetry(const MountTelemetry::Snapshot &snapshot)
+{
+    updateTelescopeCoord(snapshot.position, snapshot.pierSide, snapshot.ha);
+}
+
 void MeridianFlipState::updateTelescopeCoord(const SkyPoint &position, ISD::Mount::PierSide pierSide, const dms &ha)
 {
     updatePosition(currentPosition, position, pierSide, ha, true);
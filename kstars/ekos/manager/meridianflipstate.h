@@ -14,6 +14,7 @@
 
 #include "indi/indistd.h"
 #include "indi/indimount.h"
+#include "ekos/mount/mounttelemetry.h"
 
 /**
  * @brief A meridian flip is executed by issueing a scope motion to the target.
@@ -211,6 +212,10 @@ public slots:
      * @param ha current hour angle
      */
     void updateTelescopeCoord(const SkyPoint &position, ISD::Mount::PierSide pierSide, const dms &ha);
+    /**
+     * @brief Slot for receiving a changed snapshot of the mount telemetry
+     */
+    void updateTelemetry(const MountTelemetry::Snapshot &snapshot);
 
 signals:
     // mount meridian flip status update event
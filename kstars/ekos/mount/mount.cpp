@@ -65,6 +65,14 @@ Mount::Mount()
 
     m_Mount = nullptr;
 
+    m_Telemetry.reset(new MountTelemetry());
+    connect(m_Telemetry.get(), &MountTelemetry::newSnapshot, this, [this](const MountTelemetry::Snapshot & snapshot)
+    {
+        emit newCoords(snapshot.position, snapshot.pierSide, snapshot.ha);
+        updateTelescopeCoords(snapshot);
+    });
+    connect(m_Telemetry.get(), &MountTelemetry::uiSnapshot, this, &Mount::updateTelescopeDisplay);
+
     // initialize the state machine
     mf_state.reset(new MeridianFlipState());
     // connect to the MF state maichine
@@ -251,7 +259,10 @@ bool Mount::setMount(ISD::Mount *device)
     }
 
     if (m_Mount)
+    {
         m_Mount->disconnect(m_Mount, nullptr, this, nullptr);
+        m_Mount->disconnect(m_Mount, nullptr, m_Telemetry.get(), nullptr);
+    }
 
     m_Mount = device;
 
@@ -282,8 +293,9 @@ bool Mount::setMount(ISD::Mount *device)
     connect(m_Mount, &ISD::Mount::propertyUpdated, this, &Mount::updateProperty);
     connect(m_Mount, &ISD::Mount::newTarget, this, &Mount::newTarget);
     connect(m_Mount, &ISD::Mount::newTargetName, this, &Mount::newTargetName);
-    connect(m_Mount, &ISD::Mount::newCoords, this, &Mount::newCoords);
-    connect(m_Mount, &ISD::Mount::newCoords, this, &Mount::updateTelescopeCoords);
+    // The telemetry derives the state of the mount once per update and paces its consumers
+    m_Telemetry->reset();
+    connect(m_Mount, &ISD::Mount::newCoords, m_Telemetry.get(), &MountTelemetry::update);
     connect(m_Mount, &ISD::Mount::slewRateChanged, this, &Mount::slewRateChanged);
     connect(m_Mount, &ISD::Mount::pierSideChanged, this, &Mount::pierSideChanged);
     connect(m_Mount, &ISD::Mount::axisReversed, this, &Mount::syncAxisReversed);
@@ -432,6 +444,8 @@ void Mount::removeDevice(const QSharedPointer<ISD::GenericDevice> &device)
     if (m_Mount && m_Mount->getDeviceName() == device->getDeviceName())
     {
         m_Mount->disconnect(this);
+        m_Mount->disconnect(m_Telemetry.get());
+        m_Telemetry->reset();
         m_BaseView->hide();
         qCDebug(KSTARS_EKOS_MOUNT) << "Removing mount driver" << m_Mount->getDeviceName();
         m_Mount = nullptr;
@@ -536,57 +550,19 @@ void Mount::registerNewModule(const QString &name)
 
 }
 
-void Mount::updateTelescopeCoords(const SkyPoint &position, ISD::Mount::PierSide pierSide, const dms &ha)
+void Mount::updateTelescopeCoords(const MountTelemetry::Snapshot &snapshot)
 {
     if (m_Mount == nullptr || !m_Mount->isConnected())
         return;
 
-    telescopeCoord = position;
+    telescopeCoord = snapshot.position;
+    const ISD::Mount::PierSide pierSide = snapshot.pierSide;
 
     // No need to update coords if we are still parked.
     if (m_Status == ISD::Mount::MOUNT_PARKED && m_Status == m_Mount->status())
         return;
 
-    // Ekos Mount Tab coords are always in JNow
-    raOUT->setText(telescopeCoord.ra().toHMSString());
-    decOUT->setText(telescopeCoord.dec().toDMSString());
-
-    // Mount Control Panel coords depend on the switch
-    if (m_JNowCheck->property("checked").toBool())
-    {
-        m_raValue->setProperty("text", telescopeCoord.ra().toHMSString());
-        m_deValue->setProperty("text", telescopeCoord.dec().toDMSString());
-    }
-    else
-    {
-        m_raValue->setProperty("text", telescopeCoord.ra0().toHMSString());
-        m_deValue->setProperty("text", telescopeCoord.dec0().toDMSString());
-    }
-
-    // Get horizontal coords
-    azOUT->setText(telescopeCoord.az().toDMSString());
-    m_azValue->setProperty("text", telescopeCoord.az().toDMSString());
-    altOUT->setText(telescopeCoord.alt().toDMSString());
-    m_altValue->setProperty("text", telescopeCoord.alt().toDMSString());
-
-    dms lst = KStarsData::Instance()->geo()->GSTtoLST(KStarsData::Instance()->clock()->utc().gst());
-    dms haSigned(ha);
-    QChar sgn('+');
-
-    if (haSigned.Hours() > 12.0)
-    {
-        haSigned.setH(24.0 - haSigned.Hours());
-        sgn = '-';
-    }
-
-    haOUT->setText(QString("%1%2").arg(sgn).arg(haSigned.toHMSString()));
-
-    m_haValue->setProperty("text", haOUT->text());
-    lstOUT->setText(lst.toHMSString());
-
-    double currentAlt = telescopeCoord.altRefracted().Degrees();
-
-    m_zaValue->setProperty("text", dms(90 - currentAlt).toDMSString());
+    double currentAlt = snapshot.altitude;
 
     if (minimumAltLimit->isEnabled() && (currentAlt < minimumAltLimit->value() || currentAlt > maximumAltLimit->value()))
     {
@@ -628,7 +604,7 @@ void Mount::updateTelescopeCoords(const SkyPoint &position, ISD::Mount::PierSide
 
     //qCDebug(KSTARS_EKOS_MOUNT) << "MaximumHaLimit " << MaximumHaLimit->isEnabled() << " value " << MaximumHaLimit->value();
 
-    double haHours = rangeHA(ha.Hours());
+    double haHours = snapshot.haHours;
     // handle Ha limit:
     // Telescope must report Pier Side
     // MaximumHaLimit must be enabled
@@ -704,8 +680,48 @@ void Mount::updateTelescopeCoords(const SkyPoint &position, ISD::Mount::PierSide
         if (a != nullptr)
             a->setChecked(currentStatus == ISD::Mount::MOUNT_TRACKING);
     }
+}
+
+void Mount::updateTelescopeDisplay(const MountTelemetry::Snapshot &snapshot)
+{
+    if (m_Mount == nullptr || !m_Mount->isConnected())
+        return;
+
+    // No need to update coords if we are still parked.
+    if (m_Status == ISD::Mount::MOUNT_PARKED && m_Status == m_Mount->status())
+        return;
+
+    const SkyPoint &position = snapshot.position;
+
+    // Ekos Mount Tab coords are always in JNow
+    raOUT->setText(position.ra().toHMSString());
+    decOUT->setText(position.dec().toDMSString());
+
+    // Mount Control Panel coords depend on the switch
+    if (m_JNowCheck->property("checked").toBool())
+    {
+        m_raValue->setProperty("text", position.ra().toHMSString());
+        m_deValue->setProperty("text", position.dec().toDMSString());
+    }
+    else
+    {
+        m_raValue->setProperty("text", position.ra0().toHMSString());
+        m_deValue->setProperty("text", position.dec0().toDMSString());
+    }
+
+    // Get horizontal coords
+    azOUT->setText(position.az().toDMSString());
+    m_azValue->setProperty("text", position.az().toDMSString());
+    altOUT->setText(position.alt().toDMSString());
+    m_altValue->setProperty("text", position.alt().toDMSString());
+
+    haOUT->setText(snapshot.haText);
+    m_haValue->setProperty("text", snapshot.haText);
+    lstOUT->setText(snapshot.lst.toHMSString());
+
+    m_zaValue->setProperty("text", dms(90 - snapshot.altitude).toDMSString());
 
-    bool isTracking = (currentStatus == ISD::Mount::MOUNT_TRACKING);
+    bool isTracking = (m_Mount->status() == ISD::Mount::MOUNT_TRACKING);
     if (trackingGroup->isEnabled())
     {
         trackOnB->setChecked(isTracking);
@@ -13,6 +13,7 @@
 #include "indi/indistd.h"
 #include "indi/indifocuser.h"
 #include "indi/indimount.h"
+#include "ekos/mount/mounttelemetry.h"
 
 class QQuickView;
 class QQuickItem;
@@ -131,6 +132,15 @@ class Mount : public QWidget, public Ui::Mount
             return mf_state;
         }
 
+        /**
+         * @brief getTelemetry
+         * @return the snapshots of the mount position, delivered at the rates of their consumers
+         */
+        QSharedPointer<MountTelemetry> getTelemetry() const
+        {
+            return m_Telemetry;
+        }
+
         /** @defgroup MountDBusInterface Ekos Mount DBus Interface
              * Mount interface provides advanced scripting capabilities to control INDI mounts.
             */
@@ -373,14 +383,20 @@ class Mount : public QWidget, public Ui::Mount
         void updateLog(int messageID);
 
         /**
-             * @brief updateTelescopeCoords is triggered by the ISD::Mount::newCoord() event and updates the displayed
-             * coordinates of the mount and to ensure mount is within altitude limits if the altitude limits are enabled.
+             * @brief updateTelescopeCoords is triggered by every snapshot of the mount telemetry, i.e. every
+             * ISD::Mount::newCoords() event, and ensures the mount is within altitude and hour angle limits if
+             * the limits are enabled.
              * The frequency of this update depends on the REFRESH parameter of the INDI mount device.
-             * @param position latest coordinates the mount reports it is pointing to
-             * @param pierSide pierSide
-             * @param ha hour angle of the latest coordinates
+             * @param snapshot latest coordinates the mount reports it is pointing to, with the values derived from them
+             */
+        void updateTelescopeCoords(const MountTelemetry::Snapshot &snapshot);
+
+        /**
+             * @brief updateTelescopeDisplay updates the displayed coordinates of the mount, at most every
+             * MountTelemetry::UI_INTERVAL milliseconds.
+             * @param snapshot latest coordinates the mount reports it is pointing to, with the values derived from them
              */
-        void updateTelescopeCoords(const SkyPoint &position, ISD::Mount::PierSide pierSide, const dms &ha);
+        void updateTelescopeDisplay(const MountTelemetry::Snapshot &snapshot);
 
         /**
              * @brief move Issues motion command to the mount to move in a particular direction based the request NS and WE values
@@ -566,6 +582,8 @@ class Mount : public QWidget, public Ui::Mount
         void setScopeStatus(ISD::Mount::Status status);
         /* Meridian flip state handling */
         QSharedPointer<MeridianFlipState> mf_state;
+        /* Position snapshots paced for each consumer */
+        QSharedPointer<MountTelemetry> m_Telemetry;
         void setupParkUI();
 
         bool hasCaptureInterface { false };
@@ -0,0 +1,136 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "mounttelemetry.h"
+
+#include "kstarsdata.h"
+#include "geolocation.h"
+
+#include <indicom.h>
+
+#include <cmath>
+
+namespace Ekos
+{
+
+MountTelemetry::MountTelemetry(QObject *parent) : QObject(parent)
+{
+    qRegisterMetaType<Ekos::MountTelemetry::Snapshot>("Ekos::MountTelemetry::Snapshot");
+
+    for (int i = 0; i < ConsumerCount; ++i)
+    {
+        const Consumer consumer = static_cast<Consumer>(i);
+        Rate &rate = m_Rates[i];
+        rate.timer.setSingleShot(true);
+        rate.timer.setInterval(consumer == UI ? UI_INTERVAL : ANALYZE_INTERVAL);
+        connect(&rate.timer, &QTimer::timeout, this, [this, consumer]()
+        {
+            Rate &rate = m_Rates[consumer];
+            if (!rate.pending)
+                return;
+            rate.pending = false;
+            emitSnapshot(consumer);
+            rate.timer.start();
+        });
+    }
+}
+
+MountTelemetry::Snapshot MountTelemetry::compute(const SkyPoint &position, ISD::Mount::PierSide pierSide,
+        const dms &ha)
+{
+    Snapshot snapshot;
+    snapshot.position = position;
+    snapshot.pierSide = pierSide;
+    snapshot.ha = ha;
+    snapshot.haHours = rangeHA(ha.Hours());
+
+    dms haSigned(ha);
+    QChar sign('+');
+    if (haSigned.Hours() > 12.0)
+    {
+        haSigned.setH(24.0 - haSigned.Hours());
+        sign = '-';
+    }
+    snapshot.haText = QString("%1%2").arg(sign).arg(haSigned.toHMSString());
+
+    KStarsData *data = KStarsData::Instance();
+    if (data != nullptr && data->geo() != nullptr)
+        snapshot.lst = data->geo()->GSTtoLST(data->clock()->utc().gst());
+
+    snapshot.altitude = position.altRefracted().Degrees();
+    return snapshot;
+}
+
+bool MountTelemetry::hasChanged(const Snapshot &previous, const Snapshot &current)
+{
+    if (previous.sequence == 0 || previous.pierSide != current.pierSide)
+        return true;
+
+    return std::fabs(rangeHA(current.haHours - previous.haHours)) >= CHANGE_HA_HOURS ||
+           std::fabs(current.position.dec().Degrees() - previous.position.dec().Degrees()) >= CHANGE_DEC_DEGREES;
+}
+
+void MountTelemetry::setInterval(Consumer consumer, int interval)
+{
+    m_Rates[consumer].timer.setInterval(interval);
+}
+
+void MountTelemetry::reset()
+{
+    m_Snapshot = Snapshot();
+    m_Changed = Snapshot();
+    for (Rate &rate : m_Rates)
+    {
+        rate.timer.stop();
+        rate.pending = false;
+    }
+}
+
+void MountTelemetry::update(const SkyPoint &position, ISD::Mount::PierSide pierSide, const dms &ha)
+{
+    const quint64 sequence = m_Snapshot.sequence + 1;
+    m_Snapshot = compute(position, pierSide, ha);
+    m_Snapshot.sequence = sequence;
+
+    emit newSnapshot(m_Snapshot);
+
+    if (hasChanged(m_Changed, m_Snapshot))
+    {
+        m_Changed = m_Snapshot;
+        emit snapshotChanged(m_Snapshot);
+    }
+
+    for (int i = 0; i < ConsumerCount; ++i)
+        deliver(static_cast<Consumer>(i));
+}
+
+void MountTelemetry::deliver(Consumer consumer)
+{
+    Rate &rate = m_Rates[consumer];
+    if (rate.timer.isActive())
+    {
+        rate.pending = true;
+        return;
+    }
+
+    emitSnapshot(consumer);
+    rate.timer.start();
+}
+
+void MountTelemetry::emitSnapshot(Consumer consumer)
+{
+    switch (consumer)
+    {
+        case UI:
+            emit uiSnapshot(m_Snapshot);
+            break;
+        case Analyze:
+            emit analyzeSnapshot(m_Snapshot);
+            break;
+    }
+}
+
+}
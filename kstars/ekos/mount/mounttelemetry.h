@@ -0,0 +1,122 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "skypoint.h"
+#include "indi/indimount.h"
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+namespace Ekos
+{
+
+/**
+ * @class MountTelemetry
+ * @short Derives the state of the mount once per position update and hands it to each consumer at its own rate.
+ *
+ * Mount drivers may report their position many times a second. Every report becomes a Snapshot holding the
+ * coordinates together with the values derived from them, such as the local sidereal time, the signed hour angle
+ * and the refracted altitude, so that the consumers need not compute them again.
+ *
+ * @li newSnapshot() is emitted for every update, for the limits of the mount and the modules that need the
+ * latest position.
+ * @li snapshotChanged() is emitted once the position, the hour angle or the pier side changed noticeably, for the
+ * meridian flip state machine.
+ * @li uiSnapshot() and analyzeSnapshot() are emitted at most every UI_INTERVAL and ANALYZE_INTERVAL milliseconds.
+ * The first update is delivered right away, the last one of an interval once it ends, so no consumer misses the
+ * final position.
+ */
+class MountTelemetry : public QObject
+{
+        Q_OBJECT
+
+    public:
+        struct Snapshot
+        {
+            SkyPoint position;
+            ISD::Mount::PierSide pierSide { ISD::Mount::PIER_UNKNOWN };
+            dms ha;
+            /// Hour angle in hours from -12 to 12
+            double haHours { 0 };
+            /// Hour angle as displayed, with its sign
+            QString haText;
+            dms lst;
+            /// Altitude in degrees, corrected for refraction
+            double altitude { 0 };
+            /// Number of the update, starting at 1
+            quint64 sequence { 0 };
+        };
+
+        /** The consumers delivered at a limited rate */
+        enum Consumer
+        {
+            UI,
+            Analyze
+        };
+
+        static constexpr int ConsumerCount = Analyze + 1;
+
+        /// Intervals in milliseconds, i.e. 2 Hz for the mount tab and EkosLive, 1 Hz for Analyze
+        static constexpr int UI_INTERVAL = 500;
+        static constexpr int ANALYZE_INTERVAL = 1000;
+
+        /// Changes that reach the meridian flip state machine: one second of hour angle, or 15" of declination
+        static constexpr double CHANGE_HA_HOURS = 1.0 / 3600;
+        static constexpr double CHANGE_DEC_DEGREES = 15.0 / 3600;
+
+        explicit MountTelemetry(QObject *parent = nullptr);
+
+        /** @return the snapshot of @p position, @p pierSide and @p ha, without the sequence */
+        static Snapshot compute(const SkyPoint &position, ISD::Mount::PierSide pierSide, const dms &ha);
+
+        /** @return true if @p current differs from @p previous enough for snapshotChanged() */
+        static bool hasChanged(const Snapshot &previous, const Snapshot &current);
+
+        /** @return the latest snapshot, with sequence 0 before the first update */
+        const Snapshot &snapshot() const
+        {
+            return m_Snapshot;
+        }
+
+        /** @short Set the interval of @p consumer in milliseconds. */
+        void setInterval(Consumer consumer, int interval);
+
+        /** @short Forget the latest snapshot and drop pending deliveries, e.g. when the mount changes. */
+        void reset();
+
+    public slots:
+        /** @short Take a new position of the mount, as reported by ISD::Mount::newCoords(). */
+        void update(const SkyPoint &position, ISD::Mount::PierSide pierSide, const dms &ha);
+
+    signals:
+        void newSnapshot(const Ekos::MountTelemetry::Snapshot &snapshot);
+        void snapshotChanged(const Ekos::MountTelemetry::Snapshot &snapshot);
+        void uiSnapshot(const Ekos::MountTelemetry::Snapshot &snapshot);
+        void analyzeSnapshot(const Ekos::MountTelemetry::Snapshot &snapshot);
+
+    private:
+        struct Rate
+        {
+            QTimer timer;
+            bool pending { false };
+        };
+
+        /** Deliver the latest snapshot to @p consumer now, or once its interval ends. */
+        void deliver(Consumer consumer);
+        void emitSnapshot(Consumer consumer);
+
+        Snapshot m_Snapshot;
+        // The snapshot last delivered by snapshotChanged()
+        Snapshot m_Changed;
+        Rate m_Rates[ConsumerCount];
+};
+
+}
+
+Q_DECLARE_METATYPE(Ekos::MountTelemetry::Snapshot)
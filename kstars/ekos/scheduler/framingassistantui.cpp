@@ -17,8 +17,9 @@
 #include "ekos/manager.h"
 #include "ekos/mount/mount.h"
 #include "schedulerprocess.h"
+#include "schedulermodulestate.h"
 #include "skymapcomposite.h"
-#include "ksparser.h"
+#include "kscolumnparser.h"
 
 #include <QDBusReply>
 
@@ -620,22 +621,27 @@ void FramingAssistantUI::createJobs()
     else if (completionVal == "FinishLoop")
         completionSettings = {{"loopCheck", true}};
 
+    // The sequence is read once, only its prefix and directory change per tile
+    XMLEle *root = scheduler->process()->getSequenceJobRoot(sequence);
+    if (root == nullptr)
+        return;
+
+    // Jobs are evaluated once, after all tiles are added, as when loading a schedule
+    const SchedulerState oldState = scheduler->moduleState()->schedulerState();
+    scheduler->moduleState()->setSchedulerState(SCHEDULER_LOADING);
+
     int batchCount = 0;
+    bool created = true;
     for (auto oneTile : tiles->tiles())
     {
         batchCount++;
-        XMLEle *root = scheduler->process()->getSequenceJobRoot(sequence);
-        if (root == nullptr)
-            return;
-
         const auto oneTarget = QString("%1-Part_%2").arg(target).arg(batchCount);
         if (scheduler->process()->createJobSequence(root, oneTarget, outputDirectory) == false)
         {
-            delXMLEle(root);
-            return;
+            created = false;
+            break;
         }
 
-        delXMLEle(root);
         auto oneSequence = QString("%1/%2.esq").arg(outputDirectory, oneTarget);
 
         // First job should Always focus if possible
@@ -660,6 +666,13 @@ void FramingAssistantUI::createJobs()
         scheduler->saveJob();
     }
 
+    delXMLEle(root);
+    scheduler->moduleState()->setSchedulerState(oldState);
+    if (oldState != SCHEDULER_LOADING)
+        scheduler->process()->evaluateJobsInBackground();
+    if (!created)
+        return;
+
     auto schedulerListFile = QString("%1/%2.esl").arg(outputDirectory, target);
     scheduler->process()->saveScheduler(QUrl::fromLocalFile(schedulerListFile));
     accept();
@@ -724,15 +737,19 @@ bool FramingAssistantUI::parseMosaicCSV(const QString &filename)
     csv_sequence.append(qMakePair(QString("Overlap"), KSParser::D_QSTRING));
     csv_sequence.append(qMakePair(QString("Row"), KSParser::D_INT));
     csv_sequence.append(qMakePair(QString("Column"), KSParser::D_INT));
-    KSParser csvParser(filename, ',', csv_sequence);
+    KSColumnParser csvParser(filename, ',', csv_sequence);
+    csvParser.parse();
+    const int paneColumn = csvParser.column("Pane"), raColumn = csvParser.column("RA"),
+              decColumn = csvParser.column("DEC"), paColumn = csvParser.column("Position Angle (East)"),
+              overlapColumn = csvParser.column("Overlap"), rowColumn = csvParser.column("Row"),
+              colColumn = csvParser.column("Column");
 
-    QHash<QString, QVariant> row_content;
     int maxRow = 1, maxCol = 1;
     auto haveCenter = false;
-    while (csvParser.HasNextRow())
+    for (int i = 0; i < csvParser.rowCount(); i++)
     {
-        row_content = csvParser.ReadNextRow();
-        auto pane = row_content["Pane"].toString();
+        const KSColumnParser::Row row_content = csvParser.row(i);
+        auto pane = row_content.toString(paneColumn);
 
         // Skip first line
         if (pane == "Pane")
@@ -740,26 +757,26 @@ bool FramingAssistantUI::parseMosaicCSV(const QString &filename)
 
         if (pane != "Center")
         {
-            auto row = row_content["Row"].toInt();
+            auto row = row_content.toInt(rowColumn);
             maxRow = qMax(row, maxRow);
-            auto col = row_content["Column"].toInt();
+            auto col = row_content.toInt(colColumn);
             maxCol = qMax(col, maxCol);
             continue;
         }
 
         haveCenter = true;
 
-        auto ra = row_content["RA"].toString().trimmed();
-        auto dec = row_content["DEC"].toString().trimmed();
+        auto ra = row_content.toString(raColumn).trimmed();
+        auto dec = row_content.toString(decColumn).trimmed();
 
         ui->raBox->setText(ra.replace("hr", "h"));
         ui->decBox->setText(dec.remove("º"));
 
-        auto pa      = row_content["Position Angle (East)"].toDouble();
+        auto pa      = row_content.toDouble(paColumn);
         ui->positionAngleSpin->setValue(pa);
 
         // eg. 10% --> 10
-        auto overlap = row_content["Overlap"].toString().trimmed().midRef(0, 2).toDouble();
+        auto overlap = row_content.toString(overlapColumn).trimmed().midRef(0, 2).toDouble();
         ui->overlapSpin->setValue(overlap);
     }
 
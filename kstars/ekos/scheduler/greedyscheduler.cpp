@@ -14,17 +14,124 @@
 #include "ui_scheduler.h"
 #include "schedulerjob.h"
 #include "schedulerutils.h"
+#include "ksmoon.h"
+#include "auxiliary/executors.h"
+
+#include <QJsonArray>
+#include <QThread>
+
+#include <algorithm>
 
 #define TEST_PRINT if (false) fprintf
 
+namespace
+{
 // Can make the scheduling a bit faster by sampling every other minute instead of every minute.
-constexpr int SCHEDULE_RESOLUTION_MINUTES = 2;
+// The SchedulerResolution option defaults to 2 minutes.
+int scheduleResolutionMinutes()
+{
+    return static_cast<int>(std::max(1u, Options::schedulerResolution()));
+}
+}
 
 namespace Ekos
 {
 
+struct GreedyScheduler::BackgroundSchedule
+{
+    // The jobs the schedule is computed for, as they were then. Only compared with the current ones,
+    // as they may have been deleted since.
+    QList<SchedulerJob *> jobs;
+    QList<SchedulerJobStatus> states;
+    QList<QDateTime> stateTimes;
+
+    // Copies of the jobs, and of the Moon which the sky map updates on the GUI thread.
+    QList<SchedulerJob *> snapshots;
+    QScopedPointer<KSMoon> moon;
+    QDateTime now;
+    QMap<QString, uint16_t> capturedFramesCount;
+
+    std::atomic<bool> cancelled { false };
+    std::atomic<bool> done { false };
+
+    // The results, pointing to snapshots.
+    SchedulerJob *scheduledJob { nullptr };
+    QDateTime when;
+    QList<JobSchedule> schedule;
+    double simSeconds { 0 };
+    QElapsedTimer timer;
+
+    ~BackgroundSchedule()
+    {
+        qDeleteAll(snapshots);
+    }
+};
+
+struct GreedyScheduler::NightsPlan
+{
+    struct Night
+    {
+        QDate date;
+        // Copies of the jobs, one set per night as the nights are simulated in parallel.
+        QList<SchedulerJob *> snapshots;
+        // The result, hours scheduled per job name.
+        QMap<QString, double> hours;
+    };
+    QDate firstNight, lastNight;
+    QVector<Night> nights;
+
+    ~NightsPlan()
+    {
+        for (const auto &night : nights)
+            qDeleteAll(night.snapshots);
+    }
+};
+
 GreedyScheduler::GreedyScheduler()
 {
+    connect(&m_BackgroundWatcher, &QFutureWatcher<void>::finished, this, [this]()
+    {
+        if (!m_BackgroundSchedule.isNull() && m_BackgroundSchedule->done)
+            emit backgroundScheduleDone();
+    });
+    connect(&m_NightsWatcher, &QFutureWatcher<void>::finished, this, [this]()
+    {
+        const QSharedPointer<NightsPlan> plan = m_NightsPlan;
+        m_NightsPlan.reset();
+        if (plan.isNull())
+            return;
+
+        QJsonArray nights;
+        QMap<QString, double> totals;
+        for (const auto &night : plan->nights)
+        {
+            QJsonObject hours;
+            for (auto it = night.hours.constBegin(); it != night.hours.constEnd(); ++it)
+            {
+                hours.insert(it.key(), it.value());
+                totals[it.key()] += it.value();
+            }
+            nights.append(QJsonObject({{"date", night.date.toString(Qt::ISODate)}, {"hours", hours}}));
+        }
+        QJsonObject totalHours;
+        for (auto it = totals.constBegin(); it != totals.constEnd(); ++it)
+            totalHours.insert(it.key(), it.value());
+
+        emit nightsPlanned(QJsonObject(
+        {
+            {"firstNight", plan->firstNight.toString(Qt::ISODate)},
+            {"lastNight", plan->lastNight.toString(Qt::ISODate)},
+            {"nights", nights},
+            {"totals", totalHours}
+        }));
+    });
+}
+
+GreedyScheduler::~GreedyScheduler()
+{
+    cancelBackgroundSchedule();
+    m_BackgroundWatcher.waitForFinished();
+    m_NightsWatcher.waitForFinished();
 }
 
 void GreedyScheduler::setParams(bool restartImmediately, bool restartQueue,
@@ -49,6 +156,7 @@ void GreedyScheduler::scheduleJobs(const QList<SchedulerJob *> &jobs,
                                    const QMap<QString, uint16_t> &capturedFramesCount,
                                    ModuleLogger *logger)
 {
+    cancelBackgroundSchedule();
     for (auto job : jobs)
         job->clearCache();
 
@@ -61,7 +169,20 @@ void GreedyScheduler::scheduleJobs(const QList<SchedulerJob *> &jobs,
     prepareJobsForEvaluation(jobs, now, capturedFramesCount, logger);
 
     scheduledJob = selectNextJob(jobs, now, nullptr, SIMULATE, &when, nullptr, nullptr, &capturedFramesCount);
-    auto schedule = getSchedule();
+    logSchedule(now, when, timer.elapsed() / 1000.0, logger);
+    if (scheduledJob != nullptr)
+    {
+        scheduledJob->setState(SCHEDJOB_SCHEDULED);
+        scheduledJob->setStartupTime(when);
+    }
+
+    for (auto job : jobs)
+        job->clearCache();
+}
+
+void GreedyScheduler::logSchedule(const QDateTime &now, const QDateTime &when, double seconds,
+                                  ModuleLogger *logger) const
+{
     if (logger != nullptr)
     {
         if (!schedule.empty())
@@ -72,21 +193,158 @@ void GreedyScheduler::scheduleJobs(const QList<SchedulerJob *> &jobs,
             for (int i = schedule.size() - 1; i >= 0; i--)
                 logger->appendLogText(GreedyScheduler::jobScheduleString(schedule[i]));
             logger->appendLogText(QString("Greedy Scheduler plan for the next 48 hours starting %1 (%2)s:")
-                                  .arg(now.toString()).arg(timer.elapsed() / 1000.0));
+                                  .arg(now.toString()).arg(seconds));
         }
-        else logger->appendLogText(QString("Greedy Scheduler: empty plan (%1s)").arg(timer.elapsed() / 1000.0));
+        else logger->appendLogText(QString("Greedy Scheduler: empty plan (%1s)").arg(seconds));
     }
     if (scheduledJob != nullptr)
-    {
         qCDebug(KSTARS_EKOS_SCHEDULER)
                 << QString("Greedy Scheduler scheduling next job %1 at %2")
                 .arg(scheduledJob->getName(), when.toString("hh:mm"));
-        scheduledJob->setState(SCHEDJOB_SCHEDULED);
-        scheduledJob->setStartupTime(when);
+}
+
+// The jobs are not changed until applyBackgroundSchedule().
+void GreedyScheduler::scheduleJobsInBackground(const QList<SchedulerJob *> &jobs,
+        const QDateTime &now,
+        const QMap<QString, uint16_t> &capturedFramesCount,
+        ModuleLogger *logger)
+{
+    cancelBackgroundSchedule();
+
+    QSharedPointer<BackgroundSchedule> plan(new BackgroundSchedule());
+    plan->timer.start();
+    plan->jobs = jobs;
+    plan->now = now;
+    plan->capturedFramesCount = capturedFramesCount;
+    KSMoon *moon = jobs.isEmpty() ? nullptr : jobs.first()->getMoon();
+    if (moon != nullptr)
+        plan->moon.reset(moon->clone());
+    for (auto job : jobs)
+    {
+        plan->states.append(job->getState());
+        plan->stateTimes.append(job->getStateTime());
+        plan->snapshots.append(job->snapshot(plan->moon.data()));
+    }
+
+    // Estimating the job times reads their sequence files, which is kept on this thread.
+    prepareJobsForEvaluation(plan->snapshots, now, capturedFramesCount, logger);
+
+    m_BackgroundSchedule = plan;
+    const bool abortsImmediate = rescheduleAbortsImmediate, abortsQueue = rescheduleAbortsQueue,
+               errors = rescheduleErrors;
+    const int abortDelay = abortDelaySeconds, errorDelay = errorDelaySeconds;
+    m_BackgroundWatcher.setFuture(Executors::run(Executors::Background, [plan, abortsImmediate, abortsQueue, errors, abortDelay, errorDelay]()
+    {
+        GreedyScheduler scheduler;
+        scheduler.setParams(abortsImmediate, abortsQueue, errors, abortDelay, errorDelay);
+        scheduler.m_Cancelled = &plan->cancelled;
+
+        plan->scheduledJob = scheduler.selectNextJob(plan->snapshots, plan->now, nullptr, SIMULATE, &plan->when,
+                             nullptr, nullptr, &plan->capturedFramesCount);
+        if (plan->cancelled)
+            return;
+        if (plan->scheduledJob != nullptr)
+        {
+            plan->scheduledJob->setState(SCHEDJOB_SCHEDULED);
+            plan->scheduledJob->setStartupTime(plan->when);
+        }
+        plan->schedule = scheduler.schedule;
+        plan->simSeconds = scheduler.m_SimSeconds;
+        plan->done = true;
+    }));
+}
+
+bool GreedyScheduler::applyBackgroundSchedule(const QList<SchedulerJob *> &jobs, ModuleLogger *logger)
+{
+    const QSharedPointer<BackgroundSchedule> plan = m_BackgroundSchedule;
+    m_BackgroundSchedule.reset();
+    if (plan.isNull() || !plan->done)
+        return false;
+
+    // The jobs may have been edited, removed or run meanwhile.
+    if (jobs != plan->jobs)
+        return false;
+    for (int i = 0; i < jobs.size(); ++i)
+    {
+        if (jobs[i]->getState() != plan->states[i] || jobs[i]->getStateTime() != plan->stateTimes[i])
+            return false;
+    }
+
+    QHash<const SchedulerJob *, SchedulerJob *> liveJobs;
+    for (int i = 0; i < jobs.size(); ++i)
+    {
+        jobs[i]->applyEvaluation(*plan->snapshots[i]);
+        liveJobs[plan->snapshots[i]] = jobs[i];
     }
+    scheduledJob = liveJobs.value(plan->scheduledJob, nullptr);
+    schedule.clear();
+    for (const auto &entry : plan->schedule)
+        schedule.append(JobSchedule(liveJobs.value(entry.job, nullptr), entry.startTime, entry.stopTime, entry.stopReason));
+    m_SimSeconds = plan->simSeconds;
+
+    logSchedule(plan->now, plan->when, plan->timer.elapsed() / 1000.0, logger);
+    return true;
+}
+
+void GreedyScheduler::cancelBackgroundSchedule()
+{
+    if (m_BackgroundSchedule.isNull())
+        return;
+    // The computation stops at its next check, and drops its snapshots.
+    m_BackgroundSchedule->cancelled = true;
+    m_BackgroundSchedule.reset();
+}
+
+// The jobs are not changed, only their snapshots.
+bool GreedyScheduler::planNightsInBackground(const QList<SchedulerJob *> &jobs, const QDate &firstNight,
+        const QDate &lastNight)
+{
+    if (isPlanningNights())
+        return false;
 
+    QSharedPointer<NightsPlan> plan(new NightsPlan());
+    plan->firstNight = firstNight;
+    plan->lastNight = lastNight;
+
+    // The job times are estimated once, here, as this reads the sequence files. All nights start from these estimates.
+    QList<SchedulerJob *> prepared;
     for (auto job : jobs)
-        job->clearCache();
+        prepared.append(job->snapshot(job->getMoon()));
+    const QMap<QString, uint16_t> noFramesCaptured;
+    prepareJobsForEvaluation(prepared, QDateTime(firstNight, QTime(12, 0)), noFramesCaptured, nullptr);
+
+    // The Moon separation is checked from the almanac of each night, shared by the jobs
+    for (QDate date = firstNight; date.isValid() && date <= lastNight; date = date.addDays(1))
+    {
+        NightsPlan::Night night;
+        night.date = date;
+        for (auto job : prepared)
+            night.snapshots.append(job->snapshot(job->getMoon()));
+        plan->nights.append(night);
+    }
+    qDeleteAll(prepared);
+
+    m_NightsPlan = plan;
+    const bool abortsImmediate = rescheduleAbortsImmediate, abortsQueue = rescheduleAbortsQueue,
+               errors = rescheduleErrors;
+    const int abortDelay = abortDelaySeconds, errorDelay = errorDelaySeconds;
+    m_NightsWatcher.setFuture(Executors::map(Executors::Background, plan->nights, [plan, abortsImmediate, abortsQueue, errors, abortDelay,
+                                            errorDelay](NightsPlan::Night & night)
+    {
+        GreedyScheduler scheduler;
+        scheduler.setParams(abortsImmediate, abortsQueue, errors, abortDelay, errorDelay);
+
+        const QDateTime start(night.date, QTime(12, 0)), end = start.addDays(1);
+        const QMap<QString, uint16_t> noFramesCaptured;
+        scheduler.simulate(night.snapshots, start, end, &noFramesCaptured, SIMULATE);
+        for (const auto &entry : scheduler.schedule)
+        {
+            const QDateTime stop = entry.stopTime.isValid() ? std::min(entry.stopTime, end) : end;
+            if (entry.job != nullptr && entry.startTime.isValid() && entry.startTime < stop)
+                night.hours[entry.job->getName()] += entry.startTime.secsTo(stop) / 3600.0;
+        }
+    }));
+    return true;
 }
 
 // The changes made to a job in jobs are:
@@ -311,23 +569,24 @@ SchedulerJob *GreedyScheduler::selectNextJob(const QList<SchedulerJob *> &jobs,
     SchedulerJob * nextJob = nullptr;
     QString interruptStr;
 
+    // The start times of the jobs, computed a batch of jobs ahead of the loop below.
+    QVector<QDateTime> startTimes(jobs.size());
+    int evaluated = 0;
+
     for (int i = 0; i < jobs.size(); ++i)
     {
+        if (m_Cancelled != nullptr && *m_Cancelled)
+            return nullptr;
+
         SchedulerJob * const job = jobs[i];
         const bool evaluatingCurrentJob = (currentJob && (job == currentJob));
 
         if (!allowJob(job, rescheduleAbortsImmediate, rescheduleAbortsQueue, rescheduleErrors))
             continue;
 
-        // If the job state is abort or error, might have to delay the first possible start time.
-        QDateTime startSearchingtAt = firstPossibleStart(
-                                          job, now, rescheduleAbortsQueue, abortDelaySeconds, rescheduleErrors, errorDelaySeconds);
-
-        // Find the first time this job can meet all its constraints.
-        // I found that passing in an "until" 4th argument actually hurt performance, as it reduces
-        // the effectiveness of the cache that getNextPossibleStartTime uses.
-        const QDateTime startTime = job->getNextPossibleStartTime(startSearchingtAt, SCHEDULE_RESOLUTION_MINUTES,
-                                    evaluatingCurrentJob);
+        if (i >= evaluated)
+            evaluated = evaluateStartTimes(jobs, i, now, currentJob, &startTimes);
+        const QDateTime startTime = startTimes[i];
         if (startTime.isValid())
         {
             if (nextJob == nullptr)
@@ -399,7 +658,7 @@ SchedulerJob *GreedyScheduler::selectNextJob(const QList<SchedulerJob *> &jobs,
                                                   errorDelaySeconds);
                 // atTime above is the user-specified start time. atJobStartTime is the time it can
                 // actually start, given all the constraints (altitude, twilight, etc).
-                const QDateTime atJobStartTime = atJob->getNextPossibleStartTime(startSearchingtAt, SCHEDULE_RESOLUTION_MINUTES, currentJob
+                const QDateTime atJobStartTime = atJob->getNextPossibleStartTime(startSearchingtAt, scheduleResolutionMinutes(), currentJob
                                                  && (atJob == currentJob));
                 if (atJobStartTime.isValid())
                 {
@@ -468,7 +727,7 @@ SchedulerJob *GreedyScheduler::selectNextJob(const QList<SchedulerJob *> &jobs,
                                                   job, now, rescheduleAbortsQueue, abortDelaySeconds, rescheduleErrors, errorDelaySeconds);
 
                 // Find the first time this job can meet all its constraints.
-                const QDateTime startTime = job->getNextPossibleStartTime(startSearchingtAt, SCHEDULE_RESOLUTION_MINUTES,
+                const QDateTime startTime = job->getNextPossibleStartTime(startSearchingtAt, scheduleResolutionMinutes(),
                                             evaluatingCurrentJob);
 
                 // Only consider jobs that can start soon.
@@ -528,6 +787,51 @@ SchedulerJob *GreedyScheduler::selectNextJob(const QList<SchedulerJob *> &jobs,
     return nextJob;
 }
 
+int GreedyScheduler::evaluateStartTimes(const QList<SchedulerJob *> &jobs, int from, const QDateTime &now,
+        const SchedulerJob * const currentJob, QVector<QDateTime> *startTimes) const
+{
+    const int threads = Options::schedulerThreads() > 0 ? static_cast<int>(Options::schedulerThreads()) :
+                        QThread::idealThreadCount();
+
+    // The next allowed jobs, one per thread, up to the current job past which selectNextJob() doesn't look.
+    QVector<int> candidates;
+    int until = from;
+    while (until < jobs.size() && candidates.size() < std::max(1, threads))
+    {
+        SchedulerJob * const job = jobs[until++];
+        if (!allowJob(job, rescheduleAbortsImmediate, rescheduleAbortsQueue, rescheduleErrors))
+            continue;
+        candidates.append(until - 1);
+        if (job == currentJob)
+            break;
+    }
+
+    QDateTime * const results = startTimes->data();
+    auto evaluate = [&](int i)
+    {
+        SchedulerJob * const job = jobs[i];
+
+        // If the job state is abort or error, might have to delay the first possible start time.
+        QDateTime startSearchingtAt = firstPossibleStart(
+                                          job, now, rescheduleAbortsQueue, abortDelaySeconds, rescheduleErrors, errorDelaySeconds);
+
+        // Find the first time this job can meet all its constraints.
+        // I found that passing in an "until" 4th argument actually hurt performance, as it reduces
+        // the effectiveness of the cache that getNextPossibleStartTime uses.
+        results[i] = job->getNextPossibleStartTime(startSearchingtAt, scheduleResolutionMinutes(),
+                     currentJob && (job == currentJob));
+    };
+
+    // The jobs only share the almanacs, which are locked, and the start times they cache are their own.
+    if (candidates.size() > 1)
+        Executors::blockingMap(Executors::Background, candidates, evaluate);
+    else
+        for (int i : candidates)
+            evaluate(i);
+
+    return until;
+}
+
 // The only reason this isn't a const method is because it sets the schedule class variable
 QDateTime GreedyScheduler::simulate(const QList<SchedulerJob *> &jobs, const QDateTime &time, const QDateTime &endTime,
                                     const QMap<QString, uint16_t> *capturedFramesCount, SimulationType simType)
@@ -575,7 +879,7 @@ QDateTime GreedyScheduler::simulate(const QList<SchedulerJob *> &jobs, const QDa
     for(int i = 0; i < simJobs.size(); ++i)
         workDone[simJobs[i]] = 0.0;
 
-    while (true)
+    while (m_Cancelled == nullptr || !*m_Cancelled)
     {
         QDateTime jobStartTime;
         QDateTime jobInterruptTime;
@@ -620,10 +924,10 @@ QDateTime GreedyScheduler::simulate(const QList<SchedulerJob *> &jobs, const QDa
 
         QString constraintReason;
         // Get the time that this next job would fail its constraints, and a human-readable explanation.
-        QDateTime jobConstraintTime = selectedJob->getNextEndTime(jobStartTime, SCHEDULE_RESOLUTION_MINUTES, &constraintReason,
+        QDateTime jobConstraintTime = selectedJob->getNextEndTime(jobStartTime, scheduleResolutionMinutes(), &constraintReason,
                                       constraintStopTime);
         if (nextStartAtTime.isValid() && jobConstraintTime.isValid() &&
-                std::abs(jobConstraintTime.secsTo(nextStartAtTime)) < 2 * SCHEDULE_RESOLUTION_MINUTES)
+                std::abs(jobConstraintTime.secsTo(nextStartAtTime)) < 2 * scheduleResolutionMinutes())
             constraintReason = "interrupted by start-at job";
         TEST_PRINT(stderr, "%d   %s\n", __LINE__,     QString("  constraint \"%1\" reason \"%2\"")
                    .arg(jobConstraintTime.toString("MM/dd hh:mm")).arg(constraintReason).toLatin1().data());
@@ -8,11 +8,17 @@
 
 #include <QList>
 #include <QMap>
+#include <QDate>
 #include <QDateTime>
+#include <QFutureWatcher>
+#include <QJsonObject>
 #include <QObject>
+#include <QSharedPointer>
 #include <QString>
 #include <QVector>
 
+#include <atomic>
+
 namespace Ekos
 {
 
@@ -40,6 +46,7 @@ class GreedyScheduler : public QObject
         };
 
         GreedyScheduler();
+        ~GreedyScheduler() override;
         /**
           * @brief setParams Sets parameters, usually stored as KStars Options to the scheduler.
           * @param restartImmediately Aborted jobs should attempt to be restarted right after they were suspended.
@@ -62,6 +69,53 @@ class GreedyScheduler : public QObject
                                            const QDateTime &now,
                                            const QMap<QString, uint16_t> &capturedFramesCount,
                                            ModuleLogger *logger);
+        /**
+          * @brief scheduleJobsInBackground Computes the schedule for the jobs to be run as scheduleJobs() does, on another
+          * thread, so that a long queue doesn't block the GUI. The jobs are left untouched: their times are estimated here
+          * on snapshots, which are then scheduled in the background. backgroundScheduleDone() is emitted when the schedule is
+          * ready for applyBackgroundSchedule(). A schedule still being computed is cancelled.
+          * @param jobs A list of SchedulerJobs
+          * @param now The time at which the scheduling should start.
+          * @param capturedFramesCount A structure, computed by the scheduler, which keeps track of previous job progress.
+          * @param logger A pointer to the module logging, useful for notifying the user. Can be nullptr.
+          */
+        void scheduleJobsInBackground(const QList<SchedulerJob *> &jobs,
+                                      const QDateTime &now,
+                                      const QMap<QString, uint16_t> &capturedFramesCount,
+                                      ModuleLogger *logger);
+        /**
+          * @brief applyBackgroundSchedule Updates the jobs, the scheduled job and the schedule as scheduleJobs() would have,
+          * from the schedule computed by scheduleJobsInBackground(). Must be called after backgroundScheduleDone().
+          * @param jobs The current list of jobs.
+          * @param logger A pointer to the module logging, useful for notifying the user. Can be nullptr.
+          * @return false if the list of jobs or the state of one of them changed since the schedule was started, the
+          * schedule is then dropped and the jobs left untouched.
+          */
+        bool applyBackgroundSchedule(const QList<SchedulerJob *> &jobs, ModuleLogger *logger);
+        /**
+          * @brief cancelBackgroundSchedule Drops the schedule being computed by scheduleJobsInBackground(), if any.
+          * Also done by scheduleJobs().
+          */
+        void cancelBackgroundSchedule();
+        bool isSchedulingInBackground() const
+        {
+            return !m_BackgroundSchedule.isNull();
+        }
+        /**
+          * @brief planNightsInBackground Simulates the schedule of the jobs for each night from firstNight to lastNight,
+          * from noon to noon the next day, as if nothing had been captured yet. The nights are simulated in parallel on
+          * snapshots of the jobs, which are left untouched and may be deleted once this returns. nightsPlanned() is
+          * emitted with the report.
+          * @param jobs A list of SchedulerJobs
+          * @param firstNight The date of the first night, in local time.
+          * @param lastNight The date of the last night, in local time.
+          * @return false if nights are already being planned.
+          */
+        bool planNightsInBackground(const QList<SchedulerJob *> &jobs, const QDate &firstNight, const QDate &lastNight);
+        bool isPlanningNights() const
+        {
+            return !m_NightsPlan.isNull();
+        }
         /**
           * @brief checkJob Checks to see if a job should continue running.
           * @param jobs A list of SchedulerJobs
@@ -129,8 +183,18 @@ class GreedyScheduler : public QObject
         static void printSchedule(const QList<JobSchedule> &schedule);
         static QString jobScheduleString(const JobSchedule &jobSchedule);
 
+    signals:
+        // The schedule computed by scheduleJobsInBackground() is ready to be applied.
+        void backgroundScheduleDone();
+        // The nights planned by planNightsInBackground(), with the hours scheduled per job name for each
+        // night under "nights", and in total under "totals".
+        void nightsPlanned(const QJsonObject &report);
+
     private:
 
+        // Logs the plan computed by scheduleJobs() or scheduleJobsInBackground()
+        void logSchedule(const QDateTime &now, const QDateTime &when, double seconds, ModuleLogger *logger) const;
+
         // Changes the states of the jobs on the list, deciding which ones
         // can be scheduled by scheduleJobs(). This includes setting runnable
         // jobs to the JOB_EVALUATION state and updating their estimated time.
@@ -163,6 +227,12 @@ class GreedyScheduler : public QObject
                                     QString *interruptReason = nullptr,
                                     const QMap<QString, uint16_t> *capturedFramesCount = nullptr);
 
+        // Computes the next possible start times, from now, of the allowed jobs from index from on, as
+        // selectNextJob() does. One job per thread is computed, in parallel, up to currentJob if it is among them.
+        // Returns the index of the first job left to compute.
+        int evaluateStartTimes(const QList<SchedulerJob *> &jobs, int from, const QDateTime &now,
+                               const SchedulerJob * const currentJob, QVector<QDateTime> *startTimes) const;
+
         // Simulate the running of the scheduler from time to endTime by appending
         // JobSchedule entries to the schedule.
         // Used to find which jobs will be run in the future.
@@ -191,6 +261,17 @@ class GreedyScheduler : public QObject
         // The time of the last simulation in checkJob().
         // We don't simulate too frequently.
         QDateTime m_LastCheckJobSim;
+
+        // The snapshots and results of the schedule computed by scheduleJobsInBackground().
+        struct BackgroundSchedule;
+        QSharedPointer<BackgroundSchedule> m_BackgroundSchedule;
+        QFutureWatcher<void> m_BackgroundWatcher;
+        // The snapshots and results of the nights planned by planNightsInBackground().
+        struct NightsPlan;
+        QSharedPointer<NightsPlan> m_NightsPlan;
+        QFutureWatcher<void> m_NightsWatcher;
+        // Set on the scheduler computing in the background, to stop once the schedule is cancelled.
+        const std::atomic<bool> *m_Cancelled { nullptr };
 };
 
 }  // namespace Ekos
@@ -927,7 +927,7 @@ void Scheduler::saveJob(SchedulerJob *job)
 
     if (SCHEDULER_LOADING != moduleState()->schedulerState())
     {
-        process()->evaluateJobs(true);
+        process()->evaluateJobsInBackground();
     }
 }
 
@@ -1240,7 +1240,7 @@ void Scheduler::moveJobUp()
 
     /* Make list modified and evaluate jobs */
     moduleState()->setDirty(true);
-    process()->evaluateJobs(true);
+    process()->evaluateJobsInBackground();
 }
 
 void Scheduler::moveJobDown()
@@ -1270,7 +1270,7 @@ void Scheduler::moveJobDown()
 
     /* Make list modified and evaluate jobs */
     moduleState()->setDirty(true);
-    process()->evaluateJobs(true);
+    process()->evaluateJobsInBackground();
 }
 
 void Scheduler::updateJobTable(SchedulerJob *job)
@@ -1575,7 +1575,7 @@ void Scheduler::removeJob()
         resetJobEdit();
 
     watchJobChanges(true);
-    process()->evaluateJobs(true);
+    process()->evaluateJobsInBackground();
     emit jobsUpdated(moduleState()->getJSONJobs());
     updateJobTable();
     // disable moving and deleting, since selection is cleared
@@ -1874,7 +1874,7 @@ void Scheduler::sortJobsPerAltitude()
         for (SchedulerJob * job : moduleState()->jobs())
             job->reset();
 
-        process()->evaluateJobs(true);
+        process()->evaluateJobsInBackground();
     }
 }
 
@@ -19,6 +19,9 @@
 
 #include <knotification.h>
 
+#include <algorithm>
+#include <mutex>
+
 #include <ekos_scheduler_debug.h>
 
 #define BAD_SCORE -1000
@@ -132,6 +135,23 @@ SchedulerJob::SchedulerJob(KSMoon *moonPtr)
     moon = moonPtr;
 }
 
+SchedulerJob *SchedulerJob::snapshot(KSMoon *moonCopy) const
+{
+    SchedulerJob *copy = new SchedulerJob(moonCopy);
+    *copy = *this;
+    copy->moon = moonCopy;
+    copy->clearCache();
+    return copy;
+}
+
+void SchedulerJob::applyEvaluation(const SchedulerJob &snapshot)
+{
+    KSMoon * const ownMoon = moon;
+    *this = snapshot;
+    moon = ownMoon;
+    clearCache();
+}
+
 void SchedulerJob::setName(const QString &value)
 {
     name = value;
@@ -560,23 +580,21 @@ bool SchedulerJob::moonSeparationOK(QDateTime const &when) const
     KSNumbers numbers(ltWhen.djd());
     o.updateCoordsNow(&numbers);
 
-    CachingDms LST = SchedulerModuleState::getGeo()->GSTtoLST(SchedulerModuleState::getGeo()->LTtoUT(ltWhen).gst());
-    moon->updateCoords(&numbers, true, SchedulerModuleState::getGeo()->lat(), &LST, true);
+    // The Moon's position is interpolated from the almanac of the day, shared by all jobs
+    KStarsDateTime const midnight(ltWhen.date(), QTime(0, 1), Qt::LocalTime);
+    SkyPoint const moonPosition = KSAlmanac::forDay(midnight, SchedulerModuleState::getGeo())->moonPosition(
+                                      SchedulerModuleState::getGeo()->LTtoUT(ltWhen));
 
-    double const separation = moon->angularDistanceTo(&o).Degrees();
+    double const separation = moonPosition.angularDistanceTo(&o).Degrees();
 
     return (separation >= getMinMoonSeparation());
 }
 
-QDateTime SchedulerJob::calculateNextTime(QDateTime const &when, bool checkIfConstraintsAreMet, int increment,
-        QString *reason, bool runningJob, const QDateTime &until) const
+uint8_t SchedulerJob::violatedConstraints(const KStarsDateTime &when, QString *altitudeReason) const
 {
-    // FIXME: block calculating target coordinates at a particular time is duplicated in several places
-
-    // Retrieve the argument date/time, or fall back to current time - don't use QDateTime's timezone!
-    KStarsDateTime ltWhen(when.isValid() ?
-                          Qt::UTC == when.timeSpec() ? SchedulerModuleState::getGeo()->UTtoLT(KStarsDateTime(when)) : when :
-                          getLocalTime());
+    uint8_t violated = 0;
+    if (getEnforceTwilight() && !runsDuringAstronomicalNightTime(when))
+        violated |= TWILIGHT_CONSTRAINT;
 
     // Create a sky object with the target catalog coordinates
     SkyPoint const target = getTargetCoords();
@@ -584,10 +602,42 @@ QDateTime SchedulerJob::calculateNextTime(QDateTime const &when, bool checkIfCon
     o.setRA0(target.ra0());
     o.setDec0(target.dec0());
 
-    // Calculate the UT at the argument time
-    KStarsDateTime const ut = SchedulerModuleState::getGeo()->LTtoUT(ltWhen);
+    // Update RA/DEC of the target for the current fraction of the day
+    KSNumbers numbers(when.djd());
+    o.updateCoordsNow(&numbers);
 
-    double const SETTING_ALTITUDE_CUTOFF = Options::settingAltitudeCutoff();
+    // Compute local sidereal time for the current fraction of the day, calculate altitude
+    CachingDms const LST = SchedulerModuleState::getGeo()->GSTtoLST(SchedulerModuleState::getGeo()->LTtoUT(when).gst());
+    o.EquatorialToHorizontal(&LST, SchedulerModuleState::getGeo()->lat());
+    double const altitude = o.alt().Degrees();
+    double const azimuth = o.az().Degrees();
+
+    if (!satisfiesAltitudeConstraint(azimuth, altitude, altitudeReason))
+        return violated | ALTITUDE_CONSTRAINT;
+
+    if (0 < getMinMoonSeparation() && !moonSeparationOK(when))
+        violated |= MOON_CONSTRAINT;
+
+    // Is the target setting and under the cutoff?
+    double offset = LST.Hours() - o.ra().Hours();
+    if (24.0 <= offset)
+        offset -= 24.0;
+    else if (offset < 0.0)
+        offset += 24.0;
+    if (0.0 <= offset && offset < 12.0 &&
+            !satisfiesAltitudeConstraint(azimuth, altitude - Options::settingAltitudeCutoff()))
+        violated |= SETTING_CONSTRAINT;
+
+    return violated;
+}
+
+QDateTime SchedulerJob::calculateNextTime(QDateTime const &when, bool checkIfConstraintsAreMet, int increment,
+        QString *reason, bool runningJob, const QDateTime &until) const
+{
+    // Retrieve the argument date/time, or fall back to current time - don't use QDateTime's timezone!
+    KStarsDateTime ltWhen(when.isValid() ?
+                          Qt::UTC == when.timeSpec() ? SchedulerModuleState::getGeo()->UTtoLT(KStarsDateTime(when)) : when :
+                          getLocalTime());
 
     auto maxMinute = 1e8;
     if (!runningJob && until.isValid())
@@ -595,25 +645,39 @@ QDateTime SchedulerJob::calculateNextTime(QDateTime const &when, bool checkIfCon
 
     if (maxMinute > 24 * 60)
         maxMinute = 24 * 60;
+    if (maxMinute <= 0)
+        return QDateTime();
+
+    constraintTimeline.cover(ltWhen, KStarsDateTime(ltWhen.addSecs(static_cast<qint64>(maxMinute) * 60)),
+                             [this](const KStarsDateTime & time)
+    {
+        return violatedConstraints(time);
+    });
+
+    // The next minute of the search from the end of the stretch of the current one on
+    auto skipTo = [&](const QDateTime & from, const QDateTime & end, unsigned int &minute)
+    {
+        const qint64 seconds = from.secsTo(end);
+        if (seconds > 0)
+            minute += ((seconds - 1) / (60 * increment)) * increment;
+    };
 
     // Within the next 24 hours, search when the job target matches the altitude and moon constraints
     for (unsigned int minute = 0; minute < maxMinute; minute += increment)
     {
         KStarsDateTime const ltOffset(ltWhen.addSecs(minute * 60));
+        QDateTime end;
+        const uint8_t violated = constraintTimeline.at(ltOffset, &end);
 
         // Is this violating twilight?
-        QDateTime nextSuccess;
-        if (getEnforceTwilight() && !runsDuringAstronomicalNightTime(ltOffset, &nextSuccess))
+        if (violated & TWILIGHT_CONSTRAINT)
         {
             if (checkIfConstraintsAreMet)
             {
                 // Change the minute to increment-minutes before next success.
-                if (nextSuccess.isValid())
-                {
-                    const int minutesToSuccess = ltOffset.secsTo(nextSuccess) / 60 - increment;
-                    if (minutesToSuccess > 0)
-                        minute += minutesToSuccess;
-                }
+                const int minutesToSuccess = ltOffset.secsTo(constraintTimeline.endOf(ltOffset, TWILIGHT_CONSTRAINT)) / 60 - increment;
+                if (minutesToSuccess > 0)
+                    minute += minutesToSuccess;
                 continue;
             }
             else
@@ -623,55 +687,45 @@ QDateTime SchedulerJob::calculateNextTime(QDateTime const &when, bool checkIfCon
             }
         }
 
-        // Update RA/DEC of the target for the current fraction of the day
-        KSNumbers numbers(ltOffset.djd());
-        o.updateCoordsNow(&numbers);
+        if (violated & ALTITUDE_CONSTRAINT)
+        {
+            if (!checkIfConstraintsAreMet)
+            {
+                if (reason)
+                    violatedConstraints(ltOffset, reason);
+                return ltOffset;
+            }
+            skipTo(ltOffset, end, minute);
+            continue;
+        }
 
-        // Compute local sidereal time for the current fraction of the day, calculate altitude
-        CachingDms const LST = SchedulerModuleState::getGeo()->GSTtoLST(SchedulerModuleState::getGeo()->LTtoUT(ltOffset).gst());
-        o.EquatorialToHorizontal(&LST, SchedulerModuleState::getGeo()->lat());
-        double const altitude = o.alt().Degrees();
-        double const azimuth = o.az().Degrees();
+        // Don't test proximity to dawn in this situation, we only cater for altitude here
 
-        bool const altitudeOK = satisfiesAltitudeConstraint(azimuth, altitude, reason);
-        if (altitudeOK)
+        // Continue searching if Moon separation is not good enough
+        if (violated & MOON_CONSTRAINT)
         {
-            // Don't test proximity to dawn in this situation, we only cater for altitude here
-
-            // Continue searching if Moon separation is not good enough
-            if (0 < getMinMoonSeparation() && !moonSeparationOK(ltOffset))
+            if (!checkIfConstraintsAreMet)
             {
-                if (checkIfConstraintsAreMet)
-                    continue;
-                else
-                {
-                    if (reason) *reason = QString("moon separation");
-                    return ltOffset;
-                }
+                if (reason) *reason = QString("moon separation");
+                return ltOffset;
             }
+            skipTo(ltOffset, end, minute);
+            continue;
+        }
 
+        if (checkIfConstraintsAreMet)
+        {
             // Continue searching if target is setting and under the cutoff
-            if (checkIfConstraintsAreMet)
+            if (!runningJob && (violated & SETTING_CONSTRAINT))
             {
-                if (!runningJob)
-                {
-                    double offset = LST.Hours() - o.ra().Hours();
-                    if (24.0 <= offset)
-                        offset -= 24.0;
-                    else if (offset < 0.0)
-                        offset += 24.0;
-                    if (0.0 <= offset && offset < 12.0)
-                    {
-                        bool const settingAltitudeOK = satisfiesAltitudeConstraint(azimuth, altitude - SETTING_ALTITUDE_CUTOFF);
-                        if (!settingAltitudeOK)
-                            continue;
-                    }
-                }
-                return ltOffset;
+                skipTo(ltOffset, end, minute);
+                continue;
             }
-        }
-        else if (!checkIfConstraintsAreMet)
             return ltOffset;
+        }
+
+        // Constraints are met until the end of the stretch
+        skipTo(ltOffset, end, minute);
     }
 
     return QDateTime();
@@ -794,6 +848,89 @@ bool SchedulerJob::StartTimeCache::check(const QDateTime &from, const QDateTime
     return false;
 }
 
+void SchedulerJob::ConstraintTimeline::cover(const KStarsDateTime &from, const KStarsDateTime &until,
+        const Evaluator &evaluate) const
+{
+    // Constraints are evaluated each minute, and to the second where they changed
+    constexpr qint64 STEP_SECONDS = 60;
+
+    if (covered < 0 || from < start || start.secsTo(from) > covered)
+    {
+        start = from;
+        segmentStarts = {0};
+        segmentConstraints = {evaluate(from)};
+        covered = 0;
+    }
+
+    const qint64 target = start.secsTo(until);
+    while (covered < target)
+    {
+        const qint64 next = std::min(covered + STEP_SECONDS, target);
+        uint8_t violated = evaluate(KStarsDateTime(start.addSecs(next)));
+        if (violated == segmentConstraints.last())
+        {
+            covered = next;
+            continue;
+        }
+
+        qint64 low = covered, high = next;
+        while (high - low > 1)
+        {
+            const qint64 middle = (low + high) / 2;
+            const uint8_t v = evaluate(KStarsDateTime(start.addSecs(middle)));
+            if (v == segmentConstraints.last())
+                low = middle;
+            else
+            {
+                high = middle;
+                violated = v;
+            }
+        }
+        segmentStarts.append(high);
+        segmentConstraints.append(violated);
+        covered = high;
+    }
+}
+
+int SchedulerJob::ConstraintTimeline::segment(const QDateTime &time) const
+{
+    const qint64 seconds = start.secsTo(time);
+    const auto next = std::upper_bound(segmentStarts.cbegin(), segmentStarts.cend(), seconds);
+    return std::max(0, static_cast<int>(next - segmentStarts.cbegin()) - 1);
+}
+
+uint8_t SchedulerJob::ConstraintTimeline::at(const QDateTime &time, QDateTime *end) const
+{
+    if (segmentStarts.isEmpty())
+        return 0;
+
+    const int i = segment(time);
+    if (end)
+        *end = start.addSecs(i + 1 < segmentStarts.size() ? segmentStarts[i + 1] : covered);
+    return segmentConstraints[i];
+}
+
+QDateTime SchedulerJob::ConstraintTimeline::endOf(const QDateTime &time, uint8_t constraints) const
+{
+    if (segmentStarts.isEmpty())
+        return time;
+
+    for (int i = segment(time); i < segmentStarts.size(); ++i)
+    {
+        if ((segmentConstraints[i] & constraints) == 0)
+            return std::max(time, static_cast<QDateTime>(start.addSecs(segmentStarts[i])));
+    }
+    return start.addSecs(covered);
+}
+
+void SchedulerJob::ConstraintTimeline::clear() const
+{
+    start = KStarsDateTime();
+    segmentStarts.clear();
+    segmentConstraints.clear();
+    covered = -1;
+}
+
 void SchedulerJob::StartTimeCache::clear() const
 {
     startComputations.clear();
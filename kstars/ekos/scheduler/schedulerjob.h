@@ -15,6 +15,8 @@
 #include "kstarsdatetime.h"
 #include <QJsonObject>
 
+#include <functional>
+
 class ArtificialHorizon;
 class KSMoon;
 class TestSchedulerUnit;
@@ -513,10 +515,26 @@ class SchedulerJob
         QString jobStartupConditionString(StartupCondition condition) const;
         QString jobCompletionConditionString(CompletionCondition condition) const;
 
-        // Clear the cache that keeps results for getNextPossibleStartTime().
+        // Clear the caches that keep results for getNextPossibleStartTime() and calculateNextTime().
         void clearCache()
         {
             startTimeCache.clear();
+            constraintTimeline.clear();
+        }
+
+        /**
+         * @brief snapshot A copy of the job to be scheduled on another thread, which checks the Moon separation with
+         * moonCopy as the Moon of the sky map is updated on the GUI thread. Owned by the caller.
+         */
+        SchedulerJob *snapshot(KSMoon *moonCopy) const;
+        /**
+         * @brief applyEvaluation Takes the state, estimates and schedule of a snapshot of the job once scheduled,
+         * keeping the Moon of the job.
+         */
+        void applyEvaluation(const SchedulerJob &snapshot);
+        KSMoon *getMoon() const
+        {
+            return moon;
         }
         double getAltitudeAtStartup() const
         {
@@ -539,6 +557,22 @@ private:
         bool runsDuringAstronomicalNightTimeInternal(const QDateTime &time, QDateTime *minDawnDusk,
                 QDateTime *nextPossibleSuccess = nullptr) const;
 
+        // Constraints calculateNextTime() finds violated
+        typedef enum
+        {
+            TWILIGHT_CONSTRAINT = 1,
+            ALTITUDE_CONSTRAINT = 2,
+            MOON_CONSTRAINT = 4,
+            SETTING_CONSTRAINT = 8
+        } Constraint;
+
+        /**
+         * @brief violatedConstraints The constraints violated at a local time, as a combination of Constraint. The Moon
+         * separation and the setting altitude cutoff are only checked if the altitude is fine.
+         * @param altitudeReason a human-readable string explaining why the altitude is not fine.
+         */
+        uint8_t violatedConstraints(const KStarsDateTime &when, QString *altitudeReason = nullptr) const;
+
         // Private constructor for unit testing.
         SchedulerJob(KSMoon *moonPtr);
         friend TestSchedulerUnit;
@@ -667,6 +701,33 @@ private:
         };
         StartTimeCache startTimeCache;
 
+        // The constraints of calculateNextTime() over time, evaluated each minute and to the second where they
+        // change, so that its searches skip the stretches where the same constraints are violated instead of evaluating
+        // them again minute by minute. Like the StartTimeCache, it is reset at the start of all schedule calculations.
+        class ConstraintTimeline
+        {
+            public:
+                typedef std::function<uint8_t(const KStarsDateTime &)> Evaluator;
+
+                // Evaluates the constraints from one time to another, where they are not known yet.
+                void cover(const KStarsDateTime &from, const KStarsDateTime &until, const Evaluator &evaluate) const;
+                // The constraints violated at a covered time, and the end of the stretch they are violated for.
+                uint8_t at(const QDateTime &time, QDateTime *end = nullptr) const;
+                // The first covered time from time on at which none of constraints is violated, or the end of the cover.
+                QDateTime endOf(const QDateTime &time, uint8_t constraints) const;
+                void clear() const;
+            private:
+                int segment(const QDateTime &time) const;
+
+                mutable KStarsDateTime start;
+                // Seconds from start at which the violated constraints change, and the constraints violated from then on
+                mutable QVector<qint64> segmentStarts;
+                mutable QVector<uint8_t> segmentConstraints;
+                // Seconds from start the constraints are known until
+                mutable qint64 covered { -1 };
+        };
+        ConstraintTimeline constraintTimeline;
+
         // These are used in testing, instead of KStars::Instance() resources
         static KStarsDateTime *storedLocalTime;
         static GeoLocation *storedGeo;
@@ -9,6 +9,7 @@
 #include "greedyscheduler.h"
 #include "schedulerutils.h"
 #include "schedulerjob.h"
+#include "ekos/capture/placeholderpath.h"
 #include "ekos/capture/sequencejob.h"
 #include "Options.h"
 #include "ksmessagebox.h"
@@ -24,6 +25,7 @@
 
 #include <QDBusReply>
 #include <QDBusInterface>
+#include <QJsonDocument>
 
 #define RESTART_GUIDING_DELAY_MS  5000
 
@@ -39,6 +41,20 @@ SchedulerProcess::SchedulerProcess(QSharedPointer<SchedulerModuleState> state, c
 {
     m_moduleState = state;
     m_GreedyScheduler = new GreedyScheduler();
+    connect(m_GreedyScheduler, &GreedyScheduler::backgroundScheduleDone, this, [this]()
+    {
+        if (getGreedyScheduler()->applyBackgroundSchedule(moduleState()->jobs(), this))
+            emit jobsUpdated(moduleState()->getJSONJobs());
+        else
+        {
+            qCDebug(KSTARS_EKOS_SCHEDULER) << "Jobs changed while their schedule was computed, scheduling them again.";
+            evaluateJobsInBackground();
+        }
+    });
+    connect(m_GreedyScheduler, &GreedyScheduler::nightsPlanned, this, [this](const QJsonObject & report)
+    {
+        emit nightsPlanned(QString::fromUtf8(QJsonDocument(report).toJson(QJsonDocument::Compact)));
+    });
     connect(KConfigDialog::exists("settings"), &KConfigDialog::settingsChanged, this, &SchedulerProcess::applyConfig);
 
     // Connect simulation clock scale
@@ -609,6 +625,39 @@ void SchedulerProcess::resetAllJobs()
     startJobEvaluation();
 }
 
+bool SchedulerProcess::planNights(const QString &fileURL, const QString &firstNight, const QString &lastNight)
+{
+    const QDate first = QDate::fromString(firstNight, Qt::ISODate), last = QDate::fromString(lastNight, Qt::ISODate);
+    if (!first.isValid() || !last.isValid() || last < first)
+    {
+        appendLogText(i18n("Invalid nights to plan, from %1 to %2.", firstNight, lastNight));
+        return false;
+    }
+    if (getGreedyScheduler()->isPlanningNights())
+    {
+        appendLogText(i18n("Nights are already being planned."));
+        return false;
+    }
+
+    QList<SchedulerJob *> jobs;
+    const bool loaded = SchedulerUtils::loadJobs(fileURL, jobs, this);
+    // The jobs are planned from snapshots
+    const bool started = loaded && getGreedyScheduler()->planNightsInBackground(jobs, first, last);
+    qDeleteAll(jobs);
+    return started;
+}
+
+void SchedulerProcess::rescanCapturedFrames()
+{
+    PlaceholderPath::resetDirectoryIndex();
+
+    // A running scheduler keeps its job states, only the frame counts are refreshed
+    if (moduleState()->schedulerState() == SCHEDULER_RUNNING)
+        updateCompletedJobsCount(true);
+    else
+        startJobEvaluation();
+}
+
 bool SchedulerProcess::shouldSchedulerSleep(SchedulerJob * job)
 {
     Q_ASSERT_X(nullptr != job, __FUNCTION__,
@@ -2343,6 +2392,34 @@ void SchedulerProcess::evaluateJobs(bool evaluateOnly)
     emit jobsUpdated(moduleState()->getJSONJobs());
 }
 
+void SchedulerProcess::evaluateJobsInBackground()
+{
+    if (!Options::schedulerBackgroundPlanning())
+    {
+        evaluateJobs(true);
+        return;
+    }
+
+    for (auto job : moduleState()->jobs())
+        job->clearCache();
+
+    /* Don't evaluate if list is empty */
+    if (moduleState()->jobs().isEmpty())
+    {
+        getGreedyScheduler()->cancelBackgroundSchedule();
+        return;
+    }
+    /* Start by refreshing the number of captures already present - unneeded if not remembering job progress */
+    if (Options::rememberJobProgress())
+        updateCompletedJobsCount();
+
+    moduleState()->calculateDawnDusk();
+
+    // The jobs and the table are updated once the schedule is done
+    getGreedyScheduler()->scheduleJobsInBackground(moduleState()->jobs(), SchedulerModuleState::getLocalTime(),
+            moduleState()->capturedFramesCount(), this);
+}
+
 bool SchedulerProcess::checkStatus()
 {
     if (moduleState()->schedulerState() == SCHEDULER_PAUSED)
@@ -2622,10 +2699,39 @@ int SchedulerProcess::runSchedulerIteration()
         // qCDebug(KSTARS_EKOS_SCHEDULER) << "Scheduler iteration never set up.";
         moduleState()->setTimerInterval(moduleState()->updatePeriodMs());
     }
+
+    // While a module works on the job stage, it pushes its state changes to the setXXXStatus slots,
+    // which wake up the job check. Polling is then only a watchdog for lost events and timeouts.
+    if (moduleState()->timerState() == RUN_JOBCHECK && activeJob() != nullptr
+            && moduleState()->timerInterval() == moduleState()->updatePeriodMs())
+    {
+        switch (activeJob()->getStage())
+        {
+            case SCHEDSTAGE_SLEWING:
+            case SCHEDSTAGE_RESLEWING:
+            case SCHEDSTAGE_FOCUSING:
+            case SCHEDSTAGE_POSTALIGN_FOCUSING:
+            case SCHEDSTAGE_ALIGNING:
+            case SCHEDSTAGE_GUIDING:
+            case SCHEDSTAGE_CAPTURING:
+                moduleState()->setTimerInterval(std::max(moduleState()->updatePeriodMs(),
+                                                static_cast<int>(Options::schedulerWatchdogPeriod() * 1000)));
+                break;
+            default:
+                break;
+        }
+    }
     //    printStates(QString("End iteration, sleep %1: ").arg(moduleState()->timerInterval()));
     return moduleState()->timerInterval();
 }
 
+void SchedulerProcess::wakeUpJobCheck()
+{
+    // Only shorten a pending job check, the slots may have set up another iteration themselves
+    if (moduleState()->timerState() == RUN_JOBCHECK && moduleState()->iterationTimer().isActive())
+        moduleState()->iterationTimer().start(0);
+}
+
 void SchedulerProcess::checkJobStage()
 {
     Q_ASSERT_X(activeJob(), __FUNCTION__, "Actual current job is required to check job stage");
@@ -3348,6 +3454,8 @@ void SchedulerProcess::appendLogText(const QString &logentry)
 
 void SchedulerProcess::setAlignStatus(AlignState status)
 {
+    wakeUpJobCheck();
+
     if (moduleState()->schedulerState() == SCHEDULER_PAUSED || activeJob() == nullptr)
         return;
 
@@ -3411,6 +3519,8 @@ void SchedulerProcess::setAlignStatus(AlignState status)
 
 void SchedulerProcess::setGuideStatus(GuideState status)
 {
+    wakeUpJobCheck();
+
     if (moduleState()->schedulerState() == SCHEDULER_PAUSED || activeJob() == nullptr)
         return;
 
@@ -3482,6 +3592,8 @@ void SchedulerProcess::setGuideStatus(GuideState status)
 
 void SchedulerProcess::setCaptureStatus(CaptureState status)
 {
+    wakeUpJobCheck();
+
     if (activeJob() == nullptr)
         return;
 
@@ -3575,6 +3687,8 @@ void SchedulerProcess::setCaptureStatus(CaptureState status)
 
 void SchedulerProcess::setFocusStatus(FocusState status)
 {
+    wakeUpJobCheck();
+
     if (moduleState()->schedulerState() == SCHEDULER_PAUSED || activeJob() == nullptr)
         return;
 
@@ -3627,6 +3741,8 @@ void SchedulerProcess::setFocusStatus(FocusState status)
 
 void SchedulerProcess::setMountStatus(ISD::Mount::Status status)
 {
+    wakeUpJobCheck();
+
     if (moduleState()->schedulerState() == SCHEDULER_PAUSED || activeJob() == nullptr)
         return;
 
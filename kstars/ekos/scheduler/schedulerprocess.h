@@ -114,6 +114,22 @@ public:
      */
     Q_SCRIPTABLE void resetAllJobs();
 
+    /** DBUS interface function.
+     * @brief Scan the capture directories again to count the frames already captured, and re-evaluate the jobs.
+     * The frame counts are otherwise kept in an index, updated as frames are written.
+     */
+    Q_SCRIPTABLE Q_NOREPLY void rescanCapturedFrames();
+
+    /** DBUS interface function.
+     * @brief Plans the jobs of an Ekos Scheduler List (.esl) file for each night of a date range, without changing the
+     * queue or using any device. The nights are simulated in parallel, and the report is emitted by nightsPlanned().
+     * @param fileURL path to the file
+     * @param firstNight date of the first night, as yyyy-MM-dd
+     * @param lastNight date of the last night, as yyyy-MM-dd
+     * @return true if planning started, false if the file or the dates are invalid or nights are already being planned.
+     */
+    Q_SCRIPTABLE bool planNights(const QString &fileURL, const QString &firstNight, const QString &lastNight);
+
     /**
      * @brief shouldSchedulerSleep Check if the scheduler needs to sleep until the job is ready
      * @param job Job to check
@@ -265,6 +281,13 @@ public:
      */
     void evaluateJobs(bool evaluateOnly);
 
+    /**
+     * @brief evaluateJobsInBackground evaluates the jobs as evaluateJobs(true) does, computing their schedule on another
+     * thread so that editing a long queue doesn't block Ekos. The jobs and their table are updated once it is done.
+     * Falls back to evaluateJobs(true) unless the SchedulerBackgroundPlanning option is set.
+     */
+    void evaluateJobsInBackground();
+
     /**
      * @brief checkJobStatus Check the overall state of the scheduler, Ekos, and INDI. When all is OK, it calls evaluateJobs() when no job is current or executeJob() if a job is selected.
      * @return False if this function needs to be called again later, true if situation is stable and operations may continue.
@@ -287,6 +310,13 @@ public:
      */
     int runSchedulerIteration();
 
+    /**
+     * @brief wakeUpJobCheck Runs the pending job check now, as a module just pushed a change of its state.
+     * While a module reports the progress of the current job stage, checkJobStage only runs every
+     * SchedulerWatchdogPeriod seconds to catch the events that got lost.
+     */
+    void wakeUpJobCheck();
+
     /**
      * @brief checkJobStage Check the progress of the job states and make DBUS calls to start the next stage until the job is complete.
      */
@@ -577,6 +607,8 @@ signals:
     // required for Analyze timeline
     void jobStarted(const QString &jobName);
     void jobEnded(const QString &jobName, const QString &endReason);
+    // nights planned by planNights(), as a JSON report of the hours scheduled per job for each night and in total
+    void nightsPlanned(const QString &report);
 
 
 private slots:
@@ -13,9 +13,101 @@
 #include "kstarsdata.h"
 #include <ekos_scheduler_debug.h>
 
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+
 namespace Ekos
 {
 
+namespace
+{
+// The elements of a parsed capture sequence file.
+struct SequenceFile
+{
+    QList<XMLEle *> roots;
+    ~SequenceFile()
+    {
+        for (auto root : roots)
+            delXMLEle(root);
+    }
+};
+
+// What identifies the contents of a sequence file as last read, without reading it again.
+struct SequenceFileStamp
+{
+    QDateTime modified;
+    qint64 size { 0 };
+    QByteArray hash;
+};
+
+// Sequence files are parsed once per content, as many jobs of a schedule often share one, and are read
+// again only once they are modified.
+constexpr int MAX_SEQUENCE_FILES = 64;
+QMutex sequenceFilesMutex;
+QHash<QString, SequenceFileStamp> sequenceFileStamps;
+QHash<QByteArray, QSharedPointer<const SequenceFile>> sequenceFiles;
+
+QSharedPointer<const SequenceFile> parseSequenceFile(const QString &fileURL, ModuleLogger *logger)
+{
+    QMutexLocker locker(&sequenceFilesMutex);
+
+    const QFileInfo info(fileURL);
+    auto stamp = sequenceFileStamps.constFind(fileURL);
+    if (stamp != sequenceFileStamps.constEnd() && info.exists() && stamp->modified == info.lastModified()
+            && stamp->size == info.size() && sequenceFiles.contains(stamp->hash))
+        return sequenceFiles.value(stamp->hash);
+
+    QFile sFile;
+    sFile.setFileName(fileURL);
+
+    if (!sFile.open(QIODevice::ReadOnly))
+    {
+        if (logger != nullptr) logger->appendLogText(i18n("Unable to open sequence queue file '%1'", fileURL));
+        return QSharedPointer<const SequenceFile>();
+    }
+    const QByteArray contents = sFile.readAll();
+    const QByteArray hash = QCryptographicHash::hash(contents, QCryptographicHash::Sha1);
+    if (sequenceFiles.size() >= MAX_SEQUENCE_FILES && !sequenceFiles.contains(hash))
+    {
+        sequenceFiles.clear();
+        sequenceFileStamps.clear();
+    }
+    SequenceFileStamp newStamp;
+    newStamp.modified = info.lastModified();
+    newStamp.size = info.size();
+    newStamp.hash = hash;
+
+    auto parsed = sequenceFiles.value(hash);
+    if (parsed.isNull())
+    {
+        QSharedPointer<SequenceFile> file(new SequenceFile());
+        LilXML *xmlParser = newLilXML();
+        char errmsg[MAXRBUF];
+        for (const char c : contents)
+        {
+            XMLEle *root = readXMLEle(xmlParser, c, errmsg);
+
+            if (root)
+                file->roots.append(root);
+            else if (errmsg[0])
+            {
+                if (logger != nullptr) logger->appendLogText(QString(errmsg));
+                delLilXML(xmlParser);
+                sequenceFileStamps.remove(fileURL);
+                return QSharedPointer<const SequenceFile>();
+            }
+        }
+        delLilXML(xmlParser);
+        parsed = file;
+        sequenceFiles.insert(hash, parsed);
+    }
+    sequenceFileStamps.insert(fileURL, newStamp);
+    return parsed;
+}
+}
+
 SchedulerUtils::SchedulerUtils()
 {
 
@@ -143,8 +235,9 @@ SchedulerJob *SchedulerUtils::createJob(XMLEle *root)
             }
         }
     }
+    // The scheduler time rather than the KStars clock, which is the same in Ekos but lets tests and simulations set it
     SchedulerUtils::setupJob(*job, name, group, ra, dec,
-                             KStarsData::Instance()->ut().djd(),
+                             SchedulerModuleState::getGeo()->LTtoUT(SchedulerModuleState::getLocalTime()).djd(),
                              rotation, sequenceURL, fitsURL,
 
                              startup, startupTime,
@@ -343,22 +436,20 @@ SequenceJob *SchedulerUtils::processSequenceJobInfo(XMLEle *root, SchedulerJob *
     return job;
 }
 
-bool SchedulerUtils::loadSequenceQueue(const QString &fileURL, SchedulerJob *schedJob, QList<SequenceJob *> &jobs,
-                                       bool &hasAutoFocus, ModuleLogger *logger)
+bool SchedulerUtils::loadJobs(const QString &fileURL, QList<SchedulerJob *> &jobs, ModuleLogger *logger)
 {
     QFile sFile;
     sFile.setFileName(fileURL);
 
     if (!sFile.open(QIODevice::ReadOnly))
     {
-        if (logger != nullptr) logger->appendLogText(i18n("Unable to open sequence queue file '%1'", fileURL));
+        if (logger != nullptr) logger->appendLogText(i18n("Unable to open file %1", fileURL));
         return false;
     }
 
     LilXML *xmlParser = newLilXML();
     char errmsg[MAXRBUF];
     XMLEle *root = nullptr;
-    XMLEle *ep   = nullptr;
     char c;
 
     while (sFile.getChar(&c))
@@ -367,24 +458,10 @@ bool SchedulerUtils::loadSequenceQueue(const QString &fileURL, SchedulerJob *sch
 
         if (root)
         {
-            for (ep = nextXMLEle(root, 1); ep != nullptr; ep = nextXMLEle(root, 0))
+            for (XMLEle *ep = nextXMLEle(root, 1); ep != nullptr; ep = nextXMLEle(root, 0))
             {
-                if (!strcmp(tagXMLEle(ep), "Autofocus"))
-                    hasAutoFocus = (!strcmp(findXMLAttValu(ep, "enabled"), "true"));
-                else if (!strcmp(tagXMLEle(ep), "Job"))
-                {
-                    SequenceJob *thisJob = processSequenceJobInfo(ep, schedJob);
-                    jobs.append(thisJob);
-                    if (jobs.count() == 1)
-                    {
-                        auto &firstJob = jobs.first();
-                        if (FRAME_LIGHT == firstJob->getFrameType() && nullptr != schedJob)
-                        {
-                            schedJob->setInitialFilter(firstJob->getCoreProperty(SequenceJob::SJ_Filter).toString());
-                        }
-
-                    }
-                }
+                if (!strcmp(tagXMLEle(ep), "Job"))
+                    jobs.append(createJob(ep));
             }
             delXMLEle(root);
         }
@@ -392,11 +469,44 @@ bool SchedulerUtils::loadSequenceQueue(const QString &fileURL, SchedulerJob *sch
         {
             if (logger != nullptr) logger->appendLogText(QString(errmsg));
             delLilXML(xmlParser);
-            qDeleteAll(jobs);
             return false;
         }
     }
 
+    delLilXML(xmlParser);
+    return true;
+}
+
+bool SchedulerUtils::loadSequenceQueue(const QString &fileURL, SchedulerJob *schedJob, QList<SequenceJob *> &jobs,
+                                       bool &hasAutoFocus, ModuleLogger *logger)
+{
+    const QSharedPointer<const SequenceFile> file = parseSequenceFile(fileURL, logger);
+    if (file.isNull())
+        return false;
+
+    for (XMLEle *root : file->roots)
+    {
+        for (XMLEle *ep = nextXMLEle(root, 1); ep != nullptr; ep = nextXMLEle(root, 0))
+        {
+            if (!strcmp(tagXMLEle(ep), "Autofocus"))
+                hasAutoFocus = (!strcmp(findXMLAttValu(ep, "enabled"), "true"));
+            else if (!strcmp(tagXMLEle(ep), "Job"))
+            {
+                SequenceJob *thisJob = processSequenceJobInfo(ep, schedJob);
+                jobs.append(thisJob);
+                if (jobs.count() == 1)
+                {
+                    auto &firstJob = jobs.first();
+                    if (FRAME_LIGHT == firstJob->getFrameType() && nullptr != schedJob)
+                    {
+                        schedJob->setInitialFilter(firstJob->getCoreProperty(SequenceJob::SJ_Filter).toString());
+                    }
+
+                }
+            }
+        }
+    }
+
     return true;
 }
 
@@ -33,6 +33,15 @@ public:
      */
     static SchedulerJob *createJob(XMLEle *root);
 
+    /**
+     * @brief loadJobs Loads the jobs of an Ekos Scheduler List (.esl) file, leaving out the settings it also holds.
+     * @param fileURL the filename
+     * @param jobs the jobs read, owned by the caller
+     * @param logger module logging utility
+     * @return true if the file could be read
+     */
+    static bool loadJobs(const QString &fileURL, QList<SchedulerJob *> &jobs, ModuleLogger *logger);
+
     /**
      * @brief setupJob Initialize a job with all fields accessible from the UI.
      */
@@ -82,6 +91,7 @@ public:
          * @param jobs the returned values read from the file
          * @param hasAutoFocus a return value indicating whether autofocus can be triggered by the sequence.
          * @param logger module logging utility
+         * @note The file is parsed once per content, and read again only once modified.
          */
 
     static bool loadSequenceQueue(const QString &fileURL, SchedulerJob *schedJob, QList<SequenceJob *> &jobs, bool &hasAutoFocus, ModuleLogger *logger);
@@ -1788,7 +1788,7 @@ dc1394error_t dc1394_bayer_VNG(const uint8_t *bayer, uint8_t *dst, int sx, int s
                                dc1394color_filter_t pattern)
 {
     const int height = sy, width = sx;
-    static const signed char *cp;
+    const signed char *cp;
     /* the following has the same type as the image */
     uint8_t(*brow[5])[3], *pix; /* [FD] */
     int code[8][2][320], *ip, gval[8], gmin, gmax, sum[4];
@@ -1932,7 +1932,7 @@ dc1394error_t dc1394_bayer_VNG_uint16(const uint16_t *bayer, uint16_t *dst, int
                                       dc1394color_filter_t pattern, int bits)
 {
     const int height = sy, width = sx;
-    static const signed char *cp;
+    const signed char *cp;
     /* the following has the same type as the image */
     uint16_t(*brow[5])[3], *pix; /* [FD] */
     int code[8][2][320], *ip, gval[8], gmin, gmax, sum[4];
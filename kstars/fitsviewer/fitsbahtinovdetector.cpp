@@ -14,9 +14,14 @@
 #include "fitsbahtinovdetector.h"
 #include "hough/houghline.h"
 #include "fitsdata.h"
+#include "auxiliary/tracer.h"
 
 #include <QElapsedTimer>
-#include <QtConcurrent>
+#include <QThread>
+
+#include <limits>
+#include <numeric>
+#include <vector>
 
 //void FITSBahtinovDetector::configure(const QString &setting, const QVariant &value)
 //{
@@ -50,29 +55,29 @@ QFuture<bool> FITSBahtinovDetector::findSources(QRect const &boundary)
     switch (stats.dataType)
     {
         case TSHORT:
-            return QtConcurrent::run(this, &FITSBahtinovDetector::findBahtinovStar<int16_t>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSBahtinovDetector::findBahtinovStar<int16_t>, this, boundary);
 
         case TUSHORT:
-            return QtConcurrent::run(this, &FITSBahtinovDetector::findBahtinovStar<uint16_t>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSBahtinovDetector::findBahtinovStar<uint16_t>, this, boundary);
 
         case TLONG:
-            return QtConcurrent::run(this, &FITSBahtinovDetector::findBahtinovStar<int32_t>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSBahtinovDetector::findBahtinovStar<int32_t>, this, boundary);
 
         case TULONG:
-            return QtConcurrent::run(this, &FITSBahtinovDetector::findBahtinovStar<uint32_t>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSBahtinovDetector::findBahtinovStar<uint32_t>, this, boundary);
 
         case TFLOAT:
-            return QtConcurrent::run(this, &FITSBahtinovDetector::findBahtinovStar<float>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSBahtinovDetector::findBahtinovStar<float>, this, boundary);
 
         case TLONGLONG:
-            return QtConcurrent::run(this, &FITSBahtinovDetector::findBahtinovStar<int64_t>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSBahtinovDetector::findBahtinovStar<int64_t>, this, boundary);
 
         case TDOUBLE:
-            return QtConcurrent::run(this, &FITSBahtinovDetector::findBahtinovStar<double>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSBahtinovDetector::findBahtinovStar<double>, this, boundary);
 
         default:
         case TBYTE:
-            return QtConcurrent::run(this, &FITSBahtinovDetector::findBahtinovStar<uint8_t>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSBahtinovDetector::findBahtinovStar<uint8_t>, this, boundary);
 
     }
 }
@@ -80,6 +85,8 @@ QFuture<bool> FITSBahtinovDetector::findSources(QRect const &boundary)
 template <typename T>
 bool FITSBahtinovDetector::findBahtinovStar(const QRect &boundary)
 {
+    KSTARS_TRACE_SPAN("fits", "Star detection");
+
     if (boundary.isEmpty())
         return false;
 
@@ -138,18 +145,43 @@ bool FITSBahtinovDetector::findBahtinovStar(const QRect &boundary)
     QMap<int, BahtinovLineAverage> lineAveragesPerAngle;
     const int steps = 180;
     double radPerStep = M_PI / steps;
+    // Spikes are brighter than the background, so only pixels above the mean of the region are rotated
+    const bool prefilter = getValue("BACKGROUND_PREFILTER", true).toBool();
+    QVector<double> thresholds;
+    for (int i = 0; i < boundedImage->channels(); i++)
+        thresholds.append(prefilter ? boundedImage->getMean(i) : std::numeric_limits<double>::lowest());
+    const int averageRows = getAverageRows();
 
     timer1.start();
 
-    for (int angle = 0; angle < steps; angle++)
+    // Search the angles coarsely first, then every angle around the best coarse angles
+    const int coarseStep = qMax(1, getValue("COARSE_ANGLE_STEP", COARSE_ANGLE_STEP).toInt());
+    QVector<int> angles;
+    for (int angle = 0; angle < steps; angle += coarseStep)
+        angles.append(angle);
+    calculateMaxAverages<T>(boundedImage, angles, thresholds, averageRows, lineAveragesPerAngle);
+
+    if (coarseStep > 1)
     {
-        // TODO Apply multi threading to speed up calculation
-        BahtinovLineAverage lineAverage = calculateMaxAverage<T>(boundedImage, angle);
-        // Store line average in map
-        lineAveragesPerAngle.insert(angle, lineAverage);
+        QMap<int, BahtinovLineAverage> coarseAverages = lineAveragesPerAngle;
+        QVector<int> fineAngles;
+        for (int index1 = 0; index1 < 3; index1++)
+        {
+            const int coarseAngle = takeBestAngle(coarseAverages, steps);
+            if (coarseAngle < 0)
+                break;
+            for (int subAngle = coarseAngle - coarseStep + 1; subAngle < coarseAngle + coarseStep; subAngle++)
+            {
+                const int angleInRange = (subAngle + steps) % steps;
+                if (!lineAveragesPerAngle.contains(angleInRange) && !fineAngles.contains(angleInRange))
+                    fineAngles.append(angleInRange);
+            }
+        }
+        calculateMaxAverages<T>(boundedImage, fineAngles, thresholds, averageRows, lineAveragesPerAngle);
     }
 
-    qCDebug(KSTARS_FITS) << "Getting max average for all 180 rotations took" << timer1.elapsed() << "milliseconds";
+    qCDebug(KSTARS_FITS) << "Getting max average for" << lineAveragesPerAngle.size() << "of" << steps << "rotations took"
+                         << timer1.elapsed() << "milliseconds";
 
     // Not needed anymore
     delete boundedImage;
@@ -180,8 +212,7 @@ bool FITSBahtinovDetector::findBahtinovStar(const QRect &boundary)
         }
 
         // Remove data around peak to prevent it from being detected again
-        int minBahtinovAngleOffset = 18;
-        for (int subAngle = maxAngle - minBahtinovAngleOffset; subAngle < maxAngle + minBahtinovAngleOffset; subAngle++)
+        for (int subAngle = maxAngle - MIN_BAHTINOV_ANGLE_OFFSET; subAngle < maxAngle + MIN_BAHTINOV_ANGLE_OFFSET; subAngle++)
         {
             int angleInRange = subAngle;
             if (angleInRange < 0)
@@ -281,25 +312,8 @@ bool FITSBahtinovDetector::findBahtinovStar(const QRect &boundary)
     return true;
 }
 
-template <typename T>
-BahtinovLineAverage FITSBahtinovDetector::calculateMaxAverage(const FITSData *data, int angle)
+int FITSBahtinovDetector::getAverageRows() const
 {
-    int BBP = data->getBytesPerPixel();
-    int size = data->getStatistics().samples_per_channel;
-    int width = data->width();
-    int height = data->height();
-    int numChannels = data->channels();
-
-    BahtinovLineAverage lineAverage;
-    auto * rotimage = new T[size * BBP];
-
-    rotateImage(data, angle, rotimage);
-
-    // Calculate average pixel value for each row
-    auto * rotBuffer = reinterpret_cast<T *>(rotimage);
-
-    //    printf("Angle;%d;Width;%d;Height;%d;Rows;%d;;RowSum;", angle, width, height, NUMBER_OF_AVERAGE_ROWS);
-
     int NUMBER_OF_AVERAGE_ROWS = getValue("NUMBER_OF_AVERAGE_ROWS", 1).toInt();
     if (NUMBER_OF_AVERAGE_ROWS % 2 == 0)
     {
@@ -314,6 +328,71 @@ BahtinovLineAverage FITSBahtinovDetector::calculateMaxAverage(const FITSData *da
         qCWarning(KSTARS_FITS) << "Warning, number of rows must be positive correcting number of rows to "
                                << NUMBER_OF_AVERAGE_ROWS;
     }
+    return NUMBER_OF_AVERAGE_ROWS;
+}
+
+int FITSBahtinovDetector::takeBestAngle(QMap<int, BahtinovLineAverage> &lineAverages, int steps)
+{
+    // The lowest of equally good angles, as in the selection of the Bahtinov angles
+    double maxAverage = 0.0;
+    int maxAngle = -1;
+    for (auto it = lineAverages.constBegin(); it != lineAverages.constEnd(); ++it)
+    {
+        if (it.value().average > maxAverage)
+        {
+            maxAverage = it.value().average;
+            maxAngle = it.key();
+        }
+    }
+    if (maxAngle < 0)
+        return -1;
+
+    for (int subAngle = maxAngle - MIN_BAHTINOV_ANGLE_OFFSET; subAngle < maxAngle + MIN_BAHTINOV_ANGLE_OFFSET; subAngle++)
+        lineAverages.remove((subAngle + steps) % steps);
+    return maxAngle;
+}
+
+template <typename T>
+void FITSBahtinovDetector::calculateMaxAverages(const FITSData *data, const QVector<int> &angles,
+        const QVector<double> &thresholds, int averageRows, QMap<int, BahtinovLineAverage> &lineAverages)
+{
+    if (angles.isEmpty())
+        return;
+
+    // Split the angles into ranges, one per thread, each rotating into its own buffer
+    const int size = data->getStatistics().samples_per_channel;
+    QVector<BahtinovLineAverage> results(angles.size());
+    QVector<int> ranges(qMin(angles.size(), qMax(1, QThread::idealThreadCount())));
+    std::iota(ranges.begin(), ranges.end(), 0);
+    Executors::blockingMap(data->executorPriority(), ranges, [&](int range)
+    {
+        const int first = range * angles.size() / ranges.size();
+        const int last = (range + 1) * angles.size() / ranges.size();
+        std::vector<T> rotimage(static_cast<size_t>(size) * data->channels());
+        for (int i = first; i < last; i++)
+        {
+            rotateImage(data, angles[i], rotimage.data(), thresholds);
+            results[i] = calculateMaxAverage(data, rotimage.data(), averageRows);
+        }
+    });
+
+    for (int i = 0; i < angles.size(); i++)
+        lineAverages.insert(angles[i], results[i]);
+}
+
+template <typename T>
+BahtinovLineAverage FITSBahtinovDetector::calculateMaxAverage(const FITSData *data, const T *rotimage,
+        int NUMBER_OF_AVERAGE_ROWS)
+{
+    int size = data->getStatistics().samples_per_channel;
+    int width = data->width();
+    int height = data->height();
+    int numChannels = data->channels();
+
+    BahtinovLineAverage lineAverage;
+
+    // Calculate average pixel value for each row
+    const T *rotBuffer = rotimage;
 
     for (int y = 0; y < height; y++)
     {
@@ -350,7 +429,6 @@ BahtinovLineAverage FITSBahtinovDetector::calculateMaxAverage(const FITSData *da
                 multiRowSum += qRound(channelAverage / static_cast<double>(numChannels));
             }
         }
-        //        printf("%lu;", multiRowSum);
 
         double average = multiRowSum / static_cast<double>(width * NUMBER_OF_AVERAGE_ROWS);
         if (average > lineAverage.average)
@@ -359,33 +437,25 @@ BahtinovLineAverage FITSBahtinovDetector::calculateMaxAverage(const FITSData *da
             lineAverage.offset = y;
         }
     }
-    //    printf(";;MaxAverage;%.3f;MaxAverageIndex;%lu\r\n", lineAverage.average, lineAverage.offset);
-    //    fflush(stdout);
-
-    rotBuffer = nullptr;
-    delete[] rotimage;
-    rotimage = nullptr;
 
     return lineAverage;
 }
 
 /** Rotate an image by angle degrees.
- * verbose generates extra info on stdout.
  * return true if successful and rotated image.
  * @param angle The angle over which the image needs to be rotated
- * @param rotImage The image that needs to be rotated, also the rotated image return value
+ * @param rotImage The rotated image, of samples_per_channel pixels per channel
+ * @param thresholds Pixels below the threshold of their channel are left out, as if they were black
  */
 template <typename T>
-bool FITSBahtinovDetector::rotateImage(const FITSData *data, int angle, T * rotImage)
+bool FITSBahtinovDetector::rotateImage(const FITSData *data, int angle, T * rotImage, const QVector<double> &thresholds)
 {
-    int BBP = data->getBytesPerPixel();
     int size = data->getStatistics().samples_per_channel;
     int width = data->width();
     int height = data->height();
     int numChannels = data->channels();
 
     int hx, hy;
-    size_t bufferSize;
 
     /* Check allocation buffer for rotated image */
     if (rotImage == nullptr)
@@ -406,10 +476,9 @@ bool FITSBahtinovDetector::rotateImage(const FITSData *data, int angle, T * rotI
     hx = qFloor((width + 1) / 2.0);
     hy = qFloor((height + 1) / 2.0);
 
-    bufferSize = size * numChannels * BBP;
-    memset(rotImage, 0, bufferSize);
+    memset(rotImage, 0, static_cast<size_t>(size) * numChannels * sizeof(T));
 
-    auto * rotBuffer = reinterpret_cast<T *>(rotImage);
+    auto * rotBuffer = rotImage;
     auto * buffer = reinterpret_cast<const T *>(data->getImageBuffer());
 
     double innerCircleRadius = (0.5 * qSqrt(2.0) * qMin(hx, hy));
@@ -424,10 +493,15 @@ bool FITSBahtinovDetector::rotateImage(const FITSData *data, int angle, T * rotI
     for (int i = 0; i < numChannels; i++)
     {
         int offset = size * i;
+        const double threshold = (i < thresholds.size()) ? thresholds[i] : std::numeric_limits<double>::lowest();
         for (int x1 = leftEdge; x1 < rightEdge; x1++)
         {
             for (int y1 = topEdge; y1 < bottomEdge; y1++)
             {
+                int orgIndex = y1 * height + x1;
+                if (buffer[orgIndex + offset] < threshold)
+                    continue;
+
                 // translate point back to origin:
                 double x2 = x1 - hx;
                 double y2 = y1 - hy;
@@ -440,10 +514,9 @@ bool FITSBahtinovDetector::rotateImage(const FITSData *data, int angle, T * rotI
                 x2 = xnew + hx;
                 y2 = ynew + hy;
 
-                int orgIndex = y1 * height + x1;
                 int newIndex = qRound(y2) * height + qRound(x2);
 
-                if (newIndex >= 0 && newIndex < static_cast<int>(bufferSize))
+                if (newIndex >= 0 && newIndex < size)
                 {
                     rotBuffer[newIndex + offset] = buffer[orgIndex + offset];
                 } // else index out of bounds, do not update pixel
@@ -47,6 +47,10 @@ class FITSBahtinovDetector: public FITSStarDetector
         /** @group Detection parameters.
          * @{ */
         //int NUMBER_OF_AVERAGE_ROWS { 1 };
+        /** @brief Degrees between the angles of the coarse search, 1 searches every angle. Setting "COARSE_ANGLE_STEP". */
+        static constexpr int COARSE_ANGLE_STEP { 3 };
+        /** @brief Degrees around a selected angle in which no other angle is selected. */
+        static constexpr int MIN_BAHTINOV_ANGLE_OFFSET { 18 };
         /** @} */
 
     protected:
@@ -57,10 +61,17 @@ class FITSBahtinovDetector: public FITSStarDetector
         bool findBahtinovStar(const QRect &boundary);
 
     private:
+        int getAverageRows() const;
+        /** @internal Returns the angle of the highest average, or -1 if there is none, and removes the angles around it. */
+        static int takeBestAngle(QMap<int, BahtinovLineAverage> &lineAverages, int steps);
+        /** @internal Calculates the maximum line average of each angle, over the angles split across threads. */
         template <typename T>
-        BahtinovLineAverage calculateMaxAverage(const FITSData *data, int angle);
+        void calculateMaxAverages(const FITSData *data, const QVector<int> &angles, const QVector<double> &thresholds,
+                                  int averageRows, QMap<int, BahtinovLineAverage> &lineAverages);
         template <typename T>
-        bool rotateImage(const FITSData *data, int angle, T * rotimage);
+        static BahtinovLineAverage calculateMaxAverage(const FITSData *data, const T *rotimage, int averageRows);
+        template <typename T>
+        static bool rotateImage(const FITSData *data, int angle, T * rotimage, const QVector<double> &thresholds);
 };
 
 #endif // FITSBAHTINOVDETECTOR_H
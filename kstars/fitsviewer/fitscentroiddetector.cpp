@@ -10,11 +10,12 @@
 
 #include <math.h>
 #include <cmath>
-#include <QtConcurrent>
 
 #include "fitscentroiddetector.h"
 #include "fits_debug.h"
 #include "fitsdata.h"
+#include "fitsframepool.h"
+#include "auxiliary/tracer.h"
 
 //void FITSCentroidDetector::configure(const QString &setting, const QVariant &value)
 //{
@@ -57,28 +58,28 @@ QFuture<bool> FITSCentroidDetector::findSources(const QRect &boundary)
     {
         case TBYTE:
         default:
-            return QtConcurrent::run(this, &FITSCentroidDetector::findSources<uint8_t const>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSCentroidDetector::findSources<uint8_t const>, this, boundary);
 
         case TSHORT:
-            return QtConcurrent::run(this, &FITSCentroidDetector::findSources<int16_t const>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSCentroidDetector::findSources<int16_t const>, this, boundary);
 
         case TUSHORT:
-            return QtConcurrent::run(this, &FITSCentroidDetector::findSources<uint16_t const>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSCentroidDetector::findSources<uint16_t const>, this, boundary);
 
         case TLONG:
-            return QtConcurrent::run(this, &FITSCentroidDetector::findSources<int32_t const>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSCentroidDetector::findSources<int32_t const>, this, boundary);
 
         case TULONG:
-            return QtConcurrent::run(this, &FITSCentroidDetector::findSources<uint32_t const>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSCentroidDetector::findSources<uint32_t const>, this, boundary);
 
         case TFLOAT:
-            return QtConcurrent::run(this, &FITSCentroidDetector::findSources<float const>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSCentroidDetector::findSources<float const>, this, boundary);
 
         case TLONGLONG:
-            return QtConcurrent::run(this, &FITSCentroidDetector::findSources<int64_t const>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSCentroidDetector::findSources<int64_t const>, this, boundary);
 
         case TDOUBLE:
-            return QtConcurrent::run(this, &FITSCentroidDetector::findSources<double const>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSCentroidDetector::findSources<double const>, this, boundary);
 
     }
 }
@@ -86,6 +87,8 @@ QFuture<bool> FITSCentroidDetector::findSources(const QRect &boundary)
 template <typename T>
 bool FITSCentroidDetector::findSources(const QRect &boundary)
 {
+    KSTARS_TRACE_SPAN("fits", "Star detection");
+
     FITSImage::Statistic const &stats = m_ImageData->getStatistics();
     FITSMode const m_Mode = static_cast<FITSMode>(m_ImageData->property("mode").toInt());
 
@@ -224,7 +227,7 @@ bool FITSCentroidDetector::findSources(const QRect &boundary)
                                             (buffer[i_center + (i * stats.width) - starDiameter / 2] - min))
                                         << " located at X: " << center << " Y: " << i + 0.5;
 
-                                auto * newEdge = new Edge();
+                                auto * newEdge = FITSFramePool::instance().takeEdge();
 
                                 newEdge->x       = center;
                                 newEdge->y       = i + 0.5;
@@ -357,7 +360,7 @@ bool FITSCentroidDetector::findSources(const QRect &boundary)
         if (cen_count >= cen_limit)
         {
             // We detected a centroid, let's init it
-            auto * rCenter = new Edge();
+            auto * rCenter = FITSFramePool::instance().takeEdge();
 
             rCenter->x = avg_x / sum;
             rCenter->y = avg_y / sum;
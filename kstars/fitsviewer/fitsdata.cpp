@@ -8,13 +8,14 @@
 */
 
 #include "fitsdata.h"
+#include "fitsframepool.h"
 #include "fitsbahtinovdetector.h"
 #include "fitsthresholddetector.h"
 #include "fitsgradientdetector.h"
 #include "fitscentroiddetector.h"
 #include "fitssepdetector.h"
-
-#include "fpack.h"
+#include "fitsincrementaldetector.h"
+#include "imagememory.h"
 
 #include "kstarsdata.h"
 #include "ksutils.h"
@@ -23,12 +24,14 @@
 #include "skymapcomposite.h"
 #include "auxiliary/ksnotification.h"
 #include "auxiliary/robuststatistics.h"
+#include "auxiliary/tracer.h"
 
 #include <KFormat>
 #include <QApplication>
 #include <QImage>
-#include <QtConcurrent>
 #include <QImageReader>
+#include <QtEndian>
+#include <QThread>
 
 #if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
 #include <wcshdr.h>
@@ -43,8 +46,14 @@
 #include <libxisf.h>
 #endif
 
+#include <algorithm>
+#include <atomic>
 #include <cfloat>
 #include <cmath>
+#include <cstring>
+#include <iterator>
+#include <numeric>
+#include <vector>
 
 #include <fits_debug.h>
 
@@ -62,6 +71,19 @@ QString getTemporaryPath()
 
 const QStringList RAWFormats = { "cr2", "cr3", "crw", "nef", "raf", "dng", "arw", "orf" };
 
+namespace
+{
+// Header of the current HDU as 80 character records. Tile-compressed images are stored in a binary table,
+// whose own header describes the table, so convert it back to the header of the image it holds.
+int imageHeaderToString(fitsfile *fptr, int nocomments, char **header, int *nkeys, int *status)
+{
+    int compressedStatus = 0;
+    if (fits_is_compressed_image(fptr, &compressedStatus))
+        return fits_convert_hdr2str(fptr, nocomments, nullptr, 0, header, nkeys, status);
+    return fits_hdr2str(fptr, nocomments, nullptr, 0, header, nkeys, status);
+}
+}
+
 bool FITSData::readableFilename(const QString &filename)
 {
     QFileInfo info(filename);
@@ -100,9 +122,10 @@ FITSData::FITSData(const QSharedPointer<FITSData> &other)
     this->m_Mode = other->m_Mode;
     this->m_Statistics.channels = other->m_Statistics.channels;
     memcpy(&m_Statistics, &(other->m_Statistics), sizeof(m_Statistics));
-    m_ImageBuffer = new uint8_t[m_Statistics.samples_per_channel * m_Statistics.channels * m_Statistics.bytesPerPixel];
-    memcpy(m_ImageBuffer, other->m_ImageBuffer,
-           m_Statistics.samples_per_channel * m_Statistics.channels * m_Statistics.bytesPerPixel);
+    m_ImageBufferSize = m_Statistics.samples_per_channel * m_Statistics.channels * m_Statistics.bytesPerPixel;
+    m_ImageBuffer = new uint8_t[m_ImageBufferSize];
+    memcpy(m_ImageBuffer, other->m_ImageBuffer, m_ImageBufferSize);
+    trackImageBuffer();
 }
 
 FITSData::~FITSData()
@@ -113,6 +136,7 @@ FITSData::~FITSData()
         m_StarFindFuture.waitForFinished();
 
     clearImageBuffers();
+    ImageMemory::instance().untrack(this);
 
 #ifdef HAVE_WCSLIB
     if (m_WCSHandle != nullptr)
@@ -123,9 +147,7 @@ FITSData::~FITSData()
     }
 #endif
 
-    if (starCenters.count() > 0)
-        qDeleteAll(starCenters);
-    starCenters.clear();
+    FITSFramePool::instance().giveEdges(starCenters);
 
     if (m_SkyObjects.count() > 0)
         qDeleteAll(m_SkyObjects);
@@ -144,8 +166,7 @@ FITSData::~FITSData()
 void FITSData::loadCommon(const QString &inFilename)
 {
     int status = 0;
-    qDeleteAll(starCenters);
-    starCenters.clear();
+    FITSFramePool::instance().giveEdges(starCenters);
 
     if (fptr != nullptr)
     {
@@ -173,7 +194,7 @@ QFuture<bool> FITSData::loadFromFile(const QString &inFilename)
     QFileInfo info(m_Filename);
     m_Extension = info.completeSuffix().toLower();
     qCDebug(KSTARS_FITS) << "Loading file " << m_Filename;
-    return QtConcurrent::run(this, &FITSData::privateLoad, QByteArray());
+    return Executors::run(executorPriority(), &FITSData::privateLoad, this, QByteArray());
 }
 
 namespace
@@ -191,6 +212,8 @@ QString fitsErrorToString(int status)
 
 bool FITSData::privateLoad(const QByteArray &buffer)
 {
+    KSTARS_TRACE_SPAN("fits", "FITS load");
+
     m_isTemporary = m_Filename.startsWith(KSPaths::writableLocation(QStandardPaths::TempLocation));
     cacheHFR = -1;
     cacheEccentricity = -1;
@@ -214,61 +237,58 @@ bool FITSData::loadFITSImage(const QByteArray &buffer, const bool isCompressed)
 
     m_HistogramConstructed = false;
 
-    if (m_Extension.contains(".fz") || isCompressed)
+    const bool compressed = m_Extension.contains(".fz") || isCompressed;
+    if (compressed)
     {
-        fpstate fpvar;
-        fp_init (&fpvar);
-        bool rc = false;
-
+        // Tile-compressed images are opened as they are. CFITSIO decompresses them tile by tile
+        // straight into our image buffer in readCompressedImage(), so there is no intermediate
+        // uncompressed copy of the whole file.
         if (buffer.isEmpty())
         {
             // Store so we don't lose.
             m_compressedFilename = m_Filename;
+            free(m_PackBuffer);
+            m_PackBuffer = nullptr;
 
-            QString uncompressedFile = QDir::tempPath() + QString("/%1").arg(QUuid::createUuid().toString().remove(
-                                           QRegularExpression("[-{}]")));
-
-            rc = fp_unpack_file_to_fits(m_Filename.toLocal8Bit().data(), &fptr, fpvar) == 0;
-            if (rc)
+            if (fits_open_diskfile(&fptr, m_Filename.toLocal8Bit(), READONLY, &status))
             {
-                m_Filename = uncompressedFile;
+                m_LastError = i18n("Error opening fits file %1 : %2", m_Filename, fitsErrorToString(status));
+                qCCritical(KSTARS_FITS) << m_LastError;
+                return false;
             }
+
+            m_Statistics.size = QFile(m_Filename).size();
         }
         else
         {
-            size_t m_PackBufferSize = 100000;
+            // CFITSIO reads from the compressed data for as long as the file is open, so keep our own copy.
             free(m_PackBuffer);
-            m_PackBuffer = (uint8_t *)malloc(m_PackBufferSize);
-            rc = fp_unpack_data_to_data(buffer.data(), buffer.size(), &m_PackBuffer, &m_PackBufferSize, fpvar) == 0;
-
-            if (rc)
+            m_PackBufferSize = buffer.size();
+            m_PackBuffer = reinterpret_cast<uint8_t *>(malloc(m_PackBufferSize));
+            if (m_PackBuffer == nullptr)
             {
-                void *data = reinterpret_cast<void *>(m_PackBuffer);
-                if (fits_open_memfile(&fptr, m_Filename.toLocal8Bit().data(), READONLY, &data, &m_PackBufferSize, 0,
-                                      nullptr, &status))
-                {
-                    m_LastError = i18n("Error reading fits buffer: %1.", fitsErrorToString(status));
-                    return false;
-                }
+                m_LastError = i18n("Failed to unpack compressed fits");
+                qCCritical(KSTARS_FITS) << m_LastError;
+                return false;
+            }
+            memcpy(m_PackBuffer, buffer.data(), m_PackBufferSize);
 
-                m_Statistics.size = m_PackBufferSize;
+            void *data = reinterpret_cast<void *>(m_PackBuffer);
+            size_t size = m_PackBufferSize;
+            if (fits_open_memfile(&fptr, m_Filename.toLocal8Bit().data(), READONLY, &data, &size, 0,
+                                  nullptr, &status))
+            {
+                free(m_PackBuffer);
+                m_PackBuffer = nullptr;
+                m_LastError = i18n("Error reading fits buffer: %1.", fitsErrorToString(status));
+                return false;
             }
-            //rc = fp_unpack_data_to_fits(buffer.data(), buffer.size(), &fptr, fpvar) == 0;
-        }
 
-        if (rc == false)
-        {
-            free(m_PackBuffer);
-            m_PackBuffer = nullptr;
-            m_LastError = i18n("Failed to unpack compressed fits");
-            qCCritical(KSTARS_FITS) << m_LastError;
-            return false;
+            m_Statistics.size = m_PackBufferSize;
+            m_isTemporary = true;
         }
 
-        m_isTemporary = true;
         m_isCompressed = true;
-        m_Statistics.size = fptr->Fptr->logfilesize;
-
     }
     else if (buffer.isEmpty())
     {
@@ -304,6 +324,11 @@ bool FITSData::loadFITSImage(const QByteArray &buffer, const bool isCompressed)
         m_LastError = i18n("Could not locate image HDU: %1", fitsErrorToString(status));
     }
 
+    // fpack stores the compressed image in the first extension, after an empty primary HDU.
+    int naxis = 0;
+    if (compressed && fits_get_img_dim(fptr, &naxis, &status) == 0 && naxis == 0)
+        fits_movrel_hdu(fptr, 1, nullptr, &status);
+
     if (fits_get_img_param(fptr, 3, &m_FITSBITPIX, &(m_Statistics.ndim), naxes, &status))
     {
         free(m_PackBuffer);
@@ -313,7 +338,7 @@ bool FITSData::loadFITSImage(const QByteArray &buffer, const bool isCompressed)
     }
 
     // Reload if it is transparently compressed.
-    if ((fits_is_compressed_image(fptr, &status) || m_Statistics.ndim <= 0) && !isCompressed)
+    if ((fits_is_compressed_image(fptr, &status) || m_Statistics.ndim <= 0) && !compressed)
     {
         loadCommon(m_Filename);
         qCDebug(KSTARS_FITS) << "Image is compressed. Reloading...";
@@ -405,26 +430,41 @@ bool FITSData::loadFITSImage(const QByteArray &buffer, const bool isCompressed)
         m_Statistics.channels = 1;
 
     m_ImageBufferSize = m_Statistics.samples_per_channel * m_Statistics.channels * m_Statistics.bytesPerPixel;
-    m_ImageBuffer = new uint8_t[m_ImageBufferSize];
-    if (m_ImageBuffer == nullptr)
-    {
-        qCWarning(KSTARS_FITS) << "FITSData: Not enough memory for image_buffer channel. Requested: "
-                               << m_ImageBufferSize << " bytes.";
-        clearImageBuffers();
-        free(m_PackBuffer);
-        m_PackBuffer = nullptr;
-        return false;
-    }
 
     rotCounter     = 0;
     flipHCounter   = 0;
     flipVCounter   = 0;
     long nelements = m_Statistics.samples_per_channel * m_Statistics.channels;
 
-    if (fits_read_img(fptr, m_Statistics.dataType, 1, nelements, nullptr, m_ImageBuffer, &anynull, &status))
+    // Uncompressed files on disk can be mapped directly, otherwise let CFITSIO copy the data into our own buffer.
+    const bool canMap = buffer.isEmpty() && !compressed && Options::memoryMappedFITS();
+    if (canMap == false || mapImageBuffer() == false)
     {
-        m_LastError = i18n("Error reading image: %1", fitsErrorToString(status));
-        return false;
+        acquireImageBuffer();
+        if (m_ImageBuffer == nullptr)
+        {
+            qCWarning(KSTARS_FITS) << "FITSData: Not enough memory for image_buffer channel. Requested: "
+                                   << m_ImageBufferSize << " bytes.";
+            clearImageBuffers();
+            free(m_PackBuffer);
+            m_PackBuffer = nullptr;
+            return false;
+        }
+
+        if (compressed)
+        {
+            if (readCompressedImage(nelements) == false)
+                return false;
+        }
+        // Frames received from INDI are converted straight from the BLOB, in one pass, instead of
+        // being read through the CFITSIO memory file which buffers and converts the data separately.
+        else if (buffer.isEmpty() == false && readBufferedImage(buffer))
+            qCDebug(KSTARS_FITS) << "Converted" << KFormat().formatByteSize(m_ImageBufferSize) << "of image data from buffer";
+        else if (fits_read_img(fptr, m_Statistics.dataType, 1, nelements, nullptr, m_ImageBuffer, &anynull, &status))
+        {
+            m_LastError = i18n("Error reading image: %1", fitsErrorToString(status));
+            return false;
+        }
     }
 
     parseHeader();
@@ -543,7 +583,7 @@ bool FITSData::loadXISFImage(const QByteArray &buffer)
         }
 
         m_ImageBufferSize = image.imageDataSize();
-        m_ImageBuffer = new uint8_t[m_ImageBufferSize];
+        acquireImageBuffer();
         std::memcpy(m_ImageBuffer, image.imageData(), m_ImageBufferSize);
 
         calculateStats(false, false);
@@ -691,6 +731,7 @@ bool FITSData::loadCanonicalImage(const QByteArray &buffer)
     m_ImageBufferSize = m_Statistics.samples_per_channel * m_Statistics.channels * static_cast<uint16_t>
                         (m_Statistics.bytesPerPixel);
     m_ImageBuffer = new uint8_t[m_ImageBufferSize];
+    trackImageBuffer();
     if (m_ImageBuffer == nullptr)
     {
         m_LastError = i18n("FITSData: Not enough memory for image_buffer channel. Requested: %1 bytes ", m_ImageBufferSize);
@@ -803,6 +844,7 @@ bool FITSData::loadRAWImage(const QByteArray &buffer)
     clearImageBuffers();
     m_ImageBufferSize = m_Statistics.samples_per_channel * m_Statistics.channels * m_Statistics.bytesPerPixel;
     m_ImageBuffer = new uint8_t[m_ImageBufferSize];
+    trackImageBuffer();
     if (m_ImageBuffer == nullptr)
     {
         m_LastError = i18n("FITSData: Not enough memory for image_buffer channel. Requested: %1 bytes ", m_ImageBufferSize);
@@ -844,6 +886,8 @@ bool FITSData::loadRAWImage(const QByteArray &buffer)
 
 bool FITSData::saveImage(const QString &newFilename)
 {
+    KSTARS_TRACE_SPAN("fits", "Save");
+
     if (newFilename == m_Filename)
         return true;
 
@@ -1157,10 +1201,250 @@ bool FITSData::saveImage(const QString &newFilename)
     return true;
 }
 
-void FITSData::clearImageBuffers()
+bool FITSData::readCompressedImage(long nelements)
+{
+    int status = 0, anynull = 0;
+
+    // Each thread needs its own CFITSIO handle, so only split large images, and only with a reentrant CFITSIO.
+    constexpr uint32_t minBandSamples = 1024 * 1024;
+    long rowsPerTile = 1;
+    fits_read_key(fptr, TLONG, "ZTILE2", &rowsPerTile, nullptr, &status);
+    status = 0;
+    rowsPerTile = std::max(1L, rowsPerTile);
+
+    const uint32_t width = m_Statistics.width;
+    const uint32_t height = m_Statistics.height;
+    const uint32_t numTiles = (height + rowsPerTile - 1) / rowsPerTile;
+    uint32_t numBands = 1;
+    if (fits_is_reentrant())
+        numBands = qBound<uint32_t>(1, m_Statistics.samples_per_channel / minBandSamples,
+                                    std::min<uint32_t>(numTiles, QThread::idealThreadCount()));
+
+    if (numBands == 1)
+    {
+        if (fits_read_img(fptr, m_Statistics.dataType, 1, nelements, nullptr, m_ImageBuffer, &anynull, &status))
+        {
+            m_LastError = i18n("Error reading image: %1", fitsErrorToString(status));
+            return false;
+        }
+        return true;
+    }
+
+    int hdu = 1;
+    fits_get_hdu_num(fptr, &hdu);
+
+    // Bands are made of whole tiles, so that no tile is decompressed twice.
+    const uint32_t tilesPerBand = (numTiles + numBands - 1) / numBands;
+    std::vector<uint32_t> bands(numBands);
+    std::iota(bands.begin(), bands.end(), 0);
+    std::atomic<int> result { 0 };
+
+    Executors::blockingMap(executorPriority(), bands, [&](uint32_t band)
+    {
+        const long firstRow = band * tilesPerBand * rowsPerTile;
+        const long lastRow = std::min<long>(height, firstRow + tilesPerBand * rowsPerTile);
+        if (firstRow >= lastRow)
+            return;
+
+        int bandStatus = 0, bandNull = 0;
+        fitsfile *bandFptr = nullptr;
+        if (m_PackBuffer)
+        {
+            void *data = reinterpret_cast<void *>(m_PackBuffer);
+            size_t size = m_PackBufferSize;
+            fits_open_memfile(&bandFptr, "band", READONLY, &data, &size, 0, nullptr, &bandStatus);
+        }
+        else
+            fits_open_diskfile(&bandFptr, m_compressedFilename.toLocal8Bit(), READONLY, &bandStatus);
+
+        fits_movabs_hdu(bandFptr, hdu, nullptr, &bandStatus);
+
+        for (int channel = 0; channel < m_Statistics.channels && bandStatus == 0; channel++)
+        {
+            long fpixel[3] = { 1, firstRow + 1, channel + 1 };
+            long lpixel[3] = { static_cast<long>(width), lastRow, channel + 1 };
+            long inc[3] = { 1, 1, 1 };
+            uint8_t *destination = m_ImageBuffer +
+                                   (channel * m_Statistics.samples_per_channel + firstRow * width) * m_Statistics.bytesPerPixel;
+            fits_read_subset(bandFptr, m_Statistics.dataType, fpixel, lpixel, inc, nullptr, destination, &bandNull, &bandStatus);
+        }
+
+        if (bandStatus)
+            result = bandStatus;
+
+        int closeStatus = 0;
+        if (bandFptr)
+            fits_close_file(bandFptr, &closeStatus);
+    });
+
+    if (result != 0)
+    {
+        m_LastError = i18n("Error reading image: %1", fitsErrorToString(result));
+        return false;
+    }
+
+    return true;
+}
+
+bool FITSData::nativeImageData(int &physicalBITPIX, qint64 &dataStart)
+{
+    int status = 0;
+    double bscale = 1, bzero = 0;
+
+    if (fits_get_img_type(fptr, &physicalBITPIX, &status))
+        return false;
+
+    // Missing keywords are fine, defaults apply.
+    fits_read_key_dbl(fptr, "BSCALE", &bscale, nullptr, &status);
+    status = 0;
+    fits_read_key_dbl(fptr, "BZERO", &bzero, nullptr, &status);
+    status = 0;
+
+    // Only accept layouts whose stored representation only differs from ours by byte order.
+    switch (physicalBITPIX)
+    {
+        case BYTE_IMG:
+        case FLOAT_IMG:
+            if (bscale != 1 || bzero != 0)
+                return false;
+            break;
+        case SHORT_IMG:
+            // Unsigned 16bit images are stored as signed values with BZERO 32768
+            if (bscale != 1 || bzero != 32768 || m_Statistics.dataType != TUSHORT)
+                return false;
+            break;
+        default:
+            return false;
+    }
+
+    LONGLONG headStart = 0, start = 0, dataEnd = 0;
+    if (fits_get_hduaddrll(fptr, &headStart, &start, &dataEnd, &status))
+        return false;
+
+    if (dataEnd - start < static_cast<LONGLONG>(m_ImageBufferSize))
+        return false;
+
+    dataStart = start;
+    return true;
+}
+
+void FITSData::convertNativeImageData(const uint8_t *source, uint8_t *destination, int physicalBITPIX) const
 {
-    delete[] m_ImageBuffer;
+    // FITS data is big endian. 8bit data is used as is, other types must be converted.
+    // Source and destination may be the same buffer.
+    const uint32_t nelements = m_Statistics.samples_per_channel * m_Statistics.channels;
+    if (physicalBITPIX == SHORT_IMG)
+    {
+        // Flipping the sign bit is equivalent to adding BZERO 32768 to the signed value.
+        auto *in = reinterpret_cast<const uint16_t *>(source);
+        auto *out = reinterpret_cast<uint16_t *>(destination);
+        for (uint32_t i = 0; i < nelements; i++)
+            out[i] = qFromBigEndian(in[i]) ^ 0x8000;
+    }
+    else if (physicalBITPIX == FLOAT_IMG && QSysInfo::ByteOrder != QSysInfo::BigEndian)
+    {
+        auto *in = reinterpret_cast<const uint32_t *>(source);
+        auto *out = reinterpret_cast<uint32_t *>(destination);
+        for (uint32_t i = 0; i < nelements; i++)
+            out[i] = qFromBigEndian(in[i]);
+    }
+    else if (source != destination)
+        memcpy(destination, source, m_ImageBufferSize);
+}
+
+bool FITSData::mapImageBuffer()
+{
+    int physicalBITPIX = 0;
+    qint64 dataStart = 0;
+    if (nativeImageData(physicalBITPIX, dataStart) == false)
+        return false;
+
+    // Converting the data in place would write to every page of the mapping, which then saves no memory
+    // over reading the image. Only map the layouts that are used as they are stored.
+    const bool asStored = physicalBITPIX == BYTE_IMG ||
+                          (physicalBITPIX == FLOAT_IMG && QSysInfo::ByteOrder == QSysInfo::BigEndian);
+    if (asStored == false)
+        return false;
+
+    m_MappedFile.setFileName(m_Filename);
+    if (m_MappedFile.open(QIODevice::ReadOnly) == false)
+        return false;
+
+    // A private mapping is copy-on-write. Pages are only duplicated once they get modified by
+    // debayering, rotation, filters or calibration, so untouched pages are shared with the page cache.
+    // Untouched pages stay backed by the file, which must therefore not be truncated while it is loaded.
+    uchar *data = m_MappedFile.map(dataStart, m_ImageBufferSize, QFileDevice::MapPrivateOption);
+    if (data == nullptr)
+    {
+        m_MappedFile.close();
+        return false;
+    }
+
+    m_ImageBuffer = data;
+    m_ImageBufferMapped = true;
+    trackImageBuffer();
+    qCDebug(KSTARS_FITS) << "Mapped" << KFormat().formatByteSize(m_ImageBufferSize) << "of image data from" << m_Filename;
+    return true;
+}
+
+bool FITSData::readBufferedImage(const QByteArray &buffer)
+{
+    int physicalBITPIX = 0;
+    qint64 dataStart = 0;
+    if (nativeImageData(physicalBITPIX, dataStart) == false)
+        return false;
+
+    if (buffer.size() - dataStart < static_cast<qint64>(m_ImageBufferSize))
+        return false;
+
+    convertNativeImageData(reinterpret_cast<const uint8_t *>(buffer.constData()) + dataStart, m_ImageBuffer, physicalBITPIX);
+    return true;
+}
+
+void FITSData::acquireImageBuffer()
+{
+    if (FITSFramePool::isPooled(m_Mode) || m_PoolImageBuffer)
+    {
+        m_ImageBuffer       = FITSFramePool::instance().takeBuffer(m_Mode, m_ImageBufferSize);
+        m_ImageBufferPooled = true;
+        FITSFramePool::instance().frameLoaded(m_Mode);
+    }
+    else
+        m_ImageBuffer = new uint8_t[m_ImageBufferSize];
+    trackImageBuffer();
+}
+
+void FITSData::releaseImageBuffer()
+{
+    if (m_ImageBufferMapped)
+    {
+        m_MappedFile.unmap(m_ImageBuffer);
+        m_MappedFile.close();
+        m_ImageBufferMapped = false;
+    }
+    else if (m_ImageBufferPooled)
+    {
+        FITSFramePool::instance().giveBuffer(m_Mode, m_ImageBuffer, m_ImageBufferSize);
+        m_ImageBufferPooled = false;
+    }
+    else
+        delete[] m_ImageBuffer;
+
     m_ImageBuffer = nullptr;
+    m_ValueCountsValid = false;
+    invalidateFloatBuffers();
+    trackImageBuffer();
+}
+
+void FITSData::trackImageBuffer()
+{
+    // Mapped buffers are counted too, their pages become private once modified
+    ImageMemory::instance().track(this, m_ImageBuffer != nullptr ? m_ImageBufferSize : 0, ImageMemory::ownerOf(m_Mode));
+}
+
+void FITSData::clearImageBuffers()
+{
+    releaseImageBuffer();
     if(m_ImageRoiBuffer != nullptr )
     {
         delete[] m_ImageRoiBuffer;
@@ -1209,371 +1493,143 @@ void FITSData::makeRoiBuffer(QRect roi)
 }
 void FITSData::calculateStats(bool refresh, bool roi)
 {
-    // Calculate min max
-    if(roi == false)
-    {
-        calculateMinMax(refresh);
-        calculateMedian(refresh);
-
-        // Try to read mean/median/stddev if in file
-        if (refresh == false && fptr)
-        {
-            int status = 0;
-            int nfound = 0;
-            if (fits_read_key_dbl(fptr, "MEAN1", &m_Statistics.mean[0], nullptr, &status) == 0)
-                nfound++;
-            // NB. These could fail if missing, which is OK.
-            fits_read_key_dbl(fptr, "MEAN2", & m_Statistics.mean[1], nullptr, &status);
-            fits_read_key_dbl(fptr, "MEAN3", &m_Statistics.mean[2], nullptr, &status);
-
-            status = 0;
-            if (fits_read_key_dbl(fptr, "STDDEV1", &m_Statistics.stddev[0], nullptr, &status) == 0)
-                nfound++;
-            // NB. These could fail if missing, which is OK.
-            fits_read_key_dbl(fptr, "STDDEV2", &m_Statistics.stddev[1], nullptr, &status);
-            fits_read_key_dbl(fptr, "STDDEV3", &m_Statistics.stddev[2], nullptr, &status);
-
-            // If all is OK, we're done
-            if (nfound == 2)
-                return;
-        }
-
-        // Get standard deviation and mean in one run
-        switch (m_Statistics.dataType)
-        {
-            case TBYTE:
-                calculateStdDev<uint8_t>();
-                break;
-
-            case TSHORT:
-                calculateStdDev<int16_t>();
-                break;
-
-            case TUSHORT:
-                calculateStdDev<uint16_t>();
-                break;
-
-            case TLONG:
-                calculateStdDev<int32_t>();
-                break;
-
-            case TULONG:
-                calculateStdDev<uint32_t>();
-                break;
-
-            case TFLOAT:
-                calculateStdDev<float>();
-                break;
-
-            case TLONGLONG:
-                calculateStdDev<int64_t>();
-                break;
-
-            case TDOUBLE:
-                calculateStdDev<double>();
-                break;
-
-            default:
-                return;
-        }
-
-        // FIXME That's not really SNR, must implement a proper solution for this value
-        m_Statistics.SNR = m_Statistics.mean[0] / m_Statistics.stddev[0];
-    }
-    else
-    {
-        calculateMinMax(refresh, roi);
-        calculateMedian(refresh, roi);
-
-        switch (m_ROIStatistics.dataType)
-        {
-            case TBYTE:
-                calculateStdDev<uint8_t>(roi);
-                break;
-
-            case TSHORT:
-                calculateStdDev<int16_t>(roi);
-                break;
-
-            case TUSHORT:
-                calculateStdDev<uint16_t>(roi);
-                break;
-
-            case TLONG:
-                calculateStdDev<int32_t>(roi);
-                break;
-
-            case TULONG:
-                calculateStdDev<uint32_t>(roi);
-                break;
-
-            case TFLOAT:
-                calculateStdDev<float>(roi);
-                break;
-
-            case TLONGLONG:
-                calculateStdDev<int64_t>(roi);
-                break;
-
-            case TDOUBLE:
-                calculateStdDev<double>(roi);
-                break;
-
-            default:
-                return;
-        }
-    }
-}
+    KSTARS_TRACE_SPAN("fits", "Statistics");
 
-void FITSData::calculateMinMax(bool refresh, bool roi)
-{
     if(roi == false)
     {
-        int status, nfound = 0;
-
-        status = 0;
-
-        // Only fetch from header if we have a single channel
-        // Otherwise, calculate manually.
-        if (fptr != nullptr && !refresh)
-        {
-
-            status = 0;
-
-            if (fits_read_key_dbl(fptr, "DATAMIN", &(m_Statistics.min[0]), nullptr, &status) == 0)
-                nfound++;
-            else if (fits_read_key_dbl(fptr, "MIN1", &(m_Statistics.min[0]), nullptr, &status) == 0)
-                nfound++;
-
-            // NB. These could fail if missing, which is OK.
-            fits_read_key_dbl(fptr, "MIN2", &m_Statistics.min[1], nullptr, &status);
-            fits_read_key_dbl(fptr, "MIN3", &m_Statistics.min[2], nullptr, &status);
-
-            status = 0;
-
-            if (fits_read_key_dbl(fptr, "DATAMAX", &(m_Statistics.max[0]), nullptr, &status) == 0)
-                nfound++;
-            else if (fits_read_key_dbl(fptr, "MAX1", &(m_Statistics.max[0]), nullptr, &status) == 0)
-                nfound++;
-
-            // NB. These could fail if missing, which is OK.
-            fits_read_key_dbl(fptr, "MAX2", &m_Statistics.max[1], nullptr, &status);
-            fits_read_key_dbl(fptr, "MAX3", &m_Statistics.max[2], nullptr, &status);
-
-            // If we found both keywords, no need to calculate them, unless they are both zeros
-            if (nfound == 2 && !(m_Statistics.min[0] == 0 && m_Statistics.max[0] == 0))
-                return;
-        }
-
-        m_Statistics.min[0] = 1.0E30;
-        m_Statistics.max[0] = -1.0E30;
-
-        m_Statistics.min[1] = 1.0E30;
-        m_Statistics.max[1] = -1.0E30;
-
-        m_Statistics.min[2] = 1.0E30;
-        m_Statistics.max[2] = -1.0E30;
-
-        switch (m_Statistics.dataType)
-        {
-            case TBYTE:
-                calculateMinMax<uint8_t>();
-                break;
-
-            case TSHORT:
-                calculateMinMax<int16_t>();
-                break;
-
-            case TUSHORT:
-                calculateMinMax<uint16_t>();
-                break;
-
-            case TLONG:
-                calculateMinMax<int32_t>();
-                break;
-
-            case TULONG:
-                calculateMinMax<uint32_t>();
-                break;
-
-            case TFLOAT:
-                calculateMinMax<float>();
-                break;
-
-            case TLONGLONG:
-                calculateMinMax<int64_t>();
-                break;
-
-            case TDOUBLE:
-                calculateMinMax<double>();
-                break;
-
-            default:
-                break;
-        }
-    }
-    else
-    {
-        m_ROIStatistics.min[0] = 1.0E30;
-        m_ROIStatistics.max[0] = -1.0E30;
-
-        m_ROIStatistics.min[1] = 1.0E30;
-        m_ROIStatistics.max[1] = -1.0E30;
-
-        m_ROIStatistics.min[2] = 1.0E30;
-        m_ROIStatistics.max[2] = -1.0E30;
-
-        switch (m_Statistics.dataType)
-        {
-            case TBYTE:
-                calculateMinMax<uint8_t>(roi);
-                break;
+        // Try to read min/max/median/mean/stddev from the header if in file,
+        // and compute whatever is left in a single pass over the image.
+        const bool haveMinMax = !refresh && readMinMaxFromHeader();
+        const bool haveMedian = !refresh && readMedianFromHeader();
+        const bool haveMeanStdDev = !refresh && readMeanStdDevFromHeader();
 
-            case TSHORT:
-                calculateMinMax<int16_t>(roi);
-                break;
-
-            case TUSHORT:
-                calculateMinMax<uint16_t>(roi);
-                break;
-
-            case TLONG:
-                calculateMinMax<int32_t>(roi);
-                break;
-
-            case TULONG:
-                calculateMinMax<uint32_t>(roi);
-                break;
-
-            case TFLOAT:
-                calculateMinMax<float>(roi);
-                break;
-
-            case TLONGLONG:
-                calculateMinMax<int64_t>(roi);
-                break;
-
-            case TDOUBLE:
-                calculateMinMax<double>(roi);
-                break;
+        if (!haveMinMax || !haveMedian || !haveMeanStdDev)
+            calculateStatistics(false, !haveMinMax, !haveMedian, !haveMeanStdDev);
+        else
+            m_ValueCountsValid = false;
 
-            default:
-                break;
-        }
+        // If all is OK, we're done
+        if (haveMeanStdDev)
+            return;
 
+        // FIXME That's not really SNR, must implement a proper solution for this value
+        m_Statistics.SNR = m_Statistics.mean[0] / m_Statistics.stddev[0];
     }
+    else
+        calculateStatistics(true, true, true, true);
 }
 
-void FITSData::calculateMedian(bool refresh, bool roi)
+bool FITSData::readMinMaxFromHeader()
 {
-    if(!roi)
-    {
-        int status, nfound = 0;
+    // Only fetch from header if we have a single channel
+    // Otherwise, calculate manually.
+    if (fptr == nullptr)
+        return false;
 
-        status = 0;
+    int status = 0, nfound = 0;
 
-        // Only fetch from header if we have a single channel
-        // Otherwise, calculate manually.
-        if (fptr != nullptr && !refresh)
-        {
-            status = 0;
-            if (fits_read_key_dbl(fptr, "MEDIAN1", &m_Statistics.median[0], nullptr, &status) == 0)
-                nfound++;
+    if (fits_read_key_dbl(fptr, "DATAMIN", &(m_Statistics.min[0]), nullptr, &status) == 0)
+        nfound++;
+    else if (fits_read_key_dbl(fptr, "MIN1", &(m_Statistics.min[0]), nullptr, &status) == 0)
+        nfound++;
 
-            // NB. These could fail if missing, which is OK.
-            fits_read_key_dbl(fptr, "MEDIAN2", &m_Statistics.median[1], nullptr, &status);
-            fits_read_key_dbl(fptr, "MEDIAN3", &m_Statistics.median[2], nullptr, &status);
+    // NB. These could fail if missing, which is OK.
+    fits_read_key_dbl(fptr, "MIN2", &m_Statistics.min[1], nullptr, &status);
+    fits_read_key_dbl(fptr, "MIN3", &m_Statistics.min[2], nullptr, &status);
 
-            if (nfound == 1)
-                return;
-        }
+    status = 0;
 
-        m_Statistics.median[RED_CHANNEL] = 0;
-        m_Statistics.median[GREEN_CHANNEL] = 0;
-        m_Statistics.median[BLUE_CHANNEL] = 0;
+    if (fits_read_key_dbl(fptr, "DATAMAX", &(m_Statistics.max[0]), nullptr, &status) == 0)
+        nfound++;
+    else if (fits_read_key_dbl(fptr, "MAX1", &(m_Statistics.max[0]), nullptr, &status) == 0)
+        nfound++;
 
-        switch (m_Statistics.dataType)
-        {
-            case TBYTE:
-                calculateMedian<uint8_t>();
-                break;
+    // NB. These could fail if missing, which is OK.
+    fits_read_key_dbl(fptr, "MAX2", &m_Statistics.max[1], nullptr, &status);
+    fits_read_key_dbl(fptr, "MAX3", &m_Statistics.max[2], nullptr, &status);
 
-            case TSHORT:
-                calculateMedian<int16_t>();
-                break;
+    // If we found both keywords, no need to calculate them, unless they are both zeros
+    return (nfound == 2 && !(m_Statistics.min[0] == 0 && m_Statistics.max[0] == 0));
+}
 
-            case TUSHORT:
-                calculateMedian<uint16_t>();
-                break;
+bool FITSData::readMedianFromHeader()
+{
+    if (fptr == nullptr)
+        return false;
 
-            case TLONG:
-                calculateMedian<int32_t>();
-                break;
+    int status = 0, nfound = 0;
 
-            case TULONG:
-                calculateMedian<uint32_t>();
-                break;
+    if (fits_read_key_dbl(fptr, "MEDIAN1", &m_Statistics.median[0], nullptr, &status) == 0)
+        nfound++;
 
-            case TFLOAT:
-                calculateMedian<float>();
-                break;
+    // NB. These could fail if missing, which is OK.
+    fits_read_key_dbl(fptr, "MEDIAN2", &m_Statistics.median[1], nullptr, &status);
+    fits_read_key_dbl(fptr, "MEDIAN3", &m_Statistics.median[2], nullptr, &status);
 
-            case TLONGLONG:
-                calculateMedian<int64_t>();
-                break;
+    return (nfound == 1);
+}
 
-            case TDOUBLE:
-                calculateMedian<double>();
-                break;
+bool FITSData::readMeanStdDevFromHeader()
+{
+    if (fptr == nullptr)
+        return false;
 
-            default:
-                break;
-        }
-    }
-    else
-    {
-        m_ROIStatistics.median[RED_CHANNEL] = 0;
-        m_ROIStatistics.median[GREEN_CHANNEL] = 0;
-        m_ROIStatistics.median[BLUE_CHANNEL] = 0;
+    int status = 0, nfound = 0;
 
-        switch (m_ROIStatistics.dataType)
-        {
-            case TBYTE:
-                calculateMedian<uint8_t>(roi);
-                break;
+    if (fits_read_key_dbl(fptr, "MEAN1", &m_Statistics.mean[0], nullptr, &status) == 0)
+        nfound++;
+    // NB. These could fail if missing, which is OK.
+    fits_read_key_dbl(fptr, "MEAN2", & m_Statistics.mean[1], nullptr, &status);
+    fits_read_key_dbl(fptr, "MEAN3", &m_Statistics.mean[2], nullptr, &status);
 
-            case TSHORT:
-                calculateMedian<int16_t>(roi);
-                break;
+    status = 0;
+    if (fits_read_key_dbl(fptr, "STDDEV1", &m_Statistics.stddev[0], nullptr, &status) == 0)
+        nfound++;
+    // NB. These could fail if missing, which is OK.
+    fits_read_key_dbl(fptr, "STDDEV2", &m_Statistics.stddev[1], nullptr, &status);
+    fits_read_key_dbl(fptr, "STDDEV3", &m_Statistics.stddev[2], nullptr, &status);
 
-            case TUSHORT:
-                calculateMedian<uint16_t>(roi);
-                break;
+    return (nfound == 2);
+}
 
-            case TLONG:
-                calculateMedian<int32_t>(roi);
-                break;
+void FITSData::calculateStatistics(bool roi, bool minMax, bool median, bool meanStdDev)
+{
+    switch (roi ? m_ROIStatistics.dataType : m_Statistics.dataType)
+    {
+        case TBYTE:
+            calculateStatistics<uint8_t>(roi, minMax, median, meanStdDev);
+            break;
 
-            case TULONG:
-                calculateMedian<uint32_t>(roi);
-                break;
+        case TSHORT:
+            calculateStatistics<int16_t>(roi, minMax, median, meanStdDev);
+            break;
 
-            case TFLOAT:
-                calculateMedian<float>(roi);
-                break;
+        case TUSHORT:
+            calculateStatistics<uint16_t>(roi, minMax, median, meanStdDev);
+            break;
 
-            case TLONGLONG:
-                calculateMedian<int64_t>(roi);
-                break;
+        case TLONG:
+            calculateStatistics<int32_t>(roi, minMax, median, meanStdDev);
+            break;
 
-            case TDOUBLE:
-                calculateMedian<double>(roi);
-                break;
+        case TULONG:
+            calculateStatistics<uint32_t>(roi, minMax, median, meanStdDev);
+            break;
 
-            default:
-                break;
-        }
+        case TFLOAT:
+            calculateStatistics<float>(roi, minMax, median, meanStdDev);
+            break;
+
+        case TLONGLONG:
+            calculateStatistics<int64_t>(roi, minMax, median, meanStdDev);
+            break;
 
+        case TDOUBLE:
+            calculateStatistics<double>(roi, minMax, median, meanStdDev);
+            break;
+
+        default:
+            break;
     }
 }
 
@@ -1581,6 +1637,20 @@ template <typename T>
 void FITSData::calculateMedian(bool roi)
 {
     auto * buffer = reinterpret_cast<T *>(roi ? m_ImageRoiBuffer : m_ImageBuffer);
+
+    // Integer images don't need a sorted copy, a histogram of all the samples is cheaper and bounded in error.
+    if constexpr (std::is_integral<T>::value)
+    {
+        const uint32_t channelSize = roi ? m_ROIStatistics.samples_per_channel : m_Statistics.samples_per_channel;
+        for (uint8_t n = 0; n < m_Statistics.channels; n++)
+        {
+            auto const median = Mathematics::RobustStatistics::ComputeHistogramStatistics(buffer + n * channelSize,
+                                channelSize).median;
+            roi ? m_ROIStatistics.median[n] = median : m_Statistics.median[n] = median;
+        }
+        return;
+    }
+
     const uint32_t maxMedianSize = 500000;
     uint32_t medianSize = roi ? m_ROIStatistics.samples_per_channel : m_Statistics.samples_per_channel;
     uint8_t downsample = 1;
@@ -1598,6 +1668,7 @@ void FITSData::calculateMedian(bool roi)
 
     for (uint8_t n = 0; n < m_Statistics.channels; n++)
     {
+        samples.clear();
         auto *oneChannel = buffer + n * (roi ? m_ROIStatistics.samples_per_channel : m_Statistics.samples_per_channel);
         for (uint32_t upto = 0; upto < (roi ? m_ROIStatistics.samples_per_channel : m_Statistics.samples_per_channel);
                 upto += downsample)
@@ -1607,170 +1678,215 @@ void FITSData::calculateMedian(bool roi)
     }
 }
 
+namespace
+{
+// 8 and 16 bit samples are small enough to be counted per value. This gives us the exact median
+// and the histogram without any further pass over the image buffer.
 template <typename T>
-QPair<T, T> FITSData::getParitionMinMax(uint32_t start, uint32_t stride, bool roi)
+constexpr bool isCountable()
 {
-    auto * buffer = reinterpret_cast<T *>(roi ? m_ImageRoiBuffer : m_ImageBuffer);
-    T min = std::numeric_limits<T>::max();
-    T max = std::numeric_limits<T>::min();
-
-    uint32_t end = start + stride;
+    return std::is_integral<T>::value && sizeof(T) <= 2;
+}
 
-    for (uint32_t i = start; i < end; i++)
-    {
-        min = qMin(buffer[i], min);
-        max = qMax(buffer[i], max);
-        //        if (buffer[i] < min)
-        //            min = buffer[i];
-        //        else if (buffer[i] > max)
-        //            max = buffer[i];
-    }
+// Sums of 8 and 16 bit samples are accumulated in integers, which is exact and can be vectorized.
+template <typename T>
+using SampleSum = typename std::conditional<isCountable<T>(), int64_t, double>::type;
+template <typename T>
+using SampleSquaredSum = typename std::conditional<isCountable<T>(), uint64_t, double>::type;
 
-    return qMakePair(min, max);
-}
+// This struct is used when returning results from the threaded getPartitionStatistics calculations
+// used to compute the minimum, maximum, mean and variance of the image in a single pass.
+template <typename T>
+struct PartitionStatistics
+{
+    T min { std::numeric_limits<T>::max() };
+    T max { std::numeric_limits<T>::lowest() };
+    SampleSum<T> sum { 0 };
+    SampleSquaredSum<T> squaredSum { 0 };
+    uint32_t numSamples { 0 };
+    QVector<uint32_t> valueCounts;
+};
 
 template <typename T>
-void FITSData::calculateMinMax(bool roi)
+PartitionStatistics<T> getPartitionStatistics(const T *buffer, uint32_t start, uint32_t stride, float *floats)
 {
-    T min = std::numeric_limits<T>::max();
-    T max = std::numeric_limits<T>::min();
+    // Process the partition in blocks small enough to stay in L1 cache, so the vectorizable
+    // min/max/sum loop and the scalar counting loop share a single read from memory.
+    constexpr uint32_t blockSize = 4096;
 
+    PartitionStatistics<T> result;
+    if constexpr (isCountable<T>())
+        result.valueCounts.fill(0, 1 << (8 * sizeof(T)));
 
-    // Create N threads
-    const uint8_t nThreads = 16;
+    T min = result.min, max = result.max;
+    SampleSum<T> sum = 0;
+    SampleSquaredSum<T> squaredSum = 0;
 
-    for (int n = 0; n < m_Statistics.channels; n++)
+    const T * const data = buffer + start;
+    for (uint32_t blockStart = 0; blockStart < stride; blockStart += blockSize)
     {
-        uint32_t cStart = n * (roi ? m_ROIStatistics.samples_per_channel : m_Statistics.samples_per_channel);
-
-        // Calculate how many elements we process per thread
-        uint32_t tStride = (roi ? m_ROIStatistics.samples_per_channel : m_Statistics.samples_per_channel) / nThreads;
-
-        // Calculate the final stride since we can have some left over due to division above
-        uint32_t fStride = tStride + ((roi ? m_ROIStatistics.samples_per_channel : m_Statistics.samples_per_channel) -
-                                      (tStride * nThreads));
-
-        // Start location for inspecting elements
-        uint32_t tStart = cStart;
+        const uint32_t blockEnd = qMin(stride, blockStart + blockSize);
 
-        // List of futures
-        QList<QFuture<QPair<T, T>>> futures;
-
-        for (int i = 0; i < nThreads; i++)
+        for (uint32_t i = blockStart; i < blockEnd; i++)
         {
-            // Run threads
-            futures.append(QtConcurrent::run(this, &FITSData::getParitionMinMax<T>, tStart, (i == (nThreads - 1)) ? fStride : tStride,
-                                             roi));
-            tStart += tStride;
+            const T sample = data[i];
+            min = qMin(sample, min);
+            max = qMax(sample, max);
+            sum += sample;
+            squaredSum += static_cast<SampleSquaredSum<T>>(sample) * sample;
         }
 
-        // Now wait for results
-        for (int i = 0; i < nThreads; i++)
-        {
-            QPair<T, T> result = futures[i].result();
-            min = qMin(result.first, min);
-            max = qMax(result.second, max);
-        }
+        // Fill the float buffer while the block is still in cache.
+        if (floats != nullptr)
+            std::copy(data + blockStart, data + blockEnd, floats + start + blockStart);
 
-        if(!roi)
-        {
-            m_Statistics.min[n] = min;
-            m_Statistics.max[n] = max;
-        }
-        else
+        if constexpr (isCountable<T>())
         {
-            m_ROIStatistics.min[n] = min;
-            m_ROIStatistics.max[n] = max;
+            uint32_t * const counts = result.valueCounts.data();
+            for (uint32_t i = blockStart; i < blockEnd; i++)
+                counts[static_cast<int32_t>(data[i]) - std::numeric_limits<T>::min()]++;
         }
     }
 
+    result.min = min;
+    result.max = max;
+    result.sum = sum;
+    result.squaredSum = squaredSum;
+    result.numSamples = stride;
+    return result;
 }
 
-// This struct is used when returning results from the threaded getSumAndSquaredSum calculations
-// used to compute the mean and variance of the image.
-struct SumData
+// Median of the samples described by the exact value counts. For an even number of samples, the
+// two middle values are averaged like the sort based median does.
+double medianFromValueCounts(const QVector<uint32_t> &counts, int32_t firstValue, uint64_t numSamples)
 {
-    double sum;
-    double squaredSum;
-    double numSamples;
-    SumData(double s, double sq, int n) : sum(s), squaredSum(sq), numSamples(n) {}
-    SumData() : sum(0), squaredSum(0), numSamples(0) {}
-};
+    if (numSamples == 0)
+        return 0;
 
-template <typename T>
-SumData getSumAndSquaredSum(uint32_t start, uint32_t stride, uint8_t *buff)
-{
-    auto * buffer = reinterpret_cast<T *>(buff);
-    const uint32_t end = start + stride;
-    double sum = 0;
-    double squaredSum = 0;
-    for (uint32_t i = start; i < end; i++)
+    const uint64_t lowerRank = (numSamples - 1) / 2, upperRank = numSamples / 2;
+    double lowerValue = 0;
+    uint64_t accumulator = 0;
+    for (int i = 0; i < counts.size(); i++)
     {
-        double sample = buffer[i];
-        sum += sample;
-        squaredSum += sample * sample;
+        if (counts[i] == 0)
+            continue;
+
+        // Is the lower middle sample in this bin?
+        if (accumulator <= lowerRank && lowerRank < accumulator + counts[i])
+            lowerValue = i + firstValue;
+        accumulator += counts[i];
+        if (accumulator > upperRank)
+            return (lowerValue + i + firstValue) / 2.0;
     }
-    const double numSamples = end - start;
-    return SumData(sum, squaredSum, numSamples);
+    return lowerValue;
+}
 }
 
 template <typename T>
-void FITSData::calculateStdDev(bool roi )
+void FITSData::calculateStatistics(bool roi, bool minMax, bool median, bool meanStdDev)
 {
-    // Create N threads
-    const uint8_t nThreads = 16;
+    FITSImage::Statistic &stats = roi ? m_ROIStatistics : m_Statistics;
+    auto * const buffer = reinterpret_cast<T const *>(roi ? m_ImageRoiBuffer : m_ImageBuffer);
+    const uint32_t samples = stats.samples_per_channel;
 
-    for (int n = 0; n < m_Statistics.channels; n++)
-    {
-        uint32_t cStart = n * (roi ? m_ROIStatistics.samples_per_channel : m_Statistics.samples_per_channel);
+    // Split each channel in up to 16 partitions, but don't bother with partitions smaller than 64K samples
+    // since each one carries its own value counts.
+    const uint32_t nThreads = qBound<uint32_t>(1, samples / 65536, 16);
+
+    // Calculate how many elements we process per thread
+    const uint32_t tStride = samples / nThreads;
 
-        // Calculate how many elements we process per thread
-        uint32_t tStride = (roi ? m_ROIStatistics.samples_per_channel : m_Statistics.samples_per_channel) / nThreads;
+    // Calculate the final stride since we can have some left over due to division above
+    const uint32_t fStride = tStride + (samples - (tStride * nThreads));
 
-        // Calculate the final stride since we can have some left over due to division above
-        uint32_t fStride = tStride + ((roi ? m_ROIStatistics.samples_per_channel : m_Statistics.samples_per_channel) -
-                                      (tStride * nThreads));
+    if (!roi)
+        m_ValueCountsValid = false;
+
+    // Optionally fill the float buffer of the whole image in the same pass.
+    QSharedPointer<QVector<float>> floats;
+    uint32_t generation = 0;
+    if (!roi && m_FloatBufferWithStatistics)
+    {
+        QMutexLocker locker(&m_FloatBufferMutex);
+        generation = m_BufferGeneration;
+        if (!m_FullFloatBuffer.samples || m_FullFloatBuffer.generation != generation)
+            floats.reset(new QVector<float>(samples * m_Statistics.channels));
+    }
 
+    for (int n = 0; n < m_Statistics.channels; n++)
+    {
         // Start location for inspecting elements
-        uint32_t tStart = cStart;
+        uint32_t tStart = n * samples;
 
         // List of futures
-        QList<QFuture<SumData>> futures;
+        QList<QFuture<PartitionStatistics<T>>> futures;
 
-        for (int i = 0; i < nThreads; i++)
+        for (uint32_t i = 0; i < nThreads; i++)
         {
             // Run threads
-            uint8_t *buff = roi ? m_ImageRoiBuffer : m_ImageBuffer;
-            futures.append(QtConcurrent::run(&getSumAndSquaredSum<T>, tStart,
-                                             (i == (nThreads - 1)) ? fStride : tStride, buff));
+            futures.append(Executors::run(executorPriority(), &getPartitionStatistics<T>, buffer, tStart, (i == (nThreads - 1)) ? fStride : tStride,
+                                          floats ? floats->data() : nullptr));
             tStart += tStride;
         }
 
         // Now wait for results
-        double sum = 0, squared_sum = 0;
-        double numSamples = 0;
-        for (int i = 0; i < nThreads; i++)
+        PartitionStatistics<T> total = futures[0].result();
+        for (uint32_t i = 1; i < nThreads; i++)
         {
-            const SumData result = futures[i].result();
-            sum += result.sum;
-            squared_sum += result.squaredSum;
-            numSamples += result.numSamples;
+            const PartitionStatistics<T> result = futures[i].result();
+            total.min = qMin(result.min, total.min);
+            total.max = qMax(result.max, total.max);
+            total.sum += result.sum;
+            total.squaredSum += result.squaredSum;
+            total.numSamples += result.numSamples;
+            for (int j = 0; j < total.valueCounts.size(); j++)
+                total.valueCounts[j] += result.valueCounts[j];
+        }
 
+        if (minMax)
+        {
+            stats.min[n] = total.min;
+            stats.max[n] = total.max;
         }
-        if (numSamples <= 0) continue;
-        const double mean = sum / numSamples;
-        const double variance = squared_sum / numSamples - mean * mean;
-        if(!roi)
+
+        if (meanStdDev && total.numSamples > 0)
         {
-            m_Statistics.mean[n]   = mean;
-            m_Statistics.stddev[n] = sqrt(variance);
+            const double mean = static_cast<double>(total.sum) / total.numSamples;
+            const double variance = static_cast<double>(total.squaredSum) / total.numSamples - mean * mean;
+            stats.mean[n]   = mean;
+            stats.stddev[n] = sqrt(variance);
         }
-        else
+
+        if constexpr (isCountable<T>())
         {
-            m_ROIStatistics.mean[n] = mean;
-            m_ROIStatistics.stddev[n] = sqrt(variance);
+            if (median)
+                stats.median[n] = medianFromValueCounts(total.valueCounts, std::numeric_limits<T>::min(), total.numSamples);
+
+            // Keep the counts of the full image around for the histogram
+            if (!roi)
+                m_ValueCounts[n] = std::move(total.valueCounts);
         }
     }
+
+    if constexpr (isCountable<T>())
+    {
+        if (!roi)
+            m_ValueCountsValid = true;
+    }
+    else if (median)
+    {
+        stats.median[RED_CHANNEL] = 0;
+        stats.median[GREEN_CHANNEL] = 0;
+        stats.median[BLUE_CHANNEL] = 0;
+        calculateMedian<T>(roi);
+    }
+
+    if (floats)
+    {
+        QMutexLocker locker(&m_FloatBufferMutex);
+        if (generation == m_BufferGeneration)
+            m_FullFloatBuffer = { QRect(0, 0, m_Statistics.width, m_Statistics.height), generation, floats };
+    }
 }
 
 QVector<double> FITSData::createGaussianKernel(int size, double sigma)
@@ -1807,6 +1923,7 @@ template <typename T>
 void FITSData::convolutionFilter(const QVector<double> &kernel, int kernelSize)
 {
     T * imagePtr = reinterpret_cast<T *>(m_ImageBuffer);
+    invalidateFloatBuffers();
 
     // Create variable for pixel data for each kernel
     T gt = 0;
@@ -1878,7 +1995,7 @@ bool FITSData::parseHeader()
     char * header = nullptr;
     int status = 0, nkeys = 0;
 
-    if (fits_hdr2str(fptr, 0, nullptr, 0, &header, &nkeys, &status))
+    if (imageHeaderToString(fptr, 0, &header, &nkeys, &status))
     {
         fits_report_error(stderr, status);
         free(header);
@@ -2053,8 +2170,8 @@ QFuture<bool> FITSData::findStars(StarAlgorithm algorithm, const QRect &tracking
         m_StarFindFuture.waitForFinished();
 
     starAlgorithm = algorithm;
-    qDeleteAll(starCenters);
-    starCenters.clear();
+    FITSFramePool::instance().giveEdges(starCenters);
+    m_StarStatistics.reset();
     starsSearched = true;
 
     switch (algorithm)
@@ -2132,21 +2249,50 @@ int FITSData::filterStars(QSharedPointer<ImageMask> mask)
 {
     if (mask.isNull() == false)
     {
-        starCenters.erase(std::remove_if(starCenters.begin(), starCenters.end(),
-                                         [&](Edge * edge)
+        auto hidden = std::stable_partition(starCenters.begin(), starCenters.end(), [&](Edge * edge)
         {
-            return (mask->isVisible(edge->x, edge->y) == false);
-        }), starCenters.end());
+            return mask->isVisible(edge->x, edge->y);
+        });
+        QList<Edge *> removed;
+        std::copy(hidden, starCenters.end(), std::back_inserter(removed));
+        starCenters.erase(hidden, starCenters.end());
+        FITSFramePool::instance().giveEdges(removed);
     }
 
     return starCenters.count();
 
 }
 
+QFuture<bool> FITSData::findStars(const QList<Edge> &seeds, const QRect &trackingBox)
+{
+    if (seeds.isEmpty())
+        return findStars(ALGORITHM_SEP, trackingBox);
+
+    if (m_StarFindFuture.isRunning())
+        m_StarFindFuture.waitForFinished();
+
+    starAlgorithm = ALGORITHM_SEP;
+    FITSFramePool::instance().giveEdges(starCenters);
+    m_StarStatistics.reset();
+    starsSearched = true;
+
+    auto detector = new FITSIncrementalDetector(this);
+    detector->setSettings(m_SourceExtractorSettings);
+    detector->setSeeds(seeds);
+    m_StarDetector.reset(detector);
+    m_StarFindFuture = m_StarDetector->findSources(trackingBox);
+    return m_StarFindFuture;
+}
+
 double FITSData::getHFR(HFRType type)
 {
     if (starCenters.empty())
+    {
+        // Without a star list only the median and the maximum are known
+        if (m_StarStatistics.count() > 0)
+            return type == HFR_MAX ? m_StarStatistics.maxHFR() : m_StarStatistics.medianHFR();
         return -1;
+    }
 
     if (cacheHFR >= 0 && cacheHFRType == type)
         return cacheHFR;
@@ -2179,10 +2325,14 @@ double FITSData::getHFR(HFRType type)
         int minY = height() / 10;
         int maxX = width() - minX;
         int maxY = height() - minY;
-        starCenters.erase(std::remove_if(starCenters.begin(), starCenters.end(), [minX, minY, maxX, maxY](Edge * oneStar)
+        auto border = std::stable_partition(starCenters.begin(), starCenters.end(), [minX, minY, maxX, maxY](Edge * oneStar)
         {
-            return (oneStar->x < minX || oneStar->x > maxX || oneStar->y < minY || oneStar->y > maxY);
-        }), starCenters.end());
+            return !(oneStar->x < minX || oneStar->x > maxX || oneStar->y < minY || oneStar->y > maxY);
+        });
+        QList<Edge *> removed;
+        std::copy(border, starCenters.end(), std::back_inserter(removed));
+        starCenters.erase(border, starCenters.end());
+        FITSFramePool::instance().giveEdges(removed);
         // Top 5%
         if (starCenters.empty())
             return -1;
@@ -2275,7 +2425,7 @@ double FITSData::getHFR(int x, int y, double scale)
 double FITSData::getEccentricity()
 {
     if (starCenters.empty())
-        return -1;
+        return m_StarStatistics.eccentricity();
     if (cacheEccentricity >= 0)
         return cacheEccentricity;
     std::vector<float> eccs;
@@ -2459,6 +2609,8 @@ void FITSData::applyFilter(FITSScale type, uint8_t * targetImage, QVector<double
     {
         image     = reinterpret_cast<T *>(m_ImageBuffer);
         calcStats = true;
+        m_ValueCountsValid = false;
+        invalidateFloatBuffers();
     }
 
     T min[3], max[3];
@@ -2522,7 +2674,7 @@ void FITSData::applyFilter(FITSScale type, uint8_t * targetImage, QVector<double
                     for (int i = 0; i < nThreads; i++)
                     {
                         // Run threads
-                        futures.append(QtConcurrent::map(runningBuffer, (runningBuffer + ((i == (nThreads - 1)) ? fStride : tStride)), [min, max,
+                        futures.append(Executors::map(executorPriority(), runningBuffer, (runningBuffer + ((i == (nThreads - 1)) ? fStride : tStride)), [min, max,
                                                               coeff, n](T & a)
                         {
                             a = qBound(min[n], static_cast<T>(round(coeff[n] * std::log(1 + qBound(min[n], a, max[n])))), max[n]);
@@ -2536,7 +2688,7 @@ void FITSData::applyFilter(FITSScale type, uint8_t * targetImage, QVector<double
                     for (int i = 0; i < nThreads; i++)
                     {
                         // Run threads
-                        futures.append(QtConcurrent::map(runningBuffer, (runningBuffer + ((i == (nThreads - 1)) ? fStride : tStride)), [min, max,
+                        futures.append(Executors::map(executorPriority(), runningBuffer, (runningBuffer + ((i == (nThreads - 1)) ? fStride : tStride)), [min, max,
                                                               coeff, n](T & a)
                         {
                             a = qBound(min[n], static_cast<T>(round(coeff[n] * a)), max[n]);
@@ -2550,7 +2702,7 @@ void FITSData::applyFilter(FITSScale type, uint8_t * targetImage, QVector<double
                     for (int i = 0; i < nThreads; i++)
                     {
                         // Run threads
-                        futures.append(QtConcurrent::map(runningBuffer, (runningBuffer + ((i == (nThreads - 1)) ? fStride : tStride)), [min, max,
+                        futures.append(Executors::map(executorPriority(), runningBuffer, (runningBuffer + ((i == (nThreads - 1)) ? fStride : tStride)), [min, max,
                                                               n](T & a)
                         {
                             a = qBound(min[n], a, max[n]);
@@ -2570,7 +2722,7 @@ void FITSData::applyFilter(FITSScale type, uint8_t * targetImage, QVector<double
                     m_Statistics.min[i] = min[i];
                     m_Statistics.max[i] = max[i];
                 }
-                calculateStdDev<T>();
+                calculateStatistics<T>(false, false, false, true);
             }
         }
         break;
@@ -2674,7 +2826,7 @@ void FITSData::applyFilter(FITSScale type, uint8_t * targetImage, QVector<double
             delete[] extension;
 
             if (calcStats)
-                calculateStdDev<T>();
+                calculateStatistics<T>(false, false, false, true);
         }
         break;
 
@@ -2740,6 +2892,7 @@ bool FITSData::loadWCS()
         m_nwcs = 0;
         m_WCSHandle = nullptr;
     }
+    m_TANProjection.valid = false;
 
     qCDebug(KSTARS_FITS) << "Started WCS Data Processing...";
 
@@ -2749,7 +2902,7 @@ bool FITSData::loadWCS()
     if (fptr)
     {
         char *header = nullptr;
-        if (fits_hdr2str(fptr, 1, nullptr, 0, &header, &nkeyrec, &status))
+        if (imageHeaderToString(fptr, 1, &header, &nkeyrec, &status))
         {
             char errmsg[512];
             fits_get_errstatus(status, errmsg);
@@ -2816,6 +2969,22 @@ bool FITSData::loadWCS()
         return false;
     }
 
+    // Without distortion, a TAN projection is quicker to compute in place than through wcslib
+    m_TANProjection.valid = m_WCSHandle->naxis == 2 && m_WCSHandle->lng == 0 && m_WCSHandle->lat == 1 &&
+                            strncmp(m_WCSHandle->cel.prj.code, "TAN", 3) == 0 &&
+                            m_WCSHandle->lin.dispre == nullptr && m_WCSHandle->lin.disseq == nullptr &&
+                            std::fabs(m_WCSHandle->cel.ref[2] - 180.0) < 1e-9;
+    if (m_TANProjection.valid)
+    {
+        m_TANProjection.crpix[0] = m_WCSHandle->crpix[0];
+        m_TANProjection.crpix[1] = m_WCSHandle->crpix[1];
+        m_TANProjection.ra0 = m_WCSHandle->crval[0] * M_PI / 180.0;
+        m_TANProjection.sinDec0 = std::sin(m_WCSHandle->crval[1] * M_PI / 180.0);
+        m_TANProjection.cosDec0 = std::cos(m_WCSHandle->crval[1] * M_PI / 180.0);
+        std::copy(m_WCSHandle->lin.piximg, m_WCSHandle->lin.piximg + 4, m_TANProjection.pixToImg);
+        std::copy(m_WCSHandle->lin.imgpix, m_WCSHandle->lin.imgpix + 4, m_TANProjection.imgToPix);
+    }
+
     m_ObjectsSearched = false;
     m_WCSState = Success;
     HasWCS = true;
@@ -2871,29 +3040,205 @@ bool FITSData::pixelToWCS(const QPointF &wcsPixelPoint, SkyPoint &wcsCoord)
     double imgcrd[NWCSFIX], phi, pixcrd[NWCSFIX], theta, world[NWCSFIX];
 
     if (m_WCSHandle == nullptr)
-    {
-        m_LastError = i18n("No world coordinate systems found.");
+    {
+        m_LastError = i18n("No world coordinate systems found.");
+        return false;
+    }
+
+    pixcrd[0] = wcsPixelPoint.x();
+    pixcrd[1] = wcsPixelPoint.y();
+
+    if ((status = wcsp2s(m_WCSHandle, 1, 2, pixcrd, imgcrd, &phi, &theta, world, stat)) != 0)
+    {
+        m_LastError = QString("wcsp2s error %1: %2.").arg(status).arg(wcs_errmsg[status]);
+        return false;
+    }
+    else
+    {
+        wcsCoord.setRA0(world[0] / 15.0);
+        wcsCoord.setDec0(world[1]);
+    }
+
+    return true;
+#else
+    Q_UNUSED(wcsPixelPoint);
+    Q_UNUSED(wcsCoord);
+    return false;
+#endif
+}
+
+#if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
+namespace
+{
+// Points converted by each task of a parallel batch conversion
+constexpr int WCS_BATCH_CHUNK = 4096;
+
+// Calls convert(begin, end) over [0, count), in chunks spread over the pool of priority for large counts
+template <typename F>
+void convertInChunks(Executors::Priority priority, int count, const F &convert)
+{
+    if (count <= WCS_BATCH_CHUNK)
+    {
+        convert(0, count);
+        return;
+    }
+
+    std::vector<int> chunks((count + WCS_BATCH_CHUNK - 1) / WCS_BATCH_CHUNK);
+    std::iota(chunks.begin(), chunks.end(), 0);
+    Executors::blockingMap(priority, chunks, [&](int chunk)
+    {
+        convert(chunk * WCS_BATCH_CHUNK, std::min(count, (chunk + 1) * WCS_BATCH_CHUNK));
+    });
+}
+
+double normalizedRA(double ra)
+{
+    ra = std::fmod(ra, 360.0);
+    return ra < 0 ? ra + 360.0 : ra;
+}
+}
+#endif
+
+bool FITSData::wcsToPixels(const QVector<QPointF> &world, QVector<QPointF> &pixels, QVector<bool> &valid) const
+{
+#if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
+    if (m_WCSHandle == nullptr)
+        return false;
+
+    const int count = world.size();
+    pixels.resize(count);
+    valid.resize(count);
+    if (count == 0)
+        return true;
+
+    QPointF *pixel = pixels.data();
+    bool *converted = valid.data();
+    if (m_TANProjection.valid)
+    {
+        const TANProjection &tan = m_TANProjection;
+        convertInChunks(executorPriority(), count, [&](int begin, int end)
+        {
+            for (int i = begin; i < end; i++)
+            {
+                const double dRA = world[i].x() * M_PI / 180.0 - tan.ra0;
+                const double sinDec = std::sin(world[i].y() * M_PI / 180.0);
+                const double cosDec = std::cos(world[i].y() * M_PI / 180.0);
+                const double cosDRA = std::cos(dRA);
+                // The far hemisphere has no projection
+                const double cosDistance = tan.sinDec0 * sinDec + tan.cosDec0 * cosDec * cosDRA;
+                if (cosDistance <= 0)
+                {
+                    pixel[i] = QPointF();
+                    converted[i] = false;
+                    continue;
+                }
+
+                // Intermediate coordinates, in degrees
+                const double x = cosDec * std::sin(dRA) / cosDistance * 180.0 / M_PI;
+                const double y = (tan.cosDec0 * sinDec - tan.sinDec0 * cosDec * cosDRA) / cosDistance * 180.0 / M_PI;
+                pixel[i] = QPointF(tan.imgToPix[0] * x + tan.imgToPix[1] * y + tan.crpix[0],
+                                   tan.imgToPix[2] * x + tan.imgToPix[3] * y + tan.crpix[1]);
+                converted[i] = true;
+            }
+        });
+        return true;
+    }
+
+    // wcslib converts all of the points in a single call
+    std::vector<double> worldcrd(2 * count), imgcrd(2 * count), pixcrd(2 * count), phi(count), theta(count);
+    std::vector<int> stat(count);
+    for (int i = 0; i < count; i++)
+    {
+        worldcrd[2 * i] = world[i].x();
+        worldcrd[2 * i + 1] = world[i].y();
+    }
+
+    // Only some of the points are invalid if the status is WCSERR_BAD_WORLD
+    const int status = wcss2p(m_WCSHandle, count, 2, worldcrd.data(), phi.data(), theta.data(), imgcrd.data(),
+                              pixcrd.data(), stat.data());
+    if (status != 0 && status != WCSERR_BAD_WORLD)
+    {
+        valid.fill(false);
+        return false;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        converted[i] = stat[i] == 0;
+        pixel[i] = converted[i] ? QPointF(pixcrd[2 * i], pixcrd[2 * i + 1]) : QPointF();
+    }
+    return true;
+#else
+    Q_UNUSED(world);
+    Q_UNUSED(pixels);
+    Q_UNUSED(valid);
+    return false;
+#endif
+}
+
+bool FITSData::pixelsToWCS(const QVector<QPointF> &pixels, QVector<QPointF> &world, QVector<bool> &valid) const
+{
+#if !defined(KSTARS_LITE) && defined(HAVE_WCSLIB)
+    if (m_WCSHandle == nullptr)
         return false;
+
+    const int count = pixels.size();
+    world.resize(count);
+    valid.resize(count);
+    if (count == 0)
+        return true;
+
+    QPointF *coord = world.data();
+    bool *converted = valid.data();
+    if (m_TANProjection.valid)
+    {
+        const TANProjection &tan = m_TANProjection;
+        convertInChunks(executorPriority(), count, [&](int begin, int end)
+        {
+            for (int i = begin; i < end; i++)
+            {
+                const double dx = pixels[i].x() - tan.crpix[0];
+                const double dy = pixels[i].y() - tan.crpix[1];
+                // Intermediate coordinates, in radians
+                const double x = (tan.pixToImg[0] * dx + tan.pixToImg[1] * dy) * M_PI / 180.0;
+                const double y = (tan.pixToImg[2] * dx + tan.pixToImg[3] * dy) * M_PI / 180.0;
+                const double denominator = tan.cosDec0 - y * tan.sinDec0;
+                const double ra = tan.ra0 + std::atan2(x, denominator);
+                const double dec = std::atan2(tan.sinDec0 + y * tan.cosDec0, std::hypot(x, denominator));
+                coord[i] = QPointF(normalizedRA(ra * 180.0 / M_PI), dec * 180.0 / M_PI);
+                converted[i] = true;
+            }
+        });
+        return true;
     }
 
-    pixcrd[0] = wcsPixelPoint.x();
-    pixcrd[1] = wcsPixelPoint.y();
+    std::vector<double> pixcrd(2 * count), imgcrd(2 * count), worldcrd(2 * count), phi(count), theta(count);
+    std::vector<int> stat(count);
+    for (int i = 0; i < count; i++)
+    {
+        pixcrd[2 * i] = pixels[i].x();
+        pixcrd[2 * i + 1] = pixels[i].y();
+    }
 
-    if ((status = wcsp2s(m_WCSHandle, 1, 2, pixcrd, imgcrd, &phi, &theta, world, stat)) != 0)
+    // Only some of the points are invalid if the status is WCSERR_BAD_PIX
+    const int status = wcsp2s(m_WCSHandle, count, 2, pixcrd.data(), imgcrd.data(), phi.data(), theta.data(),
+                              worldcrd.data(), stat.data());
+    if (status != 0 && status != WCSERR_BAD_PIX)
     {
-        m_LastError = QString("wcsp2s error %1: %2.").arg(status).arg(wcs_errmsg[status]);
+        valid.fill(false);
         return false;
     }
-    else
+
+    for (int i = 0; i < count; i++)
     {
-        wcsCoord.setRA0(world[0] / 15.0);
-        wcsCoord.setDec0(world[1]);
+        converted[i] = stat[i] == 0;
+        coord[i] = converted[i] ? QPointF(normalizedRA(worldcrd[2 * i]), worldcrd[2 * i + 1]) : QPointF();
     }
-
     return true;
 #else
-    Q_UNUSED(wcsPixelPoint);
-    Q_UNUSED(wcsCoord);
+    Q_UNUSED(pixels);
+    Q_UNUSED(world);
+    Q_UNUSED(valid);
     return false;
 #endif
 }
@@ -2928,34 +3273,32 @@ bool FITSData::findWCSBounds(double &minRA, double &maxRA, double &minDec, doubl
     maxDec = -1000;
     minDec = 1000;
 
-    auto updateMinMax = [&](int x, int y)
-    {
-        int stat[2];
-        double imgcrd[2], phi, pixcrd[2], theta, world[2];
-
-        pixcrd[0] = x;
-        pixcrd[1] = y;
-
-        if (wcsp2s(m_WCSHandle, 1, 2, &pixcrd[0], &imgcrd[0], &phi, &theta, &world[0], &stat[0]))
-            return;
-
-        minRA = std::min(minRA, world[0]);
-        maxRA = std::max(maxRA, world[0]);
-        minDec = std::min(minDec, world[1]);
-        maxDec = std::max(maxDec, world[1]);
-    };
-
     // Find min and max values from edges
+    QVector<QPointF> edges;
+    edges.reserve(2 * (width() + height()));
     for (int y = 0; y < height(); y++)
     {
-        updateMinMax(0, y);
-        updateMinMax(width() - 1, y);
+        edges.append(QPointF(0, y));
+        edges.append(QPointF(width() - 1, y));
     }
 
     for (int x = 1; x < width() - 1; x++)
     {
-        updateMinMax(x, 0);
-        updateMinMax(x, height() - 1);
+        edges.append(QPointF(x, 0));
+        edges.append(QPointF(x, height() - 1));
+    }
+
+    QVector<QPointF> world;
+    QVector<bool> valid;
+    pixelsToWCS(edges, world, valid);
+    for (int i = 0; i < world.size(); i++)
+    {
+        if (!valid[i])
+            continue;
+        minRA = std::min(minRA, world[i].x());
+        maxRA = std::max(maxRA, world[i].x());
+        minDec = std::min(minDec, world[i].y());
+        maxDec = std::max(maxDec, world[i].y());
     }
 
     // Check if either pole is in the image
@@ -3022,20 +3365,22 @@ bool FITSData::findObjectsInImage(SkyPoint startPoint, SkyPoint endPoint)
                 type == SkyObject::SATELLITE);
     }), list.end());
 
-    double world[2], phi, theta, imgcrd[2], pixcrd[2];
-    int stat[2];
+    QVector<QPointF> world, pixels;
+    QVector<bool> valid;
+    world.reserve(list.size());
     for (auto &object : list)
-    {
-        world[0] = object->ra0().Degrees();
-        world[1] = object->dec0().Degrees();
+        world.append(QPointF(object->ra0().Degrees(), object->dec0().Degrees()));
+    wcsToPixels(world, pixels, valid);
 
-        if (wcss2p(m_WCSHandle, 1, 2, &world[0], &phi, &theta, &imgcrd[0], &pixcrd[0], &stat[0]) == 0)
+    for (int i = 0; i < pixels.size(); i++)
+    {
+        if (valid[i])
         {
             //The X and Y are set to the found position if it does work.
-            int x = pixcrd[0];
-            int y = pixcrd[1];
+            int x = pixels[i].x();
+            int y = pixels[i].y();
             if (x > 0 && y > 0 && x < w && y < h)
-                m_SkyObjects.append(new FITSSkyObject(object, x, y));
+                m_SkyObjects.append(new FITSSkyObject(list[i], x, y));
         }
     }
 
@@ -3325,8 +3670,9 @@ bool FITSData::rotFITS(int rotate, int mirror)
         }
     }
 
-    delete[] m_ImageBuffer;
+    releaseImageBuffer();
     m_ImageBuffer = rotimage;
+    trackImageBuffer();
 
     return true;
 }
@@ -3616,6 +3962,9 @@ void FITSData::rotWCSFITS(int angle, int mirror)
 
 uint8_t * FITSData::getWritableImageBuffer()
 {
+    // The caller may modify the pixels behind our back
+    m_ValueCountsValid = false;
+    invalidateFloatBuffers();
     return m_ImageBuffer;
 }
 
@@ -3624,10 +3973,197 @@ uint8_t const * FITSData::getImageBuffer() const
     return m_ImageBuffer;
 }
 
+void FITSData::invalidateFloatBuffers()
+{
+    QMutexLocker locker(&m_FloatBufferMutex);
+    m_BufferGeneration++;
+    m_FullFloatBuffer = FloatBuffer();
+    m_RoiFloatBuffer = FloatBuffer();
+}
+
+QSharedPointer<const QVector<float>> FITSData::getFloatBuffer(const QRect &roi) const
+{
+    const QRect frame(0, 0, m_Statistics.width, m_Statistics.height);
+    const QRect area = roi.isValid() ? roi : frame;
+    if (m_ImageBuffer == nullptr || frame.contains(area) == false)
+        return QSharedPointer<const QVector<float>>();
+
+    uint32_t generation = 0;
+    {
+        QMutexLocker locker(&m_FloatBufferMutex);
+        generation = m_BufferGeneration;
+        if (m_FullFloatBuffer.samples && m_FullFloatBuffer.generation == generation && area == frame)
+            return m_FullFloatBuffer.samples;
+        if (m_RoiFloatBuffer.samples && m_RoiFloatBuffer.generation == generation && m_RoiFloatBuffer.roi == area)
+            return m_RoiFloatBuffer.samples;
+
+        // Copying rows out of the converted full frame is cheaper than converting again.
+        if (m_FullFloatBuffer.samples && m_FullFloatBuffer.generation == generation)
+        {
+            QSharedPointer<QVector<float>> samples(new QVector<float>(area.width() * area.height() * m_Statistics.channels));
+            const float *source = m_FullFloatBuffer.samples->constData();
+            float *destination = samples->data();
+            for (int n = 0; n < m_Statistics.channels; n++)
+                for (int y = area.top(); y <= area.bottom(); y++, destination += area.width())
+                    std::copy_n(source + n * m_Statistics.samples_per_channel + y * m_Statistics.width + area.left(),
+                                area.width(), destination);
+            m_RoiFloatBuffer = { area, generation, samples };
+            return m_RoiFloatBuffer.samples;
+        }
+    }
+
+    // Convert without holding the lock, other regions can be served meanwhile.
+    QSharedPointer<const QVector<float>> samples;
+    switch (m_Statistics.dataType)
+    {
+        case TBYTE:
+            samples = convertToFloat<uint8_t>(area);
+            break;
+        case TSHORT:
+            samples = convertToFloat<int16_t>(area);
+            break;
+        case TUSHORT:
+            samples = convertToFloat<uint16_t>(area);
+            break;
+        case TLONG:
+            samples = convertToFloat<int32_t>(area);
+            break;
+        case TULONG:
+            samples = convertToFloat<uint32_t>(area);
+            break;
+        case TFLOAT:
+            samples = convertToFloat<float>(area);
+            break;
+        case TLONGLONG:
+            samples = convertToFloat<int64_t>(area);
+            break;
+        case TDOUBLE:
+            samples = convertToFloat<double>(area);
+            break;
+        default:
+            return samples;
+    }
+
+    // Only cache it if the image was not modified during the conversion.
+    QMutexLocker locker(&m_FloatBufferMutex);
+    if (generation == m_BufferGeneration)
+        (area == frame ? m_FullFloatBuffer : m_RoiFloatBuffer) = { area, generation, samples };
+    return samples;
+}
+
+template <typename T>
+QSharedPointer<const QVector<float>> FITSData::convertToFloat(const QRect &roi) const
+{
+    QSharedPointer<QVector<float>> samples(new QVector<float>(roi.width() * roi.height() * m_Statistics.channels));
+    const T *buffer = reinterpret_cast<const T *>(m_ImageBuffer);
+    float *destination = samples->data();
+    for (int n = 0; n < m_Statistics.channels; n++)
+        for (int y = roi.top(); y <= roi.bottom(); y++, destination += roi.width())
+            std::copy_n(buffer + n * m_Statistics.samples_per_channel + y * m_Statistics.width + roi.left(),
+                        roi.width(), destination);
+    return samples;
+}
+
+QSharedPointer<const QVector<float>> FITSData::getBinnedFloatBuffer(uint8_t bin, const QRect &roi) const
+{
+    const QRect frame(0, 0, m_Statistics.width, m_Statistics.height);
+    const QRect area = roi.isValid() ? roi : frame;
+    if (bin == 0 || m_ImageBuffer == nullptr || frame.contains(area) == false ||
+            area.width() < bin || area.height() < bin)
+        return QSharedPointer<const QVector<float>>();
+
+    QSharedPointer<QVector<float>> samples(new QVector<float>((area.width() / bin) * (area.height() / bin)));
+
+    QSharedPointer<const QVector<float>> converted;
+    {
+        QMutexLocker locker(&m_FloatBufferMutex);
+        if (m_FullFloatBuffer.samples && m_FullFloatBuffer.generation == m_BufferGeneration)
+            converted = m_FullFloatBuffer.samples;
+    }
+    if (converted)
+    {
+        binToFloat(converted->constData(), area, bin, samples->data());
+        return samples;
+    }
+
+    switch (m_Statistics.dataType)
+    {
+        case TBYTE:
+            binToFloat(reinterpret_cast<const uint8_t *>(m_ImageBuffer), area, bin, samples->data());
+            break;
+        case TSHORT:
+            binToFloat(reinterpret_cast<const int16_t *>(m_ImageBuffer), area, bin, samples->data());
+            break;
+        case TUSHORT:
+            binToFloat(reinterpret_cast<const uint16_t *>(m_ImageBuffer), area, bin, samples->data());
+            break;
+        case TLONG:
+            binToFloat(reinterpret_cast<const int32_t *>(m_ImageBuffer), area, bin, samples->data());
+            break;
+        case TULONG:
+            binToFloat(reinterpret_cast<const uint32_t *>(m_ImageBuffer), area, bin, samples->data());
+            break;
+        case TFLOAT:
+            binToFloat(reinterpret_cast<const float *>(m_ImageBuffer), area, bin, samples->data());
+            break;
+        case TLONGLONG:
+            binToFloat(reinterpret_cast<const int64_t *>(m_ImageBuffer), area, bin, samples->data());
+            break;
+        case TDOUBLE:
+            binToFloat(reinterpret_cast<const double *>(m_ImageBuffer), area, bin, samples->data());
+            break;
+        default:
+            return QSharedPointer<const QVector<float>>();
+    }
+    return samples;
+}
+
+template <typename T>
+void FITSData::binToFloat(const T *buffer, const QRect &roi, uint8_t bin, float *destination) const
+{
+    const int width = roi.width() / bin, height = roi.height() / bin, used = width * bin;
+    const float scale = 1.0f / (bin * bin * m_Statistics.channels);
+
+    // The rows of a block are summed into a row of sums first, a loop the compiler vectorizes, before its columns.
+    std::vector<float> sums(used);
+    for (int y = 0; y < height; y++, destination += width)
+    {
+        std::fill(sums.begin(), sums.end(), 0.0f);
+        for (int n = 0; n < m_Statistics.channels; n++)
+        {
+            for (int row = roi.top() + y * bin; row < roi.top() + (y + 1) * bin; row++)
+            {
+                const T *line = buffer + n * m_Statistics.samples_per_channel + static_cast<uint32_t>(row) * m_Statistics.width +
+                                roi.left();
+                float *sum = sums.data();
+                for (int x = 0; x < used; x++)
+                    sum[x] += line[x];
+            }
+        }
+        for (int x = 0; x < width; x++)
+        {
+            float block = 0;
+            for (int i = 0; i < bin; i++)
+                block += sums[x * bin + i];
+            destination[x] = block * scale;
+        }
+    }
+}
+
 void FITSData::setImageBuffer(uint8_t * buffer)
 {
-    delete[] m_ImageBuffer;
+    releaseImageBuffer();
     m_ImageBuffer = buffer;
+    trackImageBuffer();
+}
+
+uint8_t *FITSData::createImageBuffer(const FITSImage::Statistic &stats)
+{
+    releaseImageBuffer();
+    m_Statistics = stats;
+    m_ImageBufferSize = m_Statistics.samples_per_channel * m_Statistics.channels * m_Statistics.bytesPerPixel;
+    acquireImageBuffer();
+    return m_ImageBuffer;
 }
 
 bool FITSData::checkDebayer()
@@ -3759,105 +4295,161 @@ bool FITSData::debayer(bool reload)
     }
 }
 
-bool FITSData::debayer_8bit()
+namespace
+{
+// libdc1394 decoders for the sample types we debayer.
+dc1394error_t decodeBayer(const uint8_t *bayer, uint8_t *rgb, uint32_t width, uint32_t height, const BayerParams &params)
 {
-    dc1394error_t error_code;
+    return dc1394_bayer_decoding_8bit(bayer, rgb, width, height, params.filter, params.method);
+}
 
-    uint32_t rgb_size = m_Statistics.samples_per_channel * 3 * m_Statistics.bytesPerPixel;
-    uint8_t * destinationBuffer = nullptr;
+dc1394error_t decodeBayer(const uint16_t *bayer, uint16_t *rgb, uint32_t width, uint32_t height, const BayerParams &params)
+{
+    return dc1394_bayer_decoding_16bit(bayer, rgb, width, height, params.filter, params.method, 16);
+}
 
-    try
-    {
-        destinationBuffer = new uint8_t[rgb_size];
-    }
-    catch (const std::bad_alloc &e)
+// Superpixel debayering: every 2x2 bayer cell gives one RGB value, the two greens being averaged,
+// which is written to the four pixels of the cell. Only processes the cells of rows [firstRow, lastRow).
+// firstRow must be even.
+template <typename T>
+void superpixelRows(const T *bayer, T *planes, uint32_t width, uint32_t height, uint32_t planeSize,
+                    dc1394color_filter_t filter, uint32_t firstRow, uint32_t lastRow)
+{
+    // Offsets of red and blue in the 2x2 cell, the greens are on the other diagonal.
+    uint32_t red = 0, blue = 0, green1 = 0, green2 = 0;
+    switch (filter)
     {
-        logOOMError(rgb_size);
-        m_LastError = i18n("Unable to allocate memory for temporary bayer buffer: %1", e.what());
-        return false;
+        case DC1394_COLOR_FILTER_RGGB:
+            red = 0, green1 = 1, green2 = 2, blue = 3;
+            break;
+        case DC1394_COLOR_FILTER_GBRG:
+            green1 = 0, blue = 1, red = 2, green2 = 3;
+            break;
+        case DC1394_COLOR_FILTER_GRBG:
+            green1 = 0, red = 1, blue = 2, green2 = 3;
+            break;
+        case DC1394_COLOR_FILTER_BGGR:
+        default:
+            blue = 0, green1 = 1, green2 = 2, red = 3;
+            break;
     }
 
-    auto * bayer_source_buffer      = reinterpret_cast<uint8_t *>(m_ImageBuffer);
-    auto * bayer_destination_buffer = reinterpret_cast<uint8_t *>(destinationBuffer);
+    T *rPlane = planes;
+    T *gPlane = planes + planeSize;
+    T *bPlane = planes + 2 * planeSize;
 
-    if (bayer_destination_buffer == nullptr)
+    for (uint32_t y = firstRow; y < lastRow; y += 2)
     {
-        logOOMError(rgb_size);
-        m_LastError = i18n("Unable to allocate memory for temporary bayer buffer.");
-        return false;
+        // Odd sizes reuse the last row or column for the incomplete cells.
+        const uint32_t y1 = std::min(y + 1, height - 1);
+        const T *rows[2] = { bayer + y * width, bayer + y1 * width };
+        for (uint32_t x = 0; x < width; x += 2)
+        {
+            const uint32_t x1 = std::min(x + 1, width - 1);
+            const T cell[4] = { rows[0][x], rows[0][x1], rows[1][x], rows[1][x1] };
+            const T r = cell[red];
+            const T g = (static_cast<uint32_t>(cell[green1]) + cell[green2] + 1) / 2;
+            const T b = cell[blue];
+
+            const uint32_t offsets[4] = { y * width + x, y * width + x1, y1 * width + x, y1 * width + x1 };
+            for (uint32_t offset : offsets)
+            {
+                rPlane[offset] = r;
+                gPlane[offset] = g;
+                bPlane[offset] = b;
+            }
+        }
     }
+}
 
-    int ds1394_height = m_Statistics.height;
-    auto dc1394_source = bayer_source_buffer;
+// Debayers the width x height bayer image into three planes of planeSize samples each.
+// The image is split in horizontal bands decoded in parallel, each writing straight into its rows
+// of the planes. Bands start on even rows to keep the phase of the bayer pattern, and are decoded
+// with a margin of rows on both sides so that the interpolation near their edges sees the same
+// neighbours as when decoding the whole image.
+template <typename T>
+dc1394error_t debayerToPlanes(const T *bayer, T *planes, uint32_t width, uint32_t height, uint32_t planeSize,
+                              const BayerParams &params, Executors::Priority priority)
+{
+    constexpr uint32_t margin = 8;
+    constexpr uint32_t minBandHeight = 256;
 
-    if (debayerParams.offsetY == 1)
-    {
-        dc1394_source += m_Statistics.width;
-        ds1394_height--;
-    }
-    // offsetX == 1 is handled in checkDebayer() and should be 0 here.
+    // AHD keeps static state in bayer.c, so it cannot run on several bands at once.
+    const bool canSplit = params.method != DC1394_BAYER_METHOD_AHD;
+    uint32_t numBands = canSplit ? qBound<uint32_t>(1, height / minBandHeight, QThread::idealThreadCount()) : 1;
+    const uint32_t bandHeight = ((height + numBands - 1) / numBands + 1) & ~1u;
+    numBands = (height + bandHeight - 1) / bandHeight;
 
-    error_code = dc1394_bayer_decoding_8bit(dc1394_source, bayer_destination_buffer, m_Statistics.width, ds1394_height,
-                                            debayerParams.filter,
-                                            debayerParams.method);
+    std::vector<uint32_t> bands(numBands);
+    std::iota(bands.begin(), bands.end(), 0);
+    std::atomic<int> result { DC1394_SUCCESS };
 
-    if (error_code != DC1394_SUCCESS)
+    Executors::blockingMap(priority, bands, [&](uint32_t band)
     {
-        m_LastError = i18n("Debayer failed (%1)", error_code);
-        m_Statistics.channels = 1;
-        delete[] destinationBuffer;
-        return false;
-    }
+        const uint32_t firstRow = band * bandHeight;
+        const uint32_t lastRow = std::min(height, firstRow + bandHeight);
 
-    if (m_ImageBufferSize != rgb_size)
-    {
-        delete[] m_ImageBuffer;
+        if (params.method == DC1394_BAYER_METHOD_DOWNSAMPLE)
+        {
+            superpixelRows(bayer, planes, width, height, planeSize, params.filter, firstRow, lastRow);
+            return;
+        }
+
+        const uint32_t decodeFirst = firstRow > margin ? firstRow - margin : 0;
+        const uint32_t decodeLast = std::min(height, lastRow + margin);
+
+        std::vector<T> rgb;
         try
         {
-            m_ImageBuffer = new uint8_t[rgb_size];
+            rgb.resize(static_cast<size_t>(decodeLast - decodeFirst) * width * 3);
         }
-        catch (const std::bad_alloc &e)
+        catch (const std::bad_alloc &)
         {
-            delete[] destinationBuffer;
-            logOOMError(rgb_size);
-            m_LastError = i18n("Unable to allocate memory for temporary bayer buffer: %1", e.what());
-            return false;
+            result = DC1394_MEMORY_ALLOCATION_FAILURE;
+            return;
         }
 
-        m_ImageBufferSize = rgb_size;
-    }
-
-    auto bayered_buffer = reinterpret_cast<uint8_t *>(m_ImageBuffer);
-
-    // Data in R1G1B1, we need to copy them into 3 layers for FITS
+        const dc1394error_t error = decodeBayer(bayer + decodeFirst * width, rgb.data(), width, decodeLast - decodeFirst, params);
+        if (error != DC1394_SUCCESS)
+        {
+            result = error;
+            return;
+        }
 
-    uint8_t * rBuff = bayered_buffer;
-    uint8_t * gBuff = bayered_buffer + (m_Statistics.width * m_Statistics.height);
-    uint8_t * bBuff = bayered_buffer + (m_Statistics.width * m_Statistics.height * 2);
+        // The decoders output interleaved R1G1B1, the planes are stored one after another.
+        const T *source = rgb.data() + static_cast<size_t>(firstRow - decodeFirst) * width * 3;
+        T *rPlane = planes + firstRow * width;
+        T *gPlane = rPlane + planeSize;
+        T *bPlane = gPlane + planeSize;
+        for (uint32_t i = 0; i < (lastRow - firstRow) * width; ++i, source += 3)
+        {
+            rPlane[i] = source[0];
+            gPlane[i] = source[1];
+            bPlane[i] = source[2];
+        }
+    });
 
-    int imax = m_Statistics.samples_per_channel * 3 - 3;
-    for (int i = 0; i <= imax; i += 3)
-    {
-        *rBuff++ = bayer_destination_buffer[i];
-        *gBuff++ = bayer_destination_buffer[i + 1];
-        *bBuff++ = bayer_destination_buffer[i + 2];
-    }
+    return static_cast<dc1394error_t>(result.load());
+}
+}
 
-    // TODO Maybe all should be treated the same
-    // Doing single channel saves lots of memory though for non-essential
-    // frames
-    m_Statistics.channels = (m_Mode == FITS_NORMAL || m_Mode == FITS_CALIBRATE) ? 3 : 1;
-    m_Statistics.dataType = TBYTE;
-    delete[] destinationBuffer;
-    return true;
+bool FITSData::debayer_8bit()
+{
+    return debayer<uint8_t>();
 }
 
 bool FITSData::debayer_16bit()
 {
-    dc1394error_t error_code;
+    return debayer<uint16_t>();
+}
+
+template <typename T>
+bool FITSData::debayer()
+{
+    const uint32_t width = m_Statistics.width;
+    const uint32_t rgb_size = m_Statistics.samples_per_channel * 3 * m_Statistics.bytesPerPixel;
+    uint8_t * destinationBuffer = nullptr;
 
-    uint32_t rgb_size = m_Statistics.samples_per_channel * 3 * m_Statistics.bytesPerPixel;
-    uint8_t *destinationBuffer = nullptr;
     try
     {
         destinationBuffer = new uint8_t[rgb_size];
@@ -3869,75 +4461,41 @@ bool FITSData::debayer_16bit()
         return false;
     }
 
-    auto * bayer_source_buffer      = reinterpret_cast<uint16_t *>(m_ImageBuffer);
-    auto * bayer_destination_buffer = reinterpret_cast<uint16_t *>(destinationBuffer);
-
-    if (bayer_destination_buffer == nullptr)
-    {
-        logOOMError(rgb_size);
-        m_LastError = i18n("Unable to allocate memory for temporary bayer buffer.");
-        return false;
-    }
-
-    int ds1394_height = m_Statistics.height;
-    auto dc1394_source = bayer_source_buffer;
+    auto * bayer_source_buffer = reinterpret_cast<const T *>(m_ImageBuffer);
+    auto * bayer_destination_buffer = reinterpret_cast<T *>(destinationBuffer);
 
+    uint32_t ds1394_height = m_Statistics.height;
     if (debayerParams.offsetY == 1)
     {
-        dc1394_source += m_Statistics.width;
+        bayer_source_buffer += width;
         ds1394_height--;
+        // The last row has no bayer data with this offset.
+        for (int channel = 0; channel < 3; channel++)
+            std::fill_n(bayer_destination_buffer + channel * m_Statistics.samples_per_channel + ds1394_height * width, width, 0);
     }
     // offsetX == 1 is handled in checkDebayer() and should be 0 here.
 
-    error_code = dc1394_bayer_decoding_16bit(dc1394_source, bayer_destination_buffer, m_Statistics.width, ds1394_height,
-                 debayerParams.filter,
-                 debayerParams.method, 16);
+    // Data is written straight into the 3 layers used for FITS.
+    const dc1394error_t error_code = debayerToPlanes(bayer_source_buffer, bayer_destination_buffer, width, ds1394_height,
+                                     m_Statistics.samples_per_channel, debayerParams, executorPriority());
 
     if (error_code != DC1394_SUCCESS)
     {
-        m_LastError = i18n("Debayer failed (%1)");
+        m_LastError = i18n("Debayer failed (%1)", error_code);
         m_Statistics.channels = 1;
         delete[] destinationBuffer;
         return false;
     }
 
-    if (m_ImageBufferSize != rgb_size)
-    {
-        delete[] m_ImageBuffer;
-        try
-        {
-            m_ImageBuffer = new uint8_t[rgb_size];
-        }
-        catch (const std::bad_alloc &e)
-        {
-            logOOMError(rgb_size);
-            delete[] destinationBuffer;
-            m_LastError = i18n("Unable to allocate memory for temporary bayer buffer: %1", e.what());
-            return false;
-        }
-
-        m_ImageBufferSize = rgb_size;
-    }
-
-    auto bayered_buffer = reinterpret_cast<uint16_t *>(m_ImageBuffer);
-
-    // Data in R1G1B1, we need to copy them into 3 layers for FITS
-
-    uint16_t * rBuff = bayered_buffer;
-    uint16_t * gBuff = bayered_buffer + (m_Statistics.width * m_Statistics.height);
-    uint16_t * bBuff = bayered_buffer + (m_Statistics.width * m_Statistics.height * 2);
-
-    int imax = m_Statistics.samples_per_channel * 3 - 3;
-    for (int i = 0; i <= imax; i += 3)
-    {
-        *rBuff++ = bayer_destination_buffer[i];
-        *gBuff++ = bayer_destination_buffer[i + 1];
-        *bBuff++ = bayer_destination_buffer[i + 2];
-    }
+    releaseImageBuffer();
+    m_ImageBuffer = destinationBuffer;
+    m_ImageBufferSize = rgb_size;
+    trackImageBuffer();
 
+    // TODO Maybe all should be treated the same
+    // Doing single channel saves lots of memory though for non-essential
+    // frames
     m_Statistics.channels = (m_Mode == FITS_NORMAL || m_Mode == FITS_CALIBRATE) ? 3 : 1;
-    m_Statistics.dataType = TUSHORT;
-    delete[] destinationBuffer;
     return true;
 }
 
@@ -3956,6 +4514,52 @@ double FITSData::getADU() const
     return (adu / static_cast<double>(m_Statistics.channels));
 }
 
+template <typename T>
+double FITSData::areaMean(const QRect &area) const
+{
+    const T *buffer = reinterpret_cast<const T *>(m_ImageBuffer);
+    double sum = 0;
+    for (int n = 0; n < m_Statistics.channels; n++)
+    {
+        const T *channel = buffer + n * m_Statistics.samples_per_channel;
+        for (int y = area.top(); y <= area.bottom(); y++)
+        {
+            const T *row = channel + y * m_Statistics.width + area.left();
+            sum += std::accumulate(row, row + area.width(), 0.0);
+        }
+    }
+    return sum / (static_cast<double>(area.width()) * area.height() * m_Statistics.channels);
+}
+
+double FITSData::getADU(const QRect &area) const
+{
+    if (m_ImageBuffer == nullptr || area.isEmpty() ||
+            QRect(0, 0, m_Statistics.width, m_Statistics.height).contains(area) == false)
+        return -1;
+
+    switch (m_Statistics.dataType)
+    {
+        case TBYTE:
+            return areaMean<uint8_t>(area);
+        case TSHORT:
+            return areaMean<int16_t>(area);
+        case TUSHORT:
+            return areaMean<uint16_t>(area);
+        case TLONG:
+            return areaMean<int32_t>(area);
+        case TULONG:
+            return areaMean<uint32_t>(area);
+        case TFLOAT:
+            return areaMean<float>(area);
+        case TLONGLONG:
+            return areaMean<int64_t>(area);
+        case TDOUBLE:
+            return areaMean<double>(area);
+        default:
+            return -1;
+    }
+}
+
 QString FITSData::getLastError() const
 {
     return m_LastError;
@@ -4410,7 +5014,7 @@ template <typename T> void FITSData::constructHistogramInternal()
 
     for (int n = 0; n < m_Statistics.channels; n++)
     {
-        futures.append(QtConcurrent::run([ = ]()
+        futures.append(Executors::run(executorPriority(), [ = ]()
         {
             for (int i = 0; i < m_HistogramBinCount; i++)
                 m_HistogramIntensity[n][i] = m_Statistics.min[n] + (m_HistogramBinWidth[n] * i);
@@ -4419,8 +5023,25 @@ template <typename T> void FITSData::constructHistogramInternal()
 
     for (int n = 0; n < m_Statistics.channels; n++)
     {
-        futures.append(QtConcurrent::run([ = ]()
+        futures.append(Executors::run(executorPriority(), [ = ]()
         {
+            // Bin the exact value counts from the statistics pass if we have them
+            if constexpr (std::is_integral<T>::value && sizeof(T) <= 2)
+            {
+                if (m_ValueCountsValid)
+                {
+                    const QVector<uint32_t> &counts = m_ValueCounts[n];
+                    for (int i = 0; i < counts.size(); i++)
+                    {
+                        if (counts[i] == 0)
+                            continue;
+                        int32_t id = histogramBinInternal<T>(static_cast<T>(i + std::numeric_limits<T>::min()), n);
+                        m_HistogramFrequency[n][id] += counts[i];
+                    }
+                    return;
+                }
+            }
+
             uint32_t offset = n * samples;
 
             for (uint32_t i = 0; i < samples; i += sampleBy)
@@ -4438,7 +5059,7 @@ template <typename T> void FITSData::constructHistogramInternal()
 
     for (int n = 0; n < m_Statistics.channels; n++)
     {
-        futures.append(QtConcurrent::run([ = ]()
+        futures.append(Executors::run(executorPriority(), [ = ]()
         {
             uint32_t accumulator = 0;
             for (int i = 0; i < m_HistogramBinCount; i++)
@@ -21,8 +21,10 @@
 #include "kstarsdatetime.h"
 #include "bayer.h"
 #include "skybackground.h"
+#include "starstatistics.h"
 #include "fitscommon.h"
 #include "fitsstardetector.h"
+#include "auxiliary/executors.h"
 #include "auxiliary/imagemask.h"
 
 #ifdef WIN32
@@ -33,6 +35,7 @@
 #include <fitsio.h>
 
 #include <QFuture>
+#include <QMutex>
 #include <QObject>
 #include <QRect>
 #include <QVariant>
@@ -135,6 +138,21 @@ class FITSData : public QObject
         // Access functions
         void clearImageBuffers();
         void setImageBuffer(uint8_t *buffer);
+        /**
+         * @brief createImageBuffer Set the statistics of a new image and allocate its buffer, from the pool for
+         * guide and focus frames. The caller fills the pixels, then calls calculateStats(true).
+         * @param stats dimensions and data type of the image.
+         * @return the buffer of the image, owned by this object.
+         */
+        uint8_t *createImageBuffer(const FITSImage::Statistic &stats);
+        /**
+         * @brief setPooledBuffer Take the image buffer from the FITSFramePool like guide and focus frames,
+         * for frames of the same size loaded one after another, e.g. when blinking. Set before loading.
+         */
+        void setPooledBuffer(bool pooled)
+        {
+            m_PoolImageBuffer = pooled;
+        }
         uint8_t const *getImageBuffer() const;
         uint8_t *getWritableImageBuffer();
 
@@ -256,6 +274,8 @@ class FITSData : public QObject
             }
         }
         double getADU() const;
+        /** @brief getADU Mean of the samples of area, over all channels, or -1 if area is outside of the image. */
+        double getADU(const QRect &area) const;
 
         ////////////////////////////////////////////////////////////////////////////////////////
         ////////////////////////////////////////////////////////////////////////////////////////
@@ -303,6 +323,32 @@ class FITSData : public QObject
             starCenters = centers;
         }
         QFuture<bool> findStars(StarAlgorithm algorithm = ALGORITHM_CENTROID, const QRect &trackingBox = QRect());
+        /**
+         * @brief findStars Incremental detection for consecutive frames of the same field, e.g. while guiding.
+         * Only small windows around the stars detected in the previous frame are searched. If too few of them
+         * are found again, the frame is searched from scratch with SEP.
+         * @param seeds stars detected in the previous frame.
+         * @param trackingBox optional area to restrict the search to.
+         */
+        QFuture<bool> findStars(const QList<Edge> &seeds, const QRect &trackingBox = QRect());
+
+        /**
+         * @brief Aggregates of the stars of the last detection run with the "statisticsOnly" setting,
+         * which keeps no star list. getHFR() and getEccentricity() fall back on them.
+         */
+        void setStarStatistics(const StarStatistics &statistics)
+        {
+            m_StarStatistics = statistics;
+        }
+        const StarStatistics &getStarStatistics() const
+        {
+            return m_StarStatistics;
+        }
+        /** @return true if stars were found but only their aggregates were kept */
+        bool hasStarStatisticsOnly() const
+        {
+            return starCenters.empty() && m_StarStatistics.count() > 0;
+        }
 
         void setSkyBackground(const SkyBackground &bg)
         {
@@ -320,9 +366,32 @@ class FITSData : public QObject
         {
             m_SourceExtractorSettings = settings;
         }
-        // Use SEP (Sextractor Library) to find stars
-        template <typename T>
-        void getFloatBuffer(float *buffer, int x, int y, int w, int h) const;
+        /**
+         * @brief getFloatBuffer Return the image samples of a region converted to float.
+         * The conversion is cached until the image data is modified, so detectors analyzing the same region
+         * one after another only pay for it once. Regions of an image already converted as a whole are copied
+         * from the cached full frame rather than converted again.
+         * @param roi region to return, the whole image if invalid. Must lie within the image.
+         * @return roi.width() x roi.height() samples per channel, row by row, the channels one after another.
+         */
+        QSharedPointer<const QVector<float>> getFloatBuffer(const QRect &roi = QRect()) const;
+        /**
+         * @brief getBinnedFloatBuffer Return the samples of a region averaged over bin x bin blocks and all channels.
+         * The blocks are read from the cached float conversion of the whole image if there is one, see getFloatBuffer(),
+         * else straight from the image buffer, so that no float copy of the full image is made.
+         * @param bin size of the blocks, trailing rows and columns of the region that don't fill a block are dropped.
+         * @param roi region to bin, the whole image if invalid. Must lie within the image.
+         * @return (roi.width() / bin) x (roi.height() / bin) samples row by row, or null if that is empty.
+         */
+        QSharedPointer<const QVector<float>> getBinnedFloatBuffer(uint8_t bin, const QRect &roi = QRect()) const;
+        /**
+         * @brief setFloatBufferWithStatistics When set, statistics calculations of the whole image also fill
+         * the float buffer of the whole image in the same pass, see getFloatBuffer().
+         */
+        void setFloatBufferWithStatistics(bool enabled)
+        {
+            m_FloatBufferWithStatistics = enabled;
+        }
         //int findSEPStars(QList<Edge*> &, const int8_t &boundary = int8_t()) const;
 
         // filter all stars that are visible through the given mask
@@ -404,6 +473,26 @@ class FITSData : public QObject
              */
         bool pixelToWCS(const QPointF &wcsPixelPoint, SkyPoint &wcsCoord);
 
+        /**
+             * @brief wcsToPixels Convert J2000 coordinates to pixel coordinates in one batch. A TAN projection without
+             * distortion, such as the one of injectWCS(), is computed directly, in parallel for large batches. Other
+             * projections are handed to wcslib at once.
+             * @param world J2000 (RA, DE) coordinates in degrees.
+             * @param pixels Return XY FITS coordinates, one per world point.
+             * @param valid Return whether each point was converted.
+             * @return True if successful, false if there is no WCS or wcslib failed.
+             */
+        bool wcsToPixels(const QVector<QPointF> &world, QVector<QPointF> &pixels, QVector<bool> &valid) const;
+
+        /**
+             * @brief pixelsToWCS Convert pixel coordinates to J2000 coordinates in one batch, see wcsToPixels().
+             * @param pixels Pixel coordinates in XY Image space.
+             * @param world Return J2000 (RA, DE) coordinates in degrees, with RA in [0, 360).
+             * @param valid Return whether each point was converted.
+             * @return True if successful, false if there is no WCS or wcslib failed.
+             */
+        bool pixelsToWCS(const QVector<QPointF> &pixels, QVector<QPointF> &world, QVector<bool> &valid) const;
+
         /**
              * @brief injectWCS Add WCS keywords
              * @param orientation Solver orientation, degrees E of N.
@@ -523,6 +612,13 @@ class FITSData : public QObject
             return m_Extension;
         }
 
+        // The guide and focus frames are processed in the real-time pool, the other frames in the interactive pool
+        Executors::Priority executorPriority() const
+        {
+            return (m_Mode == FITS_GUIDE || m_Mode == FITS_FOCUS || m_Mode == FITS_CALIBRATE) ? Executors::RealTime :
+                   Executors::Interactive;
+        }
+
         // Horizontal flip counter. We keep count to rotate WCS keywords on save
         int getFlipHCounter() const;
         void setFlipHCounter(int value);
@@ -604,9 +700,42 @@ class FITSData : public QObject
         // Load RAW images.
         bool loadRAWImage(const QByteArray &buffer);
 
+        /**
+         * @brief mapImageBuffer Map the image data segment of an uncompressed FITS file on disk directly
+         * instead of reading it into a newly allocated buffer. Only data that needs no conversion is mapped.
+         * @return true if m_ImageBuffer now points to the mapped data, false if the caller must read the image.
+         */
+        bool mapImageBuffer();
+        /**
+         * @brief readBufferedImage Convert the image data segment of an uncompressed FITS file held in memory
+         * straight into m_ImageBuffer, which must be acquired already.
+         * @return true if the image was converted, false if the caller must read it with CFITSIO.
+         */
+        bool readBufferedImage(const QByteArray &buffer);
+        // Check that the current HDU stores its samples as we do but for byte order, and locate them.
+        bool nativeImageData(int &physicalBITPIX, qint64 &dataStart);
+        // Convert samples located by nativeImageData() to host order, possibly in place.
+        void convertNativeImageData(const uint8_t *source, uint8_t *destination, int physicalBITPIX) const;
+        // Allocate m_ImageBuffer of m_ImageBufferSize, from a pool for guide frames.
+        void acquireImageBuffer();
+        // Free or unmap m_ImageBuffer depending on how it was acquired.
+        void releaseImageBuffer();
+        // Report the size of m_ImageBuffer to the ImageMemory, once it is allocated, replaced or freed.
+        void trackImageBuffer();
+        /**
+         * @brief readCompressedImage Decompress the current tile-compressed HDU into m_ImageBuffer.
+         * Bands of tiles are decompressed in parallel when CFITSIO is reentrant.
+         * @param nelements number of samples to read.
+         */
+        bool readCompressedImage(long nelements);
+
         void rotWCSFITS(int angle, int mirror);
-        void calculateMinMax(bool refresh = false, bool roi = false);
-        void calculateMedian(bool refresh = false, bool roi = false);
+        // Read statistics from the FITS header. Returns true if the header provided all of them.
+        bool readMinMaxFromHeader();
+        bool readMedianFromHeader();
+        bool readMeanStdDevFromHeader();
+        // Calculate the requested statistics in a single pass over the image or ROI buffer.
+        void calculateStatistics(bool roi, bool minMax, bool median, bool meanStdDev);
         bool checkDebayer();
         void readWCSKeys();
 
@@ -630,13 +759,10 @@ class FITSData : public QObject
         void applyFilter(FITSScale type, uint8_t *targetImage, QVector<double> * min = nullptr, QVector<double> * max = nullptr);
 
         template <typename T>
-        void calculateMinMax(bool roi = false);
+        void calculateStatistics(bool roi, bool minMax, bool median, bool meanStdDev);
         template <typename T>
         void calculateMedian(bool roi = false);
 
-        template <typename T>
-        QPair<T, T> getParitionMinMax(uint32_t start, uint32_t stride, bool roi);
-
         /* Calculate the Gaussian blur matrix and apply it to the image using the convolution filter */
         QVector<double> createGaussianKernel(int size, double sigma);
         template <typename T>
@@ -644,10 +770,6 @@ class FITSData : public QObject
         template <typename T>
         void gaussianBlur(int kernelSize, double sigma);
 
-        /* Calculate running average & standard deviation */
-        template <typename T>
-        void calculateStdDev( bool roi = false );
-
         template <typename T>
         void convertToQImage(double dataMin, double dataMax, double scale, double zero, QImage &image);
 
@@ -666,6 +788,14 @@ class FITSData : public QObject
         uint8_t *m_ImageBuffer { nullptr };
         /// Above buffer size in bytes
         uint32_t m_ImageBufferSize { 0 };
+        /// Is m_ImageBuffer a private mapping of m_MappedFile?
+        bool m_ImageBufferMapped { false };
+        /// Does m_ImageBuffer belong to the FITSFramePool of guide and focus frames?
+        bool m_ImageBufferPooled { false };
+        /// Take m_ImageBuffer from the FITSFramePool whatever the mode, see setPooledBuffer()
+        bool m_PoolImageBuffer { false };
+        /// File backing m_ImageBuffer when it is memory mapped
+        QFile m_MappedFile;
         /// Image Buffer if Selection is to be done
         uint8_t *m_ImageRoiBuffer { nullptr };
         /// Above buffer size in bytes
@@ -684,6 +814,7 @@ class FITSData : public QObject
         bool HasDebayer { false };
         /// Buffer to hold fpack uncompressed data
         uint8_t *m_PackBuffer {nullptr};
+        size_t m_PackBufferSize {0};
 
         /// Our very own file name
         QString m_Filename, m_compressedFilename, m_Extension;
@@ -706,6 +837,20 @@ class FITSData : public QObject
         };
         /// Number of coordinate representations found.
         int m_nwcs {0};
+        /// The WCS, if it is a TAN projection without distortion, as computed by wcsToPixels() and pixelsToWCS().
+        typedef struct
+        {
+            bool valid { false };
+            double crpix[2] { 0, 0 };
+            /// Reference point, RA in radians.
+            double ra0 { 0 };
+            double sinDec0 { 0 };
+            double cosDec0 { 1 };
+            /// Intermediate degrees per pixel offset from crpix, and back.
+            double pixToImg[4] { 1, 0, 0, 1 };
+            double imgToPix[4] { 1, 0, 0, 1 };
+        } TANProjection;
+        TANProjection m_TANProjection;
         WCSState m_WCSState { Idle };
         /// All the stars we detected, if any.
         QList<Edge *> starCenters;
@@ -742,6 +887,29 @@ class FITSData : public QObject
         QVector<QVector<double>> m_HistogramFrequency;
         QVector<double> m_HistogramBinWidth;
         uint16_t m_HistogramBinCount { 0 };
+        /// Exact per-value counts of 8 and 16 bit images, gathered while calculating statistics.
+        QVector<uint32_t> m_ValueCounts[3];
+        /// Do the value counts above still match the image buffer?
+        bool m_ValueCountsValid { false };
+
+        /// Float copy of a region of the image buffer, see getFloatBuffer().
+        struct FloatBuffer
+        {
+            QRect roi;
+            uint32_t generation { 0 };
+            QSharedPointer<const QVector<float>> samples;
+        };
+        template <typename T> QSharedPointer<const QVector<float>> convertToFloat(const QRect &roi) const;
+        template <typename T> void binToFloat(const T *buffer, const QRect &roi, uint8_t bin, float *destination) const;
+        template <typename T> double areaMean(const QRect &area) const;
+        /// Drop the float buffers, called whenever the image buffer is replaced or written to.
+        void invalidateFloatBuffers();
+        /// Incremented on each modification of the image buffer, the float buffers of older generations are stale.
+        uint32_t m_BufferGeneration { 0 };
+        /// The whole image, and the last region requested.
+        mutable FloatBuffer m_FullFloatBuffer, m_RoiFloatBuffer;
+        mutable QMutex m_FloatBufferMutex;
+        bool m_FloatBufferWithStatistics { false };
         double m_JMIndex { 1 };
         bool m_HistogramConstructed { false };
 
@@ -752,6 +920,8 @@ class FITSData : public QObject
         ////////////////////////////////////////////////////////////////////////////////////////
         // Sky Background
         SkyBackground m_SkyBackground;
+        // Star aggregates when no star list is kept
+        StarStatistics m_StarStatistics;
         // Detector Settings
         QVariantMap m_SourceExtractorSettings;
         QFuture<bool> m_StarFindFuture;
@@ -12,6 +12,22 @@
 
 #include <QPushButton>
 
+#include <algorithm>
+
+namespace
+{
+// Debayer methods in the order of the method combo box.
+const dc1394bayer_method_t comboMethods[] =
+{
+    DC1394_BAYER_METHOD_NEAREST,
+    DC1394_BAYER_METHOD_SIMPLE,
+    DC1394_BAYER_METHOD_BILINEAR,
+    DC1394_BAYER_METHOD_HQLINEAR,
+    DC1394_BAYER_METHOD_VNG,
+    DC1394_BAYER_METHOD_DOWNSAMPLE
+};
+}
+
 debayerUI::debayerUI(QDialog *parent) : QDialog(parent)
 {
     setupUi(parent);
@@ -35,7 +51,7 @@ void FITSDebayer::applyDebayer()
     {
         auto image_data = view->imageData();
 
-        dc1394bayer_method_t method = static_cast<dc1394bayer_method_t>(ui->methodCombo->currentIndex());
+        dc1394bayer_method_t method = comboMethods[std::max(0, ui->methodCombo->currentIndex())];
         dc1394color_filter_t filter = static_cast<dc1394color_filter_t>(ui->filterCombo->currentIndex() + 512);
 
         int offsetX = ui->XOffsetSpin->value();
@@ -66,7 +82,8 @@ void FITSDebayer::applyDebayer()
 
 void FITSDebayer::setBayerParams(BayerParams *param)
 {
-    ui->methodCombo->setCurrentIndex(param->method);
+    const auto method = std::find(std::begin(comboMethods), std::end(comboMethods), param->method);
+    ui->methodCombo->setCurrentIndex(method == std::end(comboMethods) ? 0 : std::distance(std::begin(comboMethods), method));
     ui->filterCombo->setCurrentIndex(param->filter - 512);
 
     ui->XOffsetSpin->setValue(param->offsetX);
@@ -0,0 +1,130 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "fitsframepool.h"
+
+#include "fitsstardetector.h"
+
+#include <fits_debug.h>
+
+#include <typeinfo>
+
+FITSFramePool &FITSFramePool::instance()
+{
+    static FITSFramePool pool;
+    return pool;
+}
+
+FITSFramePool::~FITSFramePool()
+{
+    clear();
+}
+
+uint8_t *FITSFramePool::takeBuffer(FITSMode mode, uint32_t size)
+{
+    QMutexLocker lock(&m_Mutex);
+    for (int i = 0; i < m_Buffers.size(); ++i)
+    {
+        if (m_Buffers[i].mode == mode && m_Buffers[i].size == size)
+        {
+            m_Statistics.bufferReuses++;
+            return m_Buffers.takeAt(i).data;
+        }
+    }
+
+    m_Statistics.bufferAllocations++;
+    lock.unlock();
+    return new uint8_t[size];
+}
+
+void FITSFramePool::giveBuffer(FITSMode mode, uint8_t *buffer, uint32_t size)
+{
+    if (buffer == nullptr)
+        return;
+
+    QMutexLocker lock(&m_Mutex);
+    if (m_Buffers.size() >= MAX_BUFFERS)
+        delete[] m_Buffers.takeFirst().data;
+    m_Buffers.append({ mode, size, buffer });
+}
+
+Edge *FITSFramePool::takeEdge()
+{
+    QMutexLocker lock(&m_Mutex);
+    if (m_Edges.isEmpty())
+    {
+        m_Statistics.edgeAllocations++;
+        lock.unlock();
+        return new Edge();
+    }
+
+    m_Statistics.edgeReuses++;
+    Edge *edge = m_Edges.takeLast();
+    lock.unlock();
+
+    *edge = Edge();
+    return edge;
+}
+
+void FITSFramePool::giveEdges(QList<Edge *> &edges)
+{
+    QMutexLocker lock(&m_Mutex);
+    for (Edge *edge : edges)
+    {
+        // Only plain stars are reused, like the ones takeEdge() returns
+        if (edge != nullptr && typeid(*edge) == typeid(Edge) && m_Edges.size() < MAX_EDGES)
+            m_Edges.append(edge);
+        else
+            delete edge;
+    }
+    edges.clear();
+}
+
+void FITSFramePool::giveEdge(Edge *edge)
+{
+    QList<Edge *> edges { edge };
+    giveEdges(edges);
+}
+
+void FITSFramePool::frameLoaded(FITSMode mode)
+{
+    QMutexLocker lock(&m_Mutex);
+    m_Statistics.frames++;
+
+    qCDebug(KSTARS_FITS) << "Frame pool:" << FITSModes.value(mode) << "frame"
+                         << m_Statistics.frames << "buffers allocated"
+                         << m_Statistics.bufferAllocations - m_Logged.bufferAllocations << "reused"
+                         << m_Statistics.bufferReuses - m_Logged.bufferReuses << "stars allocated"
+                         << m_Statistics.edgeAllocations - m_Logged.edgeAllocations << "reused"
+                         << m_Statistics.edgeReuses - m_Logged.edgeReuses;
+    m_Logged = m_Statistics;
+}
+
+FITSFramePool::Statistics FITSFramePool::statistics() const
+{
+    QMutexLocker lock(&m_Mutex);
+    return m_Statistics;
+}
+
+void FITSFramePool::clear()
+{
+    QMutexLocker lock(&m_Mutex);
+    for (const Buffer &buffer : m_Buffers)
+        delete[] buffer.data;
+    m_Buffers.clear();
+    qDeleteAll(m_Edges);
+    m_Edges.clear();
+}
+
+void FITSFramePool::release(FITSMode mode)
+{
+    QMutexLocker lock(&m_Mutex);
+    for (int i = m_Buffers.size() - 1; i >= 0; i--)
+    {
+        if (m_Buffers[i].mode == mode)
+            delete[] m_Buffers.takeAt(i).data;
+    }
+}
@@ -0,0 +1,98 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "fitscommon.h"
+
+#include <QList>
+#include <QMutex>
+#include <QPair>
+
+#include <cstdint>
+
+class Edge;
+
+/**
+ * @class FITSFramePool
+ * @short Recycles the image buffers and star lists of guide and focus frames.
+ *
+ * Guide and focus loops receive frames of the same camera, region of interest and bit depth
+ * all night long. Allocating and freeing their buffers and hundreds of stars for every frame
+ * fragments the heap of small machines and adds jitter. Buffers are kept by mode and size,
+ * which are the same for frames of the same camera, ROI and bit depth, and stars are kept
+ * in a free list.
+ *
+ * Frames blinked in the FITS Viewer and stacked from a directory are pooled on request, see
+ * FITSData::setPooledBuffer(), and released once done.
+ *
+ * Counts of allocations and reuses are kept, and logged for every frame to KSTARS_FITS.
+ * All functions are thread safe.
+ */
+class FITSFramePool
+{
+    public:
+        struct Statistics
+        {
+            quint64 frames { 0 };
+            quint64 bufferAllocations { 0 };
+            quint64 bufferReuses { 0 };
+            quint64 edgeAllocations { 0 };
+            quint64 edgeReuses { 0 };
+        };
+
+        static FITSFramePool &instance();
+
+        ~FITSFramePool();
+
+        /** @return true if the buffers of frames of @p mode are pooled */
+        static bool isPooled(FITSMode mode)
+        {
+            return mode == FITS_GUIDE || mode == FITS_FOCUS;
+        }
+
+        /** @return a buffer of @p size bytes for a frame of @p mode, to be given back with giveBuffer() */
+        uint8_t *takeBuffer(FITSMode mode, uint32_t size);
+        void giveBuffer(FITSMode mode, uint8_t *buffer, uint32_t size);
+
+        /** @return a star with default values, which may be deleted or given back */
+        Edge *takeEdge();
+        /** @short Give back the stars of @p edges, which is cleared */
+        void giveEdges(QList<Edge *> &edges);
+        void giveEdge(Edge *edge);
+
+        /** @short Count a frame of @p mode and log the allocations since the previous one */
+        void frameLoaded(FITSMode mode);
+
+        Statistics statistics() const;
+
+        /** @short Free all kept buffers and stars */
+        void clear();
+        /** @short Free the kept buffers of frames of @p mode, e.g. once done blinking */
+        void release(FITSMode mode);
+
+    private:
+        FITSFramePool() = default;
+
+        struct Buffer
+        {
+            FITSMode mode;
+            uint32_t size;
+            uint8_t *data;
+        };
+
+        /// Enough for the frame being loaded, the previous one and one still displayed, and for the
+        /// preloaded neighbours of a blinked frame
+        static constexpr int MAX_BUFFERS = 6;
+        /// Far more than the guide and focus star detections keep
+        static constexpr int MAX_EDGES = 4096;
+
+        mutable QMutex m_Mutex;
+        QList<Buffer> m_Buffers;
+        QList<Edge *> m_Edges;
+        Statistics m_Statistics;
+        Statistics m_Logged;
+};
@@ -11,11 +11,11 @@
 
 #include <math.h>
 #include <cmath>
-#include <QtConcurrent>
 
 #include "fits_debug.h"
 #include "fitsgradientdetector.h"
 #include "fitsdata.h"
+#include "auxiliary/tracer.h"
 
 QFuture<bool> FITSGradientDetector::findSources(const QRect &boundary)
 {
@@ -25,34 +25,36 @@ QFuture<bool> FITSGradientDetector::findSources(const QRect &boundary)
 
         case TBYTE:
         default:
-            return QtConcurrent::run(this, &FITSGradientDetector::findSources<uint8_t>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSGradientDetector::findSources<uint8_t>, this, boundary);
 
         case TSHORT:
-            return QtConcurrent::run(this, &FITSGradientDetector::findSources<int16_t>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSGradientDetector::findSources<int16_t>, this, boundary);
 
         case TUSHORT:
-            return QtConcurrent::run(this, &FITSGradientDetector::findSources<uint16_t>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSGradientDetector::findSources<uint16_t>, this, boundary);
 
         case TLONG:
-            return QtConcurrent::run(this, &FITSGradientDetector::findSources<int32_t>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSGradientDetector::findSources<int32_t>, this, boundary);
 
         case TULONG:
-            return QtConcurrent::run(this, &FITSGradientDetector::findSources<uint16_t>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSGradientDetector::findSources<uint16_t>, this, boundary);
 
         case TFLOAT:
-            return QtConcurrent::run(this, &FITSGradientDetector::findSources<float>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSGradientDetector::findSources<float>, this, boundary);
 
         case TLONGLONG:
-            return QtConcurrent::run(this, &FITSGradientDetector::findSources<int64_t>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSGradientDetector::findSources<int64_t>, this, boundary);
 
         case TDOUBLE:
-            return QtConcurrent::run(this, &FITSGradientDetector::findSources<double>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSGradientDetector::findSources<double>, this, boundary);
     }
 }
 
 template <typename T>
 bool FITSGradientDetector::findSources(const QRect &boundary)
 {
+    KSTARS_TRACE_SPAN("fits", "Star detection");
+
     int subX = qMax(0, boundary.isNull() ? 0 : boundary.x());
     int subY = qMax(0, boundary.isNull() ? 0 : boundary.y());
     int subW = (boundary.isNull() ? m_ImageData->width() : boundary.width());
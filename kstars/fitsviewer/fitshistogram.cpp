@@ -13,10 +13,10 @@
 #include "fitstab.h"
 #include "fitsview.h"
 #include "fitsviewer.h"
+#include "auxiliary/executors.h"
 
 #include <KMessageBox>
 
-#include <QtConcurrent>
 #include <type_traits>
 #include <zlib.h>
 
@@ -216,7 +216,7 @@ template <typename T> void FITSHistogram::constructHistogram()
 
     for (int n = 0; n < channels; n++)
     {
-        futures.append(QtConcurrent::run([ = ]()
+        futures.append(Executors::run(Executors::Interactive, [ = ]()
         {
             for (int i = 0; i < binCount; i++)
                 intensity[n][i] = FITSMin[n] + (binWidth[n] * i);
@@ -225,7 +225,7 @@ template <typename T> void FITSHistogram::constructHistogram()
 
     for (int n = 0; n < channels; n++)
     {
-        futures.append(QtConcurrent::run([ = ]()
+        futures.append(Executors::run(Executors::Interactive, [ = ]()
         {
             uint32_t offset = n * samples;
 
@@ -246,7 +246,7 @@ template <typename T> void FITSHistogram::constructHistogram()
 
     for (int n = 0; n < channels; n++)
     {
-        futures.append(QtConcurrent::run([ = ]()
+        futures.append(Executors::run(Executors::Interactive, [ = ]()
         {
             uint32_t accumulator = 0;
             for (int i = 0; i < binCount; i++)
@@ -264,7 +264,7 @@ template <typename T> void FITSHistogram::constructHistogram()
 
     for (int n = 0; n < channels; n++)
     {
-        futures.append(QtConcurrent::run([ = ]()
+        futures.append(Executors::run(Executors::Interactive, [ = ]()
         {
             double median[3] = {0};
             const bool cutoffSpikes = ui->hideSaturated->isChecked();
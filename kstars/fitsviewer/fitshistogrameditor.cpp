@@ -104,7 +104,7 @@ void FITSHistogramEditor::resizePlot()
 
 void FITSHistogramEditor::syncGUI()
 {
-    if (isGUISynced)
+    if (isGUISynced || m_ImageData.isNull())
         return;
 
     sliderTick.clear();
@@ -194,6 +194,10 @@ void FITSHistogramEditor::setImageData(const QSharedPointer<FITSData> &data)
     m_ImageData = data;
     ui->histogramPlot->setImageData(data);
 
+    // Released when the image of the tab is unloaded
+    if (m_ImageData.isNull())
+        return;
+
     connect(m_ImageData.data(), &FITSData::dataChanged, [this]
     {
         isGUISynced = false;
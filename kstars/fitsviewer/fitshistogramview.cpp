@@ -165,6 +165,9 @@ void FITSHistogramView::resizePlot()
 
 void FITSHistogramView::driftMouseOverLine(QMouseEvent * event)
 {
+    if (m_ImageData.isNull())
+        return;
+
     double intensity = xAxis->pixelToCoord(event->localPos().x());
 
     uint8_t channels = m_ImageData->channels();
@@ -233,6 +236,9 @@ void FITSHistogramView::setImageData(const QSharedPointer<FITSData> &data)
 {
     m_ImageData = data;
 
+    if (m_ImageData.isNull())
+        return;
+
     connect(m_ImageData.data(), &FITSData::dataChanged, [this]()
     {
         if (m_Linear)
@@ -0,0 +1,114 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "fitsimagepyramid.h"
+#include "auxiliary/executors.h"
+
+#include <cmath>
+
+void FITSImagePyramid::setBase(const QImage &image)
+{
+    m_Levels.clear();
+    if (image.isNull() == false)
+        m_Levels.append(image);
+}
+
+void FITSImagePyramid::clear()
+{
+    m_Levels.clear();
+}
+
+int FITSImagePyramid::levelForScale(double scale) const
+{
+    if (m_Levels.isEmpty() || scale <= 0 || scale > 0.5)
+        return 0;
+
+    int n = static_cast<int>(std::floor(std::log2(1.0 / scale)));
+
+    // Do not go below a single tile, the gain would be negligible.
+    int maxLevel = 0;
+    int w = m_Levels[0].width(), h = m_Levels[0].height();
+    while ((w + 1) / 2 >= TILE_SIZE && (h + 1) / 2 >= TILE_SIZE)
+    {
+        w = (w + 1) / 2;
+        h = (h + 1) / 2;
+        maxLevel++;
+    }
+
+    return std::min(n, maxLevel);
+}
+
+const QImage &FITSImagePyramid::level(int n)
+{
+    static const QImage nullImage;
+    if (m_Levels.isEmpty())
+        return nullImage;
+
+    n = std::max(0, std::min(n, levelForScale(std::pow(0.5, n))));
+    while (m_Levels.size() <= n)
+        m_Levels.append(halve(m_Levels.last()));
+
+    return m_Levels[n];
+}
+
+QImage FITSImagePyramid::halve(const QImage &source)
+{
+    const int sw = source.width();
+    const int sh = source.height();
+    const int w = (sw + 1) / 2;
+    const int h = (sh + 1) / 2;
+
+    if (source.format() != QImage::Format_Indexed8 && source.format() != QImage::Format_RGB32)
+        return source.scaled(w, h, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+    QImage output(w, h, source.format());
+    if (source.format() == QImage::Format_Indexed8)
+        output.setColorTable(source.colorTable());
+
+    QVector<QRect> tiles;
+    for (int y = 0; y < h; y += TILE_SIZE)
+        for (int x = 0; x < w; x += TILE_SIZE)
+            tiles.append(QRect(x, y, std::min(TILE_SIZE, w - x), std::min(TILE_SIZE, h - y)));
+
+    // Each tile writes to its own part of the output, and only reads the source.
+    uchar *outputBits = output.bits();
+    const int outputStride = output.bytesPerLine();
+    const uchar *sourceBits = source.constBits();
+    const int sourceStride = source.bytesPerLine();
+    const bool gray = source.format() == QImage::Format_Indexed8;
+
+    Executors::blockingMap(Executors::Interactive, tiles, [ = ](const QRect & tile)
+    {
+        for (int y = tile.top(); y <= tile.bottom(); y++)
+        {
+            const uchar *row0 = sourceBits + 2 * y * sourceStride;
+            const uchar *row1 = (2 * y + 1 < sh) ? row0 + sourceStride : row0;
+            uchar *out = outputBits + y * outputStride;
+
+            for (int x = tile.left(); x <= tile.right(); x++)
+            {
+                const int x0 = 2 * x;
+                const int x1 = (x0 + 1 < sw) ? x0 + 1 : x0;
+                if (gray)
+                {
+                    out[x] = (row0[x0] + row0[x1] + row1[x0] + row1[x1] + 2) / 4;
+                }
+                else
+                {
+                    const QRgb *r0 = reinterpret_cast<const QRgb *>(row0);
+                    const QRgb *r1 = reinterpret_cast<const QRgb *>(row1);
+                    const QRgb a = r0[x0], b = r0[x1], c = r1[x0], d = r1[x1];
+                    reinterpret_cast<QRgb *>(out)[x] =
+                        qRgb((qRed(a) + qRed(b) + qRed(c) + qRed(d) + 2) / 4,
+                             (qGreen(a) + qGreen(b) + qGreen(c) + qGreen(d) + 2) / 4,
+                             (qBlue(a) + qBlue(b) + qBlue(c) + qBlue(d) + 2) / 4);
+                }
+            }
+        }
+    });
+
+    return output;
+}
@@ -0,0 +1,50 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QImage>
+#include <QVector>
+
+/**
+ * @class FITSImagePyramid
+ * Power-of-two downsampled copies of a stretched display image.
+ *
+ * Level 0 is the stretched image itself, and each following level halves the width and
+ * height of the previous one using a 2x2 box filter. Levels are built lazily, the first
+ * time they are requested, and are kept until a new base image is set. The reduction is
+ * split into 256x256 tiles processed on the global thread pool.
+ *
+ * FITSView uses the pyramid when zoomed out on large images so that it only converts,
+ * annotates and scales a pixmap close to the on-screen size, instead of the full image.
+ */
+class FITSImagePyramid
+{
+    public:
+        static constexpr int TILE_SIZE = 256;
+
+        /// Replace the base (level 0) image and drop all the cached levels.
+        void setBase(const QImage &image);
+        /// Drop the base image and all the cached levels.
+        void clear();
+
+        /**
+         * @brief level Return the image at the given level, building it and the levels below it if needed.
+         * @param n level index, where the image at level n is downsampled by 2^n. Clamped to the deepest usable level.
+         */
+        const QImage &level(int n);
+
+        /**
+         * @brief levelForScale Return the deepest level which still has at least one image pixel per screen pixel.
+         * @param scale ratio of the displayed size to the base image size.
+         */
+        int levelForScale(double scale) const;
+
+    private:
+        static QImage halve(const QImage &source);
+
+        QVector<QImage> m_Levels;
+};
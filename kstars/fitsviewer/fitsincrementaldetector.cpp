@@ -0,0 +1,248 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "fitsincrementaldetector.h"
+
+#include "fits_debug.h"
+#include "fitsdata.h"
+#include "fitsframepool.h"
+#include "fitssepdetector.h"
+#include "skybackground.h"
+#include "auxiliary/tracer.h"
+#include "auxiliary/executors.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+// Returns the median of the values, which are reordered.
+float median(std::vector<float> &values)
+{
+    const auto middle = values.begin() + values.size() / 2;
+    std::nth_element(values.begin(), middle, values.end());
+    return *middle;
+}
+}
+
+QFuture<bool> FITSIncrementalDetector::findSources(QRect const &boundary)
+{
+    return Executors::run(m_ImageData->executorPriority(), &FITSIncrementalDetector::findSourcesNearSeeds, this, boundary);
+}
+
+bool FITSIncrementalDetector::findSourcesNearSeeds(QRect const &boundary)
+{
+    KSTARS_TRACE_SPAN("fits", "Star detection");
+
+    bool found = false;
+    switch (m_ImageData->getStatistics().dataType)
+    {
+        case TBYTE:
+        default:
+            found = findSeeds<uint8_t>(boundary);
+            break;
+        case TSHORT:
+            found = findSeeds<int16_t>(boundary);
+            break;
+        case TUSHORT:
+            found = findSeeds<uint16_t>(boundary);
+            break;
+        case TLONG:
+            found = findSeeds<int32_t>(boundary);
+            break;
+        case TULONG:
+            found = findSeeds<uint32_t>(boundary);
+            break;
+        case TFLOAT:
+            found = findSeeds<float>(boundary);
+            break;
+        case TLONGLONG:
+            found = findSeeds<int64_t>(boundary);
+            break;
+        case TDOUBLE:
+            found = findSeeds<double>(boundary);
+            break;
+    }
+
+    if (found)
+        return true;
+
+    qCDebug(KSTARS_FITS) << "Incremental detection lost track of the stars, running a full detection.";
+    FITSSEPDetector fullDetector(m_ImageData);
+    fullDetector.setSettings(m_Settings);
+    return fullDetector.findSourcesAndBackground(boundary);
+}
+
+template <typename T>
+bool FITSIncrementalDetector::findSeeds(const QRect &boundary)
+{
+    if (m_Seeds.isEmpty())
+        return false;
+
+    const int searchRadius = getValue("SEARCH_RADIUS", SEARCH_RADIUS).toInt();
+    const double detectionSigma = getValue("DETECTION_SIGMA", DETECTION_SIGMA).toDouble();
+    const double minMatchFraction = getValue("MIN_MATCH_FRACTION", MIN_MATCH_FRACTION).toDouble();
+
+    const FITSImage::Statistic &stats = m_ImageData->getStatistics();
+    const int width = stats.width;
+    const QRect frame = boundary.isValid() ? boundary.intersected(QRect(0, 0, stats.width, stats.height)) :
+                        QRect(0, 0, stats.width, stats.height);
+    auto const *buffer = reinterpret_cast<T const *>(m_ImageData->getImageBuffer());
+
+    // Integer noise below one ADU is quantization, do not let it make every bump a star.
+    constexpr float minSigma = std::is_integral<T>::value ? 0.5f : std::numeric_limits<float>::epsilon();
+
+    QList<Edge *> starCenters;
+    std::vector<float> border;
+    std::vector<std::pair<float, float>> profile;
+    double backgroundSum = 0;
+    std::vector<float> sigmas;
+    int skyPixels = 0;
+
+    for (const Edge &seed : m_Seeds)
+    {
+        // The star may have moved by up to searchRadius, and we measure it out to a few HFRs.
+        const int starRadius = std::max(4, static_cast<int>(std::ceil(3 * std::max(1.0f, seed.HFR))));
+        const int halfSize = searchRadius + starRadius;
+        const int seedX = std::lround(seed.x);
+        const int seedY = std::lround(seed.y);
+        const QRect window = QRect(seedX - halfSize, seedY - halfSize, 2 * halfSize + 1, 2 * halfSize + 1).intersected(frame);
+        if (window.width() < 3 || window.height() < 3)
+            continue;
+
+        // Local background and noise from the window border, as median and MAD.
+        border.clear();
+        for (int x = window.left(); x <= window.right(); x++)
+        {
+            border.push_back(buffer[window.top() * width + x]);
+            border.push_back(buffer[window.bottom() * width + x]);
+        }
+        for (int y = window.top() + 1; y < window.bottom(); y++)
+        {
+            border.push_back(buffer[y * width + window.left()]);
+            border.push_back(buffer[y * width + window.right()]);
+        }
+        const float background = median(border);
+        for (auto &value : border)
+            value = std::fabs(value - background);
+        const float sigma = std::max(minSigma, 1.4826f * median(border));
+
+        // The brightest pixel close to where the star was.
+        const QRect searchArea = QRect(seedX - searchRadius, seedY - searchRadius, 2 * searchRadius + 1,
+                                       2 * searchRadius + 1).intersected(window);
+        int peakX = -1, peakY = -1;
+        float peak = std::numeric_limits<float>::lowest();
+        for (int y = searchArea.top(); y <= searchArea.bottom(); y++)
+            for (int x = searchArea.left(); x <= searchArea.right(); x++)
+                if (buffer[y * width + x] > peak)
+                {
+                    peak = buffer[y * width + x];
+                    peakX = x;
+                    peakY = y;
+                }
+
+        if (peakX < 0 || peak - background < detectionSigma * sigma)
+            continue;
+
+        // Flux weighted centroid and second moments around the peak.
+        double flux = 0, sumX = 0, sumY = 0, sumXX = 0, sumYY = 0, sumXY = 0;
+        int numPixels = 0;
+        profile.clear();
+        const QRect starArea = QRect(peakX - starRadius, peakY - starRadius, 2 * starRadius + 1,
+                                     2 * starRadius + 1).intersected(window);
+        for (int y = starArea.top(); y <= starArea.bottom(); y++)
+            for (int x = starArea.left(); x <= starArea.right(); x++)
+            {
+                const int dx = x - peakX, dy = y - peakY;
+                const double value = buffer[y * width + x] - background;
+                if (dx * dx + dy * dy > starRadius * starRadius || value <= 0)
+                    continue;
+                flux += value;
+                sumX += value * x;
+                sumY += value * y;
+                sumXX += value * x * x;
+                sumYY += value * y * y;
+                sumXY += value * x * y;
+                if (value > 3 * sigma)
+                    numPixels++;
+            }
+        if (flux <= 0)
+            continue;
+
+        const double cx = sumX / flux, cy = sumY / flux;
+        if (std::hypot(cx - seed.x, cy - seed.y) > searchRadius)
+            continue;
+
+        // Two seeds may converge on the same star.
+        const bool duplicate = std::any_of(starCenters.cbegin(), starCenters.cend(), [&](const Edge * star)
+        {
+            return std::hypot(star->x - cx, star->y - cy) < 1 + seed.HFR;
+        });
+        if (duplicate)
+            continue;
+
+        // Half flux radius from the cumulative radial profile.
+        for (int y = starArea.top(); y <= starArea.bottom(); y++)
+            for (int x = starArea.left(); x <= starArea.right(); x++)
+            {
+                const float value = buffer[y * width + x] - background;
+                const float distance = std::hypot(x - cx, y - cy);
+                if (distance <= starRadius && value > 0)
+                    profile.emplace_back(distance, value);
+            }
+        std::sort(profile.begin(), profile.end());
+        float profileFlux = 0;
+        for (const auto &sample : profile)
+            profileFlux += sample.second;
+        float hfr = 0, cumulated = 0;
+        for (const auto &sample : profile)
+        {
+            cumulated += sample.second;
+            if (cumulated >= profileFlux / 2)
+            {
+                hfr = sample.first;
+                break;
+            }
+        }
+
+        const double varX = sumXX / flux - cx * cx;
+        const double varY = sumYY / flux - cy * cy;
+        const double covXY = sumXY / flux - cx * cy;
+        const double root = std::sqrt((varX - varY) * (varX - varY) / 4 + covXY * covXY);
+        const double a = std::sqrt(std::max(0.0, (varX + varY) / 2 + root));
+        const double b = std::sqrt(std::max(0.0, (varX + varY) / 2 - root));
+
+        Edge *oneEdge = FITSFramePool::instance().takeEdge();
+        oneEdge->x = cx;
+        oneEdge->y = cy;
+        oneEdge->val = peak;
+        oneEdge->sum = flux;
+        oneEdge->HFR = hfr;
+        oneEdge->width = a;
+        oneEdge->numPixels = numPixels;
+        oneEdge->ellipticity = a > 0 ? 1 - b / a : 0;
+        starCenters.append(oneEdge);
+
+        backgroundSum += background;
+        sigmas.push_back(sigma);
+        skyPixels += static_cast<int>(border.size());
+    }
+
+    if (starCenters.isEmpty() || starCenters.size() < minMatchFraction * m_Seeds.size())
+    {
+        qCDebug(KSTARS_FITS) << "Incremental detection found" << starCenters.size() << "of" << m_Seeds.size() << "stars.";
+        FITSFramePool::instance().giveEdges(starCenters);
+        return false;
+    }
+
+    SkyBackground skyBG;
+    skyBG.initialize(backgroundSum / starCenters.size(), median(sigmas), skyPixels, starCenters.size());
+    m_ImageData->setSkyBackground(skyBG);
+    m_ImageData->setStarCenters(starCenters);
+    return true;
+}
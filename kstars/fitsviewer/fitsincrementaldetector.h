@@ -0,0 +1,57 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "fitsstardetector.h"
+
+/**
+ * @class FITSIncrementalDetector
+ * Frame to frame star detection, seeded with the stars found in a previous frame.
+ *
+ * Only small windows around the seeds are searched. In each window the local background is
+ * estimated from the window border, and the star is re-centroided and measured around the
+ * brightest pixel. If too few of the seeds are found again, the frame is searched from scratch
+ * with the SEP detector.
+ */
+class FITSIncrementalDetector : public FITSStarDetector
+{
+        Q_OBJECT
+
+    public:
+        explicit FITSIncrementalDetector(FITSData *data): FITSStarDetector(data) {};
+
+        /** @brief Set the stars detected in the previous frame. */
+        void setSeeds(const QList<Edge> &seeds)
+        {
+            m_Seeds = seeds;
+        }
+
+        /** @brief Find the seeds again in the parent FITS data file.
+         * @see FITSStarDetector::findSources().
+         */
+        QFuture<bool> findSources(QRect const &boundary = QRect()) override;
+
+        /** @brief Find the seeds again, falling back to a full SEP detection if too few of them are found. */
+        bool findSourcesNearSeeds(QRect const &boundary = QRect());
+
+    protected:
+        /** @group Detection parameters. Use the names as strings for FITSStarDetector::configure().
+         * @{ */
+        /** @brief Maximum distance in pixels a star may have moved since the previous frame. Configurable. */
+        int SEARCH_RADIUS { 10 };
+        /** @brief Minimum peak above background, in units of the background noise. Configurable. */
+        double DETECTION_SIGMA { 5 };
+        /** @brief Fraction of the seeds that must be found again, otherwise a full detection is run. Configurable. */
+        double MIN_MATCH_FRACTION { 0.75 };
+        /** @} */
+
+    private:
+        template <typename T>
+        bool findSeeds(const QRect &boundary);
+
+        QList<Edge> m_Seeds;
+};
@@ -0,0 +1,115 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "fitspreviewcache.h"
+
+#include "fitsdata.h"
+#include "stretch.h"
+#include "kspaths.h"
+#include "fits_debug.h"
+#include "auxiliary/executors.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QSaveFile>
+
+namespace
+{
+constexpr int JPEG_QUALITY = 85;
+
+QString previewDirectory()
+{
+    return QDir(KSPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("previews");
+}
+
+bool saveJpeg(const QImage &image, const QString &filename)
+{
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly) || !image.save(&file, "jpg", JPEG_QUALITY))
+        return false;
+    return file.commit();
+}
+}
+
+QFuture<void> FITSPreviewCache::generate(const QSharedPointer<FITSData> &data)
+{
+    return Executors::run(Executors::Background, &FITSPreviewCache::write, data);
+}
+
+QString FITSPreviewCache::previewFilename(const QString &filename, Size size)
+{
+    const QFileInfo info(filename);
+    const QByteArray key = info.absoluteFilePath().toUtf8() + '|'
+                           + QByteArray::number(info.lastModified().toMSecsSinceEpoch());
+    const QString hash = QString::fromLatin1(QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex());
+    return QDir(previewDirectory()).filePath(QString("%1_%2.jpg").arg(hash).arg(static_cast<int>(size)));
+}
+
+bool FITSPreviewCache::contains(const QString &filename)
+{
+    return QFileInfo::exists(previewFilename(filename, PREVIEW)) && QFileInfo::exists(previewFilename(filename, THUMBNAIL));
+}
+
+QImage FITSPreviewCache::load(const QString &filename, Size size)
+{
+    if (filename.isEmpty() || !QFileInfo::exists(filename))
+        return QImage();
+
+    QImageReader reader(previewFilename(filename, size), "jpg");
+    return reader.read();
+}
+
+void FITSPreviewCache::write(const QSharedPointer<FITSData> &data)
+{
+    const QString &filename = data->filename();
+    if (filename.isEmpty() || !QFileInfo::exists(filename) || data->getImageBuffer() == nullptr)
+        return;
+    if (!QDir().mkpath(previewDirectory()))
+        return;
+
+    // Stretch every n-th sample only, the preview is smaller than the image anyway.
+    const int sampling = std::max(1, data->width() / PREVIEW);
+    const int width = (data->width() + sampling - 1) / sampling;
+    const int height = (data->height() + sampling - 1) / sampling;
+    QImage image;
+    if (data->channels() == 1)
+    {
+        image = QImage(width, height, QImage::Format_Indexed8);
+        image.setColorCount(256);
+        for (int i = 0; i < 256; i++)
+            image.setColor(i, qRgb(i, i, i));
+    }
+    else
+        image = QImage(width, height, QImage::Format_RGB32);
+
+    Stretch stretch(data->width(), data->height(), data->channels(), data->dataType());
+    stretch.setParams(stretch.computeParams(data->getImageBuffer()));
+    stretch.run(data->getImageBuffer(), &image, sampling);
+
+    if (image.width() > PREVIEW)
+        image = image.scaledToWidth(PREVIEW, Qt::SmoothTransformation);
+    const QImage thumbnail = image.scaledToWidth(std::min<int>(THUMBNAIL, image.width()), Qt::SmoothTransformation);
+
+    if (!saveJpeg(image, previewFilename(filename, PREVIEW)) ||
+            !saveJpeg(thumbnail, previewFilename(filename, THUMBNAIL)))
+    {
+        qCWarning(KSTARS_FITS) << "Could not write the previews of" << filename;
+        return;
+    }
+
+    prune();
+}
+
+void FITSPreviewCache::prune()
+{
+    // Newest first
+    const QFileInfoList previews = QDir(previewDirectory()).entryInfoList(QStringList("*.jpg"), QDir::Files, QDir::Time);
+    for (int i = MAX_PREVIEWS; i < previews.size(); ++i)
+        QFile::remove(previews[i].absoluteFilePath());
+}
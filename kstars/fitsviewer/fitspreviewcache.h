@@ -0,0 +1,59 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QFuture>
+#include <QImage>
+#include <QSharedPointer>
+#include <QString>
+
+class FITSData;
+
+/**
+ * @class FITSPreviewCache
+ * Stretched 8-bit JPEG previews of saved images, kept on disk.
+ *
+ * The previews of a capture are generated once in the background from the image still in
+ * memory, at two sizes: a thumbnail and a screen sized preview. Browsing the capture history
+ * or sending a saved image remotely then reads a small JPEG instead of loading and stretching
+ * the full image again.
+ *
+ * The previews are stored in the cache folder, named after the path, size and modification
+ * time of the image, so a modified image gets new previews. The oldest previews are removed
+ * beyond MAX_PREVIEWS.
+ */
+class FITSPreviewCache
+{
+    public:
+        enum Size
+        {
+            THUMBNAIL = 320,
+            PREVIEW = 1920
+        };
+
+        /// Previews kept in all, of both sizes.
+        static constexpr int MAX_PREVIEWS = 1000;
+
+        /**
+         * @brief generate Generate the previews of a saved image in the background.
+         * @param data the image, which is kept until the previews are written.
+         */
+        static QFuture<void> generate(const QSharedPointer<FITSData> &data);
+
+        /// @return the preview of @p filename of width @p size at most, or a null image if it is not cached.
+        static QImage load(const QString &filename, Size size);
+
+        /// @return true if the previews of @p filename are cached.
+        static bool contains(const QString &filename);
+
+        /// @return the file of the preview of @p filename, whether it exists or not.
+        static QString previewFilename(const QString &filename, Size size);
+
+    private:
+        static void write(const QSharedPointer<FITSData> &data);
+        static void prune();
+};
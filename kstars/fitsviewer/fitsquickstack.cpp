@@ -0,0 +1,181 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "fitsquickstack.h"
+
+#include "config-kstars.h"
+#include "fitsdata.h"
+#include "fitsframepool.h"
+#include "Options.h"
+#ifdef HAVE_STELLARSOLVER
+#include "ekos/auxiliary/stellarsolverprofile.h"
+#endif
+
+#include <fits_debug.h>
+
+#include <algorithm>
+
+bool FITSQuickStack::add(const QSharedPointer<FITSData> &frame)
+{
+    const QList<QPointF> stars = brightestStars(frame);
+    if (m_Count == 0)
+    {
+        if (stars.size() < MIN_MATCHED_STARS)
+            return false;
+        m_ReferenceStars = stars;
+        return add(frame, QPointF());
+    }
+
+    QPointF offset;
+    if (!findOffset(m_ReferenceStars, stars, offset))
+        return false;
+    return add(frame, offset);
+}
+
+bool FITSQuickStack::add(const QSharedPointer<FITSData> &frame, const QPointF &offset)
+{
+    const FITSImage::Statistic &stats = frame->getStatistics();
+    if (m_Count == 0)
+    {
+        m_Stats = FITSImage::Statistic();
+        m_Stats.dataType = TFLOAT;
+        m_Stats.bytesPerPixel = sizeof(float);
+        m_Stats.width = stats.width;
+        m_Stats.height = stats.height;
+        m_Stats.channels = stats.channels;
+        m_Stats.samples_per_channel = stats.samples_per_channel;
+        m_Stats.size = m_Stats.samples_per_channel * m_Stats.channels * sizeof(float);
+        m_Mean.fill(0, m_Stats.samples_per_channel * m_Stats.channels);
+        m_Weight.fill(0, m_Stats.samples_per_channel);
+    }
+    else if (stats.width != m_Stats.width || stats.height != m_Stats.height || stats.channels != m_Stats.channels)
+        return false;
+
+    const QSharedPointer<const QVector<float>> samples = frame->getFloatBuffer();
+    if (samples.isNull())
+        return false;
+
+    // The pixels of the stack covered by the frame
+    const int width = m_Stats.width, height = m_Stats.height;
+    const int dx = qRound(offset.x()), dy = qRound(offset.y());
+    const int left = std::max(0, dx), right = std::min(width, width + dx);
+    const int top = std::max(0, dy), bottom = std::min(height, height + dy);
+    if (right <= left || bottom <= top)
+        return false;
+
+    const int length = right - left;
+    for (int y = top; y < bottom; y++)
+    {
+        const int row = y * width + left;
+        const int sourceRow = (y - dy) * width + left - dx;
+        float *weight = m_Weight.data() + row;
+        for (int n = 0; n < m_Stats.channels; n++)
+        {
+            float *mean = m_Mean.data() + n * m_Stats.samples_per_channel + row;
+            const float *source = samples->constData() + n * m_Stats.samples_per_channel + sourceRow;
+            // Rows are contiguous and updated without branches, a loop the compiler vectorizes.
+            for (int i = 0; i < length; i++)
+                mean[i] += (source[i] - mean[i]) / (weight[i] + 1.0f);
+        }
+        for (int i = 0; i < length; i++)
+            weight[i] += 1.0f;
+    }
+
+    m_Count++;
+    return true;
+}
+
+QSharedPointer<FITSData> FITSQuickStack::result() const
+{
+    if (m_Count == 0)
+        return QSharedPointer<FITSData>();
+
+    QSharedPointer<FITSData> data(new FITSData(FITS_NORMAL));
+    float *destination = reinterpret_cast<float *>(data->createImageBuffer(m_Stats));
+    std::copy(m_Mean.cbegin(), m_Mean.cend(), destination);
+    data->calculateStats(true);
+    return data;
+}
+
+bool FITSQuickStack::findOffset(const QList<QPointF> &reference, const QList<QPointF> &stars, QPointF &offset)
+{
+    const double tolerance = MATCH_TOLERANCE * MATCH_TOLERANCE;
+    int bestMatches = 0;
+
+    // Every pair of stars proposes the offset moving one onto the other, the offset matching the most stars wins.
+    for (const QPointF &referenceStar : reference)
+    {
+        for (const QPointF &star : stars)
+        {
+            const QPointF candidate = referenceStar - star;
+            QPointF sum;
+            int matches = 0;
+            for (const QPointF &moved : stars)
+            {
+                for (const QPointF &match : reference)
+                {
+                    const QPointF distance = match - moved - candidate;
+                    if (QPointF::dotProduct(distance, distance) <= tolerance)
+                    {
+                        sum += match - moved;
+                        matches++;
+                        break;
+                    }
+                }
+            }
+
+            if (matches > bestMatches)
+            {
+                bestMatches = matches;
+                offset = sum / matches;
+            }
+        }
+    }
+
+    return bestMatches >= MIN_MATCHED_STARS;
+}
+
+FITSQuickStack FITSQuickStack::stackFiles(const QStringList &filenames)
+{
+    FITSQuickStack stack;
+    for (const auto &filename : filenames)
+    {
+        QSharedPointer<FITSData> frame(new FITSData(FITS_NORMAL));
+        // The frames of a session have the same size, so their buffers are recycled.
+        frame->setPooledBuffer(true);
+        if (!frame->loadFromFile(filename).result())
+            qCWarning(KSTARS_FITS) << "Quick stack failed to load" << filename;
+        else if (!stack.add(frame))
+            qCInfo(KSTARS_FITS) << "Quick stack skipped" << filename << "as its stars do not match the first frame";
+    }
+
+    FITSFramePool::instance().release(FITS_NORMAL);
+    qCInfo(KSTARS_FITS) << "Quick stacked" << stack.count() << "of" << filenames.size() << "frames";
+    return stack;
+}
+
+QList<QPointF> FITSQuickStack::brightestStars(const QSharedPointer<FITSData> &frame)
+{
+#ifdef HAVE_STELLARSOLVER
+    QVariantMap extractionSettings;
+    extractionSettings["optionsProfileIndex"] = Options::hFROptionsProfile();
+    extractionSettings["optionsProfileGroup"] = static_cast<int>(Ekos::HFRProfiles);
+    frame->setSourceExtractorSettings(extractionSettings);
+#endif
+
+    QList<QPointF> stars;
+    if (!frame->findStars(ALGORITHM_SEP).result())
+        return stars;
+
+    QList<Edge *> centers = frame->getStarCenters();
+    std::sort(centers.begin(), centers.end(), [](const Edge * a, const Edge * b)
+    {
+        return a->sum > b->sum;
+    });
+    for (int i = 0; i < centers.size() && i < MAX_ALIGN_STARS; i++)
+        stars.append(QPointF(centers[i]->x, centers[i]->y));
+    return stars;
+}
@@ -0,0 +1,74 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "fitsviewer/structuredefinitions.h"
+
+#include <QList>
+#include <QPointF>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QVector>
+
+class FITSData;
+
+/**
+ * @class FITSQuickStack
+ * @short Averages frames of the same field, aligned on their stars, to check the framing of a session.
+ *
+ * Each frame is shifted onto the first one by the translation matching the most of their brightest
+ * stars, found by the star detection of FITSData, and added to the running mean of the frames covering
+ * each pixel. Rotation and scale are not corrected, and frames are shifted by whole pixels, which is
+ * enough to judge framing and depth from the subs of a night.
+ */
+class FITSQuickStack
+{
+    public:
+        /// Brightest stars of each frame that are matched
+        static constexpr int MAX_ALIGN_STARS = 40;
+        /// Stars matched at most this far apart, in pixels
+        static constexpr double MATCH_TOLERANCE = 2.0;
+        /// Fewest stars matched to align a frame
+        static constexpr int MIN_MATCHED_STARS = 3;
+
+        /**
+         * @brief add Detects the stars of @p frame and adds it aligned on the first frame added.
+         * @return false if the frame differs in size from the first one, or its stars do not match.
+         */
+        bool add(const QSharedPointer<FITSData> &frame);
+        /** @brief add @p frame shifted by @p offset, rounded to whole pixels */
+        bool add(const QSharedPointer<FITSData> &frame, const QPointF &offset);
+
+        int count() const
+        {
+            return m_Count;
+        }
+
+        /** @return the mean of the frames added so far as a float image, null if none was added */
+        QSharedPointer<FITSData> result() const;
+
+        /**
+         * @brief findOffset Finds the translation moving the most of @p stars onto @p reference.
+         * @param offset set to the mean offset of the matched stars.
+         * @return false if fewer than MIN_MATCHED_STARS match.
+         */
+        static bool findOffset(const QList<QPointF> &reference, const QList<QPointF> &stars, QPointF &offset);
+
+        /** @brief Loads and stacks @p filenames in the calling thread */
+        static FITSQuickStack stackFiles(const QStringList &filenames);
+
+    private:
+        static QList<QPointF> brightestStars(const QSharedPointer<FITSData> &frame);
+
+        FITSImage::Statistic m_Stats;
+        QList<QPointF> m_ReferenceStars;
+        /// Running mean of each channel, the channels one after another
+        QVector<float> m_Mean;
+        /// Number of frames covering each pixel, as a float for the mean update
+        QVector<float> m_Weight;
+        int m_Count { 0 };
+};
@@ -13,13 +13,18 @@
 #include "fits_debug.h"
 #include "fitssepdetector.h"
 #include "fitsdata.h"
+#include "fitsframepool.h"
 #include "Options.h"
 #include "kspaths.h"
+#include "auxiliary/tracer.h"
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
+#include <vector>
 #include <math.h>
 #include <QPointer>
-#include <QtConcurrent>
+#include <QThread>
 
 #ifdef HAVE_STELLARSOLVER
 #include "ekos/auxiliary/stellarsolverprofileeditor.h"
@@ -53,13 +58,40 @@
 // (e.g. unfiltered number of stars detected,background sky level). Waiting on rlancaste's
 // investigations into SEP before doing this.
 
+#ifdef HAVE_STELLARSOLVER
+namespace
+{
+// Areas with fewer pixels are extracted in one piece, splitting them would not pay off.
+constexpr int64_t MIN_STRIP_PIXELS = 4 * 1024 * 1024;
+// Strips are at least this high, so that their overlap stays small compared to them.
+constexpr int MIN_STRIP_HEIGHT = 512;
+// Rows each strip extends into its neighbours, so that a star on a seam is seen whole by both strips.
+constexpr int STRIP_OVERLAP = 64;
+// Distance in pixels under which two detections from neighbouring strips are the same star.
+constexpr double SEAM_TOLERANCE = 2;
+
+struct Strip
+{
+    // Rows owned by the strip, stars centered in there are kept.
+    int coreTop { 0 };
+    int coreBottom { 0 };
+    // Area actually extracted, the core plus the overlap with the neighbours.
+    QRect area;
+    QList<FITSImage::Star> stars;
+    FITSImage::Background background;
+};
+}
+#endif
+
 QFuture<bool> FITSSEPDetector::findSources(QRect const &boundary)
 {
-    return QtConcurrent::run(this, &FITSSEPDetector::findSourcesAndBackground, boundary);
+    return Executors::run(m_ImageData->executorPriority(), &FITSSEPDetector::findSourcesAndBackground, this, boundary);
 }
 
 bool FITSSEPDetector::findSourcesAndBackground(QRect const &boundary)
 {
+    KSTARS_TRACE_SPAN("fits", "Star detection");
+
 #ifndef HAVE_STELLARSOLVER
     Q_UNUSED(boundary)
     return false;
@@ -70,8 +102,6 @@ bool FITSSEPDetector::findSourcesAndBackground(QRect const &boundary)
 
     int optionsProfileIndex = getValue("optionsProfileIndex", -1).toInt();
     Ekos::ProfileGroup group = static_cast<Ekos::ProfileGroup>(getValue("optionsProfileGroup", 1).toInt());
-    QScopedPointer<StellarSolver, QScopedPointerDeleteLater> solver(new StellarSolver(m_ImageData->getStatistics(),
-            m_ImageData->getImageBuffer()));
     QString filename = "";
     QPointer<FITSData> image(m_ImageData);
     switch(group)
@@ -112,48 +142,162 @@ bool FITSSEPDetector::findSourcesAndBackground(QRect const &boundary)
                 break;
         }
     }
+    SSolver::Parameters params;  // This is default
     if (optionsProfileIndex >= 0 && optionsList.count() > optionsProfileIndex)
     {
-        auto params = optionsList[optionsProfileIndex];
-        params.partition = Options::stellarSolverPartition();
-        solver->setParameters(params);
+        params = optionsList[optionsProfileIndex];
         qCDebug(KSTARS_FITS) << "Sextract with: " << optionsList[optionsProfileIndex].listName;
     }
-    else
+    params.partition = Options::stellarSolverPartition();
+
+    const bool runHFR = group != Ekos::AlignProfiles;
+    const FITSImage::Statistic &stats = m_ImageData->getStatistics();
+    const QRect frame(0, 0, stats.width, stats.height);
+    const QRect area = boundary.isValid() ? boundary.intersected(frame) : frame;
+
+    // Large areas are split in horizontal strips overlapping by a few rows, extracted in parallel.
+    // Each strip keeps the stars centered in its own rows, with a small tolerance on both sides of
+    // the seams so that a star whose centroid moves slightly between two strips is not lost. The
+    // duplicates this tolerance leaves on the seams are then merged.
+    int numStrips = 1;
+    if (Options::stellarSolverStrips() && static_cast<int64_t>(area.width()) * area.height() >= MIN_STRIP_PIXELS)
+        numStrips = qBound(1, area.height() / MIN_STRIP_HEIGHT, QThread::idealThreadCount());
+    const int stripHeight = (area.height() + numStrips - 1) / numStrips;
+
+    std::vector<Strip> strips(numStrips);
+    for (int i = 0; i < numStrips; i++)
     {
-        auto params = SSolver::Parameters();  // This is default
-        params.partition = Options::stellarSolverPartition();
-        solver->setParameters(params);
+        Strip &strip = strips[i];
+        strip.coreTop = area.top() + i * stripHeight;
+        strip.coreBottom = std::min(area.top() + area.height(), strip.coreTop + stripHeight);
+        const int top = std::max(area.top(), strip.coreTop - STRIP_OVERLAP);
+        const int bottom = std::min(area.top() + area.height(), strip.coreBottom + STRIP_OVERLAP);
+        strip.area = QRect(area.left(), top, area.width(), bottom - top);
     }
 
-    QList<FITSImage::Star> stars;
-    const bool runHFR = group != Ekos::AlignProfiles;
+    // The strips already keep all the threads busy, StellarSolver must not partition them again.
+    // The number of stars to keep applies to the whole area, so it is applied once the strips are merged.
+    const int keepNum = params.keepNum;
+    if (numStrips > 1)
+    {
+        params.partition = false;
+        params.keepNum = 0;
+    }
+
+    auto extractStrip = [&](Strip & strip)
+    {
+        QScopedPointer<StellarSolver, QScopedPointerDeleteLater> solver(new StellarSolver(stats, m_ImageData->getImageBuffer()));
+        solver->setParameters(params);
+        solver->setLogLevel(SSolver::LOG_NONE);
+        solver->setSSLogLevel(SSolver::LOG_OFF);
+
+        if (numStrips > 1 || boundary.isValid())
+            solver->extract(runHFR, strip.area);
+        else
+            solver->extract(runHFR);
 
-    solver->setLogLevel(SSolver::LOG_NONE);
-    solver->setSSLogLevel(SSolver::LOG_OFF);
+        strip.stars = solver->getStarList();
+        strip.background = solver->getBackground();
+    };
 
-    if (boundary.isValid())
-        solver->extract(runHFR, boundary);
+    if (numStrips > 1)
+        Executors::blockingMap(m_ImageData->executorPriority(), strips, extractStrip);
     else
-        solver->extract(runHFR);
-
-    stars = solver->getStarList();
+        extractStrip(strips[0]);
 
     // If m_ImageData goes out of scope, also return.
-    if (stars.empty() || image.isNull())
+    if (image.isNull())
         return false;
 
-    auto bg = solver->getBackground();
+    QList<FITSImage::Star> stars;
+    for (int i = 0; i < numStrips; i++)
+    {
+        const Strip &strip = strips[i];
+        const double top = i > 0 ? strip.coreTop - SEAM_TOLERANCE : -1;
+        const double bottom = i < numStrips - 1 ? strip.coreBottom + SEAM_TOLERANCE : stats.height + 1;
+        const int previousCount = stars.count();
+        for (const auto &star : strip.stars)
+        {
+            if (star.y < top || star.y >= bottom)
+                continue;
+
+            // Only stars near the seam with the previous strip may have been kept twice.
+            const bool duplicate = i > 0 && star.y < strip.coreTop + SEAM_TOLERANCE &&
+                                   std::any_of(stars.cbegin(), stars.cbegin() + previousCount, [&](const FITSImage::Star & other)
+            {
+                return std::hypot(other.x - star.x, other.y - star.y) < SEAM_TOLERANCE;
+            });
+            if (duplicate == false)
+                stars.append(star);
+        }
+    }
+
+    if (numStrips > 1 && keepNum > 0 && stars.count() > keepNum)
+    {
+        // Like StellarSolver, keep the brightest ones.
+        std::stable_sort(stars.begin(), stars.end(), [](const FITSImage::Star & a, const FITSImage::Star & b)
+        {
+            return a.mag < b.mag;
+        });
+        stars.erase(stars.begin() + keepNum, stars.end());
+    }
+
+    if (stars.empty())
+        return false;
 
-    skyBG.mean = bg.global;
-    skyBG.sigma = bg.globalrms;
-    skyBG.numPixelsInSkyEstimate = bg.bw * bg.bh;
-    skyBG.setStarsDetected(bg.num_stars_detected);
+    if (numStrips == 1)
+    {
+        const auto &bg = strips[0].background;
+        skyBG.mean = bg.global;
+        skyBG.sigma = bg.globalrms;
+        skyBG.numPixelsInSkyEstimate = bg.bw * bg.bh;
+        skyBG.setStarsDetected(bg.num_stars_detected);
+    }
+    else
+    {
+        // Combine the strip backgrounds, weighted by their areas.
+        double pixels = 0, mean = 0, variance = 0;
+        int64_t skyPixels = 0;
+        for (const auto &strip : strips)
+        {
+            const double stripPixels = static_cast<double>(strip.area.width()) * strip.area.height();
+            pixels += stripPixels;
+            mean += strip.background.global * stripPixels;
+            variance += strip.background.globalrms * strip.background.globalrms * stripPixels;
+            skyPixels += static_cast<int64_t>(strip.background.bw) * strip.background.bh;
+        }
+        skyBG.mean = mean / pixels;
+        skyBG.sigma = std::sqrt(variance / pixels);
+        skyBG.numPixelsInSkyEstimate = static_cast<int>(skyPixels);
+        skyBG.setStarsDetected(stars.count());
+    }
     m_ImageData->setSkyBackground(skyBG);
 
-    //There is more information that can be obtained by the Stellarsolver->
-    //Background info, Star positions(if a plate solve was done before), etc
-    //The information is available as long as the StellarSolver exists.
+    // Callers that only need aggregates get the stars folded into statistics, without a list of Edges
+    if (getValue("statisticsOnly", false).toBool())
+    {
+        StarStatistics statistics(getValue("statisticsColumns", 1).toInt(), getValue("statisticsRows", 1).toInt());
+        statistics.reset(m_ImageData->width(), m_ImageData->height());
+        if (runHFR)
+            statistics.setSaturation(m_ImageData->getStatistics().dataType == TBYTE ? 250 : 50000);
+        // Only select when there are more stars than the caller wants, the order doesn't matter
+        if (stars.count() > maxStarsCount)
+        {
+            auto first = [runHFR](const FITSImage::Star & star1, const FITSImage::Star & star2) -> bool
+            {
+                return runHFR ? star1.HFR > star2.HFR : star1.flux > star2.flux;
+            };
+            std::nth_element(stars.begin(), stars.begin() + maxStarsCount, stars.end(), first);
+        }
+        const int starCount = qMin(maxStarsCount, stars.count());
+        for (int i = 0; i < starCount; i++)
+        {
+            const FITSImage::Star &star = stars[i];
+            statistics.add(star.x, star.y, star.HFR, star.a > 0 ? 1 - star.b / star.a : 0, star.peak);
+        }
+        m_ImageData->setStarStatistics(statistics);
+        return true;
+    }
 
     // Let's sort edges, starting with widest
     if (runHFR)
@@ -167,7 +311,7 @@ bool FITSSEPDetector::findSourcesAndBackground(QRect const &boundary)
     starCenters.reserve(starCount);
     for (int i = 0; i < starCount; i++)
     {
-        Edge *oneEdge = new Edge();
+        Edge *oneEdge = FITSFramePool::instance().takeEdge();
         oneEdge->x = stars[i].x;
         oneEdge->y = stars[i].y;
         oneEdge->val = stars[i].peak;
@@ -91,7 +91,7 @@ void FITSStretchUI::onHistoDoubleClick(QMouseEvent *event)
 void FITSStretchUI::onHistoMouseMove(QMouseEvent *event)
 {
     const auto image = m_View->imageData();
-    if (!image->isHistogramConstructed())
+    if (!image || !image->isHistogramConstructed())
         return;
 
     const bool rgbHistogram = (image->channels() > 1);
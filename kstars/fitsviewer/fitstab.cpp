@@ -8,10 +8,13 @@
 
 #include "auxiliary/kspaths.h"
 #include "fitsdata.h"
+#include "fitsframepool.h"
 #include "fitshistogrameditor.h"
 #include "fitshistogramcommand.h"
+#include "fitspreviewcache.h"
 #include "fitsview.h"
 #include "fitsviewer.h"
+#include "imagememory.h"
 #include "ksnotification.h"
 #include "kstars.h"
 #include "Options.h"
@@ -27,6 +30,8 @@
 
 #include <fits_debug.h>
 
+#include <algorithm>
+
 QPointer<Ekos::StellarSolverProfileEditor> FITSTab::m_ProfileEditor;
 QPointer<KConfigDialog> FITSTab::m_EditorDialog;
 QPointer<KPageWidgetItem> FITSTab::m_ProfileEditorPage;
@@ -51,6 +56,16 @@ FITSTab::FITSTab(FITSViewer *parent) : QWidget(parent)
 
 FITSTab::~FITSTab()
 {
+    if (m_BlinkFilenames.isEmpty())
+        return;
+
+    for (const auto &frame : m_BlinkFrames)
+        frame.future.waitForFinished();
+    for (const auto &frame : m_DroppedBlinkFrames)
+        frame.future.waitForFinished();
+    m_BlinkFrames.clear();
+    m_DroppedBlinkFrames.clear();
+    FITSFramePool::instance().release(FITS_NORMAL);
 }
 
 void FITSTab::saveUnsaved()
@@ -214,10 +229,16 @@ bool FITSTab::setupView(FITSMode mode, FITSScale filter)
 }
 
 void FITSTab::loadFile(const QUrl &imageURL, FITSMode mode, FITSScale filter)
+{
+    if (setFile(imageURL, mode, filter))
+        reload();
+}
+
+bool FITSTab::setFile(const QUrl &imageURL, FITSMode mode, FITSScale filter)
 {
     // check if the address points to an appropriate address
     if (imageURL.isEmpty() || !imageURL.isValid() || !QFileInfo::exists(imageURL.toLocalFile()))
-        return;
+        return false;
 
     if (setupView(mode, filter))
     {
@@ -225,6 +246,7 @@ void FITSTab::loadFile(const QUrl &imageURL, FITSMode mode, FITSScale filter)
         // On Success loading image
         connect(m_View.get(), &FITSView::loaded, this, [&]()
         {
+            m_Loaded = true;
             processData();
             emit loaded();
         });
@@ -239,7 +261,26 @@ void FITSTab::loadFile(const QUrl &imageURL, FITSMode mode, FITSScale filter)
 
     m_View->setFilter(filter);
 
-    m_View->loadFile(imageURL.toLocalFile());
+    return true;
+}
+
+void FITSTab::reload()
+{
+    m_View->loadFile(currentURL.toLocalFile());
+}
+
+bool FITSTab::unload()
+{
+    // Only images that can be loaded again from their file as they are.
+    if (!m_Loaded || m_View->getMode() != FITS_NORMAL || !undoStack->isClean() || currentURL.isEmpty() ||
+            !QFileInfo::exists(currentURL.toLocalFile()))
+        return false;
+
+    m_Loaded = false;
+    m_HistogramEditor->setImageData(QSharedPointer<FITSData>());
+    m_View->clearData(QPixmap::fromImage(FITSPreviewCache::load(currentURL.toLocalFile(), FITSPreviewCache::PREVIEW)));
+    qCDebug(KSTARS_FITS) << "Unloaded" << currentURL.toLocalFile();
+    return true;
 }
 
 bool FITSTab::shouldComputeHFR() const
@@ -257,6 +298,17 @@ void FITSTab::processData()
 
     m_HistogramEditor->setImageData(imageData);
 
+    // Over the image memory budget, images of files in hidden tabs are released until they are shown again
+    if (!currentURL.isEmpty())
+    {
+        QPointer<FITSTab> tab(this);
+        ImageMemory::instance().setOwner(imageData.get(), ImageMemory::Viewer);
+        ImageMemory::instance().setEvictor(imageData.get(), [tab]()
+        {
+            return !tab.isNull() && !tab->viewer.isNull() && !tab->viewer->isCurrentTab(tab) && tab->unload();
+        });
+    }
+
     // Only construct histogram if it is actually visible
     // Otherwise wait until histogram is needed before creating it.
     //    if (fitsSplitter->sizes().at(0) != 0 && !imageData->isHistogramConstructed() &&
@@ -304,6 +356,83 @@ void FITSTab::processData()
     //        m_HistogramEditor->createNonLinearHistogram();
 
     stretchUI->generateHistogram();
+
+    if (m_BlinkFilenames.size() > 1)
+        preloadBlinkFrames();
+}
+
+void FITSTab::loadBlinkFrame()
+{
+    const QUrl imageURL = QUrl::fromLocalFile(m_BlinkFilenames[m_BlinkIndex]);
+
+    // The stretch of the first image is kept, so that the images compare
+    if (m_View && m_View->imageData() && m_View->getAutoStretch())
+        m_View->keepStretchParams();
+
+    const BlinkFrame frame = m_BlinkFrames.take(m_BlinkIndex);
+    if (frame.data.isNull())
+    {
+        loadFile(imageURL, FITS_NORMAL, FITS_NONE);
+        return;
+    }
+
+    // Finishing the load in progress is faster than starting over
+    if (!frame.future.result())
+    {
+        emit failed(frame.data->getLastError());
+        return;
+    }
+
+    modifyFITSState(true, imageURL);
+    currentURL = imageURL;
+    m_View->setFilter(FITS_NONE);
+    m_View->loadData(frame.data);
+}
+
+bool FITSTab::isBlinkFrameLoading(int index) const
+{
+    const auto frame = m_BlinkFrames.find(index);
+    return frame != m_BlinkFrames.cend() && !frame->future.isFinished();
+}
+
+void FITSTab::preloadBlinkFrames()
+{
+    m_DroppedBlinkFrames.erase(std::remove_if(m_DroppedBlinkFrames.begin(), m_DroppedBlinkFrames.end(),
+                               [](const BlinkFrame & frame)
+    {
+        return frame.future.isFinished();
+    }), m_DroppedBlinkFrames.end());
+
+    const int count = m_BlinkFilenames.size();
+    QMap<int, BlinkFrame> frames;
+    for (const int index : { (m_BlinkIndex + 1) % count, (m_BlinkIndex + count - 1) % count })
+    {
+        if (index == m_BlinkIndex || frames.contains(index))
+            continue;
+
+        BlinkFrame frame = m_BlinkFrames.take(index);
+        if (frame.data.isNull())
+        {
+            frame.data.reset(new FITSData(FITS_NORMAL));
+            frame.data->setPooledBuffer(true);
+            ImageMemory::instance().setOwner(frame.data.get(), ImageMemory::Viewer);
+            if (m_View->imageData() && m_View->imageData()->hasDebayer())
+            {
+                BayerParams param;
+                m_View->imageData()->getBayerParams(&param);
+                frame.data->setBayerParams(&param);
+            }
+            frame.future = frame.data->loadFromFile(m_BlinkFilenames[index]);
+        }
+        frames.insert(index, frame);
+    }
+
+    for (const auto &frame : m_BlinkFrames)
+    {
+        if (!frame.future.isFinished())
+            m_DroppedBlinkFrames.append(frame);
+    }
+    m_BlinkFrames = frames;
 }
 
 bool FITSTab::loadData(const QSharedPointer<FITSData> &data, FITSMode mode, FITSScale filter)
@@ -328,6 +457,7 @@ bool FITSTab::loadData(const QSharedPointer<FITSData> &data, FITSMode mode, FITS
         return false;
     }
 
+    m_Loaded = true;
     processData();
     return true;
 }
@@ -628,6 +758,7 @@ void FITSTab::setupSolver(bool extractOnly)
         m_Solver.reset(new SolverUtils(parameters, parameters.solverTimeLimit, SSolver::SOLVE),  &QObject::deleteLater);
         connect(m_Solver.get(), &SolverUtils::done, this, &FITSTab::solverDone, Qt::UniqueConnection);
     }
+    m_Solver->setPriority(SolverUtils::INTERACTIVE_PRIORITY);
 
     const int imageWidth = m_View->imageData()->width();
     const int imageHeight = m_View->imageData()->height();
@@ -19,6 +19,7 @@
 #include <QFuture>
 #include <QPointer>
 #include <QListWidget>
+#include <QMap>
 #include <QLabel>
 #include <QPushButton>
 #include <memory>
@@ -67,6 +68,22 @@ class FITSTab : public QWidget
         void loadFile(const QUrl &imageURL, FITSMode mode = FITS_NORMAL, FITSScale filter = FITS_NONE);
         bool loadData(const QSharedPointer<FITSData> &data, FITSMode mode = FITS_NORMAL, FITSScale filter = FITS_NONE);
 
+        // Methods to load the image of a tab only once it is shown, and to release it
+        // when it has not been shown for a while.
+        /** @brief Sets up the tab for the image without loading it, see reload() */
+        bool setFile(const QUrl &imageURL, FITSMode mode = FITS_NORMAL, FITSScale filter = FITS_NONE);
+        /** @brief Loads the image of the tab, emitting loaded() or failed() */
+        void reload();
+        /**
+         * @brief Releases the image, showing its cached preview until it is reloaded.
+         * @return false if the image cannot be loaded again as it is, e.g. it was modified.
+         */
+        bool unload();
+        bool isLoaded() const
+        {
+            return m_Loaded;
+        }
+
         // Methods to setup and control blinking--loading a directory of images one-by-one
         // into a single tab.
         void initBlink(const QList<QString> &filenames)
@@ -86,6 +103,13 @@ class FITSTab : public QWidget
             if (index >= 0 && index < m_BlinkFilenames.size())
                 m_BlinkIndex = index;
         };
+        /**
+         * @brief loadBlinkFrame Shows the image of blinkUpto() with the stretch of the image shown, from the
+         * images preloaded around the previous one, emitting loaded() or failed().
+         */
+        void loadBlinkFrame();
+        /** @return true while the image of blink index @p index is preloading */
+        bool isBlinkFrameLoading(int index) const;
 
         bool saveImage(const QString &filename);
 
@@ -183,6 +207,8 @@ class FITSTab : public QWidget
         QUrl currentURL;
 
         bool mDirty { false };
+        // Whether the image of the view is loaded, see unload()
+        bool m_Loaded { false };
         QString previewText;
         int uid { 0 };
 
@@ -203,6 +229,18 @@ class FITSTab : public QWidget
         QList<QString> m_BlinkFilenames;
         int m_BlinkIndex { 0 };
 
+        // The images before and after the blink index are loaded in the background, into buffers of the
+        // FITSFramePool since they all have the same size.
+        void preloadBlinkFrames();
+        struct BlinkFrame
+        {
+            QSharedPointer<FITSData> data;
+            QFuture<bool> future;
+        };
+        QMap<int, BlinkFrame> m_BlinkFrames;
+        // Frames no longer adjacent, kept until they finish loading
+        QList<BlinkFrame> m_DroppedBlinkFrames;
+
         // The StellarSolverProfileEditor is shared among all tabs of all FITS Viewers.
         // They all edit the same (align) profiles.
         static QPointer<Ekos::StellarSolverProfileEditor> m_ProfileEditor;
@@ -10,11 +10,11 @@
 
 #include <math.h>
 #include <cmath>
-#include <QtConcurrent>
 
 #include "fits_debug.h"
 #include "fitsthresholddetector.h"
 #include "fitsdata.h"
+#include "auxiliary/tracer.h"
 
 //void FITSThresholdDetector::configure(const QString &setting, const QVariant &value)
 //{
@@ -29,29 +29,29 @@ QFuture<bool> FITSThresholdDetector::findSources(QRect const &boundary)
     switch (stats.dataType)
     {
         case TSHORT:
-            return QtConcurrent::run(this, &FITSThresholdDetector::findOneStar<int16_t>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSThresholdDetector::findOneStar<int16_t>, this, boundary);
 
         case TUSHORT:
-            return QtConcurrent::run(this, &FITSThresholdDetector::findOneStar<uint16_t>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSThresholdDetector::findOneStar<uint16_t>, this, boundary);
 
         case TLONG:
-            return QtConcurrent::run(this, &FITSThresholdDetector::findOneStar<int32_t>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSThresholdDetector::findOneStar<int32_t>, this, boundary);
 
         case TULONG:
-            return QtConcurrent::run(this, &FITSThresholdDetector::findOneStar<uint32_t>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSThresholdDetector::findOneStar<uint32_t>, this, boundary);
 
         case TFLOAT:
-            return QtConcurrent::run(this, &FITSThresholdDetector::findOneStar<float>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSThresholdDetector::findOneStar<float>, this, boundary);
 
         case TLONGLONG:
-            return QtConcurrent::run(this, &FITSThresholdDetector::findOneStar<int64_t>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSThresholdDetector::findOneStar<int64_t>, this, boundary);
 
         case TDOUBLE:
-            return QtConcurrent::run(this, &FITSThresholdDetector::findOneStar<double>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSThresholdDetector::findOneStar<double>, this, boundary);
 
         case TBYTE:
         default:
-            return QtConcurrent::run(this, &FITSThresholdDetector::findOneStar<uint8_t>, boundary);
+            return Executors::run(m_ImageData->executorPriority(), &FITSThresholdDetector::findOneStar<uint8_t>, this, boundary);
     }
 
 }
@@ -59,6 +59,8 @@ QFuture<bool> FITSThresholdDetector::findSources(QRect const &boundary)
 template <typename T>
 bool FITSThresholdDetector::findOneStar(const QRect &boundary) const
 {
+    KSTARS_TRACE_SPAN("fits", "Star detection");
+
     FITSImage::Statistic const &stats = m_ImageData->getStatistics();
 
     int subX = boundary.x();
@@ -18,6 +18,7 @@
 #include "skymap.h"
 
 #include "stretch.h"
+#include "auxiliary/executors.h"
 
 #ifdef HAVE_STELLARSOLVER
 #include "ekos/auxiliary/stellarsolverprofileeditor.h"
@@ -30,7 +31,6 @@
 
 #include <KActionCollection>
 
-#include <QtConcurrent>
 #include <QScrollBar>
 #include <QToolBar>
 #include <QGraphicsOpacityEffect>
@@ -334,7 +334,7 @@ void FITSView::setCursorMode(CursorMode mode)
     {
         if (m_ImageData->getWCSState() == FITSData::Idle && !wcsWatcher.isRunning())
         {
-            QFuture<bool> future = QtConcurrent::run(m_ImageData.data(), &FITSData::loadWCS);
+            QFuture<bool> future = Executors::run(Executors::Background, &FITSData::loadWCS, m_ImageData.data());
             wcsWatcher.setFuture(future);
         }
     }
@@ -390,19 +390,23 @@ void FITSView::loadFile(const QString &inFilename)
     fitsWatcher.setFuture(m_ImageData->loadFromFile(inFilename));
 }
 
-void FITSView::clearData()
+void FITSView::clearData(const QPixmap &placeholder)
 {
     if (!noImageLabel)
     {
         noImageLabel = new QLabel();
-        noImage.load(":/images/noimage.png");
-        noImageLabel->setPixmap(noImage);
         noImageLabel->setAlignment(Qt::AlignCenter);
     }
 
+    noImage = placeholder.isNull() ? QPixmap(":/images/noimage.png") : placeholder;
+    noImageLabel->setPixmap(noImage.scaled(qMax(width() - 20, 1), qMax(height() - 20, 1), Qt::KeepAspectRatio,
+                                           Qt::FastTransformation));
+
     setWidget(noImageLabel);
 
     m_ImageData.clear();
+    rawImage = QImage();
+    m_ImagePyramid.clear();
 }
 
 bool FITSView::loadData(const QSharedPointer<FITSData> &data)
@@ -523,7 +527,7 @@ bool FITSView::processData()
             Options::autoWCS() &&
             !wcsWatcher.isRunning())
     {
-        QFuture<bool> future = QtConcurrent::run(m_ImageData.data(), &FITSData::loadWCS);
+        QFuture<bool> future = Executors::run(Executors::Background, &FITSData::loadWCS, m_ImageData.data());
         wcsWatcher.setFuture(future);
     }
     else
@@ -679,6 +683,7 @@ bool FITSView::rescale(FITSZoom type)
     initDisplayImage();
     m_ImageFrame->setScaledContents(true);
     doStretch(&rawImage);
+    m_ImagePyramid.setBase(rawImage);
     setWidget(m_ImageFrame);
 
     // This is needed by fitstab, even if the zoom doesn't change, to change the stretch UI.
@@ -797,7 +802,7 @@ bool FITSView::isLargeImage()
 // and get scale returns the ratio of that pixmap size to the image size.
 double FITSView::getScale()
 {
-    return (isLargeImage() ? 1.0 : currentZoom / ZOOM_DEFAULT) / m_PreviewSampling;
+    return (isLargeImage() ? 1.0 / m_PyramidSampling : currentZoom / ZOOM_DEFAULT) / m_PreviewSampling;
 }
 
 // scaleSize() is only used with the large-image rendering strategy. It may increase the line
@@ -807,7 +812,7 @@ double FITSView::scaleSize(double size)
 {
     if (!isLargeImage())
         return size;
-    return (currentZoom > 100.0 ? size : std::round(size * 100.0 / currentZoom)) / m_PreviewSampling;
+    return (currentZoom > 100.0 ? size : std::round(size * 100.0 / currentZoom)) / (m_PreviewSampling * m_PyramidSampling);
 }
 
 void FITSView::updateFrame(bool now)
@@ -847,7 +852,7 @@ void FITSView::updateFrame(bool now)
 }
 
 
-bool FITSView::initDisplayPixmap(QImage &image, float scale)
+bool FITSView::initDisplayPixmap(const QImage &image, float scale)
 {
     ImageMosaicMask *mask = dynamic_cast<ImageMosaicMask *>(m_ImageMask.get());
 
@@ -880,7 +885,14 @@ bool FITSView::initDisplayPixmap(QImage &image, float scale)
 
 void FITSView::updateFrameLargeImage()
 {
-    if (!initDisplayPixmap(rawImage, 1.0 / m_PreviewSampling))
+    // When zoomed out, render from the pyramid level closest to the displayed size, so that
+    // the pixmap we convert, annotate and let the label scale down is not the full image.
+    const int level = m_ImagePyramid.levelForScale(m_PreviewSampling * currentZoom / ZOOM_DEFAULT);
+    const QImage &levelImage = m_ImagePyramid.level(level);
+    m_PyramidSampling = levelImage.isNull() ? 1 : (1 << level);
+    const double sampling = m_PyramidSampling * m_PreviewSampling;
+
+    if (!initDisplayPixmap(levelImage.isNull() ? rawImage : levelImage, 1.0 / sampling))
         return;
     QPainter painter(&displayPixmap);
     // Possibly scale the fonts as we're drawing on the full image, not just the visible part of the scroll window.
@@ -888,14 +900,15 @@ void FITSView::updateFrameLargeImage()
     font.setPixelSize(scaleSize(FONT_SIZE));
     painter.setFont(font);
 
-    drawStarRingFilter(&painter, 1.0 / m_PreviewSampling, dynamic_cast<ImageRingMask *>(m_ImageMask.get()));
-    drawOverlay(&painter, 1.0 / m_PreviewSampling);
+    drawStarRingFilter(&painter, 1.0 / sampling, dynamic_cast<ImageRingMask *>(m_ImageMask.get()));
+    drawOverlay(&painter, 1.0 / sampling);
     m_ImageFrame->setPixmap(displayPixmap);
-    m_ImageFrame->resize(((m_PreviewSampling * currentZoom) / 100.0) * displayPixmap.size());
+    m_ImageFrame->resize(((sampling * currentZoom) / 100.0) * displayPixmap.size());
 }
 
 void FITSView::updateFrameSmallImage()
 {
+    m_PyramidSampling = 1;
     QImage scaledImage = rawImage.scaled(currentWidth, currentHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation);
     if (!initDisplayPixmap(scaledImage, currentZoom / ZOOM_DEFAULT))
         return;
@@ -1644,7 +1657,10 @@ void FITSView::drawEQGrid(QPainter * painter, double scale)
 
         painter->setPen(QPen(Qt::yellow));
 
-        QPointF pixelPoint, imagePoint, pPoint;
+        QPointF imagePoint, pPoint;
+        // Points of a grid line, converted to pixels at once
+        QVector<QPointF> linePoints, linePixels;
+        QVector<bool> lineValid;
 
         //This section draws the RA Gridlines
 
@@ -1659,15 +1675,14 @@ void FITSView::drawEQGrid(QPainter * painter, double scale)
             double increment = std::abs((maxDec - minDec) /
                                         100.0); //This will determine how many points to use to create the RA Line
 
+            linePoints.clear();
             for (double targetDec = minDec; targetDec <= maxDec; targetDec += increment)
+                linePoints.append(QPointF(target, targetDec));
+            m_ImageData->wcsToPixels(linePoints, linePixels, lineValid);
+            for (int i = 0; i < linePixels.size(); i++)
             {
-                SkyPoint pointToGet(target / 15.0, targetDec);
-                bool inImage = m_ImageData->wcsToPixel(pointToGet, pixelPoint, imagePoint);
-                if (inImage)
-                {
-                    QPointF pt(pixelPoint.x() * scale, pixelPoint.y() * scale);
-                    eqGridPoints.append(pt);
-                }
+                if (lineValid[i])
+                    eqGridPoints.append(QPointF(linePixels[i].x() * scale, linePixels[i].y() * scale));
             }
 
             if (eqGridPoints.count() > 1)
@@ -1695,15 +1710,14 @@ void FITSView::drawEQGrid(QPainter * painter, double scale)
                                         100.0); //This will determine how many points to use to create the Dec Line
             double target    = targetDec * decConvert;
 
+            linePoints.clear();
             for (double targetRA = minRA; targetRA <= maxRA; targetRA += increment)
+                linePoints.append(QPointF(targetRA, target));
+            m_ImageData->wcsToPixels(linePoints, linePixels, lineValid);
+            for (int i = 0; i < linePixels.size(); i++)
             {
-                SkyPoint pointToGet(targetRA / 15, targetDec * decConvert);
-                bool inImage = m_ImageData->wcsToPixel(pointToGet, pixelPoint, imagePoint);
-                if (inImage)
-                {
-                    QPointF pt(pixelPoint.x() * scale, pixelPoint.y() * scale);
-                    eqGridPoints.append(pt);
-                }
+                if (lineValid[i])
+                    eqGridPoints.append(QPointF(linePixels[i].x() * scale, linePixels[i].y() * scale));
             }
             if (eqGridPoints.count() > 1)
             {
@@ -1989,7 +2003,7 @@ void FITSView::toggleEQGrid()
 
     if (m_ImageData->getWCSState() == FITSData::Idle && !wcsWatcher.isRunning())
     {
-        QFuture<bool> future = QtConcurrent::run(m_ImageData.data(), &FITSData::loadWCS);
+        QFuture<bool> future = Executors::run(Executors::Background, &FITSData::loadWCS, m_ImageData.data());
         wcsWatcher.setFuture(future);
         return;
     }
@@ -2004,7 +2018,7 @@ void FITSView::toggleHiPSOverlay()
 
     if (m_ImageData->getWCSState() == FITSData::Idle && !wcsWatcher.isRunning())
     {
-        QFuture<bool> future = QtConcurrent::run(m_ImageData.data(), &FITSData::loadWCS);
+        QFuture<bool> future = Executors::run(Executors::Background, &FITSData::loadWCS, m_ImageData.data());
         wcsWatcher.setFuture(future);
         return;
     }
@@ -2038,7 +2052,7 @@ void FITSView::toggleObjects()
 
     if (m_ImageData->getWCSState() == FITSData::Idle && !wcsWatcher.isRunning())
     {
-        QFuture<bool> future = QtConcurrent::run(m_ImageData.data(), &FITSData::loadWCS);
+        QFuture<bool> future = Executors::run(Executors::Background, &FITSData::loadWCS, m_ImageData.data());
         wcsWatcher.setFuture(future);
         return;
     }
@@ -2196,7 +2210,9 @@ void FITSView::toggleStars(bool enable)
 void FITSView::searchStars()
 {
     QVariant frameType;
-    if (m_ImageData->areStarsSearched() || !m_ImageData || (m_ImageData->getRecordValue("FRAME", frameType)
+    // Stars searched only for their aggregates have to be searched again to be marked
+    if ((m_ImageData->areStarsSearched() && !m_ImageData->hasStarStatisticsOnly()) || !m_ImageData
+            || (m_ImageData->getRecordValue("FRAME", frameType)
             && frameType.toString() != "Light"))
         return;
 
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "fitscommon.h"
+#include "fitsimagepyramid.h"
 #include "auxiliary/imagemask.h"
 
 #include <config-kstars.h>
@@ -71,9 +72,10 @@ class FITSView : public QScrollArea
         bool loadData(const QSharedPointer<FITSData> &data);
 
         /**
-         * @brief clearView Reset view to NO IMAGE
+         * @brief clearView Reset view to NO IMAGE, releasing the image
+         * @param placeholder displayed instead of the NO IMAGE icon, e.g. a preview of the released image
          */
-        void clearData();
+        void clearData(const QPixmap &placeholder = QPixmap());
 
         // Save FITS
         bool saveImage(const QString &newFilename);
@@ -243,6 +245,13 @@ class FITSView : public QScrollArea
         // stretch parameters are a function of the Red input param and the existing RGB params.
         void setStretchParams(const StretchParams &params);
 
+        // Keeps the current params for the next images rather than generating them for each one,
+        // e.g. so that blinked frames compare. Does not re-display the image.
+        void keepStretchParams()
+        {
+            autoStretch = false;
+        }
+
         // Sets whether to stretch the image or not.
         // Will also re-display the image if onOff != stretchImage.
         void setStretch(bool onOff);
@@ -366,7 +375,7 @@ class FITSView : public QScrollArea
         void doStretch(QImage *outputImage);
         double scaleSize(double size);
         bool isLargeImage();
-        bool initDisplayPixmap(QImage &image, float space);
+        bool initDisplayPixmap(const QImage &image, float space);
         void updateFrameLargeImage();
         void updateFrameSmallImage();
         bool drawHFR(QPainter * painter, const QString &hfr, int x, int y);
@@ -387,6 +396,10 @@ class FITSView : public QScrollArea
         QImage rawImage;
         // Actual pixmap after all the overlays
         QPixmap displayPixmap;
+        // Downsampled copies of rawImage used when zoomed out on large images
+        FITSImagePyramid m_ImagePyramid;
+        // Downsampling of the pyramid level currently displayed, 1 when displaying rawImage
+        int m_PyramidSampling { 1 };
 
         bool firstLoad { true };
         bool markStars { false };
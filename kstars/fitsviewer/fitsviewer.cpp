@@ -12,11 +12,14 @@
 
 #include "fitsdata.h"
 #include "fitsdebayer.h"
+#include "fitspreviewcache.h"
 #include "fitstab.h"
 #include "fitsview.h"
+#include "imagememory.h"
 #include "kstars.h"
 #include "ksutils.h"
 #include "Options.h"
+#include "auxiliary/executors.h"
 #ifdef HAVE_INDI
 #include "indi/indilistener.h"
 #endif
@@ -73,6 +76,34 @@ FITSViewer::FITSViewer(QWidget *parent) : KXmlGuiWindow(parent)
     connect(fitsTabWidget, &QTabWidget::currentChanged, this, &FITSViewer::tabFocusUpdated);
     connect(fitsTabWidget, &QTabWidget::tabCloseRequested, this, &FITSViewer::closeTab);
 
+    connect(&m_BlinkTimer, &QTimer::timeout, this, [this]()
+    {
+        // An image still loading is shown at a later tick, so that the others keep the cadence.
+        const int index = fitsTabWidget->currentIndex();
+        if (m_BlinkBusy || index < 0 || index >= m_Tabs.count())
+            return;
+        const auto &tab = m_Tabs[index];
+        const int count = tab->blinkFilenames().size();
+        if (count > 1 && !tab->isBlinkFrameLoading((tab->blinkUpto() + 1) % count))
+            nextBlink();
+    });
+
+    connect(&m_QuickStackWatcher, &QFutureWatcher<FITSQuickStack>::finished, this, [this]()
+    {
+        const FITSQuickStack stack = m_QuickStackWatcher.result();
+        const int index = fitsTabWidget->currentIndex();
+        updateBlinkActions(index >= 0 && index < m_Tabs.count() ? m_Tabs[index].get() : nullptr);
+        if (stack.count() == 0)
+        {
+            updateStatusBar(i18n("No images could be stacked."), FITS_MESSAGE);
+            return;
+        }
+
+        int tabUID = 0;
+        loadData(stack.result(), QUrl(), &tabUID, FITS_NORMAL, FITS_NONE,
+                 i18np("Stack of 1 image", "Stack of %1 images", stack.count()));
+    });
+
     //These two connections will enable or disable the scope button if a scope is available or not.
     //Of course this is also dependent on the presence of WCS data in the image.
 
@@ -287,6 +318,16 @@ FITSViewer::FITSViewer(QWidget *parent) : KXmlGuiWindow(parent)
     action->setText(i18n("Previous Blink Image"));
     connect(action, &QAction::triggered, this, &FITSViewer::previousBlink);
 
+    action = actionCollection()->addAction("play_blink");
+    action->setIcon(QIcon::fromTheme("media-playback-start"));
+    action->setText(i18n("Play Blink Images"));
+    action->setCheckable(true);
+    connect(action, &QAction::toggled, this, &FITSViewer::playBlink);
+
+    action = actionCollection()->addAction("quick_stack");
+    action->setText(i18n("Quick Stack Blink Images"));
+    connect(action, &QAction::triggered, this, &FITSViewer::quickStack);
+
     action = actionCollection()->addAction("zoom_all_in");
     actionCollection()->setDefaultShortcut(action, QKeySequence(Qt::CTRL + Qt::Key_Plus + Qt::AltModifier));
     action->setText(i18n("Zoom all tabs in"));
@@ -486,6 +527,24 @@ bool FITSViewer::addFITSCommon(const QSharedPointer<FITSTab> &tab, const QUrl &i
 
     fitsMap[fitsID] = tab;
 
+    // Connected to the tab rather than the viewer, as updates disconnect the tab from the viewer.
+    FITSTab *tabPtr = tab.get();
+    connect(tabPtr, &FITSTab::loaded, tabPtr, [this, tabPtr]()
+    {
+        tabLoaded(tabPtr);
+    });
+    connect(tabPtr, &FITSTab::failed, tabPtr, [this, tabPtr](const QString & errorMessage)
+    {
+        tabLoadFailed(tabPtr, errorMessage);
+    });
+
+    // Loaded once shown, see tabFocusUpdated()
+    if (!tab->isLoaded())
+    {
+        tab->setUID(fitsID);
+        return true;
+    }
+
     fitsTabWidget->setCurrentWidget(tab.get());
 
     actionCollection()->action("fits_debayer")->setEnabled(tab->getView()->imageData()->hasDebayer());
@@ -506,11 +565,12 @@ bool FITSViewer::addFITSCommon(const QSharedPointer<FITSTab> &tab, const QUrl &i
 
     tab->getView()->setCursorMode(FITSView::dragCursor);
 
-    actionCollection()->action("next_blink")->setEnabled(tab->blinkFilenames().size() > 1);
-    actionCollection()->action("previous_blink")->setEnabled(tab->blinkFilenames().size() > 1);
+    updateBlinkActions(tab.get());
 
     updateWCSFunctions();
 
+    unloadTabs();
+
     return true;
 }
 
@@ -530,8 +590,7 @@ void FITSViewer::loadFiles()
         if (fpath == cpath)
         {
             fitsTabWidget->setCurrentWidget(tab.get());
-            if (m_urls.size() > 0)
-                loadFiles();
+            addLazyTabs();
             return;
         }
     }
@@ -566,13 +625,118 @@ void FITSViewer::loadFiles()
         else
             m_Tabs.removeLast();
 
-        if (m_urls.size() > 0)
-            loadFiles();
+        addLazyTabs();
     });
 
     tab->loadFile(imageName, FITS_NORMAL, FITS_NONE);
 }
 
+void FITSViewer::addLazyTabs()
+{
+    // Only the first image opened is loaded, the others are loaded once their tab is shown.
+    while (!m_urls.isEmpty())
+    {
+        const QUrl imageName = m_urls.takeFirst();
+        const QString fpath = imageName.toLocalFile();
+        bool isOpen = false;
+        for (const auto &tab : m_Tabs)
+            isOpen |= (tab->getCurrentURL()->path() == fpath);
+        if (isOpen)
+            continue;
+
+        QSharedPointer<FITSTab> tab(new FITSTab(this));
+        if (!tab->setFile(imageName, FITS_NORMAL, FITS_NONE))
+            continue;
+        tab->getView()->clearData(QPixmap::fromImage(FITSPreviewCache::load(fpath, FITSPreviewCache::PREVIEW)));
+
+        m_Tabs.push_back(tab);
+        if (addFITSCommon(tab, imageName, FITS_NORMAL, ""))
+            emit loaded(fitsID++);
+        else
+            m_Tabs.removeLast();
+    }
+}
+
+void FITSViewer::loadTab(FITSTab *tab)
+{
+    if (tab->isLoaded() || m_LoadingTabs.contains(tab))
+        return;
+
+    // Tabs browsed past while waiting are loaded when shown again.
+    if (m_LoadingTabs.size() >= MAX_CONCURRENT_LOADS)
+    {
+        m_PendingTab = tab;
+        return;
+    }
+
+    m_LoadingTabs.insert(tab);
+    tab->reload();
+}
+
+void FITSViewer::loadPendingTab()
+{
+    FITSTab *tab = m_PendingTab;
+    m_PendingTab.clear();
+    if (tab != nullptr && tab == fitsTabWidget->currentWidget())
+        loadTab(tab);
+}
+
+void FITSViewer::tabLoaded(FITSTab *tab)
+{
+    // Also emitted when blinking or Ekos update the tab
+    if (!m_LoadingTabs.remove(tab))
+        return;
+
+    tab->getView()->setCursorMode(FITSView::dragCursor);
+    const int index = fitsTabWidget->indexOf(tab);
+    if (index == fitsTabWidget->currentIndex())
+    {
+        led.setColor(Qt::green);
+        updateStatusBar(i18n("Ready."), FITS_MESSAGE);
+        tabFocusUpdated(index);
+    }
+
+    loadPendingTab();
+    unloadTabs();
+}
+
+void FITSViewer::tabLoadFailed(FITSTab *tab, const QString &errorMessage)
+{
+    if (!m_LoadingTabs.remove(tab))
+        return;
+
+    if (tab == fitsTabWidget->currentWidget())
+    {
+        led.setColor(Qt::red);
+        updateStatusBar(errorMessage, FITS_MESSAGE);
+    }
+
+    loadPendingTab();
+}
+
+void FITSViewer::unloadTabs()
+{
+    // Release the images of the tabs shown least recently
+    const int maxResident = static_cast<int>(Options::fitsMaxResidentImages());
+    int resident = 0;
+    for (FITSTab *tab : m_RecentTabs)
+    {
+        if (tab->isLoaded() && ++resident > maxResident && tab->unload())
+            resident--;
+    }
+}
+
+bool FITSViewer::currentTabLoaded() const
+{
+    const int index = fitsTabWidget->currentIndex();
+    return index >= 0 && index < m_Tabs.count() && m_Tabs[index]->isLoaded();
+}
+
+bool FITSViewer::isCurrentTab(const FITSTab *tab) const
+{
+    return fitsTabWidget->currentWidget() == tab;
+}
+
 void FITSViewer::loadFile(const QUrl &imageName, FITSMode mode, FITSScale filter, const QString &previewText)
 {
     led.setColor(Qt::yellow);
@@ -735,8 +899,7 @@ bool FITSViewer::updateFITSCommon(const QSharedPointer<FITSTab> &tab, const QUrl
 
     updateStatusBar(HFRClipString(tab->getView().get()), FITS_CLIP);
 
-    actionCollection()->action("next_blink")->setEnabled(tab->blinkFilenames().size() > 1);
-    actionCollection()->action("previous_blink")->setEnabled(tab->blinkFilenames().size() > 1);
+    updateBlinkActions(tab.get());
 
     return true;
 }
@@ -770,6 +933,22 @@ void FITSViewer::tabFocusUpdated(int currentIndex)
     if (currentIndex < 0 || m_Tabs.empty())
         return;
 
+    FITSTab *tab = m_Tabs[currentIndex].get();
+    m_RecentTabs.removeOne(tab);
+    m_RecentTabs.prepend(tab);
+
+    if (!tab->isLoaded())
+    {
+        led.setColor(Qt::yellow);
+        updateStatusBar(i18n("Loading %1...", tab->getCurrentURL()->fileName()), FITS_MESSAGE);
+        actionCollection()->action("fits_debayer")->setEnabled(false);
+        loadTab(tab);
+        return;
+    }
+
+    // Shown images are released last over the image memory budget
+    ImageMemory::instance().touch(tab->getView()->imageData().get());
+
     m_Tabs[currentIndex]->tabPositionUpdated();
 
     auto view = m_Tabs[currentIndex]->getView();
@@ -814,8 +993,7 @@ void FITSViewer::tabFocusUpdated(int currentIndex)
         updateButtonStatus("view_hips_overlay", i18n("HiPS Overlay"), currentView->isHiPSOverlayShown());
     }
 
-    actionCollection()->action("next_blink")->setEnabled(m_Tabs[currentIndex]->blinkFilenames().size() > 1);
-    actionCollection()->action("previous_blink")->setEnabled(m_Tabs[currentIndex]->blinkFilenames().size() > 1);
+    updateBlinkActions(m_Tabs[currentIndex].get());
 
     updateScopeButton();
     updateWCSFunctions();
@@ -899,7 +1077,7 @@ void FITSViewer::blink()
     {
         m_Tabs.push_back(tab);
         tab->initBlink(allImages);
-        tab->setBlinkUpto(1);
+        tab->setBlinkUpto(0);
     }
     QString tabName = QString("%1/%2 %3")
                       .arg(1).arg(allImages.size()).arg(QFileInfo(allImages[0]).fileName());
@@ -921,8 +1099,7 @@ void FITSViewer::blink()
         m_BlinkBusy = false;
     }, Qt::UniqueConnection);
 
-    actionCollection()->action("next_blink")->setEnabled(allImages.size() > 1);
-    actionCollection()->action("previous_blink")->setEnabled(allImages.size() > 1);
+    updateBlinkActions(tab.get());
 
     tab->loadFile(imageName, FITS_NORMAL, FITS_NONE);
 }
@@ -976,7 +1153,7 @@ void FITSViewer::changeBlink(bool increment)
     }, Qt::UniqueConnection);
 
     tab->setBlinkUpto(blinkIndex);
-    tab->loadFile(QUrl::fromLocalFile(nextFilename), FITS_NORMAL, FITS_NONE);
+    tab->loadBlinkFrame();
 }
 
 void FITSViewer::nextBlink()
@@ -989,6 +1166,42 @@ void FITSViewer::previousBlink()
     changeBlink(false);
 }
 
+void FITSViewer::playBlink(bool play)
+{
+    if (play)
+        m_BlinkTimer.start(static_cast<int>(Options::fitsBlinkInterval()));
+    else
+        m_BlinkTimer.stop();
+    actionCollection()->action("play_blink")->setIcon(QIcon::fromTheme(play ? "media-playback-pause" :
+            "media-playback-start"));
+}
+
+void FITSViewer::quickStack()
+{
+    const int index = fitsTabWidget->currentIndex();
+    if (m_QuickStackWatcher.isRunning() || index < 0 || index >= m_Tabs.count())
+        return;
+
+    const QStringList filenames = m_Tabs[index]->blinkFilenames();
+    if (filenames.size() < 2)
+        return;
+
+    actionCollection()->action("quick_stack")->setEnabled(false);
+    updateStatusBar(i18np("Stacking 1 image...", "Stacking %1 images...", filenames.size()), FITS_MESSAGE);
+    m_QuickStackWatcher.setFuture(Executors::run(Executors::Background, &FITSQuickStack::stackFiles, filenames));
+}
+
+void FITSViewer::updateBlinkActions(const FITSTab *tab)
+{
+    const bool blinking = tab != nullptr && tab->blinkFilenames().size() > 1;
+    actionCollection()->action("next_blink")->setEnabled(blinking);
+    actionCollection()->action("previous_blink")->setEnabled(blinking);
+    actionCollection()->action("play_blink")->setEnabled(blinking);
+    actionCollection()->action("quick_stack")->setEnabled(blinking && !m_QuickStackWatcher.isRunning());
+    if (!blinking)
+        actionCollection()->action("play_blink")->setChecked(false);
+}
+
 void FITSViewer::openFile()
 {
     QFileDialog dialog(KStars::Instance(), i18nc("@title:window", "Open Image"));
@@ -1002,8 +1215,9 @@ void FITSViewer::openFile()
     m_urls = dialog.selectedUrls();
     if (m_urls.size() < 1)
         return;
-    // Protect against, e.g. opening 1000 tabs. Not sure what the right number is.
-    constexpr int MAX_NUM_OPENS = 40;
+    // Protect against, e.g. opening 10000 tabs. Images beyond the first are only loaded once
+    // shown, so the limit is the number of tab widgets rather than memory.
+    constexpr int MAX_NUM_OPENS = 500;
     if (m_urls.size() > MAX_NUM_OPENS)
         return;
 
@@ -1013,12 +1227,15 @@ void FITSViewer::openFile()
 
 void FITSViewer::saveFile()
 {
+    if (!currentTabLoaded())
+        return;
+
     m_Tabs[fitsTabWidget->currentIndex()]->saveFile();
 }
 
 void FITSViewer::saveFileAs()
 {
-    if (m_Tabs.empty())
+    if (!currentTabLoaded())
         return;
 
     if (m_Tabs[fitsTabWidget->currentIndex()]->saveFileAs() &&
@@ -1029,7 +1246,7 @@ void FITSViewer::saveFileAs()
 
 void FITSViewer::copyFITS()
 {
-    if (m_Tabs.empty())
+    if (!currentTabLoaded())
         return;
 
     m_Tabs[fitsTabWidget->currentIndex()]->copyFITS();
@@ -1037,7 +1254,7 @@ void FITSViewer::copyFITS()
 
 void FITSViewer::histoFITS()
 {
-    if (m_Tabs.empty())
+    if (!currentTabLoaded())
         return;
 
     m_Tabs[fitsTabWidget->currentIndex()]->histoFITS();
@@ -1045,7 +1262,7 @@ void FITSViewer::histoFITS()
 
 void FITSViewer::statFITS()
 {
-    if (m_Tabs.empty())
+    if (!currentTabLoaded())
         return;
 
     m_Tabs[fitsTabWidget->currentIndex()]->statFITS();
@@ -1073,7 +1290,7 @@ void FITSViewer::flipVertical()
 
 void FITSViewer::headerFITS()
 {
-    if (m_Tabs.empty())
+    if (!currentTabLoaded())
         return;
 
     m_Tabs[fitsTabWidget->currentIndex()]->headerFITS();
@@ -1133,12 +1350,12 @@ void FITSViewer::updateStatusBar(const QString &msg, FITSBar id)
 
 void FITSViewer::ZoomAllIn()
 {
-    if (m_Tabs.empty())
+    if (!currentTabLoaded())
         return;
 
     // Could add code to not call View::updateFrame for these
     for (int i = 0; i < fitsTabWidget->count(); ++i)
-        if (i != fitsTabWidget->currentIndex())
+        if (i != fitsTabWidget->currentIndex() && m_Tabs[i]->isLoaded())
             m_Tabs[i]->ZoomIn();
 
     m_Tabs[fitsTabWidget->currentIndex()]->ZoomIn();
@@ -1146,12 +1363,12 @@ void FITSViewer::ZoomAllIn()
 
 void FITSViewer::ZoomAllOut()
 {
-    if (m_Tabs.empty())
+    if (!currentTabLoaded())
         return;
 
     // Could add code to not call View::updateFrame for these
     for (int i = 0; i < fitsTabWidget->count(); ++i)
-        if (i != fitsTabWidget->currentIndex())
+        if (i != fitsTabWidget->currentIndex() && m_Tabs[i]->isLoaded())
             m_Tabs[i]->ZoomOut();
 
     m_Tabs[fitsTabWidget->currentIndex()]->ZoomOut();
@@ -1159,7 +1376,7 @@ void FITSViewer::ZoomAllOut()
 
 void FITSViewer::ZoomIn()
 {
-    if (m_Tabs.empty())
+    if (!currentTabLoaded())
         return;
 
     m_Tabs[fitsTabWidget->currentIndex()]->ZoomIn();
@@ -1167,7 +1384,7 @@ void FITSViewer::ZoomIn()
 
 void FITSViewer::ZoomOut()
 {
-    if (m_Tabs.empty())
+    if (!currentTabLoaded())
         return;
 
     m_Tabs[fitsTabWidget->currentIndex()]->ZoomOut();
@@ -1175,7 +1392,7 @@ void FITSViewer::ZoomOut()
 
 void FITSViewer::ZoomDefault()
 {
-    if (m_Tabs.empty())
+    if (!currentTabLoaded())
         return;
 
     m_Tabs[fitsTabWidget->currentIndex()]->ZoomDefault();
@@ -1224,6 +1441,8 @@ void FITSViewer::closeTab(int index)
     int UID = tab->getUID();
 
     fitsMap.remove(UID);
+    m_RecentTabs.removeOne(tab.get());
+    m_LoadingTabs.remove(tab.get());
     m_Tabs.removeOne(tab);
 
     if (m_Tabs.empty())
@@ -1533,8 +1752,7 @@ void FITSViewer::nextTab()
         index = 0;
     fitsTabWidget->setCurrentIndex(index);
 
-    actionCollection()->action("next_blink")->setEnabled(m_Tabs[index]->blinkFilenames().size() > 1);
-    actionCollection()->action("previous_blink")->setEnabled(m_Tabs[index]->blinkFilenames().size() > 1);
+    updateBlinkActions(m_Tabs[index].get());
 }
 
 void FITSViewer::previousTab()
@@ -1547,8 +1765,7 @@ void FITSViewer::previousTab()
         index = m_Tabs.count() - 1;
     fitsTabWidget->setCurrentIndex(index);
 
-    actionCollection()->action("next_blink")->setEnabled(m_Tabs[index]->blinkFilenames().size() > 1);
-    actionCollection()->action("previous_blink")->setEnabled(m_Tabs[index]->blinkFilenames().size() > 1);
+    updateBlinkActions(m_Tabs[index].get());
 
 }
 
@@ -1567,6 +1784,8 @@ void FITSViewer::toggleStars()
 
     for (auto tab : m_Tabs)
     {
+        if (!tab->isLoaded())
+            continue;
         tab->getView()->toggleStars(markStars);
         tab->getView()->updateFrame();
     }
@@ -1574,7 +1793,7 @@ void FITSViewer::toggleStars()
 
 void FITSViewer::applyFilter(int ftype)
 {
-    if (m_Tabs.empty())
+    if (!currentTabLoaded())
         return;
 
     QApplication::setOverrideCursor(Qt::WaitCursor);
@@ -1601,7 +1820,7 @@ bool FITSViewer::getView(int fitsUID, QSharedPointer<FITSView> &view)
 
 bool FITSViewer::getCurrentView(QSharedPointer<FITSView> &view)
 {
-    if (m_Tabs.empty() || fitsTabWidget->currentIndex() >= m_Tabs.count())
+    if (!currentTabLoaded())
         return false;
 
     view = m_Tabs[fitsTabWidget->currentIndex()]->getView();
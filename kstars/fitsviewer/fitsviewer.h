@@ -10,15 +10,20 @@
 #pragma once
 
 #include "fitscommon.h"
+#include "fitsquickstack.h"
 #include "fitsviewer/stretch.h"
 
 #include <KLed>
 #include <KXmlGui/KXmlGuiWindow>
 #include <KActionMenu>
 
+#include <QFutureWatcher>
 #include <QLabel>
 #include <QList>
 #include <QMap>
+#include <QPointer>
+#include <QSet>
+#include <QTimer>
 #include <QUrl>
 
 #ifdef WIN32
@@ -82,6 +87,8 @@ class FITSViewer : public KXmlGuiWindow
         }
         bool getView(int fitsUID, QSharedPointer<FITSView> &view);
         bool getCurrentView(QSharedPointer<FITSView> &view);
+        /** @return true if @p tab is the tab shown */
+        bool isCurrentTab(const FITSTab *tab) const;
 
         static QStringList filterTypes;
 
@@ -96,6 +103,8 @@ class FITSViewer : public KXmlGuiWindow
         void blink();
         void nextBlink();
         void previousBlink();
+        void playBlink(bool play);
+        void quickStack();
         void saveFile();
         void saveFileAs();
         void copyFITS();
@@ -163,8 +172,29 @@ class FITSViewer : public KXmlGuiWindow
 
         void loadFiles();
         QList<QUrl> m_urls;
+
+        // Tabs of opened files besides the first load their image once shown, and the images of
+        // the tabs shown least recently are released beyond Options::fitsMaxResidentImages().
+        void addLazyTabs();
+        void loadTab(FITSTab *tab);
+        void loadPendingTab();
+        void tabLoaded(FITSTab *tab);
+        void tabLoadFailed(FITSTab *tab, const QString &errorMessage);
+        void unloadTabs();
+        bool currentTabLoaded() const;
+        // Images of shown tabs loading at once, in addition to the ones loaded by Ekos
+        static constexpr int MAX_CONCURRENT_LOADS = 2;
+        QSet<FITSTab *> m_LoadingTabs;
+        // The last tab shown while MAX_CONCURRENT_LOADS were loading
+        QPointer<FITSTab> m_PendingTab;
+        // The most recently shown first
+        QList<FITSTab *> m_RecentTabs;
         void changeBlink(bool increment);
+        void updateBlinkActions(const FITSTab *tab);
         static bool m_BlinkBusy;
+        // Shows the next blink image every Options::fitsBlinkInterval() milliseconds
+        QTimer m_BlinkTimer;
+        QFutureWatcher<FITSQuickStack> m_QuickStackWatcher;
 
     signals:
         void trackingStarSelected(int x, int y);
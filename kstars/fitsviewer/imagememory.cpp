@@ -0,0 +1,296 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "imagememory.h"
+
+#include <KFormat>
+#include <KLocalizedString>
+
+#include <QCoreApplication>
+#include <QPair>
+
+#include <fits_debug.h>
+
+#include <algorithm>
+
+namespace
+{
+// The keys of the owners in toVariantMap()
+const char *const OWNER_KEYS[ImageMemory::OwnerCount] =
+{
+    "other", "capture", "viewer", "darkLibrary", "guide", "focus", "align", "ekosLive"
+};
+}
+
+ImageMemory &ImageMemory::instance()
+{
+    static ImageMemory memory;
+    return memory;
+}
+
+ImageMemory::Owner ImageMemory::ownerOf(FITSMode mode)
+{
+    switch (mode)
+    {
+        case FITS_GUIDE:
+            return Guide;
+        case FITS_FOCUS:
+            return Focus;
+        case FITS_ALIGN:
+            return Align;
+        case FITS_CALIBRATE:
+            return DarkLibrary;
+        default:
+            return Other;
+    }
+}
+
+QString ImageMemory::name(Owner owner)
+{
+    switch (owner)
+    {
+        case Capture:
+            return i18n("Capture");
+        case Viewer:
+            return i18n("FITS Viewer");
+        case DarkLibrary:
+            return i18n("Dark Library");
+        case Guide:
+            return i18n("Guide");
+        case Focus:
+            return i18n("Focus");
+        case Align:
+            return i18n("Align");
+        case EkosLive:
+            return i18n("EkosLive");
+        case Other:
+        default:
+            return i18n("Other");
+    }
+}
+
+ImageMemory::Entry &ImageMemory::entry(const FITSData *image, Owner owner)
+{
+    auto it = m_Entries.find(image);
+    if (it == m_Entries.end())
+    {
+        it = m_Entries.insert(image, Entry());
+        it->owner = owner;
+        it->lastUsed = ++m_Clock;
+    }
+    return *it;
+}
+
+void ImageMemory::track(const FITSData *image, uint64_t bytes, Owner owner)
+{
+    bool exceeded = false;
+    {
+        QMutexLocker lock(&m_Mutex);
+        Entry &tracked = entry(image, owner);
+        m_Total = m_Total - tracked.bytes + bytes;
+        tracked.bytes = bytes;
+        tracked.lastUsed = ++m_Clock;
+        exceeded = m_Budget > 0 && m_Total > m_Budget;
+    }
+
+    if (exceeded)
+        queueEnforcement();
+}
+
+void ImageMemory::untrack(const FITSData *image)
+{
+    QMutexLocker lock(&m_Mutex);
+    auto it = m_Entries.find(image);
+    if (it == m_Entries.end())
+        return;
+    m_Total -= it->bytes;
+    m_Entries.erase(it);
+}
+
+void ImageMemory::setOwner(const FITSData *image, Owner owner)
+{
+    QMutexLocker lock(&m_Mutex);
+    entry(image, owner).owner = owner;
+}
+
+void ImageMemory::setEvictor(const FITSData *image, const Evictor &evictor)
+{
+    bool exceeded = false;
+    {
+        QMutexLocker lock(&m_Mutex);
+        entry(image, Other).evictor = evictor;
+        exceeded = evictor && m_Budget > 0 && m_Total > m_Budget;
+    }
+
+    // The image may be the first one that can be evicted
+    if (exceeded)
+        queueEnforcement();
+}
+
+void ImageMemory::touch(const FITSData *image)
+{
+    QMutexLocker lock(&m_Mutex);
+    auto it = m_Entries.find(image);
+    if (it != m_Entries.end())
+        it->lastUsed = ++m_Clock;
+}
+
+void ImageMemory::setBudget(uint64_t bytes)
+{
+    bool exceeded = false;
+    {
+        QMutexLocker lock(&m_Mutex);
+        m_Budget = bytes;
+        exceeded = m_Budget > 0 && m_Total > m_Budget;
+    }
+
+    if (exceeded)
+        queueEnforcement();
+}
+
+uint64_t ImageMemory::budget() const
+{
+    QMutexLocker lock(&m_Mutex);
+    return m_Budget;
+}
+
+QVector<ImageMemory::Usage> ImageMemory::usage() const
+{
+    QVector<Usage> usage(OwnerCount);
+    for (int i = 0; i < OwnerCount; ++i)
+        usage[i].owner = static_cast<Owner>(i);
+
+    QMutexLocker lock(&m_Mutex);
+    for (const Entry &image : m_Entries)
+    {
+        // Images registered by their holder before they are loaded hold no memory yet
+        if (image.bytes == 0)
+            continue;
+        Usage &owner = usage[image.owner];
+        owner.images++;
+        owner.bytes += image.bytes;
+        if (image.evictor)
+            owner.evictable += image.bytes;
+    }
+    return usage;
+}
+
+uint64_t ImageMemory::totalBytes() const
+{
+    QMutexLocker lock(&m_Mutex);
+    return m_Total;
+}
+
+quint64 ImageMemory::evictions() const
+{
+    QMutexLocker lock(&m_Mutex);
+    return m_Evictions;
+}
+
+void ImageMemory::queueEnforcement()
+{
+    // Evictors close views and caches of the main thread, while images are loaded by the pools
+    QCoreApplication *application = QCoreApplication::instance();
+    if (application == nullptr || m_EnforcementQueued.exchange(true))
+        return;
+
+    QMetaObject::invokeMethod(application, []()
+    {
+        ImageMemory::instance().enforceBudget();
+    }, Qt::QueuedConnection);
+}
+
+int ImageMemory::enforceBudget()
+{
+    m_EnforcementQueued = false;
+
+    uint64_t excess = 0;
+    QVector<QPair<quint64, const FITSData *>> candidates;
+    {
+        QMutexLocker lock(&m_Mutex);
+        if (m_Budget == 0 || m_Total <= m_Budget)
+            return 0;
+        excess = m_Total - m_Budget;
+        for (auto it = m_Entries.cbegin(); it != m_Entries.cend(); ++it)
+        {
+            if (it->evictor && it->bytes > 0)
+                candidates.append(qMakePair(it->lastUsed, it.key()));
+        }
+    }
+
+    // Least recently used first
+    std::sort(candidates.begin(), candidates.end());
+
+    int evicted = 0;
+    for (const auto &candidate : candidates)
+    {
+        if (excess == 0)
+            break;
+
+        Evictor evictor;
+        uint64_t bytes = 0;
+        {
+            QMutexLocker lock(&m_Mutex);
+            auto it = m_Entries.find(candidate.second);
+            // Deleted or released by an earlier evictor
+            if (it == m_Entries.end() || !it->evictor || it->bytes == 0)
+                continue;
+            evictor = it->evictor;
+            bytes = it->bytes;
+        }
+
+        // Called without the lock, the image may be deleted right away
+        if (!evictor())
+            continue;
+
+        // The holder let go, even if others keep the image alive for a while
+        evicted++;
+        excess = bytes >= excess ? 0 : excess - bytes;
+
+        QMutexLocker lock(&m_Mutex);
+        m_Evictions++;
+        auto it = m_Entries.find(candidate.second);
+        if (it != m_Entries.end())
+            it->evictor = Evictor();
+    }
+
+    if (evicted > 0)
+        qCDebug(KSTARS_FITS) << "Evicted" << evicted << "images over the image memory budget," << excess
+                             << "bytes still over it";
+    return evicted;
+}
+
+QString ImageMemory::summary() const
+{
+    const KFormat format;
+    QStringList lines;
+    for (const Usage &owner : usage())
+    {
+        if (owner.images == 0)
+            continue;
+        lines << i18np("%2: 1 image, %3 (%4 evictable)", "%2: %1 images, %3 (%4 evictable)", owner.images,
+                       name(owner.owner), format.formatByteSize(owner.bytes), format.formatByteSize(owner.evictable));
+    }
+
+    const uint64_t limit = budget();
+    lines << i18n("Total: %1 of %2, %3 evicted", format.formatByteSize(totalBytes()),
+                  limit > 0 ? format.formatByteSize(limit) : i18n("no budget"), evictions());
+    return lines.join('\n');
+}
+
+QVariantMap ImageMemory::toVariantMap() const
+{
+    QVariantMap owners;
+    for (const Usage &owner : usage())
+        owners.insert(OWNER_KEYS[owner.owner], static_cast<qulonglong>(owner.bytes));
+
+    QVariantMap map;
+    map.insert("budget", static_cast<qulonglong>(budget()));
+    map.insert("total", static_cast<qulonglong>(totalBytes()));
+    map.insert("evictions", evictions());
+    map.insert("owners", owners);
+    return map;
+}
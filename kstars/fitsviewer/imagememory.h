@@ -0,0 +1,137 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "fitscommon.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QVariantMap>
+#include <QVector>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+class FITSData;
+
+/**
+ * @class ImageMemory
+ * @short Accounts for the image buffers of all FITSData, by owner, and keeps them within a budget.
+ *
+ * The same night fills the capture preview, the FITS Viewer tabs, the dark library cache, the guide,
+ * focus and align frames and the EkosLive uploads with images, each sized by the camera. Every FITSData
+ * registers its image buffer here whenever it is allocated, replaced or freed, and the subsystem that holds
+ * it sets its owner. The owner defaults to the mode of the image.
+ *
+ * Holders that can let go of an image, such as the viewer tabs that show a preview instead and the dark
+ * library cache, set an evictor. Once the images take more than the budget, the evictors of the images
+ * used least recently are called on the main thread until they fit again. Images without an evictor are
+ * never evicted, so the budget is a target rather than a hard limit.
+ *
+ * All functions are thread safe, but for enforceBudget() which is called on the main thread.
+ */
+class ImageMemory
+{
+    public:
+        enum Owner
+        {
+            Other,
+            Capture,
+            Viewer,
+            DarkLibrary,
+            Guide,
+            Focus,
+            Align,
+            EkosLive
+        };
+
+        static constexpr int OwnerCount = EkosLive + 1;
+
+        /**
+         * Releases the image from its holder, on the main thread.
+         * @return false if the image can not be released now, e.g. it is shown.
+         */
+        using Evictor = std::function<bool()>;
+
+        struct Usage
+        {
+            Owner owner { Other };
+            int images { 0 };
+            uint64_t bytes { 0 };
+            /// Bytes of the images with an evictor
+            uint64_t evictable { 0 };
+        };
+
+        static ImageMemory &instance();
+
+        /** @return the owner of images of @p mode until their holder sets one */
+        static Owner ownerOf(FITSMode mode);
+
+        /** @return the translated name of @p owner */
+        static QString name(Owner owner);
+
+        /**
+         * @short Set the size of the image buffer of @p image, 0 once freed, and mark it used. The image is
+         * registered with @p owner the first time. Enforcing the budget is queued if it is exceeded.
+         */
+        void track(const FITSData *image, uint64_t bytes, Owner owner);
+        /** @short Forget @p image, once deleted. */
+        void untrack(const FITSData *image);
+
+        void setOwner(const FITSData *image, Owner owner);
+        /** @short Let @p evictor release @p image, or make it resident again with an empty evictor. */
+        void setEvictor(const FITSData *image, const Evictor &evictor);
+        /** @short Mark @p image used now, e.g. shown again, so it is evicted last. */
+        void touch(const FITSData *image);
+
+        /** @short Set the budget of all the image buffers in bytes, 0 for none. */
+        void setBudget(uint64_t bytes);
+        uint64_t budget() const;
+
+        /** @return the images and bytes of each owner */
+        QVector<Usage> usage() const;
+        uint64_t totalBytes() const;
+        /** @return the images evicted so far */
+        quint64 evictions() const;
+
+        /**
+         * @short Call the evictors of the images used least recently until the images fit in the budget.
+         * @return the number of images evicted
+         */
+        int enforceBudget();
+
+        /** @return the usage, one line per owner holding images, and the budget */
+        QString summary() const;
+
+        /** @return the budget, total, evictions and the bytes of each owner, keyed by owner, for D-Bus */
+        QVariantMap toVariantMap() const;
+
+    private:
+        ImageMemory() = default;
+
+        struct Entry
+        {
+            Owner owner { Other };
+            uint64_t bytes { 0 };
+            quint64 lastUsed { 0 };
+            Evictor evictor;
+        };
+
+        Entry &entry(const FITSData *image, Owner owner);
+        // Called with the mutex held
+        void queueEnforcement();
+
+        mutable QMutex m_Mutex;
+        QHash<const FITSData *, Entry> m_Entries;
+        uint64_t m_Total { 0 };
+        uint64_t m_Budget { 0 };
+        quint64 m_Clock { 0 };
+        quint64 m_Evictions { 0 };
+        std::atomic<bool> m_EnforcementQueued { false };
+};
@@ -0,0 +1,181 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "starstatistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+P2Quantile::P2Quantile(double quantile) : m_Quantile(std::min(1.0, std::max(0.0, quantile)))
+{
+    reset();
+}
+
+void P2Quantile::reset()
+{
+    const double p = m_Quantile;
+    m_Count = 0;
+    m_Heights.fill(0);
+    m_Positions = { 0, 1, 2, 3, 4 };
+    m_Desired = { 0, 2 * p, 4 * p, 2 + 2 * p, 4 };
+    m_Increments = { 0, p / 2, p, (1 + p) / 2, 1 };
+}
+
+void P2Quantile::add(double value)
+{
+    if (m_Count < 5)
+    {
+        m_Heights[m_Count++] = value;
+        if (m_Count == 5)
+            std::sort(m_Heights.begin(), m_Heights.end());
+        return;
+    }
+    m_Count++;
+
+    // The cell of the new value, extending the extreme markers if needed
+    int k;
+    if (value < m_Heights[0])
+    {
+        m_Heights[0] = value;
+        k = 0;
+    }
+    else if (value >= m_Heights[4])
+    {
+        m_Heights[4] = value;
+        k = 3;
+    }
+    else
+    {
+        k = 0;
+        while (k < 3 && value >= m_Heights[k + 1])
+            k++;
+    }
+
+    for (int i = k + 1; i < 5; i++)
+        m_Positions[i]++;
+    for (int i = 0; i < 5; i++)
+        m_Desired[i] += m_Increments[i];
+
+    // Move the middle markers towards their desired positions
+    for (int i = 1; i < 4; i++)
+    {
+        const double delta = m_Desired[i] - m_Positions[i];
+        if ((delta >= 1 && m_Positions[i + 1] - m_Positions[i] > 1) ||
+                (delta <= -1 && m_Positions[i - 1] - m_Positions[i] < -1))
+        {
+            const int d = delta > 0 ? 1 : -1;
+            const double height = parabolic(i, d);
+            if (m_Heights[i - 1] < height && height < m_Heights[i + 1])
+                m_Heights[i] = height;
+            else
+                m_Heights[i] = linear(i, d);
+            m_Positions[i] += d;
+        }
+    }
+}
+
+double P2Quantile::parabolic(int i, int d) const
+{
+    const double n0 = m_Positions[i - 1], n1 = m_Positions[i], n2 = m_Positions[i + 1];
+    return m_Heights[i] + d / (n2 - n0) *
+           ((n1 - n0 + d) * (m_Heights[i + 1] - m_Heights[i]) / (n2 - n1) +
+            (n2 - n1 - d) * (m_Heights[i] - m_Heights[i - 1]) / (n1 - n0));
+}
+
+double P2Quantile::linear(int i, int d) const
+{
+    return m_Heights[i] + d * (m_Heights[i + d] - m_Heights[i]) / (m_Positions[i + d] - m_Positions[i]);
+}
+
+double P2Quantile::value() const
+{
+    if (m_Count == 0)
+        return 0;
+    if (m_Count >= 5)
+        return m_Heights[2];
+
+    // Exact quantile of the few values kept so far
+    std::array<double, 5> sorted = m_Heights;
+    std::sort(sorted.begin(), sorted.begin() + m_Count);
+    const double position = m_Quantile * (m_Count - 1);
+    const int lower = static_cast<int>(position);
+    const int upper = std::min(lower + 1, m_Count - 1);
+    return sorted[lower] + (position - lower) * (sorted[upper] - sorted[lower]);
+}
+
+StarStatistics::StarStatistics(int columns, int rows) : m_Columns(std::max(1, columns)), m_Rows(std::max(1, rows))
+{
+    reset();
+}
+
+void StarStatistics::reset(int width, int height)
+{
+    m_Width = width;
+    m_Height = height;
+    m_Count = 0;
+    m_Saturated = 0;
+    m_MaxHFR = -1;
+    m_HFR.reset();
+    m_UnsaturatedHFR.reset();
+    m_Ellipticity.reset();
+    m_TileHFR.fill(P2Quantile(), m_Columns * m_Rows);
+}
+
+void StarStatistics::add(double x, double y, double HFR, double ellipticity, double peak)
+{
+    m_Count++;
+    m_HFR.add(HFR);
+    m_MaxHFR = std::max(m_MaxHFR, HFR);
+    m_Ellipticity.add(ellipticity);
+    if (m_Saturation > 0 && peak >= m_Saturation)
+        m_Saturated++;
+    else
+        m_UnsaturatedHFR.add(HFR);
+
+    if (m_Width > 0 && m_Height > 0 && x >= 0 && y >= 0 && x < m_Width && y < m_Height)
+    {
+        const int column = std::min(m_Columns - 1, static_cast<int>(x * m_Columns / m_Width));
+        const int row = std::min(m_Rows - 1, static_cast<int>(y * m_Rows / m_Height));
+        m_TileHFR[row * m_Columns + column].add(HFR);
+    }
+}
+
+double StarStatistics::medianHFR() const
+{
+    if (m_Count == 0)
+        return -1;
+    if (m_Saturated > 0 && m_UnsaturatedHFR.count() > 20)
+        return m_UnsaturatedHFR.value();
+    return m_HFR.value();
+}
+
+double StarStatistics::maxHFR() const
+{
+    return m_MaxHFR;
+}
+
+double StarStatistics::eccentricity() const
+{
+    if (m_Count == 0)
+        return -1;
+    // SEP gives the ellipticity (flattening), the eccentricity is sqrt(ellipticity * (2 - ellipticity))
+    const double ellipticity = m_Ellipticity.value();
+    return std::sqrt(ellipticity * (2 - ellipticity));
+}
+
+int StarStatistics::tileCount(int tile) const
+{
+    if (tile < 0 || tile >= m_TileHFR.size())
+        return 0;
+    return m_TileHFR[tile].count();
+}
+
+double StarStatistics::tileMedianHFR(int tile) const
+{
+    if (tileCount(tile) == 0)
+        return -1;
+    return m_TileHFR[tile].value();
+}
@@ -0,0 +1,125 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QVector>
+
+#include <array>
+
+/**
+ * @class P2Quantile
+ * @short Running estimate of a quantile in constant memory.
+ *
+ * The P-square algorithm of Jain and Chlamtac, "The P2 algorithm for dynamic calculation of
+ * quantiles and histograms without storing observations", CACM 28(10), 1985. Five markers
+ * are kept and moved with a parabolic fit as values are added. The first five values are
+ * kept, so the estimate is exact up to then.
+ */
+class P2Quantile
+{
+    public:
+        explicit P2Quantile(double quantile = 0.5);
+
+        void add(double value);
+        void reset();
+
+        /** @return the estimate, 0 if no value was added */
+        double value() const;
+        int count() const
+        {
+            return m_Count;
+        }
+
+    private:
+        double parabolic(int i, int d) const;
+        double linear(int i, int d) const;
+
+        double m_Quantile { 0.5 };
+        int m_Count { 0 };
+        // Marker heights, actual and desired positions, and increments of the desired positions
+        std::array<double, 5> m_Heights {};
+        std::array<int, 5> m_Positions {};
+        std::array<double, 5> m_Desired {};
+        std::array<double, 5> m_Increments {};
+};
+
+/**
+ * @class StarStatistics
+ * @short Folds the stars of a frame into the aggregates the callers of a detection need.
+ *
+ * Capture only reports the HFR, eccentricity and count of the stars of a frame, and tilt only
+ * needs the HFR of each tile of the sensor. The detector can fold its stars in here as it
+ * goes instead of building a list of Edges, so memory doesn't grow with the number of stars.
+ *
+ * HFR and ellipticity are summarised by running medians, HFR also by its maximum. Stars above
+ * the saturation level are counted but, like in FITSData::getHFR(), only left out of the HFR
+ * if more than 20 unsaturated stars remain.
+ */
+class StarStatistics
+{
+    public:
+        /**
+         * @param columns number of tile columns over the frame, 1 for no tiles
+         * @param rows number of tile rows
+         */
+        explicit StarStatistics(int columns = 1, int rows = 1);
+
+        /** @short Forget all stars and use a frame of @p width x @p height pixels for the tiles */
+        void reset(int width = 0, int height = 0);
+
+        /** @short Values at or above @p saturation are saturated, 0 to not check */
+        void setSaturation(double saturation)
+        {
+            m_Saturation = saturation;
+        }
+
+        void add(double x, double y, double HFR, double ellipticity, double peak);
+
+        int count() const
+        {
+            return m_Count;
+        }
+        int saturated() const
+        {
+            return m_Saturated;
+        }
+
+        /** @return median HFR, -1 if there are no stars */
+        double medianHFR() const;
+        /** @return largest HFR, -1 if there are no stars */
+        double maxHFR() const;
+        /** @return the eccentricity of the median ellipticity, -1 if there are no stars */
+        double eccentricity() const;
+
+        int columns() const
+        {
+            return m_Columns;
+        }
+        int rows() const
+        {
+            return m_Rows;
+        }
+        /** @return number of stars in @p tile, tiles are row major from the top left */
+        int tileCount(int tile) const;
+        /** @return median HFR of the stars in @p tile, -1 if there are none */
+        double tileMedianHFR(int tile) const;
+
+    private:
+        int m_Columns { 1 };
+        int m_Rows { 1 };
+        int m_Width { 0 };
+        int m_Height { 0 };
+        double m_Saturation { 0 };
+
+        int m_Count { 0 };
+        int m_Saturated { 0 };
+        double m_MaxHFR { -1 };
+        P2Quantile m_HFR;
+        P2Quantile m_UnsaturatedHFR;
+        P2Quantile m_Ellipticity;
+        QVector<P2Quantile> m_TileHFR;
+};
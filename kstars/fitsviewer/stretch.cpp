@@ -4,10 +4,13 @@
 */
 
 #include "stretch.h"
+#include "auxiliary/robuststatistics.h"
+#include "auxiliary/executors.h"
 
 #include <fitsio.h>
 #include <math.h>
-#include <QtConcurrent>
+
+#include <vector>
 
 namespace
 {
@@ -45,11 +48,67 @@ T median(T const *values, int size, int sampleBy)
     return median(samples);
 }
 
-// This stretches one channel given the input parameters.
+// The midtones transfer function for one channel, with the expressions that do not
+// depend on the sample precomputed.
 // Based on the spec in section 8.5.6
 // https://pixinsight.com/doc/docs/XISF-1.0-spec/XISF-1.0-spec.html
-// Uses multiple threads, blocks until done.
 // The extension parameters are not used.
+template <typename T>
+struct ChannelStretch
+{
+    // We're outputting uint8, so the max output is 255.
+    static constexpr int maxOutput = 255;
+
+    ChannelStretch(const StretchParams1Channel &params, float maxInput)
+    {
+        midtones = params.midtones;
+        const float highlights = params.highlights;
+        const float shadows    = params.shadows;
+
+        // highlights - shadows, protecting for divide-by-0, in a 0->1.0 scale.
+        const float hsRangeFactor = highlights == shadows ? 1.0f : 1.0f / (highlights - shadows);
+        // Shadow and highlight values translated to the ADU scale.
+        nativeShadows = shadows * maxInput;
+        nativeHighlights = highlights * maxInput;
+        // Constants based on above needed for the stretch calculations.
+        k1 = (midtones - 1) * hsRangeFactor * maxOutput / maxInput;
+        k2 = ((2 * midtones) - 1) * hsRangeFactor / maxInput;
+    }
+
+    uint8_t operator()(T input) const
+    {
+        if (input < nativeShadows) return 0;
+        else if (input >= nativeHighlights) return maxOutput;
+        const T inputFloored = (input - nativeShadows);
+        return (inputFloored * k1) / (inputFloored * k2 - midtones);
+    }
+
+    T nativeShadows, nativeHighlights;
+    float midtones, k1, k2;
+};
+
+// For 8 and 16-bit unsigned samples the stretched value only depends on the input value,
+// so when there are more samples to stretch than possible values, we tabulate the function
+// once and the per-sample work becomes a table lookup.
+// Returns an empty table if a lookup table does not apply or would not pay off.
+template <typename T>
+std::vector<uint8_t> stretchLookupTable(const ChannelStretch<T> &stretch, int numSamples)
+{
+    std::vector<uint8_t> table;
+    if constexpr (std::is_integral<T>::value && std::is_unsigned<T>::value && sizeof(T) <= 2)
+    {
+        constexpr int tableSize = 1 << (8 * sizeof(T));
+        if (numSamples < tableSize)
+            return table;
+        table.resize(tableSize);
+        for (int value = 0; value < tableSize; ++value)
+            table[value] = stretch(static_cast<T>(value));
+    }
+    return table;
+}
+
+// This stretches one channel given the input parameters.
+// Uses multiple threads, blocks until done.
 // Sampling is applied to the output (that is, with sampling=2, we compute every other output
 // sample both in width and height, so the output would have about 4X fewer pixels.
 template <typename T>
@@ -59,44 +118,30 @@ void stretchOneChannel(T *input_buffer, QImage *output_image,
 {
     QVector<QFuture<void>> futures;
 
-    // We're outputting uint8, so the max output is 255.
-    constexpr int maxOutput = 255;
-
     // Maximum possible input value (e.g. 1024*64 - 1 for a 16 bit unsigned int).
     const float maxInput = input_range > 1 ? input_range - 1 : input_range;
 
-    const float midtones   = stretch_params.grey_red.midtones;
-    const float highlights = stretch_params.grey_red.highlights;
-    const float shadows    = stretch_params.grey_red.shadows;
-
-    // Precomputed expressions moved out of the loop.
-    // highlights - shadows, protecting for divide-by-0, in a 0->1.0 scale.
-    const float hsRangeFactor = highlights == shadows ? 1.0f : 1.0f / (highlights - shadows);
-    // Shadow and highlight values translated to the ADU scale.
-    const T nativeShadows = shadows * maxInput;
-    const T nativeHighlights = highlights * maxInput;
-    // Constants based on above needed for the stretch calculations.
-    const float k1 = (midtones - 1) * hsRangeFactor * maxOutput / maxInput;
-    const float k2 = ((2 * midtones) - 1) * hsRangeFactor / maxInput;
+    const ChannelStretch<T> stretch(stretch_params.grey_red, maxInput);
+    const std::vector<uint8_t> table = stretchLookupTable(stretch, output_image->width() * output_image->height());
+    const uint8_t *lut = table.empty() ? nullptr : table.data();
 
     // Increment the input index by the sampling, the output index increments by 1.
     for (int j = 0, jout = 0; j < image_height; j += sampling, jout++)
     {
-        futures.append(QtConcurrent::run([ = ]()
+        futures.append(Executors::run(Executors::Interactive, [ = ]()
         {
             T * inputLine  = input_buffer + j * image_width;
             auto * scanLine = output_image->scanLine(jout);
 
-            for (int i = 0, iout = 0; i < image_width; i += sampling, iout++)
+            if (lut != nullptr)
+            {
+                for (int i = 0, iout = 0; i < image_width; i += sampling, iout++)
+                    scanLine[iout] = lut[inputLine[i]];
+            }
+            else
             {
-                const T input = inputLine[i];
-                if (input < nativeShadows) scanLine[iout] = 0;
-                else if (input >= nativeHighlights) scanLine[iout] = maxOutput;
-                else
-                {
-                    const T inputFloored = (input - nativeShadows);
-                    scanLine[iout] = (inputFloored * k1) / (inputFloored * k2 - midtones);
-                }
+                for (int i = 0, iout = 0; i < image_width; i += sampling, iout++)
+                    scanLine[iout] = stretch(inputLine[i]);
             }
         }));
     }
@@ -105,9 +150,8 @@ void stretchOneChannel(T *input_buffer, QImage *output_image,
 }
 
 // This is like the above 1-channel stretch, but extended for 3 channels.
-// This could have been more modular, but the three channels are combined
-// into a single qRgb value at the end, so it seems the simplest thing is to
-// replicate the code. It is assume the colors are not interleaved--the red image
+// The three channels are combined into a single qRgb value at the end.
+// It is assume the colors are not interleaved--the red image
 // is stored fully, then the green, then the blue.
 // Sampling is applied to the output (that is, with sampling=2, we compute every other output
 // sample both in width and height, so the output would have about 4X fewer pixels.
@@ -118,47 +162,26 @@ void stretchThreeChannels(T *inputBuffer, QImage *outputImage,
 {
     QVector<QFuture<void>> futures;
 
-    // We're outputting uint8, so the max output is 255.
-    constexpr int maxOutput = 255;
-
     // Maximum possible input value (e.g. 1024*64 - 1 for a 16 bit unsigned int).
     const float maxInput = inputRange > 1 ? inputRange - 1 : inputRange;
 
-    const float midtonesR   = stretchParams.grey_red.midtones;
-    const float highlightsR = stretchParams.grey_red.highlights;
-    const float shadowsR    = stretchParams.grey_red.shadows;
-    const float midtonesG   = stretchParams.green.midtones;
-    const float highlightsG = stretchParams.green.highlights;
-    const float shadowsG    = stretchParams.green.shadows;
-    const float midtonesB   = stretchParams.blue.midtones;
-    const float highlightsB = stretchParams.blue.highlights;
-    const float shadowsB    = stretchParams.blue.shadows;
-
-    // Precomputed expressions moved out of the loop.
-    // highlights - shadows, protecting for divide-by-0, in a 0->1.0 scale.
-    const float hsRangeFactorR = highlightsR == shadowsR ? 1.0f : 1.0f / (highlightsR - shadowsR);
-    const float hsRangeFactorG = highlightsG == shadowsG ? 1.0f : 1.0f / (highlightsG - shadowsG);
-    const float hsRangeFactorB = highlightsB == shadowsB ? 1.0f : 1.0f / (highlightsB - shadowsB);
-    // Shadow and highlight values translated to the ADU scale.
-    const T nativeShadowsR = shadowsR * maxInput;
-    const T nativeShadowsG = shadowsG * maxInput;
-    const T nativeShadowsB = shadowsB * maxInput;
-    const T nativeHighlightsR = highlightsR * maxInput;
-    const T nativeHighlightsG = highlightsG * maxInput;
-    const T nativeHighlightsB = highlightsB * maxInput;
-    // Constants based on above needed for the stretch calculations.
-    const float k1R = (midtonesR - 1) * hsRangeFactorR * maxOutput / maxInput;
-    const float k1G = (midtonesG - 1) * hsRangeFactorG * maxOutput / maxInput;
-    const float k1B = (midtonesB - 1) * hsRangeFactorB * maxOutput / maxInput;
-    const float k2R = ((2 * midtonesR) - 1) * hsRangeFactorR / maxInput;
-    const float k2G = ((2 * midtonesG) - 1) * hsRangeFactorG / maxInput;
-    const float k2B = ((2 * midtonesB) - 1) * hsRangeFactorB / maxInput;
+    const ChannelStretch<T> stretchR(stretchParams.grey_red, maxInput);
+    const ChannelStretch<T> stretchG(stretchParams.green, maxInput);
+    const ChannelStretch<T> stretchB(stretchParams.blue, maxInput);
+
+    const int numOutputSamples = outputImage->width() * outputImage->height();
+    const std::vector<uint8_t> tableR = stretchLookupTable(stretchR, numOutputSamples);
+    const std::vector<uint8_t> tableG = stretchLookupTable(stretchG, numOutputSamples);
+    const std::vector<uint8_t> tableB = stretchLookupTable(stretchB, numOutputSamples);
+    const uint8_t *lutR = tableR.empty() ? nullptr : tableR.data();
+    const uint8_t *lutG = tableG.data();
+    const uint8_t *lutB = tableB.data();
 
     const int size = imageWidth * imageHeight;
 
     for (int j = 0, jout = 0; j < imageHeight; j += sampling, jout++)
     {
-        futures.append(QtConcurrent::run([ = ]()
+        futures.append(Executors::run(Executors::Interactive, [ = ]()
         {
             // R, G, B input images are stored one after another.
             T * inputLineR  = inputBuffer + j * imageWidth;
@@ -167,38 +190,15 @@ void stretchThreeChannels(T *inputBuffer, QImage *outputImage,
 
             auto * scanLine = reinterpret_cast<QRgb*>(outputImage->scanLine(jout));
 
-            for (int i = 0, iout = 0; i < imageWidth; i += sampling, iout++)
+            if (lutR != nullptr)
             {
-                const T inputR = inputLineR[i];
-                const T inputG = inputLineG[i];
-                const T inputB = inputLineB[i];
-
-                uint8_t red, green, blue;
-
-                if (inputR < nativeShadowsR) red = 0;
-                else if (inputR >= nativeHighlightsR) red = maxOutput;
-                else
-                {
-                    const T inputFloored = (inputR - nativeShadowsR);
-                    red = (inputFloored * k1R) / (inputFloored * k2R - midtonesR);
-                }
-
-                if (inputG < nativeShadowsG) green = 0;
-                else if (inputG >= nativeHighlightsG) green = maxOutput;
-                else
-                {
-                    const T inputFloored = (inputG - nativeShadowsG);
-                    green = (inputFloored * k1G) / (inputFloored * k2G - midtonesG);
-                }
-
-                if (inputB < nativeShadowsB) blue = 0;
-                else if (inputB >= nativeHighlightsB) blue = maxOutput;
-                else
-                {
-                    const T inputFloored = (inputB - nativeShadowsB);
-                    blue = (inputFloored * k1B) / (inputFloored * k2B - midtonesB);
-                }
-                scanLine[iout] = qRgb(red, green, blue);
+                for (int i = 0, iout = 0; i < imageWidth; i += sampling, iout++)
+                    scanLine[iout] = qRgb(lutR[inputLineR[i]], lutG[inputLineG[i]], lutB[inputLineB[i]]);
+            }
+            else
+            {
+                for (int i = 0, iout = 0; i < imageWidth; i += sampling, iout++)
+                    scanLine[iout] = qRgb(stretchR(inputLineR[i]), stretchG(inputLineG[i]), stretchB(inputLineB[i]));
             }
         }));
     }
@@ -228,20 +228,31 @@ void computeParamsOneChannel(T const *buffer, StretchParams1Channel *params,
     constexpr int maxSamples = 500000;
     const int sampleBy = width * height < maxSamples ? 1 : width * height / maxSamples;
 
-    T medianSample = median(buffer, width * height, sampleBy);
-    // Find the Median deviation: 1.4826 * median of abs(sample[i] - median).
-    const int numSamples = width * height / sampleBy;
-    std::vector<T> deviations(numSamples);
-    for (int index = 0, i = 0; i < numSamples; ++i, index += sampleBy)
+    float medianSample, medDev;
+    if constexpr (std::is_integral<T>::value)
     {
-        if (medianSample > buffer[index])
-            deviations[i] = medianSample - buffer[index];
-        else
-            deviations[i] = buffer[index] - medianSample;
+        // Integer samples can be histogrammed in one pass without copying or sorting them.
+        const auto stats = Mathematics::RobustStatistics::ComputeHistogramStatistics(buffer, width * height, sampleBy);
+        medianSample = stats.median;
+        medDev = stats.mad;
+    }
+    else
+    {
+        medianSample = median(buffer, width * height, sampleBy);
+        // Find the Median deviation: 1.4826 * median of abs(sample[i] - median).
+        const int numSamples = width * height / sampleBy;
+        std::vector<T> deviations(numSamples);
+        for (int index = 0, i = 0; i < numSamples; ++i, index += sampleBy)
+        {
+            if (medianSample > buffer[index])
+                deviations[i] = medianSample - buffer[index];
+            else
+                deviations[i] = buffer[index] - medianSample;
+        }
+        medDev = median(deviations);
     }
 
     // Shift everything to 0 -> 1.0.
-    const float medDev = median(deviations);
     const float normalizedMedian = medianSample / static_cast<float>(inputRange);
     const float MADN = 1.4826 * medDev / static_cast<float>(inputRange);
 
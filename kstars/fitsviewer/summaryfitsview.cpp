@@ -7,9 +7,16 @@
 #include "summaryfitsview.h"
 #include "QGraphicsOpacityEffect"
 
+#include <QLabel>
+
 
 SummaryFITSView::SummaryFITSView(QWidget *parent): FITSView(parent, FITS_NORMAL, FITS_NONE)
 {
+    previewLabel = new QLabel(this);
+    previewLabel->setAlignment(Qt::AlignCenter);
+    previewLabel->setStyleSheet("background-color: black;");
+    previewLabel->setVisible(false);
+
     processInfoWidget = new QWidget(this);
     processInfoWidget->setVisible(m_showProcessInfo);
     processInfoWidget->setGraphicsEffect(new QGraphicsOpacityEffect(this));
@@ -42,6 +49,37 @@ void SummaryFITSView::resizeEvent(QResizeEvent *event)
     FITSView::resizeEvent(event);
     // forward the viewport geometry to the overlay
     processInfoWidget->setGeometry(this->viewport()->geometry());
+    previewLabel->setGeometry(this->viewport()->geometry());
+    updatePreview();
+}
+
+void SummaryFITSView::showPreview(const QImage &preview)
+{
+    if (preview.isNull())
+    {
+        hidePreview();
+        return;
+    }
+    m_preview = QPixmap::fromImage(preview);
+    previewLabel->setGeometry(viewport()->geometry());
+    updatePreview();
+    previewLabel->show();
+    // keep the process information on top
+    processInfoWidget->raise();
+}
+
+void SummaryFITSView::hidePreview()
+{
+    previewLabel->hide();
+    previewLabel->clear();
+    m_preview = QPixmap();
+}
+
+void SummaryFITSView::updatePreview()
+{
+    if (m_preview.isNull() || previewLabel->size().isEmpty())
+        return;
+    previewLabel->setPixmap(m_preview.scaled(previewLabel->size(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
 }
 
 
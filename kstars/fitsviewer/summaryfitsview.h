@@ -12,6 +12,8 @@
 
 #include "fitsview.h"
 
+class QLabel;
+
 class SummaryFITSView : public FITSView
 {
     Q_OBJECT
@@ -25,6 +27,13 @@ public:
     // process information widget
     QWidget *processInfoWidget;
 
+    /**
+     * @brief Show a stretched preview of an image over the view, e.g. until the image itself is loaded.
+     * A null preview hides it.
+     */
+    void showPreview(const QImage &preview);
+    void hidePreview();
+
 public slots:
     // process information
     void showProcessInfo(bool show);
@@ -37,4 +46,9 @@ private:
     bool m_showProcessInfo { false };
     QAction *toggleProcessInfoAction { nullptr };
 
+    // preview shown over the view
+    QLabel *previewLabel { nullptr };
+    QPixmap m_preview;
+    void updatePreview();
+
 };
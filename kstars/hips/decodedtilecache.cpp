@@ -0,0 +1,195 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "decodedtilecache.h"
+
+#include "kstars_debug.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+DecodedTileCache::DecodedTileCache(const QString &directory) : m_directory(directory)
+{
+    m_writer.setMaxThreadCount(1);
+}
+
+DecodedTileCache::~DecodedTileCache()
+{
+    m_writer.waitForDone();
+}
+
+void DecodedTileCache::setMaximumSize(qint64 size)
+{
+    m_maximumSize = size;
+}
+
+QString DecodedTileCache::filePath(const pixCacheKey_t &key) const
+{
+    return QString("%1/%2/Norder%3/Npix%4.tile").arg(m_directory).arg(key.uid).arg(key.level).arg(key.pix);
+}
+
+bool DecodedTileCache::contains(const pixCacheKey_t &key) const
+{
+    return m_maximumSize > 0 && QFileInfo::exists(filePath(key));
+}
+
+QImage *DecodedTileCache::load(const pixCacheKey_t &key) const
+{
+    if (m_maximumSize <= 0)
+        return nullptr;
+
+    auto *file = new QFile(filePath(key));
+    if (file->open(QIODevice::ReadOnly) == false || file->size() < static_cast<qint64>(sizeof(Header)))
+    {
+        delete file;
+        return nullptr;
+    }
+
+    const uchar *data = file->map(0, file->size());
+    if (data == nullptr)
+    {
+        delete file;
+        return nullptr;
+    }
+
+    Header header;
+    memcpy(&header, data, sizeof(Header));
+
+    const bool valid = header.magic == MAGIC && header.version == VERSION && header.width > 0 && header.height > 0
+                       && header.format > QImage::Format_Invalid && header.format < QImage::NImageFormats
+                       && header.bytesPerLine % 4 == 0
+                       && file->size() == static_cast<qint64>(sizeof(Header)) + static_cast<qint64>(header.bytesPerLine) * header.height;
+    if (valid == false)
+    {
+        qCWarning(KSTARS) << "Invalid decoded HiPS tile" << file->fileName();
+        file->close();
+        file->remove();
+        delete file;
+        return nullptr;
+    }
+
+    // The file stays mapped until the image is deleted. Deleting the file unmaps it.
+    return new QImage(data + sizeof(Header), header.width, header.height, header.bytesPerLine,
+                      static_cast<QImage::Format>(header.format), [](void *info)
+    {
+        delete static_cast<QFile *>(info);
+    }, file);
+}
+
+void DecodedTileCache::store(const pixCacheKey_t &key, const QImage &image)
+{
+    if (m_maximumSize <= 0 || image.isNull())
+        return;
+
+    QtConcurrent::run(&m_writer, [this, key, image]()
+    {
+        write(key, image);
+    });
+}
+
+void DecodedTileCache::write(const pixCacheKey_t &key, const QImage &image)
+{
+    // Palette images would need their color table, store them as plain pixels instead.
+    QImage tile = image;
+    if (tile.colorCount() > 0 || tile.depth() < 8)
+        tile = tile.convertToFormat(tile.allGray() ? QImage::Format_Grayscale8 :
+                                    tile.hasAlphaChannel() ? QImage::Format_ARGB32 : QImage::Format_RGB32);
+
+    if (m_size < 0)
+    {
+        qint64 size = 0;
+        QDirIterator it(m_directory, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext())
+        {
+            it.next();
+            size += it.fileInfo().size();
+        }
+        m_size = size;
+    }
+
+    const QString path = filePath(key);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    const qint64 previousSize = QFileInfo(path).size();
+
+    Header header;
+    memset(&header, 0, sizeof(Header));
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.width = tile.width();
+    header.height = tile.height();
+    header.bytesPerLine = tile.bytesPerLine();
+    header.format = tile.format();
+
+    QSaveFile file(path);
+    if (file.open(QIODevice::WriteOnly) == false
+            || file.write(reinterpret_cast<const char *>(&header), sizeof(Header)) != static_cast<qint64>(sizeof(Header))
+            || file.write(reinterpret_cast<const char *>(tile.constBits()), tile.sizeInBytes()) != tile.sizeInBytes()
+            || file.commit() == false)
+    {
+        qCWarning(KSTARS) << "Failed to write decoded HiPS tile" << path << file.errorString();
+        return;
+    }
+
+    m_size += static_cast<qint64>(sizeof(Header)) + tile.sizeInBytes() - previousSize;
+
+    if (m_size > m_maximumSize)
+        trim();
+}
+
+void DecodedTileCache::trim()
+{
+    struct Entry
+    {
+        QDateTime modified;
+        QString path;
+        qint64 size;
+    };
+
+    std::vector<Entry> entries;
+    QDirIterator it(m_directory, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext())
+    {
+        it.next();
+        entries.push_back({it.fileInfo().lastModified(), it.filePath(), it.fileInfo().size()});
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry & a, const Entry & b)
+    {
+        return a.modified < b.modified;
+    });
+
+    qint64 size = 0;
+    for (const Entry &entry : entries)
+        size += entry.size;
+
+    // Leave some room so that the next tiles do not trigger another scan right away.
+    const qint64 target = m_maximumSize * 9 / 10;
+    for (const Entry &entry : entries)
+    {
+        if (size <= target)
+            break;
+        if (QFile::remove(entry.path))
+            size -= entry.size;
+    }
+
+    m_size = size;
+}
+
+void DecodedTileCache::clear()
+{
+    m_writer.waitForDone();
+    QDir(m_directory).removeRecursively();
+    m_size = 0;
+}
@@ -0,0 +1,79 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "hips.h"
+
+#include <QThreadPool>
+
+#include <atomic>
+
+/**
+ * @class DecodedTileCache
+ * On disc cache of decoded HiPS tiles.
+ *
+ * The network disc cache keeps the tiles as downloaded, so every tile evicted from the memory cache
+ * has to be decoded again from JPEG or PNG. This cache keeps the decoded pixels instead, one raw file
+ * per tile, which are memory mapped on load and wrapped in a QImage without any copy or decoding.
+ *
+ * Tiles are written on a background thread. When the cache grows past its maximum size, the oldest
+ * files are removed.
+ */
+class DecodedTileCache
+{
+    public:
+        explicit DecodedTileCache(const QString &directory);
+        ~DecodedTileCache();
+
+        /// Maximum size on disc in bytes, zero disables the cache.
+        void setMaximumSize(qint64 size);
+        qint64 size() const
+        {
+            return m_size > 0 ? m_size.load() : 0;
+        }
+
+        bool contains(const pixCacheKey_t &key) const;
+
+        /**
+         * @brief load Map the tile file in memory.
+         * @return a read only image using the mapped file as its buffer, to be deleted by the caller,
+         * or nullptr if the tile is not in the cache.
+         */
+        QImage *load(const pixCacheKey_t &key) const;
+
+        /// Write the tile to the cache in the background.
+        void store(const pixCacheKey_t &key, const QImage &image);
+
+        void clear();
+
+    private:
+        struct Header
+        {
+            quint32 magic;
+            quint32 version;
+            qint32 width;
+            qint32 height;
+            qint32 bytesPerLine;
+            qint32 format;
+            // Keeps the pixels aligned for SIMD loads.
+            qint32 reserved[2];
+        };
+
+        static constexpr quint32 MAGIC = 0x5448534b; // "KSHT"
+        static constexpr quint32 VERSION = 1;
+
+        QString filePath(const pixCacheKey_t &key) const;
+        void write(const pixCacheKey_t &key, const QImage &image);
+        void trim();
+
+        QString m_directory;
+        std::atomic<qint64> m_maximumSize { 0 };
+        // Bytes used on disc, -1 until the directory was scanned.
+        std::atomic<qint64> m_size { -1 };
+        // Single writer thread, so the files and m_size are only modified in one place.
+        QThreadPool m_writer;
+};
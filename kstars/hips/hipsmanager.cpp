@@ -79,6 +79,9 @@ HIPSManager::HIPSManager() : QObject(KStars::Instance())
     value = Options::hIPSMemoryCache() * 1024 * 1024;
     m_cache.setMaxCost(Options::hIPSMemoryCache() * 1024 * 1024);
 
+    m_decodedCache.reset(new DecodedTileCache(QDir(KSPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("hips-decoded")));
+    m_decodedCache->setMaximumSize(static_cast<qint64>(Options::hIPSDecodedCache()) * 1024 * 1024);
+
 
 
 }
@@ -112,6 +115,8 @@ void HIPSManager::showSettings()
 
 void HIPSManager::slotApply()
 {
+    m_decodedCache->setMaximumSize(static_cast<qint64>(Options::hIPSDecodedCache()) * 1024 * 1024);
+
     if (Options::hIPSUseOfflineSource())
     {
         QDir hipsDirectory(Options::hIPSOfflinePath());
@@ -127,7 +132,7 @@ void HIPSManager::slotApply()
 
 qint64 HIPSManager::getDiscCacheSize() const
 {
-    return g_discCache->cacheSize();
+    return g_discCache->cacheSize() + m_decodedCache->size();
 }
 
 void HIPSManager::readSources()
@@ -222,6 +227,16 @@ QImage *HIPSManager::getPix(bool allsky, int level, int pix, bool &freeImage)
         return cacheImage;
     }
 
+    // Decoded before, map it from disc instead of decoding it again.
+    QImage *decodedImage = m_decodedCache->load(key);
+    if (decodedImage != nullptr)
+    {
+        item = new pixCacheItem_t;
+        item->image = decodedImage;
+        addToMemoryCache(key, item);
+        return getPix(allsky, level, origPix, freeImage);
+    }
+
     QString path;
 
     if (!allsky)
@@ -334,6 +349,35 @@ bool HIPSManager::parseProperties(hipsParams_t *param, const QString &filename,
 }
 #endif
 
+bool HIPSManager::prefetch(int level, int pix)
+{
+    if (m_prefetchMap.size() >= static_cast<int>(Options::hIPSPrefetchTiles()))
+        return false;
+
+    if (level < 3 || level > m_currentOrder || (Options::hIPSUseOfflineSource() == false && m_currentSource.isEmpty()))
+        return true;
+
+    pixCacheKey_t key;
+
+    key.level = level;
+    key.pix = pix;
+    key.uid = m_uid;
+
+    if (m_downloadMap.contains(key) || getCacheItem(key) != nullptr || m_decodedCache->contains(key))
+        return true;
+
+    QString path = "/Norder" + QString::number(level) + "/Dir" + QString::number((pix / 10000) * 10000) + "/Npix" +
+                   QString::number(pix) + '.' + m_currentFormat;
+
+    QUrl downloadURL(m_currentURL);
+    downloadURL.setPath(downloadURL.path() + path);
+    g_download->begin(downloadURL, key);
+    m_downloadMap.insert(key);
+    m_prefetchMap.insert(key);
+
+    return true;
+}
+
 void HIPSManager::cancelAll()
 {
     g_download->abortAll();
@@ -342,10 +386,13 @@ void HIPSManager::cancelAll()
 void HIPSManager::clearDiscCache()
 {
     g_discCache->clear();
+    m_decodedCache->clear();
 }
 
 void HIPSManager::slotDone(QNetworkReply::NetworkError error, QByteArray &data, pixCacheKey_t &key)
 {
+    m_prefetchMap.remove(key);
+
     if (error == QNetworkReply::NoError)
     {
         m_downloadMap.remove(key);
@@ -355,6 +402,7 @@ void HIPSManager::slotDone(QNetworkReply::NetworkError error, QByteArray &data,
         item->image = new QImage();
         if (item->image->loadFromData(data))
         {
+            m_decodedCache->store(key, *item->image);
             addToMemoryCache(key, item);
 
             //SkyMap::Instance()->forceUpdate();
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "decodedtilecache.h"
 #include "hips.h"
 #include "opships.h"
 #include "pixcache.h"
@@ -53,6 +54,13 @@ class HIPSManager : public QObject
 
         QImage *getPix(bool allsky, int level, int pix, bool &freeImage);
 
+        /**
+         * @brief prefetch Start downloading a tile which is not shown yet but is likely to be soon.
+         * Tiles already in memory, being downloaded or in the decoded tile cache are skipped.
+         * @return false if no more prefetches can be started, as HIPSPrefetchTiles are already in flight.
+         */
+        bool prefetch(int level, int pix);
+
         void readSources();
 
         void cancelAll();
@@ -117,6 +125,8 @@ class HIPSManager : public QObject
         // Cache
         PixCache m_cache;
         QSet <pixCacheKey_t> m_downloadMap;
+        QSet <pixCacheKey_t> m_prefetchMap;
+        std::unique_ptr<DecodedTileCache> m_decodedCache;
 
         void addToMemoryCache(pixCacheKey_t &key, pixCacheItem_t *item);
         pixCacheItem_t *getCacheItem(pixCacheKey_t &key);
@@ -14,10 +14,17 @@
 #include "skymap.h"
 #include "skyqpainter.h"
 #include "projections/projector.h"
+#include "auxiliary/executors.h"
+
+#include <QThread>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
 
 HIPSRenderer::HIPSRenderer()
 {
-    m_scanRender.reset(new ScanRender());
     m_HEALpix.reset(new HEALPix());
 }
 
@@ -92,25 +99,37 @@ bool HIPSRenderer::render(uint16_t w, uint16_t h, QImage *hipsImage, const Proje
     if (size < 0)
         size = HIPSManager::Instance()->getCurrentTileWidth();
 
-    bool old = m_scanRender->isBilinearInterpolationEnabled();
-    m_scanRender->setBilinearInterpolationEnabled(Options::hIPSBiLinearInterpolation()
-            && (size >= HIPSManager::Instance()->getCurrentTileWidth() || allSky));
+    bool bilinear = Options::hIPSBiLinearInterpolation()
+                    && (size >= HIPSManager::Instance()->getCurrentTileWidth() || allSky);
+
+    // The visible tiles and their images are gathered first, then rasterized all at once so that the
+    // bands of the destination can be filled in parallel. HIPSManager and the projector are only used here,
+    // on the calling thread.
+    m_tiles.clear();
+    collectRec(allSky, level, centerPix);
+
+    rasterizeTiles(hipsImage, bilinear);
+
+    if (Options::hIPSShowGrid())
+        drawGrid(level, hipsImage);
 
-    renderRec(allSky, level, centerPix, hipsImage);
+    // The all sky image covers the whole sky already.
+    if (allSky == false)
+        prefetch(level, centerPix, ra, de, fov);
 
-    m_scanRender->setBilinearInterpolationEnabled(old);
+    m_tiles.clear();
 
     return true;
 }
 
-void HIPSRenderer::renderRec(bool allsky, int level, int pix, QImage *pDest)
+void HIPSRenderer::collectRec(bool allsky, int level, int pix)
 {
     if (m_renderedMap.contains(pix))
     {
         return;
     }
 
-    if (renderPix(allsky, level, pix, pDest))
+    if (collectPix(allsky, level, pix))
     {
         m_renderedMap.insert(pix);
         int dirs[8];
@@ -118,132 +137,303 @@ void HIPSRenderer::renderRec(bool allsky, int level, int pix, QImage *pDest)
 
         m_HEALpix->neighbours(nside, pix, dirs);
 
-        renderRec(allsky, level, dirs[0], pDest);
-        renderRec(allsky, level, dirs[2], pDest);
-        renderRec(allsky, level, dirs[4], pDest);
-        renderRec(allsky, level, dirs[6], pDest);
+        collectRec(allsky, level, dirs[0]);
+        collectRec(allsky, level, dirs[2]);
+        collectRec(allsky, level, dirs[4]);
+        collectRec(allsky, level, dirs[6]);
     }
 }
 
-bool HIPSRenderer::renderPix(bool allsky, int level, int pix, QImage *pDest)
+bool HIPSRenderer::collectPix(bool allsky, int level, int pix)
 {
     SkyPoint cornerSkyCoords[4];
-    QPointF cornerScreenCoords[4];
-    bool freeImage = false;
+    Tile tile;
 
+    tile.pix = pix;
     m_HEALpix->getCornerPoints(level, pix, cornerSkyCoords);
     bool isVisible = false;
 
     for (int i = 0; i < 4; i++)
     {
-        cornerScreenCoords[i] = m_projector->toScreen(&cornerSkyCoords[i]);
+        tile.cornerScreenCoords[i] = m_projector->toScreen(&cornerSkyCoords[i]);
         isVisible |= m_projector->checkVisibility(&cornerSkyCoords[i]);
     }
 
     //if (SKPLANECheckFrustumToPolygon(trfGetFrustum(), pts, 4))
     // Is the right way to do this?
 
-    if (isVisible)
+    if (isVisible == false)
+        return false;
+
+    m_blocks++;
+
+    /*for (int i = 0; i < 4; i++)
     {
-        m_blocks++;
+      trfProjectPointNoCheck(&pts[i]);
+    } */
 
-        /*for (int i = 0; i < 4; i++)
-        {
-          trfProjectPointNoCheck(&pts[i]);
-        } */
+    bool freeImage = false;
+    QImage *image = HIPSManager::Instance()->getPix(allsky, level, pix, freeImage);
+
+    if (image)
+    {
+        tile.image = *image;
+        if (freeImage)
+            delete image;
+
+        m_rendered++;
+
+        m_size += tile.image.sizeInBytes();
 
-        QImage *image = HIPSManager::Instance()->getPix(allsky, level, pix, freeImage);
+        int childPixelID[4];
 
-        if (image)
+        // Find all the 4 children of the current pixel
+        m_HEALpix->getPixChilds(pix, childPixelID);
+
+        double top = std::numeric_limits<double>::max();
+        double bottom = std::numeric_limits<double>::lowest();
+        bool bounded = true;
+
+        int j = 0;
+        for (int id : childPixelID)
         {
-            m_rendered++;
-
-            m_size += image->sizeInBytes();
-
-            // UV Mapping to apply image unto the destination image
-            // 4x4 = 16 points are mapped from the source image unto the destination image.
-            // Starting from each grandchild pixel, each pix polygon is mapped accordingly.
-            // For example, pixel 357 will have 4 child pixels, each of them will have 4 childs pixels and so
-            // on. Each healpix pixel appears roughly as a diamond on the sky map.
-            // The corners points for HealPIX moves from NORTH -> EAST -> SOUTH -> WEST
-            // Hence first point is 0.25, 0.25 in UV coordinate system.
-            // Depending on the selected algorithm, the mapping will either utilize nearest neighbour
-            // or bilinear interpolation.
-            QPointF uv[16][4] = {{QPointF(.25, .25), QPointF(0.25, 0), QPointF(0, .0), QPointF(0, .25)},
-                {QPointF(.25, .5), QPointF(0.25, 0.25), QPointF(0, .25), QPointF(0, .5)},
-                {QPointF(.5, .25), QPointF(0.5, 0), QPointF(.25, .0), QPointF(.25, .25)},
-                {QPointF(.5, .5), QPointF(0.5, 0.25), QPointF(.25, .25), QPointF(.25, .5)},
-
-                {QPointF(.25, .75), QPointF(0.25, 0.5), QPointF(0, 0.5), QPointF(0, .75)},
-                {QPointF(.25, 1), QPointF(0.25, 0.75), QPointF(0, .75), QPointF(0, 1)},
-                {QPointF(.5, .75), QPointF(0.5, 0.5), QPointF(.25, .5), QPointF(.25, .75)},
-                {QPointF(.5, 1), QPointF(0.5, 0.75), QPointF(.25, .75), QPointF(.25, 1)},
-
-                {QPointF(.75, .25), QPointF(0.75, 0), QPointF(0.5, .0), QPointF(0.5, .25)},
-                {QPointF(.75, .5), QPointF(0.75, 0.25), QPointF(0.5, .25), QPointF(0.5, .5)},
-                {QPointF(1, .25), QPointF(1, 0), QPointF(.75, .0), QPointF(.75, .25)},
-                {QPointF(1, .5), QPointF(1, 0.25), QPointF(.75, .25), QPointF(.75, .5)},
-
-                {QPointF(.75, .75), QPointF(0.75, 0.5), QPointF(0.5, .5), QPointF(0.5, .75)},
-                {QPointF(.75, 1), QPointF(0.75, 0.75), QPointF(0.5, .75), QPointF(0.5, 1)},
-                {QPointF(1, .75), QPointF(1, 0.5), QPointF(.75, .5), QPointF(.75, .75)},
-                {QPointF(1, 1), QPointF(1, 0.75), QPointF(.75, .75), QPointF(.75, 1)},
-            };
-
-            int childPixelID[4];
-
-            // Find all the 4 children of the current pixel
-            m_HEALpix->getPixChilds(pix, childPixelID);
-
-            int j = 0;
-            for (int id : childPixelID)
+            int grandChildPixelID[4];
+            // Find the children of this child (i.e. grand child)
+            // Then we have 4x4 pixels under the primary pixel
+            // The image is interpolated and rendered over these pixels
+            // coordinate to minimize any distortions due to the projection
+            // system.
+            m_HEALpix->getPixChilds(id, grandChildPixelID);
+
+            for (int id2 : grandChildPixelID)
             {
-                int grandChildPixelID[4];
-                // Find the children of this child (i.e. grand child)
-                // Then we have 4x4 pixels under the primary pixel
-                // The image is interpolated and rendered over these pixels
-                // coordinate to minimize any distortions due to the projection
-                // system.
-                m_HEALpix->getPixChilds(id, grandChildPixelID);
+                SkyPoint fineSkyPoints[4];
+                m_HEALpix->getCornerPoints(level + 2, id2, fineSkyPoints);
 
-                QPointF fineScreenCoords[4];
-
-                for (int id2 : grandChildPixelID)
+                for (int i = 0; i < 4; i++)
                 {
-                    SkyPoint fineSkyPoints[4];
-                    m_HEALpix->getCornerPoints(level + 2, id2, fineSkyPoints);
+                    QPointF &point = tile.fineScreenCoords[j][i];
+                    point = m_projector->toScreen(&fineSkyPoints[i]);
+                    bounded &= std::isfinite(point.y());
+                    top = std::min(top, point.y());
+                    bottom = std::max(bottom, point.y());
+                }
+                j++;
+            }
+        }
+
+        // The subdivided polygons stay within the rows of their corners.
+        tile.top = bounded ? static_cast<int>(std::floor(std::max(top, -1e6))) : std::numeric_limits<int>::min();
+        tile.bottom = bounded ? static_cast<int>(std::ceil(std::min(bottom, 1e6))) : std::numeric_limits<int>::max();
+    }
+
+    m_tiles.append(tile);
+    return true;
+}
+
+void HIPSRenderer::rasterizeTiles(QImage *pDest, bool bilinear)
+{
+    // UV Mapping to apply image unto the destination image
+    // 4x4 = 16 points are mapped from the source image unto the destination image.
+    // Starting from each grandchild pixel, each pix polygon is mapped accordingly.
+    // For example, pixel 357 will have 4 child pixels, each of them will have 4 childs pixels and so
+    // on. Each healpix pixel appears roughly as a diamond on the sky map.
+    // The corners points for HealPIX moves from NORTH -> EAST -> SOUTH -> WEST
+    // Hence first point is 0.25, 0.25 in UV coordinate system.
+    // Depending on the selected algorithm, the mapping will either utilize nearest neighbour
+    // or bilinear interpolation.
+    static const QPointF uv[16][4] = {{QPointF(.25, .25), QPointF(0.25, 0), QPointF(0, .0), QPointF(0, .25)},
+        {QPointF(.25, .5), QPointF(0.25, 0.25), QPointF(0, .25), QPointF(0, .5)},
+        {QPointF(.5, .25), QPointF(0.5, 0), QPointF(.25, .0), QPointF(.25, .25)},
+        {QPointF(.5, .5), QPointF(0.5, 0.25), QPointF(.25, .25), QPointF(.25, .5)},
+
+        {QPointF(.25, .75), QPointF(0.25, 0.5), QPointF(0, 0.5), QPointF(0, .75)},
+        {QPointF(.25, 1), QPointF(0.25, 0.75), QPointF(0, .75), QPointF(0, 1)},
+        {QPointF(.5, .75), QPointF(0.5, 0.5), QPointF(.25, .5), QPointF(.25, .75)},
+        {QPointF(.5, 1), QPointF(0.5, 0.75), QPointF(.25, .75), QPointF(.25, 1)},
+
+        {QPointF(.75, .25), QPointF(0.75, 0), QPointF(0.5, .0), QPointF(0.5, .25)},
+        {QPointF(.75, .5), QPointF(0.75, 0.25), QPointF(0.5, .25), QPointF(0.5, .5)},
+        {QPointF(1, .25), QPointF(1, 0), QPointF(.75, .0), QPointF(.75, .25)},
+        {QPointF(1, .5), QPointF(1, 0.25), QPointF(.75, .25), QPointF(.75, .5)},
+
+        {QPointF(.75, .75), QPointF(0.75, 0.5), QPointF(0.5, .5), QPointF(0.5, .75)},
+        {QPointF(.75, 1), QPointF(0.75, 0.75), QPointF(0.5, .75), QPointF(0.5, 1)},
+        {QPointF(1, .75), QPointF(1, 0.5), QPointF(.75, .5), QPointF(.75, .75)},
+        {QPointF(1, 1), QPointF(1, 0.75), QPointF(.75, .75), QPointF(.75, 1)},
+    };
+
+    // Below this many rows per band the per-band overhead of walking all the tiles dominates.
+    constexpr int minBandHeight = 64;
+
+    const int height = pDest->height();
+    const int numBands = qBound(1, height / minBandHeight, QThread::idealThreadCount());
+    const int bandHeight = (height + numBands - 1) / numBands;
+
+    while (static_cast<int>(m_scanRenders.size()) < numBands)
+        m_scanRenders.emplace_back(new ScanRender());
+
+    // Detach the destination once here, the bands then only write to their own rows of its pixels. They must
+    // not call QImage::bits() themselves, it updates the image without synchronization.
+    uchar * const destBits = pDest->bits();
+    const int destWidth = pDest->width();
+    const int destBytesPerLine = pDest->bytesPerLine();
+
+    std::vector<int> bands(numBands);
+    std::iota(bands.begin(), bands.end(), 0);
+
+    // Every band renders the tiles in the same order, so pixels shared by adjacent tiles
+    // end up the same as when rendering serially.
+    Executors::blockingMap(Executors::Interactive, bands, [&](int band)
+    {
+        const int firstRow = band * bandHeight;
+        const int lastRow = std::min(height, firstRow + bandHeight) - 1;
+        ScanRender *scanRender = m_scanRenders[band].get();
+
+        scanRender->setBilinearInterpolationEnabled(bilinear);
+        scanRender->setClipRows(firstRow, lastRow);
+
+        for (const Tile &tile : m_tiles)
+        {
+            if (tile.image.isNull() || tile.bottom < firstRow || tile.top > lastRow)
+                continue;
+
+            for (int j = 0; j < 16; j++)
+                scanRender->renderPolygon(3, tile.fineScreenCoords[j], destBits, destWidth, height, destBytesPerLine,
+                                          &tile.image, uv[j]);
+        }
+    });
+}
+
+void HIPSRenderer::drawGrid(int level, QImage *pDest)
+{
+    QPainter p(pDest);
+    p.setRenderHint(QPainter::Antialiasing);
+    p.setPen(gridColor);
 
-                    for (int i = 0; i < 4; i++)
-                        fineScreenCoords[i] = m_projector->toScreen(&fineSkyPoints[i]);
-                    m_scanRender->renderPolygon(3, fineScreenCoords, pDest, image, uv[j]);
-                    j++;
+    for (const Tile &tile : m_tiles)
+    {
+        const QPointF *cornerScreenCoords = tile.cornerScreenCoords;
+
+        p.drawLine(cornerScreenCoords[0].x(), cornerScreenCoords[0].y(), cornerScreenCoords[1].x(), cornerScreenCoords[1].y());
+        p.drawLine(cornerScreenCoords[1].x(), cornerScreenCoords[1].y(), cornerScreenCoords[2].x(), cornerScreenCoords[2].y());
+        p.drawLine(cornerScreenCoords[2].x(), cornerScreenCoords[2].y(), cornerScreenCoords[3].x(), cornerScreenCoords[3].y());
+        p.drawLine(cornerScreenCoords[3].x(), cornerScreenCoords[3].y(), cornerScreenCoords[0].x(), cornerScreenCoords[0].y());
+        p.drawText((cornerScreenCoords[0].x() + cornerScreenCoords[1].x() + cornerScreenCoords[2].x() + cornerScreenCoords[3].x()) /
+                   4,
+                   (cornerScreenCoords[0].y() + cornerScreenCoords[1].y() + cornerScreenCoords[2].y() + cornerScreenCoords[3].y()) / 4,
+                   QString::number(tile.pix) + " / " + QString::number(level));
+    }
+}
+
+void HIPSRenderer::tileCenter(int level, int pix, double &ra, double &de)
+{
+    SkyPoint cornerSkyCoords[4];
+    m_HEALpix->getCornerPoints(level, pix, cornerSkyCoords);
+
+    double x = 0, y = 0, z = 0;
+    for (const SkyPoint &corner : cornerSkyCoords)
+    {
+        const double cornerRA = corner.ra0().radians();
+        const double cornerDe = corner.dec0().radians();
+        x += std::cos(cornerDe) * std::cos(cornerRA);
+        y += std::cos(cornerDe) * std::sin(cornerRA);
+        z += std::sin(cornerDe);
+    }
+
+    ra = std::atan2(y, x);
+    de = std::atan2(z, std::hypot(x, y));
+}
+
+void HIPSRenderer::prefetch(int level, int centerPix, double ra, double de, double fov)
+{
+    HIPSManager *manager = HIPSManager::Instance();
+
+    if (Options::hIPSPrefetchTiles() > 0 && m_hasLastView)
+    {
+        const int nside = 1 << level;
+        int dirs[8];
+        bool full = false;
+
+        // Panning: the tiles just outside the view, nearest to its leading edge first.
+        const double dx = std::remainder(ra - m_lastRA, 2 * M_PI) * std::cos(de);
+        const double dy = de - m_lastDe;
+        const double motion = std::hypot(dx, dy);
+        const double reach = fov * dms::DegToRad / 2;
+
+        if (motion > reach / 100)
+        {
+            QSet<int> ring;
+            for (int pix : m_renderedMap)
+            {
+                m_HEALpix->neighbours(nside, pix, dirs);
+                for (int neighbour : dirs)
+                {
+                    if (neighbour >= 0 && m_renderedMap.contains(neighbour) == false)
+                        ring.insert(neighbour);
                 }
             }
 
-            if (freeImage)
+            const double leadX = dx / motion * reach;
+            const double leadY = dy / motion * reach;
+
+            QVector<QPair<double, int>> candidates;
+            for (int pix : ring)
             {
-                delete image;
+                double tileRA = 0, tileDe = 0;
+                tileCenter(level, pix, tileRA, tileDe);
+                const double x = std::remainder(tileRA - ra, 2 * M_PI) * std::cos(de);
+                const double y = tileDe - de;
+                candidates.append(qMakePair(std::hypot(x - leadX, y - leadY), pix));
+            }
+            std::sort(candidates.begin(), candidates.end());
+
+            for (const auto &candidate : candidates)
+            {
+                if (manager->prefetch(level, candidate.second) == false)
+                {
+                    full = true;
+                    break;
+                }
             }
         }
 
-        if (Options::hIPSShowGrid())
+        // Zooming in: the children of the tiles around the center are shown next.
+        if (full == false && fov < m_lastFov * 0.99 && level < manager->getCurrentOrder())
         {
-            QPainter p(pDest);
-            p.setRenderHint(QPainter::Antialiasing);
-            p.setPen(gridColor);
-
-            p.drawLine(cornerScreenCoords[0].x(), cornerScreenCoords[0].y(), cornerScreenCoords[1].x(), cornerScreenCoords[1].y());
-            p.drawLine(cornerScreenCoords[1].x(), cornerScreenCoords[1].y(), cornerScreenCoords[2].x(), cornerScreenCoords[2].y());
-            p.drawLine(cornerScreenCoords[2].x(), cornerScreenCoords[2].y(), cornerScreenCoords[3].x(), cornerScreenCoords[3].y());
-            p.drawLine(cornerScreenCoords[3].x(), cornerScreenCoords[3].y(), cornerScreenCoords[0].x(), cornerScreenCoords[0].y());
-            p.drawText((cornerScreenCoords[0].x() + cornerScreenCoords[1].x() + cornerScreenCoords[2].x() + cornerScreenCoords[3].x()) /
-                       4,
-                       (cornerScreenCoords[0].y() + cornerScreenCoords[1].y() + cornerScreenCoords[2].y() + cornerScreenCoords[3].y()) / 4,
-                       QString::number(pix) + " / " + QString::number(level));
+            QVector<int> around { centerPix };
+            m_HEALpix->neighbours(nside, centerPix, dirs);
+            for (int neighbour : dirs)
+            {
+                if (neighbour >= 0)
+                    around.append(neighbour);
+            }
+
+            for (int pix : around)
+            {
+                int childPixelID[4];
+                m_HEALpix->getPixChilds(pix, childPixelID);
+                for (int child : childPixelID)
+                    full = full || manager->prefetch(level + 1, child) == false;
+            }
         }
+        // Zooming out: the parents of the visible tiles.
+        else if (full == false && fov > m_lastFov * 1.01 && level > 3)
+        {
+            QSet<int> parents;
+            for (int pix : m_renderedMap)
+                parents.insert(pix / 4);
 
-        return true;
+            for (int parent : parents)
+            {
+                if (manager->prefetch(level - 1, parent) == false)
+                    break;
+            }
+        }
     }
 
-    return false;
+    m_hasLastView = true;
+    m_lastRA = ra;
+    m_lastDe = de;
+    m_lastFov = fov;
 }
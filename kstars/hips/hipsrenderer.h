@@ -12,7 +12,10 @@
 #include "hipsmanager.h"
 #include "scanrender.h"
 
+#include <QVector>
+
 #include <memory>
+#include <vector>
 
 class Projector;
 
@@ -23,20 +26,45 @@ public:
   explicit HIPSRenderer();
   //void render(mapView_t *view, CSkPainter *painter, QImage *pDest);
   bool render(uint16_t w, uint16_t h, QImage *hipsImage, const Projector *m_proj);
-  void renderRec(bool allsky, int level, int pix, QImage *pDest);
-  bool renderPix(bool allsky, int level, int pix, QImage *pDest);
 
 signals:
 
 public slots:
 
-private:  
+private:
+  // A visible HEALPix pixel, with its image and the screen coordinates of its 4x4 grandchildren.
+  struct Tile
+  {
+    int pix { 0 };
+    // Held by value, HIPSManager may evict its cached copy while later tiles are collected.
+    QImage image;
+    // Screen rows covered by the grandchildren, used to skip the tile in bands it does not cross.
+    int top { 0 };
+    int bottom { 0 };
+    QPointF cornerScreenCoords[4];
+    QPointF fineScreenCoords[16][4];
+  };
+
+  void collectRec(bool allsky, int level, int pix);
+  bool collectPix(bool allsky, int level, int pix);
+  void rasterizeTiles(QImage *pDest, bool bilinear);
+  void drawGrid(int level, QImage *pDest);
+  void prefetch(int level, int centerPix, double ra, double de, double fov);
+  void tileCenter(int level, int pix, double &ra, double &de);
+
   int m_blocks { 0 };
   int m_rendered { 0 };
   int m_size { 0 };
   QSet<int>  m_renderedMap;
+  QVector<Tile> m_tiles;
   std::unique_ptr<HEALPix> m_HEALpix;
-  std::unique_ptr<ScanRender> m_scanRender;
+  // One scan renderer per band of the destination, their scanline tables are too large to allocate every frame.
+  std::vector<std::unique_ptr<ScanRender>> m_scanRenders;
   const Projector *m_projector;
+  // View of the previous render, giving the pan and zoom direction for prefetching.
+  bool m_hasLastView { false };
+  double m_lastRA { 0 };
+  double m_lastDe { 0 };
+  double m_lastFov { 0 };
   QColor gridColor;
 };
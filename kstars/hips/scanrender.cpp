@@ -49,11 +49,23 @@ void ScanRender::resetScanPoly(int sx, int sy)
   if (sy >= MAX_BK_SCANLINES)
   {
     qDebug("ScanRender::resetScanPoly fail!");
+    m_maxRow = -1;
     return;
   }
 
   m_sx = sx;
   m_sy = sy;
+
+  m_minRow = qMax(0, m_clipTop);
+  m_maxRow = m_clipBottom < 0 ? sy - 1 : qMin(sy - 1, m_clipBottom);
+}
+
+////////////////////////////////////////////////////
+void ScanRender::setClipRows(int top, int bottom)
+////////////////////////////////////////////////////
+{
+  m_clipTop = top;
+  m_clipBottom = bottom;
 }
 
 //////////////////////////////////////////////////////////
@@ -73,12 +85,12 @@ void ScanRender::scanLine(int x1, int y1, int x2, int y2)
     side = 1;
   }
 
-  if (y2 < 0)
+  if (y2 < m_minRow)
   {
     return; // offscreen
   }
 
-  if (y1 >= m_sy)
+  if (y1 > m_maxRow)
   {
     return; // offscreen
   }
@@ -94,17 +106,17 @@ void ScanRender::scanLine(int x1, int y1, int x2, int y2)
   float x = x1;
   int   y;
 
-  if (y2 >= m_sy)
+  if (y2 > m_maxRow)
   {
-    y2 = m_sy - 1;
+    y2 = m_maxRow;
   }
 
-  if (y1 < 0)
+  if (y1 < m_minRow)
   { // partially off screen
-    float m = (float) -y1;
+    float m = (float)(m_minRow - y1);
 
     x += dx * m;
-    y1 = 0;
+    y1 = m_minRow;
   }
 
   int minY = qMin(y1, y2);
@@ -168,9 +180,9 @@ void ScanRender::scanLine(int x1, int y1, int x2, int y2, float u1, float v1, fl
     side = 1;
   }
 
-  if (y2 < 0)
+  if (y2 < m_minRow)
     return; // offscreen
-  if (y1 >= m_sy)
+  if (y1 > m_maxRow)
     return; // offscreen
 
   float dy = (float)(y2 - y1);
@@ -182,8 +194,8 @@ void ScanRender::scanLine(int x1, int y1, int x2, int y2, float u1, float v1, fl
   float x = x1;
   int   y;
 
-  if (y2 >= m_sy)
-    y2 = m_sy - 1;
+  if (y2 > m_maxRow)
+    y2 = m_maxRow;
 
   float duv[2];
   float uv[2] = {u1, v1};
@@ -191,15 +203,15 @@ void ScanRender::scanLine(int x1, int y1, int x2, int y2, float u1, float v1, fl
   duv[0] = (u2 - u1) / dy;
   duv[1] = (v2 - v1) / dy;
 
-  if (y1 < 0)
+  if (y1 < m_minRow)
   { // partially off screen
-    float m = (float) -y1;
+    float m = (float)(m_minRow - y1);
 
     uv[0] += duv[0] * m;
     uv[1] += duv[1] * m;
 
     x += dx * m;
-    y1 = 0;
+    y1 = m_minRow;
   }
 
   int minY = qMin(y1, y2);
@@ -324,16 +336,27 @@ void ScanRender::setOpacity(float opacity)
 }
 
 /////////////////////////////////////////////////////////
-void ScanRender::renderPolygon(QImage *dst, QImage *src)
+void ScanRender::renderPolygon(QImage *dst, const QImage *src)
 /////////////////////////////////////////////////////////
+{
+  renderPolygon(dst->bits(), dst->width(), dst->bytesPerLine(), src);
+}
+
+void ScanRender::renderPolygon(uchar *dstBits, int dstWidth, int dstBytesPerLine, const QImage *src)
 {
   if (bBilinear)
-    renderPolygonBI(dst, src);
+    renderPolygonBI(dstBits, dstWidth, dstBytesPerLine, src);
   else
-    renderPolygonNI(dst, src);
+    renderPolygonNI(dstBits, dstWidth, dstBytesPerLine, src);
 }
 
-void ScanRender::renderPolygon(int interpolation, QPointF *pts, QImage *pDest, QImage *pSrc, QPointF *uv)
+void ScanRender::renderPolygon(int interpolation, const QPointF *pts, QImage *pDest, const QImage *pSrc, const QPointF *uv)
+{
+  renderPolygon(interpolation, pts, pDest->bits(), pDest->width(), pDest->height(), pDest->bytesPerLine(), pSrc, uv);
+}
+
+void ScanRender::renderPolygon(int interpolation, const QPointF *pts, uchar *dstBits, int dstWidth, int dstHeight,
+                               int dstBytesPerLine, const QImage *pSrc, const QPointF *uv)
 {
   QPointF Auv = uv[0];
   QPointF Buv = uv[1];
@@ -342,12 +365,12 @@ void ScanRender::renderPolygon(int interpolation, QPointF *pts, QImage *pDest, Q
 
   if (interpolation < 2)
   {
-    resetScanPoly(pDest->width(), pDest->height());
+    resetScanPoly(dstWidth, dstHeight);
     scanLine(pts[0].x(), pts[0].y(), pts[1].x(), pts[1].y(), 1, 1, 1, 0);
     scanLine(pts[1].x(), pts[1].y(), pts[2].x(), pts[2].y(), 1, 0, 0, 0);
     scanLine(pts[2].x(), pts[2].y(), pts[3].x(), pts[3].y(), 0, 0, 0, 1);
     scanLine(pts[3].x(), pts[3].y(), pts[0].x(), pts[0].y(), 0, 1, 1, 1);
-    renderPolygon(pDest, pSrc);
+    renderPolygon(dstBits, dstWidth, dstBytesPerLine, pSrc);
     return;
   }
 
@@ -386,12 +409,12 @@ void ScanRender::renderPolygon(int interpolation, QPointF *pts, QImage *pDest, Q
       QPointF D1 = Q1 + j * (Q2 - Q1) / interpolation;
       QPointF D1uv = Q1uv + j * (Q2uv - Q1uv) / interpolation;
 
-      resetScanPoly(pDest->width(), pDest->height());
+      resetScanPoly(dstWidth, dstHeight);
       scanLine(A1.x(), A1.y(), B1.x(), B1.y(), A1uv.x(), A1uv.y(), B1uv.x(), B1uv.y());
       scanLine(B1.x(), B1.y(), C1.x(), C1.y(), B1uv.x(), B1uv.y(), C1uv.x(), C1uv.y());
       scanLine(C1.x(), C1.y(), D1.x(), D1.y(), C1uv.x(), C1uv.y(), D1uv.x(), D1uv.y());
       scanLine(D1.x(), D1.y(), A1.x(), A1.y(), D1uv.x(), D1uv.y(), A1uv.x(), A1uv.y());
-      renderPolygon(pDest, pSrc);
+      renderPolygon(dstBits, dstWidth, dstBytesPerLine, pSrc);
 
       //p->drawLine(A1, B1);
       //p->drawLine(B1, C1);
@@ -402,16 +425,21 @@ void ScanRender::renderPolygon(int interpolation, QPointF *pts, QImage *pDest, Q
 }
 
 ///////////////////////////////////////////////////////////
-void ScanRender::renderPolygonNI(QImage *dst, QImage *src)
+void ScanRender::renderPolygonNI(QImage *dst, const QImage *src)
 ///////////////////////////////////////////////////////////
 {
-  int w = dst->width();
+  renderPolygonNI(dst->bits(), dst->width(), dst->bytesPerLine(), src);
+}
+
+void ScanRender::renderPolygonNI(uchar *dstBits, int dstWidth, int dstBytesPerLine, const QImage *src)
+{
+  int w = dstWidth;
   int sw = src->width();
   int sh = src->height();
   float tsx = src->width() - 1;
   float tsy = src->height() - 1;
   const quint32 *bitsSrc = (quint32 *)src->constBits();
-  quint32 *bitsDst = (quint32 *)dst->bits();
+  uchar *bitsDst = dstBits;
   bkScan_t *scan = scLR;
   bool bw = src->format() == QImage::Format_Indexed8 || src->format() == QImage::Format_Grayscale8;      
 
@@ -459,7 +487,7 @@ void ScanRender::renderPolygonNI(QImage *dst, QImage *src)
     duv[0] *= tsx;
     duv[1] *= tsy;
 
-    quint32 *pDst = bitsDst + (y * w) + px1;
+    quint32 *pDst = reinterpret_cast<quint32 *>(bitsDst + y * dstBytesPerLine) + px1;
 
     int fuv[2];
     int fduv[2];
@@ -505,17 +533,22 @@ void ScanRender::renderPolygonNI(QImage *dst, QImage *src)
 
 
 ///////////////////////////////////////////////////////////
-void ScanRender::renderPolygonBI(QImage *dst, QImage *src)
+void ScanRender::renderPolygonBI(QImage *dst, const QImage *src)
 ///////////////////////////////////////////////////////////
 {
-  int w = dst->width();
+  renderPolygonBI(dst->bits(), dst->width(), dst->bytesPerLine(), src);
+}
+
+void ScanRender::renderPolygonBI(uchar *dstBits, int dstWidth, int dstBytesPerLine, const QImage *src)
+{
+  int w = dstWidth;
   int sw = src->width();
   int sh = src->height();
   float tsx = src->width() - 1;
   float tsy = src->height() - 1;
   const quint32 *bitsSrc = (quint32 *)src->constBits();
   const uchar *bitsSrc8 = (uchar *)src->constBits();
-  quint32 *bitsDst = (quint32 *)dst->bits();
+  uchar *bitsDst = dstBits;
   bkScan_t *scan = scLR;
   bool bw = src->format() == QImage::Format_Indexed8 || src->format() == QImage::Format_Grayscale8;
 
@@ -565,9 +598,9 @@ void ScanRender::renderPolygonBI(QImage *dst, QImage *src)
     duv[0] *= tsx;
     duv[1] *= tsy;
 
-    int size = sw * sh;
-
-    quint32 *pDst = bitsDst + (y * w) + px1;
+    // The neighbours are clamped to the last row and column instead of wrapping around with a modulo,
+    // which costs three integer divisions per pixel. Their weight is zero there anyway.
+    quint32 *pDst = reinterpret_cast<quint32 *>(bitsDst + y * dstBytesPerLine) + px1;
     if (bw)
     {
       for (int x = px1; x < px2; x++)
@@ -578,11 +611,13 @@ void ScanRender::renderPolygonBI(QImage *dst, QImage *src)
         float y_1diff = 1 - y_diff;
 
         int index = ((int)uv[0] + ((int)uv[1] * sw));
+        int right = (int)uv[0] < sw - 1 ? 1 : 0;
+        int down = (int)uv[1] < sh - 1 ? sw : 0;
 
         uchar a = bitsSrc8[index];
-        uchar b = bitsSrc8[(index + 1) % size];
-        uchar c = bitsSrc8[(index + sw) % size];
-        uchar d = bitsSrc8[(index + sw + 1) % size];
+        uchar b = bitsSrc8[index + right];
+        uchar c = bitsSrc8[index + down];
+        uchar d = bitsSrc8[index + down + right];
 
         int val = (a&0xff)*(x_1diff)*(y_1diff) + (b&0xff)*(x_diff)*(y_1diff) +
                   (c&0xff)*(y_diff)*(x_1diff)   + (d&0xff)*(x_diff*y_diff);
@@ -607,11 +642,13 @@ void ScanRender::renderPolygonBI(QImage *dst, QImage *src)
         float y_1diff = 1 - y_diff;
 
         int index = ((int)uv[0] + ((int)uv[1] * sw));
+        int right = (int)uv[0] < sw - 1 ? 1 : 0;
+        int down = (int)uv[1] < sh - 1 ? sw : 0;
 
         quint32 a = bitsSrc[index];
-        quint32 b = bitsSrc[(index + 1) % size];
-        quint32 c = bitsSrc[(index + sw) % size];
-        quint32 d = bitsSrc[(index + sw + 1) % size];
+        quint32 b = bitsSrc[index + right];
+        quint32 c = bitsSrc[index + down];
+        quint32 d = bitsSrc[index + down + right];
 
         int qxy1 = (x_1diff * y_1diff) * 65536;
         int qxy2 =(x_diff * y_1diff) * 65536;
@@ -638,7 +675,7 @@ void ScanRender::renderPolygonBI(QImage *dst, QImage *src)
   }
 }
 
-void ScanRender::renderPolygonAlpha(QImage *dst, QImage *src)
+void ScanRender::renderPolygonAlpha(QImage *dst, const QImage *src)
 {
   if (bBilinear)
     renderPolygonAlphaBI(dst, src);
@@ -647,7 +684,7 @@ void ScanRender::renderPolygonAlpha(QImage *dst, QImage *src)
 }
 
 
-void ScanRender::renderPolygonAlphaBI(QImage *dst, QImage *src)
+void ScanRender::renderPolygonAlphaBI(QImage *dst, const QImage *src)
 {
   int w = dst->width();
   int sw = src->width();
@@ -797,7 +834,7 @@ void ScanRender::renderPolygonAlphaBI(QImage *dst, QImage *src)
 
 
 ////////////////////////////////////////////////////////////////
-void ScanRender::renderPolygonAlphaNI(QImage *dst, QImage *src)
+void ScanRender::renderPolygonAlphaNI(QImage *dst, const QImage *src)
 ////////////////////////////////////////////////////////////////
 {
   int w = dst->width();
@@ -28,18 +28,29 @@ class ScanRender
     void setBilinearInterpolationEnabled(bool enable);
     bool isBilinearInterpolationEnabled(void);
     void resetScanPoly(int sx, int sy);
+    // Only scan the rows [top, bottom] of the destination, a negative bottom meaning down to the last row.
+    // Renderers working on disjoint row ranges can then fill the same destination concurrently.
+    void setClipRows(int top, int bottom);
     void scanLine(int x1, int y1, int x2, int y2);
     void scanLine(int x1, int y1, int x2, int y2, float u1, float v1, float u2, float v2);
     void renderPolygon(QColor col, QImage *dst);
-    void renderPolygon(QImage *dst, QImage *src);
-    void renderPolygon(int interpolation, QPointF *pts, QImage *pDest, QImage *pSrc, QPointF *uv);
+    void renderPolygon(QImage *dst, const QImage *src);
+    void renderPolygon(int interpolation, const QPointF *pts, QImage *pDest, const QImage *pSrc, const QPointF *uv);
 
-    void renderPolygonNI(QImage *dst, QImage *src);
-    void renderPolygonBI(QImage *dst, QImage *src);
+    // The same, rendering into the 32-bit pixels of a destination fetched once by the caller. QImage::bits()
+    // may detach the image, so renderers sharing a destination must not call it concurrently.
+    void renderPolygon(uchar *dstBits, int dstWidth, int dstBytesPerLine, const QImage *src);
+    void renderPolygon(int interpolation, const QPointF *pts, uchar *dstBits, int dstWidth, int dstHeight,
+                       int dstBytesPerLine, const QImage *pSrc, const QPointF *uv);
 
-    void renderPolygonAlpha(QImage *dst, QImage *src);
-    void renderPolygonAlphaBI(QImage *dst, QImage *src);
-    void renderPolygonAlphaNI(QImage *dst, QImage *src);
+    void renderPolygonNI(QImage *dst, const QImage *src);
+    void renderPolygonBI(QImage *dst, const QImage *src);
+    void renderPolygonNI(uchar *dstBits, int dstWidth, int dstBytesPerLine, const QImage *src);
+    void renderPolygonBI(uchar *dstBits, int dstWidth, int dstBytesPerLine, const QImage *src);
+
+    void renderPolygonAlpha(QImage *dst, const QImage *src);
+    void renderPolygonAlphaBI(QImage *dst, const QImage *src);
+    void renderPolygonAlphaNI(QImage *dst, const QImage *src);
 
     void renderPolygonAlpha(QColor col, QImage *dst);
     void setOpacity(float opacity);
@@ -50,6 +61,10 @@ private:
     int      plMaxY { 0 };
     int      m_sx { 0 };
     int      m_sy { 0 };
+    int      m_clipTop { 0 };
+    int      m_clipBottom { -1 };
+    int      m_minRow { 0 };
+    int      m_maxRow { -1 };
     bkScan_t scLR[MAX_BK_SCANLINES];
     bool     bBilinear { false };
 };
@@ -82,13 +82,14 @@ bool HTMesh::performIntersection(RangeConvex *convex, BufNum bufNum)
     convex->setOlevel(m_level);
     HtmRange range;
     convex->intersect(htm, &range);
-    HtmRangeIterator iterator(&range);
 
     MeshBuffer *buffer = m_meshBuffer[bufNum];
     buffer->reset();
-    while (iterator.hasNext())
+    Key lo, hi;
+    while (range.getNext(&lo, &hi))
     {
-        buffer->append((Trixel)iterator.next() - magicNum);
+        for (Key id = lo; id <= hi; id++)
+            buffer->append((Trixel)id - magicNum);
     }
 
     if (buffer->error())
@@ -112,6 +113,26 @@ void HTMesh::intersect(double ra, double dec, double radius, BufNum bufNum)
         printf("In intersect(%f, %f, %f)\n", ra, dec, radius);
 }
 
+void HTMesh::intersect(double ra, double dec, double radius, std::vector<Trixel> &trixels) const
+{
+    double d = cos(radius * degree2Rad);
+    SpatialConstraint c(SpatialVector(ra, dec), d);
+    RangeConvex convex;
+    convex.add(c);
+    convex.setOlevel(m_level);
+
+    HtmRange range;
+    convex.intersect(htm, &range);
+
+    trixels.clear();
+    Key lo, hi;
+    while (range.getNext(&lo, &hi))
+    {
+        for (Key id = lo; id <= hi; id++)
+            trixels.push_back((Trixel)id - magicNum);
+    }
+}
+
 // TRIANGLE
 void HTMesh::intersect(double ra1, double dec1, double ra2, double dec2, double ra3, double dec3, BufNum bufNum)
 {
@@ -13,6 +13,7 @@
 #define HTMESH_H
 
 #include <cstdio>
+#include <vector>
 #include "typedef.h"
 
 class SpatialIndex;
@@ -95,6 +96,13 @@ class HTMesh
          */
     void intersect(double ra, double dec, double radius, BufNum bufNum = 0);
 
+    /** @short finds the trixels that cover the specified circle, like the
+         * routine above, but returns them in trixels instead of a buffer.
+         * No state of the mesh is used or changed so, unlike the other
+         * intersect() routines, this can be called from several threads at once.
+         */
+    void intersect(double ra, double dec, double radius, std::vector<Trixel> &trixels) const;
+
     /** @short finds the trixels that cover the specified line segment
          */
     void intersect(double ra1, double dec1, double ra2, double dec2, BufNum bufNum = 0);
@@ -1,102 +1,96 @@
 #include <HtmRange.h>
 
-#include <stdio.h>
-#include <string.h>
-
-#define INSIDE         1
-#define OUTSIDE        -1
-#define INTERSECT      0
-#define GAP_HISTO_SIZE 10000
-
-extern "C" {
-int cc_ID2name(char *name, uint64 id);
-}
+#include <algorithm>
 
 HtmRange::HtmRange()
 {
-    my_los = new SkipList;
-    my_his = new SkipList;
 }
 
 HtmRange::~HtmRange()
 {
-    my_los->freeRange(-1, KEY_MAX);
-    my_his->freeRange(-1, KEY_MAX);
-    delete my_los;
-    delete my_his;
 }
 
-InclusionType HtmRange::tinside(const Key mid) const
+void HtmRange::insertInterval(int pos, const Interval &interval)
 {
-    // clearly out, inside, share a boundary, off by one to some boundary
-    InclusionType t1, t2;
-
-    Key GH = my_his->findMAX(mid);
-    Key GL = my_los->findMAX(mid);
-
-    if (GH < GL)
-        t1 = InclInside;
+    if (m_heap.empty() && m_size < INLINE_INTERVALS)
+    {
+        std::copy_backward(m_inline + pos, m_inline + m_size, m_inline + m_size + 1);
+        m_inline[pos] = interval;
+    }
     else
-        t1 = InclOutside;
+    {
+        if (m_heap.empty())
+            m_heap.assign(m_inline, m_inline + m_size);
+        m_heap.insert(m_heap.begin() + pos, interval);
+    }
+    ++m_size;
+}
 
-    Key SH = my_his->findMIN(mid);
-    Key SL = my_los->findMIN(mid);
-    if (SH < SL)
-        t2 = InclInside;
-    else
-        t2 = InclOutside;
+void HtmRange::eraseIntervals(int from, int to)
+{
+    if (from >= to)
+        return;
 
-    if (t1 == t2)
-        return t1;
-    if (t1 == InclInside)
-        return InclHi;
+    if (m_heap.empty())
+        std::copy(m_inline + to, m_inline + m_size, m_inline + from);
     else
-        return InclLo;
+        m_heap.erase(m_heap.begin() + from, m_heap.begin() + to);
+    m_size -= to - from;
 }
 
 void HtmRange::mergeRange(const Key lo, const Key hi)
 {
-    int lo_flag = tinside(lo);
-    int hi_flag = tinside(hi);
-
-    // delete all nodes (key) in his and los where lo < key < hi
-    my_his->freeRange(lo, hi);
-    my_los->freeRange(lo, hi);
+    Interval *data = intervals();
 
-    // add if not inside a pre-existing interval
-    if (lo_flag == InclHi)
-    {
-    }
-    else if (lo_flag == InclLo || (lo_flag == InclOutside))
+    // The common case, ranges come in increasing order
+    if (m_size == 0 || lo > data[m_size - 1].hi + 1)
     {
-        my_los->insert(lo, 33);
+        insertInterval(m_size, { lo, hi });
+        return;
     }
 
-    if (hi_flag == InclLo)
+    // First interval which overlaps or touches [lo, hi], and the first one past it
+    const int first = std::lower_bound(data, data + m_size, lo, [](const Interval & interval, Key key)
     {
-    }
-    else if (hi_flag == InclOutside || hi_flag == InclHi)
+        return interval.hi + 1 < key;
+    }) - data;
+    const int last = std::upper_bound(data + first, data + m_size, hi, [](Key key, const Interval & interval)
     {
-        my_his->insert(hi, 33);
+        return key + 1 < interval.lo;
+    }) - data;
+
+    if (first == last)
+    {
+        insertInterval(first, { lo, hi });
+        return;
     }
+
+    data[first].lo = std::min(data[first].lo, lo);
+    data[first].hi = std::max(data[last - 1].hi, hi);
+    eraseIntervals(first + 1, last);
 }
 
 void HtmRange::reset()
 {
-    my_los->reset();
-    my_his->reset();
+    m_next = 0;
+}
+
+void HtmRange::clear()
+{
+    m_heap.clear();
+    m_size = 0;
+    m_next = 0;
 }
 
 int HtmRange::getNext(Key *lo, Key *hi)
 {
-    *lo = my_los->getkey();
-    if (*lo <= (Key)0)
+    if (m_next >= m_size)
     {
         *hi = *lo = (Key)0;
         return 0;
     }
-    *hi = my_his->getkey();
-    my_his->step();
-    my_los->step();
+    const Interval &interval = intervals()[m_next++];
+    *lo = interval.lo;
+    *hi = interval.hi;
     return 1;
 }
@@ -1,34 +1,59 @@
 #ifndef _HTMHANGE_H_
 #define _HTMHANGE_H_
 
-#include <SkipList.h>
+#include <SpatialGeneral.h>
 
-enum InclusionType
-{
-    InclOutside = 0,
-    InclInside,
-    InclLo, /* number is on low end of an interval */
-    InclHi, /* number is on high end of an interval */
-    InclAdjacentXXX
-};
+#include <vector>
+
+typedef int64 Key; // key type
 
+/** @class HtmRange
+ * A set of HTM ids, stored as sorted disjoint intervals.
+ *
+ * Intervals are kept in a contiguous array, first in a small buffer inside the
+ * object and then on the heap, so that the intersection of a typical aperture
+ * does not allocate. Ranges are mostly merged in increasing order, which only
+ * appends to the array.
+ */
 class LINKAGE HtmRange
 {
   public:
     HtmRange();
     ~HtmRange();
 
+    /** @short returns the next interval in increasing order, or 0 once all were returned */
     int getNext(Key *lo, Key *hi);
 
+    /** @short adds the ids from lo to hi, merging them with the overlapping and adjacent intervals */
     void mergeRange(const Key lo, const Key hi);
+
+    /** @short restarts getNext() from the first interval */
     void reset();
 
-  protected:
-    InclusionType tinside(const Key mid) const;
+    /** @short removes all the intervals */
+    void clear();
+
+    /** @short returns the number of disjoint intervals */
+    int size() const { return m_size; }
 
   private:
-    SkipList *my_los;
-    SkipList *my_his;
+    struct Interval
+    {
+        Key lo;
+        Key hi;
+    };
+
+    Interval *intervals() { return m_heap.empty() ? m_inline : m_heap.data(); }
+    void insertInterval(int pos, const Interval &interval);
+    void eraseIntervals(int from, int to);
+
+    // Enough for the apertures of the sky map at the usual mesh levels
+    static const int INLINE_INTERVALS = 32;
+
+    Interval m_inline[INLINE_INTERVALS];
+    std::vector<Interval> m_heap;
+    int m_size { 0 };
+    int m_next { 0 };
 };
 
 #endif
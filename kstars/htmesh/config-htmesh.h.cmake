@@ -1,3 +0,0 @@
-
-/* Define if you have drand48() */
-#cmakedefine   HAVE_DRAND48 1
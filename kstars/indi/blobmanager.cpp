@@ -5,13 +5,15 @@
 */
 
 #include "blobmanager.h"
+#include "indimetrics.h"
+#include "auxiliary/tracer.h"
 
 #include <basedevice.h>
 
 #include "indi_debug.h"
 
-BlobManager::BlobManager(QObject *parent, const QString &host, int port, const QString &device,
-                         const QString &prop) : QObject(parent), m_Device(device), m_Property(prop)
+BlobManager::BlobManager(QObject *parent, const QString &host, int port, const QString &device) : QObject(parent),
+    m_Device(device)
 {
     // Set INDI server params
     setServer(host.toLatin1().constData(), port);
@@ -25,30 +27,110 @@ BlobManager::BlobManager(QObject *parent, const QString &host, int port, const Q
 
 void BlobManager::serverDisconnected(int exit_code)
 {
-    qCDebug(KSTARS_INDI) << "INDI server disconnected from BLOB manager for Device:" << m_Device << "Property:" << m_Property <<
-                         "Exit code:" << exit_code;
+    QMutexLocker locker(&m_Mutex);
+    qCDebug(KSTARS_INDI) << "INDI server disconnected from BLOB manager for Device:" << m_Device << "Properties:" <<
+                         m_Properties.keys() << "Exit code:" << exit_code;
 }
 
 void BlobManager::updateProperty(INDI::Property prop)
 {
-    if (prop.getType() == INDI_BLOB)
-        emit propertyUpdated(prop);
+    KSTARS_TRACE_SPAN("indi", "BLOB receive");
+
+    if (prop.getType() != INDI_BLOB)
+        return;
+
+    qint64 bytes = 0;
+    for (auto &oneBLOB : *prop.getBLOB())
+        bytes += oneBLOB.getSize();
+    INDIMetrics::Instance()->received(m_Device, prop.getName(), bytes);
+
+    {
+        QMutexLocker locker(&m_Mutex);
+        if (m_Uptime.isValid() == false)
+            m_Uptime.start();
+        m_Statistics.blobs++;
+        m_Statistics.bytes += bytes;
+        if (m_Uptime.elapsed() > 0)
+            m_Statistics.bytesPerSecond = m_Statistics.bytes * 1000.0 / m_Uptime.elapsed();
+        qCDebug(KSTARS_INDI) << "BLOB" << prop.getName() << "received for" << m_Device << ":" << m_Statistics.blobs << "BLOBs,"
+                             << m_Statistics.bytes << "bytes," << m_Statistics.bytesPerSecond / 1e6 << "MB/s on average";
+    }
+
+    emit propertyUpdated(prop);
 }
 
 void BlobManager::newDevice(INDI::BaseDevice device)
 {
-    // Got out target device, let's now set to BLOB ONLY for the particular property we want
+    // Got out target device, let's now set to BLOB ONLY for the properties we want
     if (QString(device.getDeviceName()) == m_Device)
     {
-        setBLOBMode(B_ONLY, m_Device.toLatin1().constData(), m_Property.toLatin1().constData());
-        // enable Direct Blob Access for faster BLOB loading.
-        enableDirectBlobAccess(m_Device.toLatin1().constData(), m_Property.toLatin1().constData());
+        QMutexLocker locker(&m_Mutex);
+        m_Ready = true;
+        for (auto it = m_Properties.cbegin(); it != m_Properties.cend(); ++it)
+            enableProperty(it.key(), it.value());
+        locker.unlock();
         emit connected();
     }
 }
 
-void BlobManager::setEnabled(bool enabled)
+void BlobManager::addProperty(const QString &property)
+{
+    QMutexLocker locker(&m_Mutex);
+    m_Properties.insert(property, true);
+    if (m_Ready)
+        enableProperty(property, true);
+}
+
+bool BlobManager::removeProperty(const QString &property)
+{
+    QMutexLocker locker(&m_Mutex);
+    if (m_Properties.remove(property) > 0 && m_Ready)
+        setBLOBMode(B_NEVER, m_Device.toLatin1().constData(), property.toLatin1().constData());
+    return m_Properties.isEmpty();
+}
+
+bool BlobManager::hasProperty(const QString &property) const
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_Properties.contains(property);
+}
+
+bool BlobManager::isReady() const
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_Ready;
+}
+
+bool BlobManager::enabled(const QString &property) const
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_Properties.value(property, false);
+}
+
+void BlobManager::setEnabled(bool enabled, const QString &property)
+{
+    QMutexLocker locker(&m_Mutex);
+    for (auto it = m_Properties.begin(); it != m_Properties.end(); ++it)
+    {
+        if (property.isEmpty() || it.key() == property)
+        {
+            it.value() = enabled;
+            if (m_Ready)
+                enableProperty(it.key(), enabled);
+        }
+    }
+}
+
+void BlobManager::enableProperty(const QString &property, bool enabled)
+{
+    setBLOBMode(enabled ? B_ONLY : B_NEVER, m_Device.toLatin1().constData(), property.toLatin1().constData());
+    // enable Direct Blob Access for faster BLOB loading.
+    if (enabled)
+        enableDirectBlobAccess(m_Device.toLatin1().constData(), property.toLatin1().constData());
+}
+
+BlobManager::Statistics BlobManager::statistics() const
 {
-    m_Enabled = enabled;
-    setBLOBMode(enabled ? B_ONLY : B_NEVER, m_Device.toLatin1().constData(), m_Property.toLatin1().constData());
+    QMutexLocker locker(&m_Mutex);
+    return m_Statistics;
 }
@@ -17,14 +17,21 @@ class DeviceInfo;
 class DriverInfo;
 class ServerManager;
 
+#include <QElapsedTimer>
+#include <QMap>
+#include <QMutex>
+
 /**
  * @class BlobManager
- * BlobManager manages connection to INDI server to handle a specific BLOB.
+ * BlobManager manages connection to INDI server to handle the BLOBs of a device.
  *
  * BlobManager is a subclass of INDI::BaseClient class part of the INDI Library.
+ * A single connection receives all the BLOB properties of its device, so that the number of connections
+ * and client threads grows with the number of cameras and not the number of their BLOBs.
+ * BLOBs of different devices are still received on separate connections, in parallel.
  *
  * @author Jasem Mutlaq
- * @version 1.0
+ * @version 1.1
  */
 #ifdef USE_QT5_INDI
 class BlobManager : public INDI::BaseClientQt
@@ -34,15 +41,31 @@ class BlobManager : public QObject, public INDI::BaseClient
 {
     Q_OBJECT
     Q_PROPERTY(QString device MEMBER m_Device)
-    Q_PROPERTY(QString property MEMBER m_Property)
-    Q_PROPERTY(bool enabled READ enabled WRITE setEnabled)
 
   public:
-    BlobManager(QObject *parent, const QString &host, int port, const QString &device, const QString &prop);
+    struct Statistics
+    {
+        quint64 blobs { 0 };
+        quint64 bytes { 0 };
+        // Average rate since the first BLOB, in bytes per second
+        double bytesPerSecond { 0 };
+    };
+
+    BlobManager(QObject *parent, const QString &host, int port, const QString &device);
     virtual ~BlobManager() override = default;
 
-    bool enabled() { return m_Enabled; }
-    void setEnabled(bool enabled);
+    /** @short Receive BLOBs of @p property on this connection, enabled by default */
+    void addProperty(const QString &property);
+    /** @return true if no property is left */
+    bool removeProperty(const QString &property);
+    bool hasProperty(const QString &property) const;
+    /** @return true once the device is known to this connection */
+    bool isReady() const;
+    bool enabled(const QString &property) const;
+    /** @short Enable or disable @p property, or all properties if it is empty */
+    void setEnabled(bool enabled, const QString &property = QString());
+
+    Statistics statistics() const;
 
   protected:
     virtual void newDevice(INDI::BaseDevice device) override;
@@ -51,13 +74,22 @@ class BlobManager : public QObject, public INDI::BaseClient
     virtual void serverConnected() override {}
     virtual void serverDisconnected(int exit_code) override;
 
-  signals:   
+  signals:
     void propertyUpdated(INDI::Property prop);
     void connected();
     void connectionFailure();
 
   private:
+    void enableProperty(const QString &property, bool enabled);
+
     QString m_Device;
-    QString m_Property;
-    bool m_Enabled { true };
+
+    // Guards the members below, which are used from both the main and the INDI client threads
+    mutable QMutex m_Mutex;
+    // Properties handled by this connection and whether their BLOBs are enabled
+    QMap<QString, bool> m_Properties;
+    bool m_Ready { false };
+    Statistics m_Statistics;
+    // Started with the first BLOB
+    QElapsedTimer m_Uptime;
 };
@@ -10,10 +10,12 @@
 #include "drivermanager.h"
 #include "guimanager.h"
 #include "indilistener.h"
+#include "indimetrics.h"
 #include "Options.h"
 #include "servermanager.h"
 
 #include <indi_debug.h>
+#include <QMutexLocker>
 #include <QTimer>
 
 ClientManager::ClientManager()
@@ -93,7 +95,45 @@ void ClientManager::newProperty(INDI::Property property)
 
 void ClientManager::updateProperty(INDI::Property property)
 {
-    emit updateINDIProperty(property);
+    // Chatty drivers send number updates (mount coordinates, focuser temperature...) far faster than
+    // devices and panels need them. Each one used to be a separate event on the GUI thread, delaying
+    // everything queued behind them. Updates are now queued in order and dispatched in one go, and a
+    // number property already waiting is not queued again since it is read with its latest values.
+    // BLOBs are received by their own BlobManager and never go through this queue.
+    INDIMetrics::Instance()->received(property.getDeviceName(), property.getName());
+
+    bool dispatch = false;
+    {
+        QMutexLocker locker(&m_PendingMutex);
+        if (property.getType() == INDI_NUMBER)
+        {
+            const QString key = QString("%1.%2").arg(property.getDeviceName(), property.getName());
+            if (m_PendingNumbers.contains(key))
+                return;
+            m_PendingNumbers.insert(key);
+        }
+        dispatch = m_PendingProperties.isEmpty();
+        m_PendingProperties.append(property);
+    }
+
+    if (dispatch)
+        QMetaObject::invokeMethod(this, &ClientManager::dispatchPendingProperties, Qt::QueuedConnection);
+}
+
+void ClientManager::dispatchPendingProperties()
+{
+    QList<INDI::Property> properties;
+    {
+        QMutexLocker locker(&m_PendingMutex);
+        properties.swap(m_PendingProperties);
+        m_PendingNumbers.clear();
+    }
+
+    for (auto &oneProperty : properties)
+    {
+        if (oneProperty.isValid())
+            emit updateINDIProperty(oneProperty);
+    }
 }
 
 void ClientManager::removeProperty(INDI::Property prop)
@@ -111,12 +151,11 @@ void ClientManager::processRemoveBLOBManager(const QString &device, const QStrin
 {
     auto manager = std::find_if(blobManagers.begin(), blobManagers.end(), [device, property](auto & oneManager)
     {
-        const auto bProperty = oneManager->property("property").toString();
-        const auto bDevice = oneManager->property("device").toString();
-        return (device == bDevice && property == bProperty);
+        return (device == oneManager->property("device").toString() && oneManager->hasProperty(property));
     });
 
-    if (manager != blobManagers.end())
+    // The connection is shared by the BLOBs of the device, close it with the last one.
+    if (manager != blobManagers.end() && (*manager)->removeProperty(property))
     {
         (*manager)->disconnectServer();
         (*manager)->deleteLater();
@@ -129,14 +168,34 @@ void ClientManager::processNewProperty(INDI::Property prop)
     // Only handle RW and RO BLOB properties
     if (prop.getType() == INDI_BLOB && prop.getPermission() != IP_WO)
     {
-        BlobManager *bm = new BlobManager(this, getHost(), getPort(), prop.getDeviceName(), prop.getName());
-        connect(bm, &BlobManager::propertyUpdated, this, &ClientManager::updateINDIProperty);
-        connect(bm, &BlobManager::connected, this, [prop, this]()
+        const QString device = prop.getDeviceName();
+        auto manager = std::find_if(blobManagers.begin(), blobManagers.end(), [device](auto & oneManager)
         {
-            if (prop && prop.getRegistered())
-                emit newBLOBManager(prop.getDeviceName(), prop);
+            return device == oneManager->property("device").toString();
         });
-        blobManagers.append(bm);
+
+        BlobManager *bm = nullptr;
+        if (manager == blobManagers.end())
+        {
+            bm = new BlobManager(this, getHost(), getPort(), device);
+            connect(bm, &BlobManager::propertyUpdated, this, &ClientManager::updateINDIProperty);
+            blobManagers.append(bm);
+        }
+        else
+            bm = *manager;
+
+        bm->addProperty(prop.getName());
+        // Properties added once the connection is up are ready immediately.
+        if (bm->isReady())
+            emit newBLOBManager(prop.getDeviceName(), prop);
+        else
+        {
+            connect(bm, &BlobManager::connected, this, [prop, this]()
+            {
+                if (prop && prop.getRegistered())
+                    emit newBLOBManager(prop.getDeviceName(), prop);
+            });
+        }
     }
 }
 
@@ -336,9 +395,9 @@ void ClientManager::setBLOBEnabled(bool enabled, const QString &device, const QS
 {
     for(auto &bm : blobManagers)
     {
-        if (bm->property("device") == device && (property.isEmpty() || bm->property("property") == property))
+        if (bm->property("device") == device)
         {
-            bm->setEnabled(enabled);
+            bm->setEnabled(enabled, property);
             return;
         }
     }
@@ -348,8 +407,8 @@ bool ClientManager::isBLOBEnabled(const QString &device, const QString &property
 {
     for(auto &bm : blobManagers)
     {
-        if (bm->property("device") == device && bm->property("property") == property)
-            return bm->property("enabled").toBool();
+        if (bm->property("device") == device)
+            return bm->enabled(property);
     }
 
     return false;
@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <QMutex>
 #include <QPointer>
+#include <QSet>
 
 #ifdef USE_QT5_INDI
 #include <baseclientqt.h>
@@ -101,6 +103,11 @@ class ClientManager : public QObject, public INDI::BaseClient
     private:
         void processNewProperty(INDI::Property prop);
         void processRemoveBLOBManager(const QString &device, const QString &property);
+        /**
+         * @brief dispatchPendingProperties Emit updateINDIProperty for the updates queued by updateProperty,
+         * in the order they were received, from the thread of this object.
+         */
+        void dispatchPendingProperties();
         QList<QSharedPointer<DriverInfo>> m_ManagedDrivers;
         QList<BlobManager *> blobManagers;
         ServerManager *sManager { nullptr };
@@ -134,4 +141,10 @@ class ClientManager : public QObject, public INDI::BaseClient
         static constexpr uint8_t MAX_RETRIES {2};
         uint8_t m_ConnectionRetries {MAX_RETRIES};
         bool m_PendingConnection {false};
+
+        // Property updates received from the INDI client thread and not dispatched yet.
+        // Number properties are queued once, as the property always holds their latest values.
+        QMutex m_PendingMutex;
+        QList<INDI::Property> m_PendingProperties;
+        QSet<QString> m_PendingNumbers;
 };
@@ -19,7 +19,9 @@
 #include "Options.h"
 #include "servermanager.h"
 #include "ui_indihostconf.h"
+#include "version.h"
 #include "auxiliary/ksnotification.h"
+#include "auxiliary/executors.h"
 
 #include <basedevice.h>
 
@@ -29,8 +31,9 @@
 #include <KNotifications/KNotification>
 #endif
 
+#include <QFileInfo>
+#include <QJsonDocument>
 #include <QTcpServer>
-#include <QtConcurrent>
 #include <indi_debug.h>
 
 #define INDI_MAX_TRIES 2
@@ -383,7 +386,7 @@ void DriverManager::startLocalDrivers(ServerManager *serverManager)
 {
     connect(serverManager, &ServerManager::driverStarted, this, &DriverManager::processDriverStartup, Qt::UniqueConnection);
     connect(serverManager, &ServerManager::driverFailed, this, &DriverManager::processDriverFailure, Qt::UniqueConnection);
-    QtConcurrent::run(serverManager, &ServerManager::startDriver, serverManager->pendingDrivers().first());
+    Executors::run(Executors::Interactive, &ServerManager::startDriver, serverManager, serverManager->pendingDrivers().first());
 }
 
 void DriverManager::processDriverStartup(const QSharedPointer<DriverInfo> &driver)
@@ -394,7 +397,7 @@ void DriverManager::processDriverStartup(const QSharedPointer<DriverInfo> &drive
     // Do we have more pending drivers?
     if (manager->pendingDrivers().count() > 0)
     {
-        QtConcurrent::run(manager, &ServerManager::startDriver, manager->pendingDrivers().first());
+        Executors::run(Executors::Interactive, &ServerManager::startDriver, manager, manager->pendingDrivers().first());
         return;
     }
 
@@ -420,7 +423,7 @@ void DriverManager::processDriverFailure(const QSharedPointer<DriverInfo> &drive
         // Do we have more pending drivers?
         if (manager->pendingDrivers().count() > 0)
         {
-            QtConcurrent::run(manager, &ServerManager::startDriver, manager->pendingDrivers().first());
+            Executors::run(Executors::Interactive, &ServerManager::startDriver, manager, manager->pendingDrivers().first());
             return;
         }
     });
@@ -1018,21 +1021,58 @@ bool DriverManager::readXMLDrivers()
     indiDir.setFilter(QDir::Files | QDir::NoSymLinks);
     QFileInfoList list = indiDir.entryInfoList();
 
+    QStringList files;
+    QJsonArray stamp;
     for (auto &fileInfo : list)
     {
         if (fileInfo.fileName().endsWith(QLatin1String("_sk.xml")))
             continue;
 
-        processXMLDriver(fileInfo.absoluteFilePath());
+        files << fileInfo.absoluteFilePath();
+        stamp.append(QJsonArray({fileInfo.absoluteFilePath(), fileInfo.lastModified().toMSecsSinceEpoch(), fileInfo.size()}));
     }
 
     // JM 2022.08.24: Process local source last as INDI sources should have higher priority than KStars own database.
-    processXMLDriver(QLatin1String(":/indidrivers.xml"));
+    files << QLatin1String(":/indidrivers.xml");
+
+    // Parsing hundreds of XML files takes a while on slow storage. The drivers are kept in an index,
+    // which is only rebuilt when a driver file was added, removed or modified, or KStars was updated.
+    QFile indexFile(QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("indidrivers.json"));
+    QJsonArray drivers;
+    bool indexValid = false;
+    if (indexFile.open(QIODevice::ReadOnly))
+    {
+        const QJsonObject index = QJsonDocument::fromJson(indexFile.readAll()).object();
+        indexValid = index["version"].toString() == KSTARS_VERSION && index["stamp"].toArray() == stamp;
+        if (indexValid)
+            drivers = index["drivers"].toArray();
+        indexFile.close();
+    }
+
+    if (indexValid == false)
+    {
+        for (auto &oneFile : files)
+            processXMLDriver(oneFile, drivers);
+
+        if (indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            QJsonObject index;
+            index["version"] = KSTARS_VERSION;
+            index["stamp"] = stamp;
+            index["drivers"] = drivers;
+            indexFile.write(QJsonDocument(index).toJson(QJsonDocument::Compact));
+            indexFile.close();
+        }
+        qCDebug(KSTARS_INDI) << "Indexed" << drivers.size() << "drivers from" << files.size() << "files";
+    }
+
+    for (const auto &oneDriver : qAsConst(drivers))
+        addDriverElement(oneDriver.toObject());
 
     return true;
 }
 
-void DriverManager::processXMLDriver(const QString &driverName)
+void DriverManager::processXMLDriver(const QString &driverName, QJsonArray &drivers)
 {
     QFile file(driverName);
     if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
@@ -1063,14 +1103,14 @@ void DriverManager::processXMLDriver(const QString &driverName)
             {
                 for (ep = nextXMLEle(root, 1); ep != nullptr; ep = nextXMLEle(root, 0))
                 {
-                    if (!buildDeviceGroup(ep, errmsg))
+                    if (!buildDeviceGroup(ep, drivers, errmsg))
                         prXMLEle(stderr, ep, 0);
                 }
             }
             // If using the older format
             else
             {
-                if (!buildDeviceGroup(root, errmsg))
+                if (!buildDeviceGroup(root, drivers, errmsg))
                     prXMLEle(stderr, root, 0);
             }
 
@@ -1087,13 +1127,11 @@ void DriverManager::processXMLDriver(const QString &driverName)
     delLilXML(xmlParser);
 }
 
-bool DriverManager::buildDeviceGroup(XMLEle *root, char errmsg[])
+bool DriverManager::buildDeviceGroup(XMLEle *root, QJsonArray &drivers, char errmsg[])
 {
     XMLAtt *ap;
     XMLEle *ep;
     QString groupName;
-    QTreeWidgetItem *group;
-    DeviceFamily groupType = KSTARS_TELESCOPE;
 
     // avoid overflow
     if (strlen(tagXMLEle(root)) > 1024)
@@ -1110,49 +1148,24 @@ bool DriverManager::buildDeviceGroup(XMLEle *root, char errmsg[])
     }
 
     groupName = valuXMLAtt(ap);
-    groupType = DeviceFamilyLabels.key(groupName);
-
-#ifndef HAVE_CFITSIO
-    // We do not create these groups if we don't have CFITSIO support
-    if (groupType == KSTARS_CCD || groupType == KSTARS_VIDEO)
-        return true;
-#endif
-
-    // Find if the group already exists
-    QList<QTreeWidgetItem *> treeList =
-        ui->localTreeWidget->findItems(groupName, Qt::MatchExactly);
-    if (!treeList.isEmpty())
-        group = treeList[0];
-    else
-        group = new QTreeWidgetItem(ui->localTreeWidget, lastGroup);
-
-    group->setText(0, groupName);
-    lastGroup = group;
 
     for (ep = nextXMLEle(root, 1); ep != nullptr; ep = nextXMLEle(root, 0))
     {
-        if (!buildDriverElement(ep, group, groupType, errmsg))
+        if (!buildDriverElement(ep, groupName, drivers, errmsg))
             return false;
     }
 
     return true;
 }
 
-bool DriverManager::buildDriverElement(XMLEle *root, QTreeWidgetItem *DGroup,
-                                       DeviceFamily groupType, char errmsg[])
+bool DriverManager::buildDriverElement(XMLEle *root, const QString &groupName, QJsonArray &drivers, char errmsg[])
 {
     XMLAtt *ap;
     XMLEle *el;
-    QString label;
-    QString driver;
-    QString version;
-    // N.B. NOT an i18n string.
-    QString manufacturer("Others");
-    QString name;
-    QString port;
-    QString skel;
-    QVariantMap vMap;
-    //double focal_length(-1), aperture(-1);
+    QJsonObject driver;
+
+    driver["group"] = groupName;
+    driver["source"] = driverSource;
 
     ap = findXMLAtt(root, "label");
     if (!ap)
@@ -1162,42 +1175,33 @@ bool DriverManager::buildDriverElement(XMLEle *root, QTreeWidgetItem *DGroup,
         return false;
     }
 
-    label = valuXMLAtt(ap);
-
-    // Label is unique, so if we have the same label, we simply ignore
-    if (findDriverByLabel(label) != nullptr)
-        return true;
+    driver["label"] = valuXMLAtt(ap);
 
+    // N.B. NOT an i18n string.
     ap = findXMLAtt(root, "manufacturer");
-    if (ap)
-        manufacturer = valuXMLAtt(ap);
+    driver["manufacturer"] = ap ? valuXMLAtt(ap) : "Others";
 
     // Search for optional port attribute
     ap = findXMLAtt(root, "port");
     if (ap)
-        port = valuXMLAtt(ap);
+        driver["port"] = valuXMLAtt(ap);
 
     // Search for skel file, if any
-    // Search for optional port attribute
     ap = findXMLAtt(root, "skel");
     if (ap)
-        skel = valuXMLAtt(ap);
+        driver["skel"] = valuXMLAtt(ap);
 
     // Find MDPD: Multiple Devices Per Driver
     ap = findXMLAtt(root, "mdpd");
     if (ap)
-    {
-        bool mdpd = false;
-        mdpd      = (QString(valuXMLAtt(ap)) == QString("true")) ? true : false;
-        vMap.insert("mdpd", mdpd);
-    }
+        driver["mdpd"] = QString(valuXMLAtt(ap)) == QString("true");
 
     el = findXMLEle(root, "driver");
 
     if (!el)
         return false;
 
-    driver = pcdataXMLEle(el);
+    driver["executable"] = pcdataXMLEle(el);
 
     ap = findXMLAtt(el, "name");
     if (!ap)
@@ -1207,25 +1211,68 @@ bool DriverManager::buildDriverElement(XMLEle *root, QTreeWidgetItem *DGroup,
         return false;
     }
 
-    name = valuXMLAtt(ap);
+    driver["name"] = valuXMLAtt(ap);
 
     el = findXMLEle(root, "version");
 
     if (!el)
         return false;
 
-    version        = pcdataXMLEle(el);
+    QString version = pcdataXMLEle(el);
     bool versionOK = false;
     version.toDouble(&versionOK);
     if (versionOK == false)
         version = "1.0";
+    driver["version"] = version;
+
+    drivers.append(driver);
+    return true;
+}
+
+void DriverManager::addDriverElement(const QJsonObject &driver)
+{
+    const QString groupName = driver["group"].toString();
+    const DeviceFamily groupType = DeviceFamilyLabels.key(groupName);
+
+#ifndef HAVE_CFITSIO
+    // We do not create these groups if we don't have CFITSIO support
+    if (groupType == KSTARS_CCD || groupType == KSTARS_VIDEO)
+        return;
+#endif
+
+    const QString label = driver["label"].toString();
+
+    // Label is unique, so if we have the same label, we simply ignore
+    if (findDriverByLabel(label) != nullptr)
+        return;
+
+    // Find if the group already exists
+    QTreeWidgetItem *group = nullptr;
+    QList<QTreeWidgetItem *> treeList =
+        ui->localTreeWidget->findItems(groupName, Qt::MatchExactly);
+    if (!treeList.isEmpty())
+        group = treeList[0];
+    else
+    {
+        group = new QTreeWidgetItem(ui->localTreeWidget, lastGroup);
+        group->setText(0, groupName);
+    }
+    lastGroup = group;
 
-    bool driverIsAvailable = checkDriverAvailability(driver);
+    const QString executable = driver["executable"].toString();
+    const QString version = driver["version"].toString();
+    const QString port = driver["port"].toString();
+
+    QVariantMap vMap;
+    if (driver.contains("mdpd"))
+        vMap.insert("mdpd", driver["mdpd"].toBool());
+
+    bool driverIsAvailable = checkDriverAvailability(executable);
 
     vMap.insert("LOCALLY_AVAILABLE", driverIsAvailable);
     QIcon remoteIcon = QIcon::fromTheme("network-modem");
 
-    QTreeWidgetItem *device = new QTreeWidgetItem(DGroup);
+    QTreeWidgetItem *device = new QTreeWidgetItem(group);
 
     device->setText(LOCAL_NAME_COLUMN, label);
     if (driverIsAvailable)
@@ -1235,19 +1282,18 @@ bool DriverManager::buildDriverElement(XMLEle *root, QTreeWidgetItem *DGroup,
     device->setText(LOCAL_VERSION_COLUMN, version);
     device->setText(LOCAL_PORT_COLUMN, port);
 
-    //if ((driverSource == PRIMARY_XML) && driversStringList.contains(driver) == false)
-    if (groupType == KSTARS_TELESCOPE && driversStringList.contains(driver) == false)
-        driversStringList.append(driver);
+    if (groupType == KSTARS_TELESCOPE && driversStringList.contains(executable) == false)
+        driversStringList.append(executable);
 
-    QSharedPointer<DriverInfo> dv(new DriverInfo(name));
+    QSharedPointer<DriverInfo> dv(new DriverInfo(driver["name"].toString()));
 
     dv->setLabel(label);
     dv->setVersion(version);
-    dv->setExecutable(driver);
-    dv->setManufacturer(manufacturer);
-    dv->setSkeletonFile(skel);
+    dv->setExecutable(executable);
+    dv->setManufacturer(driver["manufacturer"].toString());
+    dv->setSkeletonFile(driver["skel"].toString());
     dv->setType(groupType);
-    dv->setDriverSource(driverSource);
+    dv->setDriverSource(static_cast<DriverSource>(driver["source"].toInt()));
     dv->setUserPort(port.isEmpty() ? 7624 : port.toInt());
     dv->setAuxInfo(vMap);
 
@@ -1257,8 +1303,6 @@ bool DriverManager::buildDriverElement(XMLEle *root, QTreeWidgetItem *DGroup,
     });
 
     driversList.append(dv);
-
-    return true;
 }
 
 bool DriverManager::checkDriverAvailability(const QString &driver)
@@ -17,6 +17,7 @@
 #include <QString>
 #include <QPointer>
 #include <QJsonArray>
+#include <QJsonObject>
 
 #include <lilxml.h>
 
@@ -86,9 +87,12 @@ class DriverManager : public QDialog
 
         bool readXMLDrivers();
         bool readINDIHosts();
-        void processXMLDriver(const QString &driverName);
-        bool buildDeviceGroup(XMLEle *root, char errmsg[]);
-        bool buildDriverElement(XMLEle *root, QTreeWidgetItem *DGroup, DeviceFamily groupType, char errmsg[]);
+        // Parse the drivers of an XML file into drivers, as objects of the driver index
+        void processXMLDriver(const QString &driverName, QJsonArray &drivers);
+        bool buildDeviceGroup(XMLEle *root, QJsonArray &drivers, char errmsg[]);
+        bool buildDriverElement(XMLEle *root, const QString &groupName, QJsonArray &drivers, char errmsg[]);
+        // Add a driver of the driver index to the list and the local tree
+        void addDriverElement(const QJsonObject &driver);
 
         int getINDIPort(int customPort);
         bool isDeviceRunning(const QString &deviceLabel);
@@ -9,6 +9,7 @@
 #include "clientmanager.h"
 #include "deviceinfo.h"
 #include "indidevice.h"
+#include "indimetricsdialog.h"
 #include "kstars.h"
 #include "Options.h"
 #include "fitsviewer/fitsviewer.h"
@@ -73,17 +74,21 @@ GUIManager::GUIManager(QWidget *parent) : QWidget(parent, Qt::Window)
     setAttribute(Qt::WA_ShowModal, false);
 
     clearB = new QPushButton(i18n("Clear"));
+    metricsB = new QPushButton(i18n("Metrics"));
+    metricsB->setToolTip(i18n("Show the rates and processing times of the property updates of the devices"));
     closeB = new QPushButton(i18n("Close"));
 
     QHBoxLayout *buttonLayout = new QHBoxLayout;
     buttonLayout->insertStretch(0);
     buttonLayout->addWidget(clearB, 0, Qt::AlignRight);
+    buttonLayout->addWidget(metricsB, 0, Qt::AlignRight);
     buttonLayout->addWidget(closeB, 0, Qt::AlignRight);
 
     mainLayout->addLayout(buttonLayout);
 
     connect(closeB, SIGNAL(clicked()), this, SLOT(close()));
     connect(clearB, SIGNAL(clicked()), this, SLOT(clearLog()));
+    connect(metricsB, &QPushButton::clicked, this, &GUIManager::showMetrics);
 
     resize(Options::iNDIWindowWidth(), Options::iNDIWindowHeight());
 
@@ -199,6 +204,15 @@ void GUIManager::clearLog()
         dev->clearMessageLog();
 }
 
+void GUIManager::showMetrics()
+{
+    if (metricsDialog.isNull())
+        metricsDialog = new INDIMetricsDialog(this);
+
+    metricsDialog->show();
+    metricsDialog->raise();
+}
+
 void GUIManager::addClient(ClientManager *cm)
 {
     clients.append(cm);
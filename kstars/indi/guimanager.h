@@ -7,6 +7,7 @@
 #pragma once
 
 #include <QList>
+#include <QPointer>
 #include <QWidget>
 
 class QCloseEvent;
@@ -18,6 +19,7 @@ class QTabWidget;
 class QVBoxLayout;
 
 class INDI_D;
+class INDIMetricsDialog;
 
 class ClientManager;
 class DeviceInfo;
@@ -66,7 +68,9 @@ class GUIManager : public QWidget
         QVBoxLayout *mainLayout;
         QTabWidget *mainTabWidget;
         QPushButton *clearB;
+        QPushButton *metricsB;
         QPushButton *closeB;
+        QPointer<INDIMetricsDialog> metricsDialog;
         GUIManager(QWidget *parent = nullptr);
         ~GUIManager() override;
 
@@ -77,6 +81,7 @@ class GUIManager : public QWidget
     public slots:
         void changeAlwaysOnTop(Qt::ApplicationState state);
         void clearLog();
+        void showMetrics();
         void buildDevice(DeviceInfo *di);
         void removeDevice(const QString &name);
 };
@@ -19,15 +19,17 @@
 #ifdef HAVE_CFITSIO
 #include "fitsviewer/fitsdata.h"
 #include "fitsviewer/fitstab.h"
+#include "fitsviewer/imagememory.h"
 #endif
 
 #include <KNotifications/KNotification>
 #include "auxiliary/ksmessagebox.h"
+#include "auxiliary/tracer.h"
 #include "ksnotification.h"
+#include "auxiliary/executors.h"
 #include <QImageReader>
 #include <QFileInfo>
 #include <QStatusBar>
-#include <QtConcurrent>
 
 #include <basedevice.h>
 
@@ -214,6 +216,13 @@ void Camera::registerProperty(INDI::Property prop)
         else
             m_FastExposureEnabled = false;
     }
+    else if (prop.isNameMatch("CCD_COMPRESSION"))
+    {
+        if (Options::bLOBCompression() == Options::EnumBLOBCompression::Never)
+            setCompressionEnabled(false);
+        else if (Options::bLOBCompression() == Options::EnumBLOBCompression::Always)
+            setCompressionEnabled(true);
+    }
     else if (prop.isNameMatch("TELESCOPE_TYPE"))
     {
         auto sp = prop.getSwitch();
@@ -569,6 +578,8 @@ bool Camera::generateFilename(bool batch_mode, const QString &extension, QString
         return false;
     test_file.flush();
     test_file.close();
+    // The next sequence IDs are found without scanning the directory again
+    Ekos::PlaceholderPath::addToDirectoryIndex(*filename);
     return true;
 }
 
@@ -604,11 +615,16 @@ bool Camera::writeImageFile(const QString &filename, INDI::Property prop, bool i
         // Copy memory, and write file on a separate thread.
         // Probably too late to return an error if the file couldn't write.
         memcpy(fileWriteBuffer, bp->getBlob(), bp->getBlobLen());
-        fileWriteThread = QtConcurrent::run(this, &ISD::Camera::WriteImageFileInternal, fileWriteFilename, fileWriteBuffer,
-                                            bp->getBlobLen());
+        fileWriteThread = Executors::run(Executors::Background, &ISD::Camera::WriteImageFileInternal, this, fileWriteFilename, fileWriteBuffer,
+                                         bp->getBlobLen());
     }
     else
     {
+        // Only FITS files are written in the background
+        if (fileWriteThread.isRunning())
+            fileWriteThread.waitForFinished();
+        fileWriteFilename.clear();
+
         auto bp = prop.getBLOB()->at(0);
         if (!WriteImageFileInternal(filename, static_cast<char*>(bp->getBlob()), bp->getBlobLen()))
             return false;
@@ -661,6 +677,8 @@ QSharedPointer<FITSViewer> Camera::getFITSViewer()
 
 bool Camera::processBLOB(INDI::Property prop)
 {
+    KSTARS_TRACE_SPAN("indi", "BLOB process");
+
     auto bvp = prop.getBLOB();
     // Ignore write-only BLOBs since we only receive it for state-change
     if (bvp->getPermission() == IP_WO || bvp->at(0)->getSize() == 0)
@@ -712,6 +730,8 @@ bool Camera::processBLOB(INDI::Property prop)
                              bp->getSize();
     }
 
+    updateCompression(targetChip, bp->getSize());
+
     // Create temporary name if ANY of the following conditions are met:
     // 1. file is preview or batch mode is not enabled
     // 2. file type is not FITS_NORMAL (focus, guide..etc)
@@ -855,9 +875,10 @@ bool Camera::processBLOB(INDI::Property prop)
     // 2. FITS Viewer is disabled; and
     // 3. Batch mode is enabled.
     // 4. Summary view is false.
+    // In headless capture, batch images are never displayed, their files are loaded when they are analyzed.
     if (targetChip->getCaptureMode() == FITS_NORMAL &&
-            Options::useFITSViewer() == false &&
-            Options::useSummaryPreview() == false &&
+            (Options::captureHeadless() ||
+             (Options::useFITSViewer() == false && Options::useSummaryPreview() == false)) &&
             targetChip->isBatchMode())
     {
         emit propertyUpdated(prop);
@@ -868,6 +889,9 @@ bool Camera::processBLOB(INDI::Property prop)
     QByteArray buffer = QByteArray::fromRawData(reinterpret_cast<char *>(bp->getBlob()), bp->getSize());
     QSharedPointer<FITSData> imageData;
     imageData.reset(new FITSData(targetChip->getCaptureMode()), &QObject::deleteLater);
+    // Guide, focus and align frames are owned by their mode
+    if (targetChip->getCaptureMode() == FITS_NORMAL)
+        ImageMemory::instance().setOwner(imageData.get(), ImageMemory::Capture);
     if (!imageData->loadFromBuffer(buffer, shortFormat, filename))
     {
         emit error(ERROR_LOAD);
@@ -1706,6 +1730,67 @@ bool Camera::setFastExposureEnabled(bool enable)
     return true;
 }
 
+bool Camera::setCompressionEnabled(bool enable)
+{
+    auto svp = getSwitch("CCD_COMPRESSION");
+
+    if (!svp)
+        return false;
+
+    // Do not resend the property if the driver already has the requested state.
+    if ((svp->findOnSwitchIndex() == 0) == enable)
+        return true;
+
+    svp->at(0)->setState(enable ? ISS_ON : ISS_OFF);
+    svp->at(1)->setState(enable ? ISS_OFF : ISS_ON);
+    sendNewProperty(svp);
+
+    return true;
+}
+
+void Camera::updateCompression(CameraChip *chip, int size)
+{
+    switch (Options::bLOBCompression())
+    {
+        case Options::EnumBLOBCompression::Never:
+            setCompressionEnabled(false);
+            return;
+        case Options::EnumBLOBCompression::Always:
+            setCompressionEnabled(true);
+            return;
+        case Options::EnumBLOBCompression::Automatic:
+            break;
+        default:
+            return;
+    }
+
+    // Compressing costs the driver more time than it saves on a local link.
+    const QString host = m_Parent->getClientManager()->getHost();
+    if (host == "localhost" || host == "127.0.0.1" || host == "::1")
+    {
+        setCompressionEnabled(false);
+        return;
+    }
+
+    // Short downloads are dominated by the readout and latency, they don't tell the link speed.
+    const double seconds = chip->takeDownloadSeconds();
+    if (seconds < 0.5)
+        return;
+
+    const double speed = size * 8.0 / 1e6 / seconds;
+    m_LinkSpeed = m_LinkSpeed > 0 ? 0.7 * m_LinkSpeed + 0.3 * speed : speed;
+
+    // Keep some margin above the threshold so compression isn't toggled by every measurement.
+    const double threshold = Options::bLOBCompressionThreshold();
+    if (m_LinkSpeed < threshold)
+        setCompressionEnabled(true);
+    else if (m_LinkSpeed > threshold * 2)
+        setCompressionEnabled(false);
+
+    qCDebug(KSTARS_INDI) << getDeviceName() << "download of" << size << "bytes in" << seconds << "s, link speed"
+                         << m_LinkSpeed << "Mbit/s";
+}
+
 bool Camera::setCaptureFormat(const QString &format)
 {
     auto svp = getSwitch("CCD_CAPTURE_FORMAT");
@@ -1808,6 +1893,8 @@ bool Camera::setScopeInfo(double focalLength, double aperture)
 // Internal function to write an image blob to disk.
 bool Camera::WriteImageFileInternal(const QString &filename, char *buffer, const size_t size)
 {
+    KSTARS_TRACE_SPAN("capture", "Save");
+
     QFile file(filename);
     if (!file.open(QIODevice::WriteOnly))
     {
@@ -221,6 +221,12 @@ class Camera : public ConcreteDevice
         }
         bool setFastCount(uint32_t count);
 
+        /**
+         * @brief setCompressionEnabled Ask the driver to compress images before sending them.
+         * @return false if the driver doesn't support compression.
+         */
+        bool setCompressionEnabled(bool enable);
+
         const QMap<QString, double> &getExposurePresets() const
         {
             return m_ExposurePresets;
@@ -230,6 +236,16 @@ class Camera : public ConcreteDevice
             return m_ExposurePresetsMinMax;
         }
 
+        // The FITS file of the last batch image and its write, which runs in the background
+        const QString &getFileWriteFilename() const
+        {
+            return fileWriteFilename;
+        }
+        QFuture<void> getFileWrite() const
+        {
+            return fileWriteThread;
+        }
+
     public slots:
         void StreamWindowHidden();
         // Blob manager
@@ -266,6 +282,8 @@ class Camera : public ConcreteDevice
         // TODO: Need to remove all FITSViewer related functions from INDI::Camera
         QSharedPointer<FITSViewer> getFITSViewer();
         void handleImage(CameraChip *targetChip, const QString &filename, INDI::Property prop, QSharedPointer<FITSData> data);
+        // Apply the compression policy, measuring the link with an image of size bytes just received by chip.
+        void updateCompression(CameraChip *chip, int size);
 
         bool HasGuideHead { false };
         bool HasCooler { false };
@@ -273,6 +291,8 @@ class Camera : public ConcreteDevice
         bool HasCoolerControl { false };
         bool HasVideoStream { false };
         bool m_FastExposureEnabled { false };
+        // Estimated speed of the link to the driver, in Mbit/s, 0 until measured
+        double m_LinkSpeed { 0 };
         QString seqPrefix;
         Ekos::PlaceholderPath placeholderPath;
 
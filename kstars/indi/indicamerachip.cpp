@@ -403,9 +403,24 @@ bool CameraChip::capture(double exposure)
 
     m_Camera->sendNewProperty(newExpProp.get());
 
+    m_CaptureTimer.start();
+    m_CaptureExposure = exposure;
+
     return true;
 }
 
+double CameraChip::takeDownloadSeconds()
+{
+    if (m_CaptureTimer.isValid() == false)
+        return -1;
+
+    // This includes the readout, which only matters for short downloads on fast links.
+    // Frames of fast exposures and loops are not requested, so each request is measured once.
+    const double seconds = m_CaptureTimer.elapsed() / 1000.0 - m_CaptureExposure;
+    m_CaptureTimer.invalidate();
+    return seconds;
+}
+
 bool CameraChip::abortExposure()
 {
     if (!m_Camera) return false;
@@ -9,6 +9,8 @@
 #include "../fitsviewer/fitsview.h"
 #include "indicommon.h"
 
+#include <QElapsedTimer>
+
 namespace ISD
 {
 
@@ -121,6 +123,9 @@ class CameraChip
 
         QStringList getISOList() const;
 
+        /// @return seconds between the end of the last exposure and now, or a negative value if unknown or already taken
+        double takeDownloadSeconds();
+
     private:
         QPointer<FITSView> normalImage, focusImage, guideImage, calibrationImage, alignImage;
         QSharedPointer<FITSData> imageData { nullptr };
@@ -134,6 +139,10 @@ class CameraChip
 
         ISD::Camera *m_Camera { nullptr };
         ChipType m_Type;
+
+        // Start and duration of the last exposure, to measure the download time
+        QElapsedTimer m_CaptureTimer;
+        double m_CaptureExposure { 0 };
 };
 
 }
@@ -13,12 +13,15 @@
 #include "indi/clientmanager.h"
 #include "indi/indilistener.h"
 #include "indi/indiconcretedevice.h"
+#include "indi/indimetrics.h"
 #include "indi/deviceinfo.h"
 
 #include "kstars_debug.h"
 
 #include <basedevice.h>
 
+#include <QJsonDocument>
+
 INDIDBus::INDIDBus(QObject *parent) : QObject(parent)
 {
     new INDIAdaptor(this);
@@ -557,3 +560,13 @@ QString INDIDBus::getBLOBFile(const QString &device, const QString &property, co
     qCWarning(KSTARS) << "Could not find property: " << device << '.' << property << '.' << blobName;
     return filename;
 }
+
+QString INDIDBus::getMetrics()
+{
+    return QString::fromUtf8(QJsonDocument(INDIMetrics::Instance()->report()).toJson(QJsonDocument::Compact));
+}
+
+void INDIDBus::resetMetrics()
+{
+    INDIMetrics::Instance()->reset();
+}
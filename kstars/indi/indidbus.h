@@ -171,5 +171,16 @@ class INDIDBus : public QObject
         Q_SCRIPTABLE QString getBLOBFile(const QString &device, const QString &property, const QString &blobName,
                                          QString &blobFormat, int &size);
 
+        /** DBUS interface function. Returns the metrics of INDI property updates since the last reset.
+            * @returns JSON object with, for each device and each of its properties, the rate of received and handled updates,
+            * the delay between receiving and handling an update, the time spent handling it and the BLOB throughput.
+            * @see resetMetrics
+            */
+        Q_SCRIPTABLE QString getMetrics();
+
+        /** DBUS interface function. Clears the metrics of INDI property updates and restarts their measurement.
+            */
+        Q_SCRIPTABLE void resetMetrics();
+
         /** @}*/
 };
@@ -70,6 +70,11 @@ INDI_D::INDI_D(QWidget *parent, INDI::BaseDevice baseDevice, ClientManager *in_c
     deviceVBox->setStretchFactor(0, 2);
 
     layout->addWidget(deviceVBox);
+
+    m_RefreshTimer.setSingleShot(true);
+    m_RefreshTimer.setInterval(REFRESH_PERIOD_MS);
+    connect(&m_RefreshTimer, &QTimer::timeout, this, &INDI_D::refreshProperties);
+    connect(groupContainer, &QTabWidget::currentChanged, this, &INDI_D::refreshProperties);
 }
 
 bool INDI_D::buildProperty(INDI::Property prop)
@@ -157,6 +162,54 @@ bool INDI_D::removeProperty(INDI::Property prop)
 }
 
 bool INDI_D::updateProperty(INDI::Property prop)
+{
+    if (m_Name != prop.getDeviceName())
+        return false;
+
+    // Widgets are only refreshed at REFRESH_PERIOD_MS and while they are visible,
+    // the latest values are read from the property when they are.
+    m_DirtyProperties.insert(prop.getName());
+    if (isVisible() && m_RefreshTimer.isActive() == false)
+        m_RefreshTimer.start();
+
+    return true;
+}
+
+void INDI_D::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    refreshProperties();
+}
+
+void INDI_D::refreshProperties()
+{
+    QMutableSetIterator<QString> it(m_DirtyProperties);
+    while (it.hasNext())
+    {
+        const QString &name = it.next();
+        auto prop = m_BaseDevice.getProperty(name.toLatin1().constData());
+        if (prop.isValid() == false)
+        {
+            it.remove();
+            continue;
+        }
+
+        INDI_P *guiProp = nullptr;
+        for (const auto &pg : groupsList)
+        {
+            if ((guiProp = pg->getProperty(name)) != nullptr)
+                break;
+        }
+
+        if (guiProp == nullptr || guiProp->isVisible())
+        {
+            syncProperty(prop);
+            it.remove();
+        }
+    }
+}
+
+bool INDI_D::syncProperty(INDI::Property prop)
 {
     switch (prop.getType())
     {
@@ -13,6 +13,8 @@
 #include <QLabel>
 #include <QVBoxLayout>
 #include <QMutex>
+#include <QSet>
+#include <QTimer>
 
 #include <indiapi.h>
 #include <basedevice.h>
@@ -75,7 +77,14 @@ class INDI_D : public QWidget
 
         void updateMessageLog(INDI::BaseDevice idv, int messageID);
 
+    protected:
+        void showEvent(QShowEvent *event) override;
+
     private:
+        // Update the widgets of the dirty properties that are visible, the others stay dirty.
+        void refreshProperties();
+        bool syncProperty(INDI::Property prop);
+
         QString m_Name;
 
         // GUI
@@ -88,4 +97,10 @@ class INDI_D : public QWidget
         ClientManager *m_ClientManager { nullptr };
 
         QList<INDI_G *> groupsList;
+
+        // Properties updated since their widgets were last refreshed
+        QSet<QString> m_DirtyProperties;
+        QTimer m_RefreshTimer;
+        // Fast enough to follow any value, slow enough for 10Hz telemetry to cost little layout work
+        static constexpr int REFRESH_PERIOD_MS = 100;
 };
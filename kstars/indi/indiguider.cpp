@@ -7,6 +7,7 @@
 */
 
 #include "indiguider.h"
+#include "auxiliary/tracer.h"
 
 namespace ISD
 {
@@ -22,12 +23,35 @@ void Guider::setDECSwap(bool enable)
 
 bool Guider::doPulse(GuideDirection ra_dir, int ra_msecs, GuideDirection dec_dir, int dec_msecs)
 {
-    bool raOK  = doPulse(ra_dir, ra_msecs);
-    bool decOK = doPulse(dec_dir, dec_msecs);
-    return (raOK && decOK);
+    KSTARS_TRACE_SPAN("guide", "Pulse emit");
+
+    // INDI has no property for both axes. Both are filled before the first is sent, so that
+    // they leave back to back.
+    auto raPulse  = preparePulse(ra_dir, ra_msecs);
+    auto decPulse = preparePulse(dec_dir, dec_msecs);
+
+    if (raPulse)
+        sendPulse(raPulse);
+    if (decPulse)
+        sendPulse(decPulse);
+
+    return (raPulse && decPulse);
 }
 
 bool Guider::doPulse(GuideDirection dir, int msecs)
+{
+    KSTARS_TRACE_SPAN("guide", "Pulse emit");
+
+    auto pulse = preparePulse(dir, msecs);
+    if (!pulse)
+        return false;
+
+    sendPulse(pulse);
+
+    return true;
+}
+
+INDI::PropertyView<INumber> *Guider::preparePulse(GuideDirection dir, int msecs)
 {
     auto raPulse  = getNumber("TELESCOPE_TIMED_GUIDE_WE");
     auto decPulse = getNumber("TELESCOPE_TIMED_GUIDE_NS");
@@ -35,7 +59,7 @@ bool Guider::doPulse(GuideDirection dir, int msecs)
     INDI::WidgetView<INumber> *dirPulse   = nullptr;
 
     if (!raPulse || !decPulse)
-        return false;
+        return nullptr;
 
     if (dir == RA_INC_DIR || dir == RA_DEC_DIR)
     {
@@ -71,16 +95,40 @@ bool Guider::doPulse(GuideDirection dir, int msecs)
             break;
 
         default:
-            return false;
+            return nullptr;
     }
 
     if (!dirPulse)
-        return false;
+        return nullptr;
 
     dirPulse->setValue(msecs);
 
-    sendNewProperty(npulse);
+    return npulse;
+}
 
-    return true;
+void Guider::sendPulse(INDI::PropertyView<INumber> *pulse)
+{
+    if (pulse->isNameMatch("TELESCOPE_TIMED_GUIDE_WE"))
+        m_PendingWE = true;
+    else
+        m_PendingNS = true;
+
+    sendNewProperty(pulse);
+}
+
+void Guider::processNumber(INDI::Property prop)
+{
+    if (!m_PendingWE && !m_PendingNS)
+        return;
+
+    if (prop.isNameMatch("TELESCOPE_TIMED_GUIDE_WE"))
+        m_PendingWE = false;
+    else if (prop.isNameMatch("TELESCOPE_TIMED_GUIDE_NS"))
+        m_PendingNS = false;
+    else
+        return;
+
+    if (!m_PendingWE && !m_PendingNS)
+        emit pulsesAcknowledged();
 }
 }
@@ -23,6 +23,8 @@ namespace ISD
 {
 class Guider : public ConcreteDevice
 {
+        Q_OBJECT
+
     public:
         Guider(GenericDevice *parent);
 
@@ -30,8 +32,24 @@ class Guider : public ConcreteDevice
         bool doPulse(GuideDirection dir, int msecs);
         void setDECSwap(bool enable);
 
+        void processNumber(INDI::Property prop) override;
+
+    signals:
+        /**
+         * @brief pulsesAcknowledged is emitted when the driver has answered all the pulse properties
+         * sent by the last doPulse(), by setting them busy or done.
+         */
+        void pulsesAcknowledged();
+
     private:
+        // Fills the property of the axis of dir with the pulse, returns nullptr if there is none.
+        INDI::PropertyView<INumber> *preparePulse(GuideDirection dir, int msecs);
+        void sendPulse(INDI::PropertyView<INumber> *pulse);
+
         bool swapDEC { false };
+        // The pulse properties the driver hasn't answered yet
+        bool m_PendingWE { false };
+        bool m_PendingNS { false };
 };
 
 }
@@ -10,6 +10,7 @@
 
 #include "clientmanager.h"
 #include "deviceinfo.h"
+#include "indimetrics.h"
 #include "kstars.h"
 #include "Options.h"
 
@@ -17,6 +18,8 @@
 
 #include <knotification.h>
 
+#include <QElapsedTimer>
+
 #include <basedevice.h>
 #include <indi_debug.h>
 
@@ -193,7 +196,11 @@ void INDIListener::updateProperty(INDI::Property prop)
     {
         if (oneDevice->getDeviceName() == prop.getDeviceName())
         {
+            // Time the device and the concrete devices it forwards the update to.
+            QElapsedTimer handlerTimer;
+            handlerTimer.start();
             oneDevice->updateProperty(prop);
+            INDIMetrics::Instance()->handled(prop.getDeviceName(), prop.getName(), handlerTimer.nsecsElapsed());
             break;
         }
     }
@@ -0,0 +1,131 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "indimetrics.h"
+
+#include <QMutexLocker>
+
+#include <algorithm>
+
+INDIMetrics *INDIMetrics::Instance()
+{
+    // Updates are received on INDI client threads, the instance may be created on any of them.
+    static INDIMetrics instance;
+    return &instance;
+}
+
+INDIMetrics::INDIMetrics()
+{
+    m_Clock.start();
+}
+
+void INDIMetrics::received(const QString &device, const QString &property, qint64 blobBytes)
+{
+    QMutexLocker locker(&m_Mutex);
+    auto &metrics = m_Metrics[device][property];
+    metrics.received++;
+    if (metrics.pendingSince < 0)
+        metrics.pendingSince = m_Clock.nsecsElapsed();
+    if (blobBytes > 0)
+    {
+        metrics.blobs++;
+        metrics.blobBytes += blobBytes;
+    }
+}
+
+void INDIMetrics::handled(const QString &device, const QString &property, qint64 handlerNsecs)
+{
+    QMutexLocker locker(&m_Mutex);
+    auto &metrics = m_Metrics[device][property];
+    metrics.handled++;
+    metrics.handlerTotal += handlerNsecs;
+    metrics.handlerMax = std::max(metrics.handlerMax, handlerNsecs);
+
+    // Properties defined or refreshed without an update, e.g. when a device is connected, have no queue delay.
+    if (metrics.pendingSince >= 0)
+    {
+        // The handler ran before this call, it is not part of the delay.
+        const qint64 delay = std::max<qint64>(0, m_Clock.nsecsElapsed() - handlerNsecs - metrics.pendingSince);
+        metrics.queueDelayTotal += delay;
+        metrics.queueDelayMax = std::max(metrics.queueDelayMax, delay);
+        metrics.pendingSince = -1;
+    }
+}
+
+QJsonObject INDIMetrics::report() const
+{
+    QMutexLocker locker(&m_Mutex);
+
+    const double seconds = std::max<qint64>(1, m_Clock.elapsed()) / 1000.0;
+    auto average = [](qint64 total, quint64 count)
+    {
+        return count > 0 ? total / 1e6 / count : 0.0;
+    };
+
+    QJsonObject devices;
+    for (auto device = m_Metrics.cbegin(); device != m_Metrics.cend(); ++device)
+    {
+        PropertyMetrics totals;
+        QJsonObject properties;
+        for (auto property = device.value().cbegin(); property != device.value().cend(); ++property)
+        {
+            const PropertyMetrics &metrics = property.value();
+            QJsonObject oneProperty
+            {
+                {"received", static_cast<double>(metrics.received)},
+                {"receivedPerSecond", metrics.received / seconds},
+                {"handled", static_cast<double>(metrics.handled)},
+                {"handledPerSecond", metrics.handled / seconds},
+                {"queueDelayAverageMs", average(metrics.queueDelayTotal, metrics.handled)},
+                {"queueDelayMaxMs", metrics.queueDelayMax / 1e6},
+                {"handlerAverageMs", average(metrics.handlerTotal, metrics.handled)},
+                {"handlerMaxMs", metrics.handlerMax / 1e6},
+                {"handlerTotalMs", metrics.handlerTotal / 1e6}
+            };
+            if (metrics.blobs > 0)
+            {
+                oneProperty.insert("blobs", static_cast<double>(metrics.blobs));
+                oneProperty.insert("blobBytes", static_cast<double>(metrics.blobBytes));
+                oneProperty.insert("blobBytesPerSecond", metrics.blobBytes / seconds);
+            }
+            properties.insert(property.key(), oneProperty);
+
+            totals.received += metrics.received;
+            totals.handled += metrics.handled;
+            totals.handlerTotal += metrics.handlerTotal;
+            totals.handlerMax = std::max(totals.handlerMax, metrics.handlerMax);
+            totals.queueDelayTotal += metrics.queueDelayTotal;
+            totals.queueDelayMax = std::max(totals.queueDelayMax, metrics.queueDelayMax);
+            totals.blobBytes += metrics.blobBytes;
+        }
+
+        devices.insert(device.key(), QJsonObject
+        {
+            {"receivedPerSecond", totals.received / seconds},
+            {"handledPerSecond", totals.handled / seconds},
+            {"queueDelayAverageMs", average(totals.queueDelayTotal, totals.handled)},
+            {"queueDelayMaxMs", totals.queueDelayMax / 1e6},
+            {"handlerAverageMs", average(totals.handlerTotal, totals.handled)},
+            {"handlerMaxMs", totals.handlerMax / 1e6},
+            {"handlerLoad", totals.handlerTotal / 1e9 / seconds},
+            {"blobBytesPerSecond", totals.blobBytes / seconds},
+            {"properties", properties}
+        });
+    }
+
+    return QJsonObject
+    {
+        {"seconds", seconds},
+        {"devices", devices}
+    };
+}
+
+void INDIMetrics::reset()
+{
+    QMutexLocker locker(&m_Mutex);
+    m_Metrics.clear();
+    m_Clock.restart();
+}
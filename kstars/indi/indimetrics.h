@@ -0,0 +1,73 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QMutex>
+#include <QString>
+
+/**
+ * @class INDIMetrics
+ * @short Collects where the time of INDI property updates is spent.
+ *
+ * For each property of each device, the collector counts the updates received from the
+ * INDI server, the updates handled by the devices, the delay between receiving an update on
+ * the INDI client thread and handling it on the main thread, and the time spent handling it.
+ * BLOBs are counted with their size, to give the download throughput of each camera.
+ *
+ * Updates are received by ClientManager and BlobManager, and handled by INDIListener which
+ * forwards them to the ISD devices. Several updates of a property received before it is handled
+ * are counted once as handled, the queue delay being the one of the oldest update.
+ *
+ * The collector is thread-safe, and cheap enough to be always enabled.
+ */
+class INDIMetrics
+{
+    public:
+        static INDIMetrics *Instance();
+
+        /** @short An update of @p property of @p device was received, from any thread */
+        void received(const QString &device, const QString &property, qint64 blobBytes = 0);
+
+        /** @short An update of @p property of @p device was handled in @p handlerNsecs nanoseconds */
+        void handled(const QString &device, const QString &property, qint64 handlerNsecs);
+
+        /**
+         * @brief report Metrics since the last reset.
+         * @return an object with the duration of the measurement in seconds, and for each device
+         * the totals and the metrics of each property: update rate, handled update rate, average and
+         * maximum queue delay and handler time in milliseconds, BLOB count, bytes and throughput.
+         */
+        QJsonObject report() const;
+
+        /** @short Clear all metrics and restart the measurement */
+        void reset();
+
+    private:
+        INDIMetrics();
+
+        struct PropertyMetrics
+        {
+            quint64 received { 0 };
+            quint64 handled { 0 };
+            // Receive time of the oldest update not handled yet, or -1
+            qint64 pendingSince { -1 };
+            qint64 queueDelayTotal { 0 };
+            qint64 queueDelayMax { 0 };
+            qint64 handlerTotal { 0 };
+            qint64 handlerMax { 0 };
+            quint64 blobs { 0 };
+            quint64 blobBytes { 0 };
+        };
+
+        mutable QMutex m_Mutex;
+        QElapsedTimer m_Clock;
+        // Keyed by device, then property
+        QHash<QString, QHash<QString, PropertyMetrics>> m_Metrics;
+};
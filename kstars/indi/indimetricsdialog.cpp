@@ -0,0 +1,123 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "indimetricsdialog.h"
+
+#include "indimetrics.h"
+
+#include <KLocalizedString>
+
+#include <QDialogButtonBox>
+#include <QHeaderView>
+#include <QJsonObject>
+#include <QPushButton>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+namespace
+{
+// Values of the columns, after the name column
+const QStringList columnKeys =
+{
+    "receivedPerSecond", "handledPerSecond", "queueDelayAverageMs", "queueDelayMaxMs",
+    "handlerAverageMs", "handlerMaxMs", "blobBytesPerSecond"
+};
+
+void setValues(QTreeWidgetItem *item, const QJsonObject &metrics)
+{
+    for (int i = 0; i < columnKeys.size(); i++)
+    {
+        const QString &key = columnKeys[i];
+        if (metrics.contains(key) == false)
+            item->setText(i + 1, QString());
+        else if (key == "blobBytesPerSecond")
+            item->setText(i + 1, QString::number(metrics[key].toDouble() / 1e6, 'f', 2));
+        else
+            item->setText(i + 1, QString::number(metrics[key].toDouble(), 'f', 2));
+        item->setTextAlignment(i + 1, Qt::AlignRight | Qt::AlignVCenter);
+    }
+}
+
+QTreeWidgetItem *findChild(QTreeWidgetItem *parent, const QString &name)
+{
+    for (int i = 0; i < parent->childCount(); i++)
+    {
+        if (parent->child(i)->text(0) == name)
+            return parent->child(i);
+    }
+    return new QTreeWidgetItem(parent, QStringList(name));
+}
+}
+
+INDIMetricsDialog::INDIMetricsDialog(QWidget *parent) : QDialog(parent)
+{
+    setWindowTitle(i18nc("@title:window", "INDI Metrics"));
+
+    m_Tree = new QTreeWidget(this);
+    m_Tree->setHeaderLabels(QStringList()
+                            << i18n("Device / Property")
+                            << i18n("Received/s")
+                            << i18n("Handled/s")
+                            << i18n("Queue Delay (ms)")
+                            << i18n("Max Queue Delay (ms)")
+                            << i18n("Handler (ms)")
+                            << i18n("Max Handler (ms)")
+                            << i18n("BLOB (MB/s)"));
+    m_Tree->setSortingEnabled(true);
+    m_Tree->sortByColumn(0, Qt::AscendingOrder);
+    m_Tree->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+
+    QDialogButtonBox *buttonBox = new QDialogButtonBox(QDialogButtonBox::Reset | QDialogButtonBox::Close, this);
+    connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::close);
+    connect(buttonBox->button(QDialogButtonBox::Reset), &QPushButton::clicked, this, [this]()
+    {
+        INDIMetrics::Instance()->reset();
+        m_Tree->clear();
+        refresh();
+    });
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addWidget(m_Tree);
+    layout->addWidget(buttonBox);
+
+    resize(900, 500);
+
+    m_RefreshTimer.setInterval(REFRESH_PERIOD_MS);
+    connect(&m_RefreshTimer, &QTimer::timeout, this, &INDIMetricsDialog::refresh);
+}
+
+void INDIMetricsDialog::showEvent(QShowEvent *event)
+{
+    refresh();
+    m_RefreshTimer.start();
+    QDialog::showEvent(event);
+}
+
+void INDIMetricsDialog::hideEvent(QHideEvent *event)
+{
+    m_RefreshTimer.stop();
+    QDialog::hideEvent(event);
+}
+
+void INDIMetricsDialog::refresh()
+{
+    const QJsonObject devices = INDIMetrics::Instance()->report()["devices"].toObject();
+
+    // Items are updated in place to keep the expanded devices and the selection.
+    m_Tree->setSortingEnabled(false);
+    QTreeWidgetItem *root = m_Tree->invisibleRootItem();
+    for (auto device = devices.constBegin(); device != devices.constEnd(); ++device)
+    {
+        const QJsonObject deviceMetrics = device.value().toObject();
+        QTreeWidgetItem *deviceItem = findChild(root, device.key());
+        setValues(deviceItem, deviceMetrics);
+
+        const QJsonObject properties = deviceMetrics["properties"].toObject();
+        for (auto property = properties.constBegin(); property != properties.constEnd(); ++property)
+            setValues(findChild(deviceItem, property.key()), property.value().toObject());
+    }
+    m_Tree->setSortingEnabled(true);
+}
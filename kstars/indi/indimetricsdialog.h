@@ -0,0 +1,39 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QDialog>
+#include <QTimer>
+
+class QTreeWidget;
+
+/**
+ * @class INDIMetricsDialog
+ * @short Shows the metrics of INDI property updates, for each device and each of its properties.
+ *
+ * The metrics are refreshed every second while the dialog is visible.
+ * @see INDIMetrics
+ */
+class INDIMetricsDialog : public QDialog
+{
+        Q_OBJECT
+
+    public:
+        explicit INDIMetricsDialog(QWidget *parent = nullptr);
+
+    protected:
+        void showEvent(QShowEvent *event) override;
+        void hideEvent(QHideEvent *event) override;
+
+    private:
+        void refresh();
+
+        static constexpr int REFRESH_PERIOD_MS = 1000;
+
+        QTreeWidget *m_Tree { nullptr };
+        QTimer m_RefreshTimer;
+};
@@ -13,6 +13,7 @@
 #include "skymap.h"
 #include "skymapcomposite.h"
 #include "ksnotification.h"
+#include "auxiliary/tracer.h"
 
 #include <KActionCollection>
 #include <KLocalizedString>
@@ -25,6 +26,8 @@
 // Qt version calming
 #include <qtendl.h>
 
+#include <cmath>
+
 namespace ISD
 {
 
@@ -56,6 +59,11 @@ Mount::Mount(GenericDevice *parent) : ConcreteDevice(parent)
         }
     });
 
+    // Repaint the telescope symbols at most so often, however often the driver reports the position
+    skyMapUpdateTimer.setInterval(SKYMAP_UPDATE_INTERVAL);
+    skyMapUpdateTimer.setSingleShot(true);
+    connect(&skyMapUpdateTimer, &QTimer::timeout, this, &Mount::repaintSkyMap);
+
     qRegisterMetaType<ISD::Mount::Status>("ISD::Mount::Status");
     qDBusRegisterMetaType<ISD::Mount::Status>();
 
@@ -266,7 +274,7 @@ void Mount::processNumber(INDI::Property prop)
 
         EqCoordPreviousState = nvp->getState();
 
-        KStars::Instance()->map()->update();
+        updateSkyMap();
     }
     // JM 2022.03.11 Only process HORIZONTAL_COORD if it was the ONLY source of information
     // When a driver both sends EQUATORIAL_COORD and HORIZONTAL_COORD, we should prioritize EQUATORIAL_COORD
@@ -292,7 +300,7 @@ void Mount::processNumber(INDI::Property prop)
         if (! updateCoordinatesTimer.isActive())
             updateCoordinatesTimer.start();
 
-        KStars::Instance()->map()->update();
+        updateSkyMap();
     }
     else if (nvp->isNameMatch("POLLING_PERIOD"))
     {
@@ -304,6 +312,25 @@ void Mount::processNumber(INDI::Property prop)
     }
 }
 
+void Mount::updateSkyMap()
+{
+    // A pending repaint picks up the latest position once it is due
+    if (!skyMapUpdateTimer.isActive())
+        repaintSkyMap();
+}
+
+void Mount::repaintSkyMap()
+{
+    // Tracking mounts keep reporting the same position, which is drawn already
+    if (std::abs(currentCoords.ra().Degrees() - skyMapCoords.ra().Degrees()) < SKYMAP_MIN_CHANGE &&
+            std::abs(currentCoords.dec().Degrees() - skyMapCoords.dec().Degrees()) < SKYMAP_MIN_CHANGE)
+        return;
+
+    skyMapCoords = currentCoords;
+    KStars::Instance()->map()->update();
+    skyMapUpdateTimer.start();
+}
+
 void Mount::processSwitch(INDI::Property prop)
 {
     bool manualMotionChanged = false;
@@ -555,6 +582,8 @@ bool Mount::doPulse(GuideDirection ra_dir, int ra_msecs, GuideDirection dec_dir,
 
 bool Mount::doPulse(GuideDirection dir, int msecs)
 {
+    KSTARS_TRACE_SPAN("guide", "Pulse emit");
+
     auto raPulse  = getNumber("TELESCOPE_TIMED_GUIDE_WE");
     auto decPulse = getNumber("TELESCOPE_TIMED_GUIDE_NS");
     INDI::PropertyView<INumber> *npulse   = nullptr;
@@ -1547,6 +1576,7 @@ bool Mount::setReversedEnabled(INDI_EQ_AXIS axis, bool enabled)
 void Mount::stopTimers()
 {
     updateCoordinatesTimer.stop();
+    skyMapUpdateTimer.stop();
     centerLockTimer.stop();
 }
 
@@ -301,12 +301,26 @@ class Mount : public ConcreteDevice
         void axisReversed(INDI_EQ_AXIS axis, bool reversed);
 
     private:
+        /**
+         * @brief updateSkyMap repaint the telescope symbols of the sky map for the current position, at most every
+         * SKYMAP_UPDATE_INTERVAL milliseconds and only if the position moved.
+         */
+        void updateSkyMap();
+        void repaintSkyMap();
+
+        // Interval in milliseconds and position change in degrees of the repaints of the sky map
+        static constexpr int SKYMAP_UPDATE_INTERVAL = 200;
+        static constexpr double SKYMAP_MIN_CHANGE = 1.0 / 3600;
+
         SkyPoint currentCoords;
+        // The position drawn last on the sky map
+        SkyPoint skyMapCoords;
         double minAlt {0}, maxAlt = 90;
         ParkStatus m_ParkStatus = PARK_UNKNOWN;
         IPState EqCoordPreviousState {IPS_IDLE};
         QTimer centerLockTimer;
         QTimer updateCoordinatesTimer;
+        QTimer skyMapUpdateTimer;
         SkyObject *currentObject = nullptr;
         bool inManualMotion      = false;
         bool inCustomParking     = false;
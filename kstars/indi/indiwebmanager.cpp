@@ -16,9 +16,9 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QNetworkReply>
-#include <QtConcurrent>
 
 #include "ekos_debug.h"
+#include "auxiliary/executors.h"
 
 namespace INDI
 {
@@ -392,37 +392,37 @@ namespace AsyncWebManager
 
 QFuture<bool> isOnline(const QSharedPointer<ProfileInfo> &pi)
 {
-    return QtConcurrent::run(WebManager::isOnline, pi);
+    return Executors::run(Executors::Interactive, WebManager::isOnline, pi);
 }
 
 QFuture<bool> isStellarMate(const QSharedPointer<ProfileInfo> &pi)
 {
-    return QtConcurrent::run(WebManager::checkVersion, pi);
+    return Executors::run(Executors::Interactive, WebManager::checkVersion, pi);
 }
 
 QFuture<bool> syncCustomDrivers(const QSharedPointer<ProfileInfo> &pi)
 {
-    return QtConcurrent::run(WebManager::syncCustomDrivers, pi);
+    return Executors::run(Executors::Interactive, WebManager::syncCustomDrivers, pi);
 }
 
 QFuture<bool> areDriversRunning(const QSharedPointer<ProfileInfo> &pi)
 {
-    return QtConcurrent::run(WebManager::areDriversRunning, pi);
+    return Executors::run(Executors::Interactive, WebManager::areDriversRunning, pi);
 }
 
 QFuture<bool> syncProfile(const QSharedPointer<ProfileInfo> &pi)
 {
-    return QtConcurrent::run(WebManager::syncProfile, pi);
+    return Executors::run(Executors::Interactive, WebManager::syncProfile, pi);
 }
 
 QFuture<bool> startProfile(const QSharedPointer<ProfileInfo> &pi)
 {
-    return QtConcurrent::run(WebManager::startProfile, pi);
+    return Executors::run(Executors::Interactive, WebManager::startProfile, pi);
 }
 
 QFuture<bool> stopProfile(const QSharedPointer<ProfileInfo> &pi)
 {
-    return QtConcurrent::run(WebManager::stopProfile, pi);
+    return Executors::run(Executors::Interactive, WebManager::stopProfile, pi);
 }
 }
 
@@ -0,0 +1,292 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "serrecorder.h"
+
+#include "kstars_debug.h"
+
+#include <KLocalizedString>
+
+#include <QDateTime>
+#include <QMutexLocker>
+#include <QThread>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+// SER time stamps are counts of 100ns ticks since January 1st of year 1
+qint64 toTicks(qint64 msecsSinceEpoch)
+{
+    return (msecsSinceEpoch + 62135596800000LL) * 10000LL;
+}
+
+template <typename T>
+void putLittleEndian(char *header, uint32_t offset, T value)
+{
+    qToLittleEndian(value, header + offset);
+}
+}
+
+SERRecorder::~SERRecorder()
+{
+    if (isOpen())
+        close();
+}
+
+bool SERRecorder::open(const QString &filename, uint32_t width, uint32_t height, ColorID colorID, uint8_t bitDepth,
+                       const QString &instrument)
+{
+    if (isOpen())
+        close();
+
+    m_Filename = filename;
+    m_LastError.clear();
+    m_Statistics = Statistics();
+    m_FrameSize = width * height * (bitDepth > 8 ? 2 : 1) * (colorID == SER_RGB ? 3 : 1);
+
+    m_DirectIO = false;
+#ifdef Q_OS_LINUX
+    // Bypass the page cache, which would otherwise fill up with frames that are never read again.
+    // Some file systems don't support direct I/O, regular writes are used on these.
+    int fd = ::open(QFile::encodeName(filename).constData(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+    if (fd >= 0)
+    {
+        m_DirectIO = m_File.open(fd, QIODevice::WriteOnly | QIODevice::Unbuffered, QFileDevice::AutoCloseHandle);
+        if (m_DirectIO == false)
+            ::close(fd);
+    }
+#endif
+    if (m_DirectIO == false)
+    {
+        m_File.setFileName(filename);
+        if (m_File.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered) == false)
+        {
+            m_LastError = i18n("Unable to create %1: %2", filename, m_File.errorString());
+            return false;
+        }
+    }
+
+    m_Batch = static_cast<char *>(qMallocAligned(BATCH_SIZE, ALIGNMENT));
+    if (m_Batch == nullptr)
+    {
+        m_File.close();
+        m_LastError = i18n("Not enough memory to record %1.", filename);
+        return false;
+    }
+
+    const QDateTime now = QDateTime::currentDateTime();
+    memset(m_Header, 0, HEADER_SIZE);
+    memcpy(m_Header, "LUCAM-RECORDER", 14);
+    putLittleEndian<qint32>(m_Header, 18, colorID);
+    // Despite its name, readers (and INDI's own recorder) take 0 to mean little endian 16bit samples.
+    putLittleEndian<qint32>(m_Header, 22, QSysInfo::ByteOrder == QSysInfo::LittleEndian ? 0 : 1);
+    putLittleEndian<qint32>(m_Header, 26, width);
+    putLittleEndian<qint32>(m_Header, 30, height);
+    putLittleEndian<qint32>(m_Header, 34, bitDepth);
+    strncpy(m_Header + 82, instrument.toLatin1().constData(), 40);
+    putLittleEndian<qint64>(m_Header, 162, toTicks(now.toMSecsSinceEpoch() + now.offsetFromUtc() * 1000LL));
+    putLittleEndian<qint64>(m_Header, 170, toTicks(now.toMSecsSinceEpoch()));
+
+    // The header starts the first batch, so that all batches but the last are written at aligned offsets.
+    memcpy(m_Batch, m_Header, HEADER_SIZE);
+    m_BatchUsed = HEADER_SIZE;
+    m_Written = 0;
+    m_Preallocated = 0;
+    m_Failed = false;
+    m_TimeStamps.clear();
+    m_Queue.clear();
+    m_QueuedBytes = 0;
+    m_Stopping = false;
+
+    m_Thread = QThread::create([this]()
+    {
+        writeFrames();
+    });
+    m_Thread->start(QThread::HighPriority);
+
+    qCInfo(KSTARS) << "Recording" << width << "x" << height << bitDepth << "bit frames to" << filename
+                   << (m_DirectIO ? "with direct I/O" : "");
+    return true;
+}
+
+bool SERRecorder::addFrame(const char *data, uint32_t size)
+{
+    const qint64 timeStamp = toTicks(QDateTime::currentMSecsSinceEpoch());
+
+    QMutexLocker locker(&m_Mutex);
+    if (size != m_FrameSize || m_Failed || m_QueuedBytes + size > MAX_QUEUED_BYTES)
+    {
+        m_Statistics.droppedFrames++;
+        return false;
+    }
+
+    m_Queue.enqueue({QByteArray(data, size), timeStamp});
+    m_QueuedBytes += size;
+    m_FrameQueued.wakeOne();
+    return true;
+}
+
+SERRecorder::Statistics SERRecorder::close()
+{
+    if (isOpen() == false)
+        return statistics();
+
+    {
+        QMutexLocker locker(&m_Mutex);
+        m_Stopping = true;
+        m_FrameQueued.wakeOne();
+    }
+
+    m_Thread->wait();
+    delete m_Thread;
+    m_Thread = nullptr;
+
+    qFreeAligned(m_Batch);
+    m_Batch = nullptr;
+
+    const Statistics result = statistics();
+    qCInfo(KSTARS) << "Recorded" << result.frames << "frames to" << m_Filename << "," << result.droppedFrames << "dropped.";
+    return result;
+}
+
+QString SERRecorder::lastError() const
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_LastError;
+}
+
+SERRecorder::Statistics SERRecorder::statistics() const
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_Statistics;
+}
+
+void SERRecorder::writeFrames()
+{
+    forever
+    {
+        QueuedFrame frame;
+        {
+            QMutexLocker locker(&m_Mutex);
+            while (m_Queue.isEmpty() && m_Stopping == false)
+                m_FrameQueued.wait(&m_Mutex);
+
+            // Queued frames are written before stopping.
+            if (m_Queue.isEmpty())
+                break;
+
+            frame = m_Queue.dequeue();
+            m_QueuedBytes -= frame.data.size();
+        }
+
+        if (m_Failed)
+            continue;
+
+        append(frame.data.constData(), frame.data.size());
+        m_TimeStamps.append(frame.timeStamp);
+
+        QMutexLocker locker(&m_Mutex);
+        if (m_Failed)
+            m_Statistics.droppedFrames++;
+        else
+        {
+            m_Statistics.frames++;
+            m_Statistics.bytes += frame.data.size();
+        }
+    }
+
+    finish();
+}
+
+void SERRecorder::append(const char *data, uint32_t size)
+{
+    while (size > 0 && m_Failed == false)
+    {
+        const uint32_t chunk = std::min(size, BATCH_SIZE - m_BatchUsed);
+        memcpy(m_Batch + m_BatchUsed, data, chunk);
+        m_BatchUsed += chunk;
+        data += chunk;
+        size -= chunk;
+
+        if (m_BatchUsed == BATCH_SIZE && writeBatch() == false)
+        {
+            QMutexLocker locker(&m_Mutex);
+            m_Failed = true;
+            m_LastError = i18n("Error writing %1: %2", m_Filename, m_File.errorString());
+            qCCritical(KSTARS) << m_LastError;
+        }
+    }
+}
+
+bool SERRecorder::writeBatch()
+{
+#ifdef Q_OS_LINUX
+    // Preallocating keeps the file contiguous and avoids updating its allocation on every batch.
+    // This is only a hint, file systems that don't support it are simply written to.
+    if (m_Written + m_BatchUsed > m_Preallocated)
+    {
+        posix_fallocate(m_File.handle(), m_Preallocated, PREALLOCATION_SIZE);
+        m_Preallocated += PREALLOCATION_SIZE;
+    }
+#endif
+
+    if (m_File.write(m_Batch, m_BatchUsed) != m_BatchUsed)
+        return false;
+
+    m_Written += m_BatchUsed;
+    m_BatchUsed = 0;
+    return true;
+}
+
+bool SERRecorder::finish()
+{
+#ifdef Q_OS_LINUX
+    // The last batch, the trailer and the header are not aligned, write them through the page cache.
+    if (m_DirectIO)
+        fcntl(m_File.handle(), F_SETFL, fcntl(m_File.handle(), F_GETFL) & ~O_DIRECT);
+#endif
+
+    bool rc = m_Failed == false && writeBatch();
+
+    // The trailer holds the UTC time stamp of each frame.
+    if (rc)
+    {
+        for (auto &oneTimeStamp : m_TimeStamps)
+            oneTimeStamp = qToLittleEndian(oneTimeStamp);
+        const qint64 trailerSize = m_TimeStamps.size() * static_cast<qint64>(sizeof(qint64));
+        rc = m_File.write(reinterpret_cast<const char *>(m_TimeStamps.constData()), trailerSize) == trailerSize;
+        if (rc)
+            m_Written += trailerSize;
+    }
+
+    // Frames written before a failure are still readable once the header has their count.
+    quint32 frames = statistics().frames;
+    if (rc == false)
+        frames = std::max<qint64>(0, m_Written - HEADER_SIZE) / m_FrameSize;
+    putLittleEndian<qint32>(m_Header, 38, frames);
+    m_File.resize(rc ? m_Written : HEADER_SIZE + static_cast<qint64>(frames) * m_FrameSize);
+    rc = m_File.seek(0) && m_File.write(m_Header, HEADER_SIZE) == HEADER_SIZE && rc;
+    m_File.close();
+    m_TimeStamps.clear();
+
+    if (rc == false)
+    {
+        QMutexLocker locker(&m_Mutex);
+        if (m_LastError.isEmpty())
+            m_LastError = i18n("Error writing %1: %2", m_Filename, m_File.errorString());
+        qCCritical(KSTARS) << m_LastError;
+    }
+
+    return rc;
+}
@@ -0,0 +1,143 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QMutex>
+#include <QQueue>
+#include <QString>
+#include <QVector>
+#include <QWaitCondition>
+
+#include <cstdint>
+
+class QThread;
+
+/**
+ * @class SERRecorder
+ * @short Records the frames of a video stream to a SER file on this computer.
+ *
+ * Frames are queued by the caller and written by a separate I/O thread. Frames are
+ * gathered in a large aligned buffer and written in batches, bypassing the page cache
+ * where the system supports it, to a file preallocated ahead of the writes. If the disk
+ * cannot keep up, the queue is bounded and the frames that do not fit are dropped
+ * and counted, so that the stream is never slowed down by the recording.
+ */
+class SERRecorder
+{
+    public:
+        /// Color IDs of the SER format
+        typedef enum
+        {
+            SER_MONO = 0,
+            SER_BAYER_RGGB = 8,
+            SER_BAYER_GRBG = 9,
+            SER_BAYER_GBRG = 10,
+            SER_BAYER_BGGR = 11,
+            SER_RGB = 100
+        } ColorID;
+
+        struct Statistics
+        {
+            quint64 frames { 0 };
+            quint64 droppedFrames { 0 };
+            quint64 bytes { 0 };
+        };
+
+        SERRecorder() = default;
+        ~SERRecorder();
+
+        /**
+         * @brief open Create the SER file and start the I/O thread.
+         * @param filename path of the file, overwritten if it exists.
+         * @param width width of the frames in pixels.
+         * @param height height of the frames in pixels.
+         * @param colorID layout of the frames.
+         * @param bitDepth 8 or 16 bits per sample, 16bit samples being in host order.
+         * @param instrument name of the camera, recorded in the header.
+         * @return false if the file could not be created, see lastError().
+         */
+        bool open(const QString &filename, uint32_t width, uint32_t height, ColorID colorID, uint8_t bitDepth,
+                  const QString &instrument);
+
+        /**
+         * @brief addFrame Queue a frame for writing, with the current time as its time stamp.
+         * @return false if the frame was dropped, because its size doesn't match or the queue is full.
+         */
+        bool addFrame(const char *data, uint32_t size);
+
+        /**
+         * @brief close Write the queued frames, complete the file and stop the I/O thread.
+         * @return the statistics of the recording.
+         */
+        Statistics close();
+
+        bool isOpen() const
+        {
+            return m_Thread != nullptr;
+        }
+
+        const QString &filename() const
+        {
+            return m_Filename;
+        }
+
+        /// @return the error that stopped the recording, if any
+        QString lastError() const;
+
+        Statistics statistics() const;
+
+    private:
+        struct QueuedFrame
+        {
+            QByteArray data;
+            // UTC time stamp in SER ticks
+            qint64 timeStamp;
+        };
+
+        void writeFrames();
+        void append(const char *data, uint32_t size);
+        bool writeBatch();
+        bool finish();
+
+        /// Size of the SER header
+        static constexpr uint32_t HEADER_SIZE = 178;
+        /// Frames are written in batches of this size
+        static constexpr uint32_t BATCH_SIZE = 16 * 1024 * 1024;
+        /// Alignment of buffers and writes for direct I/O
+        static constexpr uint32_t ALIGNMENT = 4096;
+        /// The file is preallocated in chunks of this size ahead of the writes
+        static constexpr qint64 PREALLOCATION_SIZE = 1024LL * 1024 * 1024;
+        /// Frames waiting for the disk beyond this size are dropped
+        static constexpr qint64 MAX_QUEUED_BYTES = 512LL * 1024 * 1024;
+
+        QString m_Filename;
+        QFile m_File;
+        bool m_DirectIO { false };
+        QThread *m_Thread { nullptr };
+
+        uint32_t m_FrameSize { 0 };
+        char m_Header[HEADER_SIZE] {};
+
+        // Shared with the I/O thread
+        mutable QMutex m_Mutex;
+        QWaitCondition m_FrameQueued;
+        QQueue<QueuedFrame> m_Queue;
+        qint64 m_QueuedBytes { 0 };
+        bool m_Stopping { false };
+        bool m_Failed { false };
+        QString m_LastError;
+        Statistics m_Statistics;
+
+        // Owned by the I/O thread
+        char *m_Batch { nullptr };
+        uint32_t m_BatchUsed { 0 };
+        qint64 m_Written { 0 };
+        qint64 m_Preallocated { 0 };
+        QVector<qint64> m_TimeStamps;
+};
@@ -12,6 +12,7 @@
 #include "Options.h"
 #include "kstars_debug.h"
 #include "collimationoverlayoptions.h"
+#include "auxiliary/ksnotification.h"
 #include "qobjectdefs.h"
 
 #include <basedevice.h>
@@ -358,7 +359,17 @@ void StreamWG::toggleRecord()
         isRecording = false;
         recordB->setToolTip(i18n("Start recording"));
 
-        m_Camera->stopRecording();
+        if (m_LocalRecording)
+            stopLocalRecording();
+        else
+            m_Camera->stopRecording();
+    }
+    else if (options->recordLocallyC->isChecked())
+    {
+        startLocalRecording();
+        recordB->setIcon(stopIcon);
+        recordB->setToolTip(i18n("Stop recording"));
+        isRecording = true;
     }
     else
     {
@@ -397,6 +408,9 @@ void StreamWG::newFrame(INDI::Property prop)
 {
     auto bp = prop.getBLOB()->at(0);
 
+    if (m_LocalRecording)
+        recordLocalFrame(bp);
+
     bool rc = (m_DebayerActive
                && !strcmp(bp->getFormat(), ".stream")) ? videoFrame->newBayerFrame(bp, m_DebayerParams) : videoFrame->newFrame(bp);
 
@@ -404,6 +418,105 @@ void StreamWG::newFrame(INDI::Property prop)
         qCWarning(KSTARS) << "Failed to load video frame.";
 }
 
+void StreamWG::startLocalRecording()
+{
+    // The recorder is opened with the first frame, whose size and layout are only known then.
+    m_Recorder.reset(new SERRecorder());
+    m_RecordingFrames = 0;
+    m_RecordingTimer.start();
+    m_LocalRecording = true;
+}
+
+void StreamWG::recordLocalFrame(IBLOB *bp)
+{
+    if (m_Recorder->isOpen() == false)
+    {
+        const uint32_t pixels = streamWidth * streamHeight;
+        const uint32_t size = bp->size;
+        QString error;
+
+        if (strcmp(bp->format, ".stream") || pixels == 0 || (size != pixels && size != pixels * 2 && size != pixels * 3))
+            error = i18n("Only raw video streams can be recorded on this computer.");
+        else
+        {
+            SERRecorder::ColorID colorID = SERRecorder::SER_MONO;
+            if (size == pixels * 3)
+                colorID = SERRecorder::SER_RGB;
+            else if (m_DebayerSupported)
+            {
+                switch (m_DebayerParams.filter)
+                {
+                    case DC1394_COLOR_FILTER_GBRG:
+                        colorID = SERRecorder::SER_BAYER_GBRG;
+                        break;
+                    case DC1394_COLOR_FILTER_GRBG:
+                        colorID = SERRecorder::SER_BAYER_GRBG;
+                        break;
+                    case DC1394_COLOR_FILTER_BGGR:
+                        colorID = SERRecorder::SER_BAYER_BGGR;
+                        break;
+                    default:
+                        colorID = SERRecorder::SER_BAYER_RGGB;
+                        break;
+                }
+            }
+
+            // Same patterns as the driver side recording, but _F_ since the filter isn't known here.
+            const QDateTime now = QDateTime::currentDateTime();
+            auto expand = [now](QString name)
+            {
+                return name.replace("_D_", now.toString("yyyy-MM-dd"))
+                       .replace("_H_", now.toString("hh-mm-ss"))
+                       .replace("_T_", now.toString("yyyy-MM-ddThh-mm-ss"))
+                       .replace("_F_", "");
+            };
+
+            const QString directory = expand(options->recordDirectoryEdit->text());
+            QDir().mkpath(directory);
+            const QString filename = QDir(directory).filePath(expand(options->recordFilenameEdit->text()) + ".ser");
+
+            if (m_Recorder->open(filename, streamWidth, streamHeight, colorID, size == pixels * 2 ? 16 : 8,
+                                 m_Camera->getDeviceName()) == false)
+                error = m_Recorder->lastError();
+        }
+
+        if (error.isEmpty() == false)
+        {
+            m_LocalRecording = false;
+            updateRecordStatus(false);
+            KSNotification::error(error);
+            return;
+        }
+    }
+
+    m_Recorder->addFrame(static_cast<const char *>(bp->blob), bp->size);
+    m_RecordingFrames++;
+
+    if ((options->recordDurationR->isChecked() && m_RecordingTimer.elapsed() >= options->durationSpin->value() * 1000) ||
+            (options->recordFramesR->isChecked() && m_RecordingFrames >= static_cast<uint32_t>(options->framesSpin->value())))
+    {
+        stopLocalRecording();
+        updateRecordStatus(false);
+    }
+}
+
+void StreamWG::stopLocalRecording()
+{
+    m_LocalRecording = false;
+    if (m_Recorder->isOpen() == false)
+        return;
+
+    const SERRecorder::Statistics statistics = m_Recorder->close();
+    const QString error = m_Recorder->lastError();
+    if (error.isEmpty() == false)
+        KSNotification::error(error);
+    else
+        KSNotification::event(QLatin1String("RecordingStopped"),
+                              i18n("Recorded %1 frames to %2, %3 dropped.", statistics.frames, m_Recorder->filename(),
+                                   statistics.droppedFrames), KSNotification::INDI,
+                              statistics.droppedFrames > 0 ? KSNotification::Warn : KSNotification::Info);
+}
+
 void StreamWG::resetFrame()
 {
     m_Camera->resetStreamingFrame();
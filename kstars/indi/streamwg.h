@@ -10,10 +10,12 @@
 #include "ui_streamform.h"
 #include "ui_recordingoptions.h"
 #include "fitsviewer/bayer.h"
+#include "serrecorder.h"
 #include <indidevapi.h>
 
 #include <QCloseEvent>
 #include <QColor>
+#include <QElapsedTimer>
 #include <QIcon>
 #include <QImage>
 #include <QPaintEvent>
@@ -22,6 +24,8 @@
 #include <QVBoxLayout>
 #include <QVector>
 
+#include <memory>
+
 class RecordOptions : public QDialog, public Ui::recordingOptions
 {
         Q_OBJECT
@@ -88,6 +92,11 @@ class StreamWG : public QDialog, public Ui::streamForm
     private:
         bool queryDebayerParameters();
 
+        // Client side recording, when the driver's storage is slow or remote
+        void startLocalRecording();
+        void recordLocalFrame(IBLOB *bp);
+        void stopLocalRecording();
+
         bool processStream;
         int streamWidth, streamHeight;
         bool colorFrame, isRecording;
@@ -107,4 +116,10 @@ class StreamWG : public QDialog, public Ui::streamForm
 
         // Options panels
         RecordOptions *options;
+
+        // Client side recording
+        std::unique_ptr<SERRecorder> m_Recorder;
+        bool m_LocalRecording { false };
+        QElapsedTimer m_RecordingTimer;
+        uint32_t m_RecordingFrames { 0 };
 };
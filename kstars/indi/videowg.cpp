@@ -10,6 +10,7 @@
 #include "kstars_debug.h"
 #include "kstarsdata.h"
 #include "kstars.h"
+#include "auxiliary/executors.h"
 
 #include <QImageReader>
 #include <QMouseEvent>
@@ -19,19 +20,45 @@
 #include <QSqlRecord>
 #include <QtMath>
 
+namespace
+{
+const QVector<QRgb> &grayTable()
+{
+    static const QVector<QRgb> table = []()
+    {
+        QVector<QRgb> gray(256);
+        for (int i = 0; i < 256; i++)
+            gray[i] = qRgb(i, i, i);
+        return gray;
+    }();
+    return table;
+}
+
+// Images use the frame data without copying it, and release it with the image.
+QImage wrapFrameData(QByteArray &&data, int width, int height, int bytesPerLine, QImage::Format format)
+{
+    auto *owner = new QByteArray(std::move(data));
+    return QImage(reinterpret_cast<const uchar *>(owner->constData()), width, height, bytesPerLine, format,
+                  [](void *info)
+    {
+        delete static_cast<QByteArray *>(info);
+    }, owner);
+}
+}
+
 VideoWG::VideoWG(QWidget *parent) : QLabel(parent)
 {
     streamImage.reset(new QImage());
 
-    grayTable.resize(256);
-
-    for (int i = 0; i < 256; i++)
-        grayTable[i] = qRgb(i, i, i);
+    connect(&m_Decoder, &QFutureWatcher<DecodedFrame>::finished, this, &VideoWG::displayFrame);
 }
 
 bool VideoWG::newBayerFrame(IBLOB *bp, const BayerParams &params)
 {
-    return debayer(bp, params);
+    if (static_cast<uint32_t>(bp->size) < totalBaseCount)
+        return false;
+
+    return queueFrame(bp, false, true, params);
 }
 
 bool VideoWG::newFrame(IBLOB *bp)
@@ -39,7 +66,6 @@ bool VideoWG::newFrame(IBLOB *bp)
     if (bp->size <= 0)
         return false;
 
-    bool rc = false;
     QString format(bp->format);
     if (m_RawFormat != format)
     {
@@ -49,32 +75,123 @@ bool VideoWG::newFrame(IBLOB *bp)
         m_RawFormat = format;
     }
 
-    if (m_RawFormatSupported)
-        rc = streamImage->loadFromData(static_cast<uchar *>(bp->blob), bp->size);
-    else if (static_cast<uint32_t>(bp->size) == totalBaseCount)
+    if (m_RawFormatSupported == false
+            && static_cast<uint32_t>(bp->size) != totalBaseCount
+            && static_cast<uint32_t>(bp->size) != totalBaseCount * 3)
+        return false;
+
+    return queueFrame(bp, m_RawFormatSupported, false, BayerParams());
+}
+
+bool VideoWG::queueFrame(IBLOB *bp, bool compressed, bool bayer, const BayerParams &params)
+{
+    if (m_HasPendingFrame)
+    {
+        m_DroppedFrames++;
+        if (m_DroppedFrames % 100 == 0)
+            qCDebug(KSTARS) << "Dropped" << m_DroppedFrames << "video frames while decoding.";
+    }
+
+    // The BLOB is reused by the INDI client for the next frame, keep a copy until it is decoded.
+    m_PendingFrame.data = QByteArray(static_cast<const char *>(bp->blob), bp->size);
+    m_PendingFrame.compressed = compressed;
+    m_PendingFrame.bayer = bayer;
+    m_PendingFrame.params = params;
+    m_PendingFrame.width = streamW;
+    m_PendingFrame.height = streamH;
+    m_HasPendingFrame = true;
+
+    if (m_Decoder.isRunning() == false)
+        decodeNextFrame();
+
+    return true;
+}
+
+void VideoWG::decodeNextFrame()
+{
+    if (m_HasPendingFrame == false)
+        return;
+
+    m_HasPendingFrame = false;
+    m_Decoder.setFuture(Executors::run(Executors::Interactive, &VideoWG::decodeFrame, std::move(m_PendingFrame), size()));
+    m_PendingFrame = Frame();
+}
+
+VideoWG::DecodedFrame VideoWG::decodeFrame(Frame frame, const QSize &size)
+{
+    QImage image;
+
+    if (frame.compressed)
+        image.loadFromData(frame.data);
+    else if (frame.bayer)
+    {
+        uint32_t rgb_size = frame.width * frame.height * 3;
+        auto * destinationBuffer = new uint8_t[rgb_size];
+
+        int ds1394_height = frame.height;
+
+        uint8_t * dc1394_source = reinterpret_cast<uint8_t*>(frame.data.data());
+        if (frame.params.offsetY == 1)
+        {
+            dc1394_source += frame.width;
+            ds1394_height--;
+        }
+        if (frame.params.offsetX == 1)
+        {
+            dc1394_source++;
+        }
+        dc1394error_t error_code = dc1394_bayer_decoding_8bit(dc1394_source, destinationBuffer, frame.width, ds1394_height,
+                                   frame.params.filter, frame.params.method);
+
+        if (error_code != DC1394_SUCCESS)
+        {
+            qCCritical(KSTARS) << "Debayer failed" << error_code;
+            delete[] destinationBuffer;
+        }
+        else
+            image = QImage(destinationBuffer, frame.width, frame.height, frame.width * 3, QImage::Format_RGB888,
+                           [](void *info)
+        {
+            delete[] static_cast<uint8_t *>(info);
+        }, destinationBuffer);
+    }
+    else if (static_cast<uint32_t>(frame.data.size()) == frame.width * frame.height)
     {
-        streamImage.reset(new QImage(static_cast<uchar *>(bp->blob), streamW, streamH, QImage::Format_Indexed8));
-        streamImage->setColorTable(grayTable);
-        rc = !streamImage->isNull();
+        image = wrapFrameData(std::move(frame.data), frame.width, frame.height, frame.width, QImage::Format_Indexed8);
+        image.setColorTable(grayTable());
     }
-    else if (static_cast<uint32_t>(bp->size) == totalBaseCount * 3)
+    else
+        image = wrapFrameData(std::move(frame.data), frame.width, frame.height, frame.width * 3, QImage::Format_RGB888);
+
+    DecodedFrame decoded;
+    if (image.isNull() == false)
     {
-        streamImage.reset(new QImage(static_cast<uchar *>(bp->blob), streamW, streamH, QImage::Format_RGB888));
-        rc = !streamImage->isNull();
+        decoded.scaled = image.scaled(size, Qt::KeepAspectRatio);
+        decoded.image.reset(new QImage(std::move(image)));
     }
+    return decoded;
+}
 
-    if (rc)
+void VideoWG::displayFrame()
+{
+    const DecodedFrame decoded = m_Decoder.result();
+
+    if (decoded.image.isNull())
+        qCWarning(KSTARS) << "Failed to load video frame.";
+    else
     {
-        kPix = QPixmap::fromImage(streamImage->scaled(size(), Qt::KeepAspectRatio));
+        streamImage = decoded.image;
+
+        kPix = QPixmap::fromImage(decoded.scaled);
 
         paintOverlay(kPix);
 
         setPixmap(kPix);
-    }
 
-    emit imageChanged(streamImage);
+        emit imageChanged(streamImage);
+    }
 
-    return rc;
+    decodeNextFrame();
 }
 
 bool VideoWG::save(const QString &filename, const char *format)
@@ -138,57 +255,6 @@ void VideoWG::mouseReleaseEvent(QMouseEvent *event)
     // and QRect::contains().
 }
 
-bool VideoWG::debayer(const IBLOB *bp, const BayerParams &params)
-{
-    uint32_t rgb_size = streamW * streamH * 3;
-    auto * destinationBuffer = new uint8_t[rgb_size];
-
-    if (destinationBuffer == nullptr)
-    {
-        qCCritical(KSTARS) << "Unable to allocate memory for temporary bayer buffer.";
-        return false;
-    }
-
-    int ds1394_height = streamH;
-
-    uint8_t * dc1394_source = reinterpret_cast<uint8_t*>(bp->blob);
-    if (params.offsetY == 1)
-    {
-        dc1394_source += streamW;
-        ds1394_height--;
-    }
-    if (params.offsetX == 1)
-    {
-        dc1394_source++;
-    }
-    dc1394error_t error_code = dc1394_bayer_decoding_8bit(dc1394_source, destinationBuffer, streamW, ds1394_height,
-                               params.filter, params.method);
-
-    if (error_code != DC1394_SUCCESS)
-    {
-        qCCritical(KSTARS) << "Debayer failed" << error_code;
-        delete[] destinationBuffer;
-        return false;
-    }
-
-    streamImage.reset(new QImage(destinationBuffer, streamW, streamH, QImage::Format_RGB888));
-    bool rc = !streamImage->isNull();
-
-    if (rc)
-    {
-        kPix = QPixmap::fromImage(streamImage->scaled(size(), Qt::KeepAspectRatio));
-
-        paintOverlay(kPix);
-
-        setPixmap(kPix);
-    }
-
-    emit imageChanged(streamImage);
-
-    delete[] destinationBuffer;
-    return rc;
-}
-
 void VideoWG::paintOverlay(QPixmap &imagePix)
 {
     if (!overlayEnabled || m_EnabledOverlayElements.count() == 0) return;
@@ -319,6 +385,7 @@ void VideoWG::toggleOverlay()
 
 VideoWG::~VideoWG()
 {
+    m_Decoder.waitForFinished();
     delete m_CollimationOverlayElementsModel;
     delete m_CurrentElement;
     delete typeValues;
@@ -10,6 +10,8 @@
 
 #include <indidevapi.h>
 
+#include <QFutureWatcher>
+#include <QImage>
 #include <QPixmap>
 #include <QVector>
 #include <QColor>
@@ -21,7 +23,6 @@
 #include <memory>
 #include <mutex>
 
-class QImage;
 class QRubberBand;
 class QSqlTableModel;
 
@@ -56,12 +57,31 @@ class VideoWG : public QLabel
         void imageChanged(const QSharedPointer<QImage> &frame);
 
     private:
-        bool debayer(const IBLOB *bp, const BayerParams &params);
+        // A frame copied out of its BLOB, to be decoded in the background
+        struct Frame
+        {
+            QByteArray data;
+            bool compressed { false };
+            bool bayer { false };
+            BayerParams params;
+            uint16_t width { 0 };
+            uint16_t height { 0 };
+        };
+        struct DecodedFrame
+        {
+            QSharedPointer<QImage> image;
+            // Image scaled to the size of the widget
+            QImage scaled;
+        };
+
+        bool queueFrame(IBLOB *bp, bool compressed, bool bayer, const BayerParams &params);
+        void decodeNextFrame();
+        void displayFrame();
+        static DecodedFrame decodeFrame(Frame frame, const QSize &size);
 
         uint16_t streamW { 0 };
         uint16_t streamH { 0 };
         uint32_t totalBaseCount { 0 };
-        QVector<QRgb> grayTable;
         QSharedPointer<QImage> streamImage;
         QPixmap kPix;
         QRubberBand *rubberBand { nullptr };
@@ -81,4 +101,11 @@ class VideoWG : public QLabel
         QPainter *painter = nullptr;
         float scale;
         void PaintOneItem (QString type, QPointF position, int sizeX, int sizeY, int thickness);
+
+        // Frames are decoded one at a time. While one is being decoded, only the latest frame
+        // received is kept, older ones are dropped so the display never lags behind the camera.
+        QFutureWatcher<DecodedFrame> m_Decoder;
+        Frame m_PendingFrame;
+        bool m_HasPendingFrame { false };
+        uint32_t m_DroppedFrames { 0 };
 };
@@ -21,6 +21,10 @@ WSMedia::WSMedia(Camera *manager): m_Manager(manager)
     connect(&m_WebSocket, &QWebSocket::disconnected, this, &WSMedia::onDisconnected);
     connect(&m_WebSocket, static_cast<void(QWebSocket::*)(QAbstractSocket::SocketError)>(&QWebSocket::error), this, &WSMedia::onError);
 
+    // By default the socket reads everything the server sends, however fast, and buffers it until
+    // frames are processed. Bounding the read buffer leaves the rest in the TCP window, which throttles
+    // the driver to the rate frames are processed here and keeps memory use predictable.
+    m_WebSocket.setReadBufferSize(READ_BUFFER_SIZE);
 }
 
 void WSMedia::connectServer()
@@ -59,5 +59,7 @@ class WSMedia : public QObject
         static const uint16_t RECONNECT_INTERVAL = 5000;
         // Retry for 1 hour before giving up
         static const uint16_t RECONNECT_MAX_TRIES = 720;
+        // Data read ahead of the frame being processed
+        static const qint64 READ_BUFFER_SIZE = 8 * 1024 * 1024;
 };
 }
@@ -10,6 +10,40 @@
 #include "ksnumbers.h"
 #include "kstarsdata.h"
 
+#include <QHash>
+#include <QMutex>
+
+#include <cmath>
+
+namespace
+{
+// The almanacs shared by location and day, each one with its copy of the location
+struct SharedAlmanac
+{
+    SharedAlmanac(const GeoLocation &g, const KStarsDateTime &ut) : geo(g), almanac(ut, &geo) {}
+    GeoLocation geo;
+    KSAlmanac almanac;
+};
+constexpr int MAX_SHARED_ALMANACS = 64;
+QMutex sharedAlmanacsMutex;
+QHash<QString, std::shared_ptr<const SharedAlmanac>> sharedAlmanacs;
+
+// The Moon moves by about half a degree per hour, its positions are interpolated linearly between these steps.
+// The table spans the day with an hour of margin on each side.
+constexpr int MOON_TABLE_STEP_SECS = 600;
+constexpr int MOON_TABLE_MARGIN_SECS = 3600;
+constexpr int MOON_TABLE_SIZE = (86400 + 2 * MOON_TABLE_MARGIN_SECS) / MOON_TABLE_STEP_SECS + 1;
+QMutex moonTableMutex;
+
+SkyPoint findMoonPosition(KSMoon &moon, const GeoLocation *geo, const KStarsDateTime &ut)
+{
+    KSNumbers num(ut.djd());
+    CachingDms LST = geo->GSTtoLST(ut.gst());
+    moon.updateCoords(&num, true, geo->lat(), &LST, true);
+    return SkyPoint(dms(moon.ra().Degrees()), dms(moon.dec().Degrees()));
+}
+}
+
 KSAlmanac::KSAlmanac()
 {
     KStarsData *data = KStarsData::Instance();
@@ -39,8 +73,68 @@ KSAlmanac::KSAlmanac(const KStarsDateTime &midnight, const GeoLocation *g)
     update();
 }
 
+std::shared_ptr<const KSAlmanac> KSAlmanac::forDay(const KStarsDateTime &midnight, const GeoLocation *g)
+{
+    const GeoLocation *location = g ? g : KStarsData::Instance()->geo();
+    const KStarsDateTime ut = midnight.isValid() ?
+                              midnight.timeSpec() == Qt::LocalTime ? location->LTtoUT(midnight) : midnight :
+                              KStarsData::Instance()->ut();
+    const QString key = QString("%1 %2 %3").arg(ut.djd(), 0, 'f', 6).arg(location->lat()->Degrees())
+                        .arg(location->lng()->Degrees());
+
+    QMutexLocker locker(&sharedAlmanacsMutex);
+    auto shared = sharedAlmanacs.value(key);
+    if (!shared)
+    {
+        if (sharedAlmanacs.size() >= MAX_SHARED_ALMANACS)
+            sharedAlmanacs.clear();
+        shared = std::make_shared<const SharedAlmanac>(*location, ut);
+        sharedAlmanacs.insert(key, shared);
+    }
+    return std::shared_ptr<const KSAlmanac>(shared, &shared->almanac);
+}
+
+SkyPoint KSAlmanac::moonPosition(const KStarsDateTime &ut) const
+{
+    const double step = (dt.secsTo(ut) + MOON_TABLE_MARGIN_SECS) / static_cast<double>(MOON_TABLE_STEP_SECS);
+    const int index = static_cast<int>(std::floor(step));
+    SkyPoint before, after;
+    {
+        // The Moon keeps its series in data shared by all its instances
+        QMutexLocker locker(&moonTableMutex);
+        if (index < 0 || index + 1 >= MOON_TABLE_SIZE)
+        {
+            KSMoon moon;
+            return findMoonPosition(moon, geo, ut);
+        }
+        if (MoonTable.isEmpty())
+        {
+            KSMoon moon;
+            MoonTable.reserve(MOON_TABLE_SIZE);
+            for (int i = 0; i < MOON_TABLE_SIZE; ++i)
+                MoonTable.append(findMoonPosition(moon, geo, dt.addSecs(i * MOON_TABLE_STEP_SECS - MOON_TABLE_MARGIN_SECS)));
+        }
+        before = MoonTable[index];
+        after = MoonTable[index + 1];
+    }
+
+    const double fraction = step - index;
+    double dRA = after.ra().Degrees() - before.ra().Degrees();
+    if (dRA > 180.0)
+        dRA -= 360.0;
+    else if (dRA < -180.0)
+        dRA += 360.0;
+    return SkyPoint(dms(before.ra().Degrees() + fraction * dRA).reduce(),
+                    dms(before.dec().Degrees() + fraction * (after.dec().Degrees() - before.dec().Degrees())));
+}
+
 void KSAlmanac::update()
 {
+    {
+        QMutexLocker locker(&moonTableMutex);
+        MoonTable.clear();
+    }
+
     RiseSetTime(&m_Sun, &SunRise, &SunSet, &SunRiseT, &SunSetT);
     RiseSetTime(&m_Moon, &MoonRise, &MoonSet, &MoonRiseT, &MoonSetT);
     //    qDebug() << Q_FUNC_INFO << "Sun rise: " << SunRiseT.toString() << " Sun set: " << SunSetT.toString() << " Moon rise: " << MoonRiseT.toString() << " Moon set: " << MoonSetT.toString();
@@ -10,6 +10,10 @@
 #include "skyobjects/ksmoon.h"
 #include "kstarsdatetime.h"
 
+#include <QVector>
+
+#include <memory>
+
 /**
  *@class KSAlmanac
  *
@@ -39,6 +43,15 @@ class KSAlmanac
          */
     KSAlmanac(const KStarsDateTime &midnight, const GeoLocation *geo = nullptr);
 
+    /**
+         *@brief forDay provides the almanac of a day at a geolocation, shared by all its users and computed once per
+         *location and day, as computing one is expensive.
+         *@param midnight is the midnight date and time to consider as beginning of the day at the "geo" location.
+         *@param geo is the GeoLocation to use for this almanac, defaulting to the KStarsData::Instance geolocation.
+         *@note The almanac keeps a copy of geo, and may be used from any thread.
+         */
+    static std::shared_ptr<const KSAlmanac> forDay(const KStarsDateTime &midnight, const GeoLocation *geo = nullptr);
+
     /**
          *@short Get/set the date for computations to the given date.
          *@param utc_midnight and local_midnight are the midnight date and time to consider as beginning of the day at the geo_ location, either UTC or local.
@@ -98,6 +111,13 @@ class KSAlmanac
          */
     double sunZenithAngleToTime(double z) const;
 
+    /**
+         *@short The apparent position of the Moon as seen from the location of the almanac, interpolated from a table
+         *       of positions computed once, when first needed, over the day.
+         *@param ut Universal time. Positions outside of the day are computed directly.
+         */
+    SkyPoint moonPosition(const KStarsDateTime &ut) const;
+
   private:
     void update();
 
@@ -143,4 +163,6 @@ class KSAlmanac
     double SunMaxAlt { 0 };
     double MoonPhase { 0 };
     QTime SunRiseT, SunSetT, MoonRiseT, MoonSetT, DuskAstronomicalTwilightT, DawnAstronomicalTwilightT;
+    // Positions of the Moon over the day, filled by moonPosition()
+    mutable QVector<SkyPoint> MoonTable;
 };
@@ -9,6 +9,43 @@
 
 #include "kstarsdatetime.h" //for J2000 define
 
+#include <QMutex>
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <optional>
+
+namespace
+{
+// The cache is direct mapped, a date only ever goes to one slot
+constexpr int CACHE_SIZE = 128;
+
+struct Cache
+{
+    QMutex mutex;
+    std::array<std::optional<KSNumbers>, CACHE_SIZE> slots;
+};
+
+Cache &cache()
+{
+    static Cache cache;
+    return cache;
+}
+
+std::atomic<double> &resolution()
+{
+    static std::atomic<double> resolution { 0 };
+    return resolution;
+}
+
+int cacheSlot(long double key)
+{
+    return static_cast<int>(std::hash<double> {}(static_cast<double>(key)) % CACHE_SIZE);
+}
+}
+
 // 63 elements
 const int KSNumbers::arguments[NUTTERMS][5] = {
     { 0, 0, 0, 0, 1 },   { -2, 0, 0, 2, 2 },  { 0, 0, 0, 2, 2 },   { 0, 0, 0, 0, 2 },  { 0, 1, 0, 0, 0 },
@@ -91,6 +128,99 @@ const int KSNumbers::amp[NUTTERMS][4] = { { -171996, -1742, 92025, 89 },
                                           { -3, 0, 0, 0 } };
 
 KSNumbers::KSNumbers(long double jd)
+{
+    const long double key = cacheKey(jd);
+    if (fromCache(key, *this))
+        return;
+
+    computeConstantValues();
+    computeValues(key);
+    toCache(*this);
+}
+
+std::vector<KSNumbers> KSNumbers::forJulianDays(const std::vector<long double> &jds)
+{
+    std::vector<KSNumbers> numbers;
+    std::vector<int> missing;
+    numbers.reserve(jds.size());
+    for (long double jd : jds)
+    {
+        const long double key = cacheKey(jd);
+        KSNumbers n;
+        if (!fromCache(key, n))
+        {
+            n.computeConstantValues();
+            n.computeValues(key, false);
+            missing.push_back(static_cast<int>(numbers.size()));
+        }
+        numbers.push_back(n);
+    }
+
+    if (missing.empty())
+        return numbers;
+
+    const int count = static_cast<int>(missing.size());
+    Eigen::ArrayXd T(count), D(count), M(count), MM(count), F(count), O(count);
+    for (int i = 0; i < count; i++)
+    {
+        const KSNumbers &n = numbers[missing[i]];
+        T[i]  = n.T;
+        D[i]  = n.D.Degrees();
+        M[i]  = n.M.Degrees();
+        MM[i] = n.MM.Degrees();
+        F[i]  = n.F.Degrees();
+        O[i]  = n.O.Degrees();
+    }
+
+    Eigen::ArrayXd dEcLong, dObliq;
+    nutationSeries(T, D, M, MM, F, O, dEcLong, dObliq);
+
+    for (int i = 0; i < count; i++)
+    {
+        KSNumbers &n      = numbers[missing[i]];
+        n.deltaEcLong     = dEcLong[i];
+        n.deltaObliquity  = dObliq[i];
+        toCache(n);
+    }
+    return numbers;
+}
+
+void KSNumbers::setCacheResolution(double days)
+{
+    resolution() = days;
+}
+
+double KSNumbers::cacheResolution()
+{
+    return resolution();
+}
+
+long double KSNumbers::cacheKey(long double jd)
+{
+    const double days = resolution();
+    return days > 0 ? std::round(jd / days) * days : jd;
+}
+
+bool KSNumbers::fromCache(long double key, KSNumbers &numbers)
+{
+    Cache &c = cache();
+    QMutexLocker locker(&c.mutex);
+    const std::optional<KSNumbers> &slot = c.slots[cacheSlot(key)];
+    if (!slot || slot->days != key)
+        return false;
+
+    numbers = *slot;
+    return true;
+}
+
+void KSNumbers::toCache(const KSNumbers &numbers)
+{
+    Cache &c = cache();
+    QMutexLocker locker(&c.mutex);
+    c.slots[cacheSlot(numbers.days)] = numbers;
+}
+
+void KSNumbers::computeConstantValues()
 {
     K.setD(20.49552 / 3600.); //set the constant of aberration
 
@@ -104,12 +234,6 @@ KSNumbers::KSNumbers(long double jd)
     // deltaEcLong is used in nutation calculations. Can P be obtained computationally?
     //P.setD(104.8089842092676);
 
-    computeConstantValues();
-    updateValues(jd);
-}
-
-void KSNumbers::computeConstantValues()
-{
     // Compute those numbers that need to be computed only
     // once.
     //
@@ -153,6 +277,38 @@ void KSNumbers::computeConstantValues()
 }
 
 void KSNumbers::updateValues(long double jd)
+{
+    const long double key = cacheKey(jd);
+    if (fromCache(key, *this))
+        return;
+
+    computeValues(key);
+    toCache(*this);
+}
+
+void KSNumbers::nutationSeries(const Eigen::ArrayXd &T, const Eigen::ArrayXd &D, const Eigen::ArrayXd &M,
+                               const Eigen::ArrayXd &MM, const Eigen::ArrayXd &F, const Eigen::ArrayXd &O,
+                               Eigen::ArrayXd &dEcLong, Eigen::ArrayXd &dObliq)
+{
+    dEcLong = Eigen::ArrayXd::Zero(T.size());
+    dObliq  = Eigen::ArrayXd::Zero(T.size());
+
+    Eigen::ArrayXd arg(T.size());
+    for (unsigned int i = 0; i < NUTTERMS; i++)
+    {
+        const int *a = arguments[i];
+        arg = (double(a[0]) * D + double(a[1]) * M + double(a[2]) * MM + double(a[3]) * F + double(a[4]) * O) *
+              dms::DegToRad;
+
+        dEcLong += (double(amp[i][0]) + amp[i][1] / 10. * T) * arg.sin() * 1e-4;
+        dObliq += (double(amp[i][2]) + amp[i][3] / 10. * T) * arg.cos() * 1e-4;
+    }
+
+    dEcLong /= 3600.0;
+    dObliq /= 3600.0;
+}
+
+void KSNumbers::computeValues(long double jd, bool nutation)
 {
     dms arg;
     double args, argc;
@@ -232,7 +388,8 @@ void KSNumbers::updateValues(long double jd)
     deltaEcLong    = 0.;
     deltaObliquity = 0.;
 
-    for (unsigned int i = 0; i < NUTTERMS; i++)
+    // forJulianDays() sums the series for all its dates at once
+    for (unsigned int i = 0; nutation && i < NUTTERMS; i++)
     {
         arg.setD(arguments[i][0] * D.Degrees() + arguments[i][1] * M.Degrees() + arguments[i][2] * MM.Degrees() +
                  arguments[i][3] * F.Degrees() + arguments[i][4] * O.Degrees());
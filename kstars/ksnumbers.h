@@ -21,6 +21,8 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <vector>
+
 #define NUTTERMS 63
 
 /** @class KSNumbers
@@ -34,6 +36,11 @@
 	*constant of aberration, the obliquity of the Ecliptic, the effects of
 	*Nutation (delta Obliquity and delta Ecliptic longitude),
 	*the Julian Day/Century/Millenium, and arrays for computing the precession.
+	*
+	*The values are kept in a small cache shared by all instances, so that
+	*constructing a KSNumbers for a date that was recently computed is a copy.
+	*Many tools construct one for every time sample, and the same epochs come
+	*back for every point that is precessed.
 	*@short Store several time-dependent astronomical quantities.
 	*@author Jason Harris
 	*@version 1.0
@@ -49,6 +56,25 @@ class KSNumbers
     explicit KSNumbers(long double jd);
     ~KSNumbers() = default;
 
+    /**
+     * @return the numbers for each of @p jds, as constructing a KSNumbers for each would.
+     * The nutation series of the dates missing from the cache is evaluated for all of them
+     * at once, term by term, so that its trigonometry runs over arrays of dates.
+     */
+    static std::vector<KSNumbers> forJulianDays(const std::vector<long double> &jds);
+
+    /**
+     * @short Round the Julian Days of new instances to multiples of @p days.
+     * With the default of 0 the values are exact and only the same Julian Day hits the
+     * cache. With a resolution, all the values, julianDay() included, are those of the
+     * nearest multiple, and nearby dates share an entry. A few seconds are below the
+     * precision of the positions KStars computes.
+     */
+    static void setCacheResolution(double days);
+
+    /** @return the resolution in days set by setCacheResolution() */
+    static double cacheResolution();
+
     /**
      * @return the current Obliquity (the angle of inclination between
      * the celestial equator and the ecliptic)
@@ -130,6 +156,30 @@ class KSNumbers
     inline double vEarth(int i) const { return vearth[i]; }
 
   private:
+    /** Constructor without any values, for forJulianDays() */
+    KSNumbers() = default;
+
+    /**
+     * @short Compute the values for @p jd, with the nutation unless @p nutation is false.
+     */
+    void computeValues(long double jd, bool nutation = true);
+
+    /**
+     * @short Sum the nutation series for arrays of dates.
+     * The arguments are in degrees, the results are the corrections in degrees.
+     */
+    static void nutationSeries(const Eigen::ArrayXd &T, const Eigen::ArrayXd &D, const Eigen::ArrayXd &M,
+                               const Eigen::ArrayXd &MM, const Eigen::ArrayXd &F, const Eigen::ArrayXd &O,
+                               Eigen::ArrayXd &dEcLong, Eigen::ArrayXd &dObliq);
+
+    /** @return the cache key of @p jd, rounded to the resolution */
+    static long double cacheKey(long double jd);
+
+    /** @short Copy the cached values for @p key into @p numbers, if there are any */
+    static bool fromCache(long double key, KSNumbers &numbers);
+
+    static void toCache(const KSNumbers &numbers);
+
     CachingDms Obliquity, L0, P;
     dms K, L, LM, M, M0, O, D, MM, F;
     dms XP, YP, ZP, XB, YB, ZB;
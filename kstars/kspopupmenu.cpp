@@ -573,10 +573,8 @@ void KSPopupMenu::addLinksToMenu(SkyObject *obj, bool showDSS)
         auto *object = dynamic_cast<CatalogObject *>(obj);
         if (object)
         {
-            CatalogsDB::DBManager manager{ CatalogsDB::dso_db_path() };
-
             if (object->getCatalog().mut &&
-                    manager.get_object(object->getObjectId()).first)
+                    CatalogsDB::thread_reader().get_object(object->getObjectId()).first)
             {
                 addAction(i18n("Remove From Local Catalog"), ks->map(),
                           SLOT(slotRemoveCustomObject()));
@@ -19,6 +19,8 @@
 #include "skymap.h"
 #include "skyqpainter.h"
 #include "texturemanager.h"
+#include "auxiliary/executors.h"
+#include "auxiliary/tracer.h"
 #include "dialogs/finddialog.h"
 #include "dialogs/exportimagedialog.h"
 #include "skycomponents/starblockfactory.h"
@@ -31,6 +33,7 @@
 
 #ifdef HAVE_CFITSIO
 #include "fitsviewer/fitsviewer.h"
+#include "fitsviewer/imagememory.h"
 #endif
 
 #include <KActionCollection>
@@ -39,6 +42,7 @@
 #ifdef Q_OS_WIN
 #include <QProcess>
 #endif
+#include <QElapsedTimer>
 #include <QStatusBar>
 #include <QMenu>
 
@@ -62,6 +66,7 @@ KStars::KStars(bool doSplash, bool clockrun, const QString &startdate)
 
     // Set thread stack size to 32MB
     QThreadPool::globalInstance()->setStackSize(33554432);
+    Executors::configure();
 
     // Initialize logging settings
     if (Options::disableLogging())
@@ -73,6 +78,11 @@ KStars::KStars(bool doSplash, bool clockrun, const QString &startdate)
 
     KSUtils::Logging::SyncFilterRules();
 
+    Tracer::setEnabled(Options::enableTracing());
+#ifdef HAVE_CFITSIO
+    ImageMemory::instance().setBudget(static_cast<uint64_t>(Options::imageMemoryBudget()) * 1024 * 1024);
+#endif
+
     qCInfo(KSTARS) << "Welcome to KStars" << KSTARS_VERSION << KSTARS_BUILD_RELEASE;
     qCInfo(KSTARS) << "Build:" << KSTARS_BUILD_TS;
     qCInfo(KSTARS) << "OS:" << QSysInfo::productType();
@@ -591,7 +601,15 @@ void KStars::updateTime(const bool automaticDSTchange)
     KStarsData *Data = data();
     // dms oldLST( Data->lst()->Degrees() );
 
+    // This update also covers the pending tick, if any
+    m_TimeUpdatePending = false;
+
+    // The sky map repaint is part of the update, the clock adapts its tick rate to the cost
+    QElapsedTimer updateTimer;
+    updateTimer.start();
     Data->updateTime(Data->geo(), automaticDSTchange);
+    const qint64 updateCost = updateTimer.elapsed();
+    Data->clock()->setUpdateCost(updateCost);
 
     //We do this outside of kstarsdata just to get the coordinates
     //displayed in the infobox to update every second.
@@ -615,10 +633,25 @@ void KStars::updateTime(const bool automaticDSTchange)
         // of real time. However, the sky map update, depending on calculations and
         // drawing of objects, takes variable time to complete.
         //QTimer::singleShot(0, Data->clock(), SLOT(manualTick()));
-        QTimer::singleShot(1000, Data->clock(), SLOT(manualTick()));
+        // Count the update in the second, so that steps stay one second apart when it is slow.
+        QTimer::singleShot(static_cast<int>(qMax<qint64>(0, 1000 - updateCost)), Data->clock(), SLOT(manualTick()));
     }
 }
 
+void KStars::scheduleTimeUpdate()
+{
+    if (m_TimeUpdatePending)
+        return;
+
+    m_TimeUpdatePending = true;
+    QTimer::singleShot(0, this, [this]()
+    {
+        // An update may have run since, for instance after a time change
+        if (m_TimeUpdatePending)
+            updateTime();
+    });
+}
+
 #ifdef HAVE_CFITSIO
 const QSharedPointer<FITSViewer> &KStars::createFITSViewer()
 {
@@ -480,6 +480,27 @@ class KStars : public KXmlGuiWindow
              */
         Q_SCRIPTABLE QString getSkyMapDimensions();
 
+        /** DBUS interface function.  Get the time spent drawing each component of the Sky Map in the last frames.
+             * @param format either "csv" for comma separated values, one line per component of each frame,
+             * or "json" for an array of frames.
+             * @return the rolling trace of the last few hundred frames, or an empty string for an unknown format.
+             */
+        Q_SCRIPTABLE QString getDrawProfile(const QString &format);
+
+        /** DBUS interface function.  Get the wall time and memory of each phase of the startup.
+             * @param format "text" for an indented report, "csv" for comma separated values, one line per phase,
+             * or "json" for an array of phases.
+             * @return the phases recorded so far, the last one being the whole startup once it is complete,
+             * or an empty string for an unknown format.
+             */
+        Q_SCRIPTABLE QString getStartupProfile(const QString &format);
+
+        /** DBUS interface function.  Get the statistics of the cache of deep star blocks.
+             * @return a JSON object with the memory budget and usage in bytes, the number of blocks,
+             * the hit, miss, allocation and eviction counters, and the blocks held by each catalog.
+             */
+        Q_SCRIPTABLE QString getStarCacheStatistics();
+
         /** DBUS interface function.  Return a newline-separated list of objects in the observing wishlist.
              * @note Unfortunately, unnamed objects are troublesome. Hopefully, we don't have them on the observing list.
              */
@@ -836,6 +857,12 @@ class KStars : public KXmlGuiWindow
         /** Build the KStars main window */
         void buildGUI();
 
+        /**
+         * Run updateTime() once the pending events are processed. Ticks that arrive while an
+         * update is pending are merged into it, the clock is read when the update runs.
+         */
+        void scheduleTimeUpdate();
+
         void closeEvent(QCloseEvent *event) override;
 
     public:
@@ -926,6 +953,7 @@ class KStars : public KXmlGuiWindow
 
         bool DialogIsObsolete { false };
         bool StartClockRunning { false };
+        bool m_TimeUpdatePending { false };
         QString StartDateString;
         QLabel AltAzField, RADecField, J2000RADecField;
         //QPalette OriginalPalette, DarkPalette;
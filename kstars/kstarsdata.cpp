@@ -9,8 +9,10 @@
 #include "ksutils.h"
 #include "Options.h"
 #include "auxiliary/kspaths.h"
+#include "auxiliary/startupprofiler.h"
 #include "skycomponents/supernovaecomponent.h"
 #include "skycomponents/skymapcomposite.h"
+#include "skycomponents/solarsystemcomposite.h"
 #include "ksnotification.h"
 #include "skyobjectuserdata.h"
 #include <kio/job_base.h>
@@ -31,9 +33,9 @@
 
 #include <QSqlQuery>
 #include <QSqlRecord>
-#include <QtConcurrent>
 
 #include "kstars_debug.h"
+#include "auxiliary/executors.h"
 
 // Qt version calming
 #include <qtskipemptyparts.h>
@@ -130,6 +132,9 @@ KStarsData::~KStarsData()
 
 bool KStarsData::initialize()
 {
+    StartupProfiler &profiler = StartupProfiler::instance();
+    StartupProfiler::Phase phase("KStarsData::initialize");
+
     //Load Time Zone Rules//
     emit progressText(i18n("Reading time zone rules"));
     if (!readTimeZoneRulebook())
@@ -137,86 +142,31 @@ bool KStarsData::initialize()
         fatalErrorMessage("TZrules.dat");
         return false;
     }
-
-    emit progressText(
-        i18n("Upgrade existing user city db to support geographic elevation."));
-
-    QString dbfile = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("mycitydb.sqlite");
-
-    /// This code to add Height column to table city in mycitydb.sqlite is a transitional measure to support a meaningful
-    /// geographic elevation.
-    if (QFile::exists(dbfile))
-    {
-        QSqlDatabase fixcitydb = QSqlDatabase::addDatabase("QSQLITE", "fixcitydb");
-
-        fixcitydb.setDatabaseName(dbfile);
-        fixcitydb.open();
-
-        if (fixcitydb.tables().contains("city", Qt::CaseInsensitive))
-        {
-            QSqlRecord r = fixcitydb.record("city");
-            if (!r.contains("Elevation"))
-            {
-                emit progressText(i18n("Adding \"Elevation\" column to city table."));
-
-                QSqlQuery query(fixcitydb);
-                if (query.exec(
-                        "alter table city add column Elevation real default -10;") ==
-                    false)
-                {
-                    emit progressText(QString("failed to add Elevation column to city "
-                                              "table in mycitydb.sqlite: &1")
-                                          .arg(query.lastError().text()));
-                }
-            }
-            else
-            {
-                emit progressText(i18n("City table already contains \"Elevation\"."));
-            }
-        }
-        else
-        {
-            emit progressText(i18n("City table missing from database."));
-        }
-        fixcitydb.close();
-    }
+    profiler.mark("Time zone rules");
 
     //Load Cities//
+    // The cities only depend on the time zone rules, read them in the background while the sky objects load.
+    // Database connections belong to the thread that added them, so they are removed before returning.
     emit progressText(i18n("Loading city data"));
-    if (!readCityData())
+    QFuture<bool> cities = Executors::run(Executors::Interactive, [this]()
     {
-        fatalErrorMessage("citydb.sqlite");
-        return false;
-    }
+        upgradeCityDatabase();
+        const bool citiesFound = readCityData();
+        m_CityIndex.build(geoList);
+        QSqlDatabase::removeDatabase("fixcitydb");
+        QSqlDatabase::removeDatabase("citydb");
+        QSqlDatabase::removeDatabase("mycitydb");
+        return citiesFound;
+    });
 
     //Initialize User Database//
     emit progressText(i18n("Loading User Information"));
     m_ksuserdb.Initialize();
+    profiler.mark("User database");
 
     //Initialize SkyMapComposite//
     emit progressText(i18n("Loading sky objects"));
     m_SkyComposite.reset(new SkyMapComposite());
-    //Load Image URLs//
-    //#ifndef Q_OS_ANDROID
-    //On Android these 2 calls produce segfault. WARNING
-    emit progressText(i18n("Loading Image URLs"));
-
-    // if (!readURLData("image_url.dat", SkyObjectUserdata::Type::image) &&
-    //     !nonFatalErrorMessage("image_url.dat"))
-    //     return false;
-    QtConcurrent::run(this, &KStarsData::readURLData, QString("image_url.dat"),
-                      SkyObjectUserdata::Type::image);
-
-    //Load Information URLs//
-    //emit progressText(i18n("Loading Information URLs"));
-    // if (!readURLData("info_url.dat", SkyObjectUserdata::Type::website) &&
-    //     !nonFatalErrorMessage("info_url.dat"))
-    //     return false;
-    QtConcurrent::run(this, &KStarsData::readURLData, QString("info_url.dat"),
-                      SkyObjectUserdata::Type::website);
-
-    //#endif
-    //emit progressText( i18n("Loading Variable Stars" ) );
 
 #ifndef KSTARS_LITE
     //Initialize Observing List
@@ -224,15 +174,64 @@ bool KStarsData::initialize()
 #endif
 
     readUserLog();
+    profiler.mark("Observing list and user log");
+
+    if (!cities.result())
+    {
+        fatalErrorMessage("citydb.sqlite");
+        return false;
+    }
+    // Only the part of the city loading not hidden behind the sky objects
+    profiler.mark("City data");
+
+    // The location dialog writes user cities through this connection
+    QSqlDatabase mycitydb = QSqlDatabase::addDatabase("QSQLITE", "mycitydb");
+    QString dbfile = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("mycitydb.sqlite");
+    if (QFile::exists(dbfile))
+        mycitydb.setDatabaseName(dbfile);
+
+    return true;
+}
+
+void KStarsData::loadDeferredData()
+{
+    StartupProfiler::Phase phase("KStarsData::loadDeferredData");
+
+#ifndef KSTARS_LITE
+    // The sky map may be drawing the solar system in the background
+    if (SkyMap::Instance())
+        SkyMap::Instance()->waitForFrame();
+#endif
+
+    m_SkyComposite->solarSystemComposite()->loadMinorBodies();
+
+    //Load Image URLs//
+    //#ifndef Q_OS_ANDROID
+    //On Android these 2 calls produce segfault. WARNING
+    Executors::run(Executors::Background, &KStarsData::readURLData, this, QString("image_url.dat"),
+                   SkyObjectUserdata::Type::image);
+
+    //Load Information URLs//
+    Executors::run(Executors::Background, &KStarsData::readURLData, this, QString("info_url.dat"),
+                   SkyObjectUserdata::Type::website);
+    //#endif
 
 #ifndef KSTARS_LITE
     readADVTreeData();
 #endif
-    return true;
+
+    // Compute the positions of the bodies just loaded
+    setFullTimeUpdate();
 }
 
 void KStarsData::updateTime(GeoLocation *geo, const bool automaticDSTchange)
 {
+#ifndef KSTARS_LITE
+    // The sky map may be drawing from this data in the background
+    if (SkyMap::Instance())
+        SkyMap::Instance()->waitForFrame();
+#endif
+
     // sync LTime with the simulation clock
     LTime = geo->UTtoLT(ut());
     syncLST();
@@ -258,13 +257,17 @@ void KStarsData::updateTime(GeoLocation *geo, const bool automaticDSTchange)
     }
 
     KSNumbers num(ut().djd());
+    m_ObservationContext = ObservationContext(num, geo, LST);
 
+    // The components are updated in tiers, by how fast they change
+    bool componentsUpdated = false;
     if (std::abs(ut().djd() - LastNumUpdate.djd()) > 1.0)
     {
         LastNumUpdate = KStarsDateTime(ut().djd());
         m_preUpdateNumID++;
         m_preUpdateNum = KSNumbers(num);
         skyComposite()->update(&num);
+        componentsUpdated = true;
     }
 
     if (std::abs(ut().djd() - LastPlanetUpdate.djd()) > 0.01)
@@ -287,7 +290,9 @@ void KStarsData::updateTime(GeoLocation *geo, const bool automaticDSTchange)
         LastSkyUpdate = ut();
         m_preUpdateID++;
         //omit KSNumbers arg == just update Alt/Az coords // <-- Eh? -- asimha. Looks like this behavior / ideology has changed drastically.
-        skyComposite()->update(&num);
+        // Skip it when the same update just ran for the new day
+        if (!componentsUpdated)
+            skyComposite()->update(&num);
 
         emit skyUpdate(clock()->isManualMode());
     }
@@ -363,34 +368,12 @@ void KStarsData::setTimeDirection(float scale)
 
 GeoLocation *KStarsData::locationNamed(const QString &city, const QString &province, const QString &country)
 {
-    foreach (GeoLocation *loc, geoList)
-    {
-        if (loc->translatedName() == city && (province.isEmpty() || loc->translatedProvince() == province) &&
-                (country.isEmpty() || loc->translatedCountry() == country))
-        {
-            return loc;
-        }
-    }
-    return nullptr;
+    return m_CityIndex.named(city, province, country);
 }
 
 GeoLocation *KStarsData::nearestLocation(double longitude, double latitude)
 {
-    GeoLocation *nearest = nullptr;
-    double distance = 1e6;
-
-    dms lng(longitude), lat(latitude);
-    for (auto oneCity : geoList)
-    {
-        double newDistance = oneCity->distanceTo(lng, lat);
-        if (newDistance < distance)
-        {
-            distance = newDistance;
-            nearest = oneCity;
-        }
-    }
-
-    return nearest;
+    return m_CityIndex.nearest(longitude, latitude);
 }
 
 void KStarsData::setLocationFromOptions()
@@ -433,6 +416,52 @@ SkyObject *KStarsData::objectNamed(const QString &name)
     return skyComposite()->findByName(name, true); // objectNamed has to do an exact match
 }
 
+void KStarsData::upgradeCityDatabase()
+{
+    emit progressText(
+        i18n("Upgrade existing user city db to support geographic elevation."));
+
+    QString dbfile = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("mycitydb.sqlite");
+
+    /// This code to add Height column to table city in mycitydb.sqlite is a transitional measure to support a meaningful
+    /// geographic elevation.
+    if (QFile::exists(dbfile))
+    {
+        QSqlDatabase fixcitydb = QSqlDatabase::addDatabase("QSQLITE", "fixcitydb");
+
+        fixcitydb.setDatabaseName(dbfile);
+        fixcitydb.open();
+
+        if (fixcitydb.tables().contains("city", Qt::CaseInsensitive))
+        {
+            QSqlRecord r = fixcitydb.record("city");
+            if (!r.contains("Elevation"))
+            {
+                emit progressText(i18n("Adding \"Elevation\" column to city table."));
+
+                QSqlQuery query(fixcitydb);
+                if (query.exec(
+                        "alter table city add column Elevation real default -10;") ==
+                    false)
+                {
+                    emit progressText(QString("failed to add Elevation column to city "
+                                              "table in mycitydb.sqlite: &1")
+                                          .arg(query.lastError().text()));
+                }
+            }
+            else
+            {
+                emit progressText(i18n("City table already contains \"Elevation\"."));
+            }
+        }
+        else
+        {
+            emit progressText(i18n("City table missing from database."));
+        }
+        fixcitydb.close();
+    }
+}
+
 bool KStarsData::readCityData()
 {
     QSqlDatabase citydb = QSqlDatabase::addDatabase("QSQLITE", "citydb");
@@ -911,9 +940,6 @@ bool KStarsData::readADVTreeData()
 //directly.
 bool KStarsData::executeScript(const QString &scriptname, SkyMap *map)
 {
-#ifndef KSTARS_LITE
-    int cmdCount(0);
-
     QFile f(scriptname);
     if (!f.open(QIODevice::ReadOnly))
     {
@@ -922,6 +948,14 @@ bool KStarsData::executeScript(const QString &scriptname, SkyMap *map)
     }
 
     QTextStream istream(&f);
+    return executeScript(istream, map);
+}
+
+bool KStarsData::executeScript(QTextStream &istream, SkyMap *map)
+{
+#ifndef KSTARS_LITE
+    int cmdCount(0);
+
     while (!istream.atEnd())
     {
         QString line = istream.readLine();
@@ -1150,10 +1184,19 @@ bool KStarsData::executeScript(const QString &scriptname, SkyMap *map)
                                .toString();
                 }
             }
-            else if (fn[0] == "changeViewOption" && fn.size() == 3)
+            else if (fn[0] == "changeViewOption" && fn.size() >= 3)
             {
+                const int previousCount = cmdCount;
                 bool bOk(false), dOk(false);
 
+                // Values with spaces, such as HiPS source titles, were split with the line
+                while (fn.size() > 3)
+                    fn[2] += ' ' + fn.takeAt(3);
+
+                // The Script Builder quotes string arguments
+                fn[1].remove('\"');
+                fn[2].remove('\"');
+
                 //parse bool value
                 bool bVal(false);
                 if (fn[2].toLower() == "true")
@@ -1443,6 +1486,23 @@ bool KStarsData::executeScript(const QString &scriptname, SkyMap *map)
                     Options::setUseAbbrevConstellNames(true);
                     cmdCount++;
                 }
+
+                // Any other option, such as ShowHIPS or Projection, is set through the config skeleton
+                if (cmdCount == previousCount)
+                {
+                    KConfigSkeletonItem *item = Options::self()->findItem(fn[1]);
+                    if (item)
+                    {
+                        QVariant value(fn[2]);
+                        if (value.convert(item->property().userType()))
+                        {
+                            item->setProperty(value);
+                            cmdCount++;
+                        }
+                    }
+                    else
+                        qWarning() << "Unknown view option: " << fn[1];
+                }
             }
             else if (fn[0] == "setGeoLocation" && (fn.size() == 3 || fn.size() == 4))
             {
@@ -1454,21 +1514,13 @@ bool KStarsData::executeScript(const QString &scriptname, SkyMap *map)
                     country  = fn[3];
                 }
 
-                bool cityFound(false);
-                foreach (GeoLocation *loc, geoList)
+                GeoLocation *loc = m_CityIndex.named(city, province, country);
+                if (loc)
                 {
-                    if (loc->translatedName() == city &&
-                            (province.isEmpty() || loc->translatedProvince() == province) &&
-                            loc->translatedCountry() == country)
-                    {
-                        cityFound = true;
-                        setLocation(*loc);
-                        cmdCount++;
-                        break;
-                    }
+                    setLocation(*loc);
+                    cmdCount++;
                 }
-
-                if (!cityFound)
+                else
                     qWarning() << i18n("Could not set location named %1, %2, %3", city, province, country);
             }
         }
@@ -1478,7 +1530,7 @@ bool KStarsData::executeScript(const QString &scriptname, SkyMap *map)
         return true;
 #else
     Q_UNUSED(map)
-    Q_UNUSED(scriptname)
+    Q_UNUSED(istream)
 #endif
     return false;
 }
@@ -6,11 +6,13 @@
 
 #pragma once
 
+#include "cityindex.h"
 #include "colorscheme.h"
 #include "geolocation.h"
 #include "ksnumbers.h"
 #include "kstarsdatetime.h"
 #include "ksuserdb.h"
+#include "observationcontext.h"
 #include "simclock.h"
 #include "skyobjectuserdata.h"
 #include <qobject.h>
@@ -36,6 +38,7 @@
 #define AU_KM       1.49605e8   //km in one AU
 
 class QFile;
+class QTextStream;
 
 class Execute;
 class FOV;
@@ -99,6 +102,14 @@ class KStarsData : public QObject
          */
         bool initialize();
 
+        /**
+         * @short Load the data not needed to draw the first sky map frame.
+         *
+         * Asteroids, comets, the image and information URLs and the ADV tree are left out of
+         * initialize() to shorten startup, call this once the sky map is shown.
+         */
+        void loadDeferredData();
+
         /** Destructor.  Delete data objects. */
         ~KStarsData() override;
 
@@ -226,6 +237,15 @@ class KStarsData : public QObject
             return &LST;
         }
 
+        /**
+         * @return the rotations from catalog to horizontal coordinates at the last
+         * updateTime(), invalid before the first one
+         */
+        const ObservationContext &observationContext() const
+        {
+            return m_ObservationContext;
+        }
+
         /** @return pointer to the GeoLocation object*/
         GeoLocation *geo()
         {
@@ -238,6 +258,15 @@ class KStarsData : public QObject
             return geoList;
         }
 
+        /**
+         * @return the name and position index of the geographic locations.
+         * Code adding, removing or changing locations in getGeoList() keeps it up to date.
+         */
+        CityIndex &cityIndex()
+        {
+            return m_CityIndex;
+        }
+
         GeoLocation *locationNamed(const QString &city, const QString &province = QString(),
                                    const QString &country = QString());
 
@@ -295,6 +324,12 @@ class KStarsData : public QObject
          */
         bool executeScript(const QString &name, SkyMap *map);
 
+        /**
+         * Execute the lines of a script read from @p istream, as executeScript() does for a file.
+         * @return true if at least one command was executed.
+         */
+        bool executeScript(QTextStream &istream, SkyMap *map);
+
         /** Synchronize list of visible FOVs and list of selected FOVs in Options */
 #ifndef KSTARS_LITE
         void syncFOV();
@@ -475,6 +510,9 @@ class KStarsData : public QObject
          */
         bool readCityData();
 
+        /** Add the Elevation column to the city table of a user city database of an older version. */
+        void upgradeCityDatabase();
+
         /** Read the data file that contains daylight savings time rules. */
         bool readTimeZoneRulebook();
 
@@ -586,11 +624,13 @@ class KStarsData : public QObject
         KStarsDateTime StoredDate;
 
         QList<GeoLocation *> geoList;
+        CityIndex m_CityIndex;
         QMap<QString, TimeZoneRule> Rulebook;
 
         quint32 m_preUpdateID, m_updateID;
         quint32 m_preUpdateNumID, m_updateNumID;
         KSNumbers m_preUpdateNum, m_updateNum;
+        ObservationContext m_ObservationContext;
 
         static KStarsData *pinstance;
 
@@ -16,8 +16,10 @@
 #include "observinglist.h"
 #include "Options.h"
 #include "skymap.h"
+#include "auxiliary/startupprofiler.h"
 #include "skycomponents/constellationboundarylines.h"
 #include "skycomponents/skymapcomposite.h"
+#include "skycomponents/starblockfactory.h"
 #include "skyobjects/catalogobject.h"
 #include "catalogsdb.h"
 #include "skyobjects/ksplanetbase.h"
@@ -38,6 +40,7 @@
 #include <QPrintDialog>
 #include <QPrinter>
 #include <QElapsedTimer>
+#include <QJsonDocument>
 
 #include "kstars_debug.h"
 
@@ -999,6 +1002,34 @@ QString KStars::getSkyMapDimensions()
 {
     return (QString::number(map()->width()) + 'x' + QString::number(map()->height()));
 }
+
+QString KStars::getDrawProfile(const QString &format)
+{
+    const DrawProfiler &profiler = data()->skyComposite()->drawProfiler();
+    if (format.compare("csv", Qt::CaseInsensitive) == 0)
+        return profiler.toCSV();
+    if (format.compare("json", Qt::CaseInsensitive) == 0)
+        return profiler.toJSON();
+    return QString();
+}
+
+QString KStars::getStartupProfile(const QString &format)
+{
+    const StartupProfiler &profiler = StartupProfiler::instance();
+    if (format.compare("text", Qt::CaseInsensitive) == 0)
+        return profiler.toText();
+    if (format.compare("csv", Qt::CaseInsensitive) == 0)
+        return profiler.toCSV();
+    if (format.compare("json", Qt::CaseInsensitive) == 0)
+        return profiler.toJSON();
+    return QString();
+}
+
+QString KStars::getStarCacheStatistics()
+{
+    return QString::fromUtf8(QJsonDocument(StarBlockFactory::Instance()->statistics()).toJson(QJsonDocument::Compact));
+}
+
 void KStars::printImage(bool usePrintDialog, bool useChartColors)
 {
     //QPRINTER_FOR_NOW
@@ -20,6 +20,7 @@
 #include "widgets/timestepbox.h"
 #include "widgets/timeunitbox.h"
 #include "hips/hipsmanager.h"
+#include "auxiliary/startupprofiler.h"
 #include "auxiliary/thememanager.h"
 
 #ifdef HAVE_INDI
@@ -36,6 +37,7 @@
 
 #include <QMenu>
 #include <QStatusBar>
+#include <QTimer>
 
 //This file contains functions that kstars calls at startup (except constructors).
 //These functions are declared in kstars.h
@@ -902,11 +904,11 @@ void KStars::initStatusBar()
 
 void KStars::datainitFinished()
 {
+    StartupProfiler &profiler = StartupProfiler::instance();
+    StartupProfiler::Phase phase("KStars::datainitFinished");
+
     //Time-related connections
-    connect(data()->clock(), &SimClock::timeAdvanced, this, [this]()
-    {
-        updateTime();
-    });
+    connect(data()->clock(), &SimClock::timeAdvanced, this, &KStars::scheduleTimeUpdate);
     connect(data()->clock(), &SimClock::timeChanged, this, [this]()
     {
         updateTime();
@@ -938,15 +940,41 @@ void KStars::datainitFinished()
 
     //Propagate config settings
     applyConfig(false);
+    profiler.mark("Configuration");
 
     //show the window.  must be before kswizard and messageboxes
     show();
+    profiler.mark("Show window");
 
     //Initialize focus
     initFocus();
 
     data()->setFullTimeUpdate();
     updateTime();
+    profiler.mark("Focus and time");
+
+    //Load the data the first frame does without once the map is on screen
+    QTimer::singleShot(0, this, [this]()
+    {
+        data()->loadDeferredData();
+
+        // The tracked object may be an asteroid or comet, which initFocus() could not find
+        if (Options::isTracking() && !map()->focusObject())
+        {
+            SkyObject *oFocus = data()->objectNamed(Options::focusObject());
+            if (oFocus)
+            {
+                map()->setFocusObject(oFocus);
+                map()->setClickedObject(oFocus);
+                map()->setFocusPoint(oFocus);
+                map()->setDestination(*map()->focusPoint());
+                map()->setFocus(map()->destination());
+            }
+        }
+        updateTime();
+
+        StartupProfiler::instance().finish();
+    });
 
     // Initial State
     qCDebug(KSTARS) << "Date/Time is:" << data()->clock()->utc().toString();
@@ -974,6 +1002,7 @@ void KStars::datainitFinished()
 #ifdef HAVE_INDI
     Ekos::Manager::Instance()->initialize();
 #endif
+    profiler.mark("Wizard, tips and Ekos");
 }
 
 void KStars::initFocus()
@@ -1064,6 +1093,9 @@ void KStars::initFocus()
 
 void KStars::buildGUI()
 {
+    StartupProfiler &profiler = StartupProfiler::instance();
+    StartupProfiler::Phase phase("KStars::buildGUI");
+
     //create the texture manager
     TextureManager::Create();
     //create the skymap
@@ -1071,14 +1103,18 @@ void KStars::buildGUI()
     connect(m_SkyMap, SIGNAL(mousePointChanged(SkyPoint*)), SLOT(slotShowPositionBar(SkyPoint*)));
     connect(m_SkyMap, SIGNAL(zoomChanged()), SLOT(slotZoomChanged()));
     setCentralWidget(m_SkyMap);
+    profiler.mark("Sky map");
 
     //Initialize menus, toolbars, and statusbars
     initStatusBar();
+    profiler.mark("Status bar");
     initActions();
+    profiler.mark("KStars::initActions");
 
     // Setup GUI from the settings file
     // UI tests provide the default settings file from the resources explicitly file to render UI properly
     setupGUI(StandardWindowOptions(Default), m_KStarsUIResource);
+    profiler.mark("Menus and toolbars");
 
     //get focus of keyboard and mouse actions (for example zoom in with +)
     map()->QWidget::setFocus();
@@ -128,15 +128,16 @@ void LocationDialogLite::filterCity(const QString &city, const QString &province
     QStringList cities;
     filteredCityList.clear();
 
-    foreach (GeoLocation *loc, data->getGeoList())
+    // The city filter narrows the search to a range of the name index
+    const QList<GeoLocation *> candidates = city.isEmpty() ? data->getGeoList() : data->cityIndex().startingWith(city);
+    for (GeoLocation *loc : candidates)
     {
-        QString sc(loc->translatedName());
         QString ss(loc->translatedCountry());
         QString sp = "";
         if (!loc->province().isEmpty())
             sp = loc->translatedProvince();
 
-        if (sc.toLower().startsWith(city.toLower()) && sp.toLower().startsWith(province.toLower()) &&
+        if (sp.toLower().startsWith(province.toLower()) &&
             ss.toLower().startsWith(country.toLower()))
         {
             QString name = loc->fullName();
@@ -214,6 +215,7 @@ bool LocationDialogLite::addCity(const QString &city, const QString &province, c
         //Add city to geoList
         g = new GeoLocation(lng, lat, City, Province, Country, TZ, &KStarsData::Instance()->Rulebook[TZRule]);
         KStarsData::Instance()->getGeoList().append(g);
+        KStarsData::Instance()->cityIndex().insert(g);
 
         mycitydb.commit();
         mycitydb.close();
@@ -243,6 +245,7 @@ bool LocationDialogLite::deleteCity(const QString &fullName)
 
         filteredCityList.remove(geo->fullName());
         KStarsData::Instance()->getGeoList().removeOne(geo);
+        KStarsData::Instance()->cityIndex().remove(geo);
         delete (geo);
         mycitydb.commit();
         mycitydb.close();
@@ -285,6 +288,7 @@ bool LocationDialogLite::editCity(const QString &fullName, const QString &city,
             return false;
         }
 
+        KStarsData::Instance()->cityIndex().remove(geo);
         geo->setName(city);
         geo->setProvince(province);
         geo->setCountry(country);
@@ -292,6 +296,7 @@ bool LocationDialogLite::editCity(const QString &fullName, const QString &city,
         geo->setLong(lng);
         geo->setTZ0(TZ);
         geo->setTZRule(&KStarsData::Instance()->Rulebook[TZRule]);
+        KStarsData::Instance()->cityIndex().insert(geo);
 
         //If we are changing current location update it
         if (m_currentLocation == fullName)
@@ -17,7 +17,7 @@
 #include "htmesh/MeshIterator.h"
 #include "projections/projector.h"
 #include "skynodes/pointsourcenode.h"
-#include "skynodes/trixelnode.h"
+#include "skynodes/startrixelnode.h"
 
 DeepStarItem::DeepStarItem(DeepStarComponent *deepStarComp, RootNode *rootNode)
     : SkyItem(LabelsItem::label_t::NO_LABEL, rootNode), m_deepStarComp(deepStarComp),
@@ -29,7 +29,7 @@ DeepStarItem::DeepStarItem(DeepStarComponent *deepStarComp, RootNode *rootNode)
     {
         for (int c = 0; c < m_starBlockList->size(); ++c)
         {
-            TrixelNode *trixel = new TrixelNode(m_starBlockList->at(c)->getTrixel());
+            StarTrixelNode *trixel = new StarTrixelNode(m_starBlockList->at(c)->getTrixel(), rootNode);
             appendChildNode(trixel);
             int blockCount = m_starBlockList->at(c)->getBlockCount();
 
@@ -154,7 +154,7 @@ void DeepStarItem::update()
         int trixelID = 0;
 
         QSGNode *firstTrixel = firstChild();
-        TrixelNode *trixel   = static_cast<TrixelNode *>(firstTrixel);
+        StarTrixelNode *trixel = static_cast<StarTrixelNode *>(firstTrixel);
 
         while (trixel != 0)
         {
@@ -169,23 +169,10 @@ void DeepStarItem::update()
 
                     if (trixel->hideCount() > delLim)
                     {
-                        QLinkedList<QPair<SkyObject *, SkyNode *>>::iterator i = trixel->m_nodes.begin();
-
-                        while (i != trixel->m_nodes.end())
-                        {
-                            SkyNode *node = (*i).second;
-                            if (node)
-                            {
-                                trixel->removeChildNode(node);
-                                delete node;
-
-                                *i = QPair<SkyObject *, SkyNode *>((*i).first, 0);
-                            }
-                            ++i;
-                        }
+                        trixel->deleteAllChildNodes();
                     }
 
-                    trixel = static_cast<TrixelNode *>(trixel->nextSibling());
+                    trixel = static_cast<StarTrixelNode *>(trixel->nextSibling());
                     ++trixelID;
                     continue;
                 }
@@ -198,70 +185,36 @@ void DeepStarItem::update()
                         regionID = region.next();
                     }
 
-                    QLinkedList<QPair<SkyObject *, SkyNode *>>::iterator i = (&trixel->m_nodes)->begin();
+                    //All the stars of the trixel go into its batch, rebuilt for every frame
+                    trixel->beginUpdate();
 
-                    while (i != (&trixel->m_nodes)->end())
-                    {
-                        bool hide     = false;
-                        bool hideSlew = false;
+                    bool hideSlew = hideFaintStars && hideStarsMag;
 
-                        bool drawLabel = false;
+                    for (const auto &pair : trixel->m_nodes)
+                    {
+                        if (hideSlew)
+                            break;
 
-                        StarObject *starObj = static_cast<StarObject *>((*i).first);
-                        SkyNode *node       = (*i).second;
+                        StarObject *starObj = static_cast<StarObject *>(pair.first);
 
                         int mag = starObj->mag();
 
                         // break loop if maglim is reached
                         if (mag > maglim)
-                            hide = true;
-                        if (hideFaintStars && hideStarsMag)
-                            hideSlew = true;
+                            break;
                         if (starObj->updateID != KStarsData::Instance()->updateID())
                             starObj->JITupdate();
 
-                        if (node)
-                        {
-                            if (node->hideCount() > delLim || hide)
-                            {
-                                trixel->removeChildNode(node);
-                                delete node;
-                                *i = QPair<SkyObject *, SkyNode *>((*i).first, 0);
-                            }
-                            else
-                            {
-                                if (!hideSlew)
-                                {
-                                    node->update(drawLabel);
-                                }
-                                else
-                                {
-                                    node->hide();
-                                }
-                            }
-                        }
-                        else
+                        if (projector->checkVisibility(starObj))
                         {
-                            if (!hide && !hideSlew && projector->checkVisibility(starObj))
-                            {
-                                QPointF pos;
-
-                                bool visible = false;
-                                pos          = projector->toScreen(starObj, true, &visible);
-                                if (visible && projector->onScreen(pos))
-                                {
-                                    PointSourceNode *point =
-                                        new PointSourceNode(starObj, rootNode(), LabelsItem::label_t::STAR_LABEL,
-                                                            starObj->spchar(), starObj->mag(), trixelID);
-                                    trixel->appendChildNode(point);
-
-                                    *i = QPair<SkyObject *, SkyNode *>((*i).first, static_cast<SkyNode *>(point));
-                                    point->updatePos(pos, drawLabel);
-                                }
-                            }
+                            bool visible = false;
+                            QPointF pos  = projector->toScreen(starObj, true, &visible);
+                            if (visible && projector->onScreen(pos))
+                                trixel->addStar(starObj, pos, false);
                         }
-                        ++i;
                     }
+
+                    trixel->endUpdate();
                 }
             }
             else if (false)
@@ -316,7 +269,7 @@ void DeepStarItem::update()
                     }
                 }
             }
-            trixel = static_cast<TrixelNode *>(trixel->nextSibling());
+            trixel = static_cast<StarTrixelNode *>(trixel->nextSibling());
             trixelID++;
         }
         m_skyMesh->inDraw(false);
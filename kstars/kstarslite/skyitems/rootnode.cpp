@@ -42,6 +42,8 @@
 
 #include "kstarslite/skyitems/fovitem.h"
 
+#include "kstarslite/skyitems/skynodes/nodes/pointbatchnode.h"
+
 #include <QSGFlatColorMaterial>
 
 RootNode::RootNode() : m_skyMapLite(SkyMapLite::Instance())
@@ -160,6 +162,26 @@ RootNode::~RootNode()
             delete m_textureCache[i][c];
         }
     }
+    qDeleteAll(m_pointBatchPool);
+}
+
+PointBatchNode *RootNode::takePointBatch()
+{
+    if (m_pointBatchPool.isEmpty())
+        return new PointBatchNode;
+    return m_pointBatchPool.takeLast();
+}
+
+void RootNode::recyclePointBatch(PointBatchNode *node)
+{
+    // Keep enough batches for a screen full of trixels
+    if (m_pointBatchPool.size() >= 64)
+    {
+        delete node;
+        return;
+    }
+    node->clear();
+    m_pointBatchPool.append(node);
 }
 
 void RootNode::genCachedTextures()
@@ -213,6 +235,12 @@ void RootNode::updateClipPoly()
     markDirty(QSGNode::DirtyGeometry);
 }
 
+void RootNode::updateTelescopes()
+{
+    m_telescopeSymbols->update();
+    m_labelsItem->updateChildLabels(LabelsItem::label_t::TELESCOPE_SYMBOL);
+}
+
 void RootNode::update(bool clearTextures)
 {
     updateClipPoly();
@@ -13,6 +13,8 @@
 class QSGTexture;
 class SkyMapLite;
 
+class PointBatchNode;
+
 class StarItem;
 class DeepSkyItem;
 
@@ -70,6 +72,15 @@ class RootNode : public QSGClipNode
      */
     QSGTexture *getCachedTexture(int size, char spType);
 
+    /**
+     * @short returns a PointBatchNode from the pool, or a new one if the pool is empty. The caller
+     * owns the node until it gives it back with recyclePointBatch()
+     */
+    PointBatchNode *takePointBatch();
+
+    /** @short puts a PointBatchNode that was removed from its parent back into the pool */
+    void recyclePointBatch(PointBatchNode *node);
+
     /** @short triangulates and sets new clipping polygon provided by Projection system */
     void updateClipPoly();
 
@@ -80,6 +91,9 @@ class RootNode : public QSGClipNode
      */
     void update(bool clearTextures = false);
 
+    /** @short update only the telescope symbols and their labels, when nothing else moved */
+    void updateTelescopes();
+
     /** Debug functions **/
     void testLeakDelete();
     void testLeakAdd();
@@ -97,6 +111,8 @@ class RootNode : public QSGClipNode
   private:
     QVector<QVector<QSGTexture *>> m_textureCache;
     QVector<QVector<QSGTexture *>> m_oldTextureCache;
+    /** Batches of trixels that were hidden for long, reused by the trixels that come into view */
+    QVector<PointBatchNode *> m_pointBatchPool;
     SkyMapLite *m_skyMapLite { nullptr };
 
     QPolygonF m_clipPoly;
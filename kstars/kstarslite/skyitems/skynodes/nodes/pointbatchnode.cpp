@@ -0,0 +1,207 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "pointbatchnode.h"
+
+#include "Options.h"
+
+#include <QOpenGLShaderProgram>
+#include <QSGMaterial>
+
+#include <cstring>
+
+namespace
+{
+// Two triangles per star
+constexpr int VerticesPerPoint = 6;
+
+class PointBatchMaterial : public QSGMaterial
+{
+  public:
+    PointBatchMaterial() { setFlag(Blending); }
+
+    QSGMaterialType *type() const override
+    {
+        static QSGMaterialType type;
+        return &type;
+    }
+
+    QSGMaterialShader *createShader() const override;
+
+    int compare(const QSGMaterial *other) const override
+    {
+        const auto *material = static_cast<const PointBatchMaterial *>(other);
+        if (starColorMode != material->starColorMode)
+            return starColorMode < material->starColorMode ? -1 : 1;
+        if (starColorIntensity != material->starColorIntensity)
+            return starColorIntensity < material->starColorIntensity ? -1 : 1;
+        return 0;
+    }
+
+    int starColorMode { 0 };
+    int starColorIntensity { 0 };
+};
+
+class PointBatchShader : public QSGMaterialShader
+{
+  public:
+    const char *vertexShader() const override
+    {
+        return "attribute highp vec4 aVertex;                              \n"
+               "attribute highp vec2 aCoord;                               \n"
+               "attribute lowp vec4 aColor;                                \n"
+               "uniform highp mat4 qt_Matrix;                              \n"
+               "varying highp vec2 coord;                                  \n"
+               "varying lowp vec4 color;                                   \n"
+               "void main() {                                              \n"
+               "    coord = aCoord;                                        \n"
+               "    color = aColor;                                        \n"
+               "    gl_Position = qt_Matrix * aVertex;                     \n"
+               "}";
+    }
+
+    // The same shapes as the star images of SkyMapLite::initStarImages(). In the real color
+    // mode the center is white, and the color saturates and fades towards the rim. The other
+    // modes draw a plain disk.
+    const char *fragmentShader() const override
+    {
+        return "uniform lowp float qt_Opacity;                             \n"
+               "uniform lowp float realColor;                              \n"
+               "uniform lowp float intensity;                              \n"
+               "varying highp vec2 coord;                                  \n"
+               "varying lowp vec4 color;                                   \n"
+               "void main() {                                              \n"
+               "    highp float d = length(coord);                         \n"
+               "    lowp float alpha;                                      \n"
+               "    lowp vec3 rgb;                                         \n"
+               "    if (realColor > 0.5) {                                 \n"
+               "        lowp float value = max(color.r, max(color.g, color.b)); \n"
+               "        lowp float saturation = d < 1.0 - intensity ? 0.0 : min(1.0, d); \n"
+               "        alpha = d < 0.5 * (1.0 - intensity) ? 1.0 : max(0.0, 1.0 - d); \n"
+               "        rgb = mix(vec3(value), color.rgb, saturation);     \n"
+               "    } else {                                               \n"
+               "        alpha = 1.0 - smoothstep(0.7, 0.85, d);            \n"
+               "        rgb = color.rgb;                                   \n"
+               "    }                                                      \n"
+               "    gl_FragColor = vec4(rgb * alpha, alpha) * qt_Opacity;  \n"
+               "}";
+    }
+
+    char const *const *attributeNames() const override
+    {
+        static const char *const names[] = { "aVertex", "aCoord", "aColor", nullptr };
+        return names;
+    }
+
+    void updateState(const RenderState &state, QSGMaterial *newMaterial, QSGMaterial *oldMaterial) override
+    {
+        if (state.isMatrixDirty())
+            program()->setUniformValue(m_matrix, state.combinedMatrix());
+        if (state.isOpacityDirty())
+            program()->setUniformValue(m_opacity, state.opacity());
+
+        const auto *material = static_cast<const PointBatchMaterial *>(newMaterial);
+        if (oldMaterial == nullptr || material->compare(oldMaterial) != 0)
+        {
+            program()->setUniformValue(m_realColor, material->starColorMode == 0 ? 1.0f : 0.0f);
+            program()->setUniformValue(m_intensity, material->starColorIntensity / 10.0f);
+        }
+    }
+
+  private:
+    void initialize() override
+    {
+        m_matrix    = program()->uniformLocation("qt_Matrix");
+        m_opacity   = program()->uniformLocation("qt_Opacity");
+        m_realColor = program()->uniformLocation("realColor");
+        m_intensity = program()->uniformLocation("intensity");
+    }
+
+    int m_matrix { -1 };
+    int m_opacity { -1 };
+    int m_realColor { -1 };
+    int m_intensity { -1 };
+};
+
+QSGMaterialShader *PointBatchMaterial::createShader() const
+{
+    return new PointBatchShader;
+}
+
+const QSGGeometry::AttributeSet &pointBatchAttributes()
+{
+    static const QSGGeometry::Attribute attributes[] =
+    {
+        QSGGeometry::Attribute::create(0, 2, GL_FLOAT, true),
+        QSGGeometry::Attribute::create(1, 2, GL_FLOAT),
+        QSGGeometry::Attribute::create(2, 4, GL_UNSIGNED_BYTE)
+    };
+    static const QSGGeometry::AttributeSet set = { 3, 2 * sizeof(float) + 2 * sizeof(float) + 4, attributes };
+    return set;
+}
+}
+
+PointBatchNode::PointBatchNode() : m_geometry(pointBatchAttributes(), 0)
+{
+    m_geometry.setDrawingMode(GL_TRIANGLES);
+    setGeometry(&m_geometry);
+    setMaterial(new PointBatchMaterial);
+    setFlag(OwnsMaterial);
+}
+
+void PointBatchNode::clear()
+{
+    m_vertices.clear();
+    m_count = 0;
+}
+
+void PointBatchNode::addPoint(const QPointF &pos, float size, const QColor &color)
+{
+    // As PointNode, which uses the star images of at most 14 pixels
+    const float half = qMin(static_cast<int>(size), 14) / 2.0f;
+    const float x = pos.x(), y = pos.y();
+    const unsigned char r = color.red(), g = color.green(), b = color.blue(), a = color.alpha();
+
+    m_vertices.append({ x - half, y - half, -1, -1, r, g, b, a });
+    m_vertices.append({ x + half, y - half, 1, -1, r, g, b, a });
+    m_vertices.append({ x - half, y + half, -1, 1, r, g, b, a });
+    m_vertices.append({ x + half, y - half, 1, -1, r, g, b, a });
+    m_vertices.append({ x + half, y + half, 1, 1, r, g, b, a });
+    m_vertices.append({ x - half, y + half, -1, 1, r, g, b, a });
+    ++m_count;
+}
+
+void PointBatchNode::commit()
+{
+    DirtyState dirty = DirtyGeometry;
+
+    const int starColorMode      = Options::starColorMode();
+    const int starColorIntensity = Options::starColorIntensity();
+    if (starColorMode != m_starColorMode || starColorIntensity != m_starColorIntensity)
+    {
+        auto *batchMaterial               = static_cast<PointBatchMaterial *>(material());
+        batchMaterial->starColorMode      = m_starColorMode = starColorMode;
+        batchMaterial->starColorIntensity = m_starColorIntensity = starColorIntensity;
+        dirty |= DirtyMaterial;
+    }
+
+    // The buffer is reallocated only when the number of points doubles or drops to a quarter
+    int capacity = m_geometry.vertexCount() / VerticesPerPoint;
+    if (m_count > capacity || m_count < capacity / 4)
+    {
+        capacity = 16;
+        while (capacity < m_count)
+            capacity *= 2;
+        m_geometry.allocate(capacity * VerticesPerPoint);
+    }
+
+    auto *vertices = static_cast<Vertex *>(m_geometry.vertexData());
+    std::memcpy(vertices, m_vertices.constData(), m_vertices.size() * sizeof(Vertex));
+    std::memset(vertices + m_vertices.size(), 0, (m_geometry.vertexCount() - m_vertices.size()) * sizeof(Vertex));
+
+    m_geometry.markVertexDataDirty();
+    markDirty(dirty);
+}
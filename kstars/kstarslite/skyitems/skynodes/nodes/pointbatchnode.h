@@ -0,0 +1,61 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QColor>
+#include <QPointF>
+#include <QSGGeometry>
+#include <QSGGeometryNode>
+#include <QVector>
+
+/**
+ * @class PointBatchNode
+ * @short A QSGGeometryNode that draws many stars with one geometry
+ *
+ * Each star is a quad of two triangles with its position, its size and the color of its
+ * spectral class. The round shape, the white core and the fading rim of the star images of
+ * SkyMapLite::initStarImages() are computed by the fragment shader, so that no texture is
+ * needed and all the batches of the map can be merged by the renderer into few draw calls.
+ *
+ * The vertex buffer is kept between frames and only grows or shrinks by powers of two. The
+ * quads that are not used are empty.
+ */
+class PointBatchNode : public QSGGeometryNode
+{
+  public:
+    PointBatchNode();
+
+    /** @short Remove all the points, the memory is kept */
+    void clear();
+
+    /**
+     * @short Add a point
+     * @param pos center of the point on SkyMapLite
+     * @param size width of the point, as PointSourceNode::starWidth()
+     * @param color color of the spectral class of the star
+     */
+    void addPoint(const QPointF &pos, float size, const QColor &color);
+
+    /** @short Upload the points added since clear() */
+    void commit();
+
+    int pointCount() const { return m_count; }
+
+  private:
+    struct Vertex
+    {
+        float x, y;
+        float u, v;
+        unsigned char r, g, b, a;
+    };
+
+    QSGGeometry m_geometry;
+    QVector<Vertex> m_vertices;
+    int m_count { 0 };
+    int m_starColorMode { -1 };
+    int m_starColorIntensity { -1 };
+};
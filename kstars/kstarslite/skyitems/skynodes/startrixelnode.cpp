@@ -0,0 +1,78 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "startrixelnode.h"
+
+#include "labelnode.h"
+#include "pointsourcenode.h"
+#include "skymaplite.h"
+#include "starobject.h"
+#include "nodes/pointbatchnode.h"
+#include "../labelsitem.h"
+#include "../rootnode.h"
+
+StarTrixelNode::StarTrixelNode(const Trixel &trixel, RootNode *rootNode) : TrixelNode(trixel), m_rootNode(rootNode)
+{
+}
+
+void StarTrixelNode::beginUpdate()
+{
+    ++m_frame;
+    if (m_points)
+        m_points->clear();
+}
+
+void StarTrixelNode::addStar(StarObject *star, const QPointF &pos, bool drawLabel)
+{
+    if (!m_points)
+    {
+        m_points = m_rootNode->takePointBatch();
+        appendChildNode(m_points);
+    }
+    m_points->addPoint(pos, PointSourceNode::starWidth(star->mag()), SkyMapLite::Instance()->starColor(star->spchar()));
+
+    if (drawLabel)
+    {
+        Label &label = m_labels[star];
+        if (!label.node)
+            label.node = m_rootNode->labelsItem()->addLabel(star, LabelsItem::label_t::STAR_LABEL, trixelID());
+        label.node->setLabelPos(pos);
+        label.frame = m_frame;
+    }
+}
+
+void StarTrixelNode::endUpdate()
+{
+    if (m_points)
+        m_points->commit();
+
+    for (const Label &label : m_labels)
+    {
+        if (label.frame != m_frame)
+            label.node->hide();
+    }
+}
+
+void StarTrixelNode::forgetLabels()
+{
+    m_labels.clear();
+}
+
+void StarTrixelNode::deleteAllChildNodes()
+{
+    if (m_points)
+    {
+        removeChildNode(m_points);
+        m_rootNode->recyclePointBatch(m_points);
+        m_points = nullptr;
+    }
+
+    for (const Label &label : m_labels)
+        m_rootNode->labelsItem()->deleteLabel(label.node);
+    m_labels.clear();
+
+    TrixelNode::deleteAllChildNodes();
+}
@@ -0,0 +1,60 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "trixelnode.h"
+
+#include <QHash>
+
+class LabelNode;
+class PointBatchNode;
+class RootNode;
+class StarObject;
+
+/**
+ * @short A trixel of stars, drawn as one PointBatchNode
+ *
+ * The stars of the trixel are added again for every frame between beginUpdate() and
+ * endUpdate(), without a node of their own. The labels are kept while their stars are drawn,
+ * and hidden otherwise. When the trixel was hidden for long, its batch goes back to the pool of
+ * RootNode and its labels are deleted.
+ */
+class StarTrixelNode : public TrixelNode
+{
+  public:
+    StarTrixelNode(const Trixel &trixel, RootNode *rootNode);
+
+    /** @short Start a frame, the stars of the last one are removed */
+    void beginUpdate();
+
+    /**
+     * @short Draw @p star at @p pos
+     * @param drawLabel true if the label of the star has to be drawn
+     */
+    void addStar(StarObject *star, const QPointF &pos, bool drawLabel);
+
+    /** @short Finish the frame and hide the labels of the stars that were not drawn */
+    void endUpdate();
+
+    /** @short Forget the labels of the stars, which LabelsItem deleted */
+    void forgetLabels();
+
+    /** @short Return the batch to the pool and delete the labels */
+    virtual void deleteAllChildNodes() override;
+
+  private:
+    struct Label
+    {
+        LabelNode *node { nullptr };
+        int frame { -1 };
+    };
+
+    RootNode *m_rootNode { nullptr };
+    PointBatchNode *m_points { nullptr };
+    QHash<StarObject *, Label> m_labels;
+    int m_frame { 0 };
+};
@@ -15,8 +15,7 @@
 #include "starcomponent.h"
 #include "htmesh/MeshIterator.h"
 #include "projections/projector.h"
-#include "skynodes/pointsourcenode.h"
-#include "skynodes/trixelnode.h"
+#include "skynodes/startrixelnode.h"
 
 #include <QLinkedList>
 
@@ -36,7 +35,7 @@ StarItem::StarItem(StarComponent *starComp, RootNode *rootNode)
     for (int i = 0; i < trixels->size(); ++i)
     {
         StarList *skyList  = trixels->at(i);
-        TrixelNode *trixel = new TrixelNode(i);
+        StarTrixelNode *trixel = new StarTrixelNode(i, rootNode);
         m_stars->appendChildNode(trixel);
 
         for (int c = 0; c < skyList->size(); ++c)
@@ -145,7 +144,7 @@ void StarItem::update()
     int trixelID = 0;
 
     QSGNode *firstTrixel = m_stars->firstChild();
-    TrixelNode *trixel   = static_cast<TrixelNode *>(firstTrixel);
+    StarTrixelNode *trixel = static_cast<StarTrixelNode *>(firstTrixel);
 
     QSGNode *firstLabel = m_starLabels->firstChild();
     TrixelNode *label   = static_cast<TrixelNode *>(firstLabel);
@@ -165,17 +164,8 @@ void StarItem::update()
         {
             StarList *skyList = index->at(trixelID);
 
-            QSGNode *n = trixel->firstChild();
-
-            //Delete nodes
-            while (n != 0)
-            {
-                QSGNode *c = n;
-                n          = n->nextSibling();
-
-                trixel->removeChildNode(c);
-                delete c;
-            }
+            //The labels were deleted above
+            trixel->forgetLabels();
 
             //Delete all pairs that represent stars
             trixel->m_nodes.clear();
@@ -211,71 +201,34 @@ void StarItem::update()
                 regionID = region.next();
             }
 
-            QLinkedList<QPair<SkyObject *, SkyNode *>> *nodes = &trixel->m_nodes;
-            QLinkedList<QPair<SkyObject *, SkyNode *>>::iterator i = nodes->begin();
-            bool hide = false;
+            //All the stars of the trixel go into its batch, rebuilt for every frame
+            trixel->beginUpdate();
 
-            while (i != nodes->end())
+            for (const auto &pair : trixel->m_nodes)
             {
-                bool drawLabel = false;
-
-                StarObject *starObj = static_cast<StarObject *>((*i).first);
-                SkyNode *node       = (*i).second;
+                StarObject *starObj = static_cast<StarObject *>(pair.first);
 
                 int mag = starObj->mag();
 
                 // break loop if maglim is reached
                 if (mag > maglim)
-                    hide = true;
-                if (!(hideLabel || mag > labelMagLim))
-                    drawLabel = true;
+                    break;
+                bool drawLabel = !(hideLabel || mag > labelMagLim);
                 if (starObj->updateID != KStarsData::Instance()->updateID())
                     starObj->JITupdate();
 
-                if (node)
-                {
-                    if (node->hideCount() > delLim || hide)
-                    {
-                        trixel->removeChildNode(node);
-                        delete node;
-                        *i = QPair<SkyObject *, SkyNode *>((*i).first, 0);
-                    }
-                    else
-                    {
-                        if (!hide)
-                        {
-                            node->update(drawLabel);
-                        }
-                        else
-                        {
-                            node->hide();
-                        }
-                    }
-                }
-                else
+                if (projector->checkVisibility(starObj))
                 {
-                    if (!hide && projector->checkVisibility(starObj))
-                    {
-                        QPointF pos;
-
-                        bool visible = false;
-                        pos          = projector->toScreen(starObj, true, &visible);
-                        if (visible && projector->onScreen(pos))
-                        {
-                            PointSourceNode *point =
-                                new PointSourceNode(starObj, rootNode(), LabelsItem::label_t::STAR_LABEL,
-                                                    starObj->spchar(), starObj->mag(), trixelID);
-                            trixel->appendChildNode(point);
-
-                            *i = QPair<SkyObject *, SkyNode *>((*i).first, static_cast<SkyNode *>(point));
-                            point->updatePos(pos, drawLabel);
-                        }
-                    }
+                    bool visible = false;
+                    QPointF pos  = projector->toScreen(starObj, true, &visible);
+                    if (visible && projector->onScreen(pos))
+                        trixel->addStar(starObj, pos, drawLabel);
                 }
-                ++i;
             }
+
+            trixel->endUpdate();
         }
-        trixel = static_cast<TrixelNode *>(trixel->nextSibling());
+        trixel = static_cast<StarTrixelNode *>(trixel->nextSibling());
         label  = static_cast<TrixelNode *>(label->nextSibling());
 
         ++trixelID;
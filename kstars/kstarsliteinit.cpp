@@ -34,6 +34,9 @@ void KStarsLite::datainitFinished()
     //Propagate config settings
     applyConfig(false);
 
+    //Load the remaining data before focusing, the focus object may be an asteroid or comet
+    data()->loadDeferredData();
+
     //Initialize focus
     initFocus();
 
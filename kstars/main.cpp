@@ -17,10 +17,12 @@
 #include "ksutils.h"
 #include "Options.h"
 #include "simclock.h"
+#include "startupprofiler.h"
 #include "version.h"
 #if !defined(KSTARS_LITE)
 #include "kstars.h"
 #include "skymap.h"
+#include "skymapbenchmark.h"
 #endif
 
 #if !defined(KSTARS_LITE)
@@ -35,8 +37,10 @@
 #include <QCommandLineOption>
 #endif
 #include <QDebug>
+#include <QFile>
 #include <QPixmap>
 #include <QScreen>
+#include <QTextStream>
 #include <QtGlobal>
 #include <QTranslator>
 
@@ -198,6 +202,11 @@ int main(int argc, char *argv[])
     parser.addOption(QCommandLineOption("height", i18n("Height of sky image."), "value"));
     parser.addOption(QCommandLineOption("date", i18n("Date and time."), "string"));
     parser.addOption(QCommandLineOption("paused", i18n("Start with clock paused.")));
+    parser.addOption(QCommandLineOption("benchmark", i18n("Draw the views of a script offscreen and report their frame times."),
+                                        "file"));
+    parser.addOption(QCommandLineOption("frames", i18n("Number of timed frames of each benchmark view."), "value"));
+    parser.addOption(QCommandLineOption("report", i18n("Write the benchmark results to a JSON file."), "file"));
+    parser.addOption(QCommandLineOption("startup-profile", i18n("Log the time and memory of each startup phase.")));
 
     // urls to open
     parser.addPositionalArgument(QStringLiteral("urls"), i18n("FITS file(s) to open."),
@@ -206,9 +215,12 @@ int main(int argc, char *argv[])
     parser.process(app);
     aboutData.processCommandLine(&parser);
 
-    if (parser.isSet("dump"))
+    StartupProfiler::instance().setLogging(parser.isSet("startup-profile"));
+
+    if (parser.isSet("dump") || parser.isSet("benchmark"))
     {
-        qCDebug(KSTARS) << "Dumping sky image";
+        const bool benchmark = parser.isSet("benchmark");
+        qCDebug(KSTARS) << (benchmark ? "Benchmarking sky map" : "Dumping sky image");
 
         //parse filename and image format
         const char *format = "PNG";
@@ -234,7 +246,7 @@ int main(int argc, char *argv[])
         {
             format = "BMP";
         }
-        else
+        else if (!benchmark)
         {
             qCWarning(KSTARS) << i18n("Could not parse image format of %1; assuming PNG.",
                                       fname);
@@ -246,6 +258,13 @@ int main(int argc, char *argv[])
         w = parser.value("width").toInt(&ok);
         if (ok)
             h = parser.value("height").toInt(&ok);
+        //benchmarks default to a full HD sky map
+        if (!ok && benchmark && !parser.isSet("width") && !parser.isSet("height"))
+        {
+            w  = 1920;
+            h  = 1080;
+            ok = true;
+        }
         if (!ok)
         {
             qCWarning(KSTARS) << "Unable to parse arguments Width: "
@@ -258,6 +277,7 @@ int main(int argc, char *argv[])
         QObject::connect(dat, SIGNAL(progressText(QString)), dat,
                          SLOT(slotConsoleMessage(QString)));
         dat->initialize();
+        dat->loadDeferredData();
 
         //Set Geographic Location
         dat->setLocationFromOptions();
@@ -333,6 +353,34 @@ int main(int argc, char *argv[])
             }
         }
 
+        if (benchmark)
+        {
+            QFile scriptFile(parser.value("benchmark"));
+            if (!scriptFile.open(QIODevice::ReadOnly))
+            {
+                qCWarning(KSTARS) << "Unable to open benchmark script: " << scriptFile.fileName();
+                delete map;
+                return 1;
+            }
+
+            QTextStream istream(&scriptFile);
+            SkyMapBenchmark skyMapBenchmark(map, parser.isSet("frames") ? parser.value("frames").toInt() : 10);
+            const QList<SkyMapBenchmark::Result> results = skyMapBenchmark.run(SkyMapBenchmark::parseViews(istream));
+            std::cout << SkyMapBenchmark::toText(results).toUtf8().data() << std::flush;
+
+            if (parser.isSet("report"))
+            {
+                QFile report(parser.value("report"));
+                if (report.open(QIODevice::WriteOnly | QIODevice::Truncate))
+                    report.write(SkyMapBenchmark::toJSON(results).toUtf8());
+                else
+                    qCWarning(KSTARS) << "Unable to write benchmark report: " << report.fileName();
+            }
+
+            delete map;
+            return results.isEmpty() ? 1 : 0;
+        }
+
         qApp->processEvents();
         map->setupProjector();
         map->exportSkyImage(&sky);
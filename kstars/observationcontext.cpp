@@ -0,0 +1,137 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "observationcontext.h"
+
+#include "Options.h"
+#include "geolocation.h"
+#include "skyvectors.h"
+#include "skyobjects/skypoint.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+/** @return the rotation of the axes about x by @p angle, in radians */
+Eigen::Matrix3d rotationX(double angle)
+{
+    const double c = std::cos(angle), s = std::sin(angle);
+    Eigen::Matrix3d r;
+    r << 1, 0, 0, 0, c, s, 0, -s, c;
+    return r;
+}
+
+/** @return the rotation of the axes about z by @p angle, in radians */
+Eigen::Matrix3d rotationZ(double angle)
+{
+    const double c = std::cos(angle), s = std::sin(angle);
+    Eigen::Matrix3d r;
+    r << c, s, 0, -s, c, 0, 0, 0, 1;
+    return r;
+}
+}
+
+ObservationContext::ObservationContext()
+    : m_Numbers(std::make_shared<KSNumbers>(J2000)), m_PrecessionNutation(Eigen::Matrix3d::Identity()),
+      m_Aberration(Eigen::Vector3d::Zero()), m_EquatorialToHorizontal(Eigen::Matrix3d::Identity())
+{
+}
+
+ObservationContext::ObservationContext(const KSNumbers &num, const GeoLocation *geo, const dms &lst)
+    : m_Numbers(std::make_shared<KSNumbers>(num)), m_LST(lst), m_Latitude(*geo->lat()), m_Valid(true)
+{
+    // Nutation as in Meeus, chapter 22: to the ecliptic, by the nutation in longitude,
+    // back to the true equator
+    const double obliquity = num.obliquity()->radians();
+    const double trueObliquity = obliquity + num.dObliq() * dms::DegToRad;
+    const Eigen::Matrix3d nutation = rotationX(-trueObliquity) * rotationZ(-num.dEcLong() * dms::DegToRad) *
+                                     rotationX(obliquity);
+    m_PrecessionNutation = nutation * num.p2();
+
+    // The velocity of the Earth, from the constant of aberration and the orbit, see Meeus, equ. 23.2
+    double sinL, cosL, sinP, cosP;
+    num.sunTrueLongitude().SinCos(sinL, cosL);
+    num.earthPerihelionLongitude().SinCos(sinP, cosP);
+    const double k = num.constAberr().radians();
+    const double e = num.earthEccentricity();
+    const Eigen::Vector3d ecliptic(k * (sinL - e * sinP), -k * (cosL - e * cosP), 0);
+    m_Aberration = rotationX(-trueObliquity) * ecliptic;
+
+    // To the hour angle, H = LST - RA, then to the north, the east and the zenith
+    double sinLST, cosLST, sinLat, cosLat;
+    m_LST.SinCos(sinLST, cosLST);
+    m_Latitude.SinCos(sinLat, cosLat);
+    Eigen::Matrix3d hourAngle, horizon;
+    hourAngle << cosLST, sinLST, 0, sinLST, -cosLST, 0, 0, 0, 1;
+    horizon << -sinLat, 0, cosLat, 0, -1, 0, cosLat, 0, sinLat;
+    m_EquatorialToHorizontal = horizon * hourAngle;
+}
+
+void ObservationContext::toApparent(SkyVectors &vectors) const
+{
+    vectors.rotate(m_PrecessionNutation);
+    vectors.addAndNormalize(m_Aberration);
+}
+
+void ObservationContext::toHorizontal(SkyVectors &vectors) const
+{
+    vectors.rotate(m_EquatorialToHorizontal);
+}
+
+void ObservationContext::update(SkyPoint *const *points, int count, bool precess) const
+{
+    if (count <= 0)
+        return;
+
+    const bool relativistic = precess && Options::useRelativistic();
+    const double jd = static_cast<double>(julianDay());
+
+    SkyVectors vectors(count);
+    for (int i = 0; i < count; ++i)
+    {
+        const SkyPoint *p = points[i];
+        vectors.set(i, precess ? unitVector(p->RA0, p->Dec0) : unitVector(p->RA, p->Dec));
+    }
+
+    std::vector<double> longitude(count), latitude(count);
+    if (precess)
+    {
+        toApparent(vectors);
+        vectors.toAngles(longitude.data(), latitude.data());
+        for (int i = 0; i < count; ++i)
+        {
+            SkyPoint *p = points[i];
+            p->RA.setRadians(longitude[i]);
+            p->Dec.setRadians(latitude[i]);
+            p->lastPrecessJD = jd;
+
+            if (relativistic && p->checkBendLight())
+            {
+                // The bending of light is no rotation, update these the long way
+                p->updateCoords(m_Numbers.get(), false, nullptr, nullptr, true);
+                vectors.set(i, unitVector(p->RA, p->Dec));
+            }
+        }
+    }
+
+    toHorizontal(vectors);
+    vectors.toAngles(longitude.data(), latitude.data());
+    for (int i = 0; i < count; ++i)
+    {
+        SkyPoint *p = points[i];
+        p->Alt.setRadians(latitude[i]);
+        p->Az.setRadians(longitude[i]);
+    }
+}
+
+Eigen::Vector3d ObservationContext::unitVector(const CachingDms &ra, const CachingDms &dec)
+{
+    double sinRA, cosRA, sinDec, cosDec;
+    ra.SinCos(sinRA, cosRA);
+    dec.SinCos(sinDec, cosDec);
+    return Eigen::Vector3d(cosRA * cosDec, sinRA * cosDec, sinDec);
+}
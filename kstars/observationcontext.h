@@ -0,0 +1,121 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "cachingdms.h"
+#include "ksnumbers.h"
+
+#include <Eigen/Core>
+
+#include <memory>
+
+class GeoLocation;
+class SkyPoint;
+class SkyVectors;
+
+/**
+ * @class ObservationContext
+ * @short The rotations from catalog to horizontal coordinates for one instant and place.
+ *
+ * updateCoords() derives precession, nutation and aberration from a KSNumbers for every
+ * point, and EquatorialToHorizontal() takes the sines and cosines of the sidereal time and
+ * the latitude again for every point. This class computes them once per clock tick, as a
+ * precession-nutation matrix, the velocity of the Earth for the aberration and an
+ * equatorial-to-horizontal matrix, so that components can update their points in batches
+ * with a few matrix products.
+ *
+ * Vectors are unit vectors, equatorial ones towards (RA, Dec) = (0, 0), (90°, 0) and the
+ * pole, horizontal ones towards the north, the east and the zenith. Refraction and the
+ * bending of light near the Sun are not included.
+ */
+class ObservationContext
+{
+    public:
+        /** An invalid context, for J2000 and no location */
+        ObservationContext();
+
+        /**
+         * @param num the time-dependent quantities, which are copied
+         * @param geo the location of the observer
+         * @param lst the local sidereal time at the time of @p num
+         */
+        ObservationContext(const KSNumbers &num, const GeoLocation *geo, const dms &lst);
+
+        bool isValid() const
+        {
+            return m_Valid;
+        }
+
+        const KSNumbers &numbers() const
+        {
+            return *m_Numbers;
+        }
+
+        long double julianDay() const
+        {
+            return m_Numbers->julianDay();
+        }
+
+        const CachingDms &lst() const
+        {
+            return m_LST;
+        }
+
+        const CachingDms &latitude() const
+        {
+            return m_Latitude;
+        }
+
+        /** @return the rotation from the mean equator of J2000 to the true equator of the date */
+        const Eigen::Matrix3d &precessionNutation() const
+        {
+            return m_PrecessionNutation;
+        }
+
+        /** @return the velocity of the Earth in units of the speed of light, equatorial of the date */
+        const Eigen::Vector3d &aberration() const
+        {
+            return m_Aberration;
+        }
+
+        /** @return the rotation from the true equator of the date to the horizon */
+        const Eigen::Matrix3d &equatorialToHorizontal() const
+        {
+            return m_EquatorialToHorizontal;
+        }
+
+        /** @short Turn J2000 unit vectors into apparent ones of the date */
+        void toApparent(SkyVectors &vectors) const;
+
+        /** @short Turn apparent unit vectors of the date into horizontal ones */
+        void toHorizontal(SkyVectors &vectors) const;
+
+        /**
+         * @short Update the coordinates of the date and the horizontal coordinates of @p points.
+         *
+         * This is the same as SkyPoint::updateCoords() followed by
+         * SkyPoint::EquatorialToHorizontal() for plain points, whose catalog coordinates are
+         * J2000 ones. Points near the Sun are updated one by one when relativistic corrections
+         * are enabled. Subclasses that override updateCoords(), such as stars with a proper
+         * motion or solar system bodies, must not be passed.
+         *
+         * @param precess if false, only the horizontal coordinates are updated
+         */
+        void update(SkyPoint *const *points, int count, bool precess = true) const;
+
+        /** @return the unit vector towards @p ra, @p dec */
+        static Eigen::Vector3d unitVector(const CachingDms &ra, const CachingDms &dec);
+
+    private:
+        std::shared_ptr<const KSNumbers> m_Numbers;
+        CachingDms m_LST;
+        CachingDms m_Latitude;
+        Eigen::Matrix3d m_PrecessionNutation;
+        Eigen::Vector3d m_Aberration;
+        Eigen::Matrix3d m_EquatorialToHorizontal;
+        bool m_Valid { false };
+};
@@ -7,6 +7,7 @@
 #include "opsadvanced.h"
 
 #include "kspaths.h"
+#include "auxiliary/executors.h"
 #include "kstars.h"
 #include "ksutils.h"
 #include "Options.h"
@@ -57,6 +58,10 @@ OpsAdvanced::OpsAdvanced() : QFrame(KStars::Instance())
         SkyMap::Instance()->setMouseCursorShape(static_cast<SkyMap::Cursor>(index));
     });
 
+    // The queues of the thread pools, while the page is shown
+    m_MetricsTimer.setInterval(1000);
+    connect(&m_MetricsTimer, &QTimer::timeout, this, &OpsAdvanced::slotUpdateThreadMetrics);
+
     //Get a pointer to the KConfigDialog
     KConfigDialog *m_ConfigDialog = KConfigDialog::exists("settings");
     connect(m_ConfigDialog->button(QDialogButtonBox::Apply), SIGNAL(clicked()), SLOT(slotApply()));
@@ -110,6 +115,25 @@ void OpsAdvanced::slotShowLogFiles()
 void OpsAdvanced::slotApply()
 {
     KSUtils::Logging::SyncFilterRules();
+    Executors::configure();
+}
+
+void OpsAdvanced::slotUpdateThreadMetrics()
+{
+    threadMetricsLabel->setText(Executors::summary());
+}
+
+void OpsAdvanced::showEvent(QShowEvent *event)
+{
+    QFrame::showEvent(event);
+    slotUpdateThreadMetrics();
+    m_MetricsTimer.start();
+}
+
+void OpsAdvanced::hideEvent(QHideEvent *event)
+{
+    QFrame::hideEvent(event);
+    m_MetricsTimer.stop();
 }
 
 void OpsAdvanced::slotPurge()
@@ -8,6 +8,8 @@
 
 #include "ui_opsadvanced.h"
 
+#include <QTimer>
+
 /**
  * @class OpsAdvanced
  * The Advanced Tab of the Options window.  In this Tab the user can configure
@@ -18,6 +20,7 @@
  * @li Whether centered objects are automatically labeled
  * @li whether a "transient" label is attached when the mouse "hovers" at an object.
  * @li whether to enable verbose debug output to a file which could be useful in troubleshooting any issues in KStars.
+ * @li the threads of the real-time, interactive and background pools, and their queues.
  *
  * @author Jason Harris, Jasem Mutlaq
  * @version 1.1
@@ -39,4 +42,12 @@ class OpsAdvanced : public QFrame, public Ui::OpsAdvanced
         void slotShowLogFiles();
         void slotApply();
         void slotPurge();
+        void slotUpdateThreadMetrics();
+
+    protected:
+        void showEvent(QShowEvent *event) override;
+        void hideEvent(QHideEvent *event) override;
+
+    private:
+        QTimer m_MetricsTimer;
 };
@@ -12,6 +12,7 @@
 #include "skymap.h"
 #include "skycomponents/catalogscomponent.h"
 #include "skycomponents/skymapcomposite.h"
+#include "skycomponents/starcomponent.h"
 #include "widgets/magnitudespinbox.h"
 #include "skyobject.h"
 
@@ -40,6 +41,9 @@ OpsCatalog::OpsCatalog() : QFrame(KStars::Instance())
     //    kcfg_MagLimitDrawStar->setMinimum( Options::magLimitDrawStarZoomOut() );
     //    kcfg_MagLimitDrawStarZoomOut->setMaximum( 12.0 );
 
+    kcfg_StarCacheSize->setValue(Options::starCacheSize());
+    connect(kcfg_StarCacheSize, QOverload<int>::of(&QSpinBox::valueChanged), this, [&] { isDirty = true; });
+
     kcfg_DSOCachePercentage->setValue(Options::dSOCachePercentage());
     connect(kcfg_DSOCachePercentage, &QSlider::valueChanged, this,
             [&] { isDirty = true; });
@@ -107,6 +111,10 @@ void OpsCatalog::slotApply()
     KStars::Instance()->updateTime();
     KStars::Instance()->map()->forceUpdate();
 
+    Options::setStarCacheSize(kcfg_StarCacheSize->value());
+    if (StarComponent::Instance())
+        StarComponent::Instance()->setStarCacheSize(kcfg_StarCacheSize->value());
+
     Options::setDSOCachePercentage(kcfg_DSOCachePercentage->value());
     KStars::Instance()->data()->skyComposite()->catalogsComponent()->resizeCache(
         kcfg_DSOCachePercentage->value());
@@ -134,6 +142,10 @@ void OpsCatalog::slotStarWidgets(bool on)
     //    kcfg_MagLimitDrawStar->setEnabled(on);
     kcfg_StarDensity->setEnabled(on);
     LabelStarDensity->setEnabled(on);
+    kcfg_StarCacheSize->setEnabled(on);
+    LabelStarCacheSize->setEnabled(on);
+    kcfg_TargetStarCount->setEnabled(on);
+    LabelTargetStarCount->setEnabled(on);
     //    kcfg_MagLimitDrawStarZoomOut->setEnabled(on);
     kcfg_StarLabelDensity->setEnabled(on);
     kcfg_ShowStarNames->setEnabled(on);
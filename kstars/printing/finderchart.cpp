@@ -166,3 +166,12 @@ void FinderChart::insertSectionTitle(const QString &title)
     cursor.insertBlock(titleBlockFmt, titleCharFmt);
     cursor.insertText(title);
 }
+
+void FinderChart::insertPageBreak()
+{
+    QTextCursor cursor = m_Document->rootFrame()->lastCursorPosition();
+
+    QTextBlockFormat breakBlockFmt;
+    breakBlockFmt.setPageBreakPolicy(QTextFormat::PageBreak_AlwaysBefore);
+    cursor.insertBlock(breakBlockFmt, QTextCharFormat());
+}
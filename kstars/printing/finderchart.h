@@ -77,4 +77,9 @@ class FinderChart : public KStarsDocument
      * @param title Section title.
      */
     void insertSectionTitle(const QString &title);
+
+    /**
+     * @brief Start a new page of the finder chart.
+     */
+    void insertPageBreak();
 };
@@ -0,0 +1,132 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "finderchartbatch.h"
+
+#include "detailstable.h"
+#include "finderchart.h"
+#include "fov.h"
+#include "kstarsdata.h"
+#include "Options.h"
+#include "skyobjects/skyobject.h"
+
+#include <KLocalizedString>
+
+#include <QCache>
+#include <QVector>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace
+{
+// The memory for the cached charts, in KB. Charts are only drawn on the GUI thread.
+constexpr int ChartCacheSize = 64 * 1024;
+
+// Height of the declination bands in which nearby objects are drawn one after the other
+constexpr double BandHeight = 10.0;
+
+QCache<QString, QImage> &chartCache()
+{
+    static QCache<QString, QImage> cache(ChartCacheSize);
+    return cache;
+}
+}
+
+FinderChartBatch::FinderChartBatch(FOV *fov, const QSize &imageSize) : m_Fov(fov), m_ImageSize(imageSize)
+{
+    m_Exporter.setFovShapeOverriden(true);
+    m_Exporter.setFovSymbolDrawn(true);
+}
+
+QString FinderChartBatch::cacheKey(const SkyObject *object) const
+{
+    // Charts are reused until the time moves on by a minute, which matters for solar system objects
+    KStarsData *data = KStarsData::Instance();
+    return QString("%1 %2 %3 %4 %5 %6 %7 %8")
+        .arg(object->name())
+        .arg(object->ra().Degrees(), 0, 'f', 5)
+        .arg(object->dec().Degrees(), 0, 'f', 5)
+        .arg(QString("%1 %2x%3").arg(m_Fov->name()).arg(m_Fov->sizeX()).arg(m_Fov->sizeY()))
+        .arg(QString("%1x%2").arg(m_ImageSize.width()).arg(m_ImageSize.height()))
+        .arg(Options::useAltAz() ? 1 : 0)
+        .arg(data->colorScheme()->fileName())
+        .arg(static_cast<qint64>(std::floor(data->ut().djd() * 1440.0)));
+}
+
+QImage FinderChartBatch::chart(SkyObject *object)
+{
+    const QString key = cacheKey(object);
+    if (const QImage *image = chartCache().object(key))
+        return *image;
+
+    QImage image(m_ImageSize, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    SkyPoint center = *object;
+    m_Exporter.exportFov(&center, m_Fov, &image);
+
+    chartCache().insert(key, new QImage(image), std::max<int>(1, image.sizeInBytes() / 1024));
+    return image;
+}
+
+bool FinderChartBatch::insertCharts(FinderChart *document, const QList<SkyObject *> &objects,
+                                    const std::function<bool(int)> &progress)
+{
+    // Draw along declination bands, in alternating directions of right ascension
+    QVector<int> order(objects.size());
+    std::iota(order.begin(), order.end(), 0);
+    auto band = [](const SkyObject *object)
+    {
+        return static_cast<int>(std::floor((object->dec().Degrees() + 90.0) / BandHeight));
+    };
+    std::sort(order.begin(), order.end(), [&](int a, int b)
+    {
+        const int bandA = band(objects[a]), bandB = band(objects[b]);
+        if (bandA != bandB)
+            return bandA < bandB;
+        const double raA = objects[a]->ra().Degrees(), raB = objects[b]->ra().Degrees();
+        return bandA % 2 ? raA > raB : raA < raB;
+    });
+
+    KStarsData *data      = KStarsData::Instance();
+    const bool clockActive = data->clock()->isActive();
+    if (clockActive)
+        data->clock()->stop();
+
+    QVector<QImage> charts(objects.size());
+    bool cancelled = false;
+    for (int i = 0; i < order.size(); ++i)
+    {
+        charts[order[i]] = chart(objects[order[i]]);
+        if (progress && !progress(i + 1))
+        {
+            cancelled = true;
+            break;
+        }
+    }
+
+    if (clockActive)
+        data->clock()->start();
+    if (cancelled)
+        return false;
+
+    const QString fovDescription = i18nc("%1 = FOV name, %2 = FOV X size, %3 = FOV Y size", "FOV: %1 (%2' x %3')",
+                                         m_Fov->name(), QString::number(m_Fov->sizeX()),
+                                         QString::number(m_Fov->sizeY()));
+    DetailsTable detTable;
+    for (int i = 0; i < objects.size(); ++i)
+    {
+        if (i > 0)
+            document->insertPageBreak();
+
+        document->insertSectionTitle(objects[i]->translatedLongName());
+        document->insertImage(charts[i], fovDescription, true);
+        detTable.createGeneralTable(objects[i]);
+        document->insertDetailsTable(&detTable);
+    }
+    return true;
+}
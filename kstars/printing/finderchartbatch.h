@@ -0,0 +1,58 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "simplefovexporter.h"
+
+#include <QImage>
+#include <QList>
+#include <QSize>
+#include <QString>
+
+#include <functional>
+
+class FinderChart;
+class FOV;
+class SkyObject;
+
+/**
+ * @class FinderChartBatch
+ * @brief Draws the finder charts of many objects, e.g. of an observing list, into one document.
+ *
+ * The charts are drawn through SimpleFovExporter, so the sky map is never moved. They are drawn
+ * in an order that keeps nearby objects together, so that the star blocks and sky mesh indices
+ * loaded for one chart are still cached for the next. Drawn charts are kept in a cache shared by
+ * all batches, and printing the same objects again only lays out the document.
+ */
+class FinderChartBatch
+{
+  public:
+    /**
+     * @param fov field of view of the charts.
+     * @param imageSize size of the charts in pixels, at most the size of the sky map.
+     */
+    FinderChartBatch(FOV *fov, const QSize &imageSize);
+
+    /** @return the chart of @p object, drawn or taken from the cache. */
+    QImage chart(SkyObject *object);
+
+    /**
+     * @brief Insert a page per object, with its chart and its general details, into @p document.
+     * The simulation clock is stopped while the charts are drawn.
+     * @param progress called with the number of charts drawn so far, returns false to cancel.
+     * @return false if cancelled.
+     */
+    bool insertCharts(FinderChart *document, const QList<SkyObject *> &objects,
+                      const std::function<bool(int)> &progress = nullptr);
+
+  private:
+    QString cacheKey(const SkyObject *object) const;
+
+    FOV *m_Fov { nullptr };
+    QSize m_ImageSize;
+    SimpleFovExporter m_Exporter;
+};
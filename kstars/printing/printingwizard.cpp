@@ -130,7 +130,7 @@ void PrintingWizard::beginFovCapture(SkyPoint *center, FOV *fov)
     slewAndBeginCapture(center, fov);
 }
 
-void PrintingWizard::captureFov()
+void PrintingWizard::captureFov(const SkyPoint *center)
 {
     if (m_KStars->data()->getVisibleFOVs().isEmpty())
     {
@@ -138,7 +138,17 @@ void PrintingWizard::captureFov()
     }
 
     QPixmap pixmap(m_FovImageSize);
-    m_SimpleFovExporter.exportFov(m_KStars->data()->getVisibleFOVs().first(), &pixmap);
+    SkyPoint centralPoint;
+    if (center)
+    {
+        centralPoint = *center;
+        m_SimpleFovExporter.exportFov(&centralPoint, m_KStars->data()->getVisibleFOVs().first(), &pixmap);
+    }
+    else
+    {
+        centralPoint = m_KStars->map()->getCenterPoint();
+        m_SimpleFovExporter.exportFov(m_KStars->data()->getVisibleFOVs().first(), &pixmap);
+    }
     if (m_WizFovConfigUI->isLegendEnabled())
     {
         // Set legend position, orientation and type
@@ -157,7 +167,7 @@ void PrintingWizard::captureFov()
         legend.paintLegend(&pixmap);
     }
     FovSnapshot *snapshot = new FovSnapshot(pixmap, QString(), m_KStars->data()->getVisibleFOVs().first(),
-                                            m_KStars->map()->getCenterPoint());
+                                            centralPoint);
 
     if (m_RecapturingFov)
     {
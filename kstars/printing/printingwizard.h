@@ -185,8 +185,9 @@ class PrintingWizard : public QDialog
 
     /**
           * \brief Capture current contents of FOV symbol.
+          * \param center if not null, the FOV is captured around this point without moving the SkyMap.
           */
-    void captureFov();
+    void captureFov(const SkyPoint *center = nullptr);
 
     /**
           * \brief Disable FOV capture mode.
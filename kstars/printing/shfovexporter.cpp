@@ -71,10 +71,6 @@ void ShFovExporter::centerBetweenAndCapture(const SkyPoint &ptA, const SkyPoint
     dms dec(ptA.dec().Degrees() + 0.5 * (ptB.dec().Degrees() - ptA.dec().Degrees()));
     SkyPoint between(ra, dec);
 
-    // Center SkyMap
-    m_Map->setClickedPoint(&between);
-    m_Map->slotCenter();
-
-    // Capture FOV snapshot
-    m_ParentWizard->captureFov();
+    // Capture FOV snapshot around that point, the SkyMap stays where it is
+    m_ParentWizard->captureFov(&between);
 }
@@ -43,7 +43,7 @@ class ShFovExporter
 
   private:
     /**
-     * \brief Private method: center SkyMap between two SkyPoints and capture FOV snapshot.
+     * \brief Private method: capture FOV snapshot centered between two SkyPoints.
      * \param ptA Beginning point.
      * \param ptB Ending point.
      */
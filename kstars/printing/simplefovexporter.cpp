@@ -12,19 +12,18 @@
 #include "skyqpainter.h"
 #include "fov.h"
 #include "skymapcomposite.h"
-#include "kstars/Options.h"
 
 SimpleFovExporter::SimpleFovExporter()
     : m_KSData(KStarsData::Instance()), m_Map(KStars::Instance()->map()), m_StopClock(false), m_OverrideFovShape(false),
-      m_DrawFovSymbol(false), m_PrevClockState(false), m_PrevSlewing(false), m_PrevPoint(nullptr), m_PrevZoom(0)
+      m_DrawFovSymbol(false), m_PrevClockState(false)
 {
 }
 
 void SimpleFovExporter::exportFov(SkyPoint *point, FOV *fov, QPaintDevice *pd)
 {
-    saveState(true);
+    saveState();
     pExportFov(point, fov, pd);
-    restoreState(true);
+    restoreState();
 }
 
 void SimpleFovExporter::exportFov(FOV *fov, QPaintDevice *pd)
@@ -53,39 +52,32 @@ void SimpleFovExporter::exportFov(const QList<SkyPoint *> &points, const QList<F
 {
     Q_ASSERT(points.size() == fovs.size() && fovs.size() == pds.size());
 
-    saveState(true);
+    saveState();
 
     for (int i = 0; i < points.size(); i++)
     {
         exportFov(points.value(i), fovs.at(i), pds.value(i));
     }
 
-    restoreState(true);
+    restoreState();
 }
 
 void SimpleFovExporter::exportFov(const QList<SkyPoint *> &points, FOV *fov, const QList<QPaintDevice *> &pds)
 {
     Q_ASSERT(points.size() == pds.size());
 
-    saveState(true);
+    saveState();
 
     for (int i = 0; i < points.size(); i++)
     {
         exportFov(points.at(i), fov, pds.at(i));
     }
 
-    restoreState(true);
+    restoreState();
 }
 
 void SimpleFovExporter::pExportFov(SkyPoint *point, FOV *fov, QPaintDevice *pd)
 {
-    if (point)
-    {
-        // center sky map on selected point
-        m_Map->setClickedPoint(point);
-        m_Map->slotCenter();
-    }
-
     // this is temporary 'solution' that will be changed during the implementation of printing
     // on large paper sizes (>A4), in which case it'll be desirable to export high-res FOV
     // representations
@@ -131,35 +123,38 @@ void SimpleFovExporter::pExportFov(SkyPoint *point, FOV *fov, QPaintDevice *pd)
         region = QRegion(regionX, regionY, fovSizeX, fovSizeY, QRegion::Ellipse);
     }
 
-    m_Map->setZoomFactor(zoom);
-
-    SkyQPainter painter(m_Map, pd);
-    painter.begin();
-
-    painter.drawSkyBackground();
-
-    if (!m_OverrideFovShape)
+    // the map is centered on the point only while the FOV is drawn, it never shows there
+    const SkyPoint center = point ? *point : *m_Map->focus();
+    m_Map->exportAt(center, zoom, [&]()
     {
-        painter.setClipRegion(region);
-    }
-    // translate painter coordinates - it's necessary to extract only the area of interest (FOV)
-    int dx = (m_Map->width() - pd->width()) / 2;
-    int dy = (m_Map->height() - pd->height()) / 2;
-    painter.translate(-dx, -dy);
-
-    m_KSData->skyComposite()->draw(&painter);
-    m_Map->getSkyMapDrawAbstract()->drawOverlays(painter, false);
-
-    // reset painter coordinate transform to paint FOV symbol in the center
-    painter.resetTransform();
-
-    if (m_DrawFovSymbol)
-    {
-        fov->draw(painter, zoom);
-    }
+        SkyQPainter painter(m_Map, pd);
+        painter.begin();
+
+        painter.drawSkyBackground();
+
+        if (!m_OverrideFovShape)
+        {
+            painter.setClipRegion(region);
+        }
+        // translate painter coordinates - it's necessary to extract only the area of interest (FOV)
+        int dx = (m_Map->width() - pd->width()) / 2;
+        int dy = (m_Map->height() - pd->height()) / 2;
+        painter.translate(-dx, -dy);
+
+        m_KSData->skyComposite()->draw(&painter);
+        m_Map->getSkyMapDrawAbstract()->drawOverlays(painter, false);
+
+        // reset painter coordinate transform to paint FOV symbol in the center
+        painter.resetTransform();
+
+        if (m_DrawFovSymbol)
+        {
+            fov->draw(painter, zoom);
+        }
+    });
 }
 
-void SimpleFovExporter::saveState(bool savePos)
+void SimpleFovExporter::saveState()
 {
     // stop simulation if it's not already stopped
     m_PrevClockState = m_KSData->clock()->isActive();
@@ -167,36 +162,10 @@ void SimpleFovExporter::saveState(bool savePos)
     {
         m_KSData->clock()->stop();
     }
-
-    // disable useAnimatedSlewing option
-    m_PrevSlewing = Options::useAnimatedSlewing();
-    if (m_PrevSlewing)
-    {
-        Options::setUseAnimatedSlewing(false);
-    }
-
-    // save current central point and zoom level
-    m_PrevPoint = savePos ? m_Map->focusPoint() : nullptr;
-    m_PrevZoom  = Options::zoomFactor();
 }
 
-void SimpleFovExporter::restoreState(bool restorePos)
+void SimpleFovExporter::restoreState()
 {
-    // restore previous useAnimatedSlewing option
-    if (m_PrevSlewing)
-    {
-        Options::setUseAnimatedSlewing(true);
-    }
-
-    if (restorePos)
-    {
-        // restore previous central point
-        m_Map->setClickedPoint(m_PrevPoint);
-        m_Map->slotCenter();
-    }
-    // restore previous zoom level
-    m_Map->setZoomFactor(m_PrevZoom);
-
     // restore clock state (if it was stopped)
     if (m_StopClock && m_PrevClockState)
     {
@@ -24,6 +24,7 @@ class QPaintDevice;
   * for export of multiple FOVs at once, without user interaction.
   * \note Please note that SimpleFovExporter class instances may pause simulation clock if they're configured
   * to do so (via setClockStopping() method).
+  * \note The sky map is never moved, each FOV is drawn through SkyMap::exportAt().
   * \note FOV representation's shape can be overridden (i.e. FOV image will be always rectangular) using
   * setFovShapeOverriden() method.
   */
@@ -130,16 +131,14 @@ class SimpleFovExporter
 
   private:
     /**
-          * \brief Save SkyMap state.
-          * \param savePos should be true if current position is to be saved.
+          * \brief Stop the simulation clock, if configured to do so.
           */
-    void saveState(bool savePos);
+    void saveState();
 
     /**
-          * \brief Restore saved SkyMap state.
-          * \param restorePos should be true if saved position is to be restored.
+          * \brief Restore the simulation clock stopped by saveState().
           */
-    void restoreState(bool restorePos);
+    void restoreState();
 
     /**
           * \brief Private FOV export method.
@@ -158,9 +157,6 @@ class SimpleFovExporter
     bool m_DrawFovSymbol;
 
     bool m_PrevClockState;
-    bool m_PrevSlewing;
-    SkyPoint *m_PrevPoint;
-    double m_PrevZoom;
 };
 
 #endif // SIMPLEFOVEXPORTER_H
@@ -35,3 +35,13 @@ double AzimuthalEquidistantProjector::projectionL(double x) const
 {
     return x;
 }
+
+void AzimuthalEquidistantProjector::toScreenBatch(ProjectionBatch &batch) const
+{
+    toScreenBatchAzimuthal(batch, [](const Eigen::ArrayXd & c) -> Eigen::ArrayXd
+    {
+        const Eigen::ArrayXd crad = c.acos();
+        // The limit of x / sin(x) is 1 as x -> 0, as in projectionK().
+        return (crad != 0.0).select(crad / crad.sin(), 1.0);
+    });
+}
@@ -23,6 +23,7 @@ class AzimuthalEquidistantProjector : public Projector
     double radius() const override;
     double projectionK(double x) const override;
     double projectionL(double x) const override;
+    void toScreenBatch(ProjectionBatch &batch) const override;
 };
 
 #endif // AZIMUTHALEQUIDISTANTPROJECTOR_H
@@ -60,6 +60,39 @@ Eigen::Vector2f EquirectangularProjector::toScreenVec(const SkyPoint *o, bool oR
     return p;
 }
 
+void EquirectangularProjector::toScreenBatch(ProjectionBatch &batch) const
+{
+    const int n = batch.size();
+    batch.x.resize(n);
+    batch.y.resize(n);
+    batch.visible.resize(n);
+
+    // This projection works on the angles themselves, recover them from the sines and cosines.
+    double X0, Y0;
+    if (m_vp.useAltAz)
+    {
+        X0 = m_vp.focus->az().reduce().radians();
+        Y0 = SkyPoint::refract(m_vp.focus->alt(), batch.refract).radians();
+    }
+    else
+    {
+        X0 = m_vp.focus->ra().reduce().radians();
+        Y0 = m_vp.focus->dec().radians();
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        const double X = atan2(batch.sinLon[i], batch.cosLon[i]);
+        const double Y = atan2(batch.sinLat[i], batch.cosLat[i]);
+        const double dX = KSUtils::reduceAngle(m_vp.useAltAz ? X0 - X : X - X0, -dms::PI, dms::PI);
+
+        const Eigen::Vector2f p = rst(dX, Y - Y0);
+        batch.x[i] = p[0];
+        batch.y[i] = p[1];
+        batch.visible[i] = p[0] > 0 && p[0] < m_vp.width;
+    }
+}
+
 SkyPoint EquirectangularProjector::fromScreen(const QPointF &p, dms *LST, const dms *lat, bool onlyAltAz) const
 {
     SkyPoint result;
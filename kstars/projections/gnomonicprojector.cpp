@@ -36,3 +36,11 @@ double GnomonicProjector::cosMaxFieldAngle() const
     //Don't let things approach infty.
     return 0.02;
 }
+
+void GnomonicProjector::toScreenBatch(ProjectionBatch &batch) const
+{
+    toScreenBatchAzimuthal(batch, [](const Eigen::ArrayXd & c) -> Eigen::ArrayXd
+    {
+        return 1.0 / c;
+    });
+}
@@ -24,6 +24,7 @@ class GnomonicProjector : public Projector
     double projectionK(double x) const override;
     double projectionL(double x) const override;
     double cosMaxFieldAngle() const override;
+    void toScreenBatch(ProjectionBatch &batch) const override;
 };
 
 #endif // GNOMONICPROJECTOR_H
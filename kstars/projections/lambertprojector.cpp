@@ -30,3 +30,11 @@ double LambertProjector::projectionL(double x) const
 {
     return 2.0 * asin(0.5 * x);
 }
+
+void LambertProjector::toScreenBatch(ProjectionBatch &batch) const
+{
+    toScreenBatchAzimuthal(batch, [](const Eigen::ArrayXd & c) -> Eigen::ArrayXd
+    {
+        return (2.0 / (1.0 + c)).sqrt();
+    });
+}
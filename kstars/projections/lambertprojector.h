@@ -24,6 +24,7 @@ class LambertProjector : public Projector
     double radius() const override;
     double projectionK(double x) const override;
     double projectionL(double x) const override;
+    void toScreenBatch(ProjectionBatch &batch) const override;
 };
 
 #endif // LAMBERTPROJECTOR_H
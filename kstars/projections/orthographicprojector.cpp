@@ -31,3 +31,11 @@ double OrthographicProjector::projectionL(double x) const
 {
     return asin(x);
 }
+
+void OrthographicProjector::toScreenBatch(ProjectionBatch &batch) const
+{
+    toScreenBatchAzimuthal(batch, [](const Eigen::ArrayXd & c) -> Eigen::ArrayXd
+    {
+        return Eigen::ArrayXd::Ones(c.size());
+    });
+}
@@ -0,0 +1,56 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class ProjectionBatch
+ *
+ * A block of sky points laid out as structure of arrays, projected at once by Projector::toScreenBatch().
+ * The inputs are the sines and cosines of the longitude (RA, or azimuth in horizontal mode) and latitude
+ * (Dec, or altitude) of each point, which is what the projections consume. The outputs are the screen
+ * coordinates and whether each point is on the visible part of the celestial sphere.
+ */
+class ProjectionBatch
+{
+    public:
+        /** Remove all the points, keeping the allocated memory for the next block. */
+        void clear()
+        {
+            sinLon.clear();
+            cosLon.clear();
+            sinLat.clear();
+            cosLat.clear();
+        }
+        int size() const
+        {
+            return static_cast<int>(sinLon.size());
+        }
+        /** Append a point given by its longitude and latitude, in radians. */
+        void append(double lon, double lat)
+        {
+            append(std::sin(lon), std::cos(lon), std::sin(lat), std::cos(lat));
+        }
+        /** Append a point given by the sines and cosines of its longitude and latitude. */
+        void append(double sinLongitude, double cosLongitude, double sinLatitude, double cosLatitude)
+        {
+            sinLon.push_back(sinLongitude);
+            cosLon.push_back(cosLongitude);
+            sinLat.push_back(sinLatitude);
+            cosLat.push_back(cosLatitude);
+        }
+
+        std::vector<double> sinLon, cosLon, sinLat, cosLat;
+        /** Was refraction applied to the altitudes? Only used by the non-azimuthal projections. */
+        bool refract { true };
+
+        std::vector<float> x, y;
+        std::vector<uint8_t> visible;
+};
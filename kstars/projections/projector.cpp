@@ -514,6 +514,28 @@ SkyPoint Projector::fromScreen(const QPointF &p, dms *LST, const dms *lat, bool
     return result;
 }
 
+void Projector::appendToBatch(ProjectionBatch &batch, const SkyPoint *o, bool oRefract) const
+{
+    oRefract &= m_vp.useRefraction;
+    batch.refract = oRefract;
+    if (m_vp.useAltAz)
+        batch.append(o->az().radians(), oRefract ? SkyPoint::refract(o->alt()).radians() : o->alt().radians());
+    else
+        // RA and Dec cache their sines and cosines
+        batch.append(o->ra().sin(), o->ra().cos(), o->dec().sin(), o->dec().cos());
+}
+
+void Projector::toScreenBatch(ProjectionBatch &batch) const
+{
+    toScreenBatchAzimuthal(batch, [this](const Eigen::ArrayXd & c)
+    {
+        return c.unaryExpr([this](double x)
+        {
+            return projectionK(x);
+        }).eval();
+    });
+}
+
 Eigen::Vector2f Projector::toScreenVec(const SkyPoint *o, bool oRefract, bool *onVisibleHemisphere) const
 {
     double Y, dX;
@@ -12,6 +12,7 @@
 #include "skymap.h"
 #endif
 #include "skyobjects/skypoint.h"
+#include "projectionbatch.h"
 
 #if __GNUC__ > 5
 #pragma GCC diagnostic push
@@ -134,6 +135,24 @@ class Projector
          */
         QPointF toScreen(const SkyPoint *o, bool oRefract = true, bool *onVisibleHemisphere = nullptr) const;
 
+        /**
+         * @short Append a point to a batch, with the coordinates the projection uses in the current mode.
+         * @param batch the batch to append to.
+         * @param o the point to append.
+         * @param oRefract as in toScreenVec(), must be the same for all the points of the batch.
+         */
+        void appendToBatch(ProjectionBatch &batch, const SkyPoint *o, bool oRefract = true) const;
+
+        /**
+         * @short Project all the points of a batch at once.
+         * This gives the same results as calling toScreenVec() on each point, but runs a single
+         * virtual call per batch and vectorizes the arithmetic over the points. The default
+         * implementation evaluates projectionK() point by point, each projection reimplements
+         * it with its own kernel.
+         * @param batch the points to project, its x, y and visible arrays are filled.
+         */
+        virtual void toScreenBatch(ProjectionBatch &batch) const;
+
         /**
          * @short Determine RA, Dec coordinates of the pixel at (dx, dy), which are the
          * screen pixel coordinate offsets from the center of the Sky pixmap.
@@ -351,6 +370,14 @@ class Projector
          */
         static SkyPoint pointAt(double az);
 
+        /**
+         * Batch counterpart of the azimuthal toScreenVec(), for toScreenBatch().
+         * @param kernel maps the array of cosines of the distances to the focus to the array of
+         * projectionK() values. It is inlined, so that no virtual call is made per point.
+         */
+        template <typename Kernel>
+        void toScreenBatchAzimuthal(ProjectionBatch &batch, Kernel kernel) const;
+
         KStarsData *m_data { nullptr };
         ViewParams m_vp;
         double m_sinY0 { 0 };
@@ -363,3 +390,44 @@ class Projector
         double m_xrange { 0 };
         bool m_isPoleVisible { false };
 };
+
+template <typename Kernel>
+void Projector::toScreenBatchAzimuthal(ProjectionBatch &batch, Kernel kernel) const
+{
+    using Array = Eigen::ArrayXd;
+    const Eigen::Index n = batch.size();
+    batch.x.resize(n);
+    batch.y.resize(n);
+    batch.visible.resize(n);
+    if (n == 0)
+        return;
+
+    const Eigen::Map<const Array> sinLon(batch.sinLon.data(), n), cosLon(batch.cosLon.data(), n);
+    const Eigen::Map<const Array> sinLat(batch.sinLat.data(), n), cosLat(batch.cosLat.data(), n);
+
+    // The longitude difference to the focus, as in toScreenVec(), from the angle difference identities.
+    double sinLon0, cosLon0;
+    if (m_vp.useAltAz)
+        m_vp.focus->az().SinCos(sinLon0, cosLon0);
+    else
+        m_vp.focus->ra().SinCos(sinLon0, cosLon0);
+    const double sgn = m_vp.useAltAz ? -1. : 1.;
+    const Array sindX = sgn * (sinLon * cosLon0 - cosLon * sinLon0);
+    const Array cosdX = cosLon * cosLon0 + sinLon * sinLon0;
+
+    //c is the cosine of the angular distance from the center
+    const Array c = m_sinY0 * sinLat + m_cosY0 * cosLat * cosdX;
+    const Array k = kernel(c);
+    const Array px = k * cosLat * sindX;
+    const Array py = k * (m_cosY0 * sinLat - m_sinY0 * cosLat * cosdX);
+
+    // rst() over the whole block
+    const double mirror = m_vp.mirror ? -1. : 1.;
+    const double cosR = m_vp.rotationAngle.cos(), sinR = m_vp.rotationAngle.sin();
+    Eigen::Map<Eigen::ArrayXf>(batch.x.data(), n) =
+        (m_vp.width / 2 - m_vp.zoomFactor * (px * mirror * cosR - py * sinR)).cast<float>();
+    Eigen::Map<Eigen::ArrayXf>(batch.y.data(), n) =
+        (m_vp.height / 2 - m_vp.zoomFactor * (px * mirror * sinR + py * cosR)).cast<float>();
+    Eigen::Map<Eigen::Array<uint8_t, Eigen::Dynamic, 1>>(batch.visible.data(), n) =
+                (c > cosMaxFieldAngle()).cast<uint8_t>();
+}
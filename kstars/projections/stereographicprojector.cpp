@@ -30,3 +30,11 @@ double StereographicProjector::projectionL(double x) const
 {
     return 2.0 * atan2(x, 2.0);
 }
+
+void StereographicProjector::toScreenBatch(ProjectionBatch &batch) const
+{
+    toScreenBatchAzimuthal(batch, [](const Eigen::ArrayXd & c) -> Eigen::ArrayXd
+    {
+        return 2.0 / (1.0 + c);
+    });
+}
@@ -23,6 +23,7 @@ class StereographicProjector : public Projector
     double radius() const override;
     double projectionK(double x) const override;
     double projectionL(double x) const override;
+    void toScreenBatch(ProjectionBatch &batch) const override;
 };
 
 #endif // STEREOGRAPHICPROJECTOR_H
@@ -15,6 +15,9 @@
 #include "skypainter.h"
 #include "projections/projector.h"
 
+#include <algorithm>
+#include <cmath>
+
 #define UNDEFINED_ALTITUDE -90
 
 ArtificialHorizonEntity::~ArtificialHorizonEntity()
@@ -173,10 +176,7 @@ bool ArtificialHorizonComponent::load()
 
 void ArtificialHorizonComponent::save()
 {
-    KStarsData::Instance()->userdb()->DeleteAllHorizons();
-
-    foreach (ArtificialHorizonEntity *horizon, *horizon.horizonList())
-        KStarsData::Instance()->userdb()->AddHorizon(horizon);
+    KStarsData::Instance()->userdb()->ReplaceAllHorizons(*horizon.horizonList());
 }
 
 bool ArtificialHorizonComponent::selected()
@@ -732,6 +732,7 @@ void ArtificialHorizon::precomputeConstraints() const
 void ArtificialHorizon::resetPrecomputeConstraints() const
 {
     precomputedConstraints.clear();
+    precomputedVisibilityBits.clear();
 }
 
 double ArtificialHorizon::precomputedConstraint(double azimuth) const
@@ -745,6 +746,84 @@ double ArtificialHorizon::precomputedConstraint(double azimuth) const
     return precomputedConstraints[index];
 }
 
+// The visibility bitmap has the resolution of the precomputed constraints in azimuth and altitude.
+constexpr int VISIBILITY_COLUMNS = 360 * PRECOMPUTED_RESOLUTION;
+constexpr int VISIBILITY_ROWS = 180 * PRECOMPUTED_RESOLUTION + 1;
+constexpr int VISIBILITY_WORDS = (VISIBILITY_ROWS + 63) / 64;
+
+void ArtificialHorizon::precomputeVisibility() const
+{
+    struct Constraint
+    {
+        double altitude;
+        bool ceiling;
+    };
+
+    precomputedVisibilityBits.assign(VISIBILITY_COLUMNS * VISIBILITY_WORDS, 0);
+    QVector<Constraint> constraints;
+    for (int column = 0; column < VISIBILITY_COLUMNS; ++column)
+    {
+        const double az = column / static_cast<double>(PRECOMPUTED_RESOLUTION);
+        constraints.clear();
+        for (const ArtificialHorizonEntity *horizon : m_HorizonList)
+        {
+            if (!horizon->enabled()) continue;
+            bool constraintExists = false;
+            const double constraint = horizon->altitudeConstraint(az, &constraintExists);
+            if (constraintExists)
+                constraints.append({constraint, horizon->ceiling()});
+        }
+        // Among equal altitudes, the entities stay in the order in which getConstraintAbove/Below() find them.
+        std::stable_sort(constraints.begin(), constraints.end(), [](const Constraint & a, const Constraint & b)
+        {
+            return a.altitude < b.altitude;
+        });
+
+        // Walking up the column, a cell is visible unless the closest constraint above it is not
+        // a ceiling or the closest constraint below it is, as in isVisible().
+        quint64 *bits = precomputedVisibilityBits.data() + column * VISIBILITY_WORDS;
+        int above = 0;
+        for (int row = 0; row < VISIBILITY_ROWS; ++row)
+        {
+            const double alt = row / static_cast<double>(PRECOMPUTED_RESOLUTION) - 90.0;
+            while (above < constraints.size() && constraints[above].altitude <= alt)
+                ++above;
+            int below = above - 1;
+            while (below >= 0 && constraints[below].altitude >= alt)
+                --below;
+            while (below > 0 && constraints[below - 1].altitude == constraints[below].altitude)
+                --below;
+
+            const bool blockedAbove = above < constraints.size() && !constraints[above].ceiling;
+            const bool blockedBelow = below >= 0 && constraints[below].ceiling;
+            if (!blockedAbove && !blockedBelow)
+                bits[row / 64] |= quint64(1) << (row % 64);
+        }
+    }
+}
+
+bool ArtificialHorizon::precomputedVisibility(double azimuthDegrees, double altitudeDegrees) const
+{
+    if (precomputedVisibilityBits.empty())
+        precomputeVisibility();
+
+    int column = static_cast<int>(std::lround(azimuthDegrees * PRECOMPUTED_RESOLUTION)) % VISIBILITY_COLUMNS;
+    if (column < 0)
+        column += VISIBILITY_COLUMNS;
+    const int row = std::clamp(static_cast<int>(std::lround((altitudeDegrees + 90.0) * PRECOMPUTED_RESOLUTION)), 0,
+                               VISIBILITY_ROWS - 1);
+    return (precomputedVisibilityBits[column * VISIBILITY_WORDS + row / 64] >> (row % 64)) & 1;
+}
+
+std::vector<char> ArtificialHorizon::areVisible(const double *azimuthDegrees, const double *altitudeDegrees,
+        int count) const
+{
+    std::vector<char> visible(count);
+    for (int i = 0; i < count; ++i)
+        visible[i] = precomputedVisibility(azimuthDegrees[i], altitudeDegrees[i]);
+    return visible;
+}
+
 const ArtificialHorizonEntity *ArtificialHorizon::getConstraintBelow(double azimuthDegrees, double altitudeDegrees,
         const ArtificialHorizonEntity *ignore) const
 {
@@ -782,7 +861,12 @@ bool ArtificialHorizon::isAltitudeOK(double azimuthDegrees, double altitudeDegre
         return false;
     }
     else
-        return isVisible(azimuthDegrees, altitudeDegrees, reason);
+    {
+        if (precomputedVisibility(azimuthDegrees, altitudeDegrees))
+            return true;
+        // The reason is only worked out from the entities for blocked points.
+        return reason != nullptr ? isVisible(azimuthDegrees, altitudeDegrees, reason) : false;
+    }
 }
 
 // An altitude is blocked (not visible) if either:
@@ -9,6 +9,7 @@
 #include "noprecessindex.h"
 
 #include <memory>
+#include <vector>
 
 class TestArtificialHorizon;
 
@@ -80,9 +81,17 @@ class ArtificialHorizon
 
         // Returns true if the azimuth/altitude point is not blocked by the artificial horzon entities.
         bool isVisible(double azimuthDegrees, double altitudeDegrees, QString *reason = nullptr) const;
-        // Like isVisible, but uses the cache if there are no ceiling constraints.
+        // Like isVisible, but uses the precomputed constraints if there are no ceiling constraints,
+        // and the precomputed visibility otherwise.
         bool isAltitudeOK(double azimuthDegrees, double altitudeDegrees, QString *reason) const;
 
+        // Returns, for each of the count azimuth/altitude points (degrees), whether it is not blocked.
+        // All the enabled entities, ceilings included, are rasterized into a bitmap of the visible
+        // az/alt cells, 0.1 degrees wide, on the first call after they change. The points are looked
+        // up in the bitmap, so the answers may differ from isVisible() within 0.05 degrees of a line.
+        // As for the precomputed constraints, the first call must not happen in several threads at once.
+        std::vector<char> areVisible(const double *azimuthDegrees, const double *altitudeDegrees, int count) const;
+
         // returns the (highest) altitude constraint at the given azimuth.
         // If there are no constraints, then it returns -90.
         double altitudeConstraint(double azimuthDegrees) const;
@@ -123,6 +132,11 @@ class ArtificialHorizon
         double precomputedConstraint(double azimuth) const;
         double altitudeConstraintInternal(double azimuthDegrees) const;
         mutable QVector<double> precomputedConstraints;
+
+        // The visibility bitmap, with a column of altitude bits for every azimuth.
+        void precomputeVisibility() const;
+        bool precomputedVisibility(double azimuthDegrees, double altitudeDegrees) const;
+        mutable std::vector<quint64> precomputedVisibilityBits;
         bool noCeilingConstraints { true };
         void checkForCeilings();
         friend TestArtificialHorizon;
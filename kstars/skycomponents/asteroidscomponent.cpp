@@ -40,7 +40,6 @@
 AsteroidsComponent::AsteroidsComponent(SolarSystemComposite *parent)
     : BinaryListComponent(this, "asteroids"), SolarSystemListComponent(parent)
 {
-    loadData();
 }
 
 bool AsteroidsComponent::selected()
@@ -48,6 +47,11 @@ bool AsteroidsComponent::selected()
     return Options::showAsteroids();
 }
 
+double AsteroidsComponent::magnitudeLimit() const
+{
+    return Options::magLimitAsteroid();
+}
+
 /*
  * @short Initialize the asteroids list.
  * Reads in the asteroids data from the asteroids.dat file
@@ -170,9 +174,7 @@ void AsteroidsComponent::loadDataFromText()
             appendListObject(new_asteroid);
 
             // Add name to the list of object names
-            objectNames(SkyObject::ASTEROID).append(name);
-            objectLists(SkyObject::ASTEROID)
-            .append(QPair<QString, const SkyObject *>(name, new_asteroid));
+            addToNames(SkyObject::ASTEROID, name, new_asteroid);
         });
     }
     catch (const std::runtime_error &e)
@@ -208,9 +210,14 @@ void AsteroidsComponent::draw(SkyPainter *skyp)
     // It is however assured that labelMagLimit <= showMagLimit.
     labelMagLimit = showMagLimit - 20.0 / densityLabelFactor + std::max(zoomLimit, labelMagLimit);
 
-    foreach (SkyObject *so, m_ObjectList)
+    const Cone view = viewCone();
+    for (int i = 0; i < m_ObjectList.size(); ++i)
     {
-        KSAsteroid *ast = dynamic_cast<KSAsteroid *>(so);
+        // Skips the bodies that are too faint or off the screen without computing them
+        if (!refresh(i, view))
+            continue;
+
+        KSAsteroid *ast = dynamic_cast<KSAsteroid *>(m_ObjectList[i]);
 
         if (!ast->toDraw() || std::isnan(ast->mag()) || ast->mag() > showMagLimit)
             continue;
@@ -235,8 +242,13 @@ SkyObject *AsteroidsComponent::objectNearest(SkyPoint *p, double &maxrad)
     if (!selected())
         return nullptr;
 
-    for (auto o : m_ObjectList)
+    const Cone around = cone(*p, maxrad);
+    for (int i = 0; i < m_ObjectList.size(); ++i)
     {
+        if (!refresh(i, around))
+            continue;
+
+        SkyObject *o = m_ObjectList[i];
         if (!((dynamic_cast<KSAsteroid*>(o)->toDraw())))
             continue;
 
@@ -259,9 +271,13 @@ void AsteroidsComponent::updateDataFile(bool isAutoUpdate)
     if (isAutoUpdate == false)
         downloadJob->setProgressDialogEnabled(true, i18n("Asteroid Update"),
                                               i18n("Downloading asteroids updates..."));
-    downloadJob->registerDataVerification([&](const QByteArray & data)
+    // Stream the reply to asteroids.dat, which is only replaced once it is complete
+    downloadJob->setDownloadedFileURL(QUrl::fromLocalFile(
+                                          QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("asteroids.dat")));
+    downloadJob->registerFileVerification([](const QString & fileName)
     {
-        return data.startsWith("{\"signature\"");
+        QFile file(fileName);
+        return file.open(QIODevice::ReadOnly) && file.read(12) == "{\"signature\"";
     });
 
     QObject::connect(downloadJob, SIGNAL(downloaded()), this, SLOT(downloadReady()));
@@ -282,20 +298,7 @@ void AsteroidsComponent::updateDataFile(bool isAutoUpdate)
 
 void AsteroidsComponent::downloadReady()
 {
-    // Comment the first line
-    QByteArray data = downloadJob->downloadedData();
-
-    // Write data to asteroids.dat
-    QFile file(QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation))
-               .filePath("asteroids.dat"));
-    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
-    {
-        file.write(data);
-        file.close();
-    }
-    else
-        qCWarning(KSTARS) << "Failed writing asteroid data to" << file.fileName();
-
+    // The download replaced asteroids.dat
     QString focusedAstroid;
 
 #ifdef KSTARS_LITE
@@ -38,12 +38,18 @@ class AsteroidsComponent : public QObject, public SolarSystemListComponent,
         explicit AsteroidsComponent(SolarSystemComposite *parent);
         virtual ~AsteroidsComponent() override = default;
 
+        /** @short Load the asteroids, which are left out of the constructor to shorten startup. */
+        using BinaryListComponent<KSAsteroid, AsteroidsComponent>::loadData;
+
         void draw(SkyPainter *skyp) override;
         bool selected() override;
         SkyObject *objectNearest(SkyPoint *p, double &maxrad) override;
 
         void updateDataFile(bool isAutoUpdate = false);
 
+    protected:
+        double magnitudeLimit() const override;
+
     protected slots:
         void downloadReady();
         void downloadError(const QString &errorString);
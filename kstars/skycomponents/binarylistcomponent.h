@@ -11,6 +11,7 @@
 
 #include "listcomponent.h"
 #include "binarylistcomponent.h"
+#include "auxiliary/elementtable.h"
 #include "auxiliary/kspaths.h"
 
 //TODO: Error Handling - SERIOUSLY
@@ -33,6 +34,10 @@
  * Finally, one has to add this template as a friend class upon deriving it.
  * This is a concession to the already present architecture.
  *
+ * The binary is an ElementTable of `T::Record`, which `T` has to provide along with
+ * `T::RECORD_VERSION`, `toRecord()` and a static `fromRecord()`. It is memory mapped and read
+ * in place. A binary in another format, like the former QDataStream one, is rebuilt from text.
+ *
  * File paths are determent by the means of KSPaths::writableLocation.
  */
 template <class T, typename Component>
@@ -77,15 +82,17 @@ protected:
     /**
      * @brief loadDataFromBinary
      * @short Opens the default binfile and calls `loadDataFromBinary([FILE])`
+     * @return false if the binary is missing or in another format
      */
-    virtual void loadDataFromBinary();
+    virtual bool loadDataFromBinary();
 
     /**
      * @brief loadDataFromBinary
      * @param binfile the binary file
      * @short Loads the component data from the given binary.
+     * @return false if the binary is missing or in another format
      */
-    virtual void loadDataFromBinary(QFile &binfile);
+    virtual bool loadDataFromBinary(QFile &binfile);
 
     /**
      * @brief writeBinary
@@ -139,7 +146,6 @@ protected:
 
 // Don't allow the children to mess with the Binary Version!
 private:
-    QDataStream::Version binversion = QDataStream::Qt_5_5;
     Component* parent;
 };
 
@@ -170,46 +176,42 @@ void  BinaryListComponent<T, Component>::loadData(bool dropBinaryFile)
         dropBinary();
 
     QFile binfile(filepath_bin);
-    if (binfile.exists()) {
-        loadDataFromBinary(binfile);
-    } else {
+    if (!loadDataFromBinary(binfile)) {
+        clearData();
         loadDataFromText();
         writeBinary(binfile);
     }
 }
 
 template<class T, typename Component>
-void  BinaryListComponent<T, Component>::loadDataFromBinary()
+bool  BinaryListComponent<T, Component>::loadDataFromBinary()
 {
     QFile binfile(filepath_bin);
-    loadDataFromBinary(binfile);
+    return loadDataFromBinary(binfile);
 }
 
 template<class T, typename Component>
-void  BinaryListComponent<T, Component>::loadDataFromBinary(QFile &binfile)
+bool  BinaryListComponent<T, Component>::loadDataFromBinary(QFile &binfile)
 {
-    // Open our binary file and create a Stream
-    if (binfile.open(QIODevice::ReadOnly))
+    ElementTable table;
+    if (!table.open(binfile.fileName(), T::RECORD_VERSION, sizeof(typename T::Record)))
+    {
+        if (binfile.exists())
+            qDebug() << "Rebuilding binary data of another format" << binfile.fileName();
+        return false;
+    }
+
+    // The records are read in place from the mapped file
+    parent->m_ObjectList.reserve(table.count());
+    for (int i = 0; i < table.count(); ++i)
     {
-        QDataStream in(&binfile);
-
-        // Use the specified binary version
-        // TODO: Place this into the config
-        in.setVersion(binversion);
-        in.setFloatingPointPrecision(QDataStream::DoublePrecision);
-
-        while(!in.atEnd()){
-            T *new_object = nullptr;
-            in >> new_object;
-
-            parent->appendListObject(new_object);
-            // Add name to the list of object names
-            parent->objectNames(T::TYPE).append(new_object->name());
-            parent->objectLists(T::TYPE).append(QPair<QString, const SkyObject *>(new_object->name(), new_object));
-        }
-        binfile.close();
+        T *new_object = T::fromRecord(table.record<typename T::Record>(i), table);
+
+        parent->appendListObject(new_object);
+        // Add name to the list of object names
+        parent->addToNames(T::TYPE, new_object->name(), new_object);
     }
-    else qWarning() << "Failed loading binary data from" << binfile.fileName();
+    return true;
 }
 
 template<class T, typename Component>
@@ -222,18 +224,17 @@ void  BinaryListComponent<T, Component>::writeBinary()
 template<class T, typename Component>
 void  BinaryListComponent<T, Component>::writeBinary(QFile &binfile)
 {
-    // Open our file and create a stream
-    binfile.open(QIODevice::WriteOnly | QIODevice::Truncate);
-    QDataStream out(&binfile);
-    out.setVersion(binversion);
-    out.setFloatingPointPrecision(QDataStream::DoublePrecision);
-
     // Now just dump out everything
+    ElementTable::StringPool strings;
+    QByteArray records(parent->m_ObjectList.size() * static_cast<int>(sizeof(typename T::Record)), '\0');
+    auto *record = reinterpret_cast<typename T::Record *>(records.data());
     for(auto object : parent->m_ObjectList){
-         out << *((T*)object);
+         ((T*)object)->toRecord(*record++, strings);
     }
 
-    binfile.close();
+    if (!ElementTable::write(binfile.fileName(), T::RECORD_VERSION, sizeof(typename T::Record),
+                             parent->m_ObjectList.size(), records, strings))
+        qWarning() << "Failed writing binary data to" << binfile.fileName();
 }
 
 template<class T, typename Component>
@@ -256,6 +257,5 @@ void  BinaryListComponent<T, Component>::clearData()
     parent->m_ObjectList.clear();
     parent->m_ObjectHash.clear();
 
-    parent->objectLists(T::TYPE).clear();
-    parent->objectNames(T::TYPE).clear();
+    parent->clearNames(T::TYPE);
 }
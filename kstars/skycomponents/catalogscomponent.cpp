@@ -18,6 +18,7 @@
 #include "skymapcomposite.h"
 #include "kspaths.h"
 #include "import_skycomp.h"
+#include "auxiliary/executors.h"
 
 #include <QtConcurrent>
 
@@ -31,8 +32,10 @@ CatalogsComponent::CatalogsComponent(SkyComposite *parent, const QString &db_fil
     : SkyComponent(parent)
     , m_db_manager(db_filename)
     , m_skyMesh{ SkyMesh::Create(m_db_manager.htmesh_level()) }
-    , m_mainCache(m_skyMesh->size(), calculateCacheSize(Options::dSOCachePercentage()))
-    , m_unknownMagCache(m_skyMesh->size(), calculateCacheSize(Options::dSOCachePercentage()))
+    , m_mainCache(m_skyMesh->size(), calculatePackedCacheSize(Options::dSOCachePercentage()))
+    , m_unknownMagCache(m_skyMesh->size(), calculatePackedCacheSize(Options::dSOCachePercentage()))
+    , m_mainObjects(m_skyMesh->size(), calculateCacheSize(Options::dSOCachePercentage()))
+    , m_unknownMagObjects(m_skyMesh->size(), calculateCacheSize(Options::dSOCachePercentage()))
 {
     if (load_default)
     {
@@ -47,9 +50,72 @@ CatalogsComponent::CatalogsComponent(SkyComposite *parent, const QString &db_fil
 
     m_catalog_colors = m_db_manager.get_catalog_colors();
     tryImportSkyComponents();
+
+    m_loader.setMaxThreadCount(1);
+    m_loader.setExpiryTimeout(-1);
     qCInfo(KSTARS) << "Loaded DSO catalogs.";
 }
 
+CatalogsComponent::~CatalogsComponent()
+{
+    m_loader.waitForDone();
+}
+
+void CatalogsComponent::dropCache()
+{
+    {
+        QMutexLocker _{ &m_load_mutex };
+        m_cache_generation++;
+        m_mainLoad.loaded.clear();
+        m_unknownMagLoad.loaded.clear();
+    }
+
+    m_mainCache.clear();
+    m_unknownMagCache.clear();
+    m_mainObjects.clear();
+    m_unknownMagObjects.clear();
+    m_catalog_colors = m_db_manager.get_catalog_colors();
+}
+
+void CatalogsComponent::loadInBackground(const std::vector<int> &trixels, BulkFill fill,
+                                         BackgroundLoad &load)
+{
+    const int generation   = m_cache_generation;
+    const QString &db_file = m_db_manager.db_file_name();
+
+    QtConcurrent::run(&m_loader, [this, trixels, fill, &load, generation, db_file]()
+    {
+        CatalogsDB::TrixelObjectsMap objects;
+        try
+        {
+            // closed when the loader thread finishes
+            objects = (CatalogsDB::thread_reader(db_file).*fill)(trixels);
+        }
+        catch (const CatalogsDB::DatabaseError &e)
+        {
+            // The next frames load synchronously, and report the error
+            qCCritical(KSTARS) << "Could not load catalog objects in the background, "
+                               << e.what();
+            m_loader_failed = true;
+        }
+
+        {
+            QMutexLocker _{ &m_load_mutex };
+            for (const int trixel : trixels)
+                load.queued.erase(trixel);
+
+            if (generation != m_cache_generation)
+                return;
+
+            for (auto &trixel : objects)
+                load.loaded[trixel.first] = PackedCatalogObjects(trixel.second);
+        }
+
+        QMetaObject::invokeMethod(SkyMap::Instance(), []() { SkyMap::Instance()->forceUpdate(); },
+                                  Qt::QueuedConnection);
+    });
+}
+
 double compute_maglim()
 {
     double maglim = Options::magLimitDrawDeepSky();
@@ -130,16 +196,21 @@ void CatalogsComponent::draw(SkyPainter *skyp)
     // size, remains smooth.
 
     // Helper lambda to fill the appropriate cache for a given trixel
+    // With deferred loading, the misses are left to the background loader
+    const bool deferred = skyp->deferredLoading() && !m_loader_failed;
+
     auto fillCache = [&](
-        TrixelCache<ObjectList>::element& cacheElement,
+        TrixelCache<PackedCatalogObjects>::element& cacheElement,
+        TrixelCache<MaterializedObjects>& objectCache,
         ObjectList (CatalogsDB::DBManager::*fillFunction)(const int),
         Trixel trixel
         ) -> void {
-        if (!cacheElement.is_set())
+        if (!cacheElement.is_set() && !deferred)
         {
             try
             {
-                cacheElement = (m_db_manager.*fillFunction)(trixel);
+                cacheElement = PackedCatalogObjects((m_db_manager.*fillFunction)(trixel));
+                objectCache[trixel].reset();
             }
             catch (const CatalogsDB::DatabaseError &e)
             {
@@ -156,6 +227,95 @@ void CatalogsComponent::draw(SkyPainter *skyp)
         }
     };
 
+    // Helper lambda to fill the caches of all the trixels in view which
+    // are not cached yet in one query, rather than one query per trixel
+    auto fillCaches = [&](
+        TrixelCache<PackedCatalogObjects>& cache,
+        TrixelCache<MaterializedObjects>& objectCache,
+        BulkFill fillFunction,
+        BackgroundLoad& load
+        ) -> void {
+        std::vector<int> missing;
+        MeshIterator region(m_skyMesh, DRAW_BUF);
+        while (region.hasNext())
+        {
+            const Trixel trixel = region.next();
+            if (!cache[trixel].is_set())
+                missing.push_back(trixel);
+        }
+
+        if (missing.empty())
+            return;
+
+        if (deferred)
+        {
+            // Take what the loader has finished, queue the rest
+            std::vector<int> queue;
+            QMutexLocker _{ &m_load_mutex };
+            for (const int trixel : missing)
+            {
+                auto loaded = load.loaded.find(trixel);
+                if (loaded != load.loaded.end())
+                {
+                    cache[trixel] = std::move(loaded->second);
+                    objectCache[trixel].reset();
+                    load.loaded.erase(loaded);
+                }
+                else if (load.queued.insert(trixel).second)
+                    queue.push_back(trixel);
+            }
+
+            // Loads for trixels which went out of view before they were
+            // drawn are not kept forever.
+            if (load.loaded.size() > 2 * missing.size() + 64)
+                load.loaded.clear();
+
+            if (!queue.empty())
+                loadInBackground(queue, fillFunction, load);
+            return;
+        }
+
+        try
+        {
+            auto objects = (m_db_manager.*fillFunction)(missing);
+            for (const int trixel : missing)
+            {
+                cache[trixel] = PackedCatalogObjects(objects[trixel]);
+                objectCache[trixel].reset();
+            }
+        }
+        catch (const CatalogsDB::DatabaseError &e)
+        {
+            qCCritical(KSTARS)
+                << "Could not load catalog objects in " << missing.size() << " trixels, "
+                << e.what();
+
+            KMessageBox::detailedError(
+                nullptr, i18n("Could not load catalog objects in %1 trixels", static_cast<int>(missing.size())),
+                e.what());
+
+            throw; // do not silently fail
+        }
+    };
+
+    // Helper lambda to get the full object of a packed entry, created
+    // once per cached trixel
+    const QString &db_file = m_db_manager.db_file_name();
+    auto materialize = [&](
+        TrixelCache<MaterializedObjects>::element& objects,
+        const PackedCatalogObjects& packed,
+        std::size_t index
+        ) -> CatalogObject* {
+        if (!objects.is_set())
+            objects = MaterializedObjects{};
+
+        auto found = objects.data().find(index);
+        if (found == objects.data().end())
+            found = objects.data().emplace(index, packed.object(index, db_file)).first;
+
+        return &found->second;
+    };
+
     // Helper lambda to JIT update and draw
     auto drawObjects = [&](std::vector<CatalogObject*>& objects) {
         // TODO: If we are sure that JITupdate has no side effects
@@ -190,6 +350,8 @@ void CatalogsComponent::draw(SkyPainter *skyp)
     drawListKnownMag.reserve(expectedKnownMagObjectsPerTrixel);
 
     // Handle the objects of known magnitude
+    fillCaches(m_mainCache, m_mainObjects, &CatalogsDB::DBManager::get_objects_in_trixels_no_nulls,
+               m_mainLoad);
     MeshIterator region(m_skyMesh, DRAW_BUF);
     while (region.hasNext())
     {
@@ -198,14 +360,18 @@ void CatalogsComponent::draw(SkyPainter *skyp)
 
         // Fill the cache for this trixel
         auto &objectsKnownMag = m_mainCache[trixel];
-        fillCache(objectsKnownMag, &CatalogsDB::DBManager::get_objects_in_trixel_no_nulls, trixel);
+        fillCache(objectsKnownMag, m_mainObjects,
+                  &CatalogsDB::DBManager::get_objects_in_trixel_no_nulls, trixel);
+        auto &materializedKnownMag = m_mainObjects[trixel];
+        const auto &packedKnownMag = objectsKnownMag.data();
         drawListKnownMag.clear();
 
         // Filter based on magnitude and size
-        for (const auto &object : objectsKnownMag.data())
+        for (std::size_t i = 0; i < packedKnownMag.size(); ++i)
         {
-            const auto mag          = object.mag();
-            const auto a            = object.a(); // major axis
+            const auto &object      = packedKnownMag[i];
+            const auto mag          = object.mag;
+            const auto a            = object.a; // major axis
             const double size       = a * sizeScale;
             const bool magCriterion = (mag < maglim);
 
@@ -221,7 +387,7 @@ void CatalogsComponent::draw(SkyPainter *skyp)
             if (!sizeCriterion)
                 break;
 
-            drawListKnownMag.push_back(const_cast<CatalogObject*>(&object));
+            drawListKnownMag.push_back(materialize(materializedKnownMag, packedKnownMag, i));
         }
 
         // JIT update and draw
@@ -233,24 +399,32 @@ void CatalogsComponent::draw(SkyPainter *skyp)
     {
         std::vector<CatalogObject*> drawListUnknownMag;
         drawListUnknownMag.reserve(expectedUnknownMagObjectsPerTrixel);
+        std::vector<std::size_t> visibleUnknownMag;
+        visibleUnknownMag.reserve(expectedUnknownMagObjectsPerTrixel);
         QMutex drawListUnknownMagLock;
 
+        fillCaches(m_unknownMagCache, m_unknownMagObjects,
+                   &CatalogsDB::DBManager::get_objects_in_trixels_null_mag, m_unknownMagLoad);
         MeshIterator region(m_skyMesh, DRAW_BUF);
         while (region.hasNext())
         {
             Trixel trixel = region.next();
             drawListUnknownMag.clear();
+            visibleUnknownMag.clear();
 
             // Fill cache
             auto &objectsUnknownMag = m_unknownMagCache[trixel];
-            fillCache(objectsUnknownMag, &CatalogsDB::DBManager::get_objects_in_trixel_null_mag, trixel);
+            fillCache(objectsUnknownMag, m_unknownMagObjects,
+                      &CatalogsDB::DBManager::get_objects_in_trixel_null_mag, trixel);
+            auto &packedUnknownMag = objectsUnknownMag.data();
+            const auto *firstUnknownMag = packedUnknownMag.entries().data();
 
             // Filter
-            QtConcurrent::blockingMap(
-                objectsUnknownMag.data(),
+            Executors::blockingMap(Executors::Interactive,
+                packedUnknownMag.entries(),
                 [&](const auto &object)
                 {
-                    auto a            = object.a(); // major axis
+                    auto a            = object.a; // major axis
                     double size = a * sizeScale;
 
                     // For objects of unknown mag but known size, adjust
@@ -263,15 +437,21 @@ void CatalogsComponent::draw(SkyPainter *skyp)
                         return;
 
                     bool sizeCriterion =
-                        (size > 1.0 || (size == 0 && object.type() != SkyObject::GALAXY) || zoomFactor > 10000.);
+                        (size > 1.0 || (size == 0 && object.type != SkyObject::GALAXY) || zoomFactor > 10000.);
 
                     if (!sizeCriterion)
                         return;
 
                     QMutexLocker _{&drawListUnknownMagLock};
-                    drawListUnknownMag.push_back(const_cast<CatalogObject*>(&object));
+                    visibleUnknownMag.push_back(&object - firstUnknownMag);
                 });
 
+            // The full objects are created here, the map is not thread safe
+            auto &materializedUnknownMag = m_unknownMagObjects[trixel];
+            for (const std::size_t index : visibleUnknownMag)
+                drawListUnknownMag.push_back(
+                    materialize(materializedUnknownMag, packedUnknownMag, index));
+
             // JIT update and draw
             drawObjects(drawListUnknownMag);
         }
@@ -282,6 +462,8 @@ void CatalogsComponent::draw(SkyPainter *skyp)
     // and we are not zooming
     m_mainCache.prune(num_trixels * 1.2);
     m_unknownMagCache.prune(num_trixels * 1.2);
+    m_mainObjects.prune(num_trixels * 1.2);
+    m_unknownMagObjects.prune(num_trixels * 1.2);
 };
 
 void CatalogsComponent::updateSkyMesh(SkyMap &map, MeshBufNum_t buf)
@@ -319,11 +501,9 @@ CatalogObject &CatalogsComponent::insertStaticObject(const CatalogObject &obj)
     auto &inserted = lst.back();
 
     // we don't bother with translations here
-    auto &object_list = objectLists(inserted.type());
-
-    object_list.append({ inserted.name(), &inserted });
+    addToNames(inserted.type(), inserted.name(), &inserted, false);
     if (inserted.longname() != inserted.name())
-        object_list.append({ inserted.longname(), &inserted });
+        addToNames(inserted.type(), inserted.longname(), &inserted, false);
 
     return inserted;
 }
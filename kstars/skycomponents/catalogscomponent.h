@@ -10,12 +10,17 @@
 #include "skycomponent.h"
 #include "catalogsdb.h"
 #include "catalogobject.h"
+#include "packedcatalogobjects.h"
 #include "skymesh.h"
 #include "trixelcache.h"
 #include "Options.h"
 
 #include "polyfills/qstring_hash.h"
+#include <QMutex>
+#include <QThreadPool>
+#include <atomic>
 #include <unordered_map>
+#include <unordered_set>
 
 class SkyMesh;
 class SkyMap;
@@ -43,19 +48,22 @@ class CatalogsComponent : public SkyComponent
     public:
         using ObjectList = std::vector<CatalogObject>;
 
+        /** The objects of a trixel that were drawn, by their index in the packed list */
+        using MaterializedObjects = std::unordered_map<std::size_t, CatalogObject>;
+
         /**
          * Constructs the Catalogscomponent with a \p parent and a
          * database file under the path \p db_filename. If \p load_ngc is
          * specified, an attempt is made to load the default catalog from
          * the default location into the db.
          *
-         * The lru cache for the objects will be initialized to a capacity
+         * The lru caches for the objects will be initialized to a capacity
          * configurable by Options::dSOCachePercentage.
          */
         explicit CatalogsComponent(SkyComposite *parent, const QString &db_filename,
                                    bool load_default = false);
 
-        ~CatalogsComponent() override = default;
+        ~CatalogsComponent() override;
 
         /**
          * Draws the objects in the currently visible trixels by
@@ -70,11 +78,17 @@ class CatalogsComponent : public SkyComponent
          * trixels. Setting `percentage = 100` short circuits the cache and loads
          * all the objects into memory. This is reasonable for catalog sizes up
          * to `10_000` objects.
+         *
+         * The objects are cached in their packed form for a number of
+         * trixels `packedCacheFactor` times as large, the full objects
+         * only for the trixels drawn last.
          */
         void resizeCache(const int percentage)
         {
-            m_mainCache.set_size(calculateCacheSize(percentage));
-            m_unknownMagCache.set_size(calculateCacheSize(percentage));
+            m_mainCache.set_size(calculatePackedCacheSize(percentage));
+            m_unknownMagCache.set_size(calculatePackedCacheSize(percentage));
+            m_mainObjects.set_size(calculateCacheSize(percentage));
+            m_unknownMagObjects.set_size(calculateCacheSize(percentage));
         };
 
         /**
@@ -108,12 +122,7 @@ class CatalogsComponent : public SkyComponent
          * Clear the internal cache and effectively reload all objects
          * from the database.
          */
-        void dropCache()
-        {
-            m_mainCache.clear();
-            m_unknownMagCache.clear();
-            m_catalog_colors = m_db_manager.get_catalog_colors();
-        };
+        void dropCache();
 
         /**
          * Wether to show the DSOs.
@@ -145,12 +154,23 @@ class CatalogsComponent : public SkyComponent
         /**
          * The cache holding the DSOs of known magnitude
          */
-        TrixelCache<ObjectList> m_mainCache;
+        TrixelCache<PackedCatalogObjects> m_mainCache;
 
         /**
          * The cache holding the DSOs of unknown magnitude
          */
-        TrixelCache<ObjectList> m_unknownMagCache;
+        TrixelCache<PackedCatalogObjects> m_unknownMagCache;
+
+        //@{
+        /**
+         * The full objects created from the packed caches for drawing, so
+         * that they keep their `CatalogObject::JITupdate` state and images
+         * between frames. Reset whenever the packed list of the trixel is
+         * replaced, as they refer to it by index.
+         */
+        TrixelCache<MaterializedObjects> m_mainObjects;
+        TrixelCache<MaterializedObjects> m_unknownMagObjects;
+        //@}
 
         /**
          * A trixel indexed map of lists containing manually loaded
@@ -177,15 +197,69 @@ class CatalogsComponent : public SkyComponent
          */
         CatalogsDB::ColorMap m_catalog_colors;
 
+        /** Fetches the objects of several trixels, see `DBManager::get_objects_in_trixels` */
+        using BulkFill =
+            CatalogsDB::TrixelObjectsMap (CatalogsDB::DBManager::*)(const std::vector<int> &);
+
+        /**
+         * The trixels of a cache which are being loaded in the background,
+         * and the objects loaded but not moved into the cache yet.
+         */
+        struct BackgroundLoad
+        {
+            std::unordered_set<int> queued;
+            std::unordered_map<int, PackedCatalogObjects> loaded;
+        };
+
+        /**
+         * Loads the cache misses of the frames drawn with
+         * `SkyPainter::deferredLoading`, so that they never wait on the
+         * database. A single thread which does not expire, as it keeps
+         * its `CatalogsDB::thread_reader` open.
+         */
+        QThreadPool m_loader;
+
+        /** Guards `m_mainLoad` and `m_unknownMagLoad`. */
+        QMutex m_load_mutex;
+        BackgroundLoad m_mainLoad;
+        BackgroundLoad m_unknownMagLoad;
+
+        /** Incremented by `dropCache`, the loads started before are discarded. */
+        std::atomic<int> m_cache_generation{ 0 };
+
+        /** Set when the loader failed, the misses are loaded synchronously then. */
+        std::atomic<bool> m_loader_failed{ false };
+
         //@{
         /** Helpers */
 
         void updateSkyMesh(SkyMap &map, MeshBufNum_t buf = DRAW_BUF);
+
+        /**
+         * Load the objects of the \p trixels with \p fill in the
+         * background thread, put them into \p load and repaint the sky
+         * map once they are there.
+         */
+        void loadInBackground(const std::vector<int> &trixels, BulkFill fill,
+                              BackgroundLoad &load);
         size_t calculateCacheSize(const unsigned int percentage)
         {
             return m_skyMesh->size() * percentage / 100.f;
         }
 
+        /**
+         * A packed object takes about a third of the memory of a
+         * `CatalogObject` with its strings, so the packed caches hold
+         * that many more trixels for the same budget.
+         */
+        static constexpr size_t packedCacheFactor = 3;
+
+        size_t calculatePackedCacheSize(const unsigned int percentage)
+        {
+            return std::min<size_t>(m_skyMesh->size(),
+                                    calculateCacheSize(percentage) * packedCacheFactor);
+        }
+
         /**
          * Try importing the old skycomponents database.
          */
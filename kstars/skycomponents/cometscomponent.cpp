@@ -39,7 +39,6 @@
 CometsComponent::CometsComponent(SolarSystemComposite *parent)
     : SolarSystemListComponent(parent)
 {
-    loadData();
 }
 
 bool CometsComponent::selected()
@@ -86,8 +85,7 @@ void CometsComponent::loadData()
     qDeleteAll(m_ObjectList);
     m_ObjectList.clear();
 
-    objectNames(SkyObject::COMET).clear();
-    objectLists(SkyObject::COMET).clear();
+    clearNames(SkyObject::COMET);
 
     QString file_name = KSPaths::locate(QStandardPaths::AppLocalDataLocation, QString("cometels.json.gz"));
 
@@ -150,8 +148,7 @@ void CometsComponent::loadData()
             appendListObject(com);
 
             // Add *short* name to the list of object names
-            objectNames(SkyObject::COMET).append(com->name());
-            objectLists(SkyObject::COMET).append(QPair<QString, const SkyObject *>(com->name(), com));
+            addToNames(SkyObject::COMET, com->name(), com);
         });
     }
     catch (const std::runtime_error&)
@@ -263,9 +260,13 @@ void CometsComponent::draw(SkyPainter *skyp)
     skyp->setPen(QPen(QColor("transparent")));
     skyp->setBrush(QBrush(QColor("white")));
 
-    for (auto so : m_ObjectList)
+    const Cone view = viewCone();
+    for (int i = 0; i < m_ObjectList.size(); ++i)
     {
-        KSComet *com = dynamic_cast<KSComet *>(so);
+        if (!refresh(i, view))
+            continue;
+
+        KSComet *com = dynamic_cast<KSComet *>(m_ObjectList[i]);
         double mag   = com->mag();
         if (std::isnan(mag) == 0)
         {
@@ -321,26 +322,18 @@ void CometsComponent::updateDataFile(bool isAutoUpdate)
     if (isAutoUpdate == false)
         connect(downloadJob, SIGNAL(error(QString)), this, SLOT(downloadError(QString)));
 
+    // Stream the reply to cometels.json.gz. The request is conditional, the comets are only
+    // reloaded when the file changed.
+    downloadJob->setDownloadedFileURL(QUrl::fromLocalFile(
+                                          QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("cometels.json.gz")));
+
     QUrl url = QUrl("https://www.minorplanetcenter.net/Extended_Files/cometels.json.gz");
     downloadJob->get(url);
 }
 
 void CometsComponent::downloadReady()
 {
-    // Comment the first line
-    QByteArray data = downloadJob->downloadedData();
-
-    // Write data to cometels.json.gz
-    QFile file(QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation))
-               .filePath("cometels.json.gz"));
-    if (file.open(QIODevice::WriteOnly))
-    {
-        file.write(data);
-        file.close();
-    }
-    else
-        qCWarning(KSTARS) << "Failed writing comet data to" << file.fileName();
-
+    // The download replaced cometels.json.gz
     QString focusedComet;
 
 #ifdef KSTARS_LITE
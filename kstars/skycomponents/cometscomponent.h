@@ -41,12 +41,13 @@ class CometsComponent : public QObject, public SolarSystemListComponent
         void draw(SkyPainter *skyp) override;
         void updateDataFile(bool isAutoUpdate = false);
 
+        /** @short Load the comets, which are left out of the constructor to shorten startup. */
+        void loadData();
+
     protected slots:
         void downloadReady();
         void downloadError(const QString &errorString);
 
     private:
-        void loadData();
-
         QPointer<FileDownloader> downloadJob;
 };
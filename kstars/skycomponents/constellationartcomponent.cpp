@@ -106,12 +106,21 @@ void ConstellationArtComponent::draw(SkyPainter *skyp)
 {
     Q_UNUSED(skyp)
 #ifndef KSTARS_LITE
-    if (Options::showConstellationArt() && SkyMap::IsSlewing() == false)
+    // While slewing nothing is drawn, the images are kept until the view settles
+    if (SkyMap::IsSlewing())
+        return;
+
+    m_Frame++;
+    const bool show = Options::showConstellationArt();
+
+    //Loops through the QList containing all data required to draw constellations.
+    //Images are loaded when first drawn, and freed once off screen or hidden for a while.
+    for (ConstellationsArt *art : m_ConstList)
     {
-        for (int i = 0; i < records; i++)
-            skyp->drawConstellationArtImage(m_ConstList[i]);
+        if (show && skyp->drawConstellationArtImage(art))
+            art->setLastDrawn(m_Frame);
+        else if (art->isImageLoaded() && (!show || m_Frame - art->lastDrawn() > RELEASE_FRAMES))
+            art->releaseImage();
     }
-
-//Loops through the QList containing all data required to draw constellations.
 #endif
 }
@@ -15,6 +15,8 @@ class CultureList;
  * @class ConstellationArtComponent
  * Represents the ConstellationsArt objects.
  * For each skyculture there is a separate table in skycultures.sqlite.
+ * The images are loaded once a constellation is drawn, at the level of detail of the zoom, and freed
+ * once it has been off screen for a while.
  * @author M.S.Adityan
  * @version 0.1
  */
@@ -51,4 +53,8 @@ class ConstellationArtComponent : public SkyComponent
   private:
     QString cultureName;
     int records { 0 };
+
+    // Frames drawn, and the frames after which the images of constellations not drawn are freed
+    quint64 m_Frame { 0 };
+    static constexpr quint64 RELEASE_FRAMES = 50;
 };
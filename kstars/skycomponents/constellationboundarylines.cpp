@@ -19,6 +19,7 @@
 #include "skypainter.h"
 #include "htmesh/MeshIterator.h"
 #include "skycomponents/skymapcomposite.h"
+#include "skycomponents/skysnapshot.h"
 
 #include <QHash>
 
@@ -44,6 +45,14 @@ ConstellationBoundaryLines::ConstellationBoundaryLines(SkyComposite *parent)
 
     intro();
 
+    // The parsed and indexed boundaries are mapped from the cache after the first start
+    SkySnapshot snapshot("cbounds", { fname });
+    if (snapshot.open())
+    {
+        loadBoundaries(snapshot);
+        return;
+    }
+
     // Open the .idx file and skip past the first line
     KSFileReader idxReader, *idxFile = nullptr;
     QString idxFname = QString("cbounds-%1.idx").arg(SkyMesh::Instance()->level());
@@ -72,11 +81,11 @@ ConstellationBoundaryLines::ConstellationBoundaryLines(SkyComposite *parent)
         if (line.at(0) == ':') // :constellation line
         {
             if (lineList.get())
-                appendLine(lineList);
+                appendLine(lineList, &snapshot);
             lineList.reset();
 
             if (polyList.get())
-                appendPoly(polyList, idxFile, verbose);
+                appendPoly(polyList, idxFile, verbose, &snapshot);
             QString cName = line.mid(1);
             polyList.reset(new PolyList(cName));
             if (verbose == -1)
@@ -127,16 +136,54 @@ ConstellationBoundaryLines::ConstellationBoundaryLines(SkyComposite *parent)
         else
         {
             if (lineList.get())
-                appendLine(lineList);
+                appendLine(lineList, &snapshot);
             lineList.reset();
             lastRa = lastDec = -1000.0;
         }
     }
 
     if (lineList.get())
-        appendLine(lineList);
+        appendLine(lineList, &snapshot);
     if (polyList.get())
-        appendPoly(polyList, idxFile, verbose);
+        appendPoly(polyList, idxFile, verbose, &snapshot);
+
+    if (!snapshot.write())
+        qDebug() << Q_FUNC_INFO << "Could not write the snapshot of" << fname;
+}
+
+void ConstellationBoundaryLines::loadBoundaries(const SkySnapshot &snapshot)
+{
+    loadSnapshot(snapshot);
+
+    KStarsData *data = KStarsData::Instance();
+    for (const auto &lineList : listList())
+    {
+        for (const auto &point : *lineList->points())
+            point->EquatorialToHorizontal(data->lst(), data->geo()->lat());
+    }
+
+    std::shared_ptr<PolyList> polyList;
+    for (int i = 0; i < snapshot.count(); i++)
+    {
+        const SkySnapshot::Record &record = snapshot.record(i);
+        switch (record.kind)
+        {
+            case SkySnapshot::POLYGON:
+                polyList.reset(new PolyList(snapshot.string(record.value)));
+                polyList->setWrapRA(record.flag);
+                break;
+            case SkySnapshot::VERTEX:
+                if (polyList)
+                    polyList->append(QPointF(record.ra, record.dec));
+                break;
+            case SkySnapshot::POLYGON_TRIXEL:
+                if (polyList && static_cast<int>(record.value) < m_polyIndex.size())
+                    m_polyIndex[record.value]->append(polyList);
+                break;
+            default:
+                break;
+        }
+    }
 }
 
 bool ConstellationBoundaryLines::selected()
@@ -154,10 +201,14 @@ void ConstellationBoundaryLines::preDraw(SkyPainter *skyp)
     skyp->setPen(QPen(QBrush(color), 1, Qt::SolidLine));
 }
 
-void ConstellationBoundaryLines::appendPoly(std::shared_ptr<PolyList> &polyList, KSFileReader *file, int debug)
+void ConstellationBoundaryLines::appendPoly(std::shared_ptr<PolyList> &polyList, KSFileReader *file, int debug,
+        SkySnapshot *snapshot)
 {
     if (!file || debug == -1)
-        return appendPoly(polyList, debug);
+        return appendPoly(polyList, debug, snapshot);
+
+    if (snapshot)
+        snapshot->addPolygon(polyList->name(), polyList->wrapRA(), *polyList->poly());
 
     while (file->hasMoreLines())
     {
@@ -166,15 +217,20 @@ void ConstellationBoundaryLines::appendPoly(std::shared_ptr<PolyList> &polyList,
             return;
         Trixel trixel = line.toInt();
 
+        if (snapshot)
+            snapshot->addTrixel(SkySnapshot::POLYGON_TRIXEL, trixel);
         m_polyIndex[trixel]->append(polyList);
     }
 }
 
-void ConstellationBoundaryLines::appendPoly(const std::shared_ptr<PolyList> &polyList, int debug)
+void ConstellationBoundaryLines::appendPoly(const std::shared_ptr<PolyList> &polyList, int debug, SkySnapshot *snapshot)
 {
     if (debug >= 0 && debug < m_skyMesh->debug())
         debug = m_skyMesh->debug();
 
+    if (snapshot)
+        snapshot->addPolygon(polyList->name(), polyList->wrapRA(), *polyList->poly());
+
     const IndexHash &indexHash     = m_skyMesh->indexPoly(polyList->poly());
     IndexHash::const_iterator iter = indexHash.constBegin();
     while (iter != indexHash.constEnd())
@@ -184,6 +240,8 @@ void ConstellationBoundaryLines::appendPoly(const std::shared_ptr<PolyList> &pol
 
         if (debug == -1)
             printf("%d\n", trixel);
+        if (snapshot)
+            snapshot->addTrixel(SkySnapshot::POLYGON_TRIXEL, trixel);
 
         m_polyIndex[trixel]->append(polyList);
     }
@@ -14,6 +14,7 @@
 class PolyList;
 class ConstellationBoundary;
 class KSFileReader;
+class SkySnapshot;
 
 typedef QVector<std::shared_ptr<PolyList>> PolyListList;
 typedef QVector<std::shared_ptr<PolyListList>> PolyIndex;
@@ -48,14 +49,20 @@ class ConstellationBoundaryLines : public NoPrecessIndex
     void preDraw(SkyPainter *skyp) override;
 
   private:
-    void appendPoly(const std::shared_ptr<PolyList> &polyList, int debug = 0);
+    void appendPoly(const std::shared_ptr<PolyList> &polyList, int debug = 0, SkySnapshot *snapshot = nullptr);
 
     /**
      * @short reads the indices from the KSFileReader instead of using
      * the SkyMesh to create them.  If the file pointer is null or if
      * debug == -1 then we fall back to using the index.
      */
-    void appendPoly(std::shared_ptr<PolyList> &polyList, KSFileReader *file, int debug);
+    void appendPoly(std::shared_ptr<PolyList> &polyList, KSFileReader *file, int debug, SkySnapshot *snapshot = nullptr);
+
+    /**
+     * @short loads the boundary lines and the indexed polygons from the
+     * snapshot written on a previous start.
+     */
+    void loadBoundaries(const SkySnapshot &snapshot);
 
     PolyList *ContainingPoly(const SkyPoint *p) const;
 
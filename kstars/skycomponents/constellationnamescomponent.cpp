@@ -15,13 +15,12 @@
 #endif
 #include "projections/projector.h"
 #include "skycomponents/culturelist.h"
-
-#include <QtConcurrent>
+#include "auxiliary/executors.h"
 
 ConstellationNamesComponent::ConstellationNamesComponent(SkyComposite *parent, CultureList *cultures)
     : ListComponent(parent)
 {
-    QtConcurrent::run(this, &ConstellationNamesComponent::loadData, cultures);
+    Executors::run(Executors::Background, &ConstellationNamesComponent::loadData, this, cultures);
 }
 
 void ConstellationNamesComponent::loadData(CultureList *cultures)
@@ -84,8 +83,7 @@ void ConstellationNamesComponent::loadData(CultureList *cultures)
             appendListObject(o);
 
             //Add name to the list of object names
-            objectNames(SkyObject::CONSTELLATION).append(name);
-            objectLists(SkyObject::CONSTELLATION).append(QPair<QString, const SkyObject *>(name, o));
+            addToNames(SkyObject::CONSTELLATION, name, o);
         }
     }
 }
@@ -18,11 +18,16 @@
 #include "starcomponent.h"
 #include "htmesh/MeshIterator.h"
 #include "projections/projector.h"
+#include "auxiliary/executors.h"
 
 #include <qplatformdefs.h>
+#include <QPair>
 #include <QtConcurrent>
 #include <QElapsedTimer>
 
+#include <cmath>
+#include <cstring>
+
 #include <kstars_debug.h>
 
 #ifdef _WIN32
@@ -34,6 +39,7 @@ DeepStarComponent::DeepStarComponent(SkyComposite *parent, QString fileName, flo
       dataFileName(fileName)
 {
     fileOpened = false;
+    m_prefetchPool.setMaxThreadCount(1);
     openDataFile();
     if (staticStars)
         loadStaticStars();
@@ -42,6 +48,8 @@ DeepStarComponent::DeepStarComponent(SkyComposite *parent, QString fileName, flo
 
 DeepStarComponent::~DeepStarComponent()
 {
+    // The worker reads the mapping, which is released with the file.
+    m_prefetchPool.waitForDone();
     if (fileOpened)
         starReader.closeFile();
     fileOpened = false;
@@ -289,6 +297,7 @@ void DeepStarComponent::draw(SkyPainter *skyp)
         maglim = hideStarsMag;
 
     StarBlockFactory *m_StarBlockFactory = StarBlockFactory::Instance();
+    const Projector *proj = map->projector();
     //    m_StarBlockFactory->drawID = m_skyMesh->drawID();
     //    qDebug() << Q_FUNC_INFO << "Mesh size = " << m_skyMesh->size() << "; drawID = " << m_skyMesh->drawID();
     QElapsedTimer t;
@@ -327,6 +336,9 @@ void DeepStarComponent::draw(SkyPainter *skyp)
         region.reset();
     }
 
+    // Gather the stars which may be visible, then project them all at once.
+    m_drawStars.clear();
+    m_drawBatch.clear();
     while (region.hasNext())
     {
         ++nTrixels;
@@ -341,9 +353,15 @@ void DeepStarComponent::draw(SkyPainter *skyp)
         if (currentRegion >= m_starBlockList.size())
             continue;
 
+        // With a target star count, the trixel only gets the brightest stars of its share
+        const int quota     = StarComponent::Instance()->starQuota(currentRegion);
+        float trixelMaglim  = maglim;
+        if (quota >= 0 && !staticStars)
+            trixelMaglim = qMin(maglim, recordMagnitude(currentRegion, quota));
+
         if (!staticStars)
         {
-            m_starBlockList.at(currentRegion)->fillToMag(maglim);
+            m_starBlockList.at(currentRegion)->fillToMag(trixelMaglim);
         }
 
         //        if (!staticStars && !m_starBlockList.at(currentRegion)->fillToMag(maglim) &&
@@ -358,45 +376,69 @@ void DeepStarComponent::draw(SkyPainter *skyp)
         //                 <<  m_starBlockList[ currentRegion ]->getBlockCount() << " blocks";
 
         // REMARK: The following should never carry state, except for const parameters like updateID and maglim
-        std::function<void(std::shared_ptr<StarBlock>)> mapFunction = [&updateID, &maglim](std::shared_ptr<StarBlock> myBlock)
+        std::function<void(std::shared_ptr<StarBlock>)> mapFunction = [&updateID, &trixelMaglim](std::shared_ptr<StarBlock> myBlock)
         {
-            for (StarObject &star : myBlock->contents())
+            const int count = myBlock->brighterThan(trixelMaglim);
+            for (int i = 0; i < count; ++i)
             {
-                if (star.updateID != updateID)
-                    star.JITupdate();
-                if (star.mag() > maglim)
-                    break;
+                StarObject *star = myBlock->star(i);
+                if (star->updateID != updateID)
+                    star->JITupdate();
             }
         };
 
-        QtConcurrent::blockingMap(m_starBlockList.at(currentRegion)->contents(), mapFunction);
+        Executors::blockingMap(Executors::Interactive, m_starBlockList.at(currentRegion)->contents(), mapFunction);
 
-        for (int i = 0; i < m_starBlockList.at(currentRegion)->getBlockCount(); ++i)
+        int candidates = 0;
+        for (int i = 0; i < m_starBlockList.at(currentRegion)->getBlockCount() && candidates != quota; ++i)
         {
             std::shared_ptr<StarBlock> block = m_starBlockList.at(currentRegion)->block(i);
             //            qDebug() << Q_FUNC_INFO << "---> Drawing stars from block " << i << " of trixel " <<
             //                currentRegion << ". SB has " << block->getStarCount() << " stars";
-            for (int j = 0; j < block->getStarCount(); j++)
+            int count = block->brighterThan(trixelMaglim);
+            if (quota >= 0)
+                count = qMin(count, quota - candidates);
+            candidates += count;
+            for (int j = 0; j < count; j++)
             {
                 StarObject *curStar = block->star(j);
 
                 //                qDebug() << Q_FUNC_INFO << "We claim that he's from trixel " << currentRegion
                 //<< ", and indexStar says he's from " << m_skyMesh->indexStar( curStar );
 
-                float mag = curStar->mag();
-
-                if (mag > maglim)
-                    break;
+                if (!proj->checkVisibility(curStar))
+                    continue;
 
-                if (skyp->drawPointSource(curStar, mag, curStar->spchar()))
-                    visibleStarCount++;
+                m_drawStars.append(curStar);
+                proj->appendToBatch(m_drawBatch, curStar);
             }
         }
 
+        StarComponent::Instance()->useStarQuota(currentRegion, candidates);
+
         // DEBUG: Uncomment to identify problems with Star Block Factory / preservation of Magnitude Order in the LRU Cache
         //        verifySBLIntegrity();
         t_drawUnnamed += t.restart();
     }
+
+    proj->toScreenBatch(m_drawBatch);
+    skyp->beginPointSources();
+    for (int i = 0; i < m_drawStars.size(); ++i)
+    {
+        if (!m_drawBatch.visible[i])
+            continue;
+
+        StarObject *curStar = m_drawStars[i];
+        const QPointF pos(m_drawBatch.x[i], m_drawBatch.y[i]);
+        if (skyp->drawProjectedPointSource(curStar, pos, curStar->mag(), curStar->spchar()))
+            visibleStarCount++;
+    }
+    skyp->endPointSources();
+    t_drawUnnamed += t.restart();
+
+    if (!staticStars)
+        prefetchAhead(focus, radius, maglim);
+
     m_skyMesh->inDraw(false);
 #ifdef PROFILE_SINCOS
     trig_calls_here += dms::trig_function_calls;
@@ -422,6 +464,117 @@ void DeepStarComponent::draw(SkyPainter *skyp)
 #endif
 }
 
+void DeepStarComponent::prefetchAhead(const SkyPoint *focus, float radius, float maglim)
+{
+#ifndef KSTARS_LITE
+    // Number of frames to look ahead
+    const double lookAhead = 4.0;
+
+    const double ra  = focus->ra().Degrees();
+    const double dec = focus->dec().Degrees();
+    double dRA = 0, dDec = 0;
+    float dRadius = 0;
+    if (m_hasLastFocus)
+    {
+        dRA = ra - m_lastFocusRA;
+        if (dRA > 180.0)
+            dRA -= 360.0;
+        else if (dRA < -180.0)
+            dRA += 360.0;
+        dDec    = dec - m_lastFocusDec;
+        dRadius = radius - m_lastRadius;
+    }
+    m_hasLastFocus = true;
+    m_lastFocusRA  = ra;
+    m_lastFocusDec = dec;
+    m_lastRadius   = radius;
+
+    // The draw aperture already covers a still view, and zooming in only needs fainter stars of the same trixels.
+    if (std::fabs(dRA) < 1e-4 && std::fabs(dDec) < 1e-4 && dRadius <= 0)
+        return;
+    if (m_prefetchRunning || starReader.getMappedData() == nullptr)
+        return;
+
+    double predictedRA = ra + lookAhead * dRA;
+    predictedRA -= 360.0 * std::floor(predictedRA / 360.0);
+    const double predictedDec = qBound(-90.0, dec + lookAhead * dDec, 90.0);
+    const float predictedRadius = qMin(90.0f, radius + qMax(0.0f, lookAhead * dRadius)) + 1.0f;
+
+    // Same coordinates as the draw aperture, without bumping the draw ID.
+    SkyPoint predicted(predictedRA / 15.0, predictedDec);
+    predicted.catalogueCoord(KStarsData::Instance()->updateNum()->julianDay());
+    m_skyMesh->index(&predicted, predictedRadius, PREFETCH_BUF);
+
+    const int recordSize = starReader.guessRecordSize();
+    QVector<QPair<qint64, qint64>> ranges;
+    MeshIterator region(m_skyMesh, PREFETCH_BUF);
+    while (region.hasNext())
+    {
+        Trixel trixel = region.next();
+        if (trixel >= m_starBlockList.size() || m_starBlockList.at(trixel)->getFaintMag() >= maglim)
+            continue;
+        const qint64 offset = starReader.getOffset(trixel);
+        const qint64 length = qint64(starReader.getRecordCount(trixel)) * recordSize;
+        if (length > 0 && offset + length <= starReader.getMappedSize())
+            ranges.append(qMakePair(offset, length));
+    }
+    if (ranges.isEmpty())
+        return;
+
+    m_prefetchRunning = true;
+    const uchar *data = starReader.getMappedData();
+    QtConcurrent::run(&m_prefetchPool, [this, data, ranges]()
+    {
+        // Touching a byte of every page has the kernel read it from the disc.
+        const qint64 pageSize = 4096;
+        uchar sum = 0;
+        for (const auto &range : ranges)
+        {
+            for (qint64 i = 0; i < range.second; i += pageSize)
+                sum ^= data[range.first + i];
+            sum ^= data[range.first + range.second - 1];
+        }
+        volatile uchar sink = sum;
+        Q_UNUSED(sink)
+        m_prefetchRunning = false;
+    });
+#else
+    Q_UNUSED(focus)
+    Q_UNUSED(radius)
+    Q_UNUSED(maglim)
+#endif
+}
+
+float DeepStarComponent::recordMagnitude(Trixel trixel, quint32 index) const
+{
+    const uchar *data = starReader.getMappedData();
+    if (data == nullptr || index >= starReader.getRecordCount(trixel))
+        return 99;
+
+    const int recordSize = starReader.guessRecordSize();
+    const qint64 offset  = starReader.getOffset(trixel) + qint64(index) * recordSize;
+    if (offset + recordSize > starReader.getMappedSize())
+        return 99;
+
+    if (recordSize == 32)
+    {
+        StarData stardata;
+        memcpy(&stardata, data + offset, sizeof(StarData));
+        if (starReader.getByteSwap())
+            byteSwap(&stardata);
+        return stardata.mag / 100.0;
+    }
+
+    DeepStarData deepstardata;
+    memcpy(&deepstardata, data + offset, sizeof(DeepStarData));
+    if (starReader.getByteSwap())
+        byteSwap(&deepstardata);
+    // Same magnitude as StarObject::init()
+    if (deepstardata.V == 30000 && deepstardata.B != 30000)
+        return (deepstardata.B - 1600) / 1000.0;
+    return deepstardata.V / 1000.0;
+}
+
 bool DeepStarComponent::openDataFile()
 {
     if (starReader.getFileHandle())
@@ -462,6 +615,9 @@ bool DeepStarComponent::openDataFile()
         if (starReader.getByteSwap())
             MSpT = bswap_16(MSpT);
         fileOpened = true;
+        // The blocks of dynamically loaded catalogs are read straight from memory while panning
+        if (!staticStars && !starReader.mapFile())
+            qCWarning(KSTARS) << "Could not map deep star catalog" << dataFileName << "in memory, reading it from disk.";
         qCInfo(KSTARS) << "  Sky Mesh Size: " << m_skyMesh->size();
         for (long int i = 0; i < m_skyMesh->size(); i++)
         {
@@ -496,18 +652,19 @@ SkyObject *DeepStarComponent::objectNearest(SkyPoint *p, double &maxrad)
     StarObject *oBest = nullptr;
 
 #ifdef KSTARS_LITE
-    m_zoomMagLimit = StarComponent::zoomMagnitudeLimit();
+    const float zoomMagLimit = StarComponent::zoomMagnitudeLimit();
+#else
+    const float zoomMagLimit = m_zoomMagLimit;
 #endif
     if (!fileOpened)
         return nullptr;
 
-    m_skyMesh->index(p, maxrad + 1.0, OBJ_NEAREST_BUF);
-
-    MeshIterator region(m_skyMesh, OBJ_NEAREST_BUF);
+    // The mesh buffers are shared with the draw, find the trixels without them.
+    std::vector<Trixel> trixels;
+    m_skyMesh->intersect(p->ra().Degrees(), p->dec().Degrees(), maxrad + 1.0, trixels);
 
-    while (region.hasNext())
+    for (Trixel currentRegion : trixels)
     {
-        Trixel currentRegion = region.next();
 
         // Safety check if the current region is in star block list
         if ((int)currentRegion >= m_starBlockList.size())
@@ -525,7 +682,7 @@ SkyObject *DeepStarComponent::objectNearest(SkyPoint *p, double &maxrad)
 #endif
                 if (!star)
                     continue;
-                if (star->mag() > m_zoomMagLimit)
+                if (star->mag() > zoomMagLimit)
                     continue;
 
                 double r = star->angularDistanceTo(p).Degrees();
@@ -549,46 +706,50 @@ SkyObject *DeepStarComponent::objectNearest(SkyPoint *p, double &maxrad)
     return oBest;
 }
 
-bool DeepStarComponent::starsInAperture(QList<StarObject *> &list, const SkyPoint &center, float radius, float maglim)
+bool DeepStarComponent::starsInAperture(QList<StarObject *> &list, const std::vector<Trixel> &trixels,
+                                        const SkyPoint &center, float radius, float maglim, bool load)
 {
     if (maglim < triggerMag)
-        return false;
-
-    // For DeepStarComponents, whether we use ra0() and dec0(), or
-    // ra() and dec(), should not matter, because the stars are
-    // repeated in all trixels that they will pass through, although
-    // the factuality of this statement needs to be verified
-
-    // Ensure that we have deprecessed the (RA, Dec) to (RA0, Dec0)
-    Q_ASSERT(center.ra0().Degrees() >= 0.0);
-    Q_ASSERT(center.dec0().Degrees() <= 90.0);
-
-    m_skyMesh->intersect(center.ra0().Degrees(), center.dec0().Degrees(), radius, (BufNum)OBJ_NEAREST_BUF);
-
-    MeshIterator region(m_skyMesh, OBJ_NEAREST_BUF);
+        return true;
 
     if (maglim < -28)
         maglim = m_FaintMagnitude;
 
-    while (region.hasNext())
+    if (!load && !staticStars)
     {
-        Trixel currentRegion = region.next();
+        for (Trixel trixel : trixels)
+        {
+            if ((int)trixel >= m_starBlockList.size())
+                continue;
+            const StarBlockList *sbl = m_starBlockList.at(trixel).get();
+            if (sbl->getFaintMag() < maglim && sbl->getStarCount() < (long)starReader.getRecordCount(trixel))
+                return false;
+        }
+    }
+
+    for (Trixel trixel : trixels)
+    {
+        // Safety check if the current region is in star block list
+        if ((int)trixel >= m_starBlockList.size())
+            continue;
+
         // FIXME: Build a better way to iterate over all stars.
         // Ideally, StarBlockList should have such a facility.
-        std::shared_ptr<StarBlockList> sbl = m_starBlockList[currentRegion];
-        sbl->fillToMag(maglim);
+        std::shared_ptr<StarBlockList> sbl = m_starBlockList.at(trixel);
+        if (load)
+            sbl->fillToMag(maglim);
         for (int i = 0; i < sbl->getBlockCount(); ++i)
         {
             std::shared_ptr<StarBlock> block = sbl->block(i);
-            for (int j = 0; j < block->getStarCount(); ++j)
+            // Stars are organized by magnitude, so this should work
+            const int count = block->brighterThan(maglim);
+            for (int j = 0; j < count; ++j)
             {
 #ifdef KSTARS_LITE
                 StarObject *star = &(block->star(j)->star);
 #else
                 StarObject *star = block->star(j);
 #endif
-                if (star->mag() > maglim)
-                    break; // Stars are organized by magnitude, so this should work
                 if (star->angularDistanceTo(&center).Degrees() <= radius)
                     list.append(star);
             }
@@ -19,9 +19,15 @@
 #include "ksnumbers.h"
 #include "listcomponent.h"
 #include "starblockfactory.h"
+#include "projections/projectionbatch.h"
 #include "skyobjects/deepstardata.h"
 #include "skyobjects/stardata.h"
 
+#include <QThreadPool>
+
+#include <atomic>
+#include <vector>
+
 class SkyLabeler;
 class SkyMesh;
 class StarBlockFactory;
@@ -76,24 +82,36 @@ class DeepStarComponent : public ListComponent
 
     inline BinFileHelper *getStarReader() { return &starReader; }
 
+    /** @return the name of the catalog file */
+    inline const QString &getFileName() const { return dataFileName; }
+
     bool verifySBLIntegrity();
 
     /**
      * @short Add to the given list, the stars from this component,
      * that lie within the specified circular aperture, and that are
      * brighter than the limiting magnitude specified.
+     *
+     * This does not use the buffers of the sky mesh, so it can run from any thread
+     * as long as the caller holds the star data lock, see StarComponent::starsInAperture().
+     * @p list The list to operate on
+     * @p trixels The trixels covering the aperture
      * @p center The center point of the aperture
      * @p radius The radius around the center point that defines the
      * aperture
-     * @p maglim Optional parameter indicating the limiting magnitude.
-     * If magnitude limit is numerically < -28, the limiting magnitude
-     * is assumed to be the limiting magnitude of the catalog (i.e. no
-     * magnitude limit)
-     * @p list The list to operate on
-     * @return false if the limiting magnitude is brighter than the
-     * trigger magnitude of the DeepStarComponent
+     * @p maglim Limiting magnitude. If magnitude limit is numerically < -28, the
+     * limiting magnitude is assumed to be the limiting magnitude of the catalog
+     * (i.e. no magnitude limit)
+     * @p load If false, the stars are only added if all the trixels are already
+     * loaded to the limiting magnitude, so that the star blocks are not modified
+     * and a read lock is enough. If true, the missing stars are loaded first,
+     * which needs the write lock.
+     * @return false if some trixels were not loaded and load was false,
+     * true otherwise. Nothing is added if the limiting magnitude is brighter
+     * than the trigger magnitude of the DeepStarComponent.
      */
-    bool starsInAperture(QList<StarObject *> &list, const SkyPoint &center, float radius, float maglim = -29);
+    bool starsInAperture(QList<StarObject *> &list, const std::vector<Trixel> &trixels, const SkyPoint &center,
+                         float radius, float maglim, bool load);
 
     // TODO: Find the right place for this method
     static void byteSwap(DeepStarData *stardata);
@@ -102,6 +120,25 @@ class DeepStarComponent : public ListComponent
     static StarBlockFactory m_StarBlockFactory;
 
   private:
+    /**
+     * @short Read ahead the catalog records of the trixels the view is heading to.
+     *
+     * The focus is extrapolated from its motion since the last frame, and the radius grows
+     * when zooming out. The records of the trixels which are not loaded yet are read from
+     * the memory mapped catalog on a worker thread, so that the next fillToMag() does not
+     * wait on the disc. Nothing is shared with the worker but the read only mapping.
+     */
+    void prefetchAhead(const SkyPoint *focus, float radius, float maglim);
+
+    /**
+     * @short Magnitude of a record of the trixel, read from the memory mapped catalog.
+     *
+     * The records of a trixel are sorted by magnitude, so the magnitude of the record
+     * @p index is the faintest to load to have @p index stars of the trixel.
+     * @return the magnitude, or 99 if the record is not in the mapped catalog
+     */
+    float recordMagnitude(Trixel trixel, quint32 index) const;
+
     SkyMesh *m_skyMesh { nullptr };
     KSNumbers m_reindexNum;
 
@@ -121,6 +158,10 @@ class DeepStarComponent : public ListComponent
     long unsigned t_drawUnnamed { 0 };
     long unsigned t_updateCache { 0 };
 
+    /// The stars to draw in this frame, projected all at once. Kept to reuse their memory.
+    QVector<StarObject *> m_drawStars;
+    ProjectionBatch m_drawBatch;
+
     QVector<std::shared_ptr<StarBlockList>> m_starBlockList;
     QHash<int, StarObject *> m_CatalogNumber;
 
@@ -131,4 +172,12 @@ class DeepStarComponent : public ListComponent
     StarData stardata;
     BinFileHelper starReader;
     QString dataFileName;
+
+    // Prefetching of the trixels ahead of the view, see prefetchAhead()
+    QThreadPool m_prefetchPool;
+    std::atomic<bool> m_prefetchRunning { false };
+    bool m_hasLastFocus { false };
+    double m_lastFocusRA { 0 };
+    double m_lastFocusDec { 0 };
+    float m_lastRadius { 0 };
 };
@@ -0,0 +1,104 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "drawprofiler.h"
+
+#include "skypainter.h"
+
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+
+void DrawProfiler::beginFrame(const SkyPainter *skyp)
+{
+    m_painter = skyp;
+    m_frame = Frame();
+    m_frame.timestamp = QDateTime::currentMSecsSinceEpoch();
+    m_lastMark = 0;
+    m_lastObjects = skyp->drawnObjects();
+    m_timer.start();
+}
+
+void DrawProfiler::mark(const char *name)
+{
+    if (m_painter == nullptr)
+        return;
+
+    const qint64 now = m_timer.nsecsElapsed();
+    const quint64 objects = m_painter->drawnObjects();
+    m_frame.components.append({ name, (now - m_lastMark) / 1e6, objects - m_lastObjects });
+    m_lastMark = now;
+    m_lastObjects = objects;
+}
+
+void DrawProfiler::endFrame()
+{
+    if (m_painter == nullptr)
+        return;
+
+    m_frame.milliseconds = m_timer.nsecsElapsed() / 1e6;
+    m_painter = nullptr;
+
+    QMutexLocker locker(&m_mutex);
+    m_frames.append(m_frame);
+    while (m_frames.size() > MAX_FRAMES)
+        m_frames.removeFirst();
+}
+
+DrawProfiler::Frame DrawProfiler::lastFrame() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_frames.isEmpty() ? Frame() : m_frames.last();
+}
+
+QString DrawProfiler::toCSV() const
+{
+    QString csv;
+    QTextStream stream(&csv);
+    stream << "timestamp,frame_ms,trixels,component,component_ms,objects\n";
+
+    QMutexLocker locker(&m_mutex);
+    for (const Frame &frame : m_frames)
+    {
+        for (const Component &component : frame.components)
+            stream << frame.timestamp << ',' << frame.milliseconds << ',' << frame.trixels << ','
+                   << component.name << ',' << component.milliseconds << ',' << component.objects << '\n';
+    }
+    stream.flush();
+    return csv;
+}
+
+QString DrawProfiler::toJSON() const
+{
+    QJsonArray frames;
+
+    QMutexLocker locker(&m_mutex);
+    for (const Frame &frame : m_frames)
+    {
+        QJsonArray components;
+        for (const Component &component : frame.components)
+        {
+            components.append(QJsonObject
+            {
+                { "name", component.name },
+                { "milliseconds", component.milliseconds },
+                { "objects", static_cast<qint64>(component.objects) }
+            });
+        }
+        frames.append(QJsonObject
+        {
+            { "timestamp", frame.timestamp },
+            { "milliseconds", frame.milliseconds },
+            { "trixels", frame.trixels },
+            { "components", components }
+        });
+    }
+    locker.unlock();
+
+    return QString::fromUtf8(QJsonDocument(frames).toJson(QJsonDocument::Compact));
+}
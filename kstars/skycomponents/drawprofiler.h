@@ -0,0 +1,86 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+class SkyPainter;
+
+/**
+ * @class DrawProfiler
+ * Measures the time spent drawing each component of the sky map.
+ *
+ * SkyMapComposite::draw() starts a frame, and marks the end of each component it draws. The time
+ * and the number of objects drawn since the previous mark are attributed to the component.
+ * The last frames are kept so that they can be shown on the sky map, or exported over D-Bus.
+ *
+ * Frames may be drawn in a background thread, the accessors can be used from any thread.
+ */
+class DrawProfiler
+{
+    public:
+        struct Component
+        {
+            const char *name;
+            double milliseconds;
+            quint64 objects;
+        };
+
+        struct Frame
+        {
+            /// Start of the frame, in milliseconds since the epoch
+            qint64 timestamp { 0 };
+            double milliseconds { 0 };
+            /// Number of trixels in the draw aperture
+            int trixels { 0 };
+            QVector<Component> components;
+        };
+
+        /**
+         * @short Start timing a new frame.
+         * @param skyp the painter used to draw the frame, which counts the objects drawn
+         */
+        void beginFrame(const SkyPainter *skyp);
+
+        /** @short Set the number of trixels in the draw aperture of the frame. */
+        void setTrixels(int trixels)
+        {
+            m_frame.trixels = trixels;
+        }
+
+        /** @short Attribute the time and objects since the previous mark to the component @p name. */
+        void mark(const char *name);
+
+        /** @short Finish the frame and add it to the history. */
+        void endFrame();
+
+        /** @return the last complete frame, empty if none was drawn yet. */
+        Frame lastFrame() const;
+
+        /** @return the history as comma separated values, one line per component of each frame. */
+        QString toCSV() const;
+
+        /** @return the history as a JSON array of frames. */
+        QString toJSON() const;
+
+    private:
+        // About ten seconds of animation
+        static constexpr int MAX_FRAMES = 300;
+
+        const SkyPainter *m_painter { nullptr };
+        QElapsedTimer m_timer;
+        qint64 m_lastMark { 0 };
+        quint64 m_lastObjects { 0 };
+        Frame m_frame;
+
+        mutable QMutex m_mutex;
+        QList<Frame> m_frames;
+};
@@ -16,6 +16,7 @@
 #endif
 #include "skypainter.h"
 #include "auxiliary/kspaths.h"
+#include "htmesh/MeshIterator.h"
 #include "projections/projector.h"
 #include "skyobjects/skypoint.h"
 
@@ -25,6 +26,9 @@
 #include <QtMath>
 #include <QStandardPaths>
 
+#include <algorithm>
+#include <cmath>
+
 FlagComponent::FlagComponent(SkyComposite *parent) : PointListComponent(parent)
 {
     // Add the default flag images to available images list
@@ -128,6 +132,8 @@ void FlagComponent::loadFromFile()
             m_LabelColors.append(QColor("red"));
         }
     }
+
+    m_IndexDirty = true;
 }
 
 void FlagComponent::saveToFile()
@@ -136,14 +142,17 @@ void FlagComponent::saveToFile()
     TODO: This is a really bad way of storing things. Adding one flag shouldn't
     involve writing a new file/table every time. Needs fixing.
     */
-    KStarsData::Instance()->userdb()->DeleteAllFlags();
+    QList<QStringList> flagList;
+    flagList.reserve(size());
 
     for (int i = 0; i < size(); ++i)
     {
-        KStarsData::Instance()->userdb()->AddFlag(QString::number(epochCoords(i).first),
-                QString::number(epochCoords(i).second), epoch(i),
-                imageName(i).replace(' ', '_'), label(i), labelColor(i).name());
+        flagList.append(QStringList() << QString::number(epochCoords(i).first)
+                        << QString::number(epochCoords(i).second) << epoch(i)
+                        << imageName(i).replace(' ', '_') << label(i) << labelColor(i).name());
     }
+
+    KStarsData::Instance()->userdb()->ReplaceAllFlags(flagList);
 }
 
 void FlagComponent::add(const SkyPoint &flagPoint, QString epoch, QString image, QString label, QColor labelColor)
@@ -170,6 +179,14 @@ void FlagComponent::add(const SkyPoint &flagPoint, QString epoch, QString image,
 
     m_Labels.append(label);
     m_LabelColors.append(labelColor);
+
+    // New flags are added to the index as it is, flags removed before rebuild it anyway
+    if (!m_IndexDirty)
+    {
+        const std::shared_ptr<SkyPoint> &point = pointList().last();
+        if (!std::isnan(point->ra0().Degrees()) && !std::isnan(point->dec0().Degrees()))
+            m_FlagIndex[SkyMesh::Instance()->index(point.get())].append(pointList().size() - 1);
+    }
 }
 
 void FlagComponent::remove(int index)
@@ -187,6 +204,9 @@ void FlagComponent::remove(int index)
     m_Labels.removeAt(index);
     m_LabelColors.removeAt(index);
 
+    // The indexes of the following flags changed
+    m_IndexDirty = true;
+
     // request SkyMap update
 #ifndef KSTARS_LITE
     SkyMap::Instance()->forceUpdate();
@@ -208,6 +228,7 @@ void FlagComponent::updateFlag(int index, const SkyPoint &flagPoint, QString epo
     toJ2000(existingFlag.get(), epoch);
 
     existingFlag->updateCoordsNow(KStarsData::Instance()->updateNum());
+    m_IndexDirty = true;
 
     m_EpochCoords.replace(index, qMakePair(flagPoint.ra().Degrees(), flagPoint.dec().Degrees()));
 
@@ -307,10 +328,14 @@ QList<int> FlagComponent::getFlagsNearPix(SkyPoint *point, int pixelRadius)
 #endif
     QPointF pos = proj->toScreen(point);
     QList<int> retVal;
-    int ptr = 0;
 
-    for (auto &cp : pointList())
+    // Only the flags of the trixels around the point can be that close, the zoom factor is in pixels per radian
+    const double radius = pixelRadius / Options::zoomFactor() * 180.0 / M_PI;
+    SkyMesh::Instance()->aperture(point, radius + 1.0, OBJ_NEAREST_BUF);
+
+    for (int ptr : flagsInBuffer(OBJ_NEAREST_BUF))
     {
+        const std::shared_ptr<SkyPoint> &cp = pointList().at(ptr);
         if (std::isnan(cp->ra().Degrees()) || std::isnan(cp->dec().Degrees()))
             continue;
         cp->EquatorialToHorizontal(KStarsData::Instance()->lst(), KStarsData::Instance()->geo()->lat());
@@ -323,13 +348,50 @@ QList<int> FlagComponent::getFlagsNearPix(SkyPoint *point, int pixelRadius)
             //point is inside pixelRadius circle
             retVal.append(ptr);
         }
-
-        ptr++;
     }
 
+    // In the order of the flags, as before the index
+    std::sort(retVal.begin(), retVal.end());
     return retVal;
 }
 
+QVector<int> FlagComponent::visibleFlags()
+{
+    return flagsInBuffer(DRAW_BUF);
+}
+
+QVector<int> FlagComponent::flagsInBuffer(MeshBufNum_t bufNum)
+{
+    if (m_IndexDirty)
+        reindex();
+
+    QVector<int> flags;
+    MeshIterator region(SkyMesh::Instance(), bufNum);
+    while (region.hasNext())
+    {
+        auto it = m_FlagIndex.constFind(region.next());
+        if (it != m_FlagIndex.constEnd())
+            flags += *it;
+    }
+    return flags;
+}
+
+void FlagComponent::reindex()
+{
+    m_FlagIndex.clear();
+
+    SkyMesh *mesh = SkyMesh::Instance();
+    for (int i = 0; i < pointList().size(); ++i)
+    {
+        const SkyPoint *point = pointList().at(i).get();
+        // Index by the J2000 coordinates, which do not change with the time
+        if (std::isnan(point->ra0().Degrees()) || std::isnan(point->dec0().Degrees()))
+            continue;
+        m_FlagIndex[mesh->index(point)].append(i);
+    }
+    m_IndexDirty = false;
+}
+
 QImage FlagComponent::imageList(int index)
 {
     if (index < 0 || index > m_Images.size() - 1)
@@ -7,11 +7,14 @@
 #pragma once
 
 #include "pointlistcomponent.h"
+#include "skymesh.h"
 
 #include <QColor>
+#include <QHash>
 #include <QImage>
 #include <QObject>
 #include <QStringList>
+#include <QVector>
 
 class SkyPainter;
 
@@ -27,6 +30,10 @@ class SkyPainter;
  * The file flags.dat stores coordinates, epoch, image name and label of each
  * flags and is read to init FlagComponent
  *
+ * Flags are indexed by the trixels of the SkyMesh of their J2000 coordinates, so
+ * that drawing them and finding them near a point only visits the flags of the
+ * trixels concerned, even with thousands of flags.
+ *
  * @author Jerome SONRIER
  * @version 1.1
  */
@@ -148,6 +155,12 @@ class FlagComponent : public QObject, public PointListComponent
      */
     QList<int> getFlagsNearPix(SkyPoint *point, int pixelRadius);
 
+    /**
+     * @short Get the flags in the trixels of the draw buffer of the SkyMesh, i.e. those which may be on screen.
+     * @return indexes of the flags
+     */
+    QVector<int> visibleFlags();
+
     /** @short Load flags from flags.dat file. */
     void loadFromFile();
 
@@ -158,6 +171,12 @@ class FlagComponent : public QObject, public PointListComponent
     // Convert from given epoch to J2000. If epoch is already J2000, do nothing
     void toJ2000(SkyPoint *p, QString epoch);
 
+    /** @return the flags in the trixels of the mesh buffer @p bufNum, indexing the flags first if needed */
+    QVector<int> flagsInBuffer(MeshBufNum_t bufNum);
+
+    /** Index all flags, after flags were removed or moved */
+    void reindex();
+
     /// List of epochs
     QStringList m_Epoch;
     /// RA/DEC stored in original epoch
@@ -172,4 +191,8 @@ class FlagComponent : public QObject, public PointListComponent
     QStringList m_Names;
     /// List of flag images
     QList<QImage> m_Images;
+    /// Indexes of the flags in each trixel
+    QHash<Trixel, QVector<int>> m_FlagIndex;
+    /// Set when indexes of flags changed, the index is built again on its next use
+    bool m_IndexDirty { true };
 };
@@ -51,6 +51,11 @@ bool HighPMStarList::append(Trixel trixel, StarObject *star, double pm)
 void HighPMStarList::setIndexTime(KSNumbers *num)
 {
     m_reindexNum = KSNumbers(*num);
+
+    // The whole index was rebuilt, follow the trixels the stars were put in.
+    m_skyMesh->setKSNumbers(num);
+    for (auto &HPStar : m_stars)
+        HPStar->trixel = m_skyMesh->indexStar(HPStar->star);
 }
 
 bool HighPMStarList::reindex(KSNumbers *num, StarIndex *starIndex)
@@ -16,12 +16,12 @@
 #include "auxiliary/kspaths.h"
 #include "ekos/auxiliary/solverutils.h"
 #include "ekos/auxiliary/stellarsolverprofile.h"
+#include "auxiliary/executors.h"
 
 #include <QTableWidget>
 #include <QImageReader>
 #include <QCheckBox>
 #include <QComboBox>
-#include <QtConcurrent>
 #include <QRegularExpression>
 
 namespace
@@ -47,6 +47,9 @@ enum ColumnIndex
 constexpr int UNPROCESSED_INDEX = 0;
 constexpr int OK_INDEX = 4;
 
+// Solve results are written to the user DB in transactions of this many.
+constexpr int SolvesPerSave = 25;
+
 // Helper to create the image overlay table.
 // Start the table, displaying the heading and timing information, common to all sessions.
 void setupTable(QTableWidget *table)
@@ -283,14 +286,16 @@ void ImageOverlayComponent::statusCellChanged(int row)
             const QComboBox *ewItem = dynamic_cast<QComboBox*>(m_ImageOverlayTable->cellWidget(row, EAST_TO_RIGHT_COL));
             m_Overlays[row].m_EastToTheRight = ewItem->currentIndex();
 
-            if (m_Overlays[row].m_Img.get() == nullptr)
+            if (m_Overlays[row].m_Tiles.get() == nullptr)
             {
                 // Load the image.
-                const QString fullFilename = QString("%1/%2").arg(m_Directory).arg(m_Overlays[row].m_Filename);
-                QImage *img = loadImageFile(fullFilename, !m_Overlays[row].m_EastToTheRight);
-                m_Overlays[row].m_Width = img->width();
-                m_Overlays[row].m_Height = img->height();
-                m_Overlays[row].m_Img.reset(img);
+                auto tiles = loadImageFile(m_Overlays[row].m_Filename, !m_Overlays[row].m_EastToTheRight);
+                if (tiles)
+                {
+                    m_Overlays[row].m_Width = tiles->width();
+                    m_Overlays[row].m_Height = tiles->height();
+                }
+                m_Overlays[row].m_Tiles = tiles;
             }
             saveToUserDB();
             QString msg = i18n("Stored OK status for %1.", m_Overlays[row].m_Filename);
@@ -447,7 +452,7 @@ void ImageOverlayComponent::updateTable()
 
 void ImageOverlayComponent::loadAllImageFiles()
 {
-    m_LoadImagesFuture = QtConcurrent::run(this, &ImageOverlayComponent::loadImageFileLoop);
+    m_LoadImagesFuture = Executors::run(Executors::Background, &ImageOverlayComponent::loadImageFileLoop, this);
 }
 
 void ImageOverlayComponent::loadImageFileLoop()
@@ -456,7 +461,7 @@ void ImageOverlayComponent::loadImageFileLoop()
     while (loadImageFile());
     int num = 0;
     for (const auto &o : m_Overlays)
-        if (o.m_Img.get() != nullptr)
+        if (o.m_Tiles.get() != nullptr)
             num++;
     emit updateLog(i18n("%1 image files loaded.", num));
     // Restore editing for the table.
@@ -464,18 +469,13 @@ void ImageOverlayComponent::loadImageFileLoop()
     m_Initialized = true;
 }
 
-QImage *ImageOverlayComponent::loadImageFile (const QString &fullFilename, bool mirror)
+// The image is kept as a pyramid of tiles in a hidden directory next to it, so that
+// only the tiles that are drawn at the current zoom are held in memory.
+QSharedPointer<ImageOverlayTiles> ImageOverlayComponent::loadImageFile(const QString &filename, bool mirror)
 {
-    QSharedPointer<QImage> tempImage(new QImage(fullFilename));
-    if (tempImage.get() == nullptr) return nullptr;
-    int scaleWidth = std::min(tempImage->width(), Options::imageOverlayMaxDimension());
-    QImage *processedImg = new QImage;
-    if (mirror)
-        *processedImg = tempImage->mirrored(true, false).scaledToWidth(scaleWidth); // It's reflected horizontally.
-    else
-        *processedImg = tempImage->scaledToWidth(scaleWidth);
-
-    return processedImg;
+    const QString fullFilename = QString("%1%2%3").arg(m_Directory).arg(QDir::separator()).arg(filename);
+    const QString tileDirectory = QString("%1/.tiles/%2").arg(m_Directory).arg(filename);
+    return ImageOverlayTiles::create(fullFilename, tileDirectory, Options::imageOverlayMaxDimension(), mirror);
 }
 
 bool ImageOverlayComponent::loadImageFile()
@@ -484,12 +484,12 @@ bool ImageOverlayComponent::loadImageFile()
 
     for (auto &o : m_Overlays)
     {
-        if (o.m_Status == o.ImageOverlay::AVAILABLE && o.m_Img.get() == nullptr)
+        if (o.m_Status == o.ImageOverlay::AVAILABLE && o.m_Tiles.get() == nullptr)
         {
-            QString fullFilename = QString("%1%2%3").arg(m_Directory).arg(QDir::separator()).arg(o.m_Filename);
-            QImage *img = loadImageFile(fullFilename, !o.m_EastToTheRight);
-            o.m_Img.reset(img);
-            updatedSomething = true;
+            o.m_Tiles = loadImageFile(o.m_Filename, !o.m_EastToTheRight);
+            // An image that can't be read doesn't keep the loop going.
+            if (o.m_Tiles.get() != nullptr)
+                updatedSomething = true;
 
             // Note: The original width and height in o.m_Width/m_Height is kept even
             // though the image was rescaled. This is to get the rendering right
@@ -579,32 +579,33 @@ void ImageOverlayComponent::loadFromUserDB()
 
 void ImageOverlayComponent::saveToUserDB()
 {
-    KStarsData::Instance()->userdb()->DeleteAllImageOverlays();
-    for (const ImageOverlay &metadata : m_Overlays)
-        KStarsData::Instance()->userdb()->AddImageOverlay(metadata);
+    KStarsData::Instance()->userdb()->ReplaceAllImageOverlays(m_Overlays);
 }
 
-void ImageOverlayComponent::solveImage(const QString &filename)
+void ImageOverlayComponent::solveImage(int row)
 {
-    if (!m_Initialized) return;
-    m_SolveButton->setText(i18n("Abort"));
-    const int solverTimeout = Options::imageOverlayTimeout();
-    auto profiles = Ekos::getDefaultAlignOptionsProfiles();
-    auto parameters = profiles.at(m_SolverProfile->currentIndex());
-    // Double search radius
-    parameters.search_radius = parameters.search_radius * 2;
+    const QString filename = m_Overlays[row].m_Filename;
+    const QString fullFilename = QString("%1/%2").arg(m_Directory).arg(filename);
 
-    m_Solver.reset(new SolverUtils(parameters, solverTimeout),  &QObject::deleteLater);
-    connect(m_Solver.get(), &SolverUtils::done, this, &ImageOverlayComponent::solverDone, Qt::UniqueConnection);
+    // Only the header is read for the size, the pixels are tiled after solving.
+    const QSize size = QImageReader(fullFilename).size();
+    m_Overlays[row].m_Width = size.width();
+    m_Overlays[row].m_Height = size.height();
 
-    if (m_RowsToSolve.size() > 1)
-        emit updateLog(i18n("Solving: %1. %2 in queue.", filename, m_RowsToSolve.size()));
-    else
-        emit updateLog(i18n("Solving: %1.", filename));
+    QSharedPointer<SolverUtils> solver(new SolverUtils(m_SolverParameters, Options::imageOverlayTimeout()),
+                                       &QObject::deleteLater);
+    connect(solver.get(), &SolverUtils::done, this,
+            [this, filename](bool timedOut, bool success, const FITSImage::Solution & solution, double elapsedSeconds)
+    {
+        solverDone(filename, timedOut, success, solution, elapsedSeconds);
+    });
+    // Waits for the solves of Align and of the FITS viewer
+    solver->setPriority(SolverUtils::BATCH_PRIORITY);
+
+    emit updateLog(i18n("Solving: %1.", fullFilename));
 
     // If the user added some RA/DEC/Scale values to the table, they will be used in the solve
     // (but aren't remembered in the DB unless the solve is successful).
-    int row = m_RowsToSolve[0];
     QString raString = m_ImageOverlayTable->item(row, RA_COL)->text().toLatin1().data();
     QString decString = m_ImageOverlayTable->item(row, DEC_COL)->text().toLatin1().data();
     QString scaleString = m_ImageOverlayTable->item(row, ARCSEC_PER_PIXEL_COL)->text().toLatin1().data();
@@ -628,12 +629,66 @@ void ImageOverlayComponent::solveImage(const QString &filename)
     {
         auto lowScale = scale * 0.75;
         auto highScale = scale * 1.25;
-        m_Solver->useScale(true, lowScale, highScale);
+        solver->useScale(true, lowScale, highScale);
     }
     if (raOK && decOK)
-        m_Solver->usePosition(true, raDMS.Degrees(), decDMS.Degrees());
+        solver->usePosition(true, raDMS.Degrees(), decDMS.Degrees());
+
+    m_Solvers.insert(filename, solver);
+    solver->runSolver(fullFilename);
+}
+
+// Keeps one solve more than SolverQueue runs at once loading its image, so that no
+// solver waits for a file, without loading the images of the whole batch.
+void ImageOverlayComponent::solveNext()
+{
+    const int workers = Options::solverQueueParallelism() + 1;
+    while (m_Solvers.size() < workers && !m_RowsToSolve.isEmpty())
+    {
+        const int row = m_RowsToSolve.takeFirst();
+        if (row >= 0 && row < m_Overlays.size())
+            solveImage(row);
+    }
+
+    if (m_Solvers.isEmpty())
+    {
+        saveSolved();
+        m_SolveButton->setText(i18n("Solve"));
+        emit updateLog(i18n("Done solving. %1 available.", numAvailable()));
+        m_TableGroupBox->setTitle(i18n("Image Overlays.  %1 images, %2 available.", m_Overlays.size(), numAvailable()));
+    }
+}
 
-    m_Solver->runSolver(filename);
+// Stores the results of the batch so far, in one transaction.
+void ImageOverlayComponent::saveSolved()
+{
+    QList<ImageOverlay> solved;
+    for (const QString &filename : m_UnsavedSolves)
+    {
+        const int row = m_Filenames.value(filename, -1);
+        if (row >= 0 && row < m_Overlays.size())
+            solved.append(m_Overlays[row]);
+    }
+    m_UnsavedSolves.clear();
+    if (!solved.isEmpty())
+        KStarsData::Instance()->userdb()->AddImageOverlays(solved);
+}
+
+// Builds the tiles of a solved overlay away from the GUI thread, and hands them over once done.
+void ImageOverlayComponent::loadImageFileInBackground(const QString &filename, bool mirror)
+{
+    const QString fullFilename = QString("%1%2%3").arg(m_Directory).arg(QDir::separator()).arg(filename);
+    const QString tileDirectory = QString("%1/.tiles/%2").arg(m_Directory).arg(filename);
+    auto watcher = new QFutureWatcher<QSharedPointer<ImageOverlayTiles>>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, filename]()
+    {
+        const int row = m_Filenames.value(filename, -1);
+        if (row >= 0 && row < m_Overlays.size())
+            m_Overlays[row].m_Tiles = watcher->result();
+        watcher->deleteLater();
+    });
+    watcher->setFuture(Executors::run(Executors::Background, &ImageOverlayTiles::create, fullFilename, tileDirectory,
+                                      Options::imageOverlayMaxDimension(), mirror));
 }
 
 void ImageOverlayComponent::tryAgain()
@@ -668,7 +723,7 @@ void ImageOverlayComponent::show()
                 emit updateLog(i18n("Can't show %1. Not plate solved.", m_Overlays[row].m_Filename));
                 return;
             }
-            if (m_Overlays[row].m_Img.get() == nullptr)
+            if (m_Overlays[row].m_Tiles.get() == nullptr)
             {
                 emit updateLog(i18n("Can't show %1. Image not loaded.", m_Overlays[row].m_Filename));
                 return;
@@ -701,8 +756,11 @@ void ImageOverlayComponent::abortSolving()
 {
     if (!m_Initialized) return;
     m_RowsToSolve.clear();
-    if (m_Solver)
-        m_Solver->abort();
+    // The solves in flight report back once aborted, their results are dropped.
+    m_BatchAborted = true;
+    for (auto &solver : m_Solvers)
+        solver->abort();
+    saveSolved();
     emit updateLog(i18n("Solving aborted."));
     m_SolveButton->setText(i18n("Solve"));
 }
@@ -715,13 +773,6 @@ void ImageOverlayComponent::startSolving()
         abortSolving();
         return;
     }
-    if (m_Solver && m_Solver->isRunning())
-    {
-        m_Solver->abort();
-        if (m_RowsToSolve.size() > 0)
-            m_TryAgainTimer.start(2000);
-        return;
-    }
 
     if (m_RowsToSolve.size() == 0)
     {
@@ -744,31 +795,40 @@ void ImageOverlayComponent::startSolving()
                 selectedRows.insert(row);
             }
         }
+        else
+        {
+            // Without a selection, all the images that aren't solved yet.
+            for (int row = 0; row < m_Overlays.size(); ++row)
+                if (m_Overlays[row].m_Status != ImageOverlay::AVAILABLE)
+                    selectedRows.insert(row);
+        }
         m_RowsToSolve.clear();
         for (int row : selectedRows)
             m_RowsToSolve.push_back(row);
+        std::sort(m_RowsToSolve.begin(), m_RowsToSolve.end());
     }
 
-    if (m_RowsToSolve.size() > 0)
-    {
-        const int row = m_RowsToSolve[0];
-        const QString filename =
-            QString("%1/%2").arg(m_Directory).arg(m_Overlays[row].m_Filename);
-        if ((m_Overlays[row].m_Status == ImageOverlay::AVAILABLE) &&
-                !shouldSolveAnyway(m_ImageOverlayTable, row))
-        {
-            emit updateLog(i18n("%1 already solved. Skipping.", filename));
-            m_RowsToSolve.removeFirst();
-            if (m_RowsToSolve.size() > 0)
-                startSolving();
-            return;
-        }
+    if (m_RowsToSolve.size() == 0)
+        return;
 
-        auto img = new QImage(filename);
-        m_Overlays[row].m_Width = img->width();
-        m_Overlays[row].m_Height = img->height();
-        solveImage(filename);
+    // Aborted solves are still winding down.
+    if (!m_Solvers.isEmpty())
+    {
+        m_TryAgainTimer.start(2000);
+        return;
     }
+
+    auto profiles = Ekos::getDefaultAlignOptionsProfiles();
+    m_SolverParameters = profiles.at(m_SolverProfile->currentIndex());
+    // Double search radius
+    m_SolverParameters.search_radius = m_SolverParameters.search_radius * 2;
+
+    m_BatchAborted = false;
+    m_BatchSize = m_RowsToSolve.size();
+    m_BatchDone = 0;
+    m_SolveButton->setText(i18n("Abort"));
+    emit updateLog(i18n("Solving %1 images, %2 at a time.", m_BatchSize, Options::solverQueueParallelism()));
+    solveNext();
 }
 
 void ImageOverlayComponent::reload()
@@ -780,27 +840,32 @@ void ImageOverlayComponent::reload()
     loadAllImageFiles();
 }
 
-void ImageOverlayComponent::solverDone(bool timedOut, bool success, const FITSImage::Solution &solution,
-                                       double elapsedSeconds)
+void ImageOverlayComponent::solverDone(const QString &filename, bool timedOut, bool success,
+                                       const FITSImage::Solution &solution, double elapsedSeconds)
 {
-    disconnect(m_Solver.get(), &SolverUtils::done, this, &ImageOverlayComponent::solverDone);
-    m_SolveButton->setText(i18n("Solve"));
-    if (m_RowsToSolve.size() == 0)
+    // Keeps the solver until its signal returns.
+    auto solver = m_Solvers.take(filename);
+    if (m_BatchAborted)
         return;
 
-    const int solverRow = m_RowsToSolve[0];
-    m_RowsToSolve.removeFirst();
+    m_BatchDone++;
+    const int solverRow = m_Filenames.value(filename, -1);
+    if (solverRow < 0 || solverRow >= m_Overlays.size())
+    {
+        solveNext();
+        return;
+    }
 
     QComboBox *statusItem = dynamic_cast<QComboBox*>(m_ImageOverlayTable->cellWidget(solverRow, STATUS_COL));
     if (timedOut)
     {
-        emit updateLog(i18n("Solver timed out in %1s", QString::number(elapsedSeconds, 'f', 1)));
+        emit updateLog(i18n("%1: Solver timed out in %2s", filename, QString::number(elapsedSeconds, 'f', 1)));
         m_Overlays[solverRow].m_Status = ImageOverlay::PLATE_SOLVE_FAILURE;
         statusItem->setCurrentIndex(static_cast<int>(m_Overlays[solverRow].m_Status));
     }
     else if (!success)
     {
-        emit updateLog(i18n("Solver failed in %1s", QString::number(elapsedSeconds, 'f', 1)));
+        emit updateLog(i18n("%1: Solver failed in %2s", filename, QString::number(elapsedSeconds, 'f', 1)));
         m_Overlays[solverRow].m_Status = ImageOverlay::PLATE_SOLVE_FAILURE;
         statusItem->setCurrentIndex(static_cast<int>(m_Overlays[solverRow].m_Status));
     }
@@ -813,7 +878,8 @@ void ImageOverlayComponent::solverDone(bool timedOut, bool success, const FITSIm
         m_Overlays[solverRow].m_EastToTheRight = solution.parity;
         m_Overlays[solverRow].m_Status = ImageOverlay::AVAILABLE;
 
-        QString msg = i18n("Solver success in %1s: RA %2 DEC %3 Scale %4 Angle %5",
+        QString msg = i18n("%1: Solver success in %2s: RA %3 DEC %4 Scale %5 Angle %6",
+                           filename,
                            QString::number(elapsedSeconds, 'f', 1),
                            QString::number(solution.ra, 'f', 2),
                            QString::number(solution.dec, 'f', 2),
@@ -834,18 +900,16 @@ void ImageOverlayComponent::solverDone(bool timedOut, bool success, const FITSIm
         QComboBox *statusItem = dynamic_cast<QComboBox*>(m_ImageOverlayTable->cellWidget(solverRow, STATUS_COL));
         statusItem->setCurrentIndex(static_cast<int>(overlay.m_Status));
 
-        // Load the image.
-        QString fullFilename = QString("%1/%2").arg(m_Directory).arg(m_Overlays[solverRow].m_Filename);
-        QImage *img = loadImageFile(fullFilename, !m_Overlays[solverRow].m_EastToTheRight);
-        m_Overlays[solverRow].m_Img.reset(img);
+        // Build the tiles of the image.
+        loadImageFileInBackground(overlay.m_Filename, !overlay.m_EastToTheRight);
     }
-    saveToUserDB();
 
-    if (m_RowsToSolve.size() > 0)
-        startSolving();
-    else
-    {
-        emit updateLog(i18n("Done solving. %1 available.", numAvailable()));
-        m_TableGroupBox->setTitle(i18n("Image Overlays.  %1 images, %2 available.", m_Overlays.size(), numAvailable()));
-    }
+    // The results are stored a few at a time, so that a long batch isn't lost if interrupted.
+    m_UnsavedSolves.append(filename);
+    if (m_UnsavedSolves.size() >= SolvesPerSave)
+        saveSolved();
+
+    m_TableGroupBox->setTitle(i18n("Image Overlays.  %1 images, %2 available.  Solved %3 of %4.",
+                                   m_Overlays.size(), numAvailable(), m_BatchDone, m_BatchSize));
+    solveNext();
 }
@@ -7,7 +7,9 @@
 #pragma once
 
 #include "imageoverlaycomponent.h"
+#include "imageoverlaytiles.h"
 #include "skycomponent.h"
+#include <QHash>
 #include <QSharedPointer>
 #include <QImage>
 #include <QObject>
@@ -56,7 +58,7 @@ class ImageOverlay
         bool m_EastToTheRight = true;
         int m_Width = 0;
         int m_Height = 0;
-        QSharedPointer<QImage> m_Img = nullptr;
+        QSharedPointer<ImageOverlayTiles> m_Tiles = nullptr;
 };
 
 /**
@@ -104,8 +106,12 @@ private slots:
 private:
     void loadFromUserDB();
     void saveToUserDB();
-    void solveImage(const QString &filename);
-    void solverDone(bool timedOut, bool success, const FITSImage::Solution &solution, double elapsedSeconds);
+    // Batch solving: up to one more solve than SolverQueue runs at once is in flight.
+    void solveImage(int row);
+    void solveNext();
+    void solverDone(const QString &filename, bool timedOut, bool success, const FITSImage::Solution &solution,
+                    double elapsedSeconds);
+    void saveSolved();
     void initializeGui();
     int numAvailable();
     void cellChanged(int row, int col);
@@ -117,7 +123,8 @@ private:
     void loadAllImageFiles();
     void loadImageFileLoop();
     bool loadImageFile();
-    QImage *loadImageFile (const QString &fullFilename, bool mirror);
+    QSharedPointer<ImageOverlayTiles> loadImageFile(const QString &filename, bool mirror);
+    void loadImageFileInBackground(const QString &filename, bool mirror);
 
 
     QTableWidget *m_ImageOverlayTable;
@@ -131,8 +138,15 @@ private:
 
     QList<ImageOverlay> m_Overlays;
     QMap<QString, int> m_Filenames;
-    QSharedPointer<SolverUtils> m_Solver;
+    // The solves in flight, by the filename of their overlay.
+    QHash<QString, QSharedPointer<SolverUtils>> m_Solvers;
+    SSolver::Parameters m_SolverParameters;
     QList<int> m_RowsToSolve;
+    int m_BatchSize = 0;
+    int m_BatchDone = 0;
+    bool m_BatchAborted = false;
+    // Solved overlays not stored in the user DB yet.
+    QStringList m_UnsavedSolves;
     QString m_Directory;
     QTimer m_TryAgainTimer;
     QFuture<void> m_LoadImagesFuture;
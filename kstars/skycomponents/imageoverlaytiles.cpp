@@ -0,0 +1,185 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "imageoverlaytiles.h"
+
+#include <kstars_debug.h>
+
+#include <QCache>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QMutex>
+
+#include <algorithm>
+
+namespace
+{
+// Bumped when the layout of the tiles on disk changes
+constexpr int PyramidVersion = 1;
+
+// The memory for tiles of all the overlays, in KB
+constexpr int TileCacheSize = 64 * 1024;
+
+QMutex &tileCacheMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+QCache<QString, QImage> &tileCache()
+{
+    static QCache<QString, QImage> cache(TileCacheSize);
+    return cache;
+}
+
+// Drop the cached tiles of a pyramid that is rebuilt
+void forgetTiles(const QString &directory)
+{
+    QMutexLocker lock(&tileCacheMutex());
+    const QString prefix = directory + '/';
+    for (const QString &key : tileCache().keys())
+    {
+        if (key.startsWith(prefix))
+            tileCache().remove(key);
+    }
+}
+}
+
+QSharedPointer<ImageOverlayTiles> ImageOverlayTiles::create(const QString &filename, const QString &directory,
+        int maxDimension, bool mirror)
+{
+    const QFileInfo info(filename);
+    if (!info.exists())
+        return QSharedPointer<ImageOverlayTiles>();
+
+    QSharedPointer<ImageOverlayTiles> tiles(new ImageOverlayTiles);
+    tiles->m_Directory = directory;
+
+    // The pyramid is reused if it was built from the same file with the same processing
+    const QString stamp = QString("%1 %2 %3 %4 %5").arg(PyramidVersion).arg(info.size())
+                          .arg(info.lastModified().toMSecsSinceEpoch()).arg(maxDimension).arg(mirror ? 1 : 0);
+    QFile stampFile(QDir(directory).filePath("pyramid"));
+    if (stampFile.open(QIODevice::ReadOnly))
+    {
+        const QStringList fields = QString::fromLatin1(stampFile.readAll()).split(' ');
+        stampFile.close();
+        if (fields.size() == 7 && fields.mid(0, 5).join(' ') == stamp)
+        {
+            const QSize size(fields[5].toInt(), fields[6].toInt());
+            if (!size.isEmpty())
+            {
+                tiles->setSizes(size);
+                tiles->m_Preview = QImage(tiles->tilePath(tiles->levels() - 1, 0, 0))
+                                   .convertToFormat(QImage::Format_ARGB32_Premultiplied);
+                if (!tiles->m_Preview.isNull())
+                    return tiles;
+            }
+        }
+    }
+
+    QImage image(filename);
+    if (image.isNull())
+        return QSharedPointer<ImageOverlayTiles>();
+    if (mirror)
+        image = image.mirrored(true, false); // It's reflected horizontally.
+    if (image.width() > maxDimension && maxDimension > 0)
+        image = image.scaledToWidth(maxDimension, Qt::SmoothTransformation);
+
+    forgetTiles(directory);
+    QDir(directory).removeRecursively();
+    QDir().mkpath(directory);
+
+    tiles->setSizes(image.size());
+    if (!tiles->build(image))
+    {
+        qCWarning(KSTARS) << "Could not write the image overlay tiles to" << directory;
+        return QSharedPointer<ImageOverlayTiles>();
+    }
+
+    // The stamp goes last, so that an interrupted build is redone
+    if (stampFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        stampFile.write(QString("%1 %2 %3").arg(stamp).arg(tiles->width()).arg(tiles->height()).toLatin1());
+
+    return tiles;
+}
+
+void ImageOverlayTiles::setSizes(const QSize &size)
+{
+    m_Sizes.clear();
+    QSize levelSize = size;
+    m_Sizes.append(levelSize);
+    while (std::max(levelSize.width(), levelSize.height()) > PreviewSize)
+    {
+        levelSize = QSize((levelSize.width() + 1) / 2, (levelSize.height() + 1) / 2);
+        m_Sizes.append(levelSize);
+    }
+}
+
+bool ImageOverlayTiles::build(QImage image)
+{
+    image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    for (int level = 0; level < levels(); ++level)
+    {
+        // Each level is filtered down from the one before
+        if (level > 0)
+            image = image.scaled(m_Sizes[level], Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+        const QSize count = tileCount(level);
+        for (int y = 0; y < count.height(); ++y)
+        {
+            for (int x = 0; x < count.width(); ++x)
+            {
+                const QRect rect = QRect(x * TileSize, y * TileSize, TileSize, TileSize).intersected(image.rect());
+                if (!image.copy(rect).save(tilePath(level, x, y)))
+                    return false;
+            }
+        }
+    }
+    m_Preview = image;
+    return true;
+}
+
+int ImageOverlayTiles::level(double scale) const
+{
+    int level = 0;
+    while (level + 1 < levels() && static_cast<double>(width()) / m_Sizes[level + 1].width() <= scale)
+        ++level;
+    return level;
+}
+
+QSize ImageOverlayTiles::tileCount(int level) const
+{
+    const QSize &size = m_Sizes[level];
+    return QSize((size.width() + TileSize - 1) / TileSize, (size.height() + TileSize - 1) / TileSize);
+}
+
+QString ImageOverlayTiles::tilePath(int level, int x, int y) const
+{
+    return QString("%1/%2_%3_%4.png").arg(m_Directory).arg(level).arg(x).arg(y);
+}
+
+QImage ImageOverlayTiles::tile(int level, int x, int y, bool load) const
+{
+    if (level == levels() - 1)
+        return m_Preview;
+
+    const QString path = tilePath(level, x, y);
+    QMutexLocker lock(&tileCacheMutex());
+    if (const QImage *image = tileCache().object(path))
+        return *image;
+    if (!load)
+        return QImage();
+    lock.unlock();
+
+    const QImage image = QImage(path).convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    if (image.isNull())
+        return image;
+
+    lock.relock();
+    tileCache().insert(path, new QImage(image), std::max<int>(1, image.sizeInBytes() / 1024));
+    return image;
+}
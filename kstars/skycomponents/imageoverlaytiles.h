@@ -0,0 +1,95 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QImage>
+#include <QSharedPointer>
+#include <QSize>
+#include <QString>
+#include <QVector>
+
+/**
+ * @class ImageOverlayTiles
+ * @short A mipmap pyramid of an overlay image, cut into tiles and cached on disk.
+ *
+ * Level 0 has the size of the processed image, and each further level halves it until the
+ * image fits in PreviewSize pixels. The pyramid is written once into a directory of its own,
+ * and reused as long as the source file and the processing are unchanged. Only the coarsest
+ * level, the preview, stays in memory. The other tiles are read when they are drawn, and
+ * kept in a cache of limited size shared by all the overlays.
+ */
+class ImageOverlayTiles
+{
+    public:
+        static constexpr int TileSize = 256;
+        static constexpr int PreviewSize = 128;
+
+        /**
+         * @short Load the pyramid of @p filename from @p directory, or build it there.
+         * @param maxDimension the largest width of level 0, larger images are scaled down
+         * @param mirror whether the image is mirrored horizontally first
+         * @return the pyramid, or a null pointer if the image can not be read
+         */
+        static QSharedPointer<ImageOverlayTiles> create(const QString &filename, const QString &directory,
+                int maxDimension, bool mirror);
+
+        /** @return the size of level 0 */
+        int width() const
+        {
+            return m_Sizes[0].width();
+        }
+        int height() const
+        {
+            return m_Sizes[0].height();
+        }
+
+        int levels() const
+        {
+            return m_Sizes.size();
+        }
+
+        QSize levelSize(int level) const
+        {
+            return m_Sizes[level];
+        }
+
+        /**
+         * @return the coarsest level that is not magnified when @p scale pixels of level 0
+         * are drawn on one screen pixel
+         */
+        int level(double scale) const;
+
+        /** @return the coarsest level, which is a single tile */
+        const QImage &preview() const
+        {
+            return m_Preview;
+        }
+
+        /**
+         * @short The tile at column @p x and row @p y of @p level.
+         * @param load whether a tile that is not in memory is read from disk
+         * @return the tile, or a null image if it is not loaded
+         */
+        QImage tile(int level, int x, int y, bool load) const;
+
+        /** @return the number of tile columns and rows of @p level */
+        QSize tileCount(int level) const;
+
+    private:
+        ImageOverlayTiles() = default;
+
+        QString tilePath(int level, int x, int y) const;
+
+        /** @short Cut @p image into the tiles of all the levels, false on a write error */
+        bool build(QImage image);
+
+        void setSizes(const QSize &size);
+
+        QString m_Directory;
+        QVector<QSize> m_Sizes;
+        QImage m_Preview;
+};
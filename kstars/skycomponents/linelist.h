@@ -8,7 +8,10 @@
 
 #include "typedef.h"
 
+#include <QLineF>
 #include <QList>
+#include <QPolygonF>
+#include <QVector>
 
 class SkyPoint;
 class KSNumbers;
@@ -45,6 +48,18 @@ class LineList
     UpdateID updateID;
     UpdateID updateNumID;
 
+    /**
+     * Screen geometry computed by the last draw, which SkyPainter::drawCachedSkyPolyline() and
+     * SkyPainter::drawCachedSkyPolygon() draw again while the view and the sky are unchanged.
+     * The projection IDs are the LineListIndex cache generations the geometry was computed for.
+     * For polylines, projectedLineEnds holds the index of the point ending each segment, for the labels.
+     */
+    DrawID lineProjectionID { 0 };
+    DrawID polyProjectionID { 0 };
+    QVector<QLineF> projectedLines;
+    QVector<int> projectedLineEnds;
+    QPolygonF projectedPolygon;
+
   private:
     SkyList pointList;
 };
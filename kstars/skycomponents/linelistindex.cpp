@@ -25,12 +25,20 @@
 #include "Options.h"
 #include "kstarsdata.h"
 #include "linelist.h"
-#ifndef KSTARS_LITE
+#include "skiphashlist.h"
+#include "skysnapshot.h"
+#ifdef KSTARS_LITE
+#include "skymaplite.h"
+#else
 #include "skymap.h"
 #endif
 #include "skypainter.h"
 #include "htmesh/MeshIterator.h"
 
+#include <QVarLengthArray>
+
+#include <algorithm>
+
 LineListIndex::LineListIndex(SkyComposite *parent, const QString &name) : SkyComponent(parent), m_name(name)
 {
     m_skyMesh   = SkyMesh::Instance();
@@ -60,8 +68,11 @@ void LineListIndex::removeLine(const std::shared_ptr<LineList> &lineList)
     m_listList.removeOne(lineList);
 }
 
-void LineListIndex::appendLine(const std::shared_ptr<LineList> &lineList)
+void LineListIndex::appendLine(const std::shared_ptr<LineList> &lineList, SkySnapshot *snapshot)
 {
+    if (snapshot)
+        snapshot->addList(lineList.get());
+
     const IndexHash &indexHash     = getIndexHash(lineList.get());
     IndexHash::const_iterator iter = indexHash.constBegin();
 
@@ -70,6 +81,8 @@ void LineListIndex::appendLine(const std::shared_ptr<LineList> &lineList)
         Trixel trixel = iter.key();
 
         iter++;
+        if (snapshot)
+            snapshot->addTrixel(SkySnapshot::LINE_TRIXEL, trixel);
         if (!m_lineIndex->contains(trixel))
         {
             m_lineIndex->insert(trixel, std::shared_ptr<LineListList>(new LineListList()));
@@ -79,7 +92,7 @@ void LineListIndex::appendLine(const std::shared_ptr<LineList> &lineList)
     m_listList.append(lineList);
 }
 
-void LineListIndex::appendPoly(const std::shared_ptr<LineList> &lineList)
+void LineListIndex::appendPoly(const std::shared_ptr<LineList> &lineList, SkySnapshot *snapshot)
 {
     const IndexHash &indexHash     = skyMesh()->indexPoly(lineList->points());
     IndexHash::const_iterator iter = indexHash.constBegin();
@@ -88,6 +101,8 @@ void LineListIndex::appendPoly(const std::shared_ptr<LineList> &lineList)
     {
         Trixel trixel = iter.key();
         iter++;
+        if (snapshot)
+            snapshot->addTrixel(SkySnapshot::POLY_TRIXEL, trixel);
 
         if (!m_polyIndex->contains(trixel))
         {
@@ -97,12 +112,63 @@ void LineListIndex::appendPoly(const std::shared_ptr<LineList> &lineList)
     }
 }
 
-void LineListIndex::appendBoth(const std::shared_ptr<LineList> &lineList)
+void LineListIndex::appendBoth(const std::shared_ptr<LineList> &lineList, SkySnapshot *snapshot)
+{
+    QMutexLocker m1(&mutex);
+
+    appendLine(lineList, snapshot);
+    appendPoly(lineList, snapshot);
+}
+
+void LineListIndex::loadSnapshot(const SkySnapshot &snapshot)
 {
     QMutexLocker m1(&mutex);
 
-    appendLine(lineList);
-    appendPoly(lineList);
+    auto insert = [](LineListHash * index, Trixel trixel, const std::shared_ptr<LineList> &lineList)
+    {
+        auto &listList = (*index)[trixel];
+        if (!listList)
+            listList.reset(new LineListList());
+        listList->append(lineList);
+    };
+
+    std::shared_ptr<LineList> lineList;
+    int iPoint = 0;
+    for (int i = 0; i < snapshot.count(); i++)
+    {
+        const SkySnapshot::Record &record = snapshot.record(i);
+        switch (record.kind)
+        {
+            case SkySnapshot::LINE_LIST:
+                if (record.flag)
+                    lineList.reset(new SkipHashList());
+                else
+                    lineList.reset(new LineList());
+                m_listList.append(lineList);
+                iPoint = 0;
+                break;
+            case SkySnapshot::POINT:
+                if (!lineList)
+                    break;
+                lineList->append(std::make_shared<SkyPoint>(record.ra, record.dec));
+                if (record.flag)
+                    static_cast<SkipHashList *>(lineList.get())->setSkip(iPoint);
+                iPoint++;
+                break;
+            case SkySnapshot::LINE_TRIXEL:
+                if (lineList)
+                    insert(m_lineIndex.get(), record.value, lineList);
+                break;
+            case SkySnapshot::POLY_TRIXEL:
+                if (lineList)
+                    insert(m_polyIndex.get(), record.value, lineList);
+                break;
+            default:
+                // A polygon ends the line list before it
+                lineList.reset();
+                break;
+        }
+    }
 }
 
 void LineListIndex::reindexLines()
@@ -132,10 +198,23 @@ void LineListIndex::JITupdate(LineList *lineList)
     lineList->updateID = data->updateID();
     SkyList *points    = lineList->points();
 
-    if (lineList->updateNumID != data->updateNumID())
+    const bool precess = lineList->updateNumID != data->updateNumID();
+    lineList->updateNumID = data->updateNumID();
+
+    // The points are plain J2000 ones, rotate them all at once
+    const ObservationContext &context = data->observationContext();
+    if (context.isValid())
+    {
+        QVarLengthArray<SkyPoint *, 256> raw(points->size());
+        for (int i = 0; i < points->size(); ++i)
+            raw[i] = points->at(i).get();
+        context.update(raw.constData(), raw.size(), precess);
+        return;
+    }
+
+    if (precess)
     {
-        lineList->updateNumID = data->updateNumID();
-        KSNumbers *num        = data->updateNum();
+        KSNumbers *num = data->updateNum();
 
         for (const auto &point : *points)
         {
@@ -177,10 +256,51 @@ SkipHashList *LineListIndex::skipList(LineList *lineList)
     return nullptr;
 }
 
+DrawID LineListIndex::projectionID()
+{
+    // The lines only move on screen when the view changes, or when their points are updated
+    // for a new time. Repaints for anything else draw the geometry kept by the previous frame.
+    KStarsData *data = KStarsData::Instance();
+#ifdef KSTARS_LITE
+    const Projector *proj = SkyMapLite::Instance()->projector();
+#else
+    const Projector *proj = SkyMap::Instance()->projector();
+#endif
+    const ViewParams view = proj->viewParams();
+    const double focus[4] = { view.focus->ra().Degrees(), view.focus->dec().Degrees(),
+                              view.focus->az().Degrees(), view.focus->alt().Degrees()
+                            };
+
+    const bool same = m_projectionID != 0 && proj->type() == m_projectedType &&
+                      view.width == m_projectedView.width && view.height == m_projectedView.height &&
+                      view.zoomFactor == m_projectedView.zoomFactor &&
+                      view.rotationAngle == m_projectedView.rotationAngle &&
+                      view.useRefraction == m_projectedView.useRefraction &&
+                      view.useAltAz == m_projectedView.useAltAz &&
+                      view.fillGround == m_projectedView.fillGround && view.mirror == m_projectedView.mirror &&
+                      std::equal(focus, focus + 4, m_projectedFocus) &&
+                      data->updateID() == m_projectedUpdateID && data->updateNumID() == m_projectedUpdateNumID;
+    if (same)
+        return m_projectionID;
+
+    m_projectedView = view;
+    m_projectedView.focus = nullptr;
+    m_projectedType = proj->type();
+    std::copy(focus, focus + 4, m_projectedFocus);
+    m_projectedUpdateID = data->updateID();
+    m_projectedUpdateNumID = data->updateNumID();
+
+    // Zero is never a valid generation since new LineLists start with it.
+    if (++m_projectionID == 0)
+        ++m_projectionID;
+    return m_projectionID;
+}
+
 void LineListIndex::drawLines(SkyPainter *skyp)
 {
     DrawID drawID     = skyMesh()->drawID();
     UpdateID updateID = KStarsData::Instance()->updateID();
+    DrawID projection = projectionID();
 
     for (auto &lineListList : m_lineIndex->values())
     {
@@ -195,7 +315,9 @@ void LineListIndex::drawLines(SkyPainter *skyp)
             if (lineList->updateID != updateID)
                 JITupdate(lineList.get());
 
-            skyp->drawSkyPolyline(lineList.get(), skipList(lineList.get()), label());
+            skyp->drawCachedSkyPolyline(lineList.get(), lineList->lineProjectionID == projection,
+                                        skipList(lineList.get()), label());
+            lineList->lineProjectionID = projection;
         }
     }
 }
@@ -204,6 +326,7 @@ void LineListIndex::drawFilled(SkyPainter *skyp)
 {
     DrawID drawID     = skyMesh()->drawID();
     UpdateID updateID = KStarsData::Instance()->updateID();
+    DrawID projection = projectionID();
 
     MeshIterator region(skyMesh(), drawBuffer());
 
@@ -226,7 +349,8 @@ void LineListIndex::drawFilled(SkyPainter *skyp)
             if (lineList->updateID != updateID)
                 JITupdate(lineList.get());
 
-            skyp->drawSkyPolygon(lineList.get());
+            skyp->drawCachedSkyPolygon(lineList.get(), lineList->polyProjectionID == projection);
+            lineList->polyProjectionID = projection;
         }
     }
 }
@@ -8,6 +8,7 @@
 
 #include "skycomponent.h"
 #include "skymesh.h"
+#include "projections/projector.h"
 
 #include <QMutex>
 
@@ -17,6 +18,7 @@
 class LineList;
 class LineListLabel;
 class SkipHashList;
+class SkySnapshot;
 class SkyPainter;
 
 /**
@@ -101,21 +103,30 @@ class LineListIndex : public SkyComponent
     /**
      * @short Typically called from within a subclasses constructors.
      * Adds the trixels covering the outline of lineList to the lineIndex.
+     * The list and its trixels are recorded in @p snapshot if given.
      */
-    void appendLine(const std::shared_ptr<LineList> &lineList);
+    void appendLine(const std::shared_ptr<LineList> &lineList, SkySnapshot *snapshot = nullptr);
 
     void removeLine(const std::shared_ptr<LineList> &lineList);
 
     /**
      * @short Typically called from within a subclasses constructors.
      * Adds the trixels covering the full lineList to the polyIndex.
+     * The trixels are recorded in @p snapshot if given.
      */
-    void appendPoly(const std::shared_ptr<LineList> &lineList);
+    void appendPoly(const std::shared_ptr<LineList> &lineList, SkySnapshot *snapshot = nullptr);
 
     /**
      * @short a convenience method that adds a lineList to both the lineIndex and the polyIndex.
      */
-    void appendBoth(const std::shared_ptr<LineList> &lineList);
+    void appendBoth(const std::shared_ptr<LineList> &lineList, SkySnapshot *snapshot = nullptr);
+
+    /**
+     * @short Adds the line lists of @p snapshot to the indexes at the trixels it recorded,
+     * instead of parsing and indexing the data files again. Polygon records are left to the
+     * subclass that wrote them.
+     */
+    void loadSnapshot(const SkySnapshot &snapshot);
 
     /**
      * @short Draws all the lines in m_listList as simple lines in float mode.
@@ -163,6 +174,13 @@ class LineListIndex : public SkyComponent
     inline LineListList listList() const { return m_listList; }
 
   private:
+    /**
+     * @short Checks whether the screen geometry cached in the LineLists is still valid for the
+     * current view and sky update, and starts a new cache generation if not.
+     * @return the current generation, to compare with LineList::lineProjectionID and polyProjectionID.
+     */
+    DrawID projectionID();
+
     QString m_name;
 
     SkyMesh *m_skyMesh { nullptr };
@@ -171,5 +189,13 @@ class LineListIndex : public SkyComponent
 
     LineListList m_listList;
 
+    // Key of the cached screen geometry
+    DrawID m_projectionID { 0 };
+    ViewParams m_projectedView;
+    Projector::Projection m_projectedType { Projector::Lambert };
+    double m_projectedFocus[4] { 0, 0, 0, 0 };
+    UpdateID m_projectedUpdateID { 0 };
+    UpdateID m_projectedUpdateNumID { 0 };
+
     QMutex mutex;
 };
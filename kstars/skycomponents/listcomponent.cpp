@@ -32,6 +32,7 @@ void ListComponent::clear()
         removeFromNames(o);
         delete o;
     }
+    m_ObjectHash.clear();
 }
 
 void ListComponent::appendListObject(SkyObject *object)
@@ -40,9 +41,17 @@ void ListComponent::appendListObject(SkyObject *object)
     m_ObjectList.append(object);
 
     // Insert multiple Names
-    m_ObjectHash.insert(object->name().toLower(), object);
-    m_ObjectHash.insert(object->longname().toLower(), object);
-    m_ObjectHash.insert(object->name2().toLower(), object);
+    object->shareNames();
+    hashObjectName(object->name(), object);
+    hashObjectName(object->longname(), object);
+    hashObjectName(object->name2(), object);
+}
+
+void ListComponent::hashObjectName(const QString &name, SkyObject *object)
+{
+    const NameTable::Id id = NameTable::instance().intern(name);
+    if (id != NameTable::NoName)
+        m_ObjectHash.insert(id, object);
 }
 
 void ListComponent::update(KSNumbers *num)
@@ -61,7 +70,9 @@ void ListComponent::update(KSNumbers *num)
 SkyObject *ListComponent::findByName(const QString &name, bool exact)
 {
     Q_UNUSED(exact)
-    return m_ObjectHash[name.toLower()]; // == nullptr if not found.
+    // Names that were never interned cannot be in the hash
+    const NameTable::Id id = NameTable::instance().find(name);
+    return id == NameTable::NoName ? nullptr : m_ObjectHash.value(id, nullptr);
 }
 
 SkyObject *ListComponent::objectNearest(SkyPoint *p, double &maxrad)
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "nametable.h"
 #include "skycomponent.h"
 
 #include <QList>
@@ -57,10 +58,14 @@ class ListComponent : public SkyComponent
          * This method is a handy wrapper, which automatically appends the given
          * SkyObject to m_ObjectList and inserts references with all common names (name,
          * name2, longname) into the m_ObjectHash QHash to enable a faster findbyname.
+         * The names are interned in the NameTable and the hash is keyed by their ids.
          */
         void appendListObject(SkyObject * object);
 
     protected:
+        /** @short Insert @p object in m_ObjectHash under the id of @p name, if it is not empty. */
+        void hashObjectName(const QString &name, SkyObject *object);
+
         QList<SkyObject *> m_ObjectList;
-        QHash<QString, SkyObject *> m_ObjectHash;
+        QHash<NameTable::Id, SkyObject *> m_ObjectHash;
 };
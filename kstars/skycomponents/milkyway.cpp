@@ -16,8 +16,8 @@
 #include "Options.h"
 #include "skypainter.h"
 #include "skycomponents/skiphashlist.h"
-
-#include <QtConcurrent>
+#include "skycomponents/skysnapshot.h"
+#include "auxiliary/executors.h"
 
 MilkyWay::MilkyWay(SkyComposite *parent) : LineListIndex(parent, i18n("Milky Way"))
 {
@@ -29,9 +29,9 @@ MilkyWay::MilkyWay(SkyComposite *parent) : LineListIndex(parent, i18n("Milky Way
     //loadContours("smc.dat", i18n("Loading Small Magellanic Clouds"));
     //summary();
 
-    QtConcurrent::run(this, &MilkyWay::loadContours, QString("milkyway.dat"), i18n("Loading Milky Way"));
-    QtConcurrent::run(this, &MilkyWay::loadContours, QString("lmc.dat"), i18n("Loading Large Magellanic Clouds"));
-    QtConcurrent::run(this, &MilkyWay::loadContours, QString("smc.dat"), i18n("Loading Small Magellanic Clouds"));
+    Executors::run(Executors::Background, &MilkyWay::loadContours, this, QString("milkyway.dat"), i18n("Loading Milky Way"));
+    Executors::run(Executors::Background, &MilkyWay::loadContours, this, QString("lmc.dat"), i18n("Loading Large Magellanic Clouds"));
+    Executors::run(Executors::Background, &MilkyWay::loadContours, this, QString("smc.dat"), i18n("Loading Small Magellanic Clouds"));
 }
 
 const IndexHash &MilkyWay::getIndexHash(LineList *lineList)
@@ -75,6 +75,14 @@ void MilkyWay::draw(SkyPainter *skyp)
 
 void MilkyWay::loadContours(QString fname, QString greeting)
 {
+    // The indexed contours are mapped from the cache after the first start
+    SkySnapshot snapshot(fname, { fname });
+    if (snapshot.open())
+    {
+        loadSnapshot(snapshot);
+        return;
+    }
+
     KSFileReader fileReader;
     std::shared_ptr<LineList> skipList;
     int iSkip = 0;
@@ -105,7 +113,7 @@ void MilkyWay::loadContours(QString fname, QString greeting)
         if (firstChar == 'M')
         {
             if (skipList.get())
-                appendBoth(skipList);
+                appendBoth(skipList, &snapshot);
             skipList.reset();
             iSkip    = 0;
         }
@@ -122,5 +130,8 @@ void MilkyWay::loadContours(QString fname, QString greeting)
         iSkip++;
     }
     if (skipList.get())
-        appendBoth(skipList);
+        appendBoth(skipList, &snapshot);
+
+    if (!snapshot.write())
+        qDebug() << Q_FUNC_INFO << "Could not write the snapshot of" << fname;
 }
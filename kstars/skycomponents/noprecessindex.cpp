@@ -10,6 +10,8 @@
 #include "kstarsdata.h"
 #include "linelist.h"
 
+#include <QVarLengthArray>
+
 NoPrecessIndex::NoPrecessIndex(SkyComposite *parent, const QString &name) : LineListIndex(parent, name)
 {
 }
@@ -21,6 +23,16 @@ void NoPrecessIndex::JITupdate(LineList *lineList)
     lineList->updateID = data->updateID();
     SkyList *points    = lineList->points();
 
+    const ObservationContext &context = data->observationContext();
+    if (context.isValid())
+    {
+        QVarLengthArray<SkyPoint *, 256> raw(points->size());
+        for (int i = 0; i < points->size(); ++i)
+            raw[i] = points->at(i).get();
+        context.update(raw.constData(), raw.size(), false);
+        return;
+    }
+
     for (const auto &point : *points)
     {
         point->EquatorialToHorizontal(data->lst(), data->geo()->lat());
@@ -14,15 +14,15 @@
 #include "skymap.h"
 #include "skypainter.h"
 #include "skyobjects/satellite.h"
+#include "auxiliary/executors.h"
 
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QProgressDialog>
-#include <QtConcurrent>
 
 SatellitesComponent::SatellitesComponent(SkyComposite *parent) : SkyComponent(parent)
 {
-    QtConcurrent::run(this, &SatellitesComponent::loadData);
+    Executors::run(Executors::Background, &SatellitesComponent::loadData, this);
 }
 
 SatellitesComponent::~SatellitesComponent()
@@ -51,8 +51,13 @@ void SatellitesComponent::loadData()
         m_groups.append(new SatelliteGroup(group_infos.at(0), group_infos.at(1), QUrl(group_infos.at(2))));
     }
 
-    objectNames(SkyObject::SATELLITE).clear();
-    objectLists(SkyObject::SATELLITE).clear();
+    indexNames();
+}
+
+void SatellitesComponent::indexNames()
+{
+    clearNames(SkyObject::SATELLITE);
+    nameHash.clear();
 
     foreach (SatelliteGroup *group, m_groups)
     {
@@ -62,8 +67,7 @@ void SatellitesComponent::loadData()
 
             if (sat->selected() && nameHash.contains(sat->name().toLower()) == false)
             {
-                objectNames(SkyObject::SATELLITE).append(sat->name());
-                objectLists(SkyObject::SATELLITE).append(QPair<QString, const SkyObject *>(sat->name(), sat));
+                addToNames(SkyObject::SATELLITE, sat->name(), sat);
                 nameHash[sat->name().toLower()] = sat;
             }
         }
@@ -81,9 +85,14 @@ void SatellitesComponent::update(KSNumbers *)
     if (!selected())
         return;
 
+    // Satellites below the horizon are not drawn when the ground hides them, or when only
+    // visible satellites are drawn, so they need not be propagated until they can rise
+    Satellite::Environment env = Satellite::environment();
+    env.skipBelowHorizon       = Options::showGround() || Options::showVisibleSatellites();
+
     foreach (SatelliteGroup *group, m_groups)
     {
-        group->updateSatellitesPos();
+        group->updateSatellitesPos(env);
     }
 }
 
@@ -171,6 +180,8 @@ void SatellitesComponent::updateTLEs()
                 file.write(response->readAll());
                 file.close();
                 group->readTLE();
+                // The satellites of the group were recreated
+                indexNames();
                 group->updateSatellitesPos();
                 progressDlg.setValue(++i);
             }
@@ -97,6 +97,9 @@ class SatellitesComponent : public SkyComponent
         void drawTrails(SkyPainter *skyp) override;
 
     private:
+        /** @short Register the names of the selected satellites, after they were loaded or recreated. */
+        void indexNames();
+
         QList<SatelliteGroup *> m_groups; // List of all groups
         QHash<QString, Satellite *> nameHash;
 };
@@ -8,6 +8,7 @@
 
 #include "Options.h"
 #include "skycomposite.h"
+#include "skyobjectnameindex.h"
 #include "skyobjects/skyobject.h"
 
 SkyComponent::SkyComponent(SkyComposite *parent) : m_parent(parent)
@@ -62,8 +63,38 @@ QHash<int, QVector<QPair<QString, const SkyObject *>>> &SkyComponent::getObjectL
     return parent()->objectLists();
 }
 
+SkyObjectNameIndex *SkyComponent::getNameIndex()
+{
+    return parent() ? parent()->getNameIndex() : nullptr;
+}
+
+void SkyComponent::addToNames(int type, const QString &name, const SkyObject *object, bool addToNameList)
+{
+    if (addToNameList)
+        getObjectNames()[type].append(name);
+    getObjectLists()[type].append(QPair<QString, const SkyObject *>(name, object));
+
+    if (SkyObjectNameIndex *index = getNameIndex())
+        index->insert(name, object, type);
+}
+
+void SkyComponent::clearNames(int type)
+{
+    getObjectNames()[type].clear();
+    getObjectLists()[type].clear();
+
+    if (SkyObjectNameIndex *index = getNameIndex())
+        index->removeType(type);
+}
+
 void SkyComponent::removeFromNames(const SkyObject *obj)
 {
+    if (SkyObjectNameIndex *index = getNameIndex())
+    {
+        index->remove(obj->name(), obj);
+        index->remove(obj->longname(), obj);
+    }
+
     QStringList &names = getObjectNames()[obj->type()];
     int i;
     i = names.indexOf(obj->name());
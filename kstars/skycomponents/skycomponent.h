@@ -12,6 +12,7 @@
 class QString;
 
 class SkyObject;
+class SkyObjectNameIndex;
 class SkyPoint;
 class SkyComposite;
 class SkyPainter;
@@ -205,12 +206,26 @@ class SkyComponent
             return getObjectLists()[type];
         }
 
+        /**
+         * @short Register @p name of @p object for the find lists and for the name index of
+         * SkyMapComposite::findByName().
+         *
+         * The name is added to objectLists(type) and, if @p addToNameList is true, to
+         * objectNames(type) as well.
+         */
+        void addToNames(int type, const QString &name, const SkyObject *object, bool addToNameList = true);
+
+        /** @short Empty objectNames(type) and objectLists(type) and remove their objects from the name index. */
+        void clearNames(int type);
+
         void removeFromNames(const SkyObject *obj);
         void removeFromLists(const SkyObject *obj);
 
     private:
         virtual QHash<int, QStringList> &getObjectNames();
         virtual QHash<int, QVector<QPair<QString, const SkyObject *>>> &getObjectLists();
+        /** @return the name index of SkyMapComposite, nullptr if the component is not part of one */
+        virtual SkyObjectNameIndex *getNameIndex();
 
         // Disallow copying and assignment
         SkyComponent(const SkyComponent &);
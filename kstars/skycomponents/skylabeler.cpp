@@ -16,18 +16,6 @@
 #include "skymap.h"
 #include "projections/projector.h"
 
-//---------------------------------------------------------------------------//
-// A Little data container class
-//---------------------------------------------------------------------------//
-
-typedef struct LabelRun
-{
-    LabelRun(int s, int e) : start(s), end(e) {}
-    int start;
-    int end;
-
-} LabelRun;
-
 //----- Now for the main event ----------------------------------------------//
 
 //----- Static Methods ------------------------------------------------------//
@@ -97,17 +85,7 @@ SkyLabeler::SkyLabeler()
 #endif
 }
 
-SkyLabeler::~SkyLabeler()
-{
-    for (auto &row : screenRows)
-    {
-        for (auto &item : *row)
-        {
-            delete item;
-        }
-        delete row;
-    }
-}
+SkyLabeler::~SkyLabeler() = default;
 
 bool SkyLabeler::drawGuideLabel(QPointF &o, const QString &text, double angle)
 {
@@ -265,59 +243,48 @@ void SkyLabeler::reset(SkyMap *skyMap)
     setZoomFont();
     m_skyFont     = m_p.font();
     m_fontMetrics = QFontMetrics(m_skyFont);
-    m_minDeltaX   = (int)m_fontMetrics.width("MMMMM");
+    m_cellWidth   = (int)m_fontMetrics.width("MMMMM");
 
     // ----- Set up Zoom Dependent Offset -----
     m_offset = SkyLabeler::ZoomOffset();
 
     // ----- Prepare Virtual Screen -----
-    m_yScale = (m_fontMetrics.height() + 1.0);
-
-    int maxY = int(skyMap->height() / m_yScale);
-    if (maxY < 1)
-        maxY = 1; // prevents a crash below?
-
-    int m_maxX = skyMap->width();
-    m_size     = (maxY + 1) * m_maxX;
+    resetVirtualScreen(skyMap->width(), skyMap->height());
 
-    // Resize if needed:
-    if (maxY > m_maxY)
+    //----- Clear out labelList -----
+    for (auto &item : labelList)
     {
-        screenRows.resize(m_maxY);
-        for (int y = m_maxY; y <= maxY; y++)
-        {
-            screenRows.append(new LabelRow());
-        }
-        //printf("resize: %d -> %d, size:%d\n", m_maxY, maxY, screenRows.size());
+        item.clear();
     }
+}
 
-    // Clear all pre-existing rows as needed
+void SkyLabeler::resetVirtualScreen(int width, int height)
+{
+    m_yScale = (m_fontMetrics.height() + 1.0);
 
-    int minMaxY = (maxY < m_maxY) ? maxY : m_maxY;
+    int maxY = int(height / m_yScale);
+    if (maxY < 1)
+        maxY = 1; // prevents a crash below?
 
-    for (int y = 0; y <= minMaxY; y++)
-    {
-        LabelRow *row = screenRows[y];
+    m_maxX = width;
+    m_size = (maxY + 1) * m_maxX;
 
-        for (auto &item : *row)
-        {
-            delete item;
-        }
-        row->clear();
-    }
+    // Only the cells used in the last frame need clearing, and they keep their memory.
+    for (int cell : m_usedCells)
+        m_cells[cell].clear();
+    m_usedCells.clear();
+    m_boxes.clear();
 
-    // never decrease m_maxY:
-    if (m_maxY < maxY)
-        m_maxY = maxY;
+    if (m_cellWidth < 1)
+        m_cellWidth = 1;
+    m_maxY        = maxY;
+    m_cellColumns = m_maxX / m_cellWidth + 1;
+    const size_t numCells = static_cast<size_t>(m_maxY + 1) * m_cellColumns;
+    if (m_cells.size() < numCells)
+        m_cells.resize(numCells);
 
     // reset the counters
     m_marks = m_hits = m_misses = m_elements = 0;
-
-    //----- Clear out labelList -----
-    for (auto &item : labelList)
-    {
-        item.clear();
-    }
 }
 
 #ifdef KSTARS_LITE
@@ -331,51 +298,12 @@ void SkyLabeler::reset()
     setZoomFont();
     m_skyFont     = m_drawFont;
     m_fontMetrics = QFontMetrics(m_skyFont);
-    m_minDeltaX   = (int)m_fontMetrics.width("MMMMM");
+    m_cellWidth   = (int)m_fontMetrics.width("MMMMM");
     // ----- Set up Zoom Dependent Offset -----
     m_offset = ZoomOffset();
 
     // ----- Prepare Virtual Screen -----
-    m_yScale = (m_fontMetrics.height() + 1.0);
-
-    int maxY = int(skyMap->height() / m_yScale);
-    if (maxY < 1)
-        maxY = 1; // prevents a crash below?
-
-    int m_maxX = skyMap->width();
-    m_size     = (maxY + 1) * m_maxX;
-
-    // Resize if needed:
-    if (maxY > m_maxY)
-    {
-        screenRows.resize(m_maxY);
-        for (int y = m_maxY; y <= maxY; y++)
-        {
-            screenRows.append(new LabelRow());
-        }
-        //printf("resize: %d -> %d, size:%d\n", m_maxY, maxY, screenRows.size());
-    }
-
-    // Clear all pre-existing rows as needed
-
-    int minMaxY = (maxY < m_maxY) ? maxY : m_maxY;
-
-    for (int y = 0; y <= minMaxY; y++)
-    {
-        LabelRow *row = screenRows[y];
-        for (int i = 0; i < row->size(); i++)
-        {
-            delete row->at(i);
-        }
-        row->clear();
-    }
-
-    // never decrease m_maxY:
-    if (m_maxY < maxY)
-        m_maxY = maxY;
-
-    // reset the counters
-    m_marks = m_hits = m_misses = m_elements = 0;
+    resetVirtualScreen(skyMap->width(), skyMap->height());
 
     //----- Clear out labelList -----
     for (int i = 0; i < labelList.size(); i++)
@@ -400,11 +328,6 @@ void SkyLabeler::draw(QPainter &p)
     //m_p.begin(&m_picture);
 }
 
-// We use Run Length Encoding to hold the information instead of an array of
-// chars.  This is both faster and smaller but the code is more complicated.
-//
-// This code is easy to break and hard to fix.
-
 bool SkyLabeler::markText(const QPointF &p, const QString &text, qreal padding_factor)
 {
     static const auto ramp_zoom = log10(MAXZOOM) + log10(0.3);
@@ -460,114 +383,44 @@ bool SkyLabeler::markRegion(qreal left, qreal right, qreal top, qreal bot)
         minY     = temp;
     }
 
+    // Labels partly off the screen go in the cells along its edges.
+    const int minColumn = qBound(0, minX / m_cellWidth, m_cellColumns - 1);
+    const int maxColumn = qBound(0, maxX / m_cellWidth, m_cellColumns - 1);
+
     // check to see if we overlap any existing label
-    // We must check all rows before we start marking
+    // We must check all cells before we start marking
     for (int y = minY; y <= maxY; y++)
     {
-        LabelRow *row = screenRows[y];
-        int i;
-        for (i = 0; i < row->size(); i++)
+        for (int column = minColumn; column <= maxColumn; column++)
         {
-            if (row->at(i)->end < minX)
-                continue; // skip past these
-            if (row->at(i)->start > maxX)
-                break;
-            m_misses++;
-            return false;
+            for (int index : m_cells[y * m_cellColumns + column])
+            {
+                const LabelBox &box = m_boxes[index];
+                if (box.minX <= maxX && box.maxX >= minX && box.minY <= maxY && box.maxY >= minY)
+                {
+                    m_misses++;
+                    return false;
+                }
+            }
         }
     }
 
     m_hits++;
     m_marks += (maxX - minX + 1) * (maxY - minY + 1);
 
-    // Okay, there was no overlap so let's insert the current rectangle into
-    // screenRows.
+    // Okay, there was no overlap so let's add the current rectangle to the cells it covers.
+    const int index = static_cast<int>(m_boxes.size());
+    m_boxes.push_back({ minX, maxX, minY, maxY });
+    m_elements++;
 
     for (int y = minY; y <= maxY; y++)
     {
-        LabelRow *row = screenRows[y];
-
-        // Simplest case: an empty row
-        if (row->size() < 1)
-        {
-            row->append(new LabelRun(minX, maxX));
-            m_elements++;
-            continue;
-        }
-
-        // Find out our place in the universe (or row).
-        // H'mm.  Maybe we could cache these numbers above.
-        int i;
-        for (i = 0; i < row->size(); i++)
-        {
-            if (row->at(i)->end >= minX)
-                break;
-        }
-
-        // i now points to first label PAST ours
-
-        // if we are first, append or merge at start of list
-        if (i == 0)
-        {
-            if (row->at(0)->start - maxX < m_minDeltaX)
-            {
-                row->at(0)->start = minX;
-            }
-            else
-            {
-                row->insert(0, new LabelRun(minX, maxX));
-                m_elements++;
-            }
-            continue;
-        }
-
-        // if we are past the last label, merge or append at end
-        else if (i == row->size())
-        {
-            if (minX - row->at(i - 1)->end < m_minDeltaX)
-            {
-                row->at(i - 1)->end = maxX;
-            }
-            else
-            {
-                row->append(new LabelRun(minX, maxX));
-                m_elements++;
-            }
-            continue;
-        }
-
-        // if we got here, we must insert or merge the new label
-        //  between [i-1] and [i]
-
-        bool mergeHead = (minX - row->at(i - 1)->end < m_minDeltaX);
-        bool mergeTail = (row->at(i)->start - maxX < m_minDeltaX);
-
-        // double merge => combine all 3 into one
-        if (mergeHead && mergeTail)
-        {
-            row->at(i - 1)->end = row->at(i)->end;
-            delete row->at(i);
-            row->removeAt(i);
-            m_elements--;
-        }
-
-        // Merge label with [i-1]
-        else if (mergeHead)
+        for (int column = minColumn; column <= maxColumn; column++)
         {
-            row->at(i - 1)->end = maxX;
-        }
-
-        // Merge label with [i]
-        else if (mergeTail)
-        {
-            row->at(i)->start = minX;
-        }
-
-        // insert between the two
-        else
-        {
-            row->insert(i, new LabelRun(minX, maxX));
-            m_elements++;
+            const int cell = y * m_cellColumns + column;
+            if (m_cells[cell].empty())
+                m_usedCells.push_back(cell);
+            m_cells[cell].push_back(index);
         }
     }
 
@@ -594,37 +447,44 @@ void SkyLabeler::drawQueuedLabels()
 {
     KStarsData *data = KStarsData::Instance();
 
-    resetFont();
-    m_p.setPen(QColor(data->colorScheme()->colorNamed("PNameColor")));
-    drawQueuedLabelsType(PLANET_LABEL);
-
-    if (labelList[SATURN_MOON_LABEL].size() > 0)
+    // The buffers in priority order, each with its pen (or the previous one) and font size change.
+    // No colors for asteroids and comets, they follow planets along.
+    static const struct
     {
-        shrinkFont(2);
-        drawQueuedLabelsType(SATURN_MOON_LABEL);
-        resetFont();
-    }
+        label_t type;
+        const char *color;
+        int shrink;
+    } queue[] =
+    {
+        { PLANET_LABEL, "PNameColor", 0 },
+        { SATURN_MOON_LABEL, nullptr, 2 },
+        { JUPITER_MOON_LABEL, nullptr, 2 },
+        { ASTEROID_LABEL, nullptr, 0 },
+        { COMET_LABEL, nullptr, 0 },
+        { SATELLITE_LABEL, "SatLabelColor", 0 },
+    };
 
-    if (labelList[JUPITER_MOON_LABEL].size() > 0)
+    resetFont();
+    for (const auto &buffer : queue)
     {
-        shrinkFont(2);
-        drawQueuedLabelsType(JUPITER_MOON_LABEL);
-        resetFont();
-    }
+        if (buffer.color)
+            m_p.setPen(QColor(data->colorScheme()->colorNamed(buffer.color)));
+        if (labelList[buffer.type].isEmpty())
+            continue;
+
+        if (buffer.shrink)
+            shrinkFont(buffer.shrink);
 
-    // No colors for these fellas? Just following planets along?
-    drawQueuedLabelsType(ASTEROID_LABEL);
-    drawQueuedLabelsType(COMET_LABEL);
+        drawQueuedLabelsType(buffer.type);
 
-    m_p.setPen(QColor(data->colorScheme()->colorNamed("SatLabelColor")));
-    drawQueuedLabelsType(SATELLITE_LABEL);
+        if (buffer.shrink)
+            resetFont();
+    }
 
     // Whelp we're here and we don't have a Rude Label color?
     // Will just set it to Planet color since this is how it used to be!!
     m_p.setPen(QColor(data->colorScheme()->colorNamed("PNameColor")));
-    LabelList list = labelList[RUDE_LABEL];
-
-    for (const auto &item : list)
+    for (const auto &item : labelList[RUDE_LABEL])
     {
         drawRudeNameLabel(item.obj, item.o);
     }
@@ -632,9 +492,7 @@ void SkyLabeler::drawQueuedLabels()
 
 void SkyLabeler::drawQueuedLabelsType(SkyLabeler::label_t type)
 {
-    LabelList list = labelList[type];
-
-    for (const auto &item : list)
+    for (const auto &item : labelList[type])
     {
         drawNameLabel(item.obj, item.o);
     }
@@ -687,8 +545,8 @@ void SkyLabeler::printInfo()
     printf("  hits=%d  misses=%d  ratio=%.1f%%\n", m_hits, m_misses, hitRatio());
     printf("  yScale=%.1f maxY=%d\n", m_yScale, m_maxY);
 
-    printf("  screenRows=%d elements=%d virtualSize=%.1f Kbytes\n", screenRows.size(), m_elements,
-           float(m_size) / 1024.0);
+    printf("  cells=%dx%d used=%d elements=%d virtualSize=%.1f Kbytes\n", m_cellColumns, m_maxY + 1,
+           static_cast<int>(m_usedCells.size()), m_elements, float(m_size) / 1024.0);
 
 //    static const char *labelName[NUM_LABEL_TYPES];
 //
@@ -705,29 +563,4 @@ void SkyLabeler::printInfo()
 //    {
 //        printf("  %20ss: %d\n", labelName[i], labelList[i].size());
 //    }
-//
-//    // Check for errors in the data structure
-//    for (int y = 0; y <= m_maxY; y++)
-//    {
-//        LabelRow *row = screenRows[y];
-//        int size      = row->size();
-//        if (size < 2)
-//            continue;
-//
-//        bool error = false;
-//        for (int i = 1; i < size; i++)
-//        {
-//            if (row->at(i - 1)->end > row->at(i)->start)
-//                error = true;
-//        }
-//        if (!error)
-//            continue;
-//
-//        printf("ERROR: %3d: ", y);
-//        for (int i = 0; i < row->size(); i++)
-//        {
-//            printf("(%d, %d) ", row->at(i)->start, row->at(i)->end);
-//        }
-//        printf("\n");
-//    }
 }
@@ -14,14 +14,12 @@
 #include <QPicture>
 #include <QFont>
 
+#include <vector>
+
 class QString;
 class QPointF;
 class SkyMap;
 class Projector;
-struct LabelRun;
-
-typedef QList<LabelRun *> LabelRow;
-typedef QVector<LabelRow *> ScreenRows;
 
 /**
  *@class SkyLabeler
@@ -36,20 +34,14 @@ typedef QVector<LabelRow *> ScreenRows;
  *
  * Since we need to check for overlap for every label every time it is
  * potentially drawn on the screen, efficiency is essential.  So instead of
- * having a 2-dimensional array of boolean values we use Run Length Encoding
- * and store the virtual array in a QVector of QLists.  Each element of the
- * vector, a LabelRow, corresponds to a horizontal strip of pixels on the actual
- * screen.  How many vertical pixels are in each strip is controlled by
- * m_yDensity.  The higher the density, the fewer vertical pixels per strip and
- * hence a larger number of strips are needed to cover the screen.  As
- * m_yDensity increases so does the density of the strips.
- *
- * The information in the X-dimension is completed run length encoded. A
- * consecutive run of pixels in one strip that are covered by one or more labels
- * is stored in a LabelRun object that merely stores the start pixel and the end
- * pixel.  A LabelRow is a list of LabelRun's stored in ascending order.  This
- * saves a lot of space over an explicit array and it also makes checking for
- * overlaps faster and even makes inserting new overlaps faster on average.
+ * having a 2-dimensional array of boolean values we store the box of every
+ * marked label, in units of horizontal strips of the actual screen in Y and of
+ * pixels in X.  How many vertical pixels are in each strip is set by the font
+ * height.  The virtual screen is divided in a grid of cells, one strip high and
+ * a few characters wide, and each cell lists the boxes overlapping it.  Checking
+ * a new label only looks at the few boxes in the cells it covers, so the cost of
+ * a check does not grow with the number of labels already placed.  The boxes and
+ * cell lists keep their memory from one frame to the next.
  *
  * Synopsis:
  *
@@ -325,12 +317,29 @@ class SkyLabeler
     int marks() { return m_marks; }
 
   private:
-    ScreenRows screenRows;
+    /// A marked label, in pixels in X and in strips in Y, all bounds included.
+    struct LabelBox
+    {
+        int minX;
+        int maxX;
+        int minY;
+        int maxY;
+    };
+
+    /// Clears the virtual screen and sizes its grid for a width x height screen.
+    void resetVirtualScreen(int width, int height);
+
+    std::vector<LabelBox> m_boxes;
+    /// Indices in m_boxes of the boxes overlapping each cell, row by row.
+    std::vector<std::vector<int>> m_cells;
+    /// Cells with at least one box, the only ones to clear on reset.
+    std::vector<int> m_usedCells;
+    int m_cellColumns { 0 };
     int m_maxX { 0 };
     int m_maxY { 0 };
     int m_size { 0 };
-    /// When to merge two adjacent regions
-    int m_minDeltaX { 30 };
+    /// Width of the cells of the virtual screen
+    int m_cellWidth { 30 };
     int m_marks { 0 };
     int m_hits { 0 };
     int m_misses { 0 };
@@ -39,6 +39,7 @@
 #include "projections/projector.h"
 #include "skyobjects/ksplanet.h"
 #include "skyobjects/constellationsart.h"
+#include "auxiliary/startupprofiler.h"
 
 #ifndef KSTARS_LITE
 #include "flagcomponent.h"
@@ -58,6 +59,8 @@
 SkyMapComposite::SkyMapComposite(SkyComposite *parent)
     : SkyComposite(parent), m_reindexNum(J2000)
 {
+    StartupProfiler::Phase phase("SkyMapComposite");
+
     m_skyLabeler.reset(SkyLabeler::Instance());
     m_skyMesh = SkyMesh::Create(3); // level 5 mesh = 8192 trixels
     m_skyMesh->debug(0);
@@ -101,20 +104,27 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent)
     addComponent(m_Supernovae = new SupernovaeComponent(this), 7);
     SkyMapLite::Instance()->loadingFinished();
 #else
+    StartupProfiler &profiler = StartupProfiler::instance();
     addComponent(m_MilkyWay = new MilkyWay(this), 50);
+    profiler.mark("Milky Way");
     addComponent(m_Stars = StarComponent::Create(this), 10);
+    profiler.mark("Stars");
     addComponent(m_EquatorialCoordinateGrid = new EquatorialCoordinateGrid(this));
     addComponent(m_HorizontalCoordinateGrid = new HorizontalCoordinateGrid(this));
     addComponent(m_LocalMeridianComponent = new LocalMeridianComponent(this));
+    profiler.mark("Coordinate grids");
 
     // Do add to components.
     addComponent(m_CBoundLines = new ConstellationBoundaryLines(this), 80);
+    profiler.mark("Constellation boundaries");
     m_Cultures.reset(new CultureList());
     addComponent(m_CLines = new ConstellationLines(this, m_Cultures.get()), 85);
     addComponent(m_CNames = new ConstellationNamesComponent(this, m_Cultures.get()), 90);
+    profiler.mark("Constellation lines and names");
     addComponent(m_Equator = new Equator(this), 95);
     addComponent(m_Ecliptic = new Ecliptic(this), 95);
     addComponent(m_Horizon = new HorizonComponent(this), 100);
+    profiler.mark("Equator, ecliptic and horizon");
 
     const auto &path = CatalogsDB::dso_db_path();
     try
@@ -148,9 +158,11 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent)
             KStars::Instance()->close();
         }
     }
+    profiler.mark("Catalogs");
 
     addComponent(
         m_ConstellationArt = new ConstellationArtComponent(this, m_Cultures.get()), 100);
+    profiler.mark("Constellation art");
 
     // Hips
     addComponent(m_HiPS = new HIPSComponent(this));
@@ -163,10 +175,13 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent)
 #ifdef HAVE_INDI
     addComponent(m_Mosaic = new MosaicComponent(this));
 #endif
+    profiler.mark("HiPS, terrain and overlays");
 
     addComponent(m_ArtificialHorizon = new ArtificialHorizonComponent(this), 110);
+    profiler.mark("Artificial horizon");
 
     addComponent(m_SolarSystem = new SolarSystemComposite(this), 2);
+    profiler.mark("Solar system");
 
     addComponent(m_Flags = new FlagComponent(this), 4);
 
@@ -178,6 +193,7 @@ SkyMapComposite::SkyMapComposite(SkyComposite *parent)
                  130);
     addComponent(m_Satellites = new SatellitesComponent(this), 7);
     addComponent(m_Supernovae = new SupernovaeComponent(this), 7);
+    profiler.mark("Flags, lists, satellites and supernovae");
 #endif
     connect(this, SIGNAL(progressText(QString)), KStarsData::Instance(),
             SIGNAL(progressText(QString)));
@@ -248,6 +264,8 @@ void SkyMapComposite::draw(SkyPainter *skyp)
     SkyMap *map      = SkyMap::Instance();
     KStarsData *data = KStarsData::Instance();
 
+    m_DrawProfiler.beginFrame(skyp);
+
     // We delay one draw cycle before re-indexing
     // we MUST ensure CLines do not get re-indexed while we use DRAW_BUF
     // so we do it here.
@@ -275,6 +293,7 @@ void SkyMapComposite::draw(SkyPainter *skyp)
     m_skyMesh->inDraw(true);
     SkyPoint *focus = map->focus();
     m_skyMesh->aperture(focus, radius + 1.0, DRAW_BUF); // divide by 2 for testing
+    m_DrawProfiler.setTrixels(m_skyMesh->intersectSize(DRAW_BUF));
 
     // create the no-precess aperture if needed
     if (Options::showEquatorialGrid() || Options::showHorizontalGrid() ||
@@ -282,6 +301,7 @@ void SkyMapComposite::draw(SkyPainter *skyp)
     {
         m_skyMesh->index(focus, radius + 1.0, NO_PRECESS_BUF);
     }
+    m_DrawProfiler.mark("Sky mesh");
 
     // clear marks from old labels and prep fonts
     m_skyLabeler->reset(map);
@@ -309,17 +329,21 @@ void SkyMapComposite::draw(SkyPainter *skyp)
     }
 
     m_MilkyWay->draw(skyp);
+    m_DrawProfiler.mark("Milky Way");
 
     // Draw HIPS after milky way but before everything else
     m_HiPS->draw(skyp);
+    m_DrawProfiler.mark("HiPS");
 
     if (Options::showImageOverlaysBelowCatalogs())
         // Draw fits overlay.
         m_ImageOverlay->draw(skyp);
+    m_DrawProfiler.mark("Image overlays");
 
     m_EquatorialCoordinateGrid->draw(skyp);
     m_HorizontalCoordinateGrid->draw(skyp);
     m_LocalMeridianComponent->draw(skyp);
+    m_DrawProfiler.mark("Coordinate grids");
 
     //Draw constellation boundary lines only if we draw western constellations
     if (m_Cultures->current() == "Western")
@@ -331,29 +355,37 @@ void SkyMapComposite::draw(SkyPainter *skyp)
     {
         m_ConstellationArt->draw(skyp);
     }
+    m_DrawProfiler.mark("Constellation art and boundaries");
 
     m_CLines->draw(skyp);
+    m_DrawProfiler.mark("Constellation lines");
 
     m_Equator->draw(skyp);
 
     m_Ecliptic->draw(skyp);
+    m_DrawProfiler.mark("Equator and ecliptic");
 
     m_Catalogs->draw(skyp);
+    m_DrawProfiler.mark("Catalogs");
 
     m_Stars->draw(skyp);
+    m_DrawProfiler.mark("Stars");
 
     m_SolarSystem->drawTrails(skyp);
     m_SolarSystem->draw(skyp);
+    m_DrawProfiler.mark("Solar system");
 
     m_Satellites->draw(skyp);
 
     m_Supernovae->draw(skyp);
+    m_DrawProfiler.mark("Satellites and supernovae");
 
     map->drawObjectLabels(labelObjects());
 
     m_skyLabeler->drawQueuedLabels();
     m_CNames->draw(skyp);
     m_Stars->drawLabels();
+    m_DrawProfiler.mark("Labels");
 
     m_ObservingList->pen =
         QPen(QColor(data->colorScheme()->colorNamed("ObsListColor")), 1.);
@@ -365,10 +397,12 @@ void SkyMapComposite::draw(SkyPainter *skyp)
     m_StarHopRouteList->pen =
         QPen(QColor(data->colorScheme()->colorNamed("StarHopRouteColor")), 1.);
     m_StarHopRouteList->draw(skyp);
+    m_DrawProfiler.mark("Observing list and flags");
 
     if (!Options::showImageOverlaysBelowCatalogs())
         // Draw fits overlay before mosaic and terrain/horizon, but after most things.
         m_ImageOverlay->draw(skyp);
+    m_DrawProfiler.mark("Image overlays");
 
 #ifdef HAVE_INDI
     m_Mosaic->draw(skyp);
@@ -377,11 +411,14 @@ void SkyMapComposite::draw(SkyPainter *skyp)
     m_ArtificialHorizon->draw(skyp);
 
     m_Horizon->draw(skyp);
+    m_DrawProfiler.mark("Horizons");
 
     m_skyMesh->inDraw(false);
 
     // Draw terrain at the end.
     m_Terrain->draw(skyp);
+    m_DrawProfiler.mark("Terrain");
+    m_DrawProfiler.endFrame();
 
     // DEBUG Edit. Keywords: Trixel boundaries. Currently works only in QPainter mode
     // -jbb uncomment these to see trixel outlines:
@@ -546,6 +583,11 @@ QHash<int, QVector<QPair<QString, const SkyObject *>>> &SkyMapComposite::getObje
     return m_ObjectLists;
 }
 
+SkyObjectNameIndex *SkyMapComposite::getNameIndex()
+{
+    return &m_NameIndex;
+}
+
 QList<SkyObject *> SkyMapComposite::findObjectsInArea(const SkyPoint &p1,
         const SkyPoint &p2)
 {
@@ -567,6 +609,12 @@ SkyObject *SkyMapComposite::findByName(const QString &name, bool exact)
         return nullptr;
 #endif
 
+    // The names of the find lists are resolved with one lookup in the name index, which keeps
+    // the same precedence as the walk below. Other names, like the ones of the deep sky objects
+    // that were not loaded from the catalogs yet, still need the walk.
+    if (const SkyObject *indexed = m_NameIndex.find(name))
+        return const_cast<SkyObject *>(indexed);
+
     //We search the children in an "intelligent" order (most-used
     //object types first), in order to avoid wasting too much time
     //looking for a match.  The most important part of this ordering
@@ -646,8 +694,7 @@ void SkyMapComposite::reloadCNames()
     //     m_CNames = 0;
     //     m_CNames = new ConstellationNamesComponent( this, m_Cultures.get() );
     //     SkyMapDrawAbstract::setDrawLock( false );
-    objectNames(SkyObject::CONSTELLATION).clear();
-    objectLists(SkyObject::CONSTELLATION).clear();
+    clearNames(SkyObject::CONSTELLATION);
     removeComponent(m_CNames);
     delete m_CNames;
     addComponent(m_CNames = new ConstellationNamesComponent(this, m_Cultures.get()));
@@ -708,6 +755,12 @@ bool SkyMapComposite::isLocalCNames()
 void SkyMapComposite::emitProgressText(const QString &message)
 {
     emit progressText(message);
+#ifndef KSTARS_LITE
+    // Past startup the sky map may draw the components being loaded in the background,
+    // so the events that start a frame wait until the loading returns to the event loop.
+    if (SkyMap::Instance())
+        return;
+#endif
 #ifndef Q_OS_ANDROID
     //Can cause crashes on Android, investigate it
     qApp->processEvents(); // -jbb: this seemed to make it work.
@@ -7,11 +7,13 @@
 #pragma once
 
 #include "culturelist.h"
+#include "drawprofiler.h"
 #include "ksnumbers.h"
 #include "skycomposite.h"
 #include "skylabeler.h"
 #include "skymesh.h"
 #include "skyobject.h"
+#include "skyobjectnameindex.h"
 #include "config-kstars.h"
 #include <QList>
 
@@ -269,12 +271,19 @@ class SkyMapComposite : public QObject, public SkyComposite
         {
             return m_StarHopRouteList;
         }
+
+        /** @return the timings of the last frames drawn by draw(). */
+        const DrawProfiler &drawProfiler() const
+        {
+            return m_DrawProfiler;
+        }
     signals:
         void progressText(const QString &message);
 
     private:
         QHash<int, QStringList> &getObjectNames() override;
         QHash<int, QVector<QPair<QString, const SkyObject *>>> &getObjectLists() override;
+        SkyObjectNameIndex *getNameIndex() override;
 
         std::unique_ptr<CultureList> m_Cultures;
         ConstellationBoundaryLines *m_CBoundLines{ nullptr };
@@ -311,10 +320,14 @@ class SkyMapComposite : public QObject, public SkyComposite
 
         KSNumbers m_reindexNum;
 
+        DrawProfiler m_DrawProfiler;
+
         QList<DeepStarComponent *> m_DeepStars;
 
         QList<SkyObject *> m_LabeledObjects;
         QHash<int, QStringList> m_ObjectNames;
         QHash<int, QVector<QPair<QString, const SkyObject *>>> m_ObjectLists;
+        /// All the names of m_ObjectLists, for findByName()
+        SkyObjectNameIndex m_NameIndex;
         QHash<QString, QString> m_ConstellationNames;
 };
@@ -19,6 +19,10 @@
 #include <QPolygonF>
 #include <QPointF>
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
 QMap<int, SkyMesh *> SkyMesh::pinstances;
 int SkyMesh::defaultLevel = -1;
 
@@ -67,10 +71,53 @@ void SkyMesh::aperture(SkyPoint *p0, double radius, MeshBufNum_t bufNum)
         p2.updateCoordsNow(data->updateNum());
     }
 
-    HTMesh::intersect(p1.ra().Degrees(), p1.dec().Degrees(), radius, (BufNum)bufNum);
+    // Quantize the center to an eighth of a trixel, with the RA step widened away from the equator.
+    // The quantized circle is enlarged by more than the distance to the actual center, so that it
+    // covers the actual aperture.
+    const double step = 90.0 / (1 << level()) / 8.0;
+    const qint64 decKey = qRound64(p1.dec().Degrees() / step);
+    const double dec = decKey * step;
+    const double raStep = step / cos(qMax(0.0, fabs(dec) - step) * dms::DegToRad);
+    const qint64 raKey = qRound64(p1.ra().Degrees() / raStep);
+    const qint64 radiusKey = qint64(ceil(radius / step)) + 1;
+
+    ApertureCache &cache = m_apertureCache[bufNum];
+    MeshBuffer *buffer = meshBuffer((BufNum)bufNum);
+    if (cache.valid && cache.ra == raKey && cache.dec == decKey && cache.radius == radiusKey)
+    {
+        buffer->reset();
+        for (Trixel trixel : cache.trixels)
+            buffer->append(trixel);
+        cache.previous = cache.trixels;
+    }
+    else
+    {
+        HTMesh::intersect(raKey * raStep, dec, radiusKey * step, (BufNum)bufNum);
+
+        cache.previous.swap(cache.trixels);
+        cache.trixels.resize(buffer->size());
+        std::copy(buffer->buffer(), buffer->buffer() + buffer->size(), cache.trixels.begin());
+        std::sort(cache.trixels.begin(), cache.trixels.end());
+        // A buffer which overflowed cannot be refilled from its trixels.
+        cache.valid  = (buffer->error() == 0);
+        cache.ra     = raKey;
+        cache.dec    = decKey;
+        cache.radius = radiusKey;
+    }
     m_drawID++;
 }
 
+void SkyMesh::apertureDelta(MeshBufNum_t bufNum, QVector<Trixel> &added, QVector<Trixel> &removed) const
+{
+    const ApertureCache &cache = m_apertureCache[bufNum];
+    added.clear();
+    removed.clear();
+    std::set_difference(cache.trixels.cbegin(), cache.trixels.cend(), cache.previous.cbegin(), cache.previous.cend(),
+                        std::back_inserter(added));
+    std::set_difference(cache.previous.cbegin(), cache.previous.cend(), cache.trixels.cbegin(), cache.trixels.cend(),
+                        std::back_inserter(removed));
+}
+
 Trixel SkyMesh::index(const SkyPoint *p)
 {
     return HTMesh::index(p->ra0().Degrees(), p->dec0().Degrees());
@@ -11,6 +11,7 @@
 #include "htmesh/HTMesh.h"
 
 #include <QMap>
+#include <QVector>
 
 class QPainter;
 class QPointF;
@@ -33,6 +34,7 @@ enum MeshBufNum_t
     NO_PRECESS_BUF  = 1,
     OBJ_NEAREST_BUF = 2,
     IN_CONSTELL_BUF = 3,
+    PREFETCH_BUF    = 4,
     NUM_MESH_BUF
 };
 
@@ -114,6 +116,22 @@ class SkyMesh : public HTMesh
          */
     void aperture(SkyPoint *center, double radius, MeshBufNum_t bufNum = DRAW_BUF);
 
+    /**
+         *@short returns the trixels which entered and left the aperture of the
+         * buffer with its last aperture() call, as sorted lists.
+         *
+         * aperture() quantizes the center and radius to a fraction of a trixel
+         * and slightly enlarges the radius to cover what it asked for, so the
+         * intersection is only computed again when the view moved enough to
+         * possibly change the trixels. Otherwise the buffer is refilled from the
+         * previous result and both lists are empty. Components which keep data
+         * per trixel can use this to load and release only the changed trixels.
+         *@param bufNum Buffer of the aperture
+         *@param added Trixels in the current aperture which were not in the previous one
+         *@param removed Trixels of the previous aperture which are not in the current one
+         */
+    void apertureDelta(MeshBufNum_t bufNum, QVector<Trixel> &added, QVector<Trixel> &removed) const;
+
     /** @short returns the index of the trixel containing p.
          */
     Trixel index(const SkyPoint *p);
@@ -283,6 +301,16 @@ class SkyMesh : public HTMesh
     void inDraw(bool inDraw) { m_inDraw = inDraw; }
 
   private:
+    /// The last aperture of a buffer, see aperture()
+    struct ApertureCache
+    {
+        bool valid { false };
+        qint64 ra { 0 }, dec { 0 }, radius { 0 };
+        QVector<Trixel> trixels;
+        QVector<Trixel> previous;
+    };
+    ApertureCache m_apertureCache[NUM_MESH_BUF];
+
     DrawID m_drawID;
     int errLimit { 0 };
     int m_debug { 0 };
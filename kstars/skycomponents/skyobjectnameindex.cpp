@@ -0,0 +1,89 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "skyobjectnameindex.h"
+
+#include "skyobject.h"
+
+int SkyObjectNameIndex::precedence(int type)
+{
+    switch (type)
+    {
+        case SkyObject::PLANET:
+        case SkyObject::MOON:
+        case SkyObject::ASTEROID:
+        case SkyObject::COMET:
+            return 0;
+        case SkyObject::CONSTELLATION:
+            return 2;
+        case SkyObject::STAR:
+        case SkyObject::CATALOG_STAR:
+            return 3;
+        case SkyObject::SUPERNOVA:
+            return 4;
+        case SkyObject::SATELLITE:
+            return 5;
+        default:
+            // Deep sky objects loaded from the catalogs
+            return 1;
+    }
+}
+
+void SkyObjectNameIndex::insert(const QString &name, const SkyObject *object, int type)
+{
+    const NameTable::Id id = NameTable::instance().intern(name);
+    if (id == NameTable::NoName || !object)
+        return;
+
+    QWriteLocker lock(&m_Lock);
+    auto iter = m_Entries.find(id);
+    if (iter == m_Entries.end())
+        m_Entries.insert(id, { object, type });
+    // Of the same precedence, the object registered last wins as in the component hashes
+    else if (precedence(type) <= precedence(iter->type))
+        *iter = { object, type };
+}
+
+void SkyObjectNameIndex::remove(const QString &name, const SkyObject *object)
+{
+    const NameTable::Id id = NameTable::instance().find(name);
+    if (id == NameTable::NoName)
+        return;
+
+    QWriteLocker lock(&m_Lock);
+    auto iter = m_Entries.find(id);
+    if (iter != m_Entries.end() && iter->object == object)
+        m_Entries.erase(iter);
+}
+
+void SkyObjectNameIndex::removeType(int type)
+{
+    QWriteLocker lock(&m_Lock);
+    for (auto iter = m_Entries.begin(); iter != m_Entries.end();)
+    {
+        if (iter->type == type)
+            iter = m_Entries.erase(iter);
+        else
+            ++iter;
+    }
+}
+
+const SkyObject *SkyObjectNameIndex::find(const QString &name) const
+{
+    const NameTable::Id id = NameTable::instance().find(name);
+    if (id == NameTable::NoName)
+        return nullptr;
+
+    QReadLocker lock(&m_Lock);
+    auto iter = m_Entries.constFind(id);
+    return iter == m_Entries.constEnd() ? nullptr : iter->object;
+}
+
+int SkyObjectNameIndex::size() const
+{
+    QReadLocker lock(&m_Lock);
+    return m_Entries.size();
+}
@@ -0,0 +1,57 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "nametable.h"
+
+#include <QHash>
+#include <QReadWriteLock>
+
+class SkyObject;
+
+/**
+ * @class SkyObjectNameIndex
+ * An index of the names of the objects of all the components, as registered for the find
+ * lists with SkyComponent::addToNames().
+ *
+ * Names are keyed by their NameTable id, so a lookup is one hash probe and ignores case. When
+ * objects of several types share a name, the index keeps the one that
+ * SkyMapComposite::findByName() would find first walking its components: solar system
+ * objects, deep sky objects, constellations, stars, supernovae and then satellites.
+ *
+ * Some components load their objects in a background thread, so the index is locked.
+ */
+class SkyObjectNameIndex
+{
+    public:
+        /** @short Index @p object of @p type under @p name, unless an object of higher precedence has it. */
+        void insert(const QString &name, const SkyObject *object, int type);
+
+        /** @short Remove the entry of @p name if it is @p object. */
+        void remove(const QString &name, const SkyObject *object);
+
+        /** @short Remove all the objects of @p type. Their objects may be deleted already. */
+        void removeType(int type);
+
+        /** @return the object with @p name, or nullptr if no object was indexed under it. */
+        const SkyObject *find(const QString &name) const;
+
+        int size() const;
+
+    private:
+        /** @return the rank of @p type in the search order of SkyMapComposite::findByName(), lower first. */
+        static int precedence(int type);
+
+        struct Entry
+        {
+            const SkyObject *object;
+            int type;
+        };
+
+        mutable QReadWriteLock m_Lock;
+        QHash<NameTable::Id, Entry> m_Entries;
+};
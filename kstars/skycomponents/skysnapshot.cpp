@@ -0,0 +1,79 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "skysnapshot.h"
+
+#include "ksutils.h"
+#include "kspaths.h"
+#include "linelist.h"
+#include "skiphashlist.h"
+#include "skymesh.h"
+#include "skyobjects/skypoint.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+
+#include <cstring>
+
+SkySnapshot::SkySnapshot(const QString &name, const QStringList &dataFiles)
+{
+    m_Path = QDir(KSPaths::writableLocation(QStandardPaths::CacheLocation)).filePath(name + ".snapshot");
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArray::number(SkyMesh::Instance()->level()));
+    for (const auto &dataFile : dataFiles)
+    {
+        QFile file;
+        if (KSUtils::openDataFile(file, dataFile))
+            hash.addData(&file);
+    }
+    const QByteArray digest = hash.result();
+    std::memcpy(&m_Tag, digest.constData(), sizeof(m_Tag));
+}
+
+bool SkySnapshot::open()
+{
+    return m_Table.open(m_Path, VERSION, sizeof(Record), m_Tag);
+}
+
+void SkySnapshot::addList(LineList *lineList)
+{
+    auto *skipList = dynamic_cast<SkipHashList *>(lineList);
+    add(LINE_LIST, skipList != nullptr, 0, 0, 0);
+
+    const SkyList *points = lineList->points();
+    for (int i = 0; i < points->size(); i++)
+    {
+        const SkyPoint *point = points->at(i).get();
+        add(POINT, skipList && skipList->skip(i), 0, point->ra0().Hours(), point->dec0().Degrees());
+    }
+}
+
+void SkySnapshot::addPolygon(const QString &name, bool wrapRA, const QPolygonF &vertices)
+{
+    add(POLYGON, wrapRA, m_Strings.add(name), 0, 0);
+    for (const QPointF &vertex : vertices)
+        add(VERTEX, false, 0, vertex.x(), vertex.y());
+}
+
+void SkySnapshot::addTrixel(Kind kind, Trixel trixel)
+{
+    add(kind, false, trixel, 0, 0);
+}
+
+void SkySnapshot::add(Kind kind, bool flag, quint32 value, double ra, double dec)
+{
+    const Record record { kind, flag, value, ra, dec };
+    m_Records.append(reinterpret_cast<const char *>(&record), sizeof(Record));
+    m_Count++;
+}
+
+bool SkySnapshot::write()
+{
+    // The table may be mapped from a previous start
+    m_Table.close();
+    return ElementTable::write(m_Path, VERSION, sizeof(Record), m_Count, m_Records, m_Strings, m_Tag);
+}
@@ -0,0 +1,113 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "auxiliary/elementtable.h"
+#include "typedef.h"
+
+#include <QPolygonF>
+#include <QStringList>
+
+class LineList;
+
+/**
+ * @class SkySnapshot
+ * @short A memory mapped snapshot of the indexed lines and polygons of a static sky component.
+ *
+ * Parsing the text data files of the Milky Way or of the constellation boundaries and indexing them
+ * in the sky mesh gives the same result on every start. The snapshot stores that result as an
+ * ElementTable of records: each list is followed by its points and by the trixels it is indexed in.
+ *
+ * It is written to the cache directory on the first start. Its tag is a checksum of the data files
+ * and of the mesh level, so that a changed data file or mesh rebuilds it.
+ */
+class SkySnapshot
+{
+    public:
+        enum Kind : quint16
+        {
+            /// Starts a LineList, flagged for a SkipHashList
+            LINE_LIST,
+            /// A point of the list, flagged if the segment it starts is skipped
+            POINT,
+            /// A trixel of the line index of the list
+            LINE_TRIXEL,
+            /// A trixel of the polygon index of the list
+            POLY_TRIXEL,
+            /// Starts a polygon, value is the offset of its name, flagged if it wraps around RA 0
+            POLYGON,
+            /// A vertex of the polygon
+            VERTEX,
+            /// A trixel of the index of the polygon
+            POLYGON_TRIXEL
+        };
+
+        struct Record
+        {
+            quint16 kind;
+            quint16 flag;
+            /// The trixel, or the string offset of a name
+            quint32 value;
+            /// Hours
+            double ra;
+            /// Degrees
+            double dec;
+        };
+
+        static constexpr quint32 VERSION = 1;
+
+        /**
+         * @param name the base name of the snapshot file
+         * @param dataFiles the data files the component is loaded from
+         */
+        SkySnapshot(const QString &name, const QStringList &dataFiles);
+
+        /**
+         * @short Map the snapshot.
+         * @return false if it is missing or was built from other data, then the component loads
+         * from text and records what it loads for write().
+         */
+        bool open();
+
+        int count() const
+        {
+            return m_Table.count();
+        }
+
+        const Record &record(int index) const
+        {
+            return m_Table.record<Record>(index);
+        }
+
+        QString string(quint32 offset) const
+        {
+            return m_Table.string(offset);
+        }
+
+        /** @short Record @p lineList and its points. */
+        void addList(LineList *lineList);
+
+        /** @short Record a polygon named @p name and its @p vertices, in hours and degrees. */
+        void addPolygon(const QString &name, bool wrapRA, const QPolygonF &vertices);
+
+        /** @short Record a trixel of @p kind. */
+        void addTrixel(Kind kind, Trixel trixel);
+
+        /** @short Write the recorded lists, replacing the snapshot. */
+        bool write();
+
+    private:
+        void add(Kind kind, bool flag, quint32 value, double ra, double dec);
+
+        QString m_Path;
+        quint32 m_Tag { 0 };
+        ElementTable m_Table;
+
+        QByteArray m_Records;
+        ElementTable::StringPool m_Strings;
+        quint32 m_Count { 0 };
+};
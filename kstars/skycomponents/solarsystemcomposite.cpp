@@ -97,6 +97,12 @@ SolarSystemComposite::~SolarSystemComposite()
     delete (m_EarthShadow);
 }
 
+void SolarSystemComposite::loadMinorBodies()
+{
+    m_AsteroidsComponent->loadData();
+    m_CometsComponent->loadData();
+}
+
 bool SolarSystemComposite::selected()
 {
 #ifndef KSTARS_LITE
@@ -130,6 +136,14 @@ void SolarSystemComposite::updateSolarSystemBodies(KSNumbers *num)
     }
 }
 
+void SolarSystemComposite::updateMinorBody(SkyObject *body)
+{
+    if (body->type() == SkyObject::ASTEROID)
+        m_AsteroidsComponent->updateBody(body);
+    else if (body->type() == SkyObject::COMET)
+        m_CometsComponent->updateBody(body);
+}
+
 void SolarSystemComposite::updateMoons(KSNumbers *num)
 {
     //    if ( ! selected() ) return;
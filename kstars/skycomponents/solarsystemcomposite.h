@@ -52,8 +52,19 @@ class SolarSystemComposite : public SkyComposite
 
     void updateMoons(KSNumbers *num) override;
 
+    /**
+     * @short Give the asteroid or comet @p body its full position.
+     *
+     * Minor bodies that are too faint or off the screen are updated lazily, see
+     * SolarSystemListComponent::updateBody(). Other objects are left as they are.
+     */
+    void updateMinorBody(SkyObject *body);
+
     void drawTrails(SkyPainter *skyp) override;
 
+    /** @short Load the asteroids and comets, once the sky map can be shown without them. */
+    void loadMinorBodies();
+
     CometsComponent *cometsComponent();
 
     AsteroidsComponent *asteroidsComponent();
@@ -7,18 +7,51 @@
 #include "solarsystemlistcomponent.h"
 
 #include "kstarsdata.h"
+#include "ksnumbers.h"
 #include "Options.h"
-#ifndef KSTARS_LITE
+#ifdef KSTARS_LITE
+#include "skymaplite.h"
+#else
 #include "skymap.h"
 #endif
 #include "solarsystemcomposite.h"
 #include "skyobjects/ksplanet.h"
 #include "skyobjects/ksplanetbase.h"
+#include "auxiliary/executors.h"
 
 #include <KLocalizedString>
 
 #include <QPen>
 
+#include <cmath>
+#include <limits>
+
+namespace
+{
+/// The coarse ephemeris is recomputed when the time changed by more than this, in days
+constexpr double COARSE_INTERVAL = 1.0;
+/// Bound of the geocentric motion of a body at 1 AU, in degrees per day. Minor bodies move by
+/// less than 72 km/s relative to the Earth.
+constexpr double MAX_MOTION = 2.5;
+/// Bound of the topocentric parallax of a body at 1 AU, in degrees
+constexpr double MAX_PARALLAX = 0.0025;
+/// For the difference between the coarse and the full position at the same time, in degrees
+constexpr double POSITION_SLACK = 0.01;
+/// Bounds of the change of the magnitude of a body at 1 AU from the Earth and from the Sun, per
+/// day. The latter is large enough for the strong dependence of comets on the solar distance.
+constexpr double MAG_RATE_EARTH = 0.2;
+constexpr double MAG_RATE_SUN   = 0.7;
+
+const SkyObject *focusObject()
+{
+#ifdef KSTARS_LITE
+    return SkyMapLite::Instance() ? SkyMapLite::Instance()->focusObject() : nullptr;
+#else
+    return SkyMap::Instance() ? SkyMap::Instance()->focusObject() : nullptr;
+#endif
+}
+}
+
 SolarSystemListComponent::SolarSystemListComponent(SolarSystemComposite *p) : ListComponent(p), m_Earth(p->earth())
 {
 }
@@ -34,9 +67,13 @@ void SolarSystemListComponent::update(KSNumbers *)
     {
         KStarsData *data = KStarsData::Instance();
 
-        foreach (SkyObject *o, m_ObjectList)
+        for (int i = 0; i < m_ObjectList.size(); ++i)
         {
-            KSPlanetBase *p = dynamic_cast<KSPlanetBase*>(o);
+            // The others get their horizontal coordinates with their full position
+            if (!isFull(i))
+                continue;
+
+            KSPlanetBase *p = dynamic_cast<KSPlanetBase*>(m_ObjectList[i]);
 
             if (p)
                 p->EquatorialToHorizontal(data->lst(), data->geo()->lat());
@@ -48,17 +85,195 @@ void SolarSystemListComponent::updateSolarSystemBodies(KSNumbers *num)
 {
     if (selected())
     {
-        KStarsData *data = KStarsData::Instance();
-        foreach (SkyObject *o, m_ObjectList)
+        m_Num.reset(new KSNumbers(*num));
+        m_JD = m_Num->julianDay();
+
+        bool reloaded = m_Coarse.size() != static_cast<std::size_t>(m_ObjectList.size());
+        for (int i = 0; !reloaded && i < m_ObjectList.size(); ++i)
+            reloaded = m_Coarse[i].body != m_ObjectList[i];
+
+        if (reloaded || std::abs(m_JD - m_CoarseJD) > COARSE_INTERVAL)
+            updateCoarse(num);
+
+        // The bodies only change their own positions, so they are updated in parallel. The
+        // first one is done here, it fills the state that all of them share, like the Sun
+        // for light bending. Bodies with trails add labeled points and stay on this thread,
+        // as does the focused body, which is always updated.
+        const Cone cone        = viewCone();
+        const SkyObject *focus = focusObject();
+        QVector<int> parallel;
+        for (int i = 0; i < m_ObjectList.size(); ++i)
         {
-            KSPlanetBase *p = (KSPlanetBase *)o;
-            p->findPosition(num, data->geo()->lat(), data->lst(), m_Earth);
-            p->EquatorialToHorizontal(data->lst(), data->geo()->lat());
+            if (i == 0 || ((KSPlanetBase *)m_ObjectList[i])->hasTrail() || m_ObjectList[i] == focus)
+                updateFull(i);
+            else if (needsFull(i, cone))
+                parallel.append(i);
+        }
+
+        Executors::blockingMap(Executors::Interactive, parallel, [this](int index)
+        {
+            updateFull(index);
+        });
+    }
+}
 
-            if (p->hasTrail())
-                p->updateTrail(data->lst(), data->geo()->lat());
+void SolarSystemListComponent::updateBody(SkyObject *body)
+{
+    KSPlanetBase *p = (KSPlanetBase *)body;
+
+    // Bodies with trails are updated every time anyway
+    if (!selected() || !m_Num || p->hasTrail())
+        return;
+
+    KStarsData *data = KStarsData::Instance();
+    p->findPosition(m_Num.get(), data->geo()->lat(), data->lst(), m_Earth);
+    p->EquatorialToHorizontal(data->lst(), data->geo()->lat());
+}
+
+SkyObject *SolarSystemListComponent::objectNearest(SkyPoint *p, double &maxrad)
+{
+    if (!selected())
+        return nullptr;
+
+    const Cone around = cone(*p, maxrad);
+    SkyObject *oBest  = nullptr;
+    for (int i = 0; i < m_ObjectList.size(); ++i)
+    {
+        if (!refresh(i, around))
+            continue;
+
+        double r = m_ObjectList[i]->angularDistanceTo(p).Degrees();
+        if (r < maxrad)
+        {
+            oBest  = m_ObjectList[i];
+            maxrad = r;
         }
     }
+    return oBest;
+}
+
+SolarSystemListComponent::Cone SolarSystemListComponent::cone(const SkyPoint &center, double radius)
+{
+    double sinRA, cosRA, sinDec, cosDec;
+    center.ra().SinCos(sinRA, cosRA);
+    center.dec().SinCos(sinDec, cosDec);
+
+    Cone cone;
+    cone.x      = cosDec * cosRA;
+    cone.y      = cosDec * sinRA;
+    cone.z      = sinDec;
+    cone.radius = radius;
+    return cone;
+}
+
+SolarSystemListComponent::Cone SolarSystemListComponent::viewCone()
+{
+#ifndef KSTARS_LITE
+    SkyMap *map = SkyMap::Instance();
+    if (map)
+        return cone(*map->focus(), map->fov());
+#endif
+    return Cone();
+}
+
+double SolarSystemListComponent::magnitudeLimit() const
+{
+    return std::numeric_limits<double>::infinity();
+}
+
+bool SolarSystemListComponent::refresh(int index, const Cone &cone)
+{
+    if (isFull(index))
+        return true;
+
+    if (!needsFull(index, cone))
+        return false;
+
+    updateFull(index);
+    return true;
+}
+
+bool SolarSystemListComponent::isFull(int index) const
+{
+    // Before the first update and right after a reload, the positions are as they were
+    if (!m_Num || index >= static_cast<int>(m_Coarse.size()) || m_Coarse[index].body != m_ObjectList[index])
+        return true;
+
+    return m_Coarse[index].fullJD == m_JD;
+}
+
+void SolarSystemListComponent::updateCoarse(const KSNumbers *num)
+{
+    m_CoarseJD = num->julianDay();
+    m_Coarse.assign(m_ObjectList.size(), CoarseState());
+
+    if (m_Coarse.empty())
+        return;
+
+    auto coarse = [this, num](CoarseState & state)
+    {
+        KSPlanetBase *p = (KSPlanetBase *)m_ObjectList[static_cast<int>(&state - m_Coarse.data())];
+        state.body      = p;
+
+        // Bodies with trails always get their full position, this one would add to the trail
+        if (p->hasTrail())
+            return;
+
+        p->findPosition(num, nullptr, nullptr, m_Earth);
+
+        double sinRA, cosRA, sinDec, cosDec;
+        p->ra().SinCos(sinRA, cosRA);
+        p->dec().SinCos(sinDec, cosDec);
+        state.x      = cosDec * cosRA;
+        state.y      = cosDec * sinRA;
+        state.z      = sinDec;
+        state.mag    = p->mag();
+        state.rearth = p->rearth();
+        state.rsun   = p->rsun();
+    };
+
+    // As in updateSolarSystemBodies(), the first body fills the shared state
+    coarse(m_Coarse.front());
+    Executors::blockingMap(Executors::Interactive, m_Coarse.begin() + 1, m_Coarse.end(), coarse);
+}
+
+void SolarSystemListComponent::updateFull(int index)
+{
+    KStarsData *data = KStarsData::Instance();
+    KSPlanetBase *p  = (KSPlanetBase *)m_ObjectList[index];
+
+    p->findPosition(m_Num.get(), data->geo()->lat(), data->lst(), m_Earth);
+    p->EquatorialToHorizontal(data->lst(), data->geo()->lat());
+
+    if (p->hasTrail())
+        p->updateTrail(data->lst(), data->geo()->lat());
+
+    if (index < static_cast<int>(m_Coarse.size()) && m_Coarse[index].body == p)
+        m_Coarse[index].fullJD = m_JD;
+}
+
+bool SolarSystemListComponent::needsFull(int index, const Cone &cone) const
+{
+    const CoarseState &state = m_Coarse[index];
+
+    // No coarse position, like for the bodies with trails
+    if (state.rearth <= 0 || state.rsun <= 0)
+        return true;
+
+    const double days = std::abs(m_JD - m_CoarseJD);
+
+    if (!std::isnan(state.mag) &&
+            state.mag - days * (MAG_RATE_EARTH / state.rearth + MAG_RATE_SUN / state.rsun) > magnitudeLimit())
+        return false;
+
+    if (cone.radius >= 180)
+        return true;
+
+    const double margin   = (MAX_MOTION * days + MAX_PARALLAX) / state.rearth + POSITION_SLACK;
+    const double cosine   = cone.x * state.x + cone.y * state.y + cone.z * state.z;
+    const double distance = acos(qBound(-1.0, cosine, 1.0)) / dms::DegToRad;
+
+    return distance <= cone.radius + margin;
 }
 
 void SolarSystemListComponent::drawTrails(SkyPainter *skyp)
@@ -8,12 +8,21 @@
 
 #include "listcomponent.h"
 
+#include <memory>
+#include <vector>
+
+class KSNumbers;
 class KSPlanet;
 class SolarSystemComposite;
 
 /**
  * @class SolarSystemListComponent
  *
+ * The bodies are updated in two tiers. A coarse geocentric ephemeris of all of them is
+ * computed about once a day. On each update, only the bodies that may be brighter than
+ * magnitudeLimit() and within the view according to it get their full position, the others
+ * get it when they are drawn or queried, see refresh() and updateBody().
+ *
  * @author Jason Harris
  * @version 1.0
  */
@@ -35,9 +44,74 @@ class SolarSystemListComponent : public ListComponent
      */
     void updateSolarSystemBodies(KSNumbers *num) override;
 
+    /**
+     * @short Give @p body its full position for the time of the last update.
+     *
+     * For the bodies that are used regardless of the view, like the clicked object.
+     */
+    void updateBody(SkyObject *body);
+
+    SkyObject *objectNearest(SkyPoint *p, double &maxrad) override;
+
   protected:
     void drawTrails(SkyPainter *skyp) override;
 
+    /** A circle on the sky, as a unit vector of its center and a radius in degrees */
+    struct Cone
+    {
+        double x { 0 };
+        double y { 0 };
+        double z { 0 };
+        double radius { 180 };
+    };
+
+    /** @return the circle of @p radius degrees around @p center */
+    static Cone cone(const SkyPoint &center, double radius);
+
+    /** @return the circle that contains the sky map, or the whole sky if there is no map */
+    static Cone viewCone();
+
+    /**
+     * @return the faint limit of the drawn bodies, the full position of fainter bodies is
+     * not computed. No limit by default.
+     */
+    virtual double magnitudeLimit() const;
+
+    /**
+     * @short Make sure the body at @p index has its full position, if it is needed.
+     *
+     * @return false if the body is fainter than magnitudeLimit() or outside @p cone according
+     * to the coarse ephemeris, in which case it was not updated
+     */
+    bool refresh(int index, const Cone &cone);
+
   private:
+    struct CoarseState
+    {
+        /// The body the state belongs to, to notice when the list was reloaded
+        const SkyObject *body { nullptr };
+        /// Geocentric apparent direction and magnitude at m_CoarseJD
+        float x { 0 };
+        float y { 0 };
+        float z { 0 };
+        float mag { 0 };
+        float rearth { 0 };
+        float rsun { 0 };
+        /// Julian day of the last full position
+        double fullJD { 0 };
+    };
+
+    /** @return false if the body at @p index has only its coarse position */
+    bool isFull(int index) const;
+    void updateCoarse(const KSNumbers *num);
+    void updateFull(int index);
+    bool needsFull(int index, const Cone &cone) const;
+
     KSPlanet *m_Earth { nullptr };
+    /// Time of the last update, the bodies updated later are updated for it
+    std::unique_ptr<KSNumbers> m_Num;
+    double m_JD { 0 };
+    /// Coarse ephemeris, one entry per body of m_ObjectList
+    std::vector<CoarseState> m_Coarse;
+    double m_CoarseJD { 0 };
 };
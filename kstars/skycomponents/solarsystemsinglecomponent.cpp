@@ -33,13 +33,11 @@ SolarSystemSingleComponent::SolarSystemSingleComponent(SolarSystemComposite *par
     m_Planet->loadData();
     if (!m_Planet->name().isEmpty())
     {
-        objectNames(m_Planet->type()).append(m_Planet->name());
-        objectLists(m_Planet->type()).append(QPair<QString, const SkyObject *>(m_Planet->name(), m_Planet));
+        addToNames(m_Planet->type(), m_Planet->name(), m_Planet);
     }
     if (!m_Planet->longname().isEmpty() && m_Planet->longname() != m_Planet->name())
     {
-        objectNames(m_Planet->type()).append(m_Planet->longname());
-        objectLists(m_Planet->type()).append(QPair<QString, const SkyObject *>(m_Planet->longname(), m_Planet));
+        addToNames(m_Planet->type(), m_Planet->longname(), m_Planet);
     }
 }
 
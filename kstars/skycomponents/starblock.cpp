@@ -6,6 +6,8 @@
 
 #include <QDebug>
 
+#include <algorithm>
+
 #include "starblock.h"
 #include "skyobjects/starobject.h"
 #include "starcomponent.h"
@@ -40,6 +42,35 @@ StarBlock::StarBlock(int nstars)
 {
 }
 
+qint64 StarBlock::byteSize() const
+{
+    return sizeof(StarBlock) + stars.capacity() * qint64(sizeof(StarBlockEntry));
+}
+
+int StarBlock::brighterThan(float maglim) const
+{
+    // The stars are sorted by magnitude, a binary search only reads a few of them.
+    const StarBlockEntry *begin = stars.constData();
+    const StarBlockEntry *end   = begin + nStars;
+    return std::partition_point(begin, end, [maglim](const StarBlockEntry &entry)
+    {
+#ifdef KSTARS_LITE
+        return entry.star.mag() <= maglim;
+#else
+        return entry.mag() <= maglim;
+#endif
+    }) - begin;
+}
+
+void StarBlock::updateMagRange(const StarObject &star)
+{
+    const float mag = star.mag();
+    if (mag > faintMag)
+        faintMag = mag;
+    if (mag < brightMag)
+        brightMag = mag;
+}
+
 void StarBlock::reset()
 {
     if (parent)
@@ -60,10 +91,7 @@ StarNode *StarBlock::addStar(const StarData &data)
     StarObject &star = node.star;
 
     star.init(&data);
-    if (star.mag() > faintMag)
-        faintMag = star.mag();
-    if (star.mag() < brightMag)
-        brightMag = star.mag();
+    updateMagRange(star);
     return &node;
 }
 
@@ -75,10 +103,7 @@ StarNode *StarBlock::addStar(const DeepStarData &data)
     StarObject &star = node.star;
 
     star.init(&data);
-    if (star.mag() > faintMag)
-        faintMag = star.mag();
-    if (star.mag() < brightMag)
-        brightMag = star.mag();
+    updateMagRange(star);
     return &node;
 }
 #else
@@ -89,10 +114,7 @@ StarObject *StarBlock::addStar(const StarData &data)
     StarObject &star = stars[nStars++];
 
     star.init(&data);
-    if (star.mag() > faintMag)
-        faintMag = star.mag();
-    if (star.mag() < brightMag)
-        brightMag = star.mag();
+    updateMagRange(star);
     return &star;
 }
 
@@ -103,10 +125,7 @@ StarObject *StarBlock::addStar(const DeepStarData &data)
     StarObject &star = stars[nStars++];
 
     star.init(&data);
-    if (star.mag() > faintMag)
-        faintMag = star.mag();
-    if (star.mag() < brightMag)
-        brightMag = star.mag();
+    updateMagRange(star);
     return &star;
 }
 #endif
@@ -35,6 +35,9 @@ struct StarNode
  *
  * Holds a block of stars and various peripheral variables to mark its place in data structures
  *
+ * The stars are held as full StarObjects, brightest first, as pointers into the block are handed out
+ * by objectNearest(), starsInAperture(), the labels and the KStars Lite nodes.
+ *
  * @author  Akarsh Simha
  * @version 1.0
  */
@@ -107,6 +110,15 @@ class StarBlock
 
     inline QVector<StarBlockEntry> &contents() { return stars; }
 
+    /**
+     * @short  Return the number of leading stars brighter than the given magnitude
+     *
+     * Stars are stored by increasing magnitude, so these are the stars to draw for the limit.
+     * They are found by a binary search, instead of testing each star in the loops over the block.
+     * @param  maglim Magnitude limit
+     */
+    int brighterThan(float maglim) const;
+
     // These methods are there because we might want to make faintMag and brightMag private at some point
     /**
      * @short  Return the magnitude of the brightest star in this StarBlock
@@ -129,6 +141,9 @@ class StarBlock
      */
     inline int getStarCount() const { return nStars; }
 
+    /** @return the approximate memory used by this StarBlock, in bytes */
+    qint64 byteSize() const;
+
     /** @short  Reset this StarBlock's data, for reuse of the StarBlock */
     void reset();
 
@@ -148,4 +163,6 @@ class StarBlock
     int nStars { 0 };
     /** Array of stars. */
     QVector<StarBlockEntry> stars;
+
+    void updateMagRange(const StarObject &star);
 };
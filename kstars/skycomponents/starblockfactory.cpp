@@ -6,13 +6,14 @@
 
 #include "starblockfactory.h"
 
+#include "deepstarcomponent.h"
+#include "Options.h"
 #include "starblock.h"
 #include "starobject.h"
 
-#include <kstars_debug.h>
+#include <QHash>
 
-// TODO: Implement a better way of deciding this
-#define DEFAULT_NCACHE 12
+#include <kstars_debug.h>
 
 StarBlockFactory *StarBlockFactory::pInstance = nullptr;
 
@@ -29,7 +30,7 @@ StarBlockFactory::StarBlockFactory()
     last    = nullptr;
     nBlocks = 0;
     drawID  = 0;
-    nCache  = DEFAULT_NCACHE;
+    memoryBudget = qint64(Options::starCacheSize()) * 1024 * 1024;
 }
 
 StarBlockFactory::~StarBlockFactory()
@@ -39,19 +40,23 @@ StarBlockFactory::~StarBlockFactory()
         pInstance = nullptr;
 }
 
+std::shared_ptr<StarBlock> StarBlockFactory::newBlock()
+{
+    std::shared_ptr<StarBlock> block(new StarBlock);
+    ++nBlocks;
+    ++nAllocations;
+    memoryUsage += block->byteSize();
+    return block;
+}
+
 std::shared_ptr<StarBlock> StarBlockFactory::getBlock()
 {
     std::shared_ptr<StarBlock> freeBlock;
 
-    if (nBlocks < nCache)
-    {
-        freeBlock.reset(new StarBlock);
-        if (freeBlock.get())
-        {
-            ++nBlocks;
-            return freeBlock;
-        }
-    }
+    // Blocks of the previous draw cycles are kept while they fit, so that panning back does not reload them
+    if (memoryBudget <= 0 || memoryUsage < memoryBudget)
+        return newBlock();
+
     if (last && (last->drawID != drawID || last->drawID == 0))
     {
         //        qCDebug(KSTARS) << "Recycling block with drawID =" << last->drawID << "and current drawID =" << drawID;
@@ -70,13 +75,78 @@ std::shared_ptr<StarBlock> StarBlockFactory::getBlock()
         freeBlock->reset();
         freeBlock->prev = nullptr;
         freeBlock->next = nullptr;
+        ++nEvictions;
         return freeBlock;
     }
-    freeBlock.reset(new StarBlock);
-    if (freeBlock.get())
-        ++nBlocks;
 
-    return freeBlock;
+    // All the blocks are needed by this draw cycle
+    return newBlock();
+}
+
+void StarBlockFactory::setMemoryBudget(qint64 bytes)
+{
+    memoryBudget = bytes;
+    if (memoryBudget > 0 && memoryUsage > memoryBudget)
+        qCDebug(KSTARS) << trim() << "StarBlocks freed to fit the star cache in" << memoryBudget << "bytes";
+}
+
+int StarBlockFactory::trim()
+{
+    int i = 0;
+
+    while (last != nullptr && memoryUsage > memoryBudget && (last->drawID != drawID || last->drawID == 0))
+    {
+        std::shared_ptr<StarBlock> block = last;
+        last = block->prev;
+        if (last)
+            last->next = nullptr;
+        else
+            first = nullptr;
+
+        memoryUsage -= block->byteSize();
+        block->reset();
+        block->prev = nullptr;
+        block->next = nullptr;
+        --nBlocks;
+        ++nEvictions;
+        ++i;
+    }
+
+    return i;
+}
+
+QJsonObject StarBlockFactory::statistics() const
+{
+    struct Usage
+    {
+        int blocks { 0 };
+        qint64 bytes { 0 };
+    };
+    QHash<QString, Usage> catalogs;
+
+    for (std::shared_ptr<StarBlock> block = first; block; block = block->next)
+    {
+        const DeepStarComponent *catalog = block->parent ? block->parent->getParent() : nullptr;
+        Usage &usage = catalogs[catalog ? catalog->getFileName() : QString("unused")];
+        ++usage.blocks;
+        usage.bytes += block->byteSize();
+    }
+
+    QJsonObject catalogUsage;
+    for (auto it = catalogs.constBegin(); it != catalogs.constEnd(); ++it)
+        catalogUsage.insert(it.key(), QJsonObject{ { "blocks", it.value().blocks }, { "bytes", it.value().bytes } });
+
+    return QJsonObject
+    {
+        { "budget", memoryBudget },
+        { "usage", memoryUsage },
+        { "blocks", nBlocks },
+        { "hits", static_cast<qint64>(nHits) },
+        { "misses", static_cast<qint64>(nMisses) },
+        { "allocations", static_cast<qint64>(nAllocations) },
+        { "evictions", static_cast<qint64>(nEvictions) },
+        { "catalogs", catalogUsage }
+    };
 }
 
 bool StarBlockFactory::markFirst(std::shared_ptr<StarBlock>& block)
@@ -239,6 +309,7 @@ int StarBlockFactory::deleteBlocks(int nblocks)
     while (last != nullptr && i != nblocks)
     {
         temp = last->prev;
+        memoryUsage -= last->byteSize();
         last.reset();
         last = temp;
         i++;
@@ -292,6 +363,7 @@ int StarBlockFactory::freeUnused()
     while (last != nullptr && last->drawID < drawID && i != nBlocks)
     {
         temp = last->prev;
+        memoryUsage -= last->byteSize();
         last.reset();
         last = temp;
         i++;
@@ -8,6 +8,10 @@
 
 #include "typedef.h"
 
+#include <QJsonObject>
+
+#include <memory>
+
 class StarBlock;
 
 /**
@@ -66,6 +70,35 @@ class StarBlockFactory
      */
     inline int getBlockCount() const { return nBlocks; }
 
+    /**
+     * @short  Set the memory the cached StarBlocks may use
+     *
+     * New blocks are allocated until the budget is reached, then the least recently used
+     * blocks are recycled, so blocks from the last draw cycles survive as long as they fit.
+     * Blocks needed by the current draw cycle are always allocated, even past the budget.
+     * If the budget is lowered, blocks not used in this draw cycle are freed to fit it.
+     *
+     * @param  bytes  Budget in bytes, 0 to keep all the blocks ever loaded
+     */
+    void setMemoryBudget(qint64 bytes);
+
+    inline qint64 getMemoryBudget() const { return memoryBudget; }
+
+    /** @return the approximate memory used by the allocated StarBlocks, in bytes */
+    inline qint64 getMemoryUsage() const { return memoryUsage; }
+
+    /** @short  Count a trixel which had its stars loaded already, see StarBlockList::fillToMag() */
+    inline void countHit() { ++nHits; }
+
+    /** @short  Count a trixel which had to read stars from its catalog */
+    inline void countMiss() { ++nMisses; }
+
+    /**
+     * @return the cache counters and the blocks held by each catalog, as
+     * { budget, usage, blocks, hits, misses, allocations, evictions, catalogs: { name: { blocks, bytes } } }
+     */
+    QJsonObject statistics() const;
+
     /**
      * @short  Frees all StarBlocks that are in the cache
      * @return The number of StarBlocks freed
@@ -100,9 +133,23 @@ class StarBlockFactory
      */
     int deleteBlocks(int nblocks);
 
+    /** @short  Allocate a new StarBlock and account for it */
+    std::shared_ptr<StarBlock> newBlock();
+
+    /**
+     * @short  Frees the least recently used blocks not in this draw cycle until the budget is met
+     * @return Number of blocks freed
+     */
+    int trim();
+
     std::shared_ptr<StarBlock> first, last; // Pointers to the beginning and end of the linked list
     int nBlocks;             // Number of blocks we currently have in the cache
-    int nCache;              // Number of blocks to start recycling cached blocks at
+    qint64 memoryBudget { 0 };
+    qint64 memoryUsage { 0 };
+    quint64 nHits { 0 };
+    quint64 nMisses { 0 };
+    quint64 nAllocations { 0 };
+    quint64 nEvictions { 0 };
 
     static StarBlockFactory *pInstance;
 };
@@ -18,6 +18,8 @@
 
 #include <QDebug>
 
+#include <cstring>
+
 StarBlockList::StarBlockList(const Trixel &tr, DeepStarComponent *parent)
 {
     trixel       = tr;
@@ -75,8 +77,14 @@ bool StarBlockList::fillToMag(float maglim)
     if (staticStars)
         return false;
 
-    if (faintMag >= maglim)
-        return true;
+    // Either the stars are loaded, or all the stars of the trixel are
+    if (faintMag >= maglim || nStars >= dSReader->getRecordCount(trixel))
+    {
+        SBFactory->countHit();
+        return faintMag >= maglim;
+    }
+
+    SBFactory->countMiss();
 
     if (!dataFile)
     {
@@ -92,7 +100,27 @@ bool StarBlockList::fillToMag(float maglim)
 
     Q_ASSERT(nBlocks == (unsigned int)blocks.size());
 
-    BinFileHelper::unsigned_KDE_fseek(dataFile, readOffset, SEEK_SET);
+    // Records are copied straight from the memory mapped file if possible, which avoids a system
+    // call for every star. Otherwise they are read from the file.
+    const uchar *mappedData = dSReader->getMappedData();
+    const quint64 mappedSize = dSReader->getMappedSize();
+    auto readRecord = [&](void *record, size_t size)
+    {
+        if (mappedData)
+        {
+            if (readOffset + size > mappedSize)
+                return false;
+            memcpy(record, mappedData + readOffset, size);
+        }
+        else if (fread(record, size, 1, dataFile) != 1)
+            return false;
+
+        readOffset += size;
+        return true;
+    };
+
+    if (!mappedData)
+        BinFileHelper::unsigned_KDE_fseek(dataFile, readOffset, SEEK_SET);
 
     /*
     qDebug() << Q_FUNC_INFO << "Reading trixel" << trixel << ", id on disk =" << trixelId << ", currently nStars =" << nStars
@@ -102,8 +130,6 @@ bool StarBlockList::fillToMag(float maglim)
 
     while (maglim >= faintMag && nStars < dSReader->getRecordCount(trixelId))
     {
-        int ret = 0;
-
         if (nBlocks == 0 || blocks[nBlocks - 1]->isFull())
         {
             std::shared_ptr<StarBlock> newBlock = SBFactory->getBlock();
@@ -126,18 +152,24 @@ bool StarBlockList::fillToMag(float maglim)
         // TODO: Make this more general
         if (dSReader->guessRecordSize() == 32)
         {
-            ret = fread(&stardata, sizeof(StarData), 1, dataFile);
+            if (!readRecord(&stardata, sizeof(StarData)))
+            {
+                qWarning() << "ERROR: Truncated star record in trixel" << trixel;
+                return false;
+            }
             if (dSReader->getByteSwap())
                 DeepStarComponent::byteSwap(&stardata);
-            readOffset += sizeof(StarData);
             blocks[nBlocks - 1]->addStar(stardata);
         }
         else
         {
-            ret = fread(&deepstardata, sizeof(DeepStarData), 1, dataFile);
+            if (!readRecord(&deepstardata, sizeof(DeepStarData)))
+            {
+                qWarning() << "ERROR: Truncated star record in trixel" << trixel;
+                return false;
+            }
             if (dSReader->getByteSwap())
                 DeepStarComponent::byteSwap(&deepstardata);
-            readOffset += sizeof(DeepStarData);
             blocks[nBlocks - 1]->addStar(deepstardata);
         }
 
@@ -92,6 +92,12 @@ class StarBlockList
      */
     inline Trixel getTrixel() const { return trixel; }
 
+    /**
+     * @short  Returns the catalog this SBL belongs to
+     * @return The parent DeepStarComponent
+     */
+    inline DeepStarComponent *getParent() const { return parent; }
+
   private:
     Trixel trixel;
     unsigned long nStars { 0 };
@@ -25,9 +25,12 @@
 #include "projections/projector.h"
 
 #include "kstars_debug.h"
+#include "auxiliary/executors.h"
 
 #include <qplatformdefs.h>
 
+#include <algorithm>
+
 #ifdef _WIN32
 #include <windows.h>
 #endif
@@ -45,6 +48,23 @@
 
 StarComponent *StarComponent::pinstance = nullptr;
 
+namespace
+{
+// Number of stars indexed by each task when re-indexing
+constexpr int REINDEX_CHUNK = 4096;
+
+// Insert the star before the first fainter star, so that the list stays sorted by magnitude.
+void insertByMagnitude(StarList *list, StarObject *star)
+{
+    const float mag = star->mag();
+    auto it = std::find_if(list->begin(), list->end(), [mag](const StarObject * other)
+    {
+        return other->mag() >= mag;
+    });
+    list->insert(it, star);
+}
+}
+
 StarComponent::StarComponent(SkyComposite *parent)
     : ListComponent(parent), m_reindexNum(J2000)
 {
@@ -175,24 +195,87 @@ void StarComponent::reindexAll(KSNumbers *num)
 
     qCInfo(KSTARS) << "Re-indexing Stars to year" << 2000.0 + num->julianCenturies() * 100.0;
 
+    const double oldMillenia = m_reindexNum.julianMillenia();
+    const double newMillenia = num->julianMillenia();
     m_reindexNum = KSNumbers(*num);
     m_skyMesh->setKSNumbers(num);
 
-    // clear out the old index
-    for (auto &item : *m_starIndex)
+    // Without a trixel for every star, everything is indexed from scratch.
+    const int count = m_ObjectList.size();
+    const bool incremental = (m_starTrixels.size() == count);
+    if (!incremental)
+        m_starTrixels.fill(Trixel(0), count);
+
+    // Find the new trixels in parallel. StarObject::getIndexCoords() ignores proper motions below
+    // 0.1 arcseconds, so the stars moving less than that at both dates cannot change trixels.
+    QVector<QPair<int, int>> chunks;
+    for (int i = 0; i < count; i += REINDEX_CHUNK)
+        chunks.append(qMakePair(i, qMin(count, i + REINDEX_CHUNK)));
+
+    // The high proper motion lists move their stars in between, so these are always indexed.
+    const double maxMillenia2 = qMax(oldMillenia * oldMillenia, newMillenia * newMillenia);
+    const double highPM = m_highPMStars.last()->threshold();
+
+    QVector<Trixel> trixels = m_starTrixels;
+    Trixel *newTrixels = trixels.data();
+    Executors::blockingMap(Executors::Interactive, chunks, [&](const QPair<int, int> &chunk)
     {
-        item->clear();
+        for (int i = chunk.first; i < chunk.second; ++i)
+        {
+            StarObject *star = static_cast<StarObject *>(m_ObjectList.at(i));
+            const double pmms = star->pmMagnitudeSquared();
+            if (incremental && !(pmms * maxMillenia2 >= .01) && !(pmms >= highPM * highPM))
+                continue;
+            newTrixels[i] = m_skyMesh->indexStar(star);
+        }
+    });
+
+    int moved = 0;
+    for (int i = 0; i < count; ++i)
+        moved += (trixels.at(i) != m_starTrixels.at(i));
+
+    // If few stars changed trixels, move them only.
+    bool rebuild = !incremental || moved * 8 >= count;
+    for (int i = 0; !rebuild && i < count; ++i)
+    {
+        if (trixels.at(i) == m_starTrixels.at(i))
+            continue;
+        StarObject *star = static_cast<StarObject *>(m_ObjectList.at(i));
+        // The high proper motion lists may have moved the star since, then its trixel is unknown.
+        if (!m_starIndex->at(m_starTrixels.at(i))->removeOne(star))
+        {
+            rebuild = true;
+            break;
+        }
+        insertByMagnitude(m_starIndex->at(trixels.at(i)), star);
     }
 
-    // re-populate it from the objectList
-    for (auto &object : m_ObjectList)
+    if (!rebuild)
+        qCDebug(KSTARS) << "Moved" << moved << "of" << count << "stars to new trixels";
+    else
     {
-        StarObject *star = dynamic_cast<StarObject *>(object);
-        Trixel trixel    = m_skyMesh->indexStar(star);
+        // clear out the old index
+        for (auto &item : *m_starIndex)
+        {
+            item->clear();
+        }
+
+        // re-populate it from the objectList
+        for (int i = 0; i < count; ++i)
+            m_starIndex->at(trixels.at(i))->append(static_cast<StarObject *>(m_ObjectList.at(i)));
 
-        m_starIndex->at(trixel)->append(star);
+        // Stars come from several trixels of the catalog, the draw loop needs them sorted by magnitude again.
+        Executors::blockingMap(Executors::Interactive, *m_starIndex, [](StarList * list)
+        {
+            std::stable_sort(list->begin(), list->end(), [](const StarObject * a, const StarObject * b)
+            {
+                return a->mag() < b->mag();
+            });
+        });
     }
 
+    m_starTrixels = trixels;
+
     // Let everyone else know we have re-indexed to num
     for (auto &star : m_highPMStars)
     {
@@ -254,6 +337,8 @@ void StarComponent::draw(SkyPainter *skyp)
     if (!selected())
         return;
 
+    QWriteLocker locker(&m_dataLock);
+
     SkyMap *map           = SkyMap::Instance();
     const Projector *proj = map->projector();
     KStarsData *data      = KStarsData::Instance();
@@ -306,13 +391,28 @@ void StarComponent::draw(SkyPainter *skyp)
 
     m_StarBlockFactory->drawID = m_skyMesh->drawID();
 
+    // Share the stars to draw between the trixels in view
+    const int targetStars = Options::targetStarCount();
+    if (m_quotaFrames.size() != m_skyMesh->size())
+    {
+        m_starQuota.fill(0, m_skyMesh->size());
+        m_quotaFrames.fill(0, m_skyMesh->size());
+    }
+    ++m_quotaFrame;
+    m_quotaPerTrixel = (targetStars > 0 && region.size() > 0) ? qMax(1, (targetStars + region.size() - 1) / region.size()) : -1;
+
     int nTrixels = 0;
 
+    // Gather the stars which may be visible, then project them all at once.
+    m_drawStars.clear();
+    m_drawBatch.clear();
     while (region.hasNext())
     {
         ++nTrixels;
         Trixel currentRegion = region.next();
         StarList *starList   = m_starIndex->at(currentRegion);
+        const int quota      = starQuota(currentRegion);
+        int candidates       = 0;
 
         for (auto &star : *starList)
         {
@@ -321,19 +421,38 @@ void StarComponent::draw(SkyPainter *skyp)
 
             float mag = star->mag();
 
-            // break loop if maglim is reached
-            if (mag > maglim)
+            // break loop if maglim is reached, or if the trixel has its share of stars
+            if (mag > maglim || candidates == quota)
                 break;
+            ++candidates;
 
             if (star->updateID != updateID)
                 star->JITupdate();
 
-            bool drawn = skyp->drawPointSource(star, mag, star->spchar());
+            if (!proj->checkVisibility(star))
+                continue;
 
-            //FIXME_SKYPAINTER: find a better way to do this.
-            if (drawn && !(m_hideLabels || mag > labelMagLim))
-                addLabel(proj->toScreen(star), star);
+            m_drawStars.append(star);
+            proj->appendToBatch(m_drawBatch, star);
         }
+        useStarQuota(currentRegion, candidates);
+    }
+
+    proj->toScreenBatch(m_drawBatch);
+    skyp->beginPointSources();
+    for (int i = 0; i < m_drawStars.size(); ++i)
+    {
+        if (!m_drawBatch.visible[i])
+            continue;
+
+        StarObject *star = m_drawStars[i];
+        const float mag  = star->mag();
+        const QPointF pos(m_drawBatch.x[i], m_drawBatch.y[i]);
+        bool drawn = skyp->drawProjectedPointSource(star, pos, mag, star->spchar());
+
+        //FIXME_SKYPAINTER: find a better way to do this.
+        if (drawn && !(m_hideLabels || mag > labelMagLim))
+            addLabel(pos, star);
     }
 
     // Draw focusStar if not null
@@ -344,6 +463,7 @@ void StarComponent::draw(SkyPainter *skyp)
         float mag = focusStar->mag();
         skyp->drawPointSource(focusStar, mag, focusStar->spchar());
     }
+    skyp->endPointSources();
 
     // Now draw each of our DeepStarComponents
     for (auto &component : m_DeepStarComponents)
@@ -541,18 +661,17 @@ bool StarComponent::loadStaticData()
             //if ( ! name.isEmpty() && name != i18n("star"))
             if (named)
             {
-                objectNames(SkyObject::STAR).append(name);
-                objectLists(SkyObject::STAR).append(QPair<QString, const SkyObject *>(name, star));
+                addToNames(SkyObject::STAR, name, star);
             }
 
             if (!visibleName.isEmpty() && gname != name)
             {
                 QString gName = star->gname(false);
-                objectNames(SkyObject::STAR).append(gName);
-                objectLists(SkyObject::STAR).append(QPair<QString, const SkyObject *>(gName, star));
+                addToNames(SkyObject::STAR, gName, star);
             }
 
             appendListObject(star);
+            m_starTrixels.append(trixel);
 
             m_starIndex->at(trixel)->append(star);
             double pm = star->pmMagnitude();
@@ -575,11 +694,11 @@ bool StarComponent::loadStaticData()
 void StarComponent::appendListObject(SkyObject *object)
 {
     m_ObjectList.append(object);
-    m_ObjectHash.insert(object->name().toLower(), object);
-    m_ObjectHash.insert(object->longname().toLower(), object);
-    m_ObjectHash.insert(object->name2().toLower(), object);
-    m_ObjectHash.insert(object->name2().toLower(), object);
-    m_ObjectHash.insert((dynamic_cast<StarObject *>(object))->gname(false).toLower(), object);
+    object->shareNames();
+    hashObjectName(object->name(), object);
+    hashObjectName(object->longname(), object);
+    hashObjectName(object->name2(), object);
+    hashObjectName((dynamic_cast<StarObject *>(object))->gname(false), object);
 }
 
 SkyObject *StarComponent::findStarByGenetiveName(const QString name)
@@ -666,22 +785,24 @@ StarObject *StarComponent::findByHDIndex(int HDnum)
 //
 SkyObject *StarComponent::objectNearest(SkyPoint *p, double &maxrad)
 {
-    m_zoomMagLimit = zoomMagnitudeLimit();
+    // Called from other threads too, so neither the mesh buffers nor the magnitude limit of the draw are used.
+    const float zoomMagLimit = zoomMagnitudeLimit();
 
     SkyObject *oBest = nullptr;
 
-    MeshIterator region(m_skyMesh, OBJ_NEAREST_BUF);
+    std::vector<Trixel> trixels;
+    m_skyMesh->intersect(p->ra().Degrees(), p->dec().Degrees(), maxrad + 1.0, trixels);
 
-    while (region.hasNext())
+    QReadLocker locker(&m_dataLock);
+    for (Trixel trixel : trixels)
     {
-        Trixel currentRegion = region.next();
-        StarList *starList   = m_starIndex->at(currentRegion);
+        StarList *starList = m_starIndex->at(trixel);
 
         for (auto &star : *starList)
         {
             if (!star)
                 continue;
-            if (star->mag() > m_zoomMagLimit)
+            if (star->mag() > zoomMagLimit)
                 continue;
 
             double r = star->angularDistanceTo(p).Degrees();
@@ -720,17 +841,17 @@ void StarComponent::starsInAperture(QList<StarObject *> &list, const SkyPoint &c
     Q_ASSERT(center.ra0().Degrees() >= 0.0);
     Q_ASSERT(center.dec0().Degrees() <= 90.0);
 
-    m_skyMesh->intersect(center.ra0().Degrees(), center.dec0().Degrees(), radius, static_cast<BufNum>(OBJ_NEAREST_BUF));
-
-    MeshIterator region(m_skyMesh, OBJ_NEAREST_BUF);
+    // The mesh buffers are shared with the draw, find the trixels without them.
+    std::vector<Trixel> trixels;
+    m_skyMesh->intersect(center.ra0().Degrees(), center.dec0().Degrees(), radius, trixels);
 
     if (maglim < -28)
         maglim = m_FaintMagnitude;
 
-    while (region.hasNext())
+    QReadLocker readLocker(&m_dataLock);
+    for (Trixel trixel : trixels)
     {
-        Trixel currentRegion = region.next();
-        StarList *starList   = m_starIndex->at(currentRegion);
+        StarList *starList = m_starIndex->at(trixel);
 
         for (auto &star : *starList)
         {
@@ -743,11 +864,43 @@ void StarComponent::starsInAperture(QList<StarObject *> &list, const SkyPoint &c
         }
     }
 
-    // Add stars from the DeepStarComponents as well
+    // Add stars from the DeepStarComponents as well. If some of their stars are not loaded yet,
+    // they are loaded with the write lock, which waits for the draw and the other queries.
+    QList<StarObject *> deepStars;
+    bool loaded = true;
     for (auto &component : m_DeepStarComponents)
+        loaded = loaded && component->starsInAperture(deepStars, trixels, center, radius, maglim, false);
+    readLocker.unlock();
+
+    if (!loaded)
     {
-        component->starsInAperture(list, center, radius, maglim);
+        deepStars.clear();
+        QWriteLocker writeLocker(&m_dataLock);
+        for (auto &component : m_DeepStarComponents)
+            component->starsInAperture(deepStars, trixels, center, radius, maglim, true);
     }
+    list.append(deepStars);
+}
+
+int StarComponent::starQuota(Trixel trixel) const
+{
+    if (m_quotaPerTrixel < 0)
+        return -1;
+    return (m_quotaFrames.at(trixel) == m_quotaFrame) ? m_starQuota.at(trixel) : m_quotaPerTrixel;
+}
+
+void StarComponent::useStarQuota(Trixel trixel, int stars)
+{
+    if (m_quotaPerTrixel < 0)
+        return;
+    m_starQuota[trixel]   = qMax(0, starQuota(trixel) - stars);
+    m_quotaFrames[trixel] = m_quotaFrame;
+}
+
+void StarComponent::setStarCacheSize(uint megabytes)
+{
+    QWriteLocker locker(&m_dataLock);
+    m_StarBlockFactory->setMemoryBudget(qint64(megabytes) * 1024 * 1024);
 }
 
 void StarComponent::byteSwap(StarData *stardata)
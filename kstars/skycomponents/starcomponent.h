@@ -10,8 +10,11 @@
 #include "listcomponent.h"
 #include "skylabel.h"
 #include "stardata.h"
+#include "projections/projectionbatch.h"
 #include "skyobjects/starobject.h"
 
+#include <QReadWriteLock>
+
 #include <memory>
 
 #ifdef KSTARS_LITE
@@ -118,9 +121,32 @@ class StarComponent : public ListComponent
      * If magnitude limit is numerically < -28, the limiting magnitude
      * is assumed to be the limiting magnitude of the catalog (i.e. no magnitude limit)
      * @p list The list to operate on
+     *
+     * This can be called from any thread, concurrently with the sky map being drawn.
+     * Queries run in parallel with each other as long as the deep stars they need are
+     * loaded, otherwise they wait for the draw to load them. The stars returned stay
+     * valid until the next draw may recycle the deep star blocks.
      */
     void starsInAperture(QList<StarObject *> &list, const SkyPoint &center, float radius, float maglim = -29);
 
+    /**
+     * @short Returns how many more stars may be drawn in the trixel in this frame.
+     *
+     * With Options::targetStarCount() set, every trixel of the view gets an equal share of it.
+     * The named stars take the brightest part of the share, then each deep star catalog in turn.
+     * @return the remaining share of the trixel, or -1 if the number of stars is not limited
+     */
+    int starQuota(Trixel trixel) const;
+
+    /** @short Count stars drawn in the trixel against its share, see starQuota() */
+    void useStarQuota(Trixel trixel, int stars);
+
+    /**
+     * @short Set the memory the deep star blocks may use, see StarBlockFactory::setMemoryBudget().
+     * @param megabytes Budget in MiB, 0 to keep all the stars ever loaded
+     */
+    void setStarCacheSize(uint megabytes);
+
     // TODO: Make byteSwap a template method and put it in byteorder.h
     // It should ideally handle 32-bit, 16-bit fields and StarData and
     // DeepStarData fields
@@ -154,8 +180,22 @@ class StarComponent : public ListComponent
 
     bool addDeepStarCatalogIfExists(const QString &fileName, float trigMag, bool staticstars = false);
 
+    /**
+     * Protects the star index and the deep star blocks. Drawing, which re-indexes the stars and
+     * loads and recycles the deep star blocks, holds it for writing. Queries hold it for reading.
+     */
+    mutable QReadWriteLock m_dataLock;
+
     SkyMesh *m_skyMesh { nullptr };
     std::unique_ptr<StarIndex> m_starIndex;
+    /// Trixel each star of m_ObjectList is indexed in, in the same order
+    QVector<Trixel> m_starTrixels;
+
+    // Share of the stars to draw of each trixel, see starQuota()
+    int m_quotaPerTrixel { -1 };
+    int m_quotaFrame { 0 };
+    QVector<int> m_starQuota;
+    QVector<int> m_quotaFrames;
 
     KSNumbers m_reindexNum;
     double m_reindexInterval { 0 };
@@ -163,6 +203,10 @@ class StarComponent : public ListComponent
     LabelList *m_labelList[MAX_LINENUMBER_MAG + 1];
     bool m_hideLabels { false };
 
+    /// The stars to draw in this frame, projected all at once. Kept to reuse their memory.
+    QVector<StarObject *> m_drawStars;
+    ProjectionBatch m_drawBatch;
+
     float m_zoomMagLimit { 0 };
 
     /// Limiting magnitude of the catalog currently loaded
@@ -25,13 +25,17 @@
 #include "auxiliary/filedownloader.h"
 #include "projections/projector.h"
 #include "auxiliary/kspaths.h"
+#include "auxiliary/executors.h"
+#include "htmesh/MeshIterator.h"
 
-#include <QtConcurrent>
 #include <QJsonDocument>
 #include <QJsonValue>
+#include <QSet>
 
 #include <zlib.h>
+#include <algorithm>
 #include <fstream>
+#include <memory>
 #include <stdio.h>
 
 #include <csv.h>
@@ -72,12 +76,13 @@ bool SupernovaeComponent::selected()
 
 void SupernovaeComponent::loadData()
 {
-    qDeleteAll(m_ObjectList);
-    m_ObjectList.clear();
-
-    objectNames(SkyObject::SUPERNOVA).clear();
-    objectLists(SkyObject::SUPERNOVA).clear();
+    std::vector<Supernova> supernovae;
+    if (readData(supernovae))
+        applyData(supernovae);
+}
 
+bool SupernovaeComponent::readData(std::vector<Supernova> &supernovae)
+{
     auto sFileName = KSPaths::locate(QStandardPaths::AppLocalDataLocation, QString(tnsDataFilename));
 
     try
@@ -90,7 +95,7 @@ void SupernovaeComponent::loadData()
         if (line == nullptr)
         {
             qCritical() << "file is empty\n";
-            return;
+            return false;
         }
 
         std::string id, name, ra_s, dec_s, type;
@@ -118,31 +123,118 @@ void SupernovaeComponent::loadData()
             dms ra(QString(ra_s.c_str()), false);
             dms dec(QString(dec_s.c_str()), true);
 
-            Supernova *sup = new Supernova(
+            supernovae.emplace_back(
                 qname, ra, dec, QString(type.c_str()), QString(host_name.c_str()),
                 QString(discovery_date_s.c_str()), redshift, discovery_mag, discovery_date);
-
-            objectNames(SkyObject::SUPERNOVA).append(QString(name.c_str()));
-
-            appendListObject(sup);
-            objectLists(SkyObject::SUPERNOVA)
-            .append(QPair<QString, const SkyObject *>(qname, sup));
         }
-
-        m_DataLoading = false;
-        m_DataLoaded  = true;
+        return true;
     }
     catch (io::error::can_not_open_file &ex)
     {
         qCCritical(KSTARS) << "could not open file " << sFileName.toLocal8Bit() << "\n";
-        return;
+        return false;
     }
     catch (std::exception &ex)
     {
         qCCritical(KSTARS) << "unknown exception happened:" << ex.what() << "\n";
+        return false;
     }
 }
 
+void SupernovaeComponent::applyData(const std::vector<Supernova> &supernovae)
+{
+    KStarsData *data = KStarsData::Instance();
+
+    QHash<QString, Supernova *> previous;
+    for (SkyObject *object : m_ObjectList)
+        previous.insert(object->name(), static_cast<Supernova *>(object));
+
+    // Only new and changed supernovae are touched, the others keep their objects, positions and names
+    QSet<QString> names;
+    int added = 0, changed = 0;
+    for (const Supernova &supernova : supernovae)
+    {
+        if (names.contains(supernova.name()))
+            continue;
+        names.insert(supernova.name());
+
+        Supernova *sup = previous.take(supernova.name());
+        if (sup == nullptr)
+        {
+            sup = new Supernova(supernova);
+            appendListObject(sup);
+            addToNames(SkyObject::SUPERNOVA, sup->name(), sup);
+            added++;
+        }
+        else if (!sameData(*sup, supernova))
+        {
+            unindex(sup);
+            *sup = supernova;
+            changed++;
+        }
+        else
+            continue;
+
+        index(sup);
+        if (data != nullptr)
+        {
+            sup->updateCoordsNow(data->updateNum());
+            sup->EquatorialToHorizontal(data->lst(), data->geo()->lat());
+        }
+    }
+
+    // Those left are no longer in the file
+    if (!previous.isEmpty())
+    {
+        QSet<SkyObject *> removed;
+        for (Supernova *sup : previous)
+        {
+            unindex(sup);
+            removeFromNames(sup);
+            removeFromLists(sup);
+            removed.insert(sup);
+        }
+
+        m_ObjectList.erase(std::remove_if(m_ObjectList.begin(), m_ObjectList.end(), [&removed](SkyObject * object)
+        {
+            return removed.contains(object);
+        }), m_ObjectList.end());
+        for (auto it = m_ObjectHash.begin(); it != m_ObjectHash.end();)
+            it = removed.contains(it.value()) ? m_ObjectHash.erase(it) : it + 1;
+
+        qDeleteAll(removed);
+    }
+
+    qCInfo(KSTARS) << "Supernovae updated:" << added << "added," << changed << "changed," << previous.size()
+                   << "removed," << m_ObjectList.size() << "in total";
+
+    m_DataLoading = false;
+    m_DataLoaded  = true;
+}
+
+bool SupernovaeComponent::sameData(const Supernova &a, const Supernova &b)
+{
+    return a.ra0().Degrees() == b.ra0().Degrees() && a.dec0().Degrees() == b.dec0().Degrees() && a.mag() == b.mag() &&
+           a.getType() == b.getType() && a.getHostGalaxy() == b.getHostGalaxy() && a.getDate() == b.getDate() &&
+           a.getRedShift() == b.getRedShift();
+}
+
+void SupernovaeComponent::index(Supernova *supernova)
+{
+    // By the J2000 coordinates, which do not change with the time
+    m_Index[SkyMesh::Instance()->index(supernova)].append(supernova);
+}
+
+void SupernovaeComponent::unindex(Supernova *supernova)
+{
+    auto it = m_Index.find(SkyMesh::Instance()->index(supernova));
+    if (it == m_Index.end())
+        return;
+    it->removeOne(supernova);
+    if (it->isEmpty())
+        m_Index.erase(it);
+}
+
 SkyObject *SupernovaeComponent::objectNearest(SkyPoint *p, double &maxrad)
 {
     if (!selected() || !m_DataLoaded)
@@ -151,14 +243,23 @@ SkyObject *SupernovaeComponent::objectNearest(SkyPoint *p, double &maxrad)
     SkyObject *oBest = nullptr;
     double rBest     = maxrad;
 
-    for (auto &so : m_ObjectList)
+    // The aperture around p was set up by SkyMapComposite::objectNearest()
+    MeshIterator region(SkyMesh::Instance(), OBJ_NEAREST_BUF);
+    while (region.hasNext())
     {
-        double r = so->angularDistanceTo(p).Degrees();
-        //qDebug()<<r;
-        if (r < rBest)
+        auto it = m_Index.constFind(region.next());
+        if (it == m_Index.constEnd())
+            continue;
+
+        for (Supernova *so : *it)
         {
-            oBest = so;
-            rBest = r;
+            double r = so->angularDistanceTo(p).Degrees();
+            //qDebug()<<r;
+            if (r < rBest)
+            {
+                oBest = so;
+                rBest = r;
+            }
         }
     }
     maxrad = rBest;
@@ -185,7 +286,17 @@ void SupernovaeComponent::draw(SkyPainter *skyp)
         if (!m_DataLoading)
         {
             m_DataLoading = true;
-            QtConcurrent::run(this, &SupernovaeComponent::loadData);
+            // The file is read in the background, the objects are created on the main thread which draws them
+            Executors::run(Executors::Background, [this]()
+            {
+                auto supernovae = std::make_shared<std::vector<Supernova>>();
+                if (!readData(*supernovae))
+                    return;
+                QMetaObject::invokeMethod(this, [this, supernovae]()
+                {
+                    applyData(*supernovae);
+                }, Qt::QueuedConnection);
+            });
         }
         return;
     }
@@ -195,32 +306,40 @@ void SupernovaeComponent::draw(SkyPainter *skyp)
     bool hostOnly = Options::supernovaeHostOnly();
     bool classifiedOnly = Options::supernovaeClassifiedOnly();
 
-    for (auto so : m_ObjectList)
+    // Only the supernovae of the trixels in view
+    MeshIterator region(SkyMesh::Instance(), DRAW_BUF);
+    while (region.hasNext())
     {
-        Supernova *sup = dynamic_cast<Supernova *>(so);
-        float mag      = sup->mag();
-        float age      = sup->getAgeDays();
-        QString type     = sup->getType();
-
-        if (mag > float(Options::magnitudeLimitShowSupernovae()))
+        auto it = m_Index.constFind(region.next());
+        if (it == m_Index.constEnd())
             continue;
 
-        if (age > refage)
-            continue;
+        for (Supernova *sup : *it)
+        {
+            float mag      = sup->mag();
+            float age      = sup->getAgeDays();
+            QString type     = sup->getType();
 
-        // only SN with host galaxy?
-        if (hostOnly && sup->getHostGalaxy() == "")
-            continue;
+            if (mag > float(Options::magnitudeLimitShowSupernovae()))
+                continue;
 
-        // Do not draw if mag>maglim
-        if (mag > maglim && Options::limitSupernovaeByZoom())
-            continue;
+            if (age > refage)
+                continue;
 
-        // classified SN only?
-        if (classifiedOnly && type == "")
-            continue;
+            // only SN with host galaxy?
+            if (hostOnly && sup->getHostGalaxy() == "")
+                continue;
+
+            // Do not draw if mag>maglim
+            if (mag > maglim && Options::limitSupernovaeByZoom())
+                continue;
 
-        skyp->drawSupernova(sup);
+            // classified SN only?
+            if (classifiedOnly && type == "")
+                continue;
+
+            skyp->drawSupernova(sup);
+        }
     }
 }
 
@@ -267,6 +386,10 @@ void SupernovaeComponent::slotTriggerDataFileUpdate()
 
     if (!url.startsWith("file://"))
     {
+        // Inflate the download straight into the CSV file
+        output = QDir(KSPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath(tnsDataFilename);
+        downloadJob->setDecompress(true);
+
         qInfo() << "fetching data from web: " << url << "\n";
         downloadJob->setProgressDialogEnabled(true, i18n("Supernovae Update"),
                                               i18n("Downloading Supernovae updates..."));
@@ -333,8 +456,7 @@ void SupernovaeComponent::unzipData()
 
 void SupernovaeComponent::downloadReady()
 {
-    // uncompress csv
-    unzipData();
+    // The download replaced the csv
     // Reload Supernova
     loadData();
 #ifdef KSTARS_LITE
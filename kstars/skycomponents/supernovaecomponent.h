@@ -12,14 +12,21 @@
 #include "listcomponent.h"
 #include "skyobjects/supernova.h"
 #include "filedownloader.h"
+#include "typedef.h"
 
+#include <QHash>
 #include <QList>
 #include <QPointer>
 
+#include <vector>
+
 /**
  * @class SupernovaeComponent
  * @brief This class encapsulates Supernovae.
  *
+ * The supernovae are indexed by the trixels of the SkyMesh, so that drawing and finding the nearest one only look
+ * at the trixels in view. A new data file only adds, changes and removes the supernovae that differ.
+ *
  * @author Jasem Mutlaq, Samikshan Bairagya
  *
  * @version 0.2
@@ -58,11 +65,24 @@ class SupernovaeComponent : public QObject, public ListComponent
         void downloadError(const QString &errorString);
 
     private:
+        /** Read the data file and update the supernovae from it */
         void loadData();
+        /** Read the supernovae of the data file, which may be done in any thread */
+        static bool readData(std::vector<Supernova> &supernovae);
+        /**
+         * Update the supernovae from those of the data file, keeping the objects of those that did not change so
+         * that they stay valid for the sky map and the observing list.
+         */
+        void applyData(const std::vector<Supernova> &supernovae);
+        static bool sameData(const Supernova &a, const Supernova &b);
+        void index(Supernova *supernova);
+        void unindex(Supernova *supernova);
         void unzipData();
         static const QString tnsDataFilename;
         static const QString tnsDataFilenameZip;
         static const QString tnsDataUrl;
         bool m_DataLoaded { false }, m_DataLoading { false };
         QPointer<FileDownloader> downloadJob;
+        /// The supernovae of each trixel, by their J2000 coordinates
+        QHash<Trixel, QList<Supernova *>> m_Index;
 };
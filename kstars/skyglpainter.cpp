@@ -9,6 +9,8 @@
 #endif
 #include "skyglpainter.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <Eigen/Geometry>
 
@@ -542,17 +544,18 @@ void SkyGLPainter::drawObservingList(const QList<SkyObject *> &obs)
 void SkyGLPainter::drawFlags()
 {
     KStarsData *data = KStarsData::Instance();
+    FlagComponent *flags = data->skyComposite()->flags();
     SkyPoint *point;
     QImage image;
     const QString label;
     bool visible = false;
     Eigen::Vector2f vec;
-    int i;
 
-    for (i = 0; i < data->skyComposite()->flags()->size(); i++)
+    // Only the flags of the trixels in view
+    for (int i : flags->visibleFlags())
     {
-        point = data->skyComposite()->flags()->pointList().at(i);
-        image = data->skyComposite()->flags()->image(i);
+        point = flags->pointList().at(i).get();
+        image = flags->image(i);
 
         // Set Horizontal coordinates
         point->EquatorialToHorizontal(data->lst(), data->geo()->lat());
@@ -564,12 +567,10 @@ void SkyGLPainter::drawFlags()
         if (!visible || !m_proj->onScreen(vec))
             continue;
 
-        const QImage &img =
-            data->skyComposite()->flags()->imageName(i) == "Default" ? TextureManager::getImage("defaultflag") : image;
+        const QImage &img = flags->imageName(i) == "Default" ? TextureManager::getImage("defaultflag") : image;
 
         drawTexturedRectangle(img, vec, 0, img.width(), img.height());
-        drawText(vec.x(), vec.y(), data->skyComposite()->flags()->label(i), QFont("Courier New", 10, QFont::Bold),
-                 data->skyComposite()->flags()->labelColor(i));
+        drawText(vec.x(), vec.y(), flags->label(i), QFont("Courier New", 10, QFont::Bold), flags->labelColor(i));
     }
 }
 
@@ -615,6 +616,31 @@ void SkyGLPainter::drawText(int x, int y, const QString text, QFont font, QColor
 
 bool SkyGLPainter::drawConstellationArtImage(ConstellationsArt *obj)
 {
+    float zoom = Options::zoomFactor();
+
+    bool visible = false;
+    obj->EquatorialToHorizontal(KStarsData::Instance()->lst(), KStarsData::Instance()->geo()->lat());
+    Eigen::Vector2f pos = m_proj->toScreenVec(obj, true, &visible);
+    if (!visible)
+        return false;
+
+    float w = obj->getWidth() * 60 * dms::PI * zoom / 10800;
+    float h = obj->getHeight() * 60 * dms::PI * zoom / 10800;
+
+    // Art with its midpoint off screen may still cover part of it
+    const float radius = 0.5 * std::hypot(w, h);
+    const ViewParams view = m_proj->viewParams();
+    if (pos.x() < -radius || pos.y() < -radius || pos.x() > view.width + radius || pos.y() > view.height + radius)
+        return false;
+
+    // The levels are square with sides of powers of two, so the same image is bound every frame and the
+    // texture cache of the context uploads it once
+    const QImage &image = obj->image(std::max(w, h));
+    if (image.isNull())
+        return false;
+
+    drawTexturedRectangle(image, pos, m_proj->findPA(obj, pos.x(), pos.y()), w, h);
+    return true;
 }
 
 void SkyGLPainter::drawSkyLine(SkyPoint *a, SkyPoint *b)
@@ -27,12 +27,14 @@
 #include "skymapgldraw.h"
 #endif
 #include "skymapqdraw.h"
+#include "skyqpainter.h"
 #include "starhopperdialog.h"
 #include "starobject.h"
 #include "texturemanager.h"
 #include "dialogs/detaildialog.h"
 #include "printing/printingwizard.h"
 #include "skycomponents/flagcomponent.h"
+#include "skycomponents/solarsystemcomposite.h"
 #include "skyobjects/ksplanetbase.h"
 #include "skyobjects/satellite.h"
 #include "tools/flagmanager.h"
@@ -366,6 +368,10 @@ void SkyMap::slotTransientLabel()
 void SkyMap::setClickedObject(SkyObject *o)
 {
     ClickedObject = o;
+
+    // Faint or distant minor bodies may only have a coarse position
+    if (o)
+        data->skyComposite()->solarSystemComposite()->updateMinorBody(o);
 }
 
 void SkyMap::setFocusObject(SkyObject *o)
@@ -1243,8 +1249,57 @@ void SkyMap::slotSetSkyRotation(double angle)
     forceUpdate();
 }
 
+void SkyMap::exportAt(const SkyPoint &center, double zoomFactor, const std::function<void()> &draw)
+{
+    waitForFrame();
+
+    // The components draw through the projector and the focus of the map, so they are swapped for the export
+    const SkyPoint oldFocus    = Focus;
+    const double oldFocusRA    = Options::focusRA();
+    const double oldFocusDec   = Options::focusDec();
+    const double oldZoomFactor = Options::zoomFactor();
+
+    setFocus(center.ra(), center.dec());
+    Options::setZoomFactor(KSUtils::clamp(zoomFactor, MINZOOM, MAXZOOM));
+    setupProjector();
+
+    draw();
+
+    Focus = oldFocus;
+    Options::setFocusRA(oldFocusRA);
+    Options::setFocusDec(oldFocusDec);
+    Options::setZoomFactor(oldZoomFactor);
+    setupProjector();
+    forceUpdate();
+}
+
+void SkyMap::exportSkyView(QImage *image, const SkyPoint &center, double zoomFactor, const QRectF &rect)
+{
+    exportAt(center, zoomFactor, [&]()
+    {
+        SkyQPainter painter(this, image);
+        painter.begin();
+        painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+        QTransform transform;
+        transform.scale(image->width() / rect.width(), image->height() / rect.height());
+        transform.translate(-rect.x(), -rect.y());
+        painter.setTransform(transform);
+        exportSkyImage(&painter);
+        painter.end();
+    });
+}
+
+void SkyMap::waitForFrame()
+{
+    auto draw = dynamic_cast<SkyMapQDraw *>(m_SkyMapDraw);
+    if (draw)
+        draw->waitForFrame();
+}
+
 void SkyMap::setupProjector()
 {
+    waitForFrame();
+
     //Update View Parameters for projection
     ViewParams p;
     p.focus         = focus();
@@ -18,6 +18,8 @@
 #include <QtGlobal>
 #include <QTimer>
 
+#include <functional>
+
 class QPainter;
 class QPaintDevice;
 
@@ -272,6 +274,13 @@ class SkyMap : public QGraphicsView
         /** @short Call to set up the projector before a draw cycle. */
         void setupProjector();
 
+        /**
+         * @short Wait for the frame being drawn in the background, if any.
+         * Must be called before modifying the sky data or the projector outside of a draw cycle.
+         * @see Options::threadedSkyRendering()
+         */
+        void waitForFrame();
+
         /** @ Set zoom factor.
               *@param factor zoom factor
               */
@@ -308,14 +317,31 @@ class SkyMap : public QGraphicsView
              */
         inline void exportSkyImage(QPaintDevice *pd, bool scale = false)
         {
+            waitForFrame();
             dynamic_cast<SkyMapDrawAbstract *>(m_SkyMapDraw)->exportSkyImage(pd, scale);
         }
 
         inline void exportSkyImage(SkyQPainter *painter, bool scale = false)
         {
+            waitForFrame();
             dynamic_cast<SkyMapDrawAbstract *>(m_SkyMapDraw)->exportSkyImage(painter, scale);
         }
 
+        /**
+         * @short Call @p draw while the map is centered on @p center at @p zoomFactor, without moving it.
+         *
+         * The view of the map is swapped for the time of the call and restored before any event is
+         * processed, so the map is never shown at the exported position. @p draw paints through a
+         * SkyQPainter of this map, which picks up the swapped projector.
+         */
+        void exportAt(const SkyPoint &center, double zoomFactor, const std::function<void()> &draw);
+
+        /**
+         * @short Export the sky around @p center at @p zoomFactor into @p image, without moving the map.
+         * @param rect the part of the map, in the pixels of the exported view, that fills the image
+         */
+        void exportSkyView(QImage *image, const SkyPoint &center, double zoomFactor, const QRectF &rect);
+
         SkyMapDrawAbstract *getSkyMapDrawAbstract()
         {
             return dynamic_cast<SkyMapDrawAbstract *>(m_SkyMapDraw);
@@ -0,0 +1,237 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "skymapbenchmark.h"
+
+#include "kstarsdata.h"
+#include "Options.h"
+#include "skymap.h"
+#include "skyqpainter.h"
+#include "hips/hipsmanager.h"
+#include "projections/projector.h"
+#include "skycomponents/skylabeler.h"
+#include "skycomponents/skymapcomposite.h"
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPainterPath>
+#include <QTextStream>
+
+#include <qtskipemptyparts.h>
+
+#include <algorithm>
+
+namespace
+{
+double median(QVector<double> values)
+{
+    if (values.isEmpty())
+        return 0;
+    std::sort(values.begin(), values.end());
+    const int middle = values.size() / 2;
+    return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+}
+
+SkyMapBenchmark::SkyMapBenchmark(SkyMap *map, int frames) : m_Map(map), m_Frames(std::max(1, frames))
+{
+}
+
+QList<SkyMapBenchmark::View> SkyMapBenchmark::parseViews(QTextStream &istream)
+{
+    QList<View> views;
+    View view;
+    bool hasCommands = false;
+    while (!istream.atEnd())
+    {
+        const QString line = istream.readLine();
+        if (!line.startsWith(QLatin1String("dbus-send")))
+            continue;
+
+        const int i = line.lastIndexOf("org.kde.kstars.exportImage");
+        if (i < 0)
+        {
+            view.commands += line + '\n';
+            hasCommands = true;
+            continue;
+        }
+
+        // exportImage string:"file" int32:width int32:height bool:legend
+        const QStringList args = line.mid(i).split(' ', Qt::SkipEmptyParts);
+        if (args.size() > 1)
+            view.name = QFileInfo(args[1].section(':', 1).remove('"').remove('\'')).completeBaseName();
+        if (view.name.isEmpty())
+            view.name = QString("View %1").arg(views.size() + 1);
+        views.append(view);
+        view = View();
+        hasCommands = false;
+    }
+
+    if (hasCommands)
+    {
+        view.name = QString("View %1").arg(views.size() + 1);
+        views.append(view);
+    }
+    return views;
+}
+
+QList<SkyMapBenchmark::Result> SkyMapBenchmark::run(const QList<View> &views)
+{
+    KStarsData *data = KStarsData::Instance();
+    QList<Result> results;
+
+    for (const View &view : views)
+    {
+        QString commands = view.commands;
+        QTextStream istream(&commands);
+        data->executeScript(istream, m_Map);
+
+        // The HiPS source is read once by the manager, follow the one set by the script
+        if (Options::showHIPS())
+            HIPSManager::Instance()->setCurrentSource(Options::hIPSSource());
+
+        // As in the dump mode, the positions follow the time and location set by the script
+        data->setFullTimeUpdate();
+        data->updateTime(data->geo(), true);
+        m_Map->focus()->EquatorialToHorizontal(data->lst(), data->geo()->lat());
+        m_Map->setDestination(*m_Map->focus());
+
+        // The first frame loads the data of the view, such as star blocks and HiPS tiles
+        drawFrame();
+        qApp->processEvents();
+
+        Result result;
+        result.name = view.name;
+        result.frames = m_Frames;
+
+        QVector<double> frameTimes;
+        QVector<QString> names;
+        QVector<QVector<double>> componentTimes;
+        for (int frame = 0; frame < m_Frames; ++frame)
+        {
+            const DrawProfiler::Frame profile = drawFrame();
+            frameTimes.append(profile.milliseconds);
+            result.trixels = profile.trixels;
+
+            // Components marked more than once in a frame are added up
+            QVector<double> times(names.size(), 0);
+            for (const DrawProfiler::Component &component : profile.components)
+            {
+                int index = names.indexOf(component.name);
+                if (index < 0)
+                {
+                    index = names.size();
+                    names.append(component.name);
+                    componentTimes.append(QVector<double>());
+                    result.components.append({ component.name, 0, 0 });
+                    times.append(0);
+                }
+                times[index] += component.milliseconds;
+                if (frame == 0)
+                    result.components[index].objects += component.objects;
+            }
+            for (int i = 0; i < names.size(); ++i)
+                componentTimes[i].append(times[i]);
+        }
+
+        result.fastest = *std::min_element(frameTimes.cbegin(), frameTimes.cend());
+        result.median = median(frameTimes);
+        for (int i = 0; i < result.components.size(); ++i)
+            result.components[i].milliseconds = median(componentTimes[i]);
+        results.append(result);
+    }
+
+    return results;
+}
+
+DrawProfiler::Frame SkyMapBenchmark::drawFrame()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    m_Map->setupProjector();
+
+    // Drawn as a frame of the sky map, without the overlays
+    QImage image(m_Map->size(), QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::black);
+
+    SkyQPainter painter(&image, image.size());
+    painter.begin();
+    painter.drawSkyBackground();
+
+    QPainterPath path;
+    path.addPolygon(m_Map->projector()->clipPoly());
+    painter.setClipPath(path);
+    painter.setClipping(true);
+
+    SkyMapComposite *composite = KStarsData::Instance()->skyComposite();
+    composite->draw(&painter);
+    painter.end();
+
+    QPainter labels(&image);
+    SkyLabeler::Instance()->draw(labels);
+    labels.end();
+
+    // The background, clipping and label playback are outside of the components
+    DrawProfiler::Frame frame = composite->drawProfiler().lastFrame();
+    const double milliseconds = timer.nsecsElapsed() / 1e6;
+    frame.components.append({ "Background and labels", milliseconds - frame.milliseconds, 0 });
+    frame.milliseconds = milliseconds;
+    return frame;
+}
+
+QString SkyMapBenchmark::toText(const QList<Result> &results)
+{
+    QString text;
+    QTextStream stream(&text);
+    stream.setRealNumberNotation(QTextStream::FixedNotation);
+    stream.setRealNumberPrecision(2);
+
+    for (const Result &result : results)
+    {
+        stream << result.name << ": " << result.median << " ms median, " << result.fastest << " ms fastest, "
+               << result.frames << " frames, " << result.trixels << " trixels\n";
+        for (const Component &component : result.components)
+            stream << "    " << component.name.leftJustified(36) << component.milliseconds << " ms, "
+                   << component.objects << " objects\n";
+    }
+    stream.flush();
+    return text;
+}
+
+QString SkyMapBenchmark::toJSON(const QList<Result> &results)
+{
+    QJsonArray views;
+    for (const Result &result : results)
+    {
+        QJsonArray components;
+        for (const Component &component : result.components)
+        {
+            components.append(QJsonObject
+            {
+                { "name", component.name },
+                { "milliseconds", component.milliseconds },
+                { "objects", static_cast<qint64>(component.objects) }
+            });
+        }
+        views.append(QJsonObject
+        {
+            { "name", result.name },
+            { "frames", result.frames },
+            { "fastest", result.fastest },
+            { "median", result.median },
+            { "trixels", result.trixels },
+            { "components", components }
+        });
+    }
+
+    return QString::fromUtf8(QJsonDocument(views).toJson());
+}
@@ -0,0 +1,84 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "skycomponents/drawprofiler.h"
+
+#include <QList>
+#include <QSize>
+#include <QString>
+#include <QVector>
+
+class QTextStream;
+class SkyMap;
+
+/**
+ * @class SkyMapBenchmark
+ * Draws a scripted set of sky map views offscreen and reports their frame times.
+ *
+ * The views are written as a script of the Script Builder. Every exportImage call ends a view,
+ * named after the exported file, and the commands before it set up the view: location, time,
+ * focus, zoom and view options such as the projection, HiPS, stars, catalogs or labels. The
+ * commands are run as in the dump mode, so the same script can be played against a running
+ * KStars to look at the views.
+ *
+ * Each view is drawn once to warm up the caches, then timed over a number of frames. The frame
+ * time and the time of each component, as measured by the DrawProfiler of SkyMapComposite, are
+ * reported as medians over the frames.
+ */
+class SkyMapBenchmark
+{
+    public:
+        struct View
+        {
+            QString name;
+            /// The script lines that set up the view
+            QString commands;
+        };
+
+        struct Component
+        {
+            QString name;
+            double milliseconds { 0 };
+            quint64 objects { 0 };
+        };
+
+        struct Result
+        {
+            QString name;
+            int frames { 0 };
+            double fastest { 0 };
+            double median { 0 };
+            int trixels { 0 };
+            QVector<Component> components;
+        };
+
+        /**
+         * @param map the sky map that is set up by the scripts, its size is the size of the frames
+         * @param frames the number of timed frames of each view
+         */
+        SkyMapBenchmark(SkyMap *map, int frames);
+
+        /** @short Split a script into its views. Commands after the last exportImage make a view of their own. */
+        static QList<View> parseViews(QTextStream &istream);
+
+        /** @short Set up each view in turn and time its frames. */
+        QList<Result> run(const QList<View> &views);
+
+        /** @return the results as a table, one line per view followed by its components */
+        static QString toText(const QList<Result> &results);
+
+        /** @return the results as a JSON array of views */
+        static QString toJSON(const QList<Result> &results);
+
+    private:
+        /** @short Draw one frame as the sky map does, and return its profile. */
+        DrawProfiler::Frame drawFrame();
+
+        SkyMap *m_Map { nullptr };
+        int m_Frames { 0 };
+};
@@ -53,13 +53,14 @@ SkyMapDrawAbstract::SkyMapDrawAbstract(SkyMap *sm) : m_KStarsData(KStarsData::In
     //m_framecount = 0;
 }
 
-void SkyMapDrawAbstract::drawOverlays(QPainter &p, bool drawFov)
+void SkyMapDrawAbstract::drawOverlays(QPainter &p, bool drawFov, bool drawLabels)
 {
     if (!KStars::Instance())
         return;
 
     //draw labels
-    SkyLabeler::Instance()->draw(p);
+    if (drawLabels)
+        SkyLabeler::Instance()->draw(p);
 
     if (drawFov)
     {
@@ -101,6 +102,39 @@ void SkyMapDrawAbstract::drawOverlays(QPainter &p, bool drawFov)
         m_SkyMap->updateAngleRuler();
         drawAngleRuler(p);
     }
+
+    if (Options::showDrawProfile())
+        drawProfile(p);
+}
+
+void SkyMapDrawAbstract::drawProfile(QPainter &p)
+{
+    const DrawProfiler::Frame frame = m_KStarsData->skyComposite()->drawProfiler().lastFrame();
+    if (frame.components.isEmpty())
+        return;
+
+    QStringList lines;
+    lines << i18n("Frame: %1 ms, %2 trixels", QString::number(frame.milliseconds, 'f', 1), frame.trixels);
+    for (const auto &component : frame.components)
+        lines << QString("%1: %2 ms, %3").arg(component.name).arg(component.milliseconds, 0, 'f', 1)
+              .arg(component.objects);
+
+    const QFontMetrics metrics(p.font());
+    int width = 0;
+    for (const auto &line : lines)
+        width = qMax(width, metrics.horizontalAdvance(line));
+    const int margin = 4;
+    const QRect box(margin, margin, width + 2 * margin, lines.size() * metrics.height() + 2 * margin);
+
+    QColor background = m_KStarsData->colorScheme()->colorNamed("BoxBGColor");
+    background.setAlpha(192);
+    p.save();
+    p.setPen(Qt::NoPen);
+    p.setBrush(background);
+    p.drawRect(box);
+    p.setPen(m_KStarsData->colorScheme()->colorNamed("BoxTextColor"));
+    p.drawText(box.adjusted(margin, margin, -margin, -margin), Qt::AlignLeft | Qt::AlignTop, lines.join('\n'));
+    p.restore();
 }
 
 void SkyMapDrawAbstract::drawAngleRuler(QPainter &p)
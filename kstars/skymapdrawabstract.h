@@ -54,8 +54,9 @@ class SkyMapDrawAbstract
         	*drawOverlays() to refresh the overlays.
         	*@param p pointer to the Sky pixmap
         	*@param drawFov determines if the FOV should be drawn
+        	*@param drawLabels determines if the object labels should be drawn
         	*/
-    void drawOverlays(QPainter &p, bool drawFov = true);
+    void drawOverlays(QPainter &p, bool drawFov = true, bool drawLabels = true);
 
     /**Draw symbols at the position of each Telescope currently being controlled by KStars.
         	*@note The shape of the Telescope symbol is currently a hard-coded bullseye.
@@ -80,6 +81,12 @@ class SkyMapDrawAbstract
         	*/
     void drawZoomBox(QPainter &psky);
 
+    /**
+     * @short Draw the time spent drawing each sky component in the last frame.
+     * @param p reference to the QPainter on which to draw (this should be the sky map)
+     */
+    void drawProfile(QPainter &p);
+
     /**Draw a dashed line from the Angular-Ruler start point to the current mouse cursor,
         	*when in Angular-Ruler mode.
         	*@param psky reference to the QPainter on which to draw (this should be the Sky pixmap).
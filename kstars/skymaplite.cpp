@@ -43,8 +43,30 @@
 
 #include "kstarslite/deviceorientation.h"
 
+#include <cmath>
+
 namespace
 {
+// Changes of the view that move the sky by less than this, in pixels, are not drawn
+constexpr double MinPixelMotion = 0.5;
+
+#if defined(Q_OS_ANDROID)
+// Intervals of the polling of the orientation sensors, in milliseconds, while the device moves and
+// once it was held still for IdlePolls polls
+constexpr int ActivePollInterval = 16;
+constexpr int IdlePollInterval   = 100;
+constexpr int IdlePolls          = 30;
+
+// Angle between two horizontal positions given in degrees, in radians
+double horizontalDistance(double alt1, double az1, double alt2, double az2)
+{
+    const double a1 = alt1 * dms::DegToRad, a2 = alt2 * dms::DegToRad;
+    const double cosDistance =
+        std::sin(a1) * std::sin(a2) + std::cos(a1) * std::cos(a2) * std::cos((az1 - az2) * dms::DegToRad);
+    return std::acos(qBound(-1.0, cosDistance, 1.0));
+}
+#endif
+
 // Draw bitmap for zoom cursor. Width is size of pen to draw with.
 QBitmap zoomCursorBitmap(int width)
 {
@@ -134,7 +156,7 @@ SkyMapLite::SkyMapLite()
     });
 #if defined(Q_OS_ANDROID)
     //Automatic mode
-    automaticModeTimer.setInterval(5);
+    automaticModeTimer.setInterval(ActivePollInterval);
     connect(&automaticModeTimer, SIGNAL(timeout()), this, SLOT(updateAutomaticMode()));
     setAutomaticMode(false);
 #endif
@@ -175,8 +197,12 @@ QSGNode *SkyMapLite::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *upda
             m_delTelescopes.clear();
         }
         //Notify RootNode that textures for point node should be recreated
-        n->update(clearTextures);
+        if (m_skyDirty || clearTextures)
+            n->update(clearTextures);
+        else
+            n->updateTelescopes(); // Only the telescopes moved, see ClientManagerLite
         clearTextures = false;
+        m_skyDirty    = false;
     }
 
     //Memory Leaks test
@@ -677,12 +703,19 @@ void SkyMapLite::forceUpdate()
             m_skyMesh->index(&Focus, radius + 1.0, NO_PRECESS_BUF);
         }
     }
+    m_skyDirty      = true;
+    m_lastUpdateLST = data->lst()->radians();
     update();
 }
 
 void SkyMapLite::slotUpdateSky(bool now)
 {
-    Q_UNUSED(now);
+    // A tick of the clock turns the sky by the change of the sidereal time. While that moves
+    // nothing by a pixel at the current zoom, the map is left as it is.
+    const double turn = std::fabs(std::remainder(data->lst()->radians() - m_lastUpdateLST, 2 * dms::PI));
+    if (!now && turn * Options::zoomFactor() < MinPixelMotion)
+        return;
+
     updateFocus();
     forceUpdate();
 }
@@ -841,6 +874,12 @@ int SkyMapLite::harvardToIndex(char c)
     }
 }
 
+QColor SkyMapLite::starColor(char spType)
+{
+    const int index = harvardToIndex(spType);
+    return index < m_starColors.size() ? m_starColors[index] : QColor(Qt::white);
+}
+
 QVector<QVector<QPixmap *>> SkyMapLite::getImageCache()
 {
     return imageCache;
@@ -963,6 +1002,8 @@ void SkyMapLite::setAutomaticMode(bool automaticMode)
         if (automaticMode)
         {
             m_deviceOrientation->startSensors();
+            m_stillPolls = 0;
+            automaticModeTimer.setInterval(ActivePollInterval);
             automaticModeTimer.start();
         }
         else
@@ -980,16 +1021,40 @@ void SkyMapLite::updateAutomaticMode()
 {
 #if defined(Q_OS_ANDROID)
     m_deviceOrientation->getOrientation();
+
+    // The readings of the sensors are compared to the orientation that was last drawn, so that
+    // they only change the view in steps of a pixel and the noise of a device held still is not drawn
+    const double alt  = m_deviceOrientation->getAltitude();
+    const double az   = m_deviceOrientation->getAzimuth();
+    const double roll = -1 * m_deviceOrientation->getRoll();
+
+    const double moved  = horizontalDistance(alt, az, m_drawnAlt, m_drawnAz) * Options::zoomFactor();
+    const double turned = std::fabs(std::remainder(roll - m_drawnRoll, 360.0)) * dms::DegToRad *
+                          std::hypot(width(), height()) / 2;
+    if (moved < MinPixelMotion && turned < MinPixelMotion)
+    {
+        // Poll less often while the device is held still
+        if (++m_stillPolls == IdlePolls)
+            automaticModeTimer.setInterval(IdlePollInterval);
+        return;
+    }
+    if (m_stillPolls >= IdlePolls)
+        automaticModeTimer.setInterval(ActivePollInterval);
+    m_stillPolls = 0;
+    m_drawnAlt   = alt;
+    m_drawnAz    = az;
+    m_drawnRoll  = roll;
+
     if (Options::useRefraction() && Options::useAltAz())
     {
-        setFocusAltAz(SkyPoint::unrefract(dms(m_deviceOrientation->getAltitude())), dms(m_deviceOrientation->getAzimuth()));
+        setFocusAltAz(SkyPoint::unrefract(dms(alt)), dms(az));
     }
     else
     {
-        setFocusAltAz(dms(m_deviceOrientation->getAltitude()), dms(m_deviceOrientation->getAzimuth()));
+        setFocusAltAz(dms(alt), dms(az));
     }
 
-    setSkyRotation(-1 * m_deviceOrientation->getRoll());
+    setSkyRotation(roll);
 #endif
 }
 
@@ -1007,7 +1072,8 @@ void SkyMapLite::initStarImages()
             clearTextures = true;
         }
 
-        imageCache = QVector<QVector<QPixmap *>>(nSPclasses);
+        imageCache   = QVector<QVector<QPixmap *>>(nSPclasses);
+        m_starColors = QVector<QColor>(nSPclasses);
 
         QMap<char, QColor> ColorMap;
         const int starColorIntensity = Options::starColorIntensity();
@@ -1058,6 +1124,7 @@ void SkyMapLite::initStarImages()
         for (char color : ColorMap.keys())
         {
             //Add new spectral class
+            m_starColors[harvardToIndex(color)] = ColorMap[color];
 
             QPixmap BigImage(15, 15);
             BigImage.fill(Qt::transparent);
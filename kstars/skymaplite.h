@@ -270,6 +270,9 @@ class SkyMapLite : public QQuickItem
         /** @short Returns index for a Harvard spectral classification */
         int harvardToIndex(char c);
 
+        /** @short Returns the color of the stars of spectral class spType in the current star color mode */
+        QColor starColor(char spType);
+
         /** @short returns cache of star images
              *  @return star images cache
              */
@@ -737,9 +740,16 @@ class SkyMapLite : public QQuickItem
         const int nSPclasses { 7 };
         /// Cache for star images.
         QVector<QVector<QPixmap *>> imageCache;
+        /// Colors of the spectral classes, in the order of harvardToIndex
+        QVector<QColor> m_starColors;
         /// Textures created from cached star images
         QVector<QVector<QSGTexture *>> textureCache;
         bool clearTextures { false };
+        /// True if the view changed since the last update of the scene graph. Otherwise only the
+        /// telescope symbols are updated, see updatePaintNode()
+        bool m_skyDirty { true };
+        /// Local sidereal time of the last update of the view, in radians
+        double m_lastUpdateLST { 0 };
         bool tapBegan { false };
         QList<INDI::BaseDevice *> m_newTelescopes;
         QList<INDI::BaseDevice *> m_delTelescopes;
@@ -749,5 +759,11 @@ class SkyMapLite : public QQuickItem
 #if defined(Q_OS_ANDROID)
         QTimer automaticModeTimer;
         DeviceOrientation *m_deviceOrientation { nullptr };
+        /// Orientation of the device that was last drawn, in degrees
+        double m_drawnAlt { 0 };
+        double m_drawnAz { 0 };
+        double m_drawnRoll { 0 };
+        /// Number of successive polls of the sensors in which the view did not move
+        int m_stillPolls { 0 };
 #endif
 };
@@ -10,20 +10,82 @@
 #include "skymap.h"
 #include "projections/projector.h"
 #include "printing/legend.h"
+#include "skycomponents/skylabeler.h"
 #include "kstars_debug.h"
+#include "Options.h"
+#include "auxiliary/executors.h"
+
 #include <QPainterPath>
 
 SkyMapQDraw::SkyMapQDraw(SkyMap *sm) : QWidget(sm), SkyMapDrawAbstract(sm)
 {
     m_SkyPixmap = new QPixmap(width(), height());
     m_SkyPainter.reset(new SkyQPainter(this, m_SkyPixmap));
+    m_SkyPainter->setDeferredLoading(true);
+    connect(&m_FrameWatcher, &QFutureWatcher<void>::finished, this, &SkyMapQDraw::frameFinished);
 }
 
 SkyMapQDraw::~SkyMapQDraw()
 {
+    waitForFrame();
     delete m_SkyPixmap;
 }
 
+void SkyMapQDraw::waitForFrame()
+{
+    m_FrameWatcher.waitForFinished();
+}
+
+void SkyMapQDraw::startFrame()
+{
+    m_SkyMap->updateInfoBoxes();
+    m_SkyMap->setupProjector();
+
+    if (m_NextFrame.size() != size())
+        m_NextFrame = QImage(size(), QImage::Format_ARGB32_Premultiplied);
+
+    m_FrameWatcher.setFuture(Executors::run(Executors::Interactive, &SkyMapQDraw::drawFrame, this, &m_NextFrame));
+}
+
+void SkyMapQDraw::drawFrame(QImage *image)
+{
+    image->fill(Qt::black);
+
+    // A QImage, unlike the QPixmap of the synchronous path, can be painted outside the GUI thread
+    SkyQPainter painter(image, image->size());
+    painter.setDeferredLoading(true);
+    painter.begin();
+    painter.drawSkyBackground();
+
+    QPainterPath path;
+    path.addPolygon(m_SkyMap->projector()->clipPoly());
+    painter.setClipPath(path);
+    painter.setClipping(true);
+
+    m_KStarsData->skyComposite()->draw(&painter);
+    painter.end();
+
+    // The labels are recorded while drawing, play them back into this frame rather than from the GUI thread
+    QPainter labels(image);
+    SkyLabeler::Instance()->draw(labels);
+}
+
+void SkyMapQDraw::frameFinished()
+{
+    m_Frame.swap(m_NextFrame);
+
+    if (m_SkyMap->m_previewLegend)
+        m_SkyMap->m_legend.paintLegend(&m_Frame);
+
+    // The sky changed while drawing, draw it again
+    if (m_FramePending)
+    {
+        m_FramePending = false;
+        m_SkyMap->computeSkymap = true;
+    }
+    update();
+}
+
 void SkyMapQDraw::paintEvent(QPaintEvent *event)
 {
     Q_UNUSED(event)
@@ -35,6 +97,30 @@ void SkyMapQDraw::paintEvent(QPaintEvent *event)
     }
     setDrawLock(true);
 
+    // In threaded mode the sky is drawn in the background, and we only ever show the last complete
+    // frame with fresh overlays on top. The labels are part of the frame.
+    if (Options::threadedSkyRendering())
+    {
+        if (m_SkyMap->computeSkymap)
+        {
+            if (m_FrameWatcher.isRunning())
+                m_FramePending = true;
+            else
+                startFrame();
+            m_SkyMap->computeSkymap = false;
+        }
+
+        QPainter p;
+        p.begin(this);
+        p.drawLine(0, 0, 1, 1); // Dummy operation to circumvent bug. TODO: Add details
+        p.drawImage(0, 0, m_Frame);
+        drawOverlays(p, true, false);
+        p.end();
+
+        setDrawLock(false);
+        return;
+    }
+
     // JM 2016-05-03: Not needed since we're not using OpenGL for now
     //calculateFPS();
 
@@ -99,6 +185,9 @@ void SkyMapQDraw::paintEvent(QPaintEvent *event)
 void SkyMapQDraw::resizeEvent(QResizeEvent *e)
 {
     Q_UNUSED(e)
+    // The frame being drawn has the old size, draw another one
+    if (m_FrameWatcher.isRunning())
+        m_FramePending = true;
     delete m_SkyPixmap;
     m_SkyPixmap = new QPixmap(width(), height());
 }
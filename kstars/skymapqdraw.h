@@ -9,6 +9,8 @@
 
 #include "skymapdrawabstract.h"
 
+#include <QFutureWatcher>
+#include <QImage>
 #include <QWidget>
 
 /**
@@ -33,6 +35,13 @@ class SkyMapQDraw : public QWidget, public SkyMapDrawAbstract
          */
     ~SkyMapQDraw() override;
 
+    /**
+         *@short Wait for the frame being drawn in the background to complete, if any.
+         * The sky data and the projector must not be modified while a frame is drawn.
+         *@see Options::threadedSkyRendering()
+         */
+    void waitForFrame();
+
   protected:
     void paintEvent(QPaintEvent *e) override;
 
@@ -41,6 +50,20 @@ class SkyMapQDraw : public QWidget, public SkyMapDrawAbstract
     QPixmap *m_SkyPixmap;
 
     QScopedPointer<SkyQPainter> m_SkyPainter;
+
+  private:
+    /** Set up the projector and start drawing the next frame in the background. */
+    void startFrame();
+    /** Draw the sky into the image, runs in a worker thread. */
+    void drawFrame(QImage *image);
+    /** Show the frame drawn in the background. */
+    void frameFinished();
+
+    /// The frame being drawn in the background, and the last complete one on screen.
+    QImage m_NextFrame, m_Frame;
+    QFutureWatcher<void> m_FrameWatcher;
+    /// Was the sky map updated while a frame was being drawn?
+    bool m_FramePending { false };
 };
 
 #endif
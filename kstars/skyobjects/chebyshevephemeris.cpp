@@ -0,0 +1,122 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "chebyshevephemeris.h"
+
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+/// Segments are dropped when there are more, about 20 MB at degree 13
+constexpr int MAX_SEGMENTS = 1 << 16;
+}
+
+ChebyshevEphemeris::ChebyshevEphemeris(Function function, double span, int degree, double tolerance)
+    : m_Function(std::move(function)), m_Span(span), m_Degree(std::max(degree, 1)), m_Tolerance(tolerance)
+{
+}
+
+void ChebyshevEphemeris::evaluate(double days, double *xyz)
+{
+    const qint64 index = static_cast<qint64>(std::floor(days / m_Span));
+    const std::shared_ptr<const Segment> s = segment(index);
+
+    if (s->coefficients.empty())
+    {
+        m_Function(days, xyz);
+        return;
+    }
+
+    // Clenshaw's recurrence on [-1, 1]
+    const double x = 2.0 * (days - index * m_Span) / m_Span - 1.0;
+    const int n    = m_Degree + 1;
+    for (int k = 0; k < 3; ++k)
+    {
+        const double *c = s->coefficients.data() + k * n;
+        double b1 = 0, b2 = 0;
+        for (int j = n - 1; j > 0; --j)
+        {
+            const double b = 2.0 * x * b1 - b2 + c[j];
+            b2             = b1;
+            b1             = b;
+        }
+        xyz[k] = x * b1 - b2 + c[0];
+    }
+}
+
+double ChebyshevEphemeris::errorBound(double days)
+{
+    const std::shared_ptr<const Segment> s = segment(static_cast<qint64>(std::floor(days / m_Span)));
+    return s->coefficients.empty() ? 0.0 : s->error;
+}
+
+int ChebyshevEphemeris::segmentCount() const
+{
+    QMutexLocker lock(&m_Mutex);
+    return m_Segments.size();
+}
+
+void ChebyshevEphemeris::clear()
+{
+    QMutexLocker lock(&m_Mutex);
+    m_Segments.clear();
+}
+
+std::shared_ptr<const ChebyshevEphemeris::Segment> ChebyshevEphemeris::segment(qint64 index)
+{
+    {
+        QMutexLocker lock(&m_Mutex);
+        auto it = m_Segments.constFind(index);
+        if (it != m_Segments.constEnd())
+            return it.value();
+    }
+
+    // Fit without the lock, another thread may fit the same segment meanwhile
+    std::shared_ptr<const Segment> s = fit(index);
+
+    QMutexLocker lock(&m_Mutex);
+    if (m_Segments.size() >= MAX_SEGMENTS)
+        m_Segments.clear();
+    m_Segments.insert(index, s);
+    return s;
+}
+
+std::shared_ptr<const ChebyshevEphemeris::Segment> ChebyshevEphemeris::fit(qint64 index) const
+{
+    const int n       = m_Degree + 1;
+    const double half = m_Span / 2.0;
+    const double mid  = index * m_Span + half;
+    std::vector<double> values(3 * n);
+
+    for (int i = 0; i < n; ++i)
+        m_Function(mid + half * std::cos(M_PI * (i + 0.5) / n), values.data() + 3 * i);
+
+    auto s = std::make_shared<Segment>();
+    s->coefficients.resize(3 * n);
+    for (int k = 0; k < 3; ++k)
+    {
+        double *c = s->coefficients.data() + k * n;
+        for (int j = 0; j < n; ++j)
+        {
+            double sum = 0;
+            for (int i = 0; i < n; ++i)
+                sum += values[3 * i + k] * std::cos(M_PI * j * (i + 0.5) / n);
+            c[j] = 2.0 * sum / n;
+        }
+        c[0] /= 2.0;
+
+        // The terms fall off quickly for a smooth function, the last two bound the rest
+        s->error = std::max(s->error, std::fabs(c[n - 1]) + std::fabs(c[n - 2]));
+    }
+
+    if (s->error > m_Tolerance)
+        s->coefficients.clear();
+
+    return s;
+}
@@ -0,0 +1,89 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @class ChebyshevEphemeris
+ * @short Caches an ephemeris as Chebyshev polynomials over segments of fixed length.
+ *
+ * The series of the planets and the Moon cost hundreds of terms per position. Tools that
+ * compute positions over a date range, like the conjunction search or the altitude plots,
+ * call them thousands of times. This class samples the exact ephemeris at the Chebyshev
+ * nodes of a segment when a time in it is first asked for, and then evaluates the fitted
+ * polynomials, which takes a few dozen multiplications.
+ *
+ * The error of every segment is estimated from its last coefficients. Segments whose
+ * estimate is above the tolerance are not used, positions in them are computed exactly.
+ *
+ * The coordinates should be smooth functions of time, like rectangular coordinates, not
+ * angles that wrap around. The class is thread safe.
+ */
+class ChebyshevEphemeris
+{
+    public:
+        /** Computes the three coordinates at a time given in days */
+        using Function = std::function<void(double days, double *xyz)>;
+
+        /**
+         * @param function the exact ephemeris
+         * @param span length of the segments, in days
+         * @param degree degree of the polynomials
+         * @param tolerance largest accepted error estimate, in the unit of the coordinates
+         */
+        ChebyshevEphemeris(Function function, double span, int degree, double tolerance);
+
+        /** @short Fill @p xyz with the coordinates at @p days */
+        void evaluate(double days, double *xyz);
+
+        /**
+         * @return the error estimate of the segment that contains @p days, which is created if
+         * needed. Zero if the positions in it are computed exactly.
+         */
+        double errorBound(double days);
+
+        double span() const
+        {
+            return m_Span;
+        }
+
+        int degree() const
+        {
+            return m_Degree;
+        }
+
+        /** @return the number of segments computed so far */
+        int segmentCount() const;
+
+        /** @short Drop all segments */
+        void clear();
+
+    private:
+        struct Segment
+        {
+            /// degree + 1 coefficients for each coordinate, or none if the fit is not accurate enough
+            std::vector<double> coefficients;
+            double error { 0 };
+        };
+
+        std::shared_ptr<const Segment> segment(qint64 index);
+        std::shared_ptr<const Segment> fit(qint64 index) const;
+
+        Function m_Function;
+        double m_Span;
+        int m_Degree;
+        double m_Tolerance;
+
+        mutable QMutex m_Mutex;
+        QHash<qint64, std::shared_ptr<const Segment>> m_Segments;
+};
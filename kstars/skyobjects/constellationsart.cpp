@@ -8,6 +8,16 @@
 
 #include "texturemanager.h"
 
+#include <algorithm>
+
+namespace
+{
+// The smallest level, art drawn smaller than this is hardly visible
+constexpr int MIN_MIPMAP_SIZE = 32;
+
+const QImage emptyImage;
+}
+
 ConstellationsArt::ConstellationsArt(dms &midpointra, dms &midpointdec, double pa, double w, double h,
                                      const QString &abbreviation, const QString &filename)
 {
@@ -27,6 +37,65 @@ ConstellationsArt::ConstellationsArt(dms &midpointra, dms &midpointdec, double p
 
 void ConstellationsArt::loadImage()
 {
-    constellationArtImage = TextureManager::getImage(imageFileName);
-    imageLoaded           = true;
+    // Not cached by the TextureManager, the levels are the only copies
+    const QImage source = TextureManager::loadImage(imageFileName);
+    if (source.isNull())
+    {
+        m_ImageMissing = true;
+        return;
+    }
+
+    m_ImageSide = MIN_MIPMAP_SIZE;
+    while (m_ImageSide < std::max(source.width(), source.height()))
+        m_ImageSide *= 2;
+
+    if (m_Mipmaps.isEmpty())
+        m_Mipmaps.resize(1);
+    m_Mipmaps[0] = source.scaled(m_ImageSide, m_ImageSide, Qt::IgnoreAspectRatio, Qt::SmoothTransformation)
+                   .convertToFormat(QImage::Format_ARGB32_Premultiplied);
+}
+
+const QImage &ConstellationsArt::image(double size)
+{
+    if (m_ImageMissing)
+        return emptyImage;
+    if (m_ImageSide == 0)
+    {
+        loadImage();
+        if (m_ImageMissing)
+            return emptyImage;
+    }
+
+    int level = 0;
+    for (int side = m_ImageSide / 2; side >= MIN_MIPMAP_SIZE && side >= size; side /= 2)
+        level++;
+
+    if (m_Mipmaps.size() <= level)
+        m_Mipmaps.resize(level + 1);
+
+    if (m_Mipmaps[level].isNull())
+    {
+        // Downscale from the nearest larger level, or from the file if they were all freed
+        int source = level;
+        while (source > 0 && m_Mipmaps[source].isNull())
+            source--;
+        if (m_Mipmaps[source].isNull())
+            loadImage();
+        for (int i = source + 1; i <= level; i++)
+        {
+            const int side = m_Mipmaps[i - 1].width() / 2;
+            m_Mipmaps[i] = m_Mipmaps[i - 1].scaled(side, side, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        }
+    }
+
+    // Keep the next larger level for zooming in, and the smaller ones which are cheap
+    for (int i = 0; i < level - 1; i++)
+        m_Mipmaps[i] = QImage();
+
+    return m_Mipmaps[level];
+}
+
+void ConstellationsArt::releaseImage()
+{
+    m_Mipmaps.clear();
 }
@@ -10,6 +10,9 @@
 
 #include <QImage>
 #include <QString>
+#include <QVector>
+
+#include <limits>
 
 class dms;
 
@@ -41,20 +44,27 @@ class ConstellationsArt : public SkyObject
     explicit ConstellationsArt(dms &midpointra, dms &midpointdec, double pa, double w, double h,
                                const QString &abbreviation, const QString &filename);
 
-    /** @return an object's image */
-    const QImage &image()
-    {
-        if (imageLoaded)
-            return constellationArtImage;
-        else
-        {
-            loadImage();
-            return constellationArtImage;
-        }
-    }
-
-    /** Load the object's image. This also scales the object's image to 1024x1024 pixels. */
-    void loadImage();
+    /** @return the image at full resolution, loaded if needed */
+    const QImage &image() { return image(std::numeric_limits<double>::infinity()); }
+
+    /**
+     * @return the smallest level of the image with sides of at least @p size pixels, loaded and downscaled if needed.
+     *
+     * Levels are square with sides of powers of two, each half the size of the previous one, so they bind as GL
+     * textures as they are. They are stretched to the size of the constellation when drawn. Only the level returned
+     * and the next larger one are kept, the others are freed.
+     */
+    const QImage &image(double size);
+
+    /** @return true if levels of the image are in memory */
+    bool isImageLoaded() const { return !m_Mipmaps.isEmpty(); }
+
+    /** @short Free all levels of the image, e.g. once off screen for a while. It is loaded again when drawn. */
+    void releaseImage();
+
+    /** @return the frame of the ConstellationArtComponent the image was last drawn in */
+    quint64 lastDrawn() const { return m_LastDrawn; }
+    void setLastDrawn(quint64 frame) { m_LastDrawn = frame; }
 
     /** @return an object's abbreviation */
     inline QString getAbbrev() const { return abbrev; }
@@ -75,11 +85,18 @@ class ConstellationsArt : public SkyObject
     inline double getHeight() { return height; }
 
   private:
+    /** Load the image as the largest level, square and with sides of a power of two. */
+    void loadImage();
+
     QString abbrev;
     QString imageFileName;
-    QImage constellationArtImage;
+    // The levels of the image, largest first, null once freed
+    QVector<QImage> m_Mipmaps;
+    // The side of the largest level, 0 until loaded
+    int m_ImageSide { 0 };
+    bool m_ImageMissing { false };
+    quint64 m_LastDrawn { 0 };
     double positionAngle { 0 };
     double width { 0 };
     double height { 0 };
-    bool imageLoaded { false };
 };
@@ -0,0 +1,63 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+/**
+ * @short Solves Kepler's equation E - e sin E = M for elliptical orbits.
+ *
+ * KSAsteroid and KSComet solve it for one body at a time. The batch form takes the mean
+ * anomalies and eccentricities of many bodies as separate arrays, so that tools can propagate
+ * whole element sets without creating sky objects. This header does not depend on Qt.
+ */
+namespace KeplerSolver
+{
+/// Same accuracy as the former per-object iteration, 0.001 degree
+static constexpr double TOLERANCE      = 0.001 * M_PI / 180.0;
+static constexpr int MAX_ITERATIONS    = 1000;
+/// Below this eccentricity the second order starting value is accurate enough
+static constexpr double MIN_ITERATED_E = 0.005;
+
+/**
+ * @return the eccentric anomaly, in radians
+ * @param M the mean anomaly, in radians
+ * @param e the eccentricity, 0 <= e < 1
+ */
+inline double eccentricAnomaly(double M, double e)
+{
+    const double sinM = std::sin(M);
+    const double cosM = std::cos(M);
+    double E          = M + e * sinM * (1.0 + e * cosM);
+
+    if (e > MIN_ITERATED_E)
+    {
+        for (int iter = 0; iter < MAX_ITERATIONS; ++iter)
+        {
+            const double delta = (E - e * std::sin(E) - M) / (1.0 - e * std::cos(E));
+            E -= delta;
+            if (std::fabs(delta) <= TOLERANCE)
+                break;
+        }
+    }
+
+    return E;
+}
+
+/**
+ * Solve Kepler's equation for @p count bodies. @p E may be the same array as @p M.
+ * @param M mean anomalies, in radians
+ * @param e eccentricities
+ * @param E receives the eccentric anomalies, in radians
+ */
+inline void eccentricAnomalies(const double *M, const double *e, double *E, std::size_t count)
+{
+    for (std::size_t k = 0; k < count; ++k)
+        E[k] = eccentricAnomaly(M[k], e[k]);
+}
+}
@@ -7,6 +7,7 @@
 #include "ksasteroid.h"
 
 #include "dms.h"
+#include "keplersolver.h"
 #include "ksnumbers.h"
 #include "Options.h"
 #ifdef KSTARS_LITE
@@ -17,6 +18,7 @@
 
 #include <qdebug.h>
 
+#include <cstring>
 #include <typeinfo>
 
 KSAsteroid::KSAsteroid(int _catN, const QString &s, const QString &imfile, long double _JD, double _a, double _e,
@@ -38,11 +40,6 @@ KSAsteroid *KSAsteroid::clone() const
 
 bool KSAsteroid::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *Earth)
 {
-    // TODO: (Valentin) TOP LEVEL CONTROL OF CALCULATION FOR ALL OBJECTS
-    if(!toCalculate()){
-        return false;
-    }
-
     //determine the mean anomaly for the desired date.  This is the mean anomaly for the
     //ephemeis epoch, plus the number of days between the desired date and ephemeris epoch,
     //times the asteroid's mean daily motion (360/P):
@@ -51,31 +48,12 @@ bool KSAsteroid::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase
     // Mean anomaly is supplied at the Epoch (which is JD here)
 
     dms m = dms(double(M.Degrees() + (lastPrecessJD - JD) * 360.0 / P)).reduce();
-    double sinm, cosm;
-    m.SinCos(sinm, cosm);
 
     //compute eccentric anomaly:
-    double E = m.Degrees() + e * 180.0 / dms::PI * sinm * (1.0 + e * cosm);
-
-    if (e > 0.005) //need more accurate approximation, iterate...
-    {
-        double E0;
-        int iter(0);
-        do
-        {
-            E0 = E;
-            iter++;
-            E = E0 -
-                (E0 - e * 180.0 / dms::PI * sin(E0 * dms::DegToRad) - m.Degrees()) / (1 - e * cos(E0 * dms::DegToRad));
-        } while (fabs(E - E0) > 0.001 && iter < 1000);
-    }
-
-    // Assert that the solution of the Kepler equation E = M + e sin E is accurate to about 0.1 arcsecond
-    //Q_ASSERT( fabs( E - ( m.Degrees() + ( e * 180.0 / dms::PI ) * sin( E * dms::DegToRad ) ) ) < 0.10/3600.0 );
+    const double E = KeplerSolver::eccentricAnomaly(m.radians(), e);
 
-    double sinE, cosE;
-    dms E1(E);
-    E1.SinCos(sinE, cosE);
+    const double sinE = sin(E);
+    const double cosE = cos(E);
 
     double xv = a * (cosE - e);
     double yv = a * sqrt(1.0 - e * e) * sinE;
@@ -140,7 +118,10 @@ bool KSAsteroid::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase
     // So we have to precess as well
     setRA0(ra());
     setDec0(dec());
-    apparentCoord(J2000, lastPrecessJD);
+    if (lastPrecessJD == num->julianDay())
+        apparentCoord(num);
+    else
+        apparentCoord(J2000, lastPrecessJD);
     //nutate(num);
     //aberrate(num);
 
@@ -260,6 +241,51 @@ QDataStream &operator>>(QDataStream &in, KSAsteroid *&asteroid)
     return in;
 }
 
+void KSAsteroid::toRecord(Record &record, ElementTable::StringPool &strings) const
+{
+    std::memset(&record, 0, sizeof(Record));
+    record.JD             = static_cast<double>(JD);
+    record.a              = a;
+    record.e              = e;
+    record.q              = q;
+    record.i              = i.Degrees();
+    record.w              = w.Degrees();
+    record.N              = N.Degrees();
+    record.M              = M.Degrees();
+    record.H              = H;
+    record.G              = G;
+    record.earthMOID      = EarthMOID;
+    record.diameter       = Diameter;
+    record.albedo         = Albedo;
+    record.rotationPeriod = RotationPeriod;
+    record.period         = Period;
+    record.catN           = catN;
+    record.name           = strings.add(Name);
+    record.orbitClass     = strings.add(OrbitClass);
+    record.dimensions     = strings.add(Dimensions);
+    record.orbitID        = strings.add(OrbitID);
+    record.neo            = NEO ? 1 : 0;
+}
+
+KSAsteroid *KSAsteroid::fromRecord(const Record &record, const ElementTable &table)
+{
+    auto asteroid = new KSAsteroid(record.catN, table.string(record.name), QString(), record.JD, record.a, record.e,
+                                   dms(record.i), dms(record.w), dms(record.N), dms(record.M), record.H, record.G);
+    asteroid->setPerihelion(record.q);
+    asteroid->setOrbitID(table.string(record.orbitID));
+    asteroid->setNEO(record.neo != 0);
+    asteroid->setDiameter(record.diameter);
+    // Few distinct values, shared between the asteroids
+    asteroid->setDimensions(table.sharedString(record.dimensions));
+    asteroid->setAlbedo(record.albedo);
+    asteroid->setRotationPeriod(record.rotationPeriod);
+    asteroid->setPeriod(record.period);
+    asteroid->setEarthMOID(record.earthMOID);
+    asteroid->setOrbitClass(table.sharedString(record.orbitClass));
+    asteroid->setPhysicalSize(record.diameter);
+    return asteroid;
+}
+
 void KSAsteroid::setRotationPeriod(float rot_per)
 {
     RotationPeriod = rot_per;
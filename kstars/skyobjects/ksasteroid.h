@@ -7,6 +7,7 @@
 #pragma once
 
 #include "ksplanetbase.h"
+#include "auxiliary/elementtable.h"
 
 #include <QDataStream>
 
@@ -189,7 +190,7 @@ class KSAsteroid : public KSPlanetBase
 
     /**
      * @brief toCalculate
-     * @return whether to calculate the position
+     * @return whether the asteroid is bright enough to be shown, or is focused
      */
     bool toCalculate();
 
@@ -213,6 +214,33 @@ class KSAsteroid : public KSPlanetBase
     void setJD(long double jd) { JD = jd; }
 
 
+    /** The fixed layout of an asteroid in an ElementTable */
+    struct Record
+    {
+        double JD;
+        double a, e, q;
+        /// Angles in degrees
+        double i, w, N, M;
+        double H, G;
+        double earthMOID;
+        float diameter, albedo, rotationPeriod, period;
+        qint32 catN;
+        /// Offsets in the strings of the table
+        quint32 name, orbitClass, dimensions, orbitID;
+        quint8 neo;
+        quint8 padding[3];
+    };
+    static_assert(sizeof(Record) % 8 == 0, "Records must stay aligned in the table");
+
+    /** Changes whenever Record does */
+    static constexpr quint32 RECORD_VERSION = 1;
+
+    /** @short Fill @p record with the elements of this asteroid, adding its strings to @p strings */
+    void toRecord(Record &record, ElementTable::StringPool &strings) const;
+
+    /** @return a new asteroid with the elements of @p record, whose strings are in @p table */
+    static KSAsteroid *fromRecord(const Record &record, const ElementTable &table);
+
   private:
     /**
      * Serializers
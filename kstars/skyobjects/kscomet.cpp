@@ -6,6 +6,7 @@
 
 #include "kscomet.h"
 
+#include "keplersolver.h"
 #include "ksnumbers.h"
 #include "kstarsdata.h"
 
@@ -187,32 +188,12 @@ bool KSComet::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *E
         // Check http://astro.if.ufrgs.br/trigesf/position.html#17 for more details
 
         dms m = dms(double(360.0 * (deltaJDP) / P)).reduce();
-        double sinm, cosm;
-        m.SinCos(sinm, cosm);
 
         //compute eccentric anomaly:
-        double E = m.Degrees() + e * 180.0 / dms::PI * sinm * (1.0 + e * cosm);
+        const double E = KeplerSolver::eccentricAnomaly(m.radians(), e);
 
-        if (e > 0.005) //need more accurate approximation, iterate...
-        {
-            double E0;
-            int iter(0);
-            do
-            {
-                E0 = E;
-                iter++;
-                E = E0 - (E0 - e * 180.0 / dms::PI * sin(E0 * dms::DegToRad) - m.Degrees()) /
-                    (1 - e * cos(E0 * dms::DegToRad));
-            }
-            while (fabs(E - E0) > 0.001 && iter < 1000);
-        }
-
-        // Assert that the solution of the Kepler equation E = M + e sin E is accurate to about 0.1 arcsecond
-        //Q_ASSERT( fabs( E - ( m.Degrees() + ( e * 180.0 / dms::PI ) * sin( E * dms::DegToRad ) ) ) < 0.10/3600.0 );
-
-        double sinE, cosE;
-        dms E1(E);
-        E1.SinCos(sinE, cosE);
+        const double sinE = sin(E);
+        const double cosE = cos(E);
 
         double xv = a * (cosE - e);
         double yv = a * sqrt(1.0 - e * e) * sinE;
@@ -286,7 +267,10 @@ bool KSComet::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *E
     // So we have to precess as well
     setRA0(ra());
     setDec0(dec());
-    apparentCoord(J2000, lastPrecessJD);
+    if (lastPrecessJD == num->julianDay())
+        apparentCoord(num);
+    else
+        apparentCoord(J2000, lastPrecessJD);
     findPhysicalParameters();
 
     return true;
@@ -6,6 +6,7 @@
 
 #include "ksmoon.h"
 
+#include "chebyshevephemeris.h"
 #include "ksnumbers.h"
 #include "ksutils.h"
 #include "kssun.h"
@@ -86,6 +87,7 @@ KSMoon::~KSMoon()
     {
         LRData.clear();
         BData.clear();
+        ephemeris.reset();
         data_loaded = false;
     }
 }
@@ -94,6 +96,15 @@ bool KSMoon::data_loaded   = false;
 int KSMoon::instance_count = 0;
 QList<KSMoon::MoonLRData> KSMoon::LRData;
 QList<KSMoon::MoonBData> KSMoon::BData;
+std::unique_ptr<ChebyshevEphemeris> KSMoon::ephemeris;
+
+namespace
+{
+/// The fit is good to about a meter, well below the accuracy of the series
+constexpr double EPHEMERIS_SPAN      = 4;
+constexpr int EPHEMERIS_DEGREE       = 13;
+constexpr double EPHEMERIS_TOLERANCE = 1e-11;
+}
 
 bool KSMoon::loadData()
 {
@@ -146,22 +157,56 @@ bool KSMoon::loadData()
         f.close();
     }
 
+    ephemeris.reset(new ChebyshevEphemeris([](double days, double *xyz)
+    {
+        double longitude, latitude, distance;
+        calcSeries(days / 36525.0, longitude, latitude, distance);
+
+        double sinL, cosL, sinB, cosB;
+        dms(longitude).SinCos(sinL, cosL);
+        dms(latitude).SinCos(sinB, cosB);
+        xyz[0] = distance * cosB * cosL;
+        xyz[1] = distance * cosB * sinL;
+        xyz[2] = distance * sinB;
+    }, EPHEMERIS_SPAN, EPHEMERIS_DEGREE, EPHEMERIS_TOLERANCE));
+
     data_loaded = true;
     return true;
 }
 
 bool KSMoon::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *)
+{
+    if (!loadData())
+        return false;
+
+    double xyz[3];
+    ephemeris->evaluate(num->julianCenturies() * 36525.0, xyz);
+
+    dms longitude;
+    longitude.setRadians(atan2(xyz[1], xyz[0]));
+    setEcLong(longitude.reduce());
+    dms latitude;
+    latitude.setRadians(atan2(xyz[2], sqrt(xyz[0] * xyz[0] + xyz[1] * xyz[1])));
+    setEcLat(latitude);
+    Rearth = sqrt(xyz[0] * xyz[0] + xyz[1] * xyz[1] + xyz[2] * xyz[2]);
+
+    EclipticToEquatorial(num->obliquity());
+
+    //Determine position angle
+    findPA(num);
+
+    return true;
+}
+
+void KSMoon::calcSeries(double T, double &longitude, double &latitude, double &distance)
 {
     //Algorithms in this subroutine are taken from Chapter 45 of "Astronomical Algorithms"
     //by Jean Meeus (1991, Willmann-Bell, Inc. ISBN 0-943396-35-2.  https://www.willbell.com/math/mc1.htm)
     //updated to Jean Messus (1998, Willmann-Bell, http://www.naughter.com/aa.html )
 
-    double T, L, D, M, M1, F, A1, A2, A3;
+    double L, D, M, M1, F, A1, A2, A3;
     double sumL, sumR, sumB;
 
-    //Julian centuries since J2000
-    T = num->julianCenturies();
-
     double Et = 1.0 - 0.002516 * T - 0.0000074 * T * T;
 
     //Moon's mean longitude
@@ -188,9 +233,6 @@ bool KSMoon::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *)
     sumL = 0.0;
     sumR = 0.0;
 
-    if (!loadData())
-        return false;
-
     for (const auto &mlrd : LRData)
     {
         double E = 1.0;
@@ -225,16 +267,9 @@ bool KSMoon::findGeocentricPosition(const KSNumbers *num, const KSPlanetBase *)
              115.0 * sin(L + M1));
 
     //Geocentric coordinates
-    setEcLong(dms(sumL / 1000000.0 + L * 180.0 / dms::PI)); //convert radians to degrees
-    setEcLat(dms(sumB / 1000000.0));
-    Rearth = (385000.56 + sumR / 1000.0) / AU_KM; //distance from Earth, in AU
-
-    EclipticToEquatorial(num->obliquity());
-
-    //Determine position angle
-    findPA(num);
-
-    return true;
+    longitude = sumL / 1000000.0 + L * 180.0 / dms::PI; //convert radians to degrees
+    latitude  = sumB / 1000000.0;
+    distance  = (385000.56 + sumR / 1000.0) / AU_KM; //distance from Earth, in AU
 }
 
 void KSMoon::findMagnitude(const KSNumbers *)
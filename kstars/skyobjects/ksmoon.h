@@ -9,6 +9,9 @@
 #include "ksplanetbase.h"
 #include "dms.h"
 
+#include <memory>
+
+class ChebyshevEphemeris;
 class KSSun;
 
 /**
@@ -84,8 +87,18 @@ class KSMoon : public KSPlanetBase
   private:
     void findMagnitude(const KSNumbers *) override;
 
+    /**
+     * Sum the series of the lunar theory for @p T Julian centuries since J2000.
+     * @param longitude geocentric ecliptic longitude, in degrees
+     * @param latitude geocentric ecliptic latitude, in degrees
+     * @param distance distance from the Earth, in AU
+     */
+    static void calcSeries(double T, double &longitude, double &latitude, double &distance);
+
     static bool data_loaded;
     static int instance_count;
+    /// Chebyshev fit of calcSeries(), kept as long as the series are loaded
+    static std::unique_ptr<ChebyshevEphemeris> ephemeris;
 
     /**
      * @class MoonLRData
@@ -6,10 +6,14 @@
 
 #include "ksplanet.h"
 
+#include "chebyshevephemeris.h"
 #include "ksnumbers.h"
 #include "ksutils.h"
 #include "ksfilereader.h"
 
+#include <QMutex>
+#include <QMutexLocker>
+
 #include <cmath>
 #include <typeinfo>
 
@@ -20,6 +24,25 @@
 
 KSPlanet::OrbitDataManager KSPlanet::odm;
 
+namespace
+{
+constexpr int EPHEMERIS_DEGREE = 13;
+/// In AU, about 150 m
+constexpr double EPHEMERIS_TOLERANCE = 1e-9;
+
+/// Segment length in days, shorter for the faster planets
+double ephemerisSpan(const QString &name)
+{
+    if (name == "mercury")
+        return 16;
+    if (name == "jupiter" || name == "saturn")
+        return 64;
+    if (name == "uranus" || name == "neptune")
+        return 128;
+    return 32;
+}
+}
+
 KSPlanet::OrbitDataManager::OrbitDataManager()
 {
     //EMPTY
@@ -189,19 +212,54 @@ bool KSPlanet::loadData()
     return odm.loadData(odc, untranslatedName());
 }
 
-void KSPlanet::calcEcliptic(double Tau, EclipticPosition &epret) const
+ChebyshevEphemeris *KSPlanet::ephemeris() const
 {
-    double sum[6];
-    OrbitDataColl odc;
-    double Tpow[6];
-
-    Tpow[0] = 1.0;
-    for (int i = 1; i < 6; ++i)
+    if (!m_EphemerisLoaded)
     {
-        Tpow[i] = Tpow[i - 1] * Tau;
+        static QMutex mutex;
+        static QHash<QString, std::shared_ptr<ChebyshevEphemeris>> ephemerides;
+
+        const QString name = untranslatedName().toLower();
+        QMutexLocker lock(&mutex);
+
+        auto it = ephemerides.find(name);
+        if (it == ephemerides.end())
+        {
+            OrbitDataColl odc;
+            std::shared_ptr<ChebyshevEphemeris> ephemeris;
+
+            if (odm.loadData(odc, name))
+            {
+                auto series = [odc](double days, double *xyz)
+                {
+                    EclipticPosition pos;
+                    calcSeries(odc, days / 365250.0, pos);
+
+                    double sinL, cosL, sinB, cosB;
+                    pos.longitude.SinCos(sinL, cosL);
+                    pos.latitude.SinCos(sinB, cosB);
+                    xyz[0] = pos.radius * cosB * cosL;
+                    xyz[1] = pos.radius * cosB * sinL;
+                    xyz[2] = pos.radius * sinB;
+                };
+                ephemeris = std::make_shared<ChebyshevEphemeris>(series, ephemerisSpan(name), EPHEMERIS_DEGREE,
+                            EPHEMERIS_TOLERANCE);
+            }
+            it = ephemerides.insert(name, ephemeris);
+        }
+
+        m_Ephemeris       = it.value();
+        m_EphemerisLoaded = true;
     }
 
-    if (!odm.loadData(odc, untranslatedName()))
+    return m_Ephemeris.get();
+}
+
+void KSPlanet::calcEcliptic(double Tau, EclipticPosition &epret) const
+{
+    ChebyshevEphemeris *cache = ephemeris();
+
+    if (cache == nullptr)
     {
         epret.longitude = dms(0.0);
         epret.latitude  = dms(0.0);
@@ -210,6 +268,26 @@ void KSPlanet::calcEcliptic(double Tau, EclipticPosition &epret) const
         return;
     }
 
+    double xyz[3];
+    cache->evaluate(Tau * 365250.0, xyz);
+
+    epret.radius = sqrt(xyz[0] * xyz[0] + xyz[1] * xyz[1] + xyz[2] * xyz[2]);
+    epret.longitude.setRadians(atan2(xyz[1], xyz[0]));
+    epret.longitude.setD(epret.longitude.reduce().Degrees());
+    epret.latitude.setRadians(atan2(xyz[2], sqrt(xyz[0] * xyz[0] + xyz[1] * xyz[1])));
+}
+
+void KSPlanet::calcSeries(const OrbitDataColl &odc, double Tau, EclipticPosition &epret)
+{
+    double sum[6];
+    double Tpow[6];
+
+    Tpow[0] = 1.0;
+    for (int i = 1; i < 6; ++i)
+    {
+        Tpow[i] = Tpow[i - 1] * Tau;
+    }
+
     //Ecliptic Longitude
     for (int i = 0; i < 6; ++i)
     {
@@ -12,6 +12,9 @@
 #include <QString>
 #include <QVector>
 
+#include <memory>
+
+class ChebyshevEphemeris;
 class KSNumbers;
 
 /**
@@ -68,6 +71,7 @@ class KSPlanet : public KSPlanetBase
      * Calculate the ecliptic longitude and latitude of the planet for
      * the given date (expressed in Julian Millenia since J2000).  A reference
      * to the ecliptic coordinates is returned as the second object.
+     * The position comes from a Chebyshev fit of the series, see ChebyshevEphemeris.
      * @param jm Julian Millenia (=jd/1000)
      * @param ret The ecliptic coordinates are returned by reference through this argument.
      */
@@ -166,9 +170,21 @@ class KSPlanet : public KSPlanetBase
         QHash<QString, OrbitDataColl> hash;
     };
 
+    /** Sum the series of @p odc for @p jm Julian Millenia, as calcEcliptic() used to */
+    static void calcSeries(const OrbitDataColl &odc, double jm, EclipticPosition &ret);
+
   private:
     void findMagnitude(const KSNumbers *) override;
 
+    /**
+     * @return the cached ephemeris of the planet, shared by all planets of the same name,
+     * or nullptr if there is no orbit data for the planet
+     */
+    ChebyshevEphemeris *ephemeris() const;
+
+    mutable std::shared_ptr<ChebyshevEphemeris> m_Ephemeris;
+    mutable bool m_EphemerisLoaded { false };
+
   protected:
     bool data_loaded { false };
     static OrbitDataManager odm;
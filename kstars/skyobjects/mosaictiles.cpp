@@ -5,9 +5,11 @@
 */
 
 #include <QPainter>
+#include <QTransform>
 
 #include "mosaictiles.h"
 #include "kstarsdata.h"
+#include "ksnumbers.h"
 #include "Options.h"
 
 MosaicTiles::MosaicTiles() : SkyObject()
@@ -244,16 +246,19 @@ bool MosaicTiles::processJobInfo(XMLEle *root, int index)
 void MosaicTiles::appendTile(const OneTile &value)
 {
     m_Tiles.append(std::make_shared<OneTile>(value));
+    m_DrawnScale = 0;
 }
 
 void MosaicTiles::appendEmptyTile()
 {
     m_Tiles.append(std::make_shared<OneTile>());
+    m_DrawnScale = 0;
 }
 
 void MosaicTiles::clearTiles()
 {
     m_Tiles.clear();
+    m_DrawnScale = 0;
 }
 
 QSizeF MosaicTiles::adjustCoordinate(QPointF tileCoord)
@@ -298,6 +303,9 @@ void MosaicTiles::updateTiles()
     // Start by clearing existing tiles.
     clearTiles();
 
+    // All tiles are precessed to the same date, so compute the precession and nutation terms once
+    KSNumbers num(KStarsData::Instance()->ut().djd());
+
     int index = 0;
     for (int col = 0; col < gridW; col++)
     {
@@ -317,7 +325,7 @@ void MosaicTiles::updateTiles()
             auto adjusted_ra0 = (ra0().Degrees() + tileSkyOffsetScaled.width()) / 15.0;
             auto adjusted_de0 = (dec0().Degrees() + tileSkyOffsetScaled.height());
             SkyPoint sky_center(adjusted_ra0, adjusted_de0);
-            sky_center.apparentCoord(static_cast<long double>(J2000), KStarsData::Instance()->ut().djd());
+            sky_center.apparentCoord(&num);
 
             auto tile_center_ra0 = sky_center.ra0().Degrees();
             auto mosaic_center_ra0 = ra0().Degrees();
@@ -382,65 +390,72 @@ void MosaicTiles::draw(QPainter *painter)
     // Fill tiles with a transparent brush to show overlaps
     QBrush tileBrush(QColor(0, 255, 0, (200 * alphaValue) / 100), Qt::SolidPattern);
 
-    // Draw each tile, adjusted for rotation
-    for (int row = 0; row < gridH; row++)
-    {
-        for (int col = 0; col < gridW; col++)
-        {
-            auto tile = oneTile(row, col);
-            if (tile)
-            {
-                painter->save();
-
-                painter->translate(tile->center * pixelScale);
-                painter->rotate(tile->rotation);
-
-                painter->setBrush(tileBrush);
-                painter->setPen(m_Pen);
+    if (m_DrawnScale != pixelScale)
+        updateDrawnTiles(pixelScale);
 
-                painter->drawRect(oneRect);
+    const auto count = qMin(m_DrawnTiles.size(), gridW * gridH);
 
-                painter->restore();
-            }
-        }
-    }
+    // Draw each tile, already rotated in the cached outline
+    painter->setBrush(tileBrush);
+    painter->setPen(m_Pen);
+    for (int i = 0; i < count; i++)
+        painter->drawPolygon(m_DrawnTiles[i].outline);
 
     // Overwrite with tile information
-    for (int row = 0; row < gridH; row++)
+    painter->setBrush(m_TextBrush);
+    painter->setPen(m_TextPen);
+    defaultFont.setPointSize(qMax(1., 4 * pixelScale * m_CameraFOV.width() / 60.));
+    painter->setFont(defaultFont);
+
+    for (int i = 0; i < count; i++)
     {
-        for (int col = 0; col < gridW; col++)
-        {
-            auto tile = oneTile(row, col);
-            if (tile)
-            {
-                painter->save();
+        const auto &tile = m_DrawnTiles[i];
 
-                painter->translate(tile->center * pixelScale);
-                // Add 180 to match Position Angle per the standard definition
-                // when camera image is read bottom-up instead of KStars standard top-bottom.
-                //painter->rotate(tile->rotation + 180);
+        painter->save();
 
-                painter->rotate(tile->rotation);
+        painter->translate(tile.center);
+        // Add 180 to match Position Angle per the standard definition
+        // when camera image is read bottom-up instead of KStars standard top-bottom.
+        //painter->rotate(tile.rotation + 180);
 
-                painter->setBrush(m_TextBrush);
-                painter->setPen(m_TextPen);
+        painter->rotate(tile.rotation);
 
-                defaultFont.setPointSize(qMax(1., 4 * pixelScale * m_CameraFOV.width() / 60.));
-                painter->setFont(defaultFont);
-                painter->drawText(oneRect, Qt::AlignRight | Qt::AlignTop, QString("%1.").arg(tile->index));
+        painter->drawText(oneRect, Qt::AlignRight | Qt::AlignTop, tile.index);
+        painter->drawText(oneRect, Qt::AlignHCenter | Qt::AlignVCenter, tile.coordinates);
+        painter->drawText(oneRect, Qt::AlignHCenter | Qt::AlignBottom, tile.rotationText);
 
-                defaultFont.setPointSize(qMax(1., 4 * pixelScale * m_CameraFOV.width() / 60.));
-                painter->setFont(defaultFont);
-                painter->drawText(oneRect, Qt::AlignHCenter | Qt::AlignVCenter, QString("%1\n%2")
-                                  .arg(tile->skyCenter.ra0().toHMSString(), tile->skyCenter.dec0().toDMSString()));
-                painter->drawText(oneRect, Qt::AlignHCenter | Qt::AlignBottom, QString("%1%2°")
-                                  .arg(tile->rotation >= 0.01 ? '+' : tile->rotation <= -0.01 ? '-' : '~')
-                                  .arg(abs(tile->rotation), 5, 'f', 2));
+        painter->restore();
+    }
+}
 
-                painter->restore();
-            }
-        }
+void MosaicTiles::updateDrawnTiles(double pixelScale)
+{
+    const auto fovW = m_CameraFOV.width() * pixelScale;
+    const auto fovH = m_CameraFOV.height() * pixelScale;
+    QRect const oneRect(-fovW / 2, -fovH / 2, fovW, fovH);
+
+    m_DrawnTiles.clear();
+    m_DrawnTiles.reserve(m_Tiles.size());
+
+    for (const auto &tile : m_Tiles)
+    {
+        if (!tile)
+            continue;
+
+        DrawnTile drawn;
+        drawn.center = tile->center * pixelScale;
+        drawn.rotation = tile->rotation;
+        const auto transform = QTransform().translate(drawn.center.x(), drawn.center.y()).rotate(tile->rotation);
+        drawn.outline = transform.map(QPolygonF(QRectF(oneRect)));
+        drawn.index = QString("%1.").arg(tile->index);
+        drawn.coordinates = QString("%1\n%2").arg(tile->skyCenter.ra0().toHMSString(), tile->skyCenter.dec0().toDMSString());
+        drawn.rotationText = QString("%1%2°")
+                             .arg(tile->rotation >= 0.01 ? '+' : tile->rotation <= -0.01 ? '-' : '~')
+                             .arg(abs(tile->rotation), 5, 'f', 2);
+        m_DrawnTiles.append(drawn);
     }
+
+    m_DrawnScale = pixelScale;
 }
 
 QPointF MosaicTiles::rotatePoint(QPointF pointToRotate, QPointF centerPoint, double paDegrees)
@@ -493,5 +508,6 @@ void MosaicTiles::syncFOVs()
 {
     m_CameraFOV = calculateCameraFOV();
     m_MosaicFOV = calculateTargetMosaicFOV();
+    m_DrawnScale = 0;
 }
 
@@ -11,6 +11,7 @@
 
 #include <QBrush>
 #include <QPen>
+#include <QPolygonF>
 #include <memory>
 
 #ifdef HAVE_INDI
@@ -157,6 +158,7 @@ class MosaicTiles : public SkyObject
         void setCameraFOV(const QSizeF &value)
         {
             m_CameraFOV = value;
+            m_DrawnScale = 0;
         }
         void setMosaicFOV(const QSizeF &value)
         {
@@ -259,6 +261,20 @@ class MosaicTiles : public SkyObject
 
         QList<std::shared_ptr<OneTile>> m_Tiles;
 
+        // Tile outlines and labels at the last drawn zoom, rebuilt when the tiles or the zoom change
+        typedef struct
+        {
+            QPolygonF outline;
+            QPointF center;
+            double rotation;
+            QString index;
+            QString coordinates;
+            QString rotationText;
+        } DrawnTile;
+
+        QVector<DrawnTile> m_DrawnTiles;
+        double m_DrawnScale {0};
+
         /**
            * @brief adjustCoordinate This uses the mosaic center as reference and the argument resolution of the sky map at that center.
            * @param tileCoord point to adjust
@@ -266,6 +282,7 @@ class MosaicTiles : public SkyObject
            */
         QSizeF adjustCoordinate(QPointF tileCoord);
         void updateTiles();
+        void updateDrawnTiles(double pixelScale);
 
         bool processJobInfo(XMLEle *root, int index);
 
@@ -0,0 +1,89 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "nametable.h"
+
+uint qHash(const NameTable::Key &key, uint seed)
+{
+    // Same folding as QString::compare(Qt::CaseInsensitive), so that equal keys hash alike
+    const QString &name = key.name;
+    uint hash = seed;
+    for (int i = 0; i < name.size(); ++i)
+    {
+        uint ucs4 = name.at(i).unicode();
+        if (QChar::isHighSurrogate(ucs4) && i + 1 < name.size() && name.at(i + 1).isLowSurrogate())
+            ucs4 = QChar::surrogateToUcs4(ucs4, name.at(++i).unicode());
+
+        hash = 31 * hash + QChar::toCaseFolded(ucs4);
+    }
+    return hash;
+}
+
+NameTable &NameTable::instance()
+{
+    static NameTable table;
+    return table;
+}
+
+NameTable::Id NameTable::intern(const QString &name, QString *shared)
+{
+    if (name.isEmpty())
+    {
+        if (shared)
+            *shared = name;
+        return NoName;
+    }
+
+    const Key key{ name };
+    Id id = NoName;
+    {
+        QReadLocker lock(&m_Lock);
+        id = m_Ids.value(key, NoName);
+    }
+
+    if (id == NoName)
+    {
+        QWriteLocker lock(&m_Lock);
+        // Another thread may have added the name meanwhile
+        auto iter = m_Ids.find(key);
+        if (iter == m_Ids.end())
+        {
+            m_Names.append(name);
+            iter = m_Ids.insert(key, m_Names.size());
+        }
+        id = iter.value();
+    }
+
+    if (shared)
+    {
+        QReadLocker lock(&m_Lock);
+        const QString &stored = m_Names.at(id - 1);
+        *shared = (stored == name) ? stored : name;
+    }
+
+    return id;
+}
+
+NameTable::Id NameTable::find(const QString &name) const
+{
+    if (name.isEmpty())
+        return NoName;
+
+    QReadLocker lock(&m_Lock);
+    return m_Ids.value(Key{ name }, NoName);
+}
+
+QString NameTable::name(Id id) const
+{
+    QReadLocker lock(&m_Lock);
+    return (id == NoName || id > static_cast<Id>(m_Names.size())) ? QString() : m_Names.at(id - 1);
+}
+
+int NameTable::size() const
+{
+    QReadLocker lock(&m_Lock);
+    return m_Names.size();
+}
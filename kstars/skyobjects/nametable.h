@@ -0,0 +1,73 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+#include <QVector>
+
+/**
+ * @class NameTable
+ * A process wide table of the names of sky objects.
+ *
+ * Every name gets a compact id, and names that only differ by case share it, so that
+ * components can index their objects by id instead of keeping lower case copies of the
+ * names. The table also keeps one copy of each name, which the objects can share instead of
+ * holding their own (see SkyObject::shareNames()).
+ *
+ * Names are never removed, so only the names of objects that live for the whole session,
+ * like the ones of the list components, should be interned. The table can be used from
+ * several threads.
+ */
+class NameTable
+{
+    public:
+        using Id = quint32;
+
+        /// The id of the empty name
+        static constexpr Id NoName = 0;
+
+        static NameTable &instance();
+
+        /**
+         * @return the id of @p name, added to the table if needed. Names that only differ by
+         * case have the same id.
+         * @param shared if not null, set to the copy of @p name kept by the table if it has the
+         * same case, else to @p name.
+         */
+        Id intern(const QString &name, QString *shared = nullptr);
+
+        /** @return the id of @p name, compared case insensitively, or NoName if it was never interned. */
+        Id find(const QString &name) const;
+
+        /** @return the name with @p id, in the case it was first interned with. */
+        QString name(Id id) const;
+
+        /** @return the number of interned names */
+        int size() const;
+
+    private:
+        NameTable() = default;
+
+        /** A name that is hashed and compared case insensitively, without making a folded copy. */
+        struct Key
+        {
+            QString name;
+
+            bool operator==(const Key &other) const
+            {
+                return name.compare(other.name, Qt::CaseInsensitive) == 0;
+            }
+        };
+        friend uint qHash(const Key &key, uint seed);
+
+        mutable QReadWriteLock m_Lock;
+        QHash<Key, Id> m_Ids;
+        /// The name of id i is at i - 1
+        QVector<QString> m_Names;
+};
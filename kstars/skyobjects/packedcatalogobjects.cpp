@@ -0,0 +1,74 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "packedcatalogobjects.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+quint16 appendString(QString &buffer, const QString &string)
+{
+    const int size = std::min<int>(string.size(), std::numeric_limits<quint16>::max());
+    buffer.append(string.constData(), size);
+    return size;
+}
+}
+
+PackedCatalogObjects::PackedCatalogObjects(const std::vector<CatalogObject> &objects)
+{
+    m_entries.reserve(objects.size());
+
+    for (const auto &object : objects)
+    {
+        Entry entry;
+        entry.ra        = object.ra0().Degrees();
+        entry.dec       = object.dec0().Degrees();
+        entry.mag       = object.mag();
+        entry.a         = object.a();
+        entry.b         = object.b();
+        entry.pa        = object.pa();
+        entry.flux      = object.flux();
+        entry.catalogId = object.catalogId();
+        entry.type      = object.type();
+
+        const QString name = object.hasName() ? object.name() : QString();
+        const QString defaultLongName = object.hasName() ? name : object.name2();
+
+        entry.strings  = m_strings.size();
+        entry.nameSize = appendString(m_strings, name);
+        entry.longNameSize =
+            object.longname() == defaultLongName ? 0 : appendString(m_strings, object.longname());
+        entry.catalogIdentifierSize = appendString(m_strings, object.catalogIdentifier());
+
+        const CatalogObject::oid id = object.getObjectId();
+        entry.idOffset = m_ids.size();
+        entry.idSize   = std::min<int>(id.size(), std::numeric_limits<quint8>::max());
+        m_ids.append(id.constData(), entry.idSize);
+
+        m_entries.push_back(entry);
+    }
+
+    m_strings.squeeze();
+    m_ids.squeeze();
+}
+
+CatalogObject PackedCatalogObjects::object(std::size_t index, const QString &database_path) const
+{
+    const Entry &entry = m_entries[index];
+
+    int offset = entry.strings;
+    const QString name = m_strings.mid(offset, entry.nameSize);
+    offset += entry.nameSize;
+    const QString longName = m_strings.mid(offset, entry.longNameSize);
+    offset += entry.longNameSize;
+    const QString catalogIdentifier = m_strings.mid(offset, entry.catalogIdentifierSize);
+
+    return CatalogObject(m_ids.mid(entry.idOffset, entry.idSize), static_cast<SkyObject::TYPE>(entry.type),
+                         dms(entry.ra), dms(entry.dec), entry.mag, name, longName, catalogIdentifier,
+                         entry.catalogId, entry.a, entry.b, entry.pa, entry.flux, database_path);
+}
@@ -0,0 +1,90 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "catalogobject.h"
+
+#include <QByteArray>
+#include <QString>
+#include <vector>
+
+/**
+ * @class PackedCatalogObjects
+ * The objects of one trixel in a compact form, as kept by the DSO caches.
+ *
+ * A CatalogObject carries a full SkyPoint, an image and several separately allocated
+ * strings. Here every object is a plain Entry with its catalog data, and the names and ids
+ * of all objects share one buffer each. The fields that decide whether an object is drawn
+ * are read from the entries directly, full objects are created with object() only for the
+ * objects that are actually drawn, labeled or selected.
+ */
+class PackedCatalogObjects
+{
+    public:
+        struct Entry
+        {
+            /// J2000 coordinates in degrees
+            double ra;
+            double dec;
+            /// NaN if unknown
+            float mag;
+            float a;
+            float b;
+            float pa;
+            float flux;
+            qint32 catalogId;
+            /// Offset of the name in the string buffer, the long name and the catalog
+            /// identifier follow it
+            quint32 strings;
+            quint32 idOffset;
+            quint16 nameSize;
+            /// Zero if the long name is the default one, see SkyObject::setLongName()
+            quint16 longNameSize;
+            quint16 catalogIdentifierSize;
+            quint8 idSize;
+            quint8 type;
+        };
+
+        PackedCatalogObjects() = default;
+
+        /** @short Pack the @p objects, in the same order. */
+        explicit PackedCatalogObjects(const std::vector<CatalogObject> &objects);
+
+        std::size_t size() const
+        {
+            return m_entries.size();
+        }
+
+        const Entry &operator[](std::size_t index) const
+        {
+            return m_entries[index];
+        }
+
+        /** The entries, to filter them with QtConcurrent::blockingMap. */
+        std::vector<Entry> &entries()
+        {
+            return m_entries;
+        }
+
+        /**
+         * @return a full CatalogObject for the entry at @p index
+         * @param database_path the database of the object, has to outlive it
+         */
+        CatalogObject object(std::size_t index, const QString &database_path) const;
+
+        void swap(PackedCatalogObjects &other) noexcept
+        {
+            m_entries.swap(other.m_entries);
+            m_strings.swap(other.m_strings);
+            m_ids.swap(other.m_ids);
+        }
+
+    private:
+        std::vector<Entry> m_entries;
+        QString m_strings;
+        QByteArray m_ids;
+};
@@ -6,17 +6,20 @@
 
 #include "satellite.h"
 
+#include "geolocation.h"
 #include "ksplanetbase.h"
 #ifndef KSTARS_LITE
 #include "kspopupmenu.h"
 #endif
 #include "kstarsdata.h"
+#include "kstarsdatetime.h"
 #include "kssun.h"
 #include "Options.h"
 #include "skymapcomposite.h"
 
 #include <QDebug>
 
+#include <algorithm>
 #include <cmath>
 #include <typeinfo>
 
@@ -703,16 +706,78 @@ void Satellite::init()
     }
 }
 
+Satellite::Environment Satellite::environment()
+{
+    KStarsData *data  = KStarsData::Instance();
+    Environment env   = environment(data->clock()->utc().djd(), data->geo());
+    env.lst           = *data->lst();
+
+    KSSun *sun  = dynamic_cast<KSSun *>(data->skyComposite()->findByName(i18n("Sun")));
+    env.sunDown = sun != nullptr && sun->alt().Degrees() <= -12.0;
+
+    return env;
+}
+
+Satellite::Environment Satellite::environment(double jd, const GeoLocation *geo)
+{
+    Environment env;
+
+    env.jd        = jd;
+    env.latitude  = geo->lat()->Degrees();
+    env.longitude = geo->lng()->Degrees();
+    env.sinLat    = sin(geo->lat()->radians());
+    env.cosLat    = cos(geo->lat()->radians());
+    env.theta     = geo->LMST(jd);
+    env.lst       = geo->GSTtoLST(KStarsDateTime(static_cast<long double>(jd)).gst());
+    env.lat       = *geo->lat();
+
+    // Find ECI coordinates of the sun
+    double mjd, year, T, M, L, e, C, O, Lsa, nu, R, eps;
+
+    mjd  = env.jd - 2415020.0;
+    year = 1900.0 + mjd / 365.25;
+    T    = (mjd + deltaET(year) / (MINPD * 60.0)) / 36525.0;
+    M    = DEG2RAD * (Modulus(358.47583 + Modulus(35999.04975 * T, 360.0) - (0.000150 + 0.0000033 * T) * T * T, 360.0));
+    L    = DEG2RAD * (Modulus(279.69668 + Modulus(36000.76892 * T, 360.0) + 0.0003025 * T * T, 360.0));
+    e    = 0.01675104 - (0.0000418 + 0.000000126 * T) * T;
+    C    = DEG2RAD * ((1.919460 - (0.004789 + 0.000014 * T) * T) * sin(M) + (0.020094 - 0.000100 * T) * sin(2 * M) +
+                      0.000293 * sin(3 * M));
+    O    = DEG2RAD * (Modulus(259.18 - 1934.142 * T, 360.0));
+    Lsa  = Modulus(L + C - DEG2RAD * (0.00569 - 0.00479 * sin(O)), TWOPI);
+    nu   = Modulus(M + C, TWOPI);
+    R    = 1.0000002 * (1.0 - e * e) / (1.0 + e * cos(nu));
+    eps  = DEG2RAD * (23.452294 - (0.0130125 + (0.00000164 - 0.000000503 * T) * T) * T + 0.00256 * cos(O));
+    R    = AU * R;
+
+    env.sun[0] = R * cos(Lsa);
+    env.sun[1] = R * sin(Lsa) * cos(eps);
+    env.sun[2] = R * sin(Lsa) * sin(eps);
+
+    const double zenith = env.cosLat * cos(env.theta) * env.sun[0] + env.cosLat * sin(env.theta) * env.sun[1] +
+                          env.sinLat * env.sun[2];
+    env.sunDown = arcSin(zenith / R) <= -12.0 * DEG2RAD;
+
+    return env;
+}
+
 int Satellite::updatePos()
 {
-    KStarsData *data = KStarsData::Instance();
-    return sgp4((data->clock()->utc().djd() - m_tle_jd) * MINPD);
+    return updatePos(environment());
 }
 
-int Satellite::sgp4(double tsince)
+int Satellite::updatePos(const Environment &env)
 {
-    KStarsData *data = KStarsData::Instance();
+    // A satellite found well below the horizon cannot rise before m_skip_minutes have passed,
+    // in either direction of time, as long as the observer stays the same
+    if (env.skipBelowHorizon && m_skip_minutes > 0 && fabs(env.jd - m_pos_jd) * MINPD < m_skip_minutes &&
+            env.latitude == m_pos_latitude && env.longitude == m_pos_longitude)
+        return 0;
 
+    return sgp4((env.jd - m_tle_jd) * MINPD, env);
+}
+
+int Satellite::sgp4(double tsince, const Environment &env)
+{
     int ktr;
     double am, axnl, aynl, betal, cosim, cnod, cos2u, coseo1 = 0, cosi, cosip, cosisq, cossu, cosu, delm, delomg, em,
                                                       ecose, el2, eo1, ep, esine, argpm, argpp, argpdf, pl,
@@ -725,8 +790,6 @@ int Satellite::sgp4(double tsince)
 
     const double temp4 = 1.5e-12;
 
-    double jul_utc = data->clock()->utc().djd();
-
     vkmpersec = RADIUSEARTHKM * XKE / 60.0;
 
     // Update for secular gravity and atmospheric drag
@@ -1136,9 +1199,9 @@ int Satellite::sgp4(double tsince)
     }
 
     // Observer ECI position and velocity
-    sinlat   = sin(data->geo()->lat()->radians());
-    coslat   = cos(data->geo()->lat()->radians());
-    thetageo = data->geo()->LMST(jul_utc);
+    sinlat   = env.sinLat;
+    coslat   = env.cosLat;
+    thetageo = env.theta;
     sintheta = sin(thetageo);
     costheta = cos(thetageo);
     c        = 1.0 / sqrt(1.0 + F * (F - 2.0) * sinlat * sinlat);
@@ -1179,31 +1242,34 @@ int Satellite::sgp4(double tsince)
 
     setAz(azimuth / DEG2RAD);
     setAlt(elevation / DEG2RAD);
-    HorizontalToEquatorial(data->lst(), data->geo()->lat());
+    HorizontalToEquatorial(&env.lst, &env.lat);
+
+    // Until when the satellite cannot rise: it is above the horizon only within the angle
+    // acos(RADIUSEARTHKM / r) from the observer, seen from the center of the Earth, and its
+    // direction moves at most at its angular velocity at perigee plus the rotation of the Earth
+    m_pos_jd        = env.jd;
+    m_pos_latitude  = env.latitude;
+    m_pos_longitude = env.longitude;
+    m_skip_minutes  = 0;
+    if (env.skipBelowHorizon && elevation < 0.0)
+    {
+        const double obs_norm = sqrt(obs_posx * obs_posx + obs_posy * obs_posy + obs_posz * obs_posz);
+        const double cos_gamma =
+            (obs_posx * sat_posx + obs_posy * sat_posy + obs_posz * sat_posz) / (obs_norm * sat_posw);
+        const double gamma   = acos(std::max(-1.0, std::min(1.0, cos_gamma)));
+        const double apogee  = am * (1.0 + ep) * RADIUSEARTHKM;
+        const double reach   = apogee > RADIUSEARTHKM ? acos(RADIUSEARTHKM / apogee) : 0.0;
+        const double max_rate = nm * (1.0 + ep) * (1.0 + ep) / pow(1.0 - ep * ep, 1.5) + MFACTOR * 60.0;
+        const double margin  = 2.0 * DEG2RAD;
+
+        m_skip_minutes = std::min(MAX_SKIP_MINUTES, (gamma - reach - margin) / max_rate);
+    }
 
     // is the satellite visible ?
-    // Find ECI coordinates of the sun
-    double mjd, year, T, M, L, e, C, O, Lsa, nu, R, eps;
-
-    mjd  = jul_utc - 2415020.0;
-    year = 1900.0 + mjd / 365.25;
-    T    = (mjd + deltaET(year) / (MINPD * 60.0)) / 36525.0;
-    M    = DEG2RAD * (Modulus(358.47583 + Modulus(35999.04975 * T, 360.0) - (0.000150 + 0.0000033 * T) * T * T, 360.0));
-    L    = DEG2RAD * (Modulus(279.69668 + Modulus(36000.76892 * T, 360.0) + 0.0003025 * T * T, 360.0));
-    e    = 0.01675104 - (0.0000418 + 0.000000126 * T) * T;
-    C    = DEG2RAD * ((1.919460 - (0.004789 + 0.000014 * T) * T) * sin(M) + (0.020094 - 0.000100 * T) * sin(2 * M) +
-                      0.000293 * sin(3 * M));
-    O    = DEG2RAD * (Modulus(259.18 - 1934.142 * T, 360.0));
-    Lsa  = Modulus(L + C - DEG2RAD * (0.00569 - 0.00479 * sin(O)), TWOPI);
-    nu   = Modulus(M + C, TWOPI);
-    R    = 1.0000002 * (1.0 - e * e) / (1.0 + e * cos(nu));
-    eps  = DEG2RAD * (23.452294 - (0.0130125 + (0.00000164 - 0.000000503 * T) * T) * T + 0.00256 * cos(O));
-    R    = AU * R;
-
-    double sun_posx = R * cos(Lsa);
-    double sun_posy = R * sin(Lsa) * cos(eps);
-    double sun_posz = R * sin(Lsa) * sin(eps);
-    double sun_posw = R;
+    double sun_posx = env.sun[0];
+    double sun_posy = env.sun[1];
+    double sun_posz = env.sun[2];
+    double sun_posw = sqrt(sun_posx * sun_posx + sun_posy * sun_posy + sun_posz * sun_posz);
 
     // Calculates satellite's eclipse status and depth
     double sd_sun, sd_earth, delta, depth;
@@ -1221,10 +1287,9 @@ int Satellite::sgp4(double tsince)
     double earth_w = sat_posw;
     delta      = PIO2 - arcSin((sun_posx * earth_x + sun_posy * earth_y + sun_posz * earth_z) / (sun_posw * earth_w));
     depth      = sd_earth - sd_sun - delta;
-    KSSun *sun = dynamic_cast<KSSun *>(data->skyComposite()->findByName(i18n("Sun")));
 
     m_is_eclipsed = sd_earth >= sd_sun && depth >= 0;
-    m_is_visible  = !m_is_eclipsed && sun->alt().Degrees() <= -12.0 && elevation >= 0.0;
+    m_is_visible  = !m_is_eclipsed && env.sunDown && elevation >= 0.0;
 
     return (0);
 }
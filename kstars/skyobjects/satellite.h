@@ -10,6 +10,7 @@
 
 #include <QString>
 
+class GeoLocation;
 class KSPopupMenu;
 
 /**
@@ -34,9 +35,72 @@ class Satellite : public SkyObject
         /** @short Destructor */
         virtual ~Satellite() override = default;
 
+        /**
+         * @struct Environment
+         * The quantities that are the same for all satellites at one time: the observer and
+         * the Sun. Computing them once lets many satellites be updated together, also from
+         * several threads.
+         */
+        struct Environment
+        {
+            /// UTC Julian day
+            double jd { 0 };
+            /// Observer latitude and longitude, in degrees
+            double latitude { 0 };
+            double longitude { 0 };
+            double sinLat { 0 };
+            double cosLat { 0 };
+            /// Local mean sidereal time, in radians
+            double theta { 0 };
+            dms lst;
+            dms lat;
+            /// ECI coordinates of the Sun, in km
+            double sun[3] { 0, 0, 0 };
+            /// True if the Sun is at least 12° under the horizon
+            bool sunDown { false };
+            /// If satellites well below the horizon may keep their position until they can rise
+            bool skipBelowHorizon { false };
+        };
+
+        /** @return the environment at the current time and location of KStarsData */
+        static Environment environment();
+
+        /**
+         * @return the environment at the UTC Julian day @p jd seen from @p geo. The altitude
+         * of the Sun is found from its ECI coordinates, without refraction.
+         */
+        static Environment environment(double jd, const GeoLocation *geo);
+
         /** @short Update satellite position */
         int updatePos();
 
+        /**
+         * @short Update satellite position in the given environment
+         *
+         * If env.skipBelowHorizon is set, a satellite that was found well below the horizon
+         * is not propagated again until it could have risen, at most for MAX_SKIP_MINUTES.
+         * This function can be called for different satellites from several threads.
+         */
+        int updatePos(const Environment &env);
+
+        /// Longest time a satellite below the horizon is not propagated, in minutes
+        static constexpr double MAX_SKIP_MINUTES = 10.0;
+
+        /**
+         * @return the minutes after the last update during which the satellite cannot rise,
+         * zero if it is above the horizon or the update did not set env.skipBelowHorizon
+         */
+        double minutesBeforeRise() const
+        {
+            return m_skip_minutes;
+        }
+
+        /** @return True if the satellite is in the shadow of the Earth */
+        bool isEclipsed() const
+        {
+            return m_is_eclipsed;
+        }
+
         /**
          * @return True if the satellite is visible (above horizon, in the sunlight and sun at least 12° under horizon)
          */
@@ -77,10 +141,10 @@ class Satellite : public SkyObject
         void init();
 
         /** @short Compute satellite position */
-        int sgp4(double tsince);
+        int sgp4(double tsince, const Environment &env);
 
         /** @return Arcsine of the argument */
-        double arcSin(double arg);
+        static double arcSin(double arg);
 
         /**
          * Provides the difference between UT (approximately the same as UTC)
@@ -88,10 +152,10 @@ class Satellite : public SkyObject
          * This function is based on a least squares fit of data from 1950
          * to 1991 and will need to be updated periodically.
          */
-        double deltaET(double year);
+        static double deltaET(double year);
 
         /** @return arg1 mod arg2 */
-        double Modulus(double arg1, double arg2);
+        static double Modulus(double arg1, double arg2);
 
         // TLE
         /// Satellite Number
@@ -146,6 +210,12 @@ class Satellite : public SkyObject
         double m_altitude { 0 };
         /// Satellite range from observer in km
         double m_range { 0 };
+        /// Julian day and observer of the last propagation
+        double m_pos_jd { 0 };
+        double m_pos_latitude { 0 };
+        double m_pos_longitude { 0 };
+        /// Minutes from m_pos_jd during which the satellite cannot rise
+        double m_skip_minutes { 0 };
 
         // Near Earth
         bool isimp { false };
@@ -9,9 +9,12 @@
 #include "ksutils.h"
 #include "kspaths.h"
 #include "skyobjects/satellite.h"
+#include "auxiliary/executors.h"
 
 #include <QTextStream>
 
+#include <vector>
+
 SatelliteGroup::SatelliteGroup(const QString& name, const QString& tle_filename, const QUrl& update_url)
 {
     m_name     = name;
@@ -51,19 +54,35 @@ void SatelliteGroup::readTLE()
 
 void SatelliteGroup::updateSatellitesPos()
 {
-    QMutableListIterator<Satellite *> sats(*this);
+    updateSatellitesPos(Satellite::environment());
+}
 
-    while (sats.hasNext())
+void SatelliteGroup::updateSatellitesPos(const Satellite::Environment &env)
+{
+    struct Update
     {
-        Satellite *sat = sats.next();
+        Satellite *sat;
+        int rc;
+    };
 
+    std::vector<Update> updates;
+    for (Satellite *sat : *this)
+    {
         if (sat->selected())
-        {
-            int rc = sat->updatePos();
-            // If position cannot be calculated, remove it from list
-            if (rc != 0)
-                sats.remove();
-        }
+            updates.push_back({ sat, 0 });
+    }
+
+    // The satellites only share the environment, so they are propagated in parallel
+    Executors::blockingMap(Executors::Interactive, updates, [&env](Update & update)
+    {
+        update.rc = update.sat->updatePos(env);
+    });
+
+    // If position cannot be calculated, remove it from list
+    for (const Update &update : updates)
+    {
+        if (update.rc != 0)
+            removeOne(update.sat);
     }
 }
 
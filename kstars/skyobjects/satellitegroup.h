@@ -6,11 +6,11 @@
 
 #pragma once
 
+#include "skyobjects/satellite.h"
+
 #include <QString>
 #include <QUrl>
 
-class Satellite;
-
 /**
  * @class SatelliteGroup
  * Represents a group of artificial satellites.
@@ -37,6 +37,12 @@ class SatelliteGroup : public QList<Satellite *>
      */
     void updateSatellitesPos();
 
+    /**
+     * Compute the position of the selected satellites of the group in the given environment,
+     * in parallel.
+     */
+    void updateSatellitesPos(const Satellite::Environment &env);
+
     /**
      * @return TLE filename
      */
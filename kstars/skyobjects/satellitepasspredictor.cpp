@@ -0,0 +1,427 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "satellitepasspredictor.h"
+
+#include "satellite.h"
+#include "skypoint.h"
+#include "auxiliary/executors.h"
+
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+constexpr double SECOND = 1.0 / 86400.0;
+/// Sampling of the tracks above the horizon
+constexpr double COARSE_STEP = 30 * SECOND;
+/// Accuracy of rise, culmination, set, sunlit limits and crossings
+constexpr double RESOLUTION = SECOND;
+/// Length of the buckets of the time index
+constexpr double BUCKET_DAYS = 10.0 / 1440.0;
+
+void unitVector(const SkyPoint &p, double *xyz)
+{
+    double sinRA, cosRA, sinDec, cosDec;
+    p.ra().SinCos(sinRA, cosRA);
+    p.dec().SinCos(sinDec, cosDec);
+    xyz[0] = cosDec * cosRA;
+    xyz[1] = cosDec * sinRA;
+    xyz[2] = sinDec;
+}
+
+/// Angle between two unit vectors, in degrees
+template <typename A, typename B>
+double separation(const A *a, const B *b)
+{
+    const double dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    return std::acos(std::max(-1.0, std::min(1.0, dot))) * 180.0 / M_PI;
+}
+}
+
+struct SatellitePassPredictor::State
+{
+    bool valid { false };
+    double altitude { 0 };
+    bool eclipsed { false };
+    double minutesBeforeRise { 0 };
+    double xyz[3] { 0, 0, 0 };
+
+    bool up() const
+    {
+        return altitude >= 0;
+    }
+};
+
+SatellitePassPredictor::SatellitePassPredictor(const GeoLocation &geo) : m_Geo(geo)
+{
+}
+
+SatellitePassPredictor::~SatellitePassPredictor() = default;
+
+SatellitePassPredictor::State SatellitePassPredictor::propagate(Satellite *satellite, double jd,
+        bool skipBelowHorizon) const
+{
+    Satellite::Environment env = Satellite::environment(jd, &m_Geo);
+    env.skipBelowHorizon       = skipBelowHorizon;
+
+    State state;
+    state.valid = satellite->updatePos(env) == 0;
+    if (state.valid)
+    {
+        state.altitude          = satellite->alt().Degrees();
+        state.eclipsed          = satellite->isEclipsed();
+        state.minutesBeforeRise = satellite->minutesBeforeRise();
+        unitVector(*satellite, state.xyz);
+    }
+    return state;
+}
+
+template <typename Test>
+double SatellitePassPredictor::bisect(Satellite *satellite, double a, double b, Test test) const
+{
+    const bool atA = test(propagate(satellite, a, false));
+    while (b - a > RESOLUTION)
+    {
+        const double mid = (a + b) / 2;
+        if (test(propagate(satellite, mid, false)) == atA)
+            a = mid;
+        else
+            b = mid;
+    }
+    return (a + b) / 2;
+}
+
+void SatellitePassPredictor::compute(const QList<Satellite *> &satellites, double startJD, double stopJD)
+{
+    m_StartJD = startJD;
+    m_StopJD  = std::max(startJD, stopJD);
+    m_Bodies.clear();
+    m_Passes.clear();
+    m_Tracks.clear();
+    m_Buckets.clear();
+
+    for (Satellite *satellite : satellites)
+    {
+        auto body       = std::make_unique<Body>();
+        body->satellite = std::unique_ptr<Satellite>(satellite->clone());
+        m_Bodies.push_back(std::move(body));
+    }
+
+    struct Result
+    {
+        int body;
+        QVector<Pass> passes;
+        std::vector<Track> tracks;
+    };
+
+    std::vector<Result> results(m_Bodies.size());
+    for (std::size_t i = 0; i < results.size(); ++i)
+        results[i].body = i;
+
+    Executors::blockingMap(Executors::Interactive, results, [this](Result & result)
+    {
+        scan(result.body, result.passes, result.tracks);
+    });
+
+    // Merge, ordered by rise
+    std::vector<std::pair<double, std::pair<int, int>>> order;
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        for (int k = 0; k < results[i].passes.size(); ++k)
+            order.push_back({ results[i].passes[k].riseJD, { int(i), k } });
+    }
+    std::sort(order.begin(), order.end());
+
+    m_Passes.reserve(order.size());
+    m_Tracks.reserve(order.size());
+    for (const auto &entry : order)
+    {
+        Result &result = results[entry.second.first];
+        m_Passes.append(result.passes[entry.second.second]);
+        m_Tracks.push_back(std::move(result.tracks[entry.second.second]));
+    }
+
+    // Index the passes by time
+    m_Buckets.resize(std::size_t((m_StopJD - m_StartJD) / BUCKET_DAYS) + 1);
+    for (int i = 0; i < m_Passes.size(); ++i)
+    {
+        const std::size_t first = (m_Passes[i].riseJD - m_StartJD) / BUCKET_DAYS;
+        const std::size_t last  = std::min<std::size_t>((m_Passes[i].setJD - m_StartJD) / BUCKET_DAYS,
+                                  m_Buckets.size() - 1);
+        for (std::size_t b = first; b <= last; ++b)
+            m_Buckets[b].append(i);
+    }
+}
+
+void SatellitePassPredictor::scan(int body, QVector<Pass> &passes, std::vector<Track> &tracks) const
+{
+    Satellite *satellite = m_Bodies[body]->satellite.get();
+
+    Pass pass;
+    Track track { body, {} };
+    double bestAltitude = -90;
+    double bestJD       = 0;
+    double sunlitStart  = 0;
+
+    auto sample = [&](double jd, const State & state)
+    {
+        track.samples.push_back({ jd, float(state.xyz[0]), float(state.xyz[1]), float(state.xyz[2]) });
+        if (state.altitude > bestAltitude)
+        {
+            bestAltitude = state.altitude;
+            bestJD       = jd;
+        }
+    };
+
+    auto rise = [&](double jd, const State & state)
+    {
+        pass         = Pass();
+        pass.name    = satellite->name();
+        pass.riseJD  = jd;
+        track        = Track { body, {} };
+        bestAltitude = -90;
+        sample(jd, state);
+        sunlitStart = jd;
+    };
+
+    auto set = [&](double jd, bool eclipsed)
+    {
+        pass.setJD = jd;
+        if (!eclipsed)
+            pass.sunlit.append({ sunlitStart, jd });
+
+        // The highest sample is within a step of the culmination
+        double a = std::max(pass.riseJD, bestJD - COARSE_STEP);
+        double b = std::min(pass.setJD, bestJD + COARSE_STEP);
+        while (b - a > RESOLUTION)
+        {
+            const double m1 = a + (b - a) / 3;
+            const double m2 = b - (b - a) / 3;
+            if (propagate(satellite, m1, false).altitude < propagate(satellite, m2, false).altitude)
+                a = m1;
+            else
+                b = m2;
+        }
+        pass.culminationJD = (a + b) / 2;
+        pass.maxAltitude   = std::max(bestAltitude, propagate(satellite, pass.culminationJD, false).altitude);
+
+        passes.append(pass);
+        tracks.push_back(std::move(track));
+    };
+
+    // The limits of the sunlit parts while the satellite is up, one per step at most
+    auto advance = [&](double t0, const State & s0, double t1, const State & s1)
+    {
+        if (s0.eclipsed == s1.eclipsed)
+            return;
+
+        const double t = bisect(satellite, t0, t1, [](const State & s)
+        {
+            return s.eclipsed;
+        });
+        if (s1.eclipsed)
+            pass.sunlit.append({ sunlitStart, t });
+        else
+            sunlitStart = t;
+    };
+
+    double jd   = m_StartJD;
+    State state = propagate(satellite, jd, true);
+    if (!state.valid)
+        return;
+    if (state.up())
+        rise(jd, state);
+
+    while (jd < m_StopJD)
+    {
+        // Below the horizon, step as far as the satellite cannot rise
+        double step = COARSE_STEP;
+        if (!state.up())
+            step = std::max(step, state.minutesBeforeRise / 1440.0 + RESOLUTION);
+
+        const double next = std::min(jd + step, m_StopJD);
+        const State now   = propagate(satellite, next, true);
+        if (!now.valid)
+        {
+            // The satellite decayed, close the pass it is in
+            if (state.up())
+                set(jd, state.eclipsed);
+            return;
+        }
+
+        if (!state.up() && now.up())
+        {
+            const double t = bisect(satellite, jd, next, [](const State & s)
+            {
+                return s.up();
+            });
+            const State atRise = propagate(satellite, t, false);
+            rise(t, atRise);
+            advance(t, atRise, next, now);
+            sample(next, now);
+        }
+        else if (state.up() && !now.up())
+        {
+            const double t = bisect(satellite, jd, next, [](const State & s)
+            {
+                return s.up();
+            });
+            const State atSet = propagate(satellite, t, false);
+            advance(jd, state, t, atSet);
+            sample(t, atSet);
+            set(t, atSet.eclipsed);
+        }
+        else if (now.up())
+        {
+            advance(jd, state, next, now);
+            sample(next, now);
+        }
+
+        jd    = next;
+        state = now;
+    }
+
+    // Still up at the end of the range
+    if (state.up())
+        set(m_StopJD, state.eclipsed);
+}
+
+QVector<int> SatellitePassPredictor::passesBetween(double startJD, double stopJD) const
+{
+    QVector<int> found;
+    if (m_Buckets.empty() || stopJD < m_StartJD || startJD > m_StopJD)
+        return found;
+
+    const std::size_t first = std::max(0.0, startJD - m_StartJD) / BUCKET_DAYS;
+    const std::size_t last  = std::min<std::size_t>((std::min(stopJD, m_StopJD) - m_StartJD) / BUCKET_DAYS,
+                              m_Buckets.size() - 1);
+    for (std::size_t b = first; b <= last; ++b)
+    {
+        for (int i : m_Buckets[b])
+        {
+            if (m_Passes[i].riseJD <= stopJD && m_Passes[i].setJD >= startJD)
+                found.append(i);
+        }
+    }
+
+    std::sort(found.begin(), found.end());
+    found.erase(std::unique(found.begin(), found.end()), found.end());
+    return found;
+}
+
+QVector<SatellitePassPredictor::Crossing> SatellitePassPredictor::crossings(const SkyPoint &center, double radius,
+        double startJD, double stopJD) const
+{
+    QVector<Crossing> found;
+    double c[3];
+    unitVector(center, c);
+
+    for (int i : passesBetween(startJD, stopJD))
+    {
+        const std::vector<Sample> &samples = m_Tracks[i].samples;
+
+        // Any point of the track between two samples is within half the length of the track
+        // from one of them. The length is taken as somewhat more than the angle between them.
+        double a = -1, b = -1;
+        for (std::size_t k = 0; k + 1 < samples.size(); ++k)
+        {
+            const Sample &s0 = samples[k];
+            const Sample &s1 = samples[k + 1];
+            if (s1.jd < startJD || s0.jd > stopJD)
+                continue;
+
+            const float p0[3] = { s0.x, s0.y, s0.z };
+            const float p1[3] = { s1.x, s1.y, s1.z };
+            const double reach = radius + 0.75 * separation(p0, p1) + 0.5;
+            if (separation(c, p0) > reach && separation(c, p1) > reach)
+                continue;
+
+            // Refine consecutive candidate segments together
+            if (a >= 0 && s0.jd <= b)
+            {
+                b = s1.jd;
+                continue;
+            }
+            if (a >= 0)
+                refine(i, c, radius, std::max(a, startJD), std::min(b, stopJD), found);
+            a = s0.jd;
+            b = s1.jd;
+        }
+        if (a >= 0)
+            refine(i, c, radius, std::max(a, startJD), std::min(b, stopJD), found);
+    }
+
+    std::sort(found.begin(), found.end(), [](const Crossing & x, const Crossing & y)
+    {
+        return x.entryJD < y.entryJD;
+    });
+    return found;
+}
+
+void SatellitePassPredictor::refine(int pass, const double *center, double radius, double a, double b,
+                                    QVector<Crossing> &crossings) const
+{
+    Body &body = *m_Bodies[m_Tracks[pass].body];
+    QMutexLocker lock(&body.mutex);
+    Satellite *satellite = body.satellite.get();
+
+    auto inside = [&](const State & s)
+    {
+        return s.valid && separation(center, s.xyz) <= radius;
+    };
+
+    // Steps of at most half the radius along the track
+    State prev                = propagate(satellite, a, false);
+    const double length       = separation(prev.xyz, propagate(satellite, b, false).xyz);
+    const int count           = std::max(8, int(std::ceil(2.0 * length / std::max(radius, 0.01))));
+    const double step         = (b - a) / count;
+    const QVector<Window> &lit = m_Passes[pass].sunlit;
+
+    Crossing crossing;
+    crossing.pass = pass;
+    bool in       = inside(prev);
+    double best   = prev.valid ? separation(center, prev.xyz) : 180;
+    if (in)
+        crossing.entryJD = a;
+
+    auto close = [&](double exitJD)
+    {
+        crossing.exitJD        = exitJD;
+        crossing.minSeparation = best;
+        crossing.sunlit        = std::any_of(lit.begin(), lit.end(), [&](const Window & w)
+        {
+            return w.startJD <= crossing.exitJD && w.stopJD >= crossing.entryJD;
+        });
+        crossings.append(crossing);
+    };
+
+    for (int k = 1; k <= count; ++k)
+    {
+        const double t   = a + k * step;
+        const State now  = propagate(satellite, t, false);
+        const bool isIn  = inside(now);
+        if (now.valid && isIn)
+            best = std::min(best, separation(center, now.xyz));
+
+        if (!in && isIn)
+        {
+            crossing.entryJD = bisect(satellite, t - step, t, inside);
+            best             = std::min(best, separation(center, now.xyz));
+        }
+        else if (in && !isIn)
+        {
+            close(bisect(satellite, t - step, t, inside));
+            best = 180;
+        }
+        in = isIn;
+    }
+
+    if (in)
+        close(b);
+}
@@ -0,0 +1,140 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include "geolocation.h"
+
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+#include <memory>
+#include <vector>
+
+class Satellite;
+class SkyPoint;
+
+/**
+ * @class SatellitePassPredictor
+ * @short Predicts the passes of many satellites over a time range and finds the ones that
+ * cross a field of view.
+ *
+ * compute() propagates every satellite once over the range, typically a night, with the SGP4
+ * code of Satellite. Below the horizon it steps as far as the satellite cannot rise, above it
+ * samples the track every 30 seconds. Rise, culmination, set and the limits of the sunlit
+ * parts are refined to a second. The passes are indexed by time, so that crossings() only
+ * looks at the passes that overlap the capture window, and only propagates the satellites
+ * again whose sampled track comes close to the field.
+ *
+ * Coordinates are those of the date, like SkyPoint::ra() and SkyPoint::dec() after
+ * SkyPoint::updateCoords(). Times are UTC Julian days.
+ */
+class SatellitePassPredictor
+{
+    public:
+        struct Window
+        {
+            double startJD { 0 };
+            double stopJD { 0 };
+        };
+
+        struct Pass
+        {
+            QString name;
+            /// The start of the range if the satellite is already up
+            double riseJD { 0 };
+            double culminationJD { 0 };
+            /// The end of the range if the satellite is still up
+            double setJD { 0 };
+            /// Altitude at culmination, in degrees
+            double maxAltitude { 0 };
+            /// The parts of the pass where the satellite is out of the shadow of the Earth
+            QVector<Window> sunlit;
+        };
+
+        struct Crossing
+        {
+            /// Index of the pass in passes()
+            int pass { -1 };
+            double entryJD { 0 };
+            double exitJD { 0 };
+            /// Smallest distance to the center of the field, in degrees
+            double minSeparation { 0 };
+            /// True if the satellite is sunlit during a part of the crossing
+            bool sunlit { false };
+        };
+
+        /** @param geo location of the observer, which is copied */
+        explicit SatellitePassPredictor(const GeoLocation &geo);
+        ~SatellitePassPredictor();
+
+        /**
+         * @short Predict the passes of @p satellites between @p startJD and @p stopJD.
+         *
+         * The satellites are copied and propagated in parallel. Earlier predictions are dropped.
+         */
+        void compute(const QList<Satellite *> &satellites, double startJD, double stopJD);
+
+        /** @return all passes, ordered by rise */
+        const QVector<Pass> &passes() const
+        {
+            return m_Passes;
+        }
+
+        /** @return the indexes of the passes that overlap the given window, ordered by rise */
+        QVector<int> passesBetween(double startJD, double stopJD) const;
+
+        /**
+         * @return the satellites that come within @p radius degrees of @p center between
+         * @p startJD and @p stopJD, ordered by entry. Thread safe.
+         */
+        QVector<Crossing> crossings(const SkyPoint &center, double radius, double startJD, double stopJD) const;
+
+    private:
+        struct State;
+        struct Sample
+        {
+            double jd;
+            /// Unit vector to the satellite
+            float x, y, z;
+        };
+        struct Body
+        {
+            std::unique_ptr<Satellite> satellite;
+            /// Propagation changes the state of the satellite
+            QMutex mutex;
+        };
+        struct Track
+        {
+            int body;
+            std::vector<Sample> samples;
+        };
+
+        State propagate(Satellite *satellite, double jd, bool skipBelowHorizon) const;
+
+        /** @short Scan one satellite, appending its passes and their tracks */
+        void scan(int body, QVector<Pass> &passes, std::vector<Track> &tracks) const;
+
+        /** @return the time between @p a and @p b where @p test changes, within RESOLUTION */
+        template <typename Test>
+        double bisect(Satellite *satellite, double a, double b, Test test) const;
+
+        /** @short Find where the track of @p pass is within @p radius of @p center, in [a, b] */
+        void refine(int pass, const double *center, double radius, double a, double b,
+                    QVector<Crossing> &crossings) const;
+
+        GeoLocation m_Geo;
+        double m_StartJD { 0 };
+        double m_StopJD { 0 };
+
+        std::vector<std::unique_ptr<Body>> m_Bodies;
+        QVector<Pass> m_Passes;
+        std::vector<Track> m_Tracks;
+        /// The passes that overlap every BUCKET_DAYS from m_StartJD
+        std::vector<QVector<int>> m_Buckets;
+};
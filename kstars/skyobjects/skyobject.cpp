@@ -16,6 +16,7 @@
 #include "skymap.h"
 #endif
 #include "kstarsdata.h"
+#include "nametable.h"
 #include "Options.h"
 #include "starobject.h"
 #include "skycomponents/skylabeler.h"
@@ -90,6 +91,14 @@ void SkyObject::setLongName(const QString &longname)
     }
 }
 
+void SkyObject::shareNames()
+{
+    NameTable &names = NameTable::instance();
+    names.intern(Name, &Name);
+    names.intern(Name2, &Name2);
+    names.intern(LongName, &LongName);
+}
+
 QTime SkyObject::riseSetTime(const KStarsDateTime &dt, const GeoLocation *geo, bool rst, bool exact) const
 {
     // If this object does not rise or set, return an invalid time
@@ -305,6 +305,13 @@ class SkyObject : public SkyPoint
 
     inline bool hasLongName() const { return !LongName.isEmpty(); }
 
+    /**
+     * @short Replace the names by the copies kept in the NameTable, so that the objects
+     * with the same names share one string.
+     * @note The names are interned, so this is only meant for long lived objects.
+     */
+    void shareNames();
+
     /**
      * @short Given the Image title from a URL file, try to convert it to an image credit string.
      */
@@ -707,6 +707,15 @@ void SkyPoint::apparentCoord(long double jd0, long double jdf)
     aberrate(&num);
 }
 
+void SkyPoint::apparentCoord(const KSNumbers *num)
+{
+    precess(num);
+    nutate(num);
+    if (Options::useRelativistic() && checkBendLight())
+        bendlight();
+    aberrate(num);
+}
+
 SkyPoint SkyPoint::catalogueCoord(long double jdf)
 {
     KSNumbers num(jdf);
@@ -395,6 +395,16 @@ class SkyPoint
          */
         void apparentCoord(long double jd0, long double jdf);
 
+        /**
+         * Computes the apparent coordinates for the epoch of @p num from the J2000
+         * coordinates. Gives the same result as apparentCoord(J2000, num->julianDay()),
+         * but uses the precession, nutation and aberration terms that are already in
+         * @p num instead of computing them twice.
+         *
+         * @param num pointer to KSNumbers object for the final epoch
+         */
+        void apparentCoord(const KSNumbers *num);
+
         /**
          * Computes the J2000.0 catalogue coordinates for this SkyPoint using the epoch
          * removing aberration, nutation and precession
@@ -767,6 +777,7 @@ class SkyPoint
          */
         void precess(const KSNumbers *num);
 
+        friend class ObservationContext; // Updates points in batches
 #ifdef UNIT_TEST
         friend class TestSkyPoint; // Test class
 #endif
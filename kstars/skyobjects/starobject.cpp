@@ -289,7 +289,7 @@ void StarObject::updateCoords(const KSNumbers *num, bool, const CachingDms *, co
 
 bool StarObject::getIndexCoords(const KSNumbers *num, CachingDms &ra, CachingDms &dec)
 {
-    static double pmms;
+    double pmms;
 
     // =================== NOTE: CODE DUPLICATION ====================
     // If you modify this, please also modify the other getIndexCoords
@@ -408,7 +408,7 @@ bool StarObject::getIndexCoords(const KSNumbers *num, CachingDms &ra, CachingDms
 
 bool StarObject::getIndexCoords(const KSNumbers *num, double *ra, double *dec)
 {
-    static double pmms;
+    double pmms;
 
     // =================== NOTE: CODE DUPLICATION ====================
     // If you modify this, please also modify the other getIndexCoords
@@ -105,6 +105,33 @@ class SkyPainter
          */
         virtual void drawSkyPolygon(LineList *list, bool forceClip = true) = 0;
 
+        /**
+         * @short Draw a polyline in the sky, keeping its screen geometry in the list.
+         * The default implementation ignores the cache and calls drawSkyPolyline().
+         * @param list a list of points in the sky
+         * @param cached if true, the geometry kept by the previous call is drawn again without
+         * projecting the points. Only valid if neither the view nor the points changed since.
+         * @param skipList a SkipList object used to control skipping line segments
+         * @param label a pointer to the label for this line
+         */
+        virtual void drawCachedSkyPolyline(LineList *list, bool cached, SkipHashList *skipList = nullptr,
+                                           LineListLabel *label = nullptr)
+        {
+            Q_UNUSED(cached)
+            drawSkyPolyline(list, skipList, label);
+        }
+
+        /**
+         * @short Draw a clipped polygon in the sky, keeping its screen geometry in the list.
+         * The default implementation ignores the cache and calls drawSkyPolygon().
+         * @see drawCachedSkyPolyline()
+         */
+        virtual void drawCachedSkyPolygon(LineList *list, bool cached)
+        {
+            Q_UNUSED(cached)
+            drawSkyPolygon(list);
+        }
+
         /**
          * @short Draw a comet in the sky.
          * @param com comet to draw
@@ -128,6 +155,32 @@ class SkyPainter
          */
         virtual bool drawPointSource(const SkyPoint *loc, float mag, char sp = 'A') = 0;
 
+        /**
+         * @short Draw a point source already projected to the screen, e.g. by Projector::toScreenBatch().
+         * The default implementation ignores the position and projects the source again.
+         * @param loc the location of the source in the sky
+         * @param pos the screen position of the source, which must be on the visible hemisphere
+         * @param mag the magnitude of the source
+         * @param sp the spectral class of the source
+         * @return true if a source was drawn
+         */
+        virtual bool drawProjectedPointSource(const SkyPoint *loc, const QPointF &pos, float mag, char sp = 'A')
+        {
+            Q_UNUSED(pos)
+            return drawPointSource(loc, mag, sp);
+        }
+
+        /**
+         * @short Start drawing a batch of point sources.
+         * The point sources drawn until endPointSources() may be queued by the painter and only
+         * drawn when the batch ends, so nothing else should be drawn in between.
+         * The default implementation does nothing.
+         */
+        virtual void beginPointSources() {}
+
+        /** @short Draw the batch of point sources started by beginPointSources(). */
+        virtual void endPointSources() {}
+
         /**
         * @short Draw a deep sky object (loaded from the new implementation)
         * @param obj the object to draw
@@ -206,6 +259,32 @@ class SkyPainter
          */
         virtual bool drawImageOverlay(const QList<ImageOverlay> *imageOverlays, bool useCache = false) = 0;
 
+        /** @short Number of objects drawn by this painter so far, used to profile the drawing. */
+        quint64 drawnObjects() const
+        {
+            return m_drawnObjects;
+        }
+
+        /**
+         * @short Whether components may skip the objects which are not loaded yet.
+         *
+         * The sky map sets this on its own painters: components can then load the missing
+         * objects in the background and draw them in a later frame. Exported images are
+         * drawn in one go and need every object, so it is off by default.
+         */
+        bool deferredLoading() const
+        {
+            return m_deferredLoading;
+        }
+        void setDeferredLoading(bool deferred)
+        {
+            m_deferredLoading = deferred;
+        }
+
+    protected:
+        quint64 m_drawnObjects { 0 };
+
     private:
         float m_sizeMagLim{ 10.0f };
+        bool m_deferredLoading { false };
 };
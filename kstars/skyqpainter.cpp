@@ -6,7 +6,9 @@
 
 #include "skyqpainter.h"
 
+#include <QGuiApplication>
 #include <QPointer>
+#include <QScreen>
 
 #include "kstarsdata.h"
 #include "kstars.h"
@@ -37,8 +39,12 @@
 #include "hips/hipsrenderer.h"
 #include "terrain/terrainrenderer.h"
 #include <QElapsedTimer>
+#include <QTimer>
 #include "auxiliary/rectangleoverlap.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace
 {
 // Convert spectral class to numerical index.
@@ -74,38 +80,54 @@ int harvardToIndex(char c)
     }
 }
 
+// Star sprites are drawn from 1 to maxStarSize pixels wide, in steps of 1 / starSizeSteps pixel.
+const int maxStarSize = 14;
+const int starSizeSteps = 4;
 // Total number of sizes of stars.
-const int nStarSizes = 15;
+const int nStarSizes = (maxStarSize - 1) * starSizeSteps + 1;
 // Total number of spectral classes
 // N.B. Must be in sync with harvardToIndex
 const int nSPclasses = 7;
 
-// Cache for star images.
-//
-// These pixmaps are never deallocated. Not really good...
-QPixmap *imageCache[nSPclasses][nStarSizes] = { { nullptr } };
+// Star sprite atlases, one for each device pixel ratio of the screens.
+QVector<std::shared_ptr<const StarAtlas>> starAtlases;
 
 std::unique_ptr<QPixmap> visibleSatPixmap, invisibleSatPixmap;
 } // namespace
 
+/**
+ * @short All the star images in a single pixmap, one row per spectral class and one column per size.
+ * The sprites are rendered in device pixels, for the device pixel ratio of the atlas.
+ */
+struct StarAtlas
+{
+    qreal devicePixelRatio { 1 };
+    QPixmap pixmap;
+    QRectF sprites[nSPclasses][nStarSizes];
+};
+
+namespace
+{
+// Returns the atlas closest to the device pixel ratio, or nullptr if the star images were not created yet.
+std::shared_ptr<const StarAtlas> findStarAtlas(qreal ratio)
+{
+    std::shared_ptr<const StarAtlas> closest;
+    for (const auto &atlas : starAtlases)
+    {
+        if (!closest || qAbs(atlas->devicePixelRatio - ratio) < qAbs(closest->devicePixelRatio - ratio))
+            closest = atlas;
+    }
+    return closest;
+}
+} // namespace
+
 int SkyQPainter::starColorMode           = 0;
 QColor SkyQPainter::m_starColor          = QColor();
 QMap<char, QColor> SkyQPainter::ColorMap = QMap<char, QColor>();
 
 void SkyQPainter::releaseImageCache()
 {
-    for (char &color : ColorMap.keys())
-    {
-        QPixmap **pmap = imageCache[harvardToIndex(color)];
-
-        for (int size = 1; size < nStarSizes; size++)
-        {
-            if (pmap[size])
-                delete pmap[size];
-
-            pmap[size] = nullptr;
-        }
-    }
+    starAtlases.clear();
 }
 
 SkyQPainter::SkyQPainter(QPaintDevice *pd) : SkyPainter(), QPainter()
@@ -145,13 +167,30 @@ void SkyQPainter::begin()
     setRenderHint(QPainter::Antialiasing, aa);
     setRenderHint(QPainter::HighQualityAntialiasing, aa);
     m_proj = SkyMap::Instance()->projector();
+    m_starAtlas = findStarAtlas(m_pd->devicePixelRatioF());
 }
 
 void SkyQPainter::end()
 {
+    endPointSources();
     QPainter::end();
 }
 
+void SkyQPainter::beginPointSources()
+{
+    m_queuePointSources = true;
+}
+
+void SkyQPainter::endPointSources()
+{
+    m_queuePointSources = false;
+    if (m_pointSources.isEmpty())
+        return;
+
+    drawPixmapFragments(m_pointSources.constData(), m_pointSources.size(), m_starAtlas->pixmap);
+    m_pointSources.clear();
+}
+
 void SkyQPainter::drawSkyBackground()
 {
     //FIXME use projector
@@ -208,9 +247,10 @@ void SkyQPainter::initStarImages()
         ColorMap.insert('M', m_starColor);
     }
 
+    QMap<char, QImage> bigImages;
     for (char &color : ColorMap.keys())
     {
-        QPixmap BigImage(15, 15);
+        QImage BigImage(15, 15, QImage::Format_ARGB32_Premultiplied);
         BigImage.fill(Qt::transparent);
 
         QPainter p;
@@ -253,16 +293,56 @@ void SkyQPainter::initStarImages()
         }
         p.end();
 
-        // Cache array slice
-        QPixmap **pmap = imageCache[harvardToIndex(color)];
+        bigImages.insert(color, BigImage);
+    }
+
+    // One atlas for each resolution we may draw to, the screens and the printer or exported images.
+    QVector<qreal> ratios { 1.0 };
+    for (const QScreen *screen : QGuiApplication::screens())
+    {
+        if (!ratios.contains(screen->devicePixelRatio()))
+            ratios.append(screen->devicePixelRatio());
+    }
+
+    starAtlases.clear();
+    for (qreal ratio : ratios)
+    {
+        auto atlas = std::make_shared<StarAtlas>();
+        atlas->devicePixelRatio = ratio;
+
+        // Each sprite gets a cell of a whole number of pixels, with a pixel of spacing,
+        // so that the smooth scaling of the fragments does not bleed into the neighbours.
+        const int rowHeight = static_cast<int>(std::ceil(maxStarSize * ratio)) + 1;
+        int columns[nStarSizes + 1] = { 0 };
+        for (int size = 0; size < nStarSizes; size++)
+            columns[size + 1] = columns[size] + static_cast<int>(std::ceil((1 + qreal(size) / starSizeSteps) * ratio)) + 1;
 
-        for (int size = 1; size < nStarSizes; size++)
+        QImage image(columns[nStarSizes], rowHeight * nSPclasses, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+
+        QPainter p;
+        p.begin(&image);
+        p.setRenderHint(QPainter::SmoothPixmapTransform, true);
+        for (char &color : ColorMap.keys())
         {
-            if (!pmap[size])
-                pmap[size] = new QPixmap();
-            *pmap[size] = BigImage.scaled(size, size, Qt::KeepAspectRatio,
-                                          Qt::SmoothTransformation);
+            const int row = harvardToIndex(color);
+            for (int size = 0; size < nStarSizes; size++)
+            {
+                // Draw the star at its exact width, centered on its cell. Scale it down to the
+                // nearest whole width first, which averages the pixels properly.
+                const qreal width = (1 + qreal(size) / starSizeSteps) * ratio;
+                const int cell = columns[size + 1] - columns[size] - 1;
+                const QImage scaled = bigImages[color].scaled(cell, cell, Qt::KeepAspectRatio,
+                                      Qt::SmoothTransformation);
+                const QRectF sprite(columns[size], row * rowHeight, cell, cell);
+                p.drawImage(QRectF(sprite.center() - QPointF(width / 2, width / 2), QSizeF(width, width)), scaled);
+                atlas->sprites[row][size] = sprite;
+            }
         }
+        p.end();
+
+        atlas->pixmap = QPixmap::fromImage(image);
+        starAtlases.append(atlas);
     }
     starColorMode = Options::starColorMode();
 
@@ -301,109 +381,137 @@ void SkyQPainter::drawSkyLine(SkyPoint *a, SkyPoint *b)
 void SkyQPainter::drawSkyPolyline(LineList *list, SkipHashList *skipList,
                                   LineListLabel *label)
 {
-    SkyList *points = list->points();
-    bool isVisible, isVisibleLast;
+    drawCachedSkyPolyline(list, false, skipList, label);
+}
 
-    if (points->size() == 0)
-        return;
-    QPointF oLast = m_proj->toScreen(points->first().get(), true, &isVisibleLast);
-    // & with the result of checkVisibility to clip away things below horizon
-    isVisibleLast &= m_proj->checkVisibility(points->first().get());
-    QPointF oThis, oThis2;
+void SkyQPainter::drawCachedSkyPolyline(LineList *list, bool cached, SkipHashList *skipList,
+                                        LineListLabel *label)
+{
+    QVector<QLineF> &lines = list->projectedLines;
+    QVector<int> &lineEnds = list->projectedLineEnds;
 
-    for (int j = 1; j < points->size(); j++)
+    if (!cached)
     {
-        SkyPoint *pThis = points->at(j).get();
+        lines.clear();
+        lineEnds.clear();
+
+        SkyList *points = list->points();
+        bool isVisible, isVisibleLast;
 
-        oThis2 = oThis = m_proj->toScreen(pThis, true, &isVisible);
+        if (points->size() == 0)
+            return;
+        QPointF oLast = m_proj->toScreen(points->first().get(), true, &isVisibleLast);
         // & with the result of checkVisibility to clip away things below horizon
-        isVisible &= m_proj->checkVisibility(pThis);
-        bool doSkip = false;
-        if (skipList)
-        {
-            doSkip = skipList->skip(j);
-        }
+        isVisibleLast &= m_proj->checkVisibility(points->first().get());
+        QPointF oThis;
 
-        bool pointsVisible = false;
         //Temporary solution to avoid random lines in Gnomonic projection and draw lines up to horizon
-        if (SkyMap::Instance()->projector()->type() == Projector::Gnomonic)
-        {
-            if (isVisible && isVisibleLast)
-                pointsVisible = true;
-        }
-        else
-        {
-            if (isVisible || isVisibleLast)
-                pointsVisible = true;
-        }
+        const bool gnomonic = SkyMap::Instance()->projector()->type() == Projector::Gnomonic;
 
-        if (!doSkip)
+        for (int j = 1; j < points->size(); j++)
         {
-            if (pointsVisible)
+            SkyPoint *pThis = points->at(j).get();
+
+            oThis = m_proj->toScreen(pThis, true, &isVisible);
+            // & with the result of checkVisibility to clip away things below horizon
+            isVisible &= m_proj->checkVisibility(pThis);
+            bool doSkip = false;
+            if (skipList)
+            {
+                doSkip = skipList->skip(j);
+            }
+
+            const bool pointsVisible = gnomonic ? (isVisible && isVisibleLast) : (isVisible || isVisibleLast);
+
+            if (!doSkip && pointsVisible)
             {
-                drawLine(oLast, oThis);
-                if (label)
-                    label->updateLabelCandidates(oThis.x(), oThis.y(), list, j);
+                lines.append(QLineF(oLast, oThis));
+                lineEnds.append(j);
             }
+
+            oLast         = oThis;
+            isVisibleLast = isVisible;
         }
+    }
+
+    if (lines.isEmpty())
+        return;
 
-        oLast         = oThis2;
-        isVisibleLast = isVisible;
+    drawLines(lines);
+    if (label)
+    {
+        for (int i = 0; i < lines.size(); i++)
+            label->updateLabelCandidates(lines[i].x2(), lines[i].y2(), list, lineEnds[i]);
     }
 }
 
 void SkyQPainter::drawSkyPolygon(LineList *list, bool forceClip)
 {
+    if (forceClip)
+    {
+        drawCachedSkyPolygon(list, false);
+        return;
+    }
+
     bool isVisible  = false, isVisibleLast;
     SkyList *points = list->points();
     QPolygonF polygon;
 
-    if (forceClip == false)
+    for (const auto &point : *points)
     {
-        for (const auto &point : *points)
-        {
-            polygon << m_proj->toScreen(point.get(), false, &isVisibleLast);
-            isVisible |= isVisibleLast;
-        }
-
-        // If 1+ points are visible, draw it
-        if (polygon.size() && isVisible)
-            drawPolygon(polygon);
-
-        return;
+        polygon << m_proj->toScreen(point.get(), false, &isVisibleLast);
+        isVisible |= isVisibleLast;
     }
 
-    SkyPoint *pLast = points->last().get();
-    QPointF oLast   = m_proj->toScreen(pLast, true, &isVisibleLast);
-    // & with the result of checkVisibility to clip away things below horizon
-    isVisibleLast &= m_proj->checkVisibility(pLast);
+    // If 1+ points are visible, draw it
+    if (polygon.size() && isVisible)
+        drawPolygon(polygon);
+}
 
-    for (const auto &point : *points)
+void SkyQPainter::drawCachedSkyPolygon(LineList *list, bool cached)
+{
+    QPolygonF &polygon = list->projectedPolygon;
+
+    if (!cached)
     {
-        SkyPoint *pThis = point.get();
-        QPointF oThis   = m_proj->toScreen(pThis, true, &isVisible);
+        polygon.clear();
+
+        SkyList *points = list->points();
+        if (points->size() == 0)
+            return;
+
+        bool isVisible, isVisibleLast;
+        SkyPoint *pLast = points->last().get();
+        m_proj->toScreen(pLast, true, &isVisibleLast);
         // & with the result of checkVisibility to clip away things below horizon
-        isVisible &= m_proj->checkVisibility(pThis);
+        isVisibleLast &= m_proj->checkVisibility(pLast);
 
-        if (isVisible && isVisibleLast)
-        {
-            polygon << oThis;
-        }
-        else if (isVisibleLast)
-        {
-            QPointF oMid = m_proj->clipLine(pLast, pThis);
-            polygon << oMid;
-        }
-        else if (isVisible)
+        for (const auto &point : *points)
         {
-            QPointF oMid = m_proj->clipLine(pThis, pLast);
-            polygon << oMid;
-            polygon << oThis;
-        }
+            SkyPoint *pThis = point.get();
+            QPointF oThis   = m_proj->toScreen(pThis, true, &isVisible);
+            // & with the result of checkVisibility to clip away things below horizon
+            isVisible &= m_proj->checkVisibility(pThis);
+
+            if (isVisible && isVisibleLast)
+            {
+                polygon << oThis;
+            }
+            else if (isVisibleLast)
+            {
+                QPointF oMid = m_proj->clipLine(pLast, pThis);
+                polygon << oMid;
+            }
+            else if (isVisible)
+            {
+                QPointF oMid = m_proj->clipLine(pThis, pLast);
+                polygon << oMid;
+                polygon << oThis;
+            }
 
-        pLast         = pThis;
-        oLast         = oThis;
-        isVisibleLast = isVisible;
+            pLast         = pThis;
+            isVisibleLast = isVisible;
+        }
     }
 
     if (polygon.size())
@@ -478,6 +586,7 @@ bool SkyQPainter::drawPlanet(KSPlanetBase *planet)
             drawEllipse(pos, size * .5, size * .5);
         }
     }
+    m_drawnObjects++;
     return true;
 }
 
@@ -504,6 +613,7 @@ bool SkyQPainter::drawEarthShadow(KSEarthShadow *shadow)
     drawEllipse(pos, penumbra_size, penumbra_size);
     restore();
 
+    m_drawnObjects++;
     return true;
 }
 
@@ -567,6 +677,7 @@ bool SkyQPainter::drawComet(KSComet *com)
             restore();
         }
 
+        m_drawnObjects++;
         return true;
     }
     else
@@ -593,6 +704,7 @@ bool SkyQPainter::drawAsteroid(KSAsteroid *ast)
         drawLine(QPoint(pos.x() - 1.0, pos.y()), QPoint(pos.x() + 1.0, pos.y()));
         drawLine(QPoint(pos.x(), pos.y() - 1.0), QPoint(pos.x(), pos.y() + 1.0));
 
+        m_drawnObjects++;
         return true;
     }
 
@@ -611,6 +723,7 @@ bool SkyQPainter::drawPointSource(const SkyPoint *loc, float mag, char sp)
     if (visible && m_proj->onScreen(pos))
     {
         drawPointSource(pos, starWidth(mag), sp);
+        m_drawnObjects++;
         return true;
     }
     else
@@ -619,15 +732,37 @@ bool SkyQPainter::drawPointSource(const SkyPoint *loc, float mag, char sp)
     }
 }
 
+bool SkyQPainter::drawProjectedPointSource(const SkyPoint *loc, const QPointF &pos, float mag, char sp)
+{
+    Q_UNUSED(loc)
+    // FIXME: onScreen here should use canvas size rather than SkyMap size, especially while printing in portrait mode!
+    if (!m_proj->onScreen(pos))
+        return false;
+
+    drawPointSource(pos, starWidth(mag), sp);
+    m_drawnObjects++;
+    return true;
+}
+
 void SkyQPainter::drawPointSource(const QPointF &pos, float size, char sp)
 {
-    int isize = qMin(static_cast<int>(size), 14);
     if (!m_vectorStars || starColorMode == 0)
     {
         // Draw stars as bitmaps, either because we were asked to, or because we're painting real colors
-        QPixmap *im  = imageCache[harvardToIndex(sp)][isize];
-        float offset = 0.5 * im->width();
-        drawPixmap(QPointF(pos.x() - offset, pos.y() - offset), *im);
+        if (!m_starAtlas)
+        {
+            m_starAtlas = findStarAtlas(m_pd->devicePixelRatioF());
+            if (!m_starAtlas)
+                return;
+        }
+        const int step = qBound(0, static_cast<int>(std::lround((size - 1) * starSizeSteps)), nStarSizes - 1);
+        const qreal scale = 1.0 / m_starAtlas->devicePixelRatio;
+        const QPainter::PixmapFragment fragment = QPainter::PixmapFragment::create(pos,
+                m_starAtlas->sprites[harvardToIndex(sp)][step], scale, scale);
+        if (m_queuePointSources)
+            m_pointSources.append(fragment);
+        else
+            drawPixmapFragments(&fragment, 1, m_starAtlas->pixmap);
     }
     else
     {
@@ -664,7 +799,16 @@ bool SkyQPainter::drawConstellationArtImage(ConstellationsArt *obj)
                                 KStarsData::Instance()->geo()->lat());
     QPointF constellationmidpoint = m_proj->toScreen(obj, true, &visible);
 
-    if (!visible || !m_proj->onScreen(constellationmidpoint))
+    if (!visible)
+        return false;
+
+    float w = obj->getWidth() * 60 * dms::PI * zoom / 10800;
+    float h = obj->getHeight() * 60 * dms::PI * zoom / 10800;
+
+    // Art with its midpoint off screen may still cover part of it, art further away is not loaded
+    const float radius = 0.5 * std::hypot(w, h);
+    const ViewParams view = m_proj->viewParams();
+    if (!QRectF(-radius, -radius, view.width + 2 * radius, view.height + 2 * radius).contains(constellationmidpoint))
         return false;
 
     //qDebug() << Q_FUNC_INFO << "o->pa() " << obj->pa();
@@ -672,9 +816,6 @@ bool SkyQPainter::drawConstellationArtImage(ConstellationsArt *obj)
         m_proj->findPA(obj, constellationmidpoint.x(), constellationmidpoint.y());
     //qDebug() << Q_FUNC_INFO << " final PA " << positionangle;
 
-    float w = obj->getWidth() * 60 * dms::PI * zoom / 10800;
-    float h = obj->getHeight() * 60 * dms::PI * zoom / 10800;
-
     save();
 
     setRenderHint(QPainter::SmoothPixmapTransform);
@@ -686,11 +827,13 @@ bool SkyQPainter::drawConstellationArtImage(ConstellationsArt *obj)
         scale(-1., 1.);
     }
     setOpacity(0.7);
-    drawImage(QRectF(-0.5 * w, -0.5 * h, w, h), obj->image());
+    // The level of the image closest to the drawn size, rather than transforming the full image every frame
+    drawImage(QRectF(-0.5 * w, -0.5 * h, w, h), obj->image(std::max(w, h) * m_pd->devicePixelRatioF()));
     setOpacity(1);
 
     setRenderHint(QPainter::SmoothPixmapTransform, false);
     restore();
+    m_drawnObjects++;
     return true;
 }
 
@@ -718,6 +861,7 @@ bool SkyQPainter::drawMosaicPanel(MosaicTiles *obj)
     obj->draw(this);
     restore();
 
+    m_drawnObjects++;
     return true;
 }
 #endif
@@ -765,6 +909,11 @@ bool SkyQPainter::drawImageOverlay(const QList<ImageOverlay> *imageOverlays, boo
         return false;
 
     constexpr int minDisplayDimension = 5;
+    // Tiles that are not in memory are read from disk for up to this long in a frame.
+    // The rest are drawn from a coarser level and read in the following frames.
+    constexpr qint64 tileLoadBudgetMs = 15;
+    // Below this field of view all the projections are close enough to linear for the footprint test.
+    constexpr double maxFootprintFov = 30.0;
 
     // Convert the RA/DEC from j2000 to jNow and add in az/alt computations.
     auto localTime = KStarsData::Instance()->geo()->UTtoLT(KStarsData::Instance()->clock()->utc());
@@ -772,13 +921,14 @@ bool SkyQPainter::drawImageOverlay(const QList<ImageOverlay> *imageOverlays, boo
     const ViewParams view = m_proj->viewParams();
     const double vw = view.width, vh = view.height;
     RectangleOverlap overlap(QPointF(vw / 2.0, vh / 2.0), vw, vh);
+    const double fov = m_proj->fov();
 
-    // QElapsedTimer drawTimer;
-    // drawTimer.restart();
-    int numDrawn = 0;
+    QElapsedTimer loadTimer;
+    loadTimer.start();
+    bool deferred = false;
     for (const ImageOverlay &o : *imageOverlays)
     {
-        if (o.m_Status != ImageOverlay::AVAILABLE || o.m_Img.get() == nullptr)
+        if (o.m_Status != ImageOverlay::AVAILABLE || o.m_Tiles.get() == nullptr)
             continue;
 
         double orientation = o.m_Orientation,  ra = o.m_RA, dec = o.m_DEC, scale = o.m_ArcsecPerPixel;
@@ -792,6 +942,15 @@ bool SkyQPainter::drawImageOverlay(const QList<ImageOverlay> *imageOverlays, boo
         const dms raDms(ra), decDms(dec);
         SkyPoint coord(raDms, decDms);
         coord.apparentCoord(static_cast<long double>(J2000), KStars::Instance()->data()->ut().djd());
+
+        // Cull by the footprint on the sky, the circle around the corners of the image.
+        if (fov < maxFootprintFov && view.focus != nullptr)
+        {
+            const double footprint = 0.5 * std::hypot(origWidth, origHeight) * scale / 3600.0;
+            if (coord.angularDistanceTo(view.focus).Degrees() > 1.1 * fov + footprint)
+                continue;
+        }
+
         coord.EquatorialToHorizontal(KStarsData::Instance()->lst(), KStarsData::Instance()->geo()->lat());
 
         // Find if the object is not visible, or if it is very small.
@@ -816,18 +975,67 @@ bool SkyQPainter::drawImageOverlay(const QList<ImageOverlay> *imageOverlays, boo
         if (!overlap.intersects(pos, w, h, finalPA))
             continue;
 
-        save();
-        translate(pos);
-        rotate(finalPA);
+        // The part of the image, centered on the origin, that is on the screen.
+        QTransform transform;
+        transform.translate(pos.x(), pos.y());
+        transform.rotate(finalPA);
         if (mirror)
+            transform.scale(-1., 1.);
+        const QRectF visibleRect = transform.inverted().mapRect(QRectF(0, 0, vw, vh))
+                                   .intersected(QRectF(-0.5 * w, -0.5 * h, w, h));
+        if (visibleRect.isEmpty())
+            continue;
+
+        // Pick the level with about one pixel per screen pixel, and the tiles that cover the screen.
+        const ImageOverlayTiles &tiles = *o.m_Tiles;
+        const int level = tiles.level(tiles.width() / w);
+        const QSize levelSize = tiles.levelSize(level);
+        const double sx = w / levelSize.width(), sy = h / levelSize.height();
+        const QSize count = tiles.tileCount(level);
+        const int x0 = std::max(0, static_cast<int>((visibleRect.left() + 0.5 * w) / sx) / ImageOverlayTiles::TileSize);
+        const int y0 = std::max(0, static_cast<int>((visibleRect.top() + 0.5 * h) / sy) / ImageOverlayTiles::TileSize);
+        const int x1 = std::min(count.width() - 1,
+                                static_cast<int>((visibleRect.right() + 0.5 * w) / sx) / ImageOverlayTiles::TileSize);
+        const int y1 = std::min(count.height() - 1,
+                                static_cast<int>((visibleRect.bottom() + 0.5 * h) / sy) / ImageOverlayTiles::TileSize);
+
+        QVector<QPair<QRectF, QImage>> visibleTiles;
+        bool missing = false;
+        for (int y = y0; y <= y1; ++y)
         {
-            this->scale(-1., 1.);
+            for (int x = x0; x <= x1; ++x)
+            {
+                const QImage tile = tiles.tile(level, x, y, loadTimer.elapsed() < tileLoadBudgetMs);
+                if (tile.isNull())
+                {
+                    missing = true;
+                    continue;
+                }
+                const QRectF rect(-0.5 * w + x * ImageOverlayTiles::TileSize * sx,
+                                  -0.5 * h + y * ImageOverlayTiles::TileSize * sy,
+                                  tile.width() * sx, tile.height() * sy);
+                visibleTiles.append(qMakePair(rect, tile));
+            }
         }
-        drawImage(QRectF(-0.5 * w, -0.5 * h, w, h), *(o.m_Img.get()));
-        numDrawn++;
+
+        save();
+        setTransform(transform, true);
+        // The preview stands in for the tiles that are not read yet.
+        if (missing)
+            drawImage(QRectF(-0.5 * w, -0.5 * h, w, h), tiles.preview());
+        for (const auto &tile : visibleTiles)
+            drawImage(tile.first, tile.second);
         restore();
+        deferred = deferred || missing;
+    }
+
+    if (deferred)
+    {
+        QTimer::singleShot(0, SkyMap::Instance(), []()
+        {
+            SkyMap::Instance()->forceUpdate();
+        });
     }
-    // fprintf(stderr, "DrawTimer: %lldms for %d images\n", drawTimer.elapsed(), numDrawn);
     return true;
 }
 
@@ -883,6 +1091,7 @@ bool SkyQPainter::drawCatalogObject(const CatalogObject &obj)
     // Draw Symbol
     drawDeepSkySymbol(pos, obj.type(), size, obj.e(), positionAngle);
 
+    m_drawnObjects++;
     return true;
 }
 
@@ -1145,15 +1354,17 @@ void SkyQPainter::drawObservingList(const QList<SkyObject *> &obs)
 void SkyQPainter::drawFlags()
 {
     KStarsData *data = KStarsData::Instance();
+    FlagComponent *flags = data->skyComposite()->flags();
     std::shared_ptr<SkyPoint> point;
     QImage image;
     bool visible = false;
     QPointF pos;
 
-    for (int i = 0; i < data->skyComposite()->flags()->size(); i++)
+    // Only the flags of the trixels in view
+    for (int i : flags->visibleFlags())
     {
-        point = data->skyComposite()->flags()->pointList().at(i);
-        image = data->skyComposite()->flags()->image(i);
+        point = flags->pointList().at(i);
+        image = flags->image(i);
 
         // Set Horizontal coordinates
         point->EquatorialToHorizontal(data->lst(), data->geo()->lat());
@@ -1169,9 +1380,9 @@ void SkyQPainter::drawFlags()
         drawImage(pos.x() - 0.5 * image.width(), pos.y() - 0.5 * image.height(), image);
 
         // Draw flag label
-        setPen(data->skyComposite()->flags()->labelColor(i));
+        setPen(flags->labelColor(i));
         setFont(QFont("Helvetica", 10, QFont::Bold));
-        drawText(pos.x() + 10, pos.y() - 10, data->skyComposite()->flags()->label(i));
+        drawText(pos.x() + 10, pos.y() - 10, flags->label(i));
     }
 }
 
@@ -1226,6 +1437,7 @@ bool SkyQPainter::drawSatellite(Satellite *sat)
         drawLine( QPoint( pos.x() - 0.5, pos.y() + 0.5 ), QPoint( pos.x() - 0.5, pos.y() - 0.5 ) );*/
     }
 
+    m_drawnObjects++;
     return true;
 
     //if ( Options::showSatellitesLabels() )
@@ -1251,5 +1463,6 @@ bool SkyQPainter::drawSupernova(Supernova *sup)
     //qDebug()<<"Here";
     drawLine(QPoint(pos.x() - 2.0, pos.y()), QPoint(pos.x() + 2.0, pos.y()));
     drawLine(QPoint(pos.x(), pos.y() - 2.0), QPoint(pos.x(), pos.y() + 2.0));
+    m_drawnObjects++;
     return true;
 }
@@ -12,6 +12,9 @@
 
 #include <QColor>
 #include <QMap>
+#include <QVector>
+
+#include <memory>
 
 class Projector;
 class QWidget;
@@ -21,6 +24,7 @@ class HIPSRenderer;
 class TerrainRenderer;
 class ImageOverlay;
 class KSEarthShadow;
+struct StarAtlas;
 
 /**
  * @short The QPainter-based painting backend.
@@ -78,6 +82,13 @@ class SkyQPainter : public SkyPainter, public QPainter
         void begin() override;
         void end() override;
 
+        /**
+         * @short Queue the point sources drawn until endPointSources(), which draws them all at once
+         * from the star sprite atlas.
+         */
+        void beginPointSources() override;
+        void endPointSources() override;
+
         /** Recalculates the star pixmaps. */
         static void initStarImages();
 
@@ -87,7 +98,11 @@ class SkyQPainter : public SkyPainter, public QPainter
         void drawSkyPolyline(LineList *list, SkipHashList *skipList = nullptr,
                              LineListLabel *label = nullptr) override;
         void drawSkyPolygon(LineList *list, bool forceClip = true) override;
+        void drawCachedSkyPolyline(LineList *list, bool cached, SkipHashList *skipList = nullptr,
+                                   LineListLabel *label = nullptr) override;
+        void drawCachedSkyPolygon(LineList *list, bool cached) override;
         bool drawPointSource(const SkyPoint *loc, float mag, char sp = 'A') override;
+        bool drawProjectedPointSource(const SkyPoint *loc, const QPointF &pos, float mag, char sp = 'A') override;
         bool drawCatalogObject(const CatalogObject &obj) override;
         void drawCatalogObjectImage(const QPointF &pos, const CatalogObject &obj,
                                     float positionAngle);
@@ -121,6 +136,10 @@ class SkyQPainter : public SkyPainter, public QPainter
         TerrainRenderer *m_terrainRender{ nullptr };
         QSize m_size;
         QScopedPointer<QImage> m_HiPSImage;
+        // Star sprites for the device pixel ratio of the paint device
+        std::shared_ptr<const StarAtlas> m_starAtlas;
+        bool m_queuePointSources { false };
+        QVector<QPainter::PixmapFragment> m_pointSources;
         static int starColorMode;
         static QColor m_starColor;
         static QMap<char, QColor> ColorMap;
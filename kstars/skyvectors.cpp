@@ -0,0 +1,90 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "skyvectors.h"
+
+#include "skyobjects/skypoint.h"
+
+#include <cmath>
+
+SkyVectors::SkyVectors(int count)
+{
+    resize(count);
+}
+
+SkyVectors SkyVectors::fromAngles(const double *longitude, const double *latitude, int count)
+{
+    SkyVectors vectors;
+    const Eigen::Map<const Eigen::ArrayXd> lon(longitude, count), lat(latitude, count);
+    const Eigen::ArrayXd cosLat = lat.cos();
+    vectors.m_X = lon.cos() * cosLat;
+    vectors.m_Y = lon.sin() * cosLat;
+    vectors.m_Z = lat.sin();
+    return vectors;
+}
+
+void SkyVectors::resize(int count)
+{
+    m_X.resize(count);
+    m_Y.resize(count);
+    m_Z.resize(count);
+}
+
+void SkyVectors::set(int index, double longitude, double latitude)
+{
+    const double cosLat = std::cos(latitude);
+    m_X[index] = std::cos(longitude) * cosLat;
+    m_Y[index] = std::sin(longitude) * cosLat;
+    m_Z[index] = std::sin(latitude);
+}
+
+void SkyVectors::rotate(const Eigen::Matrix3d &rotation)
+{
+    const Eigen::ArrayXd x = m_X, y = m_Y;
+    m_X = rotation(0, 0) * x + rotation(0, 1) * y + rotation(0, 2) * m_Z;
+    m_Y = rotation(1, 0) * x + rotation(1, 1) * y + rotation(1, 2) * m_Z;
+    m_Z = rotation(2, 0) * x + rotation(2, 1) * y + rotation(2, 2) * m_Z;
+}
+
+void SkyVectors::addAndNormalize(const Eigen::Vector3d &offset)
+{
+    m_X += offset.x();
+    m_Y += offset.y();
+    m_Z += offset.z();
+    const Eigen::ArrayXd inverse = (m_X.square() + m_Y.square() + m_Z.square()).rsqrt();
+    m_X *= inverse;
+    m_Y *= inverse;
+    m_Z *= inverse;
+}
+
+void SkyVectors::toAngles(double *longitude, double *latitude) const
+{
+    // atan2 has no SIMD form in Eigen, the latitudes do
+    Eigen::Map<Eigen::ArrayXd>(latitude, size()) = m_Z.max(-1.0).min(1.0).asin();
+    for (int i = 0; i < size(); ++i)
+    {
+        const double lon = std::atan2(m_Y[i], m_X[i]);
+        longitude[i]     = lon < 0 ? lon + 2.0 * dms::PI : lon;
+    }
+}
+
+std::vector<char> SkyVectors::aboveAltitude(double altitude, bool refraction) const
+{
+    const double limit = std::sin((refraction ? SkyPoint::unrefract(altitude) : altitude) * dms::DegToRad);
+    std::vector<char> above(size());
+    for (int i = 0; i < size(); ++i)
+        above[i] = m_Z[i] >= limit;
+    return above;
+}
+
+void SkyVectors::refract(Eigen::ArrayXd &altitudes)
+{
+    // Above the critical altitude the formula of SkyPoint::refractionCorr(), below it the linear extrapolation
+    static const double corrCrit = SkyPoint::refractionCorr(SkyPoint::altCrit);
+    const Eigen::ArrayXd corr = 1.02 / (dms::DegToRad * (altitudes + 10.3 / (altitudes + 5.11))).tan() / 60;
+    const Eigen::ArrayXd low  = corrCrit * (altitudes + 90) / (SkyPoint::altCrit + 90);
+    altitudes += (altitudes > SkyPoint::altCrit).select(corr, low);
+}
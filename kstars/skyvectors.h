@@ -0,0 +1,99 @@
+/*
+    SPDX-FileCopyrightText: 2026 KStars Developers
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <Eigen/Core>
+
+#include <vector>
+
+/**
+ * @class SkyVectors
+ * @short Unit vectors of many sky positions, as one array per axis.
+ *
+ * SkyPoint converts its coordinates one point at a time, with trigonometry in every step.
+ * Once a batch of positions is turned into unit vectors, precession, nutation and the
+ * conversion to the horizon are rotations, aberration is an addition, and an altitude limit
+ * is a comparison of the z axis. Keeping x, y and z in separate arrays lets Eigen run these
+ * as SIMD loops over all the positions.
+ *
+ * Longitudes and latitudes are in radians. For equatorial vectors they are RA and Dec, for
+ * horizontal vectors as made by ObservationContext they are the azimuth from the north
+ * through the east and the altitude. SkyPoint stays the API for single positions.
+ */
+class SkyVectors
+{
+    public:
+        SkyVectors() = default;
+
+        explicit SkyVectors(int count);
+
+        /** @return the vectors towards @p longitude and @p latitude, @p count of each */
+        static SkyVectors fromAngles(const double *longitude, const double *latitude, int count);
+
+        int size() const
+        {
+            return static_cast<int>(m_X.size());
+        }
+
+        void resize(int count);
+
+        void set(int index, double longitude, double latitude);
+
+        void set(int index, const Eigen::Vector3d &vector)
+        {
+            m_X[index] = vector.x();
+            m_Y[index] = vector.y();
+            m_Z[index] = vector.z();
+        }
+
+        Eigen::Vector3d at(int index) const
+        {
+            return Eigen::Vector3d(m_X[index], m_Y[index], m_Z[index]);
+        }
+
+        const Eigen::ArrayXd &x() const
+        {
+            return m_X;
+        }
+        const Eigen::ArrayXd &y() const
+        {
+            return m_Y;
+        }
+        /** @return the sines of the latitudes */
+        const Eigen::ArrayXd &z() const
+        {
+            return m_Z;
+        }
+
+        /** @short Apply @p rotation to all the vectors */
+        void rotate(const Eigen::Matrix3d &rotation);
+
+        /** @short Add @p offset to all the vectors and normalize them, as aberration does */
+        void addAndNormalize(const Eigen::Vector3d &offset);
+
+        /** @short Write the longitudes, in [0, 2 pi), and the latitudes of the vectors */
+        void toAngles(double *longitude, double *latitude) const;
+
+        /**
+         * @short Test the horizontal vectors against an altitude limit.
+         * @param altitude the lowest apparent altitude in degrees
+         * @param refraction whether @p altitude includes the refraction, so that the limit
+         *        is lowered to the matching true altitude once for the batch
+         * @return for each vector 1 if it is at or above the limit, otherwise 0
+         */
+        std::vector<char> aboveAltitude(double altitude, bool refraction = false) const;
+
+        /**
+         * @short Turn true altitudes in degrees into apparent ones, as SkyPoint::refract() does.
+         */
+        static void refract(Eigen::ArrayXd &altitudes);
+
+    private:
+        Eigen::ArrayXd m_X;
+        Eigen::ArrayXd m_Y;
+        Eigen::ArrayXd m_Z;
+};
@@ -197,6 +197,8 @@ TerrainRenderer::TerrainRenderer()
 {
 }
 
+TerrainRenderer::~TerrainRenderer() = default;
+
 // Put degrees in the range of 0 -> 359.99999999
 double rationalizeAz(double degrees)
 {
@@ -303,14 +305,11 @@ QRgb TerrainRenderer::getPixel(double az, double alt) const
     return qPremultiply(qRgba(red, green, blue, alpha));
 }
 
-// Checks to see if the view is the same as the last call to render.
-// If true, render (below) will skip its computations and return the same image
-// as was previously calculated.
-// If the view is not the same, this method stores away the details of the current view
-// so that it may make this comparison again in the future.
-bool TerrainRenderer::sameView(const Projector *proj, bool forceRefresh)
+namespace
+{
+// Returns the azimuth and altitude of the center of the view.
+void focusAzAlt(const ViewParams &view, double *az, double *alt)
 {
-    ViewParams view = proj->viewParams();
     SkyPoint point = *(view.focus);
     const auto &lst = KStarsData::Instance()->lst();
     const auto &lat = KStarsData::Instance()->geo()->lat();
@@ -319,16 +318,37 @@ bool TerrainRenderer::sameView(const Projector *proj, bool forceRefresh)
     // but the rendering is tied to azimuth and altitude which may not change.
     // Thus we convert point to horizontal coordinates.
     point.EquatorialToHorizontal(lst, lat);
-    const double az = rationalizeAz(point.az().Degrees());
-    const double alt = rationalizeAlt(point.alt().Degrees());
-
-    bool ok = view.width == savedViewParams.width &&
-              view.height == savedViewParams.height &&
-              view.zoomFactor == savedViewParams.zoomFactor &&
-              view.rotationAngle == savedViewParams.rotationAngle &&
-              view.useRefraction == savedViewParams.useRefraction &&
-              view.useAltAz == savedViewParams.useAltAz &&
-              view.fillGround == savedViewParams.fillGround;
+    *az = rationalizeAz(point.az().Degrees());
+    *alt = rationalizeAlt(point.alt().Degrees());
+}
+
+// True if the two views project the sky the same way around their centers.
+bool sameProjection(const ViewParams &view1, const ViewParams &view2)
+{
+    return view1.width == view2.width &&
+           view1.height == view2.height &&
+           view1.zoomFactor == view2.zoomFactor &&
+           view1.rotationAngle == view2.rotationAngle &&
+           view1.useRefraction == view2.useRefraction &&
+           view1.useAltAz == view2.useAltAz &&
+           view1.fillGround == view2.fillGround;
+}
+}
+
+// Checks to see if the view is the same as the last call to render.
+// If true, render (below) will skip its computations and return the same image
+// as was previously calculated.
+// If the view is not the same, this method stores away the details of the current view
+// so that it may make this comparison again in the future.
+bool TerrainRenderer::sameView(const Projector *proj, bool forceRefresh, int sampling, bool skip)
+{
+    ViewParams view = proj->viewParams();
+    double az, alt;
+    focusAzAlt(view, &az, &alt);
+
+    bool ok = sameProjection(view, savedViewParams) &&
+              sampling == savedSampling &&
+              skip == savedSkip;
     const double azDiff = fabs(savedAz - az);
     const double altDiff = fabs(savedAlt - alt);
     if (!forceRefresh && ok && azDiff < .0001 && altDiff < .0001)
@@ -339,6 +359,37 @@ bool TerrainRenderer::sameView(const Projector *proj, bool forceRefresh)
     savedViewParams.focus = nullptr;
     savedAz = az;
     savedAlt = alt;
+    savedSampling = sampling;
+    savedSkip = skip;
+    return false;
+}
+
+// Checks to see if the az/alt lookup of the last computed view can be used for this one.
+// In horizontal mode, panning in azimuth rotates the view around the zenith, so every pixel's
+// altitude stays the same and its azimuth changes by the same amount as the view's center.
+// The old lookup is then used as is, adding azOffset to its azimuths.
+// If the lookup cannot be used, this method stores away the details of the current view.
+bool TerrainRenderer::sameLookup(const Projector *proj, bool forceRefresh, int sampling, double *azOffset)
+{
+    ViewParams view = proj->viewParams();
+    double az, alt;
+    focusAzAlt(view, &az, &alt);
+
+    const bool ok = lookup && sameProjection(view, lookupViewParams) && sampling == lookupSampling;
+    const double azDiff = fabs(lookupAz - az);
+    const double altDiff = fabs(lookupAlt - alt);
+    if (!forceRefresh && ok && altDiff < .0001 && (azDiff < .0001 || view.useAltAz))
+    {
+        *azOffset = az - lookupAz;
+        return true;
+    }
+
+    lookupViewParams = view;
+    lookupViewParams.focus = nullptr;
+    lookupAz = az;
+    lookupAlt = alt;
+    lookupSampling = sampling;
+    *azOffset = 0;
     return false;
 }
 
@@ -392,7 +443,16 @@ bool TerrainRenderer::render(uint16_t w, uint16_t h, QImage *terrainImage, const
     terrainSourceCorrectAz = Options::terrainSourceCorrectAz();
     terrainSourceCorrectAlt = Options::terrainSourceCorrectAlt();
 
-    if (sameView(proj, dirty))
+    // Only compute the pixel's az and alt values for every Nth pixel.
+    // Get the other pixel az and alt values by interpolation.
+    // This saves a lot of time. While the map is dragged, sample twice as coarsely.
+    const int sampling = Options::terrainDownsampling() * (SkyMap::IsSlewing() ? 2 : 1);
+
+    // Another speedup. If true, our calculations are downsampled by 2 in each dimension.
+    const bool skip = Options::terrainSkipSpeedup() || SkyMap::IsSlewing();
+    int increment = skip ? 2 : 1;
+
+    if (sameView(proj, dirty, sampling, skip))
     {
         // Just return the previous image if the input view hasn't changed.
         *terrainImage = savedImage.copy();
@@ -402,21 +462,18 @@ bool TerrainRenderer::render(uint16_t w, uint16_t h, QImage *terrainImage, const
     QElapsedTimer timer;
     timer.start();
 
-    // Only compute the pixel's az and alt values for every Nth pixel.
-    // Get the other pixel az and alt values by interpolation.
-    // This saves a lot of time.
-    const int sampling = Options::terrainDownsampling();
-    InterpArray interp(w, h, sampling);
     QElapsedTimer setupTimer;
     setupTimer.start();
-    setupLookup(w, h, sampling, proj, interp.azimuthLookup(), interp.altitudeLookup());
+    double azOffset = 0;
+    if (!sameLookup(proj, dirty, sampling, &azOffset))
+    {
+        lookup.reset(new InterpArray(w, h, sampling));
+        setupLookup(w, h, sampling, proj, lookup->azimuthLookup(), lookup->altitudeLookup());
+    }
+    InterpArray &interp = *lookup;
 
     const double setupTime = setupTimer.elapsed() / 1000.0; ///////////////////
 
-    // Another speedup. If true, our calculations are downsampled by 2 in each dimension.
-    const bool skip = Options::terrainSkipSpeedup() || SkyMap::IsSlewing();
-    int increment = skip ? 2 : 1;
-
     // Assign transparent pixels everywhere by default.
     terrainImage->fill(0);
 
@@ -444,7 +501,7 @@ bool TerrainRenderer::render(uint16_t w, uint16_t h, QImage *terrainImage, const
             {
                 float az, alt;
                 interp.get(i, j, &az, &alt);
-                const QRgb pixel = getPixel(az, alt);
+                const QRgb pixel = getPixel(az + azOffset, alt);
                 terrainImage->setPixel(i, j, pixel);
                 lastTransparent = (pixel == 0);
 
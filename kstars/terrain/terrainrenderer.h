@@ -12,6 +12,7 @@
 #include "projections/projector.h"
 
 class TerrainLookup;
+class InterpArray;
 
 class TerrainRenderer : public QObject
 {
@@ -29,6 +30,7 @@ class TerrainRenderer : public QObject
     private:
         // Constructor is private. Only make it with Instance().
         TerrainRenderer();
+        ~TerrainRenderer() override;
 
         // Speed-up the image calculations by downsampling azimuth and altitude
         // computations of the pixels in the input view.
@@ -40,7 +42,11 @@ class TerrainRenderer : public QObject
 
         // Checks to see if we can use the old rendering.
         // If not, copies the view for the next call.
-        bool sameView(const Projector *proj, bool forceRefresh);
+        bool sameView(const Projector *proj, bool forceRefresh, int sampling, bool skip);
+
+        // Checks to see if we can use the old az/alt lookup, possibly shifted in azimuth.
+        // If not, copies the view for the next call.
+        bool sameLookup(const Projector *proj, bool forceRefresh, int sampling, double *azOffset);
 
         // This is the only instance we'll make.
         static TerrainRenderer * _terrainRenderer;
@@ -54,8 +60,16 @@ class TerrainRenderer : public QObject
         // Save the input view and the computed image in case the image can be re-used.
         ViewParams savedViewParams;
         double savedAz, savedAlt;
+        int savedSampling = 0;
+        bool savedSkip = false;
         QImage savedImage;
 
+        // The az/alt lookup and the view it was computed for.
+        std::unique_ptr<InterpArray> lookup;
+        ViewParams lookupViewParams;
+        double lookupAz = 0, lookupAlt = 0;
+        int lookupSampling = 0;
+
         // Keep the parameters used to display the last image
         // to see if something's changed and we need to redisplay.
         QString sourceFilename;
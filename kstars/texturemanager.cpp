@@ -61,6 +61,15 @@ const QImage &TextureManager::getImage(const QString &name)
     }
 }
 
+QImage TextureManager::loadImage(const QString &name)
+{
+    Create();
+    if (name.isEmpty())
+        return QImage();
+    const QString filename = findTextureFile(name);
+    return filename.isEmpty() ? QImage() : QImage(filename, "PNG");
+}
+
 TextureManager::CacheIter TextureManager::findTexture(const QString &name)
 {
     Create();
@@ -71,44 +80,35 @@ TextureManager::CacheIter TextureManager::findTexture(const QString &name)
         return it;
     }
 
+    const QString filename = findTextureFile(name);
+    return (TextureManager::CacheIter)m_p->m_textures.insert(name,
+                                                             filename.isEmpty() ? QImage() : QImage(filename, "PNG"));
+}
+
+QString TextureManager::findTextureFile(const QString &name)
+{
     for (const auto &dir : m_p->m_texture_directories)
     {
         const auto &filename = QString("%1/%2.png").arg(dir).arg(name);
         QFile file{ filename };
         if (file.exists())
-            return (TextureManager::CacheIter)m_p->m_textures.insert(
-                name, QImage(filename, "PNG"));
+            return filename;
     }
 
     //Try to load from the file in 'skycultures/western' subdirectory for western constellation art
     QString filename = KSPaths::locate(QStandardPaths::AppLocalDataLocation,
                                        QString("skycultures/western/%1.png").arg(name));
-    if (!filename.isNull())
-    {
-        return (TextureManager::CacheIter)m_p->m_textures.insert(name,
-                                                                 QImage(filename, "PNG"));
-    }
+    if (!filename.isEmpty())
+        return filename;
 
     //Try to load from the file in 'skycultures/inuit' subdirectory for Inuit constellation art
     filename = KSPaths::locate(QStandardPaths::AppLocalDataLocation,
                                QString("skycultures/inuit/%1.png").arg(name));
-    if (!filename.isNull())
-    {
-        return (TextureManager::CacheIter)m_p->m_textures.insert(name,
-                                                                 QImage(filename, "PNG"));
-    }
+    if (!filename.isEmpty())
+        return filename;
 
     // Try to load from file in main data directory
-    filename = KSPaths::locate(QStandardPaths::AppLocalDataLocation,
-                               QString("textures/%1.png").arg(name));
-
-    if (!filename.isNull())
-    {
-        return (TextureManager::CacheIter)m_p->m_textures.insert(name,
-                                                                 QImage(filename, "PNG"));
-    }
-
-    return (TextureManager::CacheIter)m_p->m_textures.insert(name, QImage());
+    return KSPaths::locate(QStandardPaths::AppLocalDataLocation, QString("textures/%1.png").arg(name));
 }
 
 #ifdef HAVE_OPENGL
@@ -32,6 +32,12 @@ class TextureManager : public QObject
      */
     static const QImage &getImage(const QString &name);
 
+    /**
+     * Return texture image loaded from disk without caching it, or an empty image if it is not found.
+     * For large images the caller keeps only as long as they are shown, such as constellation art.
+     */
+    static QImage loadImage(const QString &name);
+
     /**
      * Clear the cache and discover the directories to load textures from.
      */
@@ -55,6 +61,8 @@ class TextureManager : public QObject
     explicit TextureManager(QObject *parent = nullptr);
     /** Try find image in the cache and then to load it from disk if it's not found */
     static CacheIter findTexture(const QString &name);
+    /** Find the file of the texture in the texture directories and the data directories, empty if none */
+    static QString findTextureFile(const QString &name);
 
     // Pointer to singleton instance
     static TextureManager *m_p;
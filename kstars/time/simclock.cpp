@@ -13,7 +13,10 @@
 
 #include <kstars_debug.h>
 
+#include <cmath>
+
 int SimClock::TimerInterval = 100; //msec
+int SimClock::MaxTimerInterval = 1000; //msec
 
 SimClock::SimClock(QObject *parent, const KStarsDateTime &when) : QObject(parent), m_InternalTimer(this)
 {
@@ -74,7 +77,7 @@ void SimClock::setManualMode(bool on)
             m_SystemMark.start();
             m_JulianMark  = m_UTC.djd();
             m_LastElapsed = 0;
-            m_InternalTimer.start(TimerInterval);
+            m_InternalTimer.start(m_TickInterval);
         }
     }
     m_ManualMode = on;
@@ -93,6 +96,21 @@ void SimClock::manualTick(bool force, bool backward)
         tick();
 }
 
+void SimClock::setUpdateCost(qint64 milliseconds)
+{
+    // Smooth the cost so that a single slow update does not change the rate
+    m_UpdateCost = m_UpdateCost > 0 ? 0.8 * m_UpdateCost + 0.2 * milliseconds : milliseconds;
+
+    // Leave the event loop at least as much time as the updates take
+    const int interval = qBound(TimerInterval, static_cast<int>(2 * m_UpdateCost), MaxTimerInterval);
+    if (std::abs(interval - m_TickInterval) * 5 < m_TickInterval)
+        return;
+
+    m_TickInterval = interval;
+    if (m_InternalTimer.isActive())
+        m_InternalTimer.setInterval(m_TickInterval);
+}
+
 bool SimClock::isActive()
 {
     if (m_ManualMode)
@@ -135,7 +153,7 @@ void SimClock::start()
         m_SystemMark.start();
         m_JulianMark  = m_UTC.djd();
         m_LastElapsed = 0;
-        m_InternalTimer.start(TimerInterval);
+        m_InternalTimer.start(m_TickInterval);
         emit clockToggled(false);
     }
 }
@@ -71,6 +71,20 @@ class SimClock : public QObject
         /**Sets Manual Mode on/off according to the bool argument. */
         void setManualMode(bool on = true);
 
+        /**
+         * @short Report how long the update triggered by the last tick took, in milliseconds.
+         * The tick interval follows the update cost, so that slow updates are not queued up
+         * behind each other. Each tick still advances the clock by the real time elapsed,
+         * times the scale, so the intermediate states are skipped rather than slowed down.
+         */
+        void setUpdateCost(qint64 milliseconds);
+
+        /** @return the current interval between ticks, in milliseconds */
+        int tickInterval() const
+        {
+            return m_TickInterval;
+        }
+
     public Q_SLOTS:
 #ifndef KSTARS_LITE
         /** DBUS function to stop the SimClock. */
@@ -151,11 +165,16 @@ class SimClock : public QObject
         int m_LastElapsed { 0 };
         bool m_ManualMode { false };
         bool m_ManualActive { false };
+        /// Smoothed cost of the updates, in milliseconds
+        double m_UpdateCost { 0 };
+        int m_TickInterval { TimerInterval };
 
         // used to generate names for dcop interfaces
         //static int idgen;
         // how often to update
         static int TimerInterval;
+        // the longest interval the update cost may stretch it to
+        static int MaxTimerInterval;
 
         // Disallow copying
         SimClock(const SimClock &);
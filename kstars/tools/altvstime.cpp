@@ -32,6 +32,40 @@
 #include <QtPrintSupport/QPrintDialog>
 
 #include "kstars_debug.h"
+#include "auxiliary/executors.h"
+
+#include <cmath>
+
+namespace
+{
+/// The curves are sampled every 15 minutes over 24 hours
+constexpr int CURVE_SAMPLES = 97;
+constexpr double CURVE_STEP_HOURS = 0.25;
+/// Sidereal hours per solar hour
+constexpr double SIDEREAL_RATE = 1.00273790935;
+/// The cache is dropped when it grows larger
+constexpr int MAX_CACHED_CURVES = 2048;
+
+/**
+ * The altitudes of a point of fixed coordinates every CURVE_STEP_HOURS, starting at the local
+ * sidereal time @p lst0. The sidereal time advances at SIDEREAL_RATE, so that only one GST
+ * has to be computed per curve.
+ */
+QVector<double> altitudeCurve(double ra, double dec, double lat, double lst0)
+{
+    QVector<double> altitudes(CURVE_SAMPLES);
+    const double sinLat = sin(lat), cosLat = cos(lat);
+    const double sinDec = sin(dec), cosDec = cos(dec);
+    const double step   = CURVE_STEP_HOURS * SIDEREAL_RATE * dms::PI / 12.0;
+
+    for (int i = 0; i < CURVE_SAMPLES; ++i)
+    {
+        const double sinAlt = sinDec * sinLat + cosDec * cosLat * cos(lst0 + i * step - ra);
+        altitudes[i]        = asin(std::max(-1.0, std::min(1.0, sinAlt))) / dms::DegToRad;
+    }
+    return altitudes;
+}
+}
 
 AltVsTimeUI::AltVsTimeUI(QWidget *p) : QFrame(p)
 {
@@ -376,9 +410,6 @@ void AltVsTime::processObject(SkyObject *o, bool forceAdd)
     //precess coords to target epoch
     o->updateCoordsNow(num);
 
-    // vector used for computing the points needed for drawing the graph
-    QVector<double> y(100), t(100);
-
     //If this point is not in list already, add it to list
     bool found(false);
     foreach (SkyObject *p, pList)
@@ -414,15 +445,14 @@ void AltVsTime::processObject(SkyObject *o, bool forceAdd)
         // time range: 24h
 
         int offset = 3;
-        for (double h = -12.0, i = 0; h <= 12.0; h += 0.25, i++)
+        const QVector<double> &y = curve(o);
+        for (int i = 0; i < y.size(); i++)
         {
-            y[i] = findAltitude(o, h);
             if (y[i] > maxAlt)
                 maxAlt = y[i];
             if (y[i] < minAlt)
                 minAlt = y[i];
-            t[i] = i * 900 + 43200;
-            avtUI->View->graph(avtUI->View->graphCount() - 1)->addData(t[i], y[i]);
+            avtUI->View->graph(avtUI->View->graphCount() - 1)->addData(i * 900 + 43200, y[i]);
         }
         avtUI->View->graph(avtUI->View->graphCount() - 1)->setPen(QPen(Qt::white, 3));
 
@@ -463,6 +493,36 @@ void AltVsTime::processObject(SkyObject *o, bool forceAdd)
     delete num;
 }
 
+QString AltVsTime::curveKey(const SkyPoint *p)
+{
+    return QString("%1 %2 %3 %4 %5 %6")
+           .arg(p->ra().Degrees(), 0, 'g', 12)
+           .arg(p->dec().Degrees(), 0, 'g', 12)
+           .arg(geo->lat()->Degrees(), 0, 'g', 12)
+           .arg(geo->lng()->Degrees(), 0, 'g', 12)
+           .arg(static_cast<double>(getDate().djd()), 0, 'f', 6)
+           .arg(DayOffset);
+}
+
+double AltVsTime::curveStartLST()
+{
+    KStarsDateTime ut = getDate().addSecs((24.0 * DayOffset - 12.0) * 3600.0);
+    return geo->GSTtoLST(ut.gst()).radians();
+}
+
+const QVector<double> &AltVsTime::curve(const SkyPoint *p)
+{
+    const QString key = curveKey(p);
+    auto it           = m_Curves.constFind(key);
+    if (it != m_Curves.constEnd())
+        return it.value();
+
+    if (m_Curves.size() >= MAX_CACHED_CURVES)
+        m_Curves.clear();
+
+    return m_Curves[key] = altitudeCurve(p->ra().radians(), p->dec().radians(), geo->lat()->radians(), curveStartLST());
+}
+
 double AltVsTime::findAltitude(SkyPoint *p, double hour)
 {
     hour += 24.0 * DayOffset;
@@ -989,116 +1049,105 @@ void AltVsTime::slotUpdateDateLoc()
     // Determine dawn/dusk time and min/max sun elevation
     setDawnDusk();
 
+    // Find the positions on the new date, which have to be computed one at a time as
+    // they change the objects
+    struct Curve
+    {
+        double ra { 0 };
+        double dec { 0 };
+        QString key;
+        QVector<double> altitudes;
+        bool cached { false };
+    };
+    QVector<Curve> curves(pList.count());
+
     for (int i = 0; i < pList.count(); ++i)
     {
         SkyObject *o = pList.at(i);
-        if (o)
-        {
-            //If the object is in the solar system, recompute its position for the given date
-            if (o->isSolarSystem())
-            {
-                oldNum = new KSNumbers(data->ut().djd());
-                o->updateCoords(num, true, geo->lat(), &LST, true);
-            }
-
-            //precess coords to target epoch
-            o->updateCoordsNow(num);
-
-            //update pList entry
-            pList.replace(i, o);
+        if (!o)
+            continue;
 
-            // We are creating a new data set (time, altitude) for the new date:
-            QVector<double> time_dataSet, altitude_dataSet;
-            double point_altitudeValue, point_timeValue;
-            // compute the new graph values:
-            // time range: 24h
-            int offset = 3;
-            for (double h = -12.0, i = 0; h <= 12.0; h += 0.25, i++)
-            {
-                point_altitudeValue = findAltitude(o, h);
-                altitude_dataSet.push_back(point_altitudeValue);
-                if (point_altitudeValue > maxAlt)
-                    maxAlt = point_altitudeValue;
-                if (point_altitudeValue < minAlt)
-                    minAlt = point_altitudeValue;
-                point_timeValue = i * 900 + 43200;
-                time_dataSet.push_back(point_timeValue);
-            }
+        //If the object is in the solar system, recompute its position for the given date
+        if (o->isSolarSystem())
+        {
+            oldNum = new KSNumbers(data->ut().djd());
+            o->updateCoords(num, true, geo->lat(), &LST, true);
+        }
 
-            // Replace graph data set:
-            avtUI->View->graph(i)->setData(time_dataSet, altitude_dataSet);
+        //precess coords to target epoch
+        o->updateCoordsNow(num);
 
-            // Go into initial state: without Zoom/Pan
-            avtUI->View->xAxis->setRange(43200, 129600);
-            avtUI->View->xAxis2->setRange(61200, 147600);
+        Curve &c = curves[i];
+        c.ra     = o->ra().radians();
+        c.dec    = o->dec().radians();
+        c.key    = curveKey(o);
+        auto it  = m_Curves.constFind(c.key);
+        c.cached = it != m_Curves.constEnd();
+        if (c.cached)
+            c.altitudes = it.value();
 
-            // Center the altitude axis in 0 value:
-            if (abs(minAlt) > maxAlt)
-                maxAlt = abs(minAlt);
-            else
-                minAlt = -maxAlt;
-            avtUI->View->yAxis->setRange(minAlt - offset, maxAlt + offset);
+        //restore original position
+        if (o->isSolarSystem())
+        {
+            o->updateCoords(oldNum, true, data->geo()->lat(), data->lst());
+            delete oldNum;
+            oldNum = nullptr;
+        }
+        o->EquatorialToHorizontal(data->lst(), data->geo()->lat());
+    }
 
-            // Update background coordinates:
-            background->topLeft->setCoords(avtUI->View->xAxis->range().lower, avtUI->View->yAxis->range().upper);
-            background->bottomRight->setCoords(avtUI->View->xAxis->range().upper, avtUI->View->yAxis->range().lower);
+    // Only the curves not computed before, in parallel
+    const double lat  = geo->lat()->radians();
+    const double lst0 = curveStartLST();
+    Executors::blockingMap(Executors::Interactive, curves, [lat, lst0](Curve & c)
+    {
+        if (!c.cached && !c.key.isEmpty())
+            c.altitudes = altitudeCurve(c.ra, c.dec, lat, lst0);
+    });
 
-            // Redraw the plot:
-            avtUI->View->replot();
+    if (m_Curves.size() + curves.size() > MAX_CACHED_CURVES)
+        m_Curves.clear();
 
-            //restore original position
-            if (o->isSolarSystem())
-            {
-                o->updateCoords(oldNum, true, data->geo()->lat(), data->lst());
-                delete oldNum;
-                oldNum = nullptr;
-            }
-            o->EquatorialToHorizontal(data->lst(), data->geo()->lat());
-        }
-        else //assume unfound object is a custom object
+    int offset = 3;
+    for (int i = 0; i < curves.size(); ++i)
+    {
+        const Curve &c = curves[i];
+        if (c.key.isEmpty())
+            continue;
+        m_Curves.insert(c.key, c.altitudes);
+
+        // We are creating a new data set (time, altitude) for the new date:
+        QVector<double> time_dataSet;
+        for (int k = 0; k < c.altitudes.size(); ++k)
         {
-            pList.at(i)->updateCoordsNow(num); //precess to desired epoch
-
-            // We are creating a new data set (time, altitude) for the new date:
-            QVector<double> time_dataSet, altitude_dataSet;
-            double point_altitudeValue, point_timeValue;
-            // compute the new graph values:
-            // time range: 24h
-            int offset = 3;
-            for (double h = -12.0, i = 0; h <= 12.0; h += 0.25, i++)
-            {
-                point_altitudeValue = findAltitude(pList.at(i), h);
-                altitude_dataSet.push_back(point_altitudeValue);
-                if (point_altitudeValue > maxAlt)
-                    maxAlt = point_altitudeValue;
-                if (point_altitudeValue < minAlt)
-                    minAlt = point_altitudeValue;
-                point_timeValue = i * 900 + 43200;
-                time_dataSet.push_back(point_timeValue);
-            }
+            if (c.altitudes[k] > maxAlt)
+                maxAlt = c.altitudes[k];
+            if (c.altitudes[k] < minAlt)
+                minAlt = c.altitudes[k];
+            time_dataSet.push_back(k * 900 + 43200);
+        }
 
-            // Replace graph data set:
-            avtUI->View->graph(i)->setData(time_dataSet, altitude_dataSet);
+        // Replace graph data set:
+        avtUI->View->graph(i)->setData(time_dataSet, c.altitudes);
+    }
 
-            // Go into initial state: without Zoom/Pan
-            avtUI->View->xAxis->setRange(43200, 129600);
-            avtUI->View->xAxis2->setRange(61200, 147600);
+    // Go into initial state: without Zoom/Pan
+    avtUI->View->xAxis->setRange(43200, 129600);
+    avtUI->View->xAxis2->setRange(61200, 147600);
 
-            // Center the altitude axis in 0 value:
-            if (abs(minAlt) > maxAlt)
-                maxAlt = abs(minAlt);
-            else
-                minAlt = -maxAlt;
-            avtUI->View->yAxis->setRange(minAlt - offset, maxAlt + offset);
+    // Center the altitude axis in 0 value:
+    if (abs(minAlt) > maxAlt)
+        maxAlt = abs(minAlt);
+    else
+        minAlt = -maxAlt;
+    avtUI->View->yAxis->setRange(minAlt - offset, maxAlt + offset);
 
-            // Update background coordinates:
-            background->topLeft->setCoords(avtUI->View->xAxis->range().lower, avtUI->View->yAxis->range().upper);
-            background->bottomRight->setCoords(avtUI->View->xAxis->range().upper, avtUI->View->yAxis->range().lower);
+    // Update background coordinates:
+    background->topLeft->setCoords(avtUI->View->xAxis->range().lower, avtUI->View->yAxis->range().upper);
+    background->bottomRight->setCoords(avtUI->View->xAxis->range().upper, avtUI->View->yAxis->range().lower);
 
-            // Redraw the plot:
-            avtUI->View->replot();
-        }
-    }
+    // Redraw the plot once for all curves:
+    avtUI->View->replot();
 
     if (getDate().time().hour() > 12)
         DayOffset = 1;
@@ -1164,18 +1213,18 @@ void AltVsTime::drawGradient()
     double SunRise, SunSet, Dawn, Dusk, SunMinAlt, SunMaxAlt;
     double MoonRise, MoonSet, MoonIllum;
 
-    KSAlmanac ksal(utt, geoLoc);
+    const auto ksal = KSAlmanac::forDay(utt, geoLoc);
 
     // Get the values:
-    SunRise   = ksal.getSunRise();
-    SunSet    = ksal.getSunSet();
-    SunMaxAlt = ksal.getSunMaxAlt();
-    SunMinAlt = ksal.getSunMinAlt();
-    MoonRise  = ksal.getMoonRise();
-    MoonSet   = ksal.getMoonSet();
-    MoonIllum = ksal.getMoonIllum();
-    Dawn      = ksal.getDawnAstronomicalTwilight();
-    Dusk      = ksal.getDuskAstronomicalTwilight();
+    SunRise   = ksal->getSunRise();
+    SunSet    = ksal->getSunSet();
+    SunMaxAlt = ksal->getSunMaxAlt();
+    SunMinAlt = ksal->getSunMinAlt();
+    MoonRise  = ksal->getMoonRise();
+    MoonSet   = ksal->getMoonSet();
+    MoonIllum = ksal->getMoonIllum();
+    Dawn      = ksal->getDawnAstronomicalTwilight();
+    Dusk      = ksal->getDuskAstronomicalTwilight();
 
     gradient = new QPixmap(avtUI->View->rect().width(), avtUI->View->rect().height());
 
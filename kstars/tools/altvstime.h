@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <QHash>
 #include <QList>
+#include <QVector>
 #include <QDialog>
 
 #include "ui_altvstime.h"
@@ -106,6 +108,13 @@ class AltVsTime : public QDialog
      */
     double findAltitude(SkyPoint *p, double hour);
 
+    /**
+     * @return the altitudes of @p p over the displayed day, as plotted. The curves are cached
+     * by coordinates, location and date, so that objects that were shown before on the same
+     * date are not computed again.
+     */
+    const QVector<double> &curve(const SkyPoint *p);
+
     /**
      * @short get object name. If star has no name, generate a name based on catalog number.
      * @param o sky object.
@@ -186,6 +195,12 @@ class AltVsTime : public QDialog
     /** @short find start of dawn, end of dusk, maximum and minimum elevation of the sun */
     void setDawnDusk();
 
+    /** @return the key of the curve of @p p in the cache */
+    QString curveKey(const SkyPoint *p);
+
+    /** @return the local sidereal time at the start of the displayed day, in radians */
+    double curveStartLST();
+
     AltVsTimeUI *avtUI { nullptr };
 
     GeoLocation *geo { nullptr };
@@ -196,4 +211,6 @@ class AltVsTime : public QDialog
     int maxAlt { 0 };
     QCPItemPixmap *background { nullptr };
     QPixmap *gradient { nullptr };
+    /// Altitude curves by curveKey()
+    QHash<QString, QVector<double>> m_Curves;
 };
@@ -6,8 +6,22 @@
 */
 
 #include "approachsolver.h"
+#include "auxiliary/executors.h"
 #include <kstars_debug.h>
 
+#include <QThread>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+/// Ranges are only split into chunks of at least this many initial steps
+constexpr int MIN_CHUNK_STEPS = 32;
+/// How far beyond its ends every chunk is searched, in initial steps
+constexpr int CHUNK_OVERLAP_STEPS = 4;
+}
+
 ApproachSolver::ApproachSolver(QObject *parent) : QObject(parent)
 {
     m_geoPlace = KStarsData::Instance()->geo();
@@ -22,16 +36,84 @@ void ApproachSolver::setGeoLocation(GeoLocation *geo)
         m_geoPlace = KStarsData::Instance()->geo();
 }
 
-// FIXME: We need a better algo for finding approaches!
 QMap<long double, dms> ApproachSolver::findClosestApproach(long double startJD,
         long double stopJD, std::function<void (long double, dms)> const &callback)
+{
+    const double step0 = findInitialStep(startJD, stopJD);
+
+    int count = std::min<long double>(QThread::idealThreadCount(), (stopJD - startJD) / (MIN_CHUNK_STEPS * step0));
+    std::unique_ptr<ApproachSolver> first;
+    if (count > 1)
+        first = createWorker();
+
+    if (!first)
+        return findApproaches(startJD, stopJD, step0, callback);
+
+    // Every chunk is searched a few steps beyond its ends, so that approaches near the ends are
+    // seen by the chunk they belong to, and keeps only the approaches within its ends
+    struct Chunk
+    {
+        std::unique_ptr<ApproachSolver> solver;
+        long double start;
+        long double stop;
+        QMap<long double, dms> approaches;
+    };
+
+    std::vector<Chunk> chunks(count);
+    const long double length  = (stopJD - startJD) / count;
+    const long double overlap = CHUNK_OVERLAP_STEPS * step0;
+    for (int i = 0; i < count; ++i)
+    {
+        Chunk &chunk = chunks[i];
+        chunk.solver = i == 0 ? std::move(first) : createWorker();
+        chunk.solver->m_geoPlace      = m_geoPlace;
+        chunk.solver->m_maxSeparation = m_maxSeparation;
+        chunk.start                   = startJD + i * length;
+        chunk.stop                    = i == count - 1 ? stopJD : startJD + (i + 1) * length;
+    }
+
+    // The first chunk stands in for the progress of all of them
+    connect(chunks.front().solver.get(), &ApproachSolver::solverMadeProgress, this,
+            &ApproachSolver::solverMadeProgress, Qt::DirectConnection);
+
+    Executors::blockingMap(Executors::Interactive, chunks, [&](Chunk & chunk)
+    {
+        const long double start = std::max(startJD, chunk.start - overlap);
+        const long double stop  = std::min(stopJD, chunk.stop + overlap);
+        const QMap<long double, dms> found = chunk.solver->findApproaches(start, stop, step0, {});
+
+        for (auto it = found.constBegin(); it != found.constEnd(); ++it)
+        {
+            if (it.key() >= chunk.start && (it.key() < chunk.stop || chunk.stop == stopJD))
+                chunk.approaches.insert(it.key(), it.value());
+        }
+    });
+
+    QMap<long double, dms> Separations;
+    for (const Chunk &chunk : chunks)
+    {
+        for (auto it = chunk.approaches.constBegin(); it != chunk.approaches.constEnd(); ++it)
+        {
+            Separations.insert(it.key(), it.value());
+            if (callback)
+                callback(it.key(), it.value());
+        }
+    }
+
+    emit solverMadeProgress(100);
+    return Separations;
+}
+
+// FIXME: We need a better algo for finding approaches!
+QMap<long double, dms> ApproachSolver::findApproaches(long double startJD, long double stopJD, double step0,
+        const std::function<void (long double, dms)> &callback)
 {
     QMap<long double, dms> Separations;
     QPair<long double, dms> extremum;
     dms Dist;
     dms prevDist;
 
-    double step, step0;
+    double step;
     int Sign, prevSign;
 
     //  qCDebug(KSTARS) << "Entered KSConjunct::findClosestApproach() with startJD = " << (double)startJD;
@@ -40,7 +122,6 @@ QMap<long double, dms> ApproachSolver::findClosestApproach(long double startJD,
     //  qCDebug(KSTARS) << m_object2->name() << ": RA = " << m_object2->ra() -> toHMSString() << "; Dec = " << m_object2->dec() -> toDMSString() << "\n";
     prevSign = 0;
 
-    step0 = findInitialStep(startJD, stopJD);
     step = step0;
     //	qCDebug(KSTARS) << "Initial Separation between " << m_object1->name() << " and " << m_object2->name() << " = " << (prevDist.toDMSString());
 
@@ -12,6 +12,7 @@
 
 #include <QObject>
 #include <QMap>
+#include <functional>
 #include <memory>
 
 /**
@@ -42,6 +43,10 @@ public:
     /**
      * @short Compute the closest approach of two planets in the given range
      *
+     * Long ranges are split into chunks that are searched in parallel, if the solver
+     * can create workers, see createWorker(). The callback is called on the calling thread,
+     * in the order of the approaches.
+     *
      * @param startJD  Julian Day corresponding to start of the calculation period
      * @param stopJD   Julian Day corresponding to end of the calculation period
      * @param callback A callback function
@@ -124,9 +129,24 @@ protected:
     bool findPrecise(QPair<long double, dms> *out, long double jd,
                      double step, int prevSign);
 
+    /**
+     * @short Create a solver for the same objects that can search another part of the range
+     * in another thread.
+     *
+     * The base properties, like the location, are copied by findClosestApproach(). The default
+     * returns nullptr, so that the range is searched in one piece by this solver.
+     */
+    virtual std::unique_ptr<ApproachSolver> createWorker() const { return nullptr; }
+
     KSPlanet m_Earth;
 
 private:
+    /**
+     * @short The search of findClosestApproach() over one range, with a given initial step
+     */
+    QMap<long double, dms> findApproaches(long double startJD, long double stopJD, double step0,
+                                          const std::function<void (long double, dms)> &callback);
+
     /**
      * @brief updateAndFindDistance
      * @param jd Julian Date for which to calculate
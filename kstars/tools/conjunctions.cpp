@@ -23,11 +23,16 @@
 #include "skyobjects/kscomet.h"
 #include "skyobjects/kspluto.h"
 #include "ksplanetbase.h"
+#include "auxiliary/executors.h"
 
 #include <QFileDialog>
 #include <QProgressDialog>
 #include <QStandardItemModel>
-#include <QtConcurrent>
+#include <QThread>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
 
 ConjunctionsTool::ConjunctionsTool(QWidget *parentSplit) : QFrame(parentSplit)
 {
@@ -75,7 +80,7 @@ ConjunctionsTool::ConjunctionsTool(QWidget *parentSplit) : QFrame(parentSplit)
     //connect(ComputeButton, SIGNAL(clicked()), this, SLOT(slotCompute()));
     connect(ComputeButton, &QPushButton::clicked, [this]()
     {
-        QtConcurrent::run(this, &ConjunctionsTool::slotCompute);
+        Executors::run(Executors::Background, &ConjunctionsTool::slotCompute, this);
     });
     connect(FilterTypeComboBox, SIGNAL(currentIndexChanged(int)), SLOT(slotFilterType(int)));
     connect(ClearButton, SIGNAL(clicked()), this, SLOT(slotClear()));
@@ -352,22 +357,57 @@ void ConjunctionsTool::slotCompute(void)
         progressDlg.setWindowModality(Qt::WindowModal);
         progressDlg.setValue(0);
 
-        for (auto &object : objects)
+        // The objects are computed in batches of one per core, every one with its own solver
+        // and its own copy of the second object
+        struct Task
+        {
+            QString name;
+            std::unique_ptr<KSConjunct> solver;
+            QMap<long double, dms> conjunctions;
+        };
+
+        const int batchSize = std::max(1, QThread::idealThreadCount());
+        for (int first = 0; first < objects.count(); first += batchSize)
         {
             // If the user click on the 'cancel' button
             if (progressDlg.wasCanceled())
                 break;
 
+            std::vector<Task> batch;
+            for (int i = first; i < std::min<int>(first + batchSize, objects.count()); ++i)
+            {
+                SkyObject *found = data->skyComposite()->findByName(objects[i]);
+                if (found == nullptr)
+                    continue;
+
+                Task task;
+                task.name   = objects[i];
+                task.solver = std::make_unique<KSConjunct>();
+                task.solver->setGeoLocation(geoPlace);
+                task.solver->setMaxSeparation(maxSeparation);
+                task.solver->setOpposition(opposition);
+
+                SkyObject_s object1(found->clone());
+                KSPlanetBase_s object2(static_cast<KSPlanetBase *>(Object2->clone()));
+                task.solver->setObject1(object1);
+                task.solver->setObject2(object2);
+                batch.push_back(std::move(task));
+            }
+
             // Update progress dialog
-            ++progress;
-            progressDlg.setValue(progress);
-            progressDlg.setLabelText(i18n("Compute conjunction between %1 and %2", Object2->name(), object));
+            progressDlg.setLabelText(i18n("Compute conjunction between %1 and %2", Object2->name(), objects[first]));
+
+            // Compute conjuctions
+            Executors::blockingMap(Executors::Background, batch, [startJD, stopJD](Task & task)
+            {
+                task.conjunctions = task.solver->findClosestApproach(startJD, stopJD);
+            });
 
-            // Compute conjuction
-            Object1 = std::shared_ptr<SkyObject>(data->skyComposite()->findByName(object)->clone());
-            ksc.setObject1(Object1);
-            showConjunctions(ksc.findClosestApproach(startJD, stopJD),
-                             object, Object2->name());
+            for (const Task &task : batch)
+                showConjunctions(task.conjunctions, task.name, Object2->name());
+
+            progress = std::min<int>(first + batchSize, objects.count());
+            progressDlg.setValue(progress);
         }
 
         progressDlg.setValue(objects.count());
@@ -12,8 +12,8 @@
 #include "dialogs/locationdialog.h"
 #include "kstars.h"
 #include "skymap.h"
+#include "auxiliary/executors.h"
 
-#include <QtConcurrent>
 #include <QFileDialog>
 #include <QErrorMessage>
 #include <QMenu>
@@ -49,7 +49,7 @@ EclipseTool::EclipseTool(QWidget *parent) :
         // reset progress
         ui->progressBar->setValue(0);
 
-        QtConcurrent::run(this, &EclipseTool::slotCompute);
+        Executors::run(Executors::Background, &EclipseTool::slotCompute, this);
     });
 
     connect(ui->ClearButton, &QPushButton::clicked, &m_model, &EclipseModel::reset);
@@ -10,24 +10,98 @@
 #include "fov.h"
 #include "ksdssdownloader.h"
 #include "kstars.h"
+#include "kstarsdata.h"
 #include "ksnotification.h"
+#include "ksutils.h"
 #include "Options.h"
 #include "skymap.h"
-#include "skyqpainter.h"
+#include "auxiliary/executors.h"
 
 #include <QBitmap>
+#include <QCache>
 #include <QCheckBox>
 #include <QComboBox>
+#include <QFutureInterface>
 #include <QHBoxLayout>
+#include <QImageReader>
 #include <QLabel>
+#include <QPainter>
 #include <QPushButton>
+#include <QSignalBlocker>
 #include <QSlider>
-#include <QSvgGenerator>
-#include <QSvgRenderer>
 #include <QVBoxLayout>
 
 #include <kstars_debug.h>
 
+#include <cmath>
+
+namespace
+{
+// The memory for the cached sky charts, in KB. Charts are only generated on the GUI thread.
+constexpr int ChartCacheSize = 64 * 1024;
+
+QCache<QString, QImage> &chartCache()
+{
+    static QCache<QString, QImage> cache(ChartCacheSize);
+    return cache;
+}
+
+QFuture<EyepieceField::EyepieceView> readyView(const EyepieceField::EyepieceView &view)
+{
+    QFutureInterface<EyepieceField::EyepieceView> future;
+    future.reportStarted();
+    future.reportResult(view);
+    future.reportFinished();
+    return future.future();
+}
+
+/**
+ * @return the size of a DSS image in arcminutes, read from its metadata without decoding it.
+ * Without metadata, the most common DSS scale of 1.01 arcsec/pixel is assumed.
+ */
+QSizeF dssImageSize(const QString &imagePath)
+{
+    QImageReader reader(imagePath);
+    if (reader.text("Author").contains("KStars"))
+    {
+        const QSizeF size(reader.text("Width").toFloat(), reader.text("Height").toFloat());
+        if (size.width() > 0 && size.height() > 0)
+            return size;
+    }
+    return QSizeF(reader.size()) * 1.01 / 60.0;
+}
+
+/**
+ * @return the image at @p imagePath, scaled to @p imageSize, rotated by @p rotation degrees and
+ * centered on a transparent canvas of @p size. This is safe to call outside the GUI thread.
+ */
+QImage prepareSkyImage(const QString &imagePath, const QSize &size, const QSize &imageSize, double rotation)
+{
+    QImage skyImage(size, QImage::Format_ARGB32);
+    skyImage.fill(Qt::transparent);
+
+    const QImage rawImg(imagePath);
+    if (rawImg.isNull())
+    {
+        qWarning() << "Image constructed from " << imagePath
+                   << "is a null image! Are you sure you supplied an image file? Continuing nevertheless...";
+    }
+
+    QImage img = rawImg.scaled(imageSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    if (rotation != 0)
+    {
+        QTransform transform;
+        transform.rotate(rotation);
+        img = img.transformed(transform, Qt::SmoothTransformation);
+    }
+
+    QPainter p(&skyImage);
+    p.drawImage(QPointF(skyImage.width() / 2.0 - img.width() / 2.0, skyImage.height() / 2.0 - img.height() / 2.0), img);
+    p.end();
+    return skyImage;
+}
+}
+
 EyepieceField::EyepieceField(QWidget *parent) : QDialog(parent)
 {
 #ifdef Q_OS_OSX
@@ -123,9 +197,16 @@ EyepieceField::EyepieceField(QWidget *parent) : QDialog(parent)
     connect(m_presetCombo, SIGNAL(currentIndexChanged(int)), this, SLOT(slotEnforcePreset(int)));
     connect(m_presetCombo, SIGNAL(activated(int)), this, SLOT(slotEnforcePreset(int)));
     connect(m_getDSS, SIGNAL(clicked()), this, SLOT(slotDownloadDss()));
+    connect(&m_viewWatcher, &QFutureWatcher<EyepieceView>::finished, this, &EyepieceField::slotViewGenerated);
 }
 
 void EyepieceField::slotEnforcePreset(int index)
+{
+    if (applyPreset(index))
+        render();
+}
+
+bool EyepieceField::applyPreset(int index)
 {
     if (index == -1)
         index = m_presetCombo->currentIndex();
@@ -133,7 +214,7 @@ void EyepieceField::slotEnforcePreset(int index)
         index = 0;
 
     if (index == 0)
-        return; // Preset "None" makes no changes
+        return false; // Preset "None" makes no changes
 
     double altAzRot = (m_usedAltAz ? 0.0 : findNorthAngle(m_sp, KStarsData::Instance()->geo()->lat()).Degrees());
     if (altAzRot > 180.0)
@@ -143,6 +224,14 @@ void EyepieceField::slotEnforcePreset(int index)
         dobRot -= 360.0;
     if (dobRot < -180.0)
         dobRot += 360.0;
+
+    // The view is rendered once for the whole preset, rather than for every control it sets
+    const int rotation = m_rotationSlider->value();
+    const bool invert  = m_invertView->isChecked();
+    const bool flip    = m_flipView->isChecked();
+    const QSignalBlocker rotationBlocker(m_rotationSlider);
+    const QSignalBlocker invertBlocker(m_invertView);
+    const QSignalBlocker flipBlocker(m_flipView);
     switch (index)
     {
         case 1:
@@ -172,6 +261,8 @@ void EyepieceField::slotEnforcePreset(int index)
         default:
             break;
     }
+    return m_rotationSlider->value() != rotation || m_invertView->isChecked() != invert ||
+           m_flipView->isChecked() != flip;
 }
 
 void EyepieceField::showEyepieceField(SkyPoint *sp, FOV const *const fov, const QString &imagePath)
@@ -223,7 +314,8 @@ void EyepieceField::showEyepieceField(SkyPoint *sp, const double fovWidth, doubl
     }
 
     m_usedAltAz = Options::useAltAz();
-    generateEyepieceView(sp, m_skyChart.get(), m_skyImage.get(), fovWidth, fovHeight, imagePath);
+    // The view is shown once the sky image is prepared, the chart is ready right away
+    m_viewWatcher.setFuture(startEyepieceView(sp, fovWidth, fovHeight, imagePath, m_skyImage.get() != nullptr));
 
     // Keep a copy for local purposes (computation of field rotation etc.)
     if (m_sp != sp)
@@ -237,15 +329,25 @@ void EyepieceField::showEyepieceField(SkyPoint *sp, const double fovWidth, doubl
     delete m_dt;
     m_dt = new KStarsDateTime(KStarsData::Instance()->ut());
 
-    // Enforce preset as per selection, since we have loaded a new eyepiece view
-    slotEnforcePreset(-1);
-    // Render the display
-    render();
     m_fovWidth   = fovWidth;
     m_fovHeight  = fovHeight;
     m_currentFOV = nullptr;
 }
 
+void EyepieceField::slotViewGenerated()
+{
+    const EyepieceView view = m_viewWatcher.result();
+    if (!view.skyChart.isNull())
+        *m_skyChart = view.skyChart;
+    if (m_skyImage.get() != nullptr && !view.skyImage.isNull())
+        *m_skyImage = view.skyImage;
+
+    // Enforce preset as per selection, since we have loaded a new eyepiece view
+    applyPreset(-1);
+    // Render the display
+    render();
+}
+
 void EyepieceField::generateEyepieceView(SkyPoint *sp, QImage *skyChart, QImage *skyImage, const FOV *fov,
         const QString &imagePath)
 {
@@ -262,166 +364,123 @@ void EyepieceField::generateEyepieceView(SkyPoint *sp, QImage *skyChart, QImage
 void EyepieceField::generateEyepieceView(SkyPoint *sp, QImage *skyChart, QImage *skyImage, double fovWidth,
         double fovHeight, const QString &imagePath)
 {
-    SkyMap *map = SkyMap::Instance();
-    KStars *ks  = KStars::Instance();
-
-    Q_ASSERT(sp);
-    Q_ASSERT(map);
-    Q_ASSERT(ks);
     Q_ASSERT(skyChart);
-
     if (!skyChart)
         return;
 
-    if (!map) // Requires initialization of Sky map.
+    const EyepieceView view = startEyepieceView(sp, fovWidth, fovHeight, imagePath, skyImage != nullptr).result();
+    if (view.skyChart.isNull())
         return;
 
+    *skyChart = view.skyChart;
+    if (skyImage && !view.skyImage.isNull())
+        *skyImage = view.skyImage;
+}
+
+QFuture<EyepieceField::EyepieceView> EyepieceField::generateEyepieceViewAsync(SkyPoint *sp, double fovWidth,
+        double fovHeight, const QString &imagePath)
+{
+    return startEyepieceView(sp, fovWidth, fovHeight, imagePath, true);
+}
+
+QFuture<EyepieceField::EyepieceView> EyepieceField::startEyepieceView(SkyPoint *sp, double fovWidth, double fovHeight,
+        const QString &imagePath, bool prepareImage)
+{
+    SkyMap *map = SkyMap::Instance();
+
+    Q_ASSERT(sp);
+    Q_ASSERT(map);
+
+    if (!sp || !map) // Requires initialization of Sky map.
+        return readyView(EyepieceView());
+
+    const bool hasImage = QFile::exists(imagePath);
     if (fovWidth <= 0)
     {
-        if (!QFile::exists(imagePath))
-            return;
+        if (!hasImage)
+            return readyView(EyepieceView());
         // Otherwise, we will assume that the user wants the FOV of the image and we'll try to guess it from there
     }
     if (fovHeight <= 0)
         fovHeight = fovWidth;
 
     // Get DSS image width / height
-    double dssWidth = 0, dssHeight = 0;
-
-    if (QFile::exists(imagePath))
+    QSizeF dssSize;
+    if (hasImage)
     {
-        KSDssImage dssImage(imagePath);
-        dssWidth  = dssImage.getMetadata().width;
-        dssHeight = dssImage.getMetadata().height;
-        if (!dssImage.getMetadata().isValid() || dssWidth == 0 || dssHeight == 0)
-        {
-            // Metadata unavailable, guess based on most common DSS arcsec/pixel
-            //const double dssArcSecPerPixel = 1.01;
-            dssWidth  = dssImage.getImage().width() * 1.01 / 60.0;
-            dssHeight = dssImage.getImage().height() * 1.01 / 60.0;
-        }
-        qCDebug(KSTARS) << "DSS width: " << dssWidth << " height: " << dssHeight;
+        dssSize = dssImageSize(imagePath);
+        qCDebug(KSTARS) << "DSS width: " << dssSize.width() << " height: " << dssSize.height();
     }
 
     // Set FOV width/height from DSS if necessary
     if (fovWidth <= 0)
     {
-        fovWidth  = dssWidth;
-        fovHeight = dssHeight;
+        fovWidth  = dssSize.width();
+        fovHeight = dssSize.height();
+        if (fovWidth <= 0 || fovHeight <= 0)
+            return readyView(EyepieceView());
     }
 
-    // Grab the sky chart
-    // Save the current state of the sky map
-    SkyPoint *oldFocus   = map->focus();
-    double oldZoomFactor = Options::zoomFactor();
-
-    // Set the right zoom
-    ks->setApproxFOV(((fovWidth > fovHeight) ? fovWidth : fovHeight) / 15.0);
-
-    //    map->setFocus( sp ); // FIXME: Why does setFocus() need a non-const SkyPoint pointer?
     KStarsData *const data = KStarsData::Instance();
     sp->updateCoords(data->updateNum(), true, data->geo()->lat(), data->lst(), false);
-    map->setClickedPoint(sp);
-    map->slotCenter();
-    qApp->processEvents();
-
-    // Repeat -- dirty workaround for some problem in KStars
-    map->setClickedPoint(sp);
-    map->slotCenter();
-    qApp->processEvents();
 
+    // The chart is the middle of a map four times as wide as the FOV, at twice the resolution of the map
+    const double zoomFactor = KSUtils::clamp(map->width() / (std::max(fovWidth, fovHeight) / 15.0 * dms::DegToRad),
+                              MINZOOM, MAXZOOM);
     // determine screen arcminutes per pixel value
-    const double arcMinToScreen = dms::PI * Options::zoomFactor() / 10800.0;
-
-    // Vector export
-    QTemporaryFile myTempSvgFile;
-    myTempSvgFile.open();
-
-    // export as SVG
-    QSvgGenerator svgGenerator;
-    svgGenerator.setFileName(myTempSvgFile.fileName());
-    // svgGenerator.setTitle(i18n(""));
-    // svgGenerator.setDescription(i18n(""));
-    svgGenerator.setSize(QSize(map->width(), map->height()));
-    svgGenerator.setResolution(qMax(map->logicalDpiX(), map->logicalDpiY()));
-    svgGenerator.setViewBox(QRect(map->width() / 2.0 - arcMinToScreen * fovWidth / 2.0,
-                                  map->height() / 2.0 - arcMinToScreen * fovHeight / 2.0, arcMinToScreen * fovWidth,
-                                  arcMinToScreen * fovHeight));
-
-    SkyQPainter painter(KStars::Instance(), &svgGenerator);
-    painter.begin();
-
-    map->exportSkyImage(&painter);
-
-    painter.end();
-
-    // Render SVG file on raster QImage canvas
-    QSvgRenderer svgRenderer(myTempSvgFile.fileName());
-    QImage *mySkyChart = new QImage(arcMinToScreen * fovWidth * 2.0, arcMinToScreen * fovHeight * 2.0,
-                                    QImage::Format_ARGB32); // 2 times bigger in both dimensions.
-    QPainter p2(mySkyChart);
-    svgRenderer.render(&p2);
-    p2.end();
-    *skyChart = *mySkyChart;
-    delete mySkyChart;
-
-    myTempSvgFile.close();
-
-    // Reset the sky-map
-    map->setZoomFactor(oldZoomFactor);
-    map->setClickedPoint(oldFocus);
-    map->slotCenter();
-    qApp->processEvents();
-
-    // Repeat -- dirty workaround for some problem in KStars
-    map->setZoomFactor(oldZoomFactor);
-    map->setClickedPoint(oldFocus);
-    map->slotCenter();
-    qApp->processEvents();
-    map->forceUpdate();
-
-    // Prepare the sky image
-    if (QFile::exists(imagePath) && skyImage)
+    const double arcMinToScreen = dms::PI * zoomFactor / 10800.0;
+
+    // Charts of the same field are reused, until the time moves on by a minute
+    const QString key = QString("%1 %2 %3 %4 %5 %6 %7 %8 %9")
+                        .arg(sp->ra().Degrees(), 0, 'f', 6)
+                        .arg(sp->dec().Degrees(), 0, 'f', 6)
+                        .arg(fovWidth)
+                        .arg(fovHeight)
+                        .arg(Options::useAltAz() ? 1 : 0)
+                        .arg(map->width())
+                        .arg(map->height())
+                        .arg(data->colorScheme()->fileName())
+                        .arg(static_cast<qint64>(std::floor(data->ut().djd() * 1440.0)));
+
+    QImage skyChart;
+    if (const QImage *chart = chartCache().object(key))
     {
-        QImage *mySkyImage = new QImage(int(arcMinToScreen * fovWidth * 2.0), int(arcMinToScreen * fovHeight * 2.0),
-                                        QImage::Format_ARGB32);
-
-        mySkyImage->fill(Qt::transparent);
-
-        QPainter p(mySkyImage);
-        QImage rawImg(imagePath);
-
-        if (rawImg.isNull())
-        {
-            qWarning() << "Image constructed from " << imagePath
-                       << "is a null image! Are you sure you supplied an image file? Continuing nevertheless...";
-        }
-
-        QImage img     = rawImg.scaled(arcMinToScreen * dssWidth * 2.0, arcMinToScreen * dssHeight * 2.0,
-                                       Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
-        const auto ksd = KStarsData::Instance();
-        sp->updateCoordsNow(ksd->updateNum());
-
-        if (Options::useAltAz())
-        {
-            // Need to rotate the image so that up is towards zenith rather than north.
-            sp->EquatorialToHorizontal(ksd->lst(), ksd->geo()->lat());
-            dms northBearing = findNorthAngle(sp, ksd->geo()->lat());
-            qCDebug(KSTARS) << "North angle = " << northBearing.toDMSString();
-
-            QTransform transform;
+        skyChart = *chart;
+    }
+    else
+    {
+        const QRectF rect(map->width() / 2.0 - arcMinToScreen * fovWidth / 2.0,
+                          map->height() / 2.0 - arcMinToScreen * fovHeight / 2.0, arcMinToScreen * fovWidth,
+                          arcMinToScreen * fovHeight);
+        skyChart = QImage(int(arcMinToScreen * fovWidth * 2.0), int(arcMinToScreen * fovHeight * 2.0),
+                          QImage::Format_ARGB32); // 2 times bigger in both dimensions.
+        if (skyChart.isNull())
+            return readyView(EyepieceView());
+
+        map->exportSkyView(&skyChart, *sp, zoomFactor, rect);
+        chartCache().insert(key, new QImage(skyChart), std::max<int>(1, skyChart.sizeInBytes() / 1024));
+    }
 
-            transform.rotate(northBearing.Degrees());
-            img = img.transformed(transform, Qt::SmoothTransformation);
-        }
-        p.drawImage(
-            QPointF(mySkyImage->width() / 2.0 - img.width() / 2.0, mySkyImage->height() / 2.0 - img.height() / 2.0),
-            img);
-        p.end();
+    if (!hasImage || !prepareImage)
+        return readyView({ skyChart, QImage() });
 
-        *skyImage = *mySkyImage;
-        delete mySkyImage;
+    // Prepare the sky image
+    sp->updateCoordsNow(data->updateNum());
+    double northAngle = 0;
+    if (Options::useAltAz())
+    {
+        // Need to rotate the image so that up is towards zenith rather than north.
+        sp->EquatorialToHorizontal(data->lst(), data->geo()->lat());
+        dms northBearing = findNorthAngle(sp, data->geo()->lat());
+        qCDebug(KSTARS) << "North angle = " << northBearing.toDMSString();
+        northAngle = northBearing.Degrees();
     }
+
+    const QSize imageSize(int(arcMinToScreen * dssSize.width() * 2.0), int(arcMinToScreen * dssSize.height() * 2.0));
+    return Executors::run(Executors::Interactive, [skyChart, imagePath, imageSize, northAngle]()
+    {
+        return EyepieceView { skyChart, prepareSkyImage(imagePath, skyChart.size(), imageSize, northAngle) };
+    });
 }
 
 void EyepieceField::renderEyepieceView(const QImage *skyChart, QPixmap *renderChart, const double rotation,
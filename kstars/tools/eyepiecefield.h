@@ -9,6 +9,8 @@
 #include "dms.h"
 
 #include <QDialog>
+#include <QFutureWatcher>
+#include <QImage>
 #include <QPixmap>
 #include <QTemporaryFile>
 
@@ -16,7 +18,6 @@
 
 class QCheckBox;
 class QComboBox;
-class QImage;
 class QLabel;
 class QPushButton;
 class QSlider;
@@ -38,6 +39,13 @@ class EyepieceField : public QDialog // FIXME: Rename to EyepieceView
     Q_OBJECT
 
   public:
+    /** @short The images of an eyepiece view, see generateEyepieceView() */
+    struct EyepieceView
+    {
+        QImage skyChart;
+        QImage skyImage;
+    };
+
     /** Constructor */
     explicit EyepieceField(QWidget *parent = nullptr);
 
@@ -89,6 +97,16 @@ class EyepieceField : public QDialog // FIXME: Rename to EyepieceView
     static void generateEyepieceView(SkyPoint *sp, QImage *skyChart, QImage *skyImage = nullptr,
                                      const FOV *fov = nullptr, const QString &imagePath = QString());
 
+    /**
+     * @short Generate the eyepiece field view and corresponding image view, the sky image in the background
+     * The arguments are those of generateEyepieceView(). The sky chart is drawn through the sky map
+     * on the calling thread, which must be the GUI thread, or taken from the charts of the last fields.
+     * The sky image is read, scaled and oriented on a worker thread.
+     * @return the future of the view, with a null sky chart if the view can not be generated
+     */
+    static QFuture<EyepieceView> generateEyepieceViewAsync(SkyPoint *sp, double fovWidth = -1.0,
+            double fovHeight = -1.0, const QString &imagePath = QString());
+
     /**
      * @short Orients the eyepiece view as needed, performs overlaying etc.
      * @param skyChart image which contains the sky chart, possibly generated using generateEyepieceView
@@ -146,7 +164,20 @@ class EyepieceField : public QDialog // FIXME: Rename to EyepieceView
     /** Loads a downloaded DSS image */
     void slotDssDownloaded(bool success);
 
+    /** Shows a generated eyepiece view */
+    void slotViewGenerated();
+
   private:
+    /**
+     * @short Sets the controls of a preset without rendering the view
+     * @return true if any control changed
+     */
+    bool applyPreset(int index);
+
+    /** @short generateEyepieceViewAsync(), without the sky image unless @p prepareImage */
+    static QFuture<EyepieceView> startEyepieceView(SkyPoint *sp, double fovWidth, double fovHeight,
+            const QString &imagePath, bool prepareImage);
+
     QLabel *m_skyChartDisplay { nullptr };
     QLabel *m_skyImageDisplay { nullptr };
     std::unique_ptr<QImage> m_skyChart;
@@ -168,4 +199,5 @@ class EyepieceField : public QDialog // FIXME: Rename to EyepieceView
     QTemporaryFile m_tempFile;
     QPixmap m_renderImage, m_renderChart;
     bool m_usedAltAz { false };
+    QFutureWatcher<EyepieceView> m_viewWatcher;
 };
@@ -23,6 +23,8 @@
 #include <QKeyEvent>
 #include <QVBoxLayout>
 
+#include <vector>
+
 JMoonTool::JMoonTool(QWidget *parent) : QDialog(parent)
 {
     QFrame *page = new QFrame(this);
@@ -132,10 +134,19 @@ void JMoonTool::initPlotObjects()
     */
 
     //t is the offset from jd0, in days.
+    std::vector<double> offsets;
+    std::vector<long double> jds;
     for (double t = dataRect.y(); t <= dataRect.bottom(); t += dy)
     {
-        KSNumbers num(jd0 + t);
-        jm.findPosition(&num, jup, ksun);
+        offsets.push_back(t);
+        jds.push_back(jd0 + t);
+    }
+    const std::vector<KSNumbers> numbers = KSNumbers::forJulianDays(jds);
+
+    for (std::size_t k = 0; k < numbers.size(); ++k)
+    {
+        const double t = offsets[k];
+        jm.findPosition(&numbers[k], jup, ksun);
 
         //jm.x(i) tells the offset from Jupiter, in units of Jupiter's angular radius.
         //multiply by 0.5*jup->angSize() to get arcminutes
@@ -46,6 +46,18 @@ void KSConjunct::updatePositions(long double jd)
     m_object2->findPosition(&num, getGeoLocation()->lat(), &LST, &m_Earth);
 }
 
+std::unique_ptr<ApproachSolver> KSConjunct::createWorker() const
+{
+    if (!m_object1 || !m_object2)
+        return nullptr;
+
+    auto worker = std::make_unique<KSConjunct>();
+    worker->m_object1    = SkyObject_s(m_object1->clone());
+    worker->m_object2    = KSPlanetBase_s(static_cast<KSPlanetBase *>(m_object2->clone()));
+    worker->m_opposition = m_opposition;
+    return worker;
+}
+
 double KSConjunct::findInitialStep(long double startJD, long double stopJD)
 {
 
@@ -38,6 +38,8 @@ signals:
 protected:
     double findInitialStep(long double startJD, long double stopJD) override;
     void updatePositions(long double jd) override;
+    /** @return a solver with its own copies of both objects */
+    std::unique_ptr<ApproachSolver> createWorker() const override;
 
 private:
     dms findDistance() override;
@@ -25,12 +25,16 @@
 #include "obslistwizard.h"
 #include "Options.h"
 #include "sessionsortfilterproxymodel.h"
+#include "auxiliary/batchvisibility.h"
+#include "auxiliary/executors.h"
 #include "skymap.h"
 #include "thumbnailpicker.h"
 #include "dialogs/detaildialog.h"
 #include "dialogs/finddialog.h"
 #include "dialogs/locationdialog.h"
 #include "oal/execute.h"
+#include "printing/finderchart.h"
+#include "printing/finderchartbatch.h"
 #include "skycomponents/skymapcomposite.h"
 #include "skyobjects/skyobject.h"
 #include "skyobjects/starobject.h"
@@ -50,6 +54,7 @@
 #include <KPlotting/KPlotObject>
 #include <KMessageBox>
 #include <QMessageBox>
+#include <QSignalBlocker>
 
 #include <kstars_debug.h>
 
@@ -61,6 +66,67 @@ ObservingListUI::ObservingListUI(QWidget *p) : QFrame(p)
     setupUi(this);
 }
 
+//
+// ObservingList::TimeColumns
+// ---------------------------------
+struct ObservingList::TimeColumns
+{
+    explicit TimeColumns(const GeoLocation &_geo) : geo(_geo) {}
+
+    /** @short Fill points and times, which only reads the copies below and may run on any thread */
+    void compute();
+
+    GeoLocation geo;
+    KStarsDateTime now;
+    /// UT of the local midnight that begins the date of the session
+    KStarsDateTime midnight;
+    /// Keeps the objects alive until their rows are updated. The first wishListSize are those of the wish list.
+    QList<QSharedPointer<SkyObject>> objects;
+    int wishListSize { 0 };
+    /// Coordinates of date of the objects, in degrees
+    QVector<double> ra, dec;
+    /// The times set by the user for the objects of the session, null for their transit
+    QVector<QTime> scheduled;
+
+    /// Horizontal coordinates now for the wish list, and at the time of observation for the session
+    QVector<SkyPoint> points;
+    /// Local times of observation for the session
+    QVector<QTime> times;
+};
+
+void ObservingList::TimeColumns::compute()
+{
+    points.resize(ra.size());
+    times.resize(ra.size());
+
+    auto toHorizontal = [this](int i, const KStarsDateTime &ut)
+    {
+        SkyPoint &p = points[i];
+        p.setRA(ra[i] / 15.0);
+        p.setDec(dec[i]);
+        const dms LST = geo.GSTtoLST(ut.gst());
+        p.EquatorialToHorizontal(&LST, geo.lat());
+    };
+
+    for (int i = 0; i < wishListSize; ++i)
+        toHorizontal(i, now);
+
+    if (ra.size() == wishListSize)
+        return;
+
+    // Objects of the session are observed at the times set by the user, or else at their transit during the date
+    BatchVisibility visibility(geo, midnight, midnight.addSecs(24 * 3600), 0.5);
+    const QVector<BatchVisibility::Result> transits = visibility.compute(ra.mid(wishListSize), dec.mid(wishListSize));
+    for (int i = wishListSize; i < ra.size(); ++i)
+    {
+        const QTime &time = scheduled[i - wishListSize];
+        const KStarsDateTime ut = time.isValid() ? midnight.addSecs(QTime(0, 0).secsTo(time)) :
+                                  KStarsDateTime(static_cast<long double>(transits[i - wishListSize].transitJD));
+        times[i] = time.isValid() ? time : QTime(0, 0).addSecs(qRound(static_cast<double>(ut.djd() - midnight.djd()) * 86400.0));
+        toHorizontal(i, ut);
+    }
+}
+
 //
 // ObservingList
 // ---------------------------------
@@ -112,8 +178,7 @@ ObservingList::ObservingList()
     ui->SessionView->setModel(m_SessionSortModel.get());
     ui->SessionView->horizontalHeader()->setStretchLastSection(true);
     ui->SessionView->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
-    ksal.reset(new KSAlmanac);
-    ksal->setLocation(geo);
+    ksal = KSAlmanac::forDay(KStarsDateTime(KStarsData::Instance()->lt().date(), QTime(), Qt::LocalTime), geo);
     ui->avt->setGeoLocation(geo);
     ui->avt->setSunRiseSetTimes(ksal->getSunRise(), ksal->getSunSet());
     ui->avt->setLimits(-12.0, 12.0, -90.0, 90.0);
@@ -151,6 +216,18 @@ ObservingList::ObservingList()
     connect(ui->saveImages, SIGNAL(clicked()), this, SLOT(slotSaveAllImages()));
     connect(ui->DeleteAllImages, SIGNAL(clicked()), this, SLOT(slotDeleteAllImages()));
     connect(ui->OALExport, SIGNAL(clicked()), this, SLOT(slotOALExport()));
+    connect(ui->printFinderCharts, &QPushButton::clicked, this, &ObservingList::slotPrintFinderCharts);
+    connect(&m_TimeColumnsWatcher, &QFutureWatcher<void>::finished, this, &ObservingList::slotTimeColumnsReady);
+
+    // Adding or removing many objects resizes the columns once, rather than for every row
+    m_resizeColumnsTimer = new QTimer(this);
+    m_resizeColumnsTimer->setSingleShot(true);
+    m_resizeColumnsTimer->setInterval(100);
+    connect(m_resizeColumnsTimer, &QTimer::timeout, this, [this]()
+    {
+        ui->WishListView->resizeColumnsToContents();
+        ui->SessionView->resizeColumnsToContents();
+    });
     connect(ui->clearListB, SIGNAL(clicked()), this, SLOT(slotClearList()));
     //Add icons to Push Buttons
     ui->OpenButton->setIcon(QIcon::fromTheme("document-open"));
@@ -169,6 +246,7 @@ ObservingList::ObservingList()
     ui->TimeEdit->setEnabled(false);
     ui->SearchImage->setEnabled(false);
     ui->saveImages->setEnabled(false);
+    ui->printFinderCharts->setEnabled(false);
     ui->DeleteImage->setEnabled(false);
     ui->OALExport->setEnabled(false);
 
@@ -350,7 +428,7 @@ void ObservingList::slotAddObject(const SkyObject *_obj, bool session, bool upda
 
         //Note addition in statusbar
         KStars::Instance()->statusBar()->showMessage(i18n("Added %1 to observing list.", finalObjectName), 0);
-        ui->WishListView->resizeColumnsToContents();
+        scheduleResizeColumns();
         if (!update)
             slotSaveList();
     }
@@ -385,7 +463,7 @@ void ObservingList::slotAddObject(const SkyObject *_obj, bool session, bool upda
         m_SessionModel->appendRow(itemList);
         //Adding an object should trigger the modified flag
         isModified = true;
-        ui->SessionView->resizeColumnsToContents();
+        scheduleResizeColumns();
         //Note addition in statusbar
         KStars::Instance()->statusBar()->showMessage(i18n("Added %1 to session list.", finalObjectName), 0);
         SkyMap::Instance()->forceUpdate();
@@ -421,6 +499,7 @@ void ObservingList::slotRemoveObject(const SkyObject *_o, bool session, bool upd
 
     // Remove from hash
     ImagePreviewHash.remove(o.data());
+    m_PlotCache.remove(o.data());
 
     if (o.data() == LogObject)
         saveCurrentUserLog();
@@ -441,7 +520,7 @@ void ObservingList::slotRemoveObject(const SkyObject *_o, bool session, bool upd
     {
         obsList().removeAt(k);
         ui->avt->removeAllPlotObjects();
-        ui->WishListView->resizeColumnsToContents();
+        scheduleResizeColumns();
         if (!update)
             slotSaveList();
     }
@@ -452,7 +531,7 @@ void ObservingList::slotRemoveObject(const SkyObject *_o, bool session, bool upd
         sessionList().removeAt(k); //Remove from the session list
         isModified = true;         //Removing an object should trigger the modified flag
         ui->avt->removeAllPlotObjects();
-        ui->SessionView->resizeColumnsToContents();
+        scheduleResizeColumns();
         SkyMap::Instance()->forceUpdate();
     }
 }
@@ -914,6 +993,7 @@ void ObservingList::slotOpenList()
         ui->tabWidget->setCurrentIndex(1); // FIXME: This is not robust -- asimha
         slotChangeTab(1);
 
+        m_PlotCache.clear();
         sessionList().clear();
         TimeHash.clear();
         m_CurrentObject = nullptr;
@@ -972,12 +1052,14 @@ void ObservingList::slotClearList()
         {
             // IMPORTANT: Is this enough or we will have dangling pointers in memory?
             ImagePreviewHash.clear();
+            m_PlotCache.clear();
             obsList().clear();
             m_WishListModel->setRowCount(0);
         }
         else
         {
             // IMPORTANT: Is this enough or we will have dangling pointers in memory?
+            m_PlotCache.clear();
             sessionList().clear();
             TimeHash.clear();
             isModified = true; //Removing an object should trigger the modified flag
@@ -1230,8 +1312,7 @@ void ObservingList::plot(SkyObject *o)
         h1 -= 24.0;
 
     ui->avt->setSecondaryLimits(h1, h1 + 24.0, -90.0, 90.0);
-    ksal->setLocation(geo);
-    ksal->setDate(ut);
+    ksal = KSAlmanac::forDay(ut, geo);
     ui->avt->setGeoLocation(geo);
     ui->avt->setSunRiseSetTimes(ksal->getSunRise(), ksal->getSunSet());
     ui->avt->setDawnDuskTimes(ksal->getDawnAstronomicalTwilight(), ksal->getDuskAstronomicalTwilight());
@@ -1239,11 +1320,18 @@ void ObservingList::plot(SkyObject *o)
     ui->avt->setMoonRiseSetTimes(ksal->getMoonRise(), ksal->getMoonSet());
     ui->avt->setMoonIllum(ksal->getMoonIllum());
     ui->avt->update();
-    KPlotObject *po = new KPlotObject(Qt::white, KPlotObject::Lines, 2.0);
-    for (double h = -12.0; h <= 12.0; h += 0.5)
+    // The curve only changes with the date, the location and the time set for the object
+    QVector<QPointF> &curve = m_PlotCache[o];
+    if (curve.isEmpty())
     {
-        po->addPoint(h, findAltitude(o, (h + DayOffset * 24.0)));
+        for (double h = -12.0; h <= 12.0; h += 0.5)
+        {
+            curve.append(QPointF(h, findAltitude(o, (h + DayOffset * 24.0))));
+        }
     }
+    KPlotObject *po = new KPlotObject(Qt::white, KPlotObject::Lines, 2.0);
+    for (const QPointF &point : curve)
+        po->addPoint(point);
     ui->avt->removeAllPlotObjects();
     ui->avt->addPlotObject(po);
 }
@@ -1290,6 +1378,7 @@ void ObservingList::slotLocation()
     {
         geo = ld->selectedCity();
         ui->SetLocation->setText(geo->fullName());
+        m_PlotCache.clear();
     }
     delete ld;
 }
@@ -1297,27 +1386,127 @@ void ObservingList::slotLocation()
 void ObservingList::slotUpdate()
 {
     dt.setDate(ui->DateEdit->date());
-    ui->avt->removeAllPlotObjects();
-    //Creating a copy of the lists, we can't use the original lists as they'll keep getting modified as the loop iterates
-    QList<QSharedPointer<SkyObject>> _obsList = m_WishList, _SessionList = m_SessionList;
+    // The rows stay, only the columns that depend on the date, the location and the times are recomputed
+    m_PlotCache.clear();
+    updateTimeColumns();
+    if (m_CurrentObject)
+        plot(m_CurrentObject);
+    else
+        ui->avt->removeAllPlotObjects();
+    SkyMap::Instance()->forceUpdate();
+}
+
+void ObservingList::updateTimeColumns()
+{
+    if (m_TimeColumnsWatcher.isRunning())
+    {
+        m_TimeColumnsPending = true;
+        return;
+    }
+
+    std::shared_ptr<TimeColumns> columns = std::make_shared<TimeColumns>(*geo);
+    columns->now      = KStarsDateTime::currentDateTimeUtc();
+    columns->midnight = geo->LTtoUT(KStarsDateTime(QDateTime(dt.date(), QTime())));
 
-    for (QSharedPointer<SkyObject> &o : _obsList)
+    QList<SkyObject *> wishList, session;
+    for (const QSharedPointer<SkyObject> &o : m_WishList)
     {
-        if (o->name() != "star")
+        columns->objects.append(o);
+        wishList.append(o.data());
+    }
+    for (const QSharedPointer<SkyObject> &o : m_SessionList)
+    {
+        columns->objects.append(o);
+        session.append(o.data());
+        columns->scheduled.append(TimeHash.value(getObjectName(o.data())));
+    }
+    columns->wishListSize = wishList.size();
+
+    // Solar system objects are recomputed here, on the GUI thread. The rest only reads the copies.
+    QVector<double> ra, dec;
+    BatchVisibility::coordinatesOfDate(wishList, columns->now, geo, columns->ra, columns->dec);
+    BatchVisibility::coordinatesOfDate(session, columns->midnight.addSecs(12 * 3600), geo, ra, dec);
+    columns->ra += ra;
+    columns->dec += dec;
+
+    m_TimeColumns = columns;
+    m_TimeColumnsWatcher.setFuture(Executors::run(Executors::Interactive, [columns]()
+    {
+        columns->compute();
+    }));
+}
+
+void ObservingList::slotTimeColumnsReady()
+{
+    std::shared_ptr<TimeColumns> columns = std::move(m_TimeColumns);
+    if (m_TimeColumnsPending)
+    {
+        // The lists or the date changed meanwhile
+        m_TimeColumnsPending = false;
+        updateTimeColumns();
+        return;
+    }
+    if (!columns)
+        return;
+
+    // An object can be in both lists, so the rows of each list are found separately
+    auto objectOfRow = [](QStandardItemModel * model, int row)
+    {
+        return static_cast<const SkyObject *>(model->item(row, 0)->data(Qt::UserRole + 1).value<void *>());
+    };
+    auto setText = [](QStandardItem * item, const QString & text)
+    {
+        item->setText(text);
+        item->setData(text, Qt::UserRole);
+    };
+
+    QHash<const SkyObject *, int> wishList, session;
+    for (int i = 0; i < columns->objects.size(); ++i)
+        (i < columns->wishListSize ? wishList : session).insert(columns->objects[i].data(), i);
+
+    // The items are changed without a signal each, the views are told once per list
+    const int altColumn = m_WishListModel->columnCount() - 1;
+    {
+        const QSignalBlocker blocker(m_WishListModel.get());
+        for (int row = 0; row < m_WishListModel->rowCount(); ++row)
         {
-            slotRemoveObject(o.data(), false, true);
-            slotAddObject(o.data(), false, true);
+            const int i          = wishList.value(objectOfRow(m_WishListModel.get(), row), -1);
+            QStandardItem *item = m_WishListModel->item(row, altColumn);
+            if (i < 0 || !item)
+                continue;
+            QStandardItem *replacement = m_altCostHelper(columns->points[i]);
+            item->setData(replacement->data(Qt::DisplayRole), Qt::DisplayRole);
+            item->setData(replacement->data(Qt::UserRole), Qt::UserRole);
+            delete replacement;
         }
     }
-    for (QSharedPointer<SkyObject> &obj : _SessionList)
+    if (m_WishListModel->rowCount() > 0)
+        emit m_WishListModel->dataChanged(m_WishListModel->index(0, altColumn),
+                                          m_WishListModel->index(m_WishListModel->rowCount() - 1, altColumn));
+
+    // The columns of the session are Time, Alt and Az
+    const int timeColumn = 7;
     {
-        if (obj->name() != "star")
+        const QSignalBlocker blocker(m_SessionModel.get());
+        for (int row = 0; row < m_SessionModel->rowCount(); ++row)
         {
-            slotRemoveObject(obj.data(), true, true);
-            slotAddObject(obj.data(), true, true);
+            const int i = session.value(objectOfRow(m_SessionModel.get(), row), -1);
+            if (i < 0 || m_SessionModel->columnCount() < timeColumn + 3 || !m_SessionModel->item(row, timeColumn + 2))
+                continue;
+            const SkyPoint &p = columns->points[i];
+            m_SessionModel->item(row, timeColumn)->setData(columns->times[i], Qt::DisplayRole);
+            setText(m_SessionModel->item(row, timeColumn + 1), p.alt().toDMSString());
+            setText(m_SessionModel->item(row, timeColumn + 2), p.az().toDMSString());
         }
     }
-    SkyMap::Instance()->forceUpdate();
+    if (m_SessionModel->rowCount() > 0 && m_SessionModel->columnCount() >= timeColumn + 3)
+        emit m_SessionModel->dataChanged(m_SessionModel->index(0, timeColumn),
+                                         m_SessionModel->index(m_SessionModel->rowCount() - 1, timeColumn + 2));
+}
+
+void ObservingList::scheduleResizeColumns()
+{
+    m_resizeColumnsTimer->start();
 }
 
 void ObservingList::slotSetTime()
@@ -1325,6 +1514,7 @@ void ObservingList::slotSetTime()
     SkyObject *o = currentObject();
     slotRemoveObject(o, true);
     TimeHash[o->name()] = ui->TimeEdit->time();
+    m_PlotCache.remove(o);
     slotAddObject(o, true, true);
 }
 
@@ -1544,6 +1734,7 @@ void ObservingList::slotDeleteAllImages()
 void ObservingList::setSaveImagesButton()
 {
     ui->saveImages->setEnabled(!getActiveList().isEmpty());
+    ui->printFinderCharts->setEnabled(!getActiveList().isEmpty());
 }
 
 // FIXME: Is there a reason to implement these as an event filter,
@@ -1674,6 +1865,51 @@ void ObservingList::slotOALExport()
     slotSaveSessionAs(false);
 }
 
+void ObservingList::slotPrintFinderCharts()
+{
+    if (getActiveList().isEmpty())
+        return;
+
+    // The charts show the first visible FOV symbol, as in the printing wizard
+    QList<FOV *> fovs = KStarsData::Instance()->getVisibleFOVs();
+    if (fovs.isEmpty())
+        fovs = KStarsData::Instance()->getAvailableFOVs();
+    if (fovs.isEmpty())
+    {
+        KSNotification::sorry(i18n("Please define a field of view symbol to print finder charts."));
+        return;
+    }
+
+    const QString fileName = QFileDialog::getSaveFileName(this, i18nc("@title:window", "Print Finder Charts"),
+                             QDir::homePath(), i18n("PDF Files (*.pdf)"));
+    if (fileName.isEmpty())
+        return;
+
+    QList<SkyObject *> objects;
+    for (const QSharedPointer<SkyObject> &o : getActiveList())
+        objects.append(o.data());
+
+    QProgressDialog progress(i18n("Drawing finder charts..."), i18n("Cancel"), 0, objects.size(), this);
+    progress.setWindowModality(Qt::WindowModal);
+    progress.setMinimumDuration(500);
+
+    FinderChart document;
+    document.insertTitleSubtitle(i18n("Observing List"), sessionView ? i18n("Session Plan") : i18n("Wish List"));
+    document.insertGeoTimeInfo(KStarsData::Instance()->ut(), KStarsData::Instance()->geo());
+
+    // Charts can not be larger than the sky map they are drawn through
+    const SkyMap *map = SkyMap::Instance();
+    const int chartSize = qMin(500, qMin(map->width(), map->height()));
+    FinderChartBatch batch(fovs.first(), QSize(chartSize, chartSize));
+    const bool done = batch.insertCharts(&document, objects, [&progress](int count)
+    {
+        progress.setValue(count);
+        return !progress.wasCanceled();
+    });
+    if (done)
+        document.writePsPdf(fileName);
+}
+
 void ObservingList::slotAddVisibleObj()
 {
     KStarsDateTime lt = dt;
@@ -1748,24 +1984,7 @@ QString ObservingList::getObjectName(const SkyObject *o, bool translated)
 void ObservingList::slotUpdateAltitudes()
 {
     // FIXME: Update upon gaining visibility, do not update when not visible
-    KStarsDateTime now = KStarsDateTime::currentDateTimeUtc();
-    //    qCDebug(KSTARS) << "Updating altitudes in observation planner @ JD - J2000 = " << double( now.djd() - J2000 );
-    for (int irow = m_WishListModel->rowCount() - 1; irow >= 0; --irow)
-    {
-        QModelIndex idx = m_WishListSortModel->mapToSource(m_WishListSortModel->index(irow, 0));
-        SkyObject *o    = static_cast<SkyObject *>(idx.data(Qt::UserRole + 1).value<void *>());
-        Q_ASSERT(o);
-        SkyPoint p = o->recomputeHorizontalCoords(now, geo);
-        idx =
-            m_WishListSortModel->mapToSource(m_WishListSortModel->index(irow, m_WishListSortModel->columnCount() - 1));
-        QStandardItem *replacement = m_altCostHelper(p);
-        m_WishListModel->setData(idx, replacement->data(Qt::DisplayRole), Qt::DisplayRole);
-        m_WishListModel->setData(idx, replacement->data(Qt::UserRole), Qt::UserRole);
-        delete replacement;
-    }
-    emit m_WishListModel->dataChanged(
-        m_WishListModel->index(0, m_WishListModel->columnCount() - 1),
-        m_WishListModel->index(m_WishListModel->rowCount() - 1, m_WishListModel->columnCount() - 1));
+    updateTimeColumns();
 }
 
 QSharedPointer<SkyObject> ObservingList::findObject(const SkyObject *o, bool session)
@@ -14,9 +14,13 @@
 #include <QAbstractTableModel>
 #include <QDialog>
 #include <QFrame>
+#include <QFutureWatcher>
+#include <QHash>
 #include <QList>
 #include <QPixmap>
+#include <QPointF>
 #include <QTime>
+#include <QVector>
 
 #include <functional>
 #include <memory>
@@ -329,6 +333,10 @@ class ObservingList : public QDialog
             */
     void slotOALExport();
 
+    /** @short Print the finder charts of the objects of the current list to a PDF file
+            */
+    void slotPrintFinderCharts();
+
     void slotAddVisibleObj();
 
     /**
@@ -349,6 +357,8 @@ class ObservingList : public QDialog
   protected slots:
     void slotClose();
     void downloadReady(bool success);
+    /** @short Show the time dependent columns computed by updateTimeColumns() */
+    void slotTimeColumnsReady();
 
   protected:
     void showEvent(QShowEvent *) override;
@@ -387,7 +397,20 @@ class ObservingList : public QDialog
          */
     inline QModelIndexList getSelectedItems() const { return getActiveView()->selectionModel()->selectedRows(); }
 
-    std::unique_ptr<KSAlmanac> ksal;
+    /**
+         * @short Recompute the current altitudes of the wish list, and the times and positions of the session.
+         * The coordinates of date are found right away, the rest in the background, and the columns of the
+         * rows are updated in place when it is done.
+         */
+    void updateTimeColumns();
+
+    /** @short Resize the columns of the views once, after a series of changes */
+    void scheduleResizeColumns();
+
+    /** The time dependent columns of the lists, defined in the source file */
+    struct TimeColumns;
+
+    std::shared_ptr<const KSAlmanac> ksal;
     ObservingListUI *ui { nullptr };
     QList<QSharedPointer<SkyObject>> m_WishList, m_SessionList;
     SkyObject *LogObject { nullptr };
@@ -413,5 +436,11 @@ class ObservingList : public QDialog
     QTimer *m_altitudeUpdater { nullptr };
     std::function<QStandardItem *(const SkyPoint &)> m_altCostHelper;
     bool m_initialWishlistLoad { false };
+    QFutureWatcher<void> m_TimeColumnsWatcher;
+    std::shared_ptr<TimeColumns> m_TimeColumns;
+    bool m_TimeColumnsPending { false };
+    QTimer *m_resizeColumnsTimer { nullptr };
+    /// The altitude curves of the objects for the date and location of the session
+    QHash<const SkyObject *, QVector<QPointF>> m_PlotCache;
     CatalogsDB::DBManager m_manager;
 };
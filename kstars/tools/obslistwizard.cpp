@@ -7,6 +7,7 @@
 #include "obslistwizard.h"
 #include "Options.h"
 
+#include "auxiliary/batchvisibility.h"
 #include "geolocation.h"
 #include "kstarsdata.h"
 #include "dialogs/locationdialog.h"
@@ -16,6 +17,10 @@
 #include "catalogobject.h"
 #include "catalogsdb.h"
 
+#include <QSet>
+
+#include <algorithm>
+
 ObsListWizardUI::ObsListWizardUI(QWidget *p) : QFrame(p)
 {
     setupUi(this);
@@ -138,7 +143,7 @@ void ObsListWizard::initialize()
     PlanNebCount     = 0;
     GalaxyCount      = 0;
 
-    CatalogsDB::DBManager manager{ CatalogsDB::dso_db_path() };
+    auto &manager = CatalogsDB::thread_reader();
 
     const auto &stats{ manager.get_master_statistics() };
     if (!stats.first)
@@ -431,6 +436,7 @@ void ObsListWizard::applyFilters(bool doBuildList)
     KStarsData *data = KStarsData::Instance();
     if (doBuildList)
         obsList().clear();
+    ObservableCandidates.clear();
 
     //We don't need to call applyRegionFilter() if no region filter is selected.
     bool needRegion = !isItemSelected(i18n(ALL_OVER_THE_SKY), olw->RegionList);
@@ -483,7 +489,7 @@ void ObsListWizard::applyFilters(bool doBuildList)
 
     if (dso)
     {
-        CatalogsDB::DBManager manager{ CatalogsDB::dso_db_path() };
+        auto &manager = CatalogsDB::thread_reader();
         CatalogsDB::CatalogObjectList cObjectList = manager.get_objects_all(); // JFD: Can't skip faint objects because counting down
 
         for (auto &o : cObjectList)
@@ -538,6 +544,9 @@ void ObsListWizard::applyFilters(bool doBuildList)
             applyMagnitudeAndRegionAndObservableFilter(o, filterParameters);
     }
 
+    if (needDate)
+        applyObservableFilter(doBuildList);
+
     //Update the object count label
     if (doBuildList)
         ObjectCount = obsList().size();
@@ -651,13 +660,18 @@ bool ObsListWizard::applyRegionFilter(SkyObject *o, bool doBuildList)
     return true;
 }
 
+bool ObsListWizard::applyObservableFilter(SkyObject *o, bool doBuildList)
+{
+    Q_UNUSED(doBuildList)
+    ObservableCandidates.append(o);
+    return true;
+}
+
 /** This routine will remove any item from the obsList if doBuildList is set which means
  *  it was added before in the previous filter.
  */
-bool ObsListWizard::applyObservableFilter(SkyObject *o, bool doBuildList)
+void ObsListWizard::applyObservableFilter(bool doBuildList)
 {
-    SkyPoint p = *o;
-
     //Check altitude of object every hour from 18:00 to midnight
     //If it's ever above 15 degrees, flag it as visible
     KStarsDateTime Evening(olw->Date->date(), QTime(18, 0, 0), Qt::LocalTime);
@@ -686,27 +700,42 @@ bool ObsListWizard::applyObservableFilter(SkyObject *o, bool doBuildList)
     minAlt = olw->minAlt->value();
     maxAlt = olw->maxAlt->value();
 
+    // The current coordinates of all candidates, checked every hour of the range at once
+    QVector<double> ra(ObservableCandidates.size()), dec(ObservableCandidates.size());
+    for (int i = 0; i < ObservableCandidates.size(); ++i)
+    {
+        ra[i]  = ObservableCandidates[i]->ra().Degrees();
+        dec[i] = ObservableCandidates[i]->dec().Degrees();
+    }
+
+    BatchVisibility visibility(*geo, Evening, Midnight, 1.0);
+    visibility.setAltitudeRange(minAlt, maxAlt);
+    const QVector<BatchVisibility::Result> results = visibility.compute(ra, dec);
+
     // This is the "relaxed" search mode
     // where if the object obeys the restrictions in 50% of the time of the range
     // then it qualifies as "visible"
-    double totalCount = 0, visibleCount = 0;
-    for (KStarsDateTime t = Evening; t < Midnight; t = t.addSecs(3600.0))
+    QSet<SkyObject *> rejected;
+    for (int i = 0; i < ObservableCandidates.size(); ++i)
     {
-        dms LST = geo->GSTtoLST(t.gst());
-        p.EquatorialToHorizontal(&LST, geo->lat());
-        totalCount++;
-        if (p.alt().Degrees() >= minAlt && p.alt().Degrees() <= maxAlt)
-            visibleCount++;
-    }
+        // If the object is within the min/max alt at least coverage % of the time range
+        // then consider it visible
+        if (visibility.sampleCount() > 0 && results[i].fractionVisible >= olw->coverage->value() / 100.0)
+            continue;
 
-    // If the object is within the min/max alt at least coverage % of the time range
-    // then consider it visible
-    if (visibleCount / totalCount >= olw->coverage->value() / 100.0)
-        return true;
+        ObjectCount--;
+        if (doBuildList)
+            rejected.insert(ObservableCandidates[i]);
+    }
 
-    ObjectCount--;
-    if (doBuildList)
-        obsList().takeAt(obsList().indexOf(o));
+    if (!rejected.isEmpty())
+    {
+        auto &list = obsList();
+        list.erase(std::remove_if(list.begin(), list.end(), [&](SkyObject * o)
+        {
+            return rejected.contains(o);
+        }), list.end());
+    }
 
-    return false;
+    ObservableCandidates.clear();
 }
@@ -77,7 +77,9 @@ class ObsListWizard : public QDialog
     bool applyMagnitudeAndRegionAndObservableFilter(SkyObject *o, FilterParameters filterParameters);
     bool applyMagnitudeFilter(SkyObject *o, FilterParameters filterParameters);
     bool applyRegionFilter(SkyObject *o, bool doBuildList);
+    /** Only collects the object, applyObservableFilter(bool) tests all of them at once. */
     bool applyObservableFilter(SkyObject *o, bool doBuildList);
+    void applyObservableFilter(bool doBuildList);
 
     /**
      * Convenience function for safely getting the selected state of a QListWidget item by name.
@@ -98,6 +100,8 @@ class ObsListWizard : public QDialog
     void setItemSelected(const QString &name, QListWidget *listWidget, bool value);
 
     QList<SkyObject *> ObsList;
+    /// Objects that passed the other filters, waiting for the observable filter
+    QList<SkyObject *> ObservableCandidates;
     ObsListWizardUI *olw { nullptr };
     uint ObjectCount { 0 };
     uint StarCount { 0 };
@@ -7,20 +7,50 @@
 #include "skycalendar.h"
 
 #include "geolocation.h"
+#include "ksnumbers.h"
+#include "ksplanet.h"
 #include "ksplanetbase.h"
 #include "kstarsdata.h"
 #include "dialogs/locationdialog.h"
 #include "skycomponents/skymapcomposite.h"
+#include "auxiliary/executors.h"
 
 #include <KPlotObject>
 
+#include <QFutureWatcher>
 #include <QPainter>
 #include <QPixmap>
 #include <QPrintDialog>
 #include <QPrinter>
 #include <QPushButton>
 #include <QScreen>
-#include <QtConcurrent>
+
+#include <cmath>
+
+namespace
+{
+// Rotation of the Earth relative to the stars, in radians per day of UT
+constexpr double SiderealRate = 2.0 * dms::PI * 1.00273790935;
+
+double wrapAngle(double angle)
+{
+    angle = std::fmod(angle, 2.0 * dms::PI);
+    if (angle > dms::PI)
+        angle -= 2.0 * dms::PI;
+    else if (angle <= -dms::PI)
+        angle += 2.0 * dms::PI;
+    return angle;
+}
+
+// Hours from local midnight, with the hours after noon counted back from the midnight before
+float plotTime(double hours)
+{
+    hours = std::fmod(hours, 24.0);
+    if (hours < 0)
+        hours += 24.0;
+    return hours <= 12.0 ? hours : hours - 24.0;
+}
+}
 
 SkyCalendarUI::SkyCalendarUI(QWidget *parent) : QFrame(parent)
 {
@@ -90,22 +120,60 @@ void SkyCalendar::slotFillCalendar()
     scUI->CalendarView->resetPlot();
     scUI->CalendarView->setHorizon();
 
-    if (scUI->checkBox_Mercury->isChecked())
-        QtConcurrent::run(this, &SkyCalendar::addPlanetEvents, KSPlanetBase::MERCURY);
-    if (scUI->checkBox_Venus->isChecked())
-        QtConcurrent::run(this, &SkyCalendar::addPlanetEvents, KSPlanetBase::VENUS);
-    if (scUI->checkBox_Mars->isChecked())
-        QtConcurrent::run(this, &SkyCalendar::addPlanetEvents, KSPlanetBase::MARS);
-    if (scUI->checkBox_Jupiter->isChecked())
-        QtConcurrent::run(this, &SkyCalendar::addPlanetEvents, KSPlanetBase::JUPITER);
-    if (scUI->checkBox_Saturn->isChecked())
-        QtConcurrent::run(this, &SkyCalendar::addPlanetEvents, KSPlanetBase::SATURN);
-    if (scUI->checkBox_Uranus->isChecked())
-        QtConcurrent::run(this, &SkyCalendar::addPlanetEvents, KSPlanetBase::URANUS);
-    if (scUI->checkBox_Neptune->isChecked())
-        QtConcurrent::run(this, &SkyCalendar::addPlanetEvents, KSPlanetBase::NEPTUNE);
-
-    scUI->CreateButton->setText(i18n("Plot Planetary Almanac"));
+    const int generation = ++m_Generation;
+
+    // Time zone rules are applied here, the calculations only take UT
+    QVector<Day> days;
+    for (KStarsDateTime kdt(QDate(year(), 1, 1), QTime(12, 0, 0)); kdt.date().year() == year();
+            kdt = kdt.addDays(scUI->spinBox_Interval->value()))
+    {
+        days.append({ static_cast<double>(geo->LTtoUT(kdt).djd()),
+                      static_cast<float>(kdt.date().daysInYear() - kdt.date().dayOfYear()) });
+    }
+
+    const QList<QPair<QCheckBox *, int>> planets =
+    {
+        { scUI->checkBox_Mercury, KSPlanetBase::MERCURY }, { scUI->checkBox_Venus, KSPlanetBase::VENUS },
+        { scUI->checkBox_Mars, KSPlanetBase::MARS }, { scUI->checkBox_Jupiter, KSPlanetBase::JUPITER },
+        { scUI->checkBox_Saturn, KSPlanetBase::SATURN }, { scUI->checkBox_Uranus, KSPlanetBase::URANUS },
+        { scUI->checkBox_Neptune, KSPlanetBase::NEPTUNE }
+    };
+
+    // Every planet is computed in a worker of its own, and plotted as soon as it is done
+    SkyMapComposite *composite = KStarsData::Instance()->skyComposite();
+    m_Pending = 0;
+    for (const auto &planet : planets)
+    {
+        if (!planet.first->isChecked())
+            continue;
+
+        std::shared_ptr<KSPlanetBase> ksp(static_cast<KSPlanetBase *>(composite->planet(planet.second)->clone()));
+        std::shared_ptr<KSPlanet> earth(composite->earth()->clone());
+        ksp->clearTrail();
+        earth->clearTrail();
+
+        auto *watcher = new QFutureWatcher<PlanetEvents>(this);
+        connect(watcher, &QFutureWatcher<PlanetEvents>::finished, this, [this, watcher, generation]()
+        {
+            if (generation == m_Generation)
+            {
+                addPlanetEvents(watcher->result());
+                if (--m_Pending == 0)
+                    finishCalendar();
+            }
+            watcher->deleteLater();
+        });
+        watcher->setFuture(Executors::run(Executors::Interactive, &SkyCalendar::computePlanetEvents, ksp, earth, GeoLocation(*geo), days));
+        ++m_Pending;
+    }
+
+    if (m_Pending == 0)
+        finishCalendar();
+}
+
+void SkyCalendar::finishCalendar()
+{
+    scUI->CreateButton->setText(plotButtonText);
     scUI->CreateButton->setEnabled(true);
 }
 
@@ -157,73 +225,99 @@ void SkyCalendar::drawEventLabel( float x1, float y1, float x2, float y2, QStrin
 }
 */
 
-void SkyCalendar::addPlanetEvents(int nPlanet)
+SkyCalendar::PlanetEvents SkyCalendar::computePlanetEvents(std::shared_ptr<KSPlanetBase> planet,
+        std::shared_ptr<KSPlanet> earth, const GeoLocation &geo, const QVector<Day> &days)
 {
-    KSPlanetBase *ksp = KStarsData::Instance()->skyComposite()->planet(nPlanet);
-    QColor pColor     = ksp->color();
-    //QVector<QPointF> vRise, vSet, vTransit;
-    std::vector<QPointF> vRise, vSet, vTransit;
-
-    for (KStarsDateTime kdt(QDate(year(), 1, 1), QTime(12, 0, 0)); kdt.date().year() == year();
-            kdt = kdt.addDays(scUI->spinBox_Interval->value()))
-    {
-        float rTime, sTime, tTime;
+    PlanetEvents events;
+    events.name  = planet->name();
+    events.color = planet->color();
 
-        //Compute rise/set/transit times.  If they occur before noon,
-        //recompute for the following day
-        QTime tmp_rTime = ksp->riseSetTime(kdt, geo, true, true);  //rise time, exact
-        QTime tmp_sTime = ksp->riseSetTime(kdt, geo, false, true); //set time, exact
-        QTime tmp_tTime = ksp->transitTime(kdt, geo);
-        QTime midday(12, 0, 0);
+    // The altitude of the rise and set of the planets, see SkyObject::elevationCorrection()
+    const double h0     = dms(-0.5667).radians();
+    const double sinLat = std::sin(geo.lat()->radians());
+    const double cosLat = std::cos(geo.lat()->radians());
 
-        // NOTE: riseSetTime should be fix now, this test is no longer necessary
-        if (tmp_rTime == tmp_sTime)
+    for (const Day &day : days)
+    {
+        // The coordinates of date at the ends of the day around the local noon. The planets move
+        // little enough in a day for linear interpolants, on which the events are solved.
+        double ra[2], dec[2];
+        for (int i = 0; i < 2; ++i)
         {
-            tmp_rTime = QTime();
-            tmp_sTime = QTime();
+            KSNumbers num(day.noonJD + i - 0.5);
+            earth->findPosition(&num);
+            planet->findPosition(&num, nullptr, nullptr, earth.get());
+            ra[i]  = planet->ra().radians();
+            dec[i] = planet->dec().radians();
         }
+        const double raRate  = wrapAngle(ra[1] - ra[0]);
+        const double decRate = dec[1] - dec[0];
+        const double noonLST = geo.GSTtoLST(KStarsDateTime(static_cast<long double>(day.noonJD)).gst()).radians();
 
-        if (tmp_rTime.isValid() && tmp_sTime.isValid())
+        // Hour angle and declination at t days from the local noon
+        auto hourAngle = [&](double t)
+        {
+            return wrapAngle(noonLST + SiderealRate * t - ra[0] - raRate * (t + 0.5));
+        };
+        auto declination = [&](double t)
         {
-            rTime = tmp_rTime.secsTo(midday) * 24.0 / 86400.0;
-            sTime = tmp_sTime.secsTo(midday) * 24.0 / 86400.0;
+            return dec[0] + decRate * (t + 0.5);
+        };
 
-            if (tmp_rTime <= midday)
-                rTime = 12.0 - rTime;
-            else
-                rTime = -12.0 - rTime;
+        double transit = 0;
+        for (int i = 0; i < 3; ++i)
+            transit -= hourAngle(transit) / (SiderealRate - raRate);
 
-            if (tmp_sTime <= midday)
-                sTime = 12.0 - sTime;
-            else
-                sTime = -12.0 - sTime;
-        }
-        else
+        float rTime, sTime;
+        const double decTransit = declination(transit);
+        const double cosH0 = (std::sin(h0) - sinLat * std::sin(decTransit)) / (cosLat * std::cos(decTransit));
+        if (std::fabs(cosH0) < 1.0)
         {
-            if (ksp->transitAltitude(kdt, geo).degree() > 0)
+            // Newton steps on the altitude, from the hour angle of the horizon at the transit
+            auto solve = [&](double t)
             {
-                rTime = -24.0;
-                sTime = 24.0;
-            }
-            else
-            {
-                rTime = 24.0;
-                sTime = -24.0;
-            }
+                for (int i = 0; i < 3; ++i)
+                {
+                    const double H = hourAngle(t), d = declination(t);
+                    const double sinAlt = sinLat * std::sin(d) + cosLat * std::cos(d) * std::cos(H);
+                    const double slope = -cosLat * std::cos(d) * std::sin(H) * (SiderealRate - raRate);
+                    if (slope == 0)
+                        break;
+                    t -= (sinAlt - std::sin(h0)) / slope;
+                }
+                return t;
+            };
+            const double H0 = std::acos(cosH0) / (SiderealRate - raRate);
+            rTime = plotTime(12.0 + 24.0 * solve(transit - H0));
+            sTime = plotTime(12.0 + 24.0 * solve(transit + H0));
+        }
+        else if (cosH0 <= -1.0)
+        {
+            // Always above the horizon
+            rTime = -24.0;
+            sTime = 24.0;
         }
-
-        tTime = tmp_tTime.secsTo(midday) * 24.0 / 86400.0;
-        if (tmp_tTime <= midday)
-            tTime = 12.0 - tTime;
         else
-            tTime = -12.0 - tTime;
+        {
+            rTime = 24.0;
+            sTime = -24.0;
+        }
 
-        float dy = kdt.date().daysInYear() - kdt.date().dayOfYear();
-        vRise.push_back(QPointF(rTime, dy));
-        vSet.push_back(QPointF(sTime, dy));
-        vTransit.push_back(QPointF(tTime, dy));
+        events.rise.push_back(QPointF(rTime, day.daysLeft));
+        events.set.push_back(QPointF(sTime, day.daysLeft));
+        events.transit.push_back(QPointF(plotTime(12.0 + 24.0 * transit), day.daysLeft));
     }
 
+    return events;
+}
+
+void SkyCalendar::addPlanetEvents(const PlanetEvents &events)
+{
+    const QColor &pColor                = events.color;
+    const std::vector<QPointF> &vRise    = events.rise;
+    const std::vector<QPointF> &vSet     = events.set;
+    const std::vector<QPointF> &vTransit = events.transit;
+
     //Now, find continuous segments in each QVector and add each segment
     //as a separate KPlotObject
 
@@ -322,7 +416,7 @@ void SkyCalendar::addPlanetEvents(int nPlanet)
             }
 
             if (needRiseLabel)
-                label = i18nc("A planet rises from the horizon", "%1 rises", ksp->name());
+                label = i18nc("A planet rises from the horizon", "%1 rises", events.name);
             else
                 label = QString();
             // Add the current point to KPlotObject
@@ -344,7 +438,7 @@ void SkyCalendar::addPlanetEvents(int nPlanet)
             }
 
             if (needSetLabel)
-                label = i18nc("A planet sets from the horizon", "%1 sets", ksp->name());
+                label = i18nc("A planet sets from the horizon", "%1 sets", events.name);
             else
                 label = QString();
 
@@ -366,7 +460,7 @@ void SkyCalendar::addPlanetEvents(int nPlanet)
             }
 
             if (needTransertLabel)
-                label = i18nc("A planet transits across the meridian", "%1 transits", ksp->name());
+                label = i18nc("A planet transits across the meridian", "%1 transits", events.name);
             else
                 label = QString();
 
@@ -6,12 +6,20 @@
 
 #pragma once
 
+#include <QColor>
 #include <QDialog>
 #include <QMutex>
+#include <QPointF>
+#include <QVector>
 
 #include "ui_skycalendar.h"
 
+#include <memory>
+#include <vector>
+
 class GeoLocation;
+class KSPlanet;
+class KSPlanetBase;
 
 class SkyCalendarUI : public QFrame, public Ui::SkyCalendar
 {
@@ -46,7 +54,31 @@ class SkyCalendar : public QDialog
     //void slotCalculating();
 
   private:
-    void addPlanetEvents(int nPlanet);
+    /** A day of the calendar */
+    struct Day
+    {
+        /// UT Julian day of the local noon
+        double noonJD;
+        /// Days left in the year, the y of the plot
+        float daysLeft;
+    };
+
+    /** Rise, set and transit of a planet on the days of the calendar, as points of the plot */
+    struct PlanetEvents
+    {
+        QString name;
+        QColor color;
+        std::vector<QPointF> rise, set, transit;
+    };
+
+    /**
+     * @short Compute the events of @p planet on @p days.
+     * The planet and the Earth are copies owned by the calculation, so that it can run in a worker thread.
+     */
+    static PlanetEvents computePlanetEvents(std::shared_ptr<KSPlanetBase> planet, std::shared_ptr<KSPlanet> earth,
+                                            const GeoLocation &geo, const QVector<Day> &days);
+    void addPlanetEvents(const PlanetEvents &events);
+    void finishCalendar();
     void drawEventLabel(float x1, float y1, float x2, float y2, QString LabelText);
 
     SkyCalendarUI *scUI { nullptr };
@@ -54,4 +86,8 @@ class SkyCalendar : public QDialog
     QMutex calculationMutex;
     QString plotButtonText;
     bool calculating { false };
+    /// Increased for every new calendar, results of an older one are dropped
+    int m_Generation { 0 };
+    /// Planets of the current calendar that are still computed
+    int m_Pending { 0 };
 };
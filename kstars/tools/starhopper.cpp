@@ -13,6 +13,121 @@
 
 #include <kstars_debug.h>
 
+#include <QSet>
+
+#include <Eigen/Core>
+
+#include <cmath>
+#include <queue>
+#include <vector>
+
+/**
+ * @class StarHopGrid
+ * @short The candidate stars of a star hop, hashed into cells of the unit sphere.
+ *
+ * The search asks for the stars around every node it expands and every star it costs. Instead
+ * of a StarComponent query each time, the stars of the whole region of the hop are queried once
+ * and their unit vectors are put into cubic cells as wide as the field of view, so that the stars
+ * within a field of view of any point are in the 27 cells around it.
+ */
+class StarHopGrid
+{
+    public:
+        struct Neighbor
+        {
+            StarObject *star;
+            // Degrees
+            double distance;
+        };
+
+        StarHopGrid(const QList<StarObject *> &stars, double cellDegrees)
+            : m_CellDegrees(cellDegrees), m_CellSize(chord(cellDegrees))
+        {
+            m_Stars.reserve(stars.size());
+            for (StarObject *star : stars)
+            {
+                m_Stars.push_back({ star, toVector(*star) });
+                m_Cells[key(m_Stars.back().vector)].append(static_cast<int>(m_Stars.size() - 1));
+            }
+        }
+
+        /**
+         * @return the stars within @p radius degrees of @p center, no larger than the cells, and
+         * no fainter than @p maglim, as StarComponent::starsInAperture() would find them
+         */
+        QVector<Neighbor> near(const SkyPoint &center, double radius, double maglim) const
+        {
+            Q_ASSERT(radius <= m_CellDegrees);
+            const Eigen::Vector3d vector = toVector(center);
+            const double maxChord = chord(radius);
+            const qint64 x = cell(vector.x()), y = cell(vector.y()), z = cell(vector.z());
+
+            QVector<Neighbor> neighbors;
+            for (qint64 dx = -1; dx <= 1; ++dx)
+                for (qint64 dy = -1; dy <= 1; ++dy)
+                    for (qint64 dz = -1; dz <= 1; ++dz)
+                    {
+                        auto entry = m_Cells.constFind(key(x + dx, y + dy, z + dz));
+                        if (entry == m_Cells.constEnd())
+                            continue;
+                        for (int index : *entry)
+                        {
+                            const Star &star = m_Stars[index];
+                            const double distance = (star.vector - vector).norm();
+                            if (distance <= maxChord && star.star->mag() <= maglim)
+                                neighbors.append({ star.star, 2 * std::asin(distance / 2) / dms::DegToRad });
+                        }
+                    }
+            return neighbors;
+        }
+
+    private:
+        struct Star
+        {
+            StarObject *star;
+            Eigen::Vector3d vector;
+        };
+
+        // The straight line distance between two points on the unit sphere @p degrees apart
+        static double chord(double degrees)
+        {
+            return 2 * std::sin(degrees * dms::DegToRad / 2);
+        }
+
+        static Eigen::Vector3d toVector(const SkyPoint &point)
+        {
+            const double ra = point.ra().radians(), dec = point.dec().radians();
+            return Eigen::Vector3d(std::cos(dec) * std::cos(ra), std::cos(dec) * std::sin(ra), std::sin(dec));
+        }
+
+        qint64 cell(double coordinate) const
+        {
+            return static_cast<qint64>(std::floor(coordinate / m_CellSize));
+        }
+
+        static quint64 key(qint64 x, qint64 y, qint64 z)
+        {
+            // Cells are at most 2^20 apart from the center of the sphere
+            constexpr qint64 offset = 1 << 20;
+            return (static_cast<quint64>(x + offset) << 42) | (static_cast<quint64>(y + offset) << 21) |
+                   static_cast<quint64>(z + offset);
+        }
+
+        quint64 key(const Eigen::Vector3d &vector) const
+        {
+            return key(cell(vector.x()), cell(vector.y()), cell(vector.z()));
+        }
+
+        double m_CellDegrees;
+        double m_CellSize;
+        std::vector<Star> m_Stars;
+        QHash<quint64, QVector<int>> m_Cells;
+};
+
+StarHopper::StarHopper() = default;
+
+StarHopper::~StarHopper() = default;
+
 QList<StarObject *> *StarHopper::computePath(const SkyPoint &src, const SkyPoint &dest, float fov__, float maglim__,
                                              QStringList *metadata_)
 {
@@ -35,40 +150,55 @@ QList<const StarObject *> StarHopper::computePath_const(const SkyPoint &src, con
 
     came_from.clear();
     result_path.clear();
+    patternNames.clear();
+    nodeCosts.clear();
 
     // Implements the A* search algorithm
 
-    QList<SkyPoint const *> cSet;
-    QList<SkyPoint const *> oSet;
+    QSet<SkyPoint const *> cSet;
+    QSet<SkyPoint const *> oSet;
     QHash<SkyPoint const *, double> g_score;
     QHash<SkyPoint const *, double> f_score;
     QHash<SkyPoint const *, double> h_score;
 
+    // The open set ordered by f_score, lowest first. A node whose score improves is pushed
+    // again, and the entries with an outdated score are skipped once they come up.
+    typedef std::pair<double, SkyPoint const *> ScoredNode;
+    auto higher = [](const ScoredNode & a, const ScoredNode & b)
+    {
+        return a.first > b.first;
+    };
+    std::priority_queue<ScoredNode, std::vector<ScoredNode>, decltype(higher)> oQueue(higher);
+
     qCDebug(KSTARS) << "StarHopper is trying to compute a path from source: " << src.ra().toHMSString()
              << src.dec().toDMSString() << " to destination: " << dest.ra().toHMSString() << dest.dec().toDMSString()
              << "; a starhop of " << src.angularDistanceTo(&dest).Degrees() << " degrees!";
 
-    oSet.append(&src);
+    // Nodes more than 1.2 times the hop from the destination are not expanded, and the stars
+    // around a node are looked for within a field of view, for the neighbors and their costs.
+    const double hop = src.angularDistanceTo(&dest).Degrees();
+    SkyPoint center = dest;
+    center.catalogueCoord(KStarsData::Instance()->updateNum()->julianDay());
+    QList<StarObject *> stars;
+    StarComponent::Instance()->starsInAperture(stars, center, 1.2 * hop + 2 * fov, maglim + 1.0);
+    grid.reset(new StarHopGrid(stars, fov));
+    qCDebug(KSTARS) << "Considering " << stars.count() << " stars around the hop";
+
+    oSet.insert(&src);
     g_score[&src] = 0;
-    h_score[&src] = src.angularDistanceTo(&dest).Degrees() / fov;
+    h_score[&src] = hop / fov;
     f_score[&src] = h_score[&src];
+    oQueue.push(ScoredNode(f_score[&src], &src));
 
-    while (!oSet.isEmpty())
+    while (!oQueue.empty())
     {
         qCDebug(KSTARS) << "Next step";
         // Find the node with the lowest f_score value
-        SkyPoint const *curr_node = nullptr;
-        double lowfscore          = 1.0e8;
-
-        foreach (const SkyPoint *sp, oSet)
-        {
-            if (f_score[sp] < lowfscore)
-            {
-                lowfscore = f_score[sp];
-                curr_node = sp;
-            }
-        }
-        if (curr_node == nullptr)
+        const ScoredNode lowest = oQueue.top();
+        oQueue.pop();
+        SkyPoint const *curr_node = lowest.second;
+        const double lowfscore    = lowest.first;
+        if (!oSet.contains(curr_node) || lowfscore != f_score[curr_node])
             continue;
 
         qCDebug(KSTARS) << "Lowest fscore (vertex distance-plus-cost score) is " << lowfscore
@@ -118,11 +248,12 @@ QList<const StarObject *> StarHopper::computePath_const(const SkyPoint &src, con
             }
             qCDebug(KSTARS) << "  The destination is within a field-of-view";
 
+            grid.reset();
             return result_path;
         }
 
-        oSet.removeOne(curr_node);
-        cSet.append(curr_node);
+        oSet.remove(curr_node);
+        cSet.insert(curr_node);
 
         // FIXME: Make sense. If current node ---> dest distance is
         // larger than src --> dest distance by more than 20%, don't
@@ -136,23 +267,14 @@ QList<const StarObject *> StarHopper::computePath_const(const SkyPoint &src, con
         }
 
         // Get the list of stars that are neighbours of this node
-        QList<StarObject *> neighbors;
-
-        // FIXME: Actually, this should be done in
-        // HorizontalToEquatorial, but we do it here because SkyPoint
-        // needs a lot of fixing to handle unprecessed and precessed,
-        // equatorial and horizontal coordinates nicely
-        SkyPoint *CurrentNode = const_cast<SkyPoint *>(curr_node);
-        //CurrentNode->deprecess(KStarsData::Instance()->updateNum());
-        CurrentNode->catalogueCoord(KStarsData::Instance()->updateNum()->julianDay());
-        //qCDebug(KSTARS) << "Calling starsInAperture";
-        StarComponent::Instance()->starsInAperture(neighbors, *curr_node, fov, maglim);
+        const QVector<StarHopGrid::Neighbor> neighbors = grid->near(*curr_node, fov, maglim);
         qCDebug(KSTARS) << "Choosing next node from a set of " << neighbors.count();
         // Look for the potential next node
         double curr_g_score = g_score[curr_node];
 
-        for (auto &nhd_node : neighbors)
+        for (const auto &neighbor : neighbors)
         {
+            const StarObject *nhd_node = neighbor.star;
             if (cSet.contains(nhd_node))
                 continue;
 
@@ -161,7 +283,7 @@ QList<const StarObject *> StarHopper::computePath_const(const SkyPoint &src, con
             bool tentative_better;
             if (!oSet.contains(nhd_node))
             {
-                oSet.append(nhd_node);
+                oSet.insert(nhd_node);
                 tentative_better = true;
             }
             else if (tentative_g_score < g_score[nhd_node])
@@ -175,9 +297,11 @@ QList<const StarObject *> StarHopper::computePath_const(const SkyPoint &src, con
                 g_score[nhd_node]   = tentative_g_score;
                 h_score[nhd_node]   = nhd_node->angularDistanceTo(&dest).Degrees() / fov;
                 f_score[nhd_node]   = g_score[nhd_node] + h_score[nhd_node];
+                oQueue.push(ScoredNode(f_score[nhd_node], nhd_node));
             }
         }
     }
+    grid.reset();
     qCDebug(KSTARS) << "REGRET! Returning empty list!";
     return QList<StarObject const *>(); // Return an empty QList
 }
@@ -198,14 +322,33 @@ float StarHopper::cost(const SkyPoint *curr, const SkyPoint *next)
     // This is a very heuristic method, that tries to produce a cost
     // for each hop.
 
-    float netcost = 0;
-
     // Convert 'next' into a StarObject
     if (next == start)
     {
         // If the next hop is back to square one, junk it
         return 1e8;
     }
+
+    // Tests 1 to 3, 6 and 7 only depend on the star, and are computed once
+    auto memo = nodeCosts.constFind(next);
+    const double nodecost = (memo != nodeCosts.constEnd()) ? *memo : (nodeCosts[next] = nodeCost(next));
+
+    // Test 4: How far is the hop?
+    double distcost =
+        (curr->angularDistanceTo(next).Degrees() /
+         fov); // 1 "magnitude" incremental cost for 1 FOV. Is this even required, or is it just equivalent to halving our distance unit? I think it is required since the hop is not necessarily in the direction of the object -- asimha
+
+    // Test 5: How effective is the hop? [Might not be required with A*]
+    //    double distredcost = -((src->angularDistanceTo( dest ).Degrees() - next->angularDistanceTo( dest ).Degrees()) * 60 / fov)*3; // 3 "magnitudes" for 1 FOV closer
+
+    float netcost = nodecost + distcost;
+    if (netcost < 0)
+        netcost = 0.1; // FIXME: Heuristics aren't supposed to be entirely random. This one is.
+    return netcost;
+}
+
+double StarHopper::nodeCost(const SkyPoint *next)
+{
     bool isThisTheEnd = (next == end);
 
     float magcost, speccost;
@@ -247,18 +390,8 @@ float StarHopper::cost(const SkyPoint *curr, const SkyPoint *next)
         */
     }
 
-    // Test 4: How far is the hop?
-    double distcost =
-        (curr->angularDistanceTo(next).Degrees() /
-         fov); // 1 "magnitude" incremental cost for 1 FOV. Is this even required, or is it just equivalent to halving our distance unit? I think it is required since the hop is not necessarily in the direction of the object -- asimha
-
-    // Test 5: How effective is the hop? [Might not be required with A*]
-    //    double distredcost = -((src->angularDistanceTo( dest ).Degrees() - next->angularDistanceTo( dest ).Degrees()) * 60 / fov)*3; // 3 "magnitudes" for 1 FOV closer
-
     // Test 6: Is the destination an asterism? Are there bright stars clustered nearby?
-    QList<StarObject *> localNeighbors;
-    StarComponent::Instance()->starsInAperture(localNeighbors, *next, fov / 10, maglim + 1.0);
-    double stardensitycost = 1 - localNeighbors.count(); // -1 "magnitude" for every neighbouring star
+    double stardensitycost = 1 - grid->near(*next, fov / 10, maglim + 1.0).count(); // -1 "magnitude" for every neighbouring star
 
 // Test 7: Identify star patterns
 
@@ -273,19 +406,24 @@ float StarHopper::cost(const SkyPoint *curr, const SkyPoint *next)
         StarObject const *nextstar = dynamic_cast<StarObject const *>(next);
         Q_ASSERT(nextstar);
 
+        // Stars within 1.0 mag of this one, in the largest aperture used for pattern identification
+        QVector<StarHopGrid::Neighbor> similar;
+        for (const auto &neighbor : grid->near(*next, fov, nextstar->mag() + 1.0))
+        {
+            if (neighbor.star != nextstar && fabs(neighbor.star->mag() - nextstar->mag()) <= 1.0)
+                similar.append(neighbor);
+        }
+
+        // Shrink the aperture until it holds two of them
+        QList<StarObject *> localNeighbors;
         float factor = 1.0;
         while (factor <= 10.0)
         {
             localNeighbors.clear();
-            StarComponent::Instance()->starsInAperture(
-                localNeighbors, *next, fov / factor,
-                nextstar->mag() + 1.0); // Use a larger aperture for pattern identification; max 1.0 mag difference
-            foreach (StarObject *star, localNeighbors)
+            for (const auto &neighbor : similar)
             {
-                if (star == nextstar)
-                    localNeighbors.removeOne(star);
-                else if (fabs(star->mag() - nextstar->mag()) > 1.0)
-                    localNeighbors.removeOne(star);
+                if (neighbor.distance <= fov / factor)
+                    localNeighbors.append(neighbor.star);
             } // Now, we should have a pruned list
             factor += 1.0;
             if (localNeighbors.size() == 2)
@@ -342,11 +480,8 @@ float StarHopper::cost(const SkyPoint *curr, const SkyPoint *next)
         }
     }
 
-    netcost = magcost + speccost + distcost + stardensitycost + patterncost;
-    if (netcost < 0)
-        netcost = 0.1; // FIXME: Heuristics aren't supposed to be entirely random. This one is.
-    qCDebug(KSTARS) << "Mag cost: " << magcost << "; Spec Cost: " << speccost << "; Dist Cost: " << distcost
-             << "; Density cost: " << stardensitycost << "; Pattern cost: " << patterncost << "; Net cost: " << netcost
-             << "; Pattern: " << patternName;
-    return netcost;
+    const double nodecost = magcost + speccost + stardensitycost + patterncost;
+    qCDebug(KSTARS) << "Mag cost: " << magcost << "; Spec Cost: " << speccost << "; Density cost: " << stardensitycost
+             << "; Pattern cost: " << patterncost << "; Star cost: " << nodecost << "; Pattern: " << patternName;
+    return nodecost;
 }
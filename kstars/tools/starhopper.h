@@ -9,9 +9,12 @@
 #include <QHash>
 #include <QList>
 
+#include <memory>
+
 class QStringList;
 
 class SkyPoint;
+class StarHopGrid;
 class StarObject;
 
 /**
@@ -24,6 +27,9 @@ class StarObject;
 class StarHopper
 {
   public:
+    StarHopper();
+    ~StarHopper();
+
     /**
      * @short Computes path for Star Hop
      * @param src SkyPoint to source of the Star Hop
@@ -53,6 +59,12 @@ class StarHopper
      */
     float cost(const SkyPoint *curr, const SkyPoint *next);
 
+    /**
+     * @short The part of the cost of hopping to @p next that does not depend on where the hop
+     * starts: its brightness, colour and the stars around it. It is computed once per search.
+     */
+    double nodeCost(const SkyPoint *next);
+
     /**
      * @short For internal use by the A* Search Algorithm. Completes
      * the star-hop path. See https://en.wikipedia.org/wiki/A*_search_algorithm for details
@@ -68,4 +80,7 @@ class StarHopper
     QHash<const SkyPoint *, const SkyPoint *> came_from; // Used by the A* search algorithm
     QList<StarObject const *> result_path;
     QHash<SkyPoint const *, QString> patternNames; // if patterns were identified, they are added to this hash.
+    // The stars of the current search, from a single query of StarComponent
+    std::unique_ptr<StarHopGrid> grid;
+    QHash<SkyPoint const *, double> nodeCosts;
 };
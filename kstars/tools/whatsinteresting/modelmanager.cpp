@@ -15,8 +15,7 @@
 #include "skyobjlistmodel.h"
 #include "starobject.h"
 #include "catalogsdb.h"
-
-#include <QtConcurrent>
+#include "auxiliary/executors.h"
 
 ModelManager::ModelManager(ObsConditions *obs)
 {
@@ -37,7 +36,7 @@ ModelManager::ModelManager(ObsConditions *obs)
         m_ObjectList.append(QList<SkyObjItem *>());
     }
 
-    QtConcurrent::run(this, &ModelManager::loadLists);
+    Executors::run(Executors::Background, &ModelManager::loadLists, this);
 }
 
 ModelManager::~ModelManager()
@@ -213,12 +212,24 @@ void ModelManager::loadObjectsIntoModel(SkyObjListModel &model, QList<SkyObjItem
 {
     KStarsData *data = KStarsData::Instance();
 
-    foreach (SkyObjItem *soitem, skyObjectList)
+    if (!showOnlyVisible)
     {
-        bool isVisible =
-            (showOnlyVisible) ? (m_ObsConditions->isVisible(data->geo(), data->lst(), soitem->getSkyObject())) : true;
-        if (isVisible)
+        foreach (SkyObjItem *soitem, skyObjectList)
             model.addSkyObject(soitem);
+        return;
+    }
+
+    // All objects of the category at once
+    QList<SkyObject *> objects;
+    objects.reserve(skyObjectList.size());
+    foreach (SkyObjItem *soitem, skyObjectList)
+        objects.append(soitem->getSkyObject());
+
+    const QVector<bool> visible = m_ObsConditions->isVisible(data->geo(), data->ut(), objects);
+    for (int i = 0; i < skyObjectList.size(); ++i)
+    {
+        if (visible[i])
+            model.addSkyObject(skyObjectList[i]);
     }
 }
 
@@ -281,7 +292,7 @@ void ModelManager::loadCatalog(const QString &name)
         { "ngc", "NGC " }, { "ic", "IC " }, { "messier", "M " }, { "sharpless", "Sh2 " }
     };
 
-    CatalogsDB::DBManager manager{ CatalogsDB::dso_db_path() };
+    auto &manager = CatalogsDB::thread_reader();
 
     const auto &prefix = search_prefixes.at(name);
     const int offset   = prefix.size();
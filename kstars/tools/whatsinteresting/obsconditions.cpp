@@ -6,6 +6,8 @@
 
 #include "obsconditions.h"
 
+#include "auxiliary/batchvisibility.h"
+
 #include <QDebug>
 
 #include <cmath>
@@ -98,6 +100,29 @@ bool ObsConditions::isVisible(GeoLocation *geo, dms *lst, SkyObject *so)
     return (sp.alt().Degrees() > 6.0 && so->mag() < getTrueMagLim());
 }
 
+QVector<bool> ObsConditions::isVisible(GeoLocation *geo, const KStarsDateTime &ut, const QList<SkyObject *> &objects)
+{
+    QVector<double> ra, dec;
+    BatchVisibility::coordinatesOfDate(objects, ut, geo, ra, dec);
+
+    // A grid of a single sample at ut
+    BatchVisibility visibility(*geo, ut, ut.addSecs(1), 1.0);
+    visibility.setAltitudeRange(6.0, 90.0);
+    const QVector<BatchVisibility::Result> results = visibility.compute(ra, dec);
+
+    const double magLim = getTrueMagLim();
+    QVector<bool> visible(objects.size());
+    for (int i = 0; i < objects.size(); ++i)
+    {
+        SkyObject *so = objects[i];
+        if (so->type() == SkyObject::SATELLITE)
+            visible[i] = so->alt().Degrees() > 6.0;
+        else
+            visible[i] = results[i].maxAltitude > 6.0 && so->mag() < magLim;
+    }
+    return visible;
+}
+
 void ObsConditions::setObsConditions(int bortle, double aperture, ObsConditions::Equipment equip,
                                      ObsConditions::TelescopeType telType)
 {
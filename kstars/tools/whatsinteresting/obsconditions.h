@@ -94,6 +94,16 @@ class ObsConditions
      */
     bool isVisible(GeoLocation *geo, dms *lst, SkyObject *so);
 
+    /**
+     * @brief Evaluate visibility of many sky-objects at once, like isVisible().
+     *
+     * @param geo       Geographic location of user.
+     * @param ut        Universal time at which visibility is evaluated.
+     * @param objects   SkyObjects for which visibility is to be evaluated.
+     * @return Visibility of each sky-object, in the order of @p objects.
+     */
+    QVector<bool> isVisible(GeoLocation *geo, const KStarsDateTime &ut, const QList<SkyObject *> &objects);
+
     /**
      * @brief Create QMap<int, double> to be initialised to static member variable m_LMMap
      *
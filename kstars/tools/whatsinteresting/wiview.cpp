@@ -19,6 +19,7 @@
 #include "starobject.h"
 #include "wiequipsettings.h"
 #include "dialogs/detaildialog.h"
+#include "auxiliary/executors.h"
 
 #include <klocalizedcontext.h>
 
@@ -29,7 +30,6 @@
 #include <QQuickItem>
 #include <QQuickView>
 #include <QStandardPaths>
-#include <QtConcurrent>
 
 #ifdef HAVE_INDI
 #include <basedevice.h>
@@ -268,7 +268,7 @@ void WIView::onCategorySelected(QString model)
             << "sharpless")
             .contains(model))
     {
-        QtConcurrent::run(m_ModManager.get(), &ModelManager::loadCatalog, model);
+        Executors::run(Executors::Background, &ModelManager::loadCatalog, m_ModManager.get(), model);
         return;
     }
 
@@ -276,7 +276,7 @@ bool WUTDialog::isCategoryInitialized(const QString &category)
 QVector<QPair<QString, const SkyObject *>> WUTDialog::load_dso(const QString &category,
                                         const std::vector<SkyObject::TYPE> &types)
 {
-    CatalogsDB::DBManager db{ CatalogsDB::dso_db_path() };
+    auto &db = CatalogsDB::thread_reader();
     QVector<QPair<QString, const SkyObject *>> objects;
 
     auto &lst = m_CatalogObjects[category];